@@ -0,0 +1,1332 @@
+/**
+ * @file avp_daemon.c
+ * @brief Vault daemon serving many agent processes over one TROPIC01 connection (POSIX).
+ *
+ * @copyright Copyright (c) 2026 AVP Protocol Contributors
+ * @license Apache-2.0 (see LICENSE)
+ */
+
+#include "avp_daemon.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lt_secure_memzero.h"
+#if defined(AVP_DAEMON_QOS) && defined(LT_STATS)
+#include "lt_l3_api_structs.h"
+#endif
+
+/*=============================================================================
+ * Constants
+ *============================================================================*/
+
+/* Agent gone while a response is sent must not kill the daemon by SIGPIPE */
+#ifdef MSG_NOSIGNAL
+#define AVP_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define AVP_SEND_FLAGS 0
+#endif
+
+/* Attempts to find an unused name for the shared memory of a connection */
+#define AVP_SHM_NAME_TRIES 16
+
+/* PIN of a connection in the secure arena, with its null character */
+#define AVP_DAEMON_PIN_LEN (LT_PIN_LEN_MAX + 1)
+
+/* Secrets returned by LIST through the shared memory */
+#define AVP_DAEMON_LIST_MAX (AVP_DAEMON_SHM_LEN / sizeof(avp_secret_metadata_t))
+
+/*=============================================================================
+ * Helpers
+ *============================================================================*/
+
+static bool full_send(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, AVP_SEND_FLAGS);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static bool full_recv(int fd, void *buf, size_t len)
+{
+    uint8_t *p = buf;
+    while (len > 0) {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/* Receives the response header of a new connection, shm_fd is -1 if the daemon sent no descriptor */
+static bool recv_shm_fd(int fd, avp_daemon_response_t *resp, int *shm_fd)
+{
+    union {
+        struct cmsghdr hdr;
+        uint8_t buf[CMSG_SPACE(sizeof(int))];
+    } ctrl;
+    memset(&ctrl, 0, sizeof(ctrl));
+
+    struct iovec iov = {.iov_base = resp, .iov_len = sizeof(*resp)};
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+
+    *shm_fd = -1;
+    if (recvmsg(fd, &msg, 0) != (ssize_t)sizeof(*resp)) {
+        return false;
+    }
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        memcpy(shm_fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    return true;
+}
+
+static bool name_fits(const char *name)
+{
+    return (name != NULL) && (strlen(name) <= AVP_MAX_SECRET_NAME_LEN);
+}
+
+#ifndef AVP_AGENT_ONLY
+/*=============================================================================
+ * Daemon: Connections
+ *============================================================================*/
+
+/* Sends the response header of a new connection together with the descriptor of its shared memory */
+static bool send_shm_fd(int fd, const avp_daemon_response_t *resp, int shm_fd)
+{
+    union {
+        struct cmsghdr hdr;
+        uint8_t buf[CMSG_SPACE(sizeof(int))];
+    } ctrl;
+    memset(&ctrl, 0, sizeof(ctrl));
+
+    struct iovec iov = {.iov_base = (void *)resp, .iov_len = sizeof(*resp)};
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &shm_fd, sizeof(int));
+
+    return sendmsg(fd, &msg, AVP_SEND_FLAGS) == (ssize_t)sizeof(*resp);
+}
+
+/* Creates anonymous shared memory of AVP_DAEMON_SHM_LEN bytes, returns its descriptor or -1 */
+static int shm_create(void)
+{
+    static unsigned seq;
+    char name[64];
+
+    for (size_t i = 0; i < AVP_SHM_NAME_TRIES; i++) {
+        snprintf(name, sizeof(name), "/avp-daemon-%ld-%u", (long)getpid(), seq++);
+        int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) {
+            if (errno == EEXIST) {
+                continue;
+            }
+            return -1;
+        }
+
+        /* Only the daemon and the agent hold the descriptor, nothing is left behind */
+        shm_unlink(name);
+        if (ftruncate(fd, AVP_DAEMON_SHM_LEN) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    return -1;
+}
+
+static void conn_drop(avp_daemon_t *daemon, avp_daemon_conn_t *conn)
+{
+    /* Wiped by the arena */
+    (void)avp_arena_free(&daemon->arena, conn->pin);
+    if (conn->shm != NULL) {
+        lt_secure_memzero(conn->shm, AVP_DAEMON_SHM_LEN);
+        munmap(conn->shm, AVP_DAEMON_SHM_LEN);
+    }
+    if (conn->fd >= 0) {
+        close(conn->fd);
+    }
+
+    lt_secure_memzero(conn, sizeof(*conn));
+    conn->fd = -1;
+}
+
+static void conn_accept(avp_daemon_t *daemon)
+{
+    int fd = accept(daemon->listen_fd, NULL, NULL);
+    if (fd < 0) {
+        return;
+    }
+
+    avp_daemon_conn_t *conn = NULL;
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS && conn == NULL; i++) {
+        if (daemon->conns[i].fd < 0) {
+            conn = &daemon->conns[i];
+        }
+    }
+
+    avp_daemon_response_t resp = {.ret = AVP_ERR_CAPACITY_EXCEEDED};
+    if (conn == NULL) {
+#ifdef AVP_METRICS
+        daemon->metrics.refused++;
+#endif
+        full_send(fd, &resp, sizeof(resp));
+        close(fd);
+        return;
+    }
+
+    char *pin = avp_arena_alloc(&daemon->arena, AVP_DAEMON_PIN_LEN);
+    int shm_fd = (pin != NULL) ? shm_create() : -1;
+    void *shm = MAP_FAILED;
+    if (shm_fd >= 0) {
+        shm = mmap(NULL, AVP_DAEMON_SHM_LEN, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    }
+
+    resp.ret = AVP_OK;
+    resp.len = AVP_DAEMON_SHM_LEN;
+    if (shm == MAP_FAILED || !send_shm_fd(fd, &resp, shm_fd)) {
+        if (shm != MAP_FAILED) {
+            munmap(shm, AVP_DAEMON_SHM_LEN);
+        }
+        if (shm_fd >= 0) {
+            close(shm_fd);
+        }
+        (void)avp_arena_free(&daemon->arena, pin);
+        close(fd);
+        return;
+    }
+
+    /* Mapping stays valid without the descriptor */
+    close(shm_fd);
+    memset(conn, 0, sizeof(*conn));
+    conn->fd = fd;
+    conn->shm = shm;
+    conn->pin = pin;
+}
+
+/* Reads the next request of the agent, drops the connection if the agent is gone */
+static void conn_read(avp_daemon_t *daemon, avp_daemon_conn_t *conn)
+{
+    if (!full_recv(conn->fd, &conn->req, sizeof(conn->req))) {
+        conn_drop(daemon, conn);
+        return;
+    }
+#ifdef AVP_METRICS
+    daemon->metrics.requests[(conn->req.op <= AVP_DAEMON_OP_METRICS) ? conn->req.op : 0]++;
+#else
+    (void)daemon;
+#endif
+
+    conn->req.name[AVP_MAX_SECRET_NAME_LEN] = '\0';
+    memset(&conn->resp, 0, sizeof(conn->resp));
+    conn->pending = true;
+}
+
+/* Session of the agent is valid, else it must AUTHENTICATE again */
+static bool conn_session_active(avp_daemon_conn_t *conn)
+{
+    if (conn->authenticated && (uint32_t)(AVP_TIME_NOW() - conn->auth_at) >= conn->ttl) {
+        conn->authenticated = false;
+        lt_secure_memzero(conn->pin, AVP_DAEMON_PIN_LEN);
+    }
+
+    return conn->authenticated;
+}
+
+/* Request is read and served in this round */
+static bool conn_ready(const avp_daemon_conn_t *conn)
+{
+#ifdef AVP_DAEMON_QOS
+    if (conn->held) {
+        return false;
+    }
+#endif
+    return conn->fd >= 0 && conn->pending;
+}
+
+#ifdef AVP_DAEMON_QOS
+/*=============================================================================
+ * Daemon: QoS
+ *
+ * Costs are chip time in microseconds: the R-memory commands a request is
+ * expected to make times their latency, which with LT_STATS is the mean
+ * measured by libtropic. Every request is charged to the token bucket of its
+ * agent when it is served, RETRIEVE by the length of the value it got, which
+ * is also the estimate of the next RETRIEVE of the agent; an agent whose
+ * bucket is empty is refused until the bucket refills.
+ *
+ * Before a round, the requests not served yet are ordered by their virtual
+ * finish time (weighted fair queueing): cost / weight after the later of the
+ * virtual time and the finish time of the previous request of the agent. The
+ * virtual time advances by the chip time served divided by the weight of all
+ * queued requests, so an agent sending request after request runs ahead of
+ * it and an agent asking now and then is put before it. The first requests up
+ * to AVP_DAEMON_QOS_ROUND_US are admitted, the next up to
+ * AVP_DAEMON_QOS_QUEUE_US wait for the next round and the rest are refused.
+ *============================================================================*/
+
+/* Entries of cmd_us */
+enum { QOS_READ, QOS_WRITE, QOS_ERASE };
+
+static uint64_t qos_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static const avp_daemon_qos_t *qos_of(const avp_daemon_t *daemon, const avp_daemon_conn_t *conn)
+{
+    /* AUTHENTICATE is charged to the workspace it asks for */
+    const char *workspace = conn->workspace;
+    if (conn->req.op == AVP_DAEMON_OP_AUTHENTICATE) {
+        workspace = (conn->req.name[0] != '\0') ? conn->req.name : "default";
+    }
+
+    for (size_t i = 0; i < AVP_DAEMON_QOS_TENANTS; i++) {
+        const avp_daemon_tenant_t *t = &daemon->tenants[i];
+        if (t->workspace[0] != '\0' && strcmp(t->workspace, workspace) == 0) {
+            return &t->qos;
+        }
+    }
+    return &daemon->qos;
+}
+
+/* R-memory slots of a value, the head slot also holds the name and the metadata */
+static uint32_t qos_slots(const avp_daemon_t *daemon, size_t value_len)
+{
+    size_t slot_len = daemon->vault->lt_handle.tr01_attrs.r_mem_udata_slot_size_max;
+    return (slot_len > 0) ? (uint32_t)(1 + value_len / slot_len) : 1;
+}
+
+/* Chip time of the request, value_len is that of RETRIEVE once served (0 before) */
+static uint32_t qos_cost(const avp_daemon_t *daemon, const avp_daemon_conn_t *conn, size_t value_len)
+{
+    const uint32_t *us = daemon->cmd_us;
+
+    switch (conn->req.op) {
+        case AVP_DAEMON_OP_STORE:
+            return qos_slots(daemon, conn->req.len) * (us[QOS_ERASE] + us[QOS_WRITE]);
+        case AVP_DAEMON_OP_RETRIEVE:
+            return qos_slots(daemon, value_len) * us[QOS_READ];
+        case AVP_DAEMON_OP_DELETE:
+            return us[QOS_ERASE];
+        default:
+            /* AUTHENTICATE and LIST are mostly served on the host, at most one read */
+            return us[QOS_READ];
+    }
+}
+
+static void qos_refill(avp_daemon_conn_t *conn, const avp_daemon_qos_t *qos, uint64_t now)
+{
+    if (conn->refill_at == 0) {
+        conn->tokens = qos->burst_us;
+        conn->refill_at = now;
+        return;
+    }
+
+    uint64_t gained = (now - conn->refill_at) * qos->rate_us / 1000000u;
+    /* Time too short for a whole microsecond is kept for the next refill */
+    if (gained == 0) {
+        return;
+    }
+    conn->refill_at = now;
+    conn->tokens = (conn->tokens + (int64_t)gained < (int64_t)qos->burst_us) ? conn->tokens + (int64_t)gained
+                                                                              : (int64_t)qos->burst_us;
+}
+
+#ifdef LT_STATS
+/* Takes the mean latency of the R-memory commands measured so far */
+static void qos_measure(avp_daemon_t *daemon)
+{
+    static const uint8_t cmd_ids[3] = {
+        [QOS_READ] = TR01_L3_R_MEM_DATA_READ_CMD_ID,
+        [QOS_WRITE] = TR01_L3_R_MEM_DATA_WRITE_CMD_ID,
+        [QOS_ERASE] = TR01_L3_R_MEM_DATA_ERASE_CMD_ID,
+    };
+    lt_stats_t stats;
+    if (lt_get_stats(&daemon->vault->lt_handle, &stats) != LT_OK) {
+        return;
+    }
+
+    for (size_t i = 0; i < LT_STATS_L3_CMDS; i++) {
+        const lt_stats_l3_cmd_t *cmd = &stats.l3_cmds[i];
+        for (size_t c = 0; c < 3 && cmd->count > 0; c++) {
+            if (cmd->cmd_id == cmd_ids[c]) {
+                daemon->cmd_us[c] = (uint32_t)(cmd->time_us / cmd->count);
+            }
+        }
+    }
+}
+#endif
+
+/* Admits the requests of the round, refused ones are answered and counted in *refused */
+static void qos_admit(avp_daemon_t *daemon, bool answer[AVP_DAEMON_CLIENTS], size_t *refused)
+{
+    avp_daemon_conn_t *queue[AVP_DAEMON_CLIENTS];
+    size_t n = 0;
+    uint64_t now = qos_now_us();
+    uint64_t weights = 0;
+    uint64_t start_min = UINT64_MAX;
+
+#ifdef LT_STATS
+    qos_measure(daemon);
+#endif
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        avp_daemon_conn_t *conn = &daemon->conns[i];
+        conn->held = false;
+        /* METRICS is answered from the host */
+        if (!conn_ready(conn) || conn->req.op == AVP_DAEMON_OP_METRICS) {
+            continue;
+        }
+
+        if (!conn->queued) {
+            const avp_daemon_qos_t *qos = qos_of(daemon, conn);
+            qos_refill(conn, qos, now);
+            if (qos->rate_us > 0 && conn->tokens <= 0) {
+                conn->resp.ret = AVP_ERR_CAPACITY_EXCEEDED;
+                conn->pending = false;
+                answer[i] = true;
+                (*refused)++;
+#ifdef AVP_METRICS
+                daemon->metrics.throttled++;
+#endif
+                continue;
+            }
+
+            /* Virtual time of an agent sending request after request runs ahead of that of the daemon */
+            conn->cost = qos_cost(daemon, conn, 0);
+            if (conn->req.op == AVP_DAEMON_OP_RETRIEVE && conn->read_cost > conn->cost) {
+                conn->cost = conn->read_cost;
+            }
+            conn->start = (conn->finish > daemon->vtime) ? conn->finish : daemon->vtime;
+            conn->finish = conn->start + (uint64_t)conn->cost * AVP_DAEMON_QOS_WEIGHT / qos->weight;
+            conn->queued = true;
+        }
+        weights += qos_of(daemon, conn)->weight;
+        start_min = (conn->start < start_min) ? conn->start : start_min;
+
+        /* Insertion by finish time, at most AVP_DAEMON_CLIENTS entries */
+        size_t k = n++;
+        while (k > 0 && queue[k - 1]->finish > conn->finish) {
+            queue[k] = queue[k - 1];
+            k--;
+        }
+        queue[k] = conn;
+    }
+
+    /* Virtual time does not lag behind the queue, e.g. after the daemon was idle */
+    daemon->weights = weights;
+    if (n > 0 && start_min > daemon->vtime) {
+        daemon->vtime = start_min;
+    }
+
+    /* The first request is always admitted, also one costlier than a round */
+    uint64_t total = 0;
+    for (size_t k = 0; k < n; k++) {
+        avp_daemon_conn_t *conn = queue[k];
+        total += conn->cost;
+        if (k == 0 || total <= AVP_DAEMON_QOS_ROUND_US) {
+            continue;
+        }
+        if (total <= AVP_DAEMON_QOS_QUEUE_US) {
+            conn->held = true;
+#ifdef AVP_METRICS
+            daemon->metrics.deferred++;
+#endif
+        }
+        else {
+            /* Not served, so not counted against the agent */
+            conn->finish = conn->start;
+            conn->resp.ret = AVP_ERR_CAPACITY_EXCEEDED;
+            conn->pending = false;
+            conn->queued = false;
+            answer[conn - daemon->conns] = true;
+            (*refused)++;
+#ifdef AVP_METRICS
+            daemon->metrics.shed++;
+#endif
+        }
+    }
+}
+
+/* Charges the served request to the bucket of its agent */
+static void qos_charge(avp_daemon_t *daemon, avp_daemon_conn_t *conn)
+{
+    if (!conn->queued) {
+        return;
+    }
+
+    uint32_t cost = conn->cost;
+    if (conn->req.op == AVP_DAEMON_OP_RETRIEVE) {
+        cost = qos_cost(daemon, conn, conn->resp.len);
+        conn->read_cost = cost;
+    }
+    conn->tokens -= cost;
+    conn->queued = false;
+
+    /* Virtual time runs at the rate each unit of weight of the queued requests is served */
+    if (daemon->weights > 0) {
+        daemon->vtime += (uint64_t)cost * AVP_DAEMON_QOS_WEIGHT / daemon->weights;
+    }
+}
+#endif /* AVP_DAEMON_QOS */
+
+/*=============================================================================
+ * Daemon: Serving a Round
+ *
+ * Every agent has at most one request outstanding. A round takes all the
+ * requests read by one poll(): AUTHENTICATE requests are served first, then
+ * the others are served workspace by workspace. The vault is switched to a
+ * workspace by avp_authenticate() with the PIN of one of its agents, which
+ * within the session TTL is checked on the host. Writes of the workspace are
+ * grouped in one batch, reads in one avp_retrieve_many(), where concurrent
+ * reads of one secret are made once and the value is copied to every agent
+ * asking for it. Agents of the workspace then share its directory, catalog
+ * and secret cache in the vault.
+ *============================================================================*/
+
+static void serve_authenticate(avp_daemon_t *daemon, avp_daemon_conn_t *conn)
+{
+    avp_vault_t *vault = daemon->vault;
+    avp_daemon_request_t *req = &conn->req;
+
+    conn->authenticated = false;
+    lt_secure_memzero(conn->pin, AVP_DAEMON_PIN_LEN);
+    if (req->len > LT_PIN_LEN_MAX) {
+        conn->resp.ret = AVP_ERR_AUTHENTICATION_FAILED;
+        return;
+    }
+
+    /* PIN goes straight to the locked memory of the connection, it is kept only if it is right */
+    memcpy(conn->pin, conn->shm, req->len);
+    lt_secure_memzero(conn->shm, req->len);
+
+    avp_ret_t ret = avp_authenticate(vault, (req->name[0] != '\0') ? req->name : NULL, conn->pin, req->arg);
+    if (ret == AVP_OK) {
+        conn->authenticated = true;
+        conn->auth_at = AVP_TIME_NOW();
+        conn->ttl = vault->session_ttl;
+        memcpy(conn->workspace, vault->workspace, sizeof(conn->workspace));
+    }
+    else {
+        lt_secure_memzero(conn->pin, AVP_DAEMON_PIN_LEN);
+    }
+
+    conn->resp.ret = ret;
+}
+
+/* Makes the workspace of the agent the current one of the vault */
+static avp_ret_t vault_switch(avp_daemon_t *daemon, const avp_daemon_conn_t *conn)
+{
+    avp_vault_t *vault = daemon->vault;
+    if (avp_session_active(vault) && strcmp(vault->workspace, conn->workspace) == 0) {
+        return AVP_OK;
+    }
+
+    return avp_authenticate(vault, conn->workspace, conn->pin, conn->ttl);
+}
+
+static bool is_write(const avp_daemon_conn_t *conn)
+{
+    return conn->req.op == AVP_DAEMON_OP_STORE || conn->req.op == AVP_DAEMON_OP_DELETE;
+}
+
+static void serve_write(avp_vault_t *vault, avp_daemon_conn_t *conn)
+{
+    avp_daemon_request_t *req = &conn->req;
+
+    if (req->op == AVP_DAEMON_OP_STORE) {
+        if (req->len > AVP_DAEMON_SHM_LEN) {
+            conn->resp.ret = AVP_ERR_INTERNAL;
+            return;
+        }
+        conn->resp.ret = avp_store(vault, req->name, conn->shm, req->len);
+        lt_secure_memzero(conn->shm, req->len);
+        return;
+    }
+
+    bool deleted = false;
+    conn->resp.ret = avp_delete(vault, req->name, &deleted);
+    conn->resp.count = deleted;
+}
+
+static void serve_list(avp_vault_t *vault, avp_daemon_conn_t *conn)
+{
+    size_t count = 0;
+    conn->resp.ret = avp_list(vault, (avp_secret_metadata_t *)conn->shm, AVP_DAEMON_LIST_MAX, &count);
+    conn->resp.count = (uint32_t)count;
+    conn->resp.len = (uint32_t)(count * sizeof(avp_secret_metadata_t));
+}
+
+/* Serves the pending requests of the agents in the workspace of the agent first */
+static size_t serve_workspace(avp_daemon_t *daemon, const avp_daemon_conn_t *first)
+{
+    avp_vault_t *vault = daemon->vault;
+    avp_daemon_conn_t *group[AVP_DAEMON_CLIENTS];
+    size_t n = 0;
+    size_t writes = 0;
+
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        avp_daemon_conn_t *conn = &daemon->conns[i];
+        if (conn_ready(conn) && strcmp(conn->workspace, first->workspace) == 0) {
+            group[n++] = conn;
+            writes += is_write(conn);
+        }
+    }
+
+    avp_ret_t ret = vault_switch(daemon, first);
+    if (ret != AVP_OK) {
+        for (size_t i = 0; i < n; i++) {
+            group[i]->resp.ret = ret;
+            group[i]->pending = false;
+            if (ret == AVP_ERR_AUTHENTICATION_FAILED) {
+                /* PIN was changed: stale PINs of the other agents must not burn further attempts */
+                group[i]->authenticated = false;
+                lt_secure_memzero(group[i]->pin, AVP_DAEMON_PIN_LEN);
+            }
+        }
+        return n;
+    }
+
+    /* Writes first, several of them share one commit; a failed commit fails all of them */
+    bool batched = (writes > 1) && (avp_batch_begin(vault) == AVP_OK);
+    for (size_t i = 0; i < n; i++) {
+        if (is_write(group[i])) {
+            serve_write(vault, group[i]);
+        }
+    }
+    if (batched) {
+        ret = avp_batch_commit(vault);
+        for (size_t i = 0; i < n && ret != AVP_OK; i++) {
+            if (is_write(group[i]) && group[i]->resp.ret == AVP_OK) {
+                group[i]->resp.ret = ret;
+            }
+        }
+    }
+
+    /* Then all reads back-to-back in one pass, agents asking for the same secret share one read */
+    const char *names[AVP_DAEMON_CLIENTS];
+    avp_retrieve_item_t items[AVP_DAEMON_CLIENTS];
+    avp_daemon_conn_t *readers[AVP_DAEMON_CLIENTS];
+    size_t read_of[AVP_DAEMON_CLIENTS];
+    size_t reads = 0;
+    size_t readers_cnt = 0;
+    for (size_t i = 0; i < n; i++) {
+        avp_daemon_conn_t *conn = group[i];
+        if (conn->req.op == AVP_DAEMON_OP_RETRIEVE) {
+            size_t r = 0;
+            while (r < reads && strcmp(names[r], conn->req.name) != 0) {
+                r++;
+            }
+            if (r == reads) {
+                names[reads] = conn->req.name;
+                items[reads].value = conn->shm;
+                items[reads].value_len = AVP_DAEMON_SHM_LEN;
+                reads++;
+            }
+            read_of[readers_cnt] = r;
+            readers[readers_cnt++] = conn;
+        }
+        else if (conn->req.op == AVP_DAEMON_OP_LIST) {
+            serve_list(vault, conn);
+        }
+        else if (!is_write(conn)) {
+            conn->resp.ret = AVP_ERR_INTERNAL;
+        }
+        conn->pending = false;
+    }
+    if (reads > 0) {
+        avp_retrieve_many(vault, names, items, reads);
+        for (size_t i = 0; i < readers_cnt; i++) {
+            const avp_retrieve_item_t *item = &items[read_of[i]];
+            readers[i]->resp.ret = item->status;
+            readers[i]->resp.len = (item->status == AVP_OK) ? (uint32_t)item->value_len : 0;
+            if (item->status == AVP_OK && item->value != readers[i]->shm) {
+                memcpy(readers[i]->shm, item->value, item->value_len);
+            }
+        }
+    }
+
+    return n;
+}
+
+/* METRICS needs no session, the text holds no names or values of secrets */
+static void serve_metrics(avp_daemon_t *daemon, avp_daemon_conn_t *conn)
+{
+#ifdef AVP_METRICS
+    size_t len = 0;
+    conn->resp.ret = avp_daemon_metrics(daemon, (char *)conn->shm, AVP_DAEMON_SHM_LEN, &len);
+    conn->resp.len = (conn->resp.ret == AVP_OK) ? (uint32_t)len : 0;
+#else
+    (void)daemon;
+    conn->resp.ret = AVP_ERR_INTERNAL;
+#endif
+}
+
+static size_t serve_round(avp_daemon_t *daemon)
+{
+    size_t served = 0;
+    bool answer[AVP_DAEMON_CLIENTS] = {false};
+
+#ifdef AVP_DAEMON_QOS
+    qos_admit(daemon, answer, &served);
+#endif
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        avp_daemon_conn_t *conn = &daemon->conns[i];
+        if (!conn_ready(conn)) {
+            continue;
+        }
+        answer[i] = true;
+        if (conn->req.op == AVP_DAEMON_OP_AUTHENTICATE) {
+            serve_authenticate(daemon, conn);
+            conn->pending = false;
+            served++;
+        }
+        else if (conn->req.op == AVP_DAEMON_OP_METRICS) {
+            serve_metrics(daemon, conn);
+            conn->pending = false;
+            served++;
+        }
+        else if (!conn_session_active(conn)) {
+            conn->resp.ret = AVP_ERR_NOT_INITIALIZED;
+            conn->pending = false;
+            served++;
+        }
+    }
+
+    /* Current workspace of the vault first, it needs no switch */
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        avp_daemon_conn_t *conn = &daemon->conns[i];
+        if (conn_ready(conn) && strcmp(conn->workspace, daemon->vault->workspace) == 0) {
+            served += serve_workspace(daemon, conn);
+            break;
+        }
+    }
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        avp_daemon_conn_t *conn = &daemon->conns[i];
+        if (conn_ready(conn)) {
+            served += serve_workspace(daemon, conn);
+        }
+    }
+
+#ifdef AVP_DAEMON_QOS
+    daemon->held = 0;
+#endif
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        avp_daemon_conn_t *conn = &daemon->conns[i];
+#ifdef AVP_DAEMON_QOS
+        daemon->held += (conn->fd >= 0 && conn->held);
+        if (answer[i]) {
+            qos_charge(daemon, conn);
+        }
+#endif
+        if (answer[i] && conn->fd >= 0 && !full_send(conn->fd, &conn->resp, sizeof(conn->resp))) {
+            conn_drop(daemon, conn);
+        }
+    }
+
+#ifdef AVP_METRICS
+    if (served > 0) {
+        daemon->metrics.rounds++;
+        daemon->metrics.queue_depth = (uint32_t)served;
+        if (served > daemon->metrics.queue_depth_max) {
+            daemon->metrics.queue_depth_max = (uint32_t)served;
+        }
+    }
+#endif
+
+    return served;
+}
+
+/*=============================================================================
+ * Daemon: Public API
+ *============================================================================*/
+
+avp_ret_t avp_daemon_open(avp_daemon_t *daemon, avp_vault_t *vault, const char *path)
+{
+    if (daemon == NULL || vault == NULL || path == NULL || strlen(path) >= AVP_DAEMON_PATH_MAX) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    memset(daemon, 0, sizeof(*daemon));
+    daemon->vault = vault;
+    strcpy(daemon->path, path);
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        daemon->conns[i].fd = -1;
+    }
+    daemon->listen_fd = -1;
+#ifdef AVP_DAEMON_QOS
+    daemon->qos.weight = AVP_DAEMON_QOS_WEIGHT;
+    daemon->qos.rate_us = AVP_DAEMON_QOS_RATE_US;
+    daemon->qos.burst_us = AVP_DAEMON_QOS_BURST_US;
+    daemon->cmd_us[QOS_READ] = AVP_DAEMON_QOS_READ_US;
+    daemon->cmd_us[QOS_WRITE] = AVP_DAEMON_QOS_WRITE_US;
+    daemon->cmd_us[QOS_ERASE] = AVP_DAEMON_QOS_ERASE_US;
+#endif
+
+    /* One block of the smallest class per connection for its PIN */
+    const uint16_t blocks[AVP_ARENA_CLASSES] = {AVP_DAEMON_CLIENTS};
+    if (avp_arena_open(&daemon->arena, blocks) != AVP_OK) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+    daemon->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (daemon->listen_fd < 0) {
+        avp_arena_close(&daemon->arena);
+        return AVP_ERR_INTERNAL;
+    }
+
+    /* Socket of a previous run */
+    unlink(path);
+    if (bind(daemon->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0
+        || listen(daemon->listen_fd, AVP_DAEMON_CLIENTS) != 0) {
+        close(daemon->listen_fd);
+        daemon->listen_fd = -1;
+        avp_arena_close(&daemon->arena);
+        return AVP_ERR_INTERNAL;
+    }
+
+    return AVP_OK;
+}
+
+avp_ret_t avp_daemon_run(avp_daemon_t *daemon, int timeout_ms, size_t *served)
+{
+    if (served != NULL) {
+        *served = 0;
+    }
+    if (daemon == NULL || daemon->listen_fd < 0) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    bool held = false;
+#ifdef AVP_DAEMON_QOS
+    /* Requests waiting for this round are not delayed by the wait */
+    held = (daemon->held > 0);
+    if (held) {
+        timeout_ms = 0;
+    }
+#endif
+
+    struct pollfd fds[1 + AVP_DAEMON_CLIENTS];
+    fds[0].fd = daemon->listen_fd;
+    fds[0].events = POLLIN;
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        /* Negative descriptors are ignored by poll(), an agent with a request waiting is watched for hangup only */
+        fds[1 + i].fd = daemon->conns[i].fd;
+        fds[1 + i].events = daemon->conns[i].pending ? 0 : POLLIN;
+        fds[1 + i].revents = 0;
+    }
+
+    int ready = poll(fds, 1 + AVP_DAEMON_CLIENTS, timeout_ms);
+    if (ready < 0) {
+        return (errno == EINTR) ? AVP_OK : AVP_ERR_INTERNAL;
+    }
+    if (ready == 0 && !held) {
+        return AVP_OK;
+    }
+
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        if (fds[1 + i].fd >= 0 && (fds[1 + i].revents & (POLLIN | POLLHUP | POLLERR))) {
+            conn_read(daemon, &daemon->conns[i]);
+        }
+    }
+    if (fds[0].revents & POLLIN) {
+        conn_accept(daemon);
+    }
+
+    size_t n = serve_round(daemon);
+    if (served != NULL) {
+        *served = n;
+    }
+
+    return AVP_OK;
+}
+
+#ifdef AVP_DAEMON_QOS
+avp_ret_t avp_daemon_set_qos(avp_daemon_t *daemon, const char *workspace, const avp_daemon_qos_t *qos)
+{
+    if (daemon == NULL || (workspace != NULL && (workspace[0] == '\0' || !name_fits(workspace)))
+        || (workspace == NULL && qos == NULL)) {
+        return AVP_ERR_INTERNAL;
+    }
+    if (qos != NULL && (qos->weight == 0 || (qos->rate_us > 0 && qos->burst_us == 0))) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    if (workspace == NULL) {
+        daemon->qos = *qos;
+        return AVP_OK;
+    }
+
+    avp_daemon_tenant_t *tenant = NULL;
+    avp_daemon_tenant_t *free_tenant = NULL;
+    for (size_t i = 0; i < AVP_DAEMON_QOS_TENANTS && tenant == NULL; i++) {
+        avp_daemon_tenant_t *t = &daemon->tenants[i];
+        if (t->workspace[0] == '\0') {
+            free_tenant = (free_tenant == NULL) ? t : free_tenant;
+        }
+        else if (strcmp(t->workspace, workspace) == 0) {
+            tenant = t;
+        }
+    }
+
+    if (qos == NULL) {
+        if (tenant != NULL) {
+            memset(tenant, 0, sizeof(*tenant));
+        }
+        return AVP_OK;
+    }
+    if (tenant == NULL) {
+        if (free_tenant == NULL) {
+            return AVP_ERR_CAPACITY_EXCEEDED;
+        }
+        tenant = free_tenant;
+        strcpy(tenant->workspace, workspace);
+    }
+    tenant->qos = *qos;
+
+    return AVP_OK;
+}
+#endif
+
+void avp_daemon_close(avp_daemon_t *daemon)
+{
+    if (daemon == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        if (daemon->conns[i].fd >= 0) {
+            conn_drop(daemon, &daemon->conns[i]);
+        }
+    }
+    if (daemon->listen_fd >= 0) {
+        close(daemon->listen_fd);
+        unlink(daemon->path);
+        daemon->listen_fd = -1;
+    }
+    avp_arena_close(&daemon->arena);
+}
+
+#ifdef AVP_METRICS
+/*=============================================================================
+ * Daemon: Metrics
+ *============================================================================*/
+
+/* Text being written, an overflow drops the rest of it */
+typedef struct metrics_out_t {
+    char *text;
+    size_t max_len;
+    size_t len;
+    bool overflow;
+} metrics_out_t;
+
+/* Names of avp_daemon_op_t as values of the op label */
+static const char *const metrics_op_names[AVP_DAEMON_OP_METRICS + 1] = {
+    "unknown", "authenticate", "store", "retrieve", "delete", "list", "metrics",
+};
+
+__attribute__((format(printf, 2, 3))) static void metrics_printf(metrics_out_t *out, const char *fmt, ...)
+{
+    if (out->overflow) {
+        return;
+    }
+
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(out->text + out->len, out->max_len - out->len, fmt, ap);
+    va_end(ap);
+    if (n < 0 || (size_t)n >= out->max_len - out->len) {
+        out->overflow = true;
+        return;
+    }
+    out->len += (size_t)n;
+}
+
+#ifdef LT_METRICS
+/* lt_metrics_write_t appending statistics of the device to the text */
+static lt_ret_t metrics_lt_write(void *write_ctx, const char *data, const size_t len)
+{
+    metrics_out_t *out = write_ctx;
+    if (out->overflow || len >= out->max_len - out->len) {
+        out->overflow = true;
+        return LT_FAIL;
+    }
+
+    memcpy(out->text + out->len, data, len);
+    out->len += len;
+    out->text[out->len] = '\0';
+    return LT_OK;
+}
+#endif
+
+avp_ret_t avp_daemon_metrics(const avp_daemon_t *daemon, char *text, size_t max_len, size_t *len)
+{
+    if (daemon == NULL || daemon->vault == NULL || text == NULL || max_len == 0 || len == NULL) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    metrics_out_t out = {.text = text, .max_len = max_len};
+    const avp_daemon_metrics_t *m = &daemon->metrics;
+    const avp_metrics_t *vm = &daemon->vault->metrics;
+    text[0] = '\0';
+
+    metrics_printf(&out, "# TYPE avp_daemon_requests counter\n# HELP avp_daemon_requests Requests read from agents.\n");
+    for (size_t op = 0; op <= AVP_DAEMON_OP_METRICS; op++) {
+        metrics_printf(&out, "avp_daemon_requests_total{op=\"%s\"} %llu\n", metrics_op_names[op],
+                       (unsigned long long)m->requests[op]);
+    }
+    metrics_printf(&out, "# TYPE avp_daemon_rounds counter\n# HELP avp_daemon_rounds Rounds serving requests.\n"
+                         "avp_daemon_rounds_total %llu\n", (unsigned long long)m->rounds);
+    metrics_printf(&out, "# TYPE avp_daemon_queue_depth gauge\n"
+                         "# HELP avp_daemon_queue_depth Requests served by the last round.\n"
+                         "avp_daemon_queue_depth %u\n", (unsigned)m->queue_depth);
+    metrics_printf(&out, "# TYPE avp_daemon_queue_depth_max gauge\n"
+                         "# HELP avp_daemon_queue_depth_max Most requests served by one round.\n"
+                         "avp_daemon_queue_depth_max %u\n", (unsigned)m->queue_depth_max);
+
+    unsigned agents = 0;
+    for (size_t i = 0; i < AVP_DAEMON_CLIENTS; i++) {
+        agents += (daemon->conns[i].fd >= 0);
+    }
+    metrics_printf(&out, "# TYPE avp_daemon_agents gauge\n# HELP avp_daemon_agents Connected agents.\n"
+                         "avp_daemon_agents %u\n", agents);
+    metrics_printf(&out, "# TYPE avp_daemon_refused counter\n"
+                         "# HELP avp_daemon_refused Connections refused with all agent entries in use.\n"
+                         "avp_daemon_refused_total %llu\n", (unsigned long long)m->refused);
+#ifdef AVP_DAEMON_QOS
+    metrics_printf(&out, "# TYPE avp_daemon_qos_refused counter\n"
+                         "# HELP avp_daemon_qos_refused Requests refused by QoS, by empty token bucket or full queue.\n"
+                         "avp_daemon_qos_refused_total{reason=\"throttled\"} %llu\n"
+                         "avp_daemon_qos_refused_total{reason=\"shed\"} %llu\n",
+                   (unsigned long long)m->throttled, (unsigned long long)m->shed);
+    metrics_printf(&out, "# TYPE avp_daemon_qos_deferred counter\n"
+                         "# HELP avp_daemon_qos_deferred Requests moved to a later round.\n"
+                         "avp_daemon_qos_deferred_total %llu\n", (unsigned long long)m->deferred);
+#endif
+
+    /* Secret cache only with AVP_SECRET_CACHE, its counters stay zero otherwise */
+    const struct {
+        const char *name;
+        uint64_t hits;
+        uint64_t misses;
+    } caches[] = {
+#ifdef AVP_SECRET_CACHE
+        {"secret", vm->secret_cache_hits, vm->secret_cache_misses},
+#endif
+        {"pubkey", vm->pubkey_cache_hits, vm->pubkey_cache_misses},
+        {"cert", vm->cert_cache_hits, vm->cert_cache_misses},
+    };
+    const size_t caches_cnt = sizeof(caches) / sizeof(caches[0]);
+    metrics_printf(&out, "# TYPE avp_cache_hits counter\n# HELP avp_cache_hits Lookups served from the cache.\n");
+    for (size_t i = 0; i < caches_cnt; i++) {
+        metrics_printf(&out, "avp_cache_hits_total{cache=\"%s\"} %llu\n", caches[i].name,
+                       (unsigned long long)caches[i].hits);
+    }
+    metrics_printf(&out, "# TYPE avp_cache_misses counter\n# HELP avp_cache_misses Lookups read from TROPIC01.\n");
+    for (size_t i = 0; i < caches_cnt; i++) {
+        metrics_printf(&out, "avp_cache_misses_total{cache=\"%s\"} %llu\n", caches[i].name,
+                       (unsigned long long)caches[i].misses);
+    }
+    metrics_printf(&out, "# TYPE avp_cache_hit_ratio gauge\n"
+                         "# HELP avp_cache_hit_ratio Hits per lookup since start, absent before the first lookup.\n");
+    for (size_t i = 0; i < caches_cnt; i++) {
+        uint64_t lookups = caches[i].hits + caches[i].misses;
+        if (lookups > 0) {
+            metrics_printf(&out, "avp_cache_hit_ratio{cache=\"%s\"} %.4f\n", caches[i].name,
+                           (double)caches[i].hits / (double)lookups);
+        }
+    }
+
+#ifdef LT_METRICS
+    lt_stats_t stats;
+    const lt_metrics_dev_t dev = {.name = "vault", .stats = &stats};
+    if (lt_get_stats(&daemon->vault->lt_handle, &stats) != LT_OK) {
+        return AVP_ERR_INTERNAL;
+    }
+    /* Fails only by an overflow of the text, which is reported below */
+    (void)lt_metrics_write_stats(&dev, 1, metrics_lt_write, &out);
+#endif
+    metrics_printf(&out, "# EOF\n");
+
+    if (out.overflow) {
+        return AVP_ERR_CAPACITY_EXCEEDED;
+    }
+    *len = out.len;
+    return AVP_OK;
+}
+#endif /* AVP_METRICS */
+
+#endif /* AVP_AGENT_ONLY */
+
+/*=============================================================================
+ * Agent
+ *============================================================================*/
+
+/* Sends the request, waits for the response of the round it was served in */
+static avp_ret_t agent_call(avp_agent_t *agent, const avp_daemon_request_t *req, avp_daemon_response_t *resp)
+{
+    if (agent->fd < 0) {
+        return AVP_ERR_NOT_INITIALIZED;
+    }
+    if (!full_send(agent->fd, req, sizeof(*req)) || !full_recv(agent->fd, resp, sizeof(*resp))) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    return (avp_ret_t)resp->ret;
+}
+
+avp_ret_t avp_agent_connect(avp_agent_t *agent, const char *path)
+{
+    if (agent == NULL || path == NULL || strlen(path) >= AVP_DAEMON_PATH_MAX) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    agent->fd = -1;
+    agent->shm = NULL;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    avp_daemon_response_t resp;
+    int shm_fd = -1;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || !recv_shm_fd(fd, &resp, &shm_fd)) {
+        close(fd);
+        return AVP_ERR_INTERNAL;
+    }
+
+    avp_ret_t ret = (avp_ret_t)resp.ret;
+    void *shm = MAP_FAILED;
+    if (ret == AVP_OK) {
+        ret = AVP_ERR_INTERNAL;
+        if (shm_fd >= 0 && resp.len == AVP_DAEMON_SHM_LEN) {
+            shm = mmap(NULL, AVP_DAEMON_SHM_LEN, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+            ret = (shm != MAP_FAILED) ? AVP_OK : AVP_ERR_INTERNAL;
+        }
+    }
+    if (shm_fd >= 0) {
+        close(shm_fd);
+    }
+    if (ret != AVP_OK) {
+        close(fd);
+        return ret;
+    }
+
+    agent->fd = fd;
+    agent->shm = shm;
+    return AVP_OK;
+}
+
+void avp_agent_disconnect(avp_agent_t *agent)
+{
+    if (agent == NULL) {
+        return;
+    }
+
+    if (agent->shm != NULL) {
+        munmap(agent->shm, AVP_DAEMON_SHM_LEN);
+        agent->shm = NULL;
+    }
+    if (agent->fd >= 0) {
+        close(agent->fd);
+        agent->fd = -1;
+    }
+}
+
+avp_ret_t avp_agent_authenticate(avp_agent_t *agent, const char *workspace, const char *pin, uint32_t ttl_seconds)
+{
+    if (agent == NULL || pin == NULL || (workspace != NULL && !name_fits(workspace))) {
+        return AVP_ERR_INTERNAL;
+    }
+    size_t pin_len = strlen(pin);
+    if (pin_len > LT_PIN_LEN_MAX) {
+        return AVP_ERR_AUTHENTICATION_FAILED;
+    }
+    if (agent->fd < 0) {
+        return AVP_ERR_NOT_INITIALIZED;
+    }
+
+    avp_daemon_request_t req = {.op = AVP_DAEMON_OP_AUTHENTICATE, .len = (uint32_t)pin_len, .arg = ttl_seconds};
+    if (workspace != NULL) {
+        strcpy(req.name, workspace);
+    }
+    memcpy(agent->shm, pin, pin_len);
+
+    avp_daemon_response_t resp;
+    avp_ret_t ret = agent_call(agent, &req, &resp);
+    lt_secure_memzero(agent->shm, pin_len);
+
+    return ret;
+}
+
+avp_ret_t avp_agent_store(avp_agent_t *agent, const char *name, const uint8_t *value, size_t value_len)
+{
+    if (agent == NULL || !name_fits(name) || (value == NULL && value_len > 0)) {
+        return AVP_ERR_INTERNAL;
+    }
+    if (value_len > AVP_DAEMON_SHM_LEN) {
+        return AVP_ERR_CAPACITY_EXCEEDED;
+    }
+    if (agent->fd < 0) {
+        return AVP_ERR_NOT_INITIALIZED;
+    }
+
+    avp_daemon_request_t req = {.op = AVP_DAEMON_OP_STORE, .len = (uint32_t)value_len};
+    strcpy(req.name, name);
+    if (value_len > 0) {
+        memcpy(agent->shm, value, value_len);
+    }
+
+    avp_daemon_response_t resp;
+    return agent_call(agent, &req, &resp);
+}
+
+avp_ret_t avp_agent_retrieve(avp_agent_t *agent, const char *name, uint8_t *value, size_t *value_len)
+{
+    if (agent == NULL || !name_fits(name) || value == NULL || value_len == NULL) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    avp_daemon_request_t req = {.op = AVP_DAEMON_OP_RETRIEVE};
+    strcpy(req.name, name);
+
+    avp_daemon_response_t resp;
+    avp_ret_t ret = agent_call(agent, &req, &resp);
+    if (ret != AVP_OK) {
+        return ret;
+    }
+
+    if (resp.len > AVP_DAEMON_SHM_LEN || resp.len > *value_len) {
+        ret = AVP_ERR_INTERNAL;
+    }
+    else {
+        memcpy(value, agent->shm, resp.len);
+        *value_len = resp.len;
+    }
+    /* Plaintext does not stay in memory the daemon can read */
+    lt_secure_memzero(agent->shm, (resp.len < AVP_DAEMON_SHM_LEN) ? resp.len : AVP_DAEMON_SHM_LEN);
+
+    return ret;
+}
+
+avp_ret_t avp_agent_delete(avp_agent_t *agent, const char *name, bool *deleted)
+{
+    if (agent == NULL || !name_fits(name)) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    avp_daemon_request_t req = {.op = AVP_DAEMON_OP_DELETE};
+    strcpy(req.name, name);
+
+    avp_daemon_response_t resp;
+    avp_ret_t ret = agent_call(agent, &req, &resp);
+    if (deleted != NULL) {
+        *deleted = (ret == AVP_OK) && (resp.count != 0);
+    }
+
+    return ret;
+}
+
+avp_ret_t avp_agent_list(avp_agent_t *agent, avp_secret_metadata_t *secrets, size_t max_secrets, size_t *count)
+{
+    if (agent == NULL || count == NULL) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    avp_daemon_request_t req = {.op = AVP_DAEMON_OP_LIST};
+    avp_daemon_response_t resp;
+    avp_ret_t ret = agent_call(agent, &req, &resp);
+    if (ret != AVP_OK) {
+        return ret;
+    }
+    if (resp.count > AVP_DAEMON_LIST_MAX) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    *count = resp.count;
+    if (secrets != NULL) {
+        if (*count > max_secrets) {
+            *count = max_secrets;
+        }
+        memcpy(secrets, agent->shm, *count * sizeof(avp_secret_metadata_t));
+    }
+
+    return AVP_OK;
+}
+
+avp_ret_t avp_agent_metrics(avp_agent_t *agent, char *text, size_t max_len, size_t *len)
+{
+    if (agent == NULL || text == NULL || max_len == 0 || len == NULL) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    avp_daemon_request_t req = {.op = AVP_DAEMON_OP_METRICS};
+    avp_daemon_response_t resp;
+    avp_ret_t ret = agent_call(agent, &req, &resp);
+    if (ret != AVP_OK) {
+        return ret;
+    }
+    if (resp.len > AVP_DAEMON_SHM_LEN) {
+        return AVP_ERR_INTERNAL;
+    }
+    if (resp.len >= max_len) {
+        return AVP_ERR_CAPACITY_EXCEEDED;
+    }
+
+    memcpy(text, agent->shm, resp.len);
+    text[resp.len] = '\0';
+    *len = resp.len;
+    return AVP_OK;
+}
@@ -0,0 +1,386 @@
+/**
+ * @file avp_daemon.h
+ * @brief Vault daemon serving many agent processes over one TROPIC01 connection (POSIX).
+ *
+ * One process owns the initialized vault and with it the only lt_handle_t of
+ * the device. Agents connect to its Unix socket as avp_agent_t and send AVP
+ * operations; values and LIST results travel through a shared memory region
+ * set up per connection, so only fixed-size headers go over the socket.
+ * Requests arriving together are served in one round: agents of a workspace
+ * are served under one AUTHENTICATE, their STOREs and DELETEs are grouped
+ * into one batch commit and their RETRIEVEs into one avp_retrieve_many(),
+ * and the directory, metadata catalog and secret cache of the vault are
+ * shared by all agents of the workspace. With AVP_METRICS, the daemon also
+ * answers METRICS requests by its counters in the OpenMetrics text format.
+ * With AVP_DAEMON_QOS, requests are admitted to rounds by chip time: token
+ * buckets per agent, fair queueing by weight of the workspace and a bounded
+ * queue refusing the excess.
+ * Built with AVP_AGENT_ONLY, the file has only the agent side, which links
+ * without the vault and libtropic (language bindings of the agents).
+ *
+ * @copyright Copyright (c) 2026 AVP Protocol Contributors
+ * @license Apache-2.0 (see LICENSE)
+ */
+
+#ifndef AVP_DAEMON_H
+#define AVP_DAEMON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avp_secure_arena.h"
+#include "avp_tropic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Longest socket path (size of sun_path) */
+#define AVP_DAEMON_PATH_MAX 108
+
+/** @brief Agents connected at once, further connections are refused */
+#ifndef AVP_DAEMON_CLIENTS
+#define AVP_DAEMON_CLIENTS 64
+#endif
+
+/** @brief Shared memory of one connection, bounds the value of STORE / RETRIEVE and the LIST result */
+#ifndef AVP_DAEMON_SHM_LEN
+#define AVP_DAEMON_SHM_LEN AVP_MAX_SECRET_VALUE_LEN
+#endif
+
+#ifdef AVP_DAEMON_QOS
+/** @brief Workspaces with their own QoS settings, see avp_daemon_set_qos() */
+#ifndef AVP_DAEMON_QOS_TENANTS
+#define AVP_DAEMON_QOS_TENANTS 8
+#endif
+
+/** @brief Default weight of a tenant in the fair queue */
+#ifndef AVP_DAEMON_QOS_WEIGHT
+#define AVP_DAEMON_QOS_WEIGHT 16
+#endif
+
+/** @brief Default chip time one agent may use per second in microseconds, 0 for no limit */
+#ifndef AVP_DAEMON_QOS_RATE_US
+#define AVP_DAEMON_QOS_RATE_US 250000
+#endif
+
+/** @brief Default chip time one agent may use at once in microseconds (size of its token bucket) */
+#ifndef AVP_DAEMON_QOS_BURST_US
+#define AVP_DAEMON_QOS_BURST_US 100000
+#endif
+
+/** @brief Chip time admitted to one round in microseconds, further requests wait for the next one */
+#ifndef AVP_DAEMON_QOS_ROUND_US
+#define AVP_DAEMON_QOS_ROUND_US 50000
+#endif
+
+/** @brief Chip time of the admitted and waiting requests in microseconds, further requests are refused */
+#ifndef AVP_DAEMON_QOS_QUEUE_US
+#define AVP_DAEMON_QOS_QUEUE_US 400000
+#endif
+
+/** @brief Latency of R_Mem_Data_Read, Write and Erase in microseconds until LT_STATS measured them */
+#ifndef AVP_DAEMON_QOS_READ_US
+#define AVP_DAEMON_QOS_READ_US 4000
+#endif
+#ifndef AVP_DAEMON_QOS_WRITE_US
+#define AVP_DAEMON_QOS_WRITE_US 8000
+#endif
+#ifndef AVP_DAEMON_QOS_ERASE_US
+#define AVP_DAEMON_QOS_ERASE_US 12000
+#endif
+#endif
+
+/**
+ * @brief Operations of the daemon protocol.
+ */
+typedef enum {
+    AVP_DAEMON_OP_AUTHENTICATE = 1,
+    AVP_DAEMON_OP_STORE,
+    AVP_DAEMON_OP_RETRIEVE,
+    AVP_DAEMON_OP_DELETE,
+    AVP_DAEMON_OP_LIST,
+    AVP_DAEMON_OP_METRICS,
+} avp_daemon_op_t;
+
+/**
+ * @brief Request sent by an agent, its payload is in the shared memory.
+ */
+typedef struct avp_daemon_request_t {
+    /** @brief avp_daemon_op_t */
+    uint32_t op;
+    /** @brief Bytes of payload: value of STORE, PIN of AUTHENTICATE */
+    uint32_t len;
+    /** @brief Session TTL of AUTHENTICATE (0 for default) */
+    uint32_t arg;
+    /** @brief Secret name, workspace of AUTHENTICATE */
+    char name[AVP_MAX_SECRET_NAME_LEN + 1];
+} avp_daemon_request_t;
+
+/**
+ * @brief Response of the daemon, its payload is in the shared memory.
+ */
+typedef struct avp_daemon_response_t {
+    /** @brief avp_ret_t of the operation */
+    int32_t ret;
+    /** @brief Bytes of payload: value of RETRIEVE, avp_secret_metadata_t array of LIST, text of METRICS */
+    uint32_t len;
+    /** @brief Secrets returned by LIST, 1 if DELETE removed the secret */
+    uint32_t count;
+} avp_daemon_response_t;
+
+/**
+ * @brief Connection of one agent, private to the daemon.
+ */
+typedef struct avp_daemon_conn_t {
+    /** @brief Socket, -1 if the entry is free */
+    int fd;
+    /** @brief Shared memory of the connection */
+    uint8_t *shm;
+    /** @brief Request waiting for the next round */
+    bool pending;
+    /** @brief Request read from the socket */
+    avp_daemon_request_t req;
+    /** @brief Response of the current round */
+    avp_daemon_response_t resp;
+    /** @brief AUTHENTICATE of the agent succeeded */
+    bool authenticated;
+    /** @brief Time of the AUTHENTICATE of the agent (Unix epoch) */
+    uint32_t auth_at;
+    /** @brief Session TTL of the agent */
+    uint32_t ttl;
+    /** @brief Workspace of the agent */
+    char workspace[256];
+    /** @brief PIN of the agent (secure arena), the vault is authenticated with it when switching to its workspace */
+    char *pin;
+#ifdef AVP_DAEMON_QOS
+    /** @brief Chip time left in the token bucket in microseconds, negative after a request costlier than it */
+    int64_t tokens;
+    /** @brief Time of the last refill of the bucket (monotonic microseconds), 0 before the first request */
+    uint64_t refill_at;
+    /** @brief Virtual start time of the request in the fair queue */
+    uint64_t start;
+    /** @brief Virtual finish time of the request in the fair queue, start of the next request of the agent */
+    uint64_t finish;
+    /** @brief Estimated chip time of the queued request in microseconds */
+    uint32_t cost;
+    /** @brief Chip time of the last RETRIEVE of the agent, the estimate of its next one */
+    uint32_t read_cost;
+    /** @brief Request is queued: its finish time is taken and its cost is charged when it is served */
+    bool queued;
+    /** @brief Request waits for a later round */
+    bool held;
+#endif
+} avp_daemon_conn_t;
+
+#ifdef AVP_DAEMON_QOS
+/**
+ * @brief QoS settings of a tenant (the agents of one workspace).
+ */
+typedef struct avp_daemon_qos_t {
+    /** @brief Share of the chip against other tenants when requests queue up, 1 or more */
+    uint32_t weight;
+    /** @brief Chip time each agent may use per second in microseconds, 0 for no limit */
+    uint32_t rate_us;
+    /** @brief Chip time each agent may use at once in microseconds */
+    uint32_t burst_us;
+} avp_daemon_qos_t;
+
+/**
+ * @brief QoS settings of one workspace, private to the daemon.
+ */
+typedef struct avp_daemon_tenant_t {
+    /** @brief Workspace, empty if the entry is free */
+    char workspace[256];
+    /** @brief Settings of its agents */
+    avp_daemon_qos_t qos;
+} avp_daemon_tenant_t;
+#endif
+
+#ifdef AVP_METRICS
+/**
+ * @brief Counters of the daemon, exported by avp_daemon_metrics().
+ */
+typedef struct avp_daemon_metrics_t {
+    /** @brief Requests read, by avp_daemon_op_t (index 0 counts unknown operations) */
+    uint64_t requests[AVP_DAEMON_OP_METRICS + 1];
+    /** @brief Rounds which served at least one request */
+    uint64_t rounds;
+    /** @brief Requests served by the last round */
+    uint32_t queue_depth;
+    /** @brief Most requests served by one round */
+    uint32_t queue_depth_max;
+    /** @brief Connections refused because AVP_DAEMON_CLIENTS agents were connected */
+    uint64_t refused;
+#ifdef AVP_DAEMON_QOS
+    /** @brief Requests refused because the token bucket of the agent was empty */
+    uint64_t throttled;
+    /** @brief Requests refused because the queue was full */
+    uint64_t shed;
+    /** @brief Requests moved to a later round */
+    uint64_t deferred;
+#endif
+} avp_daemon_metrics_t;
+#endif
+
+/**
+ * @brief Vault daemon, contents are private.
+ */
+typedef struct avp_daemon_t {
+    /** @brief Vault served, initialized by avp_init() */
+    avp_vault_t *vault;
+    /** @brief Listening socket */
+    int listen_fd;
+    /** @brief Path of the socket */
+    char path[AVP_DAEMON_PATH_MAX];
+    /** @brief Connected agents */
+    avp_daemon_conn_t conns[AVP_DAEMON_CLIENTS];
+    /** @brief Locked memory of the PINs of the agents */
+    avp_arena_t arena;
+#ifdef AVP_DAEMON_QOS
+    /** @brief Settings of the workspaces without an entry in tenants */
+    avp_daemon_qos_t qos;
+    /** @brief Workspaces with their own settings */
+    avp_daemon_tenant_t tenants[AVP_DAEMON_QOS_TENANTS];
+    /** @brief Virtual time of the fair queue */
+    uint64_t vtime;
+    /** @brief Weight of the requests queued in the last round */
+    uint64_t weights;
+    /** @brief Latency of R_Mem_Data_Read, Write and Erase in microseconds */
+    uint32_t cmd_us[3];
+    /** @brief Requests waiting for a later round */
+    size_t held;
+#endif
+#ifdef AVP_METRICS
+    /** @brief Counters since avp_daemon_open() */
+    avp_daemon_metrics_t metrics;
+#endif
+} avp_daemon_t;
+
+/**
+ * @brief Agent side of a connection to the daemon.
+ */
+typedef struct avp_agent_t {
+    /** @brief Socket */
+    int fd;
+    /** @brief Shared memory of the connection */
+    uint8_t *shm;
+} avp_agent_t;
+
+/**
+ * @brief Starts listening on the socket.
+ *
+ * @param daemon Daemon to start.
+ * @param vault Vault to serve, initialized by avp_init(); the daemon is its only user.
+ * @param path Path of the socket, an existing file is replaced.
+ * @return AVP_OK on success, AVP_ERR_INTERNAL on invalid parameters, socket error or
+ *         when the memory for the PINs of the agents cannot be locked.
+ */
+avp_ret_t avp_daemon_open(avp_daemon_t *daemon, avp_vault_t *vault, const char *path);
+
+/**
+ * @brief Waits for requests and serves all of them that arrived, in one round.
+ *
+ * Call it in a loop. When it returns without serving anything (timeout), the
+ * vault is idle and avp_idle() can do its deferred work.
+ *
+ * @param daemon Open daemon.
+ * @param timeout_ms Longest wait for a request in milliseconds, -1 to wait forever.
+ * @param served Number of requests served (optional).
+ * @return AVP_OK on success, AVP_ERR_INTERNAL on socket error.
+ */
+avp_ret_t avp_daemon_run(avp_daemon_t *daemon, int timeout_ms, size_t *served);
+
+/**
+ * @brief Disconnects all agents, wipes their PINs and removes the socket.
+ *
+ * @param daemon Open daemon.
+ */
+void avp_daemon_close(avp_daemon_t *daemon);
+
+#ifdef AVP_DAEMON_QOS
+/**
+ * @brief Sets the QoS settings of the agents of a workspace.
+ *
+ * Every agent has a token bucket of chip time, refilled by rate_us per
+ * second up to burst_us; a request arriving at an empty bucket is refused
+ * with AVP_ERR_CAPACITY_EXCEEDED. Requests are admitted to a round in the
+ * order of their virtual finish time, cost / weight after the previous
+ * request of the agent, up to AVP_DAEMON_QOS_ROUND_US of chip time; the
+ * rest wait for the next round, and requests beyond AVP_DAEMON_QOS_QUEUE_US
+ * are refused with AVP_ERR_CAPACITY_EXCEEDED.
+ *
+ * @param daemon Open daemon.
+ * @param workspace Workspace, NULL for the workspaces without their own settings.
+ * @param qos Settings, NULL removes those of the workspace.
+ * @return AVP_OK on success, AVP_ERR_CAPACITY_EXCEEDED if AVP_DAEMON_QOS_TENANTS
+ *         workspaces have their own settings, AVP_ERR_INTERNAL on invalid parameters.
+ */
+avp_ret_t avp_daemon_set_qos(avp_daemon_t *daemon, const char *workspace, const avp_daemon_qos_t *qos);
+#endif
+
+#ifdef AVP_METRICS
+/**
+ * @brief Writes the counters of the daemon and of its vault in the OpenMetrics text format.
+ *
+ * Requests per operation, rounds, queue depth and connected agents, hits,
+ * misses and hit ratio of the secret, public key and certificate caches and,
+ * with libtropic built with LT_METRICS, its statistics of the device (labelled
+ * device="vault"). The text is what a METRICS request returns, e.g. for a
+ * textfile collector or an HTTP sidecar scraped by Prometheus.
+ *
+ * @param daemon Open daemon.
+ * @param text Buffer for the text, terminated by a null character.
+ * @param max_len Size of text.
+ * @param len Length of the text without the null character.
+ * @return AVP_OK on success, AVP_ERR_CAPACITY_EXCEEDED if the text does not
+ *         fit, AVP_ERR_INTERNAL on invalid parameters.
+ */
+avp_ret_t avp_daemon_metrics(const avp_daemon_t *daemon, char *text, size_t max_len, size_t *len);
+#endif
+
+/**
+ * @brief Connects to the daemon and maps the shared memory of the connection.
+ *
+ * @param agent Agent to connect.
+ * @param path Path of the socket of the daemon.
+ * @return AVP_OK on success, AVP_ERR_CAPACITY_EXCEEDED if the daemon serves
+ *         AVP_DAEMON_CLIENTS agents already, AVP_ERR_INTERNAL on socket error.
+ */
+avp_ret_t avp_agent_connect(avp_agent_t *agent, const char *path);
+
+/**
+ * @brief Disconnects from the daemon.
+ *
+ * @param agent Connected agent.
+ */
+void avp_agent_disconnect(avp_agent_t *agent);
+
+/** @brief avp_authenticate() through the daemon, other operations fail with AVP_ERR_NOT_INITIALIZED before it. */
+avp_ret_t avp_agent_authenticate(avp_agent_t *agent, const char *workspace, const char *pin, uint32_t ttl_seconds);
+
+/** @brief avp_store() through the daemon, value_len is at most AVP_DAEMON_SHM_LEN. */
+avp_ret_t avp_agent_store(avp_agent_t *agent, const char *name, const uint8_t *value, size_t value_len);
+
+/** @brief avp_retrieve() through the daemon. */
+avp_ret_t avp_agent_retrieve(avp_agent_t *agent, const char *name, uint8_t *value, size_t *value_len);
+
+/** @brief avp_delete() through the daemon. */
+avp_ret_t avp_agent_delete(avp_agent_t *agent, const char *name, bool *deleted);
+
+/** @brief avp_list() through the daemon, at most AVP_DAEMON_SHM_LEN / sizeof(avp_secret_metadata_t) secrets. */
+avp_ret_t avp_agent_list(avp_agent_t *agent, avp_secret_metadata_t *secrets, size_t max_secrets, size_t *count);
+
+/**
+ * @brief avp_daemon_metrics() through the daemon, needs no AUTHENTICATE.
+ *
+ * Fails with AVP_ERR_INTERNAL if the daemon is built without AVP_METRICS.
+ */
+avp_ret_t avp_agent_metrics(avp_agent_t *agent, char *text, size_t max_len, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AVP_DAEMON_H */
@@ -0,0 +1,740 @@
+/**
+ * @file avp_host_log.c
+ * @brief Append-only log of envelope ciphertexts with a memory-mapped hash index (POSIX).
+ *
+ * @copyright Copyright (c) 2026 AVP Protocol Contributors
+ * @license Apache-2.0 (see LICENSE)
+ */
+
+#include "avp_host_log.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*=============================================================================
+ * Constants
+ *============================================================================*/
+
+/*
+ * Log record: magic | type (1 B) | workspace length (1 B) | name length (1 B) | 0 (1 B) |
+ * version | data length | check (4 B each) | workspace | name | data, little endian.
+ * Check is FNV-1a (32-bit) of the record without the check field, it detects a torn tail.
+ */
+#define AVP_LOG_MAGIC 0x4c505641UL /* "AVPL" */
+#define AVP_LOG_HDR_LEN 20
+#define AVP_LOG_CHECK_OFF 16
+
+/* Record types: ciphertext of a version, removal of all other versions of the name */
+#define AVP_LOG_PUT 1
+#define AVP_LOG_REMOVE 2
+
+#define AVP_IDX_MAGIC 0x58505641UL /* "AVPX" */
+#define AVP_IDX_VERSION 1
+
+/* Keys of free and removed index entries, name hashes are remapped above them */
+#define AVP_IDX_EMPTY 0
+#define AVP_IDX_TOMBSTONE 1
+
+/* Chunk of the log copied or checked at once */
+#define AVP_LOG_CHUNK_LEN 4096
+
+/*=============================================================================
+ * Types
+ *============================================================================*/
+
+/* Index entry of one version, 24 B */
+typedef struct avp_host_log_entry_t {
+    uint64_t key;
+    uint64_t offset;
+    uint32_t version;
+    uint32_t data_len;
+} avp_host_log_entry_t;
+
+/* Index file: header | buckets entries, native byte order (the index is local to the host) */
+struct avp_host_log_index_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t buckets;
+    /* Entries not empty, i.e. live and tombstones */
+    uint32_t used;
+    uint32_t live;
+    /* Set by avp_host_log_close(), cleared while the store is open */
+    uint32_t clean;
+    /* Bytes of the log covered by the index */
+    uint64_t log_len;
+    /* Bytes of the log not referenced by live entries */
+    uint64_t dead;
+    avp_host_log_entry_t entries[];
+};
+
+/* Decoded header of a log record */
+typedef struct avp_log_rec_t {
+    uint8_t type;
+    uint8_t ws_len;
+    uint8_t name_len;
+    uint32_t version;
+    uint32_t data_len;
+    uint32_t check;
+} avp_log_rec_t;
+
+/* Workspace and name of a secret with their hash, key of the index */
+typedef struct avp_log_key_t {
+    const uint8_t *ws;
+    uint8_t ws_len;
+    const uint8_t *name;
+    uint8_t name_len;
+    uint64_t hash;
+} avp_log_key_t;
+
+/*=============================================================================
+ * Helpers
+ *============================================================================*/
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t check_update(uint32_t check, const uint8_t *p, size_t len)
+{
+    /* FNV-1a, 32-bit */
+    for (size_t i = 0; i < len; i++) {
+        check ^= p[i];
+        check *= 0x01000193UL;
+    }
+    return check;
+}
+
+static void key_make(avp_log_key_t *key, const uint8_t *ws, uint8_t ws_len, const uint8_t *name, uint8_t name_len)
+{
+    /* FNV-1a, 64-bit, of workspace | 0 | name */
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < ws_len; i++) {
+        hash ^= ws[i];
+        hash *= 0x100000001b3ULL;
+    }
+    hash *= 0x100000001b3ULL;
+    for (size_t i = 0; i < name_len; i++) {
+        hash ^= name[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    key->ws = ws;
+    key->ws_len = ws_len;
+    key->name = name;
+    key->name_len = name_len;
+    key->hash = (hash > AVP_IDX_TOMBSTONE) ? hash : AVP_IDX_TOMBSTONE + 1;
+}
+
+/* Key of the name in the current workspace of the store, false if the name is too long */
+static bool key_of(const avp_host_log_t *log, const char *name, avp_log_key_t *key)
+{
+    size_t name_len = strlen(name);
+    if (name_len == 0 || name_len > 255) {
+        return false;
+    }
+
+    key_make(key, (const uint8_t *)log->workspace, log->workspace_len, (const uint8_t *)name, (uint8_t)name_len);
+    return true;
+}
+
+static bool full_pwrite(int fd, const uint8_t *buf, size_t len, uint64_t off)
+{
+    while (len > 0) {
+        ssize_t n = pwrite(fd, buf, len, (off_t)off);
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= (size_t)n;
+        off += (uint64_t)n;
+    }
+    return true;
+}
+
+static bool full_pread(int fd, uint8_t *buf, size_t len, uint64_t off)
+{
+    while (len > 0) {
+        ssize_t n = pread(fd, buf, len, (off_t)off);
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= (size_t)n;
+        off += (uint64_t)n;
+    }
+    return true;
+}
+
+static size_t rec_size(const avp_log_rec_t *rec)
+{
+    return AVP_LOG_HDR_LEN + rec->ws_len + rec->name_len + rec->data_len;
+}
+
+/* Encodes the header and the strings of the key, returns their length */
+static size_t rec_encode(const avp_log_rec_t *rec, const avp_log_key_t *key, uint8_t *buf)
+{
+    put_u32(&buf[0], AVP_LOG_MAGIC);
+    buf[4] = rec->type;
+    buf[5] = rec->ws_len;
+    buf[6] = rec->name_len;
+    buf[7] = 0;
+    put_u32(&buf[8], rec->version);
+    put_u32(&buf[12], rec->data_len);
+    memcpy(&buf[AVP_LOG_HDR_LEN], key->ws, rec->ws_len);
+    memcpy(&buf[AVP_LOG_HDR_LEN + rec->ws_len], key->name, rec->name_len);
+
+    return AVP_LOG_HDR_LEN + rec->ws_len + rec->name_len;
+}
+
+/* Reads header and strings (at most AVP_LOG_HDR_LEN + 2 * 255 bytes) of the record at off */
+static bool rec_read(const avp_host_log_t *log, uint64_t off, avp_log_rec_t *rec, uint8_t *buf)
+{
+    if (!full_pread(log->log_fd, buf, AVP_LOG_HDR_LEN, off) || get_u32(&buf[0]) != AVP_LOG_MAGIC) {
+        return false;
+    }
+
+    rec->type = buf[4];
+    rec->ws_len = buf[5];
+    rec->name_len = buf[6];
+    rec->version = get_u32(&buf[8]);
+    rec->data_len = get_u32(&buf[12]);
+    rec->check = get_u32(&buf[AVP_LOG_CHECK_OFF]);
+
+    return full_pread(log->log_fd, &buf[AVP_LOG_HDR_LEN], (size_t)rec->ws_len + rec->name_len,
+                      off + AVP_LOG_HDR_LEN);
+}
+
+/* Tells whether the record read by rec_read() belongs to the key */
+static bool rec_matches(const avp_log_rec_t *rec, const uint8_t *buf, const avp_log_key_t *key)
+{
+    return rec->ws_len == key->ws_len && rec->name_len == key->name_len
+           && memcmp(&buf[AVP_LOG_HDR_LEN], key->ws, key->ws_len) == 0
+           && memcmp(&buf[AVP_LOG_HDR_LEN + key->ws_len], key->name, key->name_len) == 0;
+}
+
+/* Verifies the check of the record read by rec_read(), data (if not NULL) are the data read already */
+static bool rec_check(const avp_host_log_t *log, uint64_t off, const avp_log_rec_t *rec, const uint8_t *buf,
+                      const uint8_t *data)
+{
+    uint32_t check = check_update(0x811c9dc5UL, buf, AVP_LOG_CHECK_OFF);
+    check = check_update(check, &buf[AVP_LOG_HDR_LEN], (size_t)rec->ws_len + rec->name_len);
+
+    if (data != NULL) {
+        check = check_update(check, data, rec->data_len);
+    }
+    else {
+        uint8_t chunk[AVP_LOG_CHUNK_LEN];
+        uint64_t pos = off + AVP_LOG_HDR_LEN + rec->ws_len + rec->name_len;
+        for (size_t done = 0; done < rec->data_len;) {
+            size_t n = (rec->data_len - done < sizeof(chunk)) ? rec->data_len - done : sizeof(chunk);
+            if (!full_pread(log->log_fd, chunk, n, pos + done)) {
+                return false;
+            }
+            check = check_update(check, chunk, n);
+            done += n;
+        }
+    }
+
+    return check == rec->check;
+}
+
+/*=============================================================================
+ * Index
+ *
+ * Open addressing with linear probing over a power of 2 buckets. Every version
+ * of a name has its own entry; removed ones become tombstones, so probe
+ * sequences stay intact until compaction builds a new index.
+ *============================================================================*/
+
+/* Tells whether the entry, whose hash matches, belongs to the key (the name resolves unlikely collisions) */
+static bool entry_matches(const avp_host_log_t *log, const avp_host_log_entry_t *entry, const avp_log_key_t *key)
+{
+    uint8_t buf[AVP_LOG_HDR_LEN + 2 * 255];
+    avp_log_rec_t rec;
+    return rec_read(log, entry->offset, &rec, buf) && rec_matches(&rec, buf, key);
+}
+
+static uint64_t entry_size(const avp_log_key_t *key, const avp_host_log_entry_t *entry)
+{
+    return AVP_LOG_HDR_LEN + key->ws_len + key->name_len + entry->data_len;
+}
+
+/* Finds the entry of the version of the key */
+static avp_host_log_entry_t *idx_find(const avp_host_log_t *log, const avp_log_key_t *key, uint32_t version)
+{
+    avp_host_log_index_t *idx = log->idx;
+    uint32_t mask = idx->buckets - 1;
+
+    for (uint32_t n = 0, i = (uint32_t)key->hash & mask; n < idx->buckets; n++, i = (i + 1) & mask) {
+        avp_host_log_entry_t *entry = &idx->entries[i];
+        if (entry->key == AVP_IDX_EMPTY) {
+            break;
+        }
+        if (entry->key == key->hash && entry->version == version && entry_matches(log, entry, key)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static void idx_insert(avp_host_log_index_t *idx, const avp_host_log_entry_t *new_entry)
+{
+    uint32_t mask = idx->buckets - 1;
+    for (uint32_t i = (uint32_t)new_entry->key & mask;; i = (i + 1) & mask) {
+        avp_host_log_entry_t *entry = &idx->entries[i];
+        if (entry->key == AVP_IDX_EMPTY || entry->key == AVP_IDX_TOMBSTONE) {
+            idx->used += (entry->key == AVP_IDX_EMPTY);
+            *entry = *new_entry;
+            idx->live++;
+            return;
+        }
+    }
+}
+
+/* Indexes the version appended at off, replaces the entry of the same version if any */
+static void idx_put(avp_host_log_t *log, const avp_log_key_t *key, uint32_t version, uint32_t data_len, uint64_t off)
+{
+    avp_host_log_entry_t *entry = idx_find(log, key, version);
+    if (entry != NULL) {
+        log->idx->dead += entry_size(key, entry);
+        entry->offset = off;
+        entry->data_len = data_len;
+        return;
+    }
+
+    avp_host_log_entry_t new_entry = {.key = key->hash, .offset = off, .version = version, .data_len = data_len};
+    idx_insert(log->idx, &new_entry);
+}
+
+/* Turns all versions of the key except keep_version into tombstones */
+static void idx_remove(avp_host_log_t *log, const avp_log_key_t *key, uint32_t keep_version)
+{
+    avp_host_log_index_t *idx = log->idx;
+    uint32_t mask = idx->buckets - 1;
+
+    for (uint32_t n = 0, i = (uint32_t)key->hash & mask; n < idx->buckets; n++, i = (i + 1) & mask) {
+        avp_host_log_entry_t *entry = &idx->entries[i];
+        if (entry->key == AVP_IDX_EMPTY) {
+            break;
+        }
+        if (entry->key == key->hash && entry->version != keep_version && entry_matches(log, entry, key)) {
+            idx->dead += entry_size(key, entry);
+            entry->key = AVP_IDX_TOMBSTONE;
+            idx->live--;
+        }
+    }
+}
+
+/* Creates empty index of the given size in the file and maps it */
+static avp_host_log_index_t *idx_create(int fd, uint32_t buckets, size_t *size)
+{
+    *size = sizeof(avp_host_log_index_t) + (size_t)buckets * sizeof(avp_host_log_entry_t);
+    if (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)*size) != 0) {
+        return NULL;
+    }
+
+    void *map = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    avp_host_log_index_t *idx = map;
+    idx->magic = AVP_IDX_MAGIC;
+    idx->version = AVP_IDX_VERSION;
+    idx->buckets = buckets;
+    return idx;
+}
+
+/* Maps the index file if it was closed cleanly and covers the whole log */
+static bool idx_map(avp_host_log_t *log, uint64_t log_size)
+{
+    struct stat st;
+    avp_host_log_index_t hdr;
+    if (fstat(log->idx_fd, &st) != 0 || (size_t)st.st_size < sizeof(hdr)
+        || !full_pread(log->idx_fd, (uint8_t *)&hdr, sizeof(hdr), 0)) {
+        return false;
+    }
+
+    if (hdr.magic != AVP_IDX_MAGIC || hdr.version != AVP_IDX_VERSION || !hdr.clean || hdr.log_len != log_size
+        || hdr.buckets == 0 || (hdr.buckets & (hdr.buckets - 1)) != 0
+        || (size_t)st.st_size != sizeof(hdr) + (size_t)hdr.buckets * sizeof(avp_host_log_entry_t)) {
+        return false;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, log->idx_fd, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    log->idx = map;
+    log->idx_size = (size_t)st.st_size;
+    return true;
+}
+
+/* Builds the index by one scan of the log, cuts off a torn record at its end */
+static avp_ret_t idx_rebuild(avp_host_log_t *log, uint64_t log_size)
+{
+    uint32_t buckets = AVP_HOST_LOG_BUCKETS;
+
+    for (;;) {
+        log->idx = idx_create(log->idx_fd, buckets, &log->idx_size);
+        if (log->idx == NULL) {
+            return AVP_ERR_INTERNAL;
+        }
+
+        uint8_t buf[AVP_LOG_HDR_LEN + 2 * 255];
+        uint64_t off = 0;
+        bool full = false;
+        while (!full && off + AVP_LOG_HDR_LEN <= log_size) {
+            avp_log_rec_t rec;
+            if (!rec_read(log, off, &rec, buf) || off + rec_size(&rec) > log_size
+                || !rec_check(log, off, &rec, buf, NULL)) {
+                break;
+            }
+
+            /* Records of all workspaces are indexed, each under its own key */
+            avp_log_key_t key;
+            key_make(&key, &buf[AVP_LOG_HDR_LEN], rec.ws_len, &buf[AVP_LOG_HDR_LEN + rec.ws_len], rec.name_len);
+            if (rec.type == AVP_LOG_PUT) {
+                idx_put(log, &key, rec.version, rec.data_len, off);
+            }
+            else {
+                idx_remove(log, &key, rec.version);
+                log->idx->dead += rec_size(&rec);
+            }
+            off += rec_size(&rec);
+            full = (log->idx->used > buckets / 4 * 3);
+        }
+
+        if (!full) {
+            if (off < log_size && ftruncate(log->log_fd, (off_t)off) != 0) {
+                return AVP_ERR_INTERNAL;
+            }
+            log->idx->log_len = off;
+            return AVP_OK;
+        }
+
+        /* Rebuild into a bigger index */
+        munmap(log->idx, log->idx_size);
+        log->idx = NULL;
+        buckets *= 2;
+    }
+}
+
+/*=============================================================================
+ * Host Storage Callbacks
+ *============================================================================*/
+
+static avp_ret_t log_put(void *ctx, const char *name, uint32_t version, const uint8_t *data, size_t len)
+{
+    avp_host_log_t *log = ctx;
+    avp_log_key_t key;
+    if (!key_of(log, name, &key) || len > UINT32_MAX) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    /* Keep probe sequences short, compaction drops the tombstones and grows the index */
+    if (log->idx->used + 1 > log->idx->buckets / 4 * 3) {
+        avp_ret_t ret = avp_host_log_compact(log);
+        if (ret != AVP_OK) {
+            return ret;
+        }
+    }
+
+    avp_log_rec_t rec = {.type = AVP_LOG_PUT,
+                         .ws_len = key.ws_len,
+                         .name_len = key.name_len,
+                         .version = version,
+                         .data_len = (uint32_t)len};
+    uint8_t buf[AVP_LOG_HDR_LEN + 2 * 255];
+    size_t hdr_len = rec_encode(&rec, &key, buf);
+    uint32_t check = check_update(0x811c9dc5UL, buf, AVP_LOG_CHECK_OFF);
+    check = check_update(check, &buf[AVP_LOG_HDR_LEN], hdr_len - AVP_LOG_HDR_LEN);
+    put_u32(&buf[AVP_LOG_CHECK_OFF], check_update(check, data, len));
+
+    /* Record is durable before it is indexed, and before TROPIC01 references the version */
+    uint64_t off = log->idx->log_len;
+    if (!full_pwrite(log->log_fd, buf, hdr_len, off) || !full_pwrite(log->log_fd, data, len, off + hdr_len)
+        || fdatasync(log->log_fd) != 0) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    idx_put(log, &key, version, (uint32_t)len, off);
+    log->idx->log_len = off + hdr_len + len;
+
+    return AVP_OK;
+}
+
+static avp_ret_t log_get(void *ctx, const char *name, uint32_t version, uint8_t *data, size_t *len)
+{
+    avp_host_log_t *log = ctx;
+    avp_log_key_t key;
+    avp_host_log_entry_t *entry = key_of(log, name, &key) ? idx_find(log, &key, version) : NULL;
+    if (entry == NULL) {
+        return AVP_ERR_SECRET_NOT_FOUND;
+    }
+    if (*len < entry->data_len) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    uint8_t buf[AVP_LOG_HDR_LEN + 2 * 255];
+    avp_log_rec_t rec;
+    if (!rec_read(log, entry->offset, &rec, buf)
+        || !full_pread(log->log_fd, data, entry->data_len,
+                       entry->offset + AVP_LOG_HDR_LEN + rec.ws_len + rec.name_len)
+        || !rec_check(log, entry->offset, &rec, buf, data)) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    *len = entry->data_len;
+    return AVP_OK;
+}
+
+static avp_ret_t log_remove(void *ctx, const char *name, uint32_t keep_version)
+{
+    avp_host_log_t *log = ctx;
+    avp_log_key_t key;
+    if (!key_of(log, name, &key)) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    avp_log_rec_t rec = {.type = AVP_LOG_REMOVE,
+                         .ws_len = key.ws_len,
+                         .name_len = key.name_len,
+                         .version = keep_version,
+                         .data_len = 0};
+    uint8_t buf[AVP_LOG_HDR_LEN + 2 * 255];
+    size_t hdr_len = rec_encode(&rec, &key, buf);
+    uint32_t check = check_update(0x811c9dc5UL, buf, AVP_LOG_CHECK_OFF);
+    put_u32(&buf[AVP_LOG_CHECK_OFF], check_update(check, &buf[AVP_LOG_HDR_LEN], hdr_len - AVP_LOG_HDR_LEN));
+
+    /* Removal must survive a restart, otherwise rebuilt index would bring removed versions back */
+    uint64_t off = log->idx->log_len;
+    if (!full_pwrite(log->log_fd, buf, hdr_len, off) || fdatasync(log->log_fd) != 0) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    idx_remove(log, &key, keep_version);
+    log->idx->log_len = off + hdr_len;
+    log->idx->dead += hdr_len;
+
+    return AVP_OK;
+}
+
+/*=============================================================================
+ * Public Functions
+ *============================================================================*/
+
+avp_ret_t avp_host_log_open(avp_host_log_t *log, const char *path, const char *workspace)
+{
+    if (log == NULL || path == NULL) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    if (workspace == NULL) {
+        workspace = "default";
+    }
+    size_t path_len = strlen(path);
+    size_t ws_len = strlen(workspace);
+    if (path_len == 0 || path_len >= AVP_HOST_LOG_PATH_MAX || ws_len >= sizeof(log->workspace)) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    memset(log, 0, sizeof(*log));
+    log->log_fd = -1;
+    log->idx_fd = -1;
+    memcpy(log->path, path, path_len + 1);
+    memcpy(log->workspace, workspace, ws_len + 1);
+    log->workspace_len = (uint8_t)ws_len;
+
+    char file[AVP_HOST_LOG_PATH_MAX + 8];
+    snprintf(file, sizeof(file), "%s.log", path);
+    log->log_fd = open(file, O_RDWR | O_CREAT, 0600);
+    snprintf(file, sizeof(file), "%s.idx", path);
+    log->idx_fd = open(file, O_RDWR | O_CREAT, 0600);
+
+    struct stat st;
+    avp_ret_t ret = AVP_ERR_INTERNAL;
+    if (log->log_fd >= 0 && log->idx_fd >= 0 && fstat(log->log_fd, &st) == 0) {
+        ret = idx_map(log, (uint64_t)st.st_size) ? AVP_OK : idx_rebuild(log, (uint64_t)st.st_size);
+    }
+
+    /* Unclean until closed, a crash in between makes the next open rebuild the index */
+    if (ret == AVP_OK) {
+        log->idx->clean = 0;
+        if (msync(log->idx, sizeof(*log->idx), MS_SYNC) != 0) {
+            ret = AVP_ERR_INTERNAL;
+        }
+    }
+
+    if (ret != AVP_OK) {
+        if (log->idx != NULL) {
+            munmap(log->idx, log->idx_size);
+        }
+        if (log->log_fd >= 0) {
+            close(log->log_fd);
+        }
+        if (log->idx_fd >= 0) {
+            close(log->idx_fd);
+        }
+        memset(log, 0, sizeof(*log));
+        log->log_fd = -1;
+        log->idx_fd = -1;
+    }
+
+    return ret;
+}
+
+avp_ret_t avp_host_log_close(avp_host_log_t *log)
+{
+    if (log == NULL || log->idx == NULL) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    /* Entries first, then the clean mark */
+    bool ok = (msync(log->idx, log->idx_size, MS_SYNC) == 0);
+    if (ok) {
+        log->idx->clean = 1;
+        ok = (msync(log->idx, sizeof(*log->idx), MS_SYNC) == 0);
+    }
+
+    munmap(log->idx, log->idx_size);
+    close(log->log_fd);
+    close(log->idx_fd);
+    memset(log, 0, sizeof(*log));
+    log->log_fd = -1;
+    log->idx_fd = -1;
+
+    return ok ? AVP_OK : AVP_ERR_INTERNAL;
+}
+
+void avp_host_log_store(avp_host_log_t *log, avp_host_store_t *store)
+{
+    store->put = log_put;
+    store->get = log_get;
+    store->remove = log_remove;
+    store->ctx = log;
+}
+
+bool avp_host_log_compact_due(const avp_host_log_t *log)
+{
+    const avp_host_log_index_t *idx = log->idx;
+    bool mostly_dead = (idx->dead >= AVP_HOST_LOG_COMPACT_MIN) && (idx->dead * 2 > idx->log_len);
+    bool filling = (idx->used > idx->buckets / 2);
+
+    return mostly_dead || filling;
+}
+
+avp_ret_t avp_host_log_compact(avp_host_log_t *log)
+{
+    if (log == NULL || log->idx == NULL) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    /* Index of the live entries at most half full */
+    uint32_t buckets = log->idx->buckets;
+    while (log->idx->live + 1 > buckets / 2) {
+        buckets *= 2;
+    }
+
+    char log_tmp[AVP_HOST_LOG_PATH_MAX + 8];
+    char idx_tmp[AVP_HOST_LOG_PATH_MAX + 8];
+    snprintf(log_tmp, sizeof(log_tmp), "%s.log~", log->path);
+    snprintf(idx_tmp, sizeof(idx_tmp), "%s.idx~", log->path);
+    int log_fd = open(log_tmp, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    int idx_fd = open(idx_tmp, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    size_t idx_size = 0;
+    avp_host_log_index_t *idx = (log_fd >= 0 && idx_fd >= 0) ? idx_create(idx_fd, buckets, &idx_size) : NULL;
+    bool ok = (idx != NULL);
+
+    /* Live records are copied as they are, in index order */
+    uint64_t off = 0;
+    for (uint32_t i = 0; ok && i < log->idx->buckets; i++) {
+        const avp_host_log_entry_t *entry = &log->idx->entries[i];
+        if (entry->key == AVP_IDX_EMPTY || entry->key == AVP_IDX_TOMBSTONE) {
+            continue;
+        }
+
+        uint8_t buf[AVP_LOG_HDR_LEN + 2 * 255];
+        avp_log_rec_t rec;
+        ok = rec_read(log, entry->offset, &rec, buf);
+        uint64_t size = ok ? rec_size(&rec) : 0;
+        uint8_t chunk[AVP_LOG_CHUNK_LEN];
+        for (uint64_t done = 0; ok && done < size;) {
+            size_t n = (size - done < sizeof(chunk)) ? (size_t)(size - done) : sizeof(chunk);
+            ok = full_pread(log->log_fd, chunk, n, entry->offset + done)
+                 && full_pwrite(log_fd, chunk, n, off + done);
+            done += n;
+        }
+
+        avp_host_log_entry_t new_entry = *entry;
+        new_entry.offset = off;
+        idx_insert(idx, &new_entry);
+        off += size;
+    }
+
+    if (ok) {
+        idx->log_len = off;
+        ok = (fdatasync(log_fd) == 0) && (msync(idx, idx_size, MS_SYNC) == 0);
+    }
+
+    /* Log first: until the index is replaced too, the index left is unclean and rebuilt at open */
+    char file[AVP_HOST_LOG_PATH_MAX + 8];
+    if (ok) {
+        snprintf(file, sizeof(file), "%s.log", log->path);
+        ok = (rename(log_tmp, file) == 0);
+        if (ok) {
+            snprintf(file, sizeof(file), "%s.idx", log->path);
+            ok = (rename(idx_tmp, file) == 0);
+            if (!ok) {
+                /* Old index does not describe the new log, stop using it */
+                munmap(log->idx, log->idx_size);
+                close(log->log_fd);
+                close(log->idx_fd);
+                log->idx = idx;
+                log->idx_size = idx_size;
+                log->log_fd = log_fd;
+                log->idx_fd = idx_fd;
+                return AVP_ERR_INTERNAL;
+            }
+        }
+    }
+
+    if (!ok) {
+        if (idx != NULL) {
+            munmap(idx, idx_size);
+        }
+        if (log_fd >= 0) {
+            close(log_fd);
+        }
+        if (idx_fd >= 0) {
+            close(idx_fd);
+        }
+        unlink(log_tmp);
+        unlink(idx_tmp);
+        return AVP_ERR_INTERNAL;
+    }
+
+    munmap(log->idx, log->idx_size);
+    close(log->log_fd);
+    close(log->idx_fd);
+    log->idx = idx;
+    log->idx_size = idx_size;
+    log->log_fd = log_fd;
+    log->idx_fd = idx_fd;
+
+    return AVP_OK;
+}
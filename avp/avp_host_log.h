@@ -0,0 +1,129 @@
+/**
+ * @file avp_host_log.h
+ * @brief Append-only log of envelope ciphertexts with a memory-mapped hash index (POSIX).
+ *
+ * Host storage for the AVP envelope mode (avp_host_store_t). Ciphertexts are
+ * appended to <path>.log as self-checking records, <path>.idx is a
+ * memory-mapped open-addressing table keyed by workspace, secret name and
+ * version, so a lookup is one probe sequence plus one read and opening the
+ * store parses nothing after a clean close. Removed and replaced versions are
+ * reclaimed by avp_host_log_compact(), intended for idle time.
+ *
+ * @copyright Copyright (c) 2026 AVP Protocol Contributors
+ * @license Apache-2.0 (see LICENSE)
+ */
+
+#ifndef AVP_HOST_LOG_H
+#define AVP_HOST_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avp_tropic.h"
+
+#ifndef AVP_ENVELOPE
+#error "AVP host log requires AVP_ENVELOPE"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Longest path of the store, without the ".log" / ".idx" suffix */
+#define AVP_HOST_LOG_PATH_MAX 256
+
+/** @brief Buckets of a new index (power of 2), the index doubles at compaction when half full */
+#ifndef AVP_HOST_LOG_BUCKETS
+#define AVP_HOST_LOG_BUCKETS 1024
+#endif
+
+/** @brief Dead bytes in the log below which compaction is not due */
+#ifndef AVP_HOST_LOG_COMPACT_MIN
+#define AVP_HOST_LOG_COMPACT_MIN (64 * 1024)
+#endif
+
+/** @brief Memory-mapped index file, private. */
+typedef struct avp_host_log_index_t avp_host_log_index_t;
+
+/**
+ * @brief Open log store, contents are private.
+ */
+typedef struct avp_host_log_t {
+    /** @brief Descriptor of the log */
+    int log_fd;
+
+    /** @brief Descriptor of the index */
+    int idx_fd;
+
+    /** @brief Mapped index */
+    avp_host_log_index_t *idx;
+
+    /** @brief Size of the mapping */
+    size_t idx_size;
+
+    /** @brief Path of the store, without suffix */
+    char path[AVP_HOST_LOG_PATH_MAX];
+
+    /** @brief Workspace the records belong to */
+    char workspace[256];
+
+    /** @brief Length of workspace */
+    uint8_t workspace_len;
+} avp_host_log_t;
+
+/**
+ * @brief Opens or creates the log store.
+ *
+ * The index is used as it is if it was closed cleanly and covers the whole
+ * log. Otherwise (crash, missing or foreign index file) it is rebuilt by one
+ * scan of the log, and a torn record at the end of the log is cut off.
+ *
+ * @param log Store to open.
+ * @param path Path of the store, ".log" and ".idx" are appended.
+ * @param workspace Workspace of the secrets (NULL for "default"), e.g. the workspace of avp_authenticate().
+ * @return AVP_OK on success, AVP_ERR_INTERNAL on invalid parameters or I/O error.
+ */
+avp_ret_t avp_host_log_open(avp_host_log_t *log, const char *path, const char *workspace);
+
+/**
+ * @brief Flushes the index, marks it clean and closes the store.
+ *
+ * @param log Open store.
+ * @return AVP_OK on success, AVP_ERR_INTERNAL on I/O error.
+ */
+avp_ret_t avp_host_log_close(avp_host_log_t *log);
+
+/**
+ * @brief Fills host storage callbacks for avp_envelope_enable() backed by the store.
+ *
+ * @param log Open store, must outlive the vault using it.
+ * @param store Host storage to fill.
+ */
+void avp_host_log_store(avp_host_log_t *log, avp_host_store_t *store);
+
+/**
+ * @brief Tells whether compaction is worth it: most of the log is dead or the index is getting full.
+ *
+ * @param log Open store.
+ * @return true if avp_host_log_compact() should run.
+ */
+bool avp_host_log_compact_due(const avp_host_log_t *log);
+
+/**
+ * @brief Rewrites the live records into a new log and index, then replaces the old ones by rename.
+ *
+ * Costs one copy of the live records; call it from avp_idle() time when
+ * avp_host_log_compact_due() says so. A crash leaves either the old or the
+ * new log, and the index is rebuilt at the next open.
+ *
+ * @param log Open store.
+ * @return AVP_OK on success, AVP_ERR_INTERNAL on I/O error (the old log stays in use).
+ */
+avp_ret_t avp_host_log_compact(avp_host_log_t *log);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AVP_HOST_LOG_H */
@@ -0,0 +1,270 @@
+/**
+ * @file avp_secure_arena.c
+ * @brief Locked arena with size-class slabs and guard pages for secret buffers (POSIX).
+ *
+ * @copyright Copyright (c) 2026 AVP Protocol Contributors
+ * @license Apache-2.0 (see LICENSE)
+ */
+
+#include "avp_secure_arena.h"
+
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "lt_secure_memzero.h"
+
+/*=============================================================================
+ * Layout
+ *
+ * Mapping: metadata (free stacks and lengths) | guard | slab 0 | ... | slab n.
+ * A slab of blocks smaller than a page is the blocks back-to-back, rounded up
+ * to whole pages, and a guard page. A slab of page-sized blocks is a run of
+ * block (rounded up to whole pages) | guard page, and the buffer of a block
+ * ends at its guard page, so an overrun faults at the first byte past the
+ * rounded length.
+ *============================================================================*/
+
+static size_t round_up(size_t len, size_t to)
+{
+    return (len + to - 1) / to * to;
+}
+
+/* Page size, read once by avp_arena_open() */
+static size_t page_len(void)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    return (page > 0) ? (size_t)page : 4096;
+}
+
+/* Bytes of one block available to the buffer, from the start of the block */
+static size_t block_room(size_t c, size_t page)
+{
+    size_t len = AVP_ARENA_BLOCK_LEN(c);
+    return (len >= page) ? round_up(len, page) : len;
+}
+
+/* Start of the buffer of len bytes in block i */
+static uint8_t *block_buf(const avp_arena_slab_t *slab, size_t c, size_t page, size_t i, size_t len)
+{
+    uint8_t *block = slab->base + i * slab->stride;
+    if (AVP_ARENA_BLOCK_LEN(c) < page) {
+        return block;
+    }
+
+    return block + block_room(c, page) - round_up(len, AVP_ARENA_ALIGN);
+}
+
+/* Size class and block of an allocated buffer, false if buf is not one */
+static bool block_find(const avp_arena_t *arena, const void *buf, size_t *c, size_t *i)
+{
+    if (arena == NULL || arena->map == NULL || buf == NULL) {
+        return false;
+    }
+
+    size_t page = arena->page;
+    const uint8_t *p = buf;
+    for (size_t k = 0; k < AVP_ARENA_CLASSES; k++) {
+        const avp_arena_slab_t *slab = &arena->slabs[k];
+        if (slab->base == NULL || p < slab->base || p >= slab->base + (size_t)slab->blocks * slab->stride) {
+            continue;
+        }
+
+        size_t idx = (size_t)(p - slab->base) / slab->stride;
+        if (slab->used[idx] == 0 || p != block_buf(slab, k, page, idx, slab->used[idx])) {
+            return false;
+        }
+        *c = k;
+        *i = idx;
+        return true;
+    }
+
+    return false;
+}
+
+/*=============================================================================
+ * Arena
+ *============================================================================*/
+
+avp_ret_t avp_arena_open(avp_arena_t *arena, const uint16_t blocks[AVP_ARENA_CLASSES])
+{
+    if (arena == NULL || blocks == NULL) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    memset(arena, 0, sizeof(*arena));
+    size_t page = page_len();
+    arena->page = page;
+
+    size_t total = 0;
+    for (size_t c = 0; c < AVP_ARENA_CLASSES; c++) {
+        total += blocks[c];
+    }
+    if (total == 0) {
+        return AVP_ERR_INTERNAL;
+    }
+    /* Lengths, then the free stack of each slab, padded to keep the next lengths aligned */
+    size_t meta_len = total * (sizeof(uint32_t) + sizeof(uint16_t)) + AVP_ARENA_CLASSES * sizeof(uint16_t);
+    meta_len = round_up(meta_len, page);
+
+    /* Offsets of the slabs first, the mapping is made at once */
+    size_t slab_off[AVP_ARENA_CLASSES];
+    size_t off = meta_len + page;
+    for (size_t c = 0; c < AVP_ARENA_CLASSES; c++) {
+        avp_arena_slab_t *slab = &arena->slabs[c];
+        slab->blocks = blocks[c];
+        slab_off[c] = off;
+        if (blocks[c] == 0) {
+            continue;
+        }
+        if (AVP_ARENA_BLOCK_LEN(c) >= page) {
+            slab->stride = block_room(c, page) + page;
+            off += (size_t)blocks[c] * slab->stride;
+        }
+        else {
+            slab->stride = AVP_ARENA_BLOCK_LEN(c);
+            off += round_up((size_t)blocks[c] * slab->stride, page) + page;
+        }
+    }
+
+    void *map = mmap(NULL, off, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        memset(arena, 0, sizeof(*arena));
+        return AVP_ERR_INTERNAL;
+    }
+    arena->map = map;
+    arena->map_len = off;
+#ifdef MADV_DONTDUMP
+    (void)madvise(map, off, MADV_DONTDUMP);
+#endif
+
+    /* Lock the metadata and the blocks, the pages in between become guards */
+    bool ok = (mlock(arena->map, meta_len) == 0) && (mprotect(arena->map + meta_len, page, PROT_NONE) == 0);
+    uint8_t *meta = arena->map;
+    for (size_t c = 0; c < AVP_ARENA_CLASSES && ok; c++) {
+        avp_arena_slab_t *slab = &arena->slabs[c];
+        if (slab->blocks == 0) {
+            continue;
+        }
+        slab->base = arena->map + slab_off[c];
+        slab->used = (uint32_t *)(void *)meta;
+        meta += (size_t)slab->blocks * sizeof(uint32_t);
+        slab->free = (uint16_t *)(void *)meta;
+        meta += round_up((size_t)slab->blocks * sizeof(uint16_t), sizeof(uint32_t));
+
+        if (AVP_ARENA_BLOCK_LEN(c) >= page) {
+            for (size_t i = 0; i < slab->blocks && ok; i++) {
+                uint8_t *block = slab->base + i * slab->stride;
+                ok = (mlock(block, block_room(c, page)) == 0)
+                     && (mprotect(block + block_room(c, page), page, PROT_NONE) == 0);
+            }
+        }
+        else {
+            size_t len = round_up((size_t)slab->blocks * slab->stride, page);
+            ok = (mlock(slab->base, len) == 0) && (mprotect(slab->base + len, page, PROT_NONE) == 0);
+        }
+
+        /* Lowest blocks are handed out first */
+        for (size_t i = 0; i < slab->blocks; i++) {
+            slab->free[i] = (uint16_t)(slab->blocks - 1 - i);
+        }
+        slab->free_cnt = slab->blocks;
+    }
+
+    if (!ok) {
+        /* munmap() drops the locks */
+        munmap(arena->map, arena->map_len);
+        memset(arena, 0, sizeof(*arena));
+        return AVP_ERR_INTERNAL;
+    }
+
+    return AVP_OK;
+}
+
+void avp_arena_close(avp_arena_t *arena)
+{
+    if (arena == NULL || arena->map == NULL) {
+        return;
+    }
+
+    size_t page = arena->page;
+    for (size_t c = 0; c < AVP_ARENA_CLASSES; c++) {
+        avp_arena_slab_t *slab = &arena->slabs[c];
+        if (slab->base == NULL) {
+            continue;
+        }
+        if (AVP_ARENA_BLOCK_LEN(c) >= page) {
+            for (size_t i = 0; i < slab->blocks; i++) {
+                lt_secure_memzero(slab->base + i * slab->stride, block_room(c, page));
+            }
+        }
+        else {
+            lt_secure_memzero(slab->base, (size_t)slab->blocks * slab->stride);
+        }
+    }
+
+    munmap(arena->map, arena->map_len);
+    memset(arena, 0, sizeof(*arena));
+}
+
+void *avp_arena_alloc(avp_arena_t *arena, size_t len)
+{
+    if (arena == NULL || arena->map == NULL || len == 0 || len > AVP_ARENA_BLOCK_LEN(AVP_ARENA_CLASSES - 1)) {
+        return NULL;
+    }
+
+    size_t c = 0;
+    while (AVP_ARENA_BLOCK_LEN(c) < len) {
+        c++;
+    }
+    for (; c < AVP_ARENA_CLASSES; c++) {
+        avp_arena_slab_t *slab = &arena->slabs[c];
+        if (slab->free_cnt == 0) {
+            continue;
+        }
+
+        size_t i = slab->free[--slab->free_cnt];
+        slab->used[i] = (uint32_t)len;
+        return block_buf(slab, c, arena->page, i, len);
+    }
+
+    return NULL;
+}
+
+avp_ret_t avp_arena_free(avp_arena_t *arena, void *buf)
+{
+    if (buf == NULL) {
+        return AVP_OK;
+    }
+
+    size_t c;
+    size_t i;
+    if (!block_find(arena, buf, &c, &i)) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    /* The buffer may have been used up to the end of its block */
+    avp_arena_slab_t *slab = &arena->slabs[c];
+    size_t page = arena->page;
+    uint8_t *end = slab->base + i * slab->stride + block_room(c, page);
+    lt_secure_memzero(buf, (size_t)(end - (uint8_t *)buf));
+
+    slab->used[i] = 0;
+    slab->free[slab->free_cnt++] = (uint16_t)i;
+
+    return AVP_OK;
+}
+
+bool avp_arena_owns(const avp_arena_t *arena, const void *buf, size_t *len)
+{
+    size_t c;
+    size_t i;
+    if (!block_find(arena, buf, &c, &i)) {
+        return false;
+    }
+
+    if (len != NULL) {
+        *len = arena->slabs[c].used[i];
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file avp_secure_arena.h
+ * @brief Locked arena with size-class slabs and guard pages for secret buffers (POSIX).
+ *
+ * The arena is one anonymous mapping set up once: every slab is mlock()ed and
+ * excluded from core dumps where supported, and PROT_NONE guard pages separate
+ * the slabs, so a secret neither reaches swap nor a neighbouring slab. Blocks
+ * of a page or larger get a guard page each and are handed out so that they
+ * end at it. Allocation pops a free block of the smallest fitting class, free
+ * wipes the block with lt_secure_memzero() and pushes it back; neither does a
+ * system call. The arena is not thread-safe.
+ *
+ * @copyright Copyright (c) 2026 AVP Protocol Contributors
+ * @license Apache-2.0 (see LICENSE)
+ */
+
+#ifndef AVP_SECURE_ARENA_H
+#define AVP_SECURE_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avp_tropic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Size classes, blocks of class c have AVP_ARENA_MIN_BLOCK << (2 * c) bytes (64 B to 64 KiB) */
+#define AVP_ARENA_CLASSES 6
+
+/** @brief Block size of the smallest class */
+#define AVP_ARENA_MIN_BLOCK 64
+
+/** @brief Block size of size class c */
+#define AVP_ARENA_BLOCK_LEN(c) ((size_t)AVP_ARENA_MIN_BLOCK << (2 * (c)))
+
+/** @brief Alignment of the returned buffers */
+#define AVP_ARENA_ALIGN 16
+
+/** @brief Slab of one size class, private. */
+typedef struct avp_arena_slab_t {
+    /** @brief First block, NULL if the class has no blocks */
+    uint8_t *base;
+    /** @brief Distance of the blocks, includes the guard page of page-sized blocks */
+    size_t stride;
+    /** @brief Blocks of the slab */
+    uint16_t blocks;
+    /** @brief Entries of free */
+    uint16_t free_cnt;
+    /** @brief Stack of the indices of free blocks */
+    uint16_t *free;
+    /** @brief Requested length of each allocated block, 0 if free */
+    uint32_t *used;
+} avp_arena_slab_t;
+
+/**
+ * @brief Secure arena, contents are private.
+ */
+typedef struct avp_arena_t {
+    /** @brief Whole mapping, metadata first, NULL if not open */
+    uint8_t *map;
+    /** @brief Length of the mapping */
+    size_t map_len;
+    /** @brief Page size */
+    size_t page;
+    /** @brief Slabs by size class */
+    avp_arena_slab_t slabs[AVP_ARENA_CLASSES];
+} avp_arena_t;
+
+/**
+ * @brief Maps, locks and guards the arena.
+ *
+ * @param arena Arena to open.
+ * @param blocks Blocks of each size class, 0 leaves the class out (at most 65535 each).
+ * @return AVP_OK on success, AVP_ERR_INTERNAL on invalid parameters, when the
+ *         mapping fails or the slabs cannot be locked (see RLIMIT_MEMLOCK).
+ */
+avp_ret_t avp_arena_open(avp_arena_t *arena, const uint16_t blocks[AVP_ARENA_CLASSES]);
+
+/**
+ * @brief Wipes all blocks, allocated or not, and unmaps the arena.
+ *
+ * @param arena Open arena, buffers allocated from it are invalid afterwards.
+ */
+void avp_arena_close(avp_arena_t *arena);
+
+/**
+ * @brief Allocates a zeroed buffer from the smallest class with a free block of at least len bytes.
+ *
+ * @param arena Open arena.
+ * @param len Bytes needed, 1 - AVP_ARENA_BLOCK_LEN(AVP_ARENA_CLASSES - 1).
+ * @return Buffer aligned to AVP_ARENA_ALIGN, NULL if len is out of range or no fitting block is free.
+ */
+void *avp_arena_alloc(avp_arena_t *arena, size_t len);
+
+/**
+ * @brief Wipes the buffer and returns it to its slab.
+ *
+ * @param arena Arena the buffer was allocated from.
+ * @param buf Buffer returned by avp_arena_alloc(), NULL is accepted.
+ * @return AVP_OK on success, AVP_ERR_INTERNAL if buf is not an allocated buffer of the arena.
+ */
+avp_ret_t avp_arena_free(avp_arena_t *arena, void *buf);
+
+/**
+ * @brief Tells whether the buffer is an allocated buffer of the arena.
+ *
+ * @param arena Open arena.
+ * @param buf Buffer to check.
+ * @param len Length requested for it at avp_arena_alloc() (optional).
+ * @return true if buf was returned by avp_arena_alloc() and not freed since.
+ */
+bool avp_arena_owns(const avp_arena_t *arena, const void *buf, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AVP_SECURE_ARENA_H */
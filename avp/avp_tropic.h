@@ -23,6 +23,10 @@
 
 #include "libtropic.h"
 
+#ifndef LT_PIN
+#error "AVP PIN login requires libtropic built with LT_PIN"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -60,6 +64,333 @@ typedef enum {
 /** @brief Session ID prefix as per AVP spec */
 #define AVP_SESSION_PREFIX "avp_sess_"
 
+/** @brief Bytes of TROPIC01 randomness fetched at once for session IDs, nonces etc. */
+#ifndef AVP_ENTROPY_POOL_LEN
+#define AVP_ENTROPY_POOL_LEN TR01_RANDOM_VALUE_GET_LEN_MAX
+#endif
+
+/*=============================================================================
+ * AVP Secret Directory
+ *============================================================================*/
+
+/** @brief First R-memory slot used for AVP secrets (AVP_TROPIC_KEY_SLOTS slots follow) */
+#ifndef AVP_SECRET_FIRST_SLOT
+#define AVP_SECRET_FIRST_SLOT 0
+#endif
+
+/** @brief Directory entries stored in one R-memory slot (8 bytes each) */
+#define AVP_DIR_ENTRIES_PER_SLOT 32
+
+/** @brief Number of R-memory slots reserved for the directory */
+#define AVP_DIR_SLOTS (AVP_TROPIC_KEY_SLOTS / AVP_DIR_ENTRIES_PER_SLOT)
+
+/** @brief First R-memory slot reserved for the directory */
+#ifndef AVP_DIR_FIRST_SLOT
+#define AVP_DIR_FIRST_SLOT (AVP_SECRET_FIRST_SLOT + AVP_TROPIC_KEY_SLOTS)
+#endif
+
+/** @brief First of the 1 + AVP_DIR_SLOTS R-memory slots of the batch commit journal */
+#ifndef AVP_JOURNAL_SLOT
+#define AVP_JOURNAL_SLOT (AVP_DIR_FIRST_SLOT + AVP_DIR_SLOTS)
+#endif
+
+/** @brief R-memory slot of the secret slot write counters */
+#ifndef AVP_WEAR_SLOT
+#define AVP_WEAR_SLOT (AVP_JOURNAL_SLOT + 1 + AVP_DIR_SLOTS)
+#endif
+
+/** @brief R-memory slot of the key directory (name hash of each ECC key slot) */
+#ifndef AVP_KEY_DIR_SLOT
+#define AVP_KEY_DIR_SLOT (AVP_WEAR_SLOT + 1)
+#endif
+
+/** @brief R-memory slot of the PIN attempt counter and encrypted secret (see lt_pin_init()) */
+#ifndef AVP_PIN_SLOT
+#define AVP_PIN_SLOT (AVP_KEY_DIR_SLOT + 1)
+#endif
+
+/** @brief First MAC-and-Destroy slot used for the PIN, one slot per attempt */
+#ifndef AVP_PIN_MACANDD_SLOT
+#define AVP_PIN_MACANDD_SLOT TR01_MAC_AND_DESTROY_SLOT_0
+#endif
+
+/** @brief Wrong PINs in a row after which the vault is locked for good */
+#ifndef AVP_PIN_ATTEMPTS
+#define AVP_PIN_ATTEMPTS 10
+#endif
+
+#if (AVP_PIN_ATTEMPTS < 1) || (AVP_PIN_ATTEMPTS > LT_PIN_ROUNDS_MAX)
+#error "AVP_PIN_ATTEMPTS must be between 1 and LT_PIN_ROUNDS_MAX"
+#endif
+
+/** @brief First ECC key slot of TROPIC01 used for AVP signing keys */
+#ifndef AVP_ECC_FIRST_SLOT
+#define AVP_ECC_FIRST_SLOT TR01_ECC_SLOT_0
+#endif
+
+/** @brief Number of ECC key slots used for AVP signing keys */
+#ifndef AVP_ECC_KEY_SLOTS
+#define AVP_ECC_KEY_SLOTS (TR01_ECC_SLOT_31 + 1 - AVP_ECC_FIRST_SLOT)
+#endif
+
+/** @brief Buckets of the RAM name index (power of 2, load factor <= 0.5) */
+#define AVP_DIR_BUCKETS (2 * AVP_TROPIC_KEY_SLOTS)
+
+/** @brief Buckets of the name index whose tags are compared at once (one SSE2 / NEON vector) */
+#define AVP_DIR_GROUP 16
+
+/**
+ * @brief Monotonic counter decremented on every change of the stored secrets.
+ *
+ * Directory and metadata catalog mirrored in RAM are dropped when the counter
+ * differs at the next AUTHENTICATE (vault changed by another host).
+ */
+#ifndef AVP_MCOUNTER_INDEX
+#define AVP_MCOUNTER_INDEX TR01_MCOUNTER_INDEX_15
+#endif
+
+/**
+ * @brief Current time in seconds (Unix epoch), used for timestamps of secrets and sessions.
+ *
+ * Define to the RTC of the target if time() is not backed by one. TTLs are
+ * measured by the monotonic AVP_CLOCK_S() instead.
+ */
+#ifndef AVP_TIME_NOW
+#include <time.h>
+#define AVP_TIME_NOW() ((uint32_t)time(NULL))
+#endif
+
+/*
+ * AVP_CLOCK_S(): monotonic clock in seconds for session and PIN TTLs, optional.
+ * Without it, CLOCK_MONOTONIC_COARSE is used where available (read from the
+ * vDSO on Linux, no syscall), then lt_port_time_us() if libtropic is built
+ * with it, then AVP_TIME_NOW().
+ */
+
+/*=============================================================================
+ * AVP Secret Cache (opt-in, define AVP_SECRET_CACHE)
+ *============================================================================*/
+
+#ifdef AVP_SECRET_CACHE
+
+/** @brief Number of secrets kept in the cache (least recently used one is evicted) */
+#ifndef AVP_SECRET_CACHE_ENTRIES
+#define AVP_SECRET_CACHE_ENTRIES 4
+#endif
+
+/** @brief Longest value kept in the cache, longer secrets are always read from TROPIC01 */
+#ifndef AVP_SECRET_CACHE_VALUE_LEN
+#define AVP_SECRET_CACHE_VALUE_LEN 512
+#endif
+
+/**
+ * @brief Plaintext copy of one retrieved secret.
+ */
+typedef struct avp_cache_entry_t {
+    /** @brief Value of the secret */
+    uint8_t value[AVP_SECRET_CACHE_VALUE_LEN];
+    /** @brief Length of value */
+    size_t value_len;
+    /** @brief LRU tick of the last use */
+    uint32_t last_used;
+    /** @brief Head slot of the secret */
+    uint8_t slot;
+    /** @brief Entry holds a secret */
+    bool used;
+#ifdef AVP_SECRET_REFRESH
+    /** @brief Name hash of the secret, finds it again after the directory was reloaded */
+    uint64_t name_hash;
+    /** @brief Time the value was read from TROPIC01 (monotonic clock) */
+    uint32_t fetched_at;
+    /** @brief Directory version (monotonic counter value) the value was read at */
+    uint32_t version;
+#endif
+} avp_cache_entry_t;
+
+#endif /* AVP_SECRET_CACHE */
+
+/*=============================================================================
+ * AVP Secret Refresh (opt-in, define AVP_SECRET_REFRESH)
+ *============================================================================*/
+
+#ifdef AVP_SECRET_REFRESH
+
+#ifndef AVP_SECRET_CACHE
+#error "AVP_SECRET_REFRESH requires AVP_SECRET_CACHE"
+#endif
+
+/** @brief Cached value is served at most this many seconds after it was read from TROPIC01 */
+#ifndef AVP_SECRET_REFRESH_TTL_S
+#define AVP_SECRET_REFRESH_TTL_S 60
+#endif
+
+/** @brief Entries this many seconds before their TTL are read again by avp_idle() */
+#ifndef AVP_SECRET_REFRESH_AHEAD_S
+#define AVP_SECRET_REFRESH_AHEAD_S (AVP_SECRET_REFRESH_TTL_S / 4)
+#endif
+
+#if AVP_SECRET_REFRESH_AHEAD_S >= AVP_SECRET_REFRESH_TTL_S
+#error "AVP_SECRET_REFRESH_AHEAD_S must be shorter than AVP_SECRET_REFRESH_TTL_S"
+#endif
+
+#endif /* AVP_SECRET_REFRESH */
+
+/*=============================================================================
+ * AVP Envelope Encryption (opt-in, define AVP_ENVELOPE)
+ *============================================================================*/
+
+#ifdef AVP_ENVELOPE
+
+/** @brief Longest value of an enveloped secret, size of the ciphertext buffer in the vault */
+#ifndef AVP_ENVELOPE_VALUE_LEN
+#define AVP_ENVELOPE_VALUE_LEN AVP_MAX_SECRET_VALUE_LEN
+#endif
+
+/** @brief AES-GCM tag appended to the ciphertext kept on the host */
+#define AVP_ENVELOPE_TAG_LEN 16
+
+/**
+ * @brief Host storage of the ciphertexts of enveloped secrets, implemented by the application (files, flash).
+ *
+ * Ciphertexts are addressed by secret name and version. A new version is put
+ * before TROPIC01 references it, so a crash never leaves the vault without a
+ * readable version; versions no longer referenced are removed afterwards.
+ */
+typedef struct avp_host_store_t {
+    /** @brief Stores ciphertext of the version of the secret, other versions must be kept */
+    avp_ret_t (*put)(void *ctx, const char *name, uint32_t version, const uint8_t *data, size_t len);
+
+    /** @brief Reads ciphertext, len is buffer size (in) / actual size (out), AVP_ERR_SECRET_NOT_FOUND if missing */
+    avp_ret_t (*get)(void *ctx, const char *name, uint32_t version, uint8_t *data, size_t *len);
+
+    /** @brief Removes all versions of the secret except keep_version (0 = all of them) */
+    avp_ret_t (*remove)(void *ctx, const char *name, uint32_t keep_version);
+
+    /** @brief Context passed to the functions */
+    void *ctx;
+} avp_host_store_t;
+
+#endif /* AVP_ENVELOPE */
+
+/*=============================================================================
+ * AVP Compression (opt-in, define AVP_COMPRESS)
+ *============================================================================*/
+
+#ifdef AVP_COMPRESS
+
+/** @brief Longest value compressed by STORE, size of the compression buffer in the vault */
+#ifndef AVP_COMPRESS_VALUE_LEN
+#define AVP_COMPRESS_VALUE_LEN 4096
+#endif
+
+#if AVP_COMPRESS_VALUE_LEN > 32768
+#error "AVP_COMPRESS_VALUE_LEN must not exceed 32768"
+#endif
+
+/** @brief Entries of the match finder table (2 B each, on the stack of STORE) are 2^AVP_COMPRESS_HASH_BITS */
+#ifndef AVP_COMPRESS_HASH_BITS
+#define AVP_COMPRESS_HASH_BITS 10
+#endif
+
+#endif /* AVP_COMPRESS */
+
+/*=============================================================================
+ * AVP Store Deduplication (opt-in, define AVP_STORE_DEDUP)
+ *============================================================================*/
+
+#ifdef AVP_STORE_DEDUP
+
+/** @brief Bytes of the salted SHA-256 of the value kept in the catalog, a STORE of the same value is skipped */
+#ifndef AVP_STORE_DEDUP_HASH_LEN
+#define AVP_STORE_DEDUP_HASH_LEN 16
+#endif
+
+#if AVP_STORE_DEDUP_HASH_LEN < 8 || AVP_STORE_DEDUP_HASH_LEN > 32
+#error "AVP_STORE_DEDUP_HASH_LEN must be between 8 and 32"
+#endif
+
+#endif /* AVP_STORE_DEDUP */
+
+/*=============================================================================
+ * AVP Workspace Partitions (opt-in, define AVP_WORKSPACES)
+ *============================================================================*/
+
+#ifdef AVP_WORKSPACES
+
+#if (AVP_WORKSPACES < 1) || (AVP_DIR_SLOTS % AVP_WORKSPACES != 0)
+#error "AVP_WORKSPACES must divide AVP_DIR_SLOTS"
+#endif
+
+/** @brief Secret slots of one workspace partition */
+#define AVP_WORKSPACE_SLOTS (AVP_TROPIC_KEY_SLOTS / AVP_WORKSPACES)
+
+/** @brief Directory slots of one workspace partition */
+#define AVP_WORKSPACE_DIR_SLOTS (AVP_DIR_SLOTS / AVP_WORKSPACES)
+
+/** @brief R-memory slot of the workspace table (name hash of the workspace of each partition) */
+#ifndef AVP_WORKSPACE_SLOT
+#define AVP_WORKSPACE_SLOT (AVP_PIN_SLOT + 1)
+#endif
+
+/** @brief Monotonic counter decremented on every change of the secrets of partition p */
+#define AVP_WORKSPACE_MCOUNTER(p) ((lt_mcounter_index_t)(AVP_MCOUNTER_INDEX - 1 - (p)))
+
+#endif /* AVP_WORKSPACES */
+
+/*=============================================================================
+ * AVP Prefetch (opt-in, define AVP_PREFETCH)
+ *============================================================================*/
+
+#ifdef AVP_PREFETCH
+
+#ifndef AVP_SECRET_CACHE
+#error "AVP_PREFETCH requires AVP_SECRET_CACHE"
+#endif
+
+/** @brief Secrets read into the cache after AUTHENTICATE, as many as it holds */
+#define AVP_PREFETCH_ENTRIES AVP_SECRET_CACHE_ENTRIES
+
+#if AVP_PREFETCH_ENTRIES > 48
+#error "AVP_PREFETCH supports at most 48 cache entries (manifest fits one R-memory slot)"
+#endif
+
+/** @brief R-memory slot of the manifest of recently used secrets, one slot per workspace partition */
+#ifndef AVP_PREFETCH_SLOT
+#ifdef AVP_WORKSPACES
+#define AVP_PREFETCH_SLOT (AVP_WORKSPACE_SLOT + 1)
+#else
+#define AVP_PREFETCH_SLOT (AVP_PIN_SLOT + 1)
+#endif
+#endif
+
+#endif /* AVP_PREFETCH */
+
+/*=============================================================================
+ * AVP Metrics (opt-in, define AVP_METRICS)
+ *============================================================================*/
+
+#ifdef AVP_METRICS
+
+/**
+ * @brief Hits and misses of the caches of the vault, exported by avp_daemon_metrics().
+ */
+typedef struct avp_metrics_t {
+    /** @brief RETRIEVEs served from the secret cache (AVP_SECRET_CACHE) */
+    uint64_t secret_cache_hits;
+    /** @brief RETRIEVEs read from TROPIC01 while the secret cache was usable */
+    uint64_t secret_cache_misses;
+    /** @brief Signing key lookups served from the cached curve and public key */
+    uint64_t pubkey_cache_hits;
+    /** @brief Signing key lookups which read the key from TROPIC01 */
+    uint64_t pubkey_cache_misses;
+    /** @brief HW_CHALLENGEs served from the cached identity and certificate chain */
+    uint64_t cert_cache_hits;
+    /** @brief HW_CHALLENGEs which read the identity and certificate chain from TROPIC01 */
+    uint64_t cert_cache_misses;
+} avp_metrics_t;
+
+#endif /* AVP_METRICS */
+
 /**
  * @brief AVP session state.
  */
@@ -70,6 +401,94 @@ typedef enum {
     AVP_SESSION_TERMINATED,
 } avp_session_state_t;
 
+/**
+ * @brief AVP secret metadata (returned by LIST).
+ */
+typedef struct avp_secret_metadata_t {
+    char name[AVP_MAX_SECRET_NAME_LEN + 1];
+    uint32_t created_at;
+    uint32_t updated_at;
+    uint8_t slot_index;
+    uint32_t version;
+#ifdef AVP_ENVELOPE
+    /** @brief Value is kept encrypted on the host, TROPIC01 holds its data key */
+    bool enveloped;
+#endif
+#ifdef AVP_COMPRESS
+    /** @brief Value is kept compressed in R-memory */
+    bool compressed;
+#endif
+#ifdef AVP_STORE_DEDUP
+    /** @brief Truncated SHA-256 of the vault salt and the value, valid if value_hashed */
+    uint8_t value_hash[AVP_STORE_DEDUP_HASH_LEN];
+    /** @brief value_hash was computed by a STORE of this version in this vault */
+    bool value_hashed;
+#endif
+} avp_secret_metadata_t;
+
+/**
+ * @brief Cursor of a listing started by avp_list_begin().
+ *
+ * A few words in size, so a listing needs no array of metadata.
+ */
+typedef struct avp_list_cursor_t {
+    /** @brief Next secret slot to visit */
+    size_t slot;
+    /** @brief Name prefix of listed secrets, NULL for all (not copied) */
+    const char *prefix;
+    /** @brief Length of prefix */
+    size_t prefix_len;
+} avp_list_cursor_t;
+
+/**
+ * @brief Signing key in one ECC key slot, mirror of the key directory.
+ */
+typedef struct avp_key_entry_t {
+    /** @brief Hash of the key name (0 = free slot) */
+    uint64_t name_hash;
+
+    /** @brief Curve and public key below were read from TROPIC01 */
+    bool cached;
+
+    /** @brief Curve of the key */
+    lt_ecc_curve_type_t curve;
+
+    /** @brief Public key (TR01_CURVE_P256_PUBKEY_LEN or TR01_CURVE_ED25519_PUBKEY_LEN bytes) */
+    uint8_t pubkey[TR01_CURVE_P256_PUBKEY_LEN];
+} avp_key_entry_t;
+
+/**
+ * @brief Hardware attestation result.
+ */
+typedef struct avp_attestation_t {
+    bool verified;
+    char manufacturer[64];
+    char model[64];
+    char firmware_version[32];
+    char serial[64];
+    uint8_t certificate[2048];
+    size_t certificate_len;
+} avp_attestation_t;
+
+/**
+ * @brief Hardware attestation result referencing data held by the vault.
+ *
+ * Filled by avp_hw_challenge_ref() and avp_hw_attest_ref() without copying
+ * the certificate chain; pointers stay valid until avp_deinit().
+ */
+typedef struct avp_attestation_ref_t {
+    bool verified;
+    const char *manufacturer;
+    const char *model;
+    /** @brief NULL if not read from the chip */
+    const char *firmware_version;
+    /** @brief NULL if not read from the chip */
+    const char *serial;
+    /** @brief DER certificates back-to-back, NULL if none */
+    const uint8_t *certificate;
+    size_t certificate_len;
+} avp_attestation_ref_t;
+
 /**
  * @brief AVP vault handle for TROPIC01 backend.
  */
@@ -89,23 +508,146 @@ typedef struct avp_vault_t {
     /** @brief Session TTL in seconds */
     uint32_t session_ttl;
 
+    /** @brief Start of the session on the monotonic clock, expiry is checked against it */
+    uint32_t session_started;
+
     /** @brief Workspace name */
     char workspace[256];
 
     /** @brief Is authenticated */
     bool authenticated;
-} avp_vault_t;
 
-/**
- * @brief AVP secret metadata (returned by LIST).
- */
-typedef struct avp_secret_metadata_t {
-    char name[AVP_MAX_SECRET_NAME_LEN + 1];
-    uint32_t created_at;
-    uint32_t updated_at;
-    uint8_t slot_index;
-    uint32_t version;
-} avp_secret_metadata_t;
+    /** @brief PIN engine, caches the key unlocked by the PIN for the Secure Session */
+    lt_pin_t pin;
+
+    /** @brief Key in the PIN engine was unlocked by a full PIN verification at pin_unlocked_at */
+    bool pin_unlocked;
+
+    /** @brief Time of the PIN verification by TROPIC01 (monotonic clock), the key is reused for session_ttl */
+    uint32_t pin_unlocked_at;
+
+    /** @brief Directory loaded from TROPIC01 */
+    bool dir_loaded;
+
+    /** @brief Name hash stored in each secret slot (0 = free), mirror of the directory slots */
+    uint64_t dir_hash[AVP_TROPIC_KEY_SLOTS];
+
+    /** @brief Open-addressing index: name hash -> secret slot + 1 (0 = empty bucket) */
+    uint8_t dir_index[AVP_DIR_BUCKETS];
+
+    /** @brief Tag of the name hash in each bucket of dir_index (0 = empty), first AVP_DIR_GROUP mirrored at the end */
+    uint8_t dir_tag[AVP_DIR_BUCKETS + AVP_DIR_GROUP];
+
+    /** @brief Metadata of each secret slot, entry with empty name is not cached yet */
+    avp_secret_metadata_t catalog[AVP_TROPIC_KEY_SLOTS];
+
+    /** @brief Value of AVP_MCOUNTER_INDEX the mirrored directory and catalog belong to */
+    uint32_t mcounter;
+
+    /** @brief Batch opened by avp_batch_begin() */
+    bool batch_active;
+
+    /** @brief Secret slots with directory entry changed in the open batch (bitmap) */
+    uint8_t batch_changed[AVP_TROPIC_KEY_SLOTS / 8];
+
+    /** @brief Released secret slots still referenced by the directory on the chip (bitmap) */
+    uint8_t batch_pinned[AVP_TROPIC_KEY_SLOTS / 8];
+
+    /** @brief Writes of each secret slot, persisted in AVP_WEAR_SLOT by avp_idle() */
+    uint16_t slot_writes[AVP_TROPIC_KEY_SLOTS];
+
+    /** @brief Free secret slots still holding an old version, erased by avp_idle() (bitmap) */
+    uint8_t erase_pending[AVP_TROPIC_KEY_SLOTS / 8];
+
+    /** @brief slot_writes or erase_pending changed since written to AVP_WEAR_SLOT */
+    bool wear_dirty;
+
+    /** @brief Signing keys by ECC key slot (index 0 = AVP_ECC_FIRST_SLOT) */
+    avp_key_entry_t keys[AVP_ECC_KEY_SLOTS];
+
+    /** @brief Randomness from TROPIC01 not used yet, consumed from the end */
+    uint8_t entropy[AVP_ENTROPY_POOL_LEN];
+
+    /** @brief Unused bytes in entropy */
+    size_t entropy_len;
+
+    /** @brief Device identity and certificate chain read by the first HW_CHALLENGE */
+    avp_attestation_t attest;
+
+    /** @brief attest is filled, valid until avp_deinit() or a failed read of the chip */
+    bool attest_loaded;
+
+#ifdef AVP_SECRET_CACHE
+    /** @brief Retrieved secrets, valid until the session ends */
+    avp_cache_entry_t cache[AVP_SECRET_CACHE_ENTRIES];
+
+    /** @brief LRU clock of the cache */
+    uint32_t cache_tick;
+
+    /** @brief Cache is usable (its memory is locked against swapping where supported) */
+    bool cache_enabled;
+#endif
+
+#ifdef AVP_PREFETCH
+    /** @brief Name hashes set by avp_prefetch_set(), prefetched before the recently used secrets */
+    uint64_t prefetch_names[AVP_PREFETCH_ENTRIES];
+
+    /** @brief Entries of prefetch_names */
+    size_t prefetch_count;
+
+    /** @brief Name hashes of the recently used secrets, most recent first (0 = none), mirror of the manifest */
+    uint64_t prefetch_mru[AVP_PREFETCH_ENTRIES];
+
+    /** @brief prefetch_mru was read from the manifest of the authenticated workspace */
+    bool prefetch_mru_loaded;
+
+    /** @brief Session not prefetched yet, done by avp_prefetch() or the next avp_idle() */
+    bool prefetch_pending;
+#endif
+
+#ifdef AVP_ENVELOPE
+    /** @brief Host storage of ciphertexts, new secrets are enveloped once set by avp_envelope_enable() */
+    avp_host_store_t host_store;
+
+    /** @brief CAL context for the data keys, separate from the one of lt_handle */
+    void *envelope_crypto_ctx;
+
+    /** @brief Ciphertext and tag of one enveloped secret */
+    uint8_t envelope_buf[AVP_ENVELOPE_VALUE_LEN + AVP_ENVELOPE_TAG_LEN];
+#endif
+
+#ifdef AVP_COMPRESS
+    /** @brief Compressed form of one value, wiped after each STORE and RETRIEVE */
+    uint8_t compress_buf[AVP_COMPRESS_VALUE_LEN];
+#endif
+
+#ifdef AVP_STORE_DEDUP
+    /** @brief Random salt of the value hashes in the catalog, drawn by the first STORE */
+    uint8_t dedup_salt[AVP_STORE_DEDUP_HASH_LEN];
+
+    /** @brief dedup_salt is drawn */
+    bool dedup_salted;
+#endif
+
+#ifdef AVP_WORKSPACES
+    /** @brief Partition of the authenticated workspace, owns secret slots ws * AVP_WORKSPACE_SLOTS onwards */
+    uint8_t ws;
+
+    /** @brief Name hash of the workspace of each partition (0 = free), mirror of AVP_WORKSPACE_SLOT */
+    uint64_t ws_hash[AVP_WORKSPACES];
+
+    /** @brief Directory slots of the partition were read and repaired */
+    bool ws_loaded[AVP_WORKSPACES];
+
+    /** @brief Value of AVP_WORKSPACE_MCOUNTER() the mirrored partition belongs to */
+    uint32_t ws_mcounter[AVP_WORKSPACES];
+#endif
+
+#ifdef AVP_METRICS
+    /** @brief Cache hits and misses since avp_init() */
+    avp_metrics_t metrics;
+#endif
+} avp_vault_t;
 
 /**
  * @brief AVP discover response.
@@ -118,19 +660,6 @@ typedef struct avp_discover_response_t {
     uint16_t max_secrets;
 } avp_discover_response_t;
 
-/**
- * @brief Hardware attestation result.
- */
-typedef struct avp_attestation_t {
-    bool verified;
-    char manufacturer[64];
-    char model[64];
-    char firmware_version[32];
-    char serial[64];
-    uint8_t certificate[2048];
-    size_t certificate_len;
-} avp_attestation_t;
-
 /*=============================================================================
  * AVP Operations
  *============================================================================*/
@@ -138,6 +667,9 @@ typedef struct avp_attestation_t {
 /**
  * @brief Initialize AVP vault with TROPIC01 backend.
  *
+ * The CAL context of the handle is kept, set vault->lt_handle.l3.crypto_ctx
+ * (e.g. to an lt_ctx_mbedtls_v4_t) before the call.
+ *
  * @param vault Pointer to vault handle to initialize.
  * @param device Pointer to device-specific structure (e.g., lt_dev_stm32u5_tropic_click_t).
  * @return AVP_OK on success.
@@ -164,16 +696,40 @@ avp_ret_t avp_discover(avp_vault_t *vault, avp_discover_response_t *response);
 /**
  * @brief AUTHENTICATE operation - establish session.
  *
- * For TROPIC01, this performs PIN authentication.
+ * For TROPIC01, this performs PIN authentication with the MAC-and-Destroy
+ * PIN engine (lt_pin_verify()); every wrong PIN destroys one of
+ * AVP_PIN_ATTEMPTS attempts, the correct one restores all of them. The key
+ * unlocked by the PIN is kept in the vault for the session TTL: repeated
+ * AUTHENTICATE with the same PIN within it is checked on the host and costs
+ * no MAC-and-Destroy round-trip. On the first successful authentication, the
+ * secret directory is read from TROPIC01 and indexed in the vault, so later
+ * name lookups need no chip round-trip.
  *
  * @param vault Pointer to vault handle.
  * @param workspace Workspace name (or NULL for "default").
  * @param pin PIN string (for hardware backend).
  * @param ttl_seconds Requested session TTL (0 for default).
- * @return AVP_OK on success, AVP_ERR_AUTHENTICATION_FAILED on wrong PIN.
+ * @return AVP_OK on success, AVP_ERR_AUTHENTICATION_FAILED on wrong or missing
+ *         PIN or when no attempts remain, AVP_ERR_NOT_INITIALIZED if no PIN was
+ *         set by avp_set_pin().
  */
 avp_ret_t avp_authenticate(avp_vault_t *vault, const char *workspace, const char *pin, uint32_t ttl_seconds);
 
+/**
+ * @brief Sets the vault PIN.
+ *
+ * Initializes all AVP_PIN_ATTEMPTS MAC-and-Destroy slots for the new PIN
+ * with a fresh random secret (lt_pin_setup()). If a PIN is already set,
+ * old_pin must be correct; the first PIN is set with old_pin NULL.
+ *
+ * @param vault Pointer to vault handle.
+ * @param old_pin Current PIN (NULL if no PIN is set yet).
+ * @param new_pin New PIN (LT_PIN_LEN_MIN to LT_PIN_LEN_MAX characters).
+ * @return AVP_OK on success, AVP_ERR_AUTHENTICATION_FAILED if old_pin is
+ *         wrong or missing, AVP_ERR_INTERNAL if new_pin has invalid length.
+ */
+avp_ret_t avp_set_pin(avp_vault_t *vault, const char *old_pin, const char *new_pin);
+
 /**
  * @brief STORE operation - store a secret.
  *
@@ -185,9 +741,33 @@ avp_ret_t avp_authenticate(avp_vault_t *vault, const char *workspace, const char
  */
 avp_ret_t avp_store(avp_vault_t *vault, const char *name, const uint8_t *value, size_t value_len);
 
+#ifdef AVP_ENVELOPE
+/**
+ * @brief Switches STORE to envelope mode.
+ *
+ * Every secret stored afterwards is encrypted by AES-GCM under a fresh random
+ * data key; the ciphertext goes to the host storage and only the data key, IV
+ * and length (48 bytes) to the head slot of the secret in TROPIC01. RETRIEVE
+ * then costs one small R-memory read plus a host decrypt regardless of the
+ * secret size, and values up to AVP_ENVELOPE_VALUE_LEN fit one slot. Name
+ * and version are authenticated with the ciphertext, so the host cannot swap
+ * or roll back blobs. Secrets stored before are still read from R-memory.
+ *
+ * @param vault Pointer to vault handle (after avp_init()).
+ * @param store Host storage, copied into the vault.
+ * @param crypto_ctx CAL context (e.g. lt_ctx_mbedtls_v4_t) used only for the data keys.
+ * @return AVP_OK on success, AVP_ERR_INTERNAL on invalid parameters.
+ */
+avp_ret_t avp_envelope_enable(avp_vault_t *vault, const avp_host_store_t *store, void *crypto_ctx);
+#endif
+
 /**
  * @brief RETRIEVE operation - retrieve a secret.
  *
+ * With AVP_SECRET_CACHE, secrets up to AVP_SECRET_CACHE_VALUE_LEN bytes are
+ * kept in the vault after the first read and served from RAM until the
+ * session expires, AUTHENTICATE starts a new one or the vault is deinitialized.
+ *
  * @param vault Pointer to vault handle.
  * @param name Secret name.
  * @param value Buffer to receive value.
@@ -196,9 +776,71 @@ avp_ret_t avp_store(avp_vault_t *vault, const char *name, const uint8_t *value,
  */
 avp_ret_t avp_retrieve(avp_vault_t *vault, const char *name, uint8_t *value, size_t *value_len);
 
+/**
+ * @brief Result of one secret of avp_retrieve_many().
+ */
+typedef struct avp_retrieve_item_t {
+    /** @brief Buffer to receive value */
+    uint8_t *value;
+    /** @brief Buffer size (in) / actual size (out) */
+    size_t value_len;
+    /** @brief Result of RETRIEVE of this secret */
+    avp_ret_t status;
+} avp_retrieve_item_t;
+
+/**
+ * @brief RETRIEVE operation for several secrets at once.
+ *
+ * All names are resolved through the name index first, so missing secrets
+ * cost no chip round-trip, and the reads of the found ones are then issued
+ * back-to-back in the current session. After a hardware error, the remaining
+ * secrets are not read and report AVP_ERR_HARDWARE_ERROR.
+ *
+ * @param vault Pointer to vault handle.
+ * @param names Secret names.
+ * @param out Results, one per name (value and value_len set by caller).
+ * @param count Number of names.
+ * @return AVP_OK if all secrets were retrieved, otherwise status of the first
+ *         failed one (statuses of all secrets are in out).
+ */
+avp_ret_t avp_retrieve_many(avp_vault_t *vault, const char *const names[], avp_retrieve_item_t out[], size_t count);
+
+#ifdef AVP_PREFETCH
+/**
+ * @brief Sets the secrets to prefetch after every AUTHENTICATE.
+ *
+ * avp_authenticate() only schedules the prefetch. avp_prefetch(), or else the
+ * next avp_idle(), reads these secrets and then the most recently used ones
+ * of the workspace into the secret cache, back-to-back, and the metadata of
+ * all secrets for LIST; the first RETRIEVE and LIST of the agent are then
+ * served from RAM. The recently used secrets are recorded in a manifest on
+ * TROPIC01 (AVP_PREFETCH_SLOT), saved by avp_idle() when they change.
+ *
+ * @param vault Pointer to vault handle.
+ * @param names Secret names (NULL if count is 0: only recently used secrets are prefetched).
+ * @param count Number of names, at most AVP_PREFETCH_ENTRIES.
+ * @return AVP_OK on success, AVP_ERR_INVALID_NAME if a name is invalid,
+ *         AVP_ERR_CAPACITY_EXCEEDED if count is above AVP_PREFETCH_ENTRIES.
+ */
+avp_ret_t avp_prefetch_set(avp_vault_t *vault, const char *const names[], size_t count);
+
+/**
+ * @brief Runs the prefetch scheduled by AUTHENTICATE now instead of in the next avp_idle().
+ *
+ * Secrets which cannot be read or do not fit the cache are skipped.
+ *
+ * @param vault Pointer to vault handle.
+ * @return AVP_OK on success (also if nothing was scheduled), AVP_ERR_HARDWARE_ERROR on chip error.
+ */
+avp_ret_t avp_prefetch(avp_vault_t *vault);
+#endif
+
 /**
  * @brief DELETE operation - delete a secret.
  *
+ * With AVP_DEFERRED_ERASE defined, the directory entry is dropped at once and
+ * the slots are only queued for erase by avp_idle() or avp_flush().
+ *
  * @param vault Pointer to vault handle.
  * @param name Secret name.
  * @param deleted Set to true if secret existed and was deleted.
@@ -206,17 +848,113 @@ avp_ret_t avp_retrieve(avp_vault_t *vault, const char *name, uint8_t *value, siz
  */
 avp_ret_t avp_delete(avp_vault_t *vault, const char *name, bool *deleted);
 
+/**
+ * @brief Starts a batch of STORE and DELETE operations.
+ *
+ * Until avp_batch_commit(), the operations write only the secret slots and
+ * the directory is updated in RAM; the commit writes all directory changes
+ * at once through the journal (AVP_JOURNAL_SLOT), so either all or none of
+ * them are applied, also on reset or power loss (a pending journal is
+ * completed by the next AUTHENTICATE). Updated secrets are written to free
+ * slots and the old ones are released at commit; a STORE which runs out of
+ * free slots because of that commits the batch so far first. A batch not
+ * committed in its session is dropped.
+ *
+ * @param vault Pointer to vault handle.
+ * @return AVP_OK on success.
+ */
+avp_ret_t avp_batch_begin(avp_vault_t *vault);
+
+/**
+ * @brief Commits the batch started by avp_batch_begin().
+ *
+ * @param vault Pointer to vault handle.
+ * @return AVP_OK on success.
+ */
+avp_ret_t avp_batch_commit(avp_vault_t *vault);
+
+/**
+ * @brief Background maintenance, to be called when the vault is idle.
+ *
+ * STORE of an existing secret writes the new version to the least written
+ * free slots and only releases the old ones; this erases up to max_erases of
+ * the released slots and saves the slot write counters. With
+ * AVP_SECRET_REFRESH, it first reads again the cached secrets near their TTL
+ * or changed by another host.
+ *
+ * @param vault      Pointer to vault handle.
+ * @param max_erases Maximum number of slots to erase in this call.
+ * @return AVP_OK on success.
+ */
+avp_ret_t avp_idle(avp_vault_t *vault, size_t max_erases);
+
+/**
+ * @brief Erases all slots queued for erase, e.g. before shutdown.
+ *
+ * Called by avp_deinit() while authenticated. Slots released by the open
+ * batch are erased by avp_batch_commit() instead.
+ *
+ * @param vault Pointer to vault handle.
+ * @return AVP_OK on success.
+ */
+avp_ret_t avp_flush(avp_vault_t *vault);
+
 /**
  * @brief LIST operation - enumerate secrets.
  *
+ * Served from the metadata catalog in the vault. Metadata not cached yet (by
+ * STORE or RETRIEVE in this vault) are read from TROPIC01 by the first LIST,
+ * every further LIST is a memory-only operation.
+ *
  * @param vault Pointer to vault handle.
- * @param secrets Array to receive secret metadata.
+ * @param secrets Array to receive secret metadata (or NULL to only count secrets).
  * @param max_secrets Maximum number of secrets to return.
- * @param count Pointer to receive actual count.
+ * @param count Pointer to receive actual count (number of all secrets if secrets is NULL).
  * @return AVP_OK on success.
  */
 avp_ret_t avp_list(avp_vault_t *vault, avp_secret_metadata_t *secrets, size_t max_secrets, size_t *count);
 
+/**
+ * @brief Starts a listing of secrets, continued by avp_list_next().
+ *
+ * Unlike avp_list(), the caller needs no array of metadata: each call of
+ * avp_list_next() returns one secret, and the listing may be stopped early
+ * by avp_list_end().
+ *
+ * @param vault Pointer to vault handle.
+ * @param cursor Cursor to start.
+ * @param prefix Only names starting with prefix are listed (NULL or "" for
+ *               all). Not copied, has to stay valid until avp_list_end().
+ * @return AVP_OK on success, AVP_ERR_INVALID_NAME if prefix is longer than
+ *         AVP_MAX_SECRET_NAME_LEN.
+ */
+avp_ret_t avp_list_begin(avp_vault_t *vault, avp_list_cursor_t *cursor, const char *prefix);
+
+/**
+ * @brief Returns the next secret of the listing started by avp_list_begin().
+ *
+ * Served from the metadata catalog like avp_list(), metadata not cached yet
+ * are read from TROPIC01 one secret per call. Secrets stored or deleted
+ * while listing may or may not be listed.
+ *
+ * @param vault Pointer to vault handle.
+ * @param cursor Cursor of the listing.
+ * @param meta Pointer to receive metadata in the catalog of the vault, valid
+ *             until the next operation changing the vault.
+ * @return AVP_OK on success, AVP_ERR_SECRET_NOT_FOUND when all secrets were
+ *         listed.
+ */
+avp_ret_t avp_list_next(avp_vault_t *vault, avp_list_cursor_t *cursor, const avp_secret_metadata_t **meta);
+
+/**
+ * @brief Ends the listing, avp_list_next() then reports no further secret.
+ *
+ * @param vault Pointer to vault handle.
+ * @param cursor Cursor of the listing.
+ * @return AVP_OK on success.
+ */
+avp_ret_t avp_list_end(avp_vault_t *vault, avp_list_cursor_t *cursor);
+
 /*=============================================================================
  * AVP Hardware Extension Operations
  *============================================================================*/
@@ -224,16 +962,95 @@ avp_ret_t avp_list(avp_vault_t *vault, avp_secret_metadata_t *secrets, size_t ma
 /**
  * @brief HW_CHALLENGE operation - verify device authenticity.
  *
+ * The first call reads chip ID, RISC-V and SPECT firmware versions and the
+ * certificate chain from TROPIC01 and keeps them in the vault; later calls
+ * are served from the vault without any chip round-trip. The certificate
+ * field holds the DER certificates of the chain back-to-back, device
+ * certificate first, as many as fit.
+ *
  * @param vault Pointer to vault handle.
  * @param attestation Pointer to attestation result.
- * @return AVP_OK on success.
+ * @return AVP_OK on success, AVP_ERR_HARDWARE_ERROR if the chip could not be read.
  */
 avp_ret_t avp_hw_challenge(avp_vault_t *vault, avp_attestation_t *attestation);
 
+/**
+ * @brief HW_CHALLENGE operation without copying the attestation.
+ *
+ * Same as avp_hw_challenge(), but attestation references the identity and
+ * certificate chain cached in the vault instead of receiving a copy.
+ *
+ * @param vault Pointer to vault handle.
+ * @param attestation Pointer to attestation result.
+ * @return AVP_OK on success, AVP_ERR_HARDWARE_ERROR if the chip could not be read.
+ */
+avp_ret_t avp_hw_challenge_ref(avp_vault_t *vault, avp_attestation_ref_t *attestation);
+
+/**
+ * @brief HW_CHALLENGE answered by a signature over the verifier's nonce.
+ *
+ * Fills the cached attestation as avp_hw_challenge() and signs the nonce by
+ * avp_hw_sign() with the named key, so a fresh challenge costs a single
+ * on-chip signature.
+ * attestation may be NULL if the caller takes it from avp_hw_challenge_ref().
+ *
+ * @param vault Pointer to vault handle.
+ * @param key_name Name of the signing key.
+ * @param nonce Challenge of the verifier.
+ * @param nonce_len Length of nonce.
+ * @param attestation Pointer to attestation result (or NULL).
+ * @param signature Buffer to receive signature.
+ * @param signature_len Pointer to buffer size (in) / actual size (out).
+ * @return AVP_OK on success, AVP_ERR_SECRET_NOT_FOUND if the key is not found.
+ */
+avp_ret_t avp_hw_challenge_sign(avp_vault_t *vault, const char *key_name, const uint8_t *nonce, size_t nonce_len,
+                                avp_attestation_t *attestation, uint8_t *signature, size_t *signature_len);
+
+/**
+ * @brief Generate a named signing key in a free ECC key slot.
+ *
+ * The key is generated inside TROPIC01 and never leaves it. The name is
+ * recorded in the key directory (AVP_KEY_DIR_SLOT), the curve and the public
+ * key are cached in the vault.
+ *
+ * @param vault Pointer to vault handle.
+ * @param key_name Name of the new key.
+ * @param curve TR01_CURVE_P256 or TR01_CURVE_ED25519.
+ * @return AVP_OK on success, AVP_ERR_INVALID_NAME if the name is invalid or
+ *         already used, AVP_ERR_CAPACITY_EXCEEDED if no ECC key slot is free.
+ */
+avp_ret_t avp_hw_key_generate(avp_vault_t *vault, const char *key_name, lt_ecc_curve_type_t curve);
+
+/**
+ * @brief Erase a named signing key.
+ *
+ * @param vault Pointer to vault handle.
+ * @param key_name Name of the key.
+ * @return AVP_OK on success, AVP_ERR_SECRET_NOT_FOUND if not found.
+ */
+avp_ret_t avp_hw_key_delete(avp_vault_t *vault, const char *key_name);
+
+/**
+ * @brief Get the public key of a named signing key.
+ *
+ * Served from the vault after the first use of the key, so signatures can be
+ * verified host-side without a round-trip to TROPIC01.
+ *
+ * @param vault Pointer to vault handle.
+ * @param key_name Name of the key.
+ * @param pubkey Buffer to receive the public key.
+ * @param pubkey_len Pointer to buffer size (in) / actual size (out).
+ * @param curve Pointer to receive the curve of the key (or NULL).
+ * @return AVP_OK on success, AVP_ERR_SECRET_NOT_FOUND if not found.
+ */
+avp_ret_t avp_hw_public_key(avp_vault_t *vault, const char *key_name,
+                            uint8_t *pubkey, size_t *pubkey_len, lt_ecc_curve_type_t *curve);
+
 /**
  * @brief HW_SIGN operation - sign data without exporting key.
  *
- * The signing key never leaves the TROPIC01 secure element.
+ * The signing key never leaves the TROPIC01 secure element. ECDSA (P-256) or
+ * EdDSA (Ed25519) is chosen by the cached curve of the key.
  *
  * @param vault Pointer to vault handle.
  * @param key_name Name of the signing key.
@@ -241,7 +1058,7 @@ avp_ret_t avp_hw_challenge(avp_vault_t *vault, avp_attestation_t *attestation);
  * @param data_len Length of data.
  * @param signature Buffer to receive signature.
  * @param signature_len Pointer to buffer size (in) / actual size (out).
- * @return AVP_OK on success.
+ * @return AVP_OK on success, AVP_ERR_SECRET_NOT_FOUND if the key is not found.
  */
 avp_ret_t avp_hw_sign(avp_vault_t *vault, const char *key_name,
                       const uint8_t *data, size_t data_len,
@@ -257,6 +1074,16 @@ avp_ret_t avp_hw_sign(avp_vault_t *vault, const char *key_name,
  */
 avp_ret_t avp_hw_attest(avp_vault_t *vault, const char *name, avp_attestation_t *attestation);
 
+/**
+ * @brief HW_ATTEST operation without copying the attestation.
+ *
+ * @param vault Pointer to vault handle.
+ * @param name Secret name to attest.
+ * @param attestation Pointer to attestation result.
+ * @return AVP_OK on success.
+ */
+avp_ret_t avp_hw_attest_ref(avp_vault_t *vault, const char *name, avp_attestation_ref_t *attestation);
+
 /*=============================================================================
  * Utility Functions
  *============================================================================*/
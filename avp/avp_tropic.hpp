@@ -0,0 +1,130 @@
+/**
+ * @file avp_tropic.hpp
+ * @brief Header-only C++20 RAII wrapper of the AVP vault with std::span based operations.
+ *
+ * The vault storage is provided by the caller and never moves (it holds the
+ * libtropic handle), avp::vault only owns its lifetime: avp_deinit() is called
+ * on destruction if init() succeeded. Nothing is allocated on the heap, values
+ * go to caller's buffers passed as spans.
+ *
+ * @copyright Copyright (c) 2026 AVP Protocol Contributors
+ * @license Apache-2.0 (see LICENSE)
+ */
+
+#ifndef AVP_TROPIC_HPP
+#define AVP_TROPIC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "avp_tropic.h"
+
+namespace avp {
+
+/**
+ * @brief Owner of the lifetime of caller's avp_vault_t, move-only.
+ */
+class vault {
+   public:
+    explicit vault(avp_vault_t &v) noexcept : v_(&v) {}
+    vault(const vault &) = delete;
+    vault &operator=(const vault &) = delete;
+    vault(vault &&other) noexcept : v_(std::exchange(other.v_, nullptr)), on_(std::exchange(other.on_, false)) {}
+    vault &operator=(vault &&other) noexcept
+    {
+        if (this != &other) {
+            deinit();
+            v_ = std::exchange(other.v_, nullptr);
+            on_ = std::exchange(other.on_, false);
+        }
+        return *this;
+    }
+    ~vault() { deinit(); }
+
+    /** @brief Initializes the vault, see avp_init(). Nothing is done if it is already initialized. */
+    avp_ret_t init(void *device) noexcept
+    {
+        if (!v_) {
+            return AVP_ERR_INTERNAL;
+        }
+        if (on_) {
+            return AVP_OK;
+        }
+        avp_ret_t ret = avp_init(v_, device);
+        on_ = (ret == AVP_OK);
+        return ret;
+    }
+
+    /** @brief Deinitializes the vault, see avp_deinit(). Nothing is done if it is not initialized. */
+    avp_ret_t deinit() noexcept
+    {
+        if (!on_) {
+            return AVP_OK;
+        }
+        on_ = false;
+        return avp_deinit(v_);
+    }
+
+    /** @brief The C vault, for operations without a wrapper. */
+    avp_vault_t &raw() noexcept { return *v_; }
+
+    /** @brief AUTHENTICATE operation, see avp_authenticate(). */
+    avp_ret_t authenticate(const char *workspace, const char *pin, uint32_t ttl_seconds) noexcept
+    {
+        return avp_authenticate(v_, workspace, pin, ttl_seconds);
+    }
+
+    /** @brief STORE operation, see avp_store(). */
+    avp_ret_t store(const char *name, std::span<const uint8_t> value) noexcept
+    {
+        return avp_store(v_, name, value.data(), value.size());
+    }
+
+    /**
+     * @brief RETRIEVE operation, see avp_retrieve().
+     *
+     * @param name Secret name.
+     * @param value Buffer to receive value.
+     * @param read Set to the part of value holding the secret.
+     */
+    avp_ret_t retrieve(const char *name, std::span<uint8_t> value, std::span<uint8_t> &read) noexcept
+    {
+        size_t len = value.size();
+        avp_ret_t ret = avp_retrieve(v_, name, value.data(), &len);
+        read = value.first(ret == AVP_OK ? len : 0);
+        return ret;
+    }
+
+    /** @brief DELETE operation, see avp_delete(). */
+    avp_ret_t remove(const char *name, bool &deleted) noexcept { return avp_delete(v_, name, &deleted); }
+
+    /**
+     * @brief HW_SIGN operation, see avp_hw_sign().
+     *
+     * @param key_name Name of the signing key.
+     * @param data Data to sign.
+     * @param signature Buffer to receive signature.
+     * @param written Set to the part of signature holding the signature.
+     */
+    avp_ret_t hw_sign(const char *key_name, std::span<const uint8_t> data, std::span<uint8_t> signature,
+                      std::span<uint8_t> &written) noexcept
+    {
+        size_t len = signature.size();
+        avp_ret_t ret = avp_hw_sign(v_, key_name, data.data(), data.size(), signature.data(), &len);
+        written = signature.first(ret == AVP_OK ? len : 0);
+        return ret;
+    }
+
+    /** @brief Checks whether the AVP session is active, see avp_session_active(). */
+    bool session_active() const noexcept { return avp_session_active(v_); }
+
+   private:
+    avp_vault_t *v_;
+    bool on_ = false;
+};
+
+}  // namespace avp
+
+#endif /* AVP_TROPIC_HPP */
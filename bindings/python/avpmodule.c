@@ -0,0 +1,383 @@
+/**
+ * @file avpmodule.c
+ * @brief CPython extension `avp`: agents of the AVP vault daemon (avp_daemon.h).
+ *
+ * Every call releases the GIL while it waits for the daemon, so other Python
+ * threads run during the round trip; a lock per Agent keeps the calls of
+ * several threads on one connection apart. Values are read from any object
+ * with the buffer protocol and retrieve_into() writes into a caller-provided
+ * writable buffer (bytearray, memoryview, mmap, numpy array), so no bytes
+ * object is made for a secret.
+ *
+ * @copyright Copyright (c) 2026 AVP Protocol Contributors
+ * @license Apache-2.0 (see LICENSE)
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "pythread.h"
+
+#include "avp_daemon.h"
+#include "lt_secure_memzero.h"
+
+/*=============================================================================
+ * Errors
+ *============================================================================*/
+
+/* avp.Error, args are (code, name of the code) and the code is also its attribute */
+static PyObject *avp_error;
+
+static const char *const ret_names[] = {
+    "AVP_OK",
+    "AVP_ERR_NOT_INITIALIZED",
+    "AVP_ERR_AUTHENTICATION_FAILED",
+    "AVP_ERR_SESSION_EXPIRED",
+    "AVP_ERR_SECRET_NOT_FOUND",
+    "AVP_ERR_CAPACITY_EXCEEDED",
+    "AVP_ERR_INVALID_NAME",
+    "AVP_ERR_HARDWARE_ERROR",
+    "AVP_ERR_CRYPTO_ERROR",
+    "AVP_ERR_INTERNAL",
+};
+#define RET_NAMES (sizeof(ret_names) / sizeof(ret_names[0]))
+
+static PyObject *raise_ret(avp_ret_t ret)
+{
+    const char *name = ((size_t)ret < RET_NAMES) ? ret_names[ret] : "AVP_ERR_UNKNOWN";
+    PyObject *exc = PyObject_CallFunction(avp_error, "is", (int)ret, name);
+    if (exc != NULL) {
+        PyObject *code = PyLong_FromLong((long)ret);
+        if (code != NULL) {
+            PyObject_SetAttrString(exc, "code", code);
+            Py_DECREF(code);
+        }
+        PyErr_SetObject(avp_error, exc);
+        Py_DECREF(exc);
+    }
+    return NULL;
+}
+
+/*=============================================================================
+ * Agent
+ *============================================================================*/
+
+typedef struct {
+    PyObject_HEAD
+    avp_agent_t agent;
+    /* Serializes calls on the connection, taken without the GIL */
+    PyThread_type_lock lock;
+} agent_object;
+
+/* Runs the call without the GIL and under the lock of the connection */
+#define AGENT_CALL(self, ret, call)                          \
+    do {                                                     \
+        Py_BEGIN_ALLOW_THREADS;                              \
+        PyThread_acquire_lock((self)->lock, WAIT_LOCK);      \
+        (ret) = (call);                                      \
+        PyThread_release_lock((self)->lock);                 \
+        Py_END_ALLOW_THREADS;                                \
+    } while (0)
+
+/* Checks a secret or workspace name for avp_agent_*(), which copy it into the request */
+static bool name_check(const char *name, Py_ssize_t len)
+{
+    if (len > AVP_MAX_SECRET_NAME_LEN || (Py_ssize_t)strlen(name) != len) {
+        PyErr_SetString(PyExc_ValueError, "name is too long or contains a null character");
+        return false;
+    }
+    return true;
+}
+
+static void agent_dealloc(agent_object *self)
+{
+    avp_agent_disconnect(&self->agent);
+    if (self->lock != NULL) {
+        PyThread_free_lock(self->lock);
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *agent_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    (void)args;
+    (void)kwds;
+    agent_object *self = (agent_object *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->agent.fd = -1;
+    self->agent.shm = NULL;
+    self->lock = PyThread_allocate_lock();
+    if (self->lock == NULL) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+    return (PyObject *)self;
+}
+
+static int agent_init(agent_object *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"path", NULL};
+    const char *path;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s", kwlist, &path)) {
+        return -1;
+    }
+
+    avp_agent_disconnect(&self->agent);
+    avp_ret_t ret;
+    AGENT_CALL(self, ret, avp_agent_connect(&self->agent, path));
+    if (ret != AVP_OK) {
+        raise_ret(ret);
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *agent_close(agent_object *self, PyObject *unused)
+{
+    (void)unused;
+    Py_BEGIN_ALLOW_THREADS;
+    PyThread_acquire_lock(self->lock, WAIT_LOCK);
+    avp_agent_disconnect(&self->agent);
+    PyThread_release_lock(self->lock);
+    Py_END_ALLOW_THREADS;
+    Py_RETURN_NONE;
+}
+
+static PyObject *agent_enter(agent_object *self, PyObject *unused)
+{
+    (void)unused;
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+static PyObject *agent_exit(agent_object *self, PyObject *args)
+{
+    (void)args;
+    return agent_close(self, NULL);
+}
+
+static PyObject *agent_authenticate(agent_object *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"workspace", "pin", "ttl", NULL};
+    const char *workspace;
+    Py_ssize_t workspace_len = 0;
+    Py_buffer pin;
+    unsigned int ttl = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "z#s*|I", kwlist, &workspace, &workspace_len, &pin, &ttl)) {
+        return NULL;
+    }
+    if (workspace != NULL && !name_check(workspace, workspace_len)) {
+        PyBuffer_Release(&pin);
+        return NULL;
+    }
+    if (pin.len > LT_PIN_LEN_MAX || memchr(pin.buf, '\0', (size_t)pin.len) != NULL) {
+        PyBuffer_Release(&pin);
+        return raise_ret(AVP_ERR_AUTHENTICATION_FAILED);
+    }
+
+    /* The C API takes a string, the copy is wiped right after the call */
+    char pin_str[LT_PIN_LEN_MAX + 1];
+    memcpy(pin_str, pin.buf, (size_t)pin.len);
+    pin_str[pin.len] = '\0';
+    PyBuffer_Release(&pin);
+
+    avp_ret_t ret;
+    AGENT_CALL(self, ret, avp_agent_authenticate(&self->agent, workspace, pin_str, ttl));
+    lt_secure_memzero(pin_str, sizeof(pin_str));
+    if (ret != AVP_OK) {
+        return raise_ret(ret);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *agent_store(agent_object *self, PyObject *args)
+{
+    const char *name;
+    Py_ssize_t name_len;
+    Py_buffer value;
+    if (!PyArg_ParseTuple(args, "s#y*", &name, &name_len, &value)) {
+        return NULL;
+    }
+    if (!name_check(name, name_len)) {
+        PyBuffer_Release(&value);
+        return NULL;
+    }
+
+    avp_ret_t ret;
+    AGENT_CALL(self, ret, avp_agent_store(&self->agent, name, value.buf, (size_t)value.len));
+    PyBuffer_Release(&value);
+    if (ret != AVP_OK) {
+        return raise_ret(ret);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *agent_retrieve_into(agent_object *self, PyObject *args)
+{
+    const char *name;
+    Py_ssize_t name_len;
+    Py_buffer value;
+    if (!PyArg_ParseTuple(args, "s#w*", &name, &name_len, &value)) {
+        return NULL;
+    }
+    if (!name_check(name, name_len)) {
+        PyBuffer_Release(&value);
+        return NULL;
+    }
+    if (!PyBuffer_IsContiguous(&value, 'C')) {
+        PyBuffer_Release(&value);
+        PyErr_SetString(PyExc_ValueError, "buffer must be contiguous");
+        return NULL;
+    }
+
+    size_t len = (size_t)value.len;
+    avp_ret_t ret;
+    AGENT_CALL(self, ret, avp_agent_retrieve(&self->agent, name, value.buf, &len));
+    PyBuffer_Release(&value);
+    if (ret != AVP_OK) {
+        return raise_ret(ret);
+    }
+    return PyLong_FromSize_t(len);
+}
+
+static PyObject *agent_delete(agent_object *self, PyObject *args)
+{
+    const char *name;
+    Py_ssize_t name_len;
+    if (!PyArg_ParseTuple(args, "s#", &name, &name_len) || !name_check(name, name_len)) {
+        return NULL;
+    }
+
+    bool deleted = false;
+    avp_ret_t ret;
+    AGENT_CALL(self, ret, avp_agent_delete(&self->agent, name, &deleted));
+    if (ret != AVP_OK) {
+        return raise_ret(ret);
+    }
+    return PyBool_FromLong(deleted);
+}
+
+/* LIST results are copied out of the shared memory of the connection, not from a second buffer */
+static PyObject *agent_list(agent_object *self, PyObject *unused)
+{
+    (void)unused;
+    size_t count = 0;
+    avp_ret_t ret;
+    AGENT_CALL(self, ret, avp_agent_list(&self->agent, NULL, 0, &count));
+    if (ret != AVP_OK) {
+        return raise_ret(ret);
+    }
+
+    avp_secret_metadata_t *secrets = PyMem_Calloc((count != 0) ? count : 1, sizeof(*secrets));
+    if (secrets == NULL) {
+        return PyErr_NoMemory();
+    }
+    AGENT_CALL(self, ret, avp_agent_list(&self->agent, secrets, count, &count));
+    if (ret != AVP_OK) {
+        PyMem_Free(secrets);
+        return raise_ret(ret);
+    }
+
+    PyObject *list = PyList_New((Py_ssize_t)count);
+    for (size_t i = 0; list != NULL && i < count; i++) {
+        const avp_secret_metadata_t *m = &secrets[i];
+        PyObject *item = Py_BuildValue("{s:s,s:I,s:I,s:I,s:B}", "name", m->name, "created_at", m->created_at,
+                                       "updated_at", m->updated_at, "version", m->version, "slot_index",
+                                       m->slot_index);
+        if (item == NULL) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, (Py_ssize_t)i, item);
+    }
+    PyMem_Free(secrets);
+    return list;
+}
+
+static PyObject *agent_metrics(agent_object *self, PyObject *unused)
+{
+    (void)unused;
+    char *text = PyMem_Malloc(AVP_DAEMON_SHM_LEN);
+    if (text == NULL) {
+        return PyErr_NoMemory();
+    }
+
+    size_t len = 0;
+    avp_ret_t ret;
+    AGENT_CALL(self, ret, avp_agent_metrics(&self->agent, text, AVP_DAEMON_SHM_LEN, &len));
+    PyObject *result = (ret == AVP_OK) ? PyUnicode_DecodeUTF8(text, (Py_ssize_t)len, "strict") : raise_ret(ret);
+    PyMem_Free(text);
+    return result;
+}
+
+static PyMethodDef agent_methods[] = {
+    {"close", (PyCFunction)agent_close, METH_NOARGS, "Disconnects from the daemon."},
+    {"__enter__", (PyCFunction)agent_enter, METH_NOARGS, NULL},
+    {"__exit__", (PyCFunction)agent_exit, METH_VARARGS, NULL},
+    {"authenticate", (PyCFunction)(void (*)(void))agent_authenticate, METH_VARARGS | METH_KEYWORDS,
+     "authenticate(workspace, pin, ttl=0)\n\nAVP AUTHENTICATE, workspace may be None, pin is str or bytes-like."},
+    {"store", (PyCFunction)agent_store, METH_VARARGS,
+     "store(name, value)\n\nAVP STORE of any bytes-like value, read in place."},
+    {"retrieve_into", (PyCFunction)agent_retrieve_into, METH_VARARGS,
+     "retrieve_into(name, buffer) -> int\n\nAVP RETRIEVE into the writable buffer, returns the value length."},
+    {"delete", (PyCFunction)agent_delete, METH_VARARGS, "delete(name) -> bool\n\nAVP DELETE, True if removed."},
+    {"list", (PyCFunction)agent_list, METH_NOARGS, "list() -> list of dict\n\nAVP LIST of the workspace."},
+    {"metrics", (PyCFunction)agent_metrics, METH_NOARGS,
+     "metrics() -> str\n\nCounters of the daemon in the OpenMetrics text format."},
+    {NULL, NULL, 0, NULL},
+};
+
+static PyTypeObject agent_type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "avp.Agent",
+    .tp_doc = "Agent(path)\n\nConnection to the AVP vault daemon listening on the Unix socket path.",
+    .tp_basicsize = sizeof(agent_object),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = agent_new,
+    .tp_init = (initproc)agent_init,
+    .tp_dealloc = (destructor)agent_dealloc,
+    .tp_methods = agent_methods,
+};
+
+/*=============================================================================
+ * Module
+ *============================================================================*/
+
+static struct PyModuleDef avp_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "avp",
+    .m_doc = "Agents of the AVP vault daemon.",
+    .m_size = -1,
+};
+
+PyMODINIT_FUNC PyInit_avp(void)
+{
+    if (PyType_Ready(&agent_type) < 0) {
+        return NULL;
+    }
+
+    PyObject *m = PyModule_Create(&avp_module);
+    if (m == NULL) {
+        return NULL;
+    }
+
+    avp_error = PyErr_NewException("avp.Error", NULL, NULL);
+    if (avp_error == NULL || PyModule_AddObjectRef(m, "Error", avp_error) < 0
+        || PyModule_AddObjectRef(m, "Agent", (PyObject *)&agent_type) < 0) {
+        Py_DECREF(m);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < RET_NAMES; i++) {
+        if (PyModule_AddIntConstant(m, ret_names[i] + 4, (long)i) < 0) {
+            Py_DECREF(m);
+            return NULL;
+        }
+    }
+    if (PyModule_AddIntConstant(m, "MAX_VALUE_LEN", AVP_DAEMON_SHM_LEN) < 0) {
+        Py_DECREF(m);
+        return NULL;
+    }
+
+    return m;
+}
@@ -0,0 +1,38 @@
+"""Build of the `avp` extension, agents of the AVP vault daemon.
+
+Only the agent side of avp/avp_daemon.c is compiled (AVP_AGENT_ONLY), the
+extension links neither libtropic nor the vault. The layout of LIST results
+depends on the AVP options of the daemon: pass the same ones in AVP_DEFINES,
+e.g. AVP_DEFINES="AVP_ENVELOPE AVP_COMPRESS AVP_DAEMON_SHM_LEN=131072".
+"""
+
+import os
+
+from setuptools import Extension, setup
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+
+macros = [("LT_PIN", None), ("AVP_AGENT_ONLY", None), ("_GNU_SOURCE", None)]
+for define in os.environ.get("AVP_DEFINES", "").split():
+    name, _, value = define.partition("=")
+    macros.append((name, value or None))
+
+setup(
+    name="avp",
+    version="0.1.0",
+    description="Agents of the AVP vault daemon",
+    license="Apache-2.0",
+    python_requires=">=3.10",
+    ext_modules=[
+        Extension(
+            "avp",
+            sources=[
+                "avpmodule.c",
+                os.path.join(ROOT, "avp", "avp_daemon.c"),
+                os.path.join(ROOT, "src", "lt_secure_memzero.c"),
+            ],
+            include_dirs=[os.path.join(ROOT, "include"), os.path.join(ROOT, "src"), os.path.join(ROOT, "avp")],
+            define_macros=macros,
+        )
+    ],
+)
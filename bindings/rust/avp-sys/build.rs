@@ -0,0 +1,47 @@
+//! Compiles the agent side of avp/avp_daemon.c (AVP_AGENT_ONLY), it links
+//! neither libtropic nor the vault. AVP_ENVELOPE and AVP_COMPRESS follow the
+//! features of the crate, other AVP options of the daemon are passed in
+//! AVP_DEFINES, e.g. AVP_DEFINES="AVP_DAEMON_SHM_LEN=131072".
+
+use std::env;
+use std::path::PathBuf;
+
+fn main() {
+    let root = PathBuf::from(env::var("CARGO_MANIFEST_DIR").unwrap()).join("../../..");
+    let mut build = cc::Build::new();
+    build
+        .file(root.join("avp/avp_daemon.c"))
+        .file(root.join("src/lt_secure_memzero.c"))
+        .include(root.join("include"))
+        .include(root.join("src"))
+        .include(root.join("avp"))
+        .define("LT_PIN", None)
+        .define("AVP_AGENT_ONLY", None)
+        .define("_GNU_SOURCE", None)
+        .flag_if_supported("-std=c11")
+        .warnings(false);
+
+    if env::var_os("CARGO_FEATURE_ENVELOPE").is_some() {
+        build.define("AVP_ENVELOPE", None);
+    }
+    if env::var_os("CARGO_FEATURE_COMPRESS").is_some() {
+        build.define("AVP_COMPRESS", None);
+    }
+
+    println!("cargo:rerun-if-env-changed=AVP_DEFINES");
+    for define in env::var("AVP_DEFINES").unwrap_or_default().split_whitespace() {
+        let (name, value) = match define.split_once('=') {
+            Some((name, value)) => (name, Some(value)),
+            None => (define, None),
+        };
+        if name == "AVP_ENVELOPE" || name == "AVP_COMPRESS" {
+            panic!("{name} changes avp_secret_metadata_t, enable the feature of avp-sys instead");
+        }
+        build.define(name, value);
+    }
+
+    for file in ["avp/avp_daemon.c", "avp/avp_daemon.h", "avp/avp_tropic.h", "src/lt_secure_memzero.c"] {
+        println!("cargo:rerun-if-changed={}", root.join(file).display());
+    }
+    build.compile("avp_agent");
+}
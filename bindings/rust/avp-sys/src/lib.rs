@@ -0,0 +1,83 @@
+//! FFI of the agent API of the AVP vault daemon (avp/avp_daemon.h).
+//!
+//! Declarations are written by hand and follow avp_daemon.h and avp_tropic.h,
+//! see the `avp` crate for the safe wrapper.
+
+#![no_std]
+#![allow(non_camel_case_types)]
+
+use core::ffi::{c_char, c_int};
+
+/// Longest secret name, without the terminating NUL.
+pub const AVP_MAX_SECRET_NAME_LEN: usize = 255;
+
+/// Longest secret value.
+pub const AVP_MAX_SECRET_VALUE_LEN: usize = 65536;
+
+/// avp_ret_t, kept as an integer so an unknown code is not undefined behaviour.
+pub type avp_ret_t = c_int;
+
+pub const AVP_OK: avp_ret_t = 0;
+pub const AVP_ERR_NOT_INITIALIZED: avp_ret_t = 1;
+pub const AVP_ERR_AUTHENTICATION_FAILED: avp_ret_t = 2;
+pub const AVP_ERR_SESSION_EXPIRED: avp_ret_t = 3;
+pub const AVP_ERR_SECRET_NOT_FOUND: avp_ret_t = 4;
+pub const AVP_ERR_CAPACITY_EXCEEDED: avp_ret_t = 5;
+pub const AVP_ERR_INVALID_NAME: avp_ret_t = 6;
+pub const AVP_ERR_HARDWARE_ERROR: avp_ret_t = 7;
+pub const AVP_ERR_CRYPTO_ERROR: avp_ret_t = 8;
+pub const AVP_ERR_INTERNAL: avp_ret_t = 9;
+
+/// Agent side of a connection to the daemon.
+#[repr(C)]
+#[derive(Debug)]
+pub struct avp_agent_t {
+    pub fd: c_int,
+    pub shm: *mut u8,
+}
+
+/// Secret metadata returned by LIST, the layout follows the features.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct avp_secret_metadata_t {
+    pub name: [c_char; AVP_MAX_SECRET_NAME_LEN + 1],
+    pub created_at: u32,
+    pub updated_at: u32,
+    pub slot_index: u8,
+    pub version: u32,
+    #[cfg(feature = "envelope")]
+    pub enveloped: bool,
+    #[cfg(feature = "compress")]
+    pub compressed: bool,
+}
+
+extern "C" {
+    pub fn avp_agent_connect(agent: *mut avp_agent_t, path: *const c_char) -> avp_ret_t;
+    pub fn avp_agent_disconnect(agent: *mut avp_agent_t);
+    pub fn avp_agent_authenticate(
+        agent: *mut avp_agent_t,
+        workspace: *const c_char,
+        pin: *const c_char,
+        ttl_seconds: u32,
+    ) -> avp_ret_t;
+    pub fn avp_agent_store(
+        agent: *mut avp_agent_t,
+        name: *const c_char,
+        value: *const u8,
+        value_len: usize,
+    ) -> avp_ret_t;
+    pub fn avp_agent_retrieve(
+        agent: *mut avp_agent_t,
+        name: *const c_char,
+        value: *mut u8,
+        value_len: *mut usize,
+    ) -> avp_ret_t;
+    pub fn avp_agent_delete(agent: *mut avp_agent_t, name: *const c_char, deleted: *mut bool) -> avp_ret_t;
+    pub fn avp_agent_list(
+        agent: *mut avp_agent_t,
+        secrets: *mut avp_secret_metadata_t,
+        max_secrets: usize,
+        count: *mut usize,
+    ) -> avp_ret_t;
+    pub fn avp_agent_metrics(agent: *mut avp_agent_t, text: *mut c_char, max_len: usize, len: *mut usize) -> avp_ret_t;
+}
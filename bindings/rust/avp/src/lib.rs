@@ -0,0 +1,224 @@
+//! Agents of the AVP vault daemon.
+//!
+//! Safe wrapper of the agent API of avp/avp_daemon.h. Nothing allocates:
+//! names are passed through a NUL-terminated copy on the stack, values are
+//! passed as slices and retrieve() writes the secret straight into the slice
+//! of the caller, which decides where plaintext lives and when it is wiped.
+
+use std::ffi::{c_char, CStr};
+use std::fmt;
+use std::mem::MaybeUninit;
+use std::path::Path;
+
+use avp_sys as sys;
+
+pub use sys::{AVP_MAX_SECRET_NAME_LEN as MAX_NAME_LEN, AVP_MAX_SECRET_VALUE_LEN as MAX_VALUE_LEN};
+
+/// Error of an operation, one variant per avp_ret_t code.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum Error {
+    NotInitialized,
+    AuthenticationFailed,
+    SessionExpired,
+    SecretNotFound,
+    CapacityExceeded,
+    InvalidName,
+    HardwareError,
+    CryptoError,
+    Internal,
+    /// Code this crate does not know.
+    Unknown(i32),
+}
+
+impl Error {
+    fn check(ret: sys::avp_ret_t) -> Result<()> {
+        Err(match ret {
+            sys::AVP_OK => return Ok(()),
+            sys::AVP_ERR_NOT_INITIALIZED => Error::NotInitialized,
+            sys::AVP_ERR_AUTHENTICATION_FAILED => Error::AuthenticationFailed,
+            sys::AVP_ERR_SESSION_EXPIRED => Error::SessionExpired,
+            sys::AVP_ERR_SECRET_NOT_FOUND => Error::SecretNotFound,
+            sys::AVP_ERR_CAPACITY_EXCEEDED => Error::CapacityExceeded,
+            sys::AVP_ERR_INVALID_NAME => Error::InvalidName,
+            sys::AVP_ERR_HARDWARE_ERROR => Error::HardwareError,
+            sys::AVP_ERR_CRYPTO_ERROR => Error::CryptoError,
+            sys::AVP_ERR_INTERNAL => Error::Internal,
+            code => Error::Unknown(code),
+        })
+    }
+}
+
+impl fmt::Display for Error {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        match self {
+            Error::Unknown(code) => write!(f, "AVP error {code}"),
+            _ => write!(f, "AVP error {self:?}"),
+        }
+    }
+}
+
+impl std::error::Error for Error {}
+
+pub type Result<T> = std::result::Result<T, Error>;
+
+/// NUL-terminated copy of a name or PIN, without interior NUL.
+struct CBuf([u8; MAX_NAME_LEN + 1]);
+
+impl CBuf {
+    fn new(s: &[u8], err: Error) -> Result<CBuf> {
+        if s.len() > MAX_NAME_LEN || s.contains(&0) {
+            return Err(err);
+        }
+        let mut buf = CBuf([0; MAX_NAME_LEN + 1]);
+        buf.0[..s.len()].copy_from_slice(s);
+        Ok(buf)
+    }
+
+    fn as_ptr(&self) -> *const c_char {
+        self.0.as_ptr().cast()
+    }
+}
+
+impl Drop for CBuf {
+    fn drop(&mut self) {
+        // May hold the PIN
+        for b in self.0.iter_mut() {
+            unsafe { std::ptr::write_volatile(b, 0) };
+        }
+    }
+}
+
+/// Metadata of a secret, filled by [`Agent::list`].
+#[repr(transparent)]
+#[derive(Clone, Copy)]
+pub struct Metadata(sys::avp_secret_metadata_t);
+
+impl Default for Metadata {
+    fn default() -> Self {
+        // All-zero is an empty name and valid for every field
+        Metadata(unsafe { MaybeUninit::zeroed().assume_init() })
+    }
+}
+
+impl Metadata {
+    pub fn name(&self) -> &str {
+        let name = unsafe { CStr::from_ptr(self.0.name.as_ptr()) };
+        name.to_str().unwrap_or("")
+    }
+
+    pub fn created_at(&self) -> u32 {
+        self.0.created_at
+    }
+
+    pub fn updated_at(&self) -> u32 {
+        self.0.updated_at
+    }
+
+    pub fn slot_index(&self) -> u8 {
+        self.0.slot_index
+    }
+
+    pub fn version(&self) -> u32 {
+        self.0.version
+    }
+
+    #[cfg(feature = "envelope")]
+    pub fn enveloped(&self) -> bool {
+        self.0.enveloped
+    }
+
+    #[cfg(feature = "compress")]
+    pub fn compressed(&self) -> bool {
+        self.0.compressed
+    }
+}
+
+impl fmt::Debug for Metadata {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("Metadata")
+            .field("name", &self.name())
+            .field("created_at", &self.0.created_at)
+            .field("updated_at", &self.0.updated_at)
+            .field("slot_index", &self.0.slot_index)
+            .field("version", &self.0.version)
+            .finish()
+    }
+}
+
+/// Connection of an agent to the daemon, disconnected on drop.
+///
+/// Operations take `&mut self`: a connection serves one request at a time,
+/// concurrent agents open a connection each.
+#[derive(Debug)]
+pub struct Agent {
+    raw: sys::avp_agent_t,
+}
+
+// The connection is a socket and a mapping, neither is tied to a thread
+unsafe impl Send for Agent {}
+
+impl Agent {
+    /// Connects to the socket of the daemon.
+    pub fn connect<P: AsRef<Path>>(path: P) -> Result<Agent> {
+        use std::os::unix::ffi::OsStrExt;
+
+        let path = CBuf::new(path.as_ref().as_os_str().as_bytes(), Error::Internal)?;
+        let mut raw = sys::avp_agent_t { fd: -1, shm: std::ptr::null_mut() };
+        Error::check(unsafe { sys::avp_agent_connect(&mut raw, path.as_ptr()) })?;
+        Ok(Agent { raw })
+    }
+
+    /// Opens the session of the connection, `workspace` None is the default one.
+    pub fn authenticate(&mut self, workspace: Option<&str>, pin: &[u8], ttl_seconds: u32) -> Result<()> {
+        let workspace = workspace.map(|w| CBuf::new(w.as_bytes(), Error::InvalidName)).transpose()?;
+        let pin = CBuf::new(pin, Error::AuthenticationFailed)?;
+        let workspace_ptr = workspace.as_ref().map_or(std::ptr::null(), CBuf::as_ptr);
+        Error::check(unsafe { sys::avp_agent_authenticate(&mut self.raw, workspace_ptr, pin.as_ptr(), ttl_seconds) })
+    }
+
+    /// Stores the value under the name.
+    pub fn store(&mut self, name: &str, value: &[u8]) -> Result<()> {
+        let name = CBuf::new(name.as_bytes(), Error::InvalidName)?;
+        Error::check(unsafe { sys::avp_agent_store(&mut self.raw, name.as_ptr(), value.as_ptr(), value.len()) })
+    }
+
+    /// Writes the value into the start of `value`, returns its length.
+    ///
+    /// Fails with [`Error::Internal`] if `value` is shorter than the secret.
+    pub fn retrieve(&mut self, name: &str, value: &mut [u8]) -> Result<usize> {
+        let name = CBuf::new(name.as_bytes(), Error::InvalidName)?;
+        let mut len = value.len();
+        Error::check(unsafe { sys::avp_agent_retrieve(&mut self.raw, name.as_ptr(), value.as_mut_ptr(), &mut len) })?;
+        Ok(len)
+    }
+
+    /// Deletes the secret, returns whether it existed.
+    pub fn delete(&mut self, name: &str) -> Result<bool> {
+        let name = CBuf::new(name.as_bytes(), Error::InvalidName)?;
+        let mut deleted = false;
+        Error::check(unsafe { sys::avp_agent_delete(&mut self.raw, name.as_ptr(), &mut deleted) })?;
+        Ok(deleted)
+    }
+
+    /// Fills the start of `secrets` with the metadata of the stored secrets, returns their count.
+    pub fn list(&mut self, secrets: &mut [Metadata]) -> Result<usize> {
+        let mut count = 0;
+        let ptr = secrets.as_mut_ptr().cast::<sys::avp_secret_metadata_t>();
+        Error::check(unsafe { sys::avp_agent_list(&mut self.raw, ptr, secrets.len(), &mut count) })?;
+        Ok(count)
+    }
+
+    /// Writes the metrics of the daemon into `text`, needs no authentication.
+    pub fn metrics<'a>(&mut self, text: &'a mut [u8]) -> Result<&'a str> {
+        let mut len = 0;
+        let ptr = text.as_mut_ptr().cast::<c_char>();
+        Error::check(unsafe { sys::avp_agent_metrics(&mut self.raw, ptr, text.len(), &mut len) })?;
+        std::str::from_utf8(&text[..len]).map_err(|_| Error::Internal)
+    }
+}
+
+impl Drop for Agent {
+    fn drop(&mut self) {
+        unsafe { sys::avp_agent_disconnect(&mut self.raw) };
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef LT_ESP_HW_H
+#define LT_ESP_HW_H
+
+/**
+ * @file libtropic_esp_hw.h
+ * @brief ESP32 hardware crypto (AES and SHA peripherals) public declarations.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ *
+ * @note AES-GCM is computed by the AES peripheral through the ESP-IDF esp_aes_gcm driver, SHA-256 and HMAC-SHA256
+ *       use PSA hash operations, which ESP-IDF executes on the SHA peripheral. X25519 is computed in software by PSA.
+ */
+
+#include <stdint.h>
+
+#include "aes/esp_aes_gcm.h"
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wredundant-decls"
+#include "psa/crypto.h"
+#pragma GCC diagnostic pop
+
+/**
+ * @brief AES-GCM context structure for ESP32 AES peripheral.
+ *
+ */
+typedef struct lt_aesgcm_ctx_esp_hw_t {
+    /** @private @brief ESP-IDF AES-GCM context. */
+    esp_gcm_context gcm;
+    /** @private @brief Flag indicating if key is set. */
+    uint8_t key_set;
+} lt_aesgcm_ctx_esp_hw_t;
+
+/**
+ * @brief Context structure for ESP32 hardware crypto.
+ *
+ */
+typedef struct lt_ctx_esp_hw_t {
+    /** @private @brief AES-GCM context for encryption. */
+    lt_aesgcm_ctx_esp_hw_t aesgcm_encrypt_ctx;
+    /** @private @brief AES-GCM context for decryption. */
+    lt_aesgcm_ctx_esp_hw_t aesgcm_decrypt_ctx;
+    /** @private @brief SHA-256 context. */
+    psa_hash_operation_t sha256_ctx;
+    /** @private @brief PSA key identifier of HMAC-SHA256 key set by lt_hmac_sha256_init(). */
+    psa_key_id_t hmac_sha256_key_id;
+    /** @private @brief Flag indicating if HMAC-SHA256 key is set. */
+    uint8_t hmac_sha256_key_set;
+} lt_ctx_esp_hw_t;
+
+#ifdef LT_CRYPTO_OPS
+#include "libtropic_common.h"
+
+/** @brief Functions of the ESP32 CAL for `lt_crypto_ops_set()` and `lt_crypto_ops_probe()`. */
+extern const lt_crypto_ops_t lt_crypto_ops_esp_hw;
+#endif
+
+#endif  // LT_ESP_HW_H
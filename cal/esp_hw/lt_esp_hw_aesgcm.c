@@ -0,0 +1,150 @@
+/**
+ * @file lt_esp_hw_aesgcm.c
+ * @brief AES-GCM on the ESP32 AES peripheral, using the esp_aes_gcm driver of ESP-IDF directly.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "aes/esp_aes.h"
+#include "aes/esp_aes_gcm.h"
+#include "libtropic_common.h"
+#include "libtropic_esp_hw.h"
+#include "libtropic_logging.h"
+#include "lt_aesgcm.h"
+
+/**
+ * @brief Initializes ESP32 AES-GCM context.
+ *
+ * @param ctx      AES-GCM context structure (ESP32 hardware specific)
+ * @param key      Key to initialize with
+ * @param key_len  Length of the key
+ * @return         LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_aesgcm_init(lt_aesgcm_ctx_esp_hw_t *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    if (ctx->key_set) {
+        LT_LOG_ERROR("AES-GCM context already initialized!");
+        return LT_CRYPTO_ERR;
+    }
+
+    esp_aes_gcm_init(&ctx->gcm);
+    int ret = esp_aes_gcm_setkey(&ctx->gcm, MBEDTLS_CIPHER_ID_AES, key, key_len * 8);
+    if (ret != 0) {
+        LT_LOG_ERROR("Couldn't set AES-GCM key, ret=%d", ret);
+        esp_aes_gcm_free(&ctx->gcm);
+        return LT_CRYPTO_ERR;
+    }
+
+    ctx->key_set = 1;
+    return LT_OK;
+}
+
+/**
+ * @brief Deinitializes ESP32 AES-GCM context.
+ *
+ * @param ctx  AES-GCM context structure (ESP32 hardware specific)
+ * @return     LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_aesgcm_deinit(lt_aesgcm_ctx_esp_hw_t *ctx)
+{
+    if (ctx->key_set) {
+        // Also wipes the key.
+        esp_aes_gcm_free(&ctx->gcm);
+        ctx->key_set = 0;
+    }
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+
+    return lt_aesgcm_init(&_ctx->aesgcm_encrypt_ctx, key, key_len);
+}
+
+lt_ret_t lt_aesgcm_decrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+
+    return lt_aesgcm_init(&_ctx->aesgcm_decrypt_ctx, key, key_len);
+}
+
+lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                           const uint32_t add_len, const uint8_t *plaintext, const uint32_t plaintext_len,
+                           uint8_t *ciphertext, const uint32_t ciphertext_len)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+
+    if (ciphertext_len < plaintext_len + TR01_L3_TAG_SIZE) {
+        LT_LOG_ERROR("AES-GCM output (ciphertext) buffer too small! Current: %" PRIu32 " bytes, required: %" PRIu32
+                     " bytes",
+                     ciphertext_len, plaintext_len + TR01_L3_TAG_SIZE);
+        return LT_PARAM_ERR;
+    }
+
+    if (!_ctx->aesgcm_encrypt_ctx.key_set) {
+        LT_LOG_ERROR("AES-GCM context key not set!");
+        return LT_CRYPTO_ERR;
+    }
+
+    int ret = esp_aes_gcm_crypt_and_tag(&_ctx->aesgcm_encrypt_ctx.gcm, ESP_AES_ENCRYPT, plaintext_len, iv, iv_len, add,
+                                        add_len, plaintext, ciphertext, TR01_L3_TAG_SIZE, ciphertext + plaintext_len);
+    if (ret != 0) {
+        LT_LOG_ERROR("AES-GCM encryption failed, ret=%d", ret);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                           const uint32_t add_len, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                           uint8_t *plaintext, const uint32_t plaintext_len)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+    // Same as in the MbedTLS v4 CAL, the driver requires plaintext != NULL even for empty payload (e.g. when only
+    // the authentication tag is decrypted during Secure Session establishment).
+    uint8_t dummy_plaintext;
+    uint8_t *_plaintext = plaintext ? plaintext : &dummy_plaintext;
+
+    if ((ciphertext_len < TR01_L3_TAG_SIZE) || (plaintext_len < ciphertext_len - TR01_L3_TAG_SIZE)) {
+        LT_LOG_ERROR("AES-GCM output (plaintext) buffer too small! Current: %" PRIu32 " bytes, required: %" PRIu32
+                     " bytes",
+                     plaintext_len, ciphertext_len - TR01_L3_TAG_SIZE);
+        return LT_PARAM_ERR;
+    }
+
+    if (!_ctx->aesgcm_decrypt_ctx.key_set) {
+        LT_LOG_ERROR("AES-GCM context key not set!");
+        return LT_CRYPTO_ERR;
+    }
+
+    const uint32_t data_len = ciphertext_len - TR01_L3_TAG_SIZE;
+    int ret = esp_aes_gcm_auth_decrypt(&_ctx->aesgcm_decrypt_ctx.gcm, data_len, iv, iv_len, add, add_len,
+                                       ciphertext + data_len, TR01_L3_TAG_SIZE, ciphertext, _plaintext);
+    if (ret != 0) {
+        LT_LOG_ERROR("AES-GCM decryption failed, ret=%d", ret);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_deinit(void *ctx)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+
+    return lt_aesgcm_deinit(&_ctx->aesgcm_encrypt_ctx);
+}
+
+lt_ret_t lt_aesgcm_decrypt_deinit(void *ctx)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+
+    return lt_aesgcm_deinit(&_ctx->aesgcm_decrypt_ctx);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file lt_esp_hw_hmac_sha256.c
+ * @brief HMAC-SHA256 using PSA MAC operations, ESP-IDF executes the underlying hashing on the SHA peripheral.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wredundant-decls"
+#include "psa/crypto.h"
+#pragma GCC diagnostic pop
+#include "libtropic_common.h"
+#include "libtropic_esp_hw.h"
+#include "libtropic_logging.h"
+#include "lt_hmac_sha256.h"
+
+lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
+                        uint8_t *output)
+{
+    psa_status_t status;
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_key_id_t key_id = 0;
+    size_t mac_length;
+
+    // Set up key attributes for HMAC
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_MESSAGE);
+    psa_set_key_algorithm(&attributes, PSA_ALG_HMAC(PSA_ALG_SHA_256));
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_HMAC);
+
+    // Import the key
+    status = psa_import_key(&attributes, key, key_len, &key_id);
+    psa_reset_key_attributes(&attributes);
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("Couldn't import HMAC key, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+
+    // Compute HMAC-SHA256
+    status = psa_mac_compute(key_id, PSA_ALG_HMAC(PSA_ALG_SHA_256), input, input_len, output,
+                             PSA_HASH_LENGTH(PSA_ALG_SHA_256), &mac_length);
+
+    // Clean up
+    psa_status_t destroy_key_status = psa_destroy_key(key_id);
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("HMAC-SHA256 computation failed, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+
+    if (destroy_key_status != PSA_SUCCESS) {
+        LT_LOG_ERROR("Couldn't destroy HMAC key, status=%" PRId32 " (psa_status_t)", destroy_key_status);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+    psa_status_t status;
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_MESSAGE);
+    psa_set_key_algorithm(&attributes, PSA_ALG_HMAC(PSA_ALG_SHA_256));
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_HMAC);
+
+    // Key is imported once for all messages, PSA derives the inner and outer pad in each psa_mac_compute().
+    status = psa_import_key(&attributes, key, key_len, &_ctx->hmac_sha256_key_id);
+    psa_reset_key_attributes(&attributes);
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("Couldn't import HMAC key, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+    _ctx->hmac_sha256_key_set = 1;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_compute(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+    psa_status_t status;
+    size_t mac_length;
+
+    if (!_ctx->hmac_sha256_key_set) {
+        LT_LOG_ERROR("HMAC-SHA256 context key not set!");
+        return LT_CRYPTO_ERR;
+    }
+
+    status = psa_mac_compute(_ctx->hmac_sha256_key_id, PSA_ALG_HMAC(PSA_ALG_SHA_256), input, input_len, output,
+                             PSA_HASH_LENGTH(PSA_ALG_SHA_256), &mac_length);
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("HMAC-SHA256 computation failed, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_deinit(void *ctx)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+
+    if (_ctx->hmac_sha256_key_set) {
+        psa_status_t status = psa_destroy_key(_ctx->hmac_sha256_key_id);
+        if (status != PSA_SUCCESS) {
+            LT_LOG_ERROR("Couldn't destroy HMAC key, status=%" PRId32 " (psa_status_t)", status);
+            return LT_CRYPTO_ERR;
+        }
+        _ctx->hmac_sha256_key_set = 0;
+    }
+
+    return LT_OK;
+}
@@ -0,0 +1,24 @@
+/**
+ * @file lt_esp_hw_ops.c
+ * @brief ESP32 CAL built as one of the CALs selected at runtime (LT_CRYPTO_OPS), its functions are renamed to
+ * lt_esp_hw_* and collected in lt_crypto_ops_esp_hw.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#define LT_CRYPTO_OPS_BACKEND esp_hw
+#include "lt_crypto_ops_backend.h"
+
+#include "lt_esp_hw_common.c"
+#include "lt_esp_hw_aesgcm.c"
+#include "lt_esp_hw_sha256.c"
+#include "lt_esp_hw_hmac_sha256.c"
+#include "../mbedtls_v4/lt_mbedtls_v4_x25519.c"
+#ifdef LT_ED25519_VERIFY
+#include "../trezor_crypto/lt_trezor_crypto_ed25519.c"
+#endif
+
+#include "libtropic_esp_hw.h"
+
+LT_CRYPTO_OPS_DEFINE(lt_crypto_ops_esp_hw, "esp_hw");
@@ -0,0 +1,89 @@
+/**
+ * @file lt_esp_hw_sha256.c
+ * @brief SHA-256 using PSA hash operations, executed by ESP-IDF on the SHA peripheral.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wredundant-decls"
+#include "psa/crypto.h"
+#pragma GCC diagnostic pop
+#include "libtropic_common.h"
+#include "libtropic_esp_hw.h"
+#include "libtropic_logging.h"
+#include "lt_sha256.h"
+
+lt_ret_t lt_sha256_init(void *ctx)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+
+    // Initialize the hash operation
+    _ctx->sha256_ctx = psa_hash_operation_init();
+    return LT_OK;
+}
+
+lt_ret_t lt_sha256_start(void *ctx)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+    psa_status_t status;
+
+    // Set up the hash operation for SHA-256
+    status = psa_hash_setup(&_ctx->sha256_ctx, PSA_ALG_SHA_256);
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("SHA-256 setup failed, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sha256_update(void *ctx, const uint8_t *input, const size_t input_len)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+    psa_status_t status;
+
+    // Update the hash with input data
+    status = psa_hash_update(&_ctx->sha256_ctx, input, input_len);
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("SHA-256 update failed, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sha256_finish(void *ctx, uint8_t *output)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+    psa_status_t status;
+    size_t hash_length;
+
+    // Finalize the hash and get the digest
+    status = psa_hash_finish(&_ctx->sha256_ctx, output, PSA_HASH_LENGTH(PSA_ALG_SHA_256), &hash_length);
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("SHA-256 finish failed, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sha256_deinit(void *ctx)
+{
+    lt_ctx_esp_hw_t *_ctx = (lt_ctx_esp_hw_t *)ctx;
+
+    // Abort the hash operation to free resources
+    psa_status_t status = psa_hash_abort(&_ctx->sha256_ctx);
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("SHA-256 deinit failed, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
\ No newline at end of file
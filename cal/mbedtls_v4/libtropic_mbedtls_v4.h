@@ -23,6 +23,10 @@ typedef struct lt_aesgcm_ctx_mbedtls_v4_t {
     psa_key_id_t key_id;
     /** @private @brief Flag indicating if key is set. */
     uint8_t key_set;
+#if defined(LT_L3_STREAM_ENCRYPT) || defined(LT_L3_STREAM_DECRYPT)
+    /** @private @brief Multi-part AEAD operation of streaming encryption or decryption. */
+    psa_aead_operation_t op;
+#endif
 } lt_aesgcm_ctx_mbedtls_v4_t;
 
 /**
@@ -36,6 +40,17 @@ typedef struct lt_ctx_mbedtls_v4_t {
     lt_aesgcm_ctx_mbedtls_v4_t aesgcm_decrypt_ctx;
     /** @private @brief SHA-256 context. */
     psa_hash_operation_t sha256_ctx;
+    /** @private @brief PSA key identifier of HMAC-SHA256 key set by lt_hmac_sha256_init(). */
+    psa_key_id_t hmac_sha256_key_id;
+    /** @private @brief Flag indicating if HMAC-SHA256 key is set. */
+    uint8_t hmac_sha256_key_set;
 } lt_ctx_mbedtls_v4_t;
 
+#ifdef LT_CRYPTO_OPS
+#include "libtropic_common.h"
+
+/** @brief Functions of the MbedTLS v4 CAL for `lt_crypto_ops_set()` and `lt_crypto_ops_probe()`. */
+extern const lt_crypto_ops_t lt_crypto_ops_mbedtls_v4;
+#endif
+
 #endif  // LT_MBEDTLS_V4_H
\ No newline at end of file
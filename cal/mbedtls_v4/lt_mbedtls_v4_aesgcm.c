@@ -21,13 +21,17 @@
 
 /**
  * @brief Initializes MbedTLS AES-GCM context.
+ * @details The key is imported as a volatile key once per Secure Session, every L3 packet then references it by the
+ * key ID, without any further setup of the key.
  *
  * @param ctx      AES-GCM context structure (MbedTLS specific)
  * @param key      Key to initialize with
  * @param key_len  Length of the key
+ * @param usage    PSA_KEY_USAGE_ENCRYPT or PSA_KEY_USAGE_DECRYPT, the key is used only in one direction
  * @return         LT_OK if success, otherwise returns other error code.
  */
-static lt_ret_t lt_aesgcm_init(lt_aesgcm_ctx_mbedtls_v4_t *ctx, const uint8_t *key, const uint32_t key_len)
+static lt_ret_t lt_aesgcm_init(lt_aesgcm_ctx_mbedtls_v4_t *ctx, const uint8_t *key, const uint32_t key_len,
+                               const psa_key_usage_t usage)
 {
     psa_status_t status;
     psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
@@ -38,7 +42,8 @@ static lt_ret_t lt_aesgcm_init(lt_aesgcm_ctx_mbedtls_v4_t *ctx, const uint8_t *k
     }
 
     // Set up key attributes
-    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+    psa_set_key_lifetime(&attributes, PSA_KEY_LIFETIME_VOLATILE);
+    psa_set_key_usage_flags(&attributes, usage);
     psa_set_key_algorithm(&attributes, PSA_ALG_GCM);
     psa_set_key_type(&attributes, PSA_KEY_TYPE_AES);
     psa_set_key_bits(&attributes, key_len * 8);
@@ -64,6 +69,10 @@ static lt_ret_t lt_aesgcm_init(lt_aesgcm_ctx_mbedtls_v4_t *ctx, const uint8_t *k
  */
 static lt_ret_t lt_aesgcm_deinit(lt_aesgcm_ctx_mbedtls_v4_t *ctx)
 {
+#if defined(LT_L3_STREAM_ENCRYPT) || defined(LT_L3_STREAM_DECRYPT)
+    // Streaming operation might have been left unfinished, e.g. when sending or receiving of L3 packet failed.
+    psa_aead_abort(&ctx->op);
+#endif
     if (ctx->key_set) {
         psa_status_t status = psa_destroy_key(ctx->key_id);
         if (status != PSA_SUCCESS) {
@@ -79,14 +88,14 @@ lt_ret_t lt_aesgcm_encrypt_init(void *ctx, const uint8_t *key, const uint32_t ke
 {
     lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
 
-    return lt_aesgcm_init(&_ctx->aesgcm_encrypt_ctx, key, key_len);
+    return lt_aesgcm_init(&_ctx->aesgcm_encrypt_ctx, key, key_len, PSA_KEY_USAGE_ENCRYPT);
 }
 
 lt_ret_t lt_aesgcm_decrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
 {
     lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
 
-    return lt_aesgcm_init(&_ctx->aesgcm_decrypt_ctx, key, key_len);
+    return lt_aesgcm_init(&_ctx->aesgcm_decrypt_ctx, key, key_len, PSA_KEY_USAGE_DECRYPT);
 }
 
 lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
@@ -109,7 +118,7 @@ lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
         return LT_CRYPTO_ERR;
     }
 
-    // PSA AEAD encrypt operation
+    // Single-shot AEAD, one call into PSA (one secure gateway call with TF-M) per L3 command.
     status = psa_aead_encrypt(_ctx->aesgcm_encrypt_ctx.key_id, PSA_ALG_GCM, iv, iv_len, add, add_len, plaintext,
                               plaintext_len, ciphertext, ciphertext_len, &resulting_length);
 
@@ -127,6 +136,92 @@ lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
     return LT_OK;
 }
 
+#ifdef LT_L3_STREAM_ENCRYPT
+lt_ret_t lt_aesgcm_encrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+    psa_status_t status;
+
+    if (!_ctx->aesgcm_encrypt_ctx.key_set) {
+        LT_LOG_ERROR("AES-GCM context key not set!");
+        return LT_CRYPTO_ERR;
+    }
+
+    // Previous streaming encryption might have been left unfinished.
+    psa_aead_abort(&_ctx->aesgcm_encrypt_ctx.op);
+
+    status = psa_aead_encrypt_setup(&_ctx->aesgcm_encrypt_ctx.op, _ctx->aesgcm_encrypt_ctx.key_id, PSA_ALG_GCM);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_nonce(&_ctx->aesgcm_encrypt_ctx.op, iv, iv_len);
+    }
+    if ((status == PSA_SUCCESS) && add_len) {
+        status = psa_aead_update_ad(&_ctx->aesgcm_encrypt_ctx.op, add, add_len);
+    }
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("AES-GCM encryption setup failed, status=%" PRId32 " (psa_status_t)", status);
+        psa_aead_abort(&_ctx->aesgcm_encrypt_ctx.op);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_update(void *ctx, const uint8_t *plaintext, const uint32_t plaintext_len,
+                                  uint8_t *ciphertext)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+    psa_status_t status;
+    size_t resulting_length;
+
+    status = psa_aead_update(&_ctx->aesgcm_encrypt_ctx.op, plaintext, plaintext_len, ciphertext, plaintext_len,
+                             &resulting_length);
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("AES-GCM encryption failed, status=%" PRId32 " (psa_status_t)", status);
+        psa_aead_abort(&_ctx->aesgcm_encrypt_ctx.op);
+        return LT_CRYPTO_ERR;
+    }
+
+    // GCM is a stream mode, the whole part has to be encrypted right away.
+    if (resulting_length != plaintext_len) {
+        LT_LOG_ERROR("AES-GCM encryption output length mismatch! Current: %zu bytes, expected: %" PRIu32 " bytes",
+                     resulting_length, plaintext_len);
+        psa_aead_abort(&_ctx->aesgcm_encrypt_ctx.op);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_finish(void *ctx, uint8_t *tag, const uint32_t tag_len)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+    psa_status_t status;
+    size_t resulting_length;
+    size_t tag_length;
+    uint8_t dummy_ciphertext;
+
+    status = psa_aead_finish(&_ctx->aesgcm_encrypt_ctx.op, &dummy_ciphertext, sizeof(dummy_ciphertext),
+                             &resulting_length, tag, tag_len, &tag_length);
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("AES-GCM encryption finish failed, status=%" PRId32 " (psa_status_t)", status);
+        psa_aead_abort(&_ctx->aesgcm_encrypt_ctx.op);
+        return LT_CRYPTO_ERR;
+    }
+
+    if (tag_length != tag_len) {
+        LT_LOG_ERROR("AES-GCM tag length mismatch! Current: %zu bytes, expected: %" PRIu32 " bytes", tag_length,
+                     tag_len);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+#endif
+
 lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
                            const uint32_t add_len, const uint8_t *ciphertext, const uint32_t ciphertext_len,
                            uint8_t *plaintext, const uint32_t plaintext_len)
@@ -159,7 +254,7 @@ lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
         return LT_CRYPTO_ERR;
     }
 
-    // PSA AEAD decrypt operation
+    // Single-shot AEAD, one call into PSA (one secure gateway call with TF-M) per L3 result.
     status = psa_aead_decrypt(_ctx->aesgcm_decrypt_ctx.key_id, PSA_ALG_GCM, iv, iv_len, add, add_len, ciphertext,
                               ciphertext_len, _plaintext, _plaintext_len, &resulting_length);
 
@@ -177,6 +272,85 @@ lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
     return LT_OK;
 }
 
+#ifdef LT_L3_STREAM_DECRYPT
+lt_ret_t lt_aesgcm_decrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+    psa_status_t status;
+
+    if (!_ctx->aesgcm_decrypt_ctx.key_set) {
+        LT_LOG_ERROR("AES-GCM context key not set!");
+        return LT_CRYPTO_ERR;
+    }
+
+    // Previous streaming decryption might have been left unfinished.
+    psa_aead_abort(&_ctx->aesgcm_decrypt_ctx.op);
+
+    status = psa_aead_decrypt_setup(&_ctx->aesgcm_decrypt_ctx.op, _ctx->aesgcm_decrypt_ctx.key_id, PSA_ALG_GCM);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_nonce(&_ctx->aesgcm_decrypt_ctx.op, iv, iv_len);
+    }
+    if ((status == PSA_SUCCESS) && add_len) {
+        status = psa_aead_update_ad(&_ctx->aesgcm_decrypt_ctx.op, add, add_len);
+    }
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("AES-GCM decryption setup failed, status=%" PRId32 " (psa_status_t)", status);
+        psa_aead_abort(&_ctx->aesgcm_decrypt_ctx.op);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_decrypt_update(void *ctx, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                                  uint8_t *plaintext)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+    psa_status_t status;
+    size_t resulting_length;
+
+    status = psa_aead_update(&_ctx->aesgcm_decrypt_ctx.op, ciphertext, ciphertext_len, plaintext, ciphertext_len,
+                             &resulting_length);
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("AES-GCM decryption failed, status=%" PRId32 " (psa_status_t)", status);
+        psa_aead_abort(&_ctx->aesgcm_decrypt_ctx.op);
+        return LT_CRYPTO_ERR;
+    }
+
+    // GCM is a stream mode, the whole part has to be decrypted right away.
+    if (resulting_length != ciphertext_len) {
+        LT_LOG_ERROR("AES-GCM decryption output length mismatch! Current: %zu bytes, expected: %" PRIu32 " bytes",
+                     resulting_length, ciphertext_len);
+        psa_aead_abort(&_ctx->aesgcm_decrypt_ctx.op);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_decrypt_finish(void *ctx, const uint8_t *tag, const uint32_t tag_len)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+    psa_status_t status;
+    size_t resulting_length;
+    uint8_t dummy_plaintext;
+
+    status = psa_aead_verify(&_ctx->aesgcm_decrypt_ctx.op, &dummy_plaintext, sizeof(dummy_plaintext),
+                             &resulting_length, tag, tag_len);
+
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("AES-GCM tag verification failed, status=%" PRId32 " (psa_status_t)", status);
+        psa_aead_abort(&_ctx->aesgcm_decrypt_ctx.op);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+#endif
+
 lt_ret_t lt_aesgcm_encrypt_deinit(void *ctx)
 {
     lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
@@ -15,6 +15,7 @@
 #include "libtropic_mbedtls_v4.h"
 #include "lt_aesgcm.h"
 #include "lt_crypto_common.h"
+#include "lt_hmac_sha256.h"
 
 lt_ret_t lt_crypto_ctx_init(void *ctx)
 {
@@ -22,6 +23,11 @@ lt_ret_t lt_crypto_ctx_init(void *ctx)
 
     _ctx->aesgcm_encrypt_ctx.key_set = 0;
     _ctx->aesgcm_decrypt_ctx.key_set = 0;
+    _ctx->hmac_sha256_key_set = 0;
+#if defined(LT_L3_STREAM_ENCRYPT) || defined(LT_L3_STREAM_DECRYPT)
+    _ctx->aesgcm_encrypt_ctx.op = psa_aead_operation_init();
+    _ctx->aesgcm_decrypt_ctx.op = psa_aead_operation_init();
+#endif
 
     return LT_OK;
 }
@@ -30,6 +36,7 @@ lt_ret_t lt_crypto_ctx_deinit(void *ctx)
 {
     lt_ret_t ret1 = lt_aesgcm_encrypt_deinit(ctx);
     lt_ret_t ret2 = lt_aesgcm_decrypt_deinit(ctx);
+    lt_ret_t ret3 = lt_hmac_sha256_deinit(ctx);
 
     if (ret1 != LT_OK) {
         return ret1;
@@ -37,6 +44,9 @@ lt_ret_t lt_crypto_ctx_deinit(void *ctx)
     if (ret2 != LT_OK) {
         return ret2;
     }
+    if (ret3 != LT_OK) {
+        return ret3;
+    }
 
     return LT_OK;
 }
\ No newline at end of file
@@ -14,23 +14,28 @@
 #pragma GCC diagnostic pop
 #include "libtropic_common.h"
 #include "libtropic_logging.h"
+#include "libtropic_mbedtls_v4.h"
 #include "lt_hmac_sha256.h"
 
-lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
-                        uint8_t *output)
+/**
+ * @brief Imports a volatile HMAC-SHA256 key.
+ *
+ * @param key      Key to import
+ * @param key_len  Length of the key
+ * @param key_id   PSA key identifier of the imported key
+ * @return         LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_hmac_sha256_import(const uint8_t *key, const uint32_t key_len, psa_key_id_t *key_id)
 {
     psa_status_t status;
     psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
-    psa_key_id_t key_id = 0;
-    size_t mac_length;
 
-    // Set up key attributes for HMAC
+    psa_set_key_lifetime(&attributes, PSA_KEY_LIFETIME_VOLATILE);
     psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_MESSAGE);
     psa_set_key_algorithm(&attributes, PSA_ALG_HMAC(PSA_ALG_SHA_256));
     psa_set_key_type(&attributes, PSA_KEY_TYPE_HMAC);
 
-    // Import the key
-    status = psa_import_key(&attributes, key, key_len, &key_id);
+    status = psa_import_key(&attributes, key, key_len, key_id);
     psa_reset_key_attributes(&attributes);
 
     if (status != PSA_SUCCESS) {
@@ -38,6 +43,21 @@ lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_
         return LT_CRYPTO_ERR;
     }
 
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
+                        uint8_t *output)
+{
+    psa_status_t status;
+    psa_key_id_t key_id = 0;
+    size_t mac_length;
+
+    lt_ret_t ret = lt_hmac_sha256_import(key, key_len, &key_id);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Compute HMAC-SHA256
     status = psa_mac_compute(key_id, PSA_ALG_HMAC(PSA_ALG_SHA_256), input, input_len, output,
                              PSA_HASH_LENGTH(PSA_ALG_SHA_256), &mac_length);
@@ -57,3 +77,59 @@ lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_
 
     return LT_OK;
 }
+
+lt_ret_t lt_hmac_sha256_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+
+    if (_ctx->hmac_sha256_key_set) {
+        LT_LOG_ERROR("HMAC-SHA256 context already initialized!");
+        return LT_CRYPTO_ERR;
+    }
+
+    // Key is imported once for all messages, PSA derives the inner and outer pad in each psa_mac_compute().
+    lt_ret_t ret = lt_hmac_sha256_import(key, key_len, &_ctx->hmac_sha256_key_id);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    _ctx->hmac_sha256_key_set = 1;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_compute(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+    psa_status_t status;
+    size_t mac_length;
+
+    if (!_ctx->hmac_sha256_key_set) {
+        LT_LOG_ERROR("HMAC-SHA256 context key not set!");
+        return LT_CRYPTO_ERR;
+    }
+
+    status = psa_mac_compute(_ctx->hmac_sha256_key_id, PSA_ALG_HMAC(PSA_ALG_SHA_256), input, input_len, output,
+                             PSA_HASH_LENGTH(PSA_ALG_SHA_256), &mac_length);
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("HMAC-SHA256 computation failed, status=%" PRId32 " (psa_status_t)", status);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_deinit(void *ctx)
+{
+    lt_ctx_mbedtls_v4_t *_ctx = (lt_ctx_mbedtls_v4_t *)ctx;
+
+    if (_ctx->hmac_sha256_key_set) {
+        psa_status_t status = psa_destroy_key(_ctx->hmac_sha256_key_id);
+        if (status != PSA_SUCCESS) {
+            LT_LOG_ERROR("Couldn't destroy HMAC key, status=%" PRId32 " (psa_status_t)", status);
+            return LT_CRYPTO_ERR;
+        }
+        _ctx->hmac_sha256_key_set = 0;
+    }
+
+    return LT_OK;
+}
@@ -0,0 +1,26 @@
+/**
+ * @file lt_mbedtls_v4_ops.c
+ * @brief MbedTLS v4 CAL built as one of the CALs selected at runtime (LT_CRYPTO_OPS), its functions are renamed to
+ * lt_mbedtls_v4_* and collected in lt_crypto_ops_mbedtls_v4.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#define LT_CRYPTO_OPS_BACKEND mbedtls_v4
+// Streaming AES-GCM of LT_L3_STREAM_ENCRYPT and LT_L3_STREAM_DECRYPT is implemented.
+#define LT_CRYPTO_OPS_AESGCM_STREAM
+#include "lt_crypto_ops_backend.h"
+
+#include "lt_mbedtls_v4_common.c"
+#include "lt_mbedtls_v4_aesgcm.c"
+#include "lt_mbedtls_v4_sha256.c"
+#include "lt_mbedtls_v4_hmac_sha256.c"
+#include "lt_mbedtls_v4_x25519.c"
+#ifdef LT_ED25519_VERIFY
+#include "../trezor_crypto/lt_trezor_crypto_ed25519.c"
+#endif
+
+#include "libtropic_mbedtls_v4.h"
+
+LT_CRYPTO_OPS_DEFINE(lt_crypto_ops_mbedtls_v4, "mbedtls_v4");
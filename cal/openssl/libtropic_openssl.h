@@ -22,6 +22,28 @@ typedef struct lt_ctx_openssl_t {
     EVP_CIPHER_CTX *aesgcm_decrypt_ctx;
     /** @private @brief SHA-256 context. */
     EVP_MD_CTX *sha256_ctx;
+    /** @private @brief HMAC-SHA256 context keyed by lt_hmac_sha256_init(), copied for every message. */
+    EVP_MD_CTX *hmac_sha256_ctx;
+    /** @private @brief HMAC-SHA256 context of the message being computed. */
+    EVP_MD_CTX *hmac_sha256_msg_ctx;
 } lt_ctx_openssl_t;
 
+#ifdef LT_OPENSSL_AESGCM_REUSE
+/**
+ * @brief Frees AES-GCM contexts, which are kept in the context across Secure Sessions.
+ * @note With LT_OPENSSL_AESGCM_REUSE, the context has to be zero-initialized before the first lt_init() and this
+ * function has to be called after lt_deinit(), otherwise the AES-GCM contexts leak.
+ *
+ * @param ctx  Context structure
+ */
+void lt_openssl_ctx_free(lt_ctx_openssl_t *ctx);
+#endif
+
+#ifdef LT_CRYPTO_OPS
+#include "libtropic_common.h"
+
+/** @brief Functions of the OpenSSL CAL for `lt_crypto_ops_set()` and `lt_crypto_ops_probe()`. */
+extern const lt_crypto_ops_t lt_crypto_ops_openssl;
+#endif
+
 #endif  // LT_OPENSSL_H
\ No newline at end of file
@@ -17,6 +17,27 @@
 #include "libtropic_openssl.h"
 #include "lt_aesgcm.h"
 
+#ifdef LT_OPENSSL_AESGCM_REUSE
+/**
+ * @brief Sets key of an AES-GCM context, which already has the cipher type and IV length set.
+ *
+ * @param cipher_ctx  AES-GCM context
+ * @param key         Key, TR01_AES256_KEY_LEN bytes
+ * @param enc         1 for encryption context, 0 for decryption context
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_openssl_aesgcm_set_key(EVP_CIPHER_CTX *cipher_ctx, const uint8_t *key, const int enc)
+{
+    if (!EVP_CipherInit_ex(cipher_ctx, NULL, NULL, key, NULL, enc)) {
+        unsigned long err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to set AES-GCM key, err_code=%lu (%s)", err_code, ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+#endif
+
 lt_ret_t lt_aesgcm_encrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
 {
     if (key_len != TR01_AES256_KEY_LEN) {
@@ -28,6 +49,13 @@ lt_ret_t lt_aesgcm_encrypt_init(void *ctx, const uint8_t *key, const uint32_t ke
     lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
     unsigned long err_code;
 
+#ifdef LT_OPENSSL_AESGCM_REUSE
+    // Context kept from the previous session already has cipher type and IV length set, only rekey it.
+    if (_ctx->aesgcm_encrypt_ctx) {
+        return lt_openssl_aesgcm_set_key(_ctx->aesgcm_encrypt_ctx, key, 1);
+    }
+#endif
+
     // Initialize AES-GCM encryption context.
     _ctx->aesgcm_encrypt_ctx = EVP_CIPHER_CTX_new();
     if (!_ctx->aesgcm_encrypt_ctx) {
@@ -75,6 +103,13 @@ lt_ret_t lt_aesgcm_decrypt_init(void *ctx, const uint8_t *key, const uint32_t ke
     lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
     unsigned long err_code;
 
+#ifdef LT_OPENSSL_AESGCM_REUSE
+    // Context kept from the previous session already has cipher type and IV length set, only rekey it.
+    if (_ctx->aesgcm_decrypt_ctx) {
+        return lt_openssl_aesgcm_set_key(_ctx->aesgcm_decrypt_ctx, key, 0);
+    }
+#endif
+
     // Initialize AES-GCM decryption context.
     _ctx->aesgcm_decrypt_ctx = EVP_CIPHER_CTX_new();
     if (!_ctx->aesgcm_decrypt_ctx) {
@@ -174,6 +209,88 @@ lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
     return LT_OK;
 }
 
+#ifdef LT_L3_STREAM_ENCRYPT
+lt_ret_t lt_aesgcm_encrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len)
+{
+    if (iv_len != TR01_L3_IV_SIZE) {
+        LT_LOG_ERROR("Invalid AES-GCM IV length: got %" PRIu32 " bytes, expected %d bytes", iv_len, TR01_L3_IV_SIZE);
+        return LT_PARAM_ERR;
+    }
+
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+    unsigned long err_code;
+    int out_len;
+
+    // Set IV.
+    if (!EVP_EncryptInit_ex(_ctx->aesgcm_encrypt_ctx, NULL, NULL, NULL, iv)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to set AES-GCM encryption IV, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    // Process AAD (Additional Authenticated Data).
+    if (!EVP_EncryptUpdate(_ctx->aesgcm_encrypt_ctx, NULL, &out_len, add, (int)add_len)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to process AES-GCM AAD, err_code=%lu (%s)", err_code, ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_update(void *ctx, const uint8_t *plaintext, const uint32_t plaintext_len,
+                                  uint8_t *ciphertext)
+{
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+    unsigned long err_code;
+    int out_len;
+
+    if (!EVP_EncryptUpdate(_ctx->aesgcm_encrypt_ctx, ciphertext, &out_len, plaintext, (int)plaintext_len)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to encrypt AES-GCM plaintext, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    // GCM is a stream mode, the whole part has to be encrypted right away.
+    if (out_len != (int)plaintext_len) {
+        LT_LOG_ERROR("AES-GCM encryption length mismatch! Current: %d bytes, expected: %" PRIu32 " bytes", out_len,
+                     plaintext_len);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_finish(void *ctx, uint8_t *tag, const uint32_t tag_len)
+{
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+    unsigned long err_code;
+    uint8_t dummy_ciphertext[TR01_L3_TAG_SIZE];
+    int out_len;
+
+    // Finalize encryption, no ciphertext is left in GCM mode.
+    if (!EVP_EncryptFinal_ex(_ctx->aesgcm_encrypt_ctx, dummy_ciphertext, &out_len)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to finalize AES-GCM encryption, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    // Get the tag.
+    if (!EVP_CIPHER_CTX_ctrl(_ctx->aesgcm_encrypt_ctx, EVP_CTRL_GCM_GET_TAG, (int)tag_len, tag)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to get AES-GCM encryption tag, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+#endif
+
 lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
                            const uint32_t add_len, const uint8_t *ciphertext, const uint32_t ciphertext_len,
                            uint8_t *plaintext, const uint32_t plaintext_len)
@@ -238,12 +355,102 @@ lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
     return LT_OK;
 }
 
+#ifdef LT_L3_STREAM_DECRYPT
+lt_ret_t lt_aesgcm_decrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len)
+{
+    if (iv_len != TR01_L3_IV_SIZE) {
+        LT_LOG_ERROR("Invalid AES-GCM IV length: got %" PRIu32 " bytes, expected %d bytes", iv_len, TR01_L3_IV_SIZE);
+        return LT_PARAM_ERR;
+    }
+
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+    unsigned long err_code;
+    int out_len;
+
+    // Set IV.
+    if (!EVP_DecryptInit_ex(_ctx->aesgcm_decrypt_ctx, NULL, NULL, NULL, iv)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to set AES-GCM decryption IV, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    // Process AAD (Additional Authenticated Data).
+    if (!EVP_DecryptUpdate(_ctx->aesgcm_decrypt_ctx, NULL, &out_len, add, (int)add_len)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to process AES-GCM AAD, err_code=%lu (%s)", err_code, ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_decrypt_update(void *ctx, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                                  uint8_t *plaintext)
+{
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+    unsigned long err_code;
+    int out_len;
+
+    if (!EVP_DecryptUpdate(_ctx->aesgcm_decrypt_ctx, plaintext, &out_len, ciphertext, (int)ciphertext_len)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to decrypt AES-GCM ciphertext, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    // GCM is a stream mode, the whole part has to be decrypted right away.
+    if (out_len != (int)ciphertext_len) {
+        LT_LOG_ERROR("AES-GCM decryption length mismatch! Current: %d bytes, expected: %" PRIu32 " bytes", out_len,
+                     ciphertext_len);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_decrypt_finish(void *ctx, const uint8_t *tag, const uint32_t tag_len)
+{
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+    unsigned long err_code;
+    uint8_t dummy_plaintext[TR01_L3_TAG_SIZE];
+    int out_len;
+
+    // Set expected tag value.
+    if (!EVP_CIPHER_CTX_ctrl(_ctx->aesgcm_decrypt_ctx, EVP_CTRL_GCM_SET_TAG, (int)tag_len, (void *)tag)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to set AES-GCM decryption tag, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    // Finalize decryption, no plaintext is left in GCM mode.
+    if (EVP_DecryptFinal_ex(_ctx->aesgcm_decrypt_ctx, dummy_plaintext, &out_len) <= 0) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to finalize AES-GCM decryption, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+#endif
+
 lt_ret_t lt_aesgcm_encrypt_deinit(void *ctx)
 {
     lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
 
+#ifdef LT_OPENSSL_AESGCM_REUSE
+    // Keep the context for the next session, only overwrite the session key.
+    if (_ctx->aesgcm_encrypt_ctx) {
+        static const uint8_t zero_key[TR01_AES256_KEY_LEN] = {0};
+        return lt_openssl_aesgcm_set_key(_ctx->aesgcm_encrypt_ctx, zero_key, 1);
+    }
+#else
     EVP_CIPHER_CTX_free(_ctx->aesgcm_encrypt_ctx);
     _ctx->aesgcm_encrypt_ctx = NULL;
+#endif
 
     return LT_OK;
 }
@@ -252,8 +459,30 @@ lt_ret_t lt_aesgcm_decrypt_deinit(void *ctx)
 {
     lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
 
+#ifdef LT_OPENSSL_AESGCM_REUSE
+    // Keep the context for the next session, only overwrite the session key.
+    if (_ctx->aesgcm_decrypt_ctx) {
+        static const uint8_t zero_key[TR01_AES256_KEY_LEN] = {0};
+        return lt_openssl_aesgcm_set_key(_ctx->aesgcm_decrypt_ctx, zero_key, 0);
+    }
+#else
     EVP_CIPHER_CTX_free(_ctx->aesgcm_decrypt_ctx);
     _ctx->aesgcm_decrypt_ctx = NULL;
+#endif
 
     return LT_OK;
-}
\ No newline at end of file
+}
+
+#ifdef LT_OPENSSL_AESGCM_REUSE
+void lt_openssl_ctx_free(lt_ctx_openssl_t *ctx)
+{
+    if (!ctx) {
+        return;
+    }
+
+    EVP_CIPHER_CTX_free(ctx->aesgcm_encrypt_ctx);
+    ctx->aesgcm_encrypt_ctx = NULL;
+    EVP_CIPHER_CTX_free(ctx->aesgcm_decrypt_ctx);
+    ctx->aesgcm_decrypt_ctx = NULL;
+}
+#endif
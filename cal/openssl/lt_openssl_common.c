@@ -11,15 +11,21 @@
 #include "libtropic_openssl.h"
 #include "lt_aesgcm.h"
 #include "lt_crypto_common.h"
+#include "lt_hmac_sha256.h"
 #include "lt_sha256.h"
 
 lt_ret_t lt_crypto_ctx_init(void *ctx)
 {
     lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
 
+    // With LT_OPENSSL_AESGCM_REUSE, AES-GCM contexts survive lt_deinit() until lt_openssl_ctx_free().
+#ifndef LT_OPENSSL_AESGCM_REUSE
     _ctx->aesgcm_encrypt_ctx = NULL;
     _ctx->aesgcm_decrypt_ctx = NULL;
+#endif
     _ctx->sha256_ctx = NULL;
+    _ctx->hmac_sha256_ctx = NULL;
+    _ctx->hmac_sha256_msg_ctx = NULL;
 
     return LT_OK;
 }
@@ -29,6 +35,7 @@ lt_ret_t lt_crypto_ctx_deinit(void *ctx)
     lt_ret_t ret1 = lt_aesgcm_encrypt_deinit(ctx);
     lt_ret_t ret2 = lt_aesgcm_decrypt_deinit(ctx);
     lt_ret_t ret3 = lt_sha256_deinit(ctx);
+    lt_ret_t ret4 = lt_hmac_sha256_deinit(ctx);
 
     if (ret1 != LT_OK) {
         return ret1;
@@ -39,6 +46,9 @@ lt_ret_t lt_crypto_ctx_deinit(void *ctx)
     if (ret3 != LT_OK) {
         return ret3;
     }
+    if (ret4 != LT_OK) {
+        return ret4;
+    }
 
     return LT_OK;
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**
+ * @file lt_openssl_ed25519.c
+ * @brief Verification of many Ed25519 signatures, OpenSSL has no batch verification, but the public key is decoded
+ * once for adjacent signatures of the same key and the digest context is reused.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+
+lt_ret_t lt_ed25519_verify_batch(lt_ed25519_verify_t *items, const size_t count)
+{
+    EVP_MD_CTX *md_ctx = NULL;
+    EVP_PKEY *pkey = NULL;
+    const uint8_t *pkey_raw = NULL;
+    lt_ret_t lt_ret = LT_OK;
+    unsigned long err_code;
+
+    if (!items) {
+        return LT_PARAM_ERR;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!items[i].pubkey || !items[i].signature || (!items[i].msg && items[i].msg_len)) {
+            return LT_PARAM_ERR;
+        }
+        items[i].valid = false;
+    }
+    if (!count) {
+        return LT_OK;
+    }
+
+    md_ctx = EVP_MD_CTX_new();
+    if (!md_ctx) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to create EVP_MD_CTX for Ed25519, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        lt_ed25519_verify_t *item = &items[i];
+
+        if (!pkey_raw || memcmp(pkey_raw, item->pubkey, TR01_CURVE_ED25519_PUBKEY_LEN)) {
+            EVP_PKEY_free(pkey);
+            pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, NULL, item->pubkey, TR01_CURVE_ED25519_PUBKEY_LEN);
+            if (!pkey) {
+                err_code = ERR_get_error();
+                LT_LOG_ERROR("Failed to create public key EVP_PKEY structure, err_code=%lu (%s)", err_code,
+                             ERR_error_string(err_code, NULL));
+                lt_ret = LT_CRYPTO_ERR;
+                goto lt_ed25519_verify_batch_cleanup;
+            }
+            pkey_raw = item->pubkey;
+        }
+
+        if (EVP_DigestVerifyInit(md_ctx, NULL, NULL, NULL, pkey) <= 0) {
+            err_code = ERR_get_error();
+            LT_LOG_ERROR("Failed to initialize Ed25519 verification, err_code=%lu (%s)", err_code,
+                         ERR_error_string(err_code, NULL));
+            lt_ret = LT_CRYPTO_ERR;
+            goto lt_ed25519_verify_batch_cleanup;
+        }
+
+        // Signatures which are not valid (including malformed ones) only leave errors in the queue.
+        item->valid = (EVP_DigestVerify(md_ctx, item->signature, TR01_ECDSA_EDDSA_SIGNATURE_LENGTH, item->msg,
+                                        item->msg_len)
+                       == 1);
+        if (!item->valid) {
+            ERR_clear_error();
+            lt_ret = LT_SIGNATURE_INVALID;
+        }
+        if (!EVP_MD_CTX_reset(md_ctx)) {
+            lt_ret = LT_CRYPTO_ERR;
+            goto lt_ed25519_verify_batch_cleanup;
+        }
+    }
+
+lt_ed25519_verify_batch_cleanup:
+    EVP_PKEY_free(pkey);
+    EVP_MD_CTX_free(md_ctx);
+    return lt_ret;
+}
+
@@ -12,6 +12,7 @@
 
 #include "libtropic_common.h"
 #include "libtropic_logging.h"
+#include "libtropic_openssl.h"
 #include "lt_hmac_sha256.h"
 
 lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
@@ -82,3 +83,94 @@ lt_hmac_sha256_cleanup:
     EVP_MD_CTX_free(ctx);
     return ret;
 }
+
+lt_ret_t lt_hmac_sha256_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+    EVP_PKEY *pkey = NULL;
+    unsigned long err_code;
+    lt_ret_t ret = LT_OK;
+
+    pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_HMAC, NULL, key, key_len);
+    if (!pkey) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to create HMAC-SHA256 key object, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    _ctx->hmac_sha256_ctx = EVP_MD_CTX_new();
+    _ctx->hmac_sha256_msg_ctx = EVP_MD_CTX_new();
+    if (!_ctx->hmac_sha256_ctx || !_ctx->hmac_sha256_msg_ctx) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to create HMAC-SHA256 context, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        ret = LT_CRYPTO_ERR;
+        goto lt_hmac_sha256_init_cleanup;
+    }
+
+    // The inner and outer pad are hashed here, every message then starts from a copy of this context.
+    if (!EVP_DigestSignInit(_ctx->hmac_sha256_ctx, NULL, EVP_sha256(), NULL, pkey)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to initialize HMAC-SHA256 context, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        ret = LT_CRYPTO_ERR;
+        goto lt_hmac_sha256_init_cleanup;
+    }
+
+lt_hmac_sha256_init_cleanup:
+    EVP_PKEY_free(pkey);
+    if (ret != LT_OK) {
+        lt_ret_t ret_unused = lt_hmac_sha256_deinit(ctx);
+        LT_UNUSED(ret_unused);
+    }
+    return ret;
+}
+
+lt_ret_t lt_hmac_sha256_compute(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output)
+{
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+    unsigned long err_code;
+
+    if (!EVP_MD_CTX_copy_ex(_ctx->hmac_sha256_msg_ctx, _ctx->hmac_sha256_ctx)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to copy HMAC-SHA256 context, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    if (!EVP_DigestSignUpdate(_ctx->hmac_sha256_msg_ctx, input, input_len)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to update HMAC-SHA256 hash, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    size_t out_len = LT_HMAC_SHA256_HASH_LEN;
+    if (!EVP_DigestSignFinal(_ctx->hmac_sha256_msg_ctx, output, &out_len)) {
+        err_code = ERR_get_error();
+        LT_LOG_ERROR("Failed to finalize HMAC-SHA256 hash, err_code=%lu (%s)", err_code,
+                     ERR_error_string(err_code, NULL));
+        return LT_CRYPTO_ERR;
+    }
+
+    if (out_len != LT_HMAC_SHA256_HASH_LEN) {
+        LT_LOG_ERROR("HMAC-SHA256 output length mismatch! Current: %zu bytes, expected: %d bytes", out_len,
+                     LT_HMAC_SHA256_HASH_LEN);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_deinit(void *ctx)
+{
+    lt_ctx_openssl_t *_ctx = (lt_ctx_openssl_t *)ctx;
+
+    EVP_MD_CTX_free(_ctx->hmac_sha256_msg_ctx);
+    _ctx->hmac_sha256_msg_ctx = NULL;
+    EVP_MD_CTX_free(_ctx->hmac_sha256_ctx);
+    _ctx->hmac_sha256_ctx = NULL;
+
+    return LT_OK;
+}
@@ -0,0 +1,26 @@
+/**
+ * @file lt_openssl_ops.c
+ * @brief OpenSSL CAL built as one of the CALs selected at runtime (LT_CRYPTO_OPS), its functions are renamed to
+ * lt_openssl_* and collected in lt_crypto_ops_openssl.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#define LT_CRYPTO_OPS_BACKEND openssl
+// Streaming AES-GCM of LT_L3_STREAM_ENCRYPT and LT_L3_STREAM_DECRYPT is implemented.
+#define LT_CRYPTO_OPS_AESGCM_STREAM
+#include "lt_crypto_ops_backend.h"
+
+#include "lt_openssl_common.c"
+#include "lt_openssl_aesgcm.c"
+#include "lt_openssl_sha256.c"
+#include "lt_openssl_hmac_sha256.c"
+#include "lt_openssl_x25519.c"
+#ifdef LT_ED25519_VERIFY
+#include "lt_openssl_ed25519.c"
+#endif
+
+#include "libtropic_openssl.h"
+
+LT_CRYPTO_OPS_DEFINE(lt_crypto_ops_openssl, "openssl");
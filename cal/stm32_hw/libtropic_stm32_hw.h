@@ -0,0 +1,68 @@
+#ifndef LT_STM32_HW_H
+#define LT_STM32_HW_H
+
+/**
+ * @file libtropic_stm32_hw.h
+ * @brief STM32 hardware crypto (CRYP and HASH peripherals) public declarations.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ *
+ * @note Requires STM32 with CRYP and HASH peripherals (e.g. STM32F439) and the STM32 HAL with HAL_CRYP_MODULE_ENABLED
+ *       and HAL_HASH_MODULE_ENABLED. X25519 is computed in software by curve25519-donna from vendor/trezor_crypto.
+ */
+
+#include <stdint.h>
+
+#include "stm32f4xx_hal.h"
+
+/** Timeout (ms) of one operation of the CRYP or HASH peripheral. */
+#define LT_STM32_HW_TIMEOUT 100
+
+/**
+ * @brief AES-GCM context structure for STM32 CRYP peripheral.
+ *
+ */
+typedef struct lt_aesgcm_ctx_stm32_hw_t {
+    /** @private @brief CRYP HAL handle. */
+    CRYP_HandleTypeDef hcryp;
+    /** @private @brief AES-256 key as big-endian words, as expected by the CRYP peripheral. */
+    uint32_t key[8];
+    /** @private @brief IV as big-endian words, last word is the initial counter. */
+    uint32_t iv[4];
+    /** @private @brief Flag indicating if key is set. */
+    uint8_t key_set;
+} lt_aesgcm_ctx_stm32_hw_t;
+
+/**
+ * @brief Context structure for STM32 hardware crypto.
+ *
+ */
+typedef struct lt_ctx_stm32_hw_t {
+    /** @private @brief AES-GCM context for encryption. */
+    lt_aesgcm_ctx_stm32_hw_t aesgcm_encrypt_ctx;
+    /** @private @brief AES-GCM context for decryption. */
+    lt_aesgcm_ctx_stm32_hw_t aesgcm_decrypt_ctx;
+    /** @private @brief HASH HAL handle used for SHA-256. */
+    HASH_HandleTypeDef sha256_ctx;
+    /**
+     * @private @brief Input bytes not yet fed to the HASH peripheral. HAL accumulates only multiples of 4 bytes, the
+     * last 1-4 bytes of the message are kept here and fed on finish.
+     */
+    uint8_t sha256_pending[4];
+    /** @private @brief Number of bytes in sha256_pending. */
+    uint8_t sha256_pending_len;
+    /** @private @brief HASH HAL handle used for HMAC-SHA256, initialized with the key by lt_hmac_sha256_init(). */
+    HASH_HandleTypeDef hmac_sha256_ctx;
+    /** @private @brief Flag indicating if HMAC-SHA256 key is set. */
+    uint8_t hmac_sha256_key_set;
+} lt_ctx_stm32_hw_t;
+
+#ifdef LT_CRYPTO_OPS
+#include "libtropic_common.h"
+
+/** @brief Functions of the STM32 CAL for `lt_crypto_ops_set()` and `lt_crypto_ops_probe()`. */
+extern const lt_crypto_ops_t lt_crypto_ops_stm32_hw;
+#endif
+
+#endif  // LT_STM32_HW_H
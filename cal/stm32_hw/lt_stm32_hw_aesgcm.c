@@ -0,0 +1,254 @@
+/**
+ * @file lt_stm32_hw_aesgcm.c
+ * @brief AES-GCM on the STM32 CRYP peripheral.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ *
+ * @note CRYP HAL accesses data as 32-bit words, the last incomplete word of the input is read and the last
+ *       incomplete word of the output is written whole (up to 3 bytes past the data). Unaligned word access is
+ *       supported by Cortex-M3/M4/M7 and L3 buffers always have the tag placed right behind the data, so the extra
+ *       bytes stay within the buffers. The received tag is copied aside before decryption for this reason.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_stm32_hw.h"
+#include "lt_aesgcm.h"
+#include "lt_secure_memzero.h"
+
+/**
+ * @brief Loads big-endian 32-bit word.
+ *
+ * @param p  Pointer to 4 bytes
+ * @return   Loaded word
+ */
+static uint32_t lt_stm32_hw_load_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/**
+ * @brief Initializes STM32 CRYP AES-GCM context.
+ *
+ * @param ctx      AES-GCM context structure (STM32 hardware specific)
+ * @param key      Key to initialize with
+ * @param key_len  Length of the key
+ * @return         LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_aesgcm_init(lt_aesgcm_ctx_stm32_hw_t *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    if (ctx->key_set) {
+        LT_LOG_ERROR("AES-GCM context already initialized!");
+        return LT_CRYPTO_ERR;
+    }
+
+    if (key_len != TR01_AES256_KEY_LEN) {
+        LT_LOG_ERROR("AES-GCM key length %" PRIu32 " not supported!", key_len);
+        return LT_PARAM_ERR;
+    }
+
+    for (uint32_t i = 0; i < 8; i++) {
+        ctx->key[i] = lt_stm32_hw_load_be32(key + 4 * i);
+    }
+
+    memset(&ctx->hcryp, 0, sizeof(ctx->hcryp));
+    ctx->hcryp.Instance = CRYP;
+    ctx->hcryp.Init.DataType = CRYP_DATATYPE_8B;
+    ctx->hcryp.Init.KeySize = CRYP_KEYSIZE_256B;
+    ctx->hcryp.Init.pKey = ctx->key;
+    ctx->hcryp.Init.pInitVect = ctx->iv;
+    ctx->hcryp.Init.Algorithm = CRYP_AES_GCM;
+    ctx->hcryp.Init.DataWidthUnit = CRYP_DATAWIDTHUNIT_BYTE;
+
+    if (HAL_CRYP_Init(&ctx->hcryp) != HAL_OK) {
+        LT_LOG_ERROR("Couldn't initialize CRYP peripheral!");
+        lt_secure_memzero(ctx->key, sizeof(ctx->key));
+        return LT_CRYPTO_ERR;
+    }
+
+    ctx->key_set = 1;
+    return LT_OK;
+}
+
+/**
+ * @brief Deinitializes STM32 CRYP AES-GCM context.
+ *
+ * @param ctx  AES-GCM context structure (STM32 hardware specific)
+ * @return     LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_aesgcm_deinit(lt_aesgcm_ctx_stm32_hw_t *ctx)
+{
+    if (ctx->key_set) {
+        lt_secure_memzero(ctx->key, sizeof(ctx->key));
+        ctx->key_set = 0;
+        if (HAL_CRYP_DeInit(&ctx->hcryp) != HAL_OK) {
+            LT_LOG_ERROR("Couldn't deinitialize CRYP peripheral!");
+            return LT_CRYPTO_ERR;
+        }
+    }
+    return LT_OK;
+}
+
+/**
+ * @brief Programs IV and AAD of one message into the CRYP peripheral.
+ *
+ * @param ctx      AES-GCM context structure (STM32 hardware specific)
+ * @param iv       Initialization vector, TR01_L3_IV_SIZE bytes
+ * @param iv_len   Length of the IV
+ * @param add      Additional authenticated data
+ * @param add_len  Length of add, has to be a multiple of 4
+ * @return         LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_aesgcm_setup(lt_aesgcm_ctx_stm32_hw_t *ctx, const uint8_t *iv, const uint32_t iv_len,
+                                const uint8_t *add, const uint32_t add_len)
+{
+    // The peripheral supports only 96-bit IVs, the counter of the first payload block is 2.
+    if ((iv_len != TR01_L3_IV_SIZE) || (add_len % 4 != 0)) {
+        LT_LOG_ERROR("AES-GCM IV length %" PRIu32 " or AAD length %" PRIu32 " not supported!", iv_len, add_len);
+        return LT_PARAM_ERR;
+    }
+
+    ctx->iv[0] = lt_stm32_hw_load_be32(iv);
+    ctx->iv[1] = lt_stm32_hw_load_be32(iv + 4);
+    ctx->iv[2] = lt_stm32_hw_load_be32(iv + 8);
+    ctx->iv[3] = 2;
+
+    CRYP_ConfigTypeDef conf = ctx->hcryp.Init;
+    conf.Header = (uint32_t *)add;
+    conf.HeaderSize = add_len / 4;
+#ifdef CRYP_HEADERWIDTHUNIT_WORD
+    conf.HeaderWidthUnit = CRYP_HEADERWIDTHUNIT_WORD;
+#endif
+
+    if (HAL_CRYP_SetConfig(&ctx->hcryp, &conf) != HAL_OK) {
+        LT_LOG_ERROR("Couldn't configure CRYP peripheral!");
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+
+    return lt_aesgcm_init(&_ctx->aesgcm_encrypt_ctx, key, key_len);
+}
+
+lt_ret_t lt_aesgcm_decrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+
+    return lt_aesgcm_init(&_ctx->aesgcm_decrypt_ctx, key, key_len);
+}
+
+lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                           const uint32_t add_len, const uint8_t *plaintext, const uint32_t plaintext_len,
+                           uint8_t *ciphertext, const uint32_t ciphertext_len)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+    lt_aesgcm_ctx_stm32_hw_t *gcm = &_ctx->aesgcm_encrypt_ctx;
+    uint32_t tag[TR01_L3_TAG_SIZE / 4];
+
+    if ((ciphertext_len < plaintext_len + TR01_L3_TAG_SIZE) || (plaintext_len > UINT16_MAX)) {
+        LT_LOG_ERROR("AES-GCM output (ciphertext) buffer too small! Current: %" PRIu32 " bytes, required: %" PRIu32
+                     " bytes",
+                     ciphertext_len, plaintext_len + TR01_L3_TAG_SIZE);
+        return LT_PARAM_ERR;
+    }
+
+    if (!gcm->key_set) {
+        LT_LOG_ERROR("AES-GCM context key not set!");
+        return LT_CRYPTO_ERR;
+    }
+
+    lt_ret_t ret = lt_aesgcm_setup(gcm, iv, iv_len, add, add_len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (HAL_CRYP_Encrypt(&gcm->hcryp, (uint32_t *)plaintext, (uint16_t)plaintext_len, (uint32_t *)ciphertext,
+                         LT_STM32_HW_TIMEOUT)
+            != HAL_OK
+        || HAL_CRYPEx_AESGCM_GenerateAuthTAG(&gcm->hcryp, tag, LT_STM32_HW_TIMEOUT) != HAL_OK) {
+        LT_LOG_ERROR("AES-GCM encryption failed, CRYP error=0x%" PRIx32, gcm->hcryp.ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+
+    memcpy(ciphertext + plaintext_len, tag, sizeof(tag));
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                           const uint32_t add_len, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                           uint8_t *plaintext, const uint32_t plaintext_len)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+    lt_aesgcm_ctx_stm32_hw_t *gcm = &_ctx->aesgcm_decrypt_ctx;
+    uint32_t tag[TR01_L3_TAG_SIZE / 4];
+    uint8_t expected_tag[TR01_L3_TAG_SIZE];
+    uint32_t dummy_plaintext;
+
+    if ((ciphertext_len < TR01_L3_TAG_SIZE) || (plaintext_len < ciphertext_len - TR01_L3_TAG_SIZE)
+        || (ciphertext_len - TR01_L3_TAG_SIZE > UINT16_MAX)) {
+        LT_LOG_ERROR("AES-GCM output (plaintext) buffer too small! Current: %" PRIu32 " bytes, required: %" PRIu32
+                     " bytes",
+                     plaintext_len, ciphertext_len - TR01_L3_TAG_SIZE);
+        return LT_PARAM_ERR;
+    }
+
+    if (!gcm->key_set) {
+        LT_LOG_ERROR("AES-GCM context key not set!");
+        return LT_CRYPTO_ERR;
+    }
+
+    lt_ret_t ret = lt_aesgcm_setup(gcm, iv, iv_len, add, add_len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    const uint32_t data_len = ciphertext_len - TR01_L3_TAG_SIZE;
+    // Decryption may overwrite the first bytes of the tag, when done in place.
+    memcpy(expected_tag, ciphertext + data_len, sizeof(expected_tag));
+
+    uint32_t *out = data_len ? (uint32_t *)plaintext : &dummy_plaintext;
+    if (HAL_CRYP_Decrypt(&gcm->hcryp, (uint32_t *)ciphertext, (uint16_t)data_len, out, LT_STM32_HW_TIMEOUT) != HAL_OK
+        || HAL_CRYPEx_AESGCM_GenerateAuthTAG(&gcm->hcryp, tag, LT_STM32_HW_TIMEOUT) != HAL_OK) {
+        LT_LOG_ERROR("AES-GCM decryption failed, CRYP error=0x%" PRIx32, gcm->hcryp.ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+
+    // Constant time comparison of the tags.
+    const uint8_t *computed_tag = (const uint8_t *)tag;
+    uint8_t diff = 0;
+    for (uint32_t i = 0; i < TR01_L3_TAG_SIZE; i++) {
+        diff |= computed_tag[i] ^ expected_tag[i];
+    }
+
+    if (diff != 0) {
+        LT_LOG_ERROR("AES-GCM tag mismatch!");
+        lt_secure_memzero(plaintext, data_len);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_deinit(void *ctx)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+
+    return lt_aesgcm_deinit(&_ctx->aesgcm_encrypt_ctx);
+}
+
+lt_ret_t lt_aesgcm_decrypt_deinit(void *ctx)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+
+    return lt_aesgcm_deinit(&_ctx->aesgcm_decrypt_ctx);
+}
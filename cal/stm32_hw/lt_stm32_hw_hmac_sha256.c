@@ -0,0 +1,96 @@
+/**
+ * @file lt_stm32_hw_hmac_sha256.c
+ * @brief HMAC-SHA256 on the STM32 HASH peripheral.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_stm32_hw.h"
+#include "lt_hmac_sha256.h"
+
+lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
+                        uint8_t *output)
+{
+    HASH_HandleTypeDef hhash;
+    lt_ret_t ret = LT_OK;
+
+    memset(&hhash, 0, sizeof(hhash));
+    hhash.Init.DataType = HASH_DATATYPE_8B;
+    hhash.Init.KeySize = key_len;
+    hhash.Init.pKey = (uint8_t *)key;
+
+    if (HAL_HASH_Init(&hhash) != HAL_OK) {
+        LT_LOG_ERROR("Couldn't initialize HASH peripheral, HASH error=0x%" PRIx32, hhash.ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+
+    if (HAL_HMACEx_SHA256_Start(&hhash, (uint8_t *)input, input_len, output, LT_STM32_HW_TIMEOUT) != HAL_OK) {
+        LT_LOG_ERROR("HMAC-SHA256 computation failed, HASH error=0x%" PRIx32, hhash.ErrorCode);
+        ret = LT_CRYPTO_ERR;
+    }
+
+    if (HAL_HASH_DeInit(&hhash) != HAL_OK && ret == LT_OK) {
+        LT_LOG_ERROR("Couldn't deinitialize HASH peripheral, HASH error=0x%" PRIx32, hhash.ErrorCode);
+        ret = LT_CRYPTO_ERR;
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_hmac_sha256_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+    HASH_HandleTypeDef *hhash = &_ctx->hmac_sha256_ctx;
+
+    // The peripheral is initialized once, it only references the key, which is fed to it with every message.
+    memset(hhash, 0, sizeof(*hhash));
+    hhash->Init.DataType = HASH_DATATYPE_8B;
+    hhash->Init.KeySize = key_len;
+    hhash->Init.pKey = (uint8_t *)key;
+
+    if (HAL_HASH_Init(hhash) != HAL_OK) {
+        LT_LOG_ERROR("Couldn't initialize HASH peripheral, HASH error=0x%" PRIx32, hhash->ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+    _ctx->hmac_sha256_key_set = 1;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_compute(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+    HASH_HandleTypeDef *hhash = &_ctx->hmac_sha256_ctx;
+
+    if (HAL_HMACEx_SHA256_Start(hhash, (uint8_t *)input, input_len, output, LT_STM32_HW_TIMEOUT) != HAL_OK) {
+        LT_LOG_ERROR("HMAC-SHA256 computation failed, HASH error=0x%" PRIx32, hhash->ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_deinit(void *ctx)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+    HASH_HandleTypeDef *hhash = &_ctx->hmac_sha256_ctx;
+
+    if (!_ctx->hmac_sha256_key_set) {
+        return LT_OK;
+    }
+    _ctx->hmac_sha256_key_set = 0;
+
+    if (HAL_HASH_DeInit(hhash) != HAL_OK) {
+        LT_LOG_ERROR("Couldn't deinitialize HASH peripheral, HASH error=0x%" PRIx32, hhash->ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file lt_stm32_hw_sha256.c
+ * @brief SHA-256 on the STM32 HASH peripheral.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_stm32_hw.h"
+#include "lt_sha256.h"
+
+lt_ret_t lt_sha256_init(void *ctx)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+
+    memset(&_ctx->sha256_ctx, 0, sizeof(_ctx->sha256_ctx));
+    _ctx->sha256_pending_len = 0;
+    return LT_OK;
+}
+
+lt_ret_t lt_sha256_start(void *ctx)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+
+    _ctx->sha256_ctx.Init.DataType = HASH_DATATYPE_8B;
+    _ctx->sha256_pending_len = 0;
+
+    // Resets the HAL state, so the next accumulation starts a new digest.
+    if (HAL_HASH_Init(&_ctx->sha256_ctx) != HAL_OK) {
+        LT_LOG_ERROR("SHA-256 setup failed, HASH error=0x%" PRIx32, _ctx->sha256_ctx.ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sha256_update(void *ctx, const uint8_t *input, const size_t input_len)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+    size_t left = input_len;
+
+    // HAL accumulates only multiples of 4 bytes and the last (possibly incomplete) word has to be passed to
+    // HAL_HASHEx_SHA256_Accmlt_End(), so 1-4 bytes are always held back until more data comes.
+    while (left) {
+        if (_ctx->sha256_pending_len == sizeof(_ctx->sha256_pending)) {
+            if (HAL_HASHEx_SHA256_Accmlt(&_ctx->sha256_ctx, _ctx->sha256_pending, sizeof(_ctx->sha256_pending))
+                != HAL_OK) {
+                LT_LOG_ERROR("SHA-256 update failed, HASH error=0x%" PRIx32, _ctx->sha256_ctx.ErrorCode);
+                return LT_CRYPTO_ERR;
+            }
+            _ctx->sha256_pending_len = 0;
+        }
+
+        if ((_ctx->sha256_pending_len == 0) && (left > sizeof(_ctx->sha256_pending))) {
+            uint32_t words_len = (uint32_t)((left - 1) & ~(size_t)3);
+            if (HAL_HASHEx_SHA256_Accmlt(&_ctx->sha256_ctx, (uint8_t *)input, words_len) != HAL_OK) {
+                LT_LOG_ERROR("SHA-256 update failed, HASH error=0x%" PRIx32, _ctx->sha256_ctx.ErrorCode);
+                return LT_CRYPTO_ERR;
+            }
+            input += words_len;
+            left -= words_len;
+            continue;
+        }
+
+        _ctx->sha256_pending[_ctx->sha256_pending_len++] = *input++;
+        left--;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sha256_finish(void *ctx, uint8_t *output)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+
+    if (HAL_HASHEx_SHA256_Accmlt_End(&_ctx->sha256_ctx, _ctx->sha256_pending, _ctx->sha256_pending_len, output,
+                                     LT_STM32_HW_TIMEOUT)
+        != HAL_OK) {
+        LT_LOG_ERROR("SHA-256 finish failed, HASH error=0x%" PRIx32, _ctx->sha256_ctx.ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+    _ctx->sha256_pending_len = 0;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sha256_deinit(void *ctx)
+{
+    lt_ctx_stm32_hw_t *_ctx = (lt_ctx_stm32_hw_t *)ctx;
+
+    if (HAL_HASH_DeInit(&_ctx->sha256_ctx) != HAL_OK) {
+        LT_LOG_ERROR("SHA-256 deinit failed, HASH error=0x%" PRIx32, _ctx->sha256_ctx.ErrorCode);
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file lt_stm32_hw_x25519.c
+ * @brief X25519 for the STM32 hardware CAL.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ *
+ * @note STM32 PKA supports only Weierstrass curves, so X25519 is computed in software by curve25519-donna from
+ *       vendor/trezor_crypto (link the trezor_crypto target).
+ */
+
+#include <stdint.h>
+
+#include "ed25519-donna/ed25519.h"
+#include "libtropic_common.h"
+#include "lt_x25519.h"
+
+lt_ret_t lt_X25519(const uint8_t *priv, const uint8_t *pub, uint8_t *secret)
+{
+    curve25519_scalarmult(secret, priv, pub);
+    return LT_OK;
+}
+
+lt_ret_t lt_X25519_scalarmult(const uint8_t *sk, uint8_t *pk)
+{
+    curve25519_scalarmult_basepoint(pk, sk);
+    return LT_OK;
+}
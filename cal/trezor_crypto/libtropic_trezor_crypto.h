@@ -9,8 +9,29 @@
  * @license For the license see LICENSE.md in the root directory of this source tree.
  */
 
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+#include <stdbool.h>
+#include <stdint.h>
+#endif
+
 #include "aes/aesgcm.h"
 #include "hasher.h"
+#include "hmac.h"
+
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+/**
+ * @brief AES-GCM context of the kernels using AES and carry-less multiply instructions of the CPU.
+ *
+ */
+typedef struct lt_aesgcm_hw_ctx_t {
+    /** @private @brief Expanded AES-256 key. */
+    uint8_t rk[15 * 16] __attribute__((aligned(16)));
+    /** @private @brief GHASH key in representation of the kernels. */
+    uint8_t h[16] __attribute__((aligned(16)));
+    /** @private @brief True if the context was initialized with a key, instead of the Trezor crypto context. */
+    bool enabled;
+} lt_aesgcm_hw_ctx_t;
+#endif
 
 /**
  * @brief Context structure for Trezor crypto.
@@ -23,6 +44,21 @@ typedef struct lt_ctx_trezor_crypto_t {
     gcm_ctx aesgcm_decrypt_ctx;
     /** @private @brief SHA-256 context. */
     Hasher sha256_ctx;
+    /** @private @brief HMAC-SHA256 context keyed by lt_hmac_sha256_init(), copied for every message. */
+    HMAC_SHA256_CTX hmac_sha256_ctx;
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+    /** @private @brief Accelerated AES-GCM context for encryption. */
+    lt_aesgcm_hw_ctx_t aesgcm_encrypt_hw_ctx;
+    /** @private @brief Accelerated AES-GCM context for decryption. */
+    lt_aesgcm_hw_ctx_t aesgcm_decrypt_hw_ctx;
+#endif
 } lt_ctx_trezor_crypto_t;
 
+#ifdef LT_CRYPTO_OPS
+#include "libtropic_common.h"
+
+/** @brief Functions of the Trezor crypto CAL for `lt_crypto_ops_set()` and `lt_crypto_ops_probe()`. */
+extern const lt_crypto_ops_t lt_crypto_ops_trezor_crypto;
+#endif
+
 #endif  // LT_TREZOR_CRYPTO_H
\ No newline at end of file
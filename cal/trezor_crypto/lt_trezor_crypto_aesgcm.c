@@ -10,17 +10,42 @@
 #include "libtropic_common.h"
 #include "libtropic_trezor_crypto.h"
 #include "lt_aesgcm.h"
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+#include "lt_secure_memzero.h"
+#include "lt_trezor_crypto_aesgcm_hw.h"
+#endif
+
+#if defined(LT_L3_STREAM_ENCRYPT) || defined(LT_L3_STREAM_DECRYPT)
+// Streaming AES-GCM is computed by Trezor's implementation only, so its context is keyed even if the accelerated
+// one is used for whole L3 packets.
+#define LT_TREZOR_CRYPTO_AESGCM_STREAM
+#endif
 
 /**
  * @brief Initializes Trezor crypto AES-GCM context.
+ * @details With LT_TREZOR_CRYPTO_AESGCM_HW, the accelerated context is initialized instead, if the CPU supports it.
  *
  * @param ctx      AES-GCM context structure (Trezor crypto specific)
+ * @param hw_ctx   Accelerated AES-GCM context (only with LT_TREZOR_CRYPTO_AESGCM_HW)
  * @param key      Key to initialize with
  * @param key_len  Length of the key
  * @return         LT_OK if success, otherwise returns other error code.
  */
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+static lt_ret_t lt_aesgcm_init(gcm_ctx *ctx, lt_aesgcm_hw_ctx_t *hw_ctx, const uint8_t *key, const uint32_t key_len)
+{
+    hw_ctx->enabled = false;
+    if ((key_len == TR01_AES256_KEY_LEN) && lt_aesgcm_hw_supported()) {
+        lt_aesgcm_hw_init(hw_ctx, key);
+        hw_ctx->enabled = true;
+#ifndef LT_TREZOR_CRYPTO_AESGCM_STREAM
+        return LT_OK;
+#endif
+    }
+#else
 static lt_ret_t lt_aesgcm_init(gcm_ctx *ctx, const uint8_t *key, const uint32_t key_len)
 {
+#endif
     int ret = gcm_init_and_key(key, key_len, ctx);
     if (ret != RETURN_GOOD) {
         return LT_CRYPTO_ERR;
@@ -31,11 +56,23 @@ static lt_ret_t lt_aesgcm_init(gcm_ctx *ctx, const uint8_t *key, const uint32_t
 /**
  * @brief Deinitializes Trezor crypto AES-GCM context.
  *
- * @param ctx  AES-GCM context structure (Trezor crypto specific)
- * @return     LT_OK if success, otherwise returns other error code.
+ * @param ctx     AES-GCM context structure (Trezor crypto specific)
+ * @param hw_ctx  Accelerated AES-GCM context (only with LT_TREZOR_CRYPTO_AESGCM_HW)
+ * @return        LT_OK if success, otherwise returns other error code.
  */
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+static lt_ret_t lt_aesgcm_deinit(gcm_ctx *ctx, lt_aesgcm_hw_ctx_t *hw_ctx)
+{
+    if (hw_ctx->enabled) {
+        lt_secure_memzero(hw_ctx, sizeof(lt_aesgcm_hw_ctx_t));
+#ifndef LT_TREZOR_CRYPTO_AESGCM_STREAM
+        return LT_OK;
+#endif
+    }
+#else
 static lt_ret_t lt_aesgcm_deinit(gcm_ctx *ctx)
 {
+#endif
     int ret = gcm_end(ctx);
     if (ret != RETURN_GOOD) {
         return LT_CRYPTO_ERR;
@@ -47,14 +84,22 @@ lt_ret_t lt_aesgcm_encrypt_init(void *ctx, const uint8_t *key, const uint32_t ke
 {
     lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
 
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+    return lt_aesgcm_init(&_ctx->aesgcm_encrypt_ctx, &_ctx->aesgcm_encrypt_hw_ctx, key, key_len);
+#else
     return lt_aesgcm_init(&_ctx->aesgcm_encrypt_ctx, key, key_len);
+#endif
 }
 
 lt_ret_t lt_aesgcm_decrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
 {
     lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
 
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+    return lt_aesgcm_init(&_ctx->aesgcm_decrypt_ctx, &_ctx->aesgcm_decrypt_hw_ctx, key, key_len);
+#else
     return lt_aesgcm_init(&_ctx->aesgcm_decrypt_ctx, key, key_len);
+#endif
 }
 
 lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
@@ -67,8 +112,21 @@ lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
         return LT_PARAM_ERR;
     }
 
-    // Copy plaintext into ciphertext, as Trezor's gcm_encrypt_message() works in-place
-    memcpy(ciphertext, plaintext, plaintext_len);
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+    if (_ctx->aesgcm_encrypt_hw_ctx.enabled) {
+        if (iv_len != TR01_L3_IV_SIZE) {
+            return LT_PARAM_ERR;
+        }
+        lt_aesgcm_hw_encrypt(&_ctx->aesgcm_encrypt_hw_ctx, iv, add, add_len, plaintext, ciphertext, plaintext_len,
+                             ciphertext + plaintext_len);
+        return LT_OK;
+    }
+#endif
+
+    // Trezor's gcm_encrypt_message() works in-place, L3 packets are encrypted in one buffer and need no copy.
+    if (ciphertext != plaintext) {
+        memmove(ciphertext, plaintext, plaintext_len);
+    }
 
     int ret = gcm_encrypt_message(iv, iv_len, add, add_len, ciphertext, plaintext_len, ciphertext + plaintext_len,
                                   TR01_L3_TAG_SIZE, &_ctx->aesgcm_encrypt_ctx);
@@ -79,6 +137,48 @@ lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
     return LT_OK;
 }
 
+#ifdef LT_L3_STREAM_ENCRYPT
+lt_ret_t lt_aesgcm_encrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+
+    if ((gcm_init_message(iv, iv_len, &_ctx->aesgcm_encrypt_ctx) != RETURN_GOOD)
+        || (gcm_auth_header(add, add_len, &_ctx->aesgcm_encrypt_ctx) != RETURN_GOOD)) {
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_update(void *ctx, const uint8_t *plaintext, const uint32_t plaintext_len,
+                                  uint8_t *ciphertext)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+
+    // Keystream is XORed into the output buffer, so distinct plaintext is placed there first.
+    if (ciphertext != plaintext) {
+        memmove(ciphertext, plaintext, plaintext_len);
+    }
+    if (gcm_encrypt(ciphertext, plaintext_len, &_ctx->aesgcm_encrypt_ctx) != RETURN_GOOD) {
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_encrypt_finish(void *ctx, uint8_t *tag, const uint32_t tag_len)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+
+    if (gcm_compute_tag(tag, tag_len, &_ctx->aesgcm_encrypt_ctx) != RETURN_GOOD) {
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+#endif
+
 lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
                            const uint32_t add_len, const uint8_t *ciphertext, const uint32_t ciphertext_len,
                            uint8_t *plaintext, const uint32_t plaintext_len)
@@ -89,8 +189,23 @@ lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
         return LT_PARAM_ERR;
     }
 
-    // Copy ciphertext into plaintext, as Trezor's gcm_decrypt_message() works in-place
-    memcpy(plaintext, ciphertext, plaintext_len);
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+    if (_ctx->aesgcm_decrypt_hw_ctx.enabled) {
+        if (iv_len != TR01_L3_IV_SIZE) {
+            return LT_PARAM_ERR;
+        }
+        if (!lt_aesgcm_hw_decrypt(&_ctx->aesgcm_decrypt_hw_ctx, iv, add, add_len, ciphertext, plaintext,
+                                  plaintext_len, ciphertext + plaintext_len)) {
+            return LT_CRYPTO_ERR;
+        }
+        return LT_OK;
+    }
+#endif
+
+    // Trezor's gcm_decrypt_message() works in-place, L3 packets are decrypted in one buffer and need no copy.
+    if (plaintext != ciphertext) {
+        memmove(plaintext, ciphertext, plaintext_len);
+    }
 
     int ret = gcm_decrypt_message(iv, iv_len, add, add_len, plaintext, plaintext_len, ciphertext + plaintext_len,
                                   TR01_L3_TAG_SIZE, &_ctx->aesgcm_decrypt_ctx);
@@ -101,16 +216,79 @@ lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
     return LT_OK;
 }
 
+#ifdef LT_L3_STREAM_DECRYPT
+lt_ret_t lt_aesgcm_decrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+
+    if ((gcm_init_message(iv, iv_len, &_ctx->aesgcm_decrypt_ctx) != RETURN_GOOD)
+        || (gcm_auth_header(add, add_len, &_ctx->aesgcm_decrypt_ctx) != RETURN_GOOD)) {
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_decrypt_update(void *ctx, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                                  uint8_t *plaintext)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+
+    // Ciphertext is authenticated where it is, then decrypted in the output buffer.
+    if (gcm_auth_data(ciphertext, ciphertext_len, &_ctx->aesgcm_decrypt_ctx) != RETURN_GOOD) {
+        return LT_CRYPTO_ERR;
+    }
+    if (plaintext != ciphertext) {
+        memmove(plaintext, ciphertext, ciphertext_len);
+    }
+    if (gcm_crypt_data(plaintext, ciphertext_len, &_ctx->aesgcm_decrypt_ctx) != RETURN_GOOD) {
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_aesgcm_decrypt_finish(void *ctx, const uint8_t *tag, const uint32_t tag_len)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+    uint8_t computed[TR01_L3_TAG_SIZE];
+    uint8_t diff = 0;
+
+    if (tag_len > sizeof(computed)) {
+        return LT_PARAM_ERR;
+    }
+    if (gcm_compute_tag(computed, tag_len, &_ctx->aesgcm_decrypt_ctx) != RETURN_GOOD) {
+        return LT_CRYPTO_ERR;
+    }
+
+    // Tags are compared in constant time.
+    for (uint32_t i = 0; i < tag_len; i++) {
+        diff |= computed[i] ^ tag[i];
+    }
+
+    return diff ? LT_CRYPTO_ERR : LT_OK;
+}
+#endif
+
 lt_ret_t lt_aesgcm_encrypt_deinit(void *ctx)
 {
     lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
 
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+    return lt_aesgcm_deinit(&_ctx->aesgcm_encrypt_ctx, &_ctx->aesgcm_encrypt_hw_ctx);
+#else
     return lt_aesgcm_deinit(&_ctx->aesgcm_encrypt_ctx);
+#endif
 }
 
 lt_ret_t lt_aesgcm_decrypt_deinit(void *ctx)
 {
     lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
 
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+    return lt_aesgcm_deinit(&_ctx->aesgcm_decrypt_ctx, &_ctx->aesgcm_decrypt_hw_ctx);
+#else
     return lt_aesgcm_deinit(&_ctx->aesgcm_decrypt_ctx);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,509 @@
+/**
+ * @file lt_trezor_crypto_aesgcm_hw.c
+ * @brief AES-256-GCM using AES and carry-less multiply instructions of the CPU.
+ * @details Kernels are compiled with function target attributes, so the rest of the build does not need any special
+ * compiler flags. They are used only when lt_aesgcm_hw_supported() confirms the instructions at runtime.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "lt_trezor_crypto_aesgcm_hw.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_secure_memzero.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LT_AESGCM_HW_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define LT_AESGCM_HW_ARM
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+#if defined(LT_AESGCM_HW_X86) || defined(LT_AESGCM_HW_ARM)
+
+/** Size of AES block. */
+#define LT_AES_BLOCK_SIZE 16
+
+// Per architecture kernels, all of them keep the GHASH state y in their own representation:
+//   lt_hw_cpu_check()  - runtime detection of the instructions
+//   lt_hw_init()       - key expansion and GHASH key
+//   lt_hw_ghash()      - y = (y ^ block) * H for all blocks of data, last partial block is zero padded
+//   lt_hw_ctr()        - CTR mode, j is the first counter block
+//   lt_hw_tag()        - tag = y ^ AES(j0)
+
+#ifdef LT_AESGCM_HW_X86
+#define LT_HW_TARGET __attribute__((target("aes,pclmul,ssse3")))
+
+static bool lt_hw_cpu_check(void)
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+}
+
+/** Reverses bytes of the block, GHASH is computed on byte reversed blocks. */
+static inline LT_HW_TARGET __m128i lt_hw_bswap(const __m128i x)
+{
+    return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+/** Multiplication in GF(2^128) of byte reversed operands ("Intel Carry-Less Multiplication Instruction and its
+ * Usage for Computing the GCM Mode", algorithm 1 with shift and reduction of 5). */
+static inline LT_HW_TARGET __m128i lt_hw_gfmul(const __m128i a, const __m128i b)
+{
+    __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+    __m128i t1, t2, t3;
+
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // Shift the 256-bit product left by one bit, operands are bit reflected.
+    t1 = _mm_srli_epi32(lo, 31);
+    t2 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t3 = _mm_srli_si128(t1, 12);
+    t2 = _mm_slli_si128(t2, 4);
+    t1 = _mm_slli_si128(t1, 4);
+    lo = _mm_or_si128(lo, t1);
+    hi = _mm_or_si128(hi, t2);
+    hi = _mm_or_si128(hi, t3);
+
+    // Reduction modulo x^128 + x^7 + x^2 + x + 1.
+    t1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+    t2 = _mm_srli_si128(t1, 4);
+    t1 = _mm_slli_si128(t1, 12);
+    lo = _mm_xor_si128(lo, t1);
+    t3 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    t3 = _mm_xor_si128(t3, t2);
+    lo = _mm_xor_si128(lo, t3);
+
+    return _mm_xor_si128(hi, lo);
+}
+
+static inline LT_HW_TARGET __m128i lt_hw_aes(const __m128i *rk, __m128i b)
+{
+    b = _mm_xor_si128(b, rk[0]);
+    for (int i = 1; i < 14; i++) {
+        b = _mm_aesenc_si128(b, rk[i]);
+    }
+    return _mm_aesenclast_si128(b, rk[14]);
+}
+
+/** Encrypts four blocks at once, so the AES pipeline is kept busy. */
+static inline LT_HW_TARGET void lt_hw_aes4(const __m128i *rk, __m128i *b)
+{
+    for (int j = 0; j < 4; j++) {
+        b[j] = _mm_xor_si128(b[j], rk[0]);
+    }
+    for (int i = 1; i < 14; i++) {
+        for (int j = 0; j < 4; j++) {
+            b[j] = _mm_aesenc_si128(b[j], rk[i]);
+        }
+    }
+    for (int j = 0; j < 4; j++) {
+        b[j] = _mm_aesenclast_si128(b[j], rk[14]);
+    }
+}
+
+/** AES-256 key expansion step computing even round key. */
+static inline LT_HW_TARGET __m128i lt_hw_key_even(__m128i prev, __m128i assist)
+{
+    assist = _mm_shuffle_epi32(assist, 0xff);
+    prev = _mm_xor_si128(prev, _mm_slli_si128(prev, 4));
+    prev = _mm_xor_si128(prev, _mm_slli_si128(prev, 8));
+    return _mm_xor_si128(prev, assist);
+}
+
+/** AES-256 key expansion step computing odd round key. */
+static inline LT_HW_TARGET __m128i lt_hw_key_odd(__m128i prev, const __m128i even)
+{
+    __m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(even, 0x00), 0xaa);
+    prev = _mm_xor_si128(prev, _mm_slli_si128(prev, 4));
+    prev = _mm_xor_si128(prev, _mm_slli_si128(prev, 8));
+    return _mm_xor_si128(prev, assist);
+}
+
+static LT_HW_TARGET void lt_hw_init(lt_aesgcm_hw_ctx_t *ctx, const uint8_t *key)
+{
+    __m128i *rk = (__m128i *)ctx->rk;
+
+    rk[0] = _mm_loadu_si128((const __m128i *)key);
+    rk[1] = _mm_loadu_si128((const __m128i *)(key + 16));
+    // Round constant has to be an immediate.
+#define LT_HW_KEY_ROUND(i, rcon)                                                    \
+    rk[i] = lt_hw_key_even(rk[i - 2], _mm_aeskeygenassist_si128(rk[i - 1], rcon)); \
+    if (i < 14) {                                                                   \
+        rk[i + 1] = lt_hw_key_odd(rk[i - 1], rk[i]);                                \
+    }
+    LT_HW_KEY_ROUND(2, 0x01)
+    LT_HW_KEY_ROUND(4, 0x02)
+    LT_HW_KEY_ROUND(6, 0x04)
+    LT_HW_KEY_ROUND(8, 0x08)
+    LT_HW_KEY_ROUND(10, 0x10)
+    LT_HW_KEY_ROUND(12, 0x20)
+    LT_HW_KEY_ROUND(14, 0x40)
+#undef LT_HW_KEY_ROUND
+
+    _mm_storeu_si128((__m128i *)ctx->h, lt_hw_bswap(lt_hw_aes(rk, _mm_setzero_si128())));
+}
+
+static LT_HW_TARGET void lt_hw_ghash(const lt_aesgcm_hw_ctx_t *ctx, uint8_t *y, const uint8_t *data, uint32_t len)
+{
+    const __m128i h = _mm_loadu_si128((const __m128i *)ctx->h);
+    __m128i acc = _mm_loadu_si128((const __m128i *)y);
+
+    while (len >= LT_AES_BLOCK_SIZE) {
+        acc = lt_hw_gfmul(_mm_xor_si128(acc, lt_hw_bswap(_mm_loadu_si128((const __m128i *)data))), h);
+        data += LT_AES_BLOCK_SIZE;
+        len -= LT_AES_BLOCK_SIZE;
+    }
+    if (len) {
+        uint8_t last[LT_AES_BLOCK_SIZE] = {0};
+        memcpy(last, data, len);
+        acc = lt_hw_gfmul(_mm_xor_si128(acc, lt_hw_bswap(_mm_loadu_si128((const __m128i *)last))), h);
+    }
+
+    _mm_storeu_si128((__m128i *)y, acc);
+}
+
+static LT_HW_TARGET void lt_hw_ctr(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *j, const uint8_t *in, uint8_t *out,
+                                   uint32_t len)
+{
+    const __m128i *rk = (const __m128i *)ctx->rk;
+    const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+    // Byte reversed counter block has the 32-bit big endian counter in the lowest dword, where it can be
+    // incremented (modulo 2^32 as inc32() of GCM) by a single addition.
+    __m128i ctr = lt_hw_bswap(_mm_loadu_si128((const __m128i *)j));
+    __m128i b[4];
+
+    while (len >= 4 * LT_AES_BLOCK_SIZE) {
+        for (int i = 0; i < 4; i++) {
+            b[i] = lt_hw_bswap(ctr);
+            ctr = _mm_add_epi32(ctr, one);
+        }
+        lt_hw_aes4(rk, b);
+        for (int i = 0; i < 4; i++) {
+            __m128i d = _mm_loadu_si128((const __m128i *)(in + i * LT_AES_BLOCK_SIZE));
+            _mm_storeu_si128((__m128i *)(out + i * LT_AES_BLOCK_SIZE), _mm_xor_si128(d, b[i]));
+        }
+        in += 4 * LT_AES_BLOCK_SIZE;
+        out += 4 * LT_AES_BLOCK_SIZE;
+        len -= 4 * LT_AES_BLOCK_SIZE;
+    }
+    while (len >= LT_AES_BLOCK_SIZE) {
+        b[0] = lt_hw_aes(rk, lt_hw_bswap(ctr));
+        ctr = _mm_add_epi32(ctr, one);
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), b[0]));
+        in += LT_AES_BLOCK_SIZE;
+        out += LT_AES_BLOCK_SIZE;
+        len -= LT_AES_BLOCK_SIZE;
+    }
+    if (len) {
+        uint8_t ks[LT_AES_BLOCK_SIZE];
+        _mm_storeu_si128((__m128i *)ks, lt_hw_aes(rk, lt_hw_bswap(ctr)));
+        for (uint32_t i = 0; i < len; i++) {
+            out[i] = in[i] ^ ks[i];
+        }
+        lt_secure_memzero(ks, sizeof(ks));
+    }
+}
+
+static LT_HW_TARGET void lt_hw_tag(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *y, const uint8_t *j0, uint8_t *tag)
+{
+    __m128i s = lt_hw_aes((const __m128i *)ctx->rk, _mm_loadu_si128((const __m128i *)j0));
+    _mm_storeu_si128((__m128i *)tag, _mm_xor_si128(lt_hw_bswap(_mm_loadu_si128((const __m128i *)y)), s));
+}
+#endif  // LT_AESGCM_HW_X86
+
+#ifdef LT_AESGCM_HW_ARM
+#define LT_HW_TARGET __attribute__((target("+crypto")))
+
+static bool lt_hw_cpu_check(void)
+{
+#if defined(__linux__)
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    return (hwcap & HWCAP_AES) && (hwcap & HWCAP_PMULL);
+#elif defined(__APPLE__)
+    return true;  // All Apple AArch64 cores implement the Crypto Extension.
+#elif defined(__ARM_FEATURE_CRYPTO)
+    return true;  // Build targets a core with the Crypto Extension.
+#else
+    return false;
+#endif
+}
+
+/** Loads the block as polynomial with coefficient of x^i in bit i (GCM stores coefficients from the MSB). */
+static inline LT_HW_TARGET uint8x16_t lt_hw_load_poly(const uint8_t *p) { return vrbitq_u8(vld1q_u8(p)); }
+
+/** Multiplication in GF(2^128) of polynomials loaded by lt_hw_load_poly(). */
+static inline LT_HW_TARGET uint8x16_t lt_hw_gfmul(const uint8x16_t a, const uint8x16_t b)
+{
+    const poly64_t r = (poly64_t)0x87;  // x^128 = x^7 + x^2 + x + 1
+    uint64x2_t a64 = vreinterpretq_u64_u8(a);
+    uint64x2_t b64 = vreinterpretq_u64_u8(b);
+    poly64_t a0 = (poly64_t)vgetq_lane_u64(a64, 0), a1 = (poly64_t)vgetq_lane_u64(a64, 1);
+    poly64_t b0 = (poly64_t)vgetq_lane_u64(b64, 0), b1 = (poly64_t)vgetq_lane_u64(b64, 1);
+
+    uint64x2_t lo = vreinterpretq_u64_p128(vmull_p64(a0, b0));
+    uint64x2_t hi = vreinterpretq_u64_p128(vmull_p64(a1, b1));
+    uint64x2_t mid
+        = veorq_u64(vreinterpretq_u64_p128(vmull_p64(a0, b1)), vreinterpretq_u64_p128(vmull_p64(a1, b0)));
+
+    // 256-bit product as four 64-bit words w0 (lowest) .. w3.
+    uint64_t w0 = vgetq_lane_u64(lo, 0);
+    uint64_t w1 = vgetq_lane_u64(lo, 1) ^ vgetq_lane_u64(mid, 0);
+    uint64_t w2 = vgetq_lane_u64(hi, 0) ^ vgetq_lane_u64(mid, 1);
+    uint64_t w3 = vgetq_lane_u64(hi, 1);
+
+    // Fold w3 (x^192) and then w2 (x^128) using x^128 = r.
+    uint64x2_t t = vreinterpretq_u64_p128(vmull_p64((poly64_t)w3, r));
+    w1 ^= vgetq_lane_u64(t, 0);
+    w2 ^= vgetq_lane_u64(t, 1);
+    t = vreinterpretq_u64_p128(vmull_p64((poly64_t)w2, r));
+    w0 ^= vgetq_lane_u64(t, 0);
+    w1 ^= vgetq_lane_u64(t, 1);
+
+    return vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(w0), vcreate_u64(w1)));
+}
+
+static inline LT_HW_TARGET uint8x16_t lt_hw_aes(const uint8_t *rk, uint8x16_t b)
+{
+    for (int i = 0; i < 13; i++) {
+        b = vaesmcq_u8(vaeseq_u8(b, vld1q_u8(rk + i * LT_AES_BLOCK_SIZE)));
+    }
+    b = vaeseq_u8(b, vld1q_u8(rk + 13 * LT_AES_BLOCK_SIZE));
+    return veorq_u8(b, vld1q_u8(rk + 14 * LT_AES_BLOCK_SIZE));
+}
+
+/** SubWord() of AES key expansion, AESE with zero round key on a block of four equal columns is just SubBytes. */
+static inline LT_HW_TARGET uint32_t lt_hw_sub_word(const uint32_t w)
+{
+    uint8x16_t b = vaeseq_u8(vreinterpretq_u8_u32(vdupq_n_u32(w)), vdupq_n_u8(0));
+    return vgetq_lane_u32(vreinterpretq_u32_u8(b), 0);
+}
+
+static LT_HW_TARGET void lt_hw_init(lt_aesgcm_hw_ctx_t *ctx, const uint8_t *key)
+{
+    uint32_t w[60];
+    uint32_t rcon = 0x01;
+
+    // Words are little endian, so RotWord() is a rotation right by 8 bits and the round constant goes to the lowest
+    // byte.
+    memcpy(w, key, TR01_AES256_KEY_LEN);
+    for (int i = 8; i < 60; i++) {
+        uint32_t t = w[i - 1];
+        if ((i % 8) == 0) {
+            t = lt_hw_sub_word((t >> 8) | (t << 24)) ^ rcon;
+            rcon <<= 1;
+        }
+        else if ((i % 8) == 4) {
+            t = lt_hw_sub_word(t);
+        }
+        w[i] = w[i - 8] ^ t;
+    }
+    memcpy(ctx->rk, w, sizeof(ctx->rk));
+    lt_secure_memzero(w, sizeof(w));
+
+    vst1q_u8(ctx->h, vrbitq_u8(lt_hw_aes(ctx->rk, vdupq_n_u8(0))));
+}
+
+static LT_HW_TARGET void lt_hw_ghash(const lt_aesgcm_hw_ctx_t *ctx, uint8_t *y, const uint8_t *data, uint32_t len)
+{
+    const uint8x16_t h = vld1q_u8(ctx->h);
+    uint8x16_t acc = vld1q_u8(y);
+
+    while (len >= LT_AES_BLOCK_SIZE) {
+        acc = lt_hw_gfmul(veorq_u8(acc, lt_hw_load_poly(data)), h);
+        data += LT_AES_BLOCK_SIZE;
+        len -= LT_AES_BLOCK_SIZE;
+    }
+    if (len) {
+        uint8_t last[LT_AES_BLOCK_SIZE] = {0};
+        memcpy(last, data, len);
+        acc = lt_hw_gfmul(veorq_u8(acc, lt_hw_load_poly(last)), h);
+    }
+
+    vst1q_u8(y, acc);
+}
+
+static LT_HW_TARGET void lt_hw_ctr(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *j, const uint8_t *in, uint8_t *out,
+                                   uint32_t len)
+{
+    uint32x4_t blk = vreinterpretq_u32_u8(vld1q_u8(j));
+    uint32_t ctr = __builtin_bswap32(vgetq_lane_u32(blk, 3));
+
+    while (len) {
+        blk = vsetq_lane_u32(__builtin_bswap32(ctr++), blk, 3);
+        uint8x16_t ks = lt_hw_aes(ctx->rk, vreinterpretq_u8_u32(blk));
+        if (len >= LT_AES_BLOCK_SIZE) {
+            vst1q_u8(out, veorq_u8(vld1q_u8(in), ks));
+            in += LT_AES_BLOCK_SIZE;
+            out += LT_AES_BLOCK_SIZE;
+            len -= LT_AES_BLOCK_SIZE;
+        }
+        else {
+            uint8_t last[LT_AES_BLOCK_SIZE];
+            vst1q_u8(last, ks);
+            for (uint32_t i = 0; i < len; i++) {
+                out[i] = in[i] ^ last[i];
+            }
+            lt_secure_memzero(last, sizeof(last));
+            len = 0;
+        }
+    }
+}
+
+static LT_HW_TARGET void lt_hw_tag(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *y, const uint8_t *j0, uint8_t *tag)
+{
+    uint8x16_t s = lt_hw_aes(ctx->rk, vld1q_u8(j0));
+    vst1q_u8(tag, veorq_u8(vrbitq_u8(vld1q_u8(y)), s));
+}
+#endif  // LT_AESGCM_HW_ARM
+
+bool lt_aesgcm_hw_supported(void)
+{
+    // Concurrent first calls all store the same value.
+    static int supported = -1;
+
+    if (supported < 0) {
+        supported = lt_hw_cpu_check() ? 1 : 0;
+    }
+
+    return supported == 1;
+}
+
+void lt_aesgcm_hw_init(lt_aesgcm_hw_ctx_t *ctx, const uint8_t *key) { lt_hw_init(ctx, key); }
+
+/**
+ * @brief Computes tag over additional data and ciphertext.
+ *
+ * @param ctx      Accelerated AES-GCM context
+ * @param j0       Pre-counter block
+ * @param add      Additional authenticated data
+ * @param add_len  Length of add
+ * @param ct       Ciphertext
+ * @param len      Length of ct
+ * @param tag      Tag, LT_AES_BLOCK_SIZE bytes
+ */
+static void lt_aesgcm_hw_compute_tag(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *j0, const uint8_t *add,
+                                     const uint32_t add_len, const uint8_t *ct, const uint32_t len, uint8_t *tag)
+{
+    uint8_t y[LT_AES_BLOCK_SIZE] = {0};
+    uint8_t lens[LT_AES_BLOCK_SIZE] = {0};
+    uint64_t add_bits = (uint64_t)add_len * 8;
+    uint64_t ct_bits = (uint64_t)len * 8;
+
+    for (int i = 0; i < 8; i++) {
+        lens[7 - i] = (uint8_t)(add_bits >> (8 * i));
+        lens[15 - i] = (uint8_t)(ct_bits >> (8 * i));
+    }
+
+    lt_hw_ghash(ctx, y, add, add_len);
+    lt_hw_ghash(ctx, y, ct, len);
+    lt_hw_ghash(ctx, y, lens, sizeof(lens));
+    lt_hw_tag(ctx, y, j0, tag);
+}
+
+/**
+ * @brief Builds pre-counter block J0 = IV || 0^31 || 1 and the first counter block inc32(J0).
+ *
+ * @param iv  IV, TR01_L3_IV_SIZE bytes
+ * @param j0  Pre-counter block
+ * @param j1  First counter block
+ */
+static void lt_aesgcm_hw_counters(const uint8_t *iv, uint8_t *j0, uint8_t *j1)
+{
+    memcpy(j0, iv, TR01_L3_IV_SIZE);
+    j0[12] = 0;
+    j0[13] = 0;
+    j0[14] = 0;
+    j0[15] = 1;
+
+    memcpy(j1, j0, LT_AES_BLOCK_SIZE);
+    j1[15] = 2;
+}
+
+void lt_aesgcm_hw_encrypt(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *iv, const uint8_t *add, const uint32_t add_len,
+                          const uint8_t *in, uint8_t *out, const uint32_t len, uint8_t *tag)
+{
+    uint8_t j0[LT_AES_BLOCK_SIZE], j1[LT_AES_BLOCK_SIZE];
+    uint8_t full_tag[LT_AES_BLOCK_SIZE];
+
+    lt_aesgcm_hw_counters(iv, j0, j1);
+    lt_hw_ctr(ctx, j1, in, out, len);
+    lt_aesgcm_hw_compute_tag(ctx, j0, add, add_len, out, len, full_tag);
+    memcpy(tag, full_tag, TR01_L3_TAG_SIZE);
+}
+
+bool lt_aesgcm_hw_decrypt(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *iv, const uint8_t *add, const uint32_t add_len,
+                          const uint8_t *in, uint8_t *out, const uint32_t len, const uint8_t *tag)
+{
+    uint8_t j0[LT_AES_BLOCK_SIZE], j1[LT_AES_BLOCK_SIZE];
+    uint8_t full_tag[LT_AES_BLOCK_SIZE];
+    uint8_t diff = 0;
+
+    lt_aesgcm_hw_counters(iv, j0, j1);
+    lt_aesgcm_hw_compute_tag(ctx, j0, add, add_len, in, len, full_tag);
+
+    // Constant time comparison.
+    for (uint32_t i = 0; i < TR01_L3_TAG_SIZE; i++) {
+        diff |= full_tag[i] ^ tag[i];
+    }
+    if (diff) {
+        return false;
+    }
+
+    lt_hw_ctr(ctx, j1, in, out, len);
+    return true;
+}
+
+#else  // No accelerated kernels for this architecture.
+
+bool lt_aesgcm_hw_supported(void) { return false; }
+
+void lt_aesgcm_hw_init(lt_aesgcm_hw_ctx_t *ctx, const uint8_t *key)
+{
+    LT_UNUSED(ctx);
+    LT_UNUSED(key);
+}
+
+void lt_aesgcm_hw_encrypt(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *iv, const uint8_t *add, const uint32_t add_len,
+                          const uint8_t *in, uint8_t *out, const uint32_t len, uint8_t *tag)
+{
+    LT_UNUSED(ctx);
+    LT_UNUSED(iv);
+    LT_UNUSED(add);
+    LT_UNUSED(add_len);
+    LT_UNUSED(in);
+    LT_UNUSED(out);
+    LT_UNUSED(len);
+    LT_UNUSED(tag);
+}
+
+bool lt_aesgcm_hw_decrypt(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *iv, const uint8_t *add, const uint32_t add_len,
+                          const uint8_t *in, uint8_t *out, const uint32_t len, const uint8_t *tag)
+{
+    LT_UNUSED(ctx);
+    LT_UNUSED(iv);
+    LT_UNUSED(add);
+    LT_UNUSED(add_len);
+    LT_UNUSED(in);
+    LT_UNUSED(out);
+    LT_UNUSED(len);
+    LT_UNUSED(tag);
+    return false;
+}
+#endif
@@ -0,0 +1,74 @@
+#ifndef LT_TREZOR_CRYPTO_AESGCM_HW_H
+#define LT_TREZOR_CRYPTO_AESGCM_HW_H
+
+/**
+ * @file lt_trezor_crypto_aesgcm_hw.h
+ * @brief AES-256-GCM using AES and carry-less multiply instructions of the CPU (used internally by the Trezor crypto
+ * CAL).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_trezor_crypto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Checks at runtime whether the CPU supports the instructions (AES-NI and PCLMULQDQ on x86, AES and PMULL of
+ * ARMv8 Crypto Extension on AArch64). Result is detected once and cached.
+ *
+ * @return true if the accelerated kernels can be used
+ */
+bool lt_aesgcm_hw_supported(void);
+
+/**
+ * @brief Expands AES-256 key and derives GHASH key. Must be called only if lt_aesgcm_hw_supported() returned true.
+ *
+ * @param ctx  Accelerated AES-GCM context
+ * @param key  AES-256 key, TR01_AES256_KEY_LEN bytes
+ */
+void lt_aesgcm_hw_init(lt_aesgcm_hw_ctx_t *ctx, const uint8_t *key);
+
+/**
+ * @brief Encrypts data with 96-bit IV. Input and output may be the same buffer.
+ *
+ * @param ctx      Accelerated AES-GCM context
+ * @param iv       IV, TR01_L3_IV_SIZE bytes
+ * @param add      Additional authenticated data
+ * @param add_len  Length of add
+ * @param in       Plaintext
+ * @param out      Ciphertext, len bytes
+ * @param len      Length of in
+ * @param tag      Tag, TR01_L3_TAG_SIZE bytes
+ */
+void lt_aesgcm_hw_encrypt(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *iv, const uint8_t *add, const uint32_t add_len,
+                          const uint8_t *in, uint8_t *out, const uint32_t len, uint8_t *tag);
+
+/**
+ * @brief Verifies tag and decrypts data with 96-bit IV. Input and output may be the same buffer.
+ * @note Output is written only when the tag matches.
+ *
+ * @param ctx      Accelerated AES-GCM context
+ * @param iv       IV, TR01_L3_IV_SIZE bytes
+ * @param add      Additional authenticated data
+ * @param add_len  Length of add
+ * @param in       Ciphertext
+ * @param out      Plaintext, len bytes
+ * @param len      Length of in
+ * @param tag      Expected tag, TR01_L3_TAG_SIZE bytes
+ * @return         true if the tag matches
+ */
+bool lt_aesgcm_hw_decrypt(const lt_aesgcm_hw_ctx_t *ctx, const uint8_t *iv, const uint8_t *add, const uint32_t add_len,
+                          const uint8_t *in, uint8_t *out, const uint32_t len, const uint8_t *tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_TREZOR_CRYPTO_AESGCM_HW_H
@@ -9,10 +9,18 @@
 #include "libtropic_trezor_crypto.h"
 #include "lt_aesgcm.h"
 #include "lt_crypto_common.h"
+#include "lt_hmac_sha256.h"
 
 lt_ret_t lt_crypto_ctx_init(void *ctx)
 {
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+
+    _ctx->aesgcm_encrypt_hw_ctx.enabled = false;
+    _ctx->aesgcm_decrypt_hw_ctx.enabled = false;
+#else
     LT_UNUSED(ctx);
+#endif
     return LT_OK;
 }
 
@@ -20,6 +28,7 @@ lt_ret_t lt_crypto_ctx_deinit(void *ctx)
 {
     lt_ret_t ret1 = lt_aesgcm_encrypt_deinit(ctx);
     lt_ret_t ret2 = lt_aesgcm_decrypt_deinit(ctx);
+    lt_ret_t ret3 = lt_hmac_sha256_deinit(ctx);
 
     if (ret1 != LT_OK) {
         return ret1;
@@ -27,6 +36,9 @@ lt_ret_t lt_crypto_ctx_deinit(void *ctx)
     if (ret2 != LT_OK) {
         return ret2;
     }
+    if (ret3 != LT_OK) {
+        return ret3;
+    }
 
     return LT_OK;
 }
\ No newline at end of file
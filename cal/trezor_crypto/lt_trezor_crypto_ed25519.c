@@ -0,0 +1,251 @@
+/**
+ * @file lt_trezor_crypto_ed25519.c
+ * @brief Batch verification of Ed25519 signatures by curve25519-donna, shared with the STM32, MbedTLS v4 and ESP32
+ * CALs.
+ * @details Group of signatures is checked by one multi-scalar multiplication (Straus) of the cofactored equation
+ * [8]([sum z_i*S_i]B - sum [z_i]R_i - sum [z_i*k_i]A_i) = 0, where k_i = SHA-512(R_i||A_i||M_i) and z_i are 128-bit
+ * weights derived from all signatures of the group by SHA-512, so they cannot be chosen by the signer. Signatures of
+ * the same public key share one point.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ed25519-donna/ed25519-donna.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "sha2.h"
+
+/** Maximum number of signatures in one multi-scalar multiplication, each adds about 1.8 kB of stack. */
+#define LT_ED25519_BATCH 8
+/** Points of the multi-scalar multiplication: base point, R of every signature and (at most) A of every signature. */
+#define LT_ED25519_TERMS (2 * LT_ED25519_BATCH + 1)
+/** Width of the sliding window, one less than curve25519-donna uses for a single point to halve the tables. */
+#define LT_ED25519_WINDOW 4
+/** Odd multiples of a point precomputed for the sliding window. */
+#define LT_ED25519_TABLE_SIZE (1 << (LT_ED25519_WINDOW - 2))
+/** Length of the public key, R and S. */
+#define LT_ED25519_LEN 32
+
+/** Decodes a point negated, only canonical encodings of RFC 8032 are accepted. */
+static bool lt_ed25519_decode_negative(ge25519 *p, const uint8_t *enc)
+{
+    // y has to be < 2^255 - 19.
+    bool y_max = ((enc[31] & 0x7F) == 0x7F) && (enc[0] >= 0xED);
+    for (int i = 1; y_max && (i < 31); i++) {
+        y_max = (enc[i] == 0xFF);
+    }
+    if (y_max || !ge25519_unpack_negative_vartime(p, enc)) {
+        return false;
+    }
+
+    // Sign bit of x = 0 has to be 0.
+    return !(enc[31] & 0x80) || curve25519_isnonzero(p->x);
+}
+
+/** Checks S and computes k = SHA-512(R||A||M) mod l. */
+static bool lt_ed25519_scalars(const lt_ed25519_verify_t *item, bignum256modm k, bignum256modm s)
+{
+    SHA512_CTX sha;
+    uint8_t hash[SHA512_DIGEST_LENGTH];
+
+    if (item->signature[63] & 0xE0) {
+        return false;
+    }
+    expand_raw256_modm(s, item->signature + LT_ED25519_LEN);
+    if (!is_reduced256_modm(s)) {
+        return false;
+    }
+
+    sha512_Init(&sha);
+    sha512_Update(&sha, item->signature, LT_ED25519_LEN);
+    sha512_Update(&sha, item->pubkey, LT_ED25519_LEN);
+    sha512_Update(&sha, item->msg, item->msg_len);
+    sha512_Final(&sha, hash);
+    expand256_modm(k, hash, sizeof(hash));
+
+    return true;
+}
+
+/** Tells whether [8]P is the neutral element. */
+static bool lt_ed25519_small_order(const ge25519 *p)
+{
+    static const uint8_t neutral[LT_ED25519_LEN] = {0x01};
+    ge25519 p8;
+    uint8_t enc[LT_ED25519_LEN];
+
+    ge25519_mul8(&p8, p);
+    ge25519_pack(enc, &p8);
+
+    return !memcmp(enc, neutral, sizeof(enc));
+}
+
+/** Precomputes odd multiples P, 3P, ..., 7P of a point. */
+static void lt_ed25519_table(ge25519_pniels table[LT_ED25519_TABLE_SIZE], const ge25519 *p)
+{
+    ge25519 p2;
+
+    ge25519_double(&p2, p);
+    ge25519_full_to_pniels(&table[0], p);
+    for (int i = 0; i < LT_ED25519_TABLE_SIZE - 1; i++) {
+        ge25519_pnielsadd(&table[i + 1], &p2, &table[i]);
+    }
+}
+
+/** Checks one signature by the cofactored equation [8]([S]B - R - [k]A) = 0. */
+static bool lt_ed25519_verify_one(const lt_ed25519_verify_t *item)
+{
+    ge25519 neg_a, neg_r, p;
+    bignum256modm k, s;
+
+    if (!lt_ed25519_decode_negative(&neg_a, item->pubkey) || !lt_ed25519_decode_negative(&neg_r, item->signature)
+        || !lt_ed25519_scalars(item, k, s)) {
+        return false;
+    }
+
+    ge25519_double_scalarmult_vartime(&p, &neg_a, k, s);
+    ge25519_add(&p, &p, &neg_r, 0);
+
+    return lt_ed25519_small_order(&p);
+}
+
+/**
+ * Checks up to LT_ED25519_BATCH signatures together and sets `valid` of the items. If the group does not verify, the
+ * signatures are checked one by one.
+ */
+static void lt_ed25519_verify_group(lt_ed25519_verify_t *items, const size_t count)
+{
+    ge25519_pniels tables[LT_ED25519_TERMS][LT_ED25519_TABLE_SIZE];
+    signed char slides[LT_ED25519_TERMS][256];
+    bignum256modm scalars[LT_ED25519_TERMS];
+    bignum256modm k[LT_ED25519_BATCH], s[LT_ED25519_BATCH], z, zk;
+    uint8_t a_term[LT_ED25519_BATCH], r_term[LT_ED25519_BATCH];
+    uint8_t enc[LT_ED25519_LEN];
+    uint8_t hash[SHA512_DIGEST_LENGTH];
+    uint8_t seed[SHA512_DIGEST_LENGTH + 1];
+    SHA512_CTX sha;
+    ge25519 a, r, p;
+    ge25519_p1p1 t;
+    size_t terms = 1;
+    bool used = false;
+
+    // Base point is the first term. Signatures which do not decode are not valid without further checks.
+    lt_ed25519_table(tables[0], &ge25519_basepoint);
+    set256_modm(scalars[0], 0);
+    sha512_Init(&sha);
+    for (size_t i = 0; i < count; i++) {
+        lt_ed25519_verify_t *item = &items[i];
+        item->valid = false;
+        a_term[i] = 0;
+        for (size_t j = 0; j < i; j++) {
+            if (items[j].valid && !memcmp(items[j].pubkey, item->pubkey, LT_ED25519_LEN)) {
+                a_term[i] = a_term[j];
+                break;
+            }
+        }
+        if (!lt_ed25519_scalars(item, k[i], s[i]) || !lt_ed25519_decode_negative(&r, item->signature)) {
+            continue;
+        }
+        if (!a_term[i]) {
+            if (!lt_ed25519_decode_negative(&a, item->pubkey)) {
+                continue;
+            }
+            a_term[i] = (uint8_t)terms;
+            lt_ed25519_table(tables[terms], &a);
+            set256_modm(scalars[terms], 0);
+            terms++;
+        }
+        r_term[i] = (uint8_t)terms;
+        lt_ed25519_table(tables[terms], &r);
+        terms++;
+        item->valid = true;
+        used = true;
+
+        contract256_modm(enc, k[i]);
+        sha512_Update(&sha, item->signature, 2 * LT_ED25519_LEN);
+        sha512_Update(&sha, item->pubkey, LT_ED25519_LEN);
+        sha512_Update(&sha, enc, sizeof(enc));
+    }
+    if (!used) {
+        return;
+    }
+    sha512_Final(&sha, seed);
+
+    // Scalars: sum z_i*S_i for B, z_i for R_i and sum z_i*k_i for A shared by the signatures of the same key.
+    for (size_t i = 0; i < count; i++) {
+        if (!items[i].valid) {
+            continue;
+        }
+        seed[SHA512_DIGEST_LENGTH] = (uint8_t)i;
+        sha512_Raw(seed, sizeof(seed), hash);
+        expand256_modm(z, hash, 16);
+
+        copy256_modm(scalars[r_term[i]], z);
+        mul256_modm(zk, z, k[i]);
+        add256_modm(scalars[a_term[i]], scalars[a_term[i]], zk);
+        mul256_modm(zk, z, s[i]);
+        add256_modm(scalars[0], scalars[0], zk);
+    }
+
+    int top = -1;
+    for (size_t j = 0; j < terms; j++) {
+        contract256_slidingwindow_modm(slides[j], scalars[j], LT_ED25519_WINDOW);
+        for (int i = 255; i > top; i--) {
+            if (slides[j][i]) {
+                top = i;
+                break;
+            }
+        }
+    }
+
+    ge25519_set_neutral(&p);
+    for (int i = top; i >= 0; i--) {
+        ge25519_double_p1p1(&t, &p);
+        for (size_t j = 0; j < terms; j++) {
+            if (slides[j][i]) {
+                ge25519_p1p1_to_full(&p, &t);
+                ge25519_pnielsadd_p1p1(&t, &p, &tables[j][abs(slides[j][i]) / 2], (unsigned char)slides[j][i] >> 7);
+            }
+        }
+        ge25519_p1p1_to_partial(&p, &t);
+    }
+
+    if (lt_ed25519_small_order(&p)) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].valid) {
+            items[i].valid = lt_ed25519_verify_one(&items[i]);
+        }
+    }
+}
+
+lt_ret_t lt_ed25519_verify_batch(lt_ed25519_verify_t *items, const size_t count)
+{
+    if (!items) {
+        return LT_PARAM_ERR;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!items[i].pubkey || !items[i].signature || (!items[i].msg && items[i].msg_len)) {
+            return LT_PARAM_ERR;
+        }
+    }
+
+    bool all_valid = true;
+    for (size_t i = 0; i < count; i += LT_ED25519_BATCH) {
+        size_t n = (count - i < LT_ED25519_BATCH) ? (count - i) : LT_ED25519_BATCH;
+        lt_ed25519_verify_group(&items[i], n);
+        for (size_t j = i; j < i + n; j++) {
+            all_valid = all_valid && items[j].valid;
+        }
+    }
+
+    return all_valid ? LT_OK : LT_SIGNATURE_INVALID;
+}
+
@@ -6,14 +6,45 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "hmac.h"
 #include "libtropic_common.h"
+#include "libtropic_trezor_crypto.h"
 #include "lt_hmac_sha256.h"
+#include "lt_secure_memzero.h"
 
 lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
                         uint8_t *output)
 {
     hmac_sha256(key, key_len, input, input_len, output);
     return LT_OK;
-}
\ No newline at end of file
+}
+
+lt_ret_t lt_hmac_sha256_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+
+    hmac_sha256_Init(&_ctx->hmac_sha256_ctx, key, key_len);
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_compute(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+    HMAC_SHA256_CTX msg_ctx;
+
+    // Context holds the midstates after the inner and outer pad, the copy continues from them.
+    memcpy(&msg_ctx, &_ctx->hmac_sha256_ctx, sizeof(msg_ctx));
+    hmac_sha256_Update(&msg_ctx, input, input_len);
+    hmac_sha256_Final(&msg_ctx, output);  // Wipes msg_ctx.
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_deinit(void *ctx)
+{
+    lt_ctx_trezor_crypto_t *_ctx = (lt_ctx_trezor_crypto_t *)ctx;
+
+    lt_secure_memzero(&_ctx->hmac_sha256_ctx, sizeof(_ctx->hmac_sha256_ctx));
+    return LT_OK;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file lt_trezor_crypto_ops.c
+ * @brief Trezor crypto CAL built as one of the CALs selected at runtime (LT_CRYPTO_OPS), its functions are renamed to
+ * lt_trezor_crypto_* and collected in lt_crypto_ops_trezor_crypto.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#define LT_CRYPTO_OPS_BACKEND trezor_crypto
+// Streaming AES-GCM of LT_L3_STREAM_ENCRYPT and LT_L3_STREAM_DECRYPT is implemented.
+#define LT_CRYPTO_OPS_AESGCM_STREAM
+#include "lt_crypto_ops_backend.h"
+
+#include "lt_trezor_crypto_common.c"
+#include "lt_trezor_crypto_aesgcm.c"
+#include "lt_trezor_crypto_sha256.c"
+#include "lt_trezor_crypto_hmac_sha256.c"
+#include "lt_trezor_crypto_x25519.c"
+#ifdef LT_TREZOR_CRYPTO_AESGCM_HW
+#include "lt_trezor_crypto_aesgcm_hw.c"
+#endif
+#ifdef LT_ED25519_VERIFY
+#include "lt_trezor_crypto_ed25519.c"
+#endif
+
+#include "libtropic_trezor_crypto.h"
+
+LT_CRYPTO_OPS_DEFINE(lt_crypto_ops_trezor_crypto, "trezor_crypto");
@@ -9,7 +9,9 @@
  * @license For the license see LICENSE.md in the root directory of this source tree.
  */
 
+#include <stdbool.h>
 #include <wolfssl/wolfcrypt/aes.h>
+#include <wolfssl/wolfcrypt/hmac.h>
 #include <wolfssl/wolfcrypt/sha256.h>
 
 /**
@@ -34,6 +36,17 @@ typedef struct lt_ctx_wolfcrypt_t {
     lt_aesgcm_ctx_wolfcrypt_t aesgcm_decrypt_ctx;
     /** @private @brief SHA-256 context. */
     wc_Sha256 sha256_ctx;
+    /** @private @brief HMAC-SHA256 context keyed by lt_hmac_sha256_init(), it keeps the inner and outer pad. */
+    Hmac hmac_sha256_ctx;
+    /** @private @brief Flag indicating if HMAC-SHA256 key is set. */
+    bool hmac_sha256_key_set;
 } lt_ctx_wolfcrypt_t;
 
+#ifdef LT_CRYPTO_OPS
+#include "libtropic_common.h"
+
+/** @brief Functions of the WolfCrypt CAL for `lt_crypto_ops_set()` and `lt_crypto_ops_probe()`. */
+extern const lt_crypto_ops_t lt_crypto_ops_wolfcrypt;
+#endif
+
 #endif  // LT_WOLFCRYPT_H
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "libtropic_wolfcrypt.h"
 #include "lt_aesgcm.h"
 #include "lt_crypto_common.h"
+#include "lt_hmac_sha256.h"
 #include "lt_sha256.h"
 
 lt_ret_t lt_crypto_ctx_init(void *ctx)
@@ -19,6 +20,7 @@ lt_ret_t lt_crypto_ctx_init(void *ctx)
 
     _ctx->aesgcm_encrypt_ctx.initialized = false;
     _ctx->aesgcm_decrypt_ctx.initialized = false;
+    _ctx->hmac_sha256_key_set = false;
 
     return LT_OK;
 }
@@ -27,6 +29,7 @@ lt_ret_t lt_crypto_ctx_deinit(void *ctx)
 {
     lt_ret_t ret1 = lt_aesgcm_encrypt_deinit(ctx);
     lt_ret_t ret2 = lt_aesgcm_decrypt_deinit(ctx);
+    lt_ret_t ret3 = lt_hmac_sha256_deinit(ctx);
 
     if (ret1 != LT_OK) {
         return ret1;
@@ -34,6 +37,9 @@ lt_ret_t lt_crypto_ctx_deinit(void *ctx)
     if (ret2 != LT_OK) {
         return ret2;
     }
+    if (ret3 != LT_OK) {
+        return ret3;
+    }
 
     return LT_OK;
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * @file lt_wolfcrypt_ed25519.c
+ * @brief Verification of many Ed25519 signatures, WolfCrypt has no batch verification, but the public key is
+ * imported once for adjacent signatures of the same key. WolfSSL has to be configured with WOLFSSL_ED25519.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <wolfssl/wolfcrypt/ed25519.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+
+lt_ret_t lt_ed25519_verify_batch(lt_ed25519_verify_t *items, const size_t count)
+{
+    ed25519_key key;
+    const uint8_t *key_raw = NULL;
+    bool key_imported = false;
+    lt_ret_t lt_ret = LT_OK;
+    int ret;
+
+    if (!items) {
+        return LT_PARAM_ERR;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!items[i].pubkey || !items[i].signature || (!items[i].msg && items[i].msg_len)) {
+            return LT_PARAM_ERR;
+        }
+        items[i].valid = false;
+    }
+    if (!count) {
+        return LT_OK;
+    }
+
+    ret = wc_ed25519_init(&key);
+    if (ret != 0) {
+        LT_LOG_ERROR("Failed to initialize Ed25519 key, ret=%d (%s)", ret, wc_GetErrorString(ret));
+        return LT_CRYPTO_ERR;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        lt_ed25519_verify_t *item = &items[i];
+        int res = 0;
+
+        if (!key_raw || memcmp(key_raw, item->pubkey, TR01_CURVE_ED25519_PUBKEY_LEN)) {
+            wc_ed25519_free(&key);
+            ret = wc_ed25519_init(&key);
+            if (ret != 0) {
+                LT_LOG_ERROR("Failed to initialize Ed25519 key, ret=%d (%s)", ret, wc_GetErrorString(ret));
+                return LT_CRYPTO_ERR;
+            }
+            // Public key which does not decode makes its signatures not valid.
+            key_imported = (wc_ed25519_import_public(item->pubkey, TR01_CURVE_ED25519_PUBKEY_LEN, &key) == 0);
+            key_raw = item->pubkey;
+        }
+
+        // Malformed signatures are reported by error codes, they are not valid either.
+        if (key_imported) {
+            ret = wc_ed25519_verify_msg(item->signature, TR01_ECDSA_EDDSA_SIGNATURE_LENGTH, item->msg,
+                                        (word32)item->msg_len, &res, &key);
+            item->valid = (ret == 0) && (res == 1);
+        }
+        if (!item->valid) {
+            lt_ret = LT_SIGNATURE_INVALID;
+        }
+    }
+
+    wc_ed25519_free(&key);
+    return lt_ret;
+}
+
@@ -12,7 +12,9 @@
 
 #include "libtropic_common.h"
 #include "libtropic_logging.h"
+#include "libtropic_wolfcrypt.h"
 #include "lt_hmac_sha256.h"
+#include "lt_secure_memzero.h"
 
 lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
                         uint8_t *output)
@@ -55,3 +57,59 @@ lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_
 
     return LT_OK;
 }
+
+lt_ret_t lt_hmac_sha256_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    lt_ctx_wolfcrypt_t *_ctx = (lt_ctx_wolfcrypt_t *)ctx;
+    int ret;
+
+    ret = wc_HmacInit(&_ctx->hmac_sha256_ctx, NULL, INVALID_DEVID);
+    if (ret != 0) {
+        LT_LOG_ERROR("Failed to initialize HMAC context, ret=%d (%s)", ret, wc_GetErrorString(ret));
+        return LT_CRYPTO_ERR;
+    }
+
+    // Inner and outer pad are kept in the context, wc_HmacFinal() rewinds it to the inner pad for the next message.
+    ret = wc_HmacSetKey(&_ctx->hmac_sha256_ctx, WC_SHA256, key, key_len);
+    if (ret != 0) {
+        LT_LOG_ERROR("Failed to set HMAC key, ret=%d (%s)", ret, wc_GetErrorString(ret));
+        wc_HmacFree(&_ctx->hmac_sha256_ctx);
+        return LT_CRYPTO_ERR;
+    }
+    _ctx->hmac_sha256_key_set = true;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_compute(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output)
+{
+    lt_ctx_wolfcrypt_t *_ctx = (lt_ctx_wolfcrypt_t *)ctx;
+    int ret;
+
+    ret = wc_HmacUpdate(&_ctx->hmac_sha256_ctx, input, input_len);
+    if (ret != 0) {
+        LT_LOG_ERROR("HMAC update failed, ret=%d (%s)", ret, wc_GetErrorString(ret));
+        return LT_CRYPTO_ERR;
+    }
+
+    ret = wc_HmacFinal(&_ctx->hmac_sha256_ctx, output);
+    if (ret != 0) {
+        LT_LOG_ERROR("HMAC finalization failed, ret=%d (%s)", ret, wc_GetErrorString(ret));
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_hmac_sha256_deinit(void *ctx)
+{
+    lt_ctx_wolfcrypt_t *_ctx = (lt_ctx_wolfcrypt_t *)ctx;
+
+    if (_ctx->hmac_sha256_key_set) {
+        wc_HmacFree(&_ctx->hmac_sha256_ctx);
+        lt_secure_memzero(&_ctx->hmac_sha256_ctx, sizeof(_ctx->hmac_sha256_ctx));
+        _ctx->hmac_sha256_key_set = false;
+    }
+
+    return LT_OK;
+}
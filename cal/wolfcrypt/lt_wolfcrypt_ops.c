@@ -0,0 +1,24 @@
+/**
+ * @file lt_wolfcrypt_ops.c
+ * @brief WolfCrypt CAL built as one of the CALs selected at runtime (LT_CRYPTO_OPS), its functions are renamed to
+ * lt_wolfcrypt_* and collected in lt_crypto_ops_wolfcrypt.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#define LT_CRYPTO_OPS_BACKEND wolfcrypt
+#include "lt_crypto_ops_backend.h"
+
+#include "lt_wolfcrypt_common.c"
+#include "lt_wolfcrypt_aesgcm.c"
+#include "lt_wolfcrypt_sha256.c"
+#include "lt_wolfcrypt_hmac_sha256.c"
+#include "lt_wolfcrypt_x25519.c"
+#ifdef LT_ED25519_VERIFY
+#include "lt_wolfcrypt_ed25519.c"
+#endif
+
+#include "libtropic_wolfcrypt.h"
+
+LT_CRYPTO_OPS_DEFINE(lt_crypto_ops_wolfcrypt, "wolfcrypt");
@@ -99,6 +99,19 @@ lt_X25519_cleanup:
     return lt_ret;
 }
 
+#ifdef LT_X25519_FIXED_BASE
+// From ed25519-donna/ed25519.h of trezor_crypto, which can't be included together with WolfCrypt's curve25519.h
+// (both define curve25519_key).
+void curve25519_scalarmult_basepoint(unsigned char pk[32], const unsigned char e[32]);
+
+lt_ret_t lt_X25519_scalarmult(const uint8_t *sk, uint8_t *pk)
+{
+    // Fixed-base multiplication in Edwards form over precomputed multiples of the base point, the result is converted
+    // to Montgomery u. Several times faster than the generic Montgomery ladder.
+    curve25519_scalarmult_basepoint(pk, sk);
+    return LT_OK;
+}
+#else
 lt_ret_t lt_X25519_scalarmult(const uint8_t *sk, uint8_t *pk)
 {
     int ret;
@@ -164,4 +177,5 @@ lt_X25519_scalarmult_cleanup:
 #endif
     wc_curve25519_free(&wc_secret);
     return lt_ret;
-}
\ No newline at end of file
+}
+#endif
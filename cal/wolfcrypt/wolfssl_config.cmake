@@ -0,0 +1,34 @@
+# Configuration of wolfSSL for the WolfCrypt CAL, include() it before wolfSSL is added by add_subdirectory() or
+# FetchContent_MakeAvailable(), or pass it to cmake by -C. It enables the features required by the CAL and selects the
+# fastest AES-GCM of wolfSSL for the target processor. Options already set by the user are not changed.
+
+# GHASH implementation of wolfSSL's AES-GCM:
+#   4bit  - 4-bit table (256 B per key) - fastest portable implementation, default,
+#   table - 8-bit table (4 kB per key) - faster on cores with large caches, needs much more RAM,
+#   word  - 32-bit multiplication without tables, for cores without fast 64-bit arithmetic,
+#   small - bit by bit without tables - smallest and slowest, for devices short of flash.
+set(LT_WOLFCRYPT_AESGCM "4bit" CACHE STRING "GHASH implementation of wolfSSL's AES-GCM for the WolfCrypt CAL.")
+set_property(CACHE LT_WOLFCRYPT_AESGCM PROPERTY STRINGS "4bit" "table" "word" "small")
+
+# Enables wolfSSL asm for the processor: AES-NI with PCLMULQDQ on x86_64 and ARMv8 Cryptography Extensions on aarch64,
+# GHASH is then computed by carry-less multiplication instead of tables. Disable when the target lacks the extensions.
+option(LT_WOLFCRYPT_ASM "Uses wolfSSL asm of the target processor in the WolfCrypt CAL." ON)
+
+set(WOLFSSL_AESGCM ${LT_WOLFCRYPT_AESGCM} CACHE STRING "Enable wolfSSL AES-GCM support.")
+set(WOLFSSL_SHA256 ON CACHE BOOL "Enable wolfSSL SHA-256 support.")
+set(WOLFSSL_CURVE25519 ON CACHE BOOL "Enable wolfSSL Curve25519 support.")
+if(LT_ED25519_VERIFY)
+    set(WOLFSSL_ED25519 ON CACHE BOOL "Enable wolfSSL Ed25519 support.")
+endif()
+
+if(LT_WOLFCRYPT_ASM)
+    set(WOLFSSL_ASM "yes" CACHE STRING "Enable wolfSSL assembly code.")
+    if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+        set(WOLFSSL_AESNI "yes" CACHE STRING "Enable wolfSSL AES-NI support.")
+        set(WOLFSSL_INTELASM "yes" CACHE STRING "Enable wolfSSL Intel asm.")
+    elseif(CMAKE_SYSTEM_PROCESSOR MATCHES "^(aarch64|arm64|ARM64)$")
+        set(WOLFSSL_ARMASM "yes" CACHE STRING "Enable wolfSSL ARMv8 asm.")
+    endif()
+else()
+    set(WOLFSSL_ASM "no" CACHE STRING "Enable wolfSSL assembly code.")
+endif()
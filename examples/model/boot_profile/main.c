@@ -0,0 +1,238 @@
+/**
+ * @file main.c
+ * @brief Boot profile example: time to the first signature with the model, cold and with caches from a previous run.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <arpa/inet.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_mbedtls_v4.h"
+#include "libtropic_port_posix_tcp.h"
+#include "psa/crypto.h"
+
+// Pairing keys the model was configured with, defaults to prod0 keys.
+// Provide your own keys here if you configured the model differently.
+#define DEFAULT_SH0_PRIV sh0priv_prod0
+#define DEFAULT_SH0_PUB sh0pub_prod0
+
+/** @brief File the caches are persisted in between the runs of the example. */
+#define BOOT_CACHE_FILE "boot_cache.bin"
+
+/** @brief ECC key slot signing the first message, the key is generated if the slot is empty. */
+#define BOOT_ECC_SLOT TR01_ECC_SLOT_0
+
+/**
+ * @brief Caches persisted between the runs, in production they would be kept in flash.
+ * @details Both caches hold public data only and are checked by libtropic when used, so a stale or corrupted file
+ * only makes the boot cold again.
+ */
+typedef struct boot_cache_t {
+    lt_tr01_attrs_cache_t attrs;
+    lt_cert_cache_t certs;
+} boot_cache_t;
+
+/** @brief Time of one phase of the boot, split by the trace hooks. */
+typedef struct boot_phase_t {
+    uint64_t us;
+    uint64_t spi_us;
+    uint64_t wait_us;
+    uint64_t aes_us;
+} boot_phase_t;
+
+static boot_cache_t cache;
+static boot_phase_t phase;
+static uint64_t trace_start[LT_TRACE_CAL_DECRYPT + 1];
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static void on_trace_start(void *ctx, lt_trace_phase_t trace_phase, uint64_t time_us)
+{
+    (void)ctx;
+    trace_start[trace_phase] = time_us;
+}
+
+// Only phases which do not nest other phases are summed.
+static void on_trace_end(void *ctx, lt_trace_phase_t trace_phase, uint64_t time_us)
+{
+    (void)ctx;
+    uint64_t us = time_us - trace_start[trace_phase];
+
+    if (trace_phase == LT_TRACE_L1_SPI) {
+        phase.spi_us += us;
+    }
+    else if (trace_phase == LT_TRACE_L1_WAIT) {
+        phase.wait_us += us;
+    }
+    else if ((trace_phase == LT_TRACE_CAL_ENCRYPT) || (trace_phase == LT_TRACE_CAL_DECRYPT)) {
+        phase.aes_us += us;
+    }
+}
+
+static const lt_trace_hooks_t trace_hooks = {.start = on_trace_start, .end = on_trace_end, .ctx = NULL};
+
+static uint64_t phase_start(void)
+{
+    memset(&phase, 0, sizeof(phase));
+    return now_us();
+}
+
+static uint64_t phase_print(const char *name, const uint64_t t0)
+{
+    phase.us = now_us() - t0;
+    uint64_t traced_us = phase.spi_us + phase.wait_us + phase.aes_us;
+    printf("\t%-50s %8" PRIu64 " us (SPI %" PRIu64 " us, waiting %" PRIu64 " us, AES-GCM %" PRIu64
+           " us, host %" PRIu64 " us)\n",
+           name, phase.us, phase.spi_us, phase.wait_us, phase.aes_us,
+           (phase.us > traced_us) ? phase.us - traced_us : 0);
+
+    return phase.us;
+}
+
+static bool cache_load(void)
+{
+    FILE *f = fopen(BOOT_CACHE_FILE, "rb");
+    if (!f) {
+        return false;
+    }
+    bool ok = (fread(&cache, sizeof(cache), 1, f) == 1);
+    fclose(f);
+
+    return ok && lt_tr01_attrs_cache_valid(&cache.attrs) && lt_cert_cache_valid(&cache.certs);
+}
+
+static void cache_save(void)
+{
+    FILE *f = fopen(BOOT_CACHE_FILE, "wb");
+    if (!f || (fwrite(&cache, sizeof(cache), 1, f) != 1)) {
+        fprintf(stderr, "Failed to write %s\n", BOOT_CACHE_FILE);
+    }
+    if (f) {
+        fclose(f);
+    }
+}
+
+int main(void)
+{
+    // Cosmetics: Disable buffering to keep output in order. You do not need to do this in your app if you don't care
+    // about stdout/stderr output being shuffled or you use stdout only (or different output mechanism altogether).
+    setvbuf(stdout, NULL, _IONBF, 0);
+    setvbuf(stderr, NULL, _IONBF, 0);
+
+    printf("=======================================\n");
+    printf("==== TROPIC01 Boot Profile Example ====\n");
+    printf("=======================================\n");
+
+    // Cryptographic function provider initialization.
+    psa_status_t status = psa_crypto_init();
+    if (status != PSA_SUCCESS) {
+        fprintf(stderr, "PSA Crypto initialization failed, status=%d (psa_status_t)\n", status);
+        return -1;
+    }
+
+    lt_handle_t lt_handle = {0};
+    lt_dev_posix_tcp_t device = {0};
+    device.addr = inet_addr("127.0.0.1");
+    device.port = 28992;
+    lt_handle.l2.device = &device;
+    lt_ctx_mbedtls_v4_t crypto_ctx;
+    lt_handle.l3.crypto_ctx = &crypto_ctx;
+
+    // Hooks stay set across lt_init() and lt_deinit(), so the initialization is split too.
+    lt_set_trace_hooks(&lt_handle, &trace_hooks);
+
+    const bool warm = cache_load();
+    if (!warm) {
+        // lt_init_warm() and lt_verify_chip_and_start_secure_session_cached() do the cold boot with invalid caches.
+        memset(&cache, 0, sizeof(cache));
+    }
+    printf("Booting %s...\n", warm ? "with the caches of the previous run" : "cold, " BOOT_CACHE_FILE " not found");
+
+    uint64_t total_us = 0;
+    uint64_t t0 = phase_start();
+    lt_ret_t ret = lt_init_warm(&lt_handle, &cache.attrs);
+    total_us += phase_print(warm ? "lt_init_warm()" : "lt_init_warm() without cache, i.e. lt_init()", t0);
+    if (LT_OK != ret) {
+        fprintf(stderr, "Failed to initialize handle, ret=%s\n", lt_ret_verbose(ret));
+        mbedtls_psa_crypto_free();
+        return -1;
+    }
+
+    // Only CHIP_ID is read on a warm boot, the cold one reads and parses the whole certificate store.
+    bool refreshed = false;
+    t0 = phase_start();
+    ret = lt_verify_chip_and_start_secure_session_cached(&lt_handle, &cache.certs, DEFAULT_SH0_PRIV, DEFAULT_SH0_PUB,
+                                                         TR01_PAIRING_KEY_SLOT_INDEX_0, &refreshed);
+    total_us += phase_print("lt_verify_chip_and_start_secure_session_cached()", t0);
+    if (LT_OK != ret) {
+        fprintf(stderr, "Failed to start Secure Session with key %d, ret=%s\n", (int)TR01_PAIRING_KEY_SLOT_INDEX_0,
+                lt_ret_verbose(ret));
+        lt_deinit(&lt_handle);
+        mbedtls_psa_crypto_free();
+        return -1;
+    }
+
+    const uint8_t msg[32] = {0};
+    uint8_t rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+    t0 = phase_start();
+    ret = lt_ecc_ecdsa_sign(&lt_handle, BOOT_ECC_SLOT, msg, sizeof(msg), rs);
+    if (LT_L3_INVALID_KEY == ret) {
+        // The slot is empty on the first run, provisioning of the key is not a part of the boot.
+        ret = lt_ecc_key_generate(&lt_handle, BOOT_ECC_SLOT, TR01_CURVE_P256);
+        if (LT_OK == ret) {
+            t0 = phase_start();
+            ret = lt_ecc_ecdsa_sign(&lt_handle, BOOT_ECC_SLOT, msg, sizeof(msg), rs);
+        }
+    }
+    total_us += phase_print("lt_ecc_ecdsa_sign()", t0);
+    if (LT_OK != ret) {
+        fprintf(stderr, "Failed to sign, ret=%s\n", lt_ret_verbose(ret));
+        lt_session_abort(&lt_handle);
+        lt_deinit(&lt_handle);
+        mbedtls_psa_crypto_free();
+        return -1;
+    }
+    printf("\t%-50s %8" PRIu64 " us\n", "Time to the first signature", total_us);
+
+    // The caches are persisted after the cold boot, or when the certificate cache was refilled (e.g. another chip).
+    if (!warm || refreshed) {
+        ret = lt_tr01_attrs_export(&lt_handle, &cache.attrs);
+        if (LT_OK != ret) {
+            fprintf(stderr, "Failed to export TROPIC01 attributes, ret=%s\n", lt_ret_verbose(ret));
+        }
+        else {
+            cache_save();
+            printf("Caches saved to %s, run the example again to boot with them.\n", BOOT_CACHE_FILE);
+        }
+    }
+
+    lt_set_trace_hooks(&lt_handle, NULL);
+    ret = lt_session_abort(&lt_handle);
+    if (LT_OK != ret) {
+        fprintf(stderr, "Failed to abort Secure Session, ret=%s\n", lt_ret_verbose(ret));
+    }
+    ret = lt_deinit(&lt_handle);
+    if (LT_OK != ret) {
+        fprintf(stderr, "Failed to deinitialize handle, ret=%s\n", lt_ret_verbose(ret));
+        mbedtls_psa_crypto_free();
+        return -1;
+    }
+
+    mbedtls_psa_crypto_free();
+
+    return 0;
+}
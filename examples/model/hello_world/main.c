@@ -7,7 +7,6 @@
  */
 
 #include <arpa/inet.h>
-#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -59,21 +58,12 @@ int main(void)
     lt_handle_t lt_handle = {0};
 
     // Initialize device before handing handle to the test.
-    lt_dev_posix_tcp_t device;
+    lt_dev_posix_tcp_t device = {0};
     device.addr = inet_addr("127.0.0.1");
     device.port = 28992;
     lt_handle.l2.device = &device;
 
-    // Generate seed for the PRNG and seed it.
-    // Note: model uses rand(), which is not cryptographically secure. Better alternative should be used in production.
-    unsigned int prng_seed;
-    if (0 != getentropy(&prng_seed, sizeof(prng_seed))) {
-        fprintf(stderr, "main: getentropy() failed (%s)!\n", strerror(errno));
-        mbedtls_psa_crypto_free();
-        return -1;
-    }
-    srand(prng_seed);
-    printf("PRNG initialized with seed=%u\n", prng_seed);
+    // Host random bytes are generated by the TCP port from getentropy() (see libtropic_posix_rng.h).
 
     // Crypto abstraction layer (CAL) context.
     lt_ctx_mbedtls_v4_t crypto_ctx;
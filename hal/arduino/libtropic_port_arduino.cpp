@@ -16,6 +16,38 @@
 
 #include "libtropic_port.h"
 
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#if LT_USE_INT_PIN
+// Interrupt handlers wake the waiting lt_port_delay_on_int() on the rising edge of the INT pin.
+#if defined(ARDUINO_ARCH_ESP32)
+static void IRAM_ATTR arduino_int_isr(void *arg)
+{
+    lt_dev_arduino_t *device = (lt_dev_arduino_t *)arg;
+    BaseType_t woken = pdFALSE;
+
+    xSemaphoreGiveFromISR(device->int_sem, &woken);
+    if (woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+#else
+// attachInterrupt() passes no argument, so one device at a time waits on the interrupt; others poll the pin.
+static lt_dev_arduino_t *volatile arduino_int_device = NULL;
+
+static void IRAM_ATTR arduino_int_isr(void)
+{
+    lt_dev_arduino_t *device = arduino_int_device;
+
+    if (device != NULL) {
+        device->int_fired = true;
+    }
+}
+#endif
+#endif
+
 lt_ret_t lt_port_init(lt_l2_state_t *s2)
 {
     lt_dev_arduino_t *device = (lt_dev_arduino_t *)(s2->device);
@@ -23,10 +55,25 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
     // Setup SPI
     pinMode(device->spi_cs_pin, OUTPUT);
     digitalWrite(device->spi_cs_pin, HIGH);
+    device->spi_txn_open = false;
 
     // Setup interrupt pin
 #if LT_USE_INT_PIN
     pinMode(device->int_gpio_pin, INPUT);
+#if defined(ARDUINO_ARCH_ESP32)
+    device->int_sem = xSemaphoreCreateBinary();
+    if (device->int_sem == NULL) {
+        return LT_FAIL;
+    }
+    attachInterruptArg(digitalPinToInterrupt(device->int_gpio_pin), arduino_int_isr, device, RISING);
+#else
+    device->int_fired = false;
+    device->int_attached = (arduino_int_device == NULL);
+    if (device->int_attached) {
+        arduino_int_device = device;
+        attachInterrupt(digitalPinToInterrupt(device->int_gpio_pin), arduino_int_isr, RISING);
+    }
+#endif
 #endif
 
     return LT_OK;
@@ -37,6 +84,26 @@ lt_ret_t lt_port_deinit(lt_l2_state_t *s2)
     lt_dev_arduino_t *device = (lt_dev_arduino_t *)(s2->device);
 
     digitalWrite(device->spi_cs_pin, HIGH);
+    if (device->spi_txn_open) {
+        device->spi->endTransaction();
+        device->spi_txn_open = false;
+    }
+
+#if LT_USE_INT_PIN
+#if defined(ARDUINO_ARCH_ESP32)
+    if (device->int_sem != NULL) {
+        detachInterrupt(digitalPinToInterrupt(device->int_gpio_pin));
+        vSemaphoreDelete(device->int_sem);
+        device->int_sem = NULL;
+    }
+#else
+    if (device->int_attached) {
+        detachInterrupt(digitalPinToInterrupt(device->int_gpio_pin));
+        arduino_int_device = NULL;
+        device->int_attached = false;
+    }
+#endif
+#endif
 
     return LT_OK;
 }
@@ -45,6 +112,11 @@ lt_ret_t lt_port_spi_csn_low(lt_l2_state_t *s2)
 {
     lt_dev_arduino_t *device = (lt_dev_arduino_t *)(s2->device);
 
+    // The frame owns the bus and its settings until chip select goes high.
+    if (device->spi_frame_txn && !device->spi_txn_open) {
+        device->spi->beginTransaction(device->spi_settings);
+        device->spi_txn_open = true;
+    }
     digitalWrite(device->spi_cs_pin, LOW);
 
     return LT_OK;
@@ -55,6 +127,10 @@ lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2)
     lt_dev_arduino_t *device = (lt_dev_arduino_t *)(s2->device);
 
     digitalWrite(device->spi_cs_pin, HIGH);
+    if (device->spi_txn_open) {
+        device->spi->endTransaction();
+        device->spi_txn_open = false;
+    }
 
     return LT_OK;
 }
@@ -64,6 +140,12 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len
     LT_UNUSED(timeout_ms);
     lt_dev_arduino_t *device = (lt_dev_arduino_t *)(s2->device);
 
+    // Buffer transfer, done by FIFO or DMA on cores which implement it so (ESP32, RP2040, SAMD).
+    if (device->spi_txn_open) {
+        device->spi->transfer(s2->buff + offset, tx_len);
+        return LT_OK;
+    }
+
     device->spi->beginTransaction(device->spi_settings);
     device->spi->transfer(s2->buff + offset, tx_len);
     device->spi->endTransaction();
@@ -71,6 +153,18 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len
     return LT_OK;
 }
 
+#ifdef LT_PORT_SPI_SET_SPEED
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    lt_dev_arduino_t *device = (lt_dev_arduino_t *)(s2->device);
+
+    // Settings are applied by the next beginTransaction(), TROPIC01 supports only mode 0.
+    device->spi_settings = SPISettings(hz, MSBFIRST, SPI_MODE0);
+
+    return LT_OK;
+}
+#endif
+
 lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
 {
     LT_UNUSED(s2);
@@ -81,22 +175,53 @@ lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
 }
 
 #if LT_USE_INT_PIN
+#if defined(ARDUINO_ARCH_ESP32)
+lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
+{
+    lt_dev_arduino_t *device = (lt_dev_arduino_t *)(s2->device);
+
+    // Drop an edge left from before, the pin is read after that so a new edge cannot be missed.
+    xSemaphoreTake(device->int_sem, 0);
+    if (digitalRead(device->int_gpio_pin)) {
+        return LT_OK;
+    }
+
+    // Task blocks and other tasks run until the interrupt handler gives the semaphore.
+    if (xSemaphoreTake(device->int_sem, pdMS_TO_TICKS(ms)) == pdTRUE) {
+        return LT_OK;
+    }
+
+    return LT_L1_INT_TIMEOUT;
+}
+#else
 lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
 {
     lt_dev_arduino_t *device = (lt_dev_arduino_t *)(s2->device);
     unsigned long start_time = millis();
-    unsigned long curr_time;
 
-    while (!digitalRead(device->int_gpio_pin)) {
-        curr_time = millis();
-        if (curr_time - start_time > (unsigned long)ms) {
+    // Clear the flag first, the pin is read after that so a new edge cannot be missed.
+    device->int_fired = false;
+    if (digitalRead(device->int_gpio_pin)) {
+        return LT_OK;
+    }
+
+    // Without the interrupt handler (another device owns it), the pin is read instead of the flag.
+    while (device->int_attached ? !device->int_fired : !digitalRead(device->int_gpio_pin)) {
+        if (millis() - start_time > (unsigned long)ms) {
             return LT_L1_INT_TIMEOUT;
         }
+        if (device->idle_hook != NULL) {
+            device->idle_hook();
+        }
+        else {
+            yield();
+        }
     }
 
     return LT_OK;
 }
 #endif
+#endif
 
 lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
 {
@@ -25,11 +25,38 @@ typedef struct lt_dev_arduino_t {
 #if LT_USE_INT_PIN
     /** @public @brief Pin to which TROPIC01's GPO or interrupt pin is connected to. */
     uint16_t int_gpio_pin;
+    /**
+     * @public @brief Called while waiting for the interrupt (NULL = yield()).
+     *
+     * E.g. a function entering a sleep mode lets the MCU sleep until the interrupt. Not used on ESP32,
+     * where the waiting task blocks on a semaphore.
+     */
+    void (*idle_hook)(void);
 #endif
     /** @public @brief SPI settings. */
     SPISettings spi_settings;
     /** @public @brief Pointer to the SPI class. */
     SPIClass *spi;
+    /**
+     * @public @brief Keep one SPI transaction open from chip select low to chip select high.
+     *
+     * @note beginTransaction() and endTransaction() then run once per L1 frame instead of around every
+     *       transfer, and the SPI bus stays owned by the frame while chip select is low.
+     */
+    bool spi_frame_txn;
+    /** @private @brief SPI transaction opened by lt_port_spi_csn_low() is open. */
+    bool spi_txn_open;
+#if LT_USE_INT_PIN
+#if defined(ARDUINO_ARCH_ESP32)
+    /** @private @brief Given by the interrupt handler, created by lt_port_init(). */
+    SemaphoreHandle_t int_sem;
+#else
+    /** @private @brief Set by the interrupt handler. */
+    volatile bool int_fired;
+    /** @private @brief The interrupt handler of the port is attached to int_gpio_pin for this device. */
+    bool int_attached;
+#endif
+#endif
 } lt_dev_arduino_t;
 
 #endif  // LIBTROPIC_PORT_ARDUINO_H
\ No newline at end of file
@@ -0,0 +1,903 @@
+/**
+ * @file libtropic_port_emulator.c
+ * @brief Port emulating TROPIC01 in the process of the application, used to test and benchmark without TROPIC01.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_port_emulator.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "aes/aesgcm.h"
+#include "bignum.h"
+#include "ecdsa.h"
+#include "ed25519-donna/ed25519.h"
+#include "hmac.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port.h"
+#include "libtropic_posix_rng.h"
+#include "lt_asn1_der.h"
+#include "lt_crc16.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "memzero.h"
+#include "nist256p1.h"
+#include "sha2.h"
+
+/** CHIP_STATUS of TROPIC01 in Application Mode, ready for the next L2 Request. */
+#define EMULATOR_CHIP_STATUS TR01_L1_CHIP_MODE_READY_bit
+
+/** Version of RISC-V FW reported by Get_Info, 2.0.0 (its R-mem slots have LT_EMULATOR_R_MEM_SLOT_SIZE bytes). */
+static const uint8_t emulator_riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE] = {0x00, 0x00, 0x00, 0x02};
+
+/** Version of SPECT FW reported by Get_Info, 1.0.0. */
+static const uint8_t emulator_spect_fw_ver[TR01_L2_GET_INFO_SPECT_FW_SIZE] = {0x00, 0x00, 0x00, 0x01};
+
+/** Number of certificates in the header of the certificate store. */
+#define EMULATOR_CERT_STORE_NUM_CERTS 4
+/** Length of the header of the certificate store: version, number of certificates and their lengths. */
+#define EMULATOR_CERT_STORE_HDR_LEN (2 + 2 * EMULATOR_CERT_STORE_NUM_CERTS)
+
+/**
+ * Device "certificate": SubjectPublicKeyInfo with the X25519 OID (LT_OBJ_ID_CURVEX25519) and STPUB in a BIT STRING,
+ * which is all libtropic looks for in it. STPUB follows the prefix.
+ */
+static const uint8_t emulator_cert_prefix[]
+    = {0x30, 0x2A, 0x30, 0x05, 0x06, 0x03, 0x2B, 0x65, 0x6E, 0x03, 0x21, 0x00};
+#define EMULATOR_CERT_LEN (sizeof(emulator_cert_prefix) + TR01_STPUB_LEN)
+
+/** Offset of the data of L3 Commands and L3 Results padded to 16 bytes (ECC keys, signatures). */
+#define EMULATOR_L3_PADDED_OFFSET 16
+/** Offset of the data of R_Mem_Data_Write, R_Mem_Data_Read and Random_Value_Get results. */
+#define EMULATOR_L3_DATA_OFFSET 4
+
+/** Noise_KK1_25519_AESGCM_SHA256\x00\x00\x00 */
+static const uint8_t emulator_protocol_name[32]
+    = {'N', 'o', 'i', 's', 'e', '_', 'K', 'K', '1', '_', '2', '5', '5', '1',  '9',  '_',
+       'A', 'E', 'S', 'G', 'C', 'M', '_', 'S', 'H', 'A', '2', '5', '6', 0x00, 0x00, 0x00};
+
+/** Next 64 bits of the PRNG of TROPIC01 (SplitMix64). */
+static uint64_t emulator_prng_next(lt_dev_emulator_t *dev)
+{
+    uint64_t z = (dev->prng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+    return z ^ (z >> 31);
+}
+
+static void emulator_random(lt_dev_emulator_t *dev, uint8_t *buff, const size_t len)
+{
+    for (size_t i = 0; i < len; i += sizeof(uint64_t)) {
+        uint64_t r = emulator_prng_next(dev);
+        size_t n = (len - i < sizeof(r)) ? len - i : sizeof(r);
+        memcpy(buff + i, &r, n);
+    }
+}
+
+lt_ret_t lt_emulator_hal_reset(lt_dev_emulator_t *dev)
+{
+    if (!dev) {
+        return LT_PARAM_ERR;
+    }
+
+    uint64_t seed = dev->seed;
+    memzero(dev, sizeof(*dev));
+    dev->seed = seed;
+    dev->prng = seed;
+
+    emulator_random(dev, dev->stpriv, sizeof(dev->stpriv));
+    curve25519_scalarmult_basepoint(dev->stpub, dev->stpriv);
+    dev->powered = true;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_emulator_hal_set_pairing_key(lt_dev_emulator_t *dev, const uint8_t slot, const uint8_t *shipub)
+{
+    if (!dev || (slot >= LT_EMULATOR_PAIRING_KEY_SLOTS) || !shipub) {
+        return LT_PARAM_ERR;
+    }
+
+    if (!dev->powered) {
+        lt_ret_t ret = lt_emulator_hal_reset(dev);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+    memcpy(dev->shipub[slot], shipub, TR01_SHIPUB_LEN);
+    dev->shipub_valid[slot] = true;
+
+    return LT_OK;
+}
+
+/** Prepares L2 Response frame for GET_RESPONSE. */
+static void emulator_respond(lt_dev_emulator_t *dev, const uint8_t status, const uint8_t *data, const uint16_t len)
+{
+    dev->rsp[0] = status;
+    dev->rsp[1] = (uint8_t)len;
+    if (len) {
+        memcpy(dev->rsp + TR01_L2_STATUS_SIZE + TR01_L2_REQ_RSP_LEN_SIZE, data, len);
+    }
+    uint16_t crc = crc16(dev->rsp, (int16_t)(len + 2));
+    dev->rsp[len + 2] = crc >> 8;
+    dev->rsp[len + 3] = crc & 0x00FF;
+    dev->rsp_len = len + 4;
+}
+
+/** Prepares the next Encrypted_Cmd_Rsp chunk of the L3 Result, if any is left. */
+static void emulator_respond_res_chunk(lt_dev_emulator_t *dev)
+{
+    uint16_t left = dev->l3_res_len - dev->l3_res_sent;
+    if (!left) {
+        return;
+    }
+
+    uint16_t len = (left > TR01_L2_CHUNK_MAX_DATA_SIZE) ? TR01_L2_CHUNK_MAX_DATA_SIZE : left;
+    uint8_t status = (len < left) ? TR01_L2_STATUS_RESULT_CONT : TR01_L2_STATUS_RESULT_OK;
+    emulator_respond(dev, status, dev->l3_res + dev->l3_res_sent, len);
+    dev->l3_res_sent += len;
+}
+
+static void emulator_session_end(lt_dev_emulator_t *dev)
+{
+    if (dev->session) {
+        gcm_end(&dev->cmd_ctx);
+        gcm_end(&dev->res_ctx);
+    }
+    dev->session = false;
+    dev->l3_cmd_len = 0;
+    dev->l3_res_len = 0;
+    dev->l3_res_sent = 0;
+}
+
+/** HKDF of the handshake: two 32-byte outputs keyed by the chaining key. */
+static void emulator_hkdf(const uint8_t *ck, const uint8_t *input, const uint32_t input_len, uint8_t *output_1,
+                          uint8_t *output_2)
+{
+    uint8_t tmp[SHA256_DIGEST_LENGTH];
+    uint8_t helper[SHA256_DIGEST_LENGTH + 1];
+    const uint8_t one = 0x01;
+
+    hmac_sha256(ck, SHA256_DIGEST_LENGTH, input, input_len, tmp);
+    hmac_sha256(tmp, sizeof(tmp), &one, 1, helper);
+    helper[SHA256_DIGEST_LENGTH] = 0x02;
+    memcpy(output_1, helper, SHA256_DIGEST_LENGTH);
+    hmac_sha256(tmp, sizeof(tmp), helper, sizeof(helper), output_2);
+
+    memzero(tmp, sizeof(tmp));
+    memzero(helper, sizeof(helper));
+}
+
+/** h = SHA256(h||data) */
+static void emulator_transcript_update(uint8_t *hash, const uint8_t *data, const size_t len)
+{
+    SHA256_CTX ctx;
+
+    sha256_Init(&ctx);
+    sha256_Update(&ctx, hash, SHA256_DIGEST_LENGTH);
+    sha256_Update(&ctx, data, len);
+    sha256_Final(&ctx, hash);
+}
+
+/** Responder of the Noise KK1 handshake. */
+static void emulator_handshake(lt_dev_emulator_t *dev, const uint8_t *ehpub, const uint8_t pkey_index)
+{
+    emulator_session_end(dev);
+    if ((pkey_index >= LT_EMULATOR_PAIRING_KEY_SLOTS) || !dev->shipub_valid[pkey_index]) {
+        emulator_respond(dev, TR01_L2_STATUS_HSK_ERR, NULL, 0);
+        return;
+    }
+
+    uint8_t etpriv[TR01_X25519_KEY_LEN];
+    uint8_t rsp[TR01_L2_HANDSHAKE_RSP_LEN];
+    uint8_t *etpub = rsp;
+    uint8_t *tauth = rsp + TR01_X25519_KEY_LEN;
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    uint8_t ck[SHA256_DIGEST_LENGTH];
+    uint8_t kauth[TR01_AES256_KEY_LEN];
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    uint8_t shared[TR01_X25519_KEY_LEN];
+    uint8_t iv[TR01_L3_IV_SIZE] = {0};
+    uint8_t empty = 0;
+    gcm_ctx auth_ctx;
+
+    emulator_random(dev, etpriv, sizeof(etpriv));
+    curve25519_scalarmult_basepoint(etpub, etpriv);
+
+    // h = SHA256(SHA256(SHA256(SHA256(SHA256(SHA256(protocol_name)||SHiPUB)||STPUB)||EHPUB)||PKEY_INDEX)||ETPUB)
+    sha256_Raw(emulator_protocol_name, sizeof(emulator_protocol_name), hash);
+    emulator_transcript_update(hash, dev->shipub[pkey_index], TR01_SHIPUB_LEN);
+    emulator_transcript_update(hash, dev->stpub, TR01_STPUB_LEN);
+    emulator_transcript_update(hash, ehpub, TR01_X25519_KEY_LEN);
+    emulator_transcript_update(hash, &pkey_index, 1);
+    emulator_transcript_update(hash, etpub, TR01_X25519_KEY_LEN);
+
+    // ck = HKDF(protocol_name, X25519(ETPRIV, EHPUB))
+    curve25519_scalarmult(shared, etpriv, ehpub);
+    emulator_hkdf(emulator_protocol_name, shared, sizeof(shared), ck, kauth);
+    // ck = HKDF(ck, X25519(ETPRIV, SHiPUB))
+    curve25519_scalarmult(shared, etpriv, dev->shipub[pkey_index]);
+    emulator_hkdf(ck, shared, sizeof(shared), ck, kauth);
+    // ck, kAUTH = HKDF(ck, X25519(STPRIV, EHPUB))
+    curve25519_scalarmult(shared, dev->stpriv, ehpub);
+    emulator_hkdf(ck, shared, sizeof(shared), ck, kauth);
+    // kCMD, kRES = HKDF(ck, emptystring)
+    emulator_hkdf(ck, &empty, 0, kcmd, kres);
+
+    // T_TAUTH = AES-GCM(kAUTH, nonce 0, h, emptystring)
+    int err = (gcm_init_and_key(kauth, sizeof(kauth), &auth_ctx) != RETURN_GOOD);
+    err |= (gcm_encrypt_message(iv, sizeof(iv), hash, sizeof(hash), &empty, 0, tauth, TR01_L3_TAG_SIZE, &auth_ctx)
+            != RETURN_GOOD);
+    gcm_end(&auth_ctx);
+    err |= (gcm_init_and_key(kcmd, sizeof(kcmd), &dev->cmd_ctx) != RETURN_GOOD);
+    err |= (gcm_init_and_key(kres, sizeof(kres), &dev->res_ctx) != RETURN_GOOD);
+
+    if (err) {
+        gcm_end(&dev->cmd_ctx);
+        gcm_end(&dev->res_ctx);
+        emulator_respond(dev, TR01_L2_STATUS_HSK_ERR, NULL, 0);
+    }
+    else {
+        dev->session = true;
+        dev->nonce = 0;
+        emulator_respond(dev, TR01_L2_STATUS_REQUEST_OK, rsp, sizeof(rsp));
+    }
+
+    memzero(etpriv, sizeof(etpriv));
+    memzero(ck, sizeof(ck));
+    memzero(kauth, sizeof(kauth));
+    memzero(kcmd, sizeof(kcmd));
+    memzero(kres, sizeof(kres));
+    memzero(shared, sizeof(shared));
+}
+
+/** Answers Get_Info_Req. */
+static void emulator_get_info(lt_dev_emulator_t *dev, const uint8_t object_id, const uint8_t block_index)
+{
+    uint8_t block[TR01_GET_INFO_BLOCK_LEN] = {0};
+
+    switch (object_id) {
+        case TR01_L2_GET_INFO_REQ_OBJECT_ID_X509_CERTIFICATE: {
+            if (block_index >= TR01_L2_GET_INFO_REQ_CERT_SIZE_TOTAL / TR01_GET_INFO_BLOCK_LEN) {
+                break;
+            }
+            // Only the first block holds anything: the header and the device certificate, the rest is zeros.
+            if (block_index == 0) {
+                block[0] = LT_CERT_STORE_VERSION;
+                block[1] = EMULATOR_CERT_STORE_NUM_CERTS;
+                block[2] = (uint8_t)(EMULATOR_CERT_LEN >> 8);
+                block[3] = (uint8_t)EMULATOR_CERT_LEN;
+                memcpy(block + EMULATOR_CERT_STORE_HDR_LEN, emulator_cert_prefix, sizeof(emulator_cert_prefix));
+                memcpy(block + EMULATOR_CERT_STORE_HDR_LEN + sizeof(emulator_cert_prefix), dev->stpub,
+                       TR01_STPUB_LEN);
+            }
+            emulator_respond(dev, TR01_L2_STATUS_REQUEST_OK, block, sizeof(block));
+            return;
+        }
+        case TR01_L2_GET_INFO_REQ_OBJECT_ID_CHIP_ID:
+            emulator_respond(dev, TR01_L2_STATUS_REQUEST_OK, block, TR01_L2_GET_INFO_CHIP_ID_SIZE);
+            return;
+        case TR01_L2_GET_INFO_REQ_OBJECT_ID_RISCV_FW_VERSION:
+            emulator_respond(dev, TR01_L2_STATUS_REQUEST_OK, emulator_riscv_fw_ver, sizeof(emulator_riscv_fw_ver));
+            return;
+        case TR01_L2_GET_INFO_REQ_OBJECT_ID_SPECT_FW_VERSION:
+            emulator_respond(dev, TR01_L2_STATUS_REQUEST_OK, emulator_spect_fw_ver, sizeof(emulator_spect_fw_ver));
+            return;
+        default:
+            break;
+    }
+
+    emulator_respond(dev, TR01_L2_STATUS_GEN_ERR, NULL, 0);
+}
+
+/** Reads little-endian slot number of L3 Command. */
+static uint16_t emulator_l3_slot(const uint8_t *cmd) { return (uint16_t)(cmd[1] | (cmd[2] << 8)); }
+
+/** Executes ECC_Key_Generate or ECC_Key_Store, k is NULL for ECC_Key_Generate. */
+static uint8_t emulator_ecc_key_set(lt_dev_emulator_t *dev, const uint16_t slot, const uint8_t curve,
+                                    const uint8_t *k)
+{
+    if ((slot >= LT_EMULATOR_ECC_SLOTS) || dev->ecc[slot].curve
+        || ((curve != TR01_CURVE_P256) && (curve != TR01_CURVE_ED25519))) {
+        return TR01_L3_RESULT_FAIL;
+    }
+
+    lt_emulator_ecc_slot_t *key = &dev->ecc[slot];
+
+    if (curve == TR01_CURVE_P256) {
+        uint8_t pub65[65];
+        bignum256 d;
+        for (;;) {
+            if (k) {
+                memcpy(key->priv, k, sizeof(key->priv));
+            }
+            else {
+                emulator_random(dev, key->priv, sizeof(key->priv));
+            }
+            bn_read_be(key->priv, &d);
+            if (!bn_is_zero(&d) && bn_is_less(&d, &nist256p1.order)) {
+                break;
+            }
+            if (k) {
+                memzero(key->priv, sizeof(key->priv));
+                return TR01_L3_RESULT_FAIL;
+            }
+        }
+        memzero(&d, sizeof(d));
+        if (ecdsa_get_public_key65(&nist256p1, key->priv, pub65) != 0) {
+            memzero(key->priv, sizeof(key->priv));
+            return TR01_L3_RESULT_FAIL;
+        }
+        memcpy(key->pub, pub65 + 1, TR01_CURVE_P256_PUBKEY_LEN);
+    }
+    else {
+        if (k) {
+            memcpy(key->priv, k, sizeof(key->priv));
+        }
+        else {
+            emulator_random(dev, key->priv, sizeof(key->priv));
+        }
+        ed25519_publickey(key->priv, key->pub);
+    }
+    key->curve = curve;
+    key->origin = k ? TR01_CURVE_STORED : TR01_CURVE_GENERATED;
+
+    return TR01_L3_RESULT_OK;
+}
+
+/**
+ * Executes decrypted L3 Command, result is written to res (without L3 size).
+ *
+ * @return Length of the result
+ */
+static uint16_t emulator_l3_execute(lt_dev_emulator_t *dev, const uint8_t *cmd, const uint16_t cmd_len, uint8_t *res)
+{
+    memset(res, 0, EMULATOR_L3_PADDED_OFFSET);
+    res[0] = TR01_L3_RESULT_FAIL;
+
+    switch (cmd[0]) {
+        case TR01_L3_PING_CMD_ID:
+            res[0] = TR01_L3_RESULT_OK;
+            memcpy(res + TR01_L3_RESULT_SIZE, cmd + 1, cmd_len - 1);
+            return cmd_len;
+
+        case TR01_L3_R_MEM_DATA_WRITE_CMD_ID: {
+            if (cmd_len <= EMULATOR_L3_DATA_OFFSET) {
+                return TR01_L3_RESULT_SIZE;
+            }
+            uint16_t slot = emulator_l3_slot(cmd);
+            uint16_t len = cmd_len - EMULATOR_L3_DATA_OFFSET;
+            if ((slot > TR01_R_MEM_DATA_SLOT_MAX) || (len > LT_EMULATOR_R_MEM_SLOT_SIZE)) {
+                return TR01_L3_RESULT_SIZE;
+            }
+            if (dev->r_mem[slot].len) {
+                res[0] = TR01_L3_RESULT_SLOT_NOT_EMPTY;
+                return TR01_L3_RESULT_SIZE;
+            }
+            memcpy(dev->r_mem[slot].data, cmd + EMULATOR_L3_DATA_OFFSET, len);
+            dev->r_mem[slot].len = len;
+            res[0] = TR01_L3_RESULT_OK;
+            return TR01_L3_RESULT_SIZE;
+        }
+
+        case TR01_L3_R_MEM_DATA_READ_CMD_ID: {
+            uint16_t slot = emulator_l3_slot(cmd);
+            if ((cmd_len < 3) || (slot > TR01_R_MEM_DATA_SLOT_MAX)) {
+                return TR01_L3_RESULT_SIZE;
+            }
+            // Empty slot is read as no data, as TROPIC01 does.
+            res[0] = TR01_L3_RESULT_OK;
+            memcpy(res + EMULATOR_L3_DATA_OFFSET, dev->r_mem[slot].data, dev->r_mem[slot].len);
+            return EMULATOR_L3_DATA_OFFSET + dev->r_mem[slot].len;
+        }
+
+        case TR01_L3_R_MEM_DATA_ERASE_CMD_ID: {
+            uint16_t slot = emulator_l3_slot(cmd);
+            if ((cmd_len < 3) || (slot > TR01_R_MEM_DATA_SLOT_MAX)) {
+                return TR01_L3_RESULT_SIZE;
+            }
+            memzero(&dev->r_mem[slot], sizeof(dev->r_mem[slot]));
+            res[0] = TR01_L3_RESULT_OK;
+            return TR01_L3_RESULT_SIZE;
+        }
+
+        case TR01_L3_RANDOM_VALUE_GET_CMD_ID: {
+            if (cmd_len < 2) {
+                return TR01_L3_RESULT_SIZE;
+            }
+            res[0] = TR01_L3_RESULT_OK;
+            emulator_random(dev, res + EMULATOR_L3_DATA_OFFSET, cmd[1]);
+            return EMULATOR_L3_DATA_OFFSET + cmd[1];
+        }
+
+        case TR01_L3_ECC_KEY_GENERATE_CMD_ID:
+            if (cmd_len >= 4) {
+                res[0] = emulator_ecc_key_set(dev, emulator_l3_slot(cmd), cmd[3], NULL);
+            }
+            return TR01_L3_RESULT_SIZE;
+
+        case TR01_L3_ECC_KEY_STORE_CMD_ID:
+            if (cmd_len >= EMULATOR_L3_PADDED_OFFSET + TR01_CURVE_PRIVKEY_LEN) {
+                res[0] = emulator_ecc_key_set(dev, emulator_l3_slot(cmd), cmd[3], cmd + EMULATOR_L3_PADDED_OFFSET);
+            }
+            return TR01_L3_RESULT_SIZE;
+
+        case TR01_L3_ECC_KEY_READ_CMD_ID: {
+            uint16_t slot = emulator_l3_slot(cmd);
+            if ((cmd_len < 3) || (slot >= LT_EMULATOR_ECC_SLOTS)) {
+                return TR01_L3_RESULT_SIZE;
+            }
+            const lt_emulator_ecc_slot_t *key = &dev->ecc[slot];
+            if (!key->curve) {
+                res[0] = TR01_L3_RESULT_INVALID_KEY;
+                return TR01_L3_RESULT_SIZE;
+            }
+            uint16_t pub_len
+                = (key->curve == TR01_CURVE_P256) ? TR01_CURVE_P256_PUBKEY_LEN : TR01_CURVE_ED25519_PUBKEY_LEN;
+            res[0] = TR01_L3_RESULT_OK;
+            res[1] = key->curve;
+            res[2] = key->origin;
+            memcpy(res + EMULATOR_L3_PADDED_OFFSET, key->pub, pub_len);
+            return EMULATOR_L3_PADDED_OFFSET + pub_len;
+        }
+
+        case TR01_L3_ECC_KEY_ERASE_CMD_ID: {
+            uint16_t slot = emulator_l3_slot(cmd);
+            if ((cmd_len < 3) || (slot >= LT_EMULATOR_ECC_SLOTS)) {
+                return TR01_L3_RESULT_SIZE;
+            }
+            memzero(&dev->ecc[slot], sizeof(dev->ecc[slot]));
+            res[0] = TR01_L3_RESULT_OK;
+            return TR01_L3_RESULT_SIZE;
+        }
+
+        case TR01_L3_ECDSA_SIGN_CMD_ID:
+        case TR01_L3_EDDSA_SIGN_CMD_ID: {
+            uint16_t slot = emulator_l3_slot(cmd);
+            bool ecdsa = (cmd[0] == TR01_L3_ECDSA_SIGN_CMD_ID);
+            if ((cmd_len < EMULATOR_L3_PADDED_OFFSET + (ecdsa ? SHA256_DIGEST_LENGTH : 0))
+                || (slot >= LT_EMULATOR_ECC_SLOTS)) {
+                return TR01_L3_RESULT_SIZE;
+            }
+            const lt_emulator_ecc_slot_t *key = &dev->ecc[slot];
+            if (key->curve != (ecdsa ? TR01_CURVE_P256 : TR01_CURVE_ED25519)) {
+                res[0] = TR01_L3_RESULT_INVALID_KEY;
+                return TR01_L3_RESULT_SIZE;
+            }
+            uint8_t *rs = res + EMULATOR_L3_PADDED_OFFSET;
+            if (ecdsa) {
+                if (ecdsa_sign_digest(&nist256p1, key->priv, cmd + EMULATOR_L3_PADDED_OFFSET, rs, NULL, NULL) != 0) {
+                    return TR01_L3_RESULT_SIZE;
+                }
+            }
+            else {
+                ed25519_sign(cmd + EMULATOR_L3_PADDED_OFFSET, cmd_len - EMULATOR_L3_PADDED_OFFSET, key->priv, rs);
+            }
+            res[0] = TR01_L3_RESULT_OK;
+            return EMULATOR_L3_PADDED_OFFSET + TR01_ECDSA_EDDSA_SIGNATURE_LENGTH;
+        }
+
+        default:
+            res[0] = TR01_L3_RESULT_INVALID_CMD;
+            return TR01_L3_RESULT_SIZE;
+    }
+}
+
+/** Decrypts assembled L3 Command packet, executes it and prepares encrypted L3 Result packet. */
+static bool emulator_l3_process(lt_dev_emulator_t *dev)
+{
+    uint8_t iv[TR01_L3_IV_SIZE] = {0};
+    uint16_t cmd_len = (uint16_t)(dev->l3_cmd[0] | (dev->l3_cmd[1] << 8));
+    uint8_t *cmd = dev->l3_cmd + TR01_L3_SIZE_SIZE;
+    uint8_t *res = dev->l3_res + TR01_L3_SIZE_SIZE;
+
+    iv[0] = (uint8_t)dev->nonce;
+    iv[1] = (uint8_t)(dev->nonce >> 8);
+    iv[2] = (uint8_t)(dev->nonce >> 16);
+    iv[3] = (uint8_t)(dev->nonce >> 24);
+
+    if (gcm_decrypt_message(iv, sizeof(iv), NULL, 0, cmd, cmd_len, cmd + cmd_len, TR01_L3_TAG_SIZE, &dev->cmd_ctx)
+        != RETURN_GOOD) {
+        return false;
+    }
+
+    uint16_t res_len = emulator_l3_execute(dev, cmd, cmd_len, res);
+    memzero(cmd, cmd_len);
+    dev->l3_res[0] = (uint8_t)res_len;
+    dev->l3_res[1] = (uint8_t)(res_len >> 8);
+    if (gcm_encrypt_message(iv, sizeof(iv), NULL, 0, res, res_len, res + res_len, TR01_L3_TAG_SIZE, &dev->res_ctx)
+        != RETURN_GOOD) {
+        return false;
+    }
+    dev->l3_res_len = TR01_L3_SIZE_SIZE + res_len + TR01_L3_TAG_SIZE;
+    dev->l3_res_sent = 0;
+    dev->nonce++;
+
+    return true;
+}
+
+/** Adds Encrypted_Cmd_Req chunk to the L3 Command packet, executes the packet once it is complete. */
+static void emulator_encrypted_cmd(lt_dev_emulator_t *dev, const uint8_t *chunk, const uint8_t len)
+{
+    if (!dev->session) {
+        emulator_respond(dev, TR01_L2_STATUS_NO_SESSION, NULL, 0);
+        return;
+    }
+    if (dev->l3_cmd_len + len > (uint16_t)sizeof(dev->l3_cmd)) {
+        dev->l3_cmd_len = 0;
+        emulator_respond(dev, TR01_L2_STATUS_GEN_ERR, NULL, 0);
+        return;
+    }
+    memcpy(dev->l3_cmd + dev->l3_cmd_len, chunk, len);
+    dev->l3_cmd_len += len;
+
+    uint16_t cmd_len = (dev->l3_cmd_len < TR01_L3_SIZE_SIZE) ? 0 : (uint16_t)(dev->l3_cmd[0] | (dev->l3_cmd[1] << 8));
+    if (!cmd_len || (cmd_len > TR01_L3_CMD_CIPHERTEXT_MAX_SIZE)) {
+        dev->l3_cmd_len = 0;
+        emulator_respond(dev, TR01_L2_STATUS_GEN_ERR, NULL, 0);
+        return;
+    }
+    uint16_t packet_len = TR01_L3_SIZE_SIZE + cmd_len + TR01_L3_TAG_SIZE;
+    if (dev->l3_cmd_len < packet_len) {
+        emulator_respond(dev, TR01_L2_STATUS_REQUEST_CONT, NULL, 0);
+        return;
+    }
+    if (dev->l3_cmd_len > packet_len) {
+        dev->l3_cmd_len = 0;
+        emulator_respond(dev, TR01_L2_STATUS_GEN_ERR, NULL, 0);
+        return;
+    }
+
+    dev->l3_cmd_len = 0;
+    if (!emulator_l3_process(dev)) {
+        // TROPIC01 ends the Secure Session when L3 Command is not authentic.
+        emulator_session_end(dev);
+        emulator_respond(dev, TR01_L2_STATUS_TAG_ERR, NULL, 0);
+        return;
+    }
+    // L3 Result follows the acknowledgement of the last chunk.
+    emulator_respond(dev, TR01_L2_STATUS_REQUEST_OK, NULL, 0);
+}
+
+/** Processes L2 Request frame received between chip select low and high. */
+static void emulator_l2_request(lt_dev_emulator_t *dev)
+{
+    const uint8_t req_id = dev->req[0];
+    const uint8_t len = dev->req[1];
+    const uint8_t *data = dev->req + TR01_L2_REQ_DATA_REQ_CRC_OFFSET;
+
+    // Any new request drops L3 Result not read out yet.
+    dev->l3_res_len = 0;
+    dev->l3_res_sent = 0;
+
+    uint16_t crc = crc16(dev->req, (int16_t)(len + 2));
+    if ((dev->spi_pos < len + 4) || (dev->req[len + 2] != (crc >> 8)) || (dev->req[len + 3] != (crc & 0x00FF))) {
+        emulator_respond(dev, TR01_L2_STATUS_CRC_ERR, NULL, 0);
+        return;
+    }
+
+    switch (req_id) {
+        case TR01_L2_GET_INFO_REQ_ID:
+            if (len == TR01_L2_GET_INFO_REQ_LEN) {
+                emulator_get_info(dev, data[0], data[1]);
+                return;
+            }
+            break;
+        case TR01_L2_HANDSHAKE_REQ_ID:
+            if (len == TR01_L2_HANDSHAKE_REQ_LEN) {
+                emulator_handshake(dev, data, data[TR01_X25519_KEY_LEN]);
+                return;
+            }
+            break;
+        case TR01_L2_ENCRYPTED_CMD_REQ_ID:
+            emulator_encrypted_cmd(dev, data, len);
+            return;
+        case TR01_L2_RESEND_REQ_ID:
+            if ((len == TR01_L2_RESEND_REQ_LEN) && dev->last_rsp_len) {
+                memcpy(dev->rsp, dev->last_rsp, dev->last_rsp_len);
+                dev->rsp_len = dev->last_rsp_len;
+                return;
+            }
+            break;
+        case TR01_L2_ENCRYPTED_SESSION_ABT_ID:
+        case TR01_L2_SLEEP_REQ_ID:
+        case TR01_L2_STARTUP_REQ_ID:
+            // Sleep and reboot end the Secure Session, TROPIC01 comes back in Application Mode instantly.
+            emulator_session_end(dev);
+            emulator_respond(dev, TR01_L2_STATUS_REQUEST_OK, NULL, 0);
+            return;
+        case TR01_L2_GET_LOG_REQ_ID:
+            emulator_respond(dev, TR01_L2_STATUS_REQUEST_OK, NULL, 0);
+            return;
+        default:
+            emulator_respond(dev, TR01_L2_STATUS_UNKNOWN_ERR, NULL, 0);
+            return;
+    }
+
+    emulator_respond(dev, TR01_L2_STATUS_GEN_ERR, NULL, 0);
+}
+
+lt_ret_t lt_port_init(lt_l2_state_t *s2)
+{
+    lt_dev_emulator_t *dev = (lt_dev_emulator_t *)(s2->device);
+
+    // Slots survive lt_deinit() and lt_init() as they do in TROPIC01.
+    if (!dev->powered) {
+        return lt_emulator_hal_reset(dev);
+    }
+    dev->csn_low = false;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_deinit(lt_l2_state_t *s2)
+{
+    LT_UNUSED(s2);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_spi_csn_low(lt_l2_state_t *s2)
+{
+    lt_dev_emulator_t *dev = (lt_dev_emulator_t *)(s2->device);
+
+    dev->csn_low = true;
+    dev->spi_pos = 0;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2)
+{
+    lt_dev_emulator_t *dev = (lt_dev_emulator_t *)(s2->device);
+
+    if (!dev->csn_low) {
+        return LT_OK;
+    }
+    dev->csn_low = false;
+    if (!dev->spi_pos) {
+        return LT_OK;
+    }
+
+    if (dev->req[0] == TR01_L1_GET_RESPONSE_REQ_ID) {
+        // Response is consumed once it was read entirely.
+        if (dev->rsp_len && (dev->spi_pos >= TR01_L1_CHIP_STATUS_SIZE + dev->rsp_len)) {
+            memcpy(dev->last_rsp, dev->rsp, dev->rsp_len);
+            dev->last_rsp_len = dev->rsp_len;
+            dev->rsp_len = 0;
+            emulator_respond_res_chunk(dev);
+        }
+    }
+    else {
+        dev->rsp_len = 0;
+        emulator_l2_request(dev);
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_emulator_t *dev = (lt_dev_emulator_t *)(s2->device);
+
+    if ((size_t)offset + tx_len > sizeof(s2->buff)) {
+        return LT_L1_DATA_LEN_ERROR;
+    }
+    if (!dev->csn_low) {
+        return LT_FAIL;
+    }
+
+    uint8_t *buff = s2->buff + offset;
+    for (uint16_t i = 0; i < tx_len; i++, dev->spi_pos++) {
+        const uint16_t pos = dev->spi_pos;
+        if (pos < sizeof(dev->req)) {
+            dev->req[pos] = buff[i];
+        }
+
+        if (pos == 0) {
+            buff[i] = EMULATOR_CHIP_STATUS;
+        }
+        else if (dev->req[0] != TR01_L1_GET_RESPONSE_REQ_ID) {
+            buff[i] = 0x00;
+        }
+        else if (!dev->rsp_len) {
+            buff[i] = 0xFF;
+        }
+        else {
+            buff[i] = (pos - 1 < dev->rsp_len) ? dev->rsp[pos - 1] : 0x00;
+        }
+    }
+
+    return LT_OK;
+}
+
+#ifdef LT_PORT_SPI_TRANSFER_V
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms)
+{
+    if (!s2 || (!segs && seg_cnt) || (seg_cnt > LT_SPI_V_SEGS_MAX)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = LT_OK;
+
+    if (flags & LT_SPI_V_CSN_LOW) {
+        ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        uint8_t *frame_pos = s2->buff + segs[i].offset;
+        if ((size_t)segs[i].offset + segs[i].len > sizeof(s2->buff)) {
+            return LT_L1_DATA_LEN_ERROR;
+        }
+        if (segs[i].tx && (segs[i].tx != frame_pos)) {
+            memcpy(frame_pos, segs[i].tx, segs[i].len);
+        }
+        ret = lt_port_spi_transfer(s2, segs[i].offset, segs[i].len, timeout_ms);
+        if (ret != LT_OK) {
+            lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+            LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
+            return ret;
+        }
+        if (segs[i].rx && (segs[i].rx != frame_pos)) {
+            memcpy(segs[i].rx, frame_pos, segs[i].len);
+        }
+    }
+
+    if (flags & LT_SPI_V_CSN_HIGH) {
+        return lt_port_spi_csn_high(s2);
+    }
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY
+lt_ret_t lt_port_spi_read_ready(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms, uint16_t max_tries,
+                                uint32_t timeout_ms)
+{
+    LT_UNUSED(retry_delay_ms);
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_emulator_t *dev = (lt_dev_emulator_t *)(s2->device);
+
+    // Responses are ready right away, one attempt is enough.
+    if (!max_tries) {
+        return LT_OK;
+    }
+    if (dev->rsp_len && (TR01_L1_CHIP_STATUS_SIZE + dev->rsp_len > max_len)) {
+        return LT_L1_DATA_LEN_ERROR;
+    }
+
+    lt_ret_t ret = lt_port_spi_csn_low(s2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    s2->buff[0] = TR01_L1_GET_RESPONSE_REQ_ID;
+    ret = lt_port_spi_transfer(s2, 0, dev->rsp_len ? TR01_L1_CHIP_STATUS_SIZE + dev->rsp_len : 2, timeout_ms);
+    lt_ret_t ret_csn = lt_port_spi_csn_high(s2);
+
+    return (ret != LT_OK) ? ret : ret_csn;
+}
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+lt_ret_t lt_port_spi_read_ready_nowait(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms,
+                                       uint16_t max_tries, uint32_t timeout_ms)
+{
+    // Polling of the emulated TROPIC01 never has to wait.
+    return lt_port_spi_read_ready(s2, max_len, retry_delay_ms, max_tries, timeout_ms);
+}
+#endif
+
+#ifdef LT_CRC16_PORT
+uint16_t lt_port_crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x8005) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+#endif
+
+lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
+{
+    LT_UNUSED(s2);
+    LT_UNUSED(ms);
+
+    // Emulated TROPIC01 is never busy.
+    return LT_OK;
+}
+
+#ifdef LT_PORT_DELAY_US
+lt_ret_t lt_port_delay_us(lt_l2_state_t *s2, uint32_t us)
+{
+    LT_UNUSED(s2);
+    LT_UNUSED(us);
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_SPI_SET_SPEED
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    LT_UNUSED(s2);
+    LT_UNUSED(hz);
+
+    return LT_OK;
+}
+#endif
+
+#if LT_USE_INT_PIN
+lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
+{
+    LT_UNUSED(s2);
+    LT_UNUSED(ms);
+
+    // Response is ready before the interrupt could be waited for.
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+#endif
+
+lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
+{
+    LT_UNUSED(s2);
+    if (!buff) {
+        return LT_PARAM_ERR;
+    }
+
+    return lt_posix_rng_bytes(buff, count);
+}
+
+int lt_port_log(const char *format, ...)
+{
+    va_list args;
+    int ret;
+
+    va_start(args, format);
+    ret = vfprintf(stderr, format, args);
+    fflush(stderr);
+    va_end(args);
+
+    return ret;
+}
@@ -0,0 +1,143 @@
+#ifndef LIBTROPIC_PORT_EMULATOR_H
+#define LIBTROPIC_PORT_EMULATOR_H
+
+/**
+ * @file libtropic_port_emulator.h
+ * @brief Port emulating TROPIC01 in the process of the application, used to test and benchmark without TROPIC01.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "aes/aesgcm.h"
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of pairing key slots of the emulated TROPIC01. */
+#define LT_EMULATOR_PAIRING_KEY_SLOTS 4
+
+/** Size of one R-mem slot of the emulated TROPIC01, the one reported by RISC-V FW 2.0.0. */
+#define LT_EMULATOR_R_MEM_SLOT_SIZE 475
+
+/** Number of ECC key slots of the emulated TROPIC01. */
+#define LT_EMULATOR_ECC_SLOTS 32
+
+/** One R-mem slot of the emulated TROPIC01. */
+typedef struct lt_emulator_r_mem_slot_t {
+    /** Length of the data, 0 if the slot is empty. */
+    uint16_t len;
+    uint8_t data[LT_EMULATOR_R_MEM_SLOT_SIZE];
+} lt_emulator_r_mem_slot_t;
+
+/** One ECC key slot of the emulated TROPIC01. */
+typedef struct lt_emulator_ecc_slot_t {
+    /** TR01_CURVE_P256 or TR01_CURVE_ED25519, 0 if the slot is empty. */
+    uint8_t curve;
+    /** TR01_CURVE_GENERATED or TR01_CURVE_STORED. */
+    uint8_t origin;
+    uint8_t priv[TR01_CURVE_PRIVKEY_LEN];
+    /** X and Y coordinates for P256, only the first TR01_CURVE_ED25519_PUBKEY_LEN bytes for Ed25519. */
+    uint8_t pub[TR01_CURVE_P256_PUBKEY_LEN];
+} lt_emulator_ecc_slot_t;
+
+/**
+ * @brief Device structure for the emulator port.
+ *
+ * @note TROPIC01 is emulated in Application Mode with RISC-V FW 2.0.0: L2 Requests Get_Info, Handshake,
+ * Encrypted_Cmd, Encrypted_Session_Abt, Resend, Sleep, Startup and Get_Log, and L3 Commands Ping, R_Mem_Data_Write,
+ * R_Mem_Data_Read, R_Mem_Data_Erase, Random_Value_Get, ECC_Key_Generate, ECC_Key_Store, ECC_Key_Read,
+ * ECC_Key_Erase, ECDSA_Sign and EdDSA_Sign. Other L3 Commands are answered by the INVALID_CMD result. Responses are
+ * ready right away and delays of the port return immediately, so the speed of libtropic and its CAL is measured
+ * rather than the speed of TROPIC01. Certificate store holds only the public key of the device (STPUB), the
+ * certificates are neither complete nor signed.
+ *
+ * The structure is large (R-mem alone has 512 slots), do not allocate it on a small stack.
+ */
+typedef struct lt_dev_emulator_t {
+    /**
+     * @public @brief Seed of the PRNG of the emulated TROPIC01, which generates its keys (STPRIV included) and
+     * random values. Same seed gives the same session of TROPIC01, as long as the host uses the same random bytes.
+     */
+    uint64_t seed;
+
+    /** @private @brief Set when the emulated TROPIC01 was powered up by the first use of the port. */
+    bool powered;
+    /** @private @brief State of the PRNG of TROPIC01. */
+    uint64_t prng;
+    /** @private @brief X25519 key pair of TROPIC01. */
+    uint8_t stpriv[TR01_X25519_KEY_LEN];
+    uint8_t stpub[TR01_STPUB_LEN];
+    /** @private @brief Pairing keys of the host. */
+    uint8_t shipub[LT_EMULATOR_PAIRING_KEY_SLOTS][TR01_SHIPUB_LEN];
+    bool shipub_valid[LT_EMULATOR_PAIRING_KEY_SLOTS];
+    /** @private @brief User data. */
+    lt_emulator_r_mem_slot_t r_mem[TR01_R_MEM_DATA_SLOT_MAX + 1];
+    /** @private @brief ECC keys. */
+    lt_emulator_ecc_slot_t ecc[LT_EMULATOR_ECC_SLOTS];
+
+    /** @private @brief Secure Session is established. */
+    bool session;
+    /** @private @brief Decrypts L3 Commands with kCMD. */
+    gcm_ctx cmd_ctx;
+    /** @private @brief Encrypts L3 Results with kRES. */
+    gcm_ctx res_ctx;
+    /** @private @brief Nonce of the next L3 Command and its L3 Result. */
+    uint32_t nonce;
+
+    /** @private @brief Chip select is low. */
+    bool csn_low;
+    /** @private @brief Number of bytes transferred since chip select went low. */
+    uint16_t spi_pos;
+    /** @private @brief Bytes received since chip select went low, the L2 Request frame. */
+    uint8_t req[TR01_L1_LEN_MAX];
+    /** @private @brief L2 Response frame waiting for GET_RESPONSE, without CHIP_STATUS. */
+    uint8_t rsp[TR01_L2_MAX_FRAME_SIZE];
+    uint16_t rsp_len;
+    /** @private @brief Last L2 Response frame read by the host, sent again on Resend_Req. */
+    uint8_t last_rsp[TR01_L2_MAX_FRAME_SIZE];
+    uint16_t last_rsp_len;
+
+    /** @private @brief L3 Command packet assembled from Encrypted_Cmd_Req chunks. */
+    uint8_t l3_cmd[TR01_L3_PACKET_MAX_SIZE];
+    uint16_t l3_cmd_len;
+    /** @private @brief L3 Result packet and the number of bytes already sent in Encrypted_Cmd_Rsp chunks. */
+    uint8_t l3_res[TR01_L3_PACKET_MAX_SIZE];
+    uint16_t l3_res_len;
+    uint16_t l3_res_sent;
+} lt_dev_emulator_t;
+
+/**
+ * @brief Writes a pairing key of the host into the emulated TROPIC01, as Pairing_Key_Write would.
+ * @details TROPIC01 is powered up first if it was not yet, slots of a powered up TROPIC01 keep their keys.
+ *
+ * @param dev     Device structure of the emulator port
+ * @param slot    Pairing key slot, 0-3
+ * @param shipub  Public pairing key of the host, TR01_SHIPUB_LEN bytes
+ *
+ * @retval        LT_OK         Key was written
+ * @retval        LT_PARAM_ERR  Invalid arguments
+ */
+lt_ret_t lt_emulator_hal_set_pairing_key(lt_dev_emulator_t *dev, const uint8_t slot, const uint8_t *shipub);
+
+/**
+ * @brief Powers up the emulated TROPIC01 again with all slots erased.
+ * @details STPRIV and the state of the PRNG are derived from `seed` again.
+ *
+ * @param dev     Device structure of the emulator port
+ *
+ * @retval        LT_OK         Function executed successfully
+ * @retval        LT_PARAM_ERR  Invalid arguments
+ */
+lt_ret_t lt_emulator_hal_reset(lt_dev_emulator_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_PORT_EMULATOR_H
@@ -16,8 +16,11 @@
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
 #include "esp_random.h"
 #include "esp_system.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
@@ -26,6 +29,12 @@
 #include "libtropic_macros.h"
 #include "libtropic_port.h"
 
+// Every transaction gets its own 4-byte aligned part of the DMA buffer, so the driver does not copy it again.
+#define LT_ESP_IDF_DMA_ALIGN(len) (((len) + 3) & ~3)
+#define LT_ESP_IDF_DMA_BUFF_LEN   (LT_ESP_IDF_DMA_ALIGN(TR01_L1_LEN_MAX) + 4 * LT_SPI_V_SEGS_MAX)
+// Default of spi_polling_max_len, covers CHIP_STATUS polling and short responses.
+#define LT_ESP_IDF_POLLING_MAX_LEN_DEFAULT 16
+
 #if LT_USE_INT_PIN
 // traceISR_EXIT_TO_SCHEDULER is a FreeRTOS tracing macro used by portYIELD_FROM_ISR.
 // It should be defined in FreeRTOS headers (typically as an empty macro when tracing
@@ -56,6 +65,157 @@ static void IRAM_ATTR int_gpio_pin_isr_handler(void *esp_idf_dev)
 }
 #endif
 
+/**
+ * @brief Does the transactions one by one in polling mode.
+ *
+ * @param dev            lt_dev_esp_idf_t device structure
+ * @param trans          Transactions
+ * @param trans_cnt      Number of transactions
+ * @param ticks_to_wait  Timeout for completion of each transaction
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t esp_idf_transact_polling(lt_dev_esp_idf_t *dev, spi_transaction_t *trans, uint8_t trans_cnt,
+                                         TickType_t ticks_to_wait)
+{
+    esp_err_t ret;
+
+    for (uint8_t i = 0; i < trans_cnt; i++) {
+        // Bus is always acquired here, so the bus timeout of spi_device_polling_start() does not apply.
+        ret = spi_device_polling_start(dev->spi_handle, &trans[i], portMAX_DELAY);
+        if (ret != ESP_OK) {
+            LT_LOG_ERROR("spi_device_polling_start() failed: %s", esp_err_to_name(ret));
+            return LT_FAIL;
+        }
+        dev->cs_active = (trans[i].flags & SPI_TRANS_CS_KEEP_ACTIVE) != 0;
+
+        ret = spi_device_polling_end(dev->spi_handle, ticks_to_wait);
+        if (ret != ESP_OK) {
+            LT_LOG_ERROR("spi_device_polling_end() failed: %s", esp_err_to_name(ret));
+            return LT_FAIL;
+        }
+    }
+
+    return LT_OK;
+}
+
+/**
+ * @brief Does the transactions, short ones in polling mode, longer ones queued back-to-back.
+ *
+ * @param dev         lt_dev_esp_idf_t device structure
+ * @param trans       Transactions
+ * @param trans_cnt   Number of transactions
+ * @param timeout_ms  Timeout for completion of each transaction, 0 to wait indefinitely
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t esp_idf_transact(lt_dev_esp_idf_t *dev, spi_transaction_t *trans, uint8_t trans_cnt,
+                                 uint32_t timeout_ms)
+{
+    esp_err_t ret = ESP_OK;
+    TickType_t ticks_to_wait = pdMS_TO_TICKS(timeout_ms);
+    uint16_t polling_max_len = dev->spi_polling_max_len ? dev->spi_polling_max_len : LT_ESP_IDF_POLLING_MAX_LEN_DEFAULT;
+    size_t total_len = 0;
+    uint8_t queued;
+
+    // If ticks==0, we wait indefinitely.
+    if (ticks_to_wait == 0) {
+        ticks_to_wait = portMAX_DELAY;
+    }
+
+    for (uint8_t i = 0; i < trans_cnt; i++) {
+        total_len += trans[i].length / 8;
+    }
+    if (total_len <= polling_max_len) {
+        return esp_idf_transact_polling(dev, trans, trans_cnt, ticks_to_wait);
+    }
+
+    for (queued = 0; queued < trans_cnt; queued++) {
+        ret = spi_device_queue_trans(dev->spi_handle, &trans[queued], 0);
+        if (ret != ESP_OK) {
+            LT_LOG_ERROR("spi_device_queue_trans() failed: %s", esp_err_to_name(ret));
+            break;
+        }
+    }
+    lt_ret_t lt_ret = (ret == ESP_OK) ? LT_OK : LT_FAIL;
+
+    if (queued) {
+        dev->cs_active = (trans[queued - 1].flags & SPI_TRANS_CS_KEEP_ACTIVE) != 0;
+    }
+
+    // Results of the queued transactions are collected also after a failed queueing.
+    for (uint8_t i = 0; i < queued; i++) {
+        spi_transaction_t *rtrans = NULL;
+        ret = spi_device_get_trans_result(dev->spi_handle, &rtrans, ticks_to_wait);
+        if (ret != ESP_OK) {
+            LT_LOG_ERROR("spi_device_get_trans_result() failed: %s", esp_err_to_name(ret));
+            return LT_FAIL;
+        }
+    }
+
+    return lt_ret;
+}
+
+/**
+ * @brief Acquires the SPI bus, unless it is already acquired for the current L1 frame.
+ *
+ * @param dev  lt_dev_esp_idf_t device structure
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t esp_idf_acquire_bus(lt_dev_esp_idf_t *dev)
+{
+    if (dev->bus_acquired) {
+        return LT_OK;
+    }
+
+    // Use portMAX_DELAY for acquisition because some ESP-IDF versions fail when a different timeout is used.
+    esp_err_t ret = spi_device_acquire_bus(dev->spi_handle, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        LT_LOG_ERROR("spi_device_acquire_bus() failed: %s", esp_err_to_name(ret));
+        return LT_FAIL;
+    }
+    dev->bus_acquired = true;
+
+    return LT_OK;
+}
+
+/**
+ * @brief Releases the SPI bus acquired by esp_idf_acquire_bus().
+ *
+ * @param dev  lt_dev_esp_idf_t device structure
+ */
+static void esp_idf_release_bus(lt_dev_esp_idf_t *dev)
+{
+    if (dev->bus_acquired) {
+        spi_device_release_bus(dev->spi_handle);
+        dev->bus_acquired = false;
+    }
+}
+
+/**
+ * @brief Adds the SPI device to the bus, clocked at `spi_clk_hz`.
+ *
+ * @param dev  lt_dev_esp_idf_t device structure
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t esp_idf_add_device(lt_dev_esp_idf_t *dev)
+{
+    // Without spi_cs_hw, we handle CS ourselves.
+    spi_device_interface_config_t spi_dev_cfg = {.mode = 0,  // TROPIC01 supports only CPOL=0 and CPHA=0.
+                                                 .clock_speed_hz = dev->spi_clk_hz,
+                                                 .spics_io_num = dev->spi_cs_hw ? dev->spi_cs_gpio_pin : -1,
+                                                 .queue_size = LT_SPI_V_SEGS_MAX,
+                                                 .pre_cb = NULL,
+                                                 .post_cb = NULL};
+
+    esp_err_t ret = spi_bus_add_device(dev->spi_host_id, &spi_dev_cfg, &dev->spi_handle);
+    if (ret != ESP_OK) {
+        LT_LOG_ERROR("spi_bus_add_device() failed: %s", esp_err_to_name(ret));
+        dev->spi_handle = NULL;
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
 lt_ret_t lt_port_init(lt_l2_state_t *s2)
 {
     lt_dev_esp_idf_t *dev = (lt_dev_esp_idf_t *)(s2->device);
@@ -64,6 +224,9 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
 
     // Ensure device handles are in a known state before initialization.
     dev->spi_handle = NULL;
+    dev->dma_buff = NULL;
+    dev->bus_acquired = false;
+    dev->cs_active = false;
 #if LT_USE_INT_PIN
     dev->int_gpio_sem = NULL;
 #endif
@@ -78,7 +241,7 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
                                     .data5_io_num = -1,
                                     .data6_io_num = -1,
                                     .data7_io_num = -1,
-                                    .max_transfer_sz = TR01_L1_LEN_MAX,
+                                    .max_transfer_sz = LT_ESP_IDF_DMA_BUFF_LEN,
                                     .flags = (SPICOMMON_BUSFLAG_MASTER | SPICOMMON_BUSFLAG_GPIO_PINS)};
 
     // Initialize the SPI bus.
@@ -88,22 +251,25 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         return LT_FAIL;
     }
 
-    // Create configuration for the SPI device.
-    spi_device_interface_config_t spi_dev_cfg = {.mode = 0,  // TROPIC01 supports only CPOL=0 and CPHA=0.
-                                                 .clock_speed_hz = dev->spi_clk_hz,
-                                                 .spics_io_num = -1,  // We handle CS ourselves.
-                                                 .queue_size = 1,
-                                                 .pre_cb = NULL,
-                                                 .post_cb = NULL};
-
     // Add the SPI device to the bus.
-    esp_ret = spi_bus_add_device(dev->spi_host_id, &spi_dev_cfg, &dev->spi_handle);
-    if (esp_ret != ESP_OK) {
-        LT_LOG_ERROR("spi_bus_add_device() failed: %s", esp_err_to_name(esp_ret));
-        lt_ret = LT_FAIL;
+    lt_ret = esp_idf_add_device(dev);
+    if (lt_ret != LT_OK) {
         goto spi_bus_add_device_error;
     }
 
+    // Allocate the buffer transactions are done from, so the driver does not allocate one for each of them.
+    dev->dma_buff = heap_caps_malloc(LT_ESP_IDF_DMA_BUFF_LEN, MALLOC_CAP_DMA);
+    if (!dev->dma_buff) {
+        LT_LOG_ERROR("Failed to allocate DMA buffer with heap_caps_malloc!");
+        lt_ret = LT_FAIL;
+        goto dma_buff_alloc_error;
+    }
+
+    if (dev->spi_cs_hw) {
+        // CS pin is configured by the SPI driver.
+        goto cs_gpio_done;
+    }
+
     // Create configuration for the SPI CS GPIO pin.
     gpio_config_t spi_cs_gpio_cfg = {.pin_bit_mask = (1ULL << dev->spi_cs_gpio_pin),
                                      .mode = GPIO_MODE_OUTPUT,
@@ -131,6 +297,7 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         lt_ret = LT_FAIL;
         goto cs_gpio_set_level_error;
     }
+cs_gpio_done:
 
 #if LT_USE_INT_PIN
     // Create configuration for the GPIO connected to TROPIC01's interrupt pin.
@@ -182,7 +349,12 @@ int_gpio_config_error:
 #endif
 cs_gpio_set_level_error:
 cs_gpio_config_error:
-    gpio_reset_pin(dev->spi_cs_gpio_pin);
+    if (!dev->spi_cs_hw) {
+        gpio_reset_pin(dev->spi_cs_gpio_pin);
+    }
+    heap_caps_free(dev->dma_buff);
+    dev->dma_buff = NULL;
+dma_buff_alloc_error:
     spi_bus_remove_device(dev->spi_handle);
     dev->spi_handle = NULL;
 spi_bus_add_device_error:
@@ -204,11 +376,16 @@ lt_ret_t lt_port_deinit(lt_l2_state_t *s2)
     }
     gpio_reset_pin(dev->int_gpio_pin);
 #endif
-    gpio_reset_pin(dev->spi_cs_gpio_pin);
+    if (!dev->spi_cs_hw) {
+        gpio_reset_pin(dev->spi_cs_gpio_pin);
+    }
     if (dev->spi_handle != NULL) {
+        esp_idf_release_bus(dev);
         spi_bus_remove_device(dev->spi_handle);
         dev->spi_handle = NULL;
     }
+    heap_caps_free(dev->dma_buff);
+    dev->dma_buff = NULL;
     spi_bus_free(dev->spi_host_id);
 
     return LT_OK;
@@ -219,9 +396,21 @@ lt_ret_t lt_port_spi_csn_low(lt_l2_state_t *s2)
     lt_dev_esp_idf_t *dev = (lt_dev_esp_idf_t *)(s2->device);
     esp_err_t ret;
 
+    // The bus is held for the whole L1 frame, so no other device can be selected in the middle of it.
+    lt_ret_t lt_ret = esp_idf_acquire_bus(dev);
+    if (lt_ret != LT_OK) {
+        return lt_ret;
+    }
+
+    // Hardware CS is activated by the first transaction of the frame.
+    if (dev->spi_cs_hw) {
+        return LT_OK;
+    }
+
     ret = gpio_set_level(dev->spi_cs_gpio_pin, 0);
     if (ret != ESP_OK) {
         LT_LOG_ERROR("gpio_set_level() failed: %s", esp_err_to_name(ret));
+        esp_idf_release_bus(dev);
         return LT_FAIL;
     }
 
@@ -231,69 +420,157 @@ lt_ret_t lt_port_spi_csn_low(lt_l2_state_t *s2)
 lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2)
 {
     lt_dev_esp_idf_t *dev = (lt_dev_esp_idf_t *)(s2->device);
+    lt_ret_t lt_ret = LT_OK;
     esp_err_t ret;
 
-    ret = gpio_set_level(dev->spi_cs_gpio_pin, 1);
-    if (ret != ESP_OK) {
-        LT_LOG_ERROR("gpio_set_level() failed: %s", esp_err_to_name(ret));
-        return LT_FAIL;
+    if (!dev->spi_cs_hw) {
+        ret = gpio_set_level(dev->spi_cs_gpio_pin, 1);
+        if (ret != ESP_OK) {
+            LT_LOG_ERROR("gpio_set_level() failed: %s", esp_err_to_name(ret));
+            lt_ret = LT_FAIL;
+        }
+    }
+    else if (dev->cs_active) {
+        // Transaction without any phase and without SPI_TRANS_CS_KEEP_ACTIVE only deactivates CS.
+        spi_transaction_t spi_transaction;
+        memset(&spi_transaction, 0, sizeof(spi_transaction));
+        lt_ret = esp_idf_transact(dev, &spi_transaction, 1, 0);
     }
 
-    return LT_OK;
+    esp_idf_release_bus(dev);
+
+    return lt_ret;
 }
 
-lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms)
+/**
+ * @brief Checks the SPI driver transfers the bytes by DMA right from where they are, without a bounce copy.
+ *
+ * @param ptr         First byte
+ * @param len         Number of bytes
+ * @return            true if the bytes lie in DMA-capable memory, 4 bytes aligned and of length multiple of 4
+ */
+static bool esp_idf_dma_direct(const uint8_t *ptr, uint16_t len)
+{
+    return esp_ptr_dma_capable(ptr) && !((uintptr_t)ptr & 3) && !(len & 3);
+}
+
+/**
+ * @brief Transfers the segments through the DMA buffer, with the semantics of lt_port_spi_transfer_v(). Segments
+ * already in DMA-capable memory (e.g. the handle placed there with `LT_BUFF_ALIGN` and `LT_DMA_BUFF_ATTR`) are
+ * transferred right from it.
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Segments to transfer
+ * @param seg_cnt     Number of segments, at most LT_SPI_V_SEGS_MAX
+ * @param flags       Combination of LT_SPI_V_CSN_LOW and LT_SPI_V_CSN_HIGH
+ * @param timeout_ms  Timeout
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t esp_idf_transfer_segs(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                      uint32_t timeout_ms)
 {
     lt_dev_esp_idf_t *dev = (lt_dev_esp_idf_t *)(s2->device);
-    esp_err_t ret;
-    spi_transaction_t spi_transaction;
-    TickType_t ticks_to_wait = pdMS_TO_TICKS(timeout_ms);
+    spi_transaction_t spi_transactions[LT_SPI_V_SEGS_MAX];
+    uint16_t dma_pos[LT_SPI_V_SEGS_MAX];
+    bool direct[LT_SPI_V_SEGS_MAX];
+    uint16_t pos = 0;
+    lt_ret_t ret, ret_unused;
+
+    if (seg_cnt > LT_SPI_V_SEGS_MAX) {
+        return LT_PARAM_ERR;
+    }
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        if ((size_t)segs[i].offset + segs[i].len > TR01_L1_LEN_MAX) {
+            LT_LOG_ERROR("Invalid data length!");
+            return LT_L1_DATA_LEN_ERROR;
+        }
+        direct[i] = esp_idf_dma_direct(segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset, segs[i].len)
+                    && esp_idf_dma_direct(segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset, segs[i].len);
+        dma_pos[i] = pos;
+        if (direct[i]) {
+            continue;
+        }
+        pos += LT_ESP_IDF_DMA_ALIGN(segs[i].len);
+        if (pos > LT_ESP_IDF_DMA_BUFF_LEN) {
+            LT_LOG_ERROR("Invalid data length!");
+            return LT_L1_DATA_LEN_ERROR;
+        }
+    }
 
-    // If ticks==0, we wait indefinitely.
-    if (ticks_to_wait == 0) {
-        ticks_to_wait = portMAX_DELAY;
+    if (flags & LT_SPI_V_CSN_LOW) {
+        ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
     }
 
-    // Prepare the SPI transaction.
-    memset(&spi_transaction, 0, sizeof(spi_transaction));
-    spi_transaction.length = tx_len * 8;
-    spi_transaction.tx_buffer = s2->buff + offset;
-    spi_transaction.rx_buffer = s2->buff + offset;
+    // A transfer outside of any frame holds the bus just for itself.
+    bool in_frame = dev->bus_acquired;
+    ret = esp_idf_acquire_bus(dev);
+    if (ret != LT_OK) {
+        return ret;
+    }
 
-    // Acquire the SPI bus. Use portMAX_DELAY for acquisition because some
-    // ESP-IDF versions fail when a different timeout is used. We implement
-    // the user-provided `timeout_ms` for the transaction completion below.
-    ret = spi_device_acquire_bus(dev->spi_handle, portMAX_DELAY);
-    if (ret != ESP_OK) {
-        LT_LOG_ERROR("spi_device_acquire_bus() failed: %s", esp_err_to_name(ret));
-        return LT_FAIL;
+    // Prepare the SPI transactions, hardware CS stays active between them until the frame ends.
+    memset(spi_transactions, 0, sizeof(spi_transactions));
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        const uint8_t *tx = segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset;
+
+        spi_transactions[i].length = segs[i].len * 8;
+        if (direct[i]) {
+            spi_transactions[i].tx_buffer = tx;
+            spi_transactions[i].rx_buffer = segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset;
+        }
+        else {
+            uint8_t *dma_ptr = dev->dma_buff + dma_pos[i];
+
+            memcpy(dma_ptr, tx, segs[i].len);
+            spi_transactions[i].tx_buffer = dma_ptr;
+            spi_transactions[i].rx_buffer = dma_ptr;
+        }
+        if (dev->spi_cs_hw && in_frame && !((flags & LT_SPI_V_CSN_HIGH) && (i == seg_cnt - 1))) {
+            spi_transactions[i].flags = SPI_TRANS_CS_KEEP_ACTIVE;
+        }
     }
 
-    // Queue the transaction and wait for its completion using the provided
-    // timeout (converted to ticks). This avoids busy polling while still
-    // respecting `timeout_ms`.
-    ret = spi_device_queue_trans(dev->spi_handle, &spi_transaction, 0);
-    if (ret != ESP_OK) {
-        LT_LOG_ERROR("spi_device_queue_trans() failed: %s", esp_err_to_name(ret));
-        spi_device_release_bus(dev->spi_handle);
-        return LT_FAIL;
+    ret = esp_idf_transact(dev, spi_transactions, seg_cnt, timeout_ms);
+    if (ret != LT_OK) {
+        ret_unused = lt_port_spi_csn_high(s2);
+        LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
+        return ret;
     }
 
-    spi_transaction_t *rtrans = NULL;
-    ret = spi_device_get_trans_result(dev->spi_handle, &rtrans, ticks_to_wait);
-    if (ret != ESP_OK) {
-        LT_LOG_ERROR("spi_device_get_trans_result() failed: %s", esp_err_to_name(ret));
-        // Release the SPI bus.
-        spi_device_release_bus(dev->spi_handle);
-        return LT_FAIL;
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        if (!direct[i]) {
+            memcpy(segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset, dev->dma_buff + dma_pos[i], segs[i].len);
+        }
     }
 
-    // Release the SPI bus.
-    spi_device_release_bus(dev->spi_handle);
+    if (!in_frame) {
+        esp_idf_release_bus(dev);
+    }
+    else if (flags & LT_SPI_V_CSN_HIGH) {
+        return lt_port_spi_csn_high(s2);
+    }
 
     return LT_OK;
 }
 
+lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms)
+{
+    lt_spi_seg_t seg = {.tx = NULL, .rx = NULL, .len = tx_len, .offset = offset};
+
+    return esp_idf_transfer_segs(s2, &seg, 1, 0, timeout_ms);
+}
+
+#ifdef LT_PORT_SPI_TRANSFER_V
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms)
+{
+    return esp_idf_transfer_segs(s2, segs, seg_cnt, flags, timeout_ms);
+}
+#endif
+
 lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
 {
     LT_UNUSED(s2);
@@ -309,6 +586,13 @@ lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
     lt_dev_esp_idf_t *dev = (lt_dev_esp_idf_t *)(s2->device);
     TickType_t ticks_to_wait = pdMS_TO_TICKS(ms);
 
+    // Drop a give of an earlier edge, which would end the wait before TROPIC01 is ready. The level is read
+    // after that, so an edge which came already is not missed either.
+    xSemaphoreTake(dev->int_gpio_sem, 0);
+    if (gpio_get_level(dev->int_gpio_pin)) {
+        return LT_OK;
+    }
+
     if (xSemaphoreTake(dev->int_gpio_sem, ticks_to_wait) == pdTRUE) {
         return LT_OK;
     }
@@ -317,6 +601,33 @@ lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
 }
 #endif
 
+#ifdef LT_PORT_SPI_SET_SPEED
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    lt_dev_esp_idf_t *dev = (lt_dev_esp_idf_t *)(s2->device);
+    int old_hz = dev->spi_clk_hz;
+
+    // The clock of an ESP-IDF SPI device is fixed, so the device is added to the bus again.
+    esp_idf_release_bus(dev);
+    spi_bus_remove_device(dev->spi_handle);
+    dev->spi_clk_hz = (int)hz;
+    if (esp_idf_add_device(dev) == LT_OK) {
+        return LT_OK;
+    }
+
+    dev->spi_clk_hz = old_hz;
+    if (esp_idf_add_device(dev) != LT_OK) {
+        LT_LOG_ERROR("SPI device could not be added back at %d Hz!", old_hz);
+    }
+
+    return LT_FAIL;
+}
+#endif
+
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void) { return (uint64_t)esp_timer_get_time(); }
+#endif
+
 lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
 {
     LT_UNUSED(s2);
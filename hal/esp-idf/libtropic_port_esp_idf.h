@@ -9,6 +9,9 @@
  * @license For the license see LICENSE.md in the root directory of this source tree.
  */
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
 #include "freertos/FreeRTOS.h"
@@ -33,6 +36,20 @@ typedef struct lt_dev_esp_idf_t {
     gpio_num_t spi_clk_pin;
     /** @brief @public SPI CLK frequency (Hz). */
     int spi_clk_hz;
+    /**
+     * @brief @public Let the SPI peripheral drive the chip select pin instead of GPIO calls.
+     *
+     * @note The bus is acquired for a whole L1 frame and chip select is kept active between transactions with
+     *       `SPI_TRANS_CS_KEEP_ACTIVE`, so the segments of the frame are queued back-to-back.
+     */
+    bool spi_cs_hw;
+    /**
+     * @brief @public Frames of at most this many bytes are transferred by polling instead of queued transactions.
+     *
+     * @note Polling saves the interrupt and task switch overhead, which for short frames (e.g. CHIP_STATUS
+     *       polling in L1) is much larger than the transfer itself. If set to zero, it defaults to 16.
+     */
+    uint16_t spi_polling_max_len;
 #if LT_USE_INT_PIN
     /** @brief @public GPIO pin connected to TROPIC01's interrupt pin. */
     gpio_num_t int_gpio_pin;
@@ -40,6 +57,12 @@ typedef struct lt_dev_esp_idf_t {
 
     /** @brief @private SPI handle. */
     spi_device_handle_t spi_handle;
+    /** @brief @private DMA capable buffer the transactions are done from. */
+    uint8_t *dma_buff;
+    /** @brief @private SPI bus is acquired for the current L1 frame. */
+    bool bus_acquired;
+    /** @brief @private Last transaction kept the hardware chip select active. */
+    bool cs_active;
 #if LT_USE_INT_PIN
     /** @brief @private Semaphore for the TROPIC01's interrupt pin. */
     SemaphoreHandle_t int_gpio_sem;
@@ -0,0 +1,173 @@
+/**
+ * @file libtropic_linux_crypto_worker.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Pool of threads executing AES-GCM works of the signing queue (LT_CRYPTO_WORKER), so the thread driving the
+ * TROPIC01 devices only transfers frames.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_linux_crypto_worker.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+
+LT_STATIC_ASSERT((LT_LINUX_CRYPTO_WORKER_QUEUE_LEN >= 1) && (LT_LINUX_CRYPTO_WORKER_QUEUE_LEN <= 255))
+LT_STATIC_ASSERT((LT_LINUX_CRYPTO_WORKER_MAX_THREADS >= 1) && (LT_LINUX_CRYPTO_WORKER_MAX_THREADS <= 255))
+
+/**
+ * @brief Executes queued works until the worker is stopped and the queue is empty.
+ *
+ * @param arg  Crypto worker structure
+ * @return     NULL
+ */
+static void *lt_linux_crypto_worker_thread(void *arg)
+{
+    lt_linux_crypto_worker_t *w = (lt_linux_crypto_worker_t *)arg;
+    const uint64_t one = 1;
+
+    pthread_mutex_lock(&w->lock);
+    for (;;) {
+        while (!w->cnt && !w->stopping) {
+            pthread_cond_wait(&w->not_empty, &w->lock);
+        }
+        if (!w->cnt) {
+            break;
+        }
+
+        lt_crypto_work_t *work = w->works[w->head];
+        w->head = (uint8_t)((w->head + 1) % LT_LINUX_CRYPTO_WORKER_QUEUE_LEN);
+        w->cnt--;
+
+        pthread_mutex_unlock(&w->lock);
+        lt_crypto_work_run(work);
+        // Counter only wakes up the poll loop, a failed write is caught by its next periodic poll.
+        (void)!write(w->event_fd, &one, sizeof(one));
+        pthread_mutex_lock(&w->lock);
+    }
+    pthread_mutex_unlock(&w->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Stops and joins the started threads, releases the rest of the worker.
+ *
+ * @param w  Crypto worker structure
+ */
+static void lt_linux_crypto_worker_cleanup(lt_linux_crypto_worker_t *w)
+{
+    pthread_mutex_lock(&w->lock);
+    w->stopping = true;
+    pthread_cond_broadcast(&w->not_empty);
+    pthread_mutex_unlock(&w->lock);
+
+    for (uint8_t i = 0; i < w->thread_cnt; i++) {
+        pthread_join(w->threads[i], NULL);
+    }
+    w->thread_cnt = 0;
+
+    pthread_cond_destroy(&w->not_empty);
+    pthread_mutex_destroy(&w->lock);
+    close(w->event_fd);
+    w->event_fd = -1;
+}
+
+lt_ret_t lt_linux_crypto_worker_start(lt_linux_crypto_worker_t *w, const uint8_t thread_cnt)
+{
+    if (!w || !thread_cnt || (thread_cnt > LT_LINUX_CRYPTO_WORKER_MAX_THREADS)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(w, 0, sizeof(*w));
+    w->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (w->event_fd < 0) {
+        LT_LOG_ERROR("eventfd() failed: %s", strerror(errno));
+        return LT_FAIL;
+    }
+
+    if (pthread_mutex_init(&w->lock, NULL) != 0) {
+        goto close_fd;
+    }
+    if (pthread_cond_init(&w->not_empty, NULL) != 0) {
+        goto destroy_lock;
+    }
+
+    for (uint8_t i = 0; i < thread_cnt; i++) {
+        int err = pthread_create(&w->threads[i], NULL, lt_linux_crypto_worker_thread, w);
+        if (err != 0) {
+            LT_LOG_ERROR("pthread_create() failed: %s", strerror(err));
+            lt_linux_crypto_worker_cleanup(w);
+            return LT_FAIL;
+        }
+        w->thread_cnt++;
+    }
+
+    return LT_OK;
+
+destroy_lock:
+    pthread_mutex_destroy(&w->lock);
+close_fd:
+    close(w->event_fd);
+    w->event_fd = -1;
+
+    return LT_FAIL;
+}
+
+lt_ret_t lt_linux_crypto_worker_stop(lt_linux_crypto_worker_t *w)
+{
+    if (!w) {
+        return LT_PARAM_ERR;
+    }
+
+    pthread_mutex_lock(&w->lock);
+    bool stopping = w->stopping;
+    pthread_mutex_unlock(&w->lock);
+    if (stopping) {
+        return LT_FAIL;
+    }
+
+    lt_linux_crypto_worker_cleanup(w);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_crypto_worker_submit(void *worker_ctx, lt_crypto_work_t *work)
+{
+    lt_linux_crypto_worker_t *w = (lt_linux_crypto_worker_t *)worker_ctx;
+
+    if (!w || !work) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = LT_FAIL;
+
+    pthread_mutex_lock(&w->lock);
+    if ((w->cnt < LT_LINUX_CRYPTO_WORKER_QUEUE_LEN) && !w->stopping) {
+        w->works[(w->head + w->cnt) % LT_LINUX_CRYPTO_WORKER_QUEUE_LEN] = work;
+        w->cnt++;
+        pthread_cond_signal(&w->not_empty);
+        ret = LT_OK;
+    }
+    pthread_mutex_unlock(&w->lock);
+
+    return ret;
+}
+
+int lt_linux_crypto_worker_get_fd(const lt_linux_crypto_worker_t *w)
+{
+    if (!w) {
+        return -1;
+    }
+
+    return w->event_fd;
+}
@@ -0,0 +1,104 @@
+#ifndef LIBTROPIC_LINUX_CRYPTO_WORKER_H
+#define LIBTROPIC_LINUX_CRYPTO_WORKER_H
+
+/**
+ * @file libtropic_linux_crypto_worker.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Pool of threads executing AES-GCM works of the signing queue (LT_CRYPTO_WORKER), so the thread driving the
+ * TROPIC01 devices only transfers frames.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Max number of threads of one crypto worker. */
+#ifndef LT_LINUX_CRYPTO_WORKER_MAX_THREADS
+#define LT_LINUX_CRYPTO_WORKER_MAX_THREADS 8
+#endif
+
+/** Max number of works waiting in the queue of one crypto worker. */
+#ifndef LT_LINUX_CRYPTO_WORKER_QUEUE_LEN
+#define LT_LINUX_CRYPTO_WORKER_QUEUE_LEN 32
+#endif
+
+/**
+ * @brief Crypto worker structure. Contents are private.
+ */
+typedef struct lt_linux_crypto_worker_t {
+    /** @private @brief Worker threads. */
+    pthread_t threads[LT_LINUX_CRYPTO_WORKER_MAX_THREADS];
+    /** @private @brief Number of started threads. */
+    uint8_t thread_cnt;
+    /** @private @brief Protects the queue. */
+    pthread_mutex_t lock;
+    /** @private @brief Signalled when a work is queued or the worker is stopped. */
+    pthread_cond_t not_empty;
+    /** @private @brief Waiting works, ring buffer. */
+    lt_crypto_work_t *works[LT_LINUX_CRYPTO_WORKER_QUEUE_LEN];
+    /** @private @brief Index of the oldest waiting work. */
+    uint8_t head;
+    /** @private @brief Number of waiting works. */
+    uint8_t cnt;
+    /** @private @brief No more works are accepted, the threads exit when the queue is empty. */
+    bool stopping;
+    /** @private @brief eventfd signalled when a work is done. */
+    int event_fd;
+} lt_linux_crypto_worker_t;
+
+/**
+ * @brief Starts the threads of the crypto worker.
+ *
+ * @param w            Crypto worker structure
+ * @param thread_cnt   Number of threads, 1 - `LT_LINUX_CRYPTO_WORKER_MAX_THREADS`
+ * @retval             LT_OK Function executed successfully
+ * @retval             other Function did not execute successully
+ */
+lt_ret_t lt_linux_crypto_worker_start(lt_linux_crypto_worker_t *w, const uint8_t thread_cnt);
+
+/**
+ * @brief Stops the crypto worker after the queued works are done and joins its threads.
+ * @details Works submitted while stopping are refused, so the signing queue executes them itself. Afterwards the
+ * worker structure must not be used, except by `lt_linux_crypto_worker_start()`.
+ *
+ * @param w  Crypto worker structure
+ * @retval   LT_OK Function executed successfully
+ * @retval   other Function did not execute successully
+ */
+lt_ret_t lt_linux_crypto_worker_stop(lt_linux_crypto_worker_t *w);
+
+/**
+ * @brief Queues the work, pass it with the worker structure to `lt_sign_queue_set_crypto_worker()`. Safe to call
+ * from any thread.
+ *
+ * @param worker_ctx  Crypto worker structure
+ * @param work        Work executed by one of the threads
+ * @retval            LT_OK Work was queued
+ * @retval            LT_FAIL Queue is full (`LT_LINUX_CRYPTO_WORKER_QUEUE_LEN` works) or the worker is stopped
+ * @retval            other Function did not execute successully
+ */
+lt_ret_t lt_linux_crypto_worker_submit(void *worker_ctx, lt_crypto_work_t *work);
+
+/**
+ * @brief Returns eventfd which becomes readable when a work is done.
+ * @details Register it in the poll loop of the application and call `lt_sign_queue_process()` when it is readable,
+ * after reading the eventfd counter to clear it.
+ *
+ * @param w  Crypto worker structure
+ * @return   File descriptor, -1 if the worker is NULL
+ */
+int lt_linux_crypto_worker_get_fd(const lt_linux_crypto_worker_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_LINUX_CRYPTO_WORKER_H
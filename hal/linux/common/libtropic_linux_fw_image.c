@@ -0,0 +1,126 @@
+/**
+ * @file libtropic_linux_fw_image.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Memory-mapped firmware update image, streamed to TROPIC01 by lt_do_mutable_fw_update_stream().
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_linux_fw_image.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+
+/**
+ * @brief Position of one update in the mapped image.
+ */
+typedef struct lt_linux_fw_image_cursor_t {
+    /** @brief Mapped image. */
+    const lt_linux_fw_image_t *image;
+    /** @brief Offset of the next part to read. */
+    size_t pos;
+} lt_linux_fw_image_cursor_t;
+
+/**
+ * @brief Reader passed to lt_do_mutable_fw_update_stream(), see lt_fw_update_reader_t.
+ */
+static lt_ret_t lt_linux_fw_image_read(void *reader_ctx, uint8_t *buf, const uint16_t len)
+{
+    lt_linux_fw_image_cursor_t *cursor = reader_ctx;
+
+    if (len > cursor->image->size - cursor->pos) {
+        LT_LOG_ERROR("Firmware image is truncated!");
+        return LT_PARAM_ERR;
+    }
+
+    memcpy(buf, cursor->image->data + cursor->pos, len);
+    cursor->pos += len;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_fw_image_open(lt_linux_fw_image_t *image, const char *path)
+{
+    if (!image || !path) {
+        return LT_PARAM_ERR;
+    }
+
+    image->data = NULL;
+    image->size = 0;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LT_LOG_ERROR("Can't open %s: %s", path, strerror(errno));
+        return LT_FAIL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        LT_LOG_ERROR("fstat() failed: %s", strerror(errno));
+        close(fd);
+        return LT_FAIL;
+    }
+
+    // Size of the image is passed as uint32_t to the update.
+    if ((st.st_size <= 0) || ((uint64_t)st.st_size > UINT32_MAX)) {
+        LT_LOG_ERROR("Invalid size of firmware image %s!", path);
+        close(fd);
+        return LT_PARAM_ERR;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // Mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (data == MAP_FAILED) {
+        LT_LOG_ERROR("mmap() failed: %s", strerror(errno));
+        return LT_FAIL;
+    }
+
+    // Image is read once from start to end, let the kernel read ahead. Only a hint, failure is harmless.
+    int ret_unused = madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+    LT_UNUSED(ret_unused);
+
+    image->data = data;
+    image->size = (size_t)st.st_size;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_fw_image_close(lt_linux_fw_image_t *image)
+{
+    if (!image) {
+        return LT_PARAM_ERR;
+    }
+
+    if (image->data) {
+        if (munmap((void *)image->data, image->size) != 0) {
+            LT_LOG_ERROR("munmap() failed: %s", strerror(errno));
+            return LT_FAIL;
+        }
+        image->data = NULL;
+        image->size = 0;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_fw_image_update(lt_handle_t *h, const lt_linux_fw_image_t *image, const lt_bank_id_t bank_id)
+{
+    if (!h || !image || !image->data) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_linux_fw_image_cursor_t cursor = {.image = image, .pos = 0};
+
+    return lt_do_mutable_fw_update_stream(h, lt_linux_fw_image_read, &cursor, (uint32_t)image->size, bank_id);
+}
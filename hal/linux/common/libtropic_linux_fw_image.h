@@ -0,0 +1,70 @@
+#ifndef LIBTROPIC_LINUX_FW_IMAGE_H
+#define LIBTROPIC_LINUX_FW_IMAGE_H
+
+/**
+ * @file libtropic_linux_fw_image.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Memory-mapped firmware update image, streamed to TROPIC01 by lt_do_mutable_fw_update_stream().
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Firmware update image mapped read-only from a file. Contents are private.
+ * @details The image is not modified by updates, so one mapped image can be used for any number of devices, also
+ * from several threads at once. All mappings of the same file share the page cache.
+ */
+typedef struct lt_linux_fw_image_t {
+    /** @private @brief Mapped contents of the file, NULL if not mapped. */
+    const uint8_t *data;
+    /** @private @brief Size of the file. */
+    size_t size;
+} lt_linux_fw_image_t;
+
+/**
+ * @brief Maps firmware update image (e.g. `fw_CPU.bin` from TROPIC01_fw_update_files) from a file.
+ *
+ * @param image  Image structure
+ * @param path   Path to the file
+ * @retval       LT_OK Function executed successfully
+ * @retval       LT_PARAM_ERR File is empty or too big for the update
+ * @retval       other Function did not execute successully
+ */
+lt_ret_t lt_linux_fw_image_open(lt_linux_fw_image_t *image, const char *path);
+
+/**
+ * @brief Unmaps the image.
+ *
+ * @param image  Image structure
+ * @retval       LT_OK Function executed successfully
+ * @retval       other Function did not execute successully
+ */
+lt_ret_t lt_linux_fw_image_close(lt_linux_fw_image_t *image);
+
+/**
+ * @brief Updates mutable firmware of TROPIC01 with the mapped image.
+ * @details Image is passed to lt_do_mutable_fw_update_stream(), parts of the image are copied from the mapping right
+ * to the L2 buffer, pages of the file are read on demand.
+ *
+ * @param h        Handle for communication with TROPIC01
+ * @param image    Mapped image
+ * @param bank_id  Bank ID where the update should be applied, see lt_do_mutable_fw_update_stream()
+ * @retval         LT_OK Function executed successfully
+ * @retval         other Function did not execute successully
+ */
+lt_ret_t lt_linux_fw_image_update(lt_handle_t *h, const lt_linux_fw_image_t *image, const lt_bank_id_t bank_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_LINUX_FW_IMAGE_H
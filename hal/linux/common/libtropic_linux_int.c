@@ -0,0 +1,133 @@
+/**
+ * @file libtropic_linux_int.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Waiting for the INT pin of TROPIC01 through the GPIO character device, for the Linux HALs.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_linux_int.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libtropic_common.h"
+#include "libtropic_linux_sleep.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+
+/** Time lt_linux_int_wait() busy-waits before poll(), set per thread by lt_linux_int_set_spin_us(). */
+static _Thread_local uint32_t lt_linux_int_spin_us;
+
+/**
+ * @brief Reads all pending edge events of the line request.
+ *
+ * @param int_fd  File descriptor of the INT pin line request
+ * @return        Number of events read, 0 if none was pending, -1 on error
+ */
+static int lt_linux_int_drain(const int int_fd)
+{
+    struct gpio_v2_line_event events[LT_LINUX_INT_EVENTS];
+    int cnt = 0;
+
+    for (;;) {
+        ssize_t ret = read(int_fd, events, sizeof(events));
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN) {
+                return cnt;
+            }
+#if EWOULDBLOCK != EAGAIN
+            if (errno == EWOULDBLOCK) {
+                return cnt;
+            }
+#endif
+            LT_LOG_ERROR("read() on INT pin failed: %s", strerror(errno));
+            return -1;
+        }
+        if ((ret == 0) || ((size_t)ret % sizeof(events[0]))) {
+            LT_LOG_ERROR("read() on INT pin returned unexpected size: %zd", ret);
+            return -1;
+        }
+        cnt += (int)((size_t)ret / sizeof(events[0]));
+        // Short read, the kernel FIFO is empty now.
+        if ((size_t)ret < sizeof(events)) {
+            return cnt;
+        }
+    }
+}
+
+lt_ret_t lt_linux_int_setup(int int_fd)
+{
+    int flags = fcntl(int_fd, F_GETFL);
+
+    if ((flags < 0) || (fcntl(int_fd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+        LT_LOG_ERROR("fcntl() on INT pin failed: %s", strerror(errno));
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+void lt_linux_int_set_spin_us(uint32_t us) { lt_linux_int_spin_us = us; }
+
+lt_ret_t lt_linux_int_wait(int int_fd, uint32_t ms)
+{
+    struct pollfd pfd = {.fd = int_fd, .events = POLLIN | POLLPRI, .revents = 0};
+    const uint64_t deadline_us = lt_linux_time_us() + (uint64_t)ms * 1000;
+    int cnt;
+
+    // Edge came before the wait, e.g. while the previous frame was transferred.
+    cnt = lt_linux_int_drain(int_fd);
+    if (cnt != 0) {
+        return (cnt > 0) ? LT_OK : LT_FAIL;
+    }
+
+    // Edge coming soon is taken without the wake-up from poll(), which costs a scheduler round-trip.
+    if (lt_linux_int_spin_us) {
+        const uint64_t spin_end_us = lt_linux_time_us() + lt_min((uint64_t)lt_linux_int_spin_us, (uint64_t)ms * 1000);
+        do {
+            cnt = lt_linux_int_drain(int_fd);
+            if (cnt != 0) {
+                return (cnt > 0) ? LT_OK : LT_FAIL;
+            }
+        } while (lt_linux_time_us() < spin_end_us);
+    }
+
+    for (;;) {
+        uint64_t now_us = lt_linux_time_us();
+        int timeout_ms = (now_us < deadline_us) ? (int)((deadline_us - now_us + 999) / 1000) : 0;
+
+        pfd.revents = 0;
+        int ret = poll(&pfd, 1, timeout_ms);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LT_LOG_ERROR("poll() on INT pin failed: %s", strerror(errno));
+            return LT_FAIL;
+        }
+        if (ret == 0) {
+            return LT_L1_INT_TIMEOUT;
+        }
+        if (!(pfd.revents & (POLLIN | POLLPRI))) {
+            LT_LOG_ERROR("poll() on INT pin returned unexpected revents: 0x%x", (unsigned)pfd.revents);
+            return LT_FAIL;
+        }
+
+        cnt = lt_linux_int_drain(int_fd);
+        if (cnt != 0) {
+            return (cnt > 0) ? LT_OK : LT_FAIL;
+        }
+        // Readable without an event (consumed by another reader), keep waiting.
+    }
+}
+
+lt_ret_t lt_linux_int_clear(int int_fd) { return (lt_linux_int_drain(int_fd) < 0) ? LT_FAIL : LT_OK; }
@@ -0,0 +1,71 @@
+#ifndef LIBTROPIC_LINUX_INT_H
+#define LIBTROPIC_LINUX_INT_H
+
+/**
+ * @file libtropic_linux_int.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Waiting for the INT pin of TROPIC01 through the GPIO character device, for the Linux HALs.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef LT_LINUX_INT_EVENTS
+/** Edge events consumed by one read() of the line request. */
+#define LT_LINUX_INT_EVENTS 16
+#endif
+
+/**
+ * @brief Switches the line request of the INT pin to non-blocking reads.
+ * @details Afterwards an edge which is already pending is consumed by a single read(), without poll().
+ *
+ * @param int_fd  File descriptor of the INT pin line request
+ * @retval        LT_OK Function executed successfully
+ * @retval        LT_FAIL fcntl() failed
+ */
+lt_ret_t lt_linux_int_setup(int int_fd);
+
+/**
+ * @brief Sets how long `lt_linux_int_wait()` called by this thread busy-waits for the edge before it sleeps in poll().
+ * @details Meant for a thread pinned to its own CPU (see `libtropic_linux_io_thread.h`), which then does not wait for
+ * the scheduler when the edge comes within the time. Other threads keep sleeping right away.
+ *
+ * @param us  Time to busy-wait in microseconds, 0 to sleep right away
+ */
+void lt_linux_int_set_spin_us(uint32_t us);
+
+/**
+ * @brief Waits for a rising edge on the INT pin and consumes all pending edge events.
+ * @details Pending edge is taken by one read(). Otherwise the line is read without waiting for the time set by
+ * `lt_linux_int_set_spin_us()`, then it is polled and the events are read at once, poll() interrupted by a signal is
+ * resumed with the remaining time.
+ *
+ * @param int_fd  File descriptor of the INT pin line request, set up by lt_linux_int_setup()
+ * @param ms      Longest wait in milliseconds
+ * @retval        LT_OK Edge occurred
+ * @retval        LT_L1_INT_TIMEOUT No edge within the time
+ * @retval        LT_FAIL poll() or read() failed
+ */
+lt_ret_t lt_linux_int_wait(int int_fd, uint32_t ms);
+
+/**
+ * @brief Consumes all pending edge events of the INT pin without waiting.
+ *
+ * @param int_fd  File descriptor of the INT pin line request, set up by lt_linux_int_setup()
+ * @retval        LT_OK Function executed successfully
+ * @retval        LT_FAIL read() failed
+ */
+lt_ret_t lt_linux_int_clear(int int_fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_LINUX_INT_H
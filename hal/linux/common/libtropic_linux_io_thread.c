@@ -0,0 +1,343 @@
+/**
+ * @file libtropic_linux_io_thread.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Dedicated I/O thread of one SPI bus: requests of the TROPIC01 devices on the bus are handed over lock-free
+ * and executed by one thread, optionally with real-time priority, CPU affinity and locked memory.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+// CPU affinity of the thread attributes.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "libtropic_linux_io_thread.h"
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#if LT_USE_INT_PIN
+#include "libtropic_linux_int.h"
+#endif
+#include "libtropic_linux_sleep.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+
+LT_STATIC_ASSERT((LT_LINUX_IO_THREAD_QUEUE_LEN >= 2) && (LT_LINUX_IO_THREAD_QUEUE_LEN <= 256)
+                 && !(LT_LINUX_IO_THREAD_QUEUE_LEN & (LT_LINUX_IO_THREAD_QUEUE_LEN - 1)))
+
+/** States of `state` of the request. */
+#define LT_LINUX_IO_THREAD_REQ_PENDING 0
+#define LT_LINUX_IO_THREAD_REQ_SLEEPING 1
+#define LT_LINUX_IO_THREAD_REQ_DONE 2
+
+/**
+ * @brief Sleeps while the futex word holds the value, or until woken up.
+ *
+ * @param word  Futex word
+ * @param val   Value of the word the caller saw
+ */
+static void lt_linux_io_thread_futex_wait(uint32_t *word, const uint32_t val)
+{
+    // EAGAIN (the word changed) and EINTR are handled by the loops of the callers.
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+/**
+ * @brief Wakes up one thread sleeping on the futex word.
+ *
+ * @param word  Futex word
+ */
+static void lt_linux_io_thread_futex_wake(uint32_t *word)
+{
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+/**
+ * @brief Tells whether a request waits in the submission ring. Called by the I/O thread only.
+ *
+ * @param io  I/O thread structure
+ * @return    true if the ring is empty
+ */
+static bool lt_linux_io_thread_empty(const lt_linux_io_thread_t *io) { return !lt_mpsc_ring_count(&io->sq); }
+
+/**
+ * @brief Executes the request and hands the result over to its caller.
+ *
+ * @param io   I/O thread structure
+ * @param req  Request
+ */
+static void lt_linux_io_thread_exec(lt_linux_io_thread_t *io, lt_linux_io_thread_req_t *req)
+{
+    req->ret = req->fn(req->h, req->ctx);
+    io->executed++;
+
+    if (req->cq) {
+        // Backpressure of a completion ring too small for the submitted requests, the consumer frees it.
+        while (lt_spsc_ring_push(req->cq, req) == LT_RING_FULL) {
+            sched_yield();
+        }
+        return;
+    }
+
+    // The caller may return as soon as it sees the result, the wake-up of a stale futex word is harmless.
+    uint32_t *state = &req->state;
+    if (__atomic_exchange_n(state, LT_LINUX_IO_THREAD_REQ_DONE, __ATOMIC_ACQ_REL) == LT_LINUX_IO_THREAD_REQ_SLEEPING) {
+        lt_linux_io_thread_futex_wake(state);
+    }
+}
+
+/**
+ * @brief Waits for a request, spinning for `spin_us` of the configuration first.
+ *
+ * @param io  I/O thread structure
+ */
+static void lt_linux_io_thread_idle(lt_linux_io_thread_t *io)
+{
+    if (io->cfg.spin_us) {
+        const uint64_t spin_end_us = lt_linux_time_us() + io->cfg.spin_us;
+        do {
+            if (!lt_linux_io_thread_empty(io) || __atomic_load_n(&io->stopping, __ATOMIC_ACQUIRE)) {
+                return;
+            }
+        } while (lt_linux_time_us() < spin_end_us);
+    }
+
+    const uint32_t wake = __atomic_load_n(&io->wake, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&io->sleeping, 1, __ATOMIC_SEQ_CST);
+    // Pairs with the fence of lt_linux_io_thread_call(): either the caller sees `sleeping`, or we see its request.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (lt_linux_io_thread_empty(io) && !__atomic_load_n(&io->stopping, __ATOMIC_SEQ_CST)) {
+        io->sleeps++;
+        lt_linux_io_thread_futex_wait(&io->wake, wake);
+    }
+    __atomic_store_n(&io->sleeping, 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Executes queued requests until the I/O thread is stopped and the queue is empty.
+ *
+ * @param arg  I/O thread structure
+ * @return     NULL
+ */
+static void *lt_linux_io_thread_main(void *arg)
+{
+    lt_linux_io_thread_t *io = (lt_linux_io_thread_t *)arg;
+
+#if LT_USE_INT_PIN
+    lt_linux_int_set_spin_us(io->cfg.spin_us);
+#endif
+
+    for (;;) {
+        lt_linux_io_thread_req_t *req = (lt_linux_io_thread_req_t *)lt_mpsc_ring_pop(&io->sq);
+        if (req) {
+            lt_linux_io_thread_exec(io, req);
+            continue;
+        }
+
+        // Callers which saw `stopping` unset are still let in, their requests are executed before exiting.
+        if (__atomic_load_n(&io->stopping, __ATOMIC_SEQ_CST) && !__atomic_load_n(&io->entering, __ATOMIC_SEQ_CST)) {
+            req = (lt_linux_io_thread_req_t *)lt_mpsc_ring_pop(&io->sq);
+            if (!req) {
+                break;
+            }
+            lt_linux_io_thread_exec(io, req);
+            continue;
+        }
+
+        lt_linux_io_thread_idle(io);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Wakes up the I/O thread if it sleeps.
+ *
+ * @param io  I/O thread structure
+ */
+static void lt_linux_io_thread_kick(lt_linux_io_thread_t *io)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&io->sleeping, __ATOMIC_SEQ_CST)) {
+        __atomic_add_fetch(&io->wake, 1, __ATOMIC_RELEASE);
+        lt_linux_io_thread_futex_wake(&io->wake);
+    }
+}
+
+lt_ret_t lt_linux_io_thread_start(lt_linux_io_thread_t *io, const lt_linux_io_thread_cfg_t *cfg)
+{
+    const lt_linux_io_thread_cfg_t cfg_default = {.sched_priority = 0, .cpu = -1, .mlock = false, .spin_us = 0};
+
+    if (!io) {
+        return LT_PARAM_ERR;
+    }
+    if (!cfg) {
+        cfg = &cfg_default;
+    }
+    if ((cfg->sched_priority < 0) || (cfg->sched_priority > sched_get_priority_max(SCHED_FIFO)) || (cfg->cpu < -1)
+        || (cfg->cpu >= CPU_SETSIZE)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(io, 0, sizeof(*io));
+    io->cfg = *cfg;
+    lt_ret_t ret = lt_mpsc_ring_init(&io->sq, io->sq_slots, LT_LINUX_IO_THREAD_QUEUE_LEN);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Locked for the whole process and left locked on failure, as other users may rely on it as well.
+    if (cfg->mlock && (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)) {
+        LT_LOG_ERROR("mlockall() failed: %s", strerror(errno));
+        return LT_FAIL;
+    }
+
+    pthread_attr_t attr;
+    if (pthread_attr_init(&attr) != 0) {
+        return LT_FAIL;
+    }
+
+    int err = 0;
+    if (cfg->sched_priority) {
+        struct sched_param param = {.sched_priority = cfg->sched_priority};
+        err = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        if (!err) {
+            err = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        }
+        if (!err) {
+            err = pthread_attr_setschedparam(&attr, &param);
+        }
+    }
+    if (!err && (cfg->cpu >= 0)) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET((size_t)cfg->cpu, &cpus);
+        err = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+    if (!err) {
+        // EPERM without the privilege of the real-time policy, EINVAL for a CPU which is not online.
+        err = pthread_create(&io->thread, &attr, lt_linux_io_thread_main, io);
+    }
+    pthread_attr_destroy(&attr);
+
+    if (err) {
+        LT_LOG_ERROR("Starting I/O thread failed: %s", strerror(err));
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_io_thread_stop(lt_linux_io_thread_t *io)
+{
+    if (!io || pthread_equal(pthread_self(), io->thread)) {
+        return LT_PARAM_ERR;
+    }
+
+    if (__atomic_exchange_n(&io->stopping, true, __ATOMIC_SEQ_CST)) {
+        return LT_FAIL;
+    }
+    __atomic_add_fetch(&io->wake, 1, __ATOMIC_RELEASE);
+    lt_linux_io_thread_futex_wake(&io->wake);
+
+    pthread_join(io->thread, NULL);
+
+    return LT_OK;
+}
+
+/**
+ * @brief Pushes the request to the submission ring, unless the I/O thread is stopped.
+ *
+ * @param io    I/O thread structure
+ * @param req   Request
+ * @param wait  Yield the CPU while the ring is full instead of returning LT_RING_FULL
+ * @retval      LT_OK Request was queued
+ * @retval      LT_RING_FULL Ring is full
+ * @retval      LT_FAIL I/O thread is stopped
+ */
+static lt_ret_t lt_linux_io_thread_enter(lt_linux_io_thread_t *io, lt_linux_io_thread_req_t *req, const bool wait)
+{
+    __atomic_add_fetch(&io->entering, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&io->stopping, __ATOMIC_SEQ_CST)) {
+        __atomic_sub_fetch(&io->entering, 1, __ATOMIC_SEQ_CST);
+        return LT_FAIL;
+    }
+
+    lt_ret_t ret;
+    while (((ret = lt_mpsc_ring_push(&io->sq, req)) == LT_RING_FULL) && wait) {
+        lt_linux_io_thread_kick(io);
+        sched_yield();
+    }
+    __atomic_sub_fetch(&io->entering, 1, __ATOMIC_SEQ_CST);
+    if (ret == LT_OK) {
+        lt_linux_io_thread_kick(io);
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_linux_io_thread_call(lt_linux_io_thread_t *io, lt_handle_t *h, lt_linux_io_thread_fn_t fn, void *ctx)
+{
+    if (!io || !fn) {
+        return LT_PARAM_ERR;
+    }
+
+    // Request calling the I/O thread already runs on it, queueing would deadlock.
+    if (pthread_equal(pthread_self(), io->thread)) {
+        return fn(h, ctx);
+    }
+
+    lt_linux_io_thread_req_t req
+        = {.h = h, .fn = fn, .ctx = ctx, .ret = LT_FAIL, .cq = NULL, .state = LT_LINUX_IO_THREAD_REQ_PENDING};
+    lt_ret_t ret = lt_linux_io_thread_enter(io, &req, true);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Short requests finish before the caller would be woken up from a sleep.
+    const uint64_t spin_end_us = lt_linux_time_us() + LT_LINUX_IO_THREAD_CALL_SPIN_US;
+    while (__atomic_load_n(&req.state, __ATOMIC_ACQUIRE) != LT_LINUX_IO_THREAD_REQ_DONE) {
+        if (lt_linux_time_us() >= spin_end_us) {
+            uint32_t pending = LT_LINUX_IO_THREAD_REQ_PENDING;
+            __atomic_compare_exchange_n(&req.state, &pending, LT_LINUX_IO_THREAD_REQ_SLEEPING, false, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE);
+            while (__atomic_load_n(&req.state, __ATOMIC_ACQUIRE) != LT_LINUX_IO_THREAD_REQ_DONE) {
+                lt_linux_io_thread_futex_wait(&req.state, LT_LINUX_IO_THREAD_REQ_SLEEPING);
+            }
+            break;
+        }
+    }
+
+    return req.ret;
+}
+
+lt_ret_t lt_linux_io_thread_submit(lt_linux_io_thread_t *io, lt_linux_io_thread_req_t *req, lt_spsc_ring_t *cq)
+{
+    if (!io || !req || !req->fn || !cq) {
+        return LT_PARAM_ERR;
+    }
+
+    req->ret = LT_FAIL;
+    req->cq = cq;
+
+    return lt_linux_io_thread_enter(io, req, false);
+}
+
+#ifdef LT_POOL
+lt_ret_t lt_linux_io_thread_pool_exec(void *exec_ctx, lt_handle_t *h, lt_pool_op_t op, void *op_ctx)
+{
+    return lt_linux_io_thread_call((lt_linux_io_thread_t *)exec_ctx, h, op, op_ctx);
+}
+#endif
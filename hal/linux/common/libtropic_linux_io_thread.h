@@ -0,0 +1,181 @@
+#ifndef LIBTROPIC_LINUX_IO_THREAD_H
+#define LIBTROPIC_LINUX_IO_THREAD_H
+
+/**
+ * @file libtropic_linux_io_thread.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Dedicated I/O thread of one SPI bus: requests of the TROPIC01 devices on the bus are handed over lock-free
+ * and executed by one thread, optionally with real-time priority, CPU affinity and locked memory.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Max number of requests waiting for the I/O thread, power of two. */
+#ifndef LT_LINUX_IO_THREAD_QUEUE_LEN
+#define LT_LINUX_IO_THREAD_QUEUE_LEN 16
+#endif
+
+/** Callers of `lt_linux_io_thread_call()` busy-wait this many microseconds for the result before they sleep. */
+#ifndef LT_LINUX_IO_THREAD_CALL_SPIN_US
+#define LT_LINUX_IO_THREAD_CALL_SPIN_US 50
+#endif
+
+/**
+ * @brief Request executed by the I/O thread, e.g. a wrapper of one or more libtropic calls on the handle.
+ *
+ * @param h    Handle passed with the request
+ * @param ctx  User data passed with the request
+ * @return     Result reported to the caller
+ */
+typedef lt_ret_t (*lt_linux_io_thread_fn_t)(lt_handle_t *h, void *ctx);
+
+/**
+ * @brief Request of the I/O thread.
+ */
+typedef struct lt_linux_io_thread_req_t {
+    /** @public @brief Handle passed to the function. */
+    lt_handle_t *h;
+    /** @public @brief Executed function. */
+    lt_linux_io_thread_fn_t fn;
+    /** @public @brief User data of the function. */
+    void *ctx;
+    /** @public @brief Result of the function, valid once the request is popped from its completion ring. */
+    lt_ret_t ret;
+    /** @private @brief Completion ring of `lt_linux_io_thread_submit()`, NULL for `lt_linux_io_thread_call()`. */
+    lt_spsc_ring_t *cq;
+    /** @private @brief Futex word of the caller blocked in `lt_linux_io_thread_call()`. */
+    uint32_t state;
+} lt_linux_io_thread_req_t;
+
+/**
+ * @brief Configuration of the I/O thread, see `lt_linux_io_thread_start()`.
+ */
+typedef struct lt_linux_io_thread_cfg_t {
+    /** @public @brief SCHED_FIFO priority (1-99) of the thread, 0 to keep the scheduling of the starting thread. */
+    int sched_priority;
+    /** @public @brief CPU the thread is pinned to, -1 to let it run on any CPU. */
+    int cpu;
+    /** @public @brief Locks current and future memory of the process by mlockall(), so no page fault delays I/O. */
+    bool mlock;
+    /**
+     * @public @brief Microseconds the thread busy-waits for a request and for the INT pin (`LT_USE_INT_PIN`) before
+     * it sleeps. Meant for a thread pinned to its own CPU, 0 to sleep right away.
+     */
+    uint32_t spin_us;
+} lt_linux_io_thread_cfg_t;
+
+/**
+ * @brief I/O thread structure. Contents are private except the statistics.
+ */
+typedef struct lt_linux_io_thread_t {
+    /** @private @brief I/O thread. */
+    pthread_t thread;
+    /** @private @brief Configuration passed to `lt_linux_io_thread_start()`. */
+    lt_linux_io_thread_cfg_t cfg;
+    /** @private @brief Submission ring of the waiting requests. */
+    lt_mpsc_ring_t sq;
+    /** @private @brief Slots of the submission ring. */
+    lt_mpsc_slot_t sq_slots[LT_LINUX_IO_THREAD_QUEUE_LEN];
+    /** @private @brief Futex word the I/O thread sleeps on, increased to wake it up. */
+    uint32_t wake;
+    /** @private @brief I/O thread sleeps or is about to, accessed atomically. */
+    uint32_t sleeping;
+    /** @private @brief Callers between checking `stopping` and queueing their request, accessed atomically. */
+    uint32_t entering;
+    /** @private @brief No more requests are accepted, the thread exits when the queue is empty, accessed atomically. */
+    bool stopping;
+    /** @public @brief Number of executed requests. */
+    uint64_t executed;
+    /** @public @brief Number of times the thread went to sleep because no request came while it spun. */
+    uint64_t sleeps;
+} lt_linux_io_thread_t;
+
+/**
+ * @brief Starts the I/O thread with the configuration.
+ * @details All handles of the devices on one SPI bus should be used only by the requests of one I/O thread, which
+ * then serializes the frames on the bus as well. With `mlock`, the memory of the whole process is locked. Real-time
+ * priority and locked memory need the privileges (CAP_SYS_NICE, CAP_IPC_LOCK or limits of RLIMIT_RTPRIO and
+ * RLIMIT_MEMLOCK), the start fails without them.
+ *
+ * @param io   I/O thread structure
+ * @param cfg  Configuration, NULL for the default scheduling without spinning
+ * @retval     LT_OK Function executed successfully
+ * @retval     LT_PARAM_ERR Invalid configuration
+ * @retval     LT_FAIL Thread could not be started with the configuration
+ */
+lt_ret_t lt_linux_io_thread_start(lt_linux_io_thread_t *io, const lt_linux_io_thread_cfg_t *cfg);
+
+/**
+ * @brief Stops the I/O thread after the queued requests are executed and joins it.
+ * @details Requests queued while stopping fail with LT_FAIL. Must not be called by a request. Afterwards the
+ * structure must not be used, except by `lt_linux_io_thread_start()`.
+ *
+ * @param io  I/O thread structure
+ * @retval    LT_OK Function executed successfully
+ * @retval    other Function did not execute successully
+ */
+lt_ret_t lt_linux_io_thread_stop(lt_linux_io_thread_t *io);
+
+/**
+ * @brief Executes the request by the I/O thread and waits for its result. Safe to call from any thread.
+ * @details The request is handed over by the lock-free submission ring (`lt_mpsc_ring_t`). The caller busy-waits for
+ * the result for `LT_LINUX_IO_THREAD_CALL_SPIN_US`, then sleeps until the I/O thread wakes it up. While the ring is
+ * full, the caller yields the CPU. Called from a request, the function is executed right away.
+ *
+ * @param io   I/O thread structure
+ * @param h    Handle passed to the function
+ * @param fn   Function executed by the I/O thread
+ * @param ctx  User data passed to the function
+ * @retval     Result of the function
+ * @retval     LT_FAIL I/O thread is stopped
+ */
+lt_ret_t lt_linux_io_thread_call(lt_linux_io_thread_t *io, lt_handle_t *h, lt_linux_io_thread_fn_t fn, void *ctx);
+
+/**
+ * @brief Queues the request without waiting for it. Safe to call from any thread.
+ * @details When the request is executed, the I/O thread sets its `ret` and pushes it to the completion ring, from
+ * which the caller pops it (e.g. from its event loop). The completion ring must be pushed to only by this I/O thread
+ * and have room for all requests submitted with it, otherwise the I/O thread waits for the consumer. The request must
+ * stay valid until it is popped.
+ *
+ * @param io   I/O thread structure
+ * @param req  Request with `h`, `fn` and `ctx` set
+ * @param cq   Completion ring, initialized by `lt_spsc_ring_init()`
+ * @retval     LT_OK Request was queued
+ * @retval     LT_RING_FULL `LT_LINUX_IO_THREAD_QUEUE_LEN` requests wait already, try again later
+ * @retval     LT_FAIL I/O thread is stopped
+ * @retval     other Function did not execute successully
+ */
+lt_ret_t lt_linux_io_thread_submit(lt_linux_io_thread_t *io, lt_linux_io_thread_req_t *req, lt_spsc_ring_t *cq);
+
+#ifdef LT_POOL
+/**
+ * @brief Executor of the device pool running the operations of a device by the I/O thread, see
+ * `lt_pool_set_executor()`.
+ *
+ * @param exec_ctx  I/O thread structure
+ * @param h         Handle of the device
+ * @param op        Operation of the pool
+ * @param op_ctx    User data of the operation
+ * @retval          Result of the operation
+ * @retval          LT_FAIL I/O thread is stopped
+ */
+lt_ret_t lt_linux_io_thread_pool_exec(void *exec_ctx, lt_handle_t *h, lt_pool_op_t op, void *op_ctx);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_LINUX_IO_THREAD_H
@@ -0,0 +1,210 @@
+/**
+ * @file libtropic_linux_reactor.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief epoll based reactor driving asynchronous L2 operations (LT_L2_ASYNC) of several TROPIC01 devices from one
+ * thread.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_linux_reactor.h"
+
+#include <errno.h>
+#include <linux/gpio.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+
+/**
+ * @brief Consumes pending edge events of the INT pin without waiting.
+ *
+ * @param int_fd  INT pin file descriptor
+ */
+static void lt_linux_reactor_clear_int(const int int_fd)
+{
+    struct pollfd pfd = {.fd = int_fd, .events = POLLIN | POLLPRI, .revents = 0};
+    struct gpio_v2_line_event event;
+
+    while ((poll(&pfd, 1, 0) > 0) && (pfd.revents & (POLLIN | POLLPRI))) {
+        if (read(int_fd, &event, sizeof(event)) != sizeof(event)) {
+            return;
+        }
+        pfd.revents = 0;
+    }
+}
+
+/**
+ * @brief Advances operation of the device, if it is in progress.
+ *
+ * @param dev  Registered device
+ */
+static void lt_linux_reactor_process(lt_linux_reactor_dev_t *dev)
+{
+    if (lt_l2_async_busy(dev->op)) {
+        // Result is reported to the completion callback.
+        lt_ret_t ret_unused = lt_l2_async_process(dev->op);
+        LT_UNUSED(ret_unused);
+    }
+}
+
+lt_ret_t lt_linux_reactor_init(lt_linux_reactor_t *r, int poll_interval_ms)
+{
+    if (!r || (poll_interval_ms <= 0)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(r, 0, sizeof(*r));
+    r->poll_interval_ms = poll_interval_ms;
+    r->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (r->epoll_fd < 0) {
+        LT_LOG_ERROR("epoll_create1() failed: %s", strerror(errno));
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_reactor_deinit(lt_linux_reactor_t *r)
+{
+    if (!r) {
+        return LT_PARAM_ERR;
+    }
+
+    if (r->epoll_fd >= 0) {
+        close(r->epoll_fd);
+        r->epoll_fd = -1;
+    }
+    r->dev_cnt = 0;
+
+    return LT_OK;
+}
+
+/**
+ * @brief Registers the device and its file descriptor.
+ *
+ * @param r             Reactor structure
+ * @param op            Asynchronous L2 operation of the device
+ * @param fd            INT pin or readiness file descriptor, -1 if the device is polled
+ * @param readiness_fd  The file descriptor only signals readiness, it is not read
+ * @return              LT_OK if the device was registered, otherwise other error code
+ */
+static lt_ret_t lt_linux_reactor_register(lt_linux_reactor_t *r, lt_l2_async_t *op, const int fd,
+                                          const bool readiness_fd)
+{
+    if (!r || !op) {
+        return LT_PARAM_ERR;
+    }
+    if (r->dev_cnt >= LT_LINUX_REACTOR_MAX_DEVICES) {
+        LT_LOG_ERROR("Max number of reactor devices (%d) reached", LT_LINUX_REACTOR_MAX_DEVICES);
+        return LT_FAIL;
+    }
+
+    if (fd >= 0) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        // Data of a readiness file descriptor stay unread until the operation consumes them, so only their arrival
+        // is reported.
+        ev.events = readiness_fd ? (EPOLLIN | EPOLLET) : (EPOLLIN | EPOLLPRI);
+        ev.data.u32 = r->dev_cnt;
+        if (epoll_ctl(r->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            LT_LOG_ERROR("epoll_ctl() failed: %s", strerror(errno));
+            return LT_FAIL;
+        }
+    }
+
+    r->devs[r->dev_cnt].op = op;
+    r->devs[r->dev_cnt].int_fd = fd;
+    r->devs[r->dev_cnt].readiness_fd = readiness_fd;
+    r->dev_cnt++;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_reactor_add(lt_linux_reactor_t *r, lt_l2_async_t *op, int int_fd)
+{
+    return lt_linux_reactor_register(r, op, int_fd, false);
+}
+
+lt_ret_t lt_linux_reactor_add_fd(lt_linux_reactor_t *r, lt_l2_async_t *op, int fd)
+{
+    if (fd < 0) {
+        return LT_PARAM_ERR;
+    }
+
+    return lt_linux_reactor_register(r, op, fd, true);
+}
+
+lt_ret_t lt_linux_reactor_run_once(lt_linux_reactor_t *r)
+{
+    if (!r) {
+        return LT_PARAM_ERR;
+    }
+
+    struct epoll_event evs[LT_LINUX_REACTOR_MAX_DEVICES];
+    int n = epoll_wait(r->epoll_fd, evs, LT_LINUX_REACTOR_MAX_DEVICES, r->poll_interval_ms);
+    if (n < 0) {
+        if (errno == EINTR) {
+            return LT_OK;
+        }
+        LT_LOG_ERROR("epoll_wait() failed: %s", strerror(errno));
+        return LT_FAIL;
+    }
+
+    if (n == 0) {
+        // No INT edge within the poll interval, poll all pending operations once.
+        for (uint8_t i = 0; i < r->dev_cnt; i++) {
+            lt_linux_reactor_process(&r->devs[i]);
+        }
+        return LT_OK;
+    }
+
+    for (int i = 0; i < n; i++) {
+        lt_linux_reactor_dev_t *dev = &r->devs[evs[i].data.u32];
+        if (!dev->readiness_fd) {
+            lt_linux_reactor_clear_int(dev->int_fd);
+        }
+        lt_linux_reactor_process(dev);
+    }
+    // Devices without INT pin are polled on every wake-up.
+    for (uint8_t i = 0; i < r->dev_cnt; i++) {
+        if (r->devs[i].int_fd < 0) {
+            lt_linux_reactor_process(&r->devs[i]);
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_reactor_run(lt_linux_reactor_t *r)
+{
+    if (!r) {
+        return LT_PARAM_ERR;
+    }
+
+    while (lt_linux_reactor_pending(r)) {
+        lt_ret_t ret = lt_linux_reactor_run_once(r);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return LT_OK;
+}
+
+uint8_t lt_linux_reactor_pending(const lt_linux_reactor_t *r)
+{
+    uint8_t cnt = 0;
+
+    for (uint8_t i = 0; i < r->dev_cnt; i++) {
+        if (lt_l2_async_busy(r->devs[i].op)) {
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
@@ -0,0 +1,131 @@
+#ifndef LIBTROPIC_LINUX_REACTOR_H
+#define LIBTROPIC_LINUX_REACTOR_H
+
+/**
+ * @file libtropic_linux_reactor.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief epoll based reactor driving asynchronous L2 operations (LT_L2_ASYNC) of several TROPIC01 devices from one
+ * thread.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Max number of devices registered in one reactor. */
+#ifndef LT_LINUX_REACTOR_MAX_DEVICES
+#define LT_LINUX_REACTOR_MAX_DEVICES 8
+#endif
+
+/**
+ * @brief Device registered in the reactor.
+ */
+typedef struct lt_linux_reactor_dev_t {
+    /** @private @brief Asynchronous L2 operation of the device. */
+    lt_l2_async_t *op;
+    /** @private @brief INT pin file descriptor, -1 if the device is polled. */
+    int int_fd;
+    /** @private @brief int_fd only signals readiness (e.g. socket), the reactor does not read it. */
+    bool readiness_fd;
+} lt_linux_reactor_dev_t;
+
+/**
+ * @brief Reactor structure. Contents are private.
+ */
+typedef struct lt_linux_reactor_t {
+    /** @private @brief epoll file descriptor. */
+    int epoll_fd;
+    /** @private @brief Period (ms) of polling devices without INT pin and of the safety poll of the others. */
+    int poll_interval_ms;
+    /** @private @brief Number of registered devices. */
+    uint8_t dev_cnt;
+    /** @private @brief Registered devices. */
+    lt_linux_reactor_dev_t devs[LT_LINUX_REACTOR_MAX_DEVICES];
+} lt_linux_reactor_t;
+
+/**
+ * @brief Initializes the reactor.
+ *
+ * @param r                 Reactor structure
+ * @param poll_interval_ms  Period (ms) of polling devices registered without INT pin. Devices with INT pin are
+ *                          polled with this period too if no INT edge comes (e.g. TROPIC01 in Start-up Mode).
+ * @retval                  LT_OK Function executed successfully
+ * @retval                  other Function did not execute successully
+ */
+lt_ret_t lt_linux_reactor_init(lt_linux_reactor_t *r, int poll_interval_ms);
+
+/**
+ * @brief Deinitializes the reactor. Registered devices and their operations are left untouched.
+ *
+ * @param r  Reactor structure
+ * @retval   LT_OK Function executed successfully
+ * @retval   other Function did not execute successully
+ */
+lt_ret_t lt_linux_reactor_deinit(lt_linux_reactor_t *r);
+
+/**
+ * @brief Registers asynchronous L2 operation of one TROPIC01 device.
+ * @details Operations are then started as usual by `lt_l2_async_send()` or `lt_l2_async_send_encrypted_cmd()`
+ * and advanced by `lt_linux_reactor_run_once()`, which calls their completion callbacks.
+ *
+ * @param r       Reactor structure
+ * @param op      Asynchronous L2 operation of the device
+ * @param int_fd  INT pin file descriptor (`lt_port_linux_spi_get_int_fd()`,
+ *                `lt_port_linux_spi_native_cs_get_int_fd()`), -1 if INT pin is not used
+ * @retval        LT_OK Function executed successfully
+ * @retval        other Function did not execute successully
+ */
+lt_ret_t lt_linux_reactor_add(lt_linux_reactor_t *r, lt_l2_async_t *op, int int_fd);
+
+/**
+ * @brief Registers asynchronous L2 operation of one TROPIC01 device driven by readiness of a file descriptor instead
+ * of the INT pin, e.g. the socket of the TCP HAL (`lt_port_posix_tcp_get_fd()`) with `LT_PORT_SPI_READ_READY_NOWAIT`.
+ * @details The operation is advanced whenever the file descriptor becomes readable, the reactor does not read it.
+ *
+ * @param r   Reactor structure
+ * @param op  Asynchronous L2 operation of the device
+ * @param fd  File descriptor becoming readable when the operation can be advanced
+ * @retval    LT_OK Function executed successfully
+ * @retval    other Function did not execute successully
+ */
+lt_ret_t lt_linux_reactor_add_fd(lt_linux_reactor_t *r, lt_l2_async_t *op, int fd);
+
+/**
+ * @brief Waits for INT pin events or for the poll interval and advances pending operations.
+ *
+ * @param r  Reactor structure
+ * @retval   LT_OK Function executed successfully
+ * @retval   other Waiting for the events failed
+ */
+lt_ret_t lt_linux_reactor_run_once(lt_linux_reactor_t *r);
+
+/**
+ * @brief Runs the reactor until all registered operations are finished.
+ *
+ * @param r  Reactor structure
+ * @retval   LT_OK Function executed successfully
+ * @retval   other Waiting for the events failed
+ */
+lt_ret_t lt_linux_reactor_run(lt_linux_reactor_t *r);
+
+/**
+ * @brief Returns number of registered operations which are in progress.
+ *
+ * @param r  Reactor structure
+ * @return   Number of pending operations
+ */
+uint8_t lt_linux_reactor_pending(const lt_linux_reactor_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_LINUX_REACTOR_H
@@ -0,0 +1,80 @@
+/**
+ * @file libtropic_linux_sleep.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief High-resolution delays for the Linux HALs.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_linux_sleep.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+
+#define LT_LINUX_SLEEP_NSEC_PER_SEC 1000000000L
+
+/**
+ * @brief Tells whether time `a` is before time `b`.
+ */
+static bool lt_linux_sleep_before(const struct timespec *a, const struct timespec *b)
+{
+    return (a->tv_sec < b->tv_sec) || ((a->tv_sec == b->tv_sec) && (a->tv_nsec < b->tv_nsec));
+}
+
+lt_ret_t lt_linux_sleep_us(uint64_t us)
+{
+    struct timespec deadline;
+
+    if (us == 0) {
+        return LT_OK;
+    }
+
+    if (clock_gettime(CLOCK_MONOTONIC, &deadline) != 0) {
+        LT_LOG_ERROR("clock_gettime() failed: %s", strerror(errno));
+        return LT_FAIL;
+    }
+    deadline.tv_sec += (time_t)(us / 1000000);
+    deadline.tv_nsec += (long)(us % 1000000) * 1000;
+    if (deadline.tv_nsec >= LT_LINUX_SLEEP_NSEC_PER_SEC) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= LT_LINUX_SLEEP_NSEC_PER_SEC;
+    }
+
+    if (us <= LT_LINUX_SLEEP_SPIN_US) {
+        struct timespec now;
+        do {
+            if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+                LT_LOG_ERROR("clock_gettime() failed: %s", strerror(errno));
+                return LT_FAIL;
+            }
+        } while (lt_linux_sleep_before(&now, &deadline));
+        return LT_OK;
+    }
+
+    // Sleeping to the absolute deadline, a restart after a signal continues with the remaining time only.
+    int ret;
+    do {
+        ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+    } while (ret == EINTR);
+    if (ret != 0) {
+        LT_LOG_ERROR("clock_nanosleep() failed: %s", strerror(ret));
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+uint64_t lt_linux_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
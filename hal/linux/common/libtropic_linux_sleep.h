@@ -0,0 +1,47 @@
+#ifndef LIBTROPIC_LINUX_SLEEP_H
+#define LIBTROPIC_LINUX_SLEEP_H
+
+/**
+ * @file libtropic_linux_sleep.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief High-resolution delays for the Linux HALs.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef LT_LINUX_SLEEP_SPIN_US
+/** Delays up to this many microseconds are busy-waited, as waking up from a sleep takes tens of microseconds. */
+#define LT_LINUX_SLEEP_SPIN_US 50
+#endif
+
+/**
+ * @brief Waits for the given time, measured on CLOCK_MONOTONIC.
+ * @details The deadline is computed once and slept to with `clock_nanosleep(TIMER_ABSTIME)`, so interruptions by
+ * signals do not prolong the wait. Delays up to LT_LINUX_SLEEP_SPIN_US are busy-waited.
+ *
+ * @param us  Time to wait in microseconds
+ * @retval    LT_OK Function executed successfully
+ * @retval    LT_FAIL Function did not execute successully
+ */
+lt_ret_t lt_linux_sleep_us(uint64_t us);
+
+/**
+ * @brief Reads CLOCK_MONOTONIC.
+ *
+ * @return Monotonic time in microseconds, the starting point is arbitrary
+ */
+uint64_t lt_linux_time_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_LINUX_SLEEP_H
@@ -0,0 +1,83 @@
+/**
+ * @file libtropic_linux_spi_bus.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Arbiter of one SPI controller shared by several TROPIC01 devices with separate chip select lines.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_linux_spi_bus.h"
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+
+lt_ret_t lt_linux_spi_bus_init(lt_linux_spi_bus_t *bus)
+{
+    if (!bus) {
+        return LT_PARAM_ERR;
+    }
+
+    bus->next_ticket = 0;
+    bus->serving = 0;
+    bus->frames = 0;
+    bus->contended = 0;
+
+    if (pthread_mutex_init(&bus->lock, NULL) != 0) {
+        LT_LOG_ERROR("lt_linux_spi_bus_init: pthread_mutex_init() failed!");
+        return LT_FAIL;
+    }
+    if (pthread_cond_init(&bus->released, NULL) != 0) {
+        LT_LOG_ERROR("lt_linux_spi_bus_init: pthread_cond_init() failed!");
+        pthread_mutex_destroy(&bus->lock);
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+void lt_linux_spi_bus_deinit(lt_linux_spi_bus_t *bus)
+{
+    pthread_cond_destroy(&bus->released);
+    pthread_mutex_destroy(&bus->lock);
+}
+
+void lt_linux_spi_bus_acquire(lt_linux_spi_bus_t *bus)
+{
+    pthread_mutex_lock(&bus->lock);
+    const uint32_t ticket = bus->next_ticket++;
+    bus->frames++;
+    if (ticket != bus->serving) {
+        bus->contended++;
+        // Tickets wrap around, only equality matters.
+        do {
+            pthread_cond_wait(&bus->released, &bus->lock);
+        } while (ticket != bus->serving);
+    }
+    pthread_mutex_unlock(&bus->lock);
+}
+
+void lt_linux_spi_bus_release(lt_linux_spi_bus_t *bus)
+{
+    pthread_mutex_lock(&bus->lock);
+    bus->serving++;
+    // Waiters check their own ticket, so all of them are woken up.
+    if (bus->serving != bus->next_ticket) {
+        pthread_cond_broadcast(&bus->released);
+    }
+    pthread_mutex_unlock(&bus->lock);
+}
+
+void lt_linux_spi_bus_get_stats(lt_linux_spi_bus_t *bus, uint64_t *frames, uint64_t *contended)
+{
+    pthread_mutex_lock(&bus->lock);
+    if (frames) {
+        *frames = bus->frames;
+    }
+    if (contended) {
+        *contended = bus->contended;
+    }
+    pthread_mutex_unlock(&bus->lock);
+}
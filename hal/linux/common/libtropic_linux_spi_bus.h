@@ -0,0 +1,85 @@
+#ifndef LIBTROPIC_LINUX_SPI_BUS_H
+#define LIBTROPIC_LINUX_SPI_BUS_H
+
+/**
+ * @file libtropic_linux_spi_bus.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Arbiter of one SPI controller shared by several TROPIC01 devices with separate chip select lines.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bus structure, shared by the devices on the bus. Contents are private.
+ * @details The bus is owned by one device from asserting its chip select to releasing it, i.e. for one L1 frame.
+ * Devices waiting for the bus get it in the order they asked for it, so a device polling its TROPIC01 does not
+ * starve the others.
+ */
+typedef struct lt_linux_spi_bus_t {
+    /** @private @brief Protects the tickets and the counters. */
+    pthread_mutex_t lock;
+    /** @private @brief Broadcast when the bus is released. */
+    pthread_cond_t released;
+    /** @private @brief Ticket of the next device asking for the bus. */
+    uint32_t next_ticket;
+    /** @private @brief Ticket of the device owning the bus. */
+    uint32_t serving;
+    /** @private @brief Frames transferred on the bus. */
+    uint64_t frames;
+    /** @private @brief Frames which had to wait for another device. */
+    uint64_t contended;
+} lt_linux_spi_bus_t;
+
+/**
+ * @brief Initializes the bus, before lt_init() of any device using it.
+ *
+ * @param bus  Bus structure
+ * @retval     LT_OK Function executed successfully
+ * @retval     LT_FAIL pthread initialization failed
+ */
+lt_ret_t lt_linux_spi_bus_init(lt_linux_spi_bus_t *bus);
+
+/**
+ * @brief Destroys the bus, after lt_deinit() of all devices using it.
+ *
+ * @param bus  Bus structure
+ */
+void lt_linux_spi_bus_deinit(lt_linux_spi_bus_t *bus);
+
+/**
+ * @brief Takes the bus for one frame, waits while another device owns it. Called by the HAL.
+ *
+ * @param bus  Initialized bus structure
+ */
+void lt_linux_spi_bus_acquire(lt_linux_spi_bus_t *bus);
+
+/**
+ * @brief Hands the bus over to the next waiting device. Called by the HAL.
+ *
+ * @param bus  Initialized bus structure, owned by the caller
+ */
+void lt_linux_spi_bus_release(lt_linux_spi_bus_t *bus);
+
+/**
+ * @brief Reads the counters of the bus.
+ *
+ * @param bus        Initialized bus structure
+ * @param frames     Frames transferred on the bus (optional)
+ * @param contended  Frames which had to wait for another device (optional)
+ */
+void lt_linux_spi_bus_get_stats(lt_linux_spi_bus_t *bus, uint64_t *frames, uint64_t *contended);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_LINUX_SPI_BUS_H
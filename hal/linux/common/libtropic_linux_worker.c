@@ -0,0 +1,218 @@
+/**
+ * @file libtropic_linux_worker.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Thread-safe front end of one TROPIC01 device: requests from any thread are queued and executed by the
+ * thread owning the handle.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_linux_worker.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+
+LT_STATIC_ASSERT((LT_LINUX_WORKER_QUEUE_LEN >= 1) && (LT_LINUX_WORKER_QUEUE_LEN <= 255))
+
+/**
+ * @brief Caller blocked in lt_linux_worker_call(), lives on its stack.
+ */
+struct lt_linux_worker_wait_t {
+    /** Result of the request. */
+    lt_ret_t ret;
+    /** Request was executed. */
+    bool done;
+};
+
+/**
+ * @brief Executes queued requests until the worker is stopped and the queue is empty.
+ *
+ * @param arg  Worker structure
+ * @return     NULL
+ */
+static void *lt_linux_worker_thread(void *arg)
+{
+    lt_linux_worker_t *w = (lt_linux_worker_t *)arg;
+
+    pthread_mutex_lock(&w->lock);
+    for (;;) {
+        while (!w->cnt && !w->stopping) {
+            pthread_cond_wait(&w->not_empty, &w->lock);
+        }
+        if (!w->cnt) {
+            break;
+        }
+
+        lt_linux_worker_req_t req = w->reqs[w->head];
+        w->head = (uint8_t)((w->head + 1) % LT_LINUX_WORKER_QUEUE_LEN);
+        w->cnt--;
+        w->executing = true;
+        pthread_cond_signal(&w->not_full);
+
+        // Only the chip I/O of the request runs with the handle, callers keep their host work outside.
+        pthread_mutex_unlock(&w->lock);
+        lt_ret_t ret = req.fn(w->h, req.ctx);
+        if (!req.wait && req.cb) {
+            req.cb(ret, req.cb_ctx);
+        }
+        pthread_mutex_lock(&w->lock);
+
+        w->executing = false;
+        if (req.wait) {
+            req.wait->ret = ret;
+            req.wait->done = true;
+            pthread_cond_broadcast(&w->done);
+        }
+    }
+    pthread_mutex_unlock(&w->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Puts the request at the end of the queue. Lock must be held, the queue must not be full.
+ *
+ * @param w    Worker structure
+ * @param req  Request
+ */
+static void lt_linux_worker_push(lt_linux_worker_t *w, const lt_linux_worker_req_t *req)
+{
+    w->reqs[(w->head + w->cnt) % LT_LINUX_WORKER_QUEUE_LEN] = *req;
+    w->cnt++;
+    pthread_cond_signal(&w->not_empty);
+}
+
+lt_ret_t lt_linux_worker_start(lt_linux_worker_t *w, lt_handle_t *h)
+{
+    if (!w || !h) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(w, 0, sizeof(*w));
+    w->h = h;
+
+    if (pthread_mutex_init(&w->lock, NULL) != 0) {
+        return LT_FAIL;
+    }
+    if (pthread_cond_init(&w->not_empty, NULL) != 0) {
+        goto destroy_lock;
+    }
+    if (pthread_cond_init(&w->not_full, NULL) != 0) {
+        goto destroy_not_empty;
+    }
+    if (pthread_cond_init(&w->done, NULL) != 0) {
+        goto destroy_not_full;
+    }
+
+    int err = pthread_create(&w->thread, NULL, lt_linux_worker_thread, w);
+    if (err == 0) {
+        return LT_OK;
+    }
+    LT_LOG_ERROR("pthread_create() failed: %s", strerror(err));
+
+    pthread_cond_destroy(&w->done);
+destroy_not_full:
+    pthread_cond_destroy(&w->not_full);
+destroy_not_empty:
+    pthread_cond_destroy(&w->not_empty);
+destroy_lock:
+    pthread_mutex_destroy(&w->lock);
+
+    return LT_FAIL;
+}
+
+lt_ret_t lt_linux_worker_stop(lt_linux_worker_t *w)
+{
+    if (!w || pthread_equal(pthread_self(), w->thread)) {
+        return LT_PARAM_ERR;
+    }
+
+    pthread_mutex_lock(&w->lock);
+    if (w->stopping) {
+        pthread_mutex_unlock(&w->lock);
+        return LT_FAIL;
+    }
+    w->stopping = true;
+    pthread_cond_signal(&w->not_empty);
+    // Callers waiting for room in the queue give up.
+    pthread_cond_broadcast(&w->not_full);
+    pthread_mutex_unlock(&w->lock);
+
+    pthread_join(w->thread, NULL);
+
+    pthread_cond_destroy(&w->done);
+    pthread_cond_destroy(&w->not_full);
+    pthread_cond_destroy(&w->not_empty);
+    pthread_mutex_destroy(&w->lock);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_linux_worker_call(lt_linux_worker_t *w, lt_linux_worker_fn_t fn, void *ctx)
+{
+    if (!w || !fn) {
+        return LT_PARAM_ERR;
+    }
+
+    // Request calling the worker already owns the handle, queueing would deadlock.
+    if (pthread_equal(pthread_self(), w->thread)) {
+        return fn(w->h, ctx);
+    }
+
+    struct lt_linux_worker_wait_t wait = {.ret = LT_FAIL, .done = false};
+    lt_linux_worker_req_t req = {.fn = fn, .ctx = ctx, .cb = NULL, .cb_ctx = NULL, .wait = &wait};
+
+    pthread_mutex_lock(&w->lock);
+    while ((w->cnt == LT_LINUX_WORKER_QUEUE_LEN) && !w->stopping) {
+        pthread_cond_wait(&w->not_full, &w->lock);
+    }
+    if (w->stopping) {
+        pthread_mutex_unlock(&w->lock);
+        return LT_FAIL;
+    }
+
+    lt_linux_worker_push(w, &req);
+    while (!wait.done) {
+        pthread_cond_wait(&w->done, &w->lock);
+    }
+    pthread_mutex_unlock(&w->lock);
+
+    return wait.ret;
+}
+
+lt_ret_t lt_linux_worker_submit(lt_linux_worker_t *w, lt_linux_worker_fn_t fn, void *ctx, lt_linux_worker_cb_t cb,
+                                void *cb_ctx)
+{
+    if (!w || !fn) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = LT_FAIL;
+    lt_linux_worker_req_t req = {.fn = fn, .ctx = ctx, .cb = cb, .cb_ctx = cb_ctx, .wait = NULL};
+
+    pthread_mutex_lock(&w->lock);
+    if ((w->cnt < LT_LINUX_WORKER_QUEUE_LEN) && !w->stopping) {
+        lt_linux_worker_push(w, &req);
+        ret = LT_OK;
+    }
+    pthread_mutex_unlock(&w->lock);
+
+    return ret;
+}
+
+uint16_t lt_linux_worker_pending(lt_linux_worker_t *w)
+{
+    if (!w) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&w->lock);
+    uint16_t pending = (uint16_t)(w->cnt + (w->executing ? 1 : 0));
+    pthread_mutex_unlock(&w->lock);
+
+    return pending;
+}
@@ -0,0 +1,154 @@
+#ifndef LIBTROPIC_LINUX_WORKER_H
+#define LIBTROPIC_LINUX_WORKER_H
+
+/**
+ * @file libtropic_linux_worker.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Thread-safe front end of one TROPIC01 device: requests from any thread are queued and executed by the
+ * thread owning the handle.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Max number of requests waiting in the queue of one worker. */
+#ifndef LT_LINUX_WORKER_QUEUE_LEN
+#define LT_LINUX_WORKER_QUEUE_LEN 16
+#endif
+
+/**
+ * @brief Request executed by the worker thread, e.g. a wrapper of one or more libtropic calls on the handle.
+ *
+ * @param h    Handle of the worker
+ * @param ctx  User data passed with the request
+ * @return     Result reported to the caller
+ */
+typedef lt_ret_t (*lt_linux_worker_fn_t)(lt_handle_t *h, void *ctx);
+
+/**
+ * @brief Called by the worker thread when a request submitted by `lt_linux_worker_submit()` finishes.
+ *
+ * @param ret     Result of the request
+ * @param cb_ctx  User data passed to `lt_linux_worker_submit()`
+ */
+typedef void (*lt_linux_worker_cb_t)(lt_ret_t ret, void *cb_ctx);
+
+struct lt_linux_worker_wait_t;
+
+/**
+ * @brief Queued request.
+ */
+typedef struct lt_linux_worker_req_t {
+    /** @private @brief Executed function. */
+    lt_linux_worker_fn_t fn;
+    /** @private @brief User data of the function. */
+    void *ctx;
+    /** @private @brief Completion callback, NULL for requests of `lt_linux_worker_call()`. */
+    lt_linux_worker_cb_t cb;
+    /** @private @brief User data of the callback. */
+    void *cb_ctx;
+    /** @private @brief Caller blocked in `lt_linux_worker_call()`, NULL for submitted requests. */
+    struct lt_linux_worker_wait_t *wait;
+} lt_linux_worker_req_t;
+
+/**
+ * @brief Worker structure. Contents are private.
+ */
+typedef struct lt_linux_worker_t {
+    /** @private @brief Handle owned by the worker thread. */
+    lt_handle_t *h;
+    /** @private @brief Worker thread. */
+    pthread_t thread;
+    /** @private @brief Protects the queue and the completion flags of blocked callers. */
+    pthread_mutex_t lock;
+    /** @private @brief Signalled when a request is queued or the worker is stopped. */
+    pthread_cond_t not_empty;
+    /** @private @brief Signalled when a request is taken from the queue. */
+    pthread_cond_t not_full;
+    /** @private @brief Broadcast when a request of `lt_linux_worker_call()` finishes. */
+    pthread_cond_t done;
+    /** @private @brief Waiting requests, ring buffer. */
+    lt_linux_worker_req_t reqs[LT_LINUX_WORKER_QUEUE_LEN];
+    /** @private @brief Index of the oldest waiting request. */
+    uint8_t head;
+    /** @private @brief Number of waiting requests. */
+    uint8_t cnt;
+    /** @private @brief Request is being executed. */
+    bool executing;
+    /** @private @brief No more requests are accepted, the thread exits when the queue is empty. */
+    bool stopping;
+} lt_linux_worker_t;
+
+/**
+ * @brief Starts worker thread owning the handle.
+ * @details From now on, the handle must be used only by the requests of the worker.
+ *
+ * @param w  Worker structure
+ * @param h  Handle for communication with TROPIC01, initialized by `lt_init()`
+ * @retval   LT_OK Function executed successfully
+ * @retval   other Function did not execute successully
+ */
+lt_ret_t lt_linux_worker_start(lt_linux_worker_t *w, lt_handle_t *h);
+
+/**
+ * @brief Stops the worker after the queued requests are executed and joins its thread.
+ * @details Requests queued while stopping fail with LT_FAIL. Must not be called by a request. Afterwards the worker
+ * structure must not be used, except by `lt_linux_worker_start()`.
+ *
+ * @param w  Worker structure
+ * @retval   LT_OK Function executed successfully
+ * @retval   other Function did not execute successully
+ */
+lt_ret_t lt_linux_worker_stop(lt_linux_worker_t *w);
+
+/**
+ * @brief Executes the request by the worker thread and waits for its result. Safe to call from any thread.
+ * @details Waits while the queue is full. Called from a request, the function is executed right away. Only the
+ * request holds the device, host-only work (e.g. verification of the signature) done by the caller after the
+ * return does not delay other callers.
+ *
+ * @param w    Worker structure
+ * @param fn   Function executed with the handle
+ * @param ctx  User data passed to the function
+ * @retval     Result of the function
+ * @retval     LT_FAIL Worker is stopped
+ */
+lt_ret_t lt_linux_worker_call(lt_linux_worker_t *w, lt_linux_worker_fn_t fn, void *ctx);
+
+/**
+ * @brief Queues the request without waiting for it. Safe to call from any thread.
+ *
+ * @param w       Worker structure
+ * @param fn      Function executed with the handle
+ * @param ctx     User data passed to the function
+ * @param cb      Called by the worker thread with the result of the function, may be NULL
+ * @param cb_ctx  User data passed to the callback
+ * @retval        LT_OK Request was queued
+ * @retval        LT_FAIL Queue is full (`LT_LINUX_WORKER_QUEUE_LEN` requests) or the worker is stopped
+ * @retval        other Function did not execute successully
+ */
+lt_ret_t lt_linux_worker_submit(lt_linux_worker_t *w, lt_linux_worker_fn_t fn, void *ctx, lt_linux_worker_cb_t cb,
+                                void *cb_ctx);
+
+/**
+ * @brief Returns number of requests waiting or being executed.
+ *
+ * @param w  Worker structure
+ * @return   Number of requests
+ */
+uint16_t lt_linux_worker_pending(lt_linux_worker_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_LINUX_WORKER_H
@@ -20,7 +20,6 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <linux/gpio.h>
-#include <poll.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -29,13 +28,69 @@
 
 // Other
 #include <stdarg.h>
-#include <sys/random.h>
 
 #include "libtropic_common.h"
+#if LT_USE_INT_PIN
+#include "libtropic_linux_int.h"
+#endif
+#include "libtropic_linux_sleep.h"
 #include "libtropic_logging.h"
 #include "libtropic_macros.h"
 #include "libtropic_port.h"
 #include "libtropic_port_linux_spi.h"
+#include "libtropic_posix_rng.h"
+
+/**
+ * @brief Transfers the segments by a single SPI_IOC_MESSAGE ioctl, using the preconfigured descriptors.
+ *
+ * @param s2       Structure holding l2 state
+ * @param segs     Segments to transfer
+ * @param seg_cnt  Number of segments, 1 to LT_SPI_V_SEGS_MAX
+ * @param keep_cs  Leave chip select driven by the controller asserted after the message
+ * @return         LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_linux_spi_message(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, bool keep_cs)
+{
+    lt_dev_linux_spi_t *device = (lt_dev_linux_spi_t *)(s2->device);
+    struct spi_ioc_transfer *xfers = device->xfers;
+
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        xfers[i].tx_buf = segs[i].tx ? (unsigned long)segs[i].tx : (unsigned long)(s2->buff + segs[i].offset);
+        xfers[i].rx_buf = segs[i].rx ? (unsigned long)segs[i].rx : (unsigned long)(s2->buff + segs[i].offset);
+        xfers[i].len = segs[i].len;
+        xfers[i].speed_hz = (uint32_t)device->spi_speed;
+        if (device->bulk_speed && (segs[i].len >= LT_LINUX_SPI_BULK_MIN_LEN)) {
+            xfers[i].speed_hz = (uint32_t)device->bulk_speed;
+        }
+        // On the last transfer, cs_change keeps CS asserted after the message, within it CS is held anyway.
+        xfers[i].cs_change = keep_cs && (i == seg_cnt - 1);
+    }
+
+    if (ioctl(device->spi_fd, SPI_IOC_MESSAGE(seg_cnt), xfers) < 0) {
+        LT_LOG_ERROR("SPI_IOC_MESSAGE error: %s", strerror(errno));
+        // State of CS after a failed message is not known, so it is released in any case.
+        device->cs_held = device->native_cs;
+        return LT_FAIL;
+    }
+    device->cs_held = keep_cs;
+
+    return LT_OK;
+}
+
+#ifdef LT_LINUX_SPI_BUS
+/**
+ * @brief Hands the shared bus over to the next device, if the device owns it.
+ *
+ * @param device  Device structure
+ */
+static void lt_linux_spi_bus_put(lt_dev_linux_spi_t *device)
+{
+    if (device->bus_owned) {
+        device->bus_owned = false;
+        lt_linux_spi_bus_release(device->bus);
+    }
+}
+#endif
 
 lt_ret_t lt_port_init(lt_l2_state_t *s2)
 {
@@ -50,6 +105,11 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
 #endif
     device->gpio_fd = -1;
     device->spi_fd = -1;
+    device->frame_open = false;
+    device->cs_held = false;
+#ifdef LT_LINUX_SPI_BUS
+    device->bus_owned = false;
+#endif
 
     LT_LOG_DEBUG("Initializing SPI...\n");
     LT_LOG_DEBUG("SPI speed: %d", device->spi_speed);
@@ -86,13 +146,29 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         goto spi_error;
     }
 
-    if (ioctl(device->spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &device->spi_speed) < 0) {
+    // Transfers faster than the maximal speed of the device would be clamped by the SPI core.
+    uint32_t max_speed = (uint32_t)((device->bulk_speed > device->spi_speed) ? device->bulk_speed : device->spi_speed);
+    if (ioctl(device->spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &max_speed) < 0) {
         LT_LOG_ERROR("Can't set max SPI speed.");
         ret = LT_FAIL;
         goto spi_error;
     }
 
-    // CS is controlled separately.
+    // Only buffers, lengths, speeds and cs_change differ between the transfers.
+    memset(device->xfers, 0, sizeof(device->xfers));
+    for (uint8_t i = 0; i < LT_SPI_V_SEGS_MAX; i++) {
+        device->xfers[i].speed_hz = (uint32_t)device->spi_speed;
+        device->xfers[i].bits_per_word = 8;
+    }
+
+    bool gpio_used = !device->native_cs;
+#if LT_USE_INT_PIN
+    gpio_used = true;
+#endif
+    if (!gpio_used) {
+        return LT_OK;
+    }
+
     device->gpio_fd = open(device->gpio_dev, O_RDWR | O_CLOEXEC);
     if (device->gpio_fd < 0) {
         LT_LOG_ERROR("Can't open GPIO device!");
@@ -113,6 +189,11 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
     LT_LOG_DEBUG("- info.label = \"%s\"", info.label);
     LT_LOG_DEBUG("- info.lines = \"%u\"", info.lines);
 
+    // CS is controlled separately, unless driven by the controller.
+    if (device->native_cs) {
+        goto gpio_cs_done;
+    }
+
     // Setup for CS pin (OUTPUT)
     device->gpioreq_cs.offsets[0] = device->gpio_cs_num;
     device->gpioreq_cs.num_lines = 1;
@@ -127,6 +208,7 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         ret = LT_FAIL;
         goto gpio_error;
     }
+gpio_cs_done:
 
 #if LT_USE_INT_PIN
     // Setup for INT pin (INPUT, RISING EDGE)
@@ -141,6 +223,14 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         ret = LT_FAIL;
         goto gpio_cs_pin_error;
     }
+
+    // Pending edge is then consumed by a single read(), see lt_linux_int_wait().
+    ret = lt_linux_int_setup(device->gpioreq_int.fd);
+    if (ret != LT_OK) {
+        close(device->gpioreq_int.fd);
+        device->gpioreq_int.fd = -1;
+        goto gpio_cs_pin_error;
+    }
 #endif
     return LT_OK;
 
@@ -179,6 +269,9 @@ lt_ret_t lt_port_deinit(lt_l2_state_t *s2)
 #endif
     device->gpio_fd = -1;
     device->spi_fd = -1;
+#ifdef LT_LINUX_SPI_BUS
+    lt_linux_spi_bus_put(device);
+#endif
 
     return LT_OK;
 }
@@ -188,11 +281,29 @@ lt_ret_t lt_port_spi_csn_low(lt_l2_state_t *s2)
     lt_dev_linux_spi_t *device = (lt_dev_linux_spi_t *)(s2->device);
     struct gpio_v2_line_values values;
 
+#ifdef LT_LINUX_SPI_BUS
+    // Other devices cannot assert their chip select until this frame ends.
+    if (device->bus && !device->bus_owned) {
+        lt_linux_spi_bus_acquire(device->bus);
+        device->bus_owned = true;
+    }
+#endif
+
+    device->frame_open = true;
+    // The controller asserts CS by itself with the first transfer of the frame.
+    if (device->native_cs) {
+        return LT_OK;
+    }
+
     values.mask = 1;
     values.bits = 0;
     if (ioctl(device->gpioreq_cs.fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0) {
         LT_LOG_ERROR("GPIO_V2_LINE_SET_VALUES_IOCTL error!");
         LT_LOG_ERROR("Error string: %s", strerror(errno));
+#ifdef LT_LINUX_SPI_BUS
+        device->frame_open = false;
+        lt_linux_spi_bus_put(device);
+#endif
         return LT_FAIL;
     }
     return LT_OK;
@@ -202,124 +313,156 @@ lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2)
 {
     lt_dev_linux_spi_t *device = (lt_dev_linux_spi_t *)(s2->device);
     struct gpio_v2_line_values values;
+    lt_ret_t ret = LT_OK;
 
-    values.mask = 1;
-    values.bits = 1;
-    if (ioctl(device->gpioreq_cs.fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0) {
-        LT_LOG_ERROR("GPIO_V2_LINE_SET_VALUES_IOCTL error!");
-        LT_LOG_ERROR("Error string: %s", strerror(errno));
-        return LT_FAIL;
+    device->frame_open = false;
+    if (device->native_cs) {
+        if (device->cs_held) {
+            // Empty message without cs_change only releases CS left asserted by the previous one.
+            const lt_spi_seg_t release_seg = {.tx = NULL, .rx = NULL, .len = 0, .offset = 0};
+            ret = lt_linux_spi_message(s2, &release_seg, 1, false);
+        }
     }
-    return LT_OK;
+    else {
+        values.mask = 1;
+        values.bits = 1;
+        if (ioctl(device->gpioreq_cs.fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0) {
+            LT_LOG_ERROR("GPIO_V2_LINE_SET_VALUES_IOCTL error!");
+            LT_LOG_ERROR("Error string: %s", strerror(errno));
+            ret = LT_FAIL;
+        }
+    }
+
+#ifdef LT_LINUX_SPI_BUS
+    // Bus is handed over even on failure, so a broken chip select line does not block the other devices.
+    lt_linux_spi_bus_put(device);
+#endif
+
+    return ret;
 }
 
 lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_data_length, uint32_t timeout_ms)
 {
     LT_UNUSED(timeout_ms);
     lt_dev_linux_spi_t *device = (lt_dev_linux_spi_t *)(s2->device);
+    const lt_spi_seg_t seg = {.tx = NULL, .rx = NULL, .len = tx_data_length, .offset = offset};
 
-    int ret = 0;
-    struct spi_ioc_transfer spi = {
-        .tx_buf = (unsigned long)s2->buff + offset,
-        .rx_buf = (unsigned long)s2->buff + offset,
-        .len = tx_data_length,
-        .delay_usecs = 0,
-    };
+    // Further parts of the frame follow, until lt_port_spi_csn_high() is called.
+    return lt_linux_spi_message(s2, &seg, 1, device->native_cs && device->frame_open);
+}
 
-    ret = ioctl(device->spi_fd, SPI_IOC_MESSAGE(1), &spi);
-    if (ret >= 0) {
-        return LT_OK;
+#ifdef LT_PORT_SPI_TRANSFER_V
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    lt_dev_linux_spi_t *device = (lt_dev_linux_spi_t *)(s2->device);
+    lt_ret_t ret;
+
+    if (seg_cnt > LT_SPI_V_SEGS_MAX) {
+        return LT_PARAM_ERR;
+    }
+
+    if (flags & LT_SPI_V_CSN_LOW) {
+        ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    // All segments are transferred by a single ioctl. With native CS, a frame ending here releases CS
+    // at the end of the message, so the whole frame is a single syscall.
+    if (seg_cnt) {
+        bool keep_cs = device->native_cs && device->frame_open && !(flags & LT_SPI_V_CSN_HIGH);
+        ret = lt_linux_spi_message(s2, segs, seg_cnt, keep_cs);
+        if (ret != LT_OK) {
+            lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+            LT_UNUSED(ret_unused);  // We don't care about it, we return LT_FAIL anyway.
+            return LT_FAIL;
+        }
+    }
+
+    if (flags & LT_SPI_V_CSN_HIGH) {
+        return lt_port_spi_csn_high(s2);
     }
-    return LT_FAIL;
+
+    return LT_OK;
 }
+#endif
 
 lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
 {
     LT_UNUSED(s2);
     LT_LOG_DEBUG("-- Waiting for the target.");
 
-    int ret = usleep(ms * 1000);
-    if (ret != 0) {
-        LT_LOG_ERROR("usleep() failed: %s (%d)", strerror(errno), ret);
-        return LT_FAIL;
-    }
-
-    return LT_OK;
+    return lt_linux_sleep_us((uint64_t)ms * 1000);
 }
 
-lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
+#ifdef LT_PORT_DELAY_US
+lt_ret_t lt_port_delay_us(lt_l2_state_t *s2, uint32_t us)
 {
     LT_UNUSED(s2);
 
-    ssize_t ret = getrandom(buff, count, 0);
+    return lt_linux_sleep_us(us);
+}
+#endif
 
-    if (ret < 0) {
-        LT_LOG_ERROR("lt_port_random_bytes: getrandom() failed (%s)!", strerror(errno));
-        return LT_FAIL;
+#ifdef LT_PORT_SPI_SET_SPEED
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    lt_dev_linux_spi_t *device = (lt_dev_linux_spi_t *)(s2->device);
+
+    // L2 frames are clocked at bulk_speed if it is set, CHIP_STATUS polling stays at spi_speed.
+    if (device->bulk_speed) {
+        device->bulk_speed = (int)hz;
+    }
+    else {
+        device->spi_speed = (int)hz;
     }
 
-    if ((size_t)ret != count) {
-        LT_LOG_ERROR("lt_port_random_bytes: getrandom() generated %zd bytes instead of requested %zu bytes!", ret,
-                     count);
+    uint32_t max_speed = (uint32_t)((device->bulk_speed > device->spi_speed) ? device->bulk_speed : device->spi_speed);
+    if (ioctl(device->spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &max_speed) < 0) {
+        LT_LOG_ERROR("Can't set max SPI speed.");
         return LT_FAIL;
     }
 
     return LT_OK;
 }
+#endif
+
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void) { return lt_linux_time_us(); }
+#endif
+
+lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
+{
+    LT_UNUSED(s2);
+
+    // Keystream buffered per thread, getrandom() is not called for each request.
+    return lt_posix_rng_bytes(buff, count);
+}
 
 #if LT_USE_INT_PIN
 lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
 {
     lt_dev_linux_spi_t *device = (lt_dev_linux_spi_t *)(s2->device);
-    struct pollfd pfd;
-    int ret;
 
-    // Set up the poll structure
-    pfd.fd = device->gpioreq_int.fd;
-    pfd.events = POLLIN | POLLPRI;  // Wait for data or priority event (GPIO edge)
-    pfd.revents = 0;
+    LT_LOG_DEBUG("Waiting on INT pin (fd: %d) for %u ms...", device->gpioreq_int.fd, ms);
 
-    LT_LOG_DEBUG("Polling on INT pin (fd: %d) for %u ms...", pfd.fd, ms);
-
-    // Wait for the event or timeout
-    ret = poll(&pfd, 1, (int)ms);
-
-    if (ret < 0) {
-        LT_LOG_ERROR("poll() failed: %s", strerror(errno));
-        return LT_FAIL;
-    }
-
-    if (ret == 0) {
+    lt_ret_t ret = lt_linux_int_wait(device->gpioreq_int.fd, ms);
+    if (ret == LT_L1_INT_TIMEOUT) {
         LT_LOG_WARN("Timeout waiting for INT pin.");
-        return LT_L1_INT_TIMEOUT;
     }
-
-    // Event occurred, check if it's the right type
-    if (pfd.revents & (POLLIN | POLLPRI)) {
-        // Event is ready. We MUST read it to consume it, otherwise poll()
-        // will return immediately on the next call.
-        struct gpio_v2_line_event event;
-        ret = read(pfd.fd, &event, sizeof(event));
-
-        if (ret < 0) {
-            LT_LOG_ERROR("read() on INT pin failed: %s", strerror(errno));
-            return LT_FAIL;
-        }
-
-        if (ret != sizeof(event)) {
-            LT_LOG_ERROR("read() on INT pin returned unexpected size: %d", ret);
-            return LT_FAIL;
-        }
-
-        // Since we only configured for RISING_EDGE, any event is the one we want.
-        // event.id == GPIO_V2_LINE_EVENT_RISING_EDGE
+    else if (ret == LT_OK) {
         LT_LOG_DEBUG("Interrupt received!");
-        return LT_OK;
     }
 
-    LT_LOG_ERROR("Poll returned positive but no expected revents.");
-    return LT_FAIL;
+    return ret;
 }
+
+int lt_port_linux_spi_get_int_fd(const lt_dev_linux_spi_t *device) { return device ? device->gpioreq_int.fd : -1; }
+
+lt_ret_t lt_port_linux_spi_clear_int(lt_dev_linux_spi_t *device) { return lt_linux_int_clear(device->gpioreq_int.fd); }
 #endif
 
 int lt_port_log(const char *format, ...)
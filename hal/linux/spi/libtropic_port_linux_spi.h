@@ -10,13 +10,23 @@
  */
 
 #include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+#include <stdbool.h>
 
 #include "libtropic_port.h"
+#ifdef LT_LINUX_SPI_BUS
+#include "libtropic_linux_spi_bus.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifndef LT_LINUX_SPI_BULK_MIN_LEN
+/** Transfers of at least this many bytes are clocked at `bulk_speed` of lt_dev_linux_spi_t. */
+#define LT_LINUX_SPI_BULK_MIN_LEN 16
+#endif
+
 /**
  * @brief Device structure for Linux SPI port.
  *
@@ -26,6 +36,17 @@ extern "C" {
 typedef struct lt_dev_linux_spi_t {
     /** @public @brief SPI speed in Hz. */
     int spi_speed;
+    /**
+     * @public @brief SPI speed in Hz of transfers of at least LT_LINUX_SPI_BULK_MIN_LEN bytes (e.g. L2 frames), 0 to
+     * use `spi_speed`. Short transfers (e.g. CHIP_STATUS polling) stay at `spi_speed`.
+     */
+    int bulk_speed;
+    /**
+     * @public @brief Chip select is driven by the SPI controller (spidev's own CS line) instead of the GPIO pin
+     * `gpio_cs_num`. A whole L1 frame is then a single SPI_IOC_MESSAGE ioctl, frames spanning more calls keep CS
+     * asserted by `cs_change`.
+     */
+    bool native_cs;
     /** @public @brief Path to the SPI device. */
     char spi_dev[LT_DEVICE_PATH_MAX_LEN];
     /** @public @brief Path to the GPIO device. */
@@ -36,6 +57,14 @@ typedef struct lt_dev_linux_spi_t {
     /** @public @brief Number of the GPIO pin to map interrupt pin to. */
     int gpio_int_num;
 #endif
+#ifdef LT_LINUX_SPI_BUS
+    /**
+     * @public @brief Bus shared with other devices on the same SPI controller, NULL if the device is alone on it.
+     * The device owns the bus from lt_port_spi_csn_low() to lt_port_spi_csn_high(), so frames of the devices are
+     * interleaved while each TROPIC01 executes its command.
+     */
+    lt_linux_spi_bus_t *bus;
+#endif
 
     /** @private @brief SPI file descriptor. */
     int spi_fd;
@@ -43,12 +72,44 @@ typedef struct lt_dev_linux_spi_t {
     int gpio_fd;
     /** @private @brief GPIO request structure for chip select. */
     struct gpio_v2_line_request gpioreq_cs;
+    /** @private @brief Transfer descriptors, configured once by lt_port_init(). */
+    struct spi_ioc_transfer xfers[LT_SPI_V_SEGS_MAX];
+    /** @private @brief Chip select was set low by lt_port_spi_csn_low() and not set high yet. */
+    bool frame_open;
+    /** @private @brief Chip select driven by the controller was left asserted after the last message. */
+    bool cs_held;
+#ifdef LT_LINUX_SPI_BUS
+    /** @private @brief The device owns `bus`. */
+    bool bus_owned;
+#endif
 #if LT_USE_INT_PIN
     /** @private @brief GPIO request structure for interrupt pin. */
     struct gpio_v2_line_request gpioreq_int;
 #endif
 } lt_dev_linux_spi_t;
 
+#if LT_USE_INT_PIN
+/**
+ * @brief Returns file descriptor of the INT pin line request, which becomes readable on rising edge of the INT pin.
+ * @details Meant for event loops (poll(), epoll), which drive the asynchronous L2 engine (`LT_L2_ASYNC`). Call
+ * `lt_port_linux_spi_clear_int()` once the descriptor became readable.
+ *
+ * @param device  Device structure, initialized by `lt_init()`
+ * @return        File descriptor, -1 if device is NULL or after `lt_init()` failed or `lt_deinit()` was called (the
+ *                value is not defined before `lt_init()` is called)
+ */
+int lt_port_linux_spi_get_int_fd(const lt_dev_linux_spi_t *device);
+
+/**
+ * @brief Consumes all pending edge events of the INT pin without waiting.
+ *
+ * @param device  Initialized device structure
+ * @retval        LT_OK Function executed successfully
+ * @retval        LT_FAIL Reading of the events failed
+ */
+lt_ret_t lt_port_linux_spi_clear_int(lt_dev_linux_spi_t *device);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
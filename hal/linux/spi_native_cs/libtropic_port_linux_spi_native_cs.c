@@ -21,7 +21,6 @@
 // GPIO-related includes
 #if LT_USE_INT_PIN
 #include <linux/gpio.h>
-#include <poll.h>
 #endif
 
 // Other
@@ -33,13 +32,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/random.h>
 
 #include "libtropic_common.h"
+#if LT_USE_INT_PIN
+#include "libtropic_linux_int.h"
+#endif
+#include "libtropic_linux_sleep.h"
 #include "libtropic_logging.h"
 #include "libtropic_macros.h"
 #include "libtropic_port.h"
 #include "libtropic_port_linux_spi_native_cs.h"
+#include "libtropic_posix_rng.h"
 
 lt_ret_t lt_port_init(lt_l2_state_t *s2)
 {
@@ -130,6 +133,14 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         ret = LT_FAIL;
         goto gpio_error;
     }
+
+    // Pending edge is then consumed by a single read(), see lt_linux_int_wait().
+    ret = lt_linux_int_setup(device->gpioreq_int.fd);
+    if (ret != LT_OK) {
+        close(device->gpioreq_int.fd);
+        device->gpioreq_int.fd = -1;
+        goto gpio_error;
+    }
 #endif
 
     return LT_OK;
@@ -215,91 +226,130 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_dat
     return LT_L1_SPI_ERROR;
 }
 
-lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
+#ifdef LT_PORT_SPI_TRANSFER_V
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms)
 {
-    LT_UNUSED(s2);
+    lt_dev_linux_spi_native_cs_t *device = (lt_dev_linux_spi_native_cs_t *)(s2->device);
+    lt_ret_t ret = LT_OK;
 
-    int ret = usleep(ms * 1000);
-    if (ret != 0) {
-        LT_LOG_ERROR("lt_port_delay: usleep() failed: %s (%d)", strerror(errno), ret);
-        return LT_FAIL;
+    if (seg_cnt > LT_SPI_V_SEGS_MAX) {
+        return LT_PARAM_ERR;
+    }
+
+    // Frame spanning more calls is transferred as a whole buffer, as CS cannot be held between two ioctls.
+    if ((flags & (LT_SPI_V_CSN_LOW | LT_SPI_V_CSN_HIGH)) != (LT_SPI_V_CSN_LOW | LT_SPI_V_CSN_HIGH)) {
+        if (flags & LT_SPI_V_CSN_LOW) {
+            ret = lt_port_spi_csn_low(s2);
+        }
+        for (uint8_t i = 0; (i < seg_cnt) && (ret == LT_OK); i++) {
+            uint8_t *frame_pos = s2->buff + segs[i].offset;
+            if (segs[i].tx && (segs[i].tx != frame_pos)) {
+                memcpy(frame_pos, segs[i].tx, segs[i].len);
+            }
+            ret = lt_port_spi_transfer(s2, segs[i].offset, segs[i].len, timeout_ms);
+            if ((ret == LT_OK) && segs[i].rx && (segs[i].rx != frame_pos)) {
+                memcpy(segs[i].rx, frame_pos, segs[i].len);
+            }
+        }
+        if ((ret != LT_OK) || (flags & LT_SPI_V_CSN_HIGH)) {
+            lt_ret_t ret_csn = lt_port_spi_csn_high(s2);
+            if (ret == LT_OK) {
+                ret = ret_csn;
+            }
+        }
+        return ret;
+    }
+
+    // Whole frame in one ioctl, spidev asserts CS for the duration of the message.
+    struct spi_ioc_transfer spi[LT_SPI_V_SEGS_MAX];
+    memset(spi, 0, sizeof(spi));
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        spi[i].tx_buf = segs[i].tx ? (unsigned long)segs[i].tx : (unsigned long)(s2->buff + segs[i].offset);
+        spi[i].rx_buf = segs[i].rx ? (unsigned long)segs[i].rx : (unsigned long)(s2->buff + segs[i].offset);
+        spi[i].len = segs[i].len;
+    }
+
+    if (seg_cnt && (ioctl(device->spi_fd, SPI_IOC_MESSAGE(seg_cnt), spi) < 0)) {
+        LT_LOG_ERROR("lt_port_spi_transfer_v: SPI_IOC_MESSAGE error: %s", strerror(errno));
+        return LT_L1_SPI_ERROR;
     }
 
     return LT_OK;
 }
+#endif
 
-lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
+lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
+{
+    LT_UNUSED(s2);
+
+    return lt_linux_sleep_us((uint64_t)ms * 1000);
+}
+
+#ifdef LT_PORT_DELAY_US
+lt_ret_t lt_port_delay_us(lt_l2_state_t *s2, uint32_t us)
 {
     LT_UNUSED(s2);
 
-    ssize_t ret = getrandom(buff, count, 0);
+    return lt_linux_sleep_us(us);
+}
+#endif
 
-    if (ret < 0) {
-        LT_LOG_ERROR("lt_port_random_bytes: getrandom() failed (%s)!", strerror(errno));
-        return LT_FAIL;
-    }
+#ifdef LT_PORT_SPI_SET_SPEED
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    lt_dev_linux_spi_native_cs_t *device = (lt_dev_linux_spi_native_cs_t *)(s2->device);
 
-    if ((size_t)ret != count) {
-        LT_LOG_ERROR("lt_port_random_bytes: getrandom() generated %zd bytes instead of requested %zu bytes!", ret,
-                     count);
+    // Transfers do not set their own speed, so the maximal speed of the device is used.
+    int speed = (int)hz;
+    if (ioctl(device->spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0) {
+        LT_LOG_ERROR("Can't set max SPI speed.");
         return LT_FAIL;
     }
+    device->spi_speed = speed;
 
     return LT_OK;
 }
+#endif
+
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void) { return lt_linux_time_us(); }
+#endif
+
+lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
+{
+    LT_UNUSED(s2);
+
+    // Keystream buffered per thread, getrandom() is not called for each request.
+    return lt_posix_rng_bytes(buff, count);
+}
 
 #if LT_USE_INT_PIN
 lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
 {
     lt_dev_linux_spi_native_cs_t *device = (lt_dev_linux_spi_native_cs_t *)(s2->device);
-    struct pollfd pfd;
-    int ret;
-
-    // Set up the poll structure
-    pfd.fd = device->gpioreq_int.fd;
-    pfd.events = POLLIN | POLLPRI;  // Wait for data or priority event (GPIO edge)
-    pfd.revents = 0;
-
-    LT_LOG_DEBUG("lt_port_delay_on_int: Polling on INT pin (fd: %d) for %u ms...", pfd.fd, ms);
-
-    // Wait for the event or timeout
-    ret = poll(&pfd, 1, (int)ms);
 
-    if (ret < 0) {
-        LT_LOG_ERROR("lt_port_delay_on_int: poll() failed: %s", strerror(errno));
-        return LT_FAIL;
-    }
+    LT_LOG_DEBUG("lt_port_delay_on_int: Waiting on INT pin (fd: %d) for %u ms...", device->gpioreq_int.fd, ms);
 
-    if (ret == 0) {
+    lt_ret_t ret = lt_linux_int_wait(device->gpioreq_int.fd, ms);
+    if (ret == LT_L1_INT_TIMEOUT) {
         LT_LOG_WARN("lt_port_delay_on_int: Timeout waiting for INT pin.");
-        return LT_L1_INT_TIMEOUT;
     }
-
-    // Event occurred, check if it's the right type
-    if (pfd.revents & (POLLIN | POLLPRI)) {
-        // Event is ready. We MUST read it to consume it, otherwise poll()
-        // will return immediately on the next call.
-        struct gpio_v2_line_event event;
-        ret = read(pfd.fd, &event, sizeof(event));
-
-        if (ret < 0) {
-            LT_LOG_ERROR("lt_port_delay_on_int: read() on INT pin failed: %s", strerror(errno));
-            return LT_FAIL;
-        }
-
-        if (ret != sizeof(event)) {
-            LT_LOG_ERROR("lt_port_delay_on_int: read() on INT pin returned unexpected size: %d", ret);
-            return LT_FAIL;
-        }
-
-        // Since we only configured for RISING_EDGE, any event is the one we want.
-        // event.id == GPIO_V2_LINE_EVENT_RISING_EDGE
+    else if (ret == LT_OK) {
         LT_LOG_DEBUG("lt_port_delay_on_int: Interrupt received!");
-        return LT_OK;
     }
 
-    LT_LOG_ERROR("lt_port_delay_on_int: Poll returned positive but no expected revents.");
-    return LT_FAIL;
+    return ret;
+}
+
+int lt_port_linux_spi_native_cs_get_int_fd(const lt_dev_linux_spi_native_cs_t *device)
+{
+    return device ? device->gpioreq_int.fd : -1;
+}
+
+lt_ret_t lt_port_linux_spi_native_cs_clear_int(lt_dev_linux_spi_native_cs_t *device)
+{
+    return lt_linux_int_clear(device->gpioreq_int.fd);
 }
 #endif
 
@@ -72,6 +72,28 @@ typedef struct lt_dev_linux_spi_native_cs_t {
 
 } lt_dev_linux_spi_native_cs_t;
 
+#if LT_USE_INT_PIN
+/**
+ * @brief Returns file descriptor of the INT pin line request, which becomes readable on rising edge of the INT pin.
+ * @details Meant for event loops (poll(), epoll), which drive the asynchronous L2 engine (`LT_L2_ASYNC`). Call
+ * `lt_port_linux_spi_native_cs_clear_int()` once the descriptor became readable.
+ *
+ * @param device  Device structure, initialized by `lt_init()`
+ * @return        File descriptor, -1 if device is NULL or after `lt_init()` failed or `lt_deinit()` was called (the
+ *                value is not defined before `lt_init()` is called)
+ */
+int lt_port_linux_spi_native_cs_get_int_fd(const lt_dev_linux_spi_native_cs_t *device);
+
+/**
+ * @brief Consumes all pending edge events of the INT pin without waiting.
+ *
+ * @param device  Initialized device structure
+ * @retval        LT_OK Function executed successfully
+ * @retval        LT_FAIL Reading of the events failed
+ */
+lt_ret_t lt_port_linux_spi_native_cs_clear_int(lt_dev_linux_spi_native_cs_t *device);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,7 +20,60 @@
 #include "libtropic_common.h"
 #include "libtropic_logging.h"
 #include "libtropic_macros.h"
+#include "libtropic_posix_rng.h"
+#include "lt_crc16.h"
 #include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+
+/** Current time used to emulate busy periods, in microseconds. */
+static uint64_t mock_now_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+/** Starts busy period after an L2 Request, if latency of the request is emulated. */
+static void mock_start_busy(lt_dev_mock_t *dev, const uint8_t req_id)
+{
+    const mock_latency_t *lat = NULL;
+
+    if (dev->next_latency_set) {
+        lat = &dev->next_latency;
+        dev->next_latency_set = false;
+    }
+    else {
+        for (size_t i = 0; i < dev->latency_count; i++) {
+            if (dev->latency[i].req_id == req_id) {
+                lat = &dev->latency[i];
+                break;
+            }
+        }
+    }
+
+    // New request always ends the previous busy period.
+    dev->busy = (lat != NULL);
+    if (!lat) {
+        return;
+    }
+
+    dev->busy_chip_status = lat->chip_status;
+    dev->busy_polls_left = lat->polls;
+    dev->busy_until_us = mock_now_us() + (uint64_t)lat->ms * 1000;
+}
+
+/** Returns true if the read of the response is answered as busy, ends the busy period otherwise. */
+static bool mock_read_busy(lt_dev_mock_t *dev)
+{
+    if (dev->busy && (dev->busy_polls_left == 0) && (mock_now_us() >= dev->busy_until_us)) {
+        dev->busy = false;
+    }
+
+    return dev->busy;
+}
 
 // Mock test control API -----------------------------------------------------
 
@@ -39,6 +92,20 @@ lt_ret_t lt_mock_hal_reset(lt_l2_state_t *s2)
     dev->frame_in_progress = false;
     dev->frame_bytes_transferred = 0;
 
+    dev->latency_count = 0;
+    dev->next_latency_set = false;
+    dev->busy = false;
+    dev->frame_busy = false;
+    dev->busy_reads = 0;
+    dev->speed_hz = 0;
+    dev->max_speed_hz = 0;
+    dev->corrupt_next = true;
+    dev->read_pending = false;
+    dev->tunnel_calls = 0;
+    dev->tunnel_unsupported = true;
+    dev->cache_cleaned = 0;
+    dev->cache_invalidated = 0;
+
     return LT_OK;
 }
 
@@ -69,6 +136,103 @@ lt_ret_t lt_mock_hal_enqueue_response(lt_l2_state_t *s2, const uint8_t *data, co
     return LT_OK;
 }
 
+lt_ret_t lt_mock_hal_set_latency(lt_l2_state_t *s2, const mock_latency_t *lat)
+{
+    if (!s2 || !lat) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)s2->device;
+    size_t i;
+
+    for (i = 0; i < dev->latency_count; i++) {
+        if (dev->latency[i].req_id == lat->req_id) {
+            break;
+        }
+    }
+
+    // Zero latency removes the entry, the last one takes its place.
+    if ((lat->polls == 0) && (lat->ms == 0)) {
+        if (i < dev->latency_count) {
+            dev->latency_count--;
+            dev->latency[i] = dev->latency[dev->latency_count];
+        }
+        return LT_OK;
+    }
+
+    if (i == MOCK_LATENCY_SLOTS) {
+        LT_LOG_ERROR("Mock HAL: latency table full, cannot set more latencies!");
+        return LT_FAIL;
+    }
+
+    dev->latency[i] = *lat;
+    if (i == dev->latency_count) {
+        dev->latency_count++;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_mock_hal_set_next_latency(lt_l2_state_t *s2, const mock_latency_t *lat)
+{
+    if (!s2 || !lat) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)s2->device;
+
+    dev->next_latency = *lat;
+    dev->next_latency_set = true;
+
+    return LT_OK;
+}
+
+uint32_t lt_mock_hal_busy_reads(lt_l2_state_t *s2)
+{
+    if (!s2) {
+        return 0;
+    }
+
+    return ((lt_dev_mock_t *)s2->device)->busy_reads;
+}
+
+lt_ret_t lt_mock_hal_set_max_speed(lt_l2_state_t *s2, const uint32_t max_speed_hz)
+{
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)s2->device;
+
+    dev->max_speed_hz = max_speed_hz;
+    dev->corrupt_next = true;
+
+    return LT_OK;
+}
+
+uint32_t lt_mock_hal_spi_speed(lt_l2_state_t *s2)
+{
+    if (!s2) {
+        return 0;
+    }
+
+    return ((lt_dev_mock_t *)s2->device)->speed_hz;
+}
+
+lt_ret_t lt_mock_hal_cache_bytes(lt_l2_state_t *s2, uint32_t *cleaned, uint32_t *invalidated)
+{
+    if (!s2 || !cleaned || !invalidated) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)s2->device;
+
+    *cleaned = dev->cache_cleaned;
+    *invalidated = dev->cache_invalidated;
+
+    return LT_OK;
+}
+
 // Platform API implementation ------------------------------------------------
 
 lt_ret_t lt_port_init(lt_l2_state_t *s2)
@@ -109,6 +273,17 @@ lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2)
         return LT_FAIL;
     }
 
+    // Busy frame was not taken from the queue, the response stays there.
+    if (dev->frame_busy) {
+        if (dev->busy_polls_left) {
+            dev->busy_polls_left--;
+        }
+        dev->busy_reads++;
+        dev->frame_busy = false;
+        dev->frame_in_progress = false;
+        return LT_OK;
+    }
+
     // End of transaction (frame), pop the response.
     if (dev->mock_queue_count == 0) {
         // This could happen only if no response was enqueued and Libtropic
@@ -138,6 +313,32 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len
         return LT_FAIL;
     }
 
+    // Offset to the internal buffer + tx_len must not exceed the buffer size.
+    if (tx_len + offset > TR01_L1_LEN_MAX) {
+        LT_LOG_ERROR("Mock HAL: SPI Transfer exceeds L1 buffer size!");
+        return LT_L1_DATA_LEN_ERROR;
+    }
+
+    // First byte of the frame on MOSI is the request ID: the chip either starts executing an L2 Request, or is asked
+    // for the response, which is not ready while busy.
+    if ((dev->frame_bytes_transferred == 0) && (offset == 0) && (tx_len > 0)) {
+        if (s2->buff[0] == TR01_L1_GET_RESPONSE_REQ_ID) {
+            dev->frame_busy = mock_read_busy(dev);
+        }
+        else {
+            mock_start_busy(dev, s2->buff[0]);
+        }
+    }
+
+    if (dev->frame_busy) {
+        memset(s2->buff + offset, 0xff, tx_len);
+        if (dev->frame_bytes_transferred == 0) {
+            s2->buff[offset] = dev->busy_chip_status;
+        }
+        dev->frame_bytes_transferred += tx_len;
+        return LT_OK;
+    }
+
     if (dev->mock_queue_count == 0) {
         LT_LOG_ERROR("Mock HAL: no response queued!");
         return LT_FAIL;
@@ -146,12 +347,6 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len
     // Peek next response.
     mock_miso_data_t *r = &dev->mock_queue[dev->mock_queue_head];
 
-    // Offset to the internal buffer + tx_len must not exceed the buffer size.
-    if (tx_len + offset > TR01_L1_LEN_MAX) {
-        LT_LOG_ERROR("Mock HAL: SPI Transfer exceeds L1 buffer size!");
-        return LT_L1_DATA_LEN_ERROR;
-    }
-
     // If reading more bytes than available in the mocked response, log. Normally, this is OK:
     // this happens when writing, as on the MOSI there is whole L2 Request and on MISO there is just CHIP_STATUS byte.
     // During reading, this should not happen, as the lt_l1_read always reads up to the length of the response frame. It
@@ -161,6 +356,16 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len
     }
 
     memcpy(s2->buff + offset, r->data + dev->frame_bytes_transferred, tx_len);
+    // Too fast clock corrupts every other L2 Request, so TROPIC01 answers it by CRC_ERR. Single CHIP_STATUS bytes of
+    // writes are kept.
+    if (dev->max_speed_hz && (dev->speed_hz > dev->max_speed_hz) && (r->len >= MOCK_L2_RSP_LEN_MIN)
+        && (dev->frame_bytes_transferred <= TR01_L2_STATUS_OFFSET)
+        && (dev->frame_bytes_transferred + tx_len > TR01_L2_STATUS_OFFSET)) {
+        if (dev->corrupt_next) {
+            s2->buff[offset + TR01_L2_STATUS_OFFSET - dev->frame_bytes_transferred] = TR01_L2_STATUS_CRC_ERR;
+        }
+        dev->corrupt_next = !dev->corrupt_next;
+    }
     dev->frame_bytes_transferred += tx_len;
 
     LT_LOG_DEBUG("Mock HAL queue position: head=%zu, tail=%zu, count=%zu", dev->mock_queue_head, dev->mock_queue_tail,
@@ -172,6 +377,275 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len
     return LT_OK;
 }
 
+#ifdef LT_PORT_SPI_TRANSFER_V
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms)
+{
+    if (!s2 || (!segs && seg_cnt) || (seg_cnt > LT_SPI_V_SEGS_MAX)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = LT_OK;
+
+    if (flags & LT_SPI_V_CSN_LOW) {
+        ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        uint8_t *frame_pos = s2->buff + segs[i].offset;
+        if (segs[i].tx && (segs[i].tx != frame_pos)) {
+            memcpy(frame_pos, segs[i].tx, segs[i].len);
+        }
+        ret = lt_port_spi_transfer(s2, segs[i].offset, segs[i].len, timeout_ms);
+        if (ret != LT_OK) {
+            lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+            LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
+            return ret;
+        }
+        if (segs[i].rx && (segs[i].rx != frame_pos)) {
+            memcpy(segs[i].rx, frame_pos, segs[i].len);
+        }
+    }
+
+    if (flags & LT_SPI_V_CSN_HIGH) {
+        return lt_port_spi_csn_high(s2);
+    }
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY
+lt_ret_t lt_port_spi_read_ready(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms, uint16_t max_tries,
+                                uint32_t timeout_ms)
+{
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)(s2->device);
+
+    lt_ret_t ret;
+
+    // Emulates a server polling the chip: queued frames are consumed as the attempts go.
+    for (uint16_t i = 0; i < max_tries; i++) {
+        ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        s2->buff[0] = TR01_L1_GET_RESPONSE_REQ_ID;
+        ret = lt_port_spi_transfer(s2, 0, 1, timeout_ms);
+        if ((ret == LT_OK) && (s2->buff[0] & TR01_L1_CHIP_MODE_READY_bit)
+            && !(s2->buff[0] & TR01_L1_CHIP_MODE_ALARM_bit)) {
+            ret = lt_port_spi_transfer(s2, 1, 2, timeout_ms);
+            if ((ret == LT_OK) && (s2->buff[1] != 0xff)) {
+                if (TR01_L1_CHIP_STATUS_SIZE + 2 + s2->buff[2] + 2 > max_len) {
+                    ret = LT_L1_DATA_LEN_ERROR;
+                }
+                else {
+                    ret = lt_port_spi_transfer(s2, 3, s2->buff[2] + 2, timeout_ms);
+                }
+                if (ret == LT_OK) {
+                    return lt_port_spi_csn_high(s2);
+                }
+            }
+        }
+        if (ret != LT_OK) {
+            lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+            LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
+            return ret;
+        }
+
+        ret = lt_port_spi_csn_high(s2);
+        if ((ret != LT_OK) || (s2->buff[0] & TR01_L1_CHIP_MODE_ALARM_bit)) {
+            return ret;
+        }
+
+        // Only emulated busy periods are timed, queued responses are consumed without waiting.
+        if (dev->busy) {
+            ret = lt_port_delay(s2, retry_delay_ms);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+    }
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+lt_ret_t lt_port_spi_read_ready_nowait(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms,
+                                       uint16_t max_tries, uint32_t timeout_ms)
+{
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)(s2->device);
+
+    // Emulates a server which is done by the next call after the timed busy period, the polling itself is left to
+    // read_ready.
+    if (!dev->read_pending) {
+        dev->read_pending = true;
+        return LT_L1_CHIP_BUSY;
+    }
+    if (dev->busy && (mock_now_us() < dev->busy_until_us)) {
+        return LT_L1_CHIP_BUSY;
+    }
+    dev->read_pending = false;
+
+    return lt_port_spi_read_ready(s2, max_len, retry_delay_ms, max_tries, timeout_ms);
+}
+#endif
+
+#ifdef LT_PORT_L3_TUNNEL
+/** Max number of polls for one L2 Response frame by the emulated bridge. */
+#define MOCK_TUNNEL_MAX_POLLS 1000
+
+/** Sends L2 Request frame of given length in l2 buffer, as the bridge does. */
+static lt_ret_t mock_tunnel_write(lt_l2_state_t *s2, const uint16_t len)
+{
+    lt_ret_t ret = lt_port_spi_csn_low(s2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_port_spi_transfer(s2, 0, len, 0);
+    lt_ret_t ret_csn = lt_port_spi_csn_high(s2);
+
+    return (ret != LT_OK) ? ret : ret_csn;
+}
+
+/** Polls for L2 Response frame into l2 buffer, as the bridge does. Only CHIP_STATUS and STATUS are valid if TROPIC01
+ *  is not ready, in Alarm Mode or has no response. */
+static lt_ret_t mock_tunnel_read(lt_l2_state_t *s2)
+{
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)(s2->device);
+
+    for (int i = 0; i < MOCK_TUNNEL_MAX_POLLS; i++) {
+        lt_ret_t ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        s2->buff[0] = TR01_L1_GET_RESPONSE_REQ_ID;
+        s2->buff[1] = 0xff;
+        ret = lt_port_spi_transfer(s2, 0, 1, 0);
+        if ((ret == LT_OK) && (s2->buff[0] & TR01_L1_CHIP_MODE_READY_bit)
+            && !(s2->buff[0] & TR01_L1_CHIP_MODE_ALARM_bit)) {
+            ret = lt_port_spi_transfer(s2, 1, 2, 0);
+            if ((ret == LT_OK) && (s2->buff[1] != 0xff)) {
+                ret = lt_port_spi_transfer(s2, 3, s2->buff[2] + 2, 0);
+                lt_ret_t ret_csn = lt_port_spi_csn_high(s2);
+                return (ret != LT_OK) ? ret : ret_csn;
+            }
+        }
+        lt_ret_t ret_csn = lt_port_spi_csn_high(s2);
+        if ((ret != LT_OK) || (ret_csn != LT_OK) || (s2->buff[0] & TR01_L1_CHIP_MODE_ALARM_bit)) {
+            return (ret != LT_OK) ? ret : ret_csn;
+        }
+
+        if (dev->busy) {
+            ret = lt_port_delay(s2, 1);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_l3_tunnel(lt_l2_state_t *s2, const uint8_t *cmd, uint16_t cmd_len, const uint8_t **res,
+                           uint16_t *res_len, uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)(s2->device);
+
+    dev->tunnel_calls++;
+    if (dev->tunnel_unsupported) {
+        return LT_NOT_SUPPORTED;
+    }
+    if (cmd_len > TR01_L3_PACKET_MAX_SIZE) {
+        return LT_PARAM_ERR;
+    }
+
+    // Emulates the bridge with the queued frames. The command may be in l2 buffer, which the bridge uses.
+    memcpy(dev->tunnel_buff, cmd, cmd_len);
+    lt_ret_t ret = LT_OK;
+    struct lt_l2_encrypted_cmd_req_t *req = (struct lt_l2_encrypted_cmd_req_t *)s2->buff;
+    for (uint16_t offset = 0; offset < cmd_len; offset += TR01_L2_CHUNK_MAX_DATA_SIZE) {
+        req->req_id = TR01_L2_ENCRYPTED_CMD_REQ_ID;
+        req->req_len = (uint8_t)lt_min((uint16_t)(cmd_len - offset), TR01_L2_CHUNK_MAX_DATA_SIZE);
+        memcpy(req->l3_chunk, dev->tunnel_buff + offset, req->req_len);
+        uint16_t crc = crc16(s2->buff, req->req_len + 2);
+        req->l3_chunk[req->req_len] = crc >> 8;
+        req->l3_chunk[req->req_len + 1] = crc & 0x00FF;
+
+        ret = mock_tunnel_write(s2, req->req_len + 4);
+        if (ret == LT_OK) {
+            ret = mock_tunnel_read(s2);
+        }
+        if ((ret != LT_OK) || (lt_l2_status_check(s2->buff[1]) != LT_L2_REQ_CONT)) {
+            break;
+        }
+    }
+
+    // L3 Result is collected behind CHIP_STATUS and STATUS, the command is not needed anymore.
+    uint16_t len = TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE;
+    if ((ret == LT_OK) && (lt_l2_status_check(s2->buff[1]) == LT_OK)) {
+        do {
+            ret = mock_tunnel_read(s2);
+            if (ret != LT_OK) {
+                break;
+            }
+            lt_ret_t ret_frame = lt_l2_status_check(s2->buff[1]);
+            if ((ret_frame != LT_OK) && (ret_frame != LT_L2_RES_CONT)) {
+                break;
+            }
+            if (len + s2->buff[2] > sizeof(dev->tunnel_buff)) {
+                LT_LOG_ERROR("Mock HAL: L3 Result exceeds L3 packet size!");
+                return LT_FAIL;
+            }
+            memcpy(dev->tunnel_buff + len, s2->buff + 3, s2->buff[2]);
+            len += s2->buff[2];
+        } while (s2->buff[1] == TR01_L2_STATUS_RESULT_CONT);
+    }
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    dev->tunnel_buff[0] = s2->buff[0];
+    dev->tunnel_buff[1] = s2->buff[1];
+    *res = dev->tunnel_buff;
+    *res_len = (s2->buff[1] == TR01_L2_STATUS_RESULT_OK) ? len : TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE;
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_CRC16_PORT
+uint16_t lt_port_crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+    // Mock of a CRC unit, bit by bit calculation.
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x8005) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+#endif
+
 lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
 {
     LT_UNUSED(s2);
@@ -185,6 +659,57 @@ lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
     return LT_OK;
 }
 
+#ifdef LT_PORT_DELAY_US
+lt_ret_t lt_port_delay_us(lt_l2_state_t *s2, uint32_t us)
+{
+    LT_UNUSED(s2);
+
+    if (us == 0) {
+        return LT_OK;
+    }
+
+    usleep((useconds_t)us);
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_SPI_SET_SPEED
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    ((lt_dev_mock_t *)(s2->device))->speed_hz = hz;
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_CACHE_MAINT
+void lt_port_cache_clean(lt_l2_state_t *s2, const void *addr, size_t len)
+{
+    LT_UNUSED(addr);
+
+    ((lt_dev_mock_t *)(s2->device))->cache_cleaned += (uint32_t)len;
+}
+
+void lt_port_cache_invalidate(lt_l2_state_t *s2, void *addr, size_t len)
+{
+    LT_UNUSED(addr);
+
+    ((lt_dev_mock_t *)(s2->device))->cache_invalidated += (uint32_t)len;
+}
+#endif
+
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+#endif
+
 lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
 {
     LT_UNUSED(s2);
@@ -192,12 +717,8 @@ lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
         return LT_PARAM_ERR;
     }
 
-    uint8_t *buff_ptr = (uint8_t *)buff;
-    for (size_t i = 0; i < count; i++) {
-        buff_ptr[i] = (uint8_t)(rand() & 0xFF);
-    }
-
-    return LT_OK;
+    // Tests reproducing the random bytes seed the generator by lt_posix_rng_seed().
+    return lt_posix_rng_bytes(buff, count);
 }
 
 int lt_port_log(const char *format, ...)
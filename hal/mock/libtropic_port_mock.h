@@ -26,8 +26,36 @@ typedef struct mock_miso_data_t {
     uint8_t data[TR01_L1_LEN_MAX];
 } mock_miso_data_t;
 
-/// @brief Depth of the mock response queue.
-#define MOCK_QUEUE_DEPTH 16
+/// @brief Depth of the mock response queue, fits responses of a dozen L3 Commands mocked ahead.
+#define MOCK_QUEUE_DEPTH 64
+
+/// @brief Maximal number of L2 Request IDs with emulated latency, see lt_mock_hal_set_latency().
+#define MOCK_LATENCY_SLOTS 8
+
+/// @brief Length of the shortest L2 Response frame (with CHIP_STATUS), shorter responses are CHIP_STATUS bytes.
+#define MOCK_L2_RSP_LEN_MIN \
+    (TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE + TR01_L2_REQ_RSP_LEN_SIZE + TR01_L2_REQ_RSP_CRC_SIZE)
+
+/**
+ * @brief Emulated busy period of the chip after an L2 Request.
+ *
+ * @details While busy, reads of the response (GET_RESPONSE) are answered by `chip_status` and 0xFF bytes instead of
+ * the queued response, which is kept in the queue. The busy period ends when at least `polls` reads were answered
+ * and at least `ms` milliseconds passed since the L2 Request was sent.
+ */
+typedef struct mock_latency_t {
+    /** @brief L2 Request ID the latency applies to, ignored by lt_mock_hal_set_next_latency(). */
+    uint8_t req_id;
+    /**
+     * @brief CHIP_STATUS returned while busy. With the READY bit set, TROPIC01 executes the request and has no
+     * response yet (STATUS 0xFF), otherwise it is not ready at all.
+     */
+    uint8_t chip_status;
+    /** @brief Number of reads answered as busy. */
+    uint16_t polls;
+    /** @brief Minimal duration of the busy period in milliseconds. */
+    uint32_t ms;
+} mock_latency_t;
 
 /**
  * @brief Device structure for Mock HAL port.
@@ -46,6 +74,48 @@ typedef struct lt_dev_mock_t {
     bool frame_in_progress;
     /** @private @brief Number of bytes transferred in the current frame so far. */
     size_t frame_bytes_transferred;
+
+    /** @private @brief Emulated latencies per L2 Request ID. */
+    mock_latency_t latency[MOCK_LATENCY_SLOTS];
+    /** @private @brief Number of valid entries in latency. */
+    size_t latency_count;
+    /** @private @brief Latency of the next L2 Request, overrides latency. */
+    mock_latency_t next_latency;
+    /** @private @brief Flag indicating if next_latency is set. */
+    bool next_latency_set;
+    /** @private @brief Flag indicating if the chip is busy executing the last L2 Request. */
+    bool busy;
+    /** @private @brief CHIP_STATUS returned while busy. */
+    uint8_t busy_chip_status;
+    /** @private @brief Number of reads still to be answered as busy. */
+    uint16_t busy_polls_left;
+    /** @private @brief End of the busy period (CLOCK_MONOTONIC, microseconds). */
+    uint64_t busy_until_us;
+    /** @private @brief Flag indicating if the current frame is answered as busy. */
+    bool frame_busy;
+    /** @private @brief Number of reads answered as busy since the reset. */
+    uint32_t busy_reads;
+    /** @private @brief SPI clock set by lt_port_spi_set_speed(), 0 if not set since the reset. */
+    uint32_t speed_hz;
+    /** @private @brief Fastest SPI clock without errors, 0 for no limit. */
+    uint32_t max_speed_hz;
+    /** @private @brief Flag indicating if the next L2 Response frame read too fast reports CRC_ERR. */
+    bool corrupt_next;
+    /** @private @brief Flag indicating if lt_port_spi_read_ready_nowait() started the polling. */
+    bool read_pending;
+    /** @private @brief Number of L3 Commands passed to lt_port_l3_tunnel() since the reset. */
+    uint32_t tunnel_calls;
+    /**
+     * @private @brief Flag indicating if lt_port_l3_tunnel() reports the bridge is not available. Set by the reset, so
+     * the tests mocking L3 Results after sending the L3 Command keep working; tests of the bridge clear it.
+     */
+    bool tunnel_unsupported;
+    /** @private @brief Number of bytes passed to lt_port_cache_clean() since the reset. */
+    uint32_t cache_cleaned;
+    /** @private @brief Number of bytes passed to lt_port_cache_invalidate() since the reset. */
+    uint32_t cache_invalidated;
+    /** @private @brief Command and response of the emulated bridge: CHIP_STATUS, STATUS and L3 Result packet. */
+    uint8_t tunnel_buff[TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE + TR01_L3_PACKET_MAX_SIZE];
 } lt_dev_mock_t;
 
 // Test control API -----------------------------------------------------
@@ -69,6 +139,64 @@ lt_ret_t lt_mock_hal_reset(lt_l2_state_t *s2);
  */
 lt_ret_t lt_mock_hal_enqueue_response(lt_l2_state_t *s2, const uint8_t *data, const size_t len);
 
+/**
+ * @brief Emulate latency of the chip after each L2 Request with the given ID.
+ *
+ * @details The latency stays set until lt_mock_hal_reset(). Setting `polls` and `ms` to zero removes it.
+ *
+ * @param lat Latency, `lat->req_id` selects the L2 Request.
+ * @return LT_OK on success, LT_FAIL if all MOCK_LATENCY_SLOTS are used, LT_PARAM_ERR on invalid parameters.
+ */
+lt_ret_t lt_mock_hal_set_latency(lt_l2_state_t *s2, const mock_latency_t *lat);
+
+/**
+ * @brief Emulate latency of the chip after the next L2 Request, whatever its ID is.
+ *
+ * @details Used once, takes precedence over lt_mock_hal_set_latency(). L3 Command IDs are encrypted on the wire, so
+ * latency of an L3 Command is emulated by calling this function before the command (the busy period starts after its
+ * first chunk).
+ *
+ * @param lat Latency, `lat->req_id` is ignored.
+ * @return LT_OK on success, LT_PARAM_ERR on invalid parameters.
+ */
+lt_ret_t lt_mock_hal_set_next_latency(lt_l2_state_t *s2, const mock_latency_t *lat);
+
+/**
+ * @brief Get number of reads answered as busy since the last lt_mock_hal_reset().
+ *
+ * @return Number of busy reads, 0 on invalid parameters.
+ */
+uint32_t lt_mock_hal_busy_reads(lt_l2_state_t *s2);
+
+/**
+ * @brief Emulate an SPI link, which corrupts L2 Requests when clocked faster than the given clock.
+ *
+ * @details While the clock set by lt_port_spi_set_speed() is above `max_speed_hz`, STATUS of every other queued L2
+ * Response frame, starting with the first one, is replaced by CRC_ERR as it is read. So the first frame is resent
+ * and the resent one passes. The limit stays set until lt_mock_hal_reset().
+ *
+ * @param max_speed_hz Fastest SPI clock without errors, 0 for no limit.
+ * @return LT_OK on success, LT_PARAM_ERR on invalid parameters.
+ */
+lt_ret_t lt_mock_hal_set_max_speed(lt_l2_state_t *s2, const uint32_t max_speed_hz);
+
+/**
+ * @brief Get SPI clock set by lt_port_spi_set_speed().
+ *
+ * @return SPI clock in Hz, 0 if not set since the last lt_mock_hal_reset() or on invalid parameters.
+ */
+uint32_t lt_mock_hal_spi_speed(lt_l2_state_t *s2);
+
+/**
+ * @brief Get number of bytes passed to lt_port_cache_clean() and lt_port_cache_invalidate() since the last
+ * lt_mock_hal_reset().
+ *
+ * @param cleaned     Number of cleaned bytes
+ * @param invalidated Number of invalidated bytes
+ * @return LT_OK on success, LT_PARAM_ERR on invalid parameters.
+ */
+lt_ret_t lt_mock_hal_cache_bytes(lt_l2_state_t *s2, uint32_t *cleaned, uint32_t *invalidated);
+
 #ifdef __cplusplus
 }
 #endif
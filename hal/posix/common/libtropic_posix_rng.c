@@ -0,0 +1,192 @@
+/**
+ * @file libtropic_posix_rng.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Host random bytes for the POSIX ports: ChaCha20 keystream keyed by getentropy(), buffered per thread.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_posix_rng.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+
+/** Size of the ChaCha20 key. */
+#define LT_POSIX_RNG_KEY_LEN 32
+/** Size of one ChaCha20 block. */
+#define LT_POSIX_RNG_BLOCK_LEN 64
+/** Size of the keystream buffer, the first LT_POSIX_RNG_KEY_LEN bytes of it key the next refill. */
+#define LT_POSIX_RNG_BUFF_LEN (LT_POSIX_RNG_BLOCKS * LT_POSIX_RNG_BLOCK_LEN)
+
+LT_STATIC_ASSERT(LT_POSIX_RNG_BLOCKS >= 1)
+LT_STATIC_ASSERT(LT_POSIX_RNG_RESEED_BYTES >= 1)
+
+/** Generator of one thread. */
+struct lt_posix_rng_t {
+    /** ChaCha20 key of the next refill. */
+    uint32_t key[LT_POSIX_RNG_KEY_LEN / 4];
+    /** Keystream, bytes before pos were returned or used as the key and are zeroed. */
+    uint8_t buff[LT_POSIX_RNG_BUFF_LEN];
+    size_t pos;
+    /** Bytes returned since the generator was keyed by getentropy(). */
+    size_t returned;
+    /** Key is valid. */
+    bool keyed;
+    /** Key comes from lt_posix_rng_seed(), it is never replaced by getentropy(). */
+    bool seeded;
+};
+
+static _Thread_local struct lt_posix_rng_t lt_posix_rng;
+
+static inline uint32_t lt_posix_rng_rotl(const uint32_t v, const int n) { return (v << n) | (v >> (32 - n)); }
+
+#define LT_POSIX_RNG_QR(a, b, c, d)                 \
+    a += b;                                         \
+    d = lt_posix_rng_rotl(d ^ a, 16);               \
+    c += d;                                         \
+    b = lt_posix_rng_rotl(b ^ c, 12);               \
+    a += b;                                         \
+    d = lt_posix_rng_rotl(d ^ a, 8);                \
+    c += d;                                         \
+    b = lt_posix_rng_rotl(b ^ c, 7);
+
+/**
+ * @brief Computes one ChaCha20 block (RFC 8439) with zero nonce.
+ *
+ * @param key      Key
+ * @param counter  Block counter
+ * @param out      Block, LT_POSIX_RNG_BLOCK_LEN bytes
+ */
+static void lt_posix_rng_block(const uint32_t *key, const uint32_t counter, uint8_t *out)
+{
+    // "expand 32-byte k"
+    uint32_t in[16] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574, key[0], key[1], key[2], key[3],
+                       key[4],     key[5],     key[6],     key[7],     counter, 0,     0,      0};
+    uint32_t x[16];
+
+    memcpy(x, in, sizeof(x));
+    for (int i = 0; i < 10; i++) {
+        LT_POSIX_RNG_QR(x[0], x[4], x[8], x[12])
+        LT_POSIX_RNG_QR(x[1], x[5], x[9], x[13])
+        LT_POSIX_RNG_QR(x[2], x[6], x[10], x[14])
+        LT_POSIX_RNG_QR(x[3], x[7], x[11], x[15])
+        LT_POSIX_RNG_QR(x[0], x[5], x[10], x[15])
+        LT_POSIX_RNG_QR(x[1], x[6], x[11], x[12])
+        LT_POSIX_RNG_QR(x[2], x[7], x[8], x[13])
+        LT_POSIX_RNG_QR(x[3], x[4], x[9], x[14])
+    }
+    for (int i = 0; i < 16; i++) {
+        uint32_t v = x[i] + in[i];
+        out[4 * i] = (uint8_t)v;
+        out[4 * i + 1] = (uint8_t)(v >> 8);
+        out[4 * i + 2] = (uint8_t)(v >> 16);
+        out[4 * i + 3] = (uint8_t)(v >> 24);
+    }
+    memset(x, 0, sizeof(x));
+    memset(in, 0, sizeof(in));
+}
+
+/**
+ * @brief Refills the keystream buffer, its first bytes replace the key.
+ *
+ * @param rng  Generator of the thread
+ */
+static void lt_posix_rng_refill(struct lt_posix_rng_t *rng)
+{
+    for (uint32_t i = 0; i < LT_POSIX_RNG_BLOCKS; i++) {
+        lt_posix_rng_block(rng->key, i, rng->buff + i * LT_POSIX_RNG_BLOCK_LEN);
+    }
+    // Fast key erasure: the key of the returned bytes does not survive the refill.
+    memcpy(rng->key, rng->buff, sizeof(rng->key));
+    memset(rng->buff, 0, sizeof(rng->key));
+    rng->pos = sizeof(rng->key);
+}
+
+/**
+ * @brief Keys the generator by getentropy().
+ *
+ * @param rng  Generator of the thread
+ * @return     LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_posix_rng_reseed(struct lt_posix_rng_t *rng)
+{
+    if (0 != getentropy(rng->key, sizeof(rng->key))) {
+        LT_LOG_ERROR("lt_posix_rng_bytes: getentropy() failed (%s)!", strerror(errno));
+        return LT_FAIL;
+    }
+    rng->keyed = true;
+    rng->returned = 0;
+    lt_posix_rng_refill(rng);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_posix_rng_bytes(void *buff, size_t count)
+{
+    if (!buff && count) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_posix_rng_t *rng = &lt_posix_rng;
+    uint8_t *buff_ptr = (uint8_t *)buff;
+
+    if (!rng->keyed || (!rng->seeded && (rng->returned >= LT_POSIX_RNG_RESEED_BYTES))) {
+        lt_ret_t ret = lt_posix_rng_reseed(rng);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    while (count) {
+        if (rng->pos == sizeof(rng->buff)) {
+            lt_posix_rng_refill(rng);
+        }
+        size_t n = sizeof(rng->buff) - rng->pos;
+        if (n > count) {
+            n = count;
+        }
+        memcpy(buff_ptr, rng->buff + rng->pos, n);
+        memset(rng->buff + rng->pos, 0, n);
+        rng->pos += n;
+        rng->returned += n;
+        buff_ptr += n;
+        count -= n;
+    }
+
+    return LT_OK;
+}
+
+void lt_posix_rng_seed(const uint64_t seed)
+{
+    struct lt_posix_rng_t *rng = &lt_posix_rng;
+
+    // Key is the seed stretched by SplitMix64.
+    uint64_t state = seed;
+    for (size_t i = 0; i < sizeof(rng->key) / sizeof(rng->key[0]); i += 2) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        rng->key[i] = (uint32_t)z;
+        rng->key[i + 1] = (uint32_t)(z >> 32);
+    }
+    rng->keyed = true;
+    rng->seeded = true;
+    rng->returned = 0;
+    lt_posix_rng_refill(rng);
+}
+
+void lt_posix_rng_unseed(void)
+{
+    struct lt_posix_rng_t *rng = &lt_posix_rng;
+
+    memset(rng, 0, sizeof(*rng));
+}
@@ -0,0 +1,63 @@
+#ifndef LIBTROPIC_POSIX_RNG_H
+#define LIBTROPIC_POSIX_RNG_H
+
+/**
+ * @file libtropic_posix_rng.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Host random bytes for the POSIX ports: ChaCha20 keystream keyed by getentropy(), buffered per thread.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of ChaCha20 blocks generated into the buffer of a thread at once. */
+#ifndef LT_POSIX_RNG_BLOCKS
+#define LT_POSIX_RNG_BLOCKS 8
+#endif
+
+/** Number of returned bytes after which the generator of a thread is keyed by getentropy() again. */
+#ifndef LT_POSIX_RNG_RESEED_BYTES
+#define LT_POSIX_RNG_RESEED_BYTES (1024 * 1024)
+#endif
+
+/**
+ * @brief Fills the buffer with random bytes, use it to implement `lt_port_random_bytes()`.
+ * @details Each thread has its own generator, keyed by getentropy() at the first use and after
+ * `LT_POSIX_RNG_RESEED_BYTES` bytes. Bytes are taken from a buffer of ChaCha20 keystream, whose first 32 bytes key the
+ * next refill, so the returned bytes cannot be recovered from the state of the thread. The generator is not reset by
+ * fork(), a child process has to call `lt_posix_rng_unseed()` to get bytes different from its parent.
+ *
+ * @param buff   Buffer for the random bytes
+ * @param count  Number of random bytes
+ * @retval       LT_OK Function executed successfully
+ * @retval       other Function did not execute successully
+ */
+lt_ret_t lt_posix_rng_bytes(void *buff, size_t count);
+
+/**
+ * @brief Keys the generator of the calling thread by the seed, so it returns the same bytes for the same seed.
+ * @details Only for tests and benchmarks which need reproducible host random bytes, as `srand()` was used before. The
+ * generator is not keyed by getentropy() again until `lt_posix_rng_unseed()` is called.
+ *
+ * @param seed   Seed of the generator
+ */
+void lt_posix_rng_seed(const uint64_t seed);
+
+/**
+ * @brief Drops the state of the generator of the calling thread, it is keyed by getentropy() at its next use.
+ */
+void lt_posix_rng_unseed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_POSIX_RNG_H
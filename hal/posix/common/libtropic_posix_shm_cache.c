@@ -0,0 +1,299 @@
+/**
+ * @file libtropic_posix_shm_cache.c
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Identity data of TROPIC01 devices shared by the processes of the host in a POSIX shared memory segment.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_posix_shm_cache.h"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+
+/** Magic of an initialized segment ("LTSC"). */
+#define LT_POSIX_SHM_CACHE_MAGIC 0x4353544cU
+/** Layout version of the segment, segments of other versions are refused. */
+#define LT_POSIX_SHM_CACHE_VERSION 1
+
+LT_STATIC_ASSERT((LT_POSIX_SHM_CACHE_ENTRIES >= 1) && (LT_POSIX_SHM_CACHE_ENTRIES <= UINT16_MAX))
+LT_STATIC_ASSERT(LT_POSIX_SHM_CACHE_READ_TRIES >= 1)
+
+/** Bytes of the entry identifying the device, read when looking for an entry. */
+#define LT_POSIX_SHM_CACHE_KEY_LEN offsetof(lt_posix_shm_cache_entry_t, spect_fw_ver)
+
+/** One entry of the segment, protected by a sequence lock. */
+struct lt_posix_shm_cache_slot_t {
+    /** Odd while the entry is written, incremented by 2 by each publish. */
+    uint32_t seq;
+    /** Slot holds an entry. */
+    uint32_t used;
+    /** Value of the publish counter of the segment when the entry was published. */
+    uint64_t stamp;
+    lt_posix_shm_cache_entry_t entry;
+};
+
+/** Layout of the shared memory segment, a new segment is all zeros. */
+struct lt_posix_shm_cache_seg_t {
+    /** LT_POSIX_SHM_CACHE_MAGIC once the fields below are set. */
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entries;
+    /** Size of the segment, segments of builds with other entry layout are refused. */
+    uint64_t size;
+    /** Publish counter, accessed atomically. */
+    uint64_t stamp;
+    struct lt_posix_shm_cache_slot_t slots[LT_POSIX_SHM_CACHE_ENTRIES];
+};
+
+/**
+ * @brief Copies bytes of the entry of the slot consistent with one publish.
+ *
+ * @param slot  Slot of the segment
+ * @param dst   Destination of the bytes
+ * @param len   Number of bytes from the start of the entry
+ * @param used  Set to whether the slot holds an entry
+ * @param seq   Set to the sequence number the copy belongs to
+ * @return      true if the copy is consistent, false if the entry was being published all the time
+ */
+static bool lt_posix_shm_cache_read(struct lt_posix_shm_cache_slot_t *slot, void *dst, const size_t len, bool *used,
+                                    uint32_t *seq)
+{
+    for (int i = 0; i < LT_POSIX_SHM_CACHE_READ_TRIES; i++) {
+        const uint32_t seq_before = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq_before & 1) {
+            sched_yield();
+            continue;
+        }
+
+        *used = slot->used != 0;
+        memcpy(dst, &slot->entry, len);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq_before) {
+            *seq = seq_before;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Tells whether the copied entry belongs to the device. */
+static bool lt_posix_shm_cache_match(const lt_posix_shm_cache_entry_t *entry, const char *dev,
+                                     const struct lt_chip_id_t *chip_id)
+{
+    if (!chip_id) {
+        return strncmp(entry->dev, dev, sizeof(entry->dev)) == 0;
+    }
+
+    struct lt_chip_id_t entry_chip_id;
+    if (lt_tr01_attrs_cache_chip_id(&entry->attrs, &entry_chip_id) != LT_OK) {
+        return false;
+    }
+
+    return memcmp(&entry_chip_id, chip_id, sizeof(entry_chip_id)) == 0;
+}
+
+lt_ret_t lt_posix_shm_cache_open(lt_posix_shm_cache_t *shm, const char *name)
+{
+    if (!shm || !name) {
+        return LT_PARAM_ERR;
+    }
+
+    shm->seg = NULL;
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        LT_LOG_ERROR("shm_open() of %s failed", name);
+        return LT_FAIL;
+    }
+
+    struct stat st;
+    const size_t size = sizeof(struct lt_posix_shm_cache_seg_t);
+    // A segment just created by another process may not be sized yet, it is sized the same here.
+    if ((fstat(fd, &st) != 0) || ((st.st_size == 0) && (ftruncate(fd, (off_t)size) != 0))) {
+        LT_LOG_ERROR("Sizing of shared memory segment %s failed", name);
+        close(fd);
+        return LT_FAIL;
+    }
+    if ((st.st_size != 0) && ((size_t)st.st_size != size)) {
+        LT_LOG_ERROR("Shared memory segment %s has another layout", name);
+        close(fd);
+        return LT_FAIL;
+    }
+
+    struct lt_posix_shm_cache_seg_t *seg = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (seg == MAP_FAILED) {
+        LT_LOG_ERROR("mmap() of %s failed", name);
+        return LT_FAIL;
+    }
+
+    // Processes initializing the segment at once write the same values.
+    if (__atomic_load_n(&seg->magic, __ATOMIC_ACQUIRE) != LT_POSIX_SHM_CACHE_MAGIC) {
+        seg->version = LT_POSIX_SHM_CACHE_VERSION;
+        seg->entries = LT_POSIX_SHM_CACHE_ENTRIES;
+        seg->size = size;
+        __atomic_store_n(&seg->magic, LT_POSIX_SHM_CACHE_MAGIC, __ATOMIC_RELEASE);
+    }
+    if ((seg->version != LT_POSIX_SHM_CACHE_VERSION) || (seg->entries != LT_POSIX_SHM_CACHE_ENTRIES)
+        || (seg->size != size)) {
+        LT_LOG_ERROR("Shared memory segment %s has another layout", name);
+        munmap(seg, size);
+        return LT_FAIL;
+    }
+
+    shm->seg = seg;
+
+    return LT_OK;
+}
+
+void lt_posix_shm_cache_close(lt_posix_shm_cache_t *shm)
+{
+    if (!shm || !shm->seg) {
+        return;
+    }
+
+    munmap(shm->seg, sizeof(*shm->seg));
+    shm->seg = NULL;
+}
+
+lt_ret_t lt_posix_shm_cache_unlink(const char *name)
+{
+    if (!name) {
+        return LT_PARAM_ERR;
+    }
+
+    return (shm_unlink(name) == 0) ? LT_OK : LT_FAIL;
+}
+
+lt_ret_t lt_posix_shm_cache_get(lt_posix_shm_cache_t *shm, const char *dev, const struct lt_chip_id_t *chip_id,
+                                lt_posix_shm_cache_entry_t *entry)
+{
+    if (!shm || !shm->seg || (!dev && !chip_id) || !entry) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint16_t i = 0; i < LT_POSIX_SHM_CACHE_ENTRIES; i++) {
+        bool used;
+        uint32_t seq;
+        if (lt_posix_shm_cache_read(&shm->seg->slots[i], entry, sizeof(*entry), &used, &seq) && used
+            && lt_posix_shm_cache_match(entry, dev, chip_id)) {
+            return LT_OK;
+        }
+    }
+    memset(entry, 0, sizeof(*entry));
+
+    return LT_FAIL;
+}
+
+lt_ret_t lt_posix_shm_cache_put(lt_posix_shm_cache_t *shm, const lt_posix_shm_cache_entry_t *entry)
+{
+    struct lt_chip_id_t chip_id;
+    if (!shm || !shm->seg || !entry || !memchr(entry->dev, '\0', sizeof(entry->dev))
+        || (lt_tr01_attrs_cache_chip_id(&entry->attrs, &chip_id) != LT_OK)) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_posix_shm_cache_seg_t *seg = shm->seg;
+    for (int i = 0; i < LT_POSIX_SHM_CACHE_READ_TRIES; i++) {
+        // Entry of the same chip first, then of the same device (its chip was replaced), a free slot, the oldest one.
+        struct lt_posix_shm_cache_slot_t *best = NULL;
+        uint32_t best_seq = 0;
+        int best_rank = 0;
+        uint64_t best_stamp = 0;
+        for (uint16_t j = 0; j < LT_POSIX_SHM_CACHE_ENTRIES; j++) {
+            struct lt_posix_shm_cache_slot_t *slot = &seg->slots[j];
+            lt_posix_shm_cache_entry_t key;
+            bool used;
+            uint32_t seq;
+            if (!lt_posix_shm_cache_read(slot, &key, LT_POSIX_SHM_CACHE_KEY_LEN, &used, &seq)) {
+                continue;
+            }
+
+            int rank = 1;
+            if (!used) {
+                rank = 2;
+            }
+            else if (lt_posix_shm_cache_match(&key, NULL, &chip_id)) {
+                rank = 4;
+            }
+            else if (lt_posix_shm_cache_match(&key, entry->dev, NULL)) {
+                rank = 3;
+            }
+            // Stamp is only a hint of the age, it is not read under the sequence lock.
+            const uint64_t stamp = __atomic_load_n(&slot->stamp, __ATOMIC_RELAXED);
+            if (!best || (rank > best_rank) || ((rank == 1) && (best_rank == 1) && (stamp < best_stamp))) {
+                best = slot;
+                best_seq = seq;
+                best_rank = rank;
+                best_stamp = stamp;
+            }
+        }
+        if (!best) {
+            return LT_FAIL;
+        }
+
+        // Fails if the slot was published since it was read, it is looked for again then.
+        uint32_t expected = best_seq;
+        if (!__atomic_compare_exchange_n(&best->seq, &expected, best_seq + 1, false, __ATOMIC_ACQUIRE,
+                                         __ATOMIC_RELAXED)) {
+            sched_yield();
+            continue;
+        }
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+
+        best->used = 1;
+        __atomic_store_n(&best->stamp, __atomic_add_fetch(&seg->stamp, 1, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+        memcpy(&best->entry, entry, sizeof(*entry));
+        __atomic_store_n(&best->seq, best_seq + 2, __ATOMIC_RELEASE);
+
+        return LT_OK;
+    }
+
+    return LT_FAIL;
+}
+
+lt_ret_t lt_posix_shm_cache_init(lt_posix_shm_cache_t *shm, lt_handle_t *h, const char *dev,
+                                 lt_posix_shm_cache_entry_t *entry, bool *filled)
+{
+    if (!shm || !shm->seg || !h || !dev || !entry || !filled || (strlen(dev) >= sizeof(entry->dev))) {
+        return LT_PARAM_ERR;
+    }
+
+    *filled = false;
+    if ((lt_posix_shm_cache_get(shm, dev, NULL, entry) == LT_OK) && lt_tr01_attrs_cache_valid(&entry->attrs)) {
+        return lt_init_warm(h, &entry->attrs);
+    }
+
+    lt_ret_t ret = lt_init(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    memset(entry, 0, sizeof(*entry));
+    memcpy(entry->dev, dev, strlen(dev) + 1);
+    ret = lt_tr01_attrs_export(h, &entry->attrs);
+    if (ret == LT_OK) {
+        ret = lt_get_info_spect_fw_ver(h, entry->spect_fw_ver);
+    }
+    if (ret != LT_OK) {
+        memset(entry, 0, sizeof(*entry));
+        lt_deinit(h);
+        return ret;
+    }
+    *filled = true;
+
+    return LT_OK;
+}
@@ -0,0 +1,144 @@
+#ifndef LIBTROPIC_POSIX_SHM_CACHE_H
+#define LIBTROPIC_POSIX_SHM_CACHE_H
+
+/**
+ * @file libtropic_posix_shm_cache.h
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ * @brief Identity data of TROPIC01 devices (attributes, CHIP_ID, FW versions, certificate store and STPUB) shared by
+ * the processes of the host in a POSIX shared memory segment, so each process warm-starts without reading them.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of TROPIC01 devices kept in the segment, the least recently published one is replaced. */
+#ifndef LT_POSIX_SHM_CACHE_ENTRIES
+#define LT_POSIX_SHM_CACHE_ENTRIES 8
+#endif
+
+/** Number of attempts of a reader to copy an entry while it is being written, then the read is a cache miss. */
+#ifndef LT_POSIX_SHM_CACHE_READ_TRIES
+#define LT_POSIX_SHM_CACHE_READ_TRIES 100
+#endif
+
+/** Size of the host name of the device, including the terminating NUL. */
+#define LT_POSIX_SHM_CACHE_DEV_LEN 64
+
+/**
+ * @brief Identity data of one TROPIC01, as kept in the segment. The structure holds no pointers.
+ * @details The entry is keyed by CHIP_ID of `attrs`. `dev` names the device on the host (e.g. "/dev/spidev0.0"), so a
+ * process finds the entry of its device before it talks to TROPIC01.
+ */
+typedef struct lt_posix_shm_cache_entry_t {
+    /** @brief Host name of the device, NUL-terminated. */
+    char dev[LT_POSIX_SHM_CACHE_DEV_LEN];
+    /** @brief CHIP_ID, Application FW version and TROPIC01 attributes for `lt_init_warm()`. */
+    lt_tr01_attrs_cache_t attrs;
+    /** @brief SPECT FW version as returned by `lt_get_info_spect_fw_ver()`. */
+    uint8_t spect_fw_ver[TR01_L2_GET_INFO_SPECT_FW_SIZE];
+    /** @brief Certificate store and STPUB, see `lt_verify_chip_and_start_secure_session_cached()`. */
+    lt_cert_cache_t certs;
+} lt_posix_shm_cache_entry_t;
+
+/** @brief Shared memory segment mapped by the process. Contents are private. */
+typedef struct lt_posix_shm_cache_t {
+    /** @private @brief Mapping of the segment. */
+    struct lt_posix_shm_cache_seg_t *seg;
+} lt_posix_shm_cache_t;
+
+/**
+ * @brief Maps the segment of the given name, creates it if it does not exist yet.
+ * @details The segment is created with mode 0600, so it is shared by the processes of one user. A segment created by
+ * a libtropic build with another layout is refused.
+ *
+ * @param shm   Segment structure
+ * @param name  Name of the segment for shm_open(), e.g. "/libtropic"
+ * @retval      LT_OK Function executed successfully
+ * @retval      LT_PARAM_ERR Invalid arguments
+ * @retval      LT_FAIL Segment cannot be mapped or has another layout
+ */
+lt_ret_t lt_posix_shm_cache_open(lt_posix_shm_cache_t *shm, const char *name);
+
+/**
+ * @brief Unmaps the segment, the segment itself stays for the other processes.
+ *
+ * @param shm  Segment structure
+ */
+void lt_posix_shm_cache_close(lt_posix_shm_cache_t *shm);
+
+/**
+ * @brief Removes the segment of the given name, processes which mapped it keep their mapping.
+ * @details A process which died while publishing an entry leaves the entry locked, removing the segment drops it.
+ *
+ * @param name  Name of the segment
+ * @retval      LT_OK Function executed successfully
+ * @retval      LT_FAIL Segment cannot be removed
+ */
+lt_ret_t lt_posix_shm_cache_unlink(const char *name);
+
+/**
+ * @brief Copies the entry of the device out of the segment.
+ * @details Readers take no lock: an entry is copied again when it was published meanwhile, up to
+ * `LT_POSIX_SHM_CACHE_READ_TRIES` times.
+ *
+ * @param shm      Mapped segment
+ * @param dev      Host name of the device, used if chip_id is NULL
+ * @param chip_id  CHIP_ID of the device, NULL to find it by dev
+ * @param entry    The entry is copied here
+ * @retval         LT_OK Function executed successfully
+ * @retval         LT_PARAM_ERR Invalid arguments
+ * @retval         LT_FAIL No entry of the device (or it is being published for too long)
+ */
+lt_ret_t lt_posix_shm_cache_get(lt_posix_shm_cache_t *shm, const char *dev, const struct lt_chip_id_t *chip_id,
+                                lt_posix_shm_cache_entry_t *entry);
+
+/**
+ * @brief Publishes the entry to the other processes, replacing the entry with the same CHIP_ID or the same device.
+ * @details Publishers of one entry are serialized, the least recently published entry is replaced when the segment
+ * is full.
+ *
+ * @note              Verify the certificate chain of `certs` (see `lt_cert_cache_get_store()`) before the entry is
+ *                    published, the other processes take STPUB from it.
+ *
+ * @param shm         Mapped segment
+ * @param entry       Entry with valid `attrs` and NUL-terminated `dev`
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid arguments or `attrs` not valid
+ * @retval            LT_FAIL Entry to replace is being published by another process
+ */
+lt_ret_t lt_posix_shm_cache_put(lt_posix_shm_cache_t *shm, const lt_posix_shm_cache_entry_t *entry);
+
+/**
+ * @brief Initializes handle by `lt_init_warm()` with the attributes of the entry of the device, without any
+ * communication with TROPIC01. If the segment has no entry of the device, the handle is initialized by `lt_init()`
+ * and the entry is filled from TROPIC01, except `certs`.
+ * @details Pass `certs` of the entry to `lt_verify_chip_and_start_secure_session_cached()`, which fills it if it is
+ * not valid. If the entry was filled here or `certs` were refreshed, publish it by `lt_posix_shm_cache_put()`.
+ *
+ * @note If the function fails, `lt_deinit` must not be called. In this case, the function handles the cleanup itself.
+ *
+ * @param shm         Mapped segment
+ * @param h           Handle for communication with TROPIC01
+ * @param dev         Host name of the device
+ * @param entry       Entry of the device is returned here
+ * @param filled      Set to true if the entry was filled from TROPIC01 and should be published
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_posix_shm_cache_init(lt_posix_shm_cache_t *shm, lt_handle_t *h, const char *dev,
+                                 lt_posix_shm_cache_entry_t *entry, bool *filled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_POSIX_SHM_CACHE_H
@@ -10,13 +10,17 @@
 
 #include <arpa/inet.h>
 #include <errno.h>
+#include <netinet/tcp.h>
 #include <inttypes.h>
+#include <poll.h>
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -24,6 +28,7 @@
 #include "libtropic_logging.h"
 #include "libtropic_macros.h"
 #include "libtropic_port.h"
+#include "libtropic_posix_rng.h"
 
 #if LT_USE_INT_PIN
 #error "Interrupt PIN not supported in the TCP port!"
@@ -76,19 +81,14 @@ static lt_ret_t send_all(const int socket_fd, const uint8_t *buffer, const size_
 }
 
 /**
- * @brief Send and receive data to/from the TCP port.
+ * @brief Sends the message in the TX buffer.
  *
  * @param dev TCP HAL Device structure
  * @param tx_payload_length_ptr Pointer to the length of the payload to send (excluding tag and length fields)
- * @param rx_payload_length_ptr Pointer to the length of the payload to receive (excluding tag and length fields)
  * @return LT_OK on success, LT_FAIL otherwise
  */
-static lt_ret_t communicate(lt_dev_posix_tcp_t *dev, int *tx_payload_length_ptr, int *rx_payload_length_ptr)
+static lt_ret_t exchange_send(lt_dev_posix_tcp_t *dev, int *tx_payload_length_ptr)
 {
-    int nb_bytes_received;
-    int nb_bytes_received_total = 0;
-    int nb_bytes_to_receive = LT_TCP_TAG_AND_LENGTH_SIZE;
-    uint8_t *rx_ptr = dev->rx_buffer.buff;
     // number of bytes to send
     int nb_bytes_to_send = LT_TCP_TAG_AND_LENGTH_SIZE;
 
@@ -99,9 +99,22 @@ static lt_ret_t communicate(lt_dev_posix_tcp_t *dev, int *tx_payload_length_ptr,
     // update payload length field
     dev->tx_buffer.len = nb_bytes_to_send - LT_TCP_TAG_AND_LENGTH_SIZE;
 
-    if (send_all(dev->socket_fd, dev->tx_buffer.buff, nb_bytes_to_send) != LT_OK) {
-        return LT_FAIL;
-    }
+    return send_all(dev->socket_fd, dev->tx_buffer.buff, nb_bytes_to_send);
+}
+
+/**
+ * @brief Receives one message into the RX buffer, waits for it.
+ *
+ * @param dev TCP HAL Device structure
+ * @param rx_payload_length_ptr Pointer to the length of the payload to receive (excluding tag and length fields)
+ * @return LT_OK on success, LT_FAIL otherwise
+ */
+static lt_ret_t exchange_recv(lt_dev_posix_tcp_t *dev, int *rx_payload_length_ptr)
+{
+    int nb_bytes_received;
+    int nb_bytes_received_total = 0;
+    int nb_bytes_to_receive = LT_TCP_TAG_AND_LENGTH_SIZE;
+    uint8_t *rx_ptr = dev->rx_buffer.buff;
 
     // receive data
     LT_LOG_DEBUG("- Receiving data from target.");
@@ -121,14 +134,15 @@ static lt_ret_t communicate(lt_dev_posix_tcp_t *dev, int *tx_payload_length_ptr,
     nb_bytes_received_total += nb_bytes_received;
     LT_LOG_DEBUG("Received %d bytes out of %d expected.", nb_bytes_received_total, nb_bytes_to_receive);
 
-    if (nb_bytes_received_total < nb_bytes_to_receive) {
+    if ((nb_bytes_received_total < nb_bytes_to_receive) && (nb_bytes_to_receive <= (int)LT_TCP_MAX_RECV_SIZE)) {
         rx_ptr += nb_bytes_received;
 
         for (int i = 0; i < LT_TCP_RX_ATTEMPTS; i++) {
             LT_LOG_DEBUG("Attempting to receive remaining bytes: attempt #%d.", i);
-            nb_bytes_received = recv(dev->socket_fd, dev->rx_buffer.buff, LT_TCP_MAX_RECV_SIZE, 0);
+            nb_bytes_received
+                = recv(dev->socket_fd, rx_ptr, nb_bytes_to_receive - nb_bytes_received_total, MSG_WAITALL);
 
-            if (nb_bytes_received < 0) {
+            if (nb_bytes_received <= 0) {
                 LT_LOG_ERROR("Receive failed: %s (%d).", strerror(errno), errno);
                 return LT_FAIL;
             }
@@ -147,6 +161,61 @@ static lt_ret_t communicate(lt_dev_posix_tcp_t *dev, int *tx_payload_length_ptr,
         return LT_FAIL;
     }
 
+#ifdef TCP_QUICKACK
+    // Delayed ACK would hold back the server's next send, the option is not permanent and is renewed every time.
+    if (!dev->unix_path) {
+        int one = 1;
+        setsockopt(dev->socket_fd, IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one));
+    }
+#endif
+
+    if (rx_payload_length_ptr != NULL) {
+        *rx_payload_length_ptr = nb_bytes_received_total - LT_TCP_TAG_AND_LENGTH_SIZE;
+    }
+
+    return LT_OK;
+}
+
+/**
+ * @brief Send and receive data to/from the TCP port, does not check the received tag.
+ *
+ * @param dev TCP HAL Device structure
+ * @param tx_payload_length_ptr Pointer to the length of the payload to send (excluding tag and length fields)
+ * @param rx_payload_length_ptr Pointer to the length of the payload to receive (excluding tag and length fields)
+ * @return LT_OK on success, LT_FAIL otherwise
+ */
+static lt_ret_t exchange(lt_dev_posix_tcp_t *dev, int *tx_payload_length_ptr, int *rx_payload_length_ptr)
+{
+    if (dev->poll_pending) {
+        // Polling started by lt_port_spi_read_ready_nowait() was abandoned, its response is not needed anymore.
+        LT_LOG_DEBUG("Discarding response of the pending poll.");
+        dev->poll_pending = false;
+        if (exchange_recv(dev, NULL) != LT_OK) {
+            return LT_FAIL;
+        }
+    }
+
+    if (exchange_send(dev, tx_payload_length_ptr) != LT_OK) {
+        return LT_FAIL;
+    }
+
+    return exchange_recv(dev, rx_payload_length_ptr);
+}
+
+/**
+ * @brief Send and receive data to/from the TCP port.
+ *
+ * @param dev TCP HAL Device structure
+ * @param tx_payload_length_ptr Pointer to the length of the payload to send (excluding tag and length fields)
+ * @param rx_payload_length_ptr Pointer to the length of the payload to receive (excluding tag and length fields)
+ * @return LT_OK on success, LT_FAIL otherwise
+ */
+static lt_ret_t communicate(lt_dev_posix_tcp_t *dev, int *tx_payload_length_ptr, int *rx_payload_length_ptr)
+{
+    if (exchange(dev, tx_payload_length_ptr, rx_payload_length_ptr) != LT_OK) {
+        return LT_FAIL;
+    }
+
     // server does not know the sent tag
     if ((lt_posix_tcp_tag_t)dev->rx_buffer.tag == LT_TCP_TAG_INVALID) {
         LT_LOG_ERROR("Tag %" PRIu8 " is not known by the server.", dev->tx_buffer.tag);
@@ -164,20 +233,18 @@ static lt_ret_t communicate(lt_dev_posix_tcp_t *dev, int *tx_payload_length_ptr,
     }
 
     LT_LOG_DEBUG("Rx tag and tx tag match: %" PRIu8 ".", dev->rx_buffer.tag);
-    if (rx_payload_length_ptr != NULL) {
-        *rx_payload_length_ptr = nb_bytes_received_total - LT_TCP_TAG_AND_LENGTH_SIZE;
-    }
 
     return LT_OK;
 }
 
-lt_ret_t lt_port_init(lt_l2_state_t *s2)
+/**
+ * @brief Connects to the server over TCP.
+ *
+ * @param dev TCP HAL Device structure
+ * @return LT_OK on success, LT_FAIL otherwise
+ */
+static lt_ret_t connect_tcp(lt_dev_posix_tcp_t *dev)
 {
-    lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
-
-    bzero(dev->tx_buffer.buff, LT_TCP_MAX_BUFFER_LEN);
-    bzero(dev->rx_buffer.buff, LT_TCP_MAX_BUFFER_LEN);
-
     // Create socket
     dev->socket_fd = socket(AF_INET, SOCK_STREAM, 0);
     if (dev->socket_fd < 0) {
@@ -200,6 +267,73 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         close(dev->socket_fd);
         return LT_FAIL;
     }
+
+    // Every message is a small request waiting for its response, do not let Nagle's algorithm hold it back.
+    int one = 1;
+    if (setsockopt(dev->socket_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)) < 0) {
+        LT_LOG_WARN("Could not set TCP_NODELAY: %s (%d).", strerror(errno), errno);
+    }
+
+    return LT_OK;
+}
+
+/**
+ * @brief Connects to the server over Unix domain socket.
+ *
+ * @param dev TCP HAL Device structure
+ * @return LT_OK on success, LT_FAIL otherwise
+ */
+static lt_ret_t connect_unix(lt_dev_posix_tcp_t *dev)
+{
+    struct sockaddr_un server;
+    memset(&server, 0, sizeof(server));
+    server.sun_family = AF_UNIX;
+    if (strlen(dev->unix_path) >= sizeof(server.sun_path)) {
+        LT_LOG_ERROR("Socket path too long: %s.", dev->unix_path);
+        return LT_FAIL;
+    }
+    strcpy(server.sun_path, dev->unix_path);
+
+    dev->socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (dev->socket_fd < 0) {
+        LT_LOG_ERROR("Could not create socket: %s (%d).", strerror(errno), errno);
+        return LT_FAIL;
+    }
+    LT_LOG_DEBUG("Socket created.");
+
+    LT_LOG_DEBUG("Connecting to %s.", dev->unix_path);
+    if (connect(dev->socket_fd, (struct sockaddr *)(&server), sizeof(server)) < 0) {
+        LT_LOG_ERROR("Could not connect: %s (%d).", strerror(errno), errno);
+        close(dev->socket_fd);
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_init(lt_l2_state_t *s2)
+{
+    lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
+
+    bzero(dev->tx_buffer.buff, LT_TCP_MAX_BUFFER_LEN);
+    bzero(dev->rx_buffer.buff, LT_TCP_MAX_BUFFER_LEN);
+
+    // Connection kept by the previous lt_port_deinit(), the server and what it supports stay the same.
+    if (dev->connected) {
+        LT_LOG_DEBUG("Reusing connection to the server.");
+        return LT_OK;
+    }
+
+    dev->framed_unsupported = false;
+    dev->read_ready_unsupported = false;
+    dev->poll_pending = false;
+    dev->l3_tunnel_unsupported = false;
+
+    lt_ret_t ret = dev->unix_path ? connect_unix(dev) : connect_tcp(dev);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    dev->connected = true;
     LT_LOG_DEBUG("Connected to the server.");
 
     return LT_OK;
@@ -209,7 +343,26 @@ lt_ret_t lt_port_deinit(lt_l2_state_t *s2)
 {
     lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
 
+    if (dev->keep_connection) {
+        LT_LOG_DEBUG("-- Keeping connection to the server");
+        return LT_OK;
+    }
+
+    return lt_port_posix_tcp_disconnect(dev);
+}
+
+lt_ret_t lt_port_posix_tcp_disconnect(lt_dev_posix_tcp_t *dev)
+{
+    if (!dev) {
+        return LT_PARAM_ERR;
+    }
+    if (!dev->connected) {
+        return LT_OK;
+    }
+
     LT_LOG_DEBUG("-- Server disconnect");
+    dev->connected = false;
+    dev->poll_pending = false;
     if (close(dev->socket_fd)) {
         LT_LOG_ERROR("close() failed: %s (%d)", strerror(errno), errno);
         return LT_FAIL;
@@ -267,6 +420,314 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_dat
     return LT_OK;
 }
 
+#ifdef LT_PORT_SPI_TRANSFER_V
+/**
+ * @brief Transfers the segments with separate messages, for servers without LT_TCP_TAG_SPI_TRANSFER_FRAMED.
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Segments to transfer
+ * @param seg_cnt     Number of segments
+ * @param flags       Combination of LT_SPI_V_CSN_LOW and LT_SPI_V_CSN_HIGH
+ * @return            LT_OK on success, LT_FAIL otherwise
+ */
+static lt_ret_t transfer_v_separate(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags)
+{
+    lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
+    lt_ret_t ret;
+
+    if (flags & LT_SPI_V_CSN_LOW) {
+        ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        int tx_payload_length = segs[i].len;
+        int rx_payload_length;
+
+        dev->tx_buffer.tag = LT_TCP_TAG_SPI_SEND;
+        memcpy(dev->tx_buffer.payload, segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset, segs[i].len);
+
+        if ((communicate(dev, &tx_payload_length, &rx_payload_length) != LT_OK)
+            || (rx_payload_length != segs[i].len)) {
+            lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+            LT_UNUSED(ret_unused);  // We don't care about it, we return LT_FAIL anyway.
+            return LT_FAIL;
+        }
+
+        memcpy(segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset, dev->rx_buffer.payload, segs[i].len);
+    }
+
+    if (flags & LT_SPI_V_CSN_HIGH) {
+        return lt_port_spi_csn_high(s2);
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
+
+    if (seg_cnt > LT_SPI_V_SEGS_MAX) {
+        return LT_PARAM_ERR;
+    }
+
+    if (dev->framed_unsupported) {
+        return transfer_v_separate(s2, segs, seg_cnt, flags);
+    }
+
+    LT_LOG_DEBUG("-- Sending chip select framed data through SPI bus.");
+
+    // Chip select pin and all segments are handled by a single message.
+    int tx_payload_length = 1;
+    int rx_payload_length;
+
+    dev->tx_buffer.tag = LT_TCP_TAG_SPI_TRANSFER_FRAMED;
+    dev->tx_buffer.payload[0] = ((flags & LT_SPI_V_CSN_LOW) ? LT_TCP_FRAMED_CSN_LOW : 0)
+                                | ((flags & LT_SPI_V_CSN_HIGH) ? LT_TCP_FRAMED_CSN_HIGH : 0);
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        if (tx_payload_length + segs[i].len > (int)LT_TCP_MAX_PAYLOAD_LEN) {
+            return LT_L1_DATA_LEN_ERROR;
+        }
+        memcpy(&dev->tx_buffer.payload[tx_payload_length], segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset,
+               segs[i].len);
+        tx_payload_length += segs[i].len;
+    }
+    int data_length = tx_payload_length - 1;
+
+    if (exchange(dev, &tx_payload_length, &rx_payload_length) != LT_OK) {
+        lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+        LT_UNUSED(ret_unused);  // We don't care about it, we return LT_FAIL anyway.
+        return LT_FAIL;
+    }
+
+    // Older servers (e.g. the TROPIC01 Model) do not know the tag and have not touched the chip select pin, so
+    // the transfer is simply repeated with separate messages.
+    if (((lt_posix_tcp_tag_t)dev->rx_buffer.tag == LT_TCP_TAG_INVALID)
+        || ((lt_posix_tcp_tag_t)dev->rx_buffer.tag == LT_TCP_TAG_UNSUPPORTED)) {
+        LT_LOG_DEBUG("Framed transfer not supported by the server, using separate messages.");
+        dev->framed_unsupported = true;
+        return transfer_v_separate(s2, segs, seg_cnt, flags);
+    }
+
+    if ((dev->rx_buffer.tag != dev->tx_buffer.tag) || (rx_payload_length != data_length)) {
+        LT_LOG_ERROR("Expected tag %" PRIu8 " with %d bytes, received %" PRIu8 " with %d bytes.",
+                     dev->tx_buffer.tag, data_length, dev->rx_buffer.tag, rx_payload_length);
+        lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+        LT_UNUSED(ret_unused);  // We don't care about it, we return LT_FAIL anyway.
+        return LT_FAIL;
+    }
+
+    const uint8_t *rx_ptr = dev->rx_buffer.payload;
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        memcpy(segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset, rx_ptr, segs[i].len);
+        rx_ptr += segs[i].len;
+    }
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY
+/**
+ * @brief Fills the TX buffer with LT_TCP_TAG_SPI_READ_READY.
+ *
+ * @param dev             TCP HAL Device structure
+ * @param max_len         Maximal length of the frame, including CHIP_STATUS
+ * @param retry_delay_ms  Delay between attempts
+ * @param max_tries       Maximal number of attempts
+ * @return                Length of the payload
+ */
+static int read_ready_request(lt_dev_posix_tcp_t *dev, uint16_t max_len, uint32_t retry_delay_ms, uint16_t max_tries)
+{
+    dev->tx_buffer.tag = LT_TCP_TAG_SPI_READ_READY;
+    dev->tx_buffer.payload[0] = max_len & 0x00ff;
+    dev->tx_buffer.payload[1] = (max_len & 0xff00) >> 8;
+    dev->tx_buffer.payload[2] = max_tries & 0x00ff;
+    dev->tx_buffer.payload[3] = (max_tries & 0xff00) >> 8;
+    dev->tx_buffer.payload[4] = retry_delay_ms & 0x000000ff;
+    dev->tx_buffer.payload[5] = (retry_delay_ms & 0x0000ff00) >> 8;
+    dev->tx_buffer.payload[6] = (retry_delay_ms & 0x00ff0000) >> 16;
+    dev->tx_buffer.payload[7] = (retry_delay_ms & 0xff000000) >> 24;
+
+    return 8;
+}
+
+/**
+ * @brief Checks response to LT_TCP_TAG_SPI_READ_READY in the RX buffer and copies the frame to the handle.
+ *
+ * @param s2                 Structure holding l2 state
+ * @param max_len            Maximal length of the frame, including CHIP_STATUS
+ * @param rx_payload_length  Length of the received payload
+ * @return                   LT_OK if polling ended, LT_NOT_SUPPORTED if the server does not know the tag, otherwise
+ *                           other error code
+ */
+static lt_ret_t read_ready_response(lt_l2_state_t *s2, uint16_t max_len, int rx_payload_length)
+{
+    lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
+
+    // Server does not know the tag, chip was not touched.
+    if (((lt_posix_tcp_tag_t)dev->rx_buffer.tag == LT_TCP_TAG_INVALID)
+        || ((lt_posix_tcp_tag_t)dev->rx_buffer.tag == LT_TCP_TAG_UNSUPPORTED)) {
+        LT_LOG_DEBUG("Polling not supported by the server, libtropic polls by itself.");
+        dev->read_ready_unsupported = true;
+        return LT_NOT_SUPPORTED;
+    }
+
+    if ((dev->rx_buffer.tag != LT_TCP_TAG_SPI_READ_READY) || (rx_payload_length < 1)) {
+        LT_LOG_ERROR("Expected tag %" PRIu8 ", received %" PRIu8 " with %d bytes.", LT_TCP_TAG_SPI_READ_READY,
+                     dev->rx_buffer.tag, rx_payload_length);
+        return LT_FAIL;
+    }
+
+    if (rx_payload_length > max_len) {
+        return LT_L1_DATA_LEN_ERROR;
+    }
+    // Frame has to be complete: CHIP_STATUS, STATUS, RSP_LEN, RSP_DATA and RSP_CRC.
+    if ((rx_payload_length > 1)
+        && ((rx_payload_length < 5) || (rx_payload_length != dev->rx_buffer.payload[2] + 5))) {
+        LT_LOG_ERROR("Incomplete frame received: %d bytes.", rx_payload_length);
+        return LT_L1_DATA_LEN_ERROR;
+    }
+
+    memcpy(s2->buff, dev->rx_buffer.payload, rx_payload_length);
+    if (rx_payload_length == 1) {
+        // Only CHIP_STATUS, no response was ready.
+        s2->buff[1] = 0xff;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_spi_read_ready(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms, uint16_t max_tries,
+                                uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
+
+    if (dev->read_ready_unsupported) {
+        return LT_NOT_SUPPORTED;
+    }
+
+    LT_LOG_DEBUG("-- Polling for response on the server.");
+
+    int tx_payload_length = read_ready_request(dev, max_len, retry_delay_ms, max_tries);
+    int rx_payload_length;
+
+    if (exchange(dev, &tx_payload_length, &rx_payload_length) != LT_OK) {
+        return LT_FAIL;
+    }
+
+    return read_ready_response(s2, max_len, rx_payload_length);
+}
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+lt_ret_t lt_port_spi_read_ready_nowait(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms,
+                                       uint16_t max_tries, uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
+
+    if (dev->read_ready_unsupported) {
+        return LT_NOT_SUPPORTED;
+    }
+
+    if (dev->poll_pending) {
+        struct pollfd pfd = {.fd = dev->socket_fd, .events = POLLIN, .revents = 0};
+        int n = poll(&pfd, 1, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                return LT_L1_CHIP_BUSY;
+            }
+            LT_LOG_ERROR("poll() failed: %s (%d).", strerror(errno), errno);
+            return LT_FAIL;
+        }
+        if (n == 0) {
+            return LT_L1_CHIP_BUSY;
+        }
+
+        int rx_payload_length;
+        dev->poll_pending = false;
+        if (exchange_recv(dev, &rx_payload_length) != LT_OK) {
+            return LT_FAIL;
+        }
+
+        // If the server gave up polling, the next call starts it again.
+        return read_ready_response(s2, max_len, rx_payload_length);
+    }
+
+    LT_LOG_DEBUG("-- Starting poll for response on the server.");
+
+    int tx_payload_length = read_ready_request(dev, max_len, retry_delay_ms, max_tries);
+    if (exchange_send(dev, &tx_payload_length) != LT_OK) {
+        return LT_FAIL;
+    }
+    dev->poll_pending = true;
+
+    return LT_L1_CHIP_BUSY;
+}
+#endif
+
+#ifdef LT_PORT_L3_TUNNEL
+lt_ret_t lt_port_l3_tunnel(lt_l2_state_t *s2, const uint8_t *cmd, uint16_t cmd_len, const uint8_t **res,
+                           uint16_t *res_len, uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
+
+    if (dev->l3_tunnel_unsupported) {
+        return LT_NOT_SUPPORTED;
+    }
+    if (cmd_len > LT_TCP_MAX_PAYLOAD_LEN) {
+        return LT_PARAM_ERR;
+    }
+
+    LT_LOG_DEBUG("-- Transferring L3 packet on the server.");
+
+    dev->tx_buffer.tag = LT_TCP_TAG_L3_TUNNEL;
+    memcpy(dev->tx_buffer.payload, cmd, cmd_len);
+    int tx_payload_length = cmd_len;
+    int rx_payload_length;
+
+    if (exchange(dev, &tx_payload_length, &rx_payload_length) != LT_OK) {
+        return LT_FAIL;
+    }
+
+    // Server does not know the tag, chip was not touched.
+    if (((lt_posix_tcp_tag_t)dev->rx_buffer.tag == LT_TCP_TAG_INVALID)
+        || ((lt_posix_tcp_tag_t)dev->rx_buffer.tag == LT_TCP_TAG_UNSUPPORTED)) {
+        LT_LOG_DEBUG("L3 tunnel not supported by the server, libtropic sends L2 chunks.");
+        dev->l3_tunnel_unsupported = true;
+        return LT_NOT_SUPPORTED;
+    }
+
+    if ((dev->rx_buffer.tag != LT_TCP_TAG_L3_TUNNEL) || (rx_payload_length < 2)) {
+        LT_LOG_ERROR("Expected tag %" PRIu8 ", received %" PRIu8 " with %d bytes.", LT_TCP_TAG_L3_TUNNEL,
+                     dev->rx_buffer.tag, rx_payload_length);
+        return LT_FAIL;
+    }
+
+    *res = dev->rx_buffer.payload;
+    *res_len = (uint16_t)rx_payload_length;
+
+    return LT_OK;
+}
+#endif
+
+int lt_port_posix_tcp_get_fd(const lt_dev_posix_tcp_t *dev)
+{
+    if (!dev || !dev->connected) {
+        return -1;
+    }
+
+    return dev->socket_fd;
+}
+
 lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
 {
     lt_dev_posix_tcp_t *dev = (lt_dev_posix_tcp_t *)(s2->device);
@@ -282,17 +743,22 @@ lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
     return communicate(dev, &payload_length, NULL);
 }
 
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+#endif
+
 lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
 {
     LT_UNUSED(s2);
 
-    uint8_t *buff_ptr = buff;
-    for (size_t i = 0; i < count; i++) {
-        // Number from rand() is guaranteed to have at least 15 bits valid
-        buff_ptr[i] = (uint8_t)(rand() & 0xFF);
-    }
-
-    return LT_OK;
+    return lt_posix_rng_bytes(buff, count);
 }
 
 int lt_port_log(const char *format, ...)
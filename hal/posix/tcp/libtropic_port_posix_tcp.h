@@ -10,6 +10,7 @@
  */
 
 #include <netinet/in.h>
+#include <stdbool.h>
 
 #include "libtropic_common.h"
 
@@ -18,7 +19,13 @@ extern "C" {
 #endif
 
 #define LT_TCP_TAG_AND_LENGTH_SIZE (sizeof(uint8_t) + sizeof(uint16_t))
-#define LT_TCP_MAX_PAYLOAD_LEN TR01_L2_MAX_FRAME_SIZE
+#ifdef LT_PORT_L3_TUNNEL
+/** Largest payload is the response of LT_TCP_TAG_L3_TUNNEL: CHIP_STATUS, STATUS and a whole L3 packet. */
+#define LT_TCP_MAX_PAYLOAD_LEN (TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE + TR01_L3_PACKET_MAX_SIZE)
+#else
+/** Largest payload is the one of LT_TCP_TAG_SPI_TRANSFER_FRAMED: flags byte followed by a whole L1 frame. */
+#define LT_TCP_MAX_PAYLOAD_LEN (1 + TR01_L1_LEN_MAX)
+#endif
 #define LT_TCP_MAX_BUFFER_LEN (LT_TCP_TAG_AND_LENGTH_SIZE + LT_TCP_MAX_PAYLOAD_LEN)
 
 #define LT_TCP_TX_ATTEMPTS 3
@@ -33,11 +40,27 @@ typedef enum lt_posix_tcp_tag_t {
     LT_TCP_TAG_POWER_ON = 0x04,
     LT_TCP_TAG_POWER_OFF = 0x05,
     LT_TCP_TAG_WAIT = 0x06,
+    /** Chip select framed SPI transfer in a single round-trip. Payload is a byte of LT_TCP_FRAMED_* flags followed
+     *  by the bytes to send, response payload holds the received bytes. */
+    LT_TCP_TAG_SPI_TRANSFER_FRAMED = 0x07,
+    /** Poll for L2 Response frame on the server's side. Payload is maximal frame length (uint16_t), maximal number
+     *  of attempts (uint16_t) and delay between them in ms (uint32_t), response payload holds the received frame
+     *  starting with CHIP_STATUS, or CHIP_STATUS of the last attempt only. */
+    LT_TCP_TAG_SPI_READ_READY = 0x08,
+    /** Transfer encrypted L3 Command packet on the server's side. Payload is the packet, the server sends it in L2
+     *  chunks, polls for the L2 Responses, resends corrupted ones and collects the L3 Result. Response payload is
+     *  CHIP_STATUS and STATUS of the last L2 Response frame, followed by the L3 Result packet for RESULT_OK. */
+    LT_TCP_TAG_L3_TUNNEL = 0x09,
     LT_TCP_TAG_RESET_TARGET = 0x10,
     LT_TCP_TAG_INVALID = 0xfd,
     LT_TCP_TAG_UNSUPPORTED = 0xfe,
 } lt_posix_tcp_tag_t;
 
+/** @brief Flag of LT_TCP_TAG_SPI_TRANSFER_FRAMED: drive chip select low before the transfer. */
+#define LT_TCP_FRAMED_CSN_LOW 0x01
+/** @brief Flag of LT_TCP_TAG_SPI_TRANSFER_FRAMED: drive chip select high after the transfer. */
+#define LT_TCP_FRAMED_CSN_HIGH 0x02
+
 /** @brief Structure for RX and TX buffers. */
 typedef struct lt_posix_tcp_buffer_t {
     union {
@@ -54,22 +77,57 @@ typedef struct lt_posix_tcp_buffer_t {
  * @brief Device structure for model port (TCP communication).
  *
  * @note Public members are meant to be configured by the developer before passing the handle to
- *       libtropic.
+ *       libtropic. The structure has to be zero-initialized before that.
  */
 typedef struct lt_dev_posix_tcp_t {
     /** @public @brief Address of the model server. */
     in_addr_t addr;
     /** @public @brief Port of the model server. */
     in_port_t port;
+    /** @public @brief Path of the server's Unix domain socket, NULL to connect to `addr` and `port` over TCP. */
+    const char *unix_path;
+    /** @public @brief Keep the connection open by lt_deinit(), so the next lt_init() reuses it. Close it by
+     *  lt_port_posix_tcp_disconnect(). */
+    bool keep_connection;
 
     /** @private @brief Socket file descriptor. */
     int socket_fd;
+    /** @private @brief Socket is connected to the server. */
+    bool connected;
     /** @private @brief Reception buffer. */
     struct lt_posix_tcp_buffer_t rx_buffer;
     /** @private @brief Emission buffer. */
     struct lt_posix_tcp_buffer_t tx_buffer;
+    /** @private @brief Server rejected LT_TCP_TAG_SPI_TRANSFER_FRAMED, separate messages are used instead. */
+    bool framed_unsupported;
+    /** @private @brief Server rejected LT_TCP_TAG_SPI_READ_READY, libtropic polls by itself. */
+    bool read_ready_unsupported;
+    /** @private @brief LT_TCP_TAG_SPI_READ_READY sent by lt_port_spi_read_ready_nowait() waits for its response. */
+    bool poll_pending;
+    /** @private @brief Server rejected LT_TCP_TAG_L3_TUNNEL, libtropic sends L3 packets in L2 chunks. */
+    bool l3_tunnel_unsupported;
 } lt_dev_posix_tcp_t;
 
+/**
+ * @brief Closes the connection to the server, e.g. the one kept by lt_deinit() with `keep_connection`.
+ *
+ * @param dev  Device structure
+ * @return     LT_OK if the connection was closed or there was none, otherwise LT_FAIL
+ */
+lt_ret_t lt_port_posix_tcp_disconnect(lt_dev_posix_tcp_t *dev);
+
+/**
+ * @brief Returns socket of the connection to the server, e.g. for an event loop driving asynchronous L2 operations.
+ * @details With `LT_PORT_SPI_READ_READY_NOWAIT`, the server polls TROPIC01 for the L2 Response frame in the
+ * background while the operation waits, and the socket becomes readable when the polling ended. Register the socket
+ * in the event loop (e.g. by `lt_linux_reactor_add_fd()`) and advance the operation when it is readable. The socket
+ * must not be read or written by the application.
+ *
+ * @param dev  Device structure
+ * @return     Socket file descriptor, -1 if not connected
+ */
+int lt_port_posix_tcp_get_fd(const lt_dev_posix_tcp_t *dev);
+
 #ifdef __cplusplus
 }
 #endif
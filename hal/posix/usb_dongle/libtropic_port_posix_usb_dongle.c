@@ -30,6 +30,7 @@
 #include "libtropic_logging.h"
 #include "libtropic_macros.h"
 #include "libtropic_port.h"
+#include "lt_hex.h"
 
 #if LT_USE_INT_PIN
 #error "Interrupt PIN not supported in the USB dongle port!"
@@ -91,6 +92,67 @@ static ssize_t read_port(int fd, uint8_t *buffer, size_t size)
     return received;
 }
 
+/**
+ * @brief Asks the dongle to switch to binary framing.
+ *
+ * @param device  Device structure with opened port
+ * @return        true if the dongle accepted binary framing
+ */
+static bool negotiate_binary(lt_dev_posix_usb_dongle_t *device)
+{
+    uint8_t cmd[] = LT_USB_DONGLE_BINARY_CMD;
+    if (write_port(device->fd, cmd, sizeof(cmd) - 1) != 0) {
+        return false;
+    }
+
+    uint8_t buff[4];
+    if ((read_port(device->fd, buff, sizeof(buff)) == sizeof(buff)) && !memcmp(buff, "OK\r\n", sizeof(buff))) {
+        return true;
+    }
+
+    // Older firmware answers by an error message (or nothing), drop whatever arrived.
+    usleep(LT_USB_DONGLE_READ_WRITE_DELAY * 1000);
+    tcflush(device->fd, TCIFLUSH);
+
+    return false;
+}
+
+/**
+ * @brief Sends a binary frame and receives the dongle's answer.
+ *
+ * @param device  Device structure
+ * @param flags   LT_USB_DONGLE_BINARY_KEEP_CS or 0 to release chip select after the transfer
+ * @param data    Bytes to send, replaced by the received ones
+ * @param len     Number of bytes
+ * @return        LT_OK if success, LT_L1_SPI_ERROR otherwise
+ */
+static lt_ret_t transfer_binary(lt_dev_posix_usb_dongle_t *device, const uint8_t flags, uint8_t *data,
+                                const uint16_t len)
+{
+    uint8_t frame[LT_USB_DONGLE_BINARY_HDR_SIZE + TR01_L1_LEN_MAX];
+
+    frame[0] = flags;
+    frame[1] = len & 0x00ff;
+    frame[2] = (len & 0xff00) >> 8;
+    if (len) {
+        memcpy(frame + LT_USB_DONGLE_BINARY_HDR_SIZE, data, len);
+    }
+
+    if (write_port(device->fd, frame, LT_USB_DONGLE_BINARY_HDR_SIZE + len) != 0) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    // Status byte followed by the received bytes.
+    if ((read_port(device->fd, frame, 1 + len) != 1 + len) || (frame[0] != LT_USB_DONGLE_BINARY_STATUS_OK)) {
+        return LT_L1_SPI_ERROR;
+    }
+    if (len) {
+        memcpy(data, frame + 1, len);
+    }
+
+    return LT_OK;
+}
+
 lt_ret_t lt_port_init(lt_l2_state_t *s2)
 {
     lt_dev_posix_usb_dongle_t *device = (lt_dev_posix_usb_dongle_t *)s2->device;
@@ -161,6 +223,11 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         return LT_FAIL;
     }
 
+    device->binary_active = device->binary_mode && negotiate_binary(device);
+    if (device->binary_mode && !device->binary_active) {
+        LT_LOG_WARN("USB dongle does not support binary framing, using ASCII hex.");
+    }
+
     return LT_OK;
 }
 
@@ -186,6 +253,17 @@ lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
     return LT_OK;
 }
 
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+#endif
+
 lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
 {
     LT_UNUSED(s2);
@@ -222,6 +300,10 @@ lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2)
 {
     lt_dev_posix_usb_dongle_t *device = (lt_dev_posix_usb_dongle_t *)s2->device;
 
+    if (device->binary_active) {
+        return transfer_binary(device, 0, NULL, 0);
+    }
+
     uint8_t cs_high[] = "CS=0\n";  // Yes, CS=0 really means that CSN is low
     if (write_port(device->fd, cs_high, 5) != 0) {
         return LT_L1_SPI_ERROR;
@@ -239,6 +321,67 @@ lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2)
     return LT_OK;
 }
 
+/**
+ * @brief Transfers bytes as ASCII hex characters.
+ *
+ * @param device   Device structure
+ * @param data     Bytes to send, replaced by the received ones
+ * @param len      Number of bytes
+ * @param keep_cs  Keep chip select low after the transfer
+ * @return         LT_OK if success, LT_L1_SPI_ERROR otherwise
+ */
+static lt_ret_t transfer_ascii(lt_dev_posix_usb_dongle_t *device, uint8_t *data, const uint16_t len,
+                               const bool keep_cs)
+{
+    // Bytes which are about to be sent are encoded as chars and stored to buffered_chars.
+    uint8_t buffered_chars[LT_USB_DONGLE_SPI_TRANSFER_BUFF_SIZE_MAX];
+    lt_hex_encode((char *)buffered_chars, data, len, true);
+
+    // Control characters (they are expected by USB dongle, see the top of this file for more information): 'x'
+    // keeps CS LOW, line feed alone releases CS after the transfer.
+    size_t chars_len = len * 2;
+    if (keep_cs) {
+        buffered_chars[chars_len++] = 'x';
+    }
+    buffered_chars[chars_len++] = '\n';
+
+    int ret = write_port(device->fd, buffered_chars, chars_len);
+    if (ret != 0) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    usleep(LT_USB_DONGLE_READ_WRITE_DELAY * 1000);
+
+    int read_bytes = read_port(device->fd, buffered_chars, (2 * len) + 2);
+    if (read_bytes != ((2 * len) + 2)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    if (lt_hex_decode(data, (const char *)buffered_chars, len) != LT_OK) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    return LT_OK;
+}
+
+/**
+ * @brief Transfers bytes in the framing negotiated with the dongle.
+ *
+ * @param device   Device structure
+ * @param data     Bytes to send, replaced by the received ones
+ * @param len      Number of bytes
+ * @param keep_cs  Keep chip select low after the transfer
+ * @return         LT_OK if success, LT_L1_SPI_ERROR otherwise
+ */
+static lt_ret_t transfer(lt_dev_posix_usb_dongle_t *device, uint8_t *data, const uint16_t len, const bool keep_cs)
+{
+    if (device->binary_active) {
+        return transfer_binary(device, keep_cs ? LT_USB_DONGLE_BINARY_KEEP_CS : 0, data, len);
+    }
+
+    return transfer_ascii(device, data, len, keep_cs);
+}
+
 lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_data_length, uint32_t timeout_ms)
 {
     LT_UNUSED(timeout_ms);
@@ -249,35 +392,53 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_dat
         return LT_L1_DATA_LEN_ERROR;
     }
 
-    // Bytes from handle which are about to be sent are encoded as chars and stored to buffered_chars.
-    uint8_t buffered_chars[LT_USB_DONGLE_SPI_TRANSFER_BUFF_SIZE_MAX] = {0};
-    for (int i = 0; i < tx_data_length; i++) {
-        sprintf((char *)(buffered_chars + i * 2), "%02" PRIX8, s2->buff[i + offset]);
-    }
+    return transfer(device, s2->buff + offset, tx_data_length, true);
+}
 
-    // Control characters to keep CS LOW (they are expected by USB dongle, see the top of this file
-    // for more information).
-    buffered_chars[tx_data_length * 2] = 'x';
-    buffered_chars[tx_data_length * 2 + 1] = '\n';
+#ifdef LT_PORT_SPI_TRANSFER_V
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    lt_dev_posix_usb_dongle_t *device = (lt_dev_posix_usb_dongle_t *)s2->device;
 
-    int ret = write_port(device->fd, buffered_chars, (tx_data_length * 2) + 2);
-    if (ret != 0) {
-        return LT_L1_SPI_ERROR;
+    if (seg_cnt > LT_SPI_V_SEGS_MAX) {
+        return LT_PARAM_ERR;
     }
 
-    lt_port_delay(s2, LT_USB_DONGLE_READ_WRITE_DELAY);
+    // CS LOW is handled automatically by the dongle, the segments are joined into a single transfer, which also
+    // releases CS if requested, so the whole L1 frame is one write and one read.
+    uint8_t frame[TR01_L1_LEN_MAX];
+    uint16_t len = 0;
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        if (len + segs[i].len > TR01_L1_LEN_MAX) {
+            lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+            LT_UNUSED(ret_unused);  // We don't care about it, we return LT_L1_DATA_LEN_ERROR anyway.
+            return LT_L1_DATA_LEN_ERROR;
+        }
+        memcpy(frame + len, segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset, segs[i].len);
+        len += segs[i].len;
+    }
+
+    if (len == 0) {
+        return (flags & LT_SPI_V_CSN_HIGH) ? lt_port_spi_csn_high(s2) : LT_OK;
+    }
 
-    int read_bytes = read_port(device->fd, buffered_chars, (2 * tx_data_length) + 2);
-    if (read_bytes != ((2 * tx_data_length) + 2)) {
+    if (transfer(device, frame, len, !(flags & LT_SPI_V_CSN_HIGH)) != LT_OK) {
+        lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+        LT_UNUSED(ret_unused);  // We don't care about it, we return LT_L1_SPI_ERROR anyway.
         return LT_L1_SPI_ERROR;
     }
 
-    for (size_t count = 0; count < tx_data_length; count++) {
-        sscanf((char *)&buffered_chars[count * 2], "%02" SCNx8, &s2->buff[count + offset]);
+    const uint8_t *rx_ptr = frame;
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        memcpy(segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset, rx_ptr, segs[i].len);
+        rx_ptr += segs[i].len;
     }
 
     return LT_OK;
 }
+#endif
 
 int lt_port_log(const char *format, ...)
 {
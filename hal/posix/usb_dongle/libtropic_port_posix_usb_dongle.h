@@ -9,6 +9,8 @@
  * @license For the license see LICENSE.md in the root directory of this source tree.
  */
 
+#include <stdbool.h>
+
 #include "libtropic_port.h"
 
 #ifdef __cplusplus
@@ -16,7 +18,17 @@ extern "C" {
 #endif
 
 #define LT_USB_DONGLE_READ_WRITE_DELAY 10
-#define LT_USB_DONGLE_SPI_TRANSFER_BUFF_SIZE_MAX ((TR01_L1_LEN_MAX * 2) + 1)
+/** Hex encoded bytes followed by two control characters. */
+#define LT_USB_DONGLE_SPI_TRANSFER_BUFF_SIZE_MAX ((TR01_L1_LEN_MAX * 2) + 2)
+
+/** Command switching the dongle to binary framing, answered by "OK\r\n" if the firmware supports it. */
+#define LT_USB_DONGLE_BINARY_CMD "BIN=1\n"
+/** Size of the binary frame header: flags byte and little endian 16-bit length. */
+#define LT_USB_DONGLE_BINARY_HDR_SIZE 3
+/** Flag of the binary frame: keep chip select low after the transfer. */
+#define LT_USB_DONGLE_BINARY_KEEP_CS 0x01
+/** Status byte starting the dongle's answer to a binary frame if the transfer succeeded. */
+#define LT_USB_DONGLE_BINARY_STATUS_OK 0x00
 
 /**
  * @brief Device structure for USB Dongle POSIX port.
@@ -29,9 +41,13 @@ typedef struct lt_dev_posix_usb_dongle_t {
     char dev_path[LT_DEVICE_PATH_MAX_LEN];
     /** @public @brief UART baudrate. */
     uint32_t baud_rate;
+    /** @public @brief Try to switch the dongle to binary framing, ASCII hex is used if the firmware refuses. */
+    bool binary_mode;
 
     /** @private @brief UART device file descriptor. */
     int fd;
+    /** @private @brief Dongle accepted binary framing. */
+    bool binary_active;
 } lt_dev_posix_usb_dongle_t;
 
 #ifdef __cplusplus
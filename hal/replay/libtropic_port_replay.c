@@ -0,0 +1,400 @@
+/**
+ * @file libtropic_port_replay.c
+ * @brief Port replaying a session recorded by the replay recorder, used to test and benchmark without TROPIC01.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_port_replay.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port.h"
+#include "libtropic_replay_format.h"
+
+/** Names of the recorded calls, used in logs. */
+static const char *const lt_replay_names[] = {
+    [LT_PORT_REC_INIT] = "init",
+    [LT_PORT_REC_DEINIT] = "deinit",
+    [LT_PORT_REC_CSN_LOW] = "csn_low",
+    [LT_PORT_REC_CSN_HIGH] = "csn_high",
+    [LT_PORT_REC_TRANSFER] = "spi_transfer",
+    [LT_PORT_REC_READ_READY] = "spi_read_ready",
+    [LT_PORT_REC_DELAY] = "delay",
+    [LT_PORT_REC_DELAY_ON_INT] = "delay_on_int",
+    [LT_PORT_REC_RANDOM] = "random_bytes",
+    [LT_PORT_REC_SET_SPEED] = "spi_set_speed",
+};
+
+/** One record read from the recording. */
+typedef struct {
+    uint8_t type;
+    uint8_t offset;
+    lt_ret_t ret;
+    uint32_t arg;
+    uint32_t dur_us;
+    uint32_t len;
+} lt_replay_rec_t;
+
+static const char *lt_replay_name(const uint8_t type)
+{
+    return (type < sizeof(lt_replay_names) / sizeof(lt_replay_names[0])) ? lt_replay_names[type] : "unknown";
+}
+
+/** Logs the first mismatch, all subsequent calls of the port fail. */
+static lt_ret_t lt_replay_diverged(lt_dev_replay_t *dev, const char *what)
+{
+    if (!dev->diverged) {
+        LT_LOG_ERROR("Replay HAL: record %" PRIu32 " of %s: %s!", dev->rec_idx, dev->path, what);
+        dev->diverged = true;
+    }
+
+    return LT_FAIL;
+}
+
+/** Waits for the recorded duration of the call, if timed replay is requested. */
+static void lt_replay_wait(const lt_dev_replay_t *dev, const lt_replay_rec_t *rec)
+{
+    if (!dev->timed || !rec->dur_us) {
+        return;
+    }
+
+    struct timespec t = {.tv_sec = rec->dur_us / 1000000, .tv_nsec = (long)(rec->dur_us % 1000000) * 1000};
+    while (nanosleep(&t, &t)) {
+    }
+}
+
+/**
+ * Reads the header of the next record and checks it is the expected call.
+ *
+ * @return LT_OK if the record matches, LT_FAIL otherwise (the mismatch is logged)
+ */
+static lt_ret_t lt_replay_next(lt_dev_replay_t *dev, const lt_port_rec_type_t type, lt_replay_rec_t *rec)
+{
+    uint8_t hdr[LT_REPLAY_REC_HDR_SIZE];
+    char what[64];
+
+    if (dev->diverged) {
+        return LT_FAIL;
+    }
+    if (!dev->f) {
+        return lt_replay_diverged(dev, "recording is not open");
+    }
+    if (fread(hdr, sizeof(hdr), 1, dev->f) != 1) {
+        snprintf(what, sizeof(what), "end of recording, %s called", lt_replay_name(type));
+        return lt_replay_diverged(dev, what);
+    }
+
+    rec->type = hdr[0];
+    rec->offset = hdr[1];
+    rec->ret = (lt_ret_t)lt_replay_get_u32(hdr + 4);
+    rec->arg = lt_replay_get_u32(hdr + 8);
+    rec->dur_us = lt_replay_get_u32(hdr + 12);
+    rec->len = lt_replay_get_u32(hdr + 16);
+
+    if (rec->type != type) {
+        snprintf(what, sizeof(what), "%s recorded, %s called", lt_replay_name(rec->type), lt_replay_name(type));
+        return lt_replay_diverged(dev, what);
+    }
+    if (rec->len > TR01_L1_LEN_MAX && type != LT_PORT_REC_RANDOM) {
+        return lt_replay_diverged(dev, "corrupted record");
+    }
+    dev->rec_idx++;
+
+    return LT_OK;
+}
+
+/** Reads the data of the record into the buffer. */
+static lt_ret_t lt_replay_read(lt_dev_replay_t *dev, void *buff, const uint32_t len)
+{
+    if (len && (fread(buff, len, 1, dev->f) != 1)) {
+        return lt_replay_diverged(dev, "truncated record");
+    }
+
+    return LT_OK;
+}
+
+/** Replays a call of the port without data. */
+static lt_ret_t lt_replay_call(lt_l2_state_t *s2, const lt_port_rec_type_t type, const uint32_t arg)
+{
+    lt_dev_replay_t *dev = (lt_dev_replay_t *)(s2->device);
+    lt_replay_rec_t rec;
+
+    lt_ret_t ret = lt_replay_next(dev, type, &rec);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (rec.arg != arg) {
+        return lt_replay_diverged(dev, "different argument");
+    }
+    lt_replay_wait(dev, &rec);
+
+    return rec.ret;
+}
+
+lt_ret_t lt_replay_hal_close(lt_dev_replay_t *dev)
+{
+    if (!dev || !dev->f) {
+        return LT_PARAM_ERR;
+    }
+
+    bool complete = (fgetc(dev->f) == EOF);
+    fclose(dev->f);
+    dev->f = NULL;
+    if (dev->diverged) {
+        return LT_FAIL;
+    }
+    if (!complete) {
+        LT_LOG_ERROR("Replay HAL: only %" PRIu32 " records of %s replayed!", dev->rec_idx, dev->path);
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_port_init(lt_l2_state_t *s2)
+{
+    lt_dev_replay_t *dev = (lt_dev_replay_t *)(s2->device);
+
+    if (!dev->f) {
+        uint8_t file_hdr[LT_REPLAY_FILE_HDR_SIZE];
+
+        dev->rec_idx = 0;
+        dev->diverged = false;
+        dev->f = fopen(dev->path, "rb");
+        if (!dev->f) {
+            LT_LOG_ERROR("Replay HAL: cannot open %s!", dev->path);
+            return LT_FAIL;
+        }
+        if ((fread(file_hdr, sizeof(file_hdr), 1, dev->f) != 1) || memcmp(file_hdr, LT_REPLAY_MAGIC, 4)
+            || (file_hdr[4] != LT_REPLAY_VERSION)) {
+            LT_LOG_ERROR("Replay HAL: %s is not a recording of version %d!", dev->path, LT_REPLAY_VERSION);
+            fclose(dev->f);
+            dev->f = NULL;
+            return LT_FAIL;
+        }
+    }
+
+    return lt_replay_call(s2, LT_PORT_REC_INIT, 0);
+}
+
+lt_ret_t lt_port_deinit(lt_l2_state_t *s2) { return lt_replay_call(s2, LT_PORT_REC_DEINIT, 0); }
+
+lt_ret_t lt_port_spi_csn_low(lt_l2_state_t *s2) { return lt_replay_call(s2, LT_PORT_REC_CSN_LOW, 0); }
+
+lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2) { return lt_replay_call(s2, LT_PORT_REC_CSN_HIGH, 0); }
+
+lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms)
+{
+    LT_UNUSED(timeout_ms);
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_replay_t *dev = (lt_dev_replay_t *)(s2->device);
+    uint8_t tx[TR01_L1_LEN_MAX];
+    lt_replay_rec_t rec;
+
+    if ((size_t)offset + tx_len > sizeof(s2->buff)) {
+        return LT_L1_DATA_LEN_ERROR;
+    }
+
+    lt_ret_t ret = lt_replay_next(dev, LT_PORT_REC_TRANSFER, &rec);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if ((rec.offset != offset) || (rec.len != tx_len)) {
+        return lt_replay_diverged(dev, "different length of the transfer");
+    }
+    ret = lt_replay_read(dev, tx, rec.len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (memcmp(tx, s2->buff + offset, tx_len)) {
+        return lt_replay_diverged(dev, "different bytes sent");
+    }
+    ret = lt_replay_read(dev, s2->buff + offset, rec.len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    lt_replay_wait(dev, &rec);
+
+    return rec.ret;
+}
+
+#ifdef LT_PORT_SPI_TRANSFER_V
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms)
+{
+    if (!s2 || (!segs && seg_cnt) || (seg_cnt > LT_SPI_V_SEGS_MAX)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = LT_OK;
+
+    // Vectored transfers are recorded as the calls they replace.
+    if (flags & LT_SPI_V_CSN_LOW) {
+        ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        uint8_t *frame_pos = s2->buff + segs[i].offset;
+        if ((size_t)segs[i].offset + segs[i].len > sizeof(s2->buff)) {
+            return LT_L1_DATA_LEN_ERROR;
+        }
+        if (segs[i].tx && (segs[i].tx != frame_pos)) {
+            memcpy(frame_pos, segs[i].tx, segs[i].len);
+        }
+        ret = lt_port_spi_transfer(s2, segs[i].offset, segs[i].len, timeout_ms);
+        if (ret != LT_OK) {
+            lt_ret_t ret_unused = lt_port_spi_csn_high(s2);
+            LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
+            return ret;
+        }
+        if (segs[i].rx && (segs[i].rx != frame_pos)) {
+            memcpy(segs[i].rx, frame_pos, segs[i].len);
+        }
+    }
+
+    if (flags & LT_SPI_V_CSN_HIGH) {
+        return lt_port_spi_csn_high(s2);
+    }
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY
+lt_ret_t lt_port_spi_read_ready(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms, uint16_t max_tries,
+                                uint32_t timeout_ms)
+{
+    LT_UNUSED(retry_delay_ms);
+    LT_UNUSED(max_tries);
+    LT_UNUSED(timeout_ms);
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_replay_t *dev = (lt_dev_replay_t *)(s2->device);
+    lt_replay_rec_t rec;
+
+    lt_ret_t ret = lt_replay_next(dev, LT_PORT_REC_READ_READY, &rec);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if ((rec.arg != max_len) || (rec.len > max_len)) {
+        return lt_replay_diverged(dev, "different maximal length of the frame");
+    }
+    ret = lt_replay_read(dev, s2->buff, rec.len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    lt_replay_wait(dev, &rec);
+
+    return rec.ret;
+}
+#endif
+
+#ifdef LT_CRC16_PORT
+uint16_t lt_port_crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x8005) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+#endif
+
+lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms) { return lt_replay_call(s2, LT_PORT_REC_DELAY, ms); }
+
+#ifdef LT_PORT_DELAY_US
+lt_ret_t lt_port_delay_us(lt_l2_state_t *s2, uint32_t us)
+{
+    // Not called by Libtropic directly, so not recorded.
+    if (((lt_dev_replay_t *)(s2->device))->timed && us) {
+        usleep((useconds_t)us);
+    }
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_SPI_SET_SPEED
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    return lt_replay_call(s2, LT_PORT_REC_SET_SPEED, hz);
+}
+#endif
+
+#if LT_USE_INT_PIN
+lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
+{
+    return lt_replay_call(s2, LT_PORT_REC_DELAY_ON_INT, ms);
+}
+#endif
+
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+#endif
+
+lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
+{
+    if (!s2 || !buff) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_dev_replay_t *dev = (lt_dev_replay_t *)(s2->device);
+    lt_replay_rec_t rec;
+
+    lt_ret_t ret = lt_replay_next(dev, LT_PORT_REC_RANDOM, &rec);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (rec.len != count) {
+        return lt_replay_diverged(dev, "different number of random bytes");
+    }
+    ret = lt_replay_read(dev, buff, rec.len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return rec.ret;
+}
+
+int lt_port_log(const char *format, ...)
+{
+    va_list args;
+    int ret;
+
+    va_start(args, format);
+    ret = vfprintf(stderr, format, args);
+    fflush(stderr);
+    va_end(args);
+
+    return ret;
+}
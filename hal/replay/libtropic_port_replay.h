@@ -0,0 +1,62 @@
+#ifndef LIBTROPIC_PORT_REPLAY_H
+#define LIBTROPIC_PORT_REPLAY_H
+
+/**
+ * @file libtropic_port_replay.h
+ * @brief Port replaying a session recorded by the replay recorder, used to test and benchmark without TROPIC01.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Device structure for the replay port.
+ *
+ * @note Data of the recording are returned for each call of the port in the recorded order, while the arguments of
+ * the calls (including all bytes sent to TROPIC01) are checked against the recording. The first mismatch is logged
+ * and all subsequent calls fail. Libtropic therefore has to be compiled with the same options which change its
+ * communication as the recorded one (e.g. `LT_PORT_SPI_READ_READY`, `LT_USE_INT_PIN`), none of which changes the
+ * result of the host crypto, as host random bytes are replayed too.
+ */
+typedef struct lt_dev_replay_t {
+    /** @public @brief Path to the recording. */
+    const char *path;
+    /** @public @brief Wait for the recorded duration of each call, otherwise the calls return immediately. */
+    bool timed;
+
+    /** @private @brief Opened recording. */
+    FILE *f;
+    /** @private @brief Index of the next record, used in logs. */
+    uint32_t rec_idx;
+    /** @private @brief Set after the first mismatch between the call and the recording. */
+    bool diverged;
+} lt_dev_replay_t;
+
+/**
+ * @brief Closes the recording opened by lt_port_init().
+ * @details The recording stays open across lt_deinit() and lt_init(), so more sessions recorded into one file can
+ * be replayed. Call it after the last lt_deinit().
+ *
+ * @param dev         Device structure of the replay port
+ *
+ * @retval            LT_OK         Whole recording was replayed
+ * @retval            LT_FAIL       Some calls did not match the recording, or some records were not replayed
+ * @retval            LT_PARAM_ERR  The recording is not open
+ */
+lt_ret_t lt_replay_hal_close(lt_dev_replay_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_PORT_REPLAY_H
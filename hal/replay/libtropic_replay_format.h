@@ -0,0 +1,62 @@
+#ifndef LIBTROPIC_REPLAY_FORMAT_H
+#define LIBTROPIC_REPLAY_FORMAT_H
+
+/**
+ * @file libtropic_replay_format.h
+ * @brief Format of files written by the replay recorder and read by the replay HAL.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ *
+ * The file starts with LT_REPLAY_FILE_HDR_SIZE bytes: LT_REPLAY_MAGIC, LT_REPLAY_VERSION and three reserved bytes.
+ * Then there is one record per call of the port (see lt_port_rec_t), each starting with LT_REPLAY_REC_HDR_SIZE bytes
+ * long little endian header:
+ *
+ * | Offset | Size | Field                                   |
+ * |--------|------|-----------------------------------------|
+ * | 0      | 1    | type (lt_port_rec_type_t)               |
+ * | 1      | 1    | offset                                  |
+ * | 2      | 2    | reserved                                |
+ * | 4      | 4    | ret (lt_ret_t)                          |
+ * | 8      | 4    | arg                                     |
+ * | 12     | 4    | dur_us                                  |
+ * | 16     | 4    | len                                     |
+ *
+ * followed by `len` sent bytes (LT_PORT_REC_TRANSFER only) and `len` received bytes.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief First four bytes of the file. */
+#define LT_REPLAY_MAGIC "LTRP"
+/** @brief Version of the format. */
+#define LT_REPLAY_VERSION 1
+/** @brief Size of the header of the file. */
+#define LT_REPLAY_FILE_HDR_SIZE 8
+/** @brief Size of the header of a record. */
+#define LT_REPLAY_REC_HDR_SIZE 20
+
+/** @brief Stores 32-bit value in little endian. */
+static inline void lt_replay_put_u32(uint8_t *p, const uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/** @brief Loads 32-bit little endian value. */
+static inline uint32_t lt_replay_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_REPLAY_FORMAT_H
@@ -0,0 +1,99 @@
+/**
+ * @file libtropic_replay_record.c
+ * @brief Recorder of calls of any POSIX port into a file replayable by the replay HAL.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_replay_record.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_replay_format.h"
+
+/** Writes one record, called by Libtropic after each call of the port. */
+static void lt_replay_record_write(void *ctx, const lt_port_rec_t *port_rec)
+{
+    lt_replay_recorder_t *rec = (lt_replay_recorder_t *)ctx;
+    uint8_t hdr[LT_REPLAY_REC_HDR_SIZE] = {0};
+    bool ok;
+
+    hdr[0] = (uint8_t)port_rec->type;
+    hdr[1] = port_rec->offset;
+    lt_replay_put_u32(hdr + 4, (uint32_t)port_rec->ret);
+    lt_replay_put_u32(hdr + 8, port_rec->arg);
+    lt_replay_put_u32(hdr + 12, port_rec->dur_us);
+    lt_replay_put_u32(hdr + 16, port_rec->len);
+
+    ok = (fwrite(hdr, sizeof(hdr), 1, rec->f) == 1);
+    if (ok && port_rec->tx && port_rec->len) {
+        ok = (fwrite(port_rec->tx, port_rec->len, 1, rec->f) == 1);
+    }
+    if (ok && port_rec->rx && port_rec->len) {
+        ok = (fwrite(port_rec->rx, port_rec->len, 1, rec->f) == 1);
+    }
+    // Flushed right away, so the file is complete even if the application aborts (e.g. on a failed assertion).
+    if (!ok || fflush(rec->f)) {
+        rec->failed = true;
+        return;
+    }
+    rec->records++;
+}
+
+lt_ret_t lt_replay_record_start(lt_handle_t *h, lt_replay_recorder_t *rec, const char *path)
+{
+    if (!h || !rec || !path) {
+        return LT_PARAM_ERR;
+    }
+
+    uint8_t file_hdr[LT_REPLAY_FILE_HDR_SIZE] = {0};
+    memcpy(file_hdr, LT_REPLAY_MAGIC, 4);
+    file_hdr[4] = LT_REPLAY_VERSION;
+
+    rec->records = 0;
+    rec->failed = false;
+    rec->f = fopen(path, "wb");
+    if (!rec->f) {
+        LT_LOG_ERROR("Replay recorder: cannot create %s!", path);
+        return LT_FAIL;
+    }
+    if (fwrite(file_hdr, sizeof(file_hdr), 1, rec->f) != 1) {
+        LT_LOG_ERROR("Replay recorder: cannot write %s!", path);
+        fclose(rec->f);
+        rec->f = NULL;
+        return LT_FAIL;
+    }
+
+    return lt_set_port_recorder(h, lt_replay_record_write, rec);
+}
+
+lt_ret_t lt_replay_record_stop(lt_handle_t *h, lt_replay_recorder_t *rec)
+{
+    if (!h || !rec || !rec->f) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_set_port_recorder(h, NULL, NULL);
+    if (fclose(rec->f)) {
+        rec->failed = true;
+    }
+    rec->f = NULL;
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (rec->failed) {
+        LT_LOG_ERROR("Replay recorder: writing failed, the recording is incomplete!");
+        return LT_FAIL;
+    }
+    LT_LOG_DEBUG("Replay recorder: %" PRIu32 " calls of the port recorded.", rec->records);
+
+    return LT_OK;
+}
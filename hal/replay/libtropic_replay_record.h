@@ -0,0 +1,63 @@
+#ifndef LIBTROPIC_REPLAY_RECORD_H
+#define LIBTROPIC_REPLAY_RECORD_H
+
+/**
+ * @file libtropic_replay_record.h
+ * @brief Recorder of calls of any POSIX port into a file replayable by the replay HAL.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief State of the replay recorder.
+ */
+typedef struct lt_replay_recorder_t {
+    /** @private @brief Recorded file. */
+    FILE *f;
+    /** @private @brief Number of written records. */
+    uint32_t records;
+    /** @private @brief Set if writing of a record failed, the file is incomplete. */
+    bool failed;
+} lt_replay_recorder_t;
+
+/**
+ * @brief Creates the file and starts recording calls of the port used by the handle.
+ * @note Libtropic has to be compiled with `LT_PORT_RECORD`. Call it before lt_init(), so the whole session including
+ * the initialization is recorded.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param rec         Recorder state, has to stay valid until lt_replay_record_stop()
+ * @param path        Path to the file, overwritten if it exists
+ *
+ * @retval            LT_OK   Recording started
+ * @retval            LT_FAIL File could not be created
+ */
+lt_ret_t lt_replay_record_start(lt_handle_t *h, lt_replay_recorder_t *rec, const char *path);
+
+/**
+ * @brief Stops recording and closes the file.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param rec         Recorder state
+ *
+ * @retval            LT_OK   Recording stopped, the file is complete
+ * @retval            LT_FAIL Writing of some record or closing of the file failed
+ */
+lt_ret_t lt_replay_record_stop(lt_handle_t *h, lt_replay_recorder_t *rec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBTROPIC_REPLAY_RECORD_H
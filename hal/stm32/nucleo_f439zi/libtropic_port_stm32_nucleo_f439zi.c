@@ -11,6 +11,7 @@
 
 #include "libtropic_port_stm32_nucleo_f439zi.h"
 
+#include <inttypes.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -24,6 +25,68 @@
 
 #define LT_STM32_F439ZI_GPIO_OUTPUT_CHECK_ATTEMPTS 10
 
+/**
+ * @brief Lets the core sleep until the next interrupt, or other tasks run if the idle hook is set.
+ *
+ * @param device  Device structure
+ */
+static void lt_stm32_f439zi_idle(const lt_dev_stm32_nucleo_f439zi_t *device)
+{
+    if (device->idle_hook) {
+        device->idle_hook();
+    }
+    else {
+        __WFI();
+    }
+}
+
+/**
+ * @brief Transfers data in place by DMA, waiting in the idle hook until the transfer completes.
+ *
+ * @param device      Device structure
+ * @param data        Data to send, overwritten by the received data
+ * @param len         Number of bytes to transfer
+ * @param timeout_ms  Timeout for the whole transfer
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_stm32_f439zi_transfer_dma(lt_dev_stm32_nucleo_f439zi_t *device, uint8_t *data, uint16_t len, uint32_t timeout_ms)
+{
+    int ret = HAL_SPI_TransmitReceive_DMA(&device->spi_handle, data, data, len);
+    if (ret != HAL_OK) {
+        LT_LOG_ERROR("HAL_SPI_TransmitReceive_DMA failed, ret=%d", ret);
+        return LT_L1_SPI_ERROR;
+    }
+
+    // The handle returns to the ready state from the DMA receive complete interrupt.
+    uint32_t time_initial = HAL_GetTick();
+    while (HAL_SPI_GetState(&device->spi_handle) != HAL_SPI_STATE_READY) {
+        if ((HAL_GetTick() - time_initial) > timeout_ms) {
+            HAL_SPI_Abort(&device->spi_handle);
+            LT_LOG_ERROR("SPI DMA transfer timed out!");
+            return LT_L1_SPI_ERROR;
+        }
+        if (device->idle_hook) {
+            device->idle_hook();
+        }
+        else {
+            // Interrupts are masked around the check, so the completion interrupt arriving
+            // right before WFI still wakes the core up.
+            __disable_irq();
+            if (HAL_SPI_GetState(&device->spi_handle) != HAL_SPI_STATE_READY) {
+                __WFI();
+            }
+            __enable_irq();
+        }
+    }
+
+    if (HAL_SPI_GetError(&device->spi_handle) != HAL_SPI_ERROR_NONE) {
+        LT_LOG_ERROR("SPI DMA transfer failed, error=0x%" PRIx32, HAL_SPI_GetError(&device->spi_handle));
+        return LT_L1_SPI_ERROR;
+    }
+
+    return LT_OK;
+}
+
 lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count)
 {
     lt_dev_stm32_nucleo_f439zi_t *device = (lt_dev_stm32_nucleo_f439zi_t *)(s2->device);
@@ -111,6 +174,11 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         return LT_L1_SPI_ERROR;
     }
 
+    if (device->dma_tx_handle && device->dma_rx_handle) {
+        __HAL_LINKDMA(&device->spi_handle, hdmatx, *device->dma_tx_handle);
+        __HAL_LINKDMA(&device->spi_handle, hdmarx, *device->dma_rx_handle);
+    }
+
     // GPIO for chip select.
     GPIO_InitTypeDef GPIO_InitStruct = {0};
     HAL_GPIO_WritePin(device->spi_cs_gpio_bank, device->spi_cs_gpio_pin, GPIO_PIN_SET);
@@ -123,7 +191,7 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
 #if LT_USE_INT_PIN
     // GPIO for INT pin.
     GPIO_InitStruct.Pin = device->int_gpio_pin;
-    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Mode = device->int_wait ? GPIO_MODE_IT_RISING : GPIO_MODE_INPUT;
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
     HAL_GPIO_Init(device->int_gpio_bank, &GPIO_InitStruct);
@@ -154,6 +222,9 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_dat
         LT_LOG_ERROR("Invalid data length!");
         return LT_L1_DATA_LEN_ERROR;
     }
+    if (device->dma_tx_handle && device->dma_rx_handle) {
+        return lt_stm32_f439zi_transfer_dma(device, s2->buff + offset, tx_data_length, timeout_ms);
+    }
     int ret = HAL_SPI_TransmitReceive(&device->spi_handle, s2->buff + offset, s2->buff + offset, tx_data_length,
                                       timeout_ms);
     if (ret != HAL_OK) {
@@ -164,11 +235,88 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_dat
     return LT_OK;
 }
 
-lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
+#ifdef LT_PORT_SPI_SET_SPEED
+/** Baudrate prescalers from the fastest, the one at index i divides the SPI kernel clock by 2^(i + 1). */
+static const uint32_t lt_stm32_f439zi_prescalers[]
+    = {SPI_BAUDRATEPRESCALER_2,  SPI_BAUDRATEPRESCALER_4,  SPI_BAUDRATEPRESCALER_8,   SPI_BAUDRATEPRESCALER_16,
+       SPI_BAUDRATEPRESCALER_32, SPI_BAUDRATEPRESCALER_64, SPI_BAUDRATEPRESCALER_128, SPI_BAUDRATEPRESCALER_256};
+
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    lt_dev_stm32_nucleo_f439zi_t *device = (lt_dev_stm32_nucleo_f439zi_t *)(s2->device);
+
+    // SPI2 and SPI3 are clocked by APB1, the others by APB2.
+    uint32_t kernel_hz = ((device->spi_instance == SPI2) || (device->spi_instance == SPI3)) ? HAL_RCC_GetPCLK1Freq()
+                                                                                            : HAL_RCC_GetPCLK2Freq();
+
+    // Smallest prescaler whose clock does not exceed the requested one, otherwise the largest prescaler.
+    size_t i = 0;
+    while ((i < sizeof(lt_stm32_f439zi_prescalers) / sizeof(lt_stm32_f439zi_prescalers[0]) - 1) && ((kernel_hz >> (i + 1)) > hz)) {
+        i++;
+    }
+
+    // The handle is initialized already, so HAL_SPI_Init() only reconfigures the peripheral.
+    device->spi_handle.Init.BaudRatePrescaler = lt_stm32_f439zi_prescalers[i];
+    int ret = HAL_SPI_Init(&device->spi_handle);
+    if (ret != HAL_OK) {
+        LT_LOG_ERROR("Failed to init SPI, ret=%d", ret);
+        return LT_L1_SPI_ERROR;
+    }
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_CACHE_MAINT
+// Parts with the data cache of the core (e.g. Cortex-M7 and M55) need the L2 buffer and L3 buffers aligned to its
+// 32 B lines (LT_BUFF_ALIGN), others do not maintain anything, as DMA sees what the core wrote.
+void lt_port_cache_clean(lt_l2_state_t *s2, const void *addr, size_t len)
 {
     LT_UNUSED(s2);
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr((uint32_t *)(uintptr_t)addr, (int32_t)len);
+#else
+    LT_UNUSED(addr);
+    LT_UNUSED(len);
+#endif
+}
+
+void lt_port_cache_invalidate(lt_l2_state_t *s2, void *addr, size_t len)
+{
+    LT_UNUSED(s2);
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr((uint32_t *)(uintptr_t)addr, (int32_t)len);
+#else
+    LT_UNUSED(addr);
+    LT_UNUSED(len);
+#endif
+}
+#endif
+
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void)
+{
+    uint32_t ms, val;
+
+    // Re-reading the tick if SysTick wrapped in between, the counter counts down from LOAD to 0 once a millisecond.
+    do {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+
+    return (uint64_t)ms * 1000 + (uint64_t)(SysTick->LOAD - val) * 1000 / (SysTick->LOAD + 1);
+}
+#endif
+
+lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
+{
+    lt_dev_stm32_nucleo_f439zi_t *device = (lt_dev_stm32_nucleo_f439zi_t *)(s2->device);
+    uint32_t time_initial = HAL_GetTick();
 
-    HAL_Delay(ms);
+    // Same minimal wait as HAL_Delay(), but the core sleeps or yields instead of spinning.
+    while ((HAL_GetTick() - time_initial) <= ms) {
+        lt_stm32_f439zi_idle(device);
+    }
 
     return LT_OK;
 }
@@ -180,12 +328,22 @@ lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
     uint32_t time_initial = HAL_GetTick();
     uint32_t time_actual;
 
+    if (device->int_wait) {
+        // Drop a signal of an earlier edge first, so the level read after it cannot miss a new one.
+        device->int_wait(device->int_ctx, 0);
+        if (HAL_GPIO_ReadPin(device->int_gpio_bank, device->int_gpio_pin)
+            || device->int_wait(device->int_ctx, ms)) {
+            return LT_OK;
+        }
+        return HAL_GPIO_ReadPin(device->int_gpio_bank, device->int_gpio_pin) ? LT_OK : LT_L1_INT_TIMEOUT;
+    }
+
     while ((HAL_GPIO_ReadPin(device->int_gpio_bank, device->int_gpio_pin) == 0)) {
         time_actual = HAL_GetTick();
         if ((time_actual - time_initial) > ms) {
             return LT_L1_INT_TIMEOUT;
         }
-        // HAL_Delay(ms);
+        lt_stm32_f439zi_idle(device);
     }
 
     return LT_OK;
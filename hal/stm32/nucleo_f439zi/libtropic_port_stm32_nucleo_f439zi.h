@@ -39,11 +39,41 @@ typedef struct lt_dev_stm32_nucleo_f439zi_t {
     uint16_t int_gpio_pin;
     /** @brief @public GPIO bank of the pin used for interrupts. Use STM32 macro (GPIOX). */
     GPIO_TypeDef *int_gpio_bank;
+
+    /**
+     * @brief @public Blocks the calling task until signalled from the INT pin interrupt or ms pass.
+     *
+     * @note If set, the INT pin is configured for a rising edge EXTI interrupt, whose callback
+     *       (HAL_GPIO_EXTI_Callback()) has to signal the waiting task, e.g. by a FreeRTOS task notification
+     *       or CMSIS-RTOS thread flag; the application enables the EXTI IRQ. It returns true if signalled and
+     *       is called with ms 0 to drop a stale signal. If NULL, the INT pin is polled in idle_hook().
+     */
+    bool (*int_wait)(void *ctx, uint32_t ms);
+    /** @brief @public Context passed to int_wait(). */
+    void *int_ctx;
 #endif
 
     /** @brief @public Random number generator handle. */
     RNG_HandleTypeDef *rng_handle;
 
+    /**
+     * @brief @public DMA handles for the SPI transmit and receive streams.
+     *
+     * @note If both are set, transfers are done by DMA and the core waits in idle_hook() until they complete.
+     *       The DMA streams must already be initialized and their interrupt handlers must call
+     *       HAL_DMA_IRQHandler(). If any of them is NULL, blocking HAL_SPI_TransmitReceive() is used.
+     */
+    DMA_HandleTypeDef *dma_tx_handle;
+    DMA_HandleTypeDef *dma_rx_handle;
+
+    /**
+     * @brief @public Called repeatedly while waiting for a DMA transfer or a delay to finish.
+     *
+     * @note Use it to yield to other RTOS tasks (e.g. `vTaskDelay(1)`). If NULL, the core sleeps in `__WFI()`
+     *       until the next interrupt (at latest the next SysTick).
+     */
+    void (*idle_hook)(void);
+
     /** @brief @private SPI handle. */
     SPI_HandleTypeDef spi_handle;
 } lt_dev_stm32_nucleo_f439zi_t;
@@ -37,6 +37,24 @@ typedef struct lt_dev_stm32_nucleo_l432kc_t {
     /** @brief @public Random number generator handle. */
     RNG_HandleTypeDef *rng_handle;
 
+    /**
+     * @brief @public DMA handles for the SPI transmit and receive streams.
+     *
+     * @note If both are set, transfers are done by DMA and the core waits in idle_hook() until they complete.
+     *       The DMA streams must already be initialized and their interrupt handlers must call
+     *       HAL_DMA_IRQHandler(). If any of them is NULL, blocking HAL_SPI_TransmitReceive() is used.
+     */
+    DMA_HandleTypeDef *dma_tx_handle;
+    DMA_HandleTypeDef *dma_rx_handle;
+
+    /**
+     * @brief @public Called repeatedly while waiting for a DMA transfer or a delay to finish.
+     *
+     * @note Use it to yield to other RTOS tasks (e.g. `vTaskDelay(1)`). If NULL, the core sleeps in `__WFI()`
+     *       until the next interrupt (at latest the next SysTick).
+     */
+    void (*idle_hook)(void);
+
     /** @brief @private SPI handle. */
     SPI_HandleTypeDef spi_handle;
 } lt_dev_stm32_nucleo_l432kc_t;
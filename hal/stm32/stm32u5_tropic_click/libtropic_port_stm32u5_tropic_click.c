@@ -17,6 +17,7 @@
 
 #include "libtropic_port_stm32u5_tropic_click.h"
 
+#include <inttypes.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -31,6 +32,20 @@
 #define LT_STM32U5_RESET_PULSE_MS      10
 #define LT_STM32U5_RESET_DELAY_MS      50
 
+/*=============================================================================
+ * Idle Waiting
+ *============================================================================*/
+
+/* Sleeps until the next interrupt (at latest SysTick), or runs the idle hook */
+static void stm32u5_idle(const lt_dev_stm32u5_tropic_click_t *device)
+{
+    if (device->idle_hook != NULL) {
+        device->idle_hook();
+    } else {
+        __WFI();
+    }
+}
+
 /*=============================================================================
  * Random Number Generation
  *============================================================================*/
@@ -142,6 +157,12 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
         return LT_L1_SPI_ERROR;
     }
 
+    /* Link DMA channels if used */
+    if (device->dma_tx_handle != NULL && device->dma_rx_handle != NULL) {
+        __HAL_LINKDMA(&device->spi_handle, hdmatx, *device->dma_tx_handle);
+        __HAL_LINKDMA(&device->spi_handle, hdmarx, *device->dma_rx_handle);
+    }
+
     /* Configure CS GPIO */
     GPIO_InitTypeDef gpio_init = {0};
     HAL_GPIO_WritePin(device->spi_cs_gpio_port, device->spi_cs_gpio_pin, GPIO_PIN_SET);
@@ -154,7 +175,7 @@ lt_ret_t lt_port_init(lt_l2_state_t *s2)
 #if LT_USE_INT_PIN
     /* Configure INT GPIO */
     gpio_init.Pin = device->int_gpio_pin;
-    gpio_init.Mode = GPIO_MODE_INPUT;
+    gpio_init.Mode = (device->int_wait != NULL) ? GPIO_MODE_IT_RISING : GPIO_MODE_INPUT;
     gpio_init.Pull = GPIO_NOPULL;
     gpio_init.Speed = GPIO_SPEED_FREQ_LOW;
     HAL_GPIO_Init(device->int_gpio_port, &gpio_init);
@@ -192,6 +213,43 @@ lt_ret_t lt_port_deinit(lt_l2_state_t *s2)
  * SPI Transfer
  *============================================================================*/
 
+static lt_ret_t stm32u5_transfer_dma(lt_dev_stm32u5_tropic_click_t *device, uint8_t *data, uint16_t len,
+                                     uint32_t timeout_ms)
+{
+    HAL_StatusTypeDef ret = HAL_SPI_TransmitReceive_DMA(&device->spi_handle, data, data, len);
+    if (ret != HAL_OK) {
+        LT_LOG_ERROR("HAL_SPI_TransmitReceive_DMA failed, ret=%d", ret);
+        return LT_L1_SPI_ERROR;
+    }
+
+    /* Handle gets ready again from the SPI end-of-transfer interrupt */
+    uint32_t start_tick = HAL_GetTick();
+    while (HAL_SPI_GetState(&device->spi_handle) != HAL_SPI_STATE_READY) {
+        if ((HAL_GetTick() - start_tick) > timeout_ms) {
+            HAL_SPI_Abort(&device->spi_handle);
+            LT_LOG_ERROR("SPI DMA transfer timeout");
+            return LT_L1_SPI_ERROR;
+        }
+        if (device->idle_hook != NULL) {
+            device->idle_hook();
+        } else {
+            /* Masked check, so an interrupt pending before WFI still wakes the core */
+            __disable_irq();
+            if (HAL_SPI_GetState(&device->spi_handle) != HAL_SPI_STATE_READY) {
+                __WFI();
+            }
+            __enable_irq();
+        }
+    }
+
+    if (HAL_SPI_GetError(&device->spi_handle) != HAL_SPI_ERROR_NONE) {
+        LT_LOG_ERROR("SPI DMA transfer failed, error=0x%" PRIx32, HAL_SPI_GetError(&device->spi_handle));
+        return LT_L1_SPI_ERROR;
+    }
+
+    return LT_OK;
+}
+
 lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_data_length, uint32_t timeout_ms)
 {
     lt_dev_stm32u5_tropic_click_t *device = (lt_dev_stm32u5_tropic_click_t *)(s2->device);
@@ -201,6 +259,10 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_dat
         return LT_L1_DATA_LEN_ERROR;
     }
 
+    if (device->dma_tx_handle != NULL && device->dma_rx_handle != NULL) {
+        return stm32u5_transfer_dma(device, s2->buff + offset, tx_data_length, timeout_ms);
+    }
+
     HAL_StatusTypeDef ret = HAL_SPI_TransmitReceive(
         &device->spi_handle,
         s2->buff + offset,
@@ -217,14 +279,99 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_dat
     return LT_OK;
 }
 
+#ifdef LT_PORT_SPI_SET_SPEED
+/** Baudrate prescalers from the fastest, the one at index i divides the SPI kernel clock by 2^(i + 1). */
+static const uint32_t stm32u5_prescalers[]
+    = {SPI_BAUDRATEPRESCALER_2,  SPI_BAUDRATEPRESCALER_4,  SPI_BAUDRATEPRESCALER_8,   SPI_BAUDRATEPRESCALER_16,
+       SPI_BAUDRATEPRESCALER_32, SPI_BAUDRATEPRESCALER_64, SPI_BAUDRATEPRESCALER_128, SPI_BAUDRATEPRESCALER_256};
+
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+    lt_dev_stm32u5_tropic_click_t *device = (lt_dev_stm32u5_tropic_click_t *)(s2->device);
+
+    // Kernel clock of each SPI is selected independently.
+    uint64_t periph_clk = RCC_PERIPHCLK_SPI3;
+    if (device->spi_instance == SPI1) {
+        periph_clk = RCC_PERIPHCLK_SPI1;
+    }
+    else if (device->spi_instance == SPI2) {
+        periph_clk = RCC_PERIPHCLK_SPI2;
+    }
+    uint32_t kernel_hz = HAL_RCCEx_GetPeriphCLKFreq(periph_clk);
+
+    // Smallest prescaler whose clock does not exceed the requested one, otherwise the largest prescaler.
+    size_t i = 0;
+    while ((i < sizeof(stm32u5_prescalers) / sizeof(stm32u5_prescalers[0]) - 1) && ((kernel_hz >> (i + 1)) > hz)) {
+        i++;
+    }
+
+    // The handle is initialized already, so HAL_SPI_Init() only reconfigures the peripheral.
+    device->spi_handle.Init.BaudRatePrescaler = stm32u5_prescalers[i];
+    int ret = HAL_SPI_Init(&device->spi_handle);
+    if (ret != HAL_OK) {
+        LT_LOG_ERROR("Failed to init SPI, ret=%d", ret);
+        return LT_L1_SPI_ERROR;
+    }
+
+    return LT_OK;
+}
+#endif
+
 /*=============================================================================
  * Delay Functions
  *============================================================================*/
 
-lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
+#ifdef LT_PORT_CACHE_MAINT
+// Parts with the data cache of the core (e.g. Cortex-M7 and M55) need the L2 buffer and L3 buffers aligned to its
+// 32 B lines (LT_BUFF_ALIGN), others do not maintain anything, as DMA sees what the core wrote.
+void lt_port_cache_clean(lt_l2_state_t *s2, const void *addr, size_t len)
 {
     LT_UNUSED(s2);
-    HAL_Delay(ms);
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr((uint32_t *)(uintptr_t)addr, (int32_t)len);
+#else
+    LT_UNUSED(addr);
+    LT_UNUSED(len);
+#endif
+}
+
+void lt_port_cache_invalidate(lt_l2_state_t *s2, void *addr, size_t len)
+{
+    LT_UNUSED(s2);
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr((uint32_t *)(uintptr_t)addr, (int32_t)len);
+#else
+    LT_UNUSED(addr);
+    LT_UNUSED(len);
+#endif
+}
+#endif
+
+#ifdef LT_PORT_TIME_US
+uint64_t lt_port_time_us(void)
+{
+    uint32_t ms, val;
+
+    // Re-reading the tick if SysTick wrapped in between, the counter counts down from LOAD to 0 once a millisecond.
+    do {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+
+    return (uint64_t)ms * 1000 + (uint64_t)(SysTick->LOAD - val) * 1000 / (SysTick->LOAD + 1);
+}
+#endif
+
+lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms)
+{
+    lt_dev_stm32u5_tropic_click_t *device = (lt_dev_stm32u5_tropic_click_t *)(s2->device);
+    uint32_t start_tick = HAL_GetTick();
+
+    /* Minimal wait like HAL_Delay(), but sleeping or yielding instead of spinning */
+    while ((HAL_GetTick() - start_tick) <= ms) {
+        stm32u5_idle(device);
+    }
+
     return LT_OK;
 }
 
@@ -234,10 +381,22 @@ lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
     lt_dev_stm32u5_tropic_click_t *device = (lt_dev_stm32u5_tropic_click_t *)(s2->device);
     uint32_t start_tick = HAL_GetTick();
 
+    /* Task blocks in the RTOS; a stale signal is dropped first, so the level read after it cannot miss an edge */
+    if (device->int_wait != NULL) {
+        (void)device->int_wait(device->int_ctx, 0);
+        if (HAL_GPIO_ReadPin(device->int_gpio_port, device->int_gpio_pin) == GPIO_PIN_SET
+            || device->int_wait(device->int_ctx, ms)) {
+            return LT_OK;
+        }
+        return (HAL_GPIO_ReadPin(device->int_gpio_port, device->int_gpio_pin) == GPIO_PIN_SET) ? LT_OK
+                                                                                                : LT_L1_INT_TIMEOUT;
+    }
+
     while (HAL_GPIO_ReadPin(device->int_gpio_port, device->int_gpio_pin) == GPIO_PIN_RESET) {
         if ((HAL_GetTick() - start_tick) > ms) {
             return LT_L1_INT_TIMEOUT;
         }
+        stm32u5_idle(device);
     }
 
     return LT_OK;
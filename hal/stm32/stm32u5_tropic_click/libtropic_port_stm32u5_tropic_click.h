@@ -62,6 +62,18 @@ typedef struct lt_dev_stm32u5_tropic_click_t {
     uint16_t int_gpio_pin;
     /** @brief @public Interrupt GPIO port */
     GPIO_TypeDef *int_gpio_port;
+
+    /**
+     * @brief @public Blocks the calling task until signalled from the INT pin interrupt or ms pass (NULL = polling)
+     *
+     * If set, the INT pin is configured for a rising edge EXTI interrupt, whose callback
+     * (HAL_GPIO_EXTI_Rising_Callback()) has to signal the waiting task, e.g. by a FreeRTOS task
+     * notification or CMSIS-RTOS thread flag; the application enables the EXTI IRQ. Returns true
+     * if signalled, called with ms 0 to drop a stale signal.
+     */
+    bool (*int_wait)(void *ctx, uint32_t ms);
+    /** @brief @public Context passed to int_wait() */
+    void *int_ctx;
 #endif
 
     /** @brief @public Optional reset GPIO pin (0 if not used) */
@@ -74,6 +86,25 @@ typedef struct lt_dev_stm32u5_tropic_click_t {
     /** @brief @public RNG handle (STM32U5 has hardware TRNG) */
     RNG_HandleTypeDef *rng_handle;
 
+    /*=== DMA and Low-Power Waiting ===*/
+
+    /**
+     * @brief @public GPDMA handles for SPI TX and RX (NULL for blocking transfers)
+     *
+     * Both channels must be initialized by the application. Their IRQ handlers must call
+     * HAL_DMA_IRQHandler() and the SPI IRQ handler must call HAL_SPI_IRQHandler() with
+     * the spi_handle below, as the transfer completes on the SPI end-of-transfer interrupt.
+     */
+    DMA_HandleTypeDef *dma_tx_handle;
+    DMA_HandleTypeDef *dma_rx_handle;
+
+    /**
+     * @brief @public Called while waiting for DMA transfers and delays (NULL = __WFI())
+     *
+     * E.g. a function calling vTaskDelay(1) lets other RTOS tasks run.
+     */
+    void (*idle_hook)(void);
+
     /*=== Private Members (managed by HAL) ===*/
 
     /** @brief @private SPI handle - initialized by lt_port_init() */
@@ -96,9 +127,14 @@ typedef struct lt_dev_stm32u5_tropic_click_t {
     .spi_cs_gpio_port = GPIOD, \
     .int_gpio_pin = GPIO_PIN_13, \
     .int_gpio_port = GPIOF, \
+    .int_wait = NULL, \
+    .int_ctx = NULL, \
     .rst_gpio_pin = 0, \
     .rst_gpio_port = NULL, \
-    .rng_handle = NULL \
+    .rng_handle = NULL, \
+    .dma_tx_handle = NULL, \
+    .dma_rx_handle = NULL, \
+    .idle_hook = NULL \
 }
 
 /**
@@ -38,6 +38,58 @@ extern "C" {
  */
 lt_ret_t lt_init(lt_handle_t *h);
 
+#ifdef LT_WARM_INIT
+/**
+ * @brief Initialize handle and transport layer with TROPIC01 attributes exported by `lt_tr01_attrs_export()` in a
+ * previous run, TROPIC01 is neither probed for its mode nor rebooted. If the cache is not valid, handle is
+ * initialized as by `lt_init()`.
+ * @details The attributes are verified (TROPIC01 is probed and rebooted into Application FW as by `lt_init()`) after
+ *          the first failure of `lt_session_start()`, `lt_r_mem_data_write()` or `lt_r_mem_data_read()`. The failed
+ *          call still returns its error and can be retried.
+ * @note If the function fails, `lt_deinit` must not be called. In this case, the function handles the cleanup itself.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cache       TROPIC01 attributes of this chip
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_init_warm(lt_handle_t *h, const lt_tr01_attrs_cache_t *cache);
+
+/**
+ * @brief Fills the cache with TROPIC01 attributes for `lt_init_warm()` of the next run, together with CHIP_ID of the
+ * chip to key them by. Attributes taken from a cache are verified first.
+ *
+ * @param h           Handle for communication with TROPIC01, initialized by `lt_init()` or `lt_init_warm()`
+ * @param cache       Cache to fill
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_tr01_attrs_export(lt_handle_t *h, lt_tr01_attrs_cache_t *cache);
+
+/**
+ * @brief Tells whether the cache was filled by `lt_tr01_attrs_export()` with this version of libtropic and is intact.
+ *
+ * @param cache       TROPIC01 attributes cache
+ * @return            true if the cache can be used by `lt_init_warm()`
+ */
+bool lt_tr01_attrs_cache_valid(const lt_tr01_attrs_cache_t *cache);
+
+/**
+ * @brief Gets CHIP_ID the cache was filled from, so the application can pick the cache of its TROPIC01.
+ *
+ * @param cache       TROPIC01 attributes cache
+ * @param chip_id     CHIP_ID is returned here
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Cache is not valid
+ */
+lt_ret_t lt_tr01_attrs_cache_chip_id(const lt_tr01_attrs_cache_t *cache, struct lt_chip_id_t *chip_id);
+#endif
+
 /**
  * @brief Deinitialize handle and transport layer
  *
@@ -67,6 +119,7 @@ lt_ret_t lt_deinit(lt_handle_t *h);
  */
 lt_ret_t lt_get_tr01_mode(lt_handle_t *h, lt_tr01_mode_t *mode);
 
+#ifdef LT_CMD_CERT_STORE
 /**
  * @brief Read out PKI chain from TROPIC01's Certificate Store
  *
@@ -79,6 +132,23 @@ lt_ret_t lt_get_tr01_mode(lt_handle_t *h, lt_tr01_mode_t *mode);
  */
 lt_ret_t lt_get_info_cert_store(lt_handle_t *h, struct lt_cert_store_t *store);
 
+/**
+ * @brief Reads out beginning of TROPIC01's Certificate Store up to and including the certificate `last` and stops,
+ * e.g. `LT_CERT_KIND_DEVICE` is enough for `lt_get_st_pub()`.
+ *
+ * @note              Only buffers of the certificates up to `last` are used (others may be NULL with zero length),
+ *                    `cert_len` of the certificates which were not read is set to 0.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param store       Certificate store handle to be filled
+ * @param last        Last certificate to be read
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_get_info_cert_store_partial(lt_handle_t *h, struct lt_cert_store_t *store, const lt_cert_kind_t last);
+
 /**
  * @brief Extracts ST_Pub from TROPIC01's Certificate Store
  *
@@ -91,6 +161,20 @@ lt_ret_t lt_get_info_cert_store(lt_handle_t *h, struct lt_cert_store_t *store);
  * of returned value
  */
 lt_ret_t lt_get_st_pub(const struct lt_cert_store_t *store, uint8_t *stpub);
+#endif
+
+/**
+ * @brief Reads only the device certificate from TROPIC01's Certificate Store and extracts STPUB from it.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param stpub       When the function executes successfully, TROPIC01's STPUB of length `TR01_STPUB_LEN` will be
+ * written into this buffer
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_get_info_st_pub(lt_handle_t *h, uint8_t *stpub);
 
 //--------------------------------------------------------------------------------------------------------------------//
 /** @brief Maximal size of returned CHIP ID */
@@ -171,457 +255,3603 @@ lt_ret_t lt_get_info_fw_bank(lt_handle_t *h, const lt_bank_id_t bank_id, uint8_t
 lt_ret_t lt_session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pkey_index_t pkey_index,
                           const uint8_t *shipriv, const uint8_t *shipub);
 
+#ifdef LT_L3_BUFF_ARENA
 /**
- * @brief Aborts encrypted secure session between TROPIC01 and host MCU
+ * @brief Initializes arena of L3 buffers in the given memory.
  *
- * @note              Data used for the Secure Session are always invalidated regardless
- *                    of the result of the abort request (if you pass correct handle).
- *                    After calling this function, it will not be possible to send L3 commands
- *                    unless new Secure Session is started.
+ * @param arena       Arena of L3 buffers
+ * @param mem         Memory of the buffers aligned to LT_DMA_BUFF_ALIGN (16 B unless LT_BUFF_ALIGN is larger), has to
+ *                    stay valid while the arena is attached to a handle
+ * @param mem_len     Size of the memory, `LT_L3_BUFF_ARENA_MEM_SIZE(n)` for n buffers (at most LT_L3_BUFF_ARENA_MAX)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_l3_buff_arena_init(lt_l3_buff_arena_t *arena, uint8_t *mem, const size_t mem_len);
+
+/**
+ * @brief Attaches arena of L3 buffers to the handle, it replaces the L3 buffer set by the user.
+ *
+ * @note              Each L3 Command borrows a buffer from the arena and returns it after its result is decoded. If a
+ *                    command fails before its result is received (e.g. on an L2 error), the handle keeps the buffer for
+ *                    its next command; it is returned when the Secure Session is dropped or by lt_deinit(). When all
+ *                    buffers are borrowed, the command waits up to `timeout_ms` of the arena and then returns
+ *                    LT_L3_BUFF_ARENA_EMPTY. Handles using one arena may be driven from different tasks/threads.
+ *                    Do not call while an L3 Command of the handle is in progress.
  *
  * @param h           Handle for communication with TROPIC01
+ * @param arena       Arena of L3 buffers, NULL detaches the arena (the user has to set the L3 buffer again)
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_session_abort(lt_handle_t *h);
+lt_ret_t lt_l3_buff_arena_attach(lt_handle_t *h, lt_l3_buff_arena_t *arena);
 
 /**
- * @brief Puts TROPIC01 into sleep
+ * @brief Returns number of buffers currently borrowed from the arena.
  *
- * @param h           Handle for communication with TROPIC01
- * @param sleep_kind  Kind of sleep
+ * @param arena       Arena of L3 buffers
+ * @return            Number of borrowed buffers, 0 if the arena is NULL
+ */
+uint8_t lt_l3_buff_arena_in_use(const lt_l3_buff_arena_t *arena);
+#endif
+
+#ifdef LT_ENTROPY_POOL
+/**
+ * @brief Initializes pool of TROPIC01 random bytes. Contents of the pool are wiped.
+ *
+ * @note              Bytes are taken out by `lt_entropy_pool_get()` without any communication with TROPIC01, the pool
+ *                    is filled ahead of demand by `lt_entropy_pool_refill()`.
+ *
+ * @param pool            Entropy pool
+ * @param low_watermark   `lt_entropy_pool_needs_refill()` reports a refill is due below this number of bytes
+ * @param high_watermark  `lt_entropy_pool_refill()` fills the pool up to this number of bytes (max.
+ *                        `LT_ENTROPY_POOL_SIZE`)
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_sleep(lt_handle_t *h, const uint8_t sleep_kind);
+lt_ret_t lt_entropy_pool_init(lt_entropy_pool_t *pool, const uint16_t low_watermark, const uint16_t high_watermark);
 
 /**
- * @brief Reboots TROPIC01
+ * @brief Fills the pool with random bytes up to its high watermark.
+ *
+ * @note              Bytes come from `lt_random_value_get()` in requests of up to `TR01_RANDOM_VALUE_GET_LEN_MAX`
+ *                    bytes. With `LT_ENTROPY_POOL_DRBG`, one request of `LT_ENTROPY_POOL_DRBG_SEED_LEN` bytes reseeds
+ *                    an HMAC-DRBG (NIST SP 800-90A), which generates the bytes. Secure Session must be started.
+ *                    Intended to be called from idle time or from a low priority task/thread, only one task may
+ *                    refill the pool at a time and it must not use the handle concurrently with other tasks.
  *
  * @param h           Handle for communication with TROPIC01
- * @param startup_id  Startup ID (determines into which mode will TROPIC01 reboot)
+ * @param pool        Entropy pool
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_reboot(lt_handle_t *h, const lt_startup_id_t startup_id);
+lt_ret_t lt_entropy_pool_refill(lt_handle_t *h, lt_entropy_pool_t *pool);
 
-#ifdef ABAB
-/** @brief Maximal size of update data */
-#define TR01_MUTABLE_FW_UPDATE_SIZE_MAX 25600
 /**
- * @brief Erase mutable firmware in one of banks
+ * @brief Takes random bytes out of the pool, never blocks and never communicates with TROPIC01.
+ *
+ * @param pool        Entropy pool
+ * @param out         Buffer for the random bytes
+ * @param len         Number of random bytes
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_ENTROPY_POOL_EMPTY Pool holds fewer than len bytes, nothing was taken
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_entropy_pool_get(lt_entropy_pool_t *pool, uint8_t *out, const uint16_t len);
+
+/**
+ * @brief Returns number of random bytes available in the pool.
+ *
+ * @param pool        Entropy pool
+ * @return            Number of bytes, 0 if the pool is NULL
+ */
+uint16_t lt_entropy_pool_available(const lt_entropy_pool_t *pool);
+
+/**
+ * @brief Tells whether the pool dropped below its low watermark, e.g. to wake up the refilling task.
  *
+ * @param pool        Entropy pool
+ * @return            true if `lt_entropy_pool_refill()` should be called
+ */
+bool lt_entropy_pool_needs_refill(const lt_entropy_pool_t *pool);
+#endif
+
+#ifdef LT_SIGN_QUEUE
+/**
+ * @brief Initializes queue of ECDSA signing jobs.
+ *
+ * @note              Jobs are executed by the devices added by `lt_sign_queue_add_device()` through asynchronous L2
+ *                    operations (`LT_L2_ASYNC`). While TROPIC01 executes one ECDSA_Sign, the L3 Command of the next
+ *                    job of the same device is already encrypted, so it is sent as soon as the result arrives.
+ *
+ * @param q           Signing queue
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_sign_queue_init(lt_sign_queue_t *q);
+
+/**
+ * @brief Adds TROPIC01 device to the signing queue.
+ *
+ * @note              Secure Session has to be started on the handle. While the queue has jobs on the device, the
+ *                    handle and the operation must not be used by anything else. The operation may also be
+ *                    registered in a reactor (e.g. `lt_linux_reactor_add()`) instead of calling
+ *                    `lt_sign_queue_process()`. A device whose Secure Session fails stops taking jobs.
+ *
+ * @param q           Signing queue
  * @param h           Handle for communication with TROPIC01
- * @param bank_id     enum lt_bank_id_t
+ * @param op          Asynchronous L2 operation of the device, must not be busy
  *
  * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Queue already has `LT_SIGN_QUEUE_MAX_DEVICES` devices
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_mutable_fw_erase(lt_handle_t *h, const lt_bank_id_t bank_id);
+lt_ret_t lt_sign_queue_add_device(lt_sign_queue_t *q, lt_handle_t *h, struct lt_l2_async_t *op);
 
 /**
- * @brief Update mutable firmware in one of banks
+ * @brief Queues job signing the digest with the ECDSA key in the slot, as `lt_ecc_ecdsa_sign()` does for the
+ * message. The job is handed to the least loaded device right away if there is one.
  *
- * @param h             Handle for communication with TROPIC01
- * @param fw_data       Array with firmware bytes
- * @param fw_data_size  Number of firmware's bytes in passed array
- * @param bank_id       enum lt_bank_id_t
- * lt_ret_t             LT_OK            - SUCCESS
- *                      other parameters - ERROR, for verbose output pass return value to function lt_ret_verbose()
+ * @param q           Signing queue
+ * @param slot        Slot containing a P-256 private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param digest      SHA-256 digest of the message, `LT_SIGN_QUEUE_DIGEST_LEN` bytes
+ * @param cb          Called with the signature when the job finishes, may submit further jobs
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Queue is full (`LT_SIGN_QUEUE_LEN` pending jobs)
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
  */
-lt_ret_t lt_mutable_fw_update(lt_handle_t *h, const uint8_t *fw_data, const uint16_t fw_data_size,
-                              lt_bank_id_t bank_id);
+lt_ret_t lt_sign_queue_submit(lt_sign_queue_t *q, const lt_ecc_slot_t slot, const uint8_t *digest,
+                              lt_sign_queue_cb_t cb, void *cb_ctx);
 
-#elif ACAB
-/** @brief Maximal size of update data */
-#define TR01_MUTABLE_FW_UPDATE_SIZE_MAX 30720
+/**
+ * @brief Advances jobs of all devices, never waits for TROPIC01.
+ * @details Each device makes at most one attempt to read its L2 Response frame, callbacks of finished jobs are
+ * called from here. Call it on INT pin events or periodically.
+ *
+ * @param q           Signing queue
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_sign_queue_process(lt_sign_queue_t *q);
 
 /**
- * @brief Sends mutable firmware update L2 request to TROPIC01 with silicon revision ACAB
+ * @brief Executes all pending jobs, i.e. calls `lt_sign_queue_process()` with 1 ms delays until the queue is empty.
  *
- * @param h               Handle for communication with TROPIC01
- * @param update_request  Array with firmware update request bytes
- * @return                LT_OK if success, otherwise returns other error code.
+ * @param q           Signing queue
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
  */
-lt_ret_t lt_mutable_fw_update(lt_handle_t *h, const uint8_t *update_request);
+lt_ret_t lt_sign_queue_run(lt_sign_queue_t *q);
 
 /**
- * @brief Sends mutable firmware update data to TROPIC01 with silicon revision ACAB. Function
- * `lt_mutable_fw_update()` must be called first to start authenticated mutable fw update.
+ * @brief Returns number of pending jobs (waiting or executed by a device).
  *
- * @param h                 Handle for communication with TROPIC01
- * @param update_data       Array with firmware update data bytes
- * @param update_data_size  Size of update data
- * @return                  LT_OK if success, otherwise returns other error code.
+ * @param q           Signing queue
+ * @return            Number of jobs, 0 if the queue is NULL
  */
-lt_ret_t lt_mutable_fw_update_data(lt_handle_t *h, const uint8_t *update_data, const uint16_t update_data_size);
+uint16_t lt_sign_queue_pending(const lt_sign_queue_t *q);
+
+#ifdef LT_CRYPTO_WORKER
+/**
+ * @brief Hands encryption of L3 Commands and decryption of L3 Results of the signing queue to a crypto worker.
+ *
+ * @note              AES-GCM of the jobs then runs on the threads of the worker instead of the I/O thread driving
+ *                    the devices, which meanwhile transfers frames of the other devices and of the next job. Each
+ *                    device has at most one work at a time. Finished works are picked up by
+ *                    `lt_sign_queue_process()`, which has to be called also when the operations are driven by a
+ *                    reactor. A work the worker does not take is executed by the calling thread.
+ *
+ * @param q           Signing queue, must have no pending jobs
+ * @param worker      Hands works to the worker (e.g. `lt_linux_crypto_worker_submit()`), NULL to do them in the
+ *                    I/O thread again
+ * @param worker_ctx  User data passed to the worker
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_sign_queue_set_crypto_worker(lt_sign_queue_t *q, lt_crypto_worker_submit_t worker, void *worker_ctx);
 
+/**
+ * @brief Executes the work handed to a crypto worker, safe to call from any thread.
+ *
+ * @note              The work must not be touched afterwards, the signing queue may reuse it right away.
+ *
+ * @param work        Work
+ */
+void lt_crypto_work_run(lt_crypto_work_t *work);
+#endif
 #endif
+
+#ifdef LT_POOL
 /**
- * @brief Gets Log message of TROPIC01's RISC-V FW (if enabled/available).
- * @note RISC-V FW logging can be disabled in the I/R-Config and for the production chips, it **will** be disabled. This
- * function is used mainly for internal debugging and not expected to be used by the user.
+ * @brief Initializes pool of TROPIC01 devices.
  *
- * @param h                    Handle for communication with TROPIC01
- * @param log_msg              Buffer for the log message (atleast 255B)
- * @param log_msg_max_size     Size of the log message buffer
- * @param log_msg_read_size    Number of bytes read into the log message buffer
+ * @note              Operations of the pool (`lt_pool_ecdsa_sign()`, `lt_pool_eddsa_sign()`,
+ *                    `lt_pool_random_value_get()`, `lt_pool_ping()`) are executed by the healthy device with the
+ *                    fewest callers assigned. They may be called from several threads at once, each device executes
+ *                    one of them at a time. A device which fails the operation by an L1/L2 error, by a loss of the
+ *                    Secure Session or by HARDWARE_FAIL is quarantined and the operation is retried by the next
+ *                    device. `lt_pool_maintain()` brings quarantined devices back. With `LT_POOL_HEDGE`, an operation
+ *                    running longer than the hedge delay (see `lt_pool_hedge_delay_ms()`) is duplicated on another
+ *                    idle device and the result of the device finishing first is returned. All operations of the
+ *                    pool leave TROPIC01 state untouched, so running them twice is harmless. Keys are brought to
+ *                    the devices by `lt_pool_replicate_key()`.
+ *
+ * @param pool        Device pool
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_get_log_req(lt_handle_t *h, uint8_t *log_msg, const uint16_t log_msg_max_size, uint16_t *log_msg_read_size);
+lt_ret_t lt_pool_init(lt_pool_t *pool);
+
+/**
+ * @brief Adds TROPIC01 device to the pool, starts Secure Session on it if there is none.
+ *
+ * @note              Keys are not copied, they have to stay valid while the device is in the pool. While in the pool,
+ *                    the handle must not be used by anything else. Devices have to be added before the operations
+ *                    are called from other threads. If the handshake fails, the device is added quarantined.
+ *
+ * @param pool        Device pool
+ * @param h           Handle for communication with TROPIC01, initialized by `lt_init()`
+ * @param stpub       STPUB from device's certificate
+ * @param pkey_index  Index of pairing public key
+ * @param shipriv     Secure host private key
+ * @param shipub      Secure host public key
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Pool already has `LT_POOL_MAX_DEVICES` devices
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_add_device(lt_pool_t *pool, lt_handle_t *h, const uint8_t *stpub, const lt_pkey_index_t pkey_index,
+                            const uint8_t *shipriv, const uint8_t *shipub);
+
+/**
+ * @brief Signs message with the ECDSA key in the slot, as `lt_ecc_ecdsa_sign()` does, on a device of the pool.
+ *
+ * @note              All devices are expected to hold the same key in the slot.
+ *
+ * @param pool        Device pool
+ * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param msg         Buffer containing a message
+ * @param msg_len     Length of the message
+ * @param rs          Buffer for the signature, 64 bytes
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_HOST_NO_SESSION No healthy device in the pool
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_ecdsa_sign(lt_pool_t *pool, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint32_t msg_len,
+                            uint8_t *rs);
+
+/**
+ * @brief Signs message with the EdDSA key in the slot, as `lt_ecc_eddsa_sign()` does, on a device of the pool.
+ *
+ * @param pool        Device pool
+ * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param msg         Buffer containing a message
+ * @param msg_len     Length of the message
+ * @param rs          Buffer for the signature, 64 bytes
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_HOST_NO_SESSION No healthy device in the pool
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_eddsa_sign(lt_pool_t *pool, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint16_t msg_len,
+                            uint8_t *rs);
+
+/**
+ * @brief Gets random bytes, as `lt_random_value_get()` does, from a device of the pool.
+ *
+ * @param pool           Device pool
+ * @param rnd_bytes      Buffer for the random bytes
+ * @param rnd_bytes_cnt  Number of random bytes to get
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_HOST_NO_SESSION No healthy device in the pool
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_random_value_get(lt_pool_t *pool, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt);
+
+/**
+ * @brief Sends Ping L3 command, as `lt_ping()` does, to a device of the pool.
+ *
+ * @param pool        Device pool
+ * @param msg_out     Ping message going out
+ * @param msg_in      Ping message going in
+ * @param msg_len     Length of both messages (msg_out and msg_in)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_HOST_NO_SESSION No healthy device in the pool
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_ping(lt_pool_t *pool, const uint8_t *msg_out, uint8_t *msg_in, const uint16_t msg_len);
+
+/**
+ * @brief Stores the same ECC key to the slot of every healthy device of the pool, over their open Secure Sessions,
+ * and verifies it by the public keys read back by `lt_ecc_key_read()`.
+ * @details All devices are locked first, then `lt_ecc_key_store()` runs on each of them. With `LT_POOL_HEDGE`,
+ * devices with asynchronous L2 operation attached by `lt_pool_set_hedge_op()` execute their L3 Commands at once, so
+ * the replication takes about the latency of one device; other devices execute them one after another. A device
+ * whose slot already holds a key is only verified, so devices added to the pool can be brought to the key of the
+ * others. Public keys are compared against the device which stored the key by this call, a device holding a
+ * different key, a generated key or a key of the other curve fails by LT_FAIL. A device which fails by an L1/L2
+ * error, by a loss of the Secure Session or by HARDWARE_FAIL is quarantined. Standby devices are included,
+ * quarantined ones are skipped and reported by LT_HOST_NO_SESSION.
+ *
+ * @note              The key is zeroized when the function returns, whatever the result, so no host copy outlives
+ *                    the replication. A key which has to be replicated to a device again later has to be kept by the
+ *                    caller elsewhere.
+ *
+ * @param pool        Device pool
+ * @param slot        Slot number TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param curve       Type of ECC curve, TR01_CURVE_P256 or TR01_CURVE_ED25519
+ * @param key         Private key, 32 bytes, zeroized on return
+ * @param replace     true to erase the slot first (key rotation), false to keep a key already held by a device
+ * @param pubkey      Buffer for the verified public key (64 bytes for P256, 32 bytes for Ed25519), NULL if not needed
+ * @param results     Results of the devices, in order of `lt_pool_add_device()` calls, NULL if not needed
+ *
+ * @retval            LT_OK The key is in the slot of every device of the pool
+ * @retval            LT_FAIL Public key read back from a device does not match
+ * @retval            LT_HOST_NO_SESSION A device is quarantined or the pool is empty
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_replicate_key(lt_pool_t *pool, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve,
+                               uint8_t *key, const bool replace, uint8_t *pubkey, lt_ret_t *results);
+
+/**
+ * @brief Re-handshakes quarantined devices, call it periodically.
+ * @details A device whose handshake fails waits exponentially more calls (up to 2^`LT_POOL_BACKOFF_MAX_SHIFT`)
+ * before the next attempt. Devices used by a caller at the moment are skipped.
+ *
+ * @param pool        Device pool
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_maintain(lt_pool_t *pool);
+
+/**
+ * @brief Returns number of callers assigned to the device (executing an operation or waiting for it).
+ *
+ * @param pool        Device pool
+ * @param idx         Index of the device, in order of `lt_pool_add_device()` calls
+ * @return            Queue depth, 0 if the device does not exist
+ */
+uint8_t lt_pool_depth(const lt_pool_t *pool, const uint8_t idx);
+
+/**
+ * @brief Tells whether the device takes operations, i.e. is not quarantined.
+ *
+ * @param pool        Device pool
+ * @param idx         Index of the device, in order of `lt_pool_add_device()` calls
+ * @return            true if the device is healthy, false if it is quarantined or does not exist
+ */
+bool lt_pool_is_healthy(const lt_pool_t *pool, const uint8_t idx);
+
+/**
+ * @brief Makes the device a warm standby: its Secure Session is kept, but it takes operations only when every other
+ * healthy device failed them, or as a hedged duplicate. Failover then does not wait for a handshake.
+ *
+ * @note              Set it before the operations are called from other threads.
+ *
+ * @param pool        Device pool
+ * @param idx         Index of the device, in order of `lt_pool_add_device()` calls
+ * @param standby     true to keep the device in standby, false to dispatch operations to it again
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_set_standby(lt_pool_t *pool, const uint8_t idx, const bool standby);
+
+/**
+ * @brief Sets the executor running the operations of the device, e.g. `lt_linux_io_thread_pool_exec()` of the Linux
+ * HALs, which runs them by the dedicated I/O thread of the SPI bus of the device.
+ * @details The caller assigned to the device still waits for its operation to finish, the executor only decides
+ * which thread uses the handle. With `LT_POOL_HEDGE`, devices with asynchronous L2 operation attached by
+ * `lt_pool_set_hedge_op()` are driven by the caller and do not use the executor.
+ *
+ * @note              Set it before the operations are called from other threads.
+ *
+ * @param pool        Device pool
+ * @param idx         Index of the device, in order of `lt_pool_add_device()` calls
+ * @param exec        Executor, NULL to run the operations by the calling thread
+ * @param exec_ctx    User data passed to the executor
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_set_executor(lt_pool_t *pool, const uint8_t idx, lt_pool_executor_t exec, void *exec_ctx);
+
+#ifdef LT_POOL_HEDGE
+/**
+ * @brief Attaches asynchronous L2 operation to the device, so operations executed by it can be hedged, it can
+ * execute hedged duplicates and `lt_pool_replicate_key()` drives it concurrently with the other devices.
+ * @details A device without it executes operations by the blocking functions and is never hedged. When the duplicate
+ * finishes first, the device of the original operation is quarantined without counting a failure, as TROPIC01 may
+ * still execute the abandoned L3 Command, and `lt_pool_maintain()` starts its Secure Session at the next call.
+ *
+ * @note              Set it before the operations are called from other threads.
+ *
+ * @param pool        Device pool
+ * @param idx         Index of the device, in order of `lt_pool_add_device()` calls
+ * @param op          Asynchronous L2 operation of the device, has to stay valid while the device is in the pool,
+ *                    NULL to detach it
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pool_set_hedge_op(lt_pool_t *pool, const uint8_t idx, struct lt_l2_async_t *op);
+
+/**
+ * @brief Returns delay after which an operation of the pool is duplicated on another device.
+ * @details Latencies of the finished operations are kept in a histogram with power of two buckets (in ms), the delay
+ * is the upper bound of the bucket holding their 99th percentile.
+ *
+ * @param pool        Device pool
+ * @return            Delay in ms, 0 until `LT_POOL_HEDGE_MIN_SAMPLES` operations finished, i.e. no hedging
+ */
+uint32_t lt_pool_hedge_delay_ms(const lt_pool_t *pool);
+#endif
+#endif
+
+#ifdef LT_BRINGUP
+/**
+ * @brief Initializes concurrent bring-up of TROPIC01 devices.
+ *
+ * @note              Each device added by `lt_bringup_add_device()` is initialized by `lt_init()`, reads STPUB from
+ *                    its device certificate and starts Secure Session, as `lt_init()`, `lt_get_info_st_pub()` and
+ *                    `lt_session_start()` do. Get_Info and Handshake_Req of the devices are executed through
+ *                    asynchronous L2 operations (`LT_L2_ASYNC`), so while one TROPIC01 prepares its response, the
+ *                    host talks to the others or computes the keys of a finished handshake. All of it runs in the
+ *                    thread calling `lt_bringup_process()`, devices may share one SPI bus.
+ *
+ * @param b           Bring-up
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_bringup_init(lt_bringup_t *b);
+
+/**
+ * @brief Adds TROPIC01 device to the bring-up.
+ *
+ * @note              Keys are not copied, they have to stay valid until the device is brought up. Until then, the
+ *                    handle and the operation must not be used by anything else. A device whose bring-up fails is
+ *                    left deinitialized.
+ *
+ * @param b           Bring-up
+ * @param h           Handle for communication with TROPIC01, not initialized yet
+ * @param op          Asynchronous L2 operation of the device, must not be busy
+ * @param pkey_index  Index of Pairing key slot, TR01_PAIRING_KEY_SLOT_INDEX_0 - TR01_PAIRING_KEY_SLOT_INDEX_3
+ * @param shipriv     Host private pairing key
+ * @param shipub      Host public pairing key
+ * @param cb          Called when bring-up of the device finishes, may be NULL
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Bring-up already has `LT_BRINGUP_MAX_DEVICES` devices
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_bringup_add_device(lt_bringup_t *b, lt_handle_t *h, struct lt_l2_async_t *op,
+                               const lt_pkey_index_t pkey_index, const uint8_t *shipriv, const uint8_t *shipub,
+                               lt_bringup_cb_t cb, void *cb_ctx);
+
+/**
+ * @brief Advances bring-up of all devices, waits for TROPIC01 only in `lt_init()`.
+ * @details Devices waiting for initialization are initialized, the others make at most one attempt to read their
+ * L2 Response frame. Callbacks of brought up devices are called from here. With `LT_REBOOT_ASYNC`, devices are
+ * initialized by `lt_init_async_start()` instead, so the reboots of the devices which are not executing the
+ * Application FW run in parallel.
+ *
+ * @param b           Bring-up
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_bringup_process(lt_bringup_t *b);
+
+/**
+ * @brief Brings up all devices, i.e. calls `lt_bringup_process()` until no device is pending, with 1 ms delays when
+ * no device made progress.
+ *
+ * @param b           Bring-up
+ *
+ * @retval            LT_OK Function executed successfully, results of the devices are given by `lt_bringup_result()`
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_bringup_run(lt_bringup_t *b);
+
+/**
+ * @brief Returns number of devices whose bring-up has not finished yet.
+ *
+ * @param b           Bring-up
+ * @return            Number of devices, 0 if the bring-up is NULL
+ */
+uint8_t lt_bringup_pending(const lt_bringup_t *b);
+
+/**
+ * @brief Returns state of the device.
+ *
+ * @param b           Bring-up
+ * @param idx         Index of the device, in order of `lt_bringup_add_device()` calls
+ * @return            State of the device, LT_BRINGUP_STATE_FAILED if the device does not exist
+ */
+lt_bringup_state_t lt_bringup_state(const lt_bringup_t *b, const uint8_t idx);
+
+/**
+ * @brief Returns result of the bring-up of the device.
+ *
+ * @param b           Bring-up
+ * @param idx         Index of the device, in order of `lt_bringup_add_device()` calls
+ *
+ * @retval            LT_OK Secure Session was started
+ * @retval            LT_L1_CHIP_BUSY Bring-up of the device has not finished yet
+ * @retval            LT_PARAM_ERR The device does not exist
+ * @retval            other Bring-up of the device failed with this error
+ */
+lt_ret_t lt_bringup_result(const lt_bringup_t *b, const uint8_t idx);
+#endif
+
+#ifdef LT_FW_FLEET
+/**
+ * @brief Initializes mutable firmware update of several TROPIC01 devices with one image.
+ *
+ * @note              The image is the same as for `lt_do_mutable_fw_update()` (e.g. `*_signed_chunks.bin` for ACAB),
+ *                    it is not copied and has to stay valid until all devices finish. L2 Requests of the update are
+ *                    sent through asynchronous L2 operations (`LT_L2_ASYNC`), interleaved across the devices, so
+ *                    while one TROPIC01 writes a chunk to its flash, the next chunk is sent to another one. All of it
+ *                    runs in the thread calling `lt_fw_fleet_process()`, devices may share one SPI bus.
+ *
+ * @param f                 Firmware update fleet
+ * @param update_data       Update image
+ * @param update_data_size  Size of the update image
+ * @param bank_id           Bank ID where the update should be applied, valid values are
+ *                             For ABAB: TR01_FW_BANK_FW1, TR01_FW_BANK_FW2, TR01_FW_BANK_SPECT1, TR01_FW_BANK_SPECT2
+ *                             For ACAB: Parameter is ignored, chip is handling firmware banks on its own
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters or malformed image
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_fw_fleet_init(lt_fw_fleet_t *f, const uint8_t *update_data, const uint16_t update_data_size,
+                          const lt_bank_id_t bank_id);
+
+/**
+ * @brief Adds TROPIC01 device to the firmware update fleet.
+ *
+ * @note              TROPIC01 has to be in Start-up mode (see `lt_reboot()` with `TR01_MAINTENANCE_REBOOT`). Until
+ *                    the device finishes, the handle and the operation must not be used by anything else.
+ *                    An update which failed may be resumed by adding the device again with the offset reported for
+ *                    it, as long as TROPIC01 was not rebooted since (ACAB keeps the hash chain of the update only
+ *                    until the reboot).
+ *
+ * @param f           Firmware update fleet
+ * @param h           Handle for communication with TROPIC01
+ * @param op          Asynchronous L2 operation of the device, must not be busy
+ * @param offset      Offset in the image to start from, 0 for a new update, otherwise an offset reported by
+ *                    `lt_fw_fleet_progress()` or by the callback
+ * @param cb          Called when the update of the device finishes, may be NULL
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters or the offset is not a boundary of the L2 Requests of the image
+ * @retval            LT_FAIL Fleet already has `LT_FW_FLEET_MAX_DEVICES` devices
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_fw_fleet_add_device(lt_fw_fleet_t *f, lt_handle_t *h, struct lt_l2_async_t *op, const uint16_t offset,
+                                lt_fw_fleet_cb_t cb, void *cb_ctx);
+
+/**
+ * @brief Advances update of all devices, never waits for TROPIC01.
+ * @details Each device makes at most one attempt to read its L2 Response frame, the next part of the image is sent
+ * right after it. Callbacks of finished devices are called from here.
+ *
+ * @param f           Firmware update fleet
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_fw_fleet_process(lt_fw_fleet_t *f);
+
+/**
+ * @brief Updates all devices, i.e. calls `lt_fw_fleet_process()` until no device is pending, with 1 ms delays when
+ * no device made progress.
+ *
+ * @param f           Firmware update fleet
+ *
+ * @retval            LT_OK Function executed successfully, results of the devices are given by `lt_fw_fleet_progress()`
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_fw_fleet_run(lt_fw_fleet_t *f);
+
+/**
+ * @brief Returns number of devices whose update has not finished yet.
+ *
+ * @param f           Firmware update fleet
+ * @return            Number of devices, 0 if the fleet is NULL
+ */
+uint8_t lt_fw_fleet_pending(const lt_fw_fleet_t *f);
+
+/**
+ * @brief Returns progress of the update of the device.
+ *
+ * @param f           Firmware update fleet
+ * @param idx         Index of the device, in order of `lt_fw_fleet_add_device()` calls
+ * @param offset      Offset in the image up to which TROPIC01 accepted it (resume point), may be NULL
+ *
+ * @retval            LT_OK The whole image was written
+ * @retval            LT_L1_CHIP_BUSY Update of the device has not finished yet
+ * @retval            LT_PARAM_ERR The device does not exist
+ * @retval            other Update of the device failed with this error
+ */
+lt_ret_t lt_fw_fleet_progress(const lt_fw_fleet_t *f, const uint8_t idx, uint16_t *offset);
+#endif
+
+#ifdef LT_FW_PLAN
+/**
+ * @brief Initializes mutable firmware update of several banks, e.g. of both CPU and SPECT firmware.
+ *
+ * @note              `lt_fw_plan_run()` sends the L2 Request which makes TROPIC01 erase a bank before the host
+ *                    prepares the image it needs next, and receives its response only afterwards, so the preparation
+ *                    (fetch over network or from a file, parsing, checks) overlaps with the erase instead of
+ *                    adding to it. For ABAB, the image of a step is prepared while its bank is erased by
+ *                    Mutable_FW_Erase. For ACAB, TROPIC01 erases the bank on the update request at the beginning of
+ *                    the image, so the image of the next step is prepared while the update request of a step is
+ *                    processed.
+ *
+ * @param p           Firmware update plan
+ * @param prepare     Prepares images which are not given to `lt_fw_plan_add()`, may be NULL if all of them are
+ * @param progress    Reports progress of the steps, may be NULL
+ * @param cb_ctx      User data passed to the callbacks
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_fw_plan_init(lt_fw_plan_t *p, lt_fw_plan_prepare_t prepare, lt_fw_plan_progress_t progress,
+                         void *cb_ctx);
+
+/**
+ * @brief Adds update of a bank to the plan, steps are executed in order they were added.
+ *
+ * @param p                 Firmware update plan
+ * @param bank_id           Bank ID where the update should be applied, valid values are
+ *                             For ABAB: TR01_FW_BANK_FW1, TR01_FW_BANK_FW2, TR01_FW_BANK_SPECT1, TR01_FW_BANK_SPECT2
+ *                             For ACAB: Parameter is ignored, chip is handling firmware banks on its own
+ * @param update_data       Update image (the same as for `lt_do_mutable_fw_update()`), NULL to have it prepared by the
+ *                          prepare callback of the plan while TROPIC01 erases a bank
+ * @param update_data_size  Size of the update image, ignored if update_data is NULL
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters, or the image is NULL and the plan has no prepare callback
+ * @retval            LT_FAIL Plan already has `LT_FW_PLAN_MAX_STEPS` steps
+ */
+lt_ret_t lt_fw_plan_add(lt_fw_plan_t *p, const lt_bank_id_t bank_id, const uint8_t *update_data,
+                        const uint16_t update_data_size);
+
+/**
+ * @brief Executes the plan.
+ *
+ * @note              TROPIC01 has to be in Start-up mode (see `lt_reboot()` with `TR01_MAINTENANCE_REBOOT`). When a
+ *                    step fails, calling this function again continues with that step from its beginning, finished
+ *                    steps are not repeated. Images are not verified on the host, TROPIC01 verifies them.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param p           Firmware update plan
+ *
+ * @retval            LT_OK All steps were done
+ * @retval            LT_PARAM_ERR Invalid parameters or malformed image
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_fw_plan_run(lt_handle_t *h, lt_fw_plan_t *p);
+
+/**
+ * @brief Returns position of the plan.
+ *
+ * @param p           Firmware update plan
+ * @param step        Index of the step in progress, number of steps when the plan is done, may be NULL
+ * @param offset      Offset in the image of the step up to which TROPIC01 accepted it, may be NULL
+ *
+ * @retval            LT_OK All steps were done
+ * @retval            LT_L1_CHIP_BUSY Plan has not finished yet
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_fw_plan_progress(const lt_fw_plan_t *p, uint8_t *step, uint16_t *offset);
+#endif
+
+#ifdef LT_FW_UPDATE_RESUME
+/**
+ * @brief Initializes resumable mutable firmware update.
+ *
+ * @note              The image is the same as for `lt_do_mutable_fw_update()`, it is not copied and has to stay valid
+ *                    until the update finishes. TROPIC01 has to be in Start-up mode (see `lt_reboot()` with
+ *                    `TR01_MAINTENANCE_REBOOT`).
+ *
+ * @param s                 Firmware update session
+ * @param update_data       Update image
+ * @param update_data_size  Size of the update image
+ * @param bank_id           Bank ID where the update should be applied, valid values are
+ *                             For ABAB: TR01_FW_BANK_FW1, TR01_FW_BANK_FW2, TR01_FW_BANK_SPECT1, TR01_FW_BANK_SPECT2
+ *                             For ACAB: Parameter is ignored, chip is handling firmware banks on its own
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters or malformed image
+ */
+lt_ret_t lt_fw_update_session_init(lt_fw_update_session_t *s, const uint8_t *update_data,
+                                   const uint16_t update_data_size, const lt_bank_id_t bank_id);
+
+/**
+ * @brief Initializes firmware update session from a checkpoint exported by `lt_fw_update_session_checkpoint()`, e.g.
+ * before restart of the process, the update continues after the last acknowledged L2 Request.
+ *
+ * @note              ABAB writes every part of the image to its offset in the erased bank, so the update can be
+ *                    resumed even after TROPIC01 was rebooted into Start-up mode again. ACAB keeps the hash chain of
+ *                    the update only until reboot, a resumed update is rejected by TROPIC01 if it was rebooted since
+ *                    and has to be started again by `lt_fw_update_session_init()`.
+ *
+ * @param s                 Firmware update session
+ * @param update_data       Update image, has to be the same as when the checkpoint was exported
+ * @param update_data_size  Size of the update image
+ * @param cp                Checkpoint
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters, the checkpoint is corrupted or belongs to another image
+ */
+lt_ret_t lt_fw_update_session_resume(lt_fw_update_session_t *s, const uint8_t *update_data,
+                                     const uint16_t update_data_size, const lt_fw_update_checkpoint_t *cp);
+
+/**
+ * @brief Sends the next L2 Request of the update. On a transient error (`LT_L1_SPI_ERROR`, `LT_L1_CHIP_BUSY`,
+ * `LT_L1_INT_TIMEOUT`, `LT_L2_CRC_ERR`, `LT_L2_IN_CRC_ERR`) only this request is sent again, up to
+ * `LT_L2_RESEND_MAX_TRIES` times with the `LT_L2_RESEND_BACKOFF_MS` delay doubled with each attempt. The session
+ * advances only when TROPIC01 acknowledges the request, so after any error it can be stepped again or exported.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param s           Firmware update session
+ *
+ * @retval            LT_OK L2 Request was acknowledged, or the update is already finished
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_fw_update_session_step(lt_handle_t *h, lt_fw_update_session_t *s);
+
+/**
+ * @brief Calls `lt_fw_update_session_step()` until the whole image is acknowledged or an error occurs.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param s           Firmware update session
+ *
+ * @retval            LT_OK The whole image was written
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_fw_update_session_run(lt_handle_t *h, lt_fw_update_session_t *s);
+
+/**
+ * @brief Tells whether the whole image was acknowledged by TROPIC01.
+ *
+ * @param s           Firmware update session
+ * @return            true if the update is finished, false otherwise or if the session is NULL
+ */
+bool lt_fw_update_session_done(const lt_fw_update_session_t *s);
+
+/**
+ * @brief Returns position of the update.
+ *
+ * @param s           Firmware update session
+ * @param offset      Offset in the image up to which TROPIC01 acknowledged it, may be NULL
+ * @param chunks      Number of acknowledged L2 Requests carrying the image, i.e. index of the next one, may be NULL
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_fw_update_session_progress(const lt_fw_update_session_t *s, uint16_t *offset, uint16_t *chunks);
+
+/**
+ * @brief Exports position of the update for `lt_fw_update_session_resume()`.
+ *
+ * @param s           Firmware update session
+ * @param cp          Checkpoint to fill
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_fw_update_session_checkpoint(const lt_fw_update_session_t *s, lt_fw_update_checkpoint_t *cp);
+#endif
+
+#ifdef LT_FW_IMAGE
+/**
+ * @brief Opens mutable firmware update image read by parts, e.g. from a file or a flash partition, so the image does
+ * not have to be compiled into the application (`fw_CPU.h`, `fw_SPECT.h`).
+ * @details For ACAB, the image consists of the update request followed by data chunks, each starting with its length
+ * byte. The lengths are walked (one byte read per chunk) to validate the image and count the chunks, offsets of the
+ * first `index_len` chunks are stored to the index for random access. Without the index, chunk offsets are found by
+ * walking the lengths again. For ABAB, every chunk is a 128 B part of the image and no index is needed.
+ *
+ * @param img         Firmware image
+ * @param read        Reads the image
+ * @param read_ctx    Context passed to the reader
+ * @param size        Size of the image
+ * @param index       Array for offsets of the chunks, may be NULL (ACAB only)
+ * @param index_len   Number of entries of the index, offsets of further chunks are walked from the last indexed one
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters or malformed image
+ * @retval            other Error returned by the reader
+ */
+lt_ret_t lt_fw_image_open(lt_fw_image_t *img, lt_fw_image_read_t read, void *read_ctx, const uint16_t size,
+                          uint16_t *index, const uint16_t index_len);
+
+/**
+ * @brief Returns number of chunks of the image, i.e. of L2 Requests carrying it (for ACAB including the update
+ * request, for ABAB excluding the erase).
+ *
+ * @param img         Firmware image
+ * @return            Number of chunks, 0 if the image is NULL
+ */
+uint16_t lt_fw_image_chunk_count(const lt_fw_image_t *img);
+
+/**
+ * @brief Returns offset and length of the chunk in the image.
+ *
+ * @param img         Firmware image
+ * @param idx         Index of the chunk
+ * @param offset      Offset of the chunk, for ACAB of its length byte
+ * @param len         Length of the chunk, for ACAB including its length byte, may be NULL
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters or the chunk does not exist
+ * @retval            other Error returned by the reader
+ */
+lt_ret_t lt_fw_image_chunk(const lt_fw_image_t *img, const uint16_t idx, uint16_t *offset, uint16_t *len);
+
+/**
+ * @brief Sends chunks of the image to TROPIC01 right from the reader to the L2 buffer, starting with the chunk
+ * `first_chunk`, so no other buffer for the image is needed.
+ * @details For ABAB, the bank is erased first if `first_chunk` is 0. An update which failed may be resumed from the
+ * chunk reported in `next_chunk`, as long as TROPIC01 was not rebooted since (ACAB keeps the hash chain of the
+ * update only until the reboot).
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param img         Firmware image
+ * @param bank_id     Bank ID where the update should be applied, valid values are
+ *                       For ABAB: TR01_FW_BANK_FW1, TR01_FW_BANK_FW2, TR01_FW_BANK_SPECT1, TR01_FW_BANK_SPECT2
+ *                       For ACAB: Parameter is ignored, chip is handling firmware banks on its own
+ * @param first_chunk Index of the first chunk to send, 0 for a new update
+ * @param next_chunk  Index of the first chunk not acknowledged by TROPIC01, may be NULL
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_fw_image_update(lt_handle_t *h, const lt_fw_image_t *img, const lt_bank_id_t bank_id,
+                            const uint16_t first_chunk, uint16_t *next_chunk);
+#endif
+
+#ifdef LT_SILICON_REV_CHECK
+/**
+ * @brief Detects silicon revision of TROPIC01 from the size of the FW header its bootloader returns (see
+ * lt_print_fw_header()). The revision is detected once after lt_init(), then the detected one is returned without
+ * any communication.
+ *
+ * @note              TROPIC01 has to be in Maintenance mode for the first call (see lt_reboot()).
+ * @note              Detection only, Libtropic does not dispatch between the revisions at runtime. Firmware update of
+ *                    the detected revision works only if it is the one Libtropic was built for (LT_SILICON_REV).
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param rev         Detected silicon revision
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_get_silicon_rev(lt_handle_t *h, lt_silicon_rev_t *rev);
+
+/**
+ * @brief Checks that silicon revision of TROPIC01 is the one Libtropic was built for (LT_SILICON_REV). Called by
+ * lt_mutable_fw_erase() and lt_mutable_fw_update(), so also by the helpers built on them. Call it before other
+ * firmware update flows (e.g. lt_fw_fleet_run()).
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_SILICON_REV_MISMATCH TROPIC01 has the other silicon revision
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_silicon_rev_check(lt_handle_t *h);
+#endif
+
+#ifdef LT_CERT_CACHE
+/**
+ * @brief Fills certificate cache from TROPIC01: reads CHIP_ID and the whole certificate store, parses STPUB.
+ *
+ * @note              The certificate chain is not verified by this function. Verify it (see
+ *                    `lt_cert_cache_get_store()`) before the cache is persisted.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cache       Certificate cache
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_cert_cache_fill(lt_handle_t *h, lt_cert_cache_t *cache);
+
+/**
+ * @brief Tells whether the cache was filled by `lt_cert_cache_fill()` with this version of libtropic and is intact,
+ * e.g. after it was loaded from a file.
+ *
+ * @param cache       Certificate cache
+ * @return            true if the cache is valid
+ */
+bool lt_cert_cache_valid(const lt_cert_cache_t *cache);
+
+/**
+ * @brief Makes certificate store view of the cached certificates, e.g. to verify the chain.
+ *
+ * @param cache       Valid certificate cache
+ * @param store       Certificate store, its buffers point into the cache
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Cache is not valid
+ */
+lt_ret_t lt_cert_cache_get_store(lt_cert_cache_t *cache, struct lt_cert_store_t *store);
+
+/**
+ * @brief Establishes a secure channel as `lt_verify_chip_and_start_secure_session()` does, but takes STPUB from the
+ * certificate cache if it was filled from the same TROPIC01.
+ * @details Only CHIP_ID is read from TROPIC01 on a warm start. If the cache is not valid, belongs to another chip
+ * or the handshake with the cached STPUB fails, the cache is refilled and the handshake repeated.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cache       Certificate cache, e.g. loaded from persistent storage
+ * @param shipriv     Host's private pairing key for the slot `pkey_index`
+ * @param shipub      Host's public pairing key for the slot `pkey_index`
+ * @param pkey_index  Pairing key index
+ * @param refreshed   Set to true if the cache was refilled and should be persisted again
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_verify_chip_and_start_secure_session_cached(lt_handle_t *h, lt_cert_cache_t *cache,
+                                                        const uint8_t *shipriv, const uint8_t *shipub,
+                                                        const lt_pkey_index_t pkey_index, bool *refreshed);
+#endif
+
+#ifdef LT_PAIRING_KEY_CACHE
+/**
+ * @brief Initializes empty pairing key cache with the provider of the pairing keys.
+ *
+ * @param cache       Pairing key cache
+ * @param unwrap      Provider of the pairing keys
+ * @param unwrap_ctx  Context passed to `unwrap`, may be NULL
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_pairing_key_cache_init(lt_pairing_key_cache_t *cache, lt_pairing_key_unwrap_fn_t unwrap, void *unwrap_ctx);
+
+/**
+ * @brief Gets pairing keys of the slot, the provider is called only if the slot is not cached yet.
+ *
+ * @param cache       Initialized pairing key cache
+ * @param pkey_index  Pairing key index
+ * @param shipriv     Set to the host's private pairing key inside the cache
+ * @param shipub      Set to the host's public pairing key inside the cache
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ * @retval            other Returned by the provider, nothing is cached
+ */
+lt_ret_t lt_pairing_key_cache_get(lt_pairing_key_cache_t *cache, const lt_pkey_index_t pkey_index,
+                                  const uint8_t **shipriv, const uint8_t **shipub);
+
+/**
+ * @brief Wipes cached pairing keys of the slot, the next `lt_pairing_key_cache_get()` calls the provider again.
+ *
+ * @param cache       Initialized pairing key cache
+ * @param pkey_index  Pairing key index
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_pairing_key_cache_forget(lt_pairing_key_cache_t *cache, const lt_pkey_index_t pkey_index);
+
+/**
+ * @brief Wipes all cached pairing keys and detaches the provider.
+ *
+ * @param cache       Pairing key cache
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_pairing_key_cache_deinit(lt_pairing_key_cache_t *cache);
+
+/**
+ * @brief Establishes a secure channel as `lt_verify_chip_and_start_secure_session()` does, with pairing keys taken from
+ * the pairing key cache.
+ * @details If the handshake fails, the keys of the slot are forgotten, so the next call unwraps them again (e.g. the
+ * keys were changed in the meantime).
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cache       Initialized pairing key cache
+ * @param pkey_index  Pairing key index
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pairing_key_cache_start_session(lt_handle_t *h, lt_pairing_key_cache_t *cache,
+                                             const lt_pkey_index_t pkey_index);
+#endif
+
+#ifdef LT_CERT_CHAIN
+/**
+ * @brief Initializes chain verifier with the trusted root and an empty memo of verified CA certificates.
+ *
+ * @param chain       Chain verifier
+ * @param root_hash   SHA-256 of the DER encoded trusted root certificate (Tropic Square Root CA),
+ *                    LT_CERT_CHAIN_HASH_LEN bytes
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_cert_chain_init(lt_cert_chain_t *chain, const uint8_t *root_hash);
+
+/**
+ * @brief Verifies the certificate chain of the certificate store from the device certificate up to the trusted root.
+ * @details The root certificate must match the root the verifier was initialized with. Each other certificate must
+ * name its successor in the store as its issuer and carry a valid signature by its key. CA certificates whose SHA-256
+ * is in the memo were verified before and are not verified again, CA certificates verified by this call are added to
+ * it (oldest entries are replaced when it is full). Validity periods and extensions are not checked.
+ *
+ * @param h           Handle for communication with TROPIC01 (only its crypto context is used, for SHA-256)
+ * @param chain       Chain verifier
+ * @param store       Certificate store with all certificates read, e.g. by `lt_get_info_cert_store()`
+ * @param verify      Verifies one signature
+ * @param verify_ctx  User data passed to `verify`
+ *
+ * @retval            LT_OK Chain is valid
+ * @retval            LT_CERT_CHAIN_INVALID Root is not trusted, issuer does not match or a signature is not valid
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_cert_chain_verify(lt_handle_t *h, lt_cert_chain_t *chain, const struct lt_cert_store_t *store,
+                              lt_cert_sig_verify_fn_t verify, void *verify_ctx);
+
+/**
+ * @brief Forgets all verified CA certificates, e.g. after a CA was revoked.
+ *
+ * @param chain       Chain verifier
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_cert_chain_memo_clear(lt_cert_chain_t *chain);
+#endif
+
+#ifdef LT_SESSION_CACHE
+/**
+ * @brief Initializes session cache with the parts of Secure Channel Handshake, which depend only on STPUB and
+ * SHiPUB.
+ *
+ * @note              The cache is bound to one TROPIC01 (STPUB) and one pairing key (SHiPUB). Together with
+ *                    `lt_session_cache_prepare()` it reduces the handshake done by `lt_session_start_cached()` to
+ *                    one L2 round-trip, two X25519 and the key derivation.
+ *
+ * @param h           Handle for communication with TROPIC01 (its crypto context is used)
+ * @param cache       Session cache
+ * @param stpub       STPUB from device's certificate
+ * @param shipub      Secure host public key
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_cache_init(lt_handle_t *h, lt_session_cache_t *cache, const uint8_t *stpub, const uint8_t *shipub);
+
+/**
+ * @brief Precomputes Host MCU ephemeral keys for the next handshakes, until `LT_SESSION_CACHE_EPH_KEYS` key pairs are
+ * prepared. Meant to be called in idle time.
+ *
+ * @note              Does nothing if the keys are already prepared. Each key pair is used for one handshake only.
+ *                    The prepared key pairs are kept in a single-producer single-consumer ring, so this function may
+ *                    be called from a low priority task or thread while another one starts Secure Sessions with the
+ *                    cache. Only one task may prepare the cache at a time and `lt_port_random_bytes()` of the HAL must
+ *                    be safe to call from the preparing task.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cache       Session cache initialized by `lt_session_cache_init()`
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_cache_prepare(lt_handle_t *h, lt_session_cache_t *cache);
+
+/**
+ * @brief Wipes session cache.
+ *
+ * @note              Detach the cache from the handle (see `lt_session_cache_attach()`) first.
+ *
+ * @param cache       Session cache
+ */
+void lt_session_cache_clear(lt_session_cache_t *cache);
+
+/**
+ * @brief Attaches session cache to the handle, so `lt_session_start()` takes the transcript hash prefix from it
+ * instead of hashing SHiPUB and STPUB, when they match those the cache was initialized with. The handshake takes its
+ * ephemeral key pair from the cache too, if one is prepared by `lt_session_cache_prepare()`.
+ *
+ * @note              `lt_init()` detaches the cache, attach it after `lt_init()`. The cache is not copied, it has to
+ *                    stay valid while it is attached.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cache       Session cache initialized by `lt_session_cache_init()`, NULL detaches the cache
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_cache_attach(lt_handle_t *h, lt_session_cache_t *cache);
+
+/**
+ * @brief Establishes encrypted secure session between TROPIC01 and host MCU, same as `lt_session_start()`, but
+ * using data prepared in the session cache.
+ *
+ * @note              `hits` and `misses` members of the cache count handshakes done with and without ephemeral
+ *                    keys prepared by `lt_session_cache_prepare()`.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cache       Session cache initialized by `lt_session_cache_init()`
+ * @param pkey_index  Index of pairing public key
+ * @param shipriv     Secure host private key
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_start_cached(lt_handle_t *h, lt_session_cache_t *cache, const lt_pkey_index_t pkey_index,
+                                 const uint8_t *shipriv);
+#endif
+
+#ifdef LT_SESSION_MGR
+/**
+ * @brief Initializes session manager, which executes requests of several pairing key slots on one handle.
+ *
+ * @note              TROPIC01 keeps only one Secure Session at a time, every handshake terminates the previous one.
+ *                    The manager keeps the session of one slot open and executes queued requests batched per slot,
+ *                    so the number of handshakes (switches between slots) is minimized.
+ *
+ * @param mgr         Session manager
+ * @param h           Handle for communication with TROPIC01, `lt_init()` has to be called already
+ * @param stpub       STPUB from device's certificate
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_mgr_init(lt_session_mgr_t *mgr, lt_handle_t *h, const uint8_t *stpub);
+
+/**
+ * @brief Sets pairing keys used by the session manager for the pairing key slot.
+ *
+ * @note              Keys are not copied, they have to stay valid while the manager is used.
+ *
+ * @param mgr         Session manager
+ * @param pkey_index  Index of pairing public key
+ * @param shipriv     Secure host private key
+ * @param shipub      Secure host public key
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_mgr_set_keys(lt_session_mgr_t *mgr, const lt_pkey_index_t pkey_index, const uint8_t *shipriv,
+                                 const uint8_t *shipub);
+
+/**
+ * @brief Queues request to be executed in Secure Session on the pairing key slot by `lt_session_mgr_run()`.
+ *
+ * @param mgr         Session manager
+ * @param pkey_index  Index of pairing public key, keys have to be set by `lt_session_mgr_set_keys()`
+ * @param fn          Function executing the request, it must not submit further requests
+ * @param ctx         Context passed to fn
+ * @param ret         Result of fn (or of the failed handshake) is stored here, may be NULL
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Queue is full (`LT_SESSION_MGR_QUEUE_LEN`)
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_mgr_submit(lt_session_mgr_t *mgr, const lt_pkey_index_t pkey_index, lt_session_mgr_fn_t fn,
+                               void *ctx, lt_ret_t *ret);
+
+/**
+ * @brief Executes all queued requests.
+ * @details Requests of the slot with the open Secure Session go first, then the slot of the oldest queued request
+ * is handshaked and all its requests are executed, and so on. Order of requests of one slot is kept. When the
+ * handshake fails, requests of the slot fail with the handshake error.
+ *
+ * @param mgr         Session manager
+ *
+ * @retval            LT_OK All handshakes succeeded, results of the requests are stored separately
+ * @retval            other Error of the first failed handshake, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_mgr_run(lt_session_mgr_t *mgr);
+
+/**
+ * @brief Reads counters of the session manager.
+ *
+ * @param mgr         Session manager
+ * @param stats       Counters are copied here
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_mgr_get_stats(const lt_session_mgr_t *mgr, lt_session_mgr_stats_t *stats);
+
+/**
+ * @brief Resets counters of the session manager.
+ *
+ * @param mgr         Session manager
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_mgr_reset_stats(lt_session_mgr_t *mgr);
+
+/**
+ * @brief Computes rate of switches between pairing key slots.
+ *
+ * @note              Libtropic has no clock, pass time elapsed since the counters were reset.
+ *
+ * @param stats       Counters from `lt_session_mgr_get_stats()`
+ * @param elapsed_ms  Time in ms the counters were collected for
+ * @return            Switches per second (rounded down), 0 if elapsed_ms is 0
+ */
+uint32_t lt_session_mgr_switches_per_sec(const lt_session_mgr_stats_t *stats, const uint32_t elapsed_ms);
+
+/**
+ * @brief Aborts Secure Session opened by the session manager and wipes the manager.
+ *
+ * @param mgr         Session manager
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_mgr_deinit(lt_session_mgr_t *mgr);
+#endif
+
+#ifdef LT_SESSION_ROLLOVER
+/**
+ * @brief Enables scheduled rollover of the Secure Session: once the session nonce reaches the threshold,
+ * `lt_session_rollover_poll()` starts a new session with the given keys.
+ *
+ * @note              Call `lt_session_rollover_poll()` from idle windows (e.g. between requests of a daemon), so the
+ *                    handshake never delays a request and L3 commands never fail with `LT_NONCE_OVERFLOW`.
+ *                    Keys are not copied, they have to stay valid while the rollover is enabled.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param threshold   Nonce value from which the session is due for a rollover, 1 to UINT32_MAX
+ * @param stpub       STPUB from device's certificate
+ * @param pkey_index  Index of pairing public key
+ * @param shipriv     Secure host private key
+ * @param shipub      Secure host public key
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_rollover_enable(lt_handle_t *h, const uint32_t threshold, const uint8_t *stpub,
+                                    const lt_pkey_index_t pkey_index, const uint8_t *shipriv, const uint8_t *shipub);
+
+/**
+ * @brief Disables scheduled rollover of the Secure Session.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_rollover_disable(lt_handle_t *h);
+
+/**
+ * @brief Checks whether the Secure Session reached the rollover threshold.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @return            true if the rollover is enabled, the session is on and its nonce reached the threshold
+ */
+bool lt_session_rollover_due(const lt_handle_t *h);
+
+/**
+ * @brief Starts a new Secure Session if the current one is due for a rollover, otherwise does nothing.
+ *
+ * @note              With a session cache attached to the handle (`lt_session_cache_attach()` of `LT_SESSION_CACHE`),
+ *                    the handshake takes its ephemeral key pair from the cache, so keeping the cache prepared in the
+ *                    background makes the rollover cheaper.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK No rollover was due, or the new session was started
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_rollover_poll(lt_handle_t *h);
+
+/**
+ * @brief Returns number of rollovers done by `lt_session_rollover_poll()`.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @return            Number of rollovers, 0 if h is NULL
+ */
+uint32_t lt_session_rollover_count(const lt_handle_t *h);
+#endif
+
+#ifdef LT_SESSION_EXPORT
+/**
+ * @brief Seals the Secure Session of the handle into a blob for `lt_session_import()`, e.g. in the next process of a
+ * daemon being restarted, so the session on TROPIC01 is used on without a new handshake.
+ * @details The blob holds the nonces and keys of the session, encrypted and authenticated by AES-GCM with the host key.
+ *          The handle gives up the session in any case, as by `lt_session_abort()` but without telling TROPIC01, so
+ *          it never sends another L3 Command with the nonces in the blob. The blob has a single owner: it must be
+ *          imported once, by one handle, and must not be kept after the import; every copy imported would reuse the
+ *          nonces of the session. If the export fails, a new session has to be started.
+ * @note The importing process must not reboot TROPIC01 (e.g. it is initialized by `lt_init_warm()`), otherwise the
+ *       session on TROPIC01 is gone and the first L3 Command after the import fails.
+ *
+ * @param h           Handle for communication with TROPIC01, with the Secure Session on and no L3 Command in flight
+ * @param wrap_key    Host key of LT_SESSION_WRAP_KEY_LEN bytes, shared only with the importing process
+ * @param blob        Sealed Secure Session
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_HOST_NO_SESSION The handle has no Secure Session
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_export(lt_handle_t *h, const uint8_t *wrap_key, lt_session_blob_t *blob);
+
+/**
+ * @brief Resumes the Secure Session sealed by `lt_session_export()` on the handle, with no communication with TROPIC01.
+ * @details A session of the handle is replaced. On success, the blob is wiped, so the same buffer cannot be imported
+ *          again; a blob which is not authentic (other host key, modified or of another layout version) is refused
+ *          and left intact.
+ *
+ * @param h           Handle for communication with TROPIC01, initialized without reboot of TROPIC01
+ * @param wrap_key    Host key of LT_SESSION_WRAP_KEY_LEN bytes used by the export
+ * @param blob        Sealed Secure Session
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Not a blob of this layout version
+ * @retval            LT_CRYPTO_ERR The blob is not authentic
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_import(lt_handle_t *h, const uint8_t *wrap_key, lt_session_blob_t *blob);
+#endif
+
+/**
+ * @brief Aborts encrypted secure session between TROPIC01 and host MCU
+ *
+ * @note              Data used for the Secure Session are always invalidated regardless
+ *                    of the result of the abort request (if you pass correct handle).
+ *                    After calling this function, it will not be possible to send L3 commands
+ *                    unless new Secure Session is started.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_session_abort(lt_handle_t *h);
+
+/**
+ * @brief Puts TROPIC01 into sleep
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param sleep_kind  Kind of sleep
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_sleep(lt_handle_t *h, const uint8_t sleep_kind);
+
+#ifdef LT_IDLE_MGR
+/**
+ * @brief Initializes idle manager, which puts TROPIC01 to sleep by `lt_idle_poll()` after the idle time of the
+ * policy and wakes it in `lt_idle_begin()`. Calls of Libtropic API using TROPIC01 have to be enclosed in
+ * `lt_idle_begin()` and `lt_idle_end()`.
+ *
+ * @param idle        Idle manager
+ * @param h           Handle for communication with TROPIC01, initialized by lt_init()
+ * @param policy      Policy, copied to the manager
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_idle_init(lt_idle_t *idle, lt_handle_t *h, const lt_idle_policy_t *policy);
+
+/**
+ * @brief Sets keys of the Secure Session restored after the wake (see `restore_session` of the policy).
+ *
+ * @note              Keys are not copied, they have to stay valid while the manager is used.
+ *
+ * @param idle        Idle manager
+ * @param stpub       STPUB from device's certificate
+ * @param pkey_index  Index of pairing public key
+ * @param shipriv     Secure host private key
+ * @param shipub      Secure host public key
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_idle_set_session(lt_idle_t *idle, const uint8_t *stpub, const lt_pkey_index_t pkey_index,
+                             const uint8_t *shipriv, const uint8_t *shipub);
+
+/**
+ * @brief Marks start of using TROPIC01. If it sleeps, it is woken by the next L2 Request and the Secure Session open
+ * before the sleep is restored, if the policy says so.
+ *
+ * @param idle        Idle manager
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Restore of the Secure Session failed, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_idle_begin(lt_idle_t *idle);
+
+/**
+ * @brief Marks end of using TROPIC01, the idle time is counted from now.
+ *
+ * @param idle        Idle manager
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_idle_end(lt_idle_t *idle);
+
+/**
+ * @brief Puts TROPIC01 to sleep if it was idle for the time of the policy, otherwise does nothing. Call it from the
+ * idle loop of the application.
+ * @details The Secure Session does not survive the sleep, its host side data are invalidated.
+ *
+ * @param idle        Idle manager
+ *
+ * @retval            LT_OK TROPIC01 was put to sleep, or it was not idle for long enough
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_idle_poll(lt_idle_t *idle);
+
+/**
+ * @brief Checks whether TROPIC01 was put to sleep by the idle manager and not woken yet.
+ *
+ * @param idle        Idle manager
+ * @return            true if TROPIC01 sleeps
+ */
+bool lt_idle_asleep(const lt_idle_t *idle);
+
+/**
+ * @brief Reads counters of the idle manager.
+ *
+ * @param idle        Idle manager
+ * @param stats       Counters are copied here
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_idle_get_stats(const lt_idle_t *idle, lt_idle_stats_t *stats);
+#endif
+
+/**
+ * @brief Reboots TROPIC01
+ * @details Waits LT_TR01_REBOOT_DELAY_MS for TROPIC01 to come up, with LT_REBOOT_POLL only LT_TR01_REBOOT_MIN_DELAY_MS
+ * and then polls CHIP_STATUS until TROPIC01 is ready in the requested mode.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param startup_id  Startup ID (determines into which mode will TROPIC01 reboot)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_reboot(lt_handle_t *h, const lt_startup_id_t startup_id);
+
+#ifdef LT_REBOOT_ASYNC
+/**
+ * @brief Starts reboot of TROPIC01 without waiting for it to come up.
+ * @details Only the Startup_Req is exchanged here. `lt_reboot_async_process()` then reads CHIP_STATUS every
+ * LT_REBOOT_ASYNC_POLL_MS until TROPIC01 is ready in the requested mode, or ALARM is set, or LT_TR01_REBOOT_DELAY_MS
+ * passed, and checks the mode as `lt_reboot()` does. Reboots of several devices, each with its own handle, can be
+ * in progress at once.
+ *
+ * @param r           Asynchronous reboot, must not be in progress
+ * @param h           Handle for communication with TROPIC01, initialized
+ * @param startup_id  Startup ID (determines into which mode will TROPIC01 reboot)
+ * @param cb          Called when the reboot finishes, may be NULL if `lt_reboot_async_process()` return value is used
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK Reboot was started
+ * @retval            other Startup_Req failed, the callback is not called
+ */
+lt_ret_t lt_reboot_async_start(lt_reboot_async_t *r, lt_handle_t *h, const lt_startup_id_t startup_id,
+                               lt_reboot_async_cb_t cb, void *cb_ctx);
+
+/**
+ * @brief Starts initialization of the handle as `lt_init()` does, without waiting for TROPIC01 to reboot.
+ * @details The mode of TROPIC01 is probed here. If it is not executing the Application FW, its reboot is started as
+ * by `lt_reboot_async_start()`. Once TROPIC01 is up, `lt_reboot_async_process()` reads the Application FW version and
+ * initializes the TROPIC01 attributes. The handle must not be used until the initialization finishes, when it fails,
+ * the handle is left deinitialized.
+ *
+ * @param r           Asynchronous reboot, must not be in progress
+ * @param h           Handle for communication with TROPIC01, not initialized yet
+ * @param cb          Called when the initialization finishes, may be NULL
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK Initialization was started
+ * @retval            other Initialization failed, the handle is not initialized and the callback is not called
+ */
+lt_ret_t lt_init_async_start(lt_reboot_async_t *r, lt_handle_t *h, lt_reboot_async_cb_t cb, void *cb_ctx);
+
+/**
+ * @brief Advances asynchronous reboot or initialization, never waits for TROPIC01.
+ * @details Until the next read of CHIP_STATUS is due (see `lt_reboot_async_delay_ms()`), returns without any
+ * communication. The callback is called from here when the reboot finishes.
+ *
+ * @param r           Asynchronous reboot
+ *
+ * @retval            LT_L1_CHIP_BUSY Reboot is still in progress
+ * @retval            LT_OK Reboot finished successfully (callback was called)
+ * @retval            other Reboot failed (callback was called), or it was not started
+ */
+lt_ret_t lt_reboot_async_process(lt_reboot_async_t *r);
+
+/**
+ * @brief Returns time until `lt_reboot_async_process()` has something to do, to sleep in an event loop.
+ *
+ * @param r           Asynchronous reboot
+ * @return            Delay in ms, 0 if the reboot is due to be processed or it is not in progress
+ */
+uint32_t lt_reboot_async_delay_ms(const lt_reboot_async_t *r);
+
+/**
+ * @brief Checks whether asynchronous reboot or initialization is in progress.
+ *
+ * @param r           Asynchronous reboot
+ * @return            true if in progress
+ */
+bool lt_reboot_async_busy(const lt_reboot_async_t *r);
+#endif
+
+#ifdef ABAB
+/** @brief Maximal size of update data */
+#define TR01_MUTABLE_FW_UPDATE_SIZE_MAX 25600
+#ifdef LT_CMD_FW_UPDATE
+/**
+ * @brief Erase mutable firmware in one of banks
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param bank_id     enum lt_bank_id_t
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_mutable_fw_erase(lt_handle_t *h, const lt_bank_id_t bank_id);
+
+/**
+ * @brief Update mutable firmware in one of banks
+ *
+ * @param h             Handle for communication with TROPIC01
+ * @param fw_data       Array with firmware bytes
+ * @param fw_data_size  Number of firmware's bytes in passed array
+ * @param bank_id       enum lt_bank_id_t
+ * lt_ret_t             LT_OK            - SUCCESS
+ *                      other parameters - ERROR, for verbose output pass return value to function lt_ret_verbose()
+ */
+lt_ret_t lt_mutable_fw_update(lt_handle_t *h, const uint8_t *fw_data, const uint16_t fw_data_size,
+                              lt_bank_id_t bank_id);
+#endif
+
+#elif ACAB
+/** @brief Maximal size of update data */
+#define TR01_MUTABLE_FW_UPDATE_SIZE_MAX 30720
+#ifdef LT_CMD_FW_UPDATE
+/**
+ * @brief Sends mutable firmware update L2 request to TROPIC01 with silicon revision ACAB
+ *
+ * @param h               Handle for communication with TROPIC01
+ * @param update_request  Array with firmware update request bytes
+ * @return                LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_mutable_fw_update(lt_handle_t *h, const uint8_t *update_request);
+
+/**
+ * @brief Sends mutable firmware update data to TROPIC01 with silicon revision ACAB. Function
+ * `lt_mutable_fw_update()` must be called first to start authenticated mutable fw update.
+ *
+ * @param h                 Handle for communication with TROPIC01
+ * @param update_data       Array with firmware update data bytes
+ * @param update_data_size  Size of update data
+ * @return                  LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_mutable_fw_update_data(lt_handle_t *h, const uint8_t *update_data, const uint16_t update_data_size);
+
+/**
+ * @brief Sends one chunk of mutable firmware update data to TROPIC01 with silicon revision ACAB, so the data do not
+ * have to be contiguous in memory. Chunks have to be sent in order of the image, after `lt_mutable_fw_update()`.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param chunk       Chunk in the format of the update data, i.e. its length byte followed by that many bytes
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_mutable_fw_update_data_chunk(lt_handle_t *h, const uint8_t *chunk);
+#endif
+
+#endif
+/**
+ * @brief Gets Log message of TROPIC01's RISC-V FW (if enabled/available).
+ * @note RISC-V FW logging can be disabled in the I/R-Config and for the production chips, it **will** be disabled. This
+ * function is used mainly for internal debugging and not expected to be used by the user.
+ *
+ * @param h                    Handle for communication with TROPIC01
+ * @param log_msg              Buffer for the log message (atleast 255B)
+ * @param log_msg_max_size     Size of the log message buffer
+ * @param log_msg_read_size    Number of bytes read into the log message buffer
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_get_log_req(lt_handle_t *h, uint8_t *log_msg, const uint16_t log_msg_max_size, uint16_t *log_msg_read_size);
+
+#ifdef LT_CPU_LOG_DRAIN
+/**
+ * @brief Initializes CPU log, a ring buffer of log messages of TROPIC01's RISC-V FW filled by
+ * `lt_cpu_log_drain_step()` and emptied by `lt_cpu_log_read()` or `lt_cpu_log_print()`.
+ *
+ * @param log         CPU log
+ * @param buff        Ring buffer, at least 512 B
+ * @param size        Size of buff, power of two
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_cpu_log_init(lt_cpu_log_t *log, uint8_t *buff, const uint32_t size);
+
+/**
+ * @brief Attaches CPU log to the handle, the alarm log retrieved with `LT_RETRIEVE_ALARM_LOG` is then stored into it
+ * instead of being printed by `lt_port_log()`.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param log         CPU log, NULL to detach
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_cpu_log_attach(lt_handle_t *h, lt_cpu_log_t *log);
+
+/**
+ * @brief Step of the drain of the CPU log, usable as `lt_sched_fn_t`. Every step sends one Get_Log_Req and stores
+ * the message into the CPU log, the drain is done when TROPIC01 has no further message. Nothing is sent while the CPU
+ * log has no space for the longest message, unread messages are never overwritten.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param ctx         CPU log (`lt_cpu_log_t`)
+ * @param done        Set to false if TROPIC01 may have further messages
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_cpu_log_drain_step(lt_handle_t *h, void *ctx, bool *done);
+
+/**
+ * @brief Moves data of the CPU log to the buffer.
+ *
+ * @param log         CPU log
+ * @param out         Output buffer
+ * @param max_len     Size of out
+ * @return            Number of bytes moved
+ */
+uint32_t lt_cpu_log_read(lt_cpu_log_t *log, uint8_t *out, const uint32_t max_len);
+
+/**
+ * @brief Prints at most max_len bytes of the CPU log by `lt_port_log()`, in chunks instead of byte by byte. Call it
+ * repeatedly from the idle loop to feed a slow console in slices.
+ *
+ * @param log         CPU log
+ * @param max_len     Maximal number of bytes printed
+ * @return            Number of bytes printed
+ */
+uint32_t lt_cpu_log_print(lt_cpu_log_t *log, const uint32_t max_len);
+
+/**
+ * @brief Returns number of messages dropped because the CPU log was full.
+ *
+ * @param log         CPU log
+ * @return            Number of dropped messages
+ */
+uint32_t lt_cpu_log_dropped(const lt_cpu_log_t *log);
+#endif
+
+/**
+ * @brief A dummy command to check the Secure Channel Session communication by exchanging a message with TROPIC01, whish
+ * is echoed through the Secure Channel.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param msg_out     Ping message going out
+ * @param msg_in      Ping message going in
+ * @param msg_len     Length of both messages (msg_out and msg_in)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ping(lt_handle_t *h, const uint8_t *msg_out, uint8_t *msg_in, const uint16_t msg_len);
+
+#ifdef LT_HEALTH
+/**
+ * @brief Initializes health monitor of TROPIC01 in a Secure Session. Every authenticated L3 Result counts as a check
+ * passed, so `lt_health_poll()` sends Ping only when TROPIC01 was idle for the monitoring period.
+ *
+ * @param mon         Health monitor
+ * @param h           Handle for communication with TROPIC01
+ * @param period_ms   Monitoring period in milliseconds
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameter
+ */
+lt_ret_t lt_health_init(lt_health_t *mon, lt_handle_t *h, const uint32_t period_ms);
+
+/**
+ * @brief Checks health of TROPIC01, call it from the idle loop of the application.
+ * @details Passes without communication when an L3 Result arrived within the monitoring period. Otherwise sends Ping
+ * with an empty message, unless an L3 Command submitted by `lt_submit()` is in flight (the check is deferred then, as
+ * the command answers it).
+ *
+ * @param mon         Health monitor
+ *
+ * @retval            LT_OK TROPIC01 is healthy, or the check was deferred
+ * @retval            other Ping failed, you might use lt_ret_verbose() to get verbose encoding of returned value
+ */
+lt_ret_t lt_health_poll(lt_health_t *mon);
+
+/**
+ * @brief Reads counters of the health monitor.
+ *
+ * @param mon         Health monitor
+ * @param stats       Counters are copied here
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_health_get_stats(const lt_health_t *mon, lt_health_stats_t *stats);
+#endif
+
+#ifdef LT_SCHED
+/**
+ * @brief Initializes scheduler of jobs for one TROPIC01. Jobs of higher priority class go first, bulk jobs split into
+ * steps (see `lt_sched_fn_t`) do not hold back urgent jobs queued after them for longer than one step.
+ *
+ * @param s           Scheduler
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameter
+ */
+lt_ret_t lt_sched_init(lt_sched_t *s, lt_handle_t *h);
+
+/**
+ * @brief Queues job to be executed by `lt_sched_step()` or `lt_sched_run()`. May be called from a step of another
+ * job.
+ *
+ * @param s           Scheduler
+ * @param prio        Priority class of the job
+ * @param fn          Function executing steps of the job
+ * @param ctx         Context passed to fn
+ * @param ret         Result of the job is stored here once it finishes, may be NULL
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Queue is full (`LT_SCHED_QUEUE_LEN`)
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_sched_submit(lt_sched_t *s, const lt_sched_prio_t prio, lt_sched_fn_t fn, void *ctx, lt_ret_t *ret);
+
+/**
+ * @brief Executes one step of the oldest job of the highest priority class with queued jobs.
+ *
+ * @param s           Scheduler
+ *
+ * @retval            LT_OK A step was executed, its result is stored separately once the job finishes
+ * @retval            LT_FAIL Queue is empty
+ * @retval            LT_PARAM_ERR Invalid parameter
+ */
+lt_ret_t lt_sched_step(lt_sched_t *s);
+
+/**
+ * @brief Executes steps until the queue is empty, including jobs submitted meanwhile.
+ *
+ * @param s           Scheduler
+ *
+ * @retval            LT_OK Function executed successfully, results of the jobs are stored separately
+ * @retval            LT_PARAM_ERR Invalid parameter
+ */
+lt_ret_t lt_sched_run(lt_sched_t *s);
+
+/**
+ * @brief Returns number of queued jobs.
+ *
+ * @param s           Scheduler
+ * @return            Number of queued jobs, 0 if s is NULL
+ */
+uint8_t lt_sched_pending(const lt_sched_t *s);
+
+/**
+ * @brief Reads counters of the scheduler.
+ *
+ * @param s           Scheduler
+ * @param stats       Counters are copied here
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_sched_get_stats(const lt_sched_t *s, lt_sched_stats_t *stats);
+#endif
+
+/**
+ * @brief Writes pairing public key into TROPIC01's pairing key slot 0-3
+ * @warning The pairing keys reside in I-Memory, which has narrower operating temperature range (-20 °C to 85 °C) than
+ * the rest of TROPIC01. New CPU firmware versions (v2.0.0 and newer) return error when the operation is unsuccessful,
+ * but with older firmwares the operation fails silently. If you use CPU firmware older than v2.0.0, make sure to
+ * manually check whether the pairing key was correctly written if operating outside this range. Refer to datasheet for
+ * absolute maximum ratings.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param pairing_pub 32B of pubkey
+ * @param slot        Pairing key lot SH0PUB - SH3PUB
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pairing_key_write(lt_handle_t *h, const uint8_t *pairing_pub, const uint8_t slot);
+
+/**
+ * @brief Reads pairing public key from TROPIC01's pairing key slot 0-3
+ * @note With LT_PAIRING_PUB_CACHE, slots read once in the Secure Session are answered from the cache in the handle
+ * without an L3 Command, the cache follows `lt_pairing_key_write()` and `lt_pairing_key_invalidate()`.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param pairing_pub 32B of pubkey
+ * @param slot        Pairing key lot SH0PUB - SH3PUB
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pairing_key_read(lt_handle_t *h, uint8_t *pairing_pub, const uint8_t slot);
+
+/**
+ * @brief Invalidates pairing key in slot 0-3
+ * @warning The pairing keys reside in I-Memory, which has narrower operating temperature range (-20 °C to 85 °C) than
+ * the rest of TROPIC01. New CPU firmware versions (v2.0.0 and newer) return error when the operation is unsuccessful,
+ * but with older firmwares the operation fails silently. If you use CPU firmware older than v2.0.0, make sure to
+ * manually check whether the pairing key was correctly invalidated if operating outside this range. Refer to datasheet
+ * for absolute maximum ratings.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param slot        Pairing key lot SH0PUB - SH3PUB
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_pairing_key_invalidate(lt_handle_t *h, const uint8_t slot);
+
+#ifdef LT_PAIRING_PUB_CACHE
+/**
+ * @brief Forgets pairing public keys cached in the handle, e.g. when the slots were changed through the separate API.
+ * The next `lt_pairing_key_read()` of each slot is sent to TROPIC01 again.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_pairing_pub_cache_invalidate(lt_handle_t *h);
+#endif
+
+#ifdef LT_CMD_CONFIG
+/**
+ * @brief Writes configuration object specified by `addr`. Make sure to read the Configuration Objects Application Note
+ * (ODN_TR01_app_006) to see how to handle the R-config before proceeding.
+ *
+ * @warning Writing R-config before erasing it first can brick the TROPIC01 chip. Refer to Erratum
+ * OI_TR01_ERR_2026010800: R-Config write triggers permanent Alarm Mode.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param addr        Address of a config object
+ * @param obj         Content to be written
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t addr, const uint32_t obj);
+
+/**
+ * @brief Reads configuration object specified by `addr`. Make sure to read the Configuration Objects Application Note
+ * (ODN_TR01_app_006) to see how to handle the R-config before proceeding.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param addr        Address of a config object
+ * @param obj         Variable to read content into
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ *
+ */
+lt_ret_t lt_r_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr, uint32_t *obj);
+
+/**
+ * @brief Erases all configuration objects. Make sure to read the Configuration Objects Application Note
+ * (ODN_TR01_app_006) to see how to handle the R-config before proceeding.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_config_erase(lt_handle_t *h);
+
+/**
+ * @brief Writes configuration object specified by `addr` to I-Config
+ * @warning The I-Config resides in I-Memory, which has narrower operating temperature range (-20 °C to 85 °C) than
+ * the rest of TROPIC01. New CPU firmware versions (v2.0.0 and newer) return error when the operation is unsuccessful,
+ * but with older firmwares the operation fails silently. If you use CPU firmware older than v2.0.0, make sure to
+ * manually check whether the I-Config was correctly written if operating outside this range. Refer to datasheet for
+ * absolute maximum ratings.
+ * @note With LT_I_CONFIG_CACHE, the bit is cleared in the cached object as well, and bits already cleared in the
+ * cache are not written again.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param addr        Address of a config object
+ * @param bit_index   Index of bit to write from 1 to 0
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_i_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t addr, const uint8_t bit_index);
+
+/**
+ * @brief Reads configuration object specified by `addr` from I-Config
+ * @note With LT_I_CONFIG_CACHE, objects read once are answered from the cache in the handle without an L3 Command.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param addr        Address of a config object
+ * @param obj         Variable to read content into
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_i_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr, uint32_t *obj);
+#endif
+
+#ifdef LT_I_CONFIG_CACHE
+/**
+ * @brief Forgets the cached I-config, e.g. when it might have been written by another host or through the separate
+ * API (`lt_out__i_config_write()`). The next `lt_i_config_read()` of each object reads it from TROPIC01.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_i_config_cache_invalidate(lt_handle_t *h);
+#endif
+
+#ifdef LT_CMD_R_MEM
+/**
+ * @brief Writes bytes into a given slot of the User Partition in the R memory
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param udata_slot  Memory's slot to be written
+ * @param data        Buffer of data to be written into R MEMORY slot
+ * @param data_size   Size of data to be written (valid range given by macros `TR01_R_MEM_DATA_SIZE_MIN` and
+ * `TR01_R_MEM_DATA_SIZE_MAX`)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, const uint8_t *data, const uint16_t data_size);
+
+/**
+ * @brief Reads bytes from a given slot of the User Partition in the R memory
+ *
+ * @param h                Handle for communication with TROPIC01
+ * @param udata_slot       Memory's slot to be read
+ * @param data             Buffer to read data into
+ * @param data_max_size    Size of the data buffer
+ * @param data_read_size   Number of bytes read into data buffer
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot, uint8_t *data, const uint16_t data_max_size,
+                            uint16_t *data_read_size);
+
+/**
+ * @brief Erases the given slot of the User Partition in the R memory
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param udata_slot  Memory's slot to be erased
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot);
+#endif
+
+#ifdef LT_R_MEM_MAP
+/**
+ * @brief Attaches occupancy map of R-mem user data slots to the handle, call it after `lt_init()`.
+ * @details While attached, `lt_r_mem_data_write()`, `lt_r_mem_data_read()` and `lt_r_mem_data_erase()` (and the same
+ * operations of `lt_submit()`) keep the map up to date, so allocators can look up occupancy instead of probing slots.
+ * In every Secure Session, the map is taken from its summary in R-mem by `lt_r_mem_map_load()` if the summary is
+ * current, otherwise the slots are probed by `lt_r_mem_map_scan_step()`, e.g. as a `LT_SCHED_PRIO_BULK` job, and
+ * the summary is written again by `lt_r_mem_map_flush()`.
+ *
+ * The summary is current only if its stamp equals the value of the monotonic counter, which is decremented before
+ * the first change of R-mem after the summary was written. The summary slot and the counter are reserved for the
+ * map and the counter must have been set by `lt_mcounter_init()`. All hosts changing R-mem must use the map, changes
+ * made through the separate API (`lt_out__r_mem_data_*()`) are not seen.
+ *
+ * @param m               Occupancy map
+ * @param h               Handle for communication with TROPIC01
+ * @param summary_slot    R-mem slot holding the summary, 0-`TR01_R_MEM_DATA_SLOT_MAX`
+ * @param mcounter_index  Monotonic counter versioning the summary
+ *
+ * @retval                LT_OK Function executed successfully
+ * @retval                LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_r_mem_map_attach(lt_r_mem_map_t *m, lt_handle_t *h, const uint16_t summary_slot,
+                             const enum lt_mcounter_index_t mcounter_index);
+
+/**
+ * @brief Detaches the occupancy map from its handle, R-mem operations no longer update it.
+ *
+ * @param m           Occupancy map
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_r_mem_map_detach(lt_r_mem_map_t *m);
+
+/**
+ * @brief Reads the summary and the monotonic counter; if the summary is current, occupancy of all slots is known.
+ * Otherwise the slots not known yet are left to `lt_r_mem_map_scan_step()`.
+ *
+ * @param m           Occupancy map
+ *
+ * @retval            LT_OK Function executed successfully, whether or not the summary was current
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_mem_map_load(lt_r_mem_map_t *m);
+
+/**
+ * @brief Step of the background scan of the occupancy map, usable as `lt_sched_fn_t`. The first step of a Secure
+ * Session loads the map by `lt_r_mem_map_load()`, every further step probes one slot of unknown occupancy by
+ * R_Mem_Data_Read, the last step writes the summary by `lt_r_mem_map_flush()`.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param ctx         Occupancy map (lt_r_mem_map_t) attached to h
+ * @param done        Set to false if the scan has further steps
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_mem_map_scan_step(lt_handle_t *h, void *ctx, bool *done);
+
+/**
+ * @brief Writes the summary of the map stamped with the current value of the monotonic counter, if occupancy of
+ * all slots is known and the summary in R-mem is not current.
+ *
+ * @param m           Occupancy map
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Occupancy of some slots is not known yet
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_mem_map_flush(lt_r_mem_map_t *m);
+
+/**
+ * @brief Tells whether the slot holds data, probing the slot by R_Mem_Data_Read if its occupancy is not known.
+ *
+ * @param m           Occupancy map
+ * @param udata_slot  R-mem slot, 0-`TR01_R_MEM_DATA_SLOT_MAX`
+ * @param occupied    Set to true if the slot holds data (the summary slot always does)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_mem_map_is_occupied(lt_r_mem_map_t *m, const uint16_t udata_slot, bool *occupied);
+
+/**
+ * @brief Finds the lowest empty slot starting from first. Slots of unknown occupancy are probed in order, only until
+ * the first empty one.
+ *
+ * @param m           Occupancy map
+ * @param first       Lowest slot to consider
+ * @param udata_slot  Set to the empty slot
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL All slots from first on hold data
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_r_mem_map_find_free(lt_r_mem_map_t *m, const uint16_t first, uint16_t *udata_slot);
+#endif
+
+/**
+ * @brief Gets random bytes from TROPIC01's Random Number Generator.
+ *
+ * @param h                 Handle for communication with TROPIC01
+ * @param rnd_bytes         Buffer for the random bytes
+ * @param rnd_bytes_cnt     Number of random bytes to get (255 bytes is the maximum)
+ *
+ * @retval                  LT_OK Function executed successfully
+ * @retval                  other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt);
+
+#ifdef LT_CMD_ECC
+/**
+ * @brief Generates ECC key in the specified ECC key slot
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param slot        Slot number lt_ecc_slot_t
+ * @param curve       Type of ECC curve. Use L3_ECC_KEY_GENERATE_CURVE_ED25519 or L3_ECC_KEY_GENERATE_CURVE_P256
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve);
+
+/**
+ * @brief Stores ECC key to the specified ECC key slot
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param slot        Slot number lt_ecc_slot_t
+ * @param curve       Type of ECC curve. Use L3_ECC_KEY_GENERATE_CURVE_ED25519 or L3_ECC_KEY_GENERATE_CURVE_P256
+ * @param key         Key to store (only the first 32 bytes are stored)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_key_store(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve,
+                          const uint8_t *key);
+
+/**
+ * @brief Reads ECC public key corresponding to a private key in the specified ECC key slot.
+ *
+ * @param h              Handle for communication with TROPIC01
+ * @param ecc_slot       Slot number TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param key            Buffer for retrieving a key; length depends on the type of key in the slot (32B for Ed25519,
+ * 64B for P256), according to *curve*
+ * @param key_max_size   Size of the key buffer
+ * @param curve          When the function executes successfully, the type of elliptic curve public key will be written
+ * @param origin         When the function executes successfully, the origin of the public key (generated/stored) will
+ * be written
+ *
+ * @note With LT_ECC_INVENTORY, keys read once in the Secure Session are answered from the inventory in the handle
+ * without an L3 Command.
+ *
+ * @retval               LT_OK Function executed successfully
+ * @retval               other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, uint8_t *key, const uint8_t key_max_size,
+                         lt_ecc_curve_type_t *curve, lt_ecc_key_origin_t *origin);
+
+/**
+ * @brief Erases ECC key from the specified ECC key slot
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param ecc_slot    Slot number TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t ecc_slot);
+
+#ifdef LT_ECC_INVENTORY
+/**
+ * @brief Reads all ECC key slots not known to the inventory yet, so that the following lookups of the Secure Session
+ * are memory operations.
+ * @details Slots are read by `lt_ecc_key_read()`, at most once per Secure Session: afterwards the inventory follows
+ * `lt_ecc_key_generate()`, `lt_ecc_key_store()` and `lt_ecc_key_erase()`, and only slots with a new key are read
+ * again for their public key. Keys changed through the separate API (`lt_out__ecc_key_*()`) or by another host in
+ * a previous Secure Session are not seen until `lt_ecc_inventory_invalidate()` or the next Secure Session.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_inventory_scan(lt_handle_t *h);
+
+/**
+ * @brief Finds the lowest empty ECC key slot, e.g. for the new key of a key rotation.
+ * @details Slots not known to the inventory are read in order, only until the first empty one.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param slot        Set to the empty slot
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL All slots hold a key
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_inventory_find_free(lt_handle_t *h, lt_ecc_slot_t *slot);
+
+/**
+ * @brief Gets occupancy of all ECC key slots, scanning the slots by `lt_ecc_inventory_scan()` first if needed.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param occupied    Bit i is set if slot TR01_ECC_SLOT_0 + i holds a key
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_inventory_get(lt_handle_t *h, uint32_t *occupied);
+
+/**
+ * @brief Forgets the inventory, e.g. when the slots were changed through the separate API. The next lookups read
+ * the slots from TROPIC01 again.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_ecc_inventory_invalidate(lt_handle_t *h);
+#endif
+
+#ifdef LT_ECC_KEY_POOL
+/**
+ * @brief Initializes pool of ECC key slots holding keys generated ahead of time, so that provisioning of a new key
+ * takes no L3 Command.
+ * @details Slots are added by `lt_ecc_key_pool_add()`, keys are generated into them by `lt_ecc_key_pool_refill_step()`
+ * in idle time and handed out by `lt_ecc_key_pool_take()`. Slots of the pool are reserved for it until they are
+ * handed out.
+ *
+ * @param pool        Key pool
+ * @param h           Handle for communication with TROPIC01
+ * @param curve       Curve of the generated keys
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_ecc_key_pool_init(lt_ecc_key_pool_t *pool, lt_handle_t *h, const lt_ecc_curve_type_t curve);
+
+/**
+ * @brief Adds ECC key slot to the pool, e.g. slot of a retired key. The slot is erased before a key is generated into
+ * it, so whatever it holds is never handed out.
+ *
+ * @param pool        Key pool
+ * @param slot        ECC key slot
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Pool holds `LT_ECC_KEY_POOL_SIZE` slots already
+ * @retval            LT_PARAM_ERR Invalid parameters or the slot is in the pool already
+ */
+lt_ret_t lt_ecc_key_pool_add(lt_ecc_key_pool_t *pool, const lt_ecc_slot_t slot);
+
+/**
+ * @brief Step of the refill of the pool, usable as `lt_sched_fn_t`. Every step sends one L3 Command for the first slot
+ * without a ready key: ECC_Key_Erase, ECC_Key_Generate, or ECC_Key_Read of the generated public key.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param ctx         Key pool (lt_ecc_key_pool_t) of h
+ * @param done        Set to false if the refill has further steps
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Slot holds a key not generated by the pool, it is erased by the next step
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_key_pool_refill_step(lt_handle_t *h, void *ctx, bool *done);
+
+/**
+ * @brief Generates keys into all slots of the pool without a ready key, step by step as
+ * `lt_ecc_key_pool_refill_step()`.
+ *
+ * @param pool        Key pool
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_key_pool_refill(lt_ecc_key_pool_t *pool);
+
+/**
+ * @brief Hands out a generated key, the slot leaves the pool and belongs to the caller.
+ * @details A ready key is handed out without an L3 Command. If no key is ready, the oldest slot of the pool is
+ * finished by the remaining refill steps first.
+ *
+ * @param pool             Key pool
+ * @param slot             Set to the ECC key slot of the key
+ * @param pubkey           Buffer for the public key
+ * @param pubkey_max_size  Size of the buffer, at least `TR01_CURVE_P256_PUBKEY_LEN` for P-256 and
+ *                         `TR01_CURVE_ED25519_PUBKEY_LEN` for Ed25519
+ *
+ * @retval                 LT_OK Function executed successfully
+ * @retval                 LT_FAIL Pool holds no slot, or no key was ready and the oldest slot holds a key not
+ *                         generated by the pool
+ * @retval                 LT_PARAM_ERR Invalid parameters or too small buffer, the key stays in the pool
+ * @retval                 other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_ecc_key_pool_take(lt_ecc_key_pool_t *pool, lt_ecc_slot_t *slot, uint8_t *pubkey,
+                              const uint8_t pubkey_max_size);
+
+/**
+ * @brief Returns number of keys ready to be handed out.
+ *
+ * @param pool        Key pool
+ * @return            Number of ready keys, 0 if pool is NULL
+ */
+uint8_t lt_ecc_key_pool_ready(const lt_ecc_key_pool_t *pool);
+#endif
+
+/**
+ * @brief Performs ECDSA sign of a message with a private ECC key stored in TROPIC01
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param msg         Buffer containing a message
+ * @param msg_len     Length of the message
+ * @param rs          Buffer for storing a signature in a form of R and S bytes (should always have length 64B)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint32_t msg_len,
+                           uint8_t *rs);
+
+/**
+ * @brief Performs ECDSA sign of a message, whose SHA-256 digest was computed by the caller, with a private ECC key
+ * stored in TROPIC01
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param msg_hash    SHA-256 digest of the message, 32 B
+ * @param rs          Buffer for storing a signature in a form of R and S bytes (should always have length 64B)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_ecdsa_sign_digest(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg_hash, uint8_t *rs);
+
+#ifdef LT_ECDSA_SIGN_STREAM
+/**
+ * @brief Starts ECDSA sign of a message passed part by part by `lt_ecdsa_sign_update()` or `lt_ecdsa_sign_read()`,
+ * the message is hashed as its parts come.
+ *
+ * @note              The message is hashed in the crypto context of the handle, other functions hashing in it (e.g.
+ *                    `lt_session_start()`, `lt_ecc_ecdsa_sign()`) must not be used on the handle until
+ *                    `lt_ecdsa_sign_final()`. On error of any `lt_ecdsa_sign_*()` function the signing is abandoned.
+ *
+ * @param s           Signing context
+ * @param h           Handle for communication with TROPIC01
+ * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecdsa_sign_init(lt_ecdsa_sign_t *s, lt_handle_t *h, const lt_ecc_slot_t ecc_slot);
+
+/**
+ * @brief Hashes next part of the message signed by `lt_ecdsa_sign_init()`.
+ *
+ * @param s           Signing context
+ * @param data        Part of the message
+ * @param len         Length of the part
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecdsa_sign_update(lt_ecdsa_sign_t *s, const uint8_t *data, const size_t len);
+
+/**
+ * @brief Hashes rest of the message signed by `lt_ecdsa_sign_init()`, reading it by the callback until it reports the
+ * end of the message.
+ *
+ * @param s           Signing context
+ * @param reader      Reads the message part by part
+ * @param reader_ctx  Passed to reader
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecdsa_sign_read(lt_ecdsa_sign_t *s, lt_ecdsa_sign_reader_t reader, void *reader_ctx);
+
+/**
+ * @brief Finishes hashing of the message signed by `lt_ecdsa_sign_init()` and signs its digest by TROPIC01.
+ *
+ * @param s           Signing context
+ * @param rs          Buffer for storing a signature in a form of R and S bytes (should always have length 64B)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecdsa_sign_final(lt_ecdsa_sign_t *s, uint8_t *rs);
+
+/**
+ * @brief Signs several messages read by the callback with the same ECC key. Each message is hashed while TROPIC01 signs
+ * the previous one.
+ *
+ * @note              Stops at the first error, signatures of the messages before it are valid.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param reader      Reads the messages part by part, called with reader_ctx of the message being read
+ * @param docs        Messages to sign and buffers for their signatures
+ * @param docs_cnt    Number of messages
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecdsa_sign_batch(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, lt_ecdsa_sign_reader_t reader,
+                             const lt_ecdsa_sign_doc_t *docs, const size_t docs_cnt);
+#endif
+
+/**
+ * @brief Performs EdDSA sign of a message with a private ECC key stored in TROPIC01
+ *
+ * @note With LT_EDDSA_SIG_CACHE, the message is hashed by SHA-256 in the crypto context of the handle and a message
+ * signed already by the same key in the Secure Session is answered from the signature cache in the handle. Signing
+ * through `lt_submit()` and the separate API (`lt_out__ecc_eddsa_sign()`) is not cached.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param msg         Buffer containing a message to sign, max length is 4096B
+ * @param msg_len     Length of the message
+ * @param rs          Buffer for storing a signature in a form of R and S bytes (should always have length 64B)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint16_t msg_len,
+                           uint8_t *rs);
+
+#ifdef LT_EDDSA_SIG_CACHE
+/**
+ * @brief Forgets EdDSA signatures cached in the handle, e.g. when the keys were changed through the separate API.
+ * The next `lt_ecc_eddsa_sign()` of each message is sent to TROPIC01 again.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_eddsa_sig_cache_invalidate(lt_handle_t *h);
+#endif
+#endif
+
+#ifdef LT_EDDSA_SIGN_STREAM
+/**
+ * @brief Starts EdDSA sign of a prehashed message of any length, passed part by part by `lt_eddsa_sign_update()` or
+ * `lt_eddsa_sign_read()`. The message is hashed by SHA-256 on the host as its parts come and TROPIC01 signs the 32 B
+ * digest with Ed25519.
+ *
+ * @note              This is not Ed25519ph of RFC 8032, the signature is a plain Ed25519 signature of SHA-256 of the
+ *                    message, so the verifier must hash the message by SHA-256 and verify the signature of the digest.
+ * @note              The message is hashed in the crypto context of the handle, other functions hashing in it (e.g.
+ *                    `lt_session_start()`, `lt_ecc_ecdsa_sign()`) must not be used on the handle until
+ *                    `lt_eddsa_sign_final()`. On error of any `lt_eddsa_sign_*()` function the signing is abandoned.
+ *
+ * @param s           Signing context
+ * @param h           Handle for communication with TROPIC01
+ * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_eddsa_sign_init(lt_eddsa_sign_t *s, lt_handle_t *h, const lt_ecc_slot_t ecc_slot);
+
+/**
+ * @brief Hashes next part of the message signed by `lt_eddsa_sign_init()`.
+ *
+ * @param s           Signing context
+ * @param data        Part of the message
+ * @param len         Length of the part
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_eddsa_sign_update(lt_eddsa_sign_t *s, const uint8_t *data, const size_t len);
+
+/**
+ * @brief Hashes rest of the message signed by `lt_eddsa_sign_init()`, reading it by the callback until it reports the
+ * end of the message.
+ *
+ * @param s           Signing context
+ * @param reader      Reads the message part by part
+ * @param reader_ctx  Passed to reader
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_eddsa_sign_read(lt_eddsa_sign_t *s, lt_ecdsa_sign_reader_t reader, void *reader_ctx);
+
+/**
+ * @brief Finishes hashing of the message signed by `lt_eddsa_sign_init()` and signs its digest by TROPIC01.
+ *
+ * @param s           Signing context
+ * @param rs          Buffer for storing a signature in a form of R and S bytes (should always have length 64B)
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_eddsa_sign_final(lt_eddsa_sign_t *s, uint8_t *rs);
+#endif
+
+#ifdef LT_CMD_MCOUNTER
+/**
+ * @brief Initializes monotonic counter of a given index
+ *
+ * @param h               Handle for communication with TROPIC01
+ * @param mcounter_index  Index of monotonic counter
+ * @param mcounter_value  Value to set as an initial value (allowed range is 0-`TR01_MCOUNTER_VALUE_MAX`)
+ *
+ * @retval                LT_OK Function executed successfully
+ * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index, const uint32_t mcounter_value);
+
+/**
+ * @brief Updates monotonic counter of a given index
+ *
+ * @param h               Handle for communication with TROPIC01
+ * @param mcounter_index  Index of monotonic counter
+ *
+ * @retval                LT_OK Function executed successfully
+ * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_mcounter_update(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index);
+
+/**
+ * @brief Gets a value of a monotonic counter of a given index
+ *
+ * @param h               Handle for communication with TROPIC01
+ * @param mcounter_index  Index of monotonic counter
+ * @param mcounter_value  Value of monotonic counter (from range 0-`TR01_MCOUNTER_VALUE_MAX`)
+ *
+ * @retval                LT_OK Function executed successfully
+ * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index, uint32_t *mcounter_value);
+#endif
+
+#ifdef LT_MCOUNTER_CACHE
+/**
+ * @brief Opens monotonic counter with the value cached on the host. Nothing is sent to TROPIC01.
+ * @details The value is read once per Secure Session and then kept up to date by `lt_mcounter_consume()` and
+ *          `lt_mcounter_set()`. This is safe because nobody else can access the counter while the Secure Session is
+ *          on and the counter can only move down. The counter must not be changed by `lt_mcounter_update()` or
+ *          `lt_mcounter_init()` while it is open, otherwise call `lt_mcounter_invalidate()`.
+ *
+ * @param c               Monotonic counter
+ * @param h               Handle for communication with TROPIC01
+ * @param mcounter_index  Index of monotonic counter
+ *
+ * @retval                LT_OK Function executed successfully
+ * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_mcounter_open(lt_mcounter_t *c, lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index);
+
+/**
+ * @brief Sets the counter by `lt_mcounter_init()` and caches the value.
+ *
+ * @param c               Monotonic counter
+ * @param mcounter_value  Value to set (allowed range is 0-`TR01_MCOUNTER_VALUE_MAX`)
+ *
+ * @retval                LT_OK Function executed successfully
+ * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_mcounter_set(lt_mcounter_t *c, const uint32_t mcounter_value);
+
+/**
+ * @brief Gets the value of the counter, it is read from TROPIC01 only if it is not cached for the current Secure
+ * Session.
+ * @details As the value only goes down, it can serve as a version stamp (e.g. of a directory in R-Memory) which costs
+ *          no round-trip to check: consume one unit per new version and compare the values.
+ *
+ * @param c               Monotonic counter
+ * @param mcounter_value  Value of monotonic counter (from range 0-`TR01_MCOUNTER_VALUE_MAX`)
+ *
+ * @retval                LT_OK Function executed successfully
+ * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_mcounter_value(lt_mcounter_t *c, uint32_t *mcounter_value);
+
+/**
+ * @brief Decrements the counter by n, the Mcounter_Update commands are sent back-to-back.
+ * @details Nothing is consumed if the counter holds less than n units. If a command fails, the cached value is dropped
+ *          and the counter is read again by the next call.
+ *
+ * @param c               Monotonic counter
+ * @param n               Number of units to consume
+ * @param mcounter_value  Value after the update is returned here, NULL if not needed
+ *
+ * @retval                LT_OK Function executed successfully
+ * @retval                LT_FAIL Counter holds less than n units
+ * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_mcounter_consume(lt_mcounter_t *c, const uint32_t n, uint32_t *mcounter_value);
+
+/**
+ * @brief Drops the cached value, the next `lt_mcounter_value()` or `lt_mcounter_consume()` reads it from TROPIC01.
+ *
+ * @param c  Monotonic counter
+ *
+ * @retval   LT_OK Function executed successfully
+ * @retval   other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding of
+ * returned value
+ */
+lt_ret_t lt_mcounter_invalidate(lt_mcounter_t *c);
+#endif
+
+#ifdef LT_CMD_MAC_DESTROY
+/**
+ * @brief Executes the MAC-and-Destroy sequence.
+ * @details This command is just a part of MAC And Destroy sequence, which takes place between the host and TROPIC01.
+ *          Example code can be found in examples/lt_ex_macandd.c, for more info about Mac And Destroy functionality,
+ * read the Application note.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param slot        Mac-and-Destroy slot index, valid values are 0-127
+ * @param data_out    Data to be sent from host to TROPIC01
+ * @param data_in     Data returned from TROPIC01 to host
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_mac_and_destroy(lt_handle_t *h, const lt_mac_and_destroy_slot_t slot, const uint8_t *data_out,
+                            uint8_t *data_in);
+#endif
+
+#ifdef LT_PIN
+/**
+ * @brief Initializes PIN verification engine based on MAC-and-Destroy, as described in the Application note
+ * (ODN_TR01_app_002_pin_verif). Nothing is sent to TROPIC01.
+ *
+ * @param p             PIN engine
+ * @param h             Handle for communication with TROPIC01
+ * @param macandd_slot  First Mac-and-Destroy slot, slots macandd_slot to macandd_slot + rounds - 1 are used
+ * @param rounds        Number of PIN attempts, 1 - `LT_PIN_ROUNDS_MAX`
+ * @param r_mem_slot    User Data slot of R-Memory for the attempt counter and the encrypted secret
+ *
+ * @retval              LT_OK Function executed successfully
+ * @retval              other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_pin_init(lt_pin_t *p, lt_handle_t *h, const lt_mac_and_destroy_slot_t macandd_slot, const uint8_t rounds,
+                     const uint16_t r_mem_slot);
+
+/**
+ * @brief Sets up a new PIN: initializes all Mac-and-Destroy slots of the engine, stores the encrypted secret into
+ * R-Memory and releases the key derived from master_secret.
+ * @details The Mac-and-Destroy commands are sent back-to-back and the host-side KDF of each slot is computed while
+ *          TROPIC01 executes the last command of the slot. The key stays cached in the engine until the Secure Session
+ *          ends or `lt_pin_lock()` is called.
+ *
+ * @param p              PIN engine
+ * @param master_secret  32 B of random data, determines the key
+ * @param pin            PIN, `LT_PIN_LEN_MIN` - `LT_PIN_LEN_MAX` bytes
+ * @param pin_len        Length of the PIN
+ * @param add            Additional data mixed into the PIN (e.g. HW ID), NULL if none
+ * @param add_len        Length of the additional data, max `LT_PIN_ADD_LEN_MAX`
+ * @param key            Buffer for the released key, `LT_PIN_KEY_LEN` bytes
+ *
+ * @retval               LT_OK Function executed successfully
+ * @retval               other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_pin_setup(lt_pin_t *p, const uint8_t *master_secret, const uint8_t *pin, const uint8_t pin_len,
+                      const uint8_t *add, const uint8_t add_len, uint8_t *key);
+
+/**
+ * @brief Verifies the PIN and releases the key set up by `lt_pin_setup()`. Each wrong PIN destroys one attempt, correct
+ * PIN restores all of them.
+ * @details If the key was already released in the current Secure Session for the same PIN and additional data, it is
+ *          returned from the engine without any communication and no attempt is consumed. Wrong PIN drops the cached
+ *          key and is verified by TROPIC01.
+ *
+ * @param p              PIN engine
+ * @param pin            PIN, `LT_PIN_LEN_MIN` - `LT_PIN_LEN_MAX` bytes
+ * @param pin_len        Length of the PIN
+ * @param add            Additional data mixed into the PIN (e.g. HW ID), NULL if none
+ * @param add_len        Length of the additional data, max `LT_PIN_ADD_LEN_MAX`
+ * @param key            Buffer for the released key, `LT_PIN_KEY_LEN` bytes
+ *
+ * @retval               LT_OK PIN is correct, key was released
+ * @retval               LT_FAIL PIN is wrong or no attempts remain
+ * @retval               other Function did not execute successully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_pin_verify(lt_pin_t *p, const uint8_t *pin, const uint8_t pin_len, const uint8_t *add,
+                       const uint8_t add_len, uint8_t *key);
+
+/**
+ * @brief Drops the key cached by the engine, next `lt_pin_verify()` is verified by TROPIC01.
+ *
+ * @param p  PIN engine
+ *
+ * @retval   LT_OK Function executed successfully
+ * @retval   other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding of
+ * returned value
+ */
+lt_ret_t lt_pin_lock(lt_pin_t *p);
+#endif
+
+#ifdef LT_SUBMIT
+/**
+ * @brief Sends L3 Command of the operation to TROPIC01 and returns without waiting for its result, so the host can do
+ * other work (e.g. hash the next message) while TROPIC01 executes it. Finish the operation with `lt_complete()`.
+ *
+ * @note              Only one operation can be submitted on the handle at a time, nothing else may be sent through
+ *                    the handle until it is completed. The operation is checked in the same way as by the matching
+ *                    libtropic function, e.g. `lt_ping()` for `LT_CMD_PING`.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cmd         Operation with its arguments, has to stay valid until `lt_complete()` returns
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Another operation is already submitted on the handle
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_submit(lt_handle_t *h, lt_cmd_t *cmd);
+
+/**
+ * @brief Waits for the result of the operation submitted by `lt_submit()` and decodes it into output buffers of the
+ * operation.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cmd         The completed operation is returned here, also when its result is an error
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR No operation is submitted on the handle
+ * @retval            other Result of the operation as returned by the matching libtropic function, you might use
+ * lt_ret_verbose() to get verbose encoding of returned value
+ */
+lt_ret_t lt_complete(lt_handle_t *h, lt_cmd_t **cmd);
+
+#ifdef LT_L2_ASYNC
+/**
+ * @brief Submits the operation as `lt_submit()` does, but sends only the first L2 chunk of the L3 Command. The rest
+ * of the command and the L3 Result are transferred by `lt_complete_async()`, which never waits for TROPIC01, so
+ * an event loop can drive several devices. The C++ coroutine layer in libtropic.hpp is built on it.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param cmd         Operation with its arguments, has to stay valid until `lt_complete_async()` finishes it
+ * @param op          Asynchronous L2 operation of the device, must not be busy
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Another operation is already submitted on the handle, or op is busy
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_submit_async(lt_handle_t *h, lt_cmd_t *cmd, struct lt_l2_async_t *op);
+
+/**
+ * @brief Advances the operation submitted by `lt_submit_async()` by at most one L2 frame, as `lt_l2_async_process()`
+ * does, and decodes its result once it is received.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param op          Asynchronous L2 operation passed to `lt_submit_async()`
+ * @param cmd         The finished operation is returned here, also when its result is an error
+ *
+ * @retval            LT_L1_CHIP_BUSY Operation is still in progress, cmd is not set
+ * @retval            LT_PARAM_ERR No operation is submitted on the handle
+ * @retval            other Result of the operation as returned by `lt_complete()`, you might use lt_ret_verbose() to
+ * get verbose encoding of returned value
+ */
+lt_ret_t lt_complete_async(lt_handle_t *h, struct lt_l2_async_t *op, lt_cmd_t **cmd);
+#endif
+#endif
+
+#ifdef LT_BULK_ERASE
+/**
+ * @brief Selects R-mem user data slots first-last for `lt_bulk_erase()`.
+ *
+ * @param set         Slots of the bulk erase, zero it before the first selection
+ * @param first       First slot, 0-`TR01_R_MEM_DATA_SLOT_MAX`
+ * @param last        Last slot, first-`TR01_R_MEM_DATA_SLOT_MAX`
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_bulk_erase_add_r_mem(lt_bulk_erase_set_t *set, const uint16_t first, const uint16_t last);
+
+/**
+ * @brief Selects ECC key slots first-last for `lt_bulk_erase()`.
+ *
+ * @param set         Slots of the bulk erase, zero it before the first selection
+ * @param first       First slot
+ * @param last        Last slot, first-`TR01_ECC_SLOT_31`
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_bulk_erase_add_ecc(lt_bulk_erase_set_t *set, const lt_ecc_slot_t first, const lt_ecc_slot_t last);
+
+/**
+ * @brief Selects pairing key slots first-last for `lt_bulk_erase()`.
+ *
+ * @param set         Slots of the bulk erase, zero it before the first selection
+ * @param first       First slot, 0-3
+ * @param last        Last slot, first-3
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_bulk_erase_add_pairing(lt_bulk_erase_set_t *set, const uint8_t first, const uint8_t last);
+
+/**
+ * @brief Erases the selected slots back-to-back in the Secure Session, e.g. to wipe a workspace or to decommission
+ * TROPIC01: R-mem user data slots, then ECC key slots, then pairing key slots are invalidated.
+ * @details Each erase is sent by `lt_submit()` as soon as the previous one completes, bookkeeping and the progress
+ * callback of a slot run while TROPIC01 erases the next one. Slots known to be empty are skipped without an L3
+ * Command: R-mem slots by the attached occupancy map (`LT_R_MEM_MAP`), ECC key slots by the inventory
+ * (`LT_ECC_INVENTORY`) and invalidated pairing key slots by the cache (`LT_PAIRING_PUB_CACHE`). Slots which TROPIC01
+ * refuses to erase (e.g. `LT_L3_UNAUTHORIZED` by the UAP configuration) stay selected and the erase goes on; other
+ * errors end it.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param set         Slots to erase, slots handled are cleared from it
+ * @param progress    Reports each erased slot, may be NULL
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK All selected slots were erased
+ * @retval            LT_FAIL Another operation is submitted on the handle
+ * @retval            other First error of a slot or the error which ended the erase, you might use lt_ret_verbose()
+ * to get verbose encoding of returned value
+ */
+lt_ret_t lt_bulk_erase(lt_handle_t *h, lt_bulk_erase_set_t *set, lt_bulk_erase_progress_t progress, void *cb_ctx);
+#endif
+
+#ifdef LT_PROVISION
+/**
+ * @brief Initializes provisioning station bringing several TROPIC01 devices to one profile.
+ *
+ * @note              Each device is driven by its own state machine: its pairing key slots, R-config, I-config and
+ *                    profile ECC key slots are read first, then only what differs from the profile is written
+ *                    (R-config is erased only if a changed object is not erased, I-config bits are cleared one by
+ *                    one) and everything written is read back and compared. L3 Commands are sent through
+ *                    asynchronous L3 operations (`lt_submit_async()`), interleaved across the devices, so while one
+ *                    TROPIC01 writes its NVM, the commands of the others are sent and their results received. All of
+ *                    it runs in the thread calling `lt_provision_process()`, devices may share one SPI bus.
+ *
+ * @param p           Provisioning station
+ * @param profile     Profile of all devices, it is not copied and has to stay valid until all devices finish
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters or invalid ECC keys of the profile
+ */
+lt_ret_t lt_provision_init(lt_provision_t *p, const lt_provision_profile_t *profile);
+
+/**
+ * @brief Adds TROPIC01 device to the provisioning station.
+ *
+ * @note              Secure Session has to be started with the device (e.g. by `LT_BRINGUP`). Until the device
+ *                    finishes, the handle and the operation must not be used by anything else. A device which failed
+ *                    may be added again, only what still differs from the profile is written.
+ *
+ * @param p           Provisioning station
+ * @param h           Handle for communication with TROPIC01
+ * @param op          Asynchronous L2 operation of the device, must not be busy
+ * @param pubkeys     Public keys of the profile ECC keys are written here, `LT_PROVISION_PUBKEY_LEN` bytes per key
+ *                    in order of the profile, may be NULL
+ * @param cb          Called when provisioning of the device finishes, may be NULL
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ * @retval            LT_HOST_NO_SESSION Secure Session is not started with the device
+ * @retval            LT_FAIL Station already has `LT_PROVISION_MAX_DEVICES` devices, or an operation is submitted on
+ *                    the handle
+ */
+lt_ret_t lt_provision_add_device(lt_provision_t *p, lt_handle_t *h, struct lt_l2_async_t *op, uint8_t *pubkeys,
+                                 lt_provision_cb_t cb, void *cb_ctx);
+
+/**
+ * @brief Advances provisioning of all devices, never waits for TROPIC01.
+ * @details Each device makes at most one L2 frame attempt, the next L3 Command of a device is sent right after its
+ * previous one completes. Callbacks of finished devices are called from here.
+ *
+ * @param p           Provisioning station
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Invalid parameters
+ */
+lt_ret_t lt_provision_process(lt_provision_t *p);
+
+/**
+ * @brief Provisions all devices, i.e. calls `lt_provision_process()` until no device is pending, with 1 ms delays
+ * when no device made progress.
+ *
+ * @param p           Provisioning station
+ *
+ * @retval            LT_OK Function executed successfully, results of the devices are given by `lt_provision_result()`
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_provision_run(lt_provision_t *p);
+
+/**
+ * @brief Returns number of devices whose provisioning has not finished yet.
+ *
+ * @param p           Provisioning station
+ * @return            Number of devices, 0 if the station is NULL
+ */
+uint8_t lt_provision_pending(const lt_provision_t *p);
+
+/**
+ * @brief Returns result of provisioning of the device.
+ *
+ * @param p           Provisioning station
+ * @param idx         Index of the device, in order of `lt_provision_add_device()` calls
+ * @param sent        Number of L3 Commands sent to the device, may be NULL
+ * @param skipped     Number of configuration objects, pairing keys and ECC keys which were already as in the profile,
+ *                    may be NULL
+ *
+ * @retval            LT_OK The device matches the profile, verified by readback
+ * @retval            LT_L1_CHIP_BUSY Provisioning of the device has not finished yet
+ * @retval            LT_PARAM_ERR The device does not exist
+ * @retval            LT_FAIL The device holds a pairing key, ECC key or I-config bit which cannot be changed to the
+ *                    profile, or readback differs from the profile
+ * @retval            other Provisioning of the device failed with this error
+ */
+lt_ret_t lt_provision_result(const lt_provision_t *p, const uint8_t idx, uint16_t *sent, uint16_t *skipped);
+#endif
+
+/** @} */  // end of libtropic_API group
+
+#ifdef LT_L3_CMD_LATENCY
+/**
+ * @brief Overrides the built-in table of expected L3 command latencies.
+ * @details Before polling for the result of an L3 command, the host sleeps for the latency of that command, which
+ * saves SPI transfers. Commands not found in the passed table fall back to the built-in values. The table is not
+ * copied, so it has to stay valid while the handle is used. `lt_init()` resets the handle to the built-in table, so
+ * call this function after it.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param tbl         Table of L3 command latencies, NULL to use only the built-in table
+ * @param tbl_cnt     Number of entries in the table
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_set_l3_cmd_latency_table(lt_handle_t *h, const lt_l3_cmd_latency_t *tbl, const uint8_t tbl_cnt);
+
+#endif
+
+#ifdef LT_L2_STATS
+/**
+ * @brief Gets counters of L2 error recovery (Resend_Req attempts), e.g. to monitor quality of the SPI bus.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param stats       Counters are copied here
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_get_l2_stats(const lt_handle_t *h, lt_l2_stats_t *stats);
+
+/**
+ * @brief Sets all counters of L2 error recovery to zero.
+ *
+ * @param h           Handle for communication with TROPIC01
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_reset_l2_stats(lt_handle_t *h);
+
+#endif
+
+#ifdef LT_LINK_TUNE
+/**
+ * @brief Finds the fastest reliable SPI clock of the board by Ping round-trips of stress patterns.
+ * @details Clocks are tried from the slowest. At each of them, `pings` messages of `ping_len` bytes are pinged and
+ * their echo compared, the clock passes if the echoes match and no CRC error is counted. Ramping stops at the
+ * first clock which does not pass and the fastest passing clock is kept. From then on, the clock is lowered by one
+ * step whenever `LT_LINK_TUNE_MAX_ERRORS` CRC errors are counted within `LT_LINK_TUNE_WINDOW` L2 Response frames.
+ *
+ * If a ping failed, the Secure Session is aborted, as its nonces may be out of sync. Start it again, possibly at the
+ * kept clock, before sending further L3 Commands.
+ *
+ * @param h           Handle for communication with TROPIC01, with Secure Session started
+ * @param speeds_hz   SPI clocks in Hz in ascending order, has to stay valid until lt_link_tune() is called again or
+ *                    lt_deinit()
+ * @param speed_cnt   Number of clocks in speeds_hz
+ * @param pings       Number of pings at each clock
+ * @param ping_len    Length of one ping message, 1 to LT_LINK_TUNE_PING_LEN_MAX
+ *
+ * @retval            LT_OK Function executed successfully, at least the slowest clock passed
+ * @retval            LT_L2_CRC_ERR CRC errors at the slowest clock, it is set anyway
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_link_tune(lt_handle_t *h, const uint32_t *speeds_hz, const uint8_t speed_cnt, const uint8_t pings,
+                      const uint16_t ping_len);
+
+/**
+ * @brief Gets the current SPI clock and the counters of the link quality since lt_link_tune().
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param info        Link quality is copied here
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_get_link_info(const lt_handle_t *h, lt_link_info_t *info);
+#endif
+
+#ifdef LT_TRACE
+/**
+ * @brief Sets trace hooks, which are called at the start and at the end of L1, L2 and CAL phases (SPI transfers,
+ * waiting for TROPIC01, CRC, AES-GCM, see lt_trace_phase_t) with a timestamp from lt_port_time_us().
+ * @details Phases nest, e.g. LT_TRACE_L1_SPI and LT_TRACE_L1_WAIT are reported also inside LT_TRACE_L1_READ. The
+ * table is not copied, so it has to stay valid while the handle is used. Hooks are called in the middle of the
+ * communication with TROPIC01, so they should only record the event and return quickly.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param hooks       Table of trace hooks, NULL to stop tracing
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_set_trace_hooks(lt_handle_t *h, const lt_trace_hooks_t *hooks);
+
+#endif
+
+#ifdef LT_TRACE_EXPORT
+/**
+ * @brief Initializes trace exporter, which records phases reported to its trace hooks into the events.
+ * @details Set `exp->hooks` to the handle by lt_set_trace_hooks(), then export the recorded phases, possibly of more
+ * exporters (devices) at once, by lt_trace_export_json(). Once the events are full, further ones are dropped.
+ *
+ * @param exp         Trace exporter
+ * @param events      Buffer for the recorded events, two per traced phase
+ * @param size        Number of events the buffer holds
+ * @param tid         Thread ID of the exported events, distinct for each exporter exported together
+ * @param name        Name of the thread, e.g. of the device, NULL for none. It is not copied.
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_trace_export_init(lt_trace_export_t *exp, lt_trace_event_t *events, const uint32_t size,
+                              const uint32_t tid, const char *name);
+
+/**
+ * @brief Forgets events recorded by the trace exporter, e.g. after they were exported.
+ *
+ * @param exp         Trace exporter
+ */
+void lt_trace_export_clear(lt_trace_export_t *exp);
+
+/**
+ * @brief Returns number of events the trace exporter dropped because its events were full.
+ *
+ * @param exp         Trace exporter
+ *
+ * @return            Number of dropped events
+ */
+uint32_t lt_trace_export_dropped(const lt_trace_export_t *exp);
 
 /**
- * @brief A dummy command to check the Secure Channel Session communication by exchanging a message with TROPIC01, whish
- * is echoed through the Secure Channel.
+ * @brief Writes events recorded by trace exporters in the Chrome trace event format (JSON), which can be opened by
+ * Perfetto UI (ui.perfetto.dev) or chrome://tracing.
+ * @details Each exporter is one thread of the trace, its phases are nested slices. Waiting for TROPIC01 while an
+ * encrypted L3 Result is received is exported as "chip compute", so the execution of an L3 command is told apart from
+ * the time spent in the host. Phases left open by events dropped at the end are closed by the last recorded event.
+ * Exporters must not record while they are exported.
  *
- * @param h           Handle for communication with TROPIC01
- * @param msg_out     Ping message going out
- * @param msg_in      Ping message going in
- * @param msg_len     Length of both messages (msg_out and msg_in)
+ * @param exps        Trace exporters
+ * @param cnt         Number of exporters
+ * @param write       Writer of the JSON text, e.g. to a file or a UART
+ * @param write_ctx   Context passed to the writer
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_ping(lt_handle_t *h, const uint8_t *msg_out, uint8_t *msg_in, const uint16_t msg_len);
+lt_ret_t lt_trace_export_json(const lt_trace_export_t *const *exps, const size_t cnt, lt_trace_export_write_t write,
+                              void *write_ctx);
+
+#endif
 
+#ifdef LT_PORT_RECORD
 /**
- * @brief Writes pairing public key into TROPIC01's pairing key slot 0-3
- * @warning The pairing keys reside in I-Memory, which has narrower operating temperature range (-20 °C to 85 °C) than
- * the rest of TROPIC01. New CPU firmware versions (v2.0.0 and newer) return error when the operation is unsuccessful,
- * but with older firmwares the operation fails silently. If you use CPU firmware older than v2.0.0, make sure to
- * manually check whether the pairing key was correctly written if operating outside this range. Refer to datasheet for
- * absolute maximum ratings.
+ * @brief Sets port recorder, which is called after each call of the port (chip select, SPI transfers, delays, random
+ * bytes, see lt_port_rec_type_t) with its arguments, data and duration.
+ * @details Used e.g. by `hal/replay` to record a session with a real TROPIC01 and replay it later without the chip.
+ * The recorder is called in the middle of the communication with TROPIC01, its duration is not included in the
+ * recorded durations.
  *
  * @param h           Handle for communication with TROPIC01
- * @param pairing_pub 32B of pubkey
- * @param slot        Pairing key lot SH0PUB - SH3PUB
+ * @param rec         Port recorder, NULL to stop recording
+ * @param ctx         User context passed to the recorder
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_pairing_key_write(lt_handle_t *h, const uint8_t *pairing_pub, const uint8_t slot);
+lt_ret_t lt_set_port_recorder(lt_handle_t *h, lt_port_rec_fn_t rec, void *ctx);
+
+#endif
 
+#ifdef LT_DEADLINE
 /**
- * @brief Reads pairing public key from TROPIC01's pairing key slot 0-3
+ * @brief Sets deadline of the following API calls with the handle, e.g. of one L3 command in a control loop.
+ * @details Until lt_deadline_clear(), delays, CHIP_STATUS polls, Resend_Req recovery and waits for the INT pin which
+ * would end after the deadline are not started and the call returns LT_DEADLINE_EXCEEDED right away, timeouts of SPI
+ * transfers are clipped to the time left (not below LT_L1_TIMEOUT_MS_MIN). A call so returns at the latest one SPI
+ * transfer after the deadline, if the port honors the transfer timeout. When an L3 command returns
+ * LT_DEADLINE_EXCEEDED, its L3 Result may still be pending in TROPIC01, so the Secure Session must be aborted by
+ * lt_session_abort() and started again before the next L3 command, the same as after LT_L1_CHIP_BUSY.
  *
  * @param h           Handle for communication with TROPIC01
- * @param pairing_pub 32B of pubkey
- * @param slot        Pairing key lot SH0PUB - SH3PUB
+ * @param budget_us   Time from now the calls may take [us], has to be nonzero
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_pairing_key_read(lt_handle_t *h, uint8_t *pairing_pub, const uint8_t slot);
+lt_ret_t lt_deadline_set(lt_handle_t *h, const uint32_t budget_us);
 
 /**
- * @brief Invalidates pairing key in slot 0-3
- * @warning The pairing keys reside in I-Memory, which has narrower operating temperature range (-20 °C to 85 °C) than
- * the rest of TROPIC01. New CPU firmware versions (v2.0.0 and newer) return error when the operation is unsuccessful,
- * but with older firmwares the operation fails silently. If you use CPU firmware older than v2.0.0, make sure to
- * manually check whether the pairing key was correctly invalidated if operating outside this range. Refer to datasheet
- * for absolute maximum ratings.
+ * @brief Removes deadline set by lt_deadline_set(), the following API calls are bounded only by the polling and
+ * resend limits of the configuration.
  *
  * @param h           Handle for communication with TROPIC01
- * @param slot        Pairing key lot SH0PUB - SH3PUB
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_pairing_key_invalidate(lt_handle_t *h, const uint8_t slot);
+lt_ret_t lt_deadline_clear(lt_handle_t *h);
 
 /**
- * @brief Writes configuration object specified by `addr`. Make sure to read the Configuration Objects Application Note
- * (ODN_TR01_app_006) to see how to handle the R-config before proceeding.
- *
- * @warning Writing R-config before erasing it first can brick the TROPIC01 chip. Refer to Erratum
- * OI_TR01_ERR_2026010800: R-Config write triggers permanent Alarm Mode.
+ * @brief Returns time left until the deadline set by lt_deadline_set(), e.g. for a scheduler deciding whether to
+ * start another call in the same budget.
  *
  * @param h           Handle for communication with TROPIC01
- * @param addr        Address of a config object
- * @param obj         Content to be written
  *
- * @retval            LT_OK Function executed successfully
- * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
- * of returned value
+ * @return            Time left [us], 0 if the deadline passed, UINT32_MAX if no deadline is set or on invalid handle.
  */
-lt_ret_t lt_r_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t addr, const uint32_t obj);
+uint32_t lt_deadline_left_us(const lt_handle_t *h);
+
+#endif
 
+#ifdef LT_RING
 /**
- * @brief Reads configuration object specified by `addr`. Make sure to read the Configuration Objects Application Note
- * (ODN_TR01_app_006) to see how to handle the R-config before proceeding.
+ * @brief Initializes the multi-producer single-consumer ring over the slots.
+ * @details Items are pointers, e.g. to requests on the stacks of the producers. Any number of threads or tasks may
+ * push at once without a lock, only one of them (e.g. the one owning the device) may pop. Uses the atomic builtins of
+ * the compiler only, so it works the same with FreeRTOS tasks and pthreads; waking up the consumer is left to the
+ * caller.
  *
- * @param h           Handle for communication with TROPIC01
- * @param addr        Address of a config object
- * @param obj         Variable to read content into
+ * @param ring        Ring
+ * @param slots       Slots, have to stay valid while the ring is used
+ * @param cap         Number of slots, a power of two from 2 to 2^31
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
- *
  */
-lt_ret_t lt_r_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr, uint32_t *obj);
+lt_ret_t lt_mpsc_ring_init(lt_mpsc_ring_t *ring, lt_mpsc_slot_t *slots, const uint32_t cap);
 
 /**
- * @brief Erases all configuration objects. Make sure to read the Configuration Objects Application Note
- * (ODN_TR01_app_006) to see how to handle the R-config before proceeding.
+ * @brief Pushes the item to the ring. Safe to call from several threads or tasks at once.
  *
- * @param h           Handle for communication with TROPIC01
+ * @param ring        Initialized ring
+ * @param item        Item, must not be NULL
  *
  * @retval            LT_OK Function executed successfully
+ * @retval            LT_RING_FULL All slots are taken, the producer has to back off and try again
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_r_config_erase(lt_handle_t *h);
+lt_ret_t lt_mpsc_ring_push(lt_mpsc_ring_t *ring, void *item);
 
 /**
- * @brief Writes configuration object specified by `addr` to I-Config
- * @warning The I-Config resides in I-Memory, which has narrower operating temperature range (-20 °C to 85 °C) than
- * the rest of TROPIC01. New CPU firmware versions (v2.0.0 and newer) return error when the operation is unsuccessful,
- * but with older firmwares the operation fails silently. If you use CPU firmware older than v2.0.0, make sure to
- * manually check whether the I-Config was correctly written if operating outside this range. Refer to datasheet for
- * absolute maximum ratings.
+ * @brief Pops the oldest item from the ring. Called by the consumer only.
  *
- * @param h           Handle for communication with TROPIC01
- * @param addr        Address of a config object
- * @param bit_index   Index of bit to write from 1 to 0
+ * @param ring        Initialized ring
  *
- * @retval            LT_OK Function executed successfully
- * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
- * of returned value
+ * @return            Item, NULL if the ring is empty or a producer has not finished its push yet
  */
-lt_ret_t lt_i_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t addr, const uint8_t bit_index);
+void *lt_mpsc_ring_pop(lt_mpsc_ring_t *ring);
 
 /**
- * @brief Reads configuration object specified by `addr` from I-Config
+ * @brief Returns number of items in the ring, including those being pushed. Exact only when called by the consumer
+ * while no producer pushes.
  *
- * @param h           Handle for communication with TROPIC01
- * @param addr        Address of a config object
- * @param obj         Variable to read content into
+ * @param ring        Initialized ring
  *
- * @retval            LT_OK Function executed successfully
- * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
- * of returned value
+ * @return            Number of items
  */
-lt_ret_t lt_i_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr, uint32_t *obj);
+uint32_t lt_mpsc_ring_count(const lt_mpsc_ring_t *ring);
 
 /**
- * @brief Writes bytes into a given slot of the User Partition in the R memory
+ * @brief Initializes the single-producer single-consumer ring over the items.
+ * @details One thread or task pushes (e.g. completions by the one owning the device), one pops. Uses the atomic
+ * builtins of the compiler only, the same as `lt_mpsc_ring_init()`.
  *
- * @param h           Handle for communication with TROPIC01
- * @param udata_slot  Memory's slot to be written
- * @param data        Buffer of data to be written into R MEMORY slot
- * @param data_size   Size of data to be written (valid range given by macros `TR01_R_MEM_DATA_SIZE_MIN` and
- * `TR01_R_MEM_DATA_SIZE_MAX`)
+ * @param ring        Ring
+ * @param items       Items, have to stay valid while the ring is used
+ * @param cap         Number of items, a power of two from 2 to 2^31
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, const uint8_t *data, const uint16_t data_size);
+lt_ret_t lt_spsc_ring_init(lt_spsc_ring_t *ring, void **items, const uint32_t cap);
 
 /**
- * @brief Reads bytes from a given slot of the User Partition in the R memory
+ * @brief Pushes the item to the ring. Called by the producer only.
  *
- * @param h                Handle for communication with TROPIC01
- * @param udata_slot       Memory's slot to be read
- * @param data             Buffer to read data into
- * @param data_max_size    Size of the data buffer
- * @param data_read_size   Number of bytes read into data buffer
+ * @param ring        Initialized ring
+ * @param item        Item, must not be NULL
  *
  * @retval            LT_OK Function executed successfully
+ * @retval            LT_RING_FULL All items are taken, the producer has to back off and try again
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot, uint8_t *data, const uint16_t data_max_size,
-                            uint16_t *data_read_size);
+lt_ret_t lt_spsc_ring_push(lt_spsc_ring_t *ring, void *item);
 
 /**
- * @brief Erases the given slot of the User Partition in the R memory
+ * @brief Pops the oldest item from the ring. Called by the consumer only.
  *
- * @param h           Handle for communication with TROPIC01
- * @param udata_slot  Memory's slot to be erased
+ * @param ring        Initialized ring
  *
- * @retval            LT_OK Function executed successfully
- * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
- * of returned value
+ * @return            Item, NULL if the ring is empty
  */
-lt_ret_t lt_r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot);
+void *lt_spsc_ring_pop(lt_spsc_ring_t *ring);
 
 /**
- * @brief Gets random bytes from TROPIC01's Random Number Generator.
+ * @brief Returns number of items in the ring.
  *
- * @param h                 Handle for communication with TROPIC01
- * @param rnd_bytes         Buffer for the random bytes
- * @param rnd_bytes_cnt     Number of random bytes to get (255 bytes is the maximum)
+ * @param ring        Initialized ring
  *
- * @retval                  LT_OK Function executed successfully
- * @retval                  other Function did not execute successully, you might use lt_ret_verbose() to get verbose
- * encoding of returned value
+ * @return            Number of items
  */
-lt_ret_t lt_random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt);
+uint32_t lt_spsc_ring_count(const lt_spsc_ring_t *ring);
+#endif
 
+#ifdef LT_STATS
 /**
- * @brief Generates ECC key in the specified ECC key slot
+ * @brief Takes a snapshot of runtime statistics of the communication with TROPIC01 (L1 polls, bytes on the wire, CRC
+ * errors, resends, L2 chunks, handshakes, nonces and execution time per L3 Command ID), e.g. to spot degraded SPI
+ * links or to size pools of devices.
+ * @details Statistics are counted from lt_init() on and are kept over lt_deinit() and the next lt_init(), until
+ * lt_reset_stats() is called. The handle has to be zero-initialized before its first lt_init().
  *
  * @param h           Handle for communication with TROPIC01
- * @param slot        Slot number lt_ecc_slot_t
- * @param curve       Type of ECC curve. Use L3_ECC_KEY_GENERATE_CURVE_ED25519 or L3_ECC_KEY_GENERATE_CURVE_P256
+ * @param stats       Snapshot of the statistics is copied here
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve);
+lt_ret_t lt_get_stats(const lt_handle_t *h, lt_stats_t *stats);
 
 /**
- * @brief Stores ECC key to the specified ECC key slot
+ * @brief Sets all runtime statistics to zero.
  *
  * @param h           Handle for communication with TROPIC01
- * @param slot        Slot number lt_ecc_slot_t
- * @param curve       Type of ECC curve. Use L3_ECC_KEY_GENERATE_CURVE_ED25519 or L3_ECC_KEY_GENERATE_CURVE_P256
- * @param key         Key to store (only the first 32 bytes are stored)
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_ecc_key_store(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve,
-                          const uint8_t *key);
+lt_ret_t lt_reset_stats(lt_handle_t *h);
+
+#endif
 
+#ifdef LT_METRICS
 /**
- * @brief Reads ECC public key corresponding to a private key in the specified ECC key slot.
+ * @brief Writes runtime statistics of the devices in the OpenMetrics text format (also read by Prometheus), so they
+ * can be scraped by a textfile collector or served by an HTTP endpoint of the application.
+ * @details Every metric family has a sample per device labelled `device` with its name: counters of L1 polls,
+ * `LT_L1_CHIP_BUSY` reads, SPI bytes, CRC errors, resends, L2 chunks and handshakes, gauges of the nonce and of the
+ * nonces left in the current Secure Session and a histogram `libtropic_l3_cmd_seconds` of the execution time per L3
+ * Command ID (labelled `cmd_id`). Call lt_metrics_write_eof() after the last family.
  *
- * @param h              Handle for communication with TROPIC01
- * @param ecc_slot       Slot number TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
- * @param key            Buffer for retrieving a key; length depends on the type of key in the slot (32B for Ed25519,
- * 64B for P256), according to *curve*
- * @param key_max_size   Size of the key buffer
- * @param curve          When the function executes successfully, the type of elliptic curve public key will be written
- * @param origin         When the function executes successfully, the origin of the public key (generated/stored) will
- * be written
+ * @param devs        Names and snapshots of the statistics (see lt_get_stats()) of the devices
+ * @param cnt         Number of devices
+ * @param write       Writer of the text
+ * @param write_ctx   Context passed to the writer
  *
- * @retval               LT_OK Function executed successfully
- * @retval               other Function did not execute successully, you might use lt_ret_verbose() to get verbose
- * encoding of returned value
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
  */
-lt_ret_t lt_ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, uint8_t *key, const uint8_t key_max_size,
-                         lt_ecc_curve_type_t *curve, lt_ecc_key_origin_t *origin);
+lt_ret_t lt_metrics_write_stats(const lt_metrics_dev_t *devs, const size_t cnt, lt_metrics_write_t write,
+                                void *write_ctx);
 
+#ifdef LT_POOL
 /**
- * @brief Erases ECC key from the specified ECC key slot
+ * @brief Writes state of the devices of the pool in the OpenMetrics text format: queue depth and health gauges and
+ * counters of operations, quarantines and re-handshakes, labelled `device`.
  *
- * @param h           Handle for communication with TROPIC01
- * @param ecc_slot    Slot number TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
+ * @param pool        Device pool
+ * @param names       Names of the devices in order of `lt_pool_add_device()` calls, NULL to label them by index
+ * @param write       Writer of the text
+ * @param write_ctx   Context passed to the writer
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t ecc_slot);
+lt_ret_t lt_metrics_write_pool(const lt_pool_t *pool, const char *const *names, lt_metrics_write_t write,
+                               void *write_ctx);
+#endif
 
 /**
- * @brief Performs ECDSA sign of a message with a private ECC key stored in TROPIC01
+ * @brief Writes the `# EOF` line, which ends the OpenMetrics exposition.
  *
- * @param h           Handle for communication with TROPIC01
- * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
- * @param msg         Buffer containing a message
- * @param msg_len     Length of the message
- * @param rs          Buffer for storing a signature in a form of R and S bytes (should always have length 64B)
+ * @param write       Writer of the text
+ * @param write_ctx   Context passed to the writer
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint32_t msg_len,
-                           uint8_t *rs);
+lt_ret_t lt_metrics_write_eof(lt_metrics_write_t write, void *write_ctx);
+
+#endif
 
+#ifdef LT_SPI_RECORDER
 /**
- * @brief Performs EdDSA sign of a message with a private ECC key stored in TROPIC01
+ * @brief Initializes SPI recorder, which captures frames exchanged with TROPIC01 into a ring buffer with negligible
+ * overhead (unlike `LT_PRINT_SPI_DATA`), see lt_spi_recorder_t for the format of the records.
+ *
+ * @param rec         SPI recorder
+ * @param buff        Ring buffer, has to stay valid while the recorder is used
+ * @param size        Size of buff, power of two, at least 512 bytes
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_spi_recorder_init(lt_spi_recorder_t *rec, uint8_t *buff, const uint32_t size);
+
+/**
+ * @brief Starts recording of L1 frames of the handle and of L3 Command IDs and RESULTs of its Secure Session.
+ * @warning L3 Command IDs and RESULTs are recorded in plaintext, other contents of L3 packets are recorded encrypted
+ * as they are sent.
  *
  * @param h           Handle for communication with TROPIC01
- * @param ecc_slot    Slot containing a private key, TR01_ECC_SLOT_0 - TR01_ECC_SLOT_31
- * @param msg         Buffer containing a message to sign, max length is 4096B
- * @param msg_len     Length of the message
- * @param rs          Buffer for storing a signature in a form of R and S bytes (should always have length 64B)
+ * @param rec         Initialized SPI recorder, NULL to stop recording
  *
  * @retval            LT_OK Function executed successfully
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint16_t msg_len,
-                           uint8_t *rs);
+lt_ret_t lt_spi_recorder_attach(lt_handle_t *h, lt_spi_recorder_t *rec);
 
 /**
- * @brief Initializes monotonic counter of a given index
+ * @brief Moves recorded data from the ring buffer out, e.g. to a file or a UART, to be decoded by
+ * `scripts/spi_trace_decode.py`.
+ * @details Data are copied as a byte stream, a record may be split between two calls. Only one reader may call this
+ * function at a time, but it may run concurrently with the communication of the handle.
  *
- * @param h               Handle for communication with TROPIC01
- * @param mcounter_index  Index of monotonic counter
- * @param mcounter_value  Value to set as an initial value (allowed range is 0-`TR01_MCOUNTER_VALUE_MAX`)
+ * @param rec         SPI recorder
+ * @param out         Buffer for the data
+ * @param max_len     Size of out
  *
- * @retval                LT_OK Function executed successfully
- * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
- * encoding of returned value
+ * @return            Number of bytes copied to out
  */
-lt_ret_t lt_mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index, const uint32_t mcounter_value);
+uint32_t lt_spi_recorder_read(lt_spi_recorder_t *rec, uint8_t *out, const uint32_t max_len);
 
 /**
- * @brief Updates monotonic counter of a given index
+ * @brief Returns number of records dropped because the ring buffer was full.
  *
- * @param h               Handle for communication with TROPIC01
- * @param mcounter_index  Index of monotonic counter
+ * @param rec         SPI recorder
  *
- * @retval                LT_OK Function executed successfully
- * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
- * encoding of returned value
+ * @return            Number of dropped records
  */
-lt_ret_t lt_mcounter_update(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index);
+uint32_t lt_spi_recorder_dropped(const lt_spi_recorder_t *rec);
+
+#endif
 
+#ifdef LT_ED25519_VERIFY
 /**
- * @brief Gets a value of a monotonic counter of a given index
+ * @brief Verifies many Ed25519 signatures on the host at once, e.g. signatures made by `lt_ecc_eddsa_sign()` collected
+ * by an audit or attestation service. Implemented by the CAL, needs no handle.
+ * @details CALs based on curve25519-donna (Trezor crypto, STM32, MbedTLS v4, ESP32) check the signatures together by
+ * one multi-scalar multiplication, signatures of the same public key share a single point. Only if the whole group
+ * does not verify, the signatures are checked one by one to tell which are not valid. They check the cofactored
+ * equation of RFC 8032, OpenSSL and WolfCrypt CALs verify signature by signature with the public key decoded once
+ * for adjacent items and check the equation of the provider; the results differ only for signatures crafted with
+ * points of small order.
  *
- * @param h               Handle for communication with TROPIC01
- * @param mcounter_index  Index of monotonic counter
- * @param mcounter_value  Value of monotonic counter (from range 0-`TR01_MCOUNTER_VALUE_MAX`)
+ * @param items       Signatures to check, `valid` of every item is set
+ * @param count       Number of items
  *
- * @retval                LT_OK Function executed successfully
- * @retval                other Function did not execute successully, you might use lt_ret_verbose() to get verbose
- * encoding of returned value
+ * @retval            LT_OK All signatures are valid
+ * @retval            LT_SIGNATURE_INVALID At least one signature is not valid, see `valid` of items
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
  */
-lt_ret_t lt_mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index, uint32_t *mcounter_value);
+lt_ret_t lt_ed25519_verify_batch(lt_ed25519_verify_t *items, const size_t count);
+
+#endif
 
+#ifdef LT_CRYPTO_OPS
 /**
- * @brief Executes the MAC-and-Destroy sequence.
- * @details This command is just a part of MAC And Destroy sequence, which takes place between the host and TROPIC01.
- *          Example code can be found in examples/lt_ex_macandd.c, for more info about Mac And Destroy functionality,
- * read the Application note.
+ * @brief Selects the CAL used by the handle, whose `crypto_ctx` points to `c`. Has to be called before `lt_init()`.
+ * @details CAL functions which take no context (X25519, one-shot HMAC-SHA256 and `lt_ed25519_verify_batch()`) are
+ * dispatched to one CAL for the whole process, which is the first one selected by `lt_crypto_ops_set_global()`,
+ * `lt_crypto_ops_set()` or `lt_crypto_ops_probe()` and is never changed afterwards. Their results do not depend on
+ * the CAL, so handles may use different CALs.
  *
- * @param h           Handle for communication with TROPIC01
- * @param slot        Mac-and-Destroy slot index, valid values are 0-127
- * @param data_out    Data to be sent from host to TROPIC01
- * @param data_in     Data returned from TROPIC01 to host
+ * @param c           Crypto context of the handle
+ * @param ops         Functions of the CAL, e.g. `&lt_crypto_ops_openssl`
+ * @param ctx         Context of the CAL, e.g. `lt_ctx_openssl_t`
  *
  * @retval            LT_OK Function executed successfully
+ * @retval            LT_PARAM_ERR Parameter is NULL or the CAL does not implement streaming AES-GCM required by
+ * `LT_L3_STREAM_ENCRYPT` or `LT_L3_STREAM_DECRYPT`
  * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
  * of returned value
  */
-lt_ret_t lt_mac_and_destroy(lt_handle_t *h, const lt_mac_and_destroy_slot_t slot, const uint8_t *data_out,
-                            uint8_t *data_in);
+lt_ret_t lt_crypto_ops_set(lt_crypto_ops_ctx_t *c, const lt_crypto_ops_t *ops, void *ctx);
 
-/** @} */  // end of libtropic_API group
+/**
+ * @brief Selects the CAL serving CAL functions which take no context (X25519, one-shot HMAC-SHA256 and
+ * `lt_ed25519_verify_batch()`) in the whole process. Call it once at startup before the handles are set up, otherwise
+ * the first CAL selected for a handle by `lt_crypto_ops_set()` or `lt_crypto_ops_probe()` is used.
+ *
+ * @param ops         Functions of the CAL, e.g. `&lt_crypto_ops_openssl`
+ *
+ * @retval            LT_OK Function executed successfully, also if the same CAL is already selected
+ * @retval            LT_PARAM_ERR Parameter is NULL or the CAL does not implement streaming AES-GCM required by
+ * `LT_L3_STREAM_ENCRYPT` or `LT_L3_STREAM_DECRYPT`
+ * @retval            LT_FAIL Different CAL is already selected for the process
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_crypto_ops_set_global(const lt_crypto_ops_t *ops);
+
+/**
+ * @brief Checks every candidate CAL by known answers and measures it by crypto operations of a Secure Session
+ * handshake and a few L3 Commands, then selects the fastest working one by `lt_crypto_ops_set()`. Has to be called
+ * before `lt_init()`, typically once at startup.
+ * @details Candidate which fails (e.g. hardware engine not available) or which does not implement streaming AES-GCM
+ * required by the configuration gets `probe_us` 0 and is skipped. Of equally
+ * fast candidates the first one is selected. Duration is measured by `lt_port_time_us()`.
+ *
+ * @param c           Crypto context of the handle
+ * @param backends    Candidate CALs, `probe_us` of every candidate is set
+ * @param count       Number of candidates
+ *
+ * @retval            LT_OK Working candidate was selected
+ * @retval            LT_CRYPTO_ERR None of the candidates works
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_crypto_ops_probe(lt_crypto_ops_ctx_t *c, lt_crypto_backend_t *backends, const size_t count);
+#endif
 
 #ifdef LT_HELPERS
 /**
@@ -648,6 +3878,7 @@ extern struct lt_config_obj_desc_t cfg_desc_table[LT_CONFIG_OBJ_CNT];
  */
 const char *lt_ret_verbose(lt_ret_t ret);
 
+#ifdef LT_CMD_CONFIG
 /**
  * @brief Writes the whole R-Config with the passed `config`. Make sure to read the Configuration Objects Application
  * Note (ODN_TR01_app_006) to see how to handle the R-config before proceeding.
@@ -677,6 +3908,28 @@ lt_ret_t lt_write_whole_R_config(lt_handle_t *h, const struct lt_config_t *confi
  */
 lt_ret_t lt_read_whole_R_config(lt_handle_t *h, struct lt_config_t *config);
 
+/**
+ * @brief Brings the R-Config to the passed `config` with as few L3 Commands as possible. Make sure to read the
+ * Configuration Objects Application Note (ODN_TR01_app_006) to see how to handle the R-config before proceeding.
+ * @details Objects which already hold the requested value are skipped. If all changed objects are erased, only they
+ * are written. Otherwise the R-Config is erased once (`lt_r_config_erase()`) and only the objects not to stay erased
+ * (0xFFFFFFFF) are written, so no object is ever written before it is erased.
+ *
+ * @warning `current` must hold the actual R-Config of this TROPIC01 (e.g. from `lt_read_whole_R_config()` or a
+ * previous call of this function), otherwise not erased objects may be written. Refer to Erratum
+ * OI_TR01_ERR_2026010800: R-Config write triggers permanent Alarm Mode.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param config      Requested R-Config
+ * @param current     Current R-Config, updated with every executed erase and write (also when the function fails).
+ *                    If NULL, the R-Config is read from TROPIC01 first.
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ * of returned value
+ */
+lt_ret_t lt_apply_R_config(lt_handle_t *h, const struct lt_config_t *config, struct lt_config_t *current);
+
 /**
  * @brief Reads all of the I-Config objects into `config`.
  *
@@ -706,6 +3959,7 @@ lt_ret_t lt_read_whole_I_config(lt_handle_t *h, struct lt_config_t *config);
  * of returned value
  */
 lt_ret_t lt_write_whole_I_config(lt_handle_t *h, const struct lt_config_t *config);
+#endif
 
 /**
  * @brief Establishes a secure channel between host MCU and TROPIC01
@@ -766,6 +4020,7 @@ lt_ret_t lt_print_chip_id(const struct lt_chip_id_t *chip_id, int (*print_func)(
  */
 lt_ret_t lt_print_fw_header(lt_handle_t *h, const lt_bank_id_t bank_id, int (*print_func)(const char *format, ...));
 
+#ifdef LT_CMD_FW_UPDATE
 /**
  * @brief Performs mutable firmware update on ABAB and ACAB silicon revisions.
  *
@@ -780,6 +4035,58 @@ lt_ret_t lt_print_fw_header(lt_handle_t *h, const lt_bank_id_t bank_id, int (*pr
 lt_ret_t lt_do_mutable_fw_update(lt_handle_t *h, const uint8_t *update_data, const uint16_t update_data_size,
                                  const lt_bank_id_t bank_id);
 
+/**
+ * @brief Performs mutable firmware update on ABAB and ACAB silicon revisions, reading the update image in parts.
+ * @details Same as lt_do_mutable_fw_update(), but the image does not have to be in memory. The reader is called for
+ * every part of the image, which is read right to the L2 buffer and sent to TROPIC01, so only one L2 frame of the image
+ * is held in RAM at a time (images can be read e.g. from a file, external flash or network).
+ *
+ * For ACAB, every data chunk is verified against the SHA-256 hash announced by the update request (first chunk) or by
+ * the previous chunk before it is sent, and the last chunk has to announce no further chunk. A corrupted or truncated
+ * image is therefore detected before the corrupted chunk reaches TROPIC01. ABAB images carry no hashes, they are only
+ * streamed.
+ *
+ * @note For ACAB, SHA-256 context of the CAL in h->l3.crypto_ctx is used.
+ *
+ * @param h                 Handle for communication with TROPIC01
+ * @param reader            Function reading the next part of the image
+ * @param reader_ctx        Context passed to the reader (e.g. file handle)
+ * @param update_data_size  Total size of the image
+ * @param bank_id           Bank ID where the update should be applied, valid values are
+ *                             For ABAB: TR01_FW_BANK_FW1, TR01_FW_BANK_FW2, TR01_FW_BANK_SPECT1, TR01_FW_BANK_SPECT2
+ *                             For ACAB: Parameter is ignored, chip is handling firmware banks on its own
+ * @retval                  LT_OK Function executed successfully
+ * @retval                  LT_FW_UPDATE_HASH_ERR Chunk of the image does not match its announced hash (ACAB only)
+ * @retval                  other Function did not execute successfully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_do_mutable_fw_update_stream(lt_handle_t *h, lt_fw_update_reader_t reader, void *reader_ctx,
+                                        const uint32_t update_data_size, const lt_bank_id_t bank_id);
+
+/**
+ * @brief Performs mutable firmware update on ABAB and ACAB silicon revisions with chunks supplied one at a time.
+ * @details The feeder returns the chunks in the `[len][data]` format of the update data, so the whole size of the image
+ * does not have to be known and the image does not have to be contiguous in memory, only the current chunk is needed.
+ * For ACAB, the first chunk is the update request (its length byte is included) and the other ones are data chunks
+ * as they are in `*_signed_chunks.bin`. For ABAB, data of the chunks (up to 128 B each) are written one after
+ * another to the erased bank. Chunks are not verified on the host, see lt_do_mutable_fw_update_stream() for that.
+ *
+ * @param h                 Handle for communication with TROPIC01
+ * @param feeder            Function supplying the next chunk
+ * @param feeder_ctx        Context passed to the feeder
+ * @param bank_id           Bank ID where the update should be applied, valid values are
+ *                             For ABAB: TR01_FW_BANK_FW1, TR01_FW_BANK_FW2, TR01_FW_BANK_SPECT1, TR01_FW_BANK_SPECT2
+ *                             For ACAB: Parameter is ignored, chip is handling firmware banks on its own
+ * @retval                  LT_OK Function executed successfully
+ * @retval                  LT_PARAM_ERR Invalid parameters, or chunk does not fit into the L2 Request frame or the
+ * bank
+ * @retval                  other Function did not execute successfully, you might use lt_ret_verbose() to get verbose
+ * encoding of returned value
+ */
+lt_ret_t lt_do_mutable_fw_update_feed(lt_handle_t *h, lt_fw_update_feeder_t feeder, void *feeder_ctx,
+                                      const lt_bank_id_t bank_id);
+#endif
+
 /** @} */  // end of libtropic_API_helpers group
 #endif
 
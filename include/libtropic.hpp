@@ -0,0 +1,498 @@
+#ifndef LT_LIBTROPIC_HPP
+#define LT_LIBTROPIC_HPP
+
+/**
+ * @file libtropic.hpp
+ * @brief Header-only C++20 layer of Libtropic: RAII handle and Secure Session with `std::span` based operations, and
+ * coroutine operations over `lt_submit_async()` and `lt_complete_async()`
+ * @details Nothing is allocated on the heap. `lt::handle` and `lt::session` only own the lifetime of the caller's
+ * `lt_handle_t` (`lt_init()`/`lt_deinit()`, `lt_session_start()`/`lt_session_abort()`), they are move-only and the
+ * handle itself never moves, as Libtropic keeps pointers into it. Output data go to caller's buffers passed as spans.
+ *
+ * With `LT_SUBMIT` and `LT_L2_ASYNC`, operations of `lt::device` are awaitables, e.g.
+ * `lt_ret_t ret = co_await dev.ecdsa_sign(slot, msg, rs);`. One `lt::executor` drives all devices from one thread:
+ * call `lt::executor::poll()` from the event loop, e.g. when INT pin of a device signalizes a response (GPIO file
+ * descriptor watched by the reactor) or from a periodic timer. Coroutines awaiting a busy device are queued and served
+ * in order, operations on different devices run at the same time. Buffers passed to an operation have to stay valid
+ * until its co_await returns.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "libtropic.h"
+
+#if defined(LT_SUBMIT) && defined(LT_L2_ASYNC)
+#include <coroutine>
+#include <exception>
+
+#include "libtropic_l2.h"
+#endif
+
+namespace lt {
+
+/** @brief Signature of `lt::handle::ecdsa_sign()` and `lt::handle::eddsa_sign()`. */
+using signature = std::span<uint8_t, TR01_ECDSA_EDDSA_SIGNATURE_LENGTH>;
+
+/**
+ * @brief Owner of the lifetime of caller's `lt_handle_t`: `lt_deinit()` is called on destruction if `init()`
+ * succeeded. Set up the device and CAL context of the handle before `init()`.
+ */
+class handle {
+   public:
+    explicit handle(lt_handle_t &h) noexcept : h_(&h) {}
+    handle(const handle &) = delete;
+    handle &operator=(const handle &) = delete;
+    handle(handle &&other) noexcept : h_(std::exchange(other.h_, nullptr)), on_(std::exchange(other.on_, false)) {}
+    handle &operator=(handle &&other) noexcept
+    {
+        if (this != &other) {
+            deinit();
+            h_ = std::exchange(other.h_, nullptr);
+            on_ = std::exchange(other.on_, false);
+        }
+        return *this;
+    }
+    ~handle() { deinit(); }
+
+    /** @brief Initializes the handle, as `lt_init()` does. Nothing is done if it is already initialized. */
+    lt_ret_t init() noexcept
+    {
+        if (!h_) {
+            return LT_PARAM_ERR;
+        }
+        if (on_) {
+            return LT_OK;
+        }
+        lt_ret_t ret = lt_init(h_);
+        on_ = (ret == LT_OK);
+        return ret;
+    }
+
+    /** @brief Deinitializes the handle, as `lt_deinit()` does. Nothing is done if it is not initialized. */
+    lt_ret_t deinit() noexcept
+    {
+        if (!on_) {
+            return LT_OK;
+        }
+        on_ = false;
+        return lt_deinit(h_);
+    }
+
+    /** @brief Checks whether the handle was initialized and not deinitialized. */
+    bool initialized() const noexcept { return on_; }
+
+    /** @brief The C handle, for functions without a wrapper. */
+    lt_handle_t &raw() noexcept { return *h_; }
+
+    /** @brief Exchanges message with TROPIC01, as `lt_ping()` does. Both spans have to be of the same size. */
+    lt_ret_t ping(std::span<const uint8_t> msg_out, std::span<uint8_t> msg_in) noexcept
+    {
+        if ((msg_out.size() != msg_in.size()) || (msg_out.size() > UINT16_MAX)) {
+            return LT_PARAM_ERR;
+        }
+        return lt_ping(h_, msg_out.data(), msg_in.data(), static_cast<uint16_t>(msg_out.size()));
+    }
+
+    /** @brief Fills the span with TROPIC01 random bytes, as `lt_random_value_get()` does. */
+    lt_ret_t random(std::span<uint8_t> rnd_bytes) noexcept
+    {
+        if (rnd_bytes.size() > UINT16_MAX) {
+            return LT_PARAM_ERR;
+        }
+        return lt_random_value_get(h_, rnd_bytes.data(), static_cast<uint16_t>(rnd_bytes.size()));
+    }
+
+#ifdef LT_CMD_ECC
+    /** @brief Signs message with the ECDSA key in the slot, as `lt_ecc_ecdsa_sign()` does. */
+    lt_ret_t ecdsa_sign(lt_ecc_slot_t slot, std::span<const uint8_t> msg, signature rs) noexcept
+    {
+        if (msg.size() > UINT32_MAX) {
+            return LT_PARAM_ERR;
+        }
+        return lt_ecc_ecdsa_sign(h_, slot, msg.data(), static_cast<uint32_t>(msg.size()), rs.data());
+    }
+
+    /** @brief Signs message with the EdDSA key in the slot, as `lt_ecc_eddsa_sign()` does. */
+    lt_ret_t eddsa_sign(lt_ecc_slot_t slot, std::span<const uint8_t> msg, signature rs) noexcept
+    {
+        if (msg.size() > UINT16_MAX) {
+            return LT_PARAM_ERR;
+        }
+        return lt_ecc_eddsa_sign(h_, slot, msg.data(), static_cast<uint16_t>(msg.size()), rs.data());
+    }
+
+    /** @brief Reads public key of the slot into the span, as `lt_ecc_key_read()` does. */
+    lt_ret_t ecc_key_read(lt_ecc_slot_t slot, std::span<uint8_t> key, lt_ecc_curve_type_t &curve,
+                          lt_ecc_key_origin_t &origin) noexcept
+    {
+        if (key.size() > UINT8_MAX) {
+            return LT_PARAM_ERR;
+        }
+        return lt_ecc_key_read(h_, slot, key.data(), static_cast<uint8_t>(key.size()), &curve, &origin);
+    }
+#endif
+
+#ifdef LT_CMD_R_MEM
+    /** @brief Writes the span into User Data slot of R-Memory, as `lt_r_mem_data_write()` does. */
+    lt_ret_t r_mem_write(uint16_t udata_slot, std::span<const uint8_t> data) noexcept
+    {
+        if (data.size() > UINT16_MAX) {
+            return LT_PARAM_ERR;
+        }
+        return lt_r_mem_data_write(h_, udata_slot, data.data(), static_cast<uint16_t>(data.size()));
+    }
+
+    /**
+     * @brief Reads User Data slot of R-Memory into the span, as `lt_r_mem_data_read()` does.
+     *
+     * @param udata_slot  User Data slot
+     * @param data        Buffer for the data
+     * @param read        Set to the part of data holding the read bytes
+     */
+    lt_ret_t r_mem_read(uint16_t udata_slot, std::span<uint8_t> data, std::span<uint8_t> &read) noexcept
+    {
+        uint16_t read_size = 0;
+        lt_ret_t ret = lt_r_mem_data_read(h_, udata_slot, data.data(),
+                                          static_cast<uint16_t>(data.size() > UINT16_MAX ? UINT16_MAX : data.size()),
+                                          &read_size);
+        read = data.first(ret == LT_OK ? read_size : 0);
+        return ret;
+    }
+
+    /** @brief Erases User Data slot of R-Memory, as `lt_r_mem_data_erase()` does. */
+    lt_ret_t r_mem_erase(uint16_t udata_slot) noexcept { return lt_r_mem_data_erase(h_, udata_slot); }
+#endif
+
+   private:
+    lt_handle_t *h_;
+    bool on_ = false;
+};
+
+/**
+ * @brief Secure Session of a handle, aborted when the object is destroyed. The handshake itself is blocking, as for
+ * `lt_session_start()`, it is done once per session.
+ */
+class session {
+   public:
+    explicit session(lt_handle_t &h) noexcept : h_(&h) {}
+    explicit session(handle &h) noexcept : h_(&h.raw()) {}
+    session(const session &) = delete;
+    session &operator=(const session &) = delete;
+    session(session &&other) noexcept : h_(std::exchange(other.h_, nullptr)), on_(std::exchange(other.on_, false)) {}
+    session &operator=(session &&other) noexcept
+    {
+        if (this != &other) {
+            end();
+            h_ = std::exchange(other.h_, nullptr);
+            on_ = std::exchange(other.on_, false);
+        }
+        return *this;
+    }
+    ~session() { end(); }
+
+    /** @brief Starts Secure Session, as `lt_session_start()` does. A session started before is aborted first. */
+    lt_ret_t start(std::span<const uint8_t, TR01_STPUB_LEN> stpub, lt_pkey_index_t pkey_index,
+                   std::span<const uint8_t, TR01_SHIPRIV_LEN> shipriv,
+                   std::span<const uint8_t, TR01_SHIPUB_LEN> shipub) noexcept
+    {
+        if (!h_) {
+            return LT_PARAM_ERR;
+        }
+        end();
+        lt_ret_t ret = lt_session_start(h_, stpub.data(), pkey_index, shipriv.data(), shipub.data());
+        on_ = (ret == LT_OK);
+        return ret;
+    }
+
+    /** @brief Aborts the Secure Session, as `lt_session_abort()` does. Nothing is done if it is not started. */
+    lt_ret_t end() noexcept
+    {
+        if (!on_) {
+            return LT_OK;
+        }
+        on_ = false;
+        return lt_session_abort(h_);
+    }
+
+    /** @brief Checks whether the session was started and not ended. */
+    bool active() const noexcept { return on_; }
+
+   private:
+    lt_handle_t *h_;
+    bool on_ = false;
+};
+
+#if defined(LT_SUBMIT) && defined(LT_L2_ASYNC)
+class device;
+
+/**
+ * @brief Detached coroutine started right away and destroyed when it finishes, e.g. one per request served by the
+ * application. Any coroutine type can await the operations, this one is for code without its own.
+ */
+struct task {
+    struct promise_type {
+        task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/** @brief Awaitable L3 operation of a device, `co_await` returns its `lt_ret_t`. */
+class operation {
+   public:
+    operation(device &dev, const lt_cmd_t &cmd) noexcept : dev_(dev), cmd_(cmd) {}
+    /** @brief Operation refused before submission, `co_await` returns ret without suspending. */
+    operation(device &dev, lt_ret_t ret) noexcept : dev_(dev), cmd_{}, ret_(ret), refused_(true) {}
+    operation(const operation &) = delete;
+    operation &operator=(const operation &) = delete;
+
+    bool await_ready() const noexcept { return refused_; }
+    inline bool await_suspend(std::coroutine_handle<> caller) noexcept;
+    lt_ret_t await_resume() const noexcept { return ret_; }
+
+   private:
+    friend class device;
+
+    device &dev_;
+    lt_cmd_t cmd_;
+    std::coroutine_handle<> caller_;
+    lt_ret_t ret_ = LT_FAIL;
+    bool refused_ = false;
+    /** Next operation waiting for the device. */
+    operation *next_ = nullptr;
+};
+
+/**
+ * @brief Executor of operations of several devices on one thread. Not thread-safe, devices and coroutines using them
+ * have to live on the thread calling `poll()`.
+ */
+class executor {
+   public:
+    executor() noexcept = default;
+    executor(const executor &) = delete;
+    executor &operator=(const executor &) = delete;
+
+    /**
+     * @brief Advances operations of all devices by at most one L2 frame each, never waits for TROPIC01. Coroutines of
+     * finished operations are resumed from here.
+     *
+     * @return Number of operations still in progress
+     */
+    inline std::size_t poll() noexcept;
+
+    /** @brief Calls `poll()` until no operation is in progress, for code without an event loop. */
+    void run() noexcept
+    {
+        while (poll()) {
+        }
+    }
+
+   private:
+    friend class device;
+
+    device *devices_ = nullptr;
+};
+
+/**
+ * @brief TROPIC01 with an initialized handle, driven by an executor. Neither copyable nor movable, the executor and
+ * operations in flight point to it. Destroy it only when no coroutine awaits its operations.
+ */
+class device {
+   public:
+    device(executor &ex, lt_handle_t &h) noexcept : ex_(ex), h_(h)
+    {
+        next_ = ex_.devices_;
+        ex_.devices_ = this;
+    }
+    device(executor &ex, handle &h) noexcept : device(ex, h.raw()) {}
+    device(const device &) = delete;
+    device &operator=(const device &) = delete;
+
+    ~device()
+    {
+        // Operation in flight is abandoned, TROPIC01 may still hold its result.
+        if (cur_) {
+            lt_l2_async_cancel(&op_);
+            h_.l3.submitted = nullptr;
+        }
+        for (device **d = &ex_.devices_; *d; d = &(*d)->next_) {
+            if (*d == this) {
+                *d = next_;
+                break;
+            }
+        }
+    }
+
+    /** @brief Handle of the device. */
+    lt_handle_t &raw() noexcept { return h_; }
+
+    /** @brief Exchanges message with TROPIC01, as `lt_ping()` does. Both spans have to be of the same size. */
+    operation ping(std::span<const uint8_t> msg_out, std::span<uint8_t> msg_in) noexcept
+    {
+        if ((msg_out.size() != msg_in.size()) || (msg_out.size() > UINT16_MAX)) {
+            return operation(*this, LT_PARAM_ERR);
+        }
+        lt_cmd_t cmd{};
+        cmd.type = LT_CMD_PING;
+        cmd.args.ping.msg_out = msg_out.data();
+        cmd.args.ping.msg_in = msg_in.data();
+        cmd.args.ping.msg_len = static_cast<uint16_t>(msg_out.size());
+        return operation(*this, cmd);
+    }
+
+    /** @brief Fills the span with TROPIC01 random bytes, as `lt_random_value_get()` does. */
+    operation random(std::span<uint8_t> rnd_bytes) noexcept
+    {
+        if (rnd_bytes.size() > UINT16_MAX) {
+            return operation(*this, LT_PARAM_ERR);
+        }
+        lt_cmd_t cmd{};
+        cmd.type = LT_CMD_RANDOM_VALUE_GET;
+        cmd.args.random_value_get.rnd_bytes = rnd_bytes.data();
+        cmd.args.random_value_get.rnd_bytes_cnt = static_cast<uint16_t>(rnd_bytes.size());
+        return operation(*this, cmd);
+    }
+
+    /** @brief Signs message with the ECDSA key in the slot, as `lt_ecc_ecdsa_sign()` does. */
+    operation ecdsa_sign(lt_ecc_slot_t slot, std::span<const uint8_t> msg, signature rs) noexcept
+    {
+        if (msg.size() > UINT32_MAX) {
+            return operation(*this, LT_PARAM_ERR);
+        }
+        lt_cmd_t cmd{};
+        cmd.type = LT_CMD_ECC_ECDSA_SIGN;
+        cmd.args.ecc_ecdsa_sign.slot = slot;
+        cmd.args.ecc_ecdsa_sign.msg = msg.data();
+        cmd.args.ecc_ecdsa_sign.msg_len = static_cast<uint32_t>(msg.size());
+        cmd.args.ecc_ecdsa_sign.rs = rs.data();
+        return operation(*this, cmd);
+    }
+
+    /** @brief Signs message with the EdDSA key in the slot, as `lt_ecc_eddsa_sign()` does. */
+    operation eddsa_sign(lt_ecc_slot_t slot, std::span<const uint8_t> msg, signature rs) noexcept
+    {
+        if (msg.size() > UINT16_MAX) {
+            return operation(*this, LT_PARAM_ERR);
+        }
+        lt_cmd_t cmd{};
+        cmd.type = LT_CMD_ECC_EDDSA_SIGN;
+        cmd.args.ecc_eddsa_sign.slot = slot;
+        cmd.args.ecc_eddsa_sign.msg = msg.data();
+        cmd.args.ecc_eddsa_sign.msg_len = static_cast<uint16_t>(msg.size());
+        cmd.args.ecc_eddsa_sign.rs = rs.data();
+        return operation(*this, cmd);
+    }
+
+    /** @brief Runs any L3 operation of `lt_submit()`, the arguments are copied. */
+    operation submit(const lt_cmd_t &cmd) noexcept { return operation(*this, cmd); }
+
+   private:
+    friend class operation;
+    friend class executor;
+
+    /** Starts the waiting operations in order until one is submitted, the refused ones are resumed with the error. */
+    void start_next() noexcept
+    {
+        while (head_) {
+            operation *o = head_;
+            head_ = o->next_;
+            if (!head_) {
+                tail_ = nullptr;
+            }
+            o->ret_ = lt_submit_async(&h_, &o->cmd_, &op_);
+            if (o->ret_ == LT_OK) {
+                cur_ = o;
+                return;
+            }
+            o->caller_.resume();
+        }
+    }
+
+    /** Advances the operation in flight, true while it is in progress. */
+    bool advance() noexcept
+    {
+        if (!cur_) {
+            return false;
+        }
+
+        lt_cmd_t *done;
+        lt_ret_t ret = lt_complete_async(&h_, &op_, &done);
+        if (ret == LT_L1_CHIP_BUSY) {
+            return true;
+        }
+
+        // The awaitable lives in the frame of the resumed coroutine, it is not touched after the resume.
+        operation *o = cur_;
+        cur_ = nullptr;
+        o->ret_ = ret;
+        std::coroutine_handle<> caller = o->caller_;
+        start_next();
+        const bool busy = (cur_ != nullptr);
+        caller.resume();
+
+        return busy;
+    }
+
+    executor &ex_;
+    lt_handle_t &h_;
+    lt_l2_async_t op_{};
+    /** Operation in flight. */
+    operation *cur_ = nullptr;
+    /** Operations waiting for the device, in order of co_await. */
+    operation *head_ = nullptr;
+    operation *tail_ = nullptr;
+    /** Next device of the executor. */
+    device *next_ = nullptr;
+};
+
+bool operation::await_suspend(std::coroutine_handle<> caller) noexcept
+{
+    caller_ = caller;
+    if (dev_.cur_ || dev_.head_) {
+        if (dev_.tail_) {
+            dev_.tail_->next_ = this;
+        }
+        else {
+            dev_.head_ = this;
+        }
+        dev_.tail_ = this;
+        return true;
+    }
+
+    ret_ = lt_submit_async(&dev_.h_, &cmd_, &dev_.op_);
+    if (ret_ != LT_OK) {
+        // Refused right away, e.g. without Secure Session, the caller goes on without suspending.
+        return false;
+    }
+    dev_.cur_ = this;
+
+    return true;
+}
+
+std::size_t executor::poll() noexcept
+{
+    std::size_t busy = 0;
+    for (device *d = devices_; d;) {
+        // A resumed coroutine may destroy its device, take the next one first.
+        device *next = d->next_;
+        if (d->advance()) {
+            busy++;
+        }
+        d = next;
+    }
+
+    return busy;
+}
+#endif
+
+}  // namespace lt
+
+#endif  // LT_LIBTROPIC_HPP
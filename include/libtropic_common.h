@@ -9,6 +9,7 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "libtropic_macros.h"
@@ -205,16 +206,427 @@ typedef enum lt_tr01_mode_t {
 } lt_tr01_mode_t;
 
 //--------------------------------------------------------------------------------------------------------------------//
+#ifdef LT_L1_ADAPTIVE_POLL
+/**
+ * Number of L2 request kinds, for which the adaptive poll scheduler learns the Response latency, one more slot is
+ * for the start-up of TROPIC01 after reboot (LT_REBOOT_POLL).
+ */
+#define LT_L1_POLL_LEARN_SLOTS 8
+
+/**
+ * @brief State of the adaptive CHIP_STATUS poll scheduler (used internally).
+ */
+typedef struct lt_l1_poll_state_t {
+    /** @private @brief Learned Response latency in ms for each kind of L2 Request, 0 if not learned yet. */
+    uint16_t expected_ms[LT_L1_POLL_LEARN_SLOTS];
+    /** @private @brief Time in ms already spent waiting for the current Response. */
+    uint16_t waited_ms;
+    /** @private @brief Index of the learn slot of the last L2 Request sent. */
+    uint8_t slot;
+    /** @private @brief Number of delays already scheduled for the current Response. */
+    uint8_t attempt;
+} lt_l1_poll_state_t;
+#endif
+
+#ifdef LT_L2_STATS
+/**
+ * @brief Counters of L2 error recovery, see lt_get_l2_stats().
+ */
+typedef struct lt_l2_stats_t {
+    /** @brief Number of received L2 Response frames, which triggered error recovery. */
+    uint32_t rx_errors;
+    /** @brief Number of Resend_Req L2 Requests sent. */
+    uint32_t resends;
+    /** @brief Number of L2 Response frames recovered by resending. */
+    uint32_t recovered;
+    /** @brief Number of L2 Response frames not recovered after all resend attempts. */
+    uint32_t unrecovered;
+} lt_l2_stats_t;
+#endif
+
+#ifdef LT_LINK_TUNE
+#ifndef LT_LINK_TUNE_PING_LEN_MAX
+/** Maximal length of one Ping message sent by lt_link_tune(), both directions are buffered on the stack. */
+#define LT_LINK_TUNE_PING_LEN_MAX 256
+#endif
+
+/**
+ * @brief Quality of the SPI link tuned by lt_link_tune(), see lt_get_link_info().
+ */
+typedef struct lt_link_info_t {
+    /** @brief Current SPI clock in Hz, 0 if lt_link_tune() did not succeed yet. */
+    uint32_t speed_hz;
+    /**
+     * @brief Number of received L2 Response frames with invalid CRC and of L2 Requests TROPIC01 received with invalid
+     * CRC since lt_link_tune().
+     */
+    uint32_t errors;
+    /** @brief Number of times the SPI clock was lowered because of too many errors since lt_link_tune(). */
+    uint32_t downshifts;
+} lt_link_info_t;
+
+/**
+ * @brief State of the SPI link tuning, see lt_link_tune().
+ */
+typedef struct lt_link_tune_state_t {
+    /** @private @brief SPI clocks in Hz in ascending order, NULL if lt_link_tune() did not succeed yet. */
+    const uint32_t *speeds_hz;
+    /** @private @brief Index of the current SPI clock in speeds_hz. */
+    uint8_t speed_idx;
+    /** @private @brief Set by lt_link_tune() while it ramps up the clock, the clock is not lowered meanwhile. */
+    bool tuning;
+    /** @private @brief Number of frames checked in the current window. */
+    uint16_t window_frames;
+    /** @private @brief Number of errors in the current window. */
+    uint16_t window_errors;
+    /** @private @brief Errors and downshifts since lt_link_tune(). */
+    lt_link_info_t info;
+} lt_link_tune_state_t;
+#endif
+
+#ifdef LT_TRACE
+/**
+ * @brief Phases reported to trace hooks, see lt_set_trace_hooks().
+ */
+typedef enum lt_trace_phase_t {
+    /** @brief SPI transfer (lt_port_spi_transfer(), lt_port_spi_transfer_v()). */
+    LT_TRACE_L1_SPI,
+    /** @brief Delay, e.g. between polls of CHIP_STATUS (lt_port_delay(), lt_port_delay_on_int()). */
+    LT_TRACE_L1_WAIT,
+    /** @brief Reading of one L2 Response frame, including polling while TROPIC01 computes it. */
+    LT_TRACE_L1_READ,
+    /** @brief Calculation or check of CRC of an L2 frame. */
+    LT_TRACE_L2_CRC,
+    /** @brief Sending of an encrypted L3 Command in L2 chunks. */
+    LT_TRACE_L2_ENC_CMD,
+    /** @brief Receiving of an encrypted L3 Result in L2 chunks, including waiting for TROPIC01 to execute the
+     * command. */
+    LT_TRACE_L2_ENC_RES,
+    /** @brief AES-GCM encryption of an L3 Command by the CAL. */
+    LT_TRACE_CAL_ENCRYPT,
+    /** @brief AES-GCM decryption of an L3 Result by the CAL. */
+    LT_TRACE_CAL_DECRYPT,
+} lt_trace_phase_t;
+
+/**
+ * @brief Trace hook, called at the start or at the end of a phase.
+ *
+ * @param ctx         User context from lt_trace_hooks_t
+ * @param phase       Phase which starts or ends
+ * @param time_us     Timestamp from lt_port_time_us()
+ */
+typedef void (*lt_trace_hook_t)(void *ctx, lt_trace_phase_t phase, uint64_t time_us);
+
+/**
+ * @brief Table of trace hooks, see lt_set_trace_hooks().
+ */
+typedef struct lt_trace_hooks_t {
+    /** @brief Called at the start of each phase, may be NULL. */
+    lt_trace_hook_t start;
+    /** @brief Called at the end of each phase, may be NULL. */
+    lt_trace_hook_t end;
+    /** @brief User context passed to the hooks. */
+    void *ctx;
+} lt_trace_hooks_t;
+#endif
+
+#ifdef LT_STATS
+#ifndef LT_STATS_L3_CMDS
+/** @brief Number of distinct L3 Command IDs, whose execution time is accumulated in lt_stats_t. */
+#define LT_STATS_L3_CMDS 16
+#endif
+
+#ifdef LT_METRICS
+/**
+ * @brief Number of latency buckets of each L3 Command ID in lt_stats_l3_cmd_t, their upper bounds are 1, 2, 5, 10,
+ * 20, 50 and 100 ms, the last one takes longer executions.
+ */
+#define LT_METRICS_BUCKETS 8
+#endif
+
+/**
+ * @brief Accumulated execution of one L3 Command ID, see lt_stats_t.
+ */
+typedef struct lt_stats_l3_cmd_t {
+    /** @brief L3 Command ID, valid if count is nonzero. */
+    uint8_t cmd_id;
+    /** @brief Number of L3 Results decrypted for the command. */
+    uint32_t count;
+    /** @brief Cumulative time from encryption of the L3 Command to decryption of its L3 Result in microseconds. */
+    uint64_t time_us;
+#ifdef LT_METRICS
+    /** @brief Number of L3 Results in each latency bucket, see LT_METRICS_BUCKETS (not cumulative). */
+    uint32_t hist[LT_METRICS_BUCKETS];
+#endif
+} lt_stats_l3_cmd_t;
+
+/**
+ * @brief Runtime statistics of the communication with TROPIC01, see lt_get_stats().
+ */
+typedef struct lt_stats_t {
+    /** @brief Number of CHIP_STATUS polls for L2 Response frames. */
+    uint32_t l1_polls;
+    /** @brief Number of L2 Response frame reads which returned LT_L1_CHIP_BUSY. */
+    uint32_t l1_chip_busy;
+    /** @brief Number of bytes clocked over SPI (each of them is sent and received at once). */
+    uint64_t l1_spi_bytes;
+    /** @brief Number of received L2 Response frames with invalid CRC. */
+    uint32_t l2_crc_errors;
+    /** @brief Number of Resend_Req L2 Requests sent. */
+    uint32_t l2_resends;
+    /** @brief Number of L2 chunks of encrypted L3 Commands sent. */
+    uint32_t l2_chunks_tx;
+    /** @brief Number of L2 chunks of encrypted L3 Results received. */
+    uint32_t l2_chunks_rx;
+    /** @brief Number of Secure Sessions established. */
+    uint32_t l3_handshakes;
+    /** @brief Number of handshakes which failed on the host side (e.g. authentication of TROPIC01). */
+    uint32_t l3_handshake_errors;
+    /** @brief Nonce of the current Secure Session, filled in by lt_get_stats(). */
+    uint32_t l3_nonce;
+    /** @brief Highest nonce reached in any Secure Session. */
+    uint32_t l3_nonce_max;
+    /** @brief Number of L3 Results of commands which did not fit into l3_cmds. */
+    uint32_t l3_cmds_untracked;
+    /** @brief Execution time per L3 Command ID, entries are taken in the order the commands are first seen. */
+    lt_stats_l3_cmd_t l3_cmds[LT_STATS_L3_CMDS];
+} lt_stats_t;
+#endif
+
+#ifdef LT_SPI_RECORDER
+/** @brief Size of the header of each record of the SPI recorder, see lt_spi_recorder_t. */
+#define LT_SPI_REC_HDR_SIZE 12
+
+/**
+ * @brief Types of records of the SPI recorder.
+ */
+typedef enum lt_spi_rec_type_t {
+    /** @brief L1 frame sent to TROPIC01 (L2 Request, Get_Response is not recorded). */
+    LT_SPI_REC_MOSI = 0,
+    /** @brief L1 frame received from TROPIC01 (CHIP_STATUS and L2 Response), polls without response are not
+     * recorded. */
+    LT_SPI_REC_MISO = 1,
+    /** @brief L3 Command ID and CMD_SIZE (little endian) of the L3 Command being encrypted. */
+    LT_SPI_REC_L3_CMD = 2,
+    /** @brief RESULT of the decrypted L3 Result. */
+    LT_SPI_REC_L3_RES = 3,
+} lt_spi_rec_type_t;
+
+/**
+ * @brief Lock-free ring buffer of timestamped frames exchanged with TROPIC01, see lt_spi_recorder_init().
+ * @details Records are stored back to back (wrapping around the end of the buffer), each starts with a
+ * LT_SPI_REC_HDR_SIZE bytes long little endian header: type (lt_spi_rec_type_t, 1 B), reserved (1 B), length of the
+ * data (2 B) and timestamp from lt_port_time_us() (8 B), followed by the data. Libtropic is the only writer and one
+ * reader drains the buffer by lt_spi_recorder_read(), possibly from another thread or an interrupt.
+ */
+typedef struct lt_spi_recorder_t {
+    /** @private @brief Ring buffer provided by the user. */
+    uint8_t *buff;
+    /** @private @brief Size of buff, power of two. */
+    uint32_t size;
+    /** @private @brief Free-running end of the published records, advanced by Libtropic. */
+    uint32_t head;
+    /** @private @brief Free-running position of the reader, advanced by lt_spi_recorder_read(). */
+    uint32_t tail;
+    /** @private @brief Free-running write position of the record being written. */
+    uint32_t wr;
+    /** @private @brief Number of records dropped because the buffer was full. */
+    uint32_t dropped;
+} lt_spi_recorder_t;
+#endif
+
+#ifdef LT_CPU_LOG_DRAIN
+/**
+ * @brief Lock-free ring buffer of log messages of TROPIC01's RISC-V FW, see lt_cpu_log_init().
+ * @details Messages are stored back to back as received, without any framing. Libtropic is the only writer (by
+ * lt_cpu_log_drain_step() and by the alarm log of LT_RETRIEVE_ALARM_LOG) and one reader drains the buffer by
+ * lt_cpu_log_read() or lt_cpu_log_print(), possibly from another thread.
+ */
+typedef struct lt_cpu_log_t {
+    /** @private @brief Ring buffer provided by the user. */
+    uint8_t *buff;
+    /** @private @brief Size of buff, power of two. */
+    uint32_t size;
+    /** @private @brief Free-running end of the published messages, advanced by Libtropic. */
+    uint32_t head;
+    /** @private @brief Free-running position of the reader. */
+    uint32_t tail;
+    /** @private @brief Number of messages dropped because the buffer was full. */
+    uint32_t dropped;
+} lt_cpu_log_t;
+#endif
+
+/**
+ * @brief Calls of the port reported to the port recorder, see lt_set_port_recorder().
+ * @note Defined regardless of `LT_PORT_RECORD`, as ports replaying the records (hal/replay/) use it too.
+ */
+typedef enum lt_port_rec_type_t {
+    /** @brief lt_port_init(). */
+    LT_PORT_REC_INIT = 0,
+    /** @brief lt_port_deinit(). */
+    LT_PORT_REC_DEINIT = 1,
+    /** @brief lt_port_spi_csn_low(), also the start of lt_port_spi_transfer_v() with LT_SPI_V_CSN_LOW. */
+    LT_PORT_REC_CSN_LOW = 2,
+    /** @brief lt_port_spi_csn_high(), also the end of lt_port_spi_transfer_v() with LT_SPI_V_CSN_HIGH. */
+    LT_PORT_REC_CSN_HIGH = 3,
+    /** @brief lt_port_spi_transfer(), also one segment of lt_port_spi_transfer_v(). */
+    LT_PORT_REC_TRANSFER = 4,
+    /** @brief lt_port_spi_read_ready(), arg is max_len and rx holds the received frame. */
+    LT_PORT_REC_READ_READY = 5,
+    /** @brief lt_port_delay(), arg is the delay in milliseconds. */
+    LT_PORT_REC_DELAY = 6,
+    /** @brief lt_port_delay_on_int(), arg is the maximal delay in milliseconds. */
+    LT_PORT_REC_DELAY_ON_INT = 7,
+    /** @brief lt_port_random_bytes(), rx holds the random bytes. */
+    LT_PORT_REC_RANDOM = 8,
+    /** @brief lt_port_spi_set_speed(), arg is the SPI clock in Hz. */
+    LT_PORT_REC_SET_SPEED = 9,
+} lt_port_rec_type_t;
+
+/**
+ * @brief One call of the port, see lt_set_port_recorder().
+ * @details Vectored transfers are reported as separate LT_PORT_REC_CSN_LOW, LT_PORT_REC_TRANSFER and
+ * LT_PORT_REC_CSN_HIGH calls, so the record does not depend on whether the port implements
+ * lt_port_spi_transfer_v().
+ */
+typedef struct lt_port_rec_t {
+    /** @brief Recorded call. */
+    lt_port_rec_type_t type;
+    /** @brief Returned value (lt_ret_t, which is defined later). */
+    int ret;
+    /** @brief Argument of the call, see lt_port_rec_type_t. */
+    uint32_t arg;
+    /** @brief Duration of the call in microseconds, measured by lt_port_time_us(). */
+    uint32_t dur_us;
+    /** @brief Bytes sent to TROPIC01 (LT_PORT_REC_TRANSFER only), NULL otherwise. */
+    const uint8_t *tx;
+    /** @brief Bytes received from TROPIC01 or random bytes, NULL if len is 0. */
+    const uint8_t *rx;
+    /** @brief Number of bytes in tx and rx. */
+    uint32_t len;
+    /** @brief Position of the transferred bytes in the L1 frame (LT_PORT_REC_TRANSFER only). */
+    uint8_t offset;
+} lt_port_rec_t;
+
+/**
+ * @brief Port recorder, called after each call of the port.
+ *
+ * @param ctx         User context passed to lt_set_port_recorder()
+ * @param rec         Recorded call, valid only during the call of the recorder
+ */
+typedef void (*lt_port_rec_fn_t)(void *ctx, const lt_port_rec_t *rec);
+
+#ifdef LT_BUFF_ALIGN
+LT_STATIC_ASSERT((LT_BUFF_ALIGN > 0) && ((LT_BUFF_ALIGN & (LT_BUFF_ALIGN - 1)) == 0))
+/** Alignment of buffers transferred by DMA: LT_BUFF_ALIGN, at least 16 B kept by the L3 buffers. */
+#define LT_DMA_BUFF_ALIGN LT_COMPTIME_MAX(LT_BUFF_ALIGN, 16)
+/** Size of a buffer of `n` bytes rounded up to LT_DMA_BUFF_ALIGN, so it does not share a cache line with others. */
+#define LT_DMA_BUFF_SIZE(n) ((((n) + LT_DMA_BUFF_ALIGN - 1u) / LT_DMA_BUFF_ALIGN) * LT_DMA_BUFF_ALIGN)
+/** Alignment of the L2 buffer, which is not aligned at all without LT_BUFF_ALIGN. */
+#define LT_L2_BUFF_ATTR __attribute__((aligned(LT_DMA_BUFF_ALIGN)))
+#else
+#define LT_DMA_BUFF_ALIGN 16
+#define LT_DMA_BUFF_SIZE(n) (n)
+#define LT_L2_BUFF_ATTR
+#endif
+
+/**
+ * @brief Attribute of objects holding buffers transferred by DMA, e.g. `static lt_handle_t h LT_DMA_BUFF_ATTR;` or
+ * `static uint8_t l3_buff[LT_DMA_BUFF_SIZE(LT_SIZE_OF_L3_BUFF)] LT_DMA_BUFF_ATTR;` with LT_SEPARATE_L3_BUFF. Aligns
+ * them to LT_DMA_BUFF_ALIGN and places them into the linker section LT_BUFF_SECTION, if defined.
+ */
+#ifdef LT_BUFF_SECTION
+#define LT_DMA_BUFF_ATTR __attribute__((aligned(LT_DMA_BUFF_ALIGN), section(LT_BUFF_SECTION)))
+#else
+#define LT_DMA_BUFF_ATTR __attribute__((aligned(LT_DMA_BUFF_ALIGN)))
+#endif
+
 typedef struct lt_l2_state_t {
     void *device;
-    uint8_t buff[TR01_L1_CHIP_STATUS_SIZE + TR01_L2_MAX_FRAME_SIZE];
+    uint8_t buff[LT_DMA_BUFF_SIZE(TR01_L1_CHIP_STATUS_SIZE + TR01_L2_MAX_FRAME_SIZE)] LT_L2_BUFF_ATTR;
     bool startup_req_sent;
+#ifdef LT_L1_ADAPTIVE_POLL
+    lt_l1_poll_state_t poll;
+#endif
+#ifdef LT_L3_CMD_LATENCY
+    /** @private @brief Time in ms to sleep before polling for the next L3 result, 0 to poll right away. */
+    uint16_t presleep_ms;
+#endif
+#ifdef LT_L2_ZERO_COPY
+    /** @private @brief Where lt_l1_read() places RSP_DATA of the next L2 Response frame, NULL to use buff. */
+    uint8_t *rx_data;
+    /** @private @brief Space available in rx_data. */
+    uint16_t rx_data_max;
+    /** @private @brief Set by lt_l1_read() when RSP_DATA of the last L2 Response frame was placed to rx_data. */
+    bool rx_data_placed;
+#endif
+#ifdef LT_L2_RESEND_REREAD
+    /** @private @brief Expected length of RSP_DATA and RSP_CRC of the next L2 Response frame, 0 if not known. */
+    uint16_t rx_len_hint;
+#endif
+#ifdef LT_PORT_L3_TUNNEL
+    /** @private @brief L3 Result packet received through the bridge of the port, NULL if there is none. */
+    const uint8_t *tunnel_res;
+    /** @private @brief Length of tunnel_res. */
+    uint16_t tunnel_res_len;
+#endif
+#ifdef LT_L2_STATS
+    /** @private @brief Counters of L2 error recovery. */
+    lt_l2_stats_t stats;
+#endif
+#ifdef LT_DEADLINE
+    /** @private @brief Time from lt_port_time_us() by which API calls have to return, 0 if there is no deadline. */
+    uint64_t deadline_us;
+#endif
+#ifdef LT_LINK_TUNE
+    /** @private @brief SPI link tuning, see lt_link_tune(). */
+    lt_link_tune_state_t link;
+#endif
+#ifdef LT_TRACE
+    /** @private @brief Trace hooks, see lt_set_trace_hooks(). */
+    const lt_trace_hooks_t *trace;
+#endif
+#ifdef LT_STATS
+    /** @private @brief Runtime statistics in the handle, set by lt_init(). */
+    lt_stats_t *rt_stats;
+#endif
+#ifdef LT_SPI_RECORDER
+    /** @private @brief SPI recorder, see lt_spi_recorder_attach(). */
+    lt_spi_recorder_t *spi_rec;
+#endif
+#ifdef LT_CPU_LOG_DRAIN
+    /** @private @brief CPU log receiving the alarm log, see lt_cpu_log_attach(). */
+    lt_cpu_log_t *cpu_log;
+#endif
+#ifdef LT_PORT_RECORD
+    /** @private @brief Port recorder, see lt_set_port_recorder(). */
+    lt_port_rec_fn_t port_rec;
+    /** @private @brief User context of the port recorder. */
+    void *port_rec_ctx;
+#endif
 } lt_l2_state_t;
 
+/**
+ * @brief Size of the L3 buffer of the `R_MEM` profile (see LT_L3_BUFF_PROFILE), fits R_Mem_Data_Write and
+ * R_Mem_Data_Read with the largest User Data slot (CMD_ID/RESULT + 3 B + 475 B of data).
+ */
+#define LT_L3_BUFF_SIZE_R_MEM (TR01_L3_SIZE_SIZE + 479u + TR01_L3_TAG_SIZE)
+/**
+ * @brief Size of the L3 buffer of the `SIGN_RANDOM` profile (see LT_L3_BUFF_PROFILE), fits all commands with
+ * fixed size, the largest being Random_Value_Get with 255 B of random data (RESULT + 3 B of padding + 255 B).
+ */
+#define LT_L3_BUFF_SIZE_SIGN_RANDOM (TR01_L3_SIZE_SIZE + 259u + TR01_L3_TAG_SIZE)
+
 // #define LT_SIZE_OF_L3_BUFF (1000)
 #ifndef LT_SIZE_OF_L3_BUFF
+#if defined(LT_L3_BUFF_PROFILE_SIGN_RANDOM)
+#define LT_SIZE_OF_L3_BUFF LT_L3_BUFF_SIZE_SIGN_RANDOM
+#elif defined(LT_L3_BUFF_PROFILE_R_MEM)
+#define LT_SIZE_OF_L3_BUFF LT_L3_BUFF_SIZE_R_MEM
+#else
 #define LT_SIZE_OF_L3_BUFF TR01_L3_PACKET_MAX_SIZE
 #endif
+#endif
 
 /**
  * @brief Used to indicate whether the Secure Session is on or off.
@@ -225,6 +637,208 @@ typedef enum lt_secure_session_status_t {
     LT_SECURE_SESSION_OFF = 0
 } lt_secure_session_status_t;
 
+#ifdef LT_L3_CMD_LATENCY
+/**
+ * @brief Expected latency of one L3 command, see lt_set_l3_cmd_latency_table().
+ */
+typedef struct lt_l3_cmd_latency_t {
+    /** @brief L3 command ID. */
+    uint8_t cmd_id;
+    /** @brief Time in ms TROPIC01 needs to execute the command, 0 to poll for the result right away. */
+    uint16_t latency_ms;
+} lt_l3_cmd_latency_t;
+#endif
+
+#ifdef LT_SESSION_ROLLOVER
+/**
+ * @brief Parameters of scheduled Secure Session rollover, see lt_session_rollover_enable().
+ */
+typedef struct lt_l3_rollover_t {
+    /** @private @brief STPUB from device's certificate, owned by the caller. */
+    const uint8_t *stpub;
+    /** @private @brief Secure host private key, owned by the caller. */
+    const uint8_t *shipriv;
+    /** @private @brief Secure host public key, owned by the caller. */
+    const uint8_t *shipub;
+    /** @private @brief Nonce value from which the session is due for a rollover. */
+    uint32_t threshold;
+    /** @private @brief Number of rollovers done. */
+    uint32_t count;
+    /** @private @brief Index of pairing public key. */
+    uint8_t pkey_index;
+    /** @private @brief True if the rollover is enabled. */
+    bool enabled;
+} lt_l3_rollover_t;
+#endif
+
+/** @brief Number of configuration objects in lt_config_t */
+#define LT_CONFIG_OBJ_CNT 27
+
+#ifdef LT_I_CONFIG_CACHE
+/**
+ * @brief I-config objects known to the host, see `lt_i_config_read()`.
+ * @details I-config bits can only be cleared, so a known object changes only by `lt_i_config_write()`, which
+ * clears the bit in the cache as well.
+ */
+typedef struct lt_i_config_cache_t {
+    /** @private @brief Cached objects, in order of the configuration object addresses. */
+    uint32_t obj[LT_CONFIG_OBJ_CNT];
+    /** @private @brief Bit i is set if obj[i] is known. */
+    uint32_t valid;
+    /** @public @brief Number of reads answered from the cache. */
+    uint32_t hits;
+    /** @public @brief Number of reads sent to TROPIC01. */
+    uint32_t misses;
+} lt_i_config_cache_t;
+#endif
+
+#ifdef LT_ECC_INVENTORY
+/** @brief Number of ECC key slots tracked by the inventory. */
+#define LT_ECC_INVENTORY_SLOTS 32
+/** @brief Longest public key kept by the inventory (P-256, Ed25519 keys take the first 32 bytes). */
+#define LT_ECC_INVENTORY_PUBKEY_LEN 64
+
+/**
+ * @brief ECC key slots known to the host in the current Secure Session, see `lt_ecc_inventory_scan()`.
+ * @details Nobody else can change the slots while the Secure Session is on, so the inventory is kept up to date by
+ * lt_ecc_key_generate(), lt_ecc_key_store(), lt_ecc_key_erase() and lt_ecc_key_read(), and dropped when a new
+ * Secure Session starts.
+ */
+typedef struct lt_ecc_inventory_t {
+    /** @private @brief Secure Session the inventory belongs to. */
+    uint32_t session_cnt;
+    /** @private @brief Bit i is set if it is known whether slot i holds a key. */
+    uint32_t known;
+    /** @private @brief Bit i is set if slot i holds a key. */
+    uint32_t occupied;
+    /** @private @brief Bit i is set if pubkey[i] holds the public key of slot i. */
+    uint32_t pubkey_known;
+    /** @private @brief Curve of the key in the slot (lt_ecc_curve_type_t). */
+    uint8_t curve[LT_ECC_INVENTORY_SLOTS];
+    /** @private @brief Origin of the key in the slot (lt_ecc_key_origin_t). */
+    uint8_t origin[LT_ECC_INVENTORY_SLOTS];
+    /** @private @brief Public keys of the slots. */
+    uint8_t pubkey[LT_ECC_INVENTORY_SLOTS][LT_ECC_INVENTORY_PUBKEY_LEN];
+    /** @public @brief Number of ECC_Key_Read commands answered from the inventory. */
+    uint32_t hits;
+    /** @public @brief Number of ECC_Key_Read commands sent to TROPIC01. */
+    uint32_t misses;
+} lt_ecc_inventory_t;
+#endif
+
+#ifdef LT_PAIRING_PUB_CACHE
+/** @brief Number of pairing key slots tracked by the cache. */
+#define LT_PAIRING_PUB_CACHE_SLOTS 4
+/** @brief Length of a pairing public key. */
+#define LT_PAIRING_PUB_CACHE_KEY_LEN 32
+
+/**
+ * @brief Pairing key slots read in the current Secure Session, see `lt_pairing_key_read()`.
+ * @details Nobody else can change the slots while the Secure Session is on, so the cache is kept up to date by
+ * lt_pairing_key_write() and lt_pairing_key_invalidate(), and dropped when a new Secure Session starts.
+ */
+typedef struct lt_pairing_pub_cache_t {
+    /** @private @brief Secure Session the cache belongs to. */
+    uint32_t session_cnt;
+    /** @private @brief Bit i is set if result[i] holds the result of Pairing_Key_Read of slot i. */
+    uint8_t known;
+    /** @private @brief Result of Pairing_Key_Read of the slot: LT_OK, LT_L3_SLOT_EMPTY or LT_L3_SLOT_INVALID. */
+    uint8_t result[LT_PAIRING_PUB_CACHE_SLOTS];
+    /** @private @brief Public keys of the slots, valid if the result is LT_OK. */
+    uint8_t pub[LT_PAIRING_PUB_CACHE_SLOTS][LT_PAIRING_PUB_CACHE_KEY_LEN];
+    /** @public @brief Number of Pairing_Key_Read commands answered from the cache. */
+    uint32_t hits;
+    /** @public @brief Number of Pairing_Key_Read commands sent to TROPIC01. */
+    uint32_t misses;
+} lt_pairing_pub_cache_t;
+#endif
+
+#ifdef LT_EDDSA_SIG_CACHE
+/** @brief Number of EdDSA signatures kept by the cache. */
+#ifndef LT_EDDSA_SIG_CACHE_ENTRIES
+#define LT_EDDSA_SIG_CACHE_ENTRIES 8
+#endif
+/** @brief Number of ECC key slots tracked by the cache. */
+#define LT_EDDSA_SIG_CACHE_SLOTS 32
+/** @brief Length of the message hash (SHA-256) the signatures are keyed by. */
+#define LT_EDDSA_SIG_CACHE_HASH_LEN 32
+/** @brief Length of a cached signature (R and S). */
+#define LT_EDDSA_SIG_CACHE_SIG_LEN 64
+
+/**
+ * @brief Signature made by `lt_ecc_eddsa_sign()`, kept by the EdDSA signature cache.
+ */
+typedef struct lt_eddsa_sig_cache_entry_t {
+    /** @private @brief SHA-256 of the signed message. */
+    uint8_t msg_hash[LT_EDDSA_SIG_CACHE_HASH_LEN];
+    /** @private @brief Signature, R and S. */
+    uint8_t rs[LT_EDDSA_SIG_CACHE_SIG_LEN];
+    /** @private @brief Generation of the key in the slot the signature was made with. */
+    uint32_t gen;
+    /** @private @brief LRU tick of the last use, 0 if the entry is free. */
+    uint32_t last_used;
+    /** @private @brief ECC key slot of the key. */
+    uint8_t slot;
+} lt_eddsa_sig_cache_entry_t;
+
+/**
+ * @brief EdDSA signatures made in the current Secure Session, see `lt_ecc_eddsa_sign()`.
+ * @details Ed25519 signatures are deterministic, the same key signs the same message always with the same signature.
+ * Signatures are keyed by the slot, the generation of its key and the message hash. The generation of a slot is
+ * increased by lt_ecc_key_generate(), lt_ecc_key_store() and lt_ecc_key_erase(), so signatures of an earlier key are
+ * never served, and the cache is dropped when a new Secure Session starts.
+ */
+typedef struct lt_eddsa_sig_cache_t {
+    /** @private @brief Secure Session the cache belongs to. */
+    uint32_t session_cnt;
+    /** @private @brief Generation of the key in each slot. */
+    uint32_t gen[LT_EDDSA_SIG_CACHE_SLOTS];
+    /** @private @brief LRU clock of the entries. */
+    uint32_t tick;
+    /** @private @brief Cached signatures, the least recently used one is evicted. */
+    lt_eddsa_sig_cache_entry_t entries[LT_EDDSA_SIG_CACHE_ENTRIES];
+    /** @public @brief Number of signatures served from the cache. */
+    uint32_t hits;
+    /** @public @brief Number of EDDSA_Sign commands sent to TROPIC01. */
+    uint32_t misses;
+} lt_eddsa_sig_cache_t;
+#endif
+
+/** @brief Length of key used by AES256. */
+#define TR01_AES256_KEY_LEN 32
+
+#ifdef LT_SESSION_EXPORT
+/** Magic of a Secure Session sealed by lt_session_export() ("LTSS"). */
+#define LT_SESSION_BLOB_MAGIC 0x5353544cU
+/** Layout version of the sealed Secure Session, blobs of other versions are refused. */
+#define LT_SESSION_BLOB_VERSION 1
+/** Length of the host key which seals the Secure Session. */
+#define LT_SESSION_WRAP_KEY_LEN 32
+/** Length of the sealed state: nonces and keys (kCMD, kRES) of the Secure Session. */
+#define LT_SESSION_BLOB_STATE_LEN (2 * TR01_L3_IV_SIZE + 2 * TR01_AES256_KEY_LEN)
+
+/**
+ * @brief Secure Session sealed by `lt_session_export()` for `lt_session_import()` in another process. The structure
+ * holds no pointers, so it can be passed through a file or a socket. Contents are private.
+ */
+typedef struct lt_session_blob_t {
+    /** @private @brief LT_SESSION_BLOB_MAGIC. */
+    uint32_t magic;
+    /** @private @brief LT_SESSION_BLOB_VERSION. */
+    uint16_t version;
+    /** @private @brief Reserved, 0. */
+    uint16_t rfu;
+    /** @private @brief Random AES-GCM IV of the sealing. */
+    uint8_t iv[TR01_L3_IV_SIZE];
+    /** @private @brief Session state encrypted by the host key, followed by the AES-GCM tag. */
+    uint8_t sealed[LT_SESSION_BLOB_STATE_LEN + TR01_L3_TAG_SIZE];
+} lt_session_blob_t;
+#endif
+
+#ifdef LT_SUBMIT
+struct lt_cmd_t;
+#endif
+
 typedef struct lt_l3_state_t {
     enum lt_secure_session_status_t session_status;
     uint8_t encryption_IV[TR01_L3_IV_SIZE];
@@ -235,14 +849,88 @@ typedef struct lt_l3_state_t {
     uint8_t *buff __attribute__((aligned(16)));
 #else
     /** Buffer for L3 commands and results */
-    uint8_t buff[LT_SIZE_OF_L3_BUFF] __attribute__((aligned(16)));
+    uint8_t buff[LT_DMA_BUFF_SIZE(LT_SIZE_OF_L3_BUFF)] __attribute__((aligned(LT_DMA_BUFF_ALIGN)));
 #endif
     uint16_t buff_len; /**< Length of the buffer */
+    /** @private @brief Bytes at the start of the buffer which held plaintext since it was zeroed last time. */
+    uint16_t buff_dirty;
+#ifdef LT_L3_CMD_LATENCY
+    /** @private @brief User table of L3 command latencies, takes precedence over the built-in one. */
+    const lt_l3_cmd_latency_t *cmd_latency_tbl;
+    /** @private @brief Number of entries in cmd_latency_tbl. */
+    uint8_t cmd_latency_tbl_cnt;
+#endif
+#ifdef LT_SESSION_CACHE
+    /** @private @brief Session cache used by lt_session_start(), see lt_session_cache_attach(). */
+    struct lt_session_cache_t *session_cache;
+#endif
+#ifdef LT_SESSION_ROLLOVER
+    /** @private @brief Scheduled session rollover, see lt_session_rollover_enable(). */
+    lt_l3_rollover_t rollover;
+#endif
+#ifdef LT_I_CONFIG_CACHE
+    /** @private @brief Snapshot of I-config, see lt_i_config_read(). */
+    lt_i_config_cache_t i_config;
+#endif
+#ifdef LT_ECC_INVENTORY
+    /** @private @brief ECC key slots known in the current Secure Session, see lt_ecc_inventory_scan(). */
+    lt_ecc_inventory_t ecc_inv;
+#endif
+#ifdef LT_PAIRING_PUB_CACHE
+    /** @private @brief Pairing public keys read in the current Secure Session, see lt_pairing_key_read(). */
+    lt_pairing_pub_cache_t pairing_pub;
+#endif
+#ifdef LT_EDDSA_SIG_CACHE
+    /** @private @brief EdDSA signatures made in the current Secure Session, see lt_ecc_eddsa_sign(). */
+    lt_eddsa_sig_cache_t eddsa_sig;
+#endif
+#ifdef LT_R_MEM_MAP
+    /** @private @brief Occupancy map of R-mem user data slots, see lt_r_mem_map_attach(). */
+    struct lt_r_mem_map_t *r_mem_map;
+#endif
+#ifdef LT_TRACE
+    /** @private @brief Trace hooks, see lt_set_trace_hooks(). */
+    const lt_trace_hooks_t *trace;
+#endif
+#ifdef LT_STATS
+    /** @private @brief Runtime statistics in the handle, set by lt_init(). */
+    lt_stats_t *rt_stats;
+    /** @private @brief L3 Command IDs in flight, indexed by the lowest bit of their nonce. */
+    uint8_t rt_stats_cmd_id[2];
+    /** @private @brief Times of encryption of the L3 Commands in flight. */
+    uint64_t rt_stats_cmd_start_us[2];
+#endif
+#ifdef LT_SPI_RECORDER
+    /** @private @brief SPI recorder, see lt_spi_recorder_attach(). */
+    lt_spi_recorder_t *spi_rec;
+#endif
+#ifdef LT_L3_BUFF_ARENA
+    /** @private @brief Arena lending the buffer for each L3 Command, see lt_l3_buff_arena_attach(). */
+    struct lt_l3_buff_arena_t *arena;
+#endif
+#ifdef LT_L3_STREAM_ENCRYPT
+    /** @private @brief Streaming encryption state of the next L3 Command (LT_L3_ENCRYPT_STREAM_*). */
+    uint8_t encrypt_stream;
+#endif
+#ifdef LT_SUBMIT
+    /** @private @brief Operation sent by lt_submit() and waiting for lt_complete(), NULL if there is none. */
+    struct lt_cmd_t *submitted;
+#endif
+#if defined(LT_PIN) || defined(LT_MCOUNTER_CACHE) || defined(LT_ECC_INVENTORY) || defined(LT_R_MEM_MAP) \
+    || defined(LT_PAIRING_PUB_CACHE) || defined(LT_EDDSA_SIG_CACHE)
+    /** @private @brief Number of Secure Sessions established on the handle, tells sessions apart for the caches. */
+    uint32_t session_cnt;
+#endif
+#ifdef LT_HEALTH
+    /** @private @brief Time of the last authenticated L3 Result from lt_port_time_us(), 0 if there was none. */
+    uint64_t last_res_us;
+#endif
+#ifdef LT_SESSION_EXPORT
+    /** @private @brief Keys of the Secure Session (kCMD, kRES), kept for lt_session_export(). */
+    uint8_t session_keys[2][TR01_AES256_KEY_LEN];
+#endif
 } lt_l3_state_t;
 
-/** @brief Length of key used by AES256. */
-#define TR01_AES256_KEY_LEN 32
-
 /**
  * @brief Configures attributes that are different among TROPIC01's Application FW versions.
  *
@@ -250,6 +938,14 @@ typedef struct lt_l3_state_t {
 typedef struct lt_tr01_attrs_t {
     /** @private @brief Maximal size of the UDATA slot in the User R-Memory. */
     uint16_t r_mem_udata_slot_size_max;
+#ifdef LT_WARM_INIT
+    /** @private @brief Set if the attributes were taken from the cache by lt_init_warm() and not read from TROPIC01. */
+    uint8_t unverified;
+#endif
+#ifdef LT_SILICON_REV_CHECK
+    /** @private @brief Silicon revision detected by lt_get_silicon_rev(), lt_silicon_rev_t. */
+    uint8_t silicon_rev;
+#endif
 } lt_tr01_attrs_t;
 
 /**
@@ -261,6 +957,10 @@ typedef struct lt_handle_t {
     lt_l2_state_t l2;
     lt_l3_state_t l3;
     lt_tr01_attrs_t tr01_attrs;
+#ifdef LT_STATS
+    /** @private @brief Runtime statistics, see lt_get_stats(). */
+    lt_stats_t stats;
+#endif
 } lt_handle_t;
 
 /**
@@ -344,8 +1044,8 @@ typedef enum lt_ret_t {
      */
     LT_L3_RES_SIZE_ERROR = 26,
     /** @brief L3 buffer is too small to parse this L3 command.
-     * @details If this error is raised, either the buffer is too small to accept the result,
-     * or RES_SIZE field in the response is invalid (attack or a bug).
+     * @details If this error is raised, either the buffer is too small to accept the command or the result
+     * (see LT_L3_BUFF_PROFILE), or RES_SIZE field in the response is invalid (attack or a bug).
      */
     LT_L3_BUFFER_TOO_SMALL = 27,
     /** @brief User slot is empty */
@@ -392,13 +1092,173 @@ typedef enum lt_ret_t {
     LT_CERT_ITEM_NOT_FOUND = 45,
     /** @brief The nonce has reached its maximum value. */
     LT_NONCE_OVERFLOW = 46,
+    /** @brief Firmware update data chunk does not match the hash announced by the preceding chunk or request. */
+    LT_FW_UPDATE_HASH_ERR = 47,
+    /** @brief Entropy pool holds fewer random bytes than requested. */
+    LT_ENTROPY_POOL_EMPTY = 48,
+    /** @brief Certificate chain does not lead to the trusted root or a certificate signature is not valid. */
+    LT_CERT_CHAIN_INVALID = 49,
+    /** @brief Optional operation is not supported by the platform (e.g. by the server behind the HAL). */
+    LT_NOT_SUPPORTED = 50,
+    /** @brief No L3 buffer of the arena attached to the handle got free in time. */
+    LT_L3_BUFF_ARENA_EMPTY = 51,
+    /** @brief Silicon revision of TROPIC01 differs from the one Libtropic was built for (LT_SILICON_REV). */
+    LT_SILICON_REV_MISMATCH = 52,
+    /** @brief At least one signature checked by lt_ed25519_verify_batch() is not valid. */
+    LT_SIGNATURE_INVALID = 53,
+    /** @brief Deadline set by lt_deadline_set() would pass before the operation finishes, see LT_DEADLINE. */
+    LT_DEADLINE_EXCEEDED = 54,
+    /** @brief Ring of requests or completions is full, the producer has to back off, see LT_RING. */
+    LT_RING_FULL = 55,
 
     /** @brief Special helper value used to signalize the last enum value, used in lt_ret_verbose. */
-    LT_RET_T_LAST_VALUE = 47
+    LT_RET_T_LAST_VALUE = 56
 } lt_ret_t;
 
+/**
+ * @brief Reads next part of a mutable firmware update image, used by lt_do_mutable_fw_update_stream().
+ *
+ * @param reader_ctx  Context passed to lt_do_mutable_fw_update_stream()
+ * @param buf         Buffer to read to
+ * @param len         Number of bytes to read, the reader has to read exactly this number of bytes
+ * @return            LT_OK if success, otherwise returns other error code, which aborts the update.
+ */
+typedef lt_ret_t (*lt_fw_update_reader_t)(void *reader_ctx, uint8_t *buf, const uint16_t len);
+
+/**
+ * @brief Supplies next chunk of a mutable firmware update image, used by lt_do_mutable_fw_update_feed().
+ *
+ * @param feeder_ctx  Context passed to lt_do_mutable_fw_update_feed()
+ * @param chunk       Set to the next chunk (its length byte followed by that many bytes), which has to stay valid
+ *                    until the next call, or to NULL when the image ends
+ * @return            LT_OK if success, otherwise returns other error code, which aborts the update.
+ */
+typedef lt_ret_t (*lt_fw_update_feeder_t)(void *feeder_ctx, const uint8_t **chunk);
+
+#ifdef LT_TRACE_EXPORT
+/**
+ * @brief Start or end of a phase recorded by the trace exporter, see lt_trace_export_t.
+ */
+typedef struct lt_trace_event_t {
+    /** @brief Timestamp from lt_port_time_us(). */
+    uint64_t time_us;
+    /** @brief Phase, see lt_trace_phase_t. */
+    uint8_t phase;
+    /** @brief 1 at the end of the phase, 0 at its start. */
+    uint8_t end;
+} lt_trace_event_t;
+
+/**
+ * @brief Trace exporter, records phases reported to its trace hooks for lt_trace_export_json().
+ * @details One exporter records one handle, so devices used from several threads do not share it.
+ */
+typedef struct lt_trace_export_t {
+    /** @brief Trace hooks recording into this exporter, to be set by lt_set_trace_hooks(). */
+    lt_trace_hooks_t hooks;
+    /** @private @brief Events, provided by the user. */
+    lt_trace_event_t *events;
+    /** @private @brief Capacity of events. */
+    uint32_t size;
+    /** @private @brief Number of recorded events. */
+    uint32_t count;
+    /** @private @brief Number of events not recorded because events were full. */
+    uint32_t dropped;
+    /** @private @brief Thread ID of the exported events. */
+    uint32_t tid;
+    /** @private @brief Name of the thread, e.g. of the device, may be NULL. */
+    const char *name;
+} lt_trace_export_t;
+
+/**
+ * @brief Writes part of the exported trace, used by lt_trace_export_json().
+ *
+ * @param write_ctx   Context passed to lt_trace_export_json()
+ * @param data        Characters to write, not terminated by a null character
+ * @param len         Number of characters
+ * @return            LT_OK if success, otherwise returns other error code, which aborts the export.
+ */
+typedef lt_ret_t (*lt_trace_export_write_t)(void *write_ctx, const char *data, const size_t len);
+#endif
+
+#ifdef LT_METRICS
+/**
+ * @brief Writes part of the exported metrics text, e.g. into a file read by a textfile collector or into a buffer
+ * served by an HTTP endpoint.
+ *
+ * @param write_ctx   Context passed to the lt_metrics_write_*() function
+ * @param data        Characters to write, not terminated by a null character
+ * @param len         Number of characters
+ * @return            LT_OK if success, otherwise returns other error code, which aborts the export.
+ */
+typedef lt_ret_t (*lt_metrics_write_t)(void *write_ctx, const char *data, const size_t len);
+
+/**
+ * @brief Statistics of one device exported by lt_metrics_write_stats().
+ */
+typedef struct lt_metrics_dev_t {
+    /** @brief Value of the device label. */
+    const char *name;
+    /** @brief Snapshot taken by lt_get_stats(). */
+    const lt_stats_t *stats;
+} lt_metrics_dev_t;
+#endif
+
 #define LT_TR01_REBOOT_DELAY_MS 250
 
+#ifndef LT_TR01_REBOOT_MIN_DELAY_MS
+/**
+ * Delay in ms after Startup_Req, before which CHIP_STATUS may still show the mode TROPIC01 is leaving. Used instead of
+ * LT_TR01_REBOOT_DELAY_MS with LT_REBOOT_POLL, CHIP_STATUS is polled afterwards.
+ */
+#define LT_TR01_REBOOT_MIN_DELAY_MS 10
+#endif
+
+#ifdef LT_REBOOT_ASYNC
+#ifndef LT_REBOOT_ASYNC_POLL_MS
+/** Interval in ms between the reads of CHIP_STATUS of a rebooting TROPIC01 by `lt_reboot_async_process()`. */
+#define LT_REBOOT_ASYNC_POLL_MS 5
+#endif
+
+/** @brief States of an asynchronous reboot, see `lt_reboot_async_start()`. */
+typedef enum lt_reboot_async_state_t {
+    LT_REBOOT_ASYNC_IDLE = 0, /**< Not started */
+    LT_REBOOT_ASYNC_WAITING,  /**< Waiting for TROPIC01 to come up */
+    LT_REBOOT_ASYNC_ATTRS,    /**< TROPIC01 is up, the attributes are read by the next process call */
+    LT_REBOOT_ASYNC_DONE      /**< Finished, the callback was called */
+} lt_reboot_async_state_t;
+
+/**
+ * @brief Called when asynchronous reboot or initialization finishes.
+ *
+ * @param h       Handle of the device
+ * @param ret     LT_OK if TROPIC01 is up in the requested mode (and the handle is initialized), otherwise error code
+ * @param cb_ctx  User data passed to `lt_reboot_async_start()` or `lt_init_async_start()`
+ */
+typedef void (*lt_reboot_async_cb_t)(lt_handle_t *h, lt_ret_t ret, void *cb_ctx);
+
+/** @brief Asynchronous reboot or initialization of one TROPIC01, contents are private. */
+typedef struct lt_reboot_async_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Completion callback, may be NULL. */
+    lt_reboot_async_cb_t cb;
+    /** @private @brief User data for the callback. */
+    void *cb_ctx;
+    /** @private @brief Time of the Startup_Req, in us of lt_port_time_us(). */
+    uint64_t start_us;
+    /** @private @brief Time of the next read of CHIP_STATUS. */
+    uint64_t next_us;
+    /** @private @brief Result, LT_L1_CHIP_BUSY while in progress. */
+    lt_ret_t ret;
+    /** @private @brief Startup ID of the Startup_Req. */
+    lt_startup_id_t startup_id;
+    /** @private @brief Current state, see lt_reboot_async_state_t. */
+    lt_reboot_async_state_t state;
+    /** @private @brief Set by lt_init_async_start(), the handle is initialized when TROPIC01 is up. */
+    bool init;
+} lt_reboot_async_t;
+#endif
+
 //--------------------------------------------------------------------------------------------------------------------//
 /** @brief Maximal size of TROPIC01's certificate */
 #define TR01_L2_GET_INFO_REQ_CERT_SIZE_TOTAL 3840
@@ -609,6 +1469,32 @@ LT_STATIC_ASSERT(
 /** @brief Maximal size of returned RISCV fw version */
 #define TR01_L2_GET_INFO_RISCV_FW_SIZE 4
 
+#ifdef LT_WARM_INIT
+/** Magic of a filled TROPIC01 attributes cache ("LTTA"). */
+#define LT_TR01_ATTRS_CACHE_MAGIC 0x4154544cU
+/** Layout version of the TROPIC01 attributes cache, caches of other versions are ignored. */
+#define LT_TR01_ATTRS_CACHE_VERSION 1
+
+/**
+ * @brief TROPIC01 attributes of one TROPIC01, keyed by its CHIP_ID (see `lt_tr01_attrs_export()`). The structure holds
+ * no pointers, so the application can persist it for `lt_init_warm()` of the next run. Contents are private.
+ */
+typedef struct lt_tr01_attrs_cache_t {
+    /** @private @brief LT_TR01_ATTRS_CACHE_MAGIC if the cache is filled. */
+    uint32_t magic;
+    /** @private @brief LT_TR01_ATTRS_CACHE_VERSION. */
+    uint16_t version;
+    /** @private @brief CRC16 of the fields below. */
+    uint16_t crc;
+    /** @private @brief CHIP_ID of the TROPIC01 the cache was filled from. */
+    struct lt_chip_id_t chip_id;
+    /** @private @brief Application FW version as returned by lt_get_info_riscv_fw_ver(). */
+    uint8_t riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE];
+    /** @private @brief Maximal size of the UDATA slot in the User R-Memory. */
+    uint16_t r_mem_udata_slot_size_max;
+} lt_tr01_attrs_cache_t;
+#endif
+
 //--------------------------------------------------------------------------------------------------------------------//
 /** @brief Maximal size of returned SPECT fw version */
 #define TR01_L2_GET_INFO_SPECT_FW_SIZE 4
@@ -621,6 +1507,15 @@ LT_STATIC_ASSERT(
 /** @brief Maximal size of returned fw header */
 #define TR01_L2_GET_INFO_FW_HEADER_SIZE TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V2
 
+#ifdef LT_SILICON_REV_CHECK
+/** @brief Silicon revision of TROPIC01, see lt_get_silicon_rev(). */
+typedef enum lt_silicon_rev_t {
+    LT_SILICON_REV_UNKNOWN = 0,  // Not detected yet.
+    LT_SILICON_REV_ABAB = 1,     // Bootloader v1.0.1.
+    LT_SILICON_REV_ACAB = 2,     // Bootloader v2.0.1.
+} lt_silicon_rev_t;
+#endif
+
 /** @brief BANK ID */
 typedef enum lt_bank_id_t {
     TR01_FW_BANK_FW1 = 1,      // Firmware bank 1.
@@ -718,6 +1613,319 @@ typedef struct lt_host_eph_keys_t {
     uint8_t ehpub[32];  /**< Host MCU ephemeral public key. */
 } lt_host_eph_keys_t;
 
+#ifdef LT_L3_BUFF_ARENA
+/** Max number of L3 buffers in an arena. */
+#define LT_L3_BUFF_ARENA_MAX 32
+/** Distance of L3 buffers in memory of an arena, LT_SIZE_OF_L3_BUFF rounded up to keep them aligned. */
+#define LT_L3_BUFF_ARENA_STRIDE \
+    (((LT_SIZE_OF_L3_BUFF + LT_DMA_BUFF_ALIGN - 1u) / LT_DMA_BUFF_ALIGN) * LT_DMA_BUFF_ALIGN)
+/** Size of memory of an arena with n L3 buffers, see lt_l3_buff_arena_init(). */
+#define LT_L3_BUFF_ARENA_MEM_SIZE(n) ((n) * LT_L3_BUFF_ARENA_STRIDE)
+#ifndef LT_L3_BUFF_ARENA_TIMEOUT_MS
+/** Default time to wait for a free L3 buffer of an arena [ms]. */
+#define LT_L3_BUFF_ARENA_TIMEOUT_MS 1000
+#endif
+
+/**
+ * @brief Arena of L3 buffers shared by several handles (see `lt_l3_buff_arena_attach()`). Contents are private.
+ * @details Each L3 Command borrows a buffer in `lt_out__*()` and returns it wiped when `lt_in__*()` decodes the
+ * result, so the arena needs as many buffers as there are L3 Commands executed concurrently, not as handles.
+ */
+typedef struct lt_l3_buff_arena_t {
+    /** @private @brief Memory of the buffers. */
+    uint8_t *mem;
+    /** @private @brief Number of the buffers. */
+    uint8_t cnt;
+    /** @private @brief Bit mask of borrowed buffers. */
+    uint32_t used;
+    /** @public @brief Max time to wait for a free buffer [ms], LT_L3_BUFF_ARENA_TIMEOUT_MS after init. */
+    uint32_t timeout_ms;
+    /** @public @brief Number of borrowed buffers. */
+    uint32_t borrows;
+    /** @public @brief Number of borrows which found all buffers borrowed, so they waited or failed. */
+    uint32_t waits;
+    /** @public @brief Max number of buffers borrowed at once. */
+    uint8_t peak;
+} lt_l3_buff_arena_t;
+#endif
+
+#ifdef LT_ENTROPY_POOL
+#ifndef LT_ENTROPY_POOL_SIZE
+/** Size of the entropy pool in bytes, power of two. */
+#define LT_ENTROPY_POOL_SIZE 1024
+#endif
+
+/** Bytes of TROPIC01 randomness mixed into the HMAC-DRBG by each refill (entropy input and nonce). */
+#define LT_ENTROPY_POOL_DRBG_SEED_LEN 48
+
+/**
+ * @brief Pool of random bytes from TROPIC01 (see `lt_entropy_pool_init()`). Contents are private.
+ * @details Single-producer single-consumer ring: `lt_entropy_pool_refill()` adds bytes, `lt_entropy_pool_get()`
+ * takes them.
+ */
+typedef struct lt_entropy_pool_t {
+    /** @private @brief Random bytes. */
+    uint8_t buf[LT_ENTROPY_POOL_SIZE];
+    /** @private @brief Number of bytes ever added (free running). */
+    uint32_t head;
+    /** @private @brief Number of bytes ever taken (free running). */
+    uint32_t tail;
+    /** @private @brief Refill is needed below this number of bytes. */
+    uint16_t low_watermark;
+    /** @private @brief Refill stops at this number of bytes. */
+    uint16_t high_watermark;
+#ifdef LT_ENTROPY_POOL_DRBG
+    /** @private @brief HMAC-DRBG key K. */
+    uint8_t drbg_key[32];
+    /** @private @brief HMAC-DRBG value V. */
+    uint8_t drbg_v[32];
+    /** @private @brief HMAC-DRBG was instantiated. */
+    bool drbg_seeded;
+#endif
+    /** @public @brief Number of Random_Value_Get L3 commands issued by the refills. */
+    uint32_t chip_requests;
+    /** @public @brief Number of lt_entropy_pool_get() calls which failed, because the pool held too few bytes. */
+    uint32_t underruns;
+} lt_entropy_pool_t;
+#endif
+
+#ifdef LT_SIGN_QUEUE
+#ifndef LT_SIGN_QUEUE_LEN
+/** Max number of signing jobs pending in the signing queue (waiting or executed by a device). */
+#define LT_SIGN_QUEUE_LEN 32
+#endif
+#ifndef LT_SIGN_QUEUE_MAX_DEVICES
+/** Max number of TROPIC01 devices served by one signing queue. */
+#define LT_SIGN_QUEUE_MAX_DEVICES 4
+#endif
+/** Size of the buffers for ECDSA_Sign L3 Command and L3 Result packets. */
+#define LT_SIGN_QUEUE_BUFF_LEN 112
+/** Size of the message digest signed by a job (SHA-256). */
+#define LT_SIGN_QUEUE_DIGEST_LEN 32
+
+/**
+ * @brief Called when a signing job finishes.
+ *
+ * @param ret     LT_OK if the signature was made, otherwise error code
+ * @param rs      Signature (R and S, 64 bytes), NULL if ret is not LT_OK
+ * @param cb_ctx  User data passed to `lt_sign_queue_submit()`
+ */
+typedef void (*lt_sign_queue_cb_t)(lt_ret_t ret, const uint8_t *rs, void *cb_ctx);
+
+/** @brief Signing job. */
+typedef struct lt_sign_job_t {
+    /** @private @brief Completion callback. */
+    lt_sign_queue_cb_t cb;
+    /** @private @brief User data for the callback. */
+    void *cb_ctx;
+    /** @private @brief SHA-256 digest of the message. */
+    uint8_t digest[LT_SIGN_QUEUE_DIGEST_LEN];
+    /** @private @brief ECC key slot. */
+    uint8_t slot;
+} lt_sign_job_t;
+
+struct lt_l2_async_t;
+struct lt_sign_queue_t;
+
+#ifdef LT_CRYPTO_WORKER
+/**
+ * @brief Encryption of an L3 Command or decryption of an L3 Result handed to a crypto worker, executed by
+ * `lt_crypto_work_run()`.
+ */
+typedef struct lt_crypto_work_t {
+    /** @private @brief L3 state of the device, owned by the work until it is done. */
+    lt_l3_state_t *s3;
+    /** @private @brief L3 packet, encrypted or decrypted in place. */
+    uint8_t *buff;
+    /** @private @brief Size of the packet buffer. */
+    uint16_t buff_len;
+    /** @private @brief Decryption of the L3 Result, otherwise encryption of the L3 Command. */
+    bool decrypt;
+    /** @private @brief Result of the work. */
+    lt_ret_t ret;
+    /** @private @brief Set by `lt_crypto_work_run()` when the work is done, accessed atomically. */
+    uint8_t done;
+} lt_crypto_work_t;
+
+/**
+ * @brief Hands the work to a crypto worker, which executes it by `lt_crypto_work_run()` on any thread.
+ *
+ * @param worker_ctx  User data passed to `lt_sign_queue_set_crypto_worker()`
+ * @param work        Work, stays valid until it is done
+ * @return            LT_OK if the work was taken, otherwise it is executed by the calling thread
+ */
+typedef lt_ret_t (*lt_crypto_worker_submit_t)(void *worker_ctx, lt_crypto_work_t *work);
+#endif
+
+/** @brief TROPIC01 device of the signing queue. */
+typedef struct lt_sign_queue_dev_t {
+    /** @private @brief L3 Command packets, one is executed while the next one is encrypted in the other. */
+    uint8_t buff[2][LT_DMA_BUFF_SIZE(LT_SIGN_QUEUE_BUFF_LEN)] __attribute__((aligned(LT_DMA_BUFF_ALIGN)));
+    /** @private @brief Jobs of the packets in buff. */
+    lt_sign_job_t jobs[2];
+    /** @private @brief Queue the device belongs to. */
+    struct lt_sign_queue_t *q;
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Asynchronous L2 operation of the device. */
+    struct lt_l2_async_t *op;
+    /** @private @brief Index of the packet executed by TROPIC01. */
+    uint8_t cur;
+    /** @private @brief Number of jobs on the device (executed and encrypted ahead), 0-2. */
+    uint8_t cnt;
+#ifdef LT_CRYPTO_WORKER
+    /** @private @brief State of the packets in buff, used with a crypto worker. */
+    uint8_t pkt[2];
+    /** @private @brief Results of the transfers of the packets. */
+    lt_ret_t pkt_ret[2];
+    /** @private @brief Index of the next packet to be staged. */
+    uint8_t tail;
+    /** @private @brief Index of the next packet to be encrypted. */
+    uint8_t seal;
+    /** @private @brief Index of the next packet whose L3 Result is decrypted. */
+    uint8_t open;
+    /** @private @brief Work handed to the crypto worker. */
+    lt_crypto_work_t work;
+    /** @private @brief Worker owns the L3 state of the device. */
+    bool work_busy;
+    /** @private @brief Transfer failed, jobs are taken off the device once the worker is done. */
+    bool failed;
+#endif
+} lt_sign_queue_dev_t;
+
+/**
+ * @brief Queue of ECDSA signing jobs executed by a pool of TROPIC01 devices (see `lt_sign_queue_init()`). Contents
+ * are private.
+ */
+typedef struct lt_sign_queue_t {
+    /** @private @brief Devices. */
+    lt_sign_queue_dev_t devs[LT_SIGN_QUEUE_MAX_DEVICES];
+    /** @private @brief Number of devices. */
+    uint8_t dev_cnt;
+    /** @private @brief Jobs waiting for a device, ring buffer. */
+    lt_sign_job_t jobs[LT_SIGN_QUEUE_LEN];
+    /** @private @brief Index of the oldest waiting job. */
+    uint8_t head;
+    /** @private @brief Number of waiting jobs. */
+    uint8_t cnt;
+#ifdef LT_CRYPTO_WORKER
+    /** @private @brief Hands encryption and decryption to the crypto worker, NULL if they run in the caller. */
+    lt_crypto_worker_submit_t worker;
+    /** @private @brief User data of the crypto worker. */
+    void *worker_ctx;
+#endif
+} lt_sign_queue_t;
+#endif
+
+#ifdef LT_POOL
+#ifndef LT_POOL_MAX_DEVICES
+/** Max number of TROPIC01 devices in one device pool. */
+#define LT_POOL_MAX_DEVICES 4
+#endif
+#ifndef LT_POOL_BACKOFF_MAX_SHIFT
+/** Quarantined device waits at most 2^LT_POOL_BACKOFF_MAX_SHIFT calls of lt_pool_maintain() between handshakes. */
+#define LT_POOL_BACKOFF_MAX_SHIFT 6
+#endif
+#ifdef LT_POOL_HEDGE
+#ifndef LT_POOL_HEDGE_MIN_SAMPLES
+/** Number of timed operations of the pool needed to derive the hedge delay, no duplicates are sent before. */
+#define LT_POOL_HEDGE_MIN_SAMPLES 100
+#endif
+#ifndef LT_POOL_HEDGE_WINDOW
+/** Counts of the latency histogram are halved once it holds this many operations, so it follows recent latencies. */
+#define LT_POOL_HEDGE_WINDOW 1024
+#endif
+/** Number of buckets of the latency histogram, bucket i holds latencies shorter than 2^i ms. */
+#define LT_POOL_HEDGE_BUCKETS 16
+#endif
+
+/**
+ * @brief Operation executed by a device of the device pool.
+ *
+ * @param h       Handle of the device
+ * @param op_ctx  Arguments of the operation
+ * @return        Result of the operation
+ */
+typedef lt_ret_t (*lt_pool_op_t)(lt_handle_t *h, void *op_ctx);
+
+/**
+ * @brief Runs the operation with the handle of a device of the device pool, e.g. by the thread owning the handle
+ * (see `lt_pool_set_executor()`).
+ *
+ * @param exec_ctx  User data passed to `lt_pool_set_executor()`
+ * @param h         Handle of the device
+ * @param op        Operation
+ * @param op_ctx    Arguments of the operation
+ * @return          Result of the operation
+ */
+typedef lt_ret_t (*lt_pool_executor_t)(void *exec_ctx, lt_handle_t *h, lt_pool_op_t op, void *op_ctx);
+
+/** @brief TROPIC01 device of the device pool. */
+typedef struct lt_pool_dev_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Keys for the re-handshake, see `lt_session_start()`. */
+    const uint8_t *stpub;
+    /** @private @brief Pairing key slot for the re-handshake. */
+    lt_pkey_index_t pkey_index;
+    /** @private @brief Host private pairing key for the re-handshake. */
+    const uint8_t *shipriv;
+    /** @private @brief Host public pairing key for the re-handshake. */
+    const uint8_t *shipub;
+    /** @private @brief Number of callers assigned to the device (executing or waiting), accessed atomically. */
+    uint8_t depth;
+    /** @private @brief Handle is used by a caller, accessed atomically. */
+    bool busy;
+    /** @private @brief Device is excluded from dispatching until the re-handshake succeeds. */
+    bool quarantined;
+    /** @private @brief Number of consecutive failed re-handshakes. */
+    uint8_t handshake_failures;
+    /** @private @brief Calls of lt_pool_maintain() left before the next re-handshake. */
+    uint8_t backoff;
+    /** @private @brief Device is kept warm for failover, it takes operations only when no other device can. */
+    bool standby;
+    /** @private @brief Runs the operations of the device, NULL to run them by the calling thread. */
+    lt_pool_executor_t exec;
+    /** @private @brief User data of the executor. */
+    void *exec_ctx;
+#ifdef LT_POOL_HEDGE
+    /** @private @brief Asynchronous L2 operation of the device, NULL if operations of the device are not hedged. */
+    struct lt_l2_async_t *op;
+    /** @public @brief Number of hedged duplicates executed by the device. */
+    uint32_t hedges;
+    /** @public @brief Number of hedged duplicates which finished before the original operation. */
+    uint32_t hedge_wins;
+    /** @public @brief Number of operations abandoned because their hedged duplicate finished first. */
+    uint32_t abandoned;
+#endif
+    /** @public @brief Number of operations executed by the device. */
+    uint32_t ops;
+    /** @public @brief Number of times the device was quarantined. */
+    uint32_t failures;
+    /** @public @brief Number of successful re-handshakes. */
+    uint32_t handshakes;
+} lt_pool_dev_t;
+
+/**
+ * @brief Pool of TROPIC01 devices executing stateless operations (see `lt_pool_init()`). Contents are private
+ * except the statistics of the devices.
+ */
+typedef struct lt_pool_t {
+    /** @private @brief Devices. */
+    lt_pool_dev_t devs[LT_POOL_MAX_DEVICES];
+    /** @private @brief Number of devices. */
+    uint8_t dev_cnt;
+#ifdef LT_POOL_HEDGE
+    /** @private @brief Histogram of operation latencies, see LT_POOL_HEDGE_BUCKETS. */
+    uint16_t lat_hist[LT_POOL_HEDGE_BUCKETS];
+    /** @private @brief Number of operations in lat_hist. */
+    uint16_t lat_cnt;
+    /** @private @brief Histogram is updated by a caller, accessed atomically. */
+    bool lat_busy;
+#endif
+} lt_pool_t;
+#endif
+
 /** @brief Length of key used in X25519 function.
  *
  * ECDH uses X25519 function with Curve25519 -> 32 bytes. See "Variables" section in GLOSSARY in TROPIC01 datasheet.
@@ -751,6 +1959,706 @@ typedef struct lt_host_eph_keys_t {
 #define TR01_EHPRIV_LEN TR01_X25519_KEY_LEN
 /** @brief Length of Host MCU ephemeral public key */
 #define TR01_EHPUB_LEN TR01_X25519_KEY_LEN
+
+#ifdef LT_BRINGUP
+#ifndef LT_BRINGUP_MAX_DEVICES
+/** Max number of TROPIC01 devices brought up by one bring-up. */
+#define LT_BRINGUP_MAX_DEVICES 4
+#endif
+/** Size of the storage of the streaming certificate parser of one device. */
+#define LT_BRINGUP_PARSER_SIZE 64
+
+/** @brief States of a device being brought up, see `lt_bringup_state()`. */
+typedef enum lt_bringup_state_t {
+    LT_BRINGUP_STATE_INIT = 0,  /**< Waiting for lt_init() */
+    LT_BRINGUP_STATE_CERT,      /**< Reading the certificate store until STPUB is found */
+    LT_BRINGUP_STATE_HANDSHAKE, /**< Waiting for Handshake_Rsp */
+    LT_BRINGUP_STATE_READY,     /**< Secure Session is running */
+    LT_BRINGUP_STATE_FAILED     /**< Bring-up failed */
+} lt_bringup_state_t;
+
+/**
+ * @brief Called when bring-up of a device finishes.
+ *
+ * @param h       Handle of the device
+ * @param ret     LT_OK if Secure Session was started, otherwise error code
+ * @param stpub   STPUB read from the device certificate, NULL if ret is not LT_OK
+ * @param cb_ctx  User data passed to `lt_bringup_add_device()`
+ */
+typedef void (*lt_bringup_cb_t)(lt_handle_t *h, lt_ret_t ret, const uint8_t *stpub, void *cb_ctx);
+
+struct lt_l2_async_t;
+struct lt_bringup_t;
+
+/** @brief TROPIC01 device of the bring-up. */
+typedef struct lt_bringup_dev_t {
+    /** @private @brief State of the streaming certificate parser. */
+    uint8_t parser[LT_BRINGUP_PARSER_SIZE] __attribute__((aligned(8)));
+    /** @private @brief STPUB from the device certificate. */
+    uint8_t stpub[TR01_STPUB_LEN];
+    /** @private @brief Ephemeral keys of the handshake in progress. */
+    lt_host_eph_keys_t eph_keys;
+    /** @private @brief Bring-up the device belongs to. */
+    struct lt_bringup_t *b;
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Asynchronous L2 operation of the device. */
+    struct lt_l2_async_t *op;
+#ifdef LT_REBOOT_ASYNC
+    /** @private @brief Initialization of the device, when TROPIC01 has to be rebooted. */
+    lt_reboot_async_t reboot;
+#endif
+    /** @private @brief Host private pairing key. */
+    const uint8_t *shipriv;
+    /** @private @brief Host public pairing key. */
+    const uint8_t *shipub;
+    /** @private @brief Completion callback, may be NULL. */
+    lt_bringup_cb_t cb;
+    /** @private @brief User data for the callback. */
+    void *cb_ctx;
+    /** @private @brief Length of the device certificate. */
+    uint16_t cert_len;
+    /** @private @brief Number of bytes of the device certificate passed to the parser. */
+    uint16_t fed;
+    /** @private @brief Index of the requested block of the certificate store. */
+    uint8_t block;
+    /** @private @brief Pairing key slot. */
+    lt_pkey_index_t pkey_index;
+    /** @private @brief Current state, see lt_bringup_state_t. */
+    lt_bringup_state_t state;
+    /** @private @brief Result of the bring-up. */
+    lt_ret_t ret;
+} lt_bringup_dev_t;
+
+/**
+ * @brief Concurrent bring-up (initialization, STPUB read, Secure Channel Handshake) of several TROPIC01 devices (see
+ * `lt_bringup_init()`). Contents are private.
+ */
+typedef struct lt_bringup_t {
+    /** @private @brief Devices. */
+    lt_bringup_dev_t devs[LT_BRINGUP_MAX_DEVICES];
+    /** @private @brief Number of devices. */
+    uint8_t dev_cnt;
+    /** @private @brief Number of finished steps of all devices, tells lt_bringup_run() whether to wait. */
+    uint16_t steps;
+} lt_bringup_t;
+#endif
+
+#ifdef LT_FW_FLEET
+#ifndef LT_FW_FLEET_MAX_DEVICES
+/** Max number of TROPIC01 devices updated by one firmware update fleet. */
+#define LT_FW_FLEET_MAX_DEVICES 4
+#endif
+
+/**
+ * @brief Called when firmware update of a device finishes.
+ *
+ * @param h       Handle of the device
+ * @param ret     LT_OK if the whole image was written, otherwise error code
+ * @param offset  Offset in the image up to which TROPIC01 accepted it, the update can be resumed from here
+ * @param cb_ctx  User data passed to `lt_fw_fleet_add_device()`
+ */
+typedef void (*lt_fw_fleet_cb_t)(lt_handle_t *h, lt_ret_t ret, uint16_t offset, void *cb_ctx);
+
+struct lt_l2_async_t;
+struct lt_fw_fleet_t;
+
+/** @brief TROPIC01 device of the firmware update fleet. */
+typedef struct lt_fw_fleet_dev_t {
+    /** @private @brief Fleet the device belongs to. */
+    struct lt_fw_fleet_t *f;
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Asynchronous L2 operation of the device. */
+    struct lt_l2_async_t *op;
+    /** @private @brief Completion callback, may be NULL. */
+    lt_fw_fleet_cb_t cb;
+    /** @private @brief User data for the callback. */
+    void *cb_ctx;
+    /** @private @brief Offset in the image up to which TROPIC01 accepted it. */
+    uint16_t offset;
+    /** @private @brief Offset in the image after the L2 Request in progress. */
+    uint16_t next;
+    /** @private @brief Bank was erased (ABAB only). */
+    bool erased;
+    /** @private @brief Result of the update, LT_L1_CHIP_BUSY while in progress. */
+    lt_ret_t ret;
+} lt_fw_fleet_dev_t;
+
+/**
+ * @brief Mutable firmware update of several TROPIC01 devices with one image (see `lt_fw_fleet_init()`). Contents are
+ * private.
+ */
+typedef struct lt_fw_fleet_t {
+    /** @private @brief Devices. */
+    lt_fw_fleet_dev_t devs[LT_FW_FLEET_MAX_DEVICES];
+    /** @private @brief Number of devices. */
+    uint8_t dev_cnt;
+    /** @private @brief Update image. */
+    const uint8_t *update_data;
+    /** @private @brief Size of the update image. */
+    uint16_t update_data_size;
+    /** @private @brief Bank to update (ABAB only). */
+    lt_bank_id_t bank_id;
+    /** @private @brief Number of finished L2 Requests of all devices, tells lt_fw_fleet_run() whether to wait. */
+    uint16_t steps;
+} lt_fw_fleet_t;
+#endif
+
+#ifdef LT_FW_PLAN
+#ifndef LT_FW_PLAN_MAX_STEPS
+/** Max number of banks updated by one firmware update plan. */
+#define LT_FW_PLAN_MAX_STEPS 4
+#endif
+
+/** @brief Phases of a step of the firmware update plan, see `lt_fw_plan_progress_t`. */
+typedef enum lt_fw_plan_phase_t {
+    LT_FW_PLAN_PHASE_PREPARED = 0, /**< Image of the step was prepared by the host */
+    LT_FW_PLAN_PHASE_ERASED,       /**< Bank was erased, for ACAB the update request was accepted */
+    LT_FW_PLAN_PHASE_WRITE,        /**< L2 Request with a part of the image was accepted */
+    LT_FW_PLAN_PHASE_DONE          /**< Whole image of the step was written */
+} lt_fw_plan_phase_t;
+
+/**
+ * @brief Prepares image of a step of the firmware update plan, e.g. fetches it from network or a file and checks it.
+ * @details Called while TROPIC01 erases a bank, it must not use the handle the plan runs on.
+ *
+ * @param cb_ctx            User data passed to `lt_fw_plan_init()`
+ * @param step              Index of the step, in order of `lt_fw_plan_add()` calls
+ * @param bank_id           Bank of the step (ABAB only)
+ * @param update_data       Image of the step, has to stay valid until the step is done
+ * @param update_data_size  Size of the image
+ * @return                  LT_OK if the image was prepared, otherwise error code ending the plan
+ */
+typedef lt_ret_t (*lt_fw_plan_prepare_t)(void *cb_ctx, uint8_t step, lt_bank_id_t bank_id,
+                                         const uint8_t **update_data, uint16_t *update_data_size);
+
+/**
+ * @brief Reports progress of the firmware update plan.
+ *
+ * @param cb_ctx  User data passed to `lt_fw_plan_init()`
+ * @param step    Index of the step
+ * @param phase   Phase the step reached
+ * @param offset  Offset in the image of the step up to which TROPIC01 accepted it
+ * @param size    Size of the image of the step
+ */
+typedef void (*lt_fw_plan_progress_t)(void *cb_ctx, uint8_t step, lt_fw_plan_phase_t phase, uint16_t offset,
+                                      uint16_t size);
+
+/** @brief Step of the firmware update plan, i.e. update of one bank. */
+typedef struct lt_fw_plan_step_t {
+    /** @private @brief Image, NULL until it is prepared. */
+    const uint8_t *update_data;
+    /** @private @brief Size of the image. */
+    uint16_t update_data_size;
+    /** @private @brief Bank to update (ABAB only). */
+    lt_bank_id_t bank_id;
+} lt_fw_plan_step_t;
+
+/**
+ * @brief Mutable firmware update of several banks (see `lt_fw_plan_init()`). Contents are private.
+ */
+typedef struct lt_fw_plan_t {
+    /** @private @brief Steps in order of the update. */
+    lt_fw_plan_step_t steps[LT_FW_PLAN_MAX_STEPS];
+    /** @private @brief Number of steps. */
+    uint8_t step_cnt;
+    /** @private @brief Index of the step in progress, step_cnt when the plan is done. */
+    uint8_t step;
+    /** @private @brief Offset in the image of the step in progress up to which TROPIC01 accepted it. */
+    uint16_t offset;
+    /** @private @brief Prepares images which were not given to lt_fw_plan_add(), may be NULL. */
+    lt_fw_plan_prepare_t prepare;
+    /** @private @brief Progress callback, may be NULL. */
+    lt_fw_plan_progress_t progress;
+    /** @private @brief User data for the callbacks. */
+    void *cb_ctx;
+} lt_fw_plan_t;
+#endif
+
+#ifdef LT_FW_UPDATE_RESUME
+/** Magic of a filled firmware update checkpoint ("LTFU"). */
+#define LT_FW_UPDATE_CHECKPOINT_MAGIC 0x5546544cU
+/** Layout version of the firmware update checkpoint, checkpoints of other versions are refused. */
+#define LT_FW_UPDATE_CHECKPOINT_VERSION 1
+
+/**
+ * @brief Position of a resumable firmware update in its image (see `lt_fw_update_session_checkpoint()`). The structure
+ * holds no pointers, so the application can persist it and resume the update after restart of the process. Contents
+ * are private.
+ */
+typedef struct lt_fw_update_checkpoint_t {
+    /** @private @brief LT_FW_UPDATE_CHECKPOINT_MAGIC if the checkpoint is filled. */
+    uint32_t magic;
+    /** @private @brief LT_FW_UPDATE_CHECKPOINT_VERSION. */
+    uint16_t version;
+    /** @private @brief CRC16 of the fields below. */
+    uint16_t crc;
+    /** @private @brief Size of the update image. */
+    uint16_t image_size;
+    /** @private @brief CRC16 of the update image, the checkpoint is valid only for the same image. */
+    uint16_t image_crc;
+    /** @private @brief Offset in the image up to which TROPIC01 acknowledged it. */
+    uint16_t offset;
+    /** @private @brief Number of acknowledged L2 Requests carrying the image. */
+    uint16_t chunks;
+    /** @private @brief Bank to update (ABAB only). */
+    uint8_t bank_id;
+    /** @private @brief Bank was erased (ABAB only). */
+    uint8_t erased;
+} lt_fw_update_checkpoint_t;
+
+/** @brief Resumable mutable firmware update (see `lt_fw_update_session_init()`). Contents are private. */
+typedef struct lt_fw_update_session_t {
+    /** @private @brief Update image. */
+    const uint8_t *update_data;
+    /** @private @brief Position of the update, CRC of the checkpoint is filled only when exported. */
+    lt_fw_update_checkpoint_t cp;
+    /** @private @brief Number of L2 Requests sent again after a transient error. */
+    uint16_t retries;
+} lt_fw_update_session_t;
+#endif
+
+#ifdef LT_FW_IMAGE
+/**
+ * @brief Reads part of a mutable firmware update image at the given offset, used by `lt_fw_image_t`.
+ *
+ * @param read_ctx    Context passed to lt_fw_image_open() (e.g. file handle or base address of a flash partition)
+ * @param offset      Offset in the image
+ * @param buf         Buffer to read to
+ * @param len         Number of bytes to read, the reader has to read exactly this number of bytes
+ * @return            LT_OK if success, otherwise returns other error code, which aborts the operation.
+ */
+typedef lt_ret_t (*lt_fw_image_read_t)(void *read_ctx, const uint16_t offset, uint8_t *buf, const uint16_t len);
+
+/**
+ * @brief Mutable firmware update image (`*_signed_chunks.bin` for ACAB, plain binary for ABAB) kept outside of the
+ * host memory and read by parts (see `lt_fw_image_open()`). Contents are private.
+ */
+typedef struct lt_fw_image_t {
+    /** @private @brief Reads the image. */
+    lt_fw_image_read_t read;
+    /** @private @brief Context of the reader. */
+    void *read_ctx;
+    /** @private @brief Size of the image. */
+    uint16_t size;
+    /** @private @brief Number of L2 Requests carrying the image (chunks). */
+    uint16_t chunk_cnt;
+    /** @private @brief Offsets of the first index_len chunks, may be NULL. */
+    uint16_t *index;
+    /** @private @brief Number of entries of the index. */
+    uint16_t index_len;
+} lt_fw_image_t;
+#endif
+
+#ifdef LT_CERT_CACHE
+/** Magic number of a filled certificate cache ("LTCC"). */
+#define LT_CERT_CACHE_MAGIC 0x4343544cU
+/** Layout version of the certificate cache, caches of other versions are refilled. */
+#define LT_CERT_CACHE_VERSION 1
+
+/**
+ * @brief Certificate store and STPUB of one TROPIC01, keyed by its CHIP_ID (see `lt_cert_cache_fill()`).
+ * @details The structure holds no pointers, so the application can persist it byte for byte (file, flash) and load
+ * it after restart. Contents are private, the certificates are accessible by `lt_cert_cache_get_store()`.
+ */
+typedef struct lt_cert_cache_t {
+    /** @private @brief LT_CERT_CACHE_MAGIC if the cache is filled. */
+    uint32_t magic;
+    /** @private @brief LT_CERT_CACHE_VERSION. */
+    uint16_t version;
+    /** @private @brief CRC16 of the fields below. */
+    uint16_t crc;
+    /** @private @brief CHIP_ID of the TROPIC01 the cache was filled from. */
+    struct lt_chip_id_t chip_id;
+    /** @private @brief STPUB parsed from the device certificate. */
+    uint8_t stpub[TR01_STPUB_LEN];
+    /** @private @brief Lengths of the certificates. */
+    uint16_t cert_len[LT_NUM_CERTIFICATES];
+    /** @private @brief Certificates of the certificate store. */
+    uint8_t certs[LT_NUM_CERTIFICATES][TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE];
+} lt_cert_cache_t;
+#endif
+
+#ifdef LT_PAIRING_KEY_CACHE
+/** Number of pairing key slots kept by the pairing key cache. */
+#define LT_PAIRING_KEY_CACHE_SLOTS (TR01_PAIRING_KEY_SLOT_INDEX_3 + 1)
+
+/**
+ * @brief Provides pairing keys of one slot to the pairing key cache, see `lt_pairing_key_cache_init()`.
+ * @details Called once per slot until the slot is forgotten. Typically unwraps the private key stored encrypted, derives
+ * it from a passphrase (PBKDF2), or takes it from an OS keyring or a TPM.
+ *
+ * @param ctx         Context passed to `lt_pairing_key_cache_init()`
+ * @param pkey_index  Pairing key index
+ * @param shipriv     Host's private pairing key, TR01_SHIPRIV_LEN bytes to be written
+ * @param shipub      Host's public pairing key, TR01_SHIPUB_LEN bytes to be written
+ * @return            LT_OK if both keys were written, other value is returned by `lt_pairing_key_cache_get()`
+ */
+typedef lt_ret_t (*lt_pairing_key_unwrap_fn_t)(void *ctx, const lt_pkey_index_t pkey_index, uint8_t *shipriv,
+                                               uint8_t *shipub);
+
+/**
+ * @brief Pairing keys unwrapped by the application's provider, kept in memory so they are unwrapped only once (see
+ * `lt_pairing_key_cache_get()`). Contents are private and wiped by `lt_pairing_key_cache_deinit()`.
+ */
+typedef struct lt_pairing_key_cache_t {
+    /** @private @brief Provider of the pairing keys. */
+    lt_pairing_key_unwrap_fn_t unwrap;
+    /** @private @brief Context of the provider. */
+    void *unwrap_ctx;
+    /** @private @brief Bit i is set if keys of slot i are cached. */
+    uint8_t cached;
+    /** @private @brief Host's private pairing keys. */
+    uint8_t shipriv[LT_PAIRING_KEY_CACHE_SLOTS][TR01_SHIPRIV_LEN];
+    /** @private @brief Host's public pairing keys. */
+    uint8_t shipub[LT_PAIRING_KEY_CACHE_SLOTS][TR01_SHIPUB_LEN];
+} lt_pairing_key_cache_t;
+#endif
+
+#ifdef LT_CERT_CHAIN
+/** Length of the SHA-256 digests identifying the certificates of the chain. */
+#define LT_CERT_CHAIN_HASH_LEN 32
+
+/**
+ * @brief Signature algorithm of a certificate of the chain.
+ */
+typedef enum lt_cert_sig_alg_t {
+    LT_CERT_SIG_ECDSA_SHA256 = 0,
+    LT_CERT_SIG_ECDSA_SHA384 = 1,
+    LT_CERT_SIG_ECDSA_SHA512 = 2,
+    LT_CERT_SIG_ED25519 = 3
+} lt_cert_sig_alg_t;
+
+/**
+ * @brief Signature of one certificate of the chain, passed to `lt_cert_sig_verify_fn_t`. Pointers point into the
+ * certificate store.
+ */
+typedef struct lt_cert_sig_t {
+    /** @brief Signature algorithm of the certificate. */
+    lt_cert_sig_alg_t alg;
+    /** @brief Signed data, i.e. DER encoded TBSCertificate. */
+    const uint8_t *tbs;
+    /** @brief Length of the signed data. */
+    uint16_t tbs_len;
+    /** @brief ECDSA: DER encoded Ecdsa-Sig-Value (r, s). Ed25519: 64 B signature. */
+    const uint8_t *sig;
+    /** @brief Length of the signature. */
+    uint16_t sig_len;
+    /** @brief Public key of the issuer. ECDSA: uncompressed point (0x04 || X || Y). Ed25519: 32 B key. */
+    const uint8_t *pubkey;
+    /** @brief Length of the public key. */
+    uint16_t pubkey_len;
+    /** @brief ECDSA: contents of the OBJECT IDENTIFIER of the issuer's named curve. Ed25519: NULL. */
+    const uint8_t *curve_oid;
+    /** @brief Length of the curve OBJECT IDENTIFIER, 0 for Ed25519. */
+    uint16_t curve_oid_len;
+} lt_cert_sig_t;
+
+/**
+ * @brief Verifies signature of a certificate by the public key of its issuer, provided by the application (e.g.
+ * wrapping its crypto library), as the CAL implements no signature verification.
+ *
+ * @param sig  Signature, signed data and the issuer's public key
+ * @param ctx  User data passed to `lt_cert_chain_verify()`
+ * @retval     LT_OK Signature is valid
+ * @retval     other Signature is not valid or cannot be verified
+ */
+typedef lt_ret_t (*lt_cert_sig_verify_fn_t)(const lt_cert_sig_t *sig, void *ctx);
+
+/**
+ * @brief Trusted root and the CA certificates already verified to lead to it (see `lt_cert_chain_verify()`).
+ * @details The structure holds no pointers, so the application can persist it byte for byte. It must be stored
+ * where it cannot be modified by an attacker, same as the trusted root itself. Contents are private except for the
+ * counters.
+ */
+typedef struct lt_cert_chain_t {
+    /** @private @brief SHA-256 of the trusted root certificate. */
+    uint8_t root_hash[LT_CERT_CHAIN_HASH_LEN];
+    /** @private @brief SHA-256 of the CA certificates verified to lead to the root. */
+    uint8_t memo[LT_CERT_CHAIN_MEMO_SIZE][LT_CERT_CHAIN_HASH_LEN];
+    /** @private @brief Number of valid entries of memo. */
+    uint8_t memo_cnt;
+    /** @private @brief Entry of memo replaced next when it is full. */
+    uint8_t memo_next;
+    /** @public @brief Number of signatures verified. */
+    uint32_t sig_verifies;
+    /** @public @brief Number of CA certificates found in memo, i.e. verifications skipped. */
+    uint32_t memo_hits;
+} lt_cert_chain_t;
+#endif
+
+#ifdef LT_SESSION_CACHE
+#ifndef LT_SESSION_CACHE_EPH_KEYS
+/** Number of ephemeral key pairs prepared ahead in a session cache, power of two. */
+#define LT_SESSION_CACHE_EPH_KEYS 1
+#endif
+
+/**
+ * @brief Host MCU ephemeral key pair prepared for one handshake with TROPIC01 of a session cache (used internally).
+ */
+typedef struct lt_session_eph_t {
+    /** @private @brief Host MCU ephemeral keys. */
+    lt_host_eph_keys_t keys;
+    /** @private @brief Precomputed X25519(EHPRIV, STPUB). */
+    uint8_t eh_st_shared[TR01_X25519_KEY_LEN];
+} lt_session_eph_t;
+
+/**
+ * @brief Host-side data of Secure Channel Handshake, which do not depend on TROPIC01's ephemeral key, so they can
+ * be prepared ahead of the handshake (see `lt_session_cache_init()`).
+ * @details Ephemeral key pairs are kept in a single-producer single-consumer ring: `lt_session_cache_prepare()` adds
+ * them, the handshake takes them.
+ */
+typedef struct lt_session_cache_t {
+    /** @private @brief STPUB the cache was initialized for. */
+    uint8_t stpub[TR01_STPUB_LEN];
+    /** @private @brief SHiPUB the cache was initialized for. */
+    uint8_t shipub[TR01_SHIPUB_LEN];
+    /** @private @brief Transcript hash h = SHA256(SHA256(SHA256(protocol_name)||SHiPUB)||STPUB). */
+    uint8_t prefix_hash[32];
+    /** @private @brief Prepared ephemeral key pairs, never reused for two handshakes. */
+    lt_session_eph_t eph[LT_SESSION_CACHE_EPH_KEYS];
+    /** @private @brief Number of key pairs ever prepared (free running). */
+    uint8_t eph_head;
+    /** @private @brief Number of key pairs ever taken (free running). */
+    uint8_t eph_tail;
+    /** @private @brief Key pair sent in Handshake_Req, waiting for Handshake_Rsp. */
+    lt_session_eph_t eph_cur;
+    /** @private @brief True if eph_cur was sent in Handshake_Req and waits for Handshake_Rsp. */
+    bool eph_in_use;
+    /** @private @brief True if the cache was initialized. */
+    bool initialized;
+    /** @public @brief Number of handshakes which used prepared ephemeral keys. */
+    uint32_t hits;
+    /** @public @brief Number of handshakes which had to compute ephemeral keys on the fly. */
+    uint32_t misses;
+} lt_session_cache_t;
+#endif
+
+#ifdef LT_SESSION_MGR
+#ifndef LT_SESSION_MGR_QUEUE_LEN
+/** Max number of requests queued in the session manager. */
+#define LT_SESSION_MGR_QUEUE_LEN 16
+#endif
+/** Number of pairing key slots the session manager can switch between. */
+#define LT_SESSION_MGR_SLOTS (TR01_PAIRING_KEY_SLOT_INDEX_3 + 1)
+
+/**
+ * @brief Request executed by the session manager in Secure Session on its pairing key slot.
+ *
+ * @param h    Handle with Secure Session established on the pairing key slot of the request
+ * @param ctx  Context passed to `lt_session_mgr_submit()`
+ * @return     Result of the request, stored into `ret` passed to `lt_session_mgr_submit()`
+ */
+typedef lt_ret_t (*lt_session_mgr_fn_t)(lt_handle_t *h, void *ctx);
+
+/** @brief Pairing keys of one pairing key slot, see `lt_session_mgr_set_keys()`. */
+typedef struct lt_session_mgr_keys_t {
+    /** @private @brief Secure host private key, owned by the caller. */
+    const uint8_t *shipriv;
+    /** @private @brief Secure host public key, owned by the caller. */
+    const uint8_t *shipub;
+} lt_session_mgr_keys_t;
+
+/** @brief Request waiting in the session manager queue. */
+typedef struct lt_session_mgr_req_t {
+    /** @private @brief Function executing the request. */
+    lt_session_mgr_fn_t fn;
+    /** @private @brief Context passed to fn. */
+    void *ctx;
+    /** @private @brief Where to store the result, may be NULL. */
+    lt_ret_t *ret;
+    /** @private @brief Pairing key slot the request has to be executed on. */
+    uint8_t pkey_index;
+} lt_session_mgr_req_t;
+
+/** @brief Counters of the session manager, see `lt_session_mgr_get_stats()`. */
+typedef struct lt_session_mgr_stats_t {
+    /** @brief Number of executed requests. */
+    uint32_t requests;
+    /** @brief Number of batches, i.e. runs of requests executed in one Secure Session without a handshake. */
+    uint32_t batches;
+    /** @brief Number of Secure Channel Handshakes done by the manager. */
+    uint32_t handshakes;
+    /** @brief Number of handshakes which moved the Secure Session to a different pairing key slot. */
+    uint32_t switches;
+    /** @brief Number of failed handshakes. */
+    uint32_t handshake_errors;
+} lt_session_mgr_stats_t;
+
+/**
+ * @brief Session manager, which schedules requests of several pairing key slots onto the single Secure Session
+ * TROPIC01 supports (see `lt_session_mgr_init()`). Contents are private.
+ */
+typedef struct lt_session_mgr_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief STPUB of TROPIC01. */
+    uint8_t stpub[TR01_STPUB_LEN];
+    /** @private @brief Pairing keys, indexed by pairing key slot. */
+    lt_session_mgr_keys_t keys[LT_SESSION_MGR_SLOTS];
+    /** @private @brief Queued requests, in order of submission. */
+    lt_session_mgr_req_t queue[LT_SESSION_MGR_QUEUE_LEN];
+    /** @private @brief Number of queued requests. */
+    uint8_t queue_cnt;
+    /** @private @brief Pairing key slot of the Secure Session set up by the manager, LT_SESSION_MGR_SLOTS if none. */
+    uint8_t active;
+    /** @private @brief Counters. */
+    lt_session_mgr_stats_t stats;
+} lt_session_mgr_t;
+#endif
+
+#ifdef LT_IDLE_MGR
+/** @brief Policy of the idle manager, trading latency of the first request after idle time against power. */
+typedef struct lt_idle_policy_t {
+    /** @brief Idle time in milliseconds after which `lt_idle_poll()` puts TROPIC01 to sleep, 0 never. */
+    uint32_t idle_ms;
+    /** @brief Restore the Secure Session open before the sleep in `lt_idle_begin()` after the wake. */
+    bool restore_session;
+    /**
+     * @brief Prepare ephemeral keys in the session cache attached to the handle (`lt_session_cache_attach()` of
+     * `LT_SESSION_CACHE`) before going to sleep, so the restore does not generate the key pair after the wake.
+     */
+    bool prepare_cache;
+} lt_idle_policy_t;
+
+/** @brief Counters of the idle manager, see `lt_idle_get_stats()`. */
+typedef struct lt_idle_stats_t {
+    /** @brief Number of times TROPIC01 was put to sleep. */
+    uint32_t sleeps;
+    /** @brief Number of wakes by `lt_idle_begin()`. */
+    uint32_t wakes;
+    /** @brief Number of Secure Sessions restored after the wake. */
+    uint32_t restores;
+    /** @brief Number of failed restores. */
+    uint32_t restore_errors;
+    /** @brief Total time TROPIC01 spent sleeping in milliseconds, counted at the wakes. */
+    uint64_t slept_ms;
+} lt_idle_stats_t;
+
+/**
+ * @brief Idle manager, which puts TROPIC01 to sleep when the application does not use it (see `lt_idle_init()`).
+ * Contents are private.
+ */
+typedef struct lt_idle_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Policy. */
+    lt_idle_policy_t policy;
+    /** @private @brief STPUB of TROPIC01, owned by the caller, NULL if the session is not restored. */
+    const uint8_t *stpub;
+    /** @private @brief Secure host private key, owned by the caller. */
+    const uint8_t *shipriv;
+    /** @private @brief Secure host public key, owned by the caller. */
+    const uint8_t *shipub;
+    /** @private @brief Index of pairing public key. */
+    uint8_t pkey_index;
+    /** @private @brief Set between `lt_idle_begin()` and `lt_idle_end()`. */
+    uint8_t active;
+    /** @private @brief Set while TROPIC01 sleeps. */
+    uint8_t asleep;
+    /** @private @brief Set if the Secure Session was open when TROPIC01 was put to sleep. */
+    uint8_t session_lost;
+    /** @private @brief Time of the last activity, or of the sleep while TROPIC01 sleeps, from lt_port_time_us(). */
+    uint64_t last_us;
+    /** @private @brief Counters. */
+    lt_idle_stats_t stats;
+} lt_idle_t;
+#endif
+
+#ifdef LT_HEALTH
+/** @brief Counters of the health monitor, see `lt_health_get_stats()`. */
+typedef struct lt_health_stats_t {
+    /** @brief Number of checks by `lt_health_poll()`. */
+    uint32_t checks;
+    /** @brief Number of checks answered by a recent L3 Result, without any communication. */
+    uint32_t piggybacked;
+    /** @brief Number of Pings sent. */
+    uint32_t pings;
+    /** @brief Number of failed Pings. */
+    uint32_t ping_errors;
+    /** @brief Number of checks deferred because an L3 Command submitted by `lt_submit()` was in flight. */
+    uint32_t deferred;
+} lt_health_stats_t;
+
+/** @brief Health monitor of one TROPIC01 (see `lt_health_init()`). Contents are private. */
+typedef struct lt_health_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Monitoring period in milliseconds. */
+    uint32_t period_ms;
+    /** @private @brief Counters. */
+    lt_health_stats_t stats;
+} lt_health_t;
+#endif
+
+#ifdef LT_SCHED
+#ifndef LT_SCHED_QUEUE_LEN
+/** Max number of jobs queued in the scheduler. */
+#define LT_SCHED_QUEUE_LEN 16
+#endif
+
+/** @brief Priority classes of the scheduler, lower value goes first. */
+typedef enum lt_sched_prio_t {
+    /** @brief Latency-critical jobs, e.g. signing. */
+    LT_SCHED_PRIO_URGENT = 0,
+    /** @brief Ordinary jobs. */
+    LT_SCHED_PRIO_NORMAL,
+    /** @brief Bulk jobs, e.g. R-mem reads, certificate fetches or firmware chunks. */
+    LT_SCHED_PRIO_BULK,
+    /** @brief Number of priority classes. */
+    LT_SCHED_PRIOS
+} lt_sched_prio_t;
+
+/**
+ * @brief Step of a job executed by the scheduler. One step should do at most one L2 Request or one L3 Command, the
+ * scheduler can switch to a job of higher priority only between the steps.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param ctx   Context passed to `lt_sched_submit()`
+ * @param done  Set to true before the call, the step sets it to false when the job has further steps
+ * @return      Result of the step, the job finishes on error and the result is stored into `ret` passed to
+ *              `lt_sched_submit()`
+ */
+typedef lt_ret_t (*lt_sched_fn_t)(lt_handle_t *h, void *ctx, bool *done);
+
+/** @brief Job waiting in the scheduler queue. */
+typedef struct lt_sched_job_t {
+    /** @private @brief Function executing steps of the job. */
+    lt_sched_fn_t fn;
+    /** @private @brief Context passed to fn. */
+    void *ctx;
+    /** @private @brief Where to store the result, may be NULL. */
+    lt_ret_t *ret;
+    /** @private @brief Priority class, one of lt_sched_prio_t. */
+    uint8_t prio;
+    /** @private @brief Set once the first step was executed. */
+    uint8_t started;
+} lt_sched_job_t;
+
+/** @brief Counters of the scheduler, see `lt_sched_get_stats()`. */
+typedef struct lt_sched_stats_t {
+    /** @brief Number of finished jobs per priority class. */
+    uint32_t jobs[LT_SCHED_PRIOS];
+    /** @brief Number of executed steps. */
+    uint32_t steps;
+    /** @brief Number of times a started job was overtaken by a job of higher priority. */
+    uint32_t preemptions;
+} lt_sched_stats_t;
+
+/** @brief Scheduler of jobs for one TROPIC01 (see `lt_sched_init()`). Contents are private. */
+typedef struct lt_sched_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Queued jobs, in order of submission. */
+    lt_sched_job_t queue[LT_SCHED_QUEUE_LEN];
+    /** @private @brief Number of queued jobs. */
+    uint8_t queue_cnt;
+    /** @private @brief Counters. */
+    lt_sched_stats_t stats;
+} lt_sched_t;
+#endif
 //--------------------------------------------------------------------------------------------------------------------//
 /** @brief Basic sleep mode */
 #define TR01_L2_SLEEP_KIND_SLEEP 0x05
@@ -1112,14 +3020,625 @@ typedef struct lt_config_obj_desc_t {
     enum lt_config_obj_addr_t addr;
 } lt_config_obj_desc_t;
 
-/** @brief Number of configuration objects in lt_config_t */
-#define LT_CONFIG_OBJ_CNT 27
-
 /** @brief Structure to hold all configuration objects */
 typedef struct lt_config_t {
     uint32_t obj[LT_CONFIG_OBJ_CNT];
 } lt_config_t;
 
+#if defined(LT_ECDSA_SIGN_STREAM) || defined(LT_EDDSA_SIGN_STREAM)
+/**
+ * @brief Reads next part of a message signed by `lt_ecdsa_sign_read()`, `lt_ecdsa_sign_batch()` or
+ * `lt_eddsa_sign_read()`.
+ *
+ * @param reader_ctx  Context passed with the callback
+ * @param buf         Buffer for the data
+ * @param buf_len     Size of buf
+ * @param read_len    Number of bytes read is returned here, 0 at the end of the message
+ * @return            LT_OK if success, otherwise signing is stopped and the error returned.
+ */
+typedef lt_ret_t (*lt_ecdsa_sign_reader_t)(void *reader_ctx, uint8_t *buf, const size_t buf_len, size_t *read_len);
+#endif
+
+#ifdef LT_ECDSA_SIGN_STREAM
+
+/** @brief ECDSA signing of a message hashed part by part (see `lt_ecdsa_sign_init()`). Contents are private. */
+typedef struct lt_ecdsa_sign_t {
+    /** @private @brief Handle for communication with TROPIC01, its crypto context hashes the message. */
+    lt_handle_t *h;
+    /** @private @brief ECC key slot. */
+    uint8_t slot;
+    /** @private @brief Set while the message is being hashed. */
+    uint8_t active;
+} lt_ecdsa_sign_t;
+
+/** @brief Message signed by `lt_ecdsa_sign_batch()`. */
+typedef struct lt_ecdsa_sign_doc_t {
+    /** @public @brief Passed to the reader callback when reading this message. */
+    void *reader_ctx;
+    /** @public @brief Signature of the message is returned here, 64 B. */
+    uint8_t *rs;
+} lt_ecdsa_sign_doc_t;
+#endif
+
+#ifdef LT_EDDSA_SIGN_STREAM
+/** @brief EdDSA signing of a message prehashed part by part (see `lt_eddsa_sign_init()`). Contents are private. */
+typedef struct lt_eddsa_sign_t {
+    /** @private @brief Handle for communication with TROPIC01, its crypto context hashes the message. */
+    lt_handle_t *h;
+    /** @private @brief ECC key slot. */
+    uint8_t slot;
+    /** @private @brief Set while the message is being hashed. */
+    uint8_t active;
+} lt_eddsa_sign_t;
+#endif
+
+#ifdef LT_ED25519_VERIFY
+/** @brief One signature checked by `lt_ed25519_verify_batch()`. */
+typedef struct lt_ed25519_verify_t {
+    /** @brief Ed25519 public key (32B). */
+    const uint8_t *pubkey;
+    /** @brief Signed message. */
+    const uint8_t *msg;
+    /** @brief Length of the message. */
+    size_t msg_len;
+    /** @brief Signature R||S (64B). */
+    const uint8_t *signature;
+    /** @brief Set by `lt_ed25519_verify_batch()` to true if the signature is valid. */
+    bool valid;
+} lt_ed25519_verify_t;
+#endif
+
+#ifdef LT_CRYPTO_OPS
+/**
+ * @brief Functions of one CAL linked with `LT_CRYPTO_OPS`, e.g. `lt_crypto_ops_openssl`. Members have the signatures
+ * of the CAL functions declared in `src/lt_*.h`, the context taken by them is the context of the CAL.
+ */
+typedef struct lt_crypto_ops_t {
+    /** @brief Name of the CAL, e.g. "openssl". */
+    const char *name;
+    lt_ret_t (*crypto_ctx_init)(void *ctx);
+    lt_ret_t (*crypto_ctx_deinit)(void *ctx);
+    lt_ret_t (*aesgcm_encrypt_init)(void *ctx, const uint8_t *key, const uint32_t key_len);
+    lt_ret_t (*aesgcm_decrypt_init)(void *ctx, const uint8_t *key, const uint32_t key_len);
+    lt_ret_t (*aesgcm_encrypt)(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                               const uint32_t add_len, const uint8_t *plaintext, const uint32_t plaintext_len,
+                               uint8_t *ciphertext, const uint32_t ciphertext_len);
+    lt_ret_t (*aesgcm_decrypt)(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                               const uint32_t add_len, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                               uint8_t *plaintext, const uint32_t plaintext_len);
+#ifdef LT_L3_STREAM_ENCRYPT
+    lt_ret_t (*aesgcm_encrypt_start)(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                     const uint32_t add_len);
+    lt_ret_t (*aesgcm_encrypt_update)(void *ctx, const uint8_t *plaintext, const uint32_t plaintext_len,
+                                      uint8_t *ciphertext);
+    lt_ret_t (*aesgcm_encrypt_finish)(void *ctx, uint8_t *tag, const uint32_t tag_len);
+#endif
+#ifdef LT_L3_STREAM_DECRYPT
+    lt_ret_t (*aesgcm_decrypt_start)(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                     const uint32_t add_len);
+    lt_ret_t (*aesgcm_decrypt_update)(void *ctx, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                                      uint8_t *plaintext);
+    lt_ret_t (*aesgcm_decrypt_finish)(void *ctx, const uint8_t *tag, const uint32_t tag_len);
+#endif
+    lt_ret_t (*aesgcm_encrypt_deinit)(void *ctx);
+    lt_ret_t (*aesgcm_decrypt_deinit)(void *ctx);
+    lt_ret_t (*sha256_init)(void *ctx);
+    lt_ret_t (*sha256_start)(void *ctx);
+    lt_ret_t (*sha256_update)(void *ctx, const uint8_t *input, const size_t input_len);
+    lt_ret_t (*sha256_finish)(void *ctx, uint8_t *output);
+    lt_ret_t (*sha256_deinit)(void *ctx);
+    lt_ret_t (*hmac_sha256)(const uint8_t *key, const uint32_t key_len, const uint8_t *input,
+                            const uint32_t input_len, uint8_t *output);
+    lt_ret_t (*hmac_sha256_init)(void *ctx, const uint8_t *key, const uint32_t key_len);
+    lt_ret_t (*hmac_sha256_compute)(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output);
+    lt_ret_t (*hmac_sha256_deinit)(void *ctx);
+    lt_ret_t (*X25519)(const uint8_t *privkey, const uint8_t *pubkey, uint8_t *secret);
+    lt_ret_t (*X25519_scalarmult)(const uint8_t *sk, uint8_t *pk);
+#ifdef LT_ED25519_VERIFY
+    lt_ret_t (*ed25519_verify_batch)(lt_ed25519_verify_t *items, const size_t count);
+#endif
+} lt_crypto_ops_t;
+
+/**
+ * @brief Crypto context of the handle with `LT_CRYPTO_OPS`, assigned to `crypto_ctx` of `lt_handle_t` and set by
+ * `lt_crypto_ops_set()` or `lt_crypto_ops_probe()`. Contents are private.
+ */
+typedef struct lt_crypto_ops_ctx_t {
+    /** @private @brief Functions of the selected CAL. */
+    const lt_crypto_ops_t *ops;
+    /** @private @brief Context of the selected CAL, e.g. `lt_ctx_openssl_t`. */
+    void *ctx;
+} lt_crypto_ops_ctx_t;
+
+/** @brief Candidate CAL compared by `lt_crypto_ops_probe()`. */
+typedef struct lt_crypto_backend_t {
+    /** @public @brief Functions of the CAL. */
+    const lt_crypto_ops_t *ops;
+    /** @public @brief Context of the CAL used when it is selected. */
+    void *ctx;
+    /** @public @brief Set by `lt_crypto_ops_probe()` to the duration of the probe in microseconds, 0 if it failed. */
+    uint32_t probe_us;
+} lt_crypto_backend_t;
+#endif
+
+#ifdef LT_PIN
+/** @brief Minimal length of the PIN accepted by `lt_pin_setup()` and `lt_pin_verify()`. */
+#define LT_PIN_LEN_MIN 4u
+/** @brief Maximal length of the PIN accepted by `lt_pin_setup()` and `lt_pin_verify()`. */
+#define LT_PIN_LEN_MAX 32u
+/** @brief Maximal length of the additional data mixed into the PIN (e.g. HW ID). */
+#define LT_PIN_ADD_LEN_MAX 128u
+/** @brief Maximal number of PIN attempts, their data fit into the smallest User Data slot of R-Memory (444 B). */
+#define LT_PIN_ROUNDS_MAX 12u
+/** @brief Length of the key released by `lt_pin_setup()` and `lt_pin_verify()`. */
+#define LT_PIN_KEY_LEN 32u
+
+/**
+ * @brief PIN verification engine based on MAC-and-Destroy (see `lt_pin_init()`). Contents are private.
+ */
+typedef struct lt_pin_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief User Data slot of R-Memory holding the attempt counter and encrypted secret. */
+    uint16_t r_mem_slot;
+    /** @private @brief First Mac-and-Destroy slot, one slot is used per attempt. */
+    uint8_t macandd_slot;
+    /** @private @brief Number of PIN attempts. */
+    uint8_t rounds;
+    /** @private @brief Set if key holds the key released in the Secure Session session_cnt. */
+    uint8_t cached;
+    /** @private @brief Secure Session in which the key was released. */
+    uint32_t session_cnt;
+    /** @private @brief Tag of the PIN and additional data the key was released for. */
+    uint8_t pin_tag[LT_PIN_KEY_LEN];
+    /** @private @brief Released key. */
+    uint8_t key[LT_PIN_KEY_LEN];
+} lt_pin_t;
+#endif
+
+#ifdef LT_MCOUNTER_CACHE
+/**
+ * @brief Monotonic counter with the value cached on the host (see `lt_mcounter_open()`). Contents are private.
+ */
+typedef struct lt_mcounter_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Index of the monotonic counter. */
+    uint8_t index;
+    /** @private @brief Set if value holds the value of the counter in the Secure Session session_cnt. */
+    uint8_t cached;
+    /** @private @brief Secure Session in which the value was read. */
+    uint32_t session_cnt;
+    /** @private @brief Cached value of the counter. */
+    uint32_t value;
+} lt_mcounter_t;
+#endif
+
+#ifdef LT_R_MEM_MAP
+/** @brief Number of R-mem user data slots covered by the occupancy map. */
+#define LT_R_MEM_MAP_SLOTS (TR01_R_MEM_DATA_SLOT_MAX + 1)
+/** @brief Number of 32-bit words of a bitmap of the occupancy map. */
+#define LT_R_MEM_MAP_WORDS (LT_R_MEM_MAP_SLOTS / 32)
+
+/**
+ * @brief Occupancy map of R-mem user data slots (see `lt_r_mem_map_attach()`). Contents are private.
+ * @details Summary of the map is kept in one R-mem slot, stamped with the value of a monotonic counter. The counter
+ *          is decremented before the first change of R-mem after the summary was written, so the summary is current
+ *          only if its stamp equals the counter.
+ */
+typedef struct lt_r_mem_map_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief R-mem slot holding the summary of the map. */
+    uint16_t summary_slot;
+    /** @private @brief Index of the monotonic counter versioning the summary. */
+    uint8_t mcounter_index;
+    /** @private @brief State of the summary in R-mem (LT_R_MEM_MAP_SUMMARY_*). */
+    uint8_t summary;
+    /** @private @brief Set once the summary was read in the Secure Session session_cnt. */
+    uint8_t loaded;
+    /** @private @brief Secure Session the map belongs to. */
+    uint32_t session_cnt;
+    /** @private @brief Number of slots with unknown occupancy. */
+    uint16_t unknown;
+    /** @private @brief Next slot looked at by the background scan. */
+    uint16_t scan_next;
+    /** @private @brief Slots with known occupancy. */
+    uint32_t known[LT_R_MEM_MAP_WORDS];
+    /** @private @brief Slots holding data, valid for known slots. */
+    uint32_t occupied[LT_R_MEM_MAP_WORDS];
+    /** @public @brief Number of R_Mem_Data_Read commands sent to find out occupancy of a slot. */
+    uint32_t probes;
+    /** @public @brief Number of times the whole map was taken from a current summary. */
+    uint32_t loads;
+} lt_r_mem_map_t;
+#endif
+
+#ifdef LT_ECC_KEY_POOL
+#ifndef LT_ECC_KEY_POOL_SIZE
+/** Max number of ECC key slots managed by one key pool. */
+#define LT_ECC_KEY_POOL_SIZE 4
+#endif
+/** @brief Length of the public keys kept by the key pool, fits both curves. */
+#define LT_ECC_KEY_POOL_PUBKEY_LEN 64
+
+/** @brief ECC key slot of a key pool, see `lt_ecc_key_pool_t`. Contents are private. */
+typedef struct lt_ecc_key_pool_entry_t {
+    /** @private @brief ECC key slot. */
+    uint8_t slot;
+    /** @private @brief Next step of the slot (LT_ECC_KEY_POOL_*). */
+    uint8_t state;
+    /** @private @brief Public key of the generated key, valid once the slot is ready. */
+    uint8_t pubkey[LT_ECC_KEY_POOL_PUBKEY_LEN];
+} lt_ecc_key_pool_entry_t;
+
+/**
+ * @brief Pool of ECC key slots holding keys generated ahead of time (see `lt_ecc_key_pool_init()`). Contents are
+ * private.
+ */
+typedef struct lt_ecc_key_pool_t {
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Curve of the generated keys. */
+    uint8_t curve;
+    /** @private @brief Number of slots in the pool. */
+    uint8_t count;
+    /** @private @brief Slots of the pool, in order of addition. */
+    lt_ecc_key_pool_entry_t entries[LT_ECC_KEY_POOL_SIZE];
+    /** @public @brief Number of keys handed out ready, without an L3 Command. */
+    uint32_t hits;
+    /** @public @brief Number of keys which had to be generated when handed out, because no key was ready. */
+    uint32_t misses;
+} lt_ecc_key_pool_t;
+#endif
+
+#ifdef LT_SUBMIT
+/** @brief L3 operations executed by `lt_submit()` and `lt_complete()`. */
+typedef enum lt_cmd_type_t {
+    LT_CMD_PING = 0,
+    LT_CMD_PAIRING_KEY_WRITE,
+    LT_CMD_PAIRING_KEY_READ,
+    LT_CMD_PAIRING_KEY_INVALIDATE,
+    LT_CMD_R_CONFIG_WRITE,
+    LT_CMD_R_CONFIG_READ,
+    LT_CMD_R_CONFIG_ERASE,
+    LT_CMD_I_CONFIG_WRITE,
+    LT_CMD_I_CONFIG_READ,
+    LT_CMD_R_MEM_DATA_WRITE,
+    LT_CMD_R_MEM_DATA_READ,
+    LT_CMD_R_MEM_DATA_ERASE,
+    LT_CMD_RANDOM_VALUE_GET,
+    LT_CMD_ECC_KEY_GENERATE,
+    LT_CMD_ECC_KEY_STORE,
+    LT_CMD_ECC_KEY_READ,
+    LT_CMD_ECC_KEY_ERASE,
+    LT_CMD_ECC_ECDSA_SIGN,
+    LT_CMD_ECC_EDDSA_SIGN,
+    LT_CMD_MCOUNTER_INIT,
+    LT_CMD_MCOUNTER_UPDATE,
+    LT_CMD_MCOUNTER_GET,
+    LT_CMD_MAC_AND_DESTROY
+} lt_cmd_type_t;
+
+/**
+ * @brief L3 operation with its arguments, see `lt_submit()`.
+ * @details The member of `args` named after `type` holds arguments of the libtropic function of the same name, e.g.
+ * `args.ping` those of `lt_ping()`. Input buffers have to stay valid until `lt_submit()` returns, output buffers until
+ * `lt_complete()` returns.
+ */
+typedef struct lt_cmd_t {
+    /** @public @brief Operation to execute. */
+    lt_cmd_type_t type;
+    /** @public @brief Arguments of the operation. */
+    union {
+        struct {
+            const uint8_t *msg_out;
+            uint8_t *msg_in;
+            uint16_t msg_len;
+        } ping;
+        struct {
+            const uint8_t *pairing_pub;
+            uint8_t slot;
+        } pairing_key_write;
+        struct {
+            uint8_t *pairing_pub;
+            uint8_t slot;
+        } pairing_key_read;
+        struct {
+            uint8_t slot;
+        } pairing_key_invalidate;
+        struct {
+            enum lt_config_obj_addr_t addr;
+            uint32_t obj;
+        } r_config_write;
+        struct {
+            enum lt_config_obj_addr_t addr;
+            uint32_t *obj;
+        } r_config_read;
+        struct {
+            enum lt_config_obj_addr_t addr;
+            uint8_t bit_index;
+        } i_config_write;
+        struct {
+            enum lt_config_obj_addr_t addr;
+            uint32_t *obj;
+        } i_config_read;
+        struct {
+            const uint8_t *data;
+            uint16_t udata_slot;
+            uint16_t data_size;
+        } r_mem_data_write;
+        struct {
+            uint8_t *data;
+            uint16_t *data_read_size;
+            uint16_t udata_slot;
+            uint16_t data_max_size;
+        } r_mem_data_read;
+        struct {
+            uint16_t udata_slot;
+        } r_mem_data_erase;
+        struct {
+            uint8_t *rnd_bytes;
+            uint16_t rnd_bytes_cnt;
+        } random_value_get;
+        struct {
+            lt_ecc_slot_t slot;
+            lt_ecc_curve_type_t curve;
+        } ecc_key_generate;
+        struct {
+            const uint8_t *key;
+            lt_ecc_slot_t slot;
+            lt_ecc_curve_type_t curve;
+        } ecc_key_store;
+        struct {
+            uint8_t *key;
+            lt_ecc_curve_type_t *curve;
+            lt_ecc_key_origin_t *origin;
+            lt_ecc_slot_t slot;
+            uint8_t key_max_size;
+        } ecc_key_read;
+        struct {
+            lt_ecc_slot_t slot;
+        } ecc_key_erase;
+        struct {
+            const uint8_t *msg;
+            uint8_t *rs;
+            uint32_t msg_len;
+            lt_ecc_slot_t slot;
+        } ecc_ecdsa_sign;
+        struct {
+            const uint8_t *msg;
+            uint8_t *rs;
+            uint16_t msg_len;
+            lt_ecc_slot_t slot;
+        } ecc_eddsa_sign;
+        struct {
+            enum lt_mcounter_index_t mcounter_index;
+            uint32_t mcounter_value;
+        } mcounter_init;
+        struct {
+            enum lt_mcounter_index_t mcounter_index;
+        } mcounter_update;
+        struct {
+            uint32_t *mcounter_value;
+            enum lt_mcounter_index_t mcounter_index;
+        } mcounter_get;
+        struct {
+            const uint8_t *data_out;
+            uint8_t *data_in;
+            lt_mac_and_destroy_slot_t slot;
+        } mac_and_destroy;
+    } args;
+} lt_cmd_t;
+
+#ifdef LT_L2_ASYNC
+struct lt_l2_async_t;
+#endif
+#endif
+
+#ifdef LT_BULK_ERASE
+/** @brief Number of 32-bit words of the bitmap of R-mem user data slots of a bulk erase. */
+#define LT_BULK_ERASE_R_MEM_WORDS ((TR01_R_MEM_DATA_SLOT_MAX + 1 + 31) / 32)
+
+/** @brief Kinds of slots of a bulk erase, see `lt_bulk_erase_progress_t`. */
+typedef enum lt_bulk_erase_kind_t {
+    LT_BULK_ERASE_R_MEM = 0, /**< R-mem user data slot, erased by R_Mem_Data_Erase */
+    LT_BULK_ERASE_ECC,       /**< ECC key slot, erased by ECC_Key_Erase */
+    LT_BULK_ERASE_PAIRING    /**< Pairing key slot, invalidated by Pairing_Key_Invalidate */
+} lt_bulk_erase_kind_t;
+
+/**
+ * @brief Reports progress of the bulk erase after each erased slot.
+ * @details Called while TROPIC01 erases the next slot, it must not use the handle the bulk erase runs on.
+ *
+ * @param cb_ctx  User data passed to `lt_bulk_erase()`
+ * @param kind    Kind of the slot
+ * @param slot    Slot of the kind: R-mem user data slot, `lt_ecc_slot_t` or pairing key slot index
+ * @param ret     Result of the erase of the slot
+ * @param done    Number of slots handled so far, including slots known to be empty
+ * @param total   Number of slots selected when `lt_bulk_erase()` was called
+ */
+typedef void (*lt_bulk_erase_progress_t)(void *cb_ctx, lt_bulk_erase_kind_t kind, uint16_t slot, lt_ret_t ret,
+                                         uint16_t done, uint16_t total);
+
+/**
+ * @brief Slots erased by `lt_bulk_erase()`, bit i of a bitmap selects slot i.
+ * @details Bits of the slots which were erased or known to be empty are cleared by `lt_bulk_erase()`, slots which
+ * failed stay selected, so the same set can be passed again, e.g. in the next Secure Session.
+ */
+typedef struct lt_bulk_erase_set_t {
+    /** @public @brief R-mem user data slots, slot i is bit i % 32 of word i / 32. */
+    uint32_t r_mem[LT_BULK_ERASE_R_MEM_WORDS];
+    /** @public @brief ECC key slots, slot TR01_ECC_SLOT_0 + i is bit i. */
+    uint32_t ecc;
+    /** @public @brief Pairing key slots, slot TR01_PAIRING_KEY_SLOT_INDEX_0 + i is bit i. */
+    uint8_t pairing;
+    /** @public @brief Number of erase commands sent. */
+    uint16_t sent;
+    /** @public @brief Number of slots skipped because they were known to be empty (or invalidated). */
+    uint16_t skipped;
+} lt_bulk_erase_set_t;
+#endif
+
+#ifdef LT_PROVISION
+#ifndef LT_PROVISION_MAX_DEVICES
+/** Max number of TROPIC01 devices provisioned by one provisioning station. */
+#define LT_PROVISION_MAX_DEVICES 4
+#endif
+/** @brief Max number of ECC keys of a provisioning profile, one per ECC key slot. */
+#define LT_PROVISION_MAX_KEYS (TR01_ECC_SLOT_31 + 1)
+/** @brief Length of a public key reported by the provisioning station, fits both curves. */
+#define LT_PROVISION_PUBKEY_LEN 64
+
+/** @brief ECC key generated by the provisioning profile. */
+typedef struct lt_provision_key_t {
+    /** @public @brief ECC key slot. */
+    lt_ecc_slot_t slot;
+    /** @public @brief Curve of the key. */
+    lt_ecc_curve_type_t curve;
+} lt_provision_key_t;
+
+/**
+ * @brief Declarative provisioning profile, i.e. the state TROPIC01 devices are brought to (see
+ * `lt_provision_add_device()`). One profile is shared by all devices, it is not copied.
+ */
+typedef struct lt_provision_profile_t {
+    /** @public @brief Host public pairing keys of the slots, NULL to leave the slot as it is. */
+    const uint8_t *pairing_pub[TR01_PAIRING_KEY_SLOT_INDEX_3 + 1];
+    /** @public @brief Whole R-config, NULL to leave R-config as it is. */
+    const struct lt_config_t *r_config;
+    /** @public @brief Whole I-config, NULL to leave I-config as it is. */
+    const struct lt_config_t *i_config;
+    /** @public @brief ECC keys generated in their slots. */
+    const lt_provision_key_t *keys;
+    /** @public @brief Number of ECC keys, 0-`LT_PROVISION_MAX_KEYS`. */
+    uint8_t key_cnt;
+} lt_provision_profile_t;
+
+/**
+ * @brief Called when provisioning of a device finishes.
+ *
+ * @param h       Handle of the device
+ * @param ret     LT_OK if the device matches the profile and it was verified by readback, otherwise error code
+ * @param cb_ctx  User data passed to `lt_provision_add_device()`
+ */
+typedef void (*lt_provision_cb_t)(lt_handle_t *h, lt_ret_t ret, void *cb_ctx);
+
+struct lt_provision_t;
+
+/** @brief TROPIC01 device of the provisioning station. */
+typedef struct lt_provision_dev_t {
+    /** @private @brief R-config read from the device, kept up to date by the writes. */
+    struct lt_config_t r_cur;
+    /** @private @brief I-config read from the device, kept up to date by the writes. */
+    struct lt_config_t i_cur;
+    /** @private @brief Public key or pairing key read back from the device. */
+    uint8_t key[LT_PROVISION_PUBKEY_LEN];
+    /** @private @brief L3 operation in flight. */
+    lt_cmd_t cmd;
+    /** @private @brief Station the device belongs to. */
+    struct lt_provision_t *p;
+    /** @private @brief Handle for communication with TROPIC01. */
+    lt_handle_t *h;
+    /** @private @brief Asynchronous L2 operation of the device. */
+    struct lt_l2_async_t *op;
+    /** @private @brief Public keys of the profile keys, LT_PROVISION_PUBKEY_LEN bytes each, may be NULL. */
+    uint8_t *pubkeys;
+    /** @private @brief Completion callback, may be NULL. */
+    lt_provision_cb_t cb;
+    /** @private @brief User data for the callback. */
+    void *cb_ctx;
+    /** @private @brief Value of a configuration object read back from the device. */
+    uint32_t obj;
+    /** @private @brief Curve of the ECC key read back from the device. */
+    lt_ecc_curve_type_t curve;
+    /** @private @brief Origin of the ECC key read back from the device. */
+    lt_ecc_key_origin_t origin;
+    /** @private @brief R-config objects written, bit i is object i of cfg_desc_table. */
+    uint32_t r_write;
+    /** @private @brief I-config objects with a bit written, bit i is object i of cfg_desc_table. */
+    uint32_t i_write;
+    /** @private @brief Profile keys generated, bit i is key i of the profile. */
+    uint32_t ecc_write;
+    /** @private @brief Pairing key slots written. */
+    uint8_t pairing_write;
+    /** @private @brief R-config has to be erased before it is written. */
+    bool r_erase;
+    /** @private @brief Operation in cmd is in flight. */
+    bool submitted;
+    /** @private @brief Phase of the operation in cmd. */
+    uint8_t phase;
+    /** @private @brief Position of the operation in cmd within its phase. */
+    uint16_t pos;
+    /** @private @brief Number of L3 Commands sent to the device. */
+    uint16_t sent;
+    /** @private @brief Number of configuration objects, pairing keys and ECC keys found as in the profile. */
+    uint16_t skipped;
+    /** @private @brief Result of the provisioning, LT_L1_CHIP_BUSY while in progress. */
+    lt_ret_t ret;
+} lt_provision_dev_t;
+
+/**
+ * @brief Provisioning station bringing several TROPIC01 devices to one profile (see `lt_provision_init()`). Contents
+ * are private.
+ */
+typedef struct lt_provision_t {
+    /** @private @brief Devices. */
+    lt_provision_dev_t devs[LT_PROVISION_MAX_DEVICES];
+    /** @private @brief Profile of all devices. */
+    const lt_provision_profile_t *profile;
+    /** @private @brief Number of devices. */
+    uint8_t dev_cnt;
+    /** @private @brief Number of L2 frames transferred to all devices, tells lt_provision_run() whether to wait. */
+    uint16_t steps;
+} lt_provision_t;
+#endif
+
+#ifdef LT_RING
+#ifndef LT_RING_CACHE_LINE
+/** Size of the cache line, the positions of the producers and of the consumer of a ring are kept this far apart. */
+#define LT_RING_CACHE_LINE 64
+#endif
+
+/** @brief Slot of the multi-producer ring, see `lt_mpsc_ring_init()`. Contents are private. */
+typedef struct lt_mpsc_slot_t {
+    /** @private @brief Position of the ring the slot is free or full for, accessed atomically. */
+    uint32_t seq;
+    /** @private @brief Item in the slot. */
+    void *item;
+} lt_mpsc_slot_t;
+
+/**
+ * @brief Bounded lock-free ring of pointers from many producers to one consumer (see `lt_mpsc_ring_init()`), e.g.
+ * submission of requests to the task owning a device. Contents are private.
+ */
+typedef struct lt_mpsc_ring_t {
+    /** @private @brief Position of the next pushed item, accessed atomically by the producers. */
+    uint32_t enq_pos __attribute__((aligned(LT_RING_CACHE_LINE)));
+    /** @private @brief Position of the next popped item, used by the consumer only. */
+    uint32_t deq_pos __attribute__((aligned(LT_RING_CACHE_LINE)));
+    /** @private @brief Slots, capacity is a power of two. */
+    lt_mpsc_slot_t *slots __attribute__((aligned(LT_RING_CACHE_LINE)));
+    /** @private @brief Capacity - 1. */
+    uint32_t mask;
+} lt_mpsc_ring_t;
+
+/**
+ * @brief Bounded lock-free ring of pointers from one producer to one consumer (see `lt_spsc_ring_init()`), e.g.
+ * completions of requests returned by the task owning a device. Contents are private.
+ */
+typedef struct lt_spsc_ring_t {
+    /** @private @brief Number of items ever pushed (free running), written by the producer only. */
+    uint32_t head __attribute__((aligned(LT_RING_CACHE_LINE)));
+    /** @private @brief Number of items ever popped (free running), written by the consumer only. */
+    uint32_t tail __attribute__((aligned(LT_RING_CACHE_LINE)));
+    /** @private @brief Items, capacity is a power of two. */
+    void **items __attribute__((aligned(LT_RING_CACHE_LINE)));
+    /** @private @brief Capacity - 1. */
+    uint32_t mask;
+} lt_spsc_ring_t;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,10 @@
 
 #include "libtropic_common.h"
 
+#ifdef LT_L2_ASYNC
+#include <stdbool.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -73,6 +77,36 @@ lt_ret_t lt_l2_receive(lt_l2_state_t *s2);
  */
 lt_ret_t lt_l2_send_encrypted_cmd(lt_l2_state_t *s2, uint8_t *buff, uint16_t buff_len);
 
+/**
+ * @brief Callback preparing a chunk of L3 packet in place right before it is sent, see
+ * `lt_l2_send_encrypted_cmd_stream()`.
+ *
+ * @param cb_ctx      Context passed with the callback
+ * @param chunk       Chunk of L3 packet in the buffer being sent
+ * @param len         Length of the chunk
+ * @return            LT_OK to send the chunk, otherwise sending is stopped and the error returned.
+ */
+typedef lt_ret_t (*lt_l2_tx_chunk_cb_t)(void *cb_ctx, uint8_t *chunk, const uint8_t len);
+
+#ifdef LT_L3_STREAM_ENCRYPT
+/**
+ * @brief Same as `lt_l2_send_encrypted_cmd()`, but each chunk is passed to the callback before it is sent. The next
+ * chunk is prepared while TROPIC01 processes the previous one.
+ * @note Only L3 size at the start of buff has to be valid before the first call of cb.
+ *
+ * @param s2          Structure holding l2 state
+ * @param buff        Buffer containing l3 command
+ * @param buff_len    Length of buff.
+ * @param cb          Called with each chunk in order, e.g. to encrypt it
+ * @param cb_ctx      Passed to cb
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully
+ */
+lt_ret_t lt_l2_send_encrypted_cmd_stream(lt_l2_state_t *s2, uint8_t *buff, uint16_t buff_len, lt_l2_tx_chunk_cb_t cb,
+                                         void *cb_ctx);
+#endif
+
 /**
  * @brief Receives encrypted L3 response over Layer 2.
  *
@@ -88,6 +122,174 @@ lt_ret_t lt_l2_send_encrypted_cmd(lt_l2_state_t *s2, uint8_t *buff, uint16_t buf
  */
 lt_ret_t lt_l2_recv_encrypted_res(lt_l2_state_t *s2, uint8_t *buff, uint16_t max_len);
 
+#ifdef LT_L3_STREAM_DECRYPT
+/**
+ * @brief Callback consuming chunks of encrypted L3 Result as they are received.
+ *
+ * @param cb_ctx      Context passed to `lt_l2_recv_encrypted_res_stream()`
+ * @param chunk       Chunk of L3 packet, valid only during the call
+ * @param len         Length of the chunk
+ * @return            LT_OK to continue receiving, otherwise the error is returned by
+ * `lt_l2_recv_encrypted_res_stream()`.
+ */
+typedef lt_ret_t (*lt_l2_chunk_cb_t)(void *cb_ctx, const uint8_t *chunk, const uint8_t len);
+
+/**
+ * @brief Receives encrypted L3 response over Layer 2 and passes each chunk to the callback, instead of assembling the
+ * whole packet in a buffer like `lt_l2_recv_encrypted_res()` does.
+ * @note Use only after secure session was established with `lt_session_start()`.
+ *
+ * @param s2          Structure holding l2 state
+ * @param cb          Called with each chunk of L3 packet in order
+ * @param cb_ctx      Passed to cb
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully
+ */
+lt_ret_t lt_l2_recv_encrypted_res_stream(lt_l2_state_t *s2, lt_l2_chunk_cb_t cb, void *cb_ctx);
+#endif
+
+#ifdef LT_L3_FAST_PATH
+/**
+ * @brief Returns position of L3 packet inside Encrypted_Cmd_Req L2 Request in handle's l2 buffer.
+ * @details L3 Command fitting into a single L2 chunk can be prepared and encrypted right there and sent by
+ * `lt_l2_transfer_encrypted_single()`, without the L3 buffer.
+ *
+ * @param s2          Structure holding l2 state
+ * @return            Pointer into s2->buff, room for TR01_L2_CHUNK_MAX_DATA_SIZE bytes.
+ */
+uint8_t *lt_l2_encrypted_cmd_chunk(lt_l2_state_t *s2);
+
+/**
+ * @brief Sends encrypted L3 Command prepared by `lt_l2_encrypted_cmd_chunk()` in a single L2 chunk and receives
+ * encrypted L3 Result, which must also fit into a single L2 chunk.
+ * @details L3 Result is left in handle's l2 buffer, it is valid only until the next L2 transfer.
+ * @note Use only after secure session was established with `lt_session_start()`.
+ *
+ * @param s2          Structure holding l2 state
+ * @param res         Position of encrypted L3 Result in s2->buff is returned here
+ * @param res_len     Length of encrypted L3 Result is returned here
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_L3_DATA_LEN_ERROR L3 Command does not fit into a single L2 chunk, nothing was sent
+ * @retval            LT_L2_RSP_LEN_ERROR L3 Result does not fit into a single L2 chunk
+ * @retval            other Function did not execute successully
+ */
+lt_ret_t lt_l2_transfer_encrypted_single(lt_l2_state_t *s2, uint8_t **res, uint8_t *res_len);
+#endif
+
+#ifdef LT_L2_ASYNC
+/**
+ * @brief States of asynchronous L2 operation.
+ */
+typedef enum lt_l2_async_state_t {
+    LT_L2_ASYNC_IDLE = 0,  /**< No operation in progress */
+    LT_L2_ASYNC_RSP,       /**< Waiting for L2 Response to a plain L2 Request */
+    LT_L2_ASYNC_CMD,       /**< Sending chunks of L3 Command, waiting for REQ_CONT/REQUEST_OK */
+    LT_L2_ASYNC_RES        /**< Receiving chunks of L3 Result */
+} lt_l2_async_state_t;
+
+struct lt_l2_async_t;
+
+/**
+ * @brief Called when asynchronous L2 operation finishes.
+ *
+ * @param op          Finished operation, may be reused for a new one right in the callback
+ * @param ret         LT_OK if the operation succeeded, otherwise error code
+ * @param cb_ctx      User data passed when the operation was started
+ */
+typedef void (*lt_l2_async_cb_t)(struct lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx);
+
+/**
+ * @brief Asynchronous L2 operation, one per TROPIC01 device. Contents are private, zero-initialize before first use.
+ */
+typedef struct lt_l2_async_t {
+    /** @private @brief L2 state of the device. */
+    lt_l2_state_t *s2;
+    /** @private @brief Completion callback, may be NULL. */
+    lt_l2_async_cb_t cb;
+    /** @private @brief User data for the callback. */
+    void *cb_ctx;
+    /** @private @brief L3 buffer. */
+    uint8_t *buff;
+    /** @private @brief Length of the L3 buffer. */
+    uint16_t buff_len;
+    /** @private @brief Size of the L3 Command packet. */
+    uint16_t packet_size;
+    /** @private @brief Position in the L3 buffer. */
+    uint16_t offset;
+    /** @private @brief Number of received L3 Result chunks. */
+    uint16_t loops;
+    /** @private @brief Current state, see lt_l2_async_state_t. */
+    lt_l2_async_state_t state;
+} lt_l2_async_t;
+
+/**
+ * @brief Starts asynchronous L2 Request, which is prepared in handle's internal L2 buffer (as for `lt_l2_send()`).
+ * @details Only the L2 Request is written here, the L2 Response is received by `lt_l2_async_process()`.
+ *
+ * @param op          Asynchronous L2 operation, must not be busy
+ * @param s2          Structure holding l2 state
+ * @param cb          Completion callback, may be NULL if `lt_l2_async_process()` return value is used instead
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Another operation is in progress on `op`
+ * @retval            other Function did not execute successully
+ */
+lt_ret_t lt_l2_async_send(lt_l2_async_t *op, lt_l2_state_t *s2, lt_l2_async_cb_t cb, void *cb_ctx);
+
+/**
+ * @brief Starts asynchronous L3 Command: sends the encrypted L3 Command and receives the encrypted L3 Result into the
+ * same buffer, as `lt_l2_send_encrypted_cmd()` followed by `lt_l2_recv_encrypted_res()` do.
+ * @details Only the first chunk is written here, the rest is done by `lt_l2_async_process()`. Prepare the command
+ * using `lt_out__*()` function and decode the result using `lt_in__*()` function once the operation is finished.
+ *
+ * @param op          Asynchronous L2 operation, must not be busy
+ * @param s2          Structure holding l2 state
+ * @param buff        Buffer containing encrypted l3 command, the encrypted l3 result will be stored here
+ * @param buff_len    Length of buff
+ * @param cb          Completion callback, may be NULL if `lt_l2_async_process()` return value is used instead
+ * @param cb_ctx      User data passed to the callback
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            LT_FAIL Another operation is in progress on `op`
+ * @retval            other Function did not execute successully
+ */
+lt_ret_t lt_l2_async_send_encrypted_cmd(lt_l2_async_t *op, lt_l2_state_t *s2, uint8_t *buff, uint16_t buff_len,
+                                        lt_l2_async_cb_t cb, void *cb_ctx);
+
+/**
+ * @brief Advances asynchronous L2 operation, never waits for TROPIC01.
+ * @details Call it when INT pin signalizes that TROPIC01 has a response ready (e.g. the INT GPIO file descriptor is
+ * readable on Linux), or periodically if INT pin is not used. Each call makes at most one attempt to read the
+ * L2 Response frame.
+ *
+ * @param op          Asynchronous L2 operation
+ *
+ * @retval            LT_L1_CHIP_BUSY Operation is still in progress
+ * @retval            LT_OK Operation finished successfully (callback was called)
+ * @retval            other Operation failed (callback was called), or it was not started
+ */
+lt_ret_t lt_l2_async_process(lt_l2_async_t *op);
+
+/**
+ * @brief Checks whether asynchronous L2 operation is in progress.
+ *
+ * @param op          Asynchronous L2 operation
+ * @return            true if in progress
+ */
+bool lt_l2_async_busy(const lt_l2_async_t *op);
+
+/**
+ * @brief Abandons asynchronous L2 operation without calling its callback.
+ * @warning TROPIC01 may still hold the response, Secure Session has to be started again after abandoned L3 Command.
+ *
+ * @param op          Asynchronous L2 operation
+ */
+void lt_l2_async_cancel(lt_l2_async_t *op);
+#endif
+
 /** @} */  // end of group_l2_functions
 
 #ifdef __cplusplus
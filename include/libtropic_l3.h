@@ -64,6 +64,39 @@ lt_ret_t lt_out__session_start(lt_handle_t *h, const lt_pkey_index_t pkey_index,
 lt_ret_t lt_in__session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pkey_index_t pkey_index,
                               const uint8_t *shipriv, const uint8_t *shipub, lt_host_eph_keys_t *host_eph_keys);
 
+#ifdef LT_SESSION_CACHE
+/**
+ * @brief Initiates secure session using data prepared in the session cache.
+ *
+ * After successful execution, `h->l2->buff` will contain data for L2 handshake request. Ephemeral keys prepared by
+ * `lt_session_cache_prepare()` are used if available, otherwise they are generated here.
+ * @note For more information read info at the top of this file.
+ *
+ * @param h              Handle for communication with TROPIC01
+ * @param pkey_index     Index of pairing public key
+ * @param cache          Session cache initialized by `lt_session_cache_init()`
+ * @return               LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_out__session_start_cached(lt_handle_t *h, const lt_pkey_index_t pkey_index, lt_session_cache_t *cache);
+
+/**
+ * @brief Decodes TROPIC01's response during secure session's establishment using data prepared in the session
+ * cache.
+ *
+ * Designed to be used together with `lt_out__session_start_cached()`, `lt_l2_send()` and `lt_l2_receive()`.
+ * @note Secure session will be established after successful execution. Ephemeral keys are wiped from the cache
+ * in any case. For more information read info at the top of this file.
+ *
+ * @param h              Handle for communication with TROPIC01
+ * @param pkey_index     Index of pairing public key
+ * @param shipriv        Secure host private key
+ * @param cache          Session cache used by `lt_out__session_start_cached()`
+ * @return               LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_in__session_start_cached(lt_handle_t *h, const lt_pkey_index_t pkey_index, const uint8_t *shipriv,
+                                     lt_session_cache_t *cache);
+#endif
+
 /**
  * @brief Encodes Ping command payload.
  * @note Used for separate L3 communication, for more information read info at the top
@@ -152,6 +185,7 @@ lt_ret_t lt_out__pairing_key_invalidate(lt_handle_t *h, const uint8_t slot);
  */
 lt_ret_t lt_in__pairing_key_invalidate(lt_handle_t *h);
 
+#ifdef LT_CMD_CONFIG
 /**
  * @brief Encodes R_Config_Write command payload.
  * @note Used for separate L3 communication, for more information read info
@@ -259,7 +293,9 @@ lt_ret_t lt_out__i_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t a
  * @return            LT_OK if success, otherwise returns other error code.
  */
 lt_ret_t lt_in__i_config_read(lt_handle_t *h, uint32_t *obj);
+#endif
 
+#ifdef LT_CMD_R_MEM
 /**
  * @brief Encodes R_Mem_Data_Write command payload.
  * @note Used for separate L3 communication, for more information read info
@@ -329,6 +365,7 @@ lt_ret_t lt_out__r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot);
  * @return            LT_OK if success, otherwise returns other error code.
  */
 lt_ret_t lt_in__r_mem_data_erase(lt_handle_t *h);
+#endif
 
 /**
  * @brief Encodes Random_Value_Get command payload.
@@ -353,6 +390,7 @@ lt_ret_t lt_out__random_value_get(lt_handle_t *h, const uint16_t rnd_bytes_cnt);
  */
 lt_ret_t lt_in__random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt);
 
+#ifdef LT_CMD_ECC
 /**
  * @brief Encodes ECC_Key_Generate command payload.
  * @note Used for separate L3 communication, for more information read
@@ -461,6 +499,18 @@ lt_ret_t lt_in__ecc_key_erase(lt_handle_t *h);
  */
 lt_ret_t lt_out__ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t slot, const uint8_t *msg, const uint32_t msg_len);
 
+/**
+ * @brief Encodes ECDSA_Sign command payload with SHA-256 digest of the message computed by the caller.
+ * @note Used for separate L3 communication, for more information read info
+ * at the top of this file.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param slot        ECC key slot to use for signing
+ * @param msg_hash    SHA-256 digest of the message, 32 B
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_out__ecc_ecdsa_sign_digest(lt_handle_t *h, const lt_ecc_slot_t slot, const uint8_t *msg_hash);
+
 /**
  * @brief Decodes ECDSA_Sign result payload.
  * @note Used for separate L3 communication, for more information read info at
@@ -496,7 +546,9 @@ lt_ret_t lt_out__ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, co
  * @return            LT_OK if success, otherwise returns other error code.
  */
 lt_ret_t lt_in__ecc_eddsa_sign(lt_handle_t *h, uint8_t *rs);
+#endif
 
+#ifdef LT_CMD_MCOUNTER
 /**
  * @brief Encodes MCounter_Init command payload.
  * @note Used for separate L3 communication, for more information read info at
@@ -565,7 +617,9 @@ lt_ret_t lt_out__mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mco
  * @return            LT_OK if success, otherwise returns other error code.
  */
 lt_ret_t lt_in__mcounter_get(lt_handle_t *h, uint32_t *mcounter_value);
+#endif
 
+#ifdef LT_CMD_MAC_DESTROY
 /**
  * @brief Encodes MAC_And_Destroy command payload.
  * @note Used for separate L3 communication, for more information read info
@@ -588,6 +642,7 @@ lt_ret_t lt_out__mac_and_destroy(lt_handle_t *h, lt_mac_and_destroy_slot_t slot,
  * @return            LT_OK if success, otherwise returns other error code.
  */
 lt_ret_t lt_in__mac_and_destroy(lt_handle_t *h, uint8_t *data_in);
+#endif
 
 /** @} */  // end of group_libtropic_l3
 
@@ -10,6 +10,8 @@
  */
 
 #include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "libtropic_port.h"
 
@@ -17,6 +19,55 @@
 extern "C" {
 #endif
 
+#ifdef LT_LOG_DEFERRED
+/**
+ * @brief Stores the format string and raw arguments of a message into the deferred log, nothing is formatted.
+ *
+ * Used by the `LT_LOG_*` macros when `LT_LOG_DEFERRED` is enabled. Can be called from more threads at once, does not
+ * block and drops the message if the deferred log is full. Strings passed by `%s` are copied, so they do not have
+ * to outlive the call. The format string itself is stored by its pointer and must be a string literal.
+ *
+ * @param format      Format string, the same as for `printf`
+ */
+void lt_log_deferred(const char *format, ...);
+
+/**
+ * @brief Formats the oldest message of the deferred log.
+ *
+ * Intended for a background task or a low priority loop of the application, which sends the messages wherever
+ * it wants. A message longer than `size` is truncated.
+ *
+ * @param line        Buffer for the formatted message, NUL terminated
+ * @param size        Size of line
+ *
+ * @return Length of the message without the terminating NUL, 0 if the deferred log is empty
+ */
+size_t lt_log_deferred_read(char *line, const size_t size);
+
+/**
+ * @brief Formats messages of the deferred log and prints them by `lt_port_log()`.
+ *
+ * Number of dropped messages is printed before the first message after the drop.
+ *
+ * @param max_msgs    Maximal number of messages to print
+ *
+ * @return Number of printed messages
+ */
+uint32_t lt_log_deferred_process(const uint32_t max_msgs);
+
+/** @brief Output of the logging macros. */
+#define LT_LOG_OUTPUT lt_log_deferred
+/** @brief Prints all messages of the deferred log, used before the program is aborted. */
+#define LT_LOG_FLUSH() ((void)lt_log_deferred_process(UINT32_MAX))
+#else
+/** @brief Output of the logging macros. */
+#define LT_LOG_OUTPUT lt_port_log
+/** @brief Prints all messages of the deferred log, nothing to do if `LT_LOG_DEFERRED` is disabled. */
+#define LT_LOG_FLUSH() \
+    do {               \
+    } while (0)
+#endif
+
 // Loggers with selectable message type.
 
 /** @brief Dummy macro used when no logging is configured. */
@@ -30,25 +81,25 @@ extern "C" {
     } while (0)
 
 #if LT_LOG_ENABLE_INFO
-#define LT_LOG_INFO(f_, ...) lt_port_log("INFO    [%4d] " f_ "\n", __LINE__, ##__VA_ARGS__)
+#define LT_LOG_INFO(f_, ...) LT_LOG_OUTPUT("INFO    [%4d] " f_ "\n", __LINE__, ##__VA_ARGS__)
 #else
 #define LT_LOG_INFO(f_, ...) LT_LOG_DISABLED(f_, ##__VA_ARGS__)
 #endif
 
 #if LT_LOG_ENABLE_WARN
-#define LT_LOG_WARN(f_, ...) lt_port_log("WARNING [%4d] " f_ "\n", __LINE__, ##__VA_ARGS__)
+#define LT_LOG_WARN(f_, ...) LT_LOG_OUTPUT("WARNING [%4d] " f_ "\n", __LINE__, ##__VA_ARGS__)
 #else
 #define LT_LOG_WARN(f_, ...) LT_LOG_DISABLED(f_, ##__VA_ARGS__)
 #endif
 
 #if LT_LOG_ENABLE_ERROR
-#define LT_LOG_ERROR(f_, ...) lt_port_log("ERROR   [%4d] " f_ "\n", __LINE__, ##__VA_ARGS__)
+#define LT_LOG_ERROR(f_, ...) LT_LOG_OUTPUT("ERROR   [%4d] " f_ "\n", __LINE__, ##__VA_ARGS__)
 #else
 #define LT_LOG_ERROR(f_, ...) LT_LOG_DISABLED(f_, ##__VA_ARGS__)
 #endif
 
 #if LT_LOG_ENABLE_DEBUG
-#define LT_LOG_DEBUG(f_, ...) lt_port_log("DEBUG   [%4d] " f_ "\n", __LINE__, ##__VA_ARGS__)
+#define LT_LOG_DEBUG(f_, ...) LT_LOG_OUTPUT("DEBUG   [%4d] " f_ "\n", __LINE__, ##__VA_ARGS__)
 #else
 #define LT_LOG_DEBUG(f_, ...) LT_LOG_DISABLED(f_, ##__VA_ARGS__)
 #endif
@@ -73,6 +124,7 @@ extern "C" {
         }                                                                          \
         else {                                                                     \
             LT_LOG_ERROR("ASSERT FAILED! Got: '%d' Expected: '%d'", _val_, _exp_); \
+            LT_LOG_FLUSH();                                                        \
         };                                                                         \
         assert(_exp_ == _val_);                                                    \
     }
@@ -86,6 +138,7 @@ extern "C" {
         }                                                                          \
         else {                                                                     \
             LT_LOG_ERROR("ASSERT FAILED! Got: '%d' Expected: '%d'", _val_, _exp_); \
+            LT_LOG_FLUSH();                                                        \
         }                                                                          \
         assert(_exp_ == _val_);                                                    \
     }
@@ -84,6 +84,129 @@ lt_ret_t lt_port_spi_csn_high(lt_l2_state_t *s2);
  */
 lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms);
 
+/** Flag for lt_port_spi_transfer_v(): set chip select pin low before the first segment. */
+#define LT_SPI_V_CSN_LOW 0x01
+/** Flag for lt_port_spi_transfer_v(): set chip select pin high after the last segment. */
+#define LT_SPI_V_CSN_HIGH 0x02
+/** Maximal number of segments passed to lt_port_spi_transfer_v(). */
+#define LT_SPI_V_SEGS_MAX 4
+
+/**
+ * @brief One segment of the vectored L1 transfer.
+ */
+typedef struct lt_spi_seg_t {
+    /** @brief Bytes to send, NULL to send bytes in the handle's internal buffer at `offset`. */
+    const uint8_t *tx;
+    /** @brief Buffer for received bytes, NULL to store them into the handle's internal buffer at `offset`. */
+    uint8_t *rx;
+    /** @brief Number of bytes in the segment. */
+    uint16_t len;
+    /** @brief Position of the segment's first byte in the L1 frame. */
+    uint8_t offset;
+} lt_spi_seg_t;
+
+#ifdef LT_PORT_SPI_TRANSFER_V
+/**
+ * @brief Does vectored L1 transfer, i.e. all segments are transferred in one go, optionally together with handling
+ * of the chip select pin. Optional platform defined function, ports providing it shall be compiled with
+ * `LT_PORT_SPI_TRANSFER_V`, others are served by a fallback built on top of lt_port_spi_transfer().
+ * @note On failure, chip select pin has to be left high.
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Segments to transfer, in the order they are clocked on the bus
+ * @param seg_cnt     Number of segments, at most LT_SPI_V_SEGS_MAX
+ * @param flags       Combination of LT_SPI_V_CSN_LOW and LT_SPI_V_CSN_HIGH
+ * @param timeout_ms  Timeout
+ *
+ * @retval            LT_OK   Function executed successfully
+ * @retval            LT_FAIL Function did not execute successully
+ */
+lt_ret_t lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                uint32_t timeout_ms);
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY
+/**
+ * @brief Polls CHIP_STATUS until TROPIC01 has L2 Response frame ready and receives the frame. Optional platform
+ * defined function for ports which can poll close to TROPIC01 (e.g. a server behind a network connection), ports
+ * providing it shall be compiled with `LT_PORT_SPI_READ_READY`.
+ *
+ * Each attempt is one chip select frame starting with REQ_ID of Get_Response: if CHIP_STATUS has the READY bit and
+ * STATUS is not 0xFF, the rest of the frame is received and polling ends. After an unsuccessful attempt, the port
+ * waits for `retry_delay_ms` before the next one. Polling ends also when CHIP_STATUS has the ALARM bit or after
+ * `max_tries` attempts.
+ * @note Chip select pin has to be left high.
+ *
+ * @param s2              Structure holding l2 state
+ * @param max_len         Maximal length of the frame, including CHIP_STATUS
+ * @param retry_delay_ms  Delay between attempts
+ * @param max_tries       Maximal number of attempts
+ * @param timeout_ms      Timeout of one attempt
+ *
+ * @retval            LT_OK                 Polling ended, the frame (or CHIP_STATUS and STATUS of the last attempt
+ *                                          if no frame was received) is in the handle's internal buffer
+ * @retval            LT_L1_DATA_LEN_ERROR  Frame is longer than `max_len`
+ * @retval            LT_NOT_SUPPORTED      Polling is not available now, libtropic polls by itself
+ * @retval            LT_FAIL               Function did not execute successully
+ */
+lt_ret_t lt_port_spi_read_ready(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms, uint16_t max_tries,
+                                uint32_t timeout_ms);
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+/**
+ * @brief Non-blocking variant of `lt_port_spi_read_ready()` for the asynchronous L2 engine. Optional platform defined
+ * function, ports providing it shall be compiled with `LT_PORT_SPI_READ_READY_NOWAIT`.
+ *
+ * The first call starts the polling in the background (e.g. sends the request to the server) and returns
+ * LT_L1_CHIP_BUSY right away, later calls return LT_L1_CHIP_BUSY until the polling ended. The call after that
+ * receives the frame as `lt_port_spi_read_ready()` does. The port shall let the application know when the polling
+ * ended, e.g. by a file descriptor becoming readable. Other port functions called while the polling runs have to
+ * wait for it and discard its result.
+ * @note Chip select pin has to be left high.
+ *
+ * @param s2              Structure holding l2 state
+ * @param max_len         Maximal length of the frame, including CHIP_STATUS
+ * @param retry_delay_ms  Delay between attempts
+ * @param max_tries       Maximal number of attempts
+ * @param timeout_ms      Timeout of one attempt
+ *
+ * @retval            LT_OK                 Polling ended, see `lt_port_spi_read_ready()`
+ * @retval            LT_L1_CHIP_BUSY       Polling runs in the background
+ * @retval            LT_L1_DATA_LEN_ERROR  Frame is longer than `max_len`
+ * @retval            LT_NOT_SUPPORTED      Polling is not available now, libtropic polls by itself
+ * @retval            LT_FAIL               Function did not execute successully
+ */
+lt_ret_t lt_port_spi_read_ready_nowait(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms,
+                                       uint16_t max_tries, uint32_t timeout_ms);
+#endif
+
+#ifdef LT_PORT_L3_TUNNEL
+/**
+ * @brief Transfers encrypted L3 Command packet through a bridge next to TROPIC01 and returns encrypted L3 Result
+ * packet. Optional platform defined function, ports providing it shall be compiled with `LT_PORT_L3_TUNNEL`.
+ *
+ * The bridge does what L2 of libtropic would: it splits the packet into Encrypted_Cmd_Req chunks, adds their CRC,
+ * polls for the L2 Responses, asks for resending of corrupted ones and collects the chunks of L3 Result. The packets
+ * stay encrypted by the Secure Session, so the bridge learns nothing libtropic's own L2 would not. Response is
+ * CHIP_STATUS and STATUS of the last L2 Response frame, followed by the L3 Result packet if STATUS is RESULT_OK.
+ * @note The response stays valid until the next call of the port.
+ *
+ * @param s2          Structure holding l2 state
+ * @param cmd         Encrypted L3 Command packet (L3 size, ciphertext and tag)
+ * @param cmd_len     Length of cmd
+ * @param res         Response of the bridge is returned here
+ * @param res_len     Length of the response is returned here
+ * @param timeout_ms  Timeout of the whole transfer
+ *
+ * @retval            LT_OK             Response of the bridge was received
+ * @retval            LT_NOT_SUPPORTED  Bridge is not available now, libtropic transfers the packet in L2 chunks
+ * @retval            LT_FAIL           Function did not execute successully
+ */
+lt_ret_t lt_port_l3_tunnel(lt_l2_state_t *s2, const uint8_t *cmd, uint16_t cmd_len, const uint8_t **res,
+                           uint16_t *res_len, uint32_t timeout_ms);
+#endif
+
 /**
  * @brief Platform defined function for delay, specifies what host platform should do when libtropic's functions need
  * some delay.
@@ -96,6 +219,62 @@ lt_ret_t lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len
  */
 lt_ret_t lt_port_delay(lt_l2_state_t *s2, uint32_t ms);
 
+#ifdef LT_PORT_DELAY_US
+/**
+ * @brief Platform defined function for delay with microsecond resolution, for waits shorter than lt_port_delay() can
+ * express. Optional platform defined function, ports providing it shall be compiled with `LT_PORT_DELAY_US`.
+ *
+ * @param s2          Structure holding l2 state
+ * @param us          Time to wait in microseconds
+ *
+ * @retval            LT_OK   Function executed successfully
+ * @retval            LT_FAIL Function did not execute successully
+ */
+lt_ret_t lt_port_delay_us(lt_l2_state_t *s2, uint32_t us);
+#endif
+
+#ifdef LT_PORT_SPI_SET_SPEED
+/**
+ * @brief Platform defined function for changing the SPI clock, used by link tuning (`LT_LINK_TUNE`). Called between
+ * L1 frames only, with chip select high. Optional platform defined function, ports providing it shall be compiled
+ * with `LT_PORT_SPI_SET_SPEED`.
+ *
+ * @param s2          Structure holding l2 state
+ * @param hz          Requested SPI clock in Hz, the port uses the fastest clock it can generate not exceeding it
+ *
+ * @retval            LT_OK   Function executed successfully
+ * @retval            LT_FAIL Function did not execute successully
+ */
+lt_ret_t lt_port_spi_set_speed(lt_l2_state_t *s2, uint32_t hz);
+#endif
+
+#ifdef LT_PORT_CACHE_MAINT
+/**
+ * @brief Platform defined function for writing dirty data cache lines over the given bytes back to memory, called
+ * before each transfer over the bytes it sends or receives, so DMA reads what the CPU wrote. Optional platform defined
+ * function, ports providing it shall be compiled with `LT_PORT_CACHE_MAINT`.
+ *
+ * @note Whole cache lines are maintained, buffers of libtropic do not share them with other data when `LT_BUFF_ALIGN`
+ * is set to the size of the cache line.
+ *
+ * @param s2          Structure holding l2 state
+ * @param addr        First byte, lies in `s2->buff` or in an L3 buffer
+ * @param len         Number of bytes
+ */
+void lt_port_cache_clean(lt_l2_state_t *s2, const void *addr, size_t len);
+
+/**
+ * @brief Platform defined function for discarding data cache lines over the given bytes, called after each transfer
+ * over the bytes it received, so the CPU reads what DMA wrote. Optional platform defined function, ports providing it
+ * shall be compiled with `LT_PORT_CACHE_MAINT`.
+ *
+ * @param s2          Structure holding l2 state
+ * @param addr        First byte, lies in `s2->buff` or in an L3 buffer
+ * @param len         Number of bytes
+ */
+void lt_port_cache_invalidate(lt_l2_state_t *s2, void *addr, size_t len);
+#endif
+
 #if LT_USE_INT_PIN
 /**
  * @brief Platform defined function used to specify reading of an interrupt pin, used as a signal that chip has a
@@ -123,6 +302,39 @@ lt_ret_t lt_port_delay_on_int(lt_l2_state_t *s2, uint32_t ms);
  */
 lt_ret_t lt_port_random_bytes(lt_l2_state_t *s2, void *buff, size_t count);
 
+#ifdef LT_CRC16_PORT
+/**
+ * @brief Calculates CRC16 of L2 frames, e.g. using a hardware CRC unit. Optional platform defined function, used only
+ * when Libtropic is compiled with `LT_CRC16_IMPL` set to `PORT`.
+ * @details Required parameters: polynomial 0x8005, initial value 0x0000, no input/output reflection, no final XOR.
+ * CRC is returned as a number, Libtropic takes care of the byte order in the frame. The calculation may be split
+ * into several calls, the value returned by the previous call is passed in `crc`.
+ *
+ * @param crc         CRC of the preceding data (initial value 0x0000 for the first call)
+ * @param data        Data to calculate CRC of
+ * @param len         Number of bytes in data
+ *
+ * @return            CRC16 of the preceding data followed by the data
+ */
+uint16_t lt_port_crc16(uint16_t crc, const uint8_t *data, uint16_t len);
+#endif
+
+#ifdef LT_PORT_TIME_US
+/**
+ * @brief Monotonic clock for timestamps passed to trace hooks (see lt_set_trace_hooks()), for execution times of L3
+ * Commands in runtime statistics (see lt_get_stats()), for records of the SPI recorder (see lt_spi_recorder_init()),
+ * for durations reported to the port recorder (see lt_set_port_recorder()) and for idle time of the idle manager (see
+ * lt_idle_init()), the health monitor (see lt_health_init()), for the probe of CALs (see lt_crypto_ops_probe()) and
+ * for the readiness polls of asynchronous reboot (see lt_reboot_async_start()) and for the deadline of API calls (see
+ * lt_deadline_set()), platform defined function required when Libtropic is compiled with `LT_TRACE`, `LT_STATS`,
+ * `LT_SPI_RECORDER`, `LT_PORT_RECORD`, `LT_IDLE_MGR`, `LT_HEALTH`, `LT_CRYPTO_OPS`, `LT_REBOOT_ASYNC` or `LT_DEADLINE`
+ * (`LT_PORT_TIME_US` is then defined automatically).
+ *
+ * @return            Time in microseconds, the starting point is arbitrary
+ */
+uint64_t lt_port_time_us(void);
+#endif
+
 /**
  * @brief Port-specific printf-like function used by Libtropic for logging debug information and test outputs.
  * @note  The implementation shall not modify output in any way (e.g., by appending arbitrary newlines)
@@ -0,0 +1,156 @@
+import argparse
+import pathlib
+import struct
+import sys
+
+# Format of the records written by lt_spi_recorder_read(), see lt_spi_recorder_t in libtropic_common.h.
+REC_HDR = struct.Struct("<BBHQ")
+
+REC_MOSI = 0
+REC_MISO = 1
+REC_L3_CMD = 2
+REC_L3_RES = 3
+
+L2_REQ_IDS = {
+    0x01: "Get_Info_Req",
+    0x02: "Handshake_Req",
+    0x04: "Encrypted_Cmd_Req",
+    0x08: "Encrypted_Session_Abt",
+    0x10: "Resend_Req",
+    0x20: "Sleep_Req",
+    0xA2: "Get_Log_Req",
+    0xB0: "Mutable_FW_Update_Req",  # ACAB
+    0xB1: "Mutable_FW_Update_Req",  # ABAB (Mutable_FW_Update_Data_Req on ACAB)
+    0xB2: "Mutable_FW_Erase_Req",
+    0xB3: "Startup_Req",
+}
+
+L2_STATUSES = {
+    0x01: "REQ_OK",
+    0x02: "RES_OK",
+    0x03: "REQ_CONT",
+    0x04: "RES_CONT",
+    0x78: "RESP_DISABLED",
+    0x79: "HSK_ERR",
+    0x7A: "NO_SESSION",
+    0x7B: "TAG_ERR",
+    0x7C: "CRC_ERR",
+    0x7E: "UNKNOWN_REQ",
+    0x7F: "GEN_ERR",
+    0xFF: "NO_RESP",
+}
+
+L3_CMD_IDS = {
+    0x01: "Ping",
+    0x10: "Pairing_Key_Write",
+    0x11: "Pairing_Key_Read",
+    0x12: "Pairing_Key_Invalidate",
+    0x20: "R_Config_Write",
+    0x21: "R_Config_Read",
+    0x22: "R_Config_Erase",
+    0x30: "I_Config_Write",
+    0x31: "I_Config_Read",
+    0x40: "R_Mem_Data_Write",
+    0x41: "R_Mem_Data_Read",
+    0x42: "R_Mem_Data_Erase",
+    0x50: "Random_Value_Get",
+    0x60: "ECC_Key_Generate",
+    0x61: "ECC_Key_Store",
+    0x62: "ECC_Key_Read",
+    0x63: "ECC_Key_Erase",
+    0x70: "ECDSA_Sign",
+    0x71: "EdDSA_Sign",
+    0x80: "MCounter_Init",
+    0x81: "MCounter_Update",
+    0x82: "MCounter_Get",
+    0x90: "MAC_And_Destroy",
+}
+
+L3_RESULTS = {
+    0xC3: "OK",
+    0x3C: "FAIL",
+    0x01: "UNAUTHORIZED",
+    0x02: "INVALID_CMD",
+    0x10: "SLOT_NOT_EMPTY",
+    0x11: "SLOT_EXPIRED",
+    0x12: "INVALID_KEY",
+    0x13: "UPDATE_ERR",
+    0x14: "COUNTER_INVALID",
+    0x15: "SLOT_EMPTY",
+    0x16: "SLOT_INVALID",
+    0x17: "HARDWARE_FAIL",
+}
+
+CHIP_MODE_BITS = ((0x01, "READY"), (0x02, "ALARM"), (0x04, "STARTUP"))
+
+
+def name(table: dict, value: int) -> str:
+    return table.get(value, f"0x{value:02X}")
+
+
+def chip_status(value: int) -> str:
+    modes = [mode for bit, mode in CHIP_MODE_BITS if value & bit]
+    return "|".join(modes) if modes else "BUSY"
+
+
+def decode_record(rec_type: int, data: bytes) -> str:
+    if rec_type == REC_MOSI:
+        if len(data) < 2:
+            return f">> {data.hex()}"
+        return f">> {name(L2_REQ_IDS, data[0])} req_len={data[1]}"
+    if rec_type == REC_MISO:
+        if len(data) < 3:
+            return f"<< {data.hex()}"
+        return f"<< {chip_status(data[0])} {name(L2_STATUSES, data[1])} rsp_len={data[2]}"
+    if rec_type == REC_L3_CMD and len(data) == 3:
+        return f"L3 >> {name(L3_CMD_IDS, data[0])} cmd_size={data[1] | (data[2] << 8)}"
+    if rec_type == REC_L3_RES and len(data) == 1:
+        return f"L3 << {name(L3_RESULTS, data[0])}"
+    return f"unknown record type {rec_type}: {data.hex()}"
+
+
+def decode(stream: bytes, show_data: bool):
+    offset = 0
+    start_us = None
+    last_us = None
+
+    while offset + REC_HDR.size <= len(stream):
+        rec_type, _, length, time_us = REC_HDR.unpack_from(stream, offset)
+        data = stream[offset + REC_HDR.size:offset + REC_HDR.size + length]
+        if len(data) < length:
+            print(f"Truncated record at offset {offset}", file=sys.stderr)
+            return
+        offset += REC_HDR.size + length
+
+        if start_us is None:
+            start_us = last_us = time_us
+        line = f"{time_us - start_us:>12} us  +{time_us - last_us:<9} {decode_record(rec_type, data)}"
+        if show_data and rec_type in (REC_MOSI, REC_MISO):
+            line += f"  [{data.hex(' ')}]"
+        print(line)
+        last_us = time_us
+
+    if offset != len(stream):
+        print(f"Truncated record at offset {offset}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Decodes data read by lt_spi_recorder_read() (LT_SPI_RECORDER) into L2/L3 requests and responses."
+    )
+
+    parser.add_argument(
+        "trace",
+        help="Path to the file with the recorded data.",
+        type=pathlib.Path
+    )
+
+    parser.add_argument(
+        "-d", "--data",
+        help="Print also raw bytes of the L1 frames.",
+        action="store_true"
+    )
+
+    args = parser.parse_args()
+
+    decode(args.trace.read_bytes(), args.data)
@@ -0,0 +1,157 @@
+import argparse
+import pathlib
+import re
+import sys
+
+# Call graph files written by GCC with -fcallgraph-info=su (LT_STACK_USAGE), one per translation unit.
+NODE_RE = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE_RE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+FRAME_RE = re.compile(r"(\d+) bytes \(([^)]*)\)")
+
+# Declarations of public API functions in libtropic.h.
+DECL_RE = re.compile(r"^(?!typedef|#)[\w][\w \t\*]*?\b(lt_\w+)\s*\(", re.MULTILINE)
+
+HEAP_FUNCS = {"malloc", "calloc", "realloc", "free", "aligned_alloc", "posix_memalign", "strdup", "strndup"}
+INDIRECT_CALL = "__indirect_call"
+
+
+class Func:
+    def __init__(self, title: str):
+        self.title = title
+        self.frame = None  # None for functions defined outside the graph (libc, crypto libraries)
+        self.dynamic = False
+        self.callees = set()
+
+
+def bare_name(title: str) -> str:
+    # Static functions are titled "file:name".
+    return title.rsplit(":", 1)[-1]
+
+
+def load_graph(build_dir: pathlib.Path) -> dict:
+    funcs = {}
+
+    for ci in sorted(build_dir.rglob("*.ci")):
+        text = ci.read_text(errors="replace")
+        for title, label in NODE_RE.findall(text):
+            f = funcs.setdefault(title, Func(title))
+            m = FRAME_RE.search(label.replace("\\n", "\n"))
+            if m:
+                # Same function may be emitted by more units, e.g. static inline from a header.
+                f.frame = max(f.frame or 0, int(m.group(1)))
+                f.dynamic |= ("dynamic" in m.group(2)) and ("bounded" not in m.group(2))
+        for src, dst in EDGE_RE.findall(text):
+            funcs.setdefault(src, Func(src)).callees.add(dst)
+
+    return funcs
+
+
+def worst_case(funcs: dict) -> dict:
+    """Returns worst-case stack depth and flags of every function, calls to unknown functions count as 0 B."""
+    result = {}
+    active = set()
+
+    def visit(title: str):
+        if title in result:
+            return result[title]
+        f = funcs.get(title)
+        if title in active:
+            return 0, {"recursive"}
+        if f is None:
+            flags = {"heap"} if bare_name(title) in HEAP_FUNCS else set()
+            if bare_name(title) == INDIRECT_CALL:
+                flags.add("indirect")
+            return 0, flags
+
+        active.add(title)
+        depth, flags = 0, set()
+        if f.dynamic:
+            flags.add("unbounded")
+        for callee in f.callees:
+            d, fl = visit(callee)
+            depth = max(depth, d)
+            flags |= fl
+        active.discard(title)
+
+        result[title] = ((f.frame or 0) + depth, flags)
+        return result[title]
+
+    for title in list(funcs):
+        visit(title)
+
+    return result
+
+
+def public_api(header: pathlib.Path) -> set:
+    return set(DECL_RE.findall(header.read_text()))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description="Reports worst-case stack usage of public API functions from call graphs written by GCC "
+        "with -fcallgraph-info=su (LT_STACK_USAGE)."
+    )
+
+    parser.add_argument(
+        "build_dir",
+        help="Directory searched for .ci files, e.g. CMakeFiles/tropic.dir of the build.",
+        type=pathlib.Path
+    )
+
+    parser.add_argument(
+        "--header",
+        help="Header declaring the public API, all functions are reported if not given.",
+        type=pathlib.Path
+    )
+
+    parser.add_argument(
+        "--budget",
+        help="Fail if a reported function may use more stack bytes or uses the heap, 0 disables the check.",
+        type=int,
+        default=0
+    )
+
+    parser.add_argument(
+        "-o", "--output",
+        help="Write the report to a file instead of the standard output.",
+        type=pathlib.Path
+    )
+
+    args = parser.parse_args()
+
+    funcs = load_graph(args.build_dir)
+    if not funcs:
+        print(f"No .ci files found in {args.build_dir}, was it built with -fcallgraph-info=su?", file=sys.stderr)
+        return 1
+
+    depths = worst_case(funcs)
+    api = public_api(args.header) if args.header else None
+    rows = sorted(
+        ((depth, funcs[title].frame or 0, title, flags) for title, (depth, flags) in depths.items()
+         if funcs[title].frame is not None and (api is None or title in api)),
+        reverse=True
+    )
+
+    lines = [f"{'worst':>7} {'frame':>6}  function"]
+    lines += [f"{d:>7} {fr:>6}  {t}" + (f"  [{', '.join(sorted(fl))}]" if fl else "") for d, fr, t, fl in rows]
+    report = "\n".join(lines) + "\n"
+    if args.output:
+        args.output.write_text(report)
+    else:
+        print(report, end="")
+
+    if args.budget <= 0:
+        return 0
+
+    failed = [(d, t, fl) for d, _, t, fl in rows if d > args.budget or "heap" in fl]
+    for d, t, fl in failed:
+        reason = "uses the heap" if "heap" in fl else f"may use {d} B of stack"
+        print(f"{t} {reason}, budget is {args.budget} B", file=sys.stderr)
+    if rows:
+        print(f"Stack usage: {len(rows)} functions, worst {rows[0][2]} with {rows[0][0]} B, budget {args.budget} B")
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,5 +1,7 @@
 import argparse
+import json
 import pathlib
+import shutil
 import subprocess
 import yaml
 import time
@@ -7,7 +9,9 @@ import sys
 import socket
 import os
 
-def wait_for_server_start(host="127.0.0.1", port=28992, retry_interval=0.2, max_attempts=10) -> bool:
+DEFAULT_PORT = 28992
+
+def wait_for_server_start(host="127.0.0.1", port=DEFAULT_PORT, retry_interval=0.2, max_attempts=10) -> bool:
     for i in range(max_attempts):
         with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as sock:
             sock.settimeout(1.0)
@@ -52,6 +56,13 @@ if __name__ == "__main__":
         required=True
     )
 
+    parser.add_argument(
+        "-p", "--port",
+        help=f"TCP port of the model, more models can run in parallel on different ports (default: {DEFAULT_PORT}).",
+        type=int,
+        default=DEFAULT_PORT
+    )
+
     args = parser.parse_args()
 
     # Resolve all paths relative to current working directory
@@ -59,11 +70,16 @@ if __name__ == "__main__":
     model_cfg_path: pathlib.Path = args.model_cfg.resolve()
     output_path: pathlib.Path = args.output_dir.resolve()
     use_valgrind: bool = args.use_valgrind
+    port: int = args.port
     exe_name = exe_path.stem
 
     # Create destination directory if it doesn't exist yet
     output_path.mkdir(parents=True, exist_ok=True)
 
+    # Every model gets its own copy of the configuration, so models running in parallel do not share any file.
+    model_cfg_copy_path = output_path / f"{exe_name}_model_cfg.yml"
+    shutil.copyfile(model_cfg_path, model_cfg_copy_path)
+
     # Get the logging configuration from the model so we can modify it
     dump_logging_cfg_res = subprocess.run(
         ["model_server", "dump-logging-cfg"],
@@ -84,7 +100,7 @@ if __name__ == "__main__":
     # Disable colors to prevent weird symbols in the .log file
     model_log_cfg["formatters"]["default"]["use_colors"] = False
 
-    model_log_cfg_path = output_path / "model_log_cfg_path.yml"
+    model_log_cfg_path = output_path / f"{exe_name}_model_log_cfg.yml"
     with model_log_cfg_path.open("w") as f:
         yaml.dump(model_log_cfg, f, default_flow_style=False)
     
@@ -92,19 +108,22 @@ if __name__ == "__main__":
     model_process = subprocess.Popen(
         [
             "model_server", "tcp",
-            "-c", str(model_cfg_path),
+            "-p", str(port),
+            "-c", str(model_cfg_copy_path),
             "-l", str(model_log_cfg_path)
         ],
         env=os.environ
     )
 
     # Wait for model server to start
-    if not wait_for_server_start():
+    if not wait_for_server_start(port=port):
         print("Server did not start.")
         sys.exit(1)
 
-    # Run the executable
+    # Run the executable, it connects to the port given by LT_MODEL_PORT
+    exe_env = dict(os.environ, LT_MODEL_PORT=str(port))
     ret = 0
+    start = time.monotonic()
     exe_log_path = output_path / f"{exe_name}.log"
     with exe_log_path.open("w") as f:
         try:
@@ -126,11 +145,16 @@ if __name__ == "__main__":
             subprocess.run(
                 args=exe_cmd,
                 stdout=f, stderr=f,
-                env=os.environ,
+                env=exe_env,
                 check=True
             )
         except subprocess.CalledProcessError as e:
             ret = e.returncode
+    duration = time.monotonic() - start
+
+    # Host-side duration of the test, one JSON object per line, so runs of more tests and models can be compared.
+    with (output_path / "timings.jsonl").open("a") as f:
+        f.write(json.dumps({"test": exe_name, "port": port, "duration_s": round(duration, 3), "ret": ret}) + "\n")
 
     # Clean up
     model_process.terminate()
@@ -0,0 +1,263 @@
+"""
+Proxy adding the compound LT_TCP_TAG_SPI_TRANSFER_FRAMED, LT_TCP_TAG_SPI_READ_READY and LT_TCP_TAG_L3_TUNNEL
+messages to a TCP server which understands only the basic messages of the libtropic TCP protocol (e.g. the
+TROPIC01 Model or a test rig).
+
+One framed message is translated into CSN_LOW, SPI_SEND and CSN_HIGH messages, one read ready message into
+the whole loop polling CHIP_STATUS until the response frame is ready. One L3 tunnel message carries a whole
+encrypted L3 Command, the proxy sends all its Encrypted_Cmd_Req frames and collects all frames of the L3 Result,
+checking their CRCs and resending corrupted frames. These are exchanged with the server locally. Run the proxy
+on the same host as the server, so the client has to wait only for one round-trip over the (slow) network per
+compound message, i.e. per L3 Command with the L3 tunnel. All other messages are forwarded as they are.
+"""
+
+import argparse
+import pathlib
+import socket
+import struct
+
+TAG_SPI_DRIVE_CSN_LOW = 0x01
+TAG_SPI_DRIVE_CSN_HIGH = 0x02
+TAG_SPI_SEND = 0x03
+TAG_WAIT = 0x06
+TAG_SPI_TRANSFER_FRAMED = 0x07
+TAG_SPI_READ_READY = 0x08
+TAG_L3_TUNNEL = 0x09
+TAG_INVALID = 0xFD
+
+FRAMED_CSN_LOW = 0x01
+FRAMED_CSN_HIGH = 0x02
+
+GET_RESPONSE_REQ_ID = 0xAA
+CHIP_MODE_READY_BIT = 0x01
+CHIP_MODE_ALARM_BIT = 0x02
+NO_RESPONSE_STATUS = 0xFF
+
+ENCRYPTED_CMD_REQ_ID = 0x04
+RESEND_REQ_ID = 0x10
+CHUNK_MAX_DATA_SIZE = 252
+L3_PACKET_MAX_SIZE = 2 + 4112 + 16
+L2_MAX_FRAME_SIZE = 1 + 1 + CHUNK_MAX_DATA_SIZE + 2
+
+STATUS_REQUEST_OK = 0x01
+STATUS_RESULT_OK = 0x02
+STATUS_REQUEST_CONT = 0x03
+STATUS_RESULT_CONT = 0x04
+STATUS_CRC_ERR = 0x7C
+
+TUNNEL_MAX_POLLS = 1000
+TUNNEL_POLL_DELAY_MS = 1
+TUNNEL_MAX_RESENDS = 3
+
+HEADER = struct.Struct("<BH")
+READ_READY_ARGS = struct.Struct("<HHI")
+
+
+def recv_exact(sock: socket.socket, n: int) -> bytes:
+    data = b""
+    while len(data) < n:
+        chunk = sock.recv(n - len(data))
+        if not chunk:
+            raise ConnectionError("Connection closed.")
+        data += chunk
+    return data
+
+
+def recv_msg(sock: socket.socket) -> tuple[int, bytes]:
+    tag, length = HEADER.unpack(recv_exact(sock, HEADER.size))
+    return tag, recv_exact(sock, length)
+
+
+def send_msg(sock: socket.socket, tag: int, payload: bytes = b"") -> None:
+    sock.sendall(HEADER.pack(tag, len(payload)) + payload)
+
+
+def forward(server: socket.socket, tag: int, payload: bytes = b"") -> tuple[int, bytes]:
+    send_msg(server, tag, payload)
+    return recv_msg(server)
+
+
+def framed_transfer(server: socket.socket, payload: bytes) -> tuple[int, bytes]:
+    if not payload:
+        return TAG_INVALID, b""
+    flags, data = payload[0], payload[1:]
+
+    if flags & FRAMED_CSN_LOW:
+        tag, _ = forward(server, TAG_SPI_DRIVE_CSN_LOW)
+        if tag != TAG_SPI_DRIVE_CSN_LOW:
+            return tag, b""
+
+    miso = b""
+    if data:
+        tag, miso = forward(server, TAG_SPI_SEND, data)
+        if tag != TAG_SPI_SEND:
+            # Client expects chip select to be high after a failed transfer.
+            forward(server, TAG_SPI_DRIVE_CSN_HIGH)
+            return tag, b""
+
+    if flags & FRAMED_CSN_HIGH:
+        tag, _ = forward(server, TAG_SPI_DRIVE_CSN_HIGH)
+        if tag != TAG_SPI_DRIVE_CSN_HIGH:
+            return tag, b""
+
+    return TAG_SPI_TRANSFER_FRAMED, miso
+
+
+def spi_send(server: socket.socket, data: bytes) -> bytes:
+    tag, miso = forward(server, TAG_SPI_SEND, data)
+    if tag != TAG_SPI_SEND or len(miso) != len(data):
+        raise ConnectionError(f"SPI_SEND failed with tag {tag}.")
+    return miso
+
+
+def read_attempt(server: socket.socket, max_len: int) -> bytes:
+    """One chip select frame of the polling, returns CHIP_STATUS (and STATUS) or the whole frame."""
+    forward(server, TAG_SPI_DRIVE_CSN_LOW)
+    try:
+        frame = spi_send(server, bytes([GET_RESPONSE_REQ_ID]))
+        if frame[0] & CHIP_MODE_ALARM_BIT or not frame[0] & CHIP_MODE_READY_BIT:
+            return frame
+        frame += spi_send(server, bytes(2))
+        if frame[1] == NO_RESPONSE_STATUS:
+            return frame[:2]
+        rest = frame[2] + 2
+        if len(frame) + rest > max_len:
+            raise ConnectionError(f"Frame longer than {max_len} bytes.")
+        return frame + spi_send(server, bytes(rest))
+    finally:
+        forward(server, TAG_SPI_DRIVE_CSN_HIGH)
+
+
+def read_ready(server: socket.socket, payload: bytes) -> tuple[int, bytes]:
+    if len(payload) != READ_READY_ARGS.size:
+        return TAG_INVALID, b""
+    max_len, max_tries, retry_delay_ms = READ_READY_ARGS.unpack(payload)
+
+    frame = b""
+    for _ in range(max_tries):
+        frame = read_attempt(server, max_len)
+        if len(frame) > 2 or frame[0] & CHIP_MODE_ALARM_BIT:
+            break
+        forward(server, TAG_WAIT, struct.pack("<I", retry_delay_ms))
+
+    # Client expects CHIP_STATUS only if no frame was received.
+    return TAG_SPI_READ_READY, frame[:1] if len(frame) <= 2 else frame
+
+
+def crc16(data: bytes) -> bytes:
+    """CRC of L2 frames (polynomial 0x8005, no reflection) in the byte order of the frame."""
+    crc = 0
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x8005) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return struct.pack("<H", crc)
+
+
+def tunnel_poll(server: socket.socket) -> bytes:
+    """Polls for the L2 Response frame, returns CHIP_STATUS and STATUS only if there is none."""
+    frame = b""
+    for _ in range(TUNNEL_MAX_POLLS):
+        frame = read_attempt(server, 1 + L2_MAX_FRAME_SIZE)
+        if len(frame) > 2 or frame[0] & CHIP_MODE_ALARM_BIT:
+            break
+        forward(server, TAG_WAIT, struct.pack("<I", TUNNEL_POLL_DELAY_MS))
+    return frame if len(frame) > 1 else frame + bytes([NO_RESPONSE_STATUS])
+
+
+def frame_valid(frame: bytes) -> bool:
+    return len(frame) <= 2 or crc16(frame[1 : 3 + frame[2]]) == frame[3 + frame[2] :]
+
+
+def tunnel_request(server: socket.socket, req: bytes) -> bytes:
+    """Sends the L2 Request frame and returns its L2 Response frame, repeats the request if it got corrupted."""
+    frame = b""
+    for _ in range(TUNNEL_MAX_RESENDS + 1):
+        framed_transfer(server, bytes([FRAMED_CSN_LOW | FRAMED_CSN_HIGH]) + req)
+        frame = tunnel_poll(server)
+        if len(frame) <= 2 or frame[1] != STATUS_CRC_ERR:
+            break
+    return frame
+
+
+def tunnel_check(server: socket.socket, frame: bytes) -> bytes:
+    """Requests the L2 Response frame again while its CRC is wrong, returns STATUS CRC_ERR if it stays wrong."""
+    resend_req = bytes([RESEND_REQ_ID, 0])
+    for _ in range(TUNNEL_MAX_RESENDS):
+        if frame_valid(frame):
+            return frame
+        frame = tunnel_request(server, resend_req + crc16(resend_req))
+    return frame if frame_valid(frame) else bytes([frame[0], STATUS_CRC_ERR])
+
+
+def l3_tunnel(server: socket.socket, payload: bytes) -> tuple[int, bytes]:
+    if not payload or len(payload) > L3_PACKET_MAX_SIZE:
+        return TAG_INVALID, b""
+
+    frame = b""
+    for offset in range(0, len(payload), CHUNK_MAX_DATA_SIZE):
+        chunk = payload[offset : offset + CHUNK_MAX_DATA_SIZE]
+        req = bytes([ENCRYPTED_CMD_REQ_ID, len(chunk)]) + chunk
+        frame = tunnel_check(server, tunnel_request(server, req + crc16(req)))
+        if len(frame) <= 2 or frame[1] != STATUS_REQUEST_CONT:
+            break
+    if len(frame) <= 2 or frame[1] != STATUS_REQUEST_OK:
+        # Client maps STATUS of the refused chunk (or CHIP_STATUS without a frame) to the error.
+        return TAG_L3_TUNNEL, frame[:2]
+
+    result = b""
+    while True:
+        frame = tunnel_check(server, tunnel_poll(server))
+        if len(frame) <= 2 or frame[1] not in (STATUS_RESULT_CONT, STATUS_RESULT_OK):
+            return TAG_L3_TUNNEL, frame[:2]
+        result += frame[3 : 3 + frame[2]]
+        if frame[1] == STATUS_RESULT_OK:
+            return TAG_L3_TUNNEL, frame[:2] + result
+
+
+def serve(client: socket.socket, server: socket.socket) -> None:
+    while True:
+        tag, payload = recv_msg(client)
+        if tag == TAG_SPI_TRANSFER_FRAMED:
+            send_msg(client, *framed_transfer(server, payload))
+        elif tag == TAG_SPI_READ_READY:
+            send_msg(client, *read_ready(server, payload))
+        elif tag == TAG_L3_TUNNEL:
+            send_msg(client, *l3_tunnel(server, payload))
+        else:
+            send_msg(client, *forward(server, tag, payload))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        prog="tcp_framing_proxy.py",
+        description="Adds compound messages to a libtropic TCP server which supports only the basic messages."
+    )
+    parser.add_argument("--listen-port", help="Port to accept the client on.", type=int, default=28993)
+    parser.add_argument("--listen-unix", help="Accept the client on this Unix domain socket instead of the port.")
+    parser.add_argument("--server-host", help="Address of the server.", default="127.0.0.1")
+    parser.add_argument("--server-port", help="Port of the server.", type=int, default=28992)
+    args = parser.parse_args()
+
+    if args.listen_unix:
+        pathlib.Path(args.listen_unix).unlink(missing_ok=True)
+        listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        listener.bind(args.listen_unix)
+        listener.listen()
+        print(f"Listening on {args.listen_unix}.")
+    else:
+        listener = socket.create_server(("", args.listen_port))
+        print(f"Listening on port {args.listen_port}.")
+
+    with listener:
+        while True:
+            client, _ = listener.accept()
+            with client, socket.create_connection((args.server_host, args.server_port)) as server:
+                server.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                if client.family != socket.AF_UNIX:
+                    client.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                try:
+                    serve(client, server)
+                except ConnectionError as e:
+                    print(f"Connection ended: {e}")
@@ -23,25 +23,43 @@
 #include "libtropic_port.h"
 #include "lt_asn1_der.h"
 #include "lt_crypto_common.h"
+#ifdef LT_ENTROPY_POOL
+#include "lt_entropy_pool.h"
+#endif
+#include "lt_hex.h"
 #include "lt_hkdf.h"
+#include "lt_ecc_inventory.h"
+#include "lt_eddsa_sig_cache.h"
+#include "lt_i_config_cache.h"
 #include "lt_l1.h"
+#ifdef LT_REBOOT_POLL
+#include "lt_l1_poll.h"
+#endif
 #include "lt_l2_api_structs.h"
 #include "lt_l3_api_structs.h"
+#include "lt_l3_buff_arena.h"
+#include "lt_l3_cmd_desc.h"
+#include "lt_l3_cmd_latency.h"
 #include "lt_l3_process.h"
+#include "lt_pairing_pub_cache.h"
 #include "lt_port_wrap.h"
+#include "lt_r_mem_map.h"
 #include "lt_secure_memzero.h"
+#ifdef LT_SESSION_CACHE
+#include "lt_session_cache_eph.h"
+#endif
 #include "lt_sha256.h"
 #include "lt_tr01_attrs.h"
 #include "lt_x25519.h"
 
-#define TR01_GET_INFO_BLOCK_LEN 128
-
-lt_ret_t lt_init(lt_handle_t *h)
+/**
+ * @brief Initializes the handle for communication with TROPIC01, except for the TROPIC01 attributes.
+ *
+ * @param h   Handle for communication with TROPIC01
+ * @return    LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_init_handle(lt_handle_t *h)
 {
-    if (!h) {
-        return LT_PARAM_ERR;
-    }
-
     lt_ret_t ret, ret_unused;
 
     // When compiling libtropic with l3 buffer embedded into handle,
@@ -51,6 +69,50 @@ lt_ret_t lt_init(lt_handle_t *h)
 #endif
 
     h->l3.session_status = LT_SECURE_SESSION_OFF;
+    // Contents of the buffer are not known yet, so the first wipe zeroes all of it.
+    h->l3.buff_dirty = h->l3.buff_len;
+#ifdef LT_STATS
+    h->l2.rt_stats = &h->stats;
+    h->l3.rt_stats = &h->stats;
+#endif
+#ifdef LT_I_CONFIG_CACHE
+    memset(&h->l3.i_config, 0, sizeof(h->l3.i_config));
+#endif
+#ifdef LT_ECC_INVENTORY
+    memset(&h->l3.ecc_inv, 0, sizeof(h->l3.ecc_inv));
+#endif
+#ifdef LT_PAIRING_PUB_CACHE
+    memset(&h->l3.pairing_pub, 0, sizeof(h->l3.pairing_pub));
+#endif
+#ifdef LT_R_MEM_MAP
+    h->l3.r_mem_map = NULL;
+#endif
+#ifdef LT_SESSION_CACHE
+    h->l3.session_cache = NULL;
+#endif
+#ifdef LT_WARM_INIT
+    h->tr01_attrs.unverified = 0;
+#endif
+#ifdef LT_SILICON_REV_CHECK
+    h->tr01_attrs.silicon_rev = LT_SILICON_REV_UNKNOWN;
+#endif
+#ifdef LT_HEALTH
+    h->l3.last_res_us = 0;
+#endif
+#ifdef LT_LINK_TUNE
+    // Until tuned, the port uses the SPI clock it is configured with.
+    memset(&h->l2.link, 0, sizeof(h->l2.link));
+#endif
+#ifdef LT_L1_ADAPTIVE_POLL
+    // Response latencies are learned again, the handle may be used with another TROPIC01 now.
+    memset(&h->l2.poll, 0, sizeof(h->l2.poll));
+#endif
+#ifdef LT_L3_CMD_LATENCY
+    // Built-in latencies until lt_set_l3_cmd_latency_table() is called.
+    h->l3.cmd_latency_tbl = NULL;
+    h->l3.cmd_latency_tbl_cnt = 0;
+    h->l2.presleep_ms = 0;
+#endif
     ret = lt_l1_init(&h->l2);
     h->l2.startup_req_sent = false;
     if (ret != LT_OK) {
@@ -68,12 +130,6 @@ lt_ret_t lt_init(lt_handle_t *h)
         goto crypto_ctx_cleanup;
     }
 
-    // Initialize the TROPIC01 attributes based on its Application FW.
-    ret = lt_init_tr01_attrs(h);
-    if (ret != LT_OK) {
-        goto crypto_ctx_cleanup;
-    }
-
     return LT_OK;
 
 crypto_ctx_cleanup:
@@ -86,6 +142,78 @@ l1_cleanup:
     return ret;
 }
 
+/** Releases what lt_init_handle() initialized, when the initialization of the TROPIC01 attributes failed. */
+static void lt_init_handle_cleanup(lt_handle_t *h)
+{
+    lt_ret_t ret_unused = lt_crypto_ctx_deinit(h->l3.crypto_ctx);
+    ret_unused = lt_l1_deinit(&h->l2);
+    LT_UNUSED(ret_unused);
+}
+
+lt_ret_t lt_init(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_init_handle(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Initialize the TROPIC01 attributes based on its Application FW.
+    ret = lt_init_tr01_attrs(h);
+    if (ret != LT_OK) {
+        lt_init_handle_cleanup(h);
+    }
+
+    return ret;
+}
+
+#ifdef LT_WARM_INIT
+lt_ret_t lt_init_warm(lt_handle_t *h, const lt_tr01_attrs_cache_t *cache)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_init_handle(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // TROPIC01 is neither probed nor rebooted, the attributes are verified after the first failed operation.
+    ret = lt_tr01_attrs_from_cache(h, cache);
+    if (ret != LT_OK) {
+        lt_init_handle_cleanup(h);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Verifies the TROPIC01 attributes taken from the cache by lt_init_warm() after a failed operation, so that
+ * the operation can be retried with the attributes of the running Application FW.
+ *
+ * @param h    Handle for communication with TROPIC01
+ * @param ret  Return value of the operation
+ * @return     ret, or error of the verification
+ */
+static lt_ret_t lt_tr01_attrs_check(lt_handle_t *h, const lt_ret_t ret)
+{
+    if ((ret == LT_OK) || !h->tr01_attrs.unverified) {
+        return ret;
+    }
+
+    lt_ret_t ret_verify = lt_tr01_attrs_verify(h);
+
+    return (ret_verify != LT_OK) ? ret_verify : ret;
+}
+#define LT_TR01_ATTRS_CHECK(h, ret) lt_tr01_attrs_check((h), (ret))
+#else
+#define LT_TR01_ATTRS_CHECK(h, ret) (ret)
+#endif
+
 lt_ret_t lt_deinit(lt_handle_t *h)
 {
     if (!h) {
@@ -152,44 +280,69 @@ lt_ret_t lt_get_tr01_mode(lt_handle_t *h, lt_tr01_mode_t *mode)
     return LT_L1_CHIP_BUSY;
 }
 
-lt_ret_t lt_get_info_cert_store(lt_handle_t *h, struct lt_cert_store_t *store)
+/**
+ * @brief Reads one block of the certificate store.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param index       Index of the block
+ * @param object      Set to the block data in the L2 buffer, TR01_GET_INFO_BLOCK_LEN bytes
+ * @return            LT_OK if successful, otherwise error code
+ */
+static lt_ret_t lt_get_info_cert_block(lt_handle_t *h, const int index, uint8_t **object)
 {
-    if (!h || !store) {
-        return LT_PARAM_ERR;
-    }
-
     // Setup a request pointer to l2 buffer with request data
     struct lt_l2_get_info_req_t *p_l2_req = (struct lt_l2_get_info_req_t *)h->l2.buff;
 
     // Setup a request pointer to l2 buffer with response data
     struct lt_l2_get_info_rsp_t *p_l2_resp = (struct lt_l2_get_info_rsp_t *)h->l2.buff;
 
+    p_l2_req->req_id = TR01_L2_GET_INFO_REQ_ID;
+    p_l2_req->req_len = TR01_L2_GET_INFO_REQ_LEN;
+    p_l2_req->object_id = TR01_L2_GET_INFO_REQ_OBJECT_ID_X509_CERTIFICATE;
+    p_l2_req->block_index = index;
+
+    lt_ret_t ret = lt_l2_send(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_l2_receive(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (TR01_GET_INFO_BLOCK_LEN != (p_l2_resp->rsp_len)) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    *object = p_l2_resp->object;
+
+    return LT_OK;
+}
+
+#ifdef LT_CMD_CERT_STORE
+lt_ret_t lt_get_info_cert_store(lt_handle_t *h, struct lt_cert_store_t *store)
+{
+    return lt_get_info_cert_store_partial(h, store, LT_CERT_KIND_TROPIC_ROOT);
+}
+
+lt_ret_t lt_get_info_cert_store_partial(lt_handle_t *h, struct lt_cert_store_t *store, const lt_cert_kind_t last)
+{
+    if (!h || !store || (last > LT_CERT_KIND_TROPIC_ROOT)) {
+        return LT_PARAM_ERR;
+    }
+
     // Max cert-store length not read out -> Optimized as being read to read out only needed part!
     int curr_cert = LT_CERT_KIND_DEVICE;
     uint8_t *cert_head = store->certs[curr_cert];
 
     // Worst case full ceert-store is read out
     for (int i = 0; i < (TR01_L2_GET_INFO_REQ_CERT_SIZE_TOTAL / TR01_GET_INFO_BLOCK_LEN); i++) {
-        p_l2_req->req_id = TR01_L2_GET_INFO_REQ_ID;
-        p_l2_req->req_len = TR01_L2_GET_INFO_REQ_LEN;
-        p_l2_req->object_id = TR01_L2_GET_INFO_REQ_OBJECT_ID_X509_CERTIFICATE;
-        p_l2_req->block_index = i;
-
-        lt_ret_t ret = lt_l2_send(&h->l2);
-        if (ret != LT_OK) {
-            return ret;
-        }
-
-        ret = lt_l2_receive(&h->l2);
+        uint8_t *head;
+        lt_ret_t ret = lt_get_info_cert_block(h, i, &head);
         if (ret != LT_OK) {
             return ret;
         }
-
-        if (TR01_GET_INFO_BLOCK_LEN != (p_l2_resp->rsp_len)) {
-            return LT_L2_RSP_LEN_ERROR;
-        }
-
-        uint8_t *head = ((struct lt_l2_get_info_rsp_t *)h->l2.buff)->object;
         uint8_t *tail = head + TR01_GET_INFO_BLOCK_LEN;
 
         // Parse the header - Gets lengths and checks buffers are large enough
@@ -210,6 +363,10 @@ lt_ret_t lt_get_info_cert_store(lt_handle_t *h, struct lt_cert_store_t *store)
                 curr_len |= *head;
                 head++;
 
+                if (j > (int)last) {
+                    store->cert_len[j] = 0;
+                    continue;
+                }
                 if (curr_len > store->buf_len[j]) {
                     return LT_PARAM_ERR;
                 }
@@ -234,7 +391,7 @@ lt_ret_t lt_get_info_cert_store(lt_handle_t *h, struct lt_cert_store_t *store)
 
         // Move to the next certificate or finish upon last chunk of last certificate
         if ((cert_head - store->certs[curr_cert]) >= store->cert_len[curr_cert]) {
-            if (curr_cert >= LT_NUM_CERTIFICATES - 1) {
+            if (curr_cert >= (int)last) {
                 break;
             }
             else {
@@ -265,6 +422,54 @@ lt_ret_t lt_get_st_pub(const struct lt_cert_store_t *store, uint8_t *stpub)
 
     return asn1der_find_object(head, len, LT_OBJ_ID_CURVEX25519, stpub, TR01_STPUB_LEN, LT_ASN1DER_CROP_PREFIX);
 }
+#endif
+
+lt_ret_t lt_get_info_st_pub(lt_handle_t *h, uint8_t *stpub)
+{
+    if (!h || !stpub) {
+        return LT_PARAM_ERR;
+    }
+
+    // Blocks are parsed as they arrive, no buffer for the certificate is needed and the rest of the device
+    // certificate after STPUB is not read at all.
+    struct lt_asn1der_stream_t parser;
+    uint16_t cert_len = 0;
+    uint16_t fed = 0;
+
+    for (int i = 0; i < (TR01_L2_GET_INFO_REQ_CERT_SIZE_TOTAL / TR01_GET_INFO_BLOCK_LEN); i++) {
+        uint8_t *head;
+        lt_ret_t ret = lt_get_info_cert_block(h, i, &head);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        uint16_t available = TR01_GET_INFO_BLOCK_LEN;
+
+        // Header: version, number of certificates and their lengths, device certificate is the first one.
+        if (i == 0) {
+            if ((head[0] != LT_CERT_STORE_VERSION) || (head[1] != LT_NUM_CERTIFICATES)) {
+                return LT_CERT_STORE_INVALID;
+            }
+            cert_len = (uint16_t)((head[2] << 8) | head[3]);
+            head += 2 + 2 * LT_NUM_CERTIFICATES;
+            available -= 2 + 2 * LT_NUM_CERTIFICATES;
+            asn1der_stream_init(&parser, cert_len, LT_OBJ_ID_CURVEX25519, stpub, TR01_STPUB_LEN,
+                                LT_ASN1DER_CROP_PREFIX);
+        }
+
+        uint16_t to_feed = lt_min(available, (uint16_t)(cert_len - fed));
+        ret = asn1der_stream_feed(&parser, head, to_feed);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        fed += to_feed;
+
+        if (parser.found || (fed == cert_len)) {
+            break;
+        }
+    }
+
+    return asn1der_stream_finish(&parser);
+}
 
 lt_ret_t lt_get_info_chip_id(lt_handle_t *h, struct lt_chip_id_t *chip_id)
 {
@@ -441,137 +646,817 @@ lt_ret_t lt_session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pkey_in
 
 cleanup:
     lt_secure_memzero(&host_eph_keys, sizeof(lt_host_eph_keys_t));
-    return ret;
+    return LT_TR01_ATTRS_CHECK(h, ret);
 }
 
-lt_ret_t lt_session_abort(lt_handle_t *h)
+#ifdef LT_ENTROPY_POOL
+lt_ret_t lt_entropy_pool_init(lt_entropy_pool_t *pool, const uint16_t low_watermark, const uint16_t high_watermark)
 {
-    if (!h) {
+    if (!pool || (low_watermark > high_watermark) || (high_watermark == 0)
+        || (high_watermark > LT_ENTROPY_POOL_SIZE)) {
         return LT_PARAM_ERR;
     }
 
-    lt_l3_invalidate_host_session_data(&h->l3);
+    lt_secure_memzero(pool, sizeof(lt_entropy_pool_t));
+    pool->low_watermark = low_watermark;
+    pool->high_watermark = high_watermark;
 
-    // Setup a request pointer to l2 buffer, which is placed in handle
-    struct lt_l2_encrypted_session_abt_req_t *p_l2_req = (struct lt_l2_encrypted_session_abt_req_t *)h->l2.buff;
-    // Setup a request pointer to l2 buffer with response data
-    struct lt_l2_encrypted_session_abt_rsp_t *p_l2_resp = (struct lt_l2_encrypted_session_abt_rsp_t *)h->l2.buff;
+    return LT_OK;
+}
 
-    p_l2_req->req_id = TR01_L2_ENCRYPTED_SESSION_ABT_ID;
-    p_l2_req->req_len = TR01_L2_ENCRYPTED_SESSION_ABT_LEN;
+lt_ret_t lt_entropy_pool_refill(lt_handle_t *h, lt_entropy_pool_t *pool)
+{
+    if (!h || !pool) {
+        return LT_PARAM_ERR;
+    }
 
-    lt_ret_t ret = lt_l2_send(&h->l2);
-    if (ret != LT_OK) {
-        return ret;
+    if (lt_entropy_pool_count(pool) >= pool->high_watermark) {
+        return LT_OK;
     }
-    ret = lt_l2_receive(&h->l2);
+
+#ifdef LT_ENTROPY_POOL_DRBG
+    // One Random_Value_Get reseeds the DRBG, which then fills the pool up to the high watermark.
+    uint8_t seed[LT_ENTROPY_POOL_DRBG_SEED_LEN];
+    lt_ret_t ret = lt_random_value_get(h, seed, sizeof(seed));
+    pool->chip_requests++;
+    if (ret == LT_OK) {
+        ret = lt_entropy_drbg_reseed(pool, seed, sizeof(seed));
+    }
+    lt_secure_memzero(seed, sizeof(seed));
     if (ret != LT_OK) {
         return ret;
     }
+#endif
 
-    if (TR01_L2_ENCRYPTED_SESSION_ABT_RSP_LEN != (p_l2_resp->rsp_len)) {
-        return LT_L2_RSP_LEN_ERROR;
+    uint16_t count;
+    while ((count = lt_entropy_pool_count(pool)) < pool->high_watermark) {
+        uint16_t len;
+        uint8_t *space = lt_entropy_pool_space(pool, &len);
+        len = lt_min(len, (uint16_t)(pool->high_watermark - count));
+#ifdef LT_ENTROPY_POOL_DRBG
+        ret = lt_entropy_drbg_generate(pool, space, len);
+#else
+        len = lt_min(len, (uint16_t)TR01_RANDOM_VALUE_GET_LEN_MAX);
+        lt_ret_t ret = lt_random_value_get(h, space, len);
+        pool->chip_requests++;
+#endif
+        if (ret != LT_OK) {
+            lt_secure_memzero(space, len);
+            return ret;
+        }
+
+        lt_entropy_pool_publish(pool, len);
     }
 
     return LT_OK;
 }
 
-lt_ret_t lt_sleep(lt_handle_t *h, const uint8_t sleep_kind)
+lt_ret_t lt_entropy_pool_get(lt_entropy_pool_t *pool, uint8_t *out, const uint16_t len)
 {
-    if (!h || ((sleep_kind != TR01_L2_SLEEP_KIND_SLEEP))) {
+    if (!pool || !out) {
         return LT_PARAM_ERR;
     }
 
-    // Setup a request pointer to l2 buffer, which is placed in handle
-    struct lt_l2_startup_req_t *p_l2_req = (struct lt_l2_startup_req_t *)h->l2.buff;
-    // Setup a request pointer to l2 buffer with response data
-    struct lt_l2_startup_rsp_t *p_l2_resp = (struct lt_l2_startup_rsp_t *)h->l2.buff;
+    if (!lt_entropy_pool_take(pool, out, len)) {
+        pool->underruns++;
+        return LT_ENTROPY_POOL_EMPTY;
+    }
 
-    p_l2_req->req_id = TR01_L2_SLEEP_REQ_ID;
-    p_l2_req->req_len = TR01_L2_SLEEP_REQ_LEN;
-    p_l2_req->startup_id = sleep_kind;
+    return LT_OK;
+}
 
-    lt_ret_t ret = lt_l2_send(&h->l2);
-    if (ret != LT_OK) {
-        return ret;
-    }
-    ret = lt_l2_receive(&h->l2);
-    if (ret != LT_OK) {
-        return ret;
+uint16_t lt_entropy_pool_available(const lt_entropy_pool_t *pool)
+{
+    if (!pool) {
+        return 0;
     }
 
-    if (TR01_L2_SLEEP_RSP_LEN != (p_l2_resp->rsp_len)) {
-        return LT_L2_RSP_LEN_ERROR;
+    return lt_entropy_pool_count(pool);
+}
+
+bool lt_entropy_pool_needs_refill(const lt_entropy_pool_t *pool)
+{
+    if (!pool) {
+        return false;
     }
 
-    return LT_OK;
+    return lt_entropy_pool_count(pool) < pool->low_watermark;
 }
+#endif
 
-lt_ret_t lt_reboot(lt_handle_t *h, const lt_startup_id_t startup_id)
+#ifdef LT_SESSION_CACHE
+lt_ret_t lt_session_cache_init(lt_handle_t *h, lt_session_cache_t *cache, const uint8_t *stpub, const uint8_t *shipub)
 {
-    if (!h || ((startup_id != TR01_REBOOT) && (startup_id != TR01_MAINTENANCE_REBOOT))) {
+    if (!h || !cache || !stpub || !shipub) {
         return LT_PARAM_ERR;
     }
 
-    // Setup a request pointer to l2 buffer, which is placed in handle
-    struct lt_l2_startup_req_t *p_l2_req = (struct lt_l2_startup_req_t *)h->l2.buff;
-    // Setup a request pointer to l2 buffer with response data
-    struct lt_l2_startup_rsp_t *p_l2_resp = (struct lt_l2_startup_rsp_t *)h->l2.buff;
-
-    p_l2_req->req_id = TR01_L2_STARTUP_REQ_ID;
-    p_l2_req->req_len = TR01_L2_STARTUP_REQ_LEN;
-    p_l2_req->startup_id = startup_id;
+    lt_session_cache_clear(cache);
 
-    lt_ret_t ret = lt_l2_send(&h->l2);
-    h->l2.startup_req_sent = true;
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
     if (ret != LT_OK) {
-        h->l2.startup_req_sent = false;
         return ret;
     }
-    ret = lt_l2_receive(&h->l2);
-    h->l2.startup_req_sent = false;
+    ret = lt_l3_transcript_prefix(h->l3.crypto_ctx, shipub, stpub, cache->prefix_hash);
+    lt_ret_t ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
+    LT_UNUSED(ret_unused);
     if (ret != LT_OK) {
+        lt_session_cache_clear(cache);
         return ret;
     }
 
-    if (TR01_L2_STARTUP_RSP_LEN != (p_l2_resp->rsp_len)) {
-        return LT_L2_RSP_LEN_ERROR;
-    }
-
-    ret = lt_l1_delay(&h->l2, LT_TR01_REBOOT_DELAY_MS);
-    if (ret != LT_OK) {
-        return ret;
-    }
+    memcpy(cache->stpub, stpub, sizeof(cache->stpub));
+    memcpy(cache->shipub, shipub, sizeof(cache->shipub));
+    cache->initialized = true;
 
-    // Get current TROPIC01 mode to check whether TROPIC01 was rebooted into the correct mode.
-    lt_tr01_mode_t tr01_mode;
-    ret = lt_get_tr01_mode(h, &tr01_mode);
-    if (ret != LT_OK) {
-        return ret;
-    }
+    return LT_OK;
+}
 
-    if (tr01_mode == LT_TR01_ALARM) {
-        return LT_L1_CHIP_ALARM_MODE;
+lt_ret_t lt_session_cache_prepare(lt_handle_t *h, lt_session_cache_t *cache)
+{
+    if (!h || !cache || !cache->initialized) {
+        return LT_PARAM_ERR;
     }
 
-    // Validate the current TROPIC01 mode based on the given `startup_id`.
-    if ((startup_id == TR01_REBOOT && tr01_mode != LT_TR01_APPLICATION)
-        || (startup_id == TR01_MAINTENANCE_REBOOT && tr01_mode != LT_TR01_MAINTENANCE)) {
-        return LT_REBOOT_UNSUCCESSFUL;
+    lt_session_eph_t *eph;
+    while ((eph = lt_session_cache_eph_slot(cache)) != NULL) {
+        lt_ret_t ret = lt_session_cache_eph_gen(h, cache, eph);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        lt_session_cache_eph_publish(cache);
     }
 
     return LT_OK;
 }
 
-#ifdef ABAB
-lt_ret_t lt_mutable_fw_erase(lt_handle_t *h, const lt_bank_id_t bank_id)
+void lt_session_cache_clear(lt_session_cache_t *cache)
 {
-    if (!h
+    if (cache) {
+        lt_secure_memzero(cache, sizeof(*cache));
+    }
+}
+
+lt_ret_t lt_session_cache_attach(lt_handle_t *h, lt_session_cache_t *cache)
+{
+    if (!h || (cache && !cache->initialized)) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l3.session_cache = cache;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_session_start_cached(lt_handle_t *h, lt_session_cache_t *cache, const lt_pkey_index_t pkey_index,
+                                 const uint8_t *shipriv)
+{
+    if (!h || !cache || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_out__session_start_cached(h, pkey_index, cache);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_l2_send(&h->l2);
+    if (ret != LT_OK) {
+        return LT_TR01_ATTRS_CHECK(h, ret);
+    }
+    ret = lt_l2_receive(&h->l2);
+    if (ret != LT_OK) {
+        return LT_TR01_ATTRS_CHECK(h, ret);
+    }
+
+    return LT_TR01_ATTRS_CHECK(h, lt_in__session_start_cached(h, pkey_index, shipriv, cache));
+}
+#endif
+
+#ifdef LT_SESSION_MGR
+lt_ret_t lt_session_mgr_init(lt_session_mgr_t *mgr, lt_handle_t *h, const uint8_t *stpub)
+{
+    if (!mgr || !h || !stpub) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(mgr, 0, sizeof(lt_session_mgr_t));
+    mgr->h = h;
+    memcpy(mgr->stpub, stpub, sizeof(mgr->stpub));
+    mgr->active = LT_SESSION_MGR_SLOTS;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_session_mgr_set_keys(lt_session_mgr_t *mgr, const lt_pkey_index_t pkey_index, const uint8_t *shipriv,
+                                 const uint8_t *shipub)
+{
+    if (!mgr || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv || !shipub) {
+        return LT_PARAM_ERR;
+    }
+
+    mgr->keys[pkey_index].shipriv = shipriv;
+    mgr->keys[pkey_index].shipub = shipub;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_session_mgr_submit(lt_session_mgr_t *mgr, const lt_pkey_index_t pkey_index, lt_session_mgr_fn_t fn,
+                               void *ctx, lt_ret_t *ret)
+{
+    if (!mgr || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !fn || !mgr->keys[pkey_index].shipriv) {
+        return LT_PARAM_ERR;
+    }
+    if (mgr->queue_cnt >= LT_SESSION_MGR_QUEUE_LEN) {
+        return LT_FAIL;
+    }
+
+    lt_session_mgr_req_t *req = &mgr->queue[mgr->queue_cnt++];
+    req->fn = fn;
+    req->ctx = ctx;
+    req->ret = ret;
+    req->pkey_index = (uint8_t)pkey_index;
+
+    return LT_OK;
+}
+
+/**
+ * @brief Picks pairing key slot of the next batch: the active slot while it has queued requests (no handshake is
+ * needed), otherwise slot of the oldest queued request, so no slot starves.
+ *
+ * @param mgr  Session manager with non-empty queue
+ * @return     Pairing key slot of the next batch
+ */
+static uint8_t lt_session_mgr_next_slot(const lt_session_mgr_t *mgr)
+{
+    for (uint8_t i = 0; i < mgr->queue_cnt; i++) {
+        if (mgr->queue[i].pkey_index == mgr->active) {
+            return mgr->active;
+        }
+    }
+
+    return mgr->queue[0].pkey_index;
+}
+
+/**
+ * @brief Executes (or fails with the passed error) all queued requests of the pairing key slot and removes them from
+ * the queue. Order of the remaining requests is kept.
+ *
+ * @param mgr         Session manager
+ * @param slot        Pairing key slot
+ * @param handshake   LT_OK to execute the requests, otherwise error stored as result of the requests
+ */
+static void lt_session_mgr_flush_slot(lt_session_mgr_t *mgr, const uint8_t slot, const lt_ret_t handshake)
+{
+    uint8_t kept = 0;
+
+    for (uint8_t i = 0; i < mgr->queue_cnt; i++) {
+        lt_session_mgr_req_t req = mgr->queue[i];
+
+        if (req.pkey_index != slot) {
+            mgr->queue[kept++] = req;
+            continue;
+        }
+
+        lt_ret_t ret = handshake;
+        if (ret == LT_OK) {
+            ret = req.fn(mgr->h, req.ctx);
+            mgr->stats.requests++;
+        }
+        if (req.ret) {
+            *req.ret = ret;
+        }
+    }
+
+    mgr->queue_cnt = kept;
+}
+
+lt_ret_t lt_session_mgr_run(lt_session_mgr_t *mgr)
+{
+    if (!mgr) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t first_err = LT_OK;
+
+    while (mgr->queue_cnt) {
+        uint8_t slot = lt_session_mgr_next_slot(mgr);
+        lt_ret_t ret = LT_OK;
+
+        // Handshake also when the session was lost in between (e.g. aborted by a request or by an error).
+        if ((slot != mgr->active) || (mgr->h->l3.session_status != LT_SECURE_SESSION_ON)) {
+            ret = lt_session_start(mgr->h, mgr->stpub, (lt_pkey_index_t)slot, mgr->keys[slot].shipriv,
+                                   mgr->keys[slot].shipub);
+            mgr->stats.handshakes++;
+            if (ret == LT_OK) {
+                if ((mgr->active != LT_SESSION_MGR_SLOTS) && (slot != mgr->active)) {
+                    mgr->stats.switches++;
+                }
+                mgr->active = slot;
+            }
+            else {
+                mgr->stats.handshake_errors++;
+                mgr->active = LT_SESSION_MGR_SLOTS;
+                if (first_err == LT_OK) {
+                    first_err = ret;
+                }
+            }
+        }
+
+        lt_session_mgr_flush_slot(mgr, slot, ret);
+        if (ret == LT_OK) {
+            mgr->stats.batches++;
+        }
+    }
+
+    return first_err;
+}
+
+lt_ret_t lt_session_mgr_get_stats(const lt_session_mgr_t *mgr, lt_session_mgr_stats_t *stats)
+{
+    if (!mgr || !stats) {
+        return LT_PARAM_ERR;
+    }
+
+    *stats = mgr->stats;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_session_mgr_reset_stats(lt_session_mgr_t *mgr)
+{
+    if (!mgr) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(&mgr->stats, 0, sizeof(mgr->stats));
+
+    return LT_OK;
+}
+
+uint32_t lt_session_mgr_switches_per_sec(const lt_session_mgr_stats_t *stats, const uint32_t elapsed_ms)
+{
+    if (!stats || !elapsed_ms) {
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)stats->switches * 1000) / elapsed_ms);
+}
+
+lt_ret_t lt_session_mgr_deinit(lt_session_mgr_t *mgr)
+{
+    if (!mgr) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = LT_OK;
+    if (mgr->h && (mgr->active != LT_SESSION_MGR_SLOTS)) {
+        ret = lt_session_abort(mgr->h);
+    }
+
+    lt_secure_memzero(mgr, sizeof(lt_session_mgr_t));
+
+    return ret;
+}
+#endif
+
+#ifdef LT_SESSION_ROLLOVER
+lt_ret_t lt_session_rollover_enable(lt_handle_t *h, const uint32_t threshold, const uint8_t *stpub,
+                                    const lt_pkey_index_t pkey_index, const uint8_t *shipriv, const uint8_t *shipub)
+{
+    if (!h || !threshold || !stpub || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv || !shipub) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_l3_rollover_t *rollover = &h->l3.rollover;
+    rollover->stpub = stpub;
+    rollover->shipriv = shipriv;
+    rollover->shipub = shipub;
+    rollover->threshold = threshold;
+    rollover->pkey_index = (uint8_t)pkey_index;
+    rollover->enabled = true;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_session_rollover_disable(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l3.rollover.enabled = false;
+
+    return LT_OK;
+}
+
+bool lt_session_rollover_due(const lt_handle_t *h)
+{
+    if (!h || !h->l3.rollover.enabled || (h->l3.session_status != LT_SECURE_SESSION_ON)) {
+        return false;
+    }
+
+    return lt_l3_nonce_get(&h->l3) >= h->l3.rollover.threshold;
+}
+
+lt_ret_t lt_session_rollover_poll(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+    if (!lt_session_rollover_due(h)) {
+        return LT_OK;
+    }
+
+    const lt_l3_rollover_t *rollover = &h->l3.rollover;
+    lt_ret_t ret = lt_session_start(h, rollover->stpub, (lt_pkey_index_t)rollover->pkey_index, rollover->shipriv,
+                                    rollover->shipub);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    h->l3.rollover.count++;
+
+    return LT_OK;
+}
+
+uint32_t lt_session_rollover_count(const lt_handle_t *h)
+{
+    if (!h) {
+        return 0;
+    }
+
+    return h->l3.rollover.count;
+}
+#endif
+
+lt_ret_t lt_session_abort(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_l3_invalidate_host_session_data(&h->l3);
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_encrypted_session_abt_req_t *p_l2_req = (struct lt_l2_encrypted_session_abt_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_encrypted_session_abt_rsp_t *p_l2_resp = (struct lt_l2_encrypted_session_abt_rsp_t *)h->l2.buff;
+
+    p_l2_req->req_id = TR01_L2_ENCRYPTED_SESSION_ABT_ID;
+    p_l2_req->req_len = TR01_L2_ENCRYPTED_SESSION_ABT_LEN;
+
+    lt_ret_t ret = lt_l2_send(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_l2_receive(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (TR01_L2_ENCRYPTED_SESSION_ABT_RSP_LEN != (p_l2_resp->rsp_len)) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sleep(lt_handle_t *h, const uint8_t sleep_kind)
+{
+    if (!h || ((sleep_kind != TR01_L2_SLEEP_KIND_SLEEP))) {
+        return LT_PARAM_ERR;
+    }
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_startup_req_t *p_l2_req = (struct lt_l2_startup_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_startup_rsp_t *p_l2_resp = (struct lt_l2_startup_rsp_t *)h->l2.buff;
+
+    p_l2_req->req_id = TR01_L2_SLEEP_REQ_ID;
+    p_l2_req->req_len = TR01_L2_SLEEP_REQ_LEN;
+    p_l2_req->startup_id = sleep_kind;
+
+    lt_ret_t ret = lt_l2_send(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_l2_receive(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (TR01_L2_SLEEP_RSP_LEN != (p_l2_resp->rsp_len)) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    return LT_OK;
+}
+
+/** Sends Startup_Req and receives its response, TROPIC01 starts to reboot while the response is clocked out. */
+static lt_ret_t lt_reboot_send(lt_handle_t *h, const lt_startup_id_t startup_id)
+{
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_startup_req_t *p_l2_req = (struct lt_l2_startup_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_startup_rsp_t *p_l2_resp = (struct lt_l2_startup_rsp_t *)h->l2.buff;
+
+    p_l2_req->req_id = TR01_L2_STARTUP_REQ_ID;
+    p_l2_req->req_len = TR01_L2_STARTUP_REQ_LEN;
+    p_l2_req->startup_id = startup_id;
+
+    lt_ret_t ret = lt_l2_send(&h->l2);
+    h->l2.startup_req_sent = true;
+    if (ret != LT_OK) {
+        h->l2.startup_req_sent = false;
+        return ret;
+    }
+    ret = lt_l2_receive(&h->l2);
+    h->l2.startup_req_sent = false;
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (TR01_L2_STARTUP_RSP_LEN != (p_l2_resp->rsp_len)) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    return LT_OK;
+}
+
+/** Checks whether TROPIC01 came up from the reboot in the mode given by startup_id. */
+static lt_ret_t lt_reboot_check_mode(lt_handle_t *h, const lt_startup_id_t startup_id)
+{
+    // Get current TROPIC01 mode to check whether TROPIC01 was rebooted into the correct mode.
+    lt_tr01_mode_t tr01_mode;
+    lt_ret_t ret = lt_get_tr01_mode(h, &tr01_mode);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (tr01_mode == LT_TR01_ALARM) {
+        return LT_L1_CHIP_ALARM_MODE;
+    }
+
+    // Validate the current TROPIC01 mode based on the given `startup_id`.
+    if ((startup_id == TR01_REBOOT && tr01_mode != LT_TR01_APPLICATION)
+        || (startup_id == TR01_MAINTENANCE_REBOOT && tr01_mode != LT_TR01_MAINTENANCE)) {
+        return LT_REBOOT_UNSUCCESSFUL;
+    }
+
+    return LT_OK;
+}
+
+#if defined(LT_REBOOT_POLL) || defined(LT_REBOOT_ASYNC)
+/** Tells whether CHIP_STATUS read after Startup_Req shows READY in the requested mode, or ALARM. */
+static bool lt_reboot_chip_up(const uint8_t chip_status, const lt_startup_id_t startup_id)
+{
+    const uint8_t startup_bit = (startup_id == TR01_MAINTENANCE_REBOOT) ? TR01_L1_CHIP_MODE_STARTUP_bit : 0;
+
+    // MISO of TROPIC01 which is still in reset reads as 0xFF, which is not a valid CHIP_STATUS.
+    if (chip_status == 0xFF) {
+        return false;
+    }
+
+    return (chip_status & TR01_L1_CHIP_MODE_ALARM_bit)
+           || ((chip_status & TR01_L1_CHIP_MODE_READY_bit)
+               && ((chip_status & TR01_L1_CHIP_MODE_STARTUP_bit) == startup_bit));
+}
+#endif
+
+#ifdef LT_REBOOT_POLL
+/**
+ * @brief Waits until TROPIC01 rebooted by Startup_Req reports READY in the requested mode, or ALARM (used only with
+ * LT_REBOOT_POLL).
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param startup_id  Startup ID of the sent Startup_Req
+ * @return            LT_OK also if TROPIC01 did not come up in the requested mode in time, the caller checks the mode,
+ *                    otherwise returns other error code.
+ */
+static lt_ret_t lt_reboot_wait_ready(lt_handle_t *h, const lt_startup_id_t startup_id)
+{
+    // TROPIC01 starts to reboot already while the response to Startup_Req is clocked out (see Erratum
+    // CI_TR01_ERR_2025091800), but for a while CHIP_STATUS may still show the mode it is leaving.
+    lt_ret_t ret = lt_l1_delay(&h->l2, LT_TR01_REBOOT_MIN_DELAY_MS);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    lt_l1_poll_start(&h->l2.poll);
+    while (true) {
+        h->l2.buff[0] = TR01_L1_GET_RESPONSE_REQ_ID;
+        ret = lt_l1_write(&h->l2, 1, LT_L1_TIMEOUT_MS_DEFAULT);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        const uint8_t chip_status = h->l2.buff[0];
+        // lt_l1_write() selected the learn slot of Get_Response, the start-up time is learned separately.
+        lt_l1_poll_set_reboot(&h->l2.poll);
+
+        if (lt_reboot_chip_up(chip_status, startup_id)) {
+            lt_l1_poll_done(&h->l2.poll);
+            return LT_OK;
+        }
+
+        const uint32_t delay_ms = lt_l1_poll_next_delay(&h->l2.poll);
+        if (delay_ms == 0) {
+            return LT_OK;
+        }
+        ret = lt_l1_delay(&h->l2, delay_ms);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+}
+#endif
+
+lt_ret_t lt_reboot(lt_handle_t *h, const lt_startup_id_t startup_id)
+{
+    if (!h || ((startup_id != TR01_REBOOT) && (startup_id != TR01_MAINTENANCE_REBOOT))) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_reboot_send(h, startup_id);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+#ifdef LT_REBOOT_POLL
+    ret = lt_reboot_wait_ready(h, startup_id);
+#else
+    ret = lt_l1_delay(&h->l2, LT_TR01_REBOOT_DELAY_MS);
+#endif
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_reboot_check_mode(h, startup_id);
+}
+
+#ifdef LT_REBOOT_ASYNC
+/** Finishes asynchronous reboot and reports it, a handle being initialized is deinitialized when it failed. */
+static lt_ret_t lt_reboot_async_finish(lt_reboot_async_t *r, const lt_ret_t ret)
+{
+    if ((ret != LT_OK) && r->init) {
+        lt_init_handle_cleanup(r->h);
+    }
+
+    r->ret = ret;
+    r->state = LT_REBOOT_ASYNC_DONE;
+    if (r->cb) {
+        r->cb(r->h, ret, r->cb_ctx);
+    }
+
+    return ret;
+}
+
+/** Sets up asynchronous reboot, CHIP_STATUS is read first after the time CHIP_STATUS may still show the old mode. */
+static void lt_reboot_async_setup(lt_reboot_async_t *r, lt_handle_t *h, const lt_startup_id_t startup_id,
+                                  const lt_reboot_async_state_t state, lt_reboot_async_cb_t cb, void *cb_ctx)
+{
+    r->h = h;
+    r->cb = cb;
+    r->cb_ctx = cb_ctx;
+    r->start_us = lt_port_time_us();
+    r->next_us = (state == LT_REBOOT_ASYNC_WAITING) ? r->start_us + LT_TR01_REBOOT_MIN_DELAY_MS * 1000U : r->start_us;
+    r->ret = LT_L1_CHIP_BUSY;
+    r->startup_id = startup_id;
+    r->state = state;
+    r->init = false;
+}
+
+lt_ret_t lt_reboot_async_start(lt_reboot_async_t *r, lt_handle_t *h, const lt_startup_id_t startup_id,
+                               lt_reboot_async_cb_t cb, void *cb_ctx)
+{
+    if (!r || !h || ((startup_id != TR01_REBOOT) && (startup_id != TR01_MAINTENANCE_REBOOT))) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_reboot_send(h, startup_id);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    lt_reboot_async_setup(r, h, startup_id, LT_REBOOT_ASYNC_WAITING, cb, cb_ctx);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_init_async_start(lt_reboot_async_t *r, lt_handle_t *h, lt_reboot_async_cb_t cb, void *cb_ctx)
+{
+    if (!r || !h) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_init_handle(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Steps of lt_init_tr01_attrs(), the reboot and the read of the attributes are left to lt_reboot_async_process().
+    h->tr01_attrs.r_mem_udata_slot_size_max = 0;
+    lt_tr01_mode_t tr01_mode;
+    ret = lt_get_tr01_mode(h, &tr01_mode);
+    if (ret != LT_OK) {
+        lt_init_handle_cleanup(h);
+        return ret;
+    }
+
+    if (tr01_mode != LT_TR01_APPLICATION) {
+        ret = lt_reboot_send(h, TR01_REBOOT);
+        if (ret != LT_OK) {
+            lt_init_handle_cleanup(h);
+            return ret;
+        }
+        lt_reboot_async_setup(r, h, TR01_REBOOT, LT_REBOOT_ASYNC_WAITING, cb, cb_ctx);
+    }
+    else {
+        lt_reboot_async_setup(r, h, TR01_REBOOT, LT_REBOOT_ASYNC_ATTRS, cb, cb_ctx);
+    }
+    r->init = true;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_reboot_async_process(lt_reboot_async_t *r)
+{
+    if (!r || (r->state == LT_REBOOT_ASYNC_IDLE)) {
+        return LT_PARAM_ERR;
+    }
+
+    if (r->state == LT_REBOOT_ASYNC_DONE) {
+        return r->ret;
+    }
+
+    const uint64_t now_us = lt_port_time_us();
+    if (now_us < r->next_us) {
+        return LT_L1_CHIP_BUSY;
+    }
+
+    lt_handle_t *h = r->h;
+    lt_ret_t ret;
+    if (r->state == LT_REBOOT_ASYNC_WAITING) {
+        h->l2.buff[0] = TR01_L1_GET_RESPONSE_REQ_ID;
+        ret = lt_l1_write(&h->l2, 1, LT_L1_TIMEOUT_MS_DEFAULT);
+        if (ret != LT_OK) {
+            return lt_reboot_async_finish(r, ret);
+        }
+
+        if (!lt_reboot_chip_up(h->l2.buff[0], r->startup_id)
+            && (now_us - r->start_us < (uint64_t)LT_TR01_REBOOT_DELAY_MS * 1000U)) {
+            r->next_us = now_us + LT_REBOOT_ASYNC_POLL_MS * 1000U;
+            return LT_L1_CHIP_BUSY;
+        }
+
+        // TROPIC01 is up, or it did not come up within the time lt_reboot() waits, the mode check tells which.
+        ret = lt_reboot_check_mode(h, r->startup_id);
+        if ((ret != LT_OK) || !r->init) {
+            return lt_reboot_async_finish(r, ret);
+        }
+    }
+
+    return lt_reboot_async_finish(r, lt_tr01_attrs_read(h));
+}
+
+uint32_t lt_reboot_async_delay_ms(const lt_reboot_async_t *r)
+{
+    if (!lt_reboot_async_busy(r)) {
+        return 0;
+    }
+
+    const uint64_t now_us = lt_port_time_us();
+    if (now_us >= r->next_us) {
+        return 0;
+    }
+
+    // Rounded up, so the process call after the delay is not early.
+    return (uint32_t)((r->next_us - now_us + 999U) / 1000U);
+}
+
+bool lt_reboot_async_busy(const lt_reboot_async_t *r)
+{
+    return r && (r->state != LT_REBOOT_ASYNC_IDLE) && (r->state != LT_REBOOT_ASYNC_DONE);
+}
+#endif
+
+#ifdef LT_CMD_FW_UPDATE
+#ifdef ABAB
+lt_ret_t lt_mutable_fw_erase(lt_handle_t *h, const lt_bank_id_t bank_id)
+{
+    if (!h
         || ((bank_id != TR01_FW_BANK_FW1) && (bank_id != TR01_FW_BANK_FW2) && (bank_id != TR01_FW_BANK_SPECT1)
             && (bank_id != TR01_FW_BANK_SPECT2))) {
         return LT_PARAM_ERR;
     }
 
+#ifdef LT_SILICON_REV_CHECK
+    lt_ret_t ret_rev = lt_silicon_rev_check(h);
+    if (ret_rev != LT_OK) {
+        return ret_rev;
+    }
+#endif
+
     // Setup a request pointer to l2 buffer, which is placed in handle
     struct lt_l2_mutable_fw_erase_req_t *p_l2_req = (struct lt_l2_mutable_fw_erase_req_t *)h->l2.buff;
     // Setup a request pointer to l2 buffer with response data
@@ -605,6 +1490,13 @@ lt_ret_t lt_mutable_fw_update(lt_handle_t *h, const uint8_t *fw_data, const uint
         return LT_PARAM_ERR;
     }
 
+#ifdef LT_SILICON_REV_CHECK
+    lt_ret_t ret_rev = lt_silicon_rev_check(h);
+    if (ret_rev != LT_OK) {
+        return ret_rev;
+    }
+#endif
+
     // Setup a request pointer to l2 buffer, which is placed in handle
     struct lt_l2_mutable_fw_update_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_req_t *)h->l2.buff;
     // Setup a request pointer to l2 buffer with response data
@@ -664,6 +1556,13 @@ lt_ret_t lt_mutable_fw_update(lt_handle_t *h, const uint8_t *update_request)
         return LT_PARAM_ERR;
     }
 
+#ifdef LT_SILICON_REV_CHECK
+    lt_ret_t ret_rev = lt_silicon_rev_check(h);
+    if (ret_rev != LT_OK) {
+        return ret_rev;
+    }
+#endif
+
     // This structure reflects incomming data and is used for passing those data into l2 frame
     struct data_format_t {
         uint8_t req_len;        /**< Length byte */
@@ -717,11 +1616,6 @@ lt_ret_t lt_mutable_fw_update_data(lt_handle_t *h, const uint8_t *update_data, c
         return LT_PARAM_ERR;
     }
 
-    // Setup a request pointer to l2 buffer, which is placed in handle
-    struct lt_l2_mutable_fw_update_data_req_t *p2_l2_req = (struct lt_l2_mutable_fw_update_data_req_t *)h->l2.buff;
-    // Setup a request pointer to l2 buffer with response data
-    struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
-
     // Normalized sizes for arithmetic.
     size_t upd_size = (size_t)update_data_size;
     size_t copy_len;
@@ -729,7 +1623,9 @@ lt_ret_t lt_mutable_fw_update_data(lt_handle_t *h, const uint8_t *update_data, c
     // Compute how many bytes are available in the `lt_l2_mutable_fw_update_data_req_t` struct starting at `req_len`.
     // This is a compile-time-safe calculation and prevents overflow into unknown memory.
     const size_t dest_offset = offsetof(struct lt_l2_mutable_fw_update_data_req_t, req_len);
-    const size_t dest_capacity = sizeof(*p2_l2_req) > dest_offset ? sizeof(*p2_l2_req) - dest_offset : 0U;
+    const size_t dest_capacity = sizeof(struct lt_l2_mutable_fw_update_data_req_t) > dest_offset
+                                     ? sizeof(struct lt_l2_mutable_fw_update_data_req_t) - dest_offset
+                                     : 0U;
 
     // Data consist of "request" and "data" parts,
     // 'data' byte chunks are taken starting from 'chunk_index'
@@ -741,21 +1637,47 @@ lt_ret_t lt_mutable_fw_update_data(lt_handle_t *h, const uint8_t *update_data, c
             return LT_PARAM_ERR;
         }
 
-        p2_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_DATA_REQ;
-        memcpy((uint8_t *)&p2_l2_req->req_len, update_data + chunk_index, copy_len);
-
-        lt_ret_t ret = lt_l2_send(&h->l2);
-        if (ret != LT_OK) {
-            return ret;
-        }
-        ret = lt_l2_receive(&h->l2);
+        lt_ret_t ret = lt_mutable_fw_update_data_chunk(h, update_data + chunk_index);
         if (ret != LT_OK) {
             return ret;
         }
+    }
 
-        if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
-            return LT_L2_RSP_LEN_ERROR;
-        }
+    return LT_OK;
+}
+
+lt_ret_t lt_mutable_fw_update_data_chunk(lt_handle_t *h, const uint8_t *chunk)
+{
+    if (!h || !chunk) {
+        return LT_PARAM_ERR;
+    }
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_mutable_fw_update_data_req_t *p2_l2_req = (struct lt_l2_mutable_fw_update_data_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
+
+    // Same capacity check as in lt_mutable_fw_update_data(), the chunk is copied starting at `req_len`.
+    const size_t dest_capacity = sizeof(*p2_l2_req) - offsetof(struct lt_l2_mutable_fw_update_data_req_t, req_len);
+    const size_t copy_len = (size_t)chunk[0] + 1U;
+    if (copy_len > dest_capacity) {
+        return LT_PARAM_ERR;
+    }
+
+    p2_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_DATA_REQ;
+    memcpy((uint8_t *)&p2_l2_req->req_len, chunk, copy_len);
+
+    lt_ret_t ret = lt_l2_send(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_l2_receive(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
+        return LT_L2_RSP_LEN_ERROR;
     }
 
     return LT_OK;
@@ -763,6 +1685,7 @@ lt_ret_t lt_mutable_fw_update_data(lt_handle_t *h, const uint8_t *update_data, c
 #else
 #error "Undefined silicon revision. Please define either ABAB or ACAB."
 #endif
+#endif
 
 lt_ret_t lt_get_log_req(lt_handle_t *h, uint8_t *log_msg, const uint16_t log_msg_max_size, uint16_t *log_msg_read_size)
 {
@@ -799,6 +1722,97 @@ lt_ret_t lt_get_log_req(lt_handle_t *h, uint8_t *log_msg, const uint16_t log_msg
     return LT_OK;
 }
 
+#ifdef LT_L3_STREAM_ENCRYPT
+/** Requests L3 Command prepared by the next lt_out__*() to be encrypted chunk by chunk while being sent. */
+#define LT_L3_ENCRYPT_STREAM_REQUEST(h) ((h)->l3.encrypt_stream = LT_L3_ENCRYPT_STREAM_REQ)
+#else
+#define LT_L3_ENCRYPT_STREAM_REQUEST(h) LT_UNUSED(h)
+#endif
+
+/**
+ * @brief Sends L3 Command prepared by lt_out__*(), which encrypts it unless LT_L3_ENCRYPT_STREAM_REQUEST() was used,
+ * then it is encrypted while being sent.
+ *
+ * @param h        Handle for communication with TROPIC01
+ * @param out_ret  Return value of lt_out__*()
+ * @return         LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l3_send_cmd(lt_handle_t *h, const lt_ret_t out_ret)
+{
+#ifdef LT_L3_STREAM_ENCRYPT
+    const uint8_t stream = h->l3.encrypt_stream;
+    h->l3.encrypt_stream = LT_L3_ENCRYPT_STREAM_OFF;
+#endif
+    if (out_ret != LT_OK) {
+        return out_ret;
+    }
+
+#ifdef LT_L3_STREAM_ENCRYPT
+    if (stream == LT_L3_ENCRYPT_STREAM_ON) {
+        const struct lt_l3_gen_frame_t *p_frame = (const struct lt_l3_gen_frame_t *)h->l3.buff;
+        const size_t packet_size = TR01_L3_SIZE_SIZE + p_frame->cmd_size + TR01_L3_TAG_SIZE;
+
+        lt_ret_t ret = lt_l2_send_encrypted_cmd_stream(&h->l2, h->l3.buff, h->l3.buff_len, lt_l3_encrypt_stream_chunk,
+                                                       &h->l3);
+        if (ret != LT_OK) {
+            // Chunks which were not sent are left in plaintext.
+            lt_secure_memzero(h->l3.buff, lt_min(packet_size, (size_t)h->l3.buff_len));
+        }
+        return ret;
+    }
+#endif
+
+    return lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
+}
+
+#ifdef LT_L3_FAST_PATH
+/** Longest message lt_ping() sends by lt_l3_fast_cmd(), so that its L3 Result fits into a 128 B chunk of TROPIC01. */
+#define LT_L3_FAST_PING_LEN_MAX (128 - TR01_L3_SIZE_SIZE - TR01_L3_RESULT_SIZE - TR01_L3_TAG_SIZE)
+
+/**
+ * @brief Executes L3 Command prepared by the caller at lt_l2_encrypted_cmd_chunk(), both the command and its result
+ * fitting into a single L2 chunk. The command is encrypted and the result decrypted right in l2 buffer, L3 buffer is
+ * not used at all.
+ *
+ * @param h         Handle for communication with TROPIC01
+ * @param res_size  Expected RES_SIZE of the result
+ * @param res       Decrypted L3 Result in l2 buffer is returned here, valid until the next L2 transfer
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l3_fast_cmd(lt_handle_t *h, const uint16_t res_size, uint8_t **res)
+{
+    uint8_t *cmd = lt_l2_encrypted_cmd_chunk(&h->l2);
+#ifdef LT_L3_CMD_LATENCY
+    // First byte of the command data is the command ID.
+    h->l2.presleep_ms = lt_l3_cmd_latency_get(h, ((const struct lt_l3_gen_frame_t *)cmd)->data[0]);
+#endif
+
+    lt_ret_t ret = lt_l3_encrypt_request_buff(&h->l3, cmd);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    uint8_t res_len;
+    ret = lt_l2_transfer_encrypted_single(&h->l2, res, &res_len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_l3_decrypt_response_buff(&h->l3, *res, res_len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // The result status is OK, we can check for precise size.
+    if (((const struct lt_l3_gen_frame_t *)*res)->cmd_size != res_size) {
+        lt_l3_invalidate_host_session_data(&h->l3);
+        return LT_L3_RES_SIZE_ERROR;
+    }
+
+    return LT_OK;
+}
+#endif
+
 lt_ret_t lt_ping(lt_handle_t *h, const uint8_t *msg_out, uint8_t *msg_in, const uint16_t msg_len)
 {
     if (!h || !msg_out || !msg_in || (msg_len > TR01_PING_LEN_MAX)) {
@@ -808,17 +1822,31 @@ lt_ret_t lt_ping(lt_handle_t *h, const uint8_t *msg_out, uint8_t *msg_in, const
         return LT_HOST_NO_SESSION;
     }
 
-    lt_ret_t ret = lt_out__ping(h, msg_out, msg_len);
-    if (ret != LT_OK) {
-        return ret;
+#ifdef LT_L3_FAST_PATH
+    if (msg_len <= LT_L3_FAST_PING_LEN_MAX) {
+        struct lt_l3_ping_cmd_t *p_l3_cmd = (struct lt_l3_ping_cmd_t *)lt_l2_encrypted_cmd_chunk(&h->l2);
+        p_l3_cmd->cmd_size = TR01_L3_PING_CMD_SIZE_MIN + msg_len;
+        p_l3_cmd->cmd_id = TR01_L3_PING_CMD_ID;
+        memcpy(p_l3_cmd->data_in, msg_out, msg_len);
+
+        uint8_t *res;
+        lt_ret_t ret = lt_l3_fast_cmd(h, TR01_L3_PING_RES_SIZE_MIN + msg_len, &res);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        memcpy(msg_in, ((const struct lt_l3_ping_res_t *)res)->data_out, msg_len);
+        return LT_OK;
     }
+#endif
 
-    ret = lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
+    LT_L3_ENCRYPT_STREAM_REQUEST(h);
+    lt_ret_t ret = lt_l3_send_cmd(h, lt_out__ping(h, msg_out, msg_len));
     if (ret != LT_OK) {
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_PING_RES_PACKET_SIZE_MAX));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_PING));
     if (ret != LT_OK) {
         return ret;
     }
@@ -835,6 +1863,9 @@ lt_ret_t lt_pairing_key_write(lt_handle_t *h, const uint8_t *pairing_pub, const
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_PAIRING_PUB_CACHE
+    lt_pairing_pub_cache_forget(h, slot);
+#endif
     lt_ret_t ret = lt_out__pairing_key_write(h, pairing_pub, slot);
     if (ret != LT_OK) {
         return ret;
@@ -845,13 +1876,17 @@ lt_ret_t lt_pairing_key_write(lt_handle_t *h, const uint8_t *pairing_pub, const
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff,
-                                   lt_min(h->l3.buff_len, TR01_L3_PAIRING_KEY_WRITE_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_PAIRING_KEY_WRITE));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__pairing_key_write(h);
+    ret = lt_in__pairing_key_write(h);
+#ifdef LT_PAIRING_PUB_CACHE
+    lt_pairing_pub_cache_merge_write(h, slot, ret, pairing_pub);
+#endif
+
+    return ret;
 }
 
 lt_ret_t lt_pairing_key_read(lt_handle_t *h, uint8_t *pairing_pub, const uint8_t slot)
@@ -863,6 +1898,12 @@ lt_ret_t lt_pairing_key_read(lt_handle_t *h, uint8_t *pairing_pub, const uint8_t
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_PAIRING_PUB_CACHE
+    lt_ret_t ret_cache;
+    if (lt_pairing_pub_cache_read(h, slot, pairing_pub, &ret_cache)) {
+        return ret_cache;
+    }
+#endif
     lt_ret_t ret = lt_out__pairing_key_read(h, slot);
     if (ret != LT_OK) {
         return ret;
@@ -873,13 +1914,17 @@ lt_ret_t lt_pairing_key_read(lt_handle_t *h, uint8_t *pairing_pub, const uint8_t
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff,
-                                   lt_min(h->l3.buff_len, TR01_L3_PAIRING_KEY_READ_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_PAIRING_KEY_READ));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__pairing_key_read(h, pairing_pub);
+    ret = lt_in__pairing_key_read(h, pairing_pub);
+#ifdef LT_PAIRING_PUB_CACHE
+    lt_pairing_pub_cache_merge_read(h, slot, ret, pairing_pub);
+#endif
+
+    return ret;
 }
 
 lt_ret_t lt_pairing_key_invalidate(lt_handle_t *h, const uint8_t slot)
@@ -891,6 +1936,9 @@ lt_ret_t lt_pairing_key_invalidate(lt_handle_t *h, const uint8_t slot)
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_PAIRING_PUB_CACHE
+    lt_pairing_pub_cache_forget(h, slot);
+#endif
     lt_ret_t ret = lt_out__pairing_key_invalidate(h, slot);
     if (ret != LT_OK) {
         return ret;
@@ -901,15 +1949,20 @@ lt_ret_t lt_pairing_key_invalidate(lt_handle_t *h, const uint8_t slot)
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff,
-                                   lt_min(h->l3.buff_len, TR01_L3_PAIRING_KEY_INVALIDATE_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_PAIRING_KEY_INVALIDATE));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__pairing_key_invalidate(h);
+    ret = lt_in__pairing_key_invalidate(h);
+#ifdef LT_PAIRING_PUB_CACHE
+    lt_pairing_pub_cache_merge_invalidate(h, slot, ret);
+#endif
+
+    return ret;
 }
 
+#ifdef LT_CMD_CONFIG
 lt_ret_t lt_r_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t addr, const uint32_t obj)
 {
     if (!h) {
@@ -929,7 +1982,7 @@ lt_ret_t lt_r_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t addr,
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_R_CONFIG_WRITE_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_R_CONFIG_WRITE));
     if (ret != LT_OK) {
         return ret;
     }
@@ -946,6 +1999,21 @@ lt_ret_t lt_r_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr,
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_L3_FAST_PATH
+    struct lt_l3_r_config_read_cmd_t *p_l3_cmd = (struct lt_l3_r_config_read_cmd_t *)lt_l2_encrypted_cmd_chunk(&h->l2);
+    p_l3_cmd->cmd_size = TR01_L3_R_CONFIG_READ_CMD_SIZE;
+    p_l3_cmd->cmd_id = TR01_L3_R_CONFIG_READ_CMD_ID;
+    p_l3_cmd->address = (uint16_t)addr;
+
+    uint8_t *res;
+    lt_ret_t ret = lt_l3_fast_cmd(h, TR01_L3_R_CONFIG_READ_RES_SIZE, &res);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    *obj = ((const struct lt_l3_r_config_read_res_t *)res)->value;
+    return LT_OK;
+#else
     lt_ret_t ret = lt_out__r_config_read(h, addr);
     if (ret != LT_OK) {
         return ret;
@@ -956,12 +2024,13 @@ lt_ret_t lt_r_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr,
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_R_CONFIG_READ_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_R_CONFIG_READ));
     if (ret != LT_OK) {
         return ret;
     }
 
     return lt_in__r_config_read(h, obj);
+#endif
 }
 
 lt_ret_t lt_r_config_erase(lt_handle_t *h)
@@ -983,7 +2052,7 @@ lt_ret_t lt_r_config_erase(lt_handle_t *h)
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_R_CONFIG_ERASE_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_R_CONFIG_ERASE));
     if (ret != LT_OK) {
         return ret;
     }
@@ -1000,22 +2069,31 @@ lt_ret_t lt_i_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t addr,
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_I_CONFIG_CACHE
+    // Cleared bit cannot be set back, writing it again changes nothing.
+    if (lt_i_config_cache_bit_cleared(&h->l3.i_config, addr, bit_index)) {
+        return LT_OK;
+    }
+#endif
+
     lt_ret_t ret = lt_out__i_config_write(h, addr, bit_index);
     if (ret != LT_OK) {
         return ret;
     }
 
     ret = lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
-    if (ret != LT_OK) {
-        return ret;
+    if (ret == LT_OK) {
+        ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_I_CONFIG_WRITE));
     }
-
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_I_CONFIG_WRITE_RES_PACKET_SIZE));
-    if (ret != LT_OK) {
-        return ret;
+    if (ret == LT_OK) {
+        ret = lt_in__i_config_write(h);
     }
 
-    return lt_in__i_config_write(h);
+#ifdef LT_I_CONFIG_CACHE
+    lt_i_config_cache_merge_write(&h->l3.i_config, addr, bit_index, ret == LT_OK);
+#endif
+
+    return ret;
 }
 
 lt_ret_t lt_i_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr, uint32_t *obj)
@@ -1027,6 +2105,12 @@ lt_ret_t lt_i_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr,
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_I_CONFIG_CACHE
+    if (lt_i_config_cache_get(&h->l3.i_config, addr, obj)) {
+        return LT_OK;
+    }
+#endif
+
     lt_ret_t ret = lt_out__i_config_read(h, addr);
     if (ret != LT_OK) {
         return ret;
@@ -1037,16 +2121,52 @@ lt_ret_t lt_i_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t addr,
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_I_CONFIG_READ_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_I_CONFIG_READ));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_in__i_config_read(h, obj);
+#ifdef LT_I_CONFIG_CACHE
+    if (ret == LT_OK) {
+        lt_i_config_cache_put(&h->l3.i_config, addr, *obj);
+    }
+#endif
+
+    return ret;
+}
+#endif
+
+/** Sends R_Mem_Data_Write for lt_r_mem_data_write(), which checked the parameters. */
+#ifdef LT_CMD_R_MEM
+static lt_ret_t lt_r_mem_data_write_cmd(lt_handle_t *h, const uint16_t udata_slot, const uint8_t *data,
+                                        const uint16_t data_size)
+{
+    LT_L3_ENCRYPT_STREAM_REQUEST(h);
+    lt_ret_t ret = lt_l3_send_cmd(h, lt_out__r_mem_data_write(h, udata_slot, data, data_size));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__i_config_read(h, obj);
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_R_MEM_DATA_WRITE));
+    if (ret != LT_OK) {
+        return LT_TR01_ATTRS_CHECK(h, ret);
+    }
+
+    return LT_TR01_ATTRS_CHECK(h, lt_in__r_mem_data_write(h));
 }
 
 lt_ret_t lt_r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, const uint8_t *data, const uint16_t data_size)
 {
+#ifdef LT_WARM_INIT
+    // Slot size taken from the cache may belong to older Application FW.
+    if (h && (data_size > h->tr01_attrs.r_mem_udata_slot_size_max)) {
+        lt_ret_t ret = lt_tr01_attrs_verify(h);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+#endif
     if (!h || !data || data_size < TR01_R_MEM_DATA_SIZE_MIN || data_size > h->tr01_attrs.r_mem_udata_slot_size_max
         || (udata_slot > TR01_R_MEM_DATA_SLOT_MAX)) {
         return LT_PARAM_ERR;
@@ -1055,7 +2175,26 @@ lt_ret_t lt_r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, const ui
         return LT_HOST_NO_SESSION;
     }
 
-    lt_ret_t ret = lt_out__r_mem_data_write(h, udata_slot, data, data_size);
+#ifdef LT_R_MEM_MAP
+    lt_ret_t ret = lt_r_mem_map_before_change(h, udata_slot);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_r_mem_data_write_cmd(h, udata_slot, data, data_size);
+    lt_r_mem_map_merge_write(h, udata_slot, ret);
+
+    return ret;
+#else
+    return lt_r_mem_data_write_cmd(h, udata_slot, data, data_size);
+#endif
+}
+
+/** Sends R_Mem_Data_Read for lt_r_mem_data_read(), which checked the parameters. */
+static lt_ret_t lt_r_mem_data_read_cmd(lt_handle_t *h, const uint16_t udata_slot, uint8_t *data,
+                                       const uint16_t data_max_size, uint16_t *data_read_size)
+{
+    lt_ret_t ret = lt_out__r_mem_data_read(h, udata_slot);
     if (ret != LT_OK) {
         return ret;
     }
@@ -1065,13 +2204,52 @@ lt_ret_t lt_r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, const ui
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff,
-                                   lt_min(h->l3.buff_len, TR01_L3_R_MEM_DATA_WRITE_RES_PACKET_SIZE));
+#ifdef LT_L3_STREAM_DECRYPT
+    // L3 buffer is no longer needed, the data are decrypted straight into the caller's buffer.
+    lt_l3_buff_return(&h->l3);
+
+    lt_l3_decrypt_stream_t st;
+    lt_l3_decrypt_stream_start(&st, &h->l3, TR01_L3_RESULT_SIZE + TR01_L3_R_MEM_DATA_READ_PADDING_SIZE, data,
+                               data_max_size,
+                               TR01_L3_RESULT_SIZE + TR01_L3_R_MEM_DATA_READ_PADDING_SIZE
+                                   + h->tr01_attrs.r_mem_udata_slot_size_max);
+    ret = lt_l3_decrypt_stream_finish(&st, lt_l2_recv_encrypted_res_stream(&h->l2, lt_l3_decrypt_stream_chunk, &st));
+    if (ret != LT_OK) {
+        return LT_TR01_ATTRS_CHECK(h, ret);
+    }
+
+    // Same checks as in lt_in__r_mem_data_read(), RES_SIZE was already checked against the size of the slot.
+    if (st.res_size < TR01_L3_RESULT_SIZE + TR01_L3_R_MEM_DATA_READ_PADDING_SIZE) {
+        lt_l3_invalidate_host_session_data(&h->l3);
+        return LT_L3_RES_SIZE_ERROR;
+    }
+    *data_read_size = st.res_size - TR01_L3_RESULT_SIZE - TR01_L3_R_MEM_DATA_READ_PADDING_SIZE;
+    if (*data_read_size == 0) {
+        return LT_L3_R_MEM_DATA_READ_SLOT_EMPTY;
+    }
+    if (data_max_size < *data_read_size) {
+        lt_secure_memzero(data, data_max_size);
+        return LT_PARAM_ERR;
+    }
+
+    return LT_OK;
+#else
+    ret = lt_l2_recv_encrypted_res(
+        &h->l2, h->l3.buff,
+        lt_min(h->l3.buff_len, TR01_L3_SIZE_SIZE + TR01_L3_RESULT_SIZE
+                                   + (TR01_L3_R_MEM_DATA_READ_PADDING_SIZE + h->tr01_attrs.r_mem_udata_slot_size_max)
+                                   + TR01_L3_TAG_SIZE));
     if (ret != LT_OK) {
+        return LT_TR01_ATTRS_CHECK(h, ret);
+    }
+
+    ret = lt_in__r_mem_data_read(h, data, data_max_size, data_read_size);
+    if (ret == LT_L3_R_MEM_DATA_READ_SLOT_EMPTY) {
         return ret;
     }
 
-    return lt_in__r_mem_data_write(h);
+    return LT_TR01_ATTRS_CHECK(h, ret);
+#endif
 }
 
 lt_ret_t lt_r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot, uint8_t *data, const uint16_t data_max_size,
@@ -1084,7 +2262,20 @@ lt_ret_t lt_r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot, uint8_t *
         return LT_HOST_NO_SESSION;
     }
 
-    lt_ret_t ret = lt_out__r_mem_data_read(h, udata_slot);
+#ifdef LT_R_MEM_MAP
+    lt_ret_t ret = lt_r_mem_data_read_cmd(h, udata_slot, data, data_max_size, data_read_size);
+    lt_r_mem_map_merge_read(h, udata_slot, ret);
+
+    return ret;
+#else
+    return lt_r_mem_data_read_cmd(h, udata_slot, data, data_max_size, data_read_size);
+#endif
+}
+
+/** Sends R_Mem_Data_Erase for lt_r_mem_data_erase(), which checked the parameters. */
+static lt_ret_t lt_r_mem_data_erase_cmd(lt_handle_t *h, const uint16_t udata_slot)
+{
+    lt_ret_t ret = lt_out__r_mem_data_erase(h, udata_slot);
     if (ret != LT_OK) {
         return ret;
     }
@@ -1094,16 +2285,12 @@ lt_ret_t lt_r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot, uint8_t *
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(
-        &h->l2, h->l3.buff,
-        lt_min(h->l3.buff_len, TR01_L3_SIZE_SIZE + TR01_L3_RESULT_SIZE
-                                   + (TR01_L3_R_MEM_DATA_READ_PADDING_SIZE + h->tr01_attrs.r_mem_udata_slot_size_max)
-                                   + TR01_L3_TAG_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_R_MEM_DATA_ERASE));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__r_mem_data_read(h, data, data_max_size, data_read_size);
+    return lt_in__r_mem_data_erase(h);
 }
 
 lt_ret_t lt_r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot)
@@ -1115,24 +2302,21 @@ lt_ret_t lt_r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot)
         return LT_HOST_NO_SESSION;
     }
 
-    lt_ret_t ret = lt_out__r_mem_data_erase(h, udata_slot);
-    if (ret != LT_OK) {
-        return ret;
-    }
-
-    ret = lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
+#ifdef LT_R_MEM_MAP
+    lt_ret_t ret = lt_r_mem_map_before_change(h, udata_slot);
     if (ret != LT_OK) {
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff,
-                                   lt_min(h->l3.buff_len, TR01_L3_R_MEM_DATA_ERASE_RES_PACKET_SIZE));
-    if (ret != LT_OK) {
-        return ret;
-    }
+    ret = lt_r_mem_data_erase_cmd(h, udata_slot);
+    lt_r_mem_map_merge_erase(h, udata_slot, ret);
 
-    return lt_in__r_mem_data_erase(h);
+    return ret;
+#else
+    return lt_r_mem_data_erase_cmd(h, udata_slot);
+#endif
 }
+#endif
 
 lt_ret_t lt_random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt)
 {
@@ -1153,15 +2337,37 @@ lt_ret_t lt_random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint16_t
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff,
-                                   lt_min(h->l3.buff_len, TR01_L3_RANDOM_VALUE_GET_RES_PACKET_SIZE_MAX));
+#ifdef LT_L3_STREAM_DECRYPT
+    // L3 buffer is no longer needed, the random bytes are decrypted straight into the caller's buffer.
+    lt_l3_buff_return(&h->l3);
+
+    lt_l3_decrypt_stream_t st;
+    lt_l3_decrypt_stream_start(&st, &h->l3, TR01_L3_RANDOM_VALUE_GET_RES_SIZE_MIN, rnd_bytes, rnd_bytes_cnt,
+                               TR01_L3_RANDOM_VALUE_GET_RES_SIZE_MIN + rnd_bytes_cnt);
+    ret = lt_l3_decrypt_stream_finish(&st, lt_l2_recv_encrypted_res_stream(&h->l2, lt_l3_decrypt_stream_chunk, &st));
+    if (ret != LT_OK) {
+        return LT_TR01_ATTRS_CHECK(h, ret);
+    }
+
+    // Same check as in lt_in__random_value_get().
+    if (st.res_size != TR01_L3_RANDOM_VALUE_GET_RES_SIZE_MIN + rnd_bytes_cnt) {
+        lt_secure_memzero(rnd_bytes, rnd_bytes_cnt);
+        lt_l3_invalidate_host_session_data(&h->l3);
+        return LT_L3_RES_SIZE_ERROR;
+    }
+
+    return LT_OK;
+#else
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_RANDOM_VALUE_GET));
     if (ret != LT_OK) {
         return ret;
     }
 
     return lt_in__random_value_get(h, rnd_bytes, rnd_bytes_cnt);
+#endif
 }
 
+#ifdef LT_CMD_ECC
 lt_ret_t lt_ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve)
 {
     if (!h || (slot > TR01_ECC_SLOT_31) || ((curve != TR01_CURVE_P256) && (curve != TR01_CURVE_ED25519))) {
@@ -1171,6 +2377,14 @@ lt_ret_t lt_ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_ECC_INVENTORY
+    // Until TROPIC01 confirms the result, it is not known whether the slot changed.
+    lt_ecc_inventory_forget(h, slot);
+#endif
+#ifdef LT_EDDSA_SIG_CACHE
+    lt_eddsa_sig_cache_key_changed(h, slot);
+#endif
+
     lt_ret_t ret = lt_out__ecc_key_generate(h, slot, curve);
     if (ret != LT_OK) {
         return ret;
@@ -1181,13 +2395,19 @@ lt_ret_t lt_ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff,
-                                   lt_min(h->l3.buff_len, TR01_L3_ECC_KEY_GENERATE_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_ECC_KEY_GENERATE));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__ecc_key_generate(h);
+    ret = lt_in__ecc_key_generate(h);
+#ifdef LT_ECC_INVENTORY
+    if (ret == LT_OK) {
+        lt_ecc_inventory_put_key(h, slot, curve, TR01_CURVE_GENERATED);
+    }
+#endif
+
+    return ret;
 }
 
 lt_ret_t lt_ecc_key_store(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve, const uint8_t *key)
@@ -1198,6 +2418,13 @@ lt_ret_t lt_ecc_key_store(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc
     if (h->l3.session_status != LT_SECURE_SESSION_ON) {
         return LT_HOST_NO_SESSION;
     }
+#ifdef LT_ECC_INVENTORY
+    // Until TROPIC01 confirms the result, it is not known whether the slot changed.
+    lt_ecc_inventory_forget(h, slot);
+#endif
+#ifdef LT_EDDSA_SIG_CACHE
+    lt_eddsa_sig_cache_key_changed(h, slot);
+#endif
     lt_ret_t ret = lt_out__ecc_key_store(h, slot, curve, key);
     if (ret != LT_OK) {
         return ret;
@@ -1208,12 +2435,19 @@ lt_ret_t lt_ecc_key_store(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_ECC_KEY_STORE_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_ECC_KEY_STORE));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__ecc_key_store(h);
+    ret = lt_in__ecc_key_store(h);
+#ifdef LT_ECC_INVENTORY
+    if (ret == LT_OK) {
+        lt_ecc_inventory_put_key(h, slot, curve, TR01_CURVE_STORED);
+    }
+#endif
+
+    return ret;
 }
 
 lt_ret_t lt_ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, uint8_t *key, const uint8_t key_max_size,
@@ -1226,6 +2460,13 @@ lt_ret_t lt_ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, uint8_t *
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_ECC_INVENTORY
+    lt_ret_t ret_inv;
+    if (lt_ecc_inventory_read(h, ecc_slot, key, key_max_size, curve, origin, &ret_inv)) {
+        return ret_inv;
+    }
+#endif
+
     lt_ret_t ret = lt_out__ecc_key_read(h, ecc_slot);
     if (ret != LT_OK) {
         return ret;
@@ -1236,13 +2477,17 @@ lt_ret_t lt_ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, uint8_t *
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff,
-                                   lt_min(h->l3.buff_len, TR01_L3_ECC_KEY_READ_RES_PACKET_SIZE_MAX));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_ECC_KEY_READ));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__ecc_key_read(h, key, key_max_size, curve, origin);
+    ret = lt_in__ecc_key_read(h, key, key_max_size, curve, origin);
+#ifdef LT_ECC_INVENTORY
+    lt_ecc_inventory_merge_read(h, ecc_slot, ret, key, *curve, *origin);
+#endif
+
+    return ret;
 }
 
 lt_ret_t lt_ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t ecc_slot)
@@ -1254,6 +2499,23 @@ lt_ret_t lt_ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t ecc_slot)
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_ECC_INVENTORY
+    // Until TROPIC01 confirms the result, it is not known whether the slot changed.
+    lt_ecc_inventory_forget(h, ecc_slot);
+#endif
+#ifdef LT_EDDSA_SIG_CACHE
+    lt_eddsa_sig_cache_key_changed(h, ecc_slot);
+#endif
+
+#ifdef LT_L3_FAST_PATH
+    struct lt_l3_ecc_key_erase_cmd_t *p_l3_cmd = (struct lt_l3_ecc_key_erase_cmd_t *)lt_l2_encrypted_cmd_chunk(&h->l2);
+    p_l3_cmd->cmd_size = TR01_L3_ECC_KEY_ERASE_CMD_SIZE;
+    p_l3_cmd->cmd_id = TR01_L3_ECC_KEY_ERASE_CMD_ID;
+    p_l3_cmd->slot = ecc_slot;
+
+    uint8_t *res;
+    lt_ret_t ret = lt_l3_fast_cmd(h, TR01_L3_ECC_KEY_ERASE_RES_SIZE, &res);
+#else
     lt_ret_t ret = lt_out__ecc_key_erase(h, ecc_slot);
     if (ret != LT_OK) {
         return ret;
@@ -1264,12 +2526,20 @@ lt_ret_t lt_ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t ecc_slot)
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_ECC_KEY_ERASE_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_ECC_KEY_ERASE));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__ecc_key_erase(h);
+    ret = lt_in__ecc_key_erase(h);
+#endif
+#ifdef LT_ECC_INVENTORY
+    if (ret == LT_OK) {
+        lt_ecc_inventory_put_empty(h, ecc_slot);
+    }
+#endif
+
+    return ret;
 }
 
 lt_ret_t lt_ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint32_t msg_len,
@@ -1292,7 +2562,7 @@ lt_ret_t lt_ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const u
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_ECDSA_SIGN_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_ECDSA_SIGN));
     if (ret != LT_OK) {
         return ret;
     }
@@ -1300,17 +2570,16 @@ lt_ret_t lt_ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const u
     return lt_in__ecc_ecdsa_sign(h, rs);
 }
 
-lt_ret_t lt_ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint16_t msg_len,
-                           uint8_t *rs)
+lt_ret_t lt_ecc_ecdsa_sign_digest(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg_hash, uint8_t *rs)
 {
-    if (!h || !msg || !rs || (msg_len > TR01_L3_EDDSA_SIGN_CMD_MSG_LEN_MAX) || (ecc_slot > TR01_ECC_SLOT_31)) {
+    if (!h || !msg_hash || !rs || (ecc_slot > TR01_ECC_SLOT_31)) {
         return LT_PARAM_ERR;
     }
     if (h->l3.session_status != LT_SECURE_SESSION_ON) {
         return LT_HOST_NO_SESSION;
     }
 
-    lt_ret_t ret = lt_out__ecc_eddsa_sign(h, ecc_slot, msg, msg_len);
+    lt_ret_t ret = lt_out__ecc_ecdsa_sign_digest(h, ecc_slot, msg_hash);
     if (ret != LT_OK) {
         return ret;
     }
@@ -1320,14 +2589,56 @@ lt_ret_t lt_ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const u
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_EDDSA_SIGN_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_ECDSA_SIGN));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_in__ecc_ecdsa_sign(h, rs);
+}
+
+lt_ret_t lt_ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint16_t msg_len,
+                           uint8_t *rs)
+{
+    if (!h || !msg || !rs || (msg_len > TR01_L3_EDDSA_SIGN_CMD_MSG_LEN_MAX) || (ecc_slot > TR01_ECC_SLOT_31)) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+
+#ifdef LT_EDDSA_SIG_CACHE
+    // Signature is deterministic, a message signed already by the same key is served from the cache.
+    uint8_t msg_hash[LT_EDDSA_SIG_CACHE_HASH_LEN];
+    const bool hashed = (lt_eddsa_sig_cache_hash(h, msg, msg_len, msg_hash) == LT_OK);
+    if (hashed && lt_eddsa_sig_cache_get(h, ecc_slot, msg_hash, rs)) {
+        return LT_OK;
+    }
+#endif
+
+    LT_L3_ENCRYPT_STREAM_REQUEST(h);
+    lt_ret_t ret = lt_l3_send_cmd(h, lt_out__ecc_eddsa_sign(h, ecc_slot, msg, msg_len));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_EDDSA_SIGN));
     if (ret != LT_OK) {
         return ret;
     }
 
-    return lt_in__ecc_eddsa_sign(h, rs);
+    ret = lt_in__ecc_eddsa_sign(h, rs);
+#ifdef LT_EDDSA_SIG_CACHE
+    if (hashed && (ret == LT_OK)) {
+        lt_eddsa_sig_cache_put(h, ecc_slot, msg_hash, rs);
+    }
+#endif
+
+    return ret;
 }
+#endif
 
+#ifdef LT_CMD_MCOUNTER
 lt_ret_t lt_mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index, const uint32_t mcounter_value)
 {
     if (!h || (mcounter_index > TR01_MCOUNTER_INDEX_15) || mcounter_value > TR01_MCOUNTER_VALUE_MAX) {
@@ -1347,7 +2658,7 @@ lt_ret_t lt_mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mcounte
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_MCOUNTER_INIT_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_MCOUNTER_INIT));
     if (ret != LT_OK) {
         return ret;
     }
@@ -1364,6 +2675,16 @@ lt_ret_t lt_mcounter_update(lt_handle_t *h, const enum lt_mcounter_index_t mcoun
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_L3_FAST_PATH
+    struct lt_l3_mcounter_update_cmd_t *p_l3_cmd
+        = (struct lt_l3_mcounter_update_cmd_t *)lt_l2_encrypted_cmd_chunk(&h->l2);
+    p_l3_cmd->cmd_size = TR01_L3_MCOUNTER_UPDATE_CMD_SIZE;
+    p_l3_cmd->cmd_id = TR01_L3_MCOUNTER_UPDATE_CMD_ID;
+    p_l3_cmd->mcounter_index = mcounter_index;
+
+    uint8_t *res;
+    return lt_l3_fast_cmd(h, TR01_L3_MCOUNTER_UPDATE_RES_SIZE, &res);
+#else
     lt_ret_t ret = lt_out__mcounter_update(h, mcounter_index);
     if (ret != LT_OK) {
         return ret;
@@ -1374,12 +2695,13 @@ lt_ret_t lt_mcounter_update(lt_handle_t *h, const enum lt_mcounter_index_t mcoun
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_MCOUNTER_UPDATE_RES_PACKET_SIZE));
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_MCOUNTER_UPDATE));
     if (ret != LT_OK) {
         return ret;
     }
 
     return lt_in__mcounter_update(h);
+#endif
 }
 
 lt_ret_t lt_mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index, uint32_t *mcounter_value)
@@ -1391,6 +2713,21 @@ lt_ret_t lt_mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mcounter
         return LT_HOST_NO_SESSION;
     }
 
+#ifdef LT_L3_FAST_PATH
+    struct lt_l3_mcounter_get_cmd_t *p_l3_cmd = (struct lt_l3_mcounter_get_cmd_t *)lt_l2_encrypted_cmd_chunk(&h->l2);
+    p_l3_cmd->cmd_size = TR01_L3_MCOUNTER_GET_CMD_SIZE;
+    p_l3_cmd->cmd_id = TR01_L3_MCOUNTER_GET_CMD_ID;
+    p_l3_cmd->mcounter_index = mcounter_index;
+
+    uint8_t *res;
+    lt_ret_t ret = lt_l3_fast_cmd(h, TR01_L3_MCOUNTER_GET_RES_SIZE, &res);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    *mcounter_value = ((const struct lt_l3_mcounter_get_res_t *)res)->mcounter_val;
+    return LT_OK;
+#else
     lt_ret_t ret = lt_out__mcounter_get(h, mcounter_index);
     if (ret != LT_OK) {
         return ret;
@@ -1401,41 +2738,136 @@ lt_ret_t lt_mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mcounter
         return ret;
     }
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_MCOUNTER_GET_RES_PACKET_SIZE));
-    if (ret != LT_OK) {
-        return ret;
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_MCOUNTER_GET));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_in__mcounter_get(h, mcounter_value);
+#endif
+}
+#endif
+
+#ifdef LT_CMD_MAC_DESTROY
+lt_ret_t lt_mac_and_destroy(lt_handle_t *h, const lt_mac_and_destroy_slot_t slot, const uint8_t *data_out,
+                            uint8_t *data_in)
+{
+    if (!h || !data_out || !data_in || slot > TR01_MAC_AND_DESTROY_SLOT_127) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+
+    lt_ret_t ret = lt_out__mac_and_destroy(h, slot, data_out);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_MAC_AND_DESTROY));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_in__mac_and_destroy(h, data_in);
+}
+#endif
+
+#ifdef LT_L3_CMD_LATENCY
+lt_ret_t lt_set_l3_cmd_latency_table(lt_handle_t *h, const lt_l3_cmd_latency_t *tbl, const uint8_t tbl_cnt)
+{
+    if (!h || (!tbl && tbl_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l3.cmd_latency_tbl = tbl;
+    h->l3.cmd_latency_tbl_cnt = tbl_cnt;
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_L2_STATS
+lt_ret_t lt_get_l2_stats(const lt_handle_t *h, lt_l2_stats_t *stats)
+{
+    if (!h || !stats) {
+        return LT_PARAM_ERR;
+    }
+
+    *stats = h->l2.stats;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_reset_l2_stats(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(&h->l2.stats, 0, sizeof(h->l2.stats));
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_TRACE
+lt_ret_t lt_set_trace_hooks(lt_handle_t *h, const lt_trace_hooks_t *hooks)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l2.trace = hooks;
+    h->l3.trace = hooks;
+
+    return LT_OK;
+}
+#endif
+
+#ifdef LT_PORT_RECORD
+lt_ret_t lt_set_port_recorder(lt_handle_t *h, lt_port_rec_fn_t rec, void *ctx)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
     }
 
-    return lt_in__mcounter_get(h, mcounter_value);
+    h->l2.port_rec = rec;
+    h->l2.port_rec_ctx = ctx;
+
+    return LT_OK;
 }
+#endif
 
-lt_ret_t lt_mac_and_destroy(lt_handle_t *h, const lt_mac_and_destroy_slot_t slot, const uint8_t *data_out,
-                            uint8_t *data_in)
+#ifdef LT_STATS
+lt_ret_t lt_get_stats(const lt_handle_t *h, lt_stats_t *stats)
 {
-    if (!h || !data_out || !data_in || slot > TR01_MAC_AND_DESTROY_SLOT_127) {
+    if (!h || !stats) {
         return LT_PARAM_ERR;
     }
-    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
-        return LT_HOST_NO_SESSION;
-    }
 
-    lt_ret_t ret = lt_out__mac_and_destroy(h, slot, data_out);
-    if (ret != LT_OK) {
-        return ret;
-    }
+    *stats = h->stats;
+    stats->l3_nonce = (h->l3.session_status == LT_SECURE_SESSION_ON) ? lt_l3_nonce_get(&h->l3) : 0;
 
-    ret = lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
-    if (ret != LT_OK) {
-        return ret;
-    }
+    return LT_OK;
+}
 
-    ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_min(h->l3.buff_len, TR01_L3_MAC_AND_DESTROY_RES_PACKET_SIZE));
-    if (ret != LT_OK) {
-        return ret;
+lt_ret_t lt_reset_stats(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
     }
 
-    return lt_in__mac_and_destroy(h, data_in);
+    memset(&h->stats, 0, sizeof(h->stats));
+
+    return LT_OK;
 }
+#endif
 
 static const char *lt_ret_strs[] = {"LT_OK",
                                     "LT_FAIL",
@@ -1483,7 +2915,16 @@ static const char *lt_ret_strs[] = {"LT_OK",
                                     "LT_CERT_STORE_INVALID",
                                     "LT_CERT_UNSUPPORTED",
                                     "LT_CERT_ITEM_NOT_FOUND",
-                                    "LT_NONCE_OVERFLOW"};
+                                    "LT_NONCE_OVERFLOW",
+                                    "LT_FW_UPDATE_HASH_ERR",
+                                    "LT_ENTROPY_POOL_EMPTY",
+                                    "LT_CERT_CHAIN_INVALID",
+                                    "LT_NOT_SUPPORTED",
+                                    "LT_L3_BUFF_ARENA_EMPTY",
+                                    "LT_SILICON_REV_MISMATCH",
+                                    "LT_SIGNATURE_INVALID",
+                                    "LT_DEADLINE_EXCEEDED",
+                                    "LT_RING_FULL"};
 
 const char *lt_ret_verbose(lt_ret_t ret)
 {
@@ -1524,6 +2965,7 @@ struct lt_config_obj_desc_t cfg_desc_table[LT_CONFIG_OBJ_CNT]
        {"TR01_CFG_UAP_MCOUNTER_UPDATE        ", TR01_CFG_UAP_MCOUNTER_UPDATE_ADDR},
        {"TR01_CFG_UAP_MAC_AND_DESTROY        ", TR01_CFG_UAP_MAC_AND_DESTROY_ADDR}};
 
+#ifdef LT_CMD_CONFIG
 lt_ret_t lt_read_whole_R_config(lt_handle_t *h, struct lt_config_t *config)
 {
     if (!h || !config) {
@@ -1560,6 +3002,58 @@ lt_ret_t lt_write_whole_R_config(lt_handle_t *h, const struct lt_config_t *confi
     return LT_OK;
 }
 
+/** Value of an R-config object after `lt_r_config_erase()`. */
+#define LT_R_CONFIG_OBJ_ERASED 0xFFFFFFFFU
+
+lt_ret_t lt_apply_R_config(lt_handle_t *h, const struct lt_config_t *config, struct lt_config_t *current)
+{
+    if (!h || !config) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret;
+    struct lt_config_t read_config;
+
+    if (!current) {
+        ret = lt_read_whole_R_config(h, &read_config);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        current = &read_config;
+    }
+
+    // Only erased objects may be written and only the whole R-config can be erased, so a single changed object
+    // which is not erased requires erasing and rewriting all objects which are not to stay erased.
+    bool erase = false;
+    for (uint8_t i = 0; i < LT_CONFIG_OBJ_CNT; i++) {
+        if ((config->obj[i] != current->obj[i]) && (current->obj[i] != LT_R_CONFIG_OBJ_ERASED)) {
+            erase = true;
+            break;
+        }
+    }
+
+    if (erase) {
+        ret = lt_r_config_erase(h);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        memset(current->obj, 0xFF, sizeof(current->obj));
+    }
+
+    for (uint8_t i = 0; i < LT_CONFIG_OBJ_CNT; i++) {
+        if (config->obj[i] == current->obj[i]) {
+            continue;
+        }
+        ret = lt_r_config_write(h, cfg_desc_table[i].addr, config->obj[i]);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        current->obj[i] = config->obj[i];
+    }
+
+    return LT_OK;
+}
+
 lt_ret_t lt_read_whole_I_config(lt_handle_t *h, struct lt_config_t *config)
 {
     if (!h || !config) {
@@ -1603,14 +3097,16 @@ lt_ret_t lt_write_whole_I_config(lt_handle_t *h, const struct lt_config_t *confi
 
     return LT_OK;
 }
+#endif
 
-lt_ret_t lt_verify_chip_and_start_secure_session(lt_handle_t *h, const uint8_t *shipriv, const uint8_t *shipub,
-                                                 const lt_pkey_index_t pkey_index)
+/**
+ * @brief Reads chip ID and FW versions, they are not used by lt_verify_chip_and_start_secure_session() but read anyway.
+ *
+ * @param h  Handle for communication with TROPIC01
+ * @return   LT_OK if success, otherwise returns other error code.
+ */
+static __attribute__((noinline)) lt_ret_t lt_verify_chip_read_info(lt_handle_t *h)
 {
-    if (!h || !shipriv || !shipub || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3)) {
-        return LT_PARAM_ERR;
-    }
-
     lt_ret_t ret = LT_FAIL;
 
     // This is not used here, but let's read it anyway
@@ -1620,40 +3116,39 @@ lt_ret_t lt_verify_chip_and_start_secure_session(lt_handle_t *h, const uint8_t *
         return ret;
     }
 
-    // This is not used in this example, but let's read it anyway
+    // This is not used, but let's read it anyway
     uint8_t riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE] = {0};
     ret = lt_get_info_riscv_fw_ver(h, riscv_fw_ver);
     if (ret != LT_OK) {
         return ret;
     }
 
-    // This is not used in this example, but let's read it anyway
+    // This is not used, but let's read it anyway
     uint8_t spect_fw_ver[TR01_L2_GET_INFO_SPECT_FW_SIZE] = {0};
     ret = lt_get_info_spect_fw_ver(h, spect_fw_ver);
     if (ret != LT_OK) {
         return ret;
     }
 
-    // Read certificate store
-    uint8_t cert_ese[TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE] = {0};
-    uint8_t cert_xxxx[TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE] = {0};
-    uint8_t cert_tr01[TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE] = {0};
-    uint8_t cert_root[TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE] = {0};
+    return LT_OK;
+}
 
-    struct lt_cert_store_t cert_store
-        = {.cert_len = {0, 0, 0, 0},
-           .buf_len = {TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE, TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE,
-                       TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE, TR01_L2_GET_INFO_REQ_CERT_SIZE_SINGLE},
-           .certs = {cert_ese, cert_xxxx, cert_tr01, cert_root}};
+lt_ret_t lt_verify_chip_and_start_secure_session(lt_handle_t *h, const uint8_t *shipriv, const uint8_t *shipub,
+                                                 const lt_pkey_index_t pkey_index)
+{
+    if (!h || !shipriv || !shipub || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3)) {
+        return LT_PARAM_ERR;
+    }
 
-    ret = lt_get_info_cert_store(h, &cert_store);
+    // Not inlined, so its buffers are not on the stack during the handshake.
+    lt_ret_t ret = lt_verify_chip_read_info(h);
     if (ret != LT_OK) {
         return ret;
     }
 
-    // Extract STPub
+    // Only the device certificate is read out, the rest of the certificate store is not needed for STPUB
     uint8_t stpub[TR01_STPUB_LEN] = {0};
-    ret = lt_get_st_pub(&cert_store, stpub);
+    ret = lt_get_info_st_pub(h, stpub);
     if (ret != LT_OK) {
         return ret;
     }
@@ -1676,15 +3171,7 @@ lt_ret_t lt_print_bytes(const uint8_t *bytes, const size_t bytes_cnt, char *out_
         return LT_PARAM_ERR;
     }
 
-    for (size_t i = 0; i < bytes_cnt; i++) {
-        size_t remaining = out_buf_size - (i * 2);
-        int written = snprintf(&out_buf[i * 2], remaining, "%02" PRIX8, bytes[i]);
-        // Verify snprintf succeeded and didn't truncate
-        // (should never happen given precondition check, but defensive)
-        if (written < 0 || (size_t)written >= remaining) {
-            return LT_FAIL;
-        }
-    }
+    lt_hex_encode(out_buf, bytes, bytes_cnt, true);
     out_buf[bytes_cnt * 2] = '\0';
 
     return LT_OK;
@@ -1861,6 +3348,7 @@ lt_ret_t lt_print_chip_id(const struct lt_chip_id_t *chip_id, int (*print_func)(
     return LT_OK;
 }
 
+#ifdef LT_CMD_FW_UPDATE
 lt_ret_t lt_do_mutable_fw_update(lt_handle_t *h, const uint8_t *update_data, const uint16_t update_data_size,
                                  const lt_bank_id_t bank_id)
 {
@@ -1905,6 +3393,259 @@ lt_ret_t lt_do_mutable_fw_update(lt_handle_t *h, const uint8_t *update_data, con
     return LT_OK;
 }
 
+lt_ret_t lt_do_mutable_fw_update_stream(lt_handle_t *h, lt_fw_update_reader_t reader, void *reader_ctx,
+                                        const uint32_t update_data_size, const lt_bank_id_t bank_id)
+{
+#ifdef ABAB
+    if (!h || !reader || update_data_size > TR01_MUTABLE_FW_UPDATE_SIZE_MAX
+        || ((bank_id != TR01_FW_BANK_FW1) && (bank_id != TR01_FW_BANK_FW2) && (bank_id != TR01_FW_BANK_SPECT1)
+            && (bank_id != TR01_FW_BANK_SPECT2))) {
+        return LT_PARAM_ERR;
+    }
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_mutable_fw_update_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
+
+    lt_ret_t ret = lt_mutable_fw_erase(h, bank_id);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Same chunking as lt_mutable_fw_update(), the chunk is read right to the L2 Request frame.
+    uint16_t chunk_len;
+    for (uint32_t offset = 0; offset < update_data_size; offset += chunk_len) {
+        chunk_len = (uint16_t)lt_min(update_data_size - offset, 128U);
+
+        ret = reader(reader_ctx, p_l2_req->data, chunk_len);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        p_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_REQ_ID;
+        p_l2_req->req_len = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN_MIN + chunk_len;
+        p_l2_req->bank_id = bank_id;
+        p_l2_req->offset = (uint16_t)offset;
+
+        ret = lt_l2_send(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        ret = lt_l2_receive(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
+            return LT_L2_RSP_LEN_ERROR;
+        }
+    }
+
+    return LT_OK;
+#elif ACAB
+    LT_UNUSED(bank_id);  // bank_id is not used with ACAB, chip handles banks on its own
+    if (!h || !reader || update_data_size <= (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1U)
+        || update_data_size > TR01_MUTABLE_FW_UPDATE_SIZE_MAX) {
+        return LT_PARAM_ERR;
+    }
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_mutable_fw_update_data_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_data_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
+
+    // Image starts with the update 'request' (length byte included), followed by the 'data' chunks.
+    uint8_t update_request[TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1U];
+    lt_ret_t ret_unused;
+    lt_ret_t ret = reader(reader_ctx, update_request, sizeof(update_request));
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (update_request[0] != TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN) {
+        return LT_PARAM_ERR;
+    }
+
+    // Request announces hash of the first chunk, every chunk announces hash of the next one (zeros in the last chunk).
+    // Hash covers the chunk without its length byte.
+    uint8_t expected_hash[LT_SHA256_DIGEST_LENGTH];
+    uint8_t chunk_hash[LT_SHA256_DIGEST_LENGTH];
+    memcpy(expected_hash,
+           update_request + offsetof(struct lt_l2_mutable_fw_update_req_t, hash)
+               - offsetof(struct lt_l2_mutable_fw_update_req_t, req_len),
+           sizeof(expected_hash));
+
+    ret = lt_mutable_fw_update(h, update_request);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_sha256_init(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    uint8_t *chunk = (uint8_t *)&p_l2_req->req_len;
+    const size_t dest_capacity = sizeof(*p_l2_req) - offsetof(struct lt_l2_mutable_fw_update_data_req_t, req_len);
+    size_t copy_len;
+    for (uint32_t chunk_index = sizeof(update_request); chunk_index < update_data_size; chunk_index += copy_len) {
+        ret = reader(reader_ctx, chunk, 1);
+        if (ret != LT_OK) {
+            goto sha256_cleanup;
+        }
+
+        copy_len = (size_t)chunk[0] + 1U;
+        if (copy_len > update_data_size - chunk_index || copy_len > dest_capacity
+            || chunk[0] < sizeof(p_l2_req->hash)) {
+            ret = LT_PARAM_ERR;
+            goto sha256_cleanup;
+        }
+
+        ret = reader(reader_ctx, chunk + 1, chunk[0]);
+        if (ret != LT_OK) {
+            goto sha256_cleanup;
+        }
+
+        ret = lt_sha256_start(h->l3.crypto_ctx);
+        if (ret != LT_OK) {
+            goto sha256_cleanup;
+        }
+        ret = lt_sha256_update(h->l3.crypto_ctx, chunk + 1, chunk[0]);
+        if (ret != LT_OK) {
+            goto sha256_cleanup;
+        }
+        ret = lt_sha256_finish(h->l3.crypto_ctx, chunk_hash);
+        if (ret != LT_OK) {
+            goto sha256_cleanup;
+        }
+
+        // Do not send a chunk TROPIC01 would reject anyway.
+        if (memcmp(chunk_hash, expected_hash, sizeof(expected_hash)) != 0) {
+            LT_LOG_ERROR("FW update chunk at offset %" PRIu32 " does not match its hash", chunk_index);
+            ret = LT_FW_UPDATE_HASH_ERR;
+            goto sha256_cleanup;
+        }
+        // L2 buffer is overwritten by the response.
+        memcpy(expected_hash, p_l2_req->hash, sizeof(expected_hash));
+
+        p_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_DATA_REQ;
+
+        ret = lt_l2_send(&h->l2);
+        if (ret != LT_OK) {
+            goto sha256_cleanup;
+        }
+        ret = lt_l2_receive(&h->l2);
+        if (ret != LT_OK) {
+            goto sha256_cleanup;
+        }
+
+        if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
+            ret = LT_L2_RSP_LEN_ERROR;
+            goto sha256_cleanup;
+        }
+    }
+
+    // Image ended, but the last chunk announced another one.
+    memset(chunk_hash, 0, sizeof(chunk_hash));
+    if (memcmp(chunk_hash, expected_hash, sizeof(expected_hash)) != 0) {
+        LT_LOG_ERROR("FW update image is truncated");
+        ret = LT_FW_UPDATE_HASH_ERR;
+    }
+
+sha256_cleanup:
+    ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
+    LT_UNUSED(ret_unused);
+
+    return ret;
+#else
+#error "Undefined silicon revision. Please define either ABAB or ACAB."
+#endif
+}
+
+lt_ret_t lt_do_mutable_fw_update_feed(lt_handle_t *h, lt_fw_update_feeder_t feeder, void *feeder_ctx,
+                                      const lt_bank_id_t bank_id)
+{
+    const uint8_t *chunk;
+#ifdef ABAB
+    if (!h || !feeder
+        || ((bank_id != TR01_FW_BANK_FW1) && (bank_id != TR01_FW_BANK_FW2) && (bank_id != TR01_FW_BANK_SPECT1)
+            && (bank_id != TR01_FW_BANK_SPECT2))) {
+        return LT_PARAM_ERR;
+    }
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_mutable_fw_update_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
+
+    lt_ret_t ret = lt_mutable_fw_erase(h, bank_id);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Data of the chunks are written one after another, each by one L2 Request.
+    uint32_t offset = 0;
+    while ((ret = feeder(feeder_ctx, &chunk)) == LT_OK && chunk) {
+        if (chunk[0] == 0 || chunk[0] > 128U || chunk[0] > TR01_MUTABLE_FW_UPDATE_SIZE_MAX - offset) {
+            return LT_PARAM_ERR;
+        }
+
+        memcpy(p_l2_req->data, chunk + 1, chunk[0]);
+        p_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_REQ_ID;
+        p_l2_req->req_len = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN_MIN + chunk[0];
+        p_l2_req->bank_id = bank_id;
+        p_l2_req->offset = (uint16_t)offset;
+        offset += chunk[0];
+
+        ret = lt_l2_send(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        ret = lt_l2_receive(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
+            return LT_L2_RSP_LEN_ERROR;
+        }
+    }
+
+    return ret;
+#elif ACAB
+    LT_UNUSED(bank_id);  // bank_id is not used with ACAB, chip handles banks on its own
+    if (!h || !feeder) {
+        return LT_PARAM_ERR;
+    }
+
+    // send the update 'request'
+    lt_ret_t ret = feeder(feeder_ctx, &chunk);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (!chunk || chunk[0] != TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN) {
+        return LT_PARAM_ERR;
+    }
+    ret = lt_mutable_fw_update(h, chunk);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // send the rest - update 'data', chunk by chunk as they come
+    while ((ret = feeder(feeder_ctx, &chunk)) == LT_OK && chunk) {
+        ret = lt_mutable_fw_update_data_chunk(h, chunk);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return ret;
+#else
+#error "Undefined silicon revision. Please define either ABAB or ACAB."
+#endif
+}
+#endif
+
 lt_ret_t lt_print_fw_header(lt_handle_t *h, const lt_bank_id_t bank_id, int (*print_func)(const char *format, ...))
 {
     if (!h || !print_func) {
@@ -1965,9 +3706,7 @@ lt_ret_t lt_print_fw_header(lt_handle_t *h, const lt_bank_id_t bank_id, int (*pr
         print_func("      Git hash:           %08" PRIX32 "\n", p_h->git_hash);
         // Hash str has 32B
         char hash_str[32 * 2 + 1] = {0};
-        for (int i = 0; i < 32; i++) {
-            snprintf(hash_str + i * 2, sizeof(hash_str) - i * 2, "%02" PRIX8, p_h->hash[i]);
-        }
+        lt_hex_encode(hash_str, p_h->hash, sizeof(p_h->hash), true);
         print_func("      Hash:          %s\n", hash_str);
         print_func("      Pair version:  %08" PRIX32 "\n", p_h->pair_version);
     }
@@ -13,10 +13,15 @@
 
 #include "libtropic_common.h"
 #include "libtropic_logging.h"
+#include "libtropic_macros.h"
 #include "lt_crc16.h"
 #include "lt_l1.h"
 #include "lt_l2_api_structs.h"
 #include "lt_l2_frame_check.h"
+#include "lt_link_tune.h"
+#include "lt_port_wrap.h"
+#include "lt_stats.h"
+#include "lt_trace.h"
 
 /** Safety number - limit number of loops during l3 chunks reception. TROPIC01 divides data into 128B
  *  chunks, length of L3 buffer is (2 + 4096 + 16).
@@ -25,13 +30,300 @@
  */
 #define LT_L2_RECV_ENC_RES_MAX_LOOPS 42
 
+#ifndef LT_L2_RESEND_MAX_TRIES
+/** Number of Resend_Req attempts when the received L2 Response frame is not valid. */
+#define LT_L2_RESEND_MAX_TRIES 3
+#endif
+
+#ifndef LT_L2_RESEND_BACKOFF_MS
+/** Delay in ms before the first Resend_Req attempt, doubled with each further attempt. 0 resends right away. */
+#define LT_L2_RESEND_BACKOFF_MS 0
+#endif
+
+/**
+ * @brief Checks CRC and STATUS of the L2 Response frame in l2 buffer, see lt_l2_frame_check().
+ *
+ * @param s2    Structure holding l2 state
+ * @return      Return value of lt_l2_frame_check()
+ */
+static lt_ret_t lt_l2_frame_check_traced(lt_l2_state_t *s2)
+{
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_CRC);
+    lt_ret_t ret = lt_l2_frame_check(s2->buff);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_CRC);
+    if (ret == LT_L2_CRC_ERR) {
+        LT_STATS_INC(s2, l2_crc_errors);
+    }
+    LT_LINK_TUNE_FRAME(s2, ret);
+
+    return ret;
+}
+
+#if defined(LT_L2_ZERO_COPY) || defined(LT_L3_FAST_PATH)
+/**
+ * @brief Calculates REQ_CRC of Encrypted_Cmd_Req L2 Request carrying given chunk of L3 packet.
+ *
+ * @param chunk   Chunk of L3 packet
+ * @param len     Length of the chunk
+ * @return        CRC16 in the same form as returned by crc16()
+ */
+static uint16_t lt_l2_encrypted_cmd_crc(const uint8_t *chunk, const uint8_t len)
+{
+    const uint8_t hdr[TR01_L2_REQ_ID_SIZE + TR01_L2_REQ_RSP_LEN_SIZE] = {TR01_L2_ENCRYPTED_CMD_REQ_ID, len};
+
+    return crc16_final(crc16_update(crc16_update(LT_CRC16_INITIAL_VAL, hdr, sizeof(hdr)), chunk, len));
+}
+#endif
+
+/**
+ * @brief Calculates REQ_CRC of the chunk ahead of lt_l2_write_encrypted_chunk() (used only with LT_L2_ZERO_COPY,
+ * otherwise the CRC is calculated while the chunk is copied into l2 buffer).
+ *
+ * @param s2      Structure holding l2 state
+ * @param chunk   Chunk of L3 packet
+ * @param len     Length of the chunk
+ * @return        CRC16 in the same form as returned by crc16(), 0 without LT_L2_ZERO_COPY
+ */
+static uint16_t lt_l2_chunk_crc(lt_l2_state_t *s2, const uint8_t *chunk, const uint8_t len)
+{
+    // s2 is used only by trace hooks.
+    LT_UNUSED(s2);
+#ifdef LT_L2_ZERO_COPY
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_CRC);
+    const uint16_t crc = lt_l2_encrypted_cmd_crc(chunk, len);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_CRC);
+
+    return crc;
+#else
+    LT_UNUSED(chunk);
+    LT_UNUSED(len);
+
+    return 0;
+#endif
+}
+
+/**
+ * @brief Gets size of encrypted L3 command packet in the buffer and checks it.
+ *
+ * @param buff         Buffer containing encrypted l3 command
+ * @param buff_len     Length of buff
+ * @param packet_size  Size of the L3 packet (including L3 size and tag) is returned here
+ * @return             LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_encrypted_cmd_size(const uint8_t *buff, const uint16_t buff_len, uint16_t *packet_size)
+{
+    // There is l3 payload in passed buffer.
+    // First check how much data are to be send and if it actually fits into that buffer,
+    // there must be a space for 2B of size value, ?B of command (ID + data) and 16B of TAG.
+    const struct lt_l3_gen_frame_t *p_frame = (const struct lt_l3_gen_frame_t *)buff;
+    *packet_size = (TR01_L3_SIZE_SIZE + p_frame->cmd_size + TR01_L3_TAG_SIZE);
+
+    // Prevent sending more data than is the max size of L3 packet.
+    if (*packet_size > TR01_L3_PACKET_MAX_SIZE) {
+        LT_LOG_ERROR("Packet size %" PRIu16 "exceeds maximum L3 packet size %u", *packet_size,
+                     TR01_L3_PACKET_MAX_SIZE);
+        return LT_L3_DATA_LEN_ERROR;
+    }
+    // Prevent sending more data than is the size of passed buffer.
+    if (*packet_size > buff_len) {
+        LT_LOG_ERROR("Packet size %" PRIu16 "exceeds L3 buffer size %" PRIu16, *packet_size, buff_len);
+        return LT_PARAM_ERR;
+    }
+
+    return LT_OK;
+}
+
+/**
+ * @brief Writes Encrypted_Cmd_Req L2 Request carrying given chunk of L3 packet.
+ *
+ * @param s2      Structure holding l2 state
+ * @param chunk   Chunk of L3 packet
+ * @param len     Length of the chunk
+ * @param crc     REQ_CRC of the request, see lt_l2_chunk_crc()
+ * @return        LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_write_encrypted_chunk(lt_l2_state_t *s2, const uint8_t *chunk, const uint8_t len,
+                                            const uint16_t crc)
+{
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_encrypted_cmd_req_t *req = (struct lt_l2_encrypted_cmd_req_t *)s2->buff;
+
+    req->req_id = TR01_L2_ENCRYPTED_CMD_REQ_ID;
+    req->req_len = len;
+#ifdef LT_L2_ZERO_COPY
+    // Chunk is sent right from l3 buff, only REQ_ID, REQ_LEN and REQ_CRC are prepared separately.
+    const uint8_t req_crc[TR01_L2_REQ_RSP_CRC_SIZE] = {crc >> 8, crc & 0x00FF};
+    const lt_spi_seg_t segs[] = {
+        {NULL, NULL, TR01_L2_REQ_ID_SIZE + TR01_L2_REQ_RSP_LEN_SIZE, 0},
+        {chunk, NULL, len, TR01_L2_REQ_ID_SIZE + TR01_L2_REQ_RSP_LEN_SIZE},
+        {req_crc, NULL, sizeof(req_crc), TR01_L2_REQ_ID_SIZE + TR01_L2_REQ_RSP_LEN_SIZE + len},
+    };
+
+    lt_ret_t ret = lt_l1_write_v(s2, segs, sizeof(segs) / sizeof(segs[0]), LT_L1_TIMEOUT_MS_DEFAULT);
+#else
+    LT_UNUSED(crc);
+    // Chunk is copied into l2 buffer in the same pass as its CRC is calculated.
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_CRC);
+    uint16_t req_crc
+        = crc16_update(LT_CRC16_INITIAL_VAL, s2->buff, TR01_L2_REQ_ID_SIZE + TR01_L2_REQ_RSP_LEN_SIZE);
+    req_crc = crc16_final(crc16_copy_update(req_crc, req->l3_chunk, chunk, len));
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_CRC);
+    req->l3_chunk[len] = req_crc >> 8;
+    req->l3_chunk[len + 1] = req_crc & 0x00FF;
+
+    lt_ret_t ret = lt_l1_write(s2, 2 + len + 2, LT_L1_TIMEOUT_MS_DEFAULT);
+#endif
+    if (ret == LT_OK) {
+        LT_STATS_INC(s2, l2_chunks_tx);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Sets where L1 places RSP_DATA of the next L2 Response frame (used only with LT_L2_ZERO_COPY).
+ *
+ * @param s2        Structure holding l2 state
+ * @param rx_data   Destination of RSP_DATA, NULL to receive them into the l2 buffer
+ * @param max_len   Space available in rx_data
+ */
+static void lt_l2_set_rx_data(lt_l2_state_t *s2, uint8_t *rx_data, const uint16_t max_len)
+{
+#ifdef LT_L2_ZERO_COPY
+    s2->rx_data = rx_data;
+    s2->rx_data_max = max_len;
+#else
+    LT_UNUSED(s2);
+    LT_UNUSED(rx_data);
+    LT_UNUSED(max_len);
+#endif
+}
+
+/**
+ * @brief Checks received L2 Response frame carrying a chunk of L3 packet and stores the chunk into l3 buffer.
+ *
+ * @param s2       Structure holding l2 state
+ * @param buff     Buffer where encrypted l3 result is being stored
+ * @param max_len  Maximal length of buff
+ * @param offset   Position of the chunk in buff, moved behind the chunk if it was stored
+ * @return         LT_OK for the last chunk, LT_L2_RES_CONT if more chunks follow, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_take_res_chunk(lt_l2_state_t *s2, uint8_t *buff, const uint16_t max_len, uint16_t *offset)
+{
+    // Setup a response pointer to l2 buffer, which is placed in handle
+    struct lt_l2_encrypted_cmd_rsp_t *resp = (struct lt_l2_encrypted_cmd_rsp_t *)s2->buff;
+
+    // Prevent receiving more data then is compiled size of l3 buffer
+    if (*offset + resp->rsp_len > max_len) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    // Check status byte of this frame, RSP_DATA are copied into l3 buffer during the CRC check unless L1 already
+    // placed them there.
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_CRC);
+#ifdef LT_L2_ZERO_COPY
+    lt_ret_t ret = s2->rx_data_placed ? lt_l2_frame_check_split(s2->buff, buff + *offset)
+                                      : lt_l2_frame_check_copy(s2->buff, buff + *offset);
+#else
+    lt_ret_t ret = lt_l2_frame_check_copy(s2->buff, buff + *offset);
+#endif
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_CRC);
+    if (ret == LT_L2_CRC_ERR) {
+        LT_STATS_INC(s2, l2_crc_errors);
+    }
+    LT_LINK_TUNE_FRAME(s2, ret);
+    if ((ret == LT_OK) || (ret == LT_L2_RES_CONT)) {
+        *offset += resp->rsp_len;
+        LT_STATS_INC(s2, l2_chunks_rx);
+    }
+
+    return ret;
+}
+
+#ifdef LT_PORT_L3_TUNNEL
+/**
+ * @brief Transfers encrypted L3 Command packet through the bridge of the port, the L3 Result packet is kept until
+ * lt_l2_tunnel_take_res().
+ *
+ * @param s2           Structure holding l2 state
+ * @param packet       Encrypted L3 Command packet
+ * @param packet_size  Size of the packet
+ * @return             LT_OK if success, LT_NOT_SUPPORTED if the packet has to be sent in L2 chunks, otherwise returns
+ *                     other error code.
+ */
+static lt_ret_t lt_l2_tunnel_cmd(lt_l2_state_t *s2, const uint8_t *packet, const uint16_t packet_size)
+{
+    const uint8_t *res;
+    uint16_t res_len;
+
+    s2->tunnel_res = NULL;
+    lt_ret_t ret = lt_l1_l3_tunnel(s2, packet, packet_size, &res, &res_len, LT_L1_TIMEOUT_MS_DEFAULT);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Response starts with CHIP_STATUS and STATUS of the last L2 Response frame the bridge received.
+    if (res_len < TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE) {
+        return LT_FAIL;
+    }
+    if (res[0] & TR01_L1_CHIP_MODE_ALARM_bit) {
+        LT_LOG_DEBUG("CHIP_STATUS: 0x%02" PRIX8, res[0]);
+        return LT_L1_CHIP_ALARM_MODE;
+    }
+    if (!(res[0] & TR01_L1_CHIP_MODE_READY_bit)) {
+        return LT_L1_CHIP_BUSY;
+    }
+    if (res[1] != TR01_L2_STATUS_RESULT_OK) {
+        ret = lt_l2_status_check(res[1]);
+        // REQUEST_OK means the bridge received no L3 Result.
+        return (ret == LT_OK) ? LT_L2_STATUS_UNKNOWN : ret;
+    }
+    res_len -= TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE;
+    if (res_len > TR01_L3_PACKET_MAX_SIZE) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    s2->tunnel_res = res + TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE;
+    s2->tunnel_res_len = res_len;
+#ifdef LT_L3_CMD_LATENCY
+    // The bridge already polled for the result.
+    s2->presleep_ms = 0;
+#endif
+
+    return LT_OK;
+}
+
+/**
+ * @brief Takes L3 Result packet received through the bridge by the last L3 Command.
+ *
+ * @param s2       Structure holding l2 state
+ * @param res      L3 Result packet is returned here
+ * @param res_len  Length of the packet is returned here
+ * @return         true if the last L3 Command was transferred through the bridge, false otherwise.
+ */
+static bool lt_l2_tunnel_take_res(lt_l2_state_t *s2, const uint8_t **res, uint16_t *res_len)
+{
+    if (!s2->tunnel_res) {
+        return false;
+    }
+
+    *res = s2->tunnel_res;
+    *res_len = s2->tunnel_res_len;
+    s2->tunnel_res = NULL;
+
+    return true;
+}
+#endif
+
 lt_ret_t lt_l2_send(lt_l2_state_t *s2)
 {
     if (!s2) {
         return LT_PARAM_ERR;
     }
 
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_CRC);
     add_crc(s2->buff);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_CRC);
 
     uint8_t len = s2->buff[1];
 
@@ -55,7 +347,7 @@ lt_ret_t lt_l2_resend_response(lt_l2_state_t *s2)
         return ret;
     }
 
-    return lt_l2_frame_check(s2->buff);
+    return lt_l2_frame_check_traced(s2);
 }
 
 lt_ret_t lt_l2_receive(lt_l2_state_t *s2)
@@ -78,51 +370,114 @@ lt_ret_t lt_l2_receive(lt_l2_state_t *s2)
         return LT_OK;
     }
 
-    ret = lt_l2_frame_check(s2->buff);
+    ret = lt_l2_frame_check_traced(s2);
 
     if ((ret == LT_L2_CRC_ERR) || (ret == LT_L2_GEN_ERR)) {
         // There was an error when checking received data.
         // Let's consider that length byte is correct, but CRC is not.
-        // We try three times to resend the last response.
-        for (int i = 0; i < 3; i++) {
+        // We try LT_L2_RESEND_MAX_TRIES times to resend the last response.
+#ifdef LT_L2_RESEND_REREAD
+        uint16_t rx_len = s2->buff[TR01_L2_RSP_LEN_OFFSET] + TR01_L2_REQ_RSP_CRC_SIZE;
+#endif
+#ifdef LT_L2_STATS
+        s2->stats.rx_errors++;
+#endif
+        for (int i = 0; i < LT_L2_RESEND_MAX_TRIES; i++) {
+#if LT_L2_RESEND_BACKOFF_MS > 0
+            // Give the bus some time to settle, the delay doubles with each attempt.
+            lt_ret_t ret_delay = lt_l1_delay(s2, (uint32_t)LT_L2_RESEND_BACKOFF_MS << lt_min(i, 7));
+            if (ret_delay != LT_OK) {
+                return ret_delay;
+            }
+#endif
+#ifdef LT_L2_RESEND_REREAD
+            // The resent frame has the same length, so it is read in a single transfer.
+            s2->rx_len_hint = rx_len;
+#endif
             ret = lt_l2_resend_response(s2);
+#ifdef LT_L2_RESEND_REREAD
+            s2->rx_len_hint = 0;
+#endif
+#ifdef LT_L2_STATS
+            s2->stats.resends++;
+#endif
+            LT_STATS_INC(s2, l2_resends);
             if (ret == LT_OK) {
                 break;
             }
+#ifdef LT_DEADLINE
+            if (ret == LT_DEADLINE_EXCEEDED) {
+                break;
+            }
+#endif
+        }
+#ifdef LT_L2_STATS
+        if (ret == LT_OK) {
+            s2->stats.recovered++;
+        }
+        else {
+            s2->stats.unrecovered++;
         }
+#endif
     }
 
     // Rest of errors are reported directly to upper layers, without trying to resend response.
     return ret;
 }
 
-lt_ret_t lt_l2_send_encrypted_cmd(lt_l2_state_t *s2, uint8_t *buff, uint16_t buff_len)
+/**
+ * @brief Lets the callback prepare a chunk of L3 packet in place before it is sent.
+ *
+ * @param chunk     Chunk of L3 packet
+ * @param len       Length of the chunk
+ * @param cb        Callback of lt_l2_send_encrypted_cmd_stream(), NULL if the packet is already prepared
+ * @param cb_ctx    Passed to cb
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_prepare_chunk(uint8_t *chunk, const uint8_t len, lt_l2_tx_chunk_cb_t cb, void *cb_ctx)
 {
-    if (!s2 || !buff) {
-        return LT_PARAM_ERR;
+    if (!cb) {
+        return LT_OK;
     }
 
-    int ret = LT_FAIL;
-
-    // There is l3 payload in passed buffer.
-    // First check how much data are to be send and if it actually fits into that buffer,
-    // there must be a space for 2B of size value, ?B of command (ID + data) and 16B of TAG.
-    struct lt_l3_gen_frame_t *p_frame = (struct lt_l3_gen_frame_t *)buff;
-    uint16_t packet_size = (TR01_L3_SIZE_SIZE + p_frame->cmd_size + TR01_L3_TAG_SIZE);
+    return cb(cb_ctx, chunk, len);
+}
 
-    // Prevent sending more data than is the max size of L3 packet.
-    if (packet_size > TR01_L3_PACKET_MAX_SIZE) {
-        LT_LOG_ERROR("Packet size %" PRIu16 "exceeds maximum L3 packet size %u", packet_size, TR01_L3_PACKET_MAX_SIZE);
-        return LT_L3_DATA_LEN_ERROR;
+/**
+ * @brief Sends encrypted L3 Command in the buffer in L2 chunks, see lt_l2_send_encrypted_cmd().
+ *
+ * @param s2        Structure holding l2 state
+ * @param buff      Buffer containing encrypted l3 command
+ * @param buff_len  Length of buff
+ * @param cb        Callback preparing each chunk, NULL if the packet is already prepared
+ * @param cb_ctx    Passed to cb
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_send_encrypted_chunks(lt_l2_state_t *s2, uint8_t *buff, uint16_t buff_len,
+                                            lt_l2_tx_chunk_cb_t cb, void *cb_ctx)
+{
+    uint16_t packet_size;
+    int ret = lt_l2_encrypted_cmd_size(buff, buff_len, &packet_size);
+    if (ret != LT_OK) {
+        return ret;
     }
-    // Prevent sending more data than is the size of passed buffer.
-    if (packet_size > buff_len) {
-        LT_LOG_ERROR("Packet size %" PRIu16 "exceeds L3 buffer size %" PRIu16, packet_size, buff_len);
-        return LT_PARAM_ERR;
+
+#ifdef LT_PORT_L3_TUNNEL
+    // Bridge needs the whole packet, so all chunks are prepared first.
+    for (uint16_t offset = 0; cb && (offset < packet_size); offset += TR01_L2_CHUNK_MAX_DATA_SIZE) {
+        const uint16_t len = (uint16_t)(packet_size - offset);
+        ret = lt_l2_prepare_chunk(buff + offset, (uint8_t)lt_min(len, TR01_L2_CHUNK_MAX_DATA_SIZE), cb, cb_ctx);
+        if (ret != LT_OK) {
+            return ret;
+        }
     }
+    cb = NULL;
 
-    // Setup a request pointer to l2 buffer, which is placed in handle
-    struct lt_l2_encrypted_cmd_req_t *req = (struct lt_l2_encrypted_cmd_req_t *)s2->buff;
+    ret = lt_l2_tunnel_cmd(s2, buff, packet_size);
+    if (ret != LT_NOT_SUPPORTED) {
+        return ret;
+    }
+#endif
 
     // Calculate number of chunks to send.
     // First, get the number of full chunks.
@@ -134,26 +489,32 @@ lt_ret_t lt_l2_send_encrypted_cmd(lt_l2_state_t *s2, uint8_t *buff, uint16_t buf
     uint16_t last_chunk_len = packet_size - ((chunk_num - 1) * TR01_L2_CHUNK_MAX_DATA_SIZE);
 
     uint16_t buff_offset = 0;
+    uint8_t chunk_len = (chunk_num == 1) ? last_chunk_len : TR01_L2_CHUNK_MAX_DATA_SIZE;
+    ret = lt_l2_prepare_chunk(buff, chunk_len, cb, cb_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    uint16_t crc = lt_l2_chunk_crc(s2, buff, chunk_len);
 
     // Split encrypted buffer into chunks and proceed them into l2 transfers:
     for (int i = 0; i < chunk_num; i++) {
-        req->req_id = TR01_L2_ENCRYPTED_CMD_REQ_ID;
-        // If the currently processed chunk is the last one, get its length (may be shorter than L2_CHUNK_MAX_DATA_SIZE)
-        if (i == (chunk_num - 1)) {
-            req->req_len = last_chunk_len;
-        }
-        else {
-            req->req_len = TR01_L2_CHUNK_MAX_DATA_SIZE;
-        }
-        memcpy(req->l3_chunk, buff + buff_offset, req->req_len);
-        buff_offset += req->req_len;  // Move offset for next chunk
-        add_crc(req);
-
         // Send l2 request cointaining a chunk from l3 buff
-        ret = lt_l1_write(s2, 2 + req->req_len + 2, LT_L1_TIMEOUT_MS_DEFAULT);
+        ret = lt_l2_write_encrypted_chunk(s2, buff + buff_offset, chunk_len, crc);
         if (ret != LT_OK) {
             return ret;
         }
+        buff_offset += chunk_len;  // Move offset for next chunk
+
+        // While TROPIC01 processes this chunk, prepare the next one and with LT_L2_ZERO_COPY calculate its CRC, so it
+        // can be sent right after REQ_CONT.
+        if (i < (chunk_num - 1)) {
+            chunk_len = (i == (chunk_num - 2)) ? last_chunk_len : TR01_L2_CHUNK_MAX_DATA_SIZE;
+            ret = lt_l2_prepare_chunk(buff + buff_offset, chunk_len, cb, cb_ctx);
+            if (ret != LT_OK) {
+                return ret;
+            }
+            crc = lt_l2_chunk_crc(s2, buff + buff_offset, chunk_len);
+        }
 
         // Read a response on this l2 request
         ret = lt_l1_read(s2, TR01_L1_LEN_MAX, LT_L1_TIMEOUT_MS_DEFAULT);
@@ -162,7 +523,7 @@ lt_ret_t lt_l2_send_encrypted_cmd(lt_l2_state_t *s2, uint8_t *buff, uint16_t buf
         }
 
         // Check status byte of this frame
-        ret = lt_l2_frame_check(s2->buff);
+        ret = lt_l2_frame_check_traced(s2);
         if (ret != LT_OK && ret != LT_L2_REQ_CONT) {
             return ret;
         }
@@ -171,47 +532,108 @@ lt_ret_t lt_l2_send_encrypted_cmd(lt_l2_state_t *s2, uint8_t *buff, uint16_t buf
     return LT_OK;
 }
 
-lt_ret_t lt_l2_recv_encrypted_res(lt_l2_state_t *s2, uint8_t *buff, uint16_t max_len)
+lt_ret_t lt_l2_send_encrypted_cmd(lt_l2_state_t *s2, uint8_t *buff, uint16_t buff_len)
 {
-    if (!s2
-        // Max len must be definitively smaller than size of l3 buffer
-        || max_len > TR01_L3_PACKET_MAX_SIZE || !buff) {
+    if (!s2 || !buff) {
         return LT_PARAM_ERR;
     }
 
-    int ret = LT_FAIL;
-    // Setup a response pointer to l2 buffer, which is placed in handle
-    struct lt_l2_encrypted_cmd_rsp_t *resp = (struct lt_l2_encrypted_cmd_rsp_t *)s2->buff;
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_ENC_CMD);
+    lt_ret_t ret = lt_l2_send_encrypted_chunks(s2, buff, buff_len, NULL, NULL);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_ENC_CMD);
+
+    return ret;
+}
+
+#ifdef LT_L3_STREAM_ENCRYPT
+lt_ret_t lt_l2_send_encrypted_cmd_stream(lt_l2_state_t *s2, uint8_t *buff, uint16_t buff_len, lt_l2_tx_chunk_cb_t cb,
+                                         void *cb_ctx)
+{
+    if (!s2 || !buff || !cb) {
+        return LT_PARAM_ERR;
+    }
+
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_ENC_CMD);
+    lt_ret_t ret = lt_l2_send_encrypted_chunks(s2, buff, buff_len, cb, cb_ctx);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_ENC_CMD);
+
+    return ret;
+}
+#endif
 
+/**
+ * @brief Sleeps for the expected execution time of the L3 command before polling for its result
+ * (used only with LT_L3_CMD_LATENCY).
+ *
+ * @param s2        Structure holding l2 state
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_presleep(lt_l2_state_t *s2)
+{
+#ifdef LT_L3_CMD_LATENCY
+    // Sleep for the expected execution time of the L3 command, that saves polling while TROPIC01 is busy.
+    if (s2->presleep_ms) {
+        lt_ret_t ret = lt_l1_delay(s2, s2->presleep_ms);
+        s2->presleep_ms = 0;
+        return ret;
+    }
+#else
+    LT_UNUSED(s2);
+#endif
+
+    return LT_OK;
+}
+
+/**
+ * @brief Receives encrypted L3 Result in L2 chunks into the buffer, see lt_l2_recv_encrypted_res().
+ *
+ * @param s2        Structure holding l2 state
+ * @param buff      Buffer where encrypted l3 result is stored
+ * @param max_len   Maximal length of buff
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_recv_encrypted_chunks(lt_l2_state_t *s2, uint8_t *buff, uint16_t max_len)
+{
     // Position into l3 buffer where processed l2 chunk will be copied into
     uint16_t offset = 0;
     // Tropic can respond with various lengths of chunks, this loop should be limited
     uint16_t loops = 0;
 
+#ifdef LT_PORT_L3_TUNNEL
+    const uint8_t *res;
+    uint16_t res_len;
+    if (lt_l2_tunnel_take_res(s2, &res, &res_len)) {
+        if (res_len > max_len) {
+            return LT_L2_RSP_LEN_ERROR;
+        }
+        memcpy(buff, res, res_len);
+        return LT_OK;
+    }
+#endif
+
+    int ret = lt_l2_presleep(s2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     do {
+        // Let L1 place the chunk right into certain offset of l3 buffer
+        lt_l2_set_rx_data(s2, buff + offset, max_len - offset);
         /* Get one l2 frame of a device's response */
         ret = lt_l1_read(s2, TR01_L1_LEN_MAX, LT_L1_TIMEOUT_MS_DEFAULT);
+        lt_l2_set_rx_data(s2, NULL, 0);
         if (ret != LT_OK) {
             return ret;
         }
 
-        // Prevent receiving more data then is compiled size of l3 buffer
-        if (offset + resp->rsp_len > max_len) {
-            return LT_L2_RSP_LEN_ERROR;
-        }
-
-        // Check status byte of this frame
-        ret = lt_l2_frame_check(s2->buff);
+        // Check this frame and copy content of l2 into certain offset of l3 buffer
+        ret = lt_l2_take_res_chunk(s2, buff, max_len, &offset);
         switch (ret) {
             case LT_L2_RES_CONT:
-                // Copy content of l2 into certain offset of l3 buffer
-                memcpy(buff + offset, (struct l2_encrypted_rsp_t *)resp->l3_chunk, resp->rsp_len);
-                offset += resp->rsp_len;
                 loops++;
                 break;
             case LT_OK:
-                // This was last l2 frame of l3 packet, copy it and return
-                memcpy(buff + offset, (struct l2_encrypted_rsp_t *)resp->l3_chunk, resp->rsp_len);
+                // This was last l2 frame of l3 packet
                 return LT_OK;
             default:
                 // Any other L2 packet's status is not expected
@@ -221,3 +643,380 @@ lt_ret_t lt_l2_recv_encrypted_res(lt_l2_state_t *s2, uint8_t *buff, uint16_t max
 
     return LT_FAIL;
 }
+
+lt_ret_t lt_l2_recv_encrypted_res(lt_l2_state_t *s2, uint8_t *buff, uint16_t max_len)
+{
+    if (!s2
+        // Max len must be definitively smaller than size of l3 buffer
+        || max_len > TR01_L3_PACKET_MAX_SIZE || !buff) {
+        return LT_PARAM_ERR;
+    }
+
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_ENC_RES);
+    lt_ret_t ret = lt_l2_recv_encrypted_chunks(s2, buff, max_len);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_ENC_RES);
+
+    return ret;
+}
+
+#ifdef LT_L3_STREAM_DECRYPT
+/**
+ * @brief Receives encrypted L3 Result in L2 chunks and passes them to the callback, see
+ * lt_l2_recv_encrypted_res_stream().
+ *
+ * @param s2        Structure holding l2 state
+ * @param cb        Called with each chunk
+ * @param cb_ctx    Passed to cb
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_stream_encrypted_chunks(lt_l2_state_t *s2, lt_l2_chunk_cb_t cb, void *cb_ctx)
+{
+    const struct lt_l2_encrypted_cmd_rsp_t *resp = (const struct lt_l2_encrypted_cmd_rsp_t *)s2->buff;
+    // Number of bytes of l3 packet passed so far
+    uint16_t offset = 0;
+    uint16_t loops = 0;
+
+#ifdef LT_PORT_L3_TUNNEL
+    const uint8_t *res;
+    uint16_t res_len;
+    if (lt_l2_tunnel_take_res(s2, &res, &res_len)) {
+        // Passed in chunks of the size TROPIC01 would use.
+        for (; offset < res_len; offset += TR01_L2_CHUNK_MAX_DATA_SIZE) {
+            const uint16_t len = (uint16_t)(res_len - offset);
+            lt_ret_t cb_ret = cb(cb_ctx, res + offset, (uint8_t)lt_min(len, TR01_L2_CHUNK_MAX_DATA_SIZE));
+            if (cb_ret != LT_OK) {
+                return cb_ret;
+            }
+        }
+        return LT_OK;
+    }
+#endif
+
+    lt_ret_t ret = lt_l2_presleep(s2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    do {
+        // Chunks are received into l2 buffer and consumed by the callback right away
+        ret = lt_l1_read(s2, TR01_L1_LEN_MAX, LT_L1_TIMEOUT_MS_DEFAULT);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        // Prevent receiving more data than the largest L3 packet
+        if (offset + resp->rsp_len > TR01_L3_PACKET_MAX_SIZE) {
+            return LT_L2_RSP_LEN_ERROR;
+        }
+
+        ret = lt_l2_frame_check_traced(s2);
+        if ((ret != LT_OK) && (ret != LT_L2_RES_CONT)) {
+            // Any other L2 packet's status is not expected
+            return ret;
+        }
+        LT_STATS_INC(s2, l2_chunks_rx);
+        offset += resp->rsp_len;
+
+        lt_ret_t cb_ret = cb(cb_ctx, resp->l3_chunk, resp->rsp_len);
+        if (cb_ret != LT_OK) {
+            return cb_ret;
+        }
+        if (ret == LT_OK) {
+            // This was last l2 frame of l3 packet
+            return LT_OK;
+        }
+        loops++;
+    } while (loops < LT_L2_RECV_ENC_RES_MAX_LOOPS);
+
+    return LT_FAIL;
+}
+
+lt_ret_t lt_l2_recv_encrypted_res_stream(lt_l2_state_t *s2, lt_l2_chunk_cb_t cb, void *cb_ctx)
+{
+    if (!s2 || !cb) {
+        return LT_PARAM_ERR;
+    }
+
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_ENC_RES);
+    lt_ret_t ret = lt_l2_stream_encrypted_chunks(s2, cb, cb_ctx);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_ENC_RES);
+
+    return ret;
+}
+#endif
+
+#ifdef LT_L3_FAST_PATH
+uint8_t *lt_l2_encrypted_cmd_chunk(lt_l2_state_t *s2)
+{
+    if (!s2) {
+        return NULL;
+    }
+
+    return ((struct lt_l2_encrypted_cmd_req_t *)s2->buff)->l3_chunk;
+}
+
+/**
+ * @brief Sends L3 Command in a single L2 chunk and receives L3 Result in a single L2 chunk, see
+ * lt_l2_transfer_encrypted_single().
+ *
+ * @param s2        Structure holding l2 state
+ * @param res       Position of encrypted L3 Result in l2 buffer is returned here
+ * @param res_len   Length of encrypted L3 Result is returned here
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_transfer_single_chunk(lt_l2_state_t *s2, uint8_t **res, uint8_t *res_len)
+{
+    struct lt_l2_encrypted_cmd_req_t *req = (struct lt_l2_encrypted_cmd_req_t *)s2->buff;
+    const struct lt_l2_encrypted_cmd_rsp_t *resp = (const struct lt_l2_encrypted_cmd_rsp_t *)s2->buff;
+
+    const struct lt_l3_gen_frame_t *p_frame = (const struct lt_l3_gen_frame_t *)req->l3_chunk;
+    const uint16_t packet_size = TR01_L3_SIZE_SIZE + p_frame->cmd_size + TR01_L3_TAG_SIZE;
+    if (packet_size > TR01_L2_CHUNK_MAX_DATA_SIZE) {
+        return LT_L3_DATA_LEN_ERROR;
+    }
+
+#ifdef LT_PORT_L3_TUNNEL
+    lt_ret_t tunnel_ret = lt_l2_tunnel_cmd(s2, req->l3_chunk, packet_size);
+    if (tunnel_ret == LT_OK) {
+        const uint8_t *tunnel_res;
+        uint16_t tunnel_res_len;
+        if (!lt_l2_tunnel_take_res(s2, &tunnel_res, &tunnel_res_len)
+            || (tunnel_res_len > TR01_L2_CHUNK_MAX_DATA_SIZE)) {
+            // The rest of L3 Result would not fit into l2 buffer.
+            return LT_L2_RSP_LEN_ERROR;
+        }
+        memmove((uint8_t *)resp->l3_chunk, tunnel_res, tunnel_res_len);
+        *res = (uint8_t *)resp->l3_chunk;
+        *res_len = (uint8_t)tunnel_res_len;
+        return LT_OK;
+    }
+    if (tunnel_ret != LT_NOT_SUPPORTED) {
+        return tunnel_ret;
+    }
+#endif
+
+    // L3 packet is already in place, only REQ_ID, REQ_LEN and REQ_CRC are added around it.
+    req->req_id = TR01_L2_ENCRYPTED_CMD_REQ_ID;
+    req->req_len = (uint8_t)packet_size;
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_CRC);
+    const uint16_t crc = lt_l2_encrypted_cmd_crc(req->l3_chunk, req->req_len);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_CRC);
+    req->l3_chunk[packet_size] = crc >> 8;
+    req->l3_chunk[packet_size + 1] = crc & 0x00FF;
+
+    lt_ret_t ret = lt_l1_write(s2, 2 + packet_size + 2, LT_L1_TIMEOUT_MS_DEFAULT);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    LT_STATS_INC(s2, l2_chunks_tx);
+
+    ret = lt_l1_read(s2, TR01_L1_LEN_MAX, LT_L1_TIMEOUT_MS_DEFAULT);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_l2_frame_check_traced(s2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_l2_presleep(s2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_l1_read(s2, TR01_L1_LEN_MAX, LT_L1_TIMEOUT_MS_DEFAULT);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_l2_frame_check_traced(s2);
+    if (ret == LT_L2_RES_CONT) {
+        // The rest of L3 Result would not fit into l2 buffer.
+        return LT_L2_RSP_LEN_ERROR;
+    }
+    if (ret != LT_OK) {
+        return ret;
+    }
+    LT_STATS_INC(s2, l2_chunks_rx);
+
+    *res = (uint8_t *)resp->l3_chunk;
+    *res_len = resp->rsp_len;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_l2_transfer_encrypted_single(lt_l2_state_t *s2, uint8_t **res, uint8_t *res_len)
+{
+    if (!s2 || !res || !res_len) {
+        return LT_PARAM_ERR;
+    }
+
+    LT_TRACE_START(s2->trace, LT_TRACE_L2_ENC_CMD);
+    lt_ret_t ret = lt_l2_transfer_single_chunk(s2, res, res_len);
+    LT_TRACE_END(s2->trace, LT_TRACE_L2_ENC_CMD);
+
+    return ret;
+}
+#endif
+
+#ifdef LT_L2_ASYNC
+/**
+ * @brief Finishes asynchronous L2 operation and reports its result to the callback.
+ *
+ * @param op    Asynchronous L2 operation
+ * @param ret   Result of the operation
+ * @return      ret
+ */
+static lt_ret_t lt_l2_async_finish(lt_l2_async_t *op, const lt_ret_t ret)
+{
+    op->state = LT_L2_ASYNC_IDLE;
+    if (op->cb) {
+        op->cb(op, ret, op->cb_ctx);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Writes next chunk of the L3 packet of asynchronous L2 operation.
+ *
+ * @param op    Asynchronous L2 operation
+ * @return      LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_async_write_chunk(lt_l2_async_t *op)
+{
+    uint16_t remaining = op->packet_size - op->offset;
+    uint8_t chunk_len = (uint8_t)lt_min(remaining, (uint16_t)TR01_L2_CHUNK_MAX_DATA_SIZE);
+
+    lt_ret_t ret = lt_l2_write_encrypted_chunk(op->s2, op->buff + op->offset, chunk_len,
+                                               lt_l2_chunk_crc(op->s2, op->buff + op->offset, chunk_len));
+    if (ret != LT_OK) {
+        return ret;
+    }
+    op->offset += chunk_len;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_l2_async_send(lt_l2_async_t *op, lt_l2_state_t *s2, lt_l2_async_cb_t cb, void *cb_ctx)
+{
+    if (!op || !s2) {
+        return LT_PARAM_ERR;
+    }
+    // Another operation is in flight, starting this one would lose it.
+    if (lt_l2_async_busy(op)) {
+        return LT_FAIL;
+    }
+
+    lt_ret_t ret = lt_l2_send(s2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    op->s2 = s2;
+    op->cb = cb;
+    op->cb_ctx = cb_ctx;
+    op->state = LT_L2_ASYNC_RSP;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_l2_async_send_encrypted_cmd(lt_l2_async_t *op, lt_l2_state_t *s2, uint8_t *buff, uint16_t buff_len,
+                                        lt_l2_async_cb_t cb, void *cb_ctx)
+{
+    if (!op || !s2 || !buff || (buff_len > TR01_L3_PACKET_MAX_SIZE)) {
+        return LT_PARAM_ERR;
+    }
+    if (lt_l2_async_busy(op)) {
+        return LT_FAIL;
+    }
+
+    uint16_t packet_size;
+    lt_ret_t ret = lt_l2_encrypted_cmd_size(buff, buff_len, &packet_size);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    op->s2 = s2;
+    op->cb = cb;
+    op->cb_ctx = cb_ctx;
+    op->buff = buff;
+    op->buff_len = buff_len;
+    op->packet_size = packet_size;
+    op->offset = 0;
+    op->loops = 0;
+
+    ret = lt_l2_async_write_chunk(op);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    op->state = LT_L2_ASYNC_CMD;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_l2_async_process(lt_l2_async_t *op)
+{
+    if (!op || (op->state == LT_L2_ASYNC_IDLE)) {
+        return LT_PARAM_ERR;
+    }
+
+    if (op->state == LT_L2_ASYNC_RES) {
+        // Let L1 place the chunk right into certain offset of l3 buffer
+        lt_l2_set_rx_data(op->s2, op->buff + op->offset, op->buff_len - op->offset);
+    }
+    lt_ret_t ret = lt_l1_read_nowait(op->s2, LT_L1_TIMEOUT_MS_DEFAULT);
+    lt_l2_set_rx_data(op->s2, NULL, 0);
+    if (ret == LT_L1_CHIP_BUSY) {
+        // Nothing to receive yet, try again later (e.g. after next INT edge)
+        return LT_L1_CHIP_BUSY;
+    }
+    if (ret != LT_OK) {
+        return lt_l2_async_finish(op, ret);
+    }
+
+    switch (op->state) {
+        case LT_L2_ASYNC_RSP:
+            return lt_l2_async_finish(op, lt_l2_frame_check_traced(op->s2));
+
+        case LT_L2_ASYNC_CMD:
+            ret = lt_l2_frame_check_traced(op->s2);
+            if (ret != LT_OK && ret != LT_L2_REQ_CONT) {
+                return lt_l2_async_finish(op, ret);
+            }
+            if (op->offset < op->packet_size) {
+                ret = lt_l2_async_write_chunk(op);
+                if (ret != LT_OK) {
+                    return lt_l2_async_finish(op, ret);
+                }
+                return LT_L1_CHIP_BUSY;
+            }
+            // Whole L3 Command was sent, L3 Result is received into the same buffer
+            op->state = LT_L2_ASYNC_RES;
+            op->offset = 0;
+            return LT_L1_CHIP_BUSY;
+
+        case LT_L2_ASYNC_RES:
+            ret = lt_l2_take_res_chunk(op->s2, op->buff, op->buff_len, &op->offset);
+            if (ret == LT_L2_RES_CONT) {
+                // Tropic can respond with various lengths of chunks, number of them is limited
+                if (++op->loops >= LT_L2_RECV_ENC_RES_MAX_LOOPS) {
+                    return lt_l2_async_finish(op, LT_FAIL);
+                }
+                return LT_L1_CHIP_BUSY;
+            }
+            return lt_l2_async_finish(op, ret);
+
+        default:
+            return lt_l2_async_finish(op, LT_FAIL);
+    }
+}
+
+bool lt_l2_async_busy(const lt_l2_async_t *op) { return op && (op->state != LT_L2_ASYNC_IDLE); }
+
+void lt_l2_async_cancel(lt_l2_async_t *op)
+{
+    if (op) {
+        op->state = LT_L2_ASYNC_IDLE;
+    }
+}
+#endif
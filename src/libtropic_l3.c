@@ -22,12 +22,165 @@
 #include "lt_l1.h"
 #include "lt_l2_api_structs.h"
 #include "lt_l3_api_structs.h"
+#include "lt_l3_buff_arena.h"
 #include "lt_l3_process.h"
+#ifdef LT_L3_CMD_LATENCY
+#include "lt_l3_cmd_latency.h"
+#endif
 #include "lt_port_wrap.h"
 #include "lt_secure_memzero.h"
+#ifdef LT_SESSION_CACHE
+#include "lt_session_cache_eph.h"
+#endif
 #include "lt_sha256.h"
+#include "lt_stats.h"
 #include "lt_x25519.h"
 
+// clang-format off
+/** \cond */
+// Sizes of the L3 buffer profiles (see LT_L3_BUFF_PROFILE) are derived from the largest structure they have to fit.
+LT_STATIC_ASSERT(
+    LT_L3_BUFF_SIZE_R_MEM == sizeof(struct lt_l3_r_mem_data_write_cmd_t) + TR01_L3_TAG_SIZE
+)
+LT_STATIC_ASSERT(
+    LT_L3_BUFF_SIZE_R_MEM ==
+    (
+        LT_MEMBER_SIZE(struct lt_l3_r_mem_data_read_res_t, res_size) +
+        LT_MEMBER_SIZE(struct lt_l3_r_mem_data_read_res_t, result) +
+        LT_MEMBER_SIZE(struct lt_l3_r_mem_data_read_res_t, padding) +
+        LT_MEMBER_SIZE(struct lt_l3_r_mem_data_write_cmd_t, data) +
+        TR01_L3_TAG_SIZE
+    )
+)
+LT_STATIC_ASSERT(
+    LT_L3_BUFF_SIZE_SIGN_RANDOM == sizeof(struct lt_l3_random_value_get_res_t) + TR01_L3_TAG_SIZE
+)
+LT_STATIC_ASSERT(
+    LT_SIZE_OF_L3_BUFF >= LT_L3_BUFF_SIZE_SIGN_RANDOM
+)
+
+// Commands and results with fixed size fit even the smallest profile, so only Ping, EdDSA_Sign and R-Memory
+// User Data commands are checked against the L3 buffer at runtime.
+#define LT_L3_BUFF_FITS_FIXED(s) LT_STATIC_ASSERT(sizeof(s) + TR01_L3_TAG_SIZE <= LT_L3_BUFF_SIZE_SIGN_RANDOM)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_pairing_key_write_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_pairing_key_write_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_pairing_key_read_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_pairing_key_read_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_pairing_key_invalidate_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_pairing_key_invalidate_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_config_write_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_config_write_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_config_read_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_config_read_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_config_erase_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_config_erase_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_i_config_write_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_i_config_write_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_i_config_read_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_i_config_read_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_mem_data_write_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_mem_data_read_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_mem_data_erase_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_r_mem_data_erase_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_random_value_get_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_random_value_get_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecc_key_generate_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecc_key_generate_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecc_key_store_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecc_key_store_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecc_key_read_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecc_key_read_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecc_key_erase_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecc_key_erase_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecdsa_sign_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_ecdsa_sign_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_eddsa_sign_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_mcounter_init_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_mcounter_init_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_mcounter_update_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_mcounter_update_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_mcounter_get_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_mcounter_get_res_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_mac_and_destroy_cmd_t)
+LT_L3_BUFF_FITS_FIXED(struct lt_l3_mac_and_destroy_res_t)
+#undef LT_L3_BUFF_FITS_FIXED
+/** \endcond */
+// clang-format on
+
+/**
+ * @brief Checks whether an L3 packet (incl. the size and tag) of a command or result fits into the L3 buffer.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param size        Size of the command (CMD_ID + CMD_DATA) or result (RESULT + RES_DATA)
+ * @return            true if the packet fits
+ */
+static inline bool lt_l3_buff_fits(const lt_handle_t *h, const size_t size)
+{
+    return (TR01_L3_SIZE_SIZE + size + TR01_L3_TAG_SIZE) <= h->l3.buff_len;
+}
+
+/**
+ * @brief Encrypts L3 command prepared in the L3 buffer.
+ * @details When LT_L3_CMD_LATENCY is defined, expected latency of the command is also noted, so Layer 2 can sleep
+ * before polling for the result.
+ * With LT_L3_STREAM_ENCRYPT, encryption is only started when requested by lt_l3_state_t::encrypt_stream, the
+ * plaintext is then encrypted while being sent.
+ *
+ * @param h   Handle for communication with TROPIC01
+ * @return    LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l3_encrypt_cmd(lt_handle_t *h)
+{
+#ifdef LT_L3_CMD_LATENCY
+    const struct lt_l3_gen_frame_t *p_frame = (const struct lt_l3_gen_frame_t *)h->l3.buff;
+    // First byte of the command data is the command ID.
+    h->l2.presleep_ms = lt_l3_cmd_latency_get(h, p_frame->data[0]);
+#endif
+#ifdef LT_L3_STREAM_ENCRYPT
+    // Plaintext is left in L3 buffer, it is encrypted chunk by chunk while being sent.
+    if (h->l3.encrypt_stream == LT_L3_ENCRYPT_STREAM_REQ) {
+        h->l3.encrypt_stream = LT_L3_ENCRYPT_STREAM_ON;
+        return lt_l3_encrypt_stream_start(&h->l3);
+    }
+#endif
+
+    return lt_l3_encrypt_request(&h->l3);
+}
+
+/**
+ * @brief Creates ephemeral host keys for the handshake.
+ * @details When LT_SESSION_CACHE is defined and a session cache is attached to the handle, key pair prepared in the
+ * cache is taken. Key pair is generated here only when there is no cache or no key pair is prepared.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param keys  Ephemeral host keys are returned here
+ * @return      LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l3_gen_eph_keys(lt_handle_t *h, lt_host_eph_keys_t *keys)
+{
+#ifdef LT_SESSION_CACHE
+    lt_session_cache_t *cache = h->l3.session_cache;
+    if (cache) {
+        // Ephemeral keys of an abandoned handshake were already sent, never use them again.
+        lt_session_cache_eph_drop(cache);
+        if (lt_session_cache_eph_take(cache, &cache->eph_cur)) {
+            cache->hits++;
+            cache->eph_in_use = true;
+            memcpy(keys, &cache->eph_cur.keys, sizeof(*keys));
+            return LT_OK;
+        }
+        cache->misses++;
+    }
+#endif
+
+    lt_ret_t ret = lt_random_bytes(h, keys->ehpriv, sizeof(keys->ehpriv));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_X25519_scalarmult(keys->ehpriv, keys->ehpub);
+}
+
 lt_ret_t lt_out__session_start(lt_handle_t *h, const lt_pkey_index_t pkey_index, lt_host_eph_keys_t *host_eph_keys)
 {
     if (!h || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !host_eph_keys) {
@@ -40,12 +193,7 @@ lt_ret_t lt_out__session_start(lt_handle_t *h, const lt_pkey_index_t pkey_index,
     lt_l3_invalidate_host_session_data(&h->l3);
 
     // Create ephemeral host keys
-    lt_ret_t ret = lt_random_bytes(h, host_eph_keys->ehpriv, sizeof(host_eph_keys->ehpriv));
-    if (ret != LT_OK) {
-        return ret;
-    }
-
-    ret = lt_X25519_scalarmult(host_eph_keys->ehpriv, host_eph_keys->ehpub);
+    lt_ret_t ret = lt_l3_gen_eph_keys(h, host_eph_keys);
     if (ret != LT_OK) {
         return ret;
     }
@@ -62,136 +210,49 @@ lt_ret_t lt_out__session_start(lt_handle_t *h, const lt_pkey_index_t pkey_index,
     return LT_OK;
 }
 
-lt_ret_t lt_in__session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pkey_index_t pkey_index,
-                              const uint8_t *shipriv, const uint8_t *shipub, lt_host_eph_keys_t *host_eph_keys)
+/**
+ * @brief Finishes secure session establishment, when TROPIC01's Handshake_Rsp is in the l2 buffer.
+ * @note SHA-256 context in crypto_ctx has to be initialized by lt_sha256_init().
+ *
+ * @param h              Handle for communication with TROPIC01
+ * @param hash           Transcript hash computed by lt_l3_transcript_prefix(), updated in place
+ * @param stpub          STPUB from device's certificate
+ * @param pkey_index     Index of pairing public key
+ * @param shipriv        Secure host private key
+ * @param host_eph_keys  Host MCU ephemeral keys used for the handshake
+ * @param eh_st_shared   Precomputed X25519(EHPRIV, STPUB), NULL to compute it here
+ * @return               LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l3_session_finish(lt_handle_t *h, uint8_t *hash, const uint8_t *stpub,
+                                     const lt_pkey_index_t pkey_index, const uint8_t *shipriv,
+                                     const lt_host_eph_keys_t *host_eph_keys, const uint8_t *eh_st_shared)
 {
-    if (!h || !stpub || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv || !shipub || !host_eph_keys) {
-        return LT_PARAM_ERR;
-    }
-
-    // Remove any previous session data and init IVs.
-    // In case we reuse handle and use separate l3 buffer, we need to ensure that IV's are zeroed,
-    // because on session start we expect IV's to be 0. It does not hurt to zero them anyway on session start.
-    lt_l3_invalidate_host_session_data(&h->l3);
-
     // Setup a response pointer to l2 buffer, which is placed in handle
     struct lt_l2_handshake_rsp_t *p_rsp = (struct lt_l2_handshake_rsp_t *)h->l2.buff;
 
     // Noise_KK1_25519_AESGCM_SHA256\x00\x00\x00
     uint8_t protocol_name[32] = {'N', 'o', 'i', 's', 'e', '_', 'K', 'K', '1', '_', '2', '5', '5', '1',  '9',  '_',
                                  'A', 'E', 'S', 'G', 'C', 'M', '_', 'S', 'H', 'A', '2', '5', '6', 0x00, 0x00, 0x00};
-    uint8_t hash[LT_SHA256_DIGEST_LENGTH] = {0};
     lt_ret_t ret;
     lt_ret_t ret_unused;
 
-    // Initialize SHA-256 context.
-    ret = lt_sha256_init(h->l3.crypto_ctx);
-    if (ret != LT_OK) {
-        return ret;
-    }
-
-    // h = SHA_256(protocol_name)
-    ret = lt_sha256_start(h->l3.crypto_ctx);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, protocol_name, sizeof(protocol_name));
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_finish(h->l3.crypto_ctx, hash);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-
-    // h = SHA256(h||SHiPUB)
-    ret = lt_sha256_start(h->l3.crypto_ctx);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, hash, sizeof(hash));
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, shipub, TR01_SHIPUB_LEN);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_finish(h->l3.crypto_ctx, hash);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-
-    // h = SHA256(h||STPUB)
-    ret = lt_sha256_start(h->l3.crypto_ctx);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, hash, sizeof(hash));
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, stpub, TR01_STPUB_LEN);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_finish(h->l3.crypto_ctx, hash);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-
     // h = SHA256(h||EHPUB)
-    ret = lt_sha256_start(h->l3.crypto_ctx);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, hash, sizeof(hash));
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, host_eph_keys->ehpub, TR01_EHPUB_LEN);
+    ret = lt_l3_transcript_update(h->l3.crypto_ctx, hash, host_eph_keys->ehpub, TR01_EHPUB_LEN);
     if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_finish(h->l3.crypto_ctx, hash);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
+        return ret;
     }
 
     // h = SHA256(h||PKEY_INDEX)
-    ret = lt_sha256_start(h->l3.crypto_ctx);
+    const uint8_t pkey_index_byte = (uint8_t)pkey_index;
+    ret = lt_l3_transcript_update(h->l3.crypto_ctx, hash, &pkey_index_byte, 1);
     if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, hash, sizeof(hash));
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, (uint8_t *)&pkey_index, 1);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_finish(h->l3.crypto_ctx, hash);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
+        return ret;
     }
 
     // h = SHA256(h||ETPUB)
-    ret = lt_sha256_start(h->l3.crypto_ctx);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, hash, sizeof(hash));
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_update(h->l3.crypto_ctx, p_rsp->e_tpub, TR01_ETPUB_LEN);
+    ret = lt_l3_transcript_update(h->l3.crypto_ctx, hash, p_rsp->e_tpub, TR01_ETPUB_LEN);
     if (ret != LT_OK) {
-        goto sha256_cleanup;
-    }
-    ret = lt_sha256_finish(h->l3.crypto_ctx, hash);
-    if (ret != LT_OK) {
-        goto sha256_cleanup;
+        return ret;
     }
 
     // Derivate the keys (ECDH)
@@ -208,7 +269,8 @@ lt_ret_t lt_in__session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pke
     if (ret != LT_OK) {
         goto key_derivation_cleanup;
     }
-    ret = lt_hkdf(protocol_name, sizeof(protocol_name), shared_secret, sizeof(shared_secret), 1, output_1, output_2);
+    ret = lt_hkdf(h->l3.crypto_ctx, protocol_name, sizeof(protocol_name), shared_secret, sizeof(shared_secret), 1,
+                  output_1, output_2);
     if (ret != LT_OK) {
         goto key_derivation_cleanup;
     }
@@ -217,21 +279,28 @@ lt_ret_t lt_in__session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pke
     if (ret != LT_OK) {
         goto key_derivation_cleanup;
     }
-    ret = lt_hkdf(output_1, sizeof(output_1), shared_secret, sizeof(shared_secret), 1, output_1, output_2);
+    ret = lt_hkdf(h->l3.crypto_ctx, output_1, sizeof(output_1), shared_secret, sizeof(shared_secret), 1, output_1,
+                  output_2);
     if (ret != LT_OK) {
         goto key_derivation_cleanup;
     }
     // ck, kAUTH = HKDF (ck, X25519(EHPRIV, STPUB), 2)
-    ret = lt_X25519(host_eph_keys->ehpriv, stpub, shared_secret);
-    if (ret != LT_OK) {
-        goto key_derivation_cleanup;
+    if (eh_st_shared) {
+        memcpy(shared_secret, eh_st_shared, sizeof(shared_secret));
     }
-    ret = lt_hkdf(output_1, sizeof(output_1), shared_secret, sizeof(shared_secret), 2, output_1, kauth);
+    else {
+        ret = lt_X25519(host_eph_keys->ehpriv, stpub, shared_secret);
+        if (ret != LT_OK) {
+            goto key_derivation_cleanup;
+        }
+    }
+    ret = lt_hkdf(h->l3.crypto_ctx, output_1, sizeof(output_1), shared_secret, sizeof(shared_secret), 2, output_1,
+                  kauth);
     if (ret != LT_OK) {
         goto key_derivation_cleanup;
     }
     // kCMD, kRES = HKDF (ck, emptystring, 2)
-    ret = lt_hkdf(output_1, sizeof(output_1), (uint8_t *)"", 0, 2, kcmd, kres);
+    ret = lt_hkdf(h->l3.crypto_ctx, output_1, sizeof(output_1), (uint8_t *)"", 0, 2, kcmd, kres);
     if (ret != LT_OK) {
         goto key_derivation_cleanup;
     }
@@ -241,8 +310,8 @@ lt_ret_t lt_in__session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pke
         goto aesgcm_error;
     }
 
-    ret = lt_aesgcm_decrypt(h->l3.crypto_ctx, h->l3.decryption_IV, sizeof(h->l3.decryption_IV), hash, sizeof(hash),
-                            p_rsp->t_tauth, sizeof(p_rsp->t_tauth), (uint8_t *)"", 0);
+    ret = lt_aesgcm_decrypt(h->l3.crypto_ctx, h->l3.decryption_IV, sizeof(h->l3.decryption_IV), hash,
+                            LT_SHA256_DIGEST_LENGTH, p_rsp->t_tauth, sizeof(p_rsp->t_tauth), (uint8_t *)"", 0);
     if (ret != LT_OK) {
         goto aesgcm_error;
     }
@@ -263,6 +332,14 @@ lt_ret_t lt_in__session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pke
     }
 
     h->l3.session_status = LT_SECURE_SESSION_ON;
+#ifdef LT_SESSION_EXPORT
+    memcpy(h->l3.session_keys[0], kcmd, sizeof(kcmd));
+    memcpy(h->l3.session_keys[1], kres, sizeof(kres));
+#endif
+#if defined(LT_PIN) || defined(LT_MCOUNTER_CACHE) || defined(LT_ECC_INVENTORY) || defined(LT_R_MEM_MAP) \
+    || defined(LT_PAIRING_PUB_CACHE) || defined(LT_EDDSA_SIG_CACHE)
+    h->l3.session_cnt++;
+#endif
     goto key_derivation_cleanup;
 
 aesgcm_error:
@@ -276,15 +353,152 @@ key_derivation_cleanup:
     lt_secure_memzero(kcmd, sizeof(kcmd));
     lt_secure_memzero(kres, sizeof(kres));
     lt_secure_memzero(kauth, sizeof(kauth));
+    LT_UNUSED(ret_unused);
+
+    return ret;
+}
+
+lt_ret_t lt_in__session_start(lt_handle_t *h, const uint8_t *stpub, const lt_pkey_index_t pkey_index,
+                              const uint8_t *shipriv, const uint8_t *shipub, lt_host_eph_keys_t *host_eph_keys)
+{
+    if (!h || !stpub || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv || !shipub || !host_eph_keys) {
+        return LT_PARAM_ERR;
+    }
+
+    // Remove any previous session data and init IVs.
+    // In case we reuse handle and use separate l3 buffer, we need to ensure that IV's are zeroed,
+    // because on session start we expect IV's to be 0. It does not hurt to zero them anyway on session start.
+    lt_l3_invalidate_host_session_data(&h->l3);
+
+    uint8_t hash[LT_SHA256_DIGEST_LENGTH] = {0};
+    lt_ret_t ret_unused;
+
+    // Initialize SHA-256 context.
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // h = SHA256(SHA256(SHA256(protocol_name)||SHiPUB)||STPUB)
+    const uint8_t *eh_st_shared = NULL;
+#ifdef LT_SESSION_CACHE
+    lt_session_cache_t *cache = h->l3.session_cache;
+    const bool cache_stpub = cache && !memcmp(cache->stpub, stpub, TR01_STPUB_LEN);
+    if (cache_stpub && !memcmp(cache->shipub, shipub, TR01_SHIPUB_LEN)) {
+        memcpy(hash, cache->prefix_hash, sizeof(hash));
+    }
+    else {
+        ret = lt_l3_transcript_prefix(h->l3.crypto_ctx, shipub, stpub, hash);
+    }
+    // X25519(EHPRIV, STPUB) was prepared with the key pair lt_out__session_start() took from the cache.
+    if (cache_stpub && cache->eph_in_use
+        && !memcmp(cache->eph_cur.keys.ehpub, host_eph_keys->ehpub, TR01_EHPUB_LEN)) {
+        eh_st_shared = cache->eph_cur.eh_st_shared;
+    }
+#else
+    ret = lt_l3_transcript_prefix(h->l3.crypto_ctx, shipub, stpub, hash);
+#endif
+    if (ret == LT_OK) {
+        ret = lt_l3_session_finish(h, hash, stpub, pkey_index, shipriv, host_eph_keys, eh_st_shared);
+    }
+#ifdef LT_SESSION_CACHE
+    // Ephemeral keys are used for one handshake only.
+    if (cache) {
+        lt_session_cache_eph_drop(cache);
+    }
+#endif
 
-sha256_cleanup:
     ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
     LT_UNUSED(ret_unused);
     lt_secure_memzero(hash, sizeof(hash));
 
+    if (ret == LT_OK) {
+        LT_STATS_INC(&h->l3, l3_handshakes);
+    }
+    else {
+        LT_STATS_INC(&h->l3, l3_handshake_errors);
+    }
+
     return ret;
 }
 
+#ifdef LT_SESSION_CACHE
+lt_ret_t lt_out__session_start_cached(lt_handle_t *h, const lt_pkey_index_t pkey_index, lt_session_cache_t *cache)
+{
+    if (!h || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !cache || !cache->initialized) {
+        return LT_PARAM_ERR;
+    }
+
+    // Remove any previous session data and init IVs.
+    lt_l3_invalidate_host_session_data(&h->l3);
+
+    // Ephemeral keys of an abandoned handshake were already sent, never use them again.
+    lt_session_cache_eph_drop(cache);
+
+    if (lt_session_cache_eph_take(cache, &cache->eph_cur)) {
+        cache->hits++;
+    }
+    else {
+        cache->misses++;
+        lt_ret_t ret = lt_session_cache_eph_gen(h, cache, &cache->eph_cur);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+    cache->eph_in_use = true;
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_handshake_req_t *p_req = (struct lt_l2_handshake_req_t *)h->l2.buff;
+
+    p_req->req_id = TR01_L2_HANDSHAKE_REQ_ID;
+    p_req->req_len = TR01_L2_HANDSHAKE_REQ_LEN;
+    memcpy(p_req->e_hpub, cache->eph_cur.keys.ehpub, TR01_EHPUB_LEN);
+
+    p_req->pkey_index = (uint8_t)pkey_index;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_in__session_start_cached(lt_handle_t *h, const lt_pkey_index_t pkey_index, const uint8_t *shipriv,
+                                     lt_session_cache_t *cache)
+{
+    if (!h || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv || !cache || !cache->eph_in_use) {
+        return LT_PARAM_ERR;
+    }
+
+    // Remove any previous session data and init IVs.
+    lt_l3_invalidate_host_session_data(&h->l3);
+
+    uint8_t hash[LT_SHA256_DIGEST_LENGTH];
+    lt_ret_t ret_unused;
+
+    // Initialize SHA-256 context.
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
+    if (ret == LT_OK) {
+        // Transcript hash up to STPUB was computed by lt_session_cache_init()
+        memcpy(hash, cache->prefix_hash, sizeof(hash));
+        ret = lt_l3_session_finish(h, hash, cache->stpub, pkey_index, shipriv, &cache->eph_cur.keys,
+                                   cache->eph_cur.eh_st_shared);
+
+        ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
+        LT_UNUSED(ret_unused);
+        lt_secure_memzero(hash, sizeof(hash));
+    }
+
+    // Ephemeral keys are used for one handshake only.
+    lt_session_cache_eph_drop(cache);
+
+    if (ret == LT_OK) {
+        LT_STATS_INC(&h->l3, l3_handshakes);
+    }
+    else {
+        LT_STATS_INC(&h->l3, l3_handshake_errors);
+    }
+
+    return ret;
+}
+#endif
+
 lt_ret_t lt_out__ping(lt_handle_t *h, const uint8_t *msg_out, const uint16_t msg_len)
 {
     if (!h || !msg_out || (msg_len > TR01_PING_LEN_MAX)) {
@@ -293,6 +507,15 @@ lt_ret_t lt_out__ping(lt_handle_t *h, const uint8_t *msg_out, const uint16_t msg
     if (h->l3.session_status != LT_SECURE_SESSION_ON) {
         return LT_HOST_NO_SESSION;
     }
+    // The result echoes the message, so it has the same size as the command.
+    if (!lt_l3_buff_fits(h, TR01_L3_PING_CMD_SIZE_MIN + msg_len)) {
+        return LT_L3_BUFFER_TOO_SMALL;
+    }
+
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
 
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_ping_cmd_t *p_l3_cmd = (struct lt_l3_ping_cmd_t *)h->l3.buff;
@@ -302,7 +525,7 @@ lt_ret_t lt_out__ping(lt_handle_t *h, const uint8_t *msg_out, const uint16_t msg
     p_l3_cmd->cmd_id = TR01_L3_PING_CMD_ID;
     memcpy(p_l3_cmd->data_in, msg_out, msg_len);
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__ping(lt_handle_t *h, uint8_t *msg_in, const uint16_t msg_len)
@@ -316,6 +539,7 @@ lt_ret_t lt_in__ping(lt_handle_t *h, uint8_t *msg_in, const uint16_t msg_len)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -330,6 +554,7 @@ lt_ret_t lt_in__ping(lt_handle_t *h, uint8_t *msg_in, const uint16_t msg_len)
 
     memcpy(msg_in, p_l3_res->data_out, msg_len);
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -342,6 +567,11 @@ lt_ret_t lt_out__pairing_key_write(lt_handle_t *h, const uint8_t *pairing_pub, c
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_pairing_key_write_cmd_t *p_l3_cmd = (struct lt_l3_pairing_key_write_cmd_t *)h->l3.buff;
 
@@ -351,7 +581,7 @@ lt_ret_t lt_out__pairing_key_write(lt_handle_t *h, const uint8_t *pairing_pub, c
     p_l3_cmd->slot = slot;
     memcpy(p_l3_cmd->s_hipub, pairing_pub, sizeof(p_l3_cmd->s_hipub));
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__pairing_key_write(lt_handle_t *h)
@@ -365,6 +595,7 @@ lt_ret_t lt_in__pairing_key_write(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -377,6 +608,7 @@ lt_ret_t lt_in__pairing_key_write(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -389,6 +621,11 @@ lt_ret_t lt_out__pairing_key_read(lt_handle_t *h, const uint8_t slot)
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_pairing_key_read_cmd_t *p_l3_cmd = (struct lt_l3_pairing_key_read_cmd_t *)h->l3.buff;
 
@@ -397,7 +634,7 @@ lt_ret_t lt_out__pairing_key_read(lt_handle_t *h, const uint8_t slot)
     p_l3_cmd->cmd_id = TR01_L3_PAIRING_KEY_READ_CMD_ID;
     p_l3_cmd->slot = slot;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__pairing_key_read(lt_handle_t *h, uint8_t *pubkey)
@@ -411,6 +648,7 @@ lt_ret_t lt_in__pairing_key_read(lt_handle_t *h, uint8_t *pubkey)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -425,6 +663,7 @@ lt_ret_t lt_in__pairing_key_read(lt_handle_t *h, uint8_t *pubkey)
 
     memcpy(pubkey, p_l3_res->s_hipub, TR01_SHIPUB_LEN);
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -437,6 +676,11 @@ lt_ret_t lt_out__pairing_key_invalidate(lt_handle_t *h, const uint8_t slot)
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_pairing_key_invalidate_cmd_t *p_l3_cmd = (struct lt_l3_pairing_key_invalidate_cmd_t *)h->l3.buff;
 
@@ -446,7 +690,7 @@ lt_ret_t lt_out__pairing_key_invalidate(lt_handle_t *h, const uint8_t slot)
     // cmd data
     p_l3_cmd->slot = slot;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__pairing_key_invalidate(lt_handle_t *h)
@@ -460,6 +704,7 @@ lt_ret_t lt_in__pairing_key_invalidate(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -472,9 +717,11 @@ lt_ret_t lt_in__pairing_key_invalidate(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
+#ifdef LT_CMD_CONFIG
 static bool conf_addr_valid(enum lt_config_obj_addr_t addr)
 {
     bool valid = false;
@@ -521,6 +768,11 @@ lt_ret_t lt_out__r_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_r_config_write_cmd_t *p_l3_cmd = (struct lt_l3_r_config_write_cmd_t *)h->l3.buff;
 
@@ -530,7 +782,7 @@ lt_ret_t lt_out__r_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t
     p_l3_cmd->address = (uint16_t)addr;
     p_l3_cmd->value = obj;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__r_config_write(lt_handle_t *h)
@@ -544,6 +796,7 @@ lt_ret_t lt_in__r_config_write(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -556,6 +809,7 @@ lt_ret_t lt_in__r_config_write(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -568,6 +822,11 @@ lt_ret_t lt_out__r_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t a
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_r_config_read_cmd_t *p_l3_cmd = (struct lt_l3_r_config_read_cmd_t *)h->l3.buff;
 
@@ -576,7 +835,7 @@ lt_ret_t lt_out__r_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t a
     p_l3_cmd->cmd_id = TR01_L3_R_CONFIG_READ_CMD_ID;
     p_l3_cmd->address = (uint16_t)addr;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__r_config_read(lt_handle_t *h, uint32_t *obj)
@@ -590,6 +849,7 @@ lt_ret_t lt_in__r_config_read(lt_handle_t *h, uint32_t *obj)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -604,6 +864,7 @@ lt_ret_t lt_in__r_config_read(lt_handle_t *h, uint32_t *obj)
 
     *obj = p_l3_res->value;
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -616,6 +877,11 @@ lt_ret_t lt_out__r_config_erase(lt_handle_t *h)
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_r_config_erase_cmd_t *p_l3_cmd = (struct lt_l3_r_config_erase_cmd_t *)h->l3.buff;
 
@@ -623,7 +889,7 @@ lt_ret_t lt_out__r_config_erase(lt_handle_t *h)
     p_l3_cmd->cmd_size = TR01_L3_R_CONFIG_ERASE_CMD_SIZE;
     p_l3_cmd->cmd_id = TR01_L3_R_CONFIG_ERASE_CMD_ID;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__r_config_erase(lt_handle_t *h)
@@ -637,6 +903,7 @@ lt_ret_t lt_in__r_config_erase(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -649,6 +916,7 @@ lt_ret_t lt_in__r_config_erase(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -661,6 +929,11 @@ lt_ret_t lt_out__i_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_i_config_write_cmd_t *p_l3_cmd = (struct lt_l3_i_config_write_cmd_t *)h->l3.buff;
 
@@ -670,7 +943,7 @@ lt_ret_t lt_out__i_config_write(lt_handle_t *h, const enum lt_config_obj_addr_t
     p_l3_cmd->address = (uint16_t)addr;
     p_l3_cmd->bit_index = bit_index;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__i_config_write(lt_handle_t *h)
@@ -684,6 +957,7 @@ lt_ret_t lt_in__i_config_write(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -696,6 +970,7 @@ lt_ret_t lt_in__i_config_write(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -708,6 +983,11 @@ lt_ret_t lt_out__i_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t a
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_i_config_read_cmd_t *p_l3_cmd = (struct lt_l3_i_config_read_cmd_t *)h->l3.buff;
 
@@ -716,7 +996,7 @@ lt_ret_t lt_out__i_config_read(lt_handle_t *h, const enum lt_config_obj_addr_t a
     p_l3_cmd->cmd_id = TR01_L3_I_CONFIG_READ_CMD_ID;
     p_l3_cmd->address = (uint16_t)addr;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__i_config_read(lt_handle_t *h, uint32_t *obj)
@@ -730,6 +1010,7 @@ lt_ret_t lt_in__i_config_read(lt_handle_t *h, uint32_t *obj)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -744,9 +1025,12 @@ lt_ret_t lt_in__i_config_read(lt_handle_t *h, uint32_t *obj)
 
     *obj = p_l3_res->value;
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
+#endif
 
+#ifdef LT_CMD_R_MEM
 lt_ret_t lt_out__r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, const uint8_t *data,
                                   const uint16_t data_size)
 {
@@ -757,6 +1041,14 @@ lt_ret_t lt_out__r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, con
     if (h->l3.session_status != LT_SECURE_SESSION_ON) {
         return LT_HOST_NO_SESSION;
     }
+    if (!lt_l3_buff_fits(h, data_size + 4)) {
+        return LT_L3_BUFFER_TOO_SMALL;
+    }
+
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
 
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_r_mem_data_write_cmd_t *p_l3_cmd = (struct lt_l3_r_mem_data_write_cmd_t *)h->l3.buff;
@@ -767,7 +1059,7 @@ lt_ret_t lt_out__r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, con
     p_l3_cmd->udata_slot = udata_slot;
     memcpy(p_l3_cmd->data, data, data_size);
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__r_mem_data_write(lt_handle_t *h)
@@ -781,6 +1073,7 @@ lt_ret_t lt_in__r_mem_data_write(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -793,6 +1086,7 @@ lt_ret_t lt_in__r_mem_data_write(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -804,6 +1098,16 @@ lt_ret_t lt_out__r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot)
     if (h->l3.session_status != LT_SECURE_SESSION_ON) {
         return LT_HOST_NO_SESSION;
     }
+    // The slot may hold up to the max slot size, so the result has to fit even then.
+    if (!lt_l3_buff_fits(h, TR01_L3_RESULT_SIZE + TR01_L3_R_MEM_DATA_READ_PADDING_SIZE
+                                + h->tr01_attrs.r_mem_udata_slot_size_max)) {
+        return LT_L3_BUFFER_TOO_SMALL;
+    }
+
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
 
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_r_mem_data_read_cmd_t *p_l3_cmd = (struct lt_l3_r_mem_data_read_cmd_t *)h->l3.buff;
@@ -813,7 +1117,7 @@ lt_ret_t lt_out__r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot)
     p_l3_cmd->cmd_id = TR01_L3_R_MEM_DATA_READ_CMD_ID;
     p_l3_cmd->udata_slot = udata_slot;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__r_mem_data_read(lt_handle_t *h, uint8_t *data, const uint16_t data_max_size, uint16_t *data_read_size)
@@ -827,6 +1131,7 @@ lt_ret_t lt_in__r_mem_data_read(lt_handle_t *h, uint8_t *data, const uint16_t da
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -845,16 +1150,19 @@ lt_ret_t lt_in__r_mem_data_read(lt_handle_t *h, uint8_t *data, const uint16_t da
 
     // Check if slot is not empty
     if (*data_read_size == 0) {
+        lt_l3_buff_return(&h->l3);
         return LT_L3_R_MEM_DATA_READ_SLOT_EMPTY;
     }
 
     // Check if the output buffer for the read data is big enough
     if (data_max_size < *data_read_size) {
+        lt_l3_buff_return(&h->l3);
         return LT_PARAM_ERR;
     }
 
     memcpy(data, p_l3_res->data, *data_read_size);
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -867,6 +1175,11 @@ lt_ret_t lt_out__r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot)
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_r_mem_data_erase_cmd_t *p_l3_cmd = (struct lt_l3_r_mem_data_erase_cmd_t *)h->l3.buff;
 
@@ -875,7 +1188,7 @@ lt_ret_t lt_out__r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot)
     p_l3_cmd->cmd_id = TR01_L3_R_MEM_DATA_ERASE_CMD_ID;
     p_l3_cmd->udata_slot = udata_slot;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__r_mem_data_erase(lt_handle_t *h)
@@ -889,6 +1202,7 @@ lt_ret_t lt_in__r_mem_data_erase(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -901,8 +1215,10 @@ lt_ret_t lt_in__r_mem_data_erase(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
+#endif
 
 lt_ret_t lt_out__random_value_get(lt_handle_t *h, const uint16_t rnd_bytes_cnt)
 {
@@ -913,6 +1229,11 @@ lt_ret_t lt_out__random_value_get(lt_handle_t *h, const uint16_t rnd_bytes_cnt)
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_random_value_get_cmd_t *p_l3_cmd = (struct lt_l3_random_value_get_cmd_t *)h->l3.buff;
 
@@ -921,7 +1242,7 @@ lt_ret_t lt_out__random_value_get(lt_handle_t *h, const uint16_t rnd_bytes_cnt)
     p_l3_cmd->cmd_id = TR01_L3_RANDOM_VALUE_GET_CMD_ID;
     p_l3_cmd->n_bytes = rnd_bytes_cnt;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt)
@@ -935,6 +1256,7 @@ lt_ret_t lt_in__random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint1
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -953,9 +1275,11 @@ lt_ret_t lt_in__random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint1
     // parameter. Note: p_l3_res->res_size could be used as well if we subtract TR01_L3_RANDOM_VALUE_GET_RES_SIZE_MIN.
     memcpy(rnd_bytes, p_l3_res->random_data, rnd_bytes_cnt);
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
+#ifdef LT_CMD_ECC
 lt_ret_t lt_out__ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve)
 {
     if (!h || (slot > TR01_ECC_SLOT_31) || ((curve != TR01_CURVE_P256) && (curve != TR01_CURVE_ED25519))) {
@@ -965,6 +1289,11 @@ lt_ret_t lt_out__ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, cons
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_ecc_key_generate_cmd_t *p_l3_cmd = (struct lt_l3_ecc_key_generate_cmd_t *)h->l3.buff;
 
@@ -974,7 +1303,7 @@ lt_ret_t lt_out__ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, cons
     p_l3_cmd->slot = (uint8_t)slot;
     p_l3_cmd->curve = (uint8_t)curve;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__ecc_key_generate(lt_handle_t *h)
@@ -988,6 +1317,7 @@ lt_ret_t lt_in__ecc_key_generate(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1000,6 +1330,7 @@ lt_ret_t lt_in__ecc_key_generate(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -1013,6 +1344,11 @@ lt_ret_t lt_out__ecc_key_store(lt_handle_t *h, const lt_ecc_slot_t slot, const l
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_ecc_key_store_cmd_t *p_l3_cmd = (struct lt_l3_ecc_key_store_cmd_t *)h->l3.buff;
 
@@ -1023,7 +1359,7 @@ lt_ret_t lt_out__ecc_key_store(lt_handle_t *h, const lt_ecc_slot_t slot, const l
     p_l3_cmd->curve = curve;
     memcpy(p_l3_cmd->k, key, TR01_CURVE_PRIVKEY_LEN);
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__ecc_key_store(lt_handle_t *h)
@@ -1037,6 +1373,7 @@ lt_ret_t lt_in__ecc_key_store(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1049,6 +1386,7 @@ lt_ret_t lt_in__ecc_key_store(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -1061,6 +1399,11 @@ lt_ret_t lt_out__ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t slot)
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_ecc_key_read_cmd_t *p_l3_cmd = (struct lt_l3_ecc_key_read_cmd_t *)h->l3.buff;
 
@@ -1069,7 +1412,7 @@ lt_ret_t lt_out__ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t slot)
     p_l3_cmd->cmd_id = TR01_L3_ECC_KEY_READ_CMD_ID;
     p_l3_cmd->slot = slot;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__ecc_key_read(lt_handle_t *h, uint8_t *key, const uint8_t key_max_size, lt_ecc_curve_type_t *curve,
@@ -1084,6 +1427,7 @@ lt_ret_t lt_in__ecc_key_read(lt_handle_t *h, uint8_t *key, const uint8_t key_max
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1102,6 +1446,7 @@ lt_ret_t lt_in__ecc_key_read(lt_handle_t *h, uint8_t *key, const uint8_t key_max
 
         // Check if the output buffer for the key is big enough
         if (key_max_size < TR01_CURVE_ED25519_PUBKEY_LEN) {
+            lt_l3_buff_return(&h->l3);
             return LT_PARAM_ERR;
         }
 
@@ -1116,6 +1461,7 @@ lt_ret_t lt_in__ecc_key_read(lt_handle_t *h, uint8_t *key, const uint8_t key_max
 
         // Check if the output buffer for the key is big enough
         if (key_max_size < TR01_CURVE_P256_PUBKEY_LEN) {
+            lt_l3_buff_return(&h->l3);
             return LT_PARAM_ERR;
         }
 
@@ -1123,12 +1469,14 @@ lt_ret_t lt_in__ecc_key_read(lt_handle_t *h, uint8_t *key, const uint8_t key_max
     }
     else {
         // Unknown curve type.
+        lt_l3_buff_return(&h->l3);
         return LT_FAIL;
     }
 
     *curve = p_l3_res->curve;
     *origin = p_l3_res->origin;
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -1141,6 +1489,11 @@ lt_ret_t lt_out__ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t slot)
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_ecc_key_erase_cmd_t *p_l3_cmd = (struct lt_l3_ecc_key_erase_cmd_t *)h->l3.buff;
 
@@ -1149,7 +1502,7 @@ lt_ret_t lt_out__ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t slot)
     p_l3_cmd->cmd_id = TR01_L3_ECC_KEY_ERASE_CMD_ID;
     p_l3_cmd->slot = slot;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__ecc_key_erase(lt_handle_t *h)
@@ -1163,6 +1516,7 @@ lt_ret_t lt_in__ecc_key_erase(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1175,6 +1529,7 @@ lt_ret_t lt_in__ecc_key_erase(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -1210,6 +1565,30 @@ lt_ret_t lt_out__ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t slot, const
         goto sha256_cleanup;
     }
 
+    ret = lt_out__ecc_ecdsa_sign_digest(h, slot, msg_hash);
+
+sha256_cleanup:
+    ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
+    lt_secure_memzero(msg_hash, sizeof(msg_hash));
+    LT_UNUSED(ret_unused);
+
+    return ret;
+}
+
+lt_ret_t lt_out__ecc_ecdsa_sign_digest(lt_handle_t *h, const lt_ecc_slot_t slot, const uint8_t *msg_hash)
+{
+    if (!h || (slot > TR01_ECC_SLOT_31) || !msg_hash) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_ecdsa_sign_cmd_t *p_l3_cmd = (struct lt_l3_ecdsa_sign_cmd_t *)h->l3.buff;
 
@@ -1219,14 +1598,7 @@ lt_ret_t lt_out__ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t slot, const
     p_l3_cmd->slot = slot;
     memcpy(p_l3_cmd->msg_hash, msg_hash, sizeof(p_l3_cmd->msg_hash));
 
-    ret = lt_l3_encrypt_request(&h->l3);
-
-sha256_cleanup:
-    ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
-    lt_secure_memzero(msg_hash, sizeof(msg_hash));
-    LT_UNUSED(ret_unused);
-
-    return ret;
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__ecc_ecdsa_sign(lt_handle_t *h, uint8_t *rs)
@@ -1240,6 +1612,7 @@ lt_ret_t lt_in__ecc_ecdsa_sign(lt_handle_t *h, uint8_t *rs)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1255,6 +1628,7 @@ lt_ret_t lt_in__ecc_ecdsa_sign(lt_handle_t *h, uint8_t *rs)
     memcpy(rs, p_l3_res->r, sizeof(p_l3_res->r));
     memcpy(rs + sizeof(p_l3_res->r), p_l3_res->s, sizeof(p_l3_res->s));
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -1267,6 +1641,14 @@ lt_ret_t lt_out__ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, co
     if (h->l3.session_status != LT_SECURE_SESSION_ON) {
         return LT_HOST_NO_SESSION;
     }
+    if (!lt_l3_buff_fits(h, TR01_L3_EDDSA_SIGN_CMD_SIZE_MIN + msg_len)) {
+        return LT_L3_BUFFER_TOO_SMALL;
+    }
+
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
 
     // Pointer to access l3 buffer when it contains command data
     struct lt_l3_eddsa_sign_cmd_t *p_l3_cmd = (struct lt_l3_eddsa_sign_cmd_t *)h->l3.buff;
@@ -1277,7 +1659,7 @@ lt_ret_t lt_out__ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, co
     p_l3_cmd->slot = ecc_slot;
     memcpy(p_l3_cmd->msg, msg, msg_len);
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__ecc_eddsa_sign(lt_handle_t *h, uint8_t *rs)
@@ -1291,6 +1673,7 @@ lt_ret_t lt_in__ecc_eddsa_sign(lt_handle_t *h, uint8_t *rs)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1306,9 +1689,12 @@ lt_ret_t lt_in__ecc_eddsa_sign(lt_handle_t *h, uint8_t *rs)
     memcpy(rs, p_l3_res->r, sizeof(p_l3_res->r));
     memcpy(rs + sizeof(p_l3_res->r), p_l3_res->s, sizeof(p_l3_res->s));
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
+#endif
 
+#ifdef LT_CMD_MCOUNTER
 lt_ret_t lt_out__mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index,
                                const uint32_t mcounter_value)
 {
@@ -1319,6 +1705,11 @@ lt_ret_t lt_out__mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mc
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_mcounter_init_cmd_t *p_l3_cmd = (struct lt_l3_mcounter_init_cmd_t *)h->l3.buff;
 
@@ -1328,7 +1719,7 @@ lt_ret_t lt_out__mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mc
     p_l3_cmd->mcounter_index = mcounter_index;
     p_l3_cmd->mcounter_val = mcounter_value;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__mcounter_init(lt_handle_t *h)
@@ -1342,6 +1733,7 @@ lt_ret_t lt_in__mcounter_init(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1354,6 +1746,7 @@ lt_ret_t lt_in__mcounter_init(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -1366,6 +1759,11 @@ lt_ret_t lt_out__mcounter_update(lt_handle_t *h, const enum lt_mcounter_index_t
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_mcounter_update_cmd_t *p_l3_cmd = (struct lt_l3_mcounter_update_cmd_t *)h->l3.buff;
 
@@ -1374,7 +1772,7 @@ lt_ret_t lt_out__mcounter_update(lt_handle_t *h, const enum lt_mcounter_index_t
     p_l3_cmd->cmd_id = TR01_L3_MCOUNTER_UPDATE_CMD_ID;
     p_l3_cmd->mcounter_index = mcounter_index;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__mcounter_update(lt_handle_t *h)
@@ -1388,6 +1786,7 @@ lt_ret_t lt_in__mcounter_update(lt_handle_t *h)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1400,6 +1799,7 @@ lt_ret_t lt_in__mcounter_update(lt_handle_t *h)
         return LT_L3_RES_SIZE_ERROR;
     }
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
 
@@ -1412,6 +1812,11 @@ lt_ret_t lt_out__mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mco
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_mcounter_get_cmd_t *p_l3_cmd = (struct lt_l3_mcounter_get_cmd_t *)h->l3.buff;
 
@@ -1420,7 +1825,7 @@ lt_ret_t lt_out__mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mco
     p_l3_cmd->cmd_id = TR01_L3_MCOUNTER_GET_CMD_ID;
     p_l3_cmd->mcounter_index = mcounter_index;
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__mcounter_get(lt_handle_t *h, uint32_t *mcounter_value)
@@ -1434,6 +1839,7 @@ lt_ret_t lt_in__mcounter_get(lt_handle_t *h, uint32_t *mcounter_value)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1448,9 +1854,12 @@ lt_ret_t lt_in__mcounter_get(lt_handle_t *h, uint32_t *mcounter_value)
 
     *mcounter_value = p_l3_res->mcounter_val;
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
+#endif
 
+#ifdef LT_CMD_MAC_DESTROY
 lt_ret_t lt_out__mac_and_destroy(lt_handle_t *h, lt_mac_and_destroy_slot_t slot, const uint8_t *data_out)
 {
     if (!h || !data_out || slot > TR01_MAC_AND_DESTROY_SLOT_127) {
@@ -1460,6 +1869,11 @@ lt_ret_t lt_out__mac_and_destroy(lt_handle_t *h, lt_mac_and_destroy_slot_t slot,
         return LT_HOST_NO_SESSION;
     }
 
+    lt_ret_t ret = lt_l3_buff_borrow(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
     // Setup a pointer to l3 buffer, which is placed in handle
     struct lt_l3_mac_and_destroy_cmd_t *p_l3_cmd = (struct lt_l3_mac_and_destroy_cmd_t *)h->l3.buff;
 
@@ -1469,7 +1883,7 @@ lt_ret_t lt_out__mac_and_destroy(lt_handle_t *h, lt_mac_and_destroy_slot_t slot,
     p_l3_cmd->slot = slot;
     memcpy(p_l3_cmd->data_in, data_out, TR01_MAC_AND_DESTROY_DATA_SIZE);
 
-    return lt_l3_encrypt_request(&h->l3);
+    return lt_l3_encrypt_cmd(h);
 }
 
 lt_ret_t lt_in__mac_and_destroy(lt_handle_t *h, uint8_t *data_in)
@@ -1483,6 +1897,7 @@ lt_ret_t lt_in__mac_and_destroy(lt_handle_t *h, uint8_t *data_in)
 
     lt_ret_t ret = lt_l3_decrypt_response(&h->l3);
     if (ret != LT_OK) {
+        lt_l3_buff_return(&h->l3);
         return ret;
     }
 
@@ -1497,5 +1912,7 @@ lt_ret_t lt_in__mac_and_destroy(lt_handle_t *h, uint8_t *data_in)
 
     memcpy(data_in, p_l3_res->data_out, TR01_MAC_AND_DESTROY_DATA_SIZE);
 
+    lt_l3_buff_return(&h->l3);
     return LT_OK;
 }
+#endif
@@ -73,6 +73,86 @@ lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len,
                            const uint32_t add_len, const uint8_t *ciphertext, const uint32_t ciphertext_len,
                            uint8_t *plaintext, const uint32_t plaintext_len) __attribute__((warn_unused_result));
 
+#ifdef LT_L3_STREAM_ENCRYPT
+/**
+ * @brief Starts encryption of data passed in parts by `lt_aesgcm_encrypt_update()`, expects initialized context with
+ * valid keys.
+ * @note Implemented only by CALs supporting LT_L3_STREAM_ENCRYPT.
+ *
+ * @param ctx               AES-GCM context structure
+ * @param iv                Initialization vector
+ * @param iv_len            Length of the initialization vector
+ * @param add               Additional data
+ * @param add_len           Length of additional data
+ * @return                  LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_aesgcm_encrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len) __attribute__((warn_unused_result));
+
+/**
+ * @brief Encrypts next part of plaintext started by `lt_aesgcm_encrypt_start()`.
+ *
+ * @param ctx               AES-GCM context structure
+ * @param plaintext         Part of the plaintext, any length
+ * @param plaintext_len     Length of the part
+ * @param ciphertext        Buffer to store ciphertext of the same length as the part, may be the same as plaintext
+ * @return                  LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_aesgcm_encrypt_update(void *ctx, const uint8_t *plaintext, const uint32_t plaintext_len,
+                                  uint8_t *ciphertext) __attribute__((warn_unused_result));
+
+/**
+ * @brief Finishes encryption started by `lt_aesgcm_encrypt_start()` and computes the tag.
+ *
+ * @param ctx               AES-GCM context structure
+ * @param tag               Buffer to store the tag
+ * @param tag_len           Length of the tag
+ * @return                  LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_aesgcm_encrypt_finish(void *ctx, uint8_t *tag, const uint32_t tag_len) __attribute__((warn_unused_result));
+#endif
+
+#ifdef LT_L3_STREAM_DECRYPT
+/**
+ * @brief Starts decryption of data passed in parts by `lt_aesgcm_decrypt_update()`, expects initialized context with
+ * valid keys.
+ * @note Implemented only by CALs supporting LT_L3_STREAM_DECRYPT.
+ *
+ * @param ctx               AES-GCM context structure
+ * @param iv                The initialisation vector
+ * @param iv_len            Length of the initialization vector
+ * @param add               Additional data
+ * @param add_len           Length of additional data
+ * @return                  LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_aesgcm_decrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len) __attribute__((warn_unused_result));
+
+/**
+ * @brief Decrypts next part of ciphertext (without tag) started by `lt_aesgcm_decrypt_start()`.
+ * @warning Plaintext is not authenticated until `lt_aesgcm_decrypt_finish()` succeeds.
+ *
+ * @param ctx               AES-GCM context structure
+ * @param ciphertext        Part of the ciphertext, any length
+ * @param ciphertext_len    Length of the part
+ * @param plaintext         Buffer to store plaintext of the same length as the part
+ * @return                  LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_aesgcm_decrypt_update(void *ctx, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                                  uint8_t *plaintext) __attribute__((warn_unused_result));
+
+/**
+ * @brief Finishes decryption started by `lt_aesgcm_decrypt_start()` and verifies the tag.
+ *
+ * @param ctx               AES-GCM context structure
+ * @param tag               Expected tag
+ * @param tag_len           Length of the tag
+ * @return                  LT_OK if the tag matches, otherwise returns other error code.
+ */
+lt_ret_t lt_aesgcm_decrypt_finish(void *ctx, const uint8_t *tag, const uint32_t tag_len)
+    __attribute__((warn_unused_result));
+#endif
+
 /**
  * @brief Deinitializes AES-GCM encryption context.
  * @warning Implementation can assume that `lt_crypto_ctx_init` was called before, but must not assume that
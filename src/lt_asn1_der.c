@@ -17,272 +17,272 @@
 #include "libtropic_logging.h"
 
 /**
- * @brief ASN1 DER parsing context
- *
- * @details Holds state of the parser and parsing results
+ * @brief Part of the ASN1 object the next byte of the stream belongs to.
  */
-struct parse_ctx_t {
-    uint8_t *head;                         /** Next byte to be parse */
-    uint16_t len;                          /** Length of the byte stream */
-    uint16_t past;                         /** Index of last processed byte */
-    uint32_t obj_id;                       /** Target OBJECT_IDENTIFIER (3-byte) to be searched */
-    uint8_t *sbuf;                         /** Buffer (and its length) where to copy data after
-                                               OBJECT_IDENTIFIER match */
-    int sbuf_len;                          /** Length of Buffer pointed to by sbuf. */
-    enum lt_asn1der_crop_kind_t crop_kind; /** How to treat objects larger than provided buffer */
-    bool sample_next;                      /** Internal context ->
-                                               Next ASN1 object is the one to be sampled */
-    bool found;                            /** Searched OBJECT_IDENTIFIER was found */
-    bool cropped;                          /** Searched object was cropped */
+enum lt_asn1der_state_t {
+    LT_ASN1DER_STATE_TAG,        /** Tag of the next object */
+    LT_ASN1DER_STATE_LEN,        /** First length byte */
+    LT_ASN1DER_STATE_LEN_LONG,   /** Next byte of long form length */
+    LT_ASN1DER_STATE_CONTENTS,   /** Contents of a primitive object, skipped */
+    LT_ASN1DER_STATE_OID,        /** Contents of OBJECT_IDENTIFIER */
+    LT_ASN1DER_STATE_SAMPLE,     /** Contents of the searched object */
 };
 
-#define LT_ASN1_DER_PARSE_ERR(ctx, msg, ...)                           \
-    do {                                                               \
-        LT_LOG_ERROR("ASN1 DER Parsing error:");                       \
-        LT_LOG_ERROR("    Byte position:    %" PRIu16, ctx->past);     \
-        LT_LOG_ERROR("    Byte value:       0x%" PRIx8, *(ctx->head)); \
-        LT_LOG_ERROR("    Error:            " msg, ##__VA_ARGS__);     \
+#define LT_ASN1_DER_PARSE_ERR(s, b, msg, ...)                        \
+    do {                                                             \
+        LT_LOG_ERROR("ASN1 DER Parsing error:");                     \
+        LT_LOG_ERROR("    Byte position:    %" PRIu16, (s)->past);   \
+        LT_LOG_ERROR("    Byte value:       0x%" PRIx8, (b));        \
+        LT_LOG_ERROR("    Error:            " msg, ##__VA_ARGS__);   \
     } while (0);
 
 /**
- * @brief Process bytes from byte stream being parsed
- *
- * @param ctx       Parsing context
- * @param buf       Result buffer
- * @param n         Number of bytes to copy
- * @param copy      If true, copy the consumed bytes to "buf"
+ * @brief Tells whether the object of this type can be sampled after the searched OBJECT_IDENTIFIER.
  *
- * @returns LT_OK if sucessfully, error code otherwise
+ * @param tag       Tag of the object
+ * @returns true if the object can be sampled
  */
-static lt_ret_t consume_bytes(struct parse_ctx_t *ctx, uint8_t *buf, uint16_t n, bool copy)
+static bool asn1der_sampled_kind(const uint8_t tag)
 {
-    if (ctx->past + n > ctx->len) {
-        LT_ASN1_DER_PARSE_ERR(ctx, "Incomplete byte stream. Past: %" PRIu16 ", n: %" PRIu16 ", len: %" PRIu16,
-                              ctx->past, n, ctx->len);
-        return LT_CERT_STORE_INVALID;
+    switch (tag) {
+        case LT_ASN1DER_BOOLEAN:
+        case LT_ASN1DER_INTEGER:
+        case LT_ASN1DER_STRING_BIT:
+        case LT_ASN1DER_STRING_OCTET:
+        case LT_ASN1DER_STRING_NULL:
+        case LT_ASN1DER_STRING_UTF8:
+        case LT_ASN1DER_STRING_PRINTABLE:
+        case LT_ASN1DER_UTC_TIME:
+            return true;
+        default:
+            return false;
     }
+}
+
+/**
+ * @brief Copies byte of the searched object into the sample buffer, cropping objects larger than the buffer.
+ *
+ * @param s         Parser state
+ * @param b         Byte of the object at position s->obj_pos
+ */
+static void asn1der_sample_byte(struct lt_asn1der_stream_t *s, const uint8_t b)
+{
+    uint16_t pos = s->obj_pos;
 
-    if (copy) {
-        if (n == 1) {
-            *buf = *(ctx->head);
+    if (s->obj_len > s->sbuf_len) {
+        uint16_t n_crop_bytes = s->obj_len - s->sbuf_len;
+        if (s->crop_kind == LT_ASN1DER_CROP_PREFIX) {
+            if (pos < n_crop_bytes) {
+                return;
+            }
+            pos -= n_crop_bytes;
         }
-        else {
-            memcpy(buf, ctx->head, n);
+        else if (pos >= s->sbuf_len) {
+            return;
         }
     }
 
-    ctx->head += n;
-    ctx->past += n;
-
-    return LT_OK;
+    s->sbuf[pos] = b;
 }
 
-#define LT_ASN1_DER_GET_BYTES(ctx, buf, n)                \
-    do {                                                  \
-        lt_ret_t _rv_ = consume_bytes(ctx, buf, n, true); \
-        if (_rv_ != LT_OK) return _rv_;                   \
-    } while (0);
-
-#define LT_ASN1_DER_GET_NEXT_BYTE(ctx, buf) LT_ASN1_DER_GET_BYTES(ctx, buf, 1)
+/**
+ * @brief Finishes the current object and the SEQUENCEs which end with it.
+ *
+ * @param s         Parser state
+ */
+static void asn1der_object_done(struct lt_asn1der_stream_t *s)
+{
+    if (s->state == LT_ASN1DER_STATE_OID) {
+        // Objects shorter than 3 bytes never match.
+        if ((s->obj_len >= 3) && (s->oid == (uint32_t)s->obj_id)) {
+#ifdef ASNDER_LOG_EN
+            LT_LOG_DEBUG("Found searched object: 0x%" PRIx32 ". Next object will be sampled!", s->obj_id);
+#endif
+            s->sample_next = true;
+        }
+    }
+    else if (s->state == LT_ASN1DER_STATE_SAMPLE) {
+        s->sample_next = false;
+        s->found = true;
+    }
 
-#define LT_ASN1_DER_DROP_BYTES(ctx, n)                      \
-    do {                                                    \
-        lt_ret_t _rv_ = consume_bytes(ctx, NULL, n, false); \
-        if (_rv_ != LT_OK) return _rv_;                     \
-    } while (0);
+    s->state = LT_ASN1DER_STATE_TAG;
+    while (s->depth && (s->past == s->ends[s->depth - 1])) {
+        s->depth--;
+    }
+}
 
 /**
- * @brief Parse ASN1 DER length encoding
- *
- * @param ctx       Parsing context
- * @param len       Pointer to integer where length is returned
+ * @brief Handles the object whose length was just parsed: SEQUENCEs are descended into, contents of other objects
+ *        are processed byte by byte.
  *
+ * @param s         Parser state
+ * @param b         Last byte of the length
  * @returns LT_OK if sucessfully, error code otherwise
  */
-static lt_ret_t parse_length(struct parse_ctx_t *ctx, uint16_t *len)
+static lt_ret_t asn1der_header_done(struct lt_asn1der_stream_t *s, const uint8_t b)
 {
-    uint8_t b;
-    LT_ASN1_DER_GET_NEXT_BYTE(ctx, &b);
+    uint16_t limit = s->depth ? s->ends[s->depth - 1] : s->len;
 
-    if (b < 127) {
-        *len = (uint16_t)b;
+#ifdef ASNDER_LOG_EN
+    LT_LOG_DEBUG("parse_object:");
+    LT_LOG_DEBUG("    Start: %" PRIu16, s->past);
+    LT_LOG_DEBUG("    Object type: 0x%" PRIx8, s->tag);
+    LT_LOG_DEBUG("    Object len: %" PRIu16, s->obj_len);
+#endif
+
+    if (s->obj_len > limit - s->past) {
+        LT_ASN1_DER_PARSE_ERR(s, b, "Object exceeds its parent. Length: %" PRIu16 ", parent end: %" PRIu16,
+                              s->obj_len, limit);
+        return LT_CERT_STORE_INVALID;
     }
-    else {
-        uint8_t n_bytes = b ^ 0x80;
 
-        if (n_bytes > 2) {
-            LT_ASN1_DER_PARSE_ERR(ctx, "Unsupported length: More than 2 bytes");
+    s->obj_pos = 0;
+    s->oid = 0;
+
+    if (s->tag == LT_ASN1DER_SEQUENCE) {
+        if (s->depth == LT_ASN1DER_MAX_DEPTH) {
+            LT_ASN1_DER_PARSE_ERR(s, b, "Unsupported nesting: More than %d SEQUENCEs", LT_ASN1DER_MAX_DEPTH);
             return LT_CERT_UNSUPPORTED;
         }
+        s->ends[s->depth++] = s->past + s->obj_len;
+        s->state = LT_ASN1DER_STATE_TAG;
+        // Empty SEQUENCE ends right away.
+        asn1der_object_done(s);
+        return LT_OK;
+    }
 
-        *len = 0;
-        for (int i = 0; i < n_bytes; i++) {
-            (*len) <<= 8;
-            LT_ASN1_DER_GET_NEXT_BYTE(ctx, &b);
-            *len |= b;
-        }
+    if (s->tag == LT_ASN1DER_OBJECT_IDENTIFIER) {
+        s->state = LT_ASN1DER_STATE_OID;
+    }
+    else if (s->sample_next && asn1der_sampled_kind(s->tag)) {
+#ifdef ASNDER_LOG_EN
+        LT_LOG_DEBUG("Sampling this object!");
+#endif
+        s->state = LT_ASN1DER_STATE_SAMPLE;
+    }
+    else {
+        s->state = LT_ASN1DER_STATE_CONTENTS;
+    }
+
+    if (!s->obj_len) {
+        asn1der_object_done(s);
     }
 
     return LT_OK;
 }
 
 /**
- * @brief Parse ASN1 object.
+ * @brief Processes one byte of the stream.
  *
- * @details Recursively parses the ASN1/DER stream and searches for Object with
- *          ctx->obj_id 3 byte identifier. If found, samples the follow-up item
- *          in the sequence that shall be of primitive type into ctx.
- *
- * @param   ctx     Parsing context
- * @returns LT_OK if successful, false otherwise
+ * @param s         Parser state
+ * @param b         Byte
+ * @returns LT_OK if sucessfully, error code otherwise
  */
-static lt_ret_t parse_object(struct parse_ctx_t *ctx)
+static lt_ret_t asn1der_stream_byte(struct lt_asn1der_stream_t *s, const uint8_t b)
 {
-    uint8_t b = 0;
-    uint16_t len = 0;
-    lt_ret_t rv = LT_OK;
-
-    LT_ASN1_DER_GET_NEXT_BYTE(ctx, &b);
-
-    rv = parse_length(ctx, &len);
-    if (rv != LT_OK) return rv;
-
-    uint16_t start = ctx->past;
-
-#ifdef ASNDER_LOG_EN
-    LT_LOG_DEBUG("parse_object:");
-    LT_LOG_DEBUG("    Start: %" PRIu16, start);
-    LT_LOG_DEBUG("    Object type: 0x%" PRIx8, b);
-    LT_LOG_DEBUG("    Object len: %" PRIu16, len);
-#endif
-
-    switch (b) {
-        case LT_ASN1DER_SEQUENCE:
-            while (ctx->past < start + len - 1) {
-                rv = parse_object(ctx);
-                if (rv != LT_OK) return rv;
+    if (s->past >= s->len) {
+        LT_ASN1_DER_PARSE_ERR(s, b, "Byte stream longer than %" PRIu16, s->len);
+        return LT_CERT_STORE_INVALID;
+    }
+    s->past++;
+
+    switch (s->state) {
+        case LT_ASN1DER_STATE_TAG:
+            s->tag = b;
+            s->state = LT_ASN1DER_STATE_LEN;
+            return LT_OK;
+
+        case LT_ASN1DER_STATE_LEN:
+            if (b < 0x80) {
+                s->obj_len = b;
+                return asn1der_header_done(s, b);
             }
-
-            if (start + len != ctx->past) {
-                LT_ASN1_DER_PARSE_ERR(ctx,
-                                      "Invalid Sequence length. "
-                                      "Sequence start: %" PRIu16
-                                      ". "
-                                      "Expected length: %" PRIu16
-                                      ". "
-                                      "Expected end: %" PRIu16
-                                      ". "
-                                      "Real end: %" PRIu16,
-                                      start, len, start + len - 1, ctx->past);
-                return LT_CERT_STORE_INVALID;
+            s->len_bytes = b ^ 0x80;
+            if ((s->len_bytes == 0) || (s->len_bytes > 2)) {
+                LT_ASN1_DER_PARSE_ERR(s, b, "Unsupported length: Indefinite or more than 2 bytes");
+                return LT_CERT_UNSUPPORTED;
             }
-            break;
-
-        case LT_ASN1DER_OBJECT_IDENTIFIER: {
-            if (len < 3) {
-#ifdef ASNDER_LOG_EN
-                LT_LOG_DEBUG("Length too short (< 3), skipping.");
-#endif  // ASNDER_LOG_EN
-                break;
+            s->obj_len = 0;
+            s->state = LT_ASN1DER_STATE_LEN_LONG;
+            return LT_OK;
+
+        case LT_ASN1DER_STATE_LEN_LONG:
+            s->obj_len = (uint16_t)((s->obj_len << 8) | b);
+            if (--s->len_bytes) {
+                return LT_OK;
             }
+            return asn1der_header_done(s, b);
 
-            uint8_t buf[len];
-            LT_ASN1_DER_GET_BYTES(ctx, buf, len);
+        case LT_ASN1DER_STATE_OID:
+            if (s->obj_pos < 3) {
+                s->oid = (s->oid << 8) | b;
+            }
+            break;
 
-            // We skip this step if the len is shorter than 3, so this is OK.
-            uint32_t obj_id = (((uint32_t)buf[0]) << 16) | (((uint32_t)buf[1]) << 8) | (((uint32_t)buf[2]));
+        case LT_ASN1DER_STATE_SAMPLE:
+            asn1der_sample_byte(s, b);
+            break;
 
-            if (ctx->obj_id == obj_id) {
-#ifdef ASNDER_LOG_EN
-                LT_LOG_DEBUG("Found searched object: 0x%" PRIx32 ". Next object will be sampled!", ctx->obj_id);
-#endif
-                ctx->sample_next = true;
-            }
+        default:
             break;
-        }
+    }
 
-        /* These object types can be searched for */
-        case LT_ASN1DER_BOOLEAN:
-        case LT_ASN1DER_INTEGER:
-        case LT_ASN1DER_STRING_BIT:
-        case LT_ASN1DER_STRING_OCTET:
-        case LT_ASN1DER_STRING_NULL:
-        case LT_ASN1DER_STRING_UTF8:
-        case LT_ASN1DER_STRING_PRINTABLE:
-        case LT_ASN1DER_UTC_TIME: {
-            if (ctx->sample_next & !ctx->found) {
-#ifdef ASNDER_LOG_EN
-                LT_LOG_DEBUG("Sampling this object!", ctx->obj_id);
-#endif
-                uint8_t sample_len = len;
+    if (++s->obj_pos == s->obj_len) {
+        asn1der_object_done(s);
+    }
 
-                if (ctx->sbuf_len < sample_len) {
-                    uint16_t n_crop_bytes = sample_len - ctx->sbuf_len;
-                    bool crop_prefix = ctx->crop_kind == LT_ASN1DER_CROP_PREFIX;
-                    ctx->cropped = true;
+    return LT_OK;
+}
 
-#ifdef ASNDER_LOG_EN
-                    LT_LOG_DEBUG("Sample buffer (%d) is smaller than size of the object to be sampled (%" PRIu8
-                                 "). "
-                                 "Cropping %" PRIu16 " bytes from %s of the searched object",
-                                 ctx->sbuf_len, sample_len, n_crop_bytes, crop_prefix ? "prefix" : "suffix");
-#endif
+/*******************************************************************************
+ * Public API
+ *******************************************************************************/
 
-                    if (crop_prefix) {
-                        LT_ASN1_DER_DROP_BYTES(ctx, n_crop_bytes)
-                    }
+void asn1der_stream_init(struct lt_asn1der_stream_t *s, uint16_t len, int32_t obj_id, uint8_t *buf, int buf_len,
+                         enum lt_asn1der_crop_kind_t crop_kind)
+{
+    memset(s, 0, sizeof(*s));
+    s->obj_id = obj_id;
+    s->sbuf = buf;
+    s->sbuf_len = buf_len;
+    s->crop_kind = crop_kind;
+    s->len = len;
+    s->state = LT_ASN1DER_STATE_TAG;
+}
 
-                    sample_len = ctx->sbuf_len;
-                    LT_ASN1_DER_GET_BYTES(ctx, ctx->sbuf, sample_len);
+lt_ret_t asn1der_stream_feed(struct lt_asn1der_stream_t *s, const uint8_t *data, uint16_t n)
+{
+    for (uint16_t i = 0; (i < n) && !s->found; i++) {
+        lt_ret_t rv = asn1der_stream_byte(s, data[i]);
+        if (rv != LT_OK) return rv;
+    }
 
-                    if (!crop_prefix) {
-                        LT_ASN1_DER_DROP_BYTES(ctx, n_crop_bytes)
-                    }
-                }
-                else {
-                    LT_ASN1_DER_GET_BYTES(ctx, ctx->sbuf, sample_len);
-                }
+    return LT_OK;
+}
 
-                ctx->sample_next = false;
-                ctx->found = true;
-            }
-            else {
-                LT_ASN1_DER_DROP_BYTES(ctx, len);
-            }
-            break;
-        }
+lt_ret_t asn1der_stream_finish(const struct lt_asn1der_stream_t *s)
+{
+    if (s->found) return LT_OK;
 
-        default:
-            LT_ASN1_DER_DROP_BYTES(ctx, len);
+    if ((s->state != LT_ASN1DER_STATE_TAG) || s->depth) {
+        LT_LOG_ERROR("ASN1 DER Parsing error: Incomplete byte stream. Past: %" PRIu16 ", len: %" PRIu16, s->past,
+                     s->len);
+        return LT_CERT_STORE_INVALID;
     }
 
-    return rv;
+    return LT_CERT_ITEM_NOT_FOUND;
 }
 
-/*******************************************************************************
- * Public API
- *******************************************************************************/
-
 lt_ret_t asn1der_find_object(const uint8_t *stream, uint16_t len, int32_t obj_id, uint8_t *buf, int buf_len,
                              enum lt_asn1der_crop_kind_t crop_kind)
 {
-    struct parse_ctx_t ctx = {.head = (uint8_t *)stream,
-                              .len = len,
-                              .past = 0,
-                              .obj_id = obj_id,
-                              .sbuf = buf,
-                              .sbuf_len = buf_len,
-                              .crop_kind = crop_kind,
-                              .sample_next = false,
-                              .found = false,
-                              .cropped = false};
-
-    while (ctx.past < ctx.len - 1) {
-        lt_ret_t rv = parse_object(&ctx);
-        if (rv != LT_OK) return rv;
-    };
+    struct lt_asn1der_stream_t s;
 
-    if (!ctx.found) return LT_CERT_ITEM_NOT_FOUND;
+    asn1der_stream_init(&s, len, obj_id, buf, buf_len, crop_kind);
 
-    return LT_OK;
+    lt_ret_t rv = asn1der_stream_feed(&s, stream, len);
+    if (rv != LT_OK) return rv;
+
+    return asn1der_stream_finish(&s);
 }
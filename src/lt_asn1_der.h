@@ -9,6 +9,9 @@
  * @license For the license see LICENSE.md in the root directory of this source tree.
  */
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "libtropic_common.h"
 
 #ifdef __cplusplus
@@ -55,6 +58,68 @@ typedef enum lt_asn1der_crop_kind_t { LT_ASN1DER_CROP_SUFFIX, LT_ASN1DER_CROP_PR
 lt_ret_t asn1der_find_object(const uint8_t *stream, uint16_t len, int32_t obj_id, uint8_t *buf, int buf_len,
                              enum lt_asn1der_crop_kind_t crop_kind) __attribute__((warn_unused_result));
 
+/** Max nesting of SEQUENCEs supported by the streaming parser. */
+#define LT_ASN1DER_MAX_DEPTH 8
+
+/**
+ * @brief State of the streaming parser, see asn1der_stream_init(). Contents are private.
+ */
+struct lt_asn1der_stream_t {
+    int32_t obj_id;                        /** Target OBJECT_IDENTIFIER (3-byte) to be searched */
+    uint8_t *sbuf;                         /** Buffer where to copy data after OBJECT_IDENTIFIER match */
+    int sbuf_len;                          /** Length of Buffer pointed to by sbuf */
+    enum lt_asn1der_crop_kind_t crop_kind; /** How to treat objects larger than provided buffer */
+    uint16_t len;                          /** Length of the whole byte stream */
+    uint16_t past;                         /** Number of processed bytes */
+    uint16_t ends[LT_ASN1DER_MAX_DEPTH];   /** End offsets of the SEQUENCEs being parsed */
+    uint8_t depth;                         /** Number of SEQUENCEs being parsed */
+    uint8_t state;                         /** Part of the object the next byte belongs to */
+    uint8_t tag;                           /** Tag of the current object */
+    uint8_t len_bytes;                     /** Length bytes of the current object still to be read */
+    uint16_t obj_len;                      /** Length of the current object contents */
+    uint16_t obj_pos;                      /** Number of processed bytes of the current object contents */
+    uint32_t oid;                          /** First 3 bytes of the current OBJECT_IDENTIFIER */
+    bool sample_next;                      /** Next primitive object is the one to be sampled */
+    bool found;                            /** Searched object was sampled */
+};
+
+/**
+ * @brief Starts single-pass parsing of ASN1 DER encoded stream, which is then passed in parts as it arrives by
+ *        asn1der_stream_feed(). Searches for the same object as asn1der_find_object() does.
+ *
+ * @param s             Parser state
+ * @param len           Length of the certificate in the byte-stream
+ * @param obj_id        3-byte OBJECT_IDENTIFIER to be searched for
+ * @param buf           Buffer where to copy the found object value
+ * @param buf_len       Size of the buffer pointed to by "buf"
+ * @param crop_kind     How to crop the found object if it is bigger than "buf", see asn1der_find_object()
+ */
+void asn1der_stream_init(struct lt_asn1der_stream_t *s, uint16_t len, int32_t obj_id, uint8_t *buf, int buf_len,
+                         enum lt_asn1der_crop_kind_t crop_kind);
+
+/**
+ * @brief Parses next part of the stream. Once the object is found (s->found), further data are ignored.
+ *
+ * @param s             Parser state
+ * @param data          Next part of the stream
+ * @param n             Length of the part
+ * @return lt_ret_t     LT_OK if the part was parsed
+ *                      LT_CERT_STORE_INVALID if the stream does not contain valid ASN1 syntax
+ *                      LT_CERT_UNSUPPORTED if the ASN1 stream contains features unsupported by this parser
+ */
+lt_ret_t asn1der_stream_feed(struct lt_asn1der_stream_t *s, const uint8_t *data, uint16_t n)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Finishes parsing of the stream.
+ *
+ * @param s             Parser state
+ * @return lt_ret_t     LT_OK if the object was found
+ *                      LT_CERT_STORE_INVALID if the stream ended inside of an object
+ *                      LT_CERT_ITEM_NOT_FOUND if OBJECT_IDENTIFIER with "obj_id" value was not found!
+ */
+lt_ret_t asn1der_stream_finish(const struct lt_asn1der_stream_t *s) __attribute__((warn_unused_result));
+
 #ifdef __cplusplus
 }
 #endif
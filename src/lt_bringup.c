@@ -0,0 +1,301 @@
+/**
+ * @file lt_bringup.c
+ * @brief Concurrent bring-up (initialization, STPUB read, Secure Channel Handshake) of several TROPIC01 devices
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_l3.h"
+#include "libtropic_macros.h"
+#include "lt_asn1_der.h"
+#include "lt_l2_api_structs.h"
+#include "lt_port_wrap.h"
+#include "lt_secure_memzero.h"
+
+#ifndef LT_L2_ASYNC
+#error "LT_BRINGUP requires LT_L2_ASYNC"
+#endif
+
+LT_STATIC_ASSERT(sizeof(struct lt_asn1der_stream_t) <= LT_BRINGUP_PARSER_SIZE)
+LT_STATIC_ASSERT((TR01_L2_GET_INFO_REQ_CERT_SIZE_TOTAL / TR01_GET_INFO_BLOCK_LEN) <= UINT8_MAX)
+
+static struct lt_asn1der_stream_t *lt_bringup_parser(lt_bringup_dev_t *dev)
+{
+    return (struct lt_asn1der_stream_t *)dev->parser;
+}
+
+/**
+ * @brief Finishes bring-up of the device and reports it. A device which fails after lt_init() is deinitialized, so
+ * the handle is left as it was added.
+ */
+static void lt_bringup_finish(lt_bringup_dev_t *dev, const lt_ret_t ret)
+{
+    lt_secure_memzero(&dev->eph_keys, sizeof(dev->eph_keys));
+    if ((ret != LT_OK) && (dev->state != LT_BRINGUP_STATE_INIT)) {
+        lt_ret_t ret_unused = lt_deinit(dev->h);
+        LT_UNUSED(ret_unused);
+    }
+
+    dev->ret = ret;
+    dev->state = (ret == LT_OK) ? LT_BRINGUP_STATE_READY : LT_BRINGUP_STATE_FAILED;
+    if (dev->cb) {
+        dev->cb(dev->h, ret, (ret == LT_OK) ? dev->stpub : NULL, dev->cb_ctx);
+    }
+}
+
+static void lt_bringup_done(lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx);
+
+/** Starts Get_Info of the next block of the certificate store, as lt_get_info_st_pub() reads it. */
+static lt_ret_t lt_bringup_request_block(lt_bringup_dev_t *dev)
+{
+    struct lt_l2_get_info_req_t *p_l2_req = (struct lt_l2_get_info_req_t *)dev->h->l2.buff;
+
+    p_l2_req->req_id = TR01_L2_GET_INFO_REQ_ID;
+    p_l2_req->req_len = TR01_L2_GET_INFO_REQ_LEN;
+    p_l2_req->object_id = TR01_L2_GET_INFO_REQ_OBJECT_ID_X509_CERTIFICATE;
+    p_l2_req->block_index = dev->block;
+
+    return lt_l2_async_send(dev->op, &dev->h->l2, lt_bringup_done, dev);
+}
+
+/** Passes the received block of the certificate store to the parser, more is set if the next block is needed. */
+static lt_ret_t lt_bringup_feed_block(lt_bringup_dev_t *dev, bool *more)
+{
+    const struct lt_l2_get_info_rsp_t *p_l2_resp = (const struct lt_l2_get_info_rsp_t *)dev->h->l2.buff;
+    struct lt_asn1der_stream_t *parser = lt_bringup_parser(dev);
+
+    if (TR01_GET_INFO_BLOCK_LEN != (p_l2_resp->rsp_len)) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    const uint8_t *head = p_l2_resp->object;
+    uint16_t available = TR01_GET_INFO_BLOCK_LEN;
+
+    // Header: version, number of certificates and their lengths, device certificate is the first one.
+    if (dev->block == 0) {
+        if ((head[0] != LT_CERT_STORE_VERSION) || (head[1] != LT_NUM_CERTIFICATES)) {
+            return LT_CERT_STORE_INVALID;
+        }
+        dev->cert_len = (uint16_t)((head[2] << 8) | head[3]);
+        head += 2 + 2 * LT_NUM_CERTIFICATES;
+        available -= 2 + 2 * LT_NUM_CERTIFICATES;
+        asn1der_stream_init(parser, dev->cert_len, LT_OBJ_ID_CURVEX25519, dev->stpub, TR01_STPUB_LEN,
+                            LT_ASN1DER_CROP_PREFIX);
+    }
+
+    uint16_t to_feed = lt_min(available, (uint16_t)(dev->cert_len - dev->fed));
+    lt_ret_t ret = asn1der_stream_feed(parser, head, to_feed);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    dev->fed += to_feed;
+    dev->block++;
+
+    *more = !parser->found && (dev->fed < dev->cert_len)
+            && (dev->block < (TR01_L2_GET_INFO_REQ_CERT_SIZE_TOTAL / TR01_GET_INFO_BLOCK_LEN));
+    if (*more) {
+        return LT_OK;
+    }
+
+    return asn1der_stream_finish(parser);
+}
+
+/** Sends Handshake_Req, keys of the session are derived once Handshake_Rsp arrives. */
+static lt_ret_t lt_bringup_start_handshake(lt_bringup_dev_t *dev)
+{
+    dev->state = LT_BRINGUP_STATE_HANDSHAKE;
+
+    lt_ret_t ret = lt_out__session_start(dev->h, dev->pkey_index, &dev->eph_keys);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_l2_async_send(dev->op, &dev->h->l2, lt_bringup_done, dev);
+}
+
+/** Completion of Get_Info or Handshake_Req of the device: starts the next step or finishes the bring-up. */
+static void lt_bringup_done(lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx)
+{
+    lt_bringup_dev_t *dev = (lt_bringup_dev_t *)cb_ctx;
+
+    LT_UNUSED(op);
+
+    dev->b->steps++;
+
+    if ((ret == LT_OK) && (dev->state == LT_BRINGUP_STATE_CERT)) {
+        bool more = false;
+        ret = lt_bringup_feed_block(dev, &more);
+        if (ret == LT_OK) {
+            ret = more ? lt_bringup_request_block(dev) : lt_bringup_start_handshake(dev);
+        }
+        if (ret == LT_OK) {
+            return;
+        }
+    }
+    else if (ret == LT_OK) {
+        // Other devices keep preparing their responses while the host derives the session keys.
+        ret = lt_in__session_start(dev->h, dev->stpub, dev->pkey_index, dev->shipriv, dev->shipub, &dev->eph_keys);
+    }
+
+    lt_bringup_finish(dev, ret);
+}
+
+lt_ret_t lt_bringup_init(lt_bringup_t *b)
+{
+    if (!b) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(b, 0, sizeof(*b));
+
+    return LT_OK;
+}
+
+lt_ret_t lt_bringup_add_device(lt_bringup_t *b, lt_handle_t *h, lt_l2_async_t *op, const lt_pkey_index_t pkey_index,
+                               const uint8_t *shipriv, const uint8_t *shipub, lt_bringup_cb_t cb, void *cb_ctx)
+{
+    if (!b || !h || !op || lt_l2_async_busy(op) || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv
+        || !shipub) {
+        return LT_PARAM_ERR;
+    }
+    if (b->dev_cnt == LT_BRINGUP_MAX_DEVICES) {
+        return LT_FAIL;
+    }
+
+    lt_bringup_dev_t *dev = &b->devs[b->dev_cnt++];
+    memset(dev, 0, sizeof(*dev));
+    dev->b = b;
+    dev->h = h;
+    dev->op = op;
+    dev->pkey_index = pkey_index;
+    dev->shipriv = shipriv;
+    dev->shipub = shipub;
+    dev->cb = cb;
+    dev->cb_ctx = cb_ctx;
+    dev->state = LT_BRINGUP_STATE_INIT;
+    dev->ret = LT_L1_CHIP_BUSY;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_bringup_process(lt_bringup_t *b)
+{
+    if (!b) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t i = 0; i < b->dev_cnt; i++) {
+        lt_bringup_dev_t *dev = &b->devs[i];
+        lt_ret_t ret;
+
+        switch (dev->state) {
+            case LT_BRINGUP_STATE_INIT:
+#ifdef LT_REBOOT_ASYNC
+                // Device which has to be rebooted does not hold up the others, its reboot is advanced by next calls.
+                if (dev->reboot.state == LT_REBOOT_ASYNC_IDLE) {
+                    b->steps++;
+                    ret = lt_init_async_start(&dev->reboot, dev->h, NULL, NULL);
+                    if (ret != LT_OK) {
+                        lt_bringup_finish(dev, ret);
+                        break;
+                    }
+                }
+                ret = lt_reboot_async_process(&dev->reboot);
+                if (ret == LT_L1_CHIP_BUSY) {
+                    break;
+                }
+                b->steps++;
+#else
+                b->steps++;
+                ret = lt_init(dev->h);
+#endif
+                if (ret != LT_OK) {
+                    lt_bringup_finish(dev, ret);
+                    break;
+                }
+                dev->state = LT_BRINGUP_STATE_CERT;
+                ret = lt_bringup_request_block(dev);
+                if (ret != LT_OK) {
+                    lt_bringup_finish(dev, ret);
+                }
+                break;
+
+            case LT_BRINGUP_STATE_CERT:
+            case LT_BRINGUP_STATE_HANDSHAKE:
+                // Next step is started by lt_bringup_done().
+                (void)lt_l2_async_process(dev->op);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_bringup_run(lt_bringup_t *b)
+{
+    if (!b) {
+        return LT_PARAM_ERR;
+    }
+
+    while (lt_bringup_pending(b)) {
+        uint16_t steps = b->steps;
+        lt_ret_t ret = lt_bringup_process(b);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        if (steps == b->steps) {
+            // No response was ready, give TROPIC01 time before the next attempt.
+            ret = lt_l1_delay(&b->devs[0].h->l2, 1);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+    }
+
+    return LT_OK;
+}
+
+uint8_t lt_bringup_pending(const lt_bringup_t *b)
+{
+    if (!b) {
+        return 0;
+    }
+
+    uint8_t pending = 0;
+    for (uint8_t i = 0; i < b->dev_cnt; i++) {
+        if ((b->devs[i].state != LT_BRINGUP_STATE_READY) && (b->devs[i].state != LT_BRINGUP_STATE_FAILED)) {
+            pending++;
+        }
+    }
+
+    return pending;
+}
+
+lt_bringup_state_t lt_bringup_state(const lt_bringup_t *b, const uint8_t idx)
+{
+    if (!b || (idx >= b->dev_cnt)) {
+        return LT_BRINGUP_STATE_FAILED;
+    }
+
+    return b->devs[idx].state;
+}
+
+lt_ret_t lt_bringup_result(const lt_bringup_t *b, const uint8_t idx)
+{
+    if (!b || (idx >= b->dev_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    return b->devs[idx].ret;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file lt_bulk_erase.c
+ * @brief Bulk erase definitions, selected R-mem, ECC and pairing key slots erased back-to-back in one Secure Session
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_ecc_inventory.h"
+#include "lt_pairing_pub_cache.h"
+#include "lt_r_mem_map.h"
+
+/** Slots are erased in order of positions: R-mem slots first, then ECC key slots, then pairing key slots. */
+#define LT_BULK_ERASE_POS_ECC (TR01_R_MEM_DATA_SLOT_MAX + 1)
+#define LT_BULK_ERASE_POS_PAIRING (LT_BULK_ERASE_POS_ECC + TR01_ECC_SLOT_31 + 1)
+#define LT_BULK_ERASE_POS_END (LT_BULK_ERASE_POS_PAIRING + TR01_PAIRING_KEY_SLOT_INDEX_3 + 1)
+
+LT_STATIC_ASSERT(TR01_ECC_SLOT_31 < 32)
+
+static lt_bulk_erase_kind_t lt_bulk_erase_kind(const uint16_t pos)
+{
+    if (pos < LT_BULK_ERASE_POS_ECC) {
+        return LT_BULK_ERASE_R_MEM;
+    }
+    return (pos < LT_BULK_ERASE_POS_PAIRING) ? LT_BULK_ERASE_ECC : LT_BULK_ERASE_PAIRING;
+}
+
+/** Slot at the position, within its kind. */
+static uint16_t lt_bulk_erase_slot(const uint16_t pos)
+{
+    switch (lt_bulk_erase_kind(pos)) {
+        case LT_BULK_ERASE_R_MEM:
+            return pos;
+        case LT_BULK_ERASE_ECC:
+            return pos - LT_BULK_ERASE_POS_ECC;
+        default:
+            return pos - LT_BULK_ERASE_POS_PAIRING;
+    }
+}
+
+static bool lt_bulk_erase_selected(const lt_bulk_erase_set_t *set, const uint16_t pos)
+{
+    const uint16_t slot = lt_bulk_erase_slot(pos);
+
+    switch (lt_bulk_erase_kind(pos)) {
+        case LT_BULK_ERASE_R_MEM:
+            return (set->r_mem[slot / 32] >> (slot % 32)) & 1;
+        case LT_BULK_ERASE_ECC:
+            return (set->ecc >> slot) & 1;
+        default:
+            return (set->pairing >> slot) & 1;
+    }
+}
+
+static void lt_bulk_erase_clear(lt_bulk_erase_set_t *set, const uint16_t pos)
+{
+    const uint16_t slot = lt_bulk_erase_slot(pos);
+
+    switch (lt_bulk_erase_kind(pos)) {
+        case LT_BULK_ERASE_R_MEM:
+            set->r_mem[slot / 32] &= ~(1UL << (slot % 32));
+            break;
+        case LT_BULK_ERASE_ECC:
+            set->ecc &= ~(1UL << slot);
+            break;
+        default:
+            set->pairing &= (uint8_t)~(1U << slot);
+            break;
+    }
+}
+
+/** Tells whether the slot is known to need no erase, by the host-side state kept up to date by lt_submit(). */
+static bool lt_bulk_erase_known_empty(lt_handle_t *h, const uint16_t pos)
+{
+    const lt_bulk_erase_kind_t kind = lt_bulk_erase_kind(pos);
+    const uint16_t slot = lt_bulk_erase_slot(pos);
+
+#ifdef LT_R_MEM_MAP
+    if (kind == LT_BULK_ERASE_R_MEM) {
+        return lt_r_mem_map_known_empty(h, slot);
+    }
+#endif
+#ifdef LT_ECC_INVENTORY
+    if (kind == LT_BULK_ERASE_ECC) {
+        return lt_ecc_inventory_known_empty(h, (lt_ecc_slot_t)slot);
+    }
+#endif
+#ifdef LT_PAIRING_PUB_CACHE
+    if (kind == LT_BULK_ERASE_PAIRING) {
+        return lt_pairing_pub_cache_known_invalid(h, (uint8_t)slot);
+    }
+#endif
+    LT_UNUSED(h);
+    LT_UNUSED(kind);
+    LT_UNUSED(slot);
+
+    return false;
+}
+
+/**
+ * @brief Finds the next selected slot which has to be erased, slots known to be empty are cleared from the set.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param set   Slots of the bulk erase
+ * @param pos   Position to start at
+ * @param done  Incremented by the number of skipped slots
+ * @return      Position of the slot, LT_BULK_ERASE_POS_END if there is none
+ */
+static uint16_t lt_bulk_erase_next(lt_handle_t *h, lt_bulk_erase_set_t *set, uint16_t pos, uint16_t *done)
+{
+    for (; pos < LT_BULK_ERASE_POS_END; pos++) {
+        if (!lt_bulk_erase_selected(set, pos)) {
+            continue;
+        }
+        if (!lt_bulk_erase_known_empty(h, pos)) {
+            break;
+        }
+        lt_bulk_erase_clear(set, pos);
+        set->skipped++;
+        (*done)++;
+    }
+
+    return pos;
+}
+
+/** Fills the erase command of the slot. */
+static void lt_bulk_erase_cmd(lt_cmd_t *cmd, const uint16_t pos)
+{
+    const uint16_t slot = lt_bulk_erase_slot(pos);
+
+    switch (lt_bulk_erase_kind(pos)) {
+        case LT_BULK_ERASE_R_MEM:
+            cmd->type = LT_CMD_R_MEM_DATA_ERASE;
+            cmd->args.r_mem_data_erase.udata_slot = slot;
+            break;
+        case LT_BULK_ERASE_ECC:
+            cmd->type = LT_CMD_ECC_KEY_ERASE;
+            cmd->args.ecc_key_erase.slot = (lt_ecc_slot_t)slot;
+            break;
+        default:
+            cmd->type = LT_CMD_PAIRING_KEY_INVALIDATE;
+            cmd->args.pairing_key_invalidate.slot = (uint8_t)slot;
+            break;
+    }
+}
+
+/**
+ * @brief Tells whether TROPIC01 executed the erase and refused it by its L3 Result, so the erase of the other slots
+ * goes on.
+ */
+static bool lt_bulk_erase_refused(const lt_ret_t ret)
+{
+    return (ret >= LT_L3_SLOT_NOT_EMPTY) && (ret <= LT_L3_HARDWARE_FAIL);
+}
+
+lt_ret_t lt_bulk_erase_add_r_mem(lt_bulk_erase_set_t *set, const uint16_t first, const uint16_t last)
+{
+    if (!set || (first > last) || (last > TR01_R_MEM_DATA_SLOT_MAX)) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint16_t slot = first; slot <= last; slot++) {
+        set->r_mem[slot / 32] |= 1UL << (slot % 32);
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_bulk_erase_add_ecc(lt_bulk_erase_set_t *set, const lt_ecc_slot_t first, const lt_ecc_slot_t last)
+{
+    if (!set || (first > last) || (last > TR01_ECC_SLOT_31)) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t slot = (uint8_t)first; slot <= (uint8_t)last; slot++) {
+        set->ecc |= 1UL << slot;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_bulk_erase_add_pairing(lt_bulk_erase_set_t *set, const uint8_t first, const uint8_t last)
+{
+    if (!set || (first > last) || (last > TR01_PAIRING_KEY_SLOT_INDEX_3)) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t slot = first; slot <= last; slot++) {
+        set->pairing |= (uint8_t)(1U << slot);
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_bulk_erase(lt_handle_t *h, lt_bulk_erase_set_t *set, lt_bulk_erase_progress_t progress, void *cb_ctx)
+{
+    if (!h || !set) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+    if (h->l3.submitted) {
+        return LT_FAIL;
+    }
+
+    uint16_t total = 0;
+    for (uint16_t pos = 0; pos < LT_BULK_ERASE_POS_END; pos++) {
+        total += lt_bulk_erase_selected(set, pos);
+    }
+
+    uint16_t done = 0;
+    uint16_t pos = lt_bulk_erase_next(h, set, 0, &done);
+    if (pos == LT_BULK_ERASE_POS_END) {
+        return LT_OK;
+    }
+
+    // Slot of the erase in flight is kept in pos, so the command is reused by the next erase once this one completes.
+    lt_cmd_t cmd;
+    lt_bulk_erase_cmd(&cmd, pos);
+    lt_ret_t ret = lt_submit(h, &cmd);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    set->sent++;
+
+    lt_ret_t first_err = LT_OK;
+    for (;;) {
+        lt_cmd_t *completed;
+        const lt_ret_t res = lt_complete(h, &completed);
+        const uint16_t res_pos = pos;
+
+        // The next erase is sent right away, TROPIC01 executes it while the result is handled below.
+        pos = LT_BULK_ERASE_POS_END;
+        ret = LT_OK;
+        if ((res == LT_OK) || lt_bulk_erase_refused(res)) {
+            pos = lt_bulk_erase_next(h, set, res_pos + 1, &done);
+        }
+        if (pos != LT_BULK_ERASE_POS_END) {
+            lt_bulk_erase_cmd(&cmd, pos);
+            ret = lt_submit(h, &cmd);
+            if (ret == LT_OK) {
+                set->sent++;
+            }
+        }
+
+        done++;
+        if (res == LT_OK) {
+            lt_bulk_erase_clear(set, res_pos);
+        }
+        else if (first_err == LT_OK) {
+            first_err = res;
+        }
+        if (progress) {
+            progress(cb_ctx, lt_bulk_erase_kind(res_pos), lt_bulk_erase_slot(res_pos), res, done, total);
+        }
+
+        if ((res != LT_OK) && !lt_bulk_erase_refused(res)) {
+            return res;
+        }
+        if (ret != LT_OK) {
+            return ret;
+        }
+        if (pos == LT_BULK_ERASE_POS_END) {
+            return first_err;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file lt_cert_cache.c
+ * @brief Certificate cache definitions, STPUB of a known TROPIC01 without reading its certificate store
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_crc16.h"
+
+// crc16() takes signed 16-bit length.
+LT_STATIC_ASSERT(sizeof(lt_cert_cache_t) - offsetof(lt_cert_cache_t, chip_id) <= INT16_MAX)
+
+/** CRC16 of the cached data, i.e. of everything following the crc field. */
+static uint16_t lt_cert_cache_crc(const lt_cert_cache_t *cache)
+{
+    return crc16((const uint8_t *)&cache->chip_id, (int16_t)(sizeof(*cache) - offsetof(lt_cert_cache_t, chip_id)));
+}
+
+/** Makes certificate store whose buffers are the certificates of the cache. */
+static void lt_cert_cache_store(lt_cert_cache_t *cache, struct lt_cert_store_t *store)
+{
+    for (int i = 0; i < LT_NUM_CERTIFICATES; i++) {
+        store->certs[i] = cache->certs[i];
+        store->buf_len[i] = sizeof(cache->certs[i]);
+        store->cert_len[i] = cache->cert_len[i];
+    }
+}
+
+lt_ret_t lt_cert_cache_fill(lt_handle_t *h, lt_cert_cache_t *cache)
+{
+    if (!h || !cache) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_cert_store_t store;
+    memset(cache, 0, sizeof(*cache));
+    lt_cert_cache_store(cache, &store);
+
+    lt_ret_t ret = lt_get_info_chip_id(h, &cache->chip_id);
+    if (ret == LT_OK) {
+        ret = lt_get_info_cert_store(h, &store);
+    }
+    if (ret == LT_OK) {
+        ret = lt_get_st_pub(&store, cache->stpub);
+    }
+    if (ret != LT_OK) {
+        memset(cache, 0, sizeof(*cache));
+        return ret;
+    }
+
+    memcpy(cache->cert_len, store.cert_len, sizeof(cache->cert_len));
+    cache->magic = LT_CERT_CACHE_MAGIC;
+    cache->version = LT_CERT_CACHE_VERSION;
+    cache->crc = lt_cert_cache_crc(cache);
+
+    return LT_OK;
+}
+
+bool lt_cert_cache_valid(const lt_cert_cache_t *cache)
+{
+    if (!cache || (cache->magic != LT_CERT_CACHE_MAGIC) || (cache->version != LT_CERT_CACHE_VERSION)) {
+        return false;
+    }
+
+    return cache->crc == lt_cert_cache_crc(cache);
+}
+
+lt_ret_t lt_cert_cache_get_store(lt_cert_cache_t *cache, struct lt_cert_store_t *store)
+{
+    if (!store || !lt_cert_cache_valid(cache)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_cert_cache_store(cache, store);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_verify_chip_and_start_secure_session_cached(lt_handle_t *h, lt_cert_cache_t *cache,
+                                                        const uint8_t *shipriv, const uint8_t *shipub,
+                                                        const lt_pkey_index_t pkey_index, bool *refreshed)
+{
+    if (!h || !cache || !shipriv || !shipub || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !refreshed) {
+        return LT_PARAM_ERR;
+    }
+
+    *refreshed = false;
+
+    // CHIP_ID is a single Get_Info, the certificate store takes dozens of them.
+    struct lt_chip_id_t chip_id;
+    lt_ret_t ret = lt_get_info_chip_id(h, &chip_id);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (lt_cert_cache_valid(cache) && !memcmp(&chip_id, &cache->chip_id, sizeof(chip_id))) {
+        ret = lt_session_start(h, cache->stpub, pkey_index, shipriv, shipub);
+        if (ret != LT_L2_HSK_ERR) {
+            return ret;
+        }
+        // Cached STPUB may be stale, e.g. the cache was restored from another device's backup.
+    }
+
+    ret = lt_cert_cache_fill(h, cache);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    *refreshed = true;
+
+    return lt_session_start(h, cache->stpub, pkey_index, shipriv, shipub);
+}
@@ -0,0 +1,399 @@
+/**
+ * @file lt_cert_chain.c
+ * @brief Host-side verification of the certificate chain with memoized CA certificates
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "lt_asn1_der.h"
+#include "lt_sha256.h"
+
+LT_STATIC_ASSERT(LT_CERT_CHAIN_HASH_LEN == LT_SHA256_DIGEST_LENGTH)
+
+/** Context specific constructed tag [0] of the TBSCertificate version. */
+#define LT_CERT_CHAIN_TAG_VERSION 0xA0
+
+/** Contents of OBJECT IDENTIFIERs of the supported algorithms. */
+static const uint8_t oid_ecdsa_sha256[] = {0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02};
+static const uint8_t oid_ecdsa_sha384[] = {0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x03};
+static const uint8_t oid_ecdsa_sha512[] = {0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x04};
+static const uint8_t oid_ed25519[] = {0x2B, 0x65, 0x70};
+static const uint8_t oid_ec_public_key[] = {0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x02, 0x01};
+
+/** DER element: its encoding as a whole and its contents. */
+struct lt_der_elem_t {
+    const uint8_t *raw;
+    uint16_t raw_len;
+    const uint8_t *val;
+    uint16_t val_len;
+};
+
+/** Parts of a certificate needed to verify it and the certificates it issued. */
+struct lt_cert_parts_t {
+    struct lt_der_elem_t tbs;
+    struct lt_der_elem_t issuer;
+    struct lt_der_elem_t subject;
+    /** Signature algorithm (AlgorithmIdentifier of the certificate). */
+    struct lt_der_elem_t sig_alg;
+    /** Signature, BIT STRING without the unused bits byte. */
+    struct lt_der_elem_t sig;
+    /** Algorithm OID of the subject public key. */
+    struct lt_der_elem_t key_alg;
+    /** Named curve OID of the subject public key, zero length if absent. */
+    struct lt_der_elem_t key_curve;
+    /** Subject public key, BIT STRING without the unused bits byte. */
+    struct lt_der_elem_t key;
+};
+
+/**
+ * @brief Reads one DER element of the expected tag and advances the position past it.
+ *
+ * @param pos         Position in the buffer, advanced past the element
+ * @param end         End of the enclosing element
+ * @param tag         Expected tag
+ * @param elem        Parsed element
+ * @return            LT_OK if successful, LT_CERT_STORE_INVALID otherwise
+ */
+static lt_ret_t lt_der_next(const uint8_t **pos, const uint8_t *end, const uint8_t tag, struct lt_der_elem_t *elem)
+{
+    const uint8_t *p = *pos;
+
+    if ((end - p < 2) || (p[0] != tag)) {
+        return LT_CERT_STORE_INVALID;
+    }
+
+    size_t len = p[1];
+    p += 2;
+    if (len & 0x80) {
+        size_t len_bytes = len & 0x7F;
+        if ((len_bytes == 0) || (len_bytes > 2) || ((size_t)(end - p) < len_bytes)) {
+            return LT_CERT_STORE_INVALID;
+        }
+        len = 0;
+        for (size_t i = 0; i < len_bytes; i++) {
+            len = (len << 8) | *p++;
+        }
+    }
+    if ((size_t)(end - p) < len) {
+        return LT_CERT_STORE_INVALID;
+    }
+
+    elem->raw = *pos;
+    elem->raw_len = (uint16_t)(p + len - *pos);
+    elem->val = p;
+    elem->val_len = (uint16_t)len;
+    *pos = p + len;
+
+    return LT_OK;
+}
+
+/**
+ * @brief Strips the unused bits byte of a BIT STRING holding whole bytes.
+ *
+ * @param elem        BIT STRING, its contents are replaced by the bytes
+ * @return            LT_OK if successful, LT_CERT_UNSUPPORTED otherwise
+ */
+static lt_ret_t lt_der_bit_string_bytes(struct lt_der_elem_t *elem)
+{
+    if ((elem->val_len < 1) || (elem->val[0] != 0)) {
+        return LT_CERT_UNSUPPORTED;
+    }
+    elem->val++;
+    elem->val_len--;
+
+    return LT_OK;
+}
+
+/**
+ * @brief Splits certificate into the parts needed for chain verification.
+ *
+ * @param cert        DER encoded certificate
+ * @param len         Length of the certificate
+ * @param parts       Parsed parts
+ * @return            LT_OK if successful, error code otherwise
+ */
+static lt_ret_t lt_cert_parse(const uint8_t *cert, const uint16_t len, struct lt_cert_parts_t *parts)
+{
+    struct lt_der_elem_t cert_seq, elem, tbs_sig_alg, spki, key_alg_id;
+    const uint8_t *pos = cert;
+    lt_ret_t ret;
+
+    memset(parts, 0, sizeof(*parts));
+
+    // Certificate ::= SEQUENCE { tbsCertificate, signatureAlgorithm, signatureValue }
+    ret = lt_der_next(&pos, cert + len, LT_ASN1DER_SEQUENCE, &cert_seq);
+    if (ret != LT_OK) return ret;
+    const uint8_t *cert_end = cert_seq.val + cert_seq.val_len;
+    pos = cert_seq.val;
+    ret = lt_der_next(&pos, cert_end, LT_ASN1DER_SEQUENCE, &parts->tbs);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_next(&pos, cert_end, LT_ASN1DER_SEQUENCE, &parts->sig_alg);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_next(&pos, cert_end, LT_ASN1DER_STRING_BIT, &parts->sig);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_bit_string_bytes(&parts->sig);
+    if (ret != LT_OK) return ret;
+
+    // TBSCertificate ::= SEQUENCE { [0] version, serialNumber, signature, issuer, validity, subject, SPKI, ... }
+    const uint8_t *tbs_end = parts->tbs.val + parts->tbs.val_len;
+    pos = parts->tbs.val;
+    if ((pos < tbs_end) && (*pos == LT_CERT_CHAIN_TAG_VERSION)) {
+        ret = lt_der_next(&pos, tbs_end, LT_CERT_CHAIN_TAG_VERSION, &elem);
+        if (ret != LT_OK) return ret;
+    }
+    ret = lt_der_next(&pos, tbs_end, LT_ASN1DER_INTEGER, &elem);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_next(&pos, tbs_end, LT_ASN1DER_SEQUENCE, &tbs_sig_alg);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_next(&pos, tbs_end, LT_ASN1DER_SEQUENCE, &parts->issuer);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_next(&pos, tbs_end, LT_ASN1DER_SEQUENCE, &elem);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_next(&pos, tbs_end, LT_ASN1DER_SEQUENCE, &parts->subject);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_next(&pos, tbs_end, LT_ASN1DER_SEQUENCE, &spki);
+    if (ret != LT_OK) return ret;
+
+    // Signature algorithm is stated twice, the signed one must match the outer one.
+    if ((tbs_sig_alg.raw_len != parts->sig_alg.raw_len)
+        || memcmp(tbs_sig_alg.raw, parts->sig_alg.raw, tbs_sig_alg.raw_len)) {
+        return LT_CERT_STORE_INVALID;
+    }
+
+    // SubjectPublicKeyInfo ::= SEQUENCE { algorithm SEQUENCE { OID, curve OID OPTIONAL }, subjectPublicKey }
+    const uint8_t *spki_end = spki.val + spki.val_len;
+    pos = spki.val;
+    ret = lt_der_next(&pos, spki_end, LT_ASN1DER_SEQUENCE, &key_alg_id);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_next(&pos, spki_end, LT_ASN1DER_STRING_BIT, &parts->key);
+    if (ret != LT_OK) return ret;
+    ret = lt_der_bit_string_bytes(&parts->key);
+    if (ret != LT_OK) return ret;
+
+    const uint8_t *key_alg_end = key_alg_id.val + key_alg_id.val_len;
+    pos = key_alg_id.val;
+    ret = lt_der_next(&pos, key_alg_end, LT_ASN1DER_OBJECT_IDENTIFIER, &parts->key_alg);
+    if (ret != LT_OK) return ret;
+    if ((pos < key_alg_end) && (*pos == LT_ASN1DER_OBJECT_IDENTIFIER)) {
+        ret = lt_der_next(&pos, key_alg_end, LT_ASN1DER_OBJECT_IDENTIFIER, &parts->key_curve);
+        if (ret != LT_OK) return ret;
+    }
+
+    return LT_OK;
+}
+
+/** Tells whether the contents of the OBJECT IDENTIFIER element equal the given OID. */
+static bool lt_der_oid_eq(const struct lt_der_elem_t *oid, const uint8_t *expected, const size_t expected_len)
+{
+    return (oid->val_len == expected_len) && !memcmp(oid->val, expected, expected_len);
+}
+
+/**
+ * @brief Verifies the certificate by the public key of its issuer.
+ *
+ * @param chain       Chain verifier
+ * @param cert        Verified certificate
+ * @param issuer      Certificate of the issuer
+ * @param verify      Verifies the signature
+ * @param verify_ctx  User data of `verify`
+ * @return            LT_OK if the certificate is valid, error code otherwise
+ */
+static lt_ret_t lt_cert_chain_verify_one(lt_cert_chain_t *chain, const struct lt_cert_parts_t *cert,
+                                         const struct lt_cert_parts_t *issuer, lt_cert_sig_verify_fn_t verify,
+                                         void *verify_ctx)
+{
+    if ((cert->issuer.raw_len != issuer->subject.raw_len)
+        || memcmp(cert->issuer.raw, issuer->subject.raw, cert->issuer.raw_len)) {
+        LT_LOG_ERROR("Certificate chain: issuer does not match the subject of the next certificate");
+        return LT_CERT_CHAIN_INVALID;
+    }
+
+    struct lt_der_elem_t alg_oid;
+    const uint8_t *pos = cert->sig_alg.val;
+    lt_ret_t ret = lt_der_next(&pos, cert->sig_alg.val + cert->sig_alg.val_len, LT_ASN1DER_OBJECT_IDENTIFIER, &alg_oid);
+    if (ret != LT_OK) return ret;
+
+    lt_cert_sig_t sig = {.tbs = cert->tbs.raw,
+                         .tbs_len = cert->tbs.raw_len,
+                         .sig = cert->sig.val,
+                         .sig_len = cert->sig.val_len,
+                         .pubkey = issuer->key.val,
+                         .pubkey_len = issuer->key.val_len};
+
+    bool ecdsa_key = lt_der_oid_eq(&issuer->key_alg, oid_ec_public_key, sizeof(oid_ec_public_key));
+    if (lt_der_oid_eq(&alg_oid, oid_ecdsa_sha256, sizeof(oid_ecdsa_sha256))) {
+        sig.alg = LT_CERT_SIG_ECDSA_SHA256;
+    }
+    else if (lt_der_oid_eq(&alg_oid, oid_ecdsa_sha384, sizeof(oid_ecdsa_sha384))) {
+        sig.alg = LT_CERT_SIG_ECDSA_SHA384;
+    }
+    else if (lt_der_oid_eq(&alg_oid, oid_ecdsa_sha512, sizeof(oid_ecdsa_sha512))) {
+        sig.alg = LT_CERT_SIG_ECDSA_SHA512;
+    }
+    else if (lt_der_oid_eq(&alg_oid, oid_ed25519, sizeof(oid_ed25519))) {
+        sig.alg = LT_CERT_SIG_ED25519;
+    }
+    else {
+        LT_LOG_ERROR("Certificate chain: unsupported signature algorithm");
+        return LT_CERT_UNSUPPORTED;
+    }
+
+    if (sig.alg == LT_CERT_SIG_ED25519) {
+        if (!lt_der_oid_eq(&issuer->key_alg, oid_ed25519, sizeof(oid_ed25519))) {
+            return LT_CERT_CHAIN_INVALID;
+        }
+    }
+    else {
+        if (!ecdsa_key || !issuer->key_curve.val_len) {
+            return LT_CERT_CHAIN_INVALID;
+        }
+        sig.curve_oid = issuer->key_curve.val;
+        sig.curve_oid_len = issuer->key_curve.val_len;
+    }
+
+    chain->sig_verifies++;
+    if (verify(&sig, verify_ctx) != LT_OK) {
+        LT_LOG_ERROR("Certificate chain: signature is not valid");
+        return LT_CERT_CHAIN_INVALID;
+    }
+
+    return LT_OK;
+}
+
+/** Tells whether the CA certificate of this hash was verified before. */
+static bool lt_cert_chain_memo_find(const lt_cert_chain_t *chain, const uint8_t *hash)
+{
+    for (uint8_t i = 0; i < chain->memo_cnt; i++) {
+        if (!memcmp(chain->memo[i], hash, LT_CERT_CHAIN_HASH_LEN)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Memoizes verified CA certificate, replacing the oldest entry when the memo is full. */
+static void lt_cert_chain_memo_add(lt_cert_chain_t *chain, const uint8_t *hash)
+{
+    memcpy(chain->memo[chain->memo_next], hash, LT_CERT_CHAIN_HASH_LEN);
+    chain->memo_next = (uint8_t)((chain->memo_next + 1) % LT_CERT_CHAIN_MEMO_SIZE);
+    if (chain->memo_cnt < LT_CERT_CHAIN_MEMO_SIZE) {
+        chain->memo_cnt++;
+    }
+}
+
+/** SHA-256 of the certificate. */
+static lt_ret_t lt_cert_chain_hash(void *crypto_ctx, const uint8_t *cert, const uint16_t len, uint8_t *hash)
+{
+    lt_ret_t ret = lt_sha256_start(crypto_ctx);
+    if (ret != LT_OK) return ret;
+    ret = lt_sha256_update(crypto_ctx, cert, len);
+    if (ret != LT_OK) return ret;
+
+    return lt_sha256_finish(crypto_ctx, hash);
+}
+
+/**
+ * @brief Verifies the chain with the crypto context initialized for SHA-256.
+ */
+static lt_ret_t lt_cert_chain_verify_sha256(void *crypto_ctx, lt_cert_chain_t *chain,
+                                            const struct lt_cert_store_t *store, lt_cert_sig_verify_fn_t verify,
+                                            void *verify_ctx)
+{
+    struct lt_cert_parts_t cert, issuer;
+    uint8_t hash[LT_CERT_CHAIN_HASH_LEN];
+
+    lt_ret_t ret = lt_cert_chain_hash(crypto_ctx, store->certs[LT_CERT_KIND_TROPIC_ROOT],
+                                      store->cert_len[LT_CERT_KIND_TROPIC_ROOT], hash);
+    if (ret != LT_OK) return ret;
+    if (memcmp(hash, chain->root_hash, sizeof(hash))) {
+        LT_LOG_ERROR("Certificate chain: root certificate is not trusted");
+        return LT_CERT_CHAIN_INVALID;
+    }
+
+    // From the root down, so only certificates of a verified issuer are memoized.
+    ret = lt_cert_parse(store->certs[LT_CERT_KIND_TROPIC_ROOT], store->cert_len[LT_CERT_KIND_TROPIC_ROOT], &issuer);
+    if (ret != LT_OK) return ret;
+
+    for (int i = LT_CERT_KIND_TROPIC_ROOT - 1; i >= LT_CERT_KIND_DEVICE; i--) {
+        ret = lt_cert_parse(store->certs[i], store->cert_len[i], &cert);
+        if (ret != LT_OK) return ret;
+
+        if (i != LT_CERT_KIND_DEVICE) {
+            ret = lt_cert_chain_hash(crypto_ctx, store->certs[i], store->cert_len[i], hash);
+            if (ret != LT_OK) return ret;
+        }
+
+        if ((i != LT_CERT_KIND_DEVICE) && lt_cert_chain_memo_find(chain, hash)) {
+            chain->memo_hits++;
+        }
+        else {
+            ret = lt_cert_chain_verify_one(chain, &cert, &issuer, verify, verify_ctx);
+            if (ret != LT_OK) return ret;
+            if (i != LT_CERT_KIND_DEVICE) {
+                lt_cert_chain_memo_add(chain, hash);
+            }
+        }
+
+        issuer = cert;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_cert_chain_init(lt_cert_chain_t *chain, const uint8_t *root_hash)
+{
+    if (!chain || !root_hash) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(chain, 0, sizeof(*chain));
+    memcpy(chain->root_hash, root_hash, sizeof(chain->root_hash));
+
+    return LT_OK;
+}
+
+lt_ret_t lt_cert_chain_verify(lt_handle_t *h, lt_cert_chain_t *chain, const struct lt_cert_store_t *store,
+                              lt_cert_sig_verify_fn_t verify, void *verify_ctx)
+{
+    if (!h || !chain || !store || !verify) {
+        return LT_PARAM_ERR;
+    }
+    for (int i = 0; i < LT_NUM_CERTIFICATES; i++) {
+        if (!store->certs[i] || !store->cert_len[i] || (store->cert_len[i] > store->buf_len[i])) {
+            return LT_PARAM_ERR;
+        }
+    }
+
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_cert_chain_verify_sha256(h->l3.crypto_ctx, chain, store, verify, verify_ctx);
+    lt_ret_t ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
+    LT_UNUSED(ret_unused);
+
+    return ret;
+}
+
+lt_ret_t lt_cert_chain_memo_clear(lt_cert_chain_t *chain)
+{
+    if (!chain) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(chain->memo, 0, sizeof(chain->memo));
+    chain->memo_cnt = 0;
+    chain->memo_next = 0;
+
+    return LT_OK;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file lt_cpu_log.c
+ * @brief CPU log, lock-free ring buffer of log messages of TROPIC01's RISC-V FW drained in idle time
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_cpu_log.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "libtropic_port.h"
+
+/** Smallest ring buffer, the longest message has to fit while the previous one is still unread. */
+#define LT_CPU_LOG_SIZE_MIN 512
+
+/** Number of bytes printed by one call of lt_port_log(). */
+#define LT_CPU_LOG_PRINT_CHUNK 64
+
+LT_STATIC_ASSERT(LT_CPU_LOG_SIZE_MIN >= 2 * TR01_GET_LOG_MAX_MSG_LEN)
+
+/** Number of bytes the writer may store. */
+static uint32_t lt_cpu_log_space(const lt_cpu_log_t *log)
+{
+    return log->size - (log->head - __atomic_load_n(&log->tail, __ATOMIC_ACQUIRE));
+}
+
+lt_ret_t lt_cpu_log_init(lt_cpu_log_t *log, uint8_t *buff, const uint32_t size)
+{
+    if (!log || !buff || (size < LT_CPU_LOG_SIZE_MIN) || (size & (size - 1))) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(log, 0, sizeof(lt_cpu_log_t));
+    log->buff = buff;
+    log->size = size;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_cpu_log_attach(lt_handle_t *h, lt_cpu_log_t *log)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l2.cpu_log = log;
+
+    return LT_OK;
+}
+
+bool lt_cpu_log_push(lt_cpu_log_t *log, const uint8_t *msg, const uint32_t len)
+{
+    if (len > lt_cpu_log_space(log)) {
+        __atomic_store_n(&log->dropped, log->dropped + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    uint32_t head = log->head;
+    uint32_t pos = head & (log->size - 1);
+    uint32_t first = log->size - pos;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(log->buff + pos, msg, first);
+    memcpy(log->buff, msg + first, len - first);
+
+    __atomic_store_n(&log->head, head + len, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+lt_ret_t lt_cpu_log_drain_step(lt_handle_t *h, void *ctx, bool *done)
+{
+    lt_cpu_log_t *log = (lt_cpu_log_t *)ctx;
+
+    if (!h || !log || !log->buff || !done) {
+        return LT_PARAM_ERR;
+    }
+
+    // The reader has to make space first, messages left in TROPIC01 are drained by a later job.
+    if (lt_cpu_log_space(log) < TR01_GET_LOG_MAX_MSG_LEN) {
+        *done = true;
+        return LT_OK;
+    }
+
+    uint8_t msg[TR01_GET_LOG_MAX_MSG_LEN];
+    uint16_t len = 0;
+    lt_ret_t ret = lt_get_log_req(h, msg, sizeof(msg), &len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (len) {
+        // Fits, the space was checked above and Libtropic is the only writer.
+        bool stored = lt_cpu_log_push(log, msg, len);
+        LT_UNUSED(stored);
+    }
+    *done = (len == 0);
+
+    return LT_OK;
+}
+
+uint32_t lt_cpu_log_read(lt_cpu_log_t *log, uint8_t *out, const uint32_t max_len)
+{
+    if (!log || !out) {
+        return 0;
+    }
+
+    // Only the reader writes tail, data up to head were published by lt_cpu_log_push().
+    uint32_t tail = log->tail;
+    uint32_t len = __atomic_load_n(&log->head, __ATOMIC_ACQUIRE) - tail;
+    if (len > max_len) {
+        len = max_len;
+    }
+
+    uint32_t pos = tail & (log->size - 1);
+    uint32_t first = log->size - pos;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(out, log->buff + pos, first);
+    memcpy(out + first, log->buff, len - first);
+
+    // Space is given back to the writer only after the data were copied out.
+    __atomic_store_n(&log->tail, tail + len, __ATOMIC_RELEASE);
+
+    return len;
+}
+
+uint32_t lt_cpu_log_print(lt_cpu_log_t *log, const uint32_t max_len)
+{
+    if (!log) {
+        return 0;
+    }
+
+    uint32_t printed = 0;
+    while (printed < max_len) {
+        char chunk[LT_CPU_LOG_PRINT_CHUNK];
+        uint32_t len = max_len - printed;
+        len = lt_cpu_log_read(log, (uint8_t *)chunk, (len < sizeof(chunk)) ? len : sizeof(chunk));
+        if (len == 0) {
+            break;
+        }
+        lt_port_log("%.*s", (int)len, chunk);
+        printed += len;
+    }
+
+    return printed;
+}
+
+uint32_t lt_cpu_log_dropped(const lt_cpu_log_t *log)
+{
+    if (!log) {
+        return 0;
+    }
+
+    return __atomic_load_n(&log->dropped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,37 @@
+#ifndef LT_CPU_LOG_H
+#define LT_CPU_LOG_H
+
+/**
+ * @file lt_cpu_log.h
+ * @brief CPU log declarations (used internally), see lt_cpu_log_init()
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_CPU_LOG_DRAIN
+/**
+ * @brief Stores the message into the CPU log, the message is dropped if it does not fit.
+ *
+ * @param log   CPU log
+ * @param msg   Message
+ * @param len   Length of msg
+ * @return      true if the message was stored, false if it was dropped
+ */
+bool lt_cpu_log_push(lt_cpu_log_t *log, const uint8_t *msg, const uint32_t len);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_CPU_LOG_H
@@ -15,6 +15,9 @@
 extern "C" {
 #endif
 
+/** Used to initialize the crc value, see crc16_update() */
+#define LT_CRC16_INITIAL_VAL 0x0000
+
 /**
  * @brief Calculates CRC16 checksum on a buffer
  *
@@ -24,6 +27,37 @@ extern "C" {
  */
 uint16_t crc16(const uint8_t *buf, int16_t size) __attribute__((warn_unused_result));
 
+/**
+ * @brief Continues CRC16 calculation over next part of the data, so CRC of data scattered over several buffers can
+ * be calculated without copying them together.
+ *
+ * @param crc       CRC of the preceding data as returned by this function, LT_CRC16_INITIAL_VAL for the first part
+ * @param data      Next part of the data
+ * @param len       Length of the next part
+ * @return          Intermediate CRC16, pass it to crc16_final() to get the same value as crc16() returns
+ */
+uint16_t crc16_update(uint16_t crc, const uint8_t *data, uint16_t len) __attribute__((warn_unused_result));
+
+/**
+ * @brief Copies next part of the data and continues CRC16 calculation over it in the same pass, see crc16_update().
+ *
+ * @param crc       CRC of the preceding data, LT_CRC16_INITIAL_VAL for the first part
+ * @param dst       Destination of the copy, must not overlap with src
+ * @param src       Next part of the data
+ * @param len       Length of the next part
+ * @return          Intermediate CRC16, the same value as crc16_update() returns for src
+ */
+uint16_t crc16_copy_update(uint16_t crc, uint8_t *dst, const uint8_t *src, uint16_t len)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Finishes CRC16 calculation started by crc16_update()
+ *
+ * @param crc       Intermediate CRC16 returned by crc16_update()
+ * @return          CRC16 checksum in the same form as returned by crc16()
+ */
+uint16_t crc16_final(uint16_t crc) __attribute__((warn_unused_result));
+
 /**
  * @brief Takes pointer to filled l2 buffer and adds checksum
  *
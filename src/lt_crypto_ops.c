@@ -0,0 +1,522 @@
+/**
+ * @file lt_crypto_ops.c
+ * @brief CAL functions dispatched to the CAL selected at runtime (LT_CRYPTO_OPS) and the probe selecting it
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port.h"
+#include "lt_aesgcm.h"
+#include "lt_crypto_common.h"
+#include "lt_hmac_sha256.h"
+#include "lt_sha256.h"
+#include "lt_x25519.h"
+
+/** Rounds of the probe workload, the fastest one is taken. */
+#define LT_CRYPTO_OPS_PROBE_ROUNDS 3
+/** L3 Commands encrypted and L3 Results decrypted by one round of the probe workload. */
+#define LT_CRYPTO_OPS_PROBE_CMDS 4
+/** Length of the data of one L3 Command of the probe workload. */
+#define LT_CRYPTO_OPS_PROBE_DATA_LEN 128
+
+/** CAL serving the functions which take no context in the whole process, selected once and never changed. */
+static const lt_crypto_ops_t *lt_crypto_ops_global = NULL;
+
+/** Returns the process-wide CAL, NULL if none is selected yet. */
+static const lt_crypto_ops_t *lt_crypto_ops_of_global(void)
+{
+    return __atomic_load_n(&lt_crypto_ops_global, __ATOMIC_ACQUIRE);
+}
+
+/** Context of the selected CAL. */
+#define LT_CRYPTO_OPS_CTX(ctx) (((lt_crypto_ops_ctx_t *)(ctx))->ctx)
+
+/** Returns the functions of the CAL selected for the crypto context, NULL if there are none. */
+static const lt_crypto_ops_t *lt_crypto_ops_of(const void *ctx)
+{
+    return ctx ? ((const lt_crypto_ops_ctx_t *)ctx)->ops : NULL;
+}
+
+lt_ret_t lt_crypto_ctx_init(void *ctx)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->crypto_ctx_init(LT_CRYPTO_OPS_CTX(ctx)) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_crypto_ctx_deinit(void *ctx)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->crypto_ctx_deinit(LT_CRYPTO_OPS_CTX(ctx)) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_encrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_encrypt_init(LT_CRYPTO_OPS_CTX(ctx), key, key_len) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_decrypt_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_decrypt_init(LT_CRYPTO_OPS_CTX(ctx), key, key_len) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_encrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                           const uint32_t add_len, const uint8_t *plaintext, const uint32_t plaintext_len,
+                           uint8_t *ciphertext, const uint32_t ciphertext_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_encrypt(LT_CRYPTO_OPS_CTX(ctx), iv, iv_len, add, add_len, plaintext, plaintext_len,
+                                     ciphertext, ciphertext_len)
+               : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_decrypt(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                           const uint32_t add_len, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                           uint8_t *plaintext, const uint32_t plaintext_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_decrypt(LT_CRYPTO_OPS_CTX(ctx), iv, iv_len, add, add_len, ciphertext, ciphertext_len,
+                                     plaintext, plaintext_len)
+               : LT_PARAM_ERR;
+}
+
+#ifdef LT_L3_STREAM_ENCRYPT
+lt_ret_t lt_aesgcm_encrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_encrypt_start(LT_CRYPTO_OPS_CTX(ctx), iv, iv_len, add, add_len) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_encrypt_update(void *ctx, const uint8_t *plaintext, const uint32_t plaintext_len,
+                                  uint8_t *ciphertext)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_encrypt_update(LT_CRYPTO_OPS_CTX(ctx), plaintext, plaintext_len, ciphertext)
+               : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_encrypt_finish(void *ctx, uint8_t *tag, const uint32_t tag_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_encrypt_finish(LT_CRYPTO_OPS_CTX(ctx), tag, tag_len) : LT_PARAM_ERR;
+}
+#endif
+
+#ifdef LT_L3_STREAM_DECRYPT
+lt_ret_t lt_aesgcm_decrypt_start(void *ctx, const uint8_t *iv, const uint32_t iv_len, const uint8_t *add,
+                                 const uint32_t add_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_decrypt_start(LT_CRYPTO_OPS_CTX(ctx), iv, iv_len, add, add_len) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_decrypt_update(void *ctx, const uint8_t *ciphertext, const uint32_t ciphertext_len,
+                                  uint8_t *plaintext)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_decrypt_update(LT_CRYPTO_OPS_CTX(ctx), ciphertext, ciphertext_len, plaintext)
+               : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_decrypt_finish(void *ctx, const uint8_t *tag, const uint32_t tag_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_decrypt_finish(LT_CRYPTO_OPS_CTX(ctx), tag, tag_len) : LT_PARAM_ERR;
+}
+#endif
+
+lt_ret_t lt_aesgcm_encrypt_deinit(void *ctx)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_encrypt_deinit(LT_CRYPTO_OPS_CTX(ctx)) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_aesgcm_decrypt_deinit(void *ctx)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->aesgcm_decrypt_deinit(LT_CRYPTO_OPS_CTX(ctx)) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_sha256_init(void *ctx)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->sha256_init(LT_CRYPTO_OPS_CTX(ctx)) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_sha256_start(void *ctx)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->sha256_start(LT_CRYPTO_OPS_CTX(ctx)) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_sha256_update(void *ctx, const uint8_t *input, const size_t input_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->sha256_update(LT_CRYPTO_OPS_CTX(ctx), input, input_len) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_sha256_finish(void *ctx, uint8_t *output)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->sha256_finish(LT_CRYPTO_OPS_CTX(ctx), output) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_sha256_deinit(void *ctx)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->sha256_deinit(LT_CRYPTO_OPS_CTX(ctx)) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
+                        uint8_t *output)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of_global();
+    return ops ? ops->hmac_sha256(key, key_len, input, input_len, output) : LT_CRYPTO_ERR;
+}
+
+lt_ret_t lt_hmac_sha256_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->hmac_sha256_init(LT_CRYPTO_OPS_CTX(ctx), key, key_len) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_hmac_sha256_compute(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->hmac_sha256_compute(LT_CRYPTO_OPS_CTX(ctx), input, input_len, output) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_hmac_sha256_deinit(void *ctx)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of(ctx);
+    return ops ? ops->hmac_sha256_deinit(LT_CRYPTO_OPS_CTX(ctx)) : LT_PARAM_ERR;
+}
+
+lt_ret_t lt_X25519(const uint8_t *privkey, const uint8_t *pubkey, uint8_t *secret)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of_global();
+    return ops ? ops->X25519(privkey, pubkey, secret) : LT_CRYPTO_ERR;
+}
+
+lt_ret_t lt_X25519_scalarmult(const uint8_t *sk, uint8_t *pk)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of_global();
+    return ops ? ops->X25519_scalarmult(sk, pk) : LT_CRYPTO_ERR;
+}
+
+#ifdef LT_ED25519_VERIFY
+lt_ret_t lt_ed25519_verify_batch(lt_ed25519_verify_t *items, const size_t count)
+{
+    const lt_crypto_ops_t *ops = lt_crypto_ops_of_global();
+    return ops ? ops->ed25519_verify_batch(items, count) : LT_CRYPTO_ERR;
+}
+#endif
+
+/** Tells whether the CAL implements the streaming AES-GCM functions, if Libtropic is configured to use them. */
+static bool lt_crypto_ops_complete(const lt_crypto_ops_t *ops)
+{
+#ifdef LT_L3_STREAM_ENCRYPT
+    if (!ops->aesgcm_encrypt_start || !ops->aesgcm_encrypt_update || !ops->aesgcm_encrypt_finish) {
+        return false;
+    }
+#endif
+#ifdef LT_L3_STREAM_DECRYPT
+    if (!ops->aesgcm_decrypt_start || !ops->aesgcm_decrypt_update || !ops->aesgcm_decrypt_finish) {
+        return false;
+    }
+#endif
+    LT_UNUSED(ops);
+    return true;
+}
+
+/** Selects the process-wide CAL if none is selected yet, returns the process-wide CAL. */
+static const lt_crypto_ops_t *lt_crypto_ops_claim_global(const lt_crypto_ops_t *ops)
+{
+    const lt_crypto_ops_t *expected = NULL;
+
+    // Handles may be set up by different threads, only one of them wins.
+    if (!__atomic_compare_exchange_n(&lt_crypto_ops_global, &expected, ops, false, __ATOMIC_ACQ_REL,
+                                     __ATOMIC_ACQUIRE)) {
+        return expected;
+    }
+
+    return ops;
+}
+
+lt_ret_t lt_crypto_ops_set(lt_crypto_ops_ctx_t *c, const lt_crypto_ops_t *ops, void *ctx)
+{
+    if (!c || !ops || !ctx) {
+        return LT_PARAM_ERR;
+    }
+    if (!lt_crypto_ops_complete(ops)) {
+        LT_LOG_ERROR("CAL %s does not implement streaming AES-GCM", ops->name);
+        return LT_PARAM_ERR;
+    }
+
+    c->ops = ops;
+    c->ctx = ctx;
+    // First selection in the process also serves the functions which take no context, later ones keep it.
+    lt_crypto_ops_claim_global(ops);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_crypto_ops_set_global(const lt_crypto_ops_t *ops)
+{
+    if (!ops) {
+        return LT_PARAM_ERR;
+    }
+    if (!lt_crypto_ops_complete(ops)) {
+        LT_LOG_ERROR("CAL %s does not implement streaming AES-GCM", ops->name);
+        return LT_PARAM_ERR;
+    }
+
+    const lt_crypto_ops_t *global = lt_crypto_ops_claim_global(ops);
+    if (global != ops) {
+        LT_LOG_ERROR("CAL %s is already selected for the process, %s cannot be", global->name, ops->name);
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+// X25519 key pairs of Alice and Bob and their shared secret, RFC 7748, section 6.1.
+static const uint8_t lt_crypto_ops_kat_sk[32]
+    = {0x77, 0x07, 0x6d, 0x0a, 0x73, 0x18, 0xa5, 0x7d, 0x3c, 0x16, 0xc1, 0x72, 0x51, 0xb2, 0x66, 0x45,
+       0xdf, 0x4c, 0x2f, 0x87, 0xeb, 0xc0, 0x99, 0x2a, 0xb1, 0x77, 0xfb, 0xa5, 0x1d, 0xb9, 0x2c, 0x2a};
+static const uint8_t lt_crypto_ops_kat_pk[32]
+    = {0x85, 0x20, 0xf0, 0x09, 0x89, 0x30, 0xa7, 0x54, 0x74, 0x8b, 0x7d, 0xdc, 0xb4, 0x3e, 0xf7, 0x5a,
+       0x0d, 0xbf, 0x3a, 0x0d, 0x26, 0x38, 0x1a, 0xf4, 0xeb, 0xa4, 0xa9, 0x8e, 0xaa, 0x9b, 0x4e, 0x6a};
+static const uint8_t lt_crypto_ops_kat_peer_pk[32]
+    = {0xde, 0x9e, 0xdb, 0x7d, 0x7b, 0x7d, 0xc1, 0xb4, 0xd3, 0x5b, 0x61, 0xc2, 0xec, 0xe4, 0x35, 0x37,
+       0x3f, 0x83, 0x43, 0xc8, 0x5b, 0x78, 0x67, 0x4d, 0xad, 0xfc, 0x7e, 0x14, 0x6f, 0x88, 0x2b, 0x4f};
+static const uint8_t lt_crypto_ops_kat_secret[32]
+    = {0x4a, 0x5d, 0x9d, 0x5b, 0xa4, 0xce, 0x2d, 0xe1, 0x72, 0x8e, 0x3b, 0xf4, 0x80, 0x35, 0x0f, 0x25,
+       0xe0, 0x7e, 0x21, 0xc9, 0x47, 0xd1, 0x9e, 0x33, 0x76, 0xf0, 0x9b, 0x3c, 0x1e, 0x16, 0x17, 0x42};
+// SHA-256 of "abc", FIPS 180-2.
+static const uint8_t lt_crypto_ops_kat_sha256[32]
+    = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+       0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+// HMAC-SHA256 of "what do ya want for nothing?" keyed by "Jefe", RFC 4231, test case 2.
+static const uint8_t lt_crypto_ops_kat_hmac[32]
+    = {0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xc7,
+       0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43};
+// AES-256-GCM of 16 zero bytes by zero key and IV, ciphertext and tag, GCM specification, test case 14.
+static const uint8_t lt_crypto_ops_kat_gcm[32]
+    = {0xce, 0xa7, 0x40, 0x3d, 0x4d, 0x60, 0x6b, 0x6e, 0x07, 0x4e, 0xc5, 0xd3, 0xba, 0xf3, 0x9d, 0x18,
+       0xd0, 0xd1, 0xc8, 0xa7, 0x99, 0x99, 0x6b, 0xf0, 0x26, 0x5b, 0x98, 0xb5, 0xd4, 0x8a, 0xb9, 0x19};
+
+/** Checks the functions of the CAL by known answers, CAL context has to be initialized. */
+static lt_ret_t lt_crypto_ops_kat(const lt_crypto_ops_t *ops, void *ctx)
+{
+    static const uint8_t hmac_key[] = "Jefe";
+    static const uint8_t hmac_msg[] = "what do ya want for nothing?";
+    const uint8_t zeros[TR01_AES256_KEY_LEN] = {0};
+    uint8_t out[32], gcm[32];
+    lt_ret_t ret;
+
+    ret = ops->sha256_init(ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = ops->sha256_start(ctx);
+    if (ret == LT_OK) {
+        ret = ops->sha256_update(ctx, (const uint8_t *)"abc", 3);
+    }
+    if (ret == LT_OK) {
+        ret = ops->sha256_finish(ctx, out);
+    }
+    lt_ret_t ret_deinit = ops->sha256_deinit(ctx);
+    if ((ret != LT_OK) || (ret_deinit != LT_OK) || memcmp(out, lt_crypto_ops_kat_sha256, sizeof(out))) {
+        return LT_CRYPTO_ERR;
+    }
+
+    ret = ops->hmac_sha256(hmac_key, sizeof(hmac_key) - 1, hmac_msg, sizeof(hmac_msg) - 1, out);
+    if ((ret != LT_OK) || memcmp(out, lt_crypto_ops_kat_hmac, sizeof(out))) {
+        return LT_CRYPTO_ERR;
+    }
+    memset(out, 0, sizeof(out));
+    ret = ops->hmac_sha256_init(ctx, hmac_key, sizeof(hmac_key) - 1);
+    if (ret == LT_OK) {
+        ret = ops->hmac_sha256_compute(ctx, hmac_msg, sizeof(hmac_msg) - 1, out);
+    }
+    ret_deinit = ops->hmac_sha256_deinit(ctx);
+    if ((ret != LT_OK) || (ret_deinit != LT_OK) || memcmp(out, lt_crypto_ops_kat_hmac, sizeof(out))) {
+        return LT_CRYPTO_ERR;
+    }
+
+    ret = ops->X25519_scalarmult(lt_crypto_ops_kat_sk, out);
+    if ((ret != LT_OK) || memcmp(out, lt_crypto_ops_kat_pk, sizeof(out))) {
+        return LT_CRYPTO_ERR;
+    }
+    ret = ops->X25519(lt_crypto_ops_kat_sk, lt_crypto_ops_kat_peer_pk, out);
+    if ((ret != LT_OK) || memcmp(out, lt_crypto_ops_kat_secret, sizeof(out))) {
+        return LT_CRYPTO_ERR;
+    }
+
+    ret = ops->aesgcm_encrypt_init(ctx, zeros, sizeof(zeros));
+    if (ret == LT_OK) {
+        ret = ops->aesgcm_encrypt(ctx, zeros, TR01_L3_IV_SIZE, (const uint8_t *)"", 0, zeros, 16, gcm, sizeof(gcm));
+    }
+    ret_deinit = ops->aesgcm_encrypt_deinit(ctx);
+    if ((ret != LT_OK) || (ret_deinit != LT_OK) || memcmp(gcm, lt_crypto_ops_kat_gcm, sizeof(gcm))) {
+        return LT_CRYPTO_ERR;
+    }
+    memset(out, 0xFF, sizeof(out));
+    ret = ops->aesgcm_decrypt_init(ctx, zeros, sizeof(zeros));
+    if (ret == LT_OK) {
+        ret = ops->aesgcm_decrypt(ctx, zeros, TR01_L3_IV_SIZE, (const uint8_t *)"", 0, gcm, sizeof(gcm), out, 16);
+    }
+    ret_deinit = ops->aesgcm_decrypt_deinit(ctx);
+    if ((ret != LT_OK) || (ret_deinit != LT_OK) || memcmp(out, zeros, 16)) {
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+/** Crypto operations of one Secure Session handshake followed by a few L3 Commands. */
+static lt_ret_t lt_crypto_ops_workload(const lt_crypto_ops_t *ops, void *ctx)
+{
+    uint8_t pk[32], secret[32], ck[32], key[32];
+    uint8_t data[LT_CRYPTO_OPS_PROBE_DATA_LEN] = {0};
+    uint8_t packet[LT_CRYPTO_OPS_PROBE_DATA_LEN + TR01_L3_TAG_SIZE];
+    uint8_t iv[TR01_L3_IV_SIZE] = {0};
+    lt_ret_t ret, ret_deinit;
+
+    // Ephemeral key pair and the three shared secrets of the handshake.
+    ret = ops->X25519_scalarmult(lt_crypto_ops_kat_sk, pk);
+    for (int i = 0; (ret == LT_OK) && (i < 3); i++) {
+        ret = ops->X25519(lt_crypto_ops_kat_sk, lt_crypto_ops_kat_peer_pk, secret);
+    }
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Transcript hash.
+    ret = ops->sha256_init(ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = ops->sha256_start(ctx);
+    for (int i = 0; (ret == LT_OK) && (i < 4); i++) {
+        ret = ops->sha256_update(ctx, pk, sizeof(pk));
+    }
+    if (ret == LT_OK) {
+        ret = ops->sha256_finish(ctx, ck);
+    }
+    ret_deinit = ops->sha256_deinit(ctx);
+    if ((ret != LT_OK) || (ret_deinit != LT_OK)) {
+        return LT_CRYPTO_ERR;
+    }
+
+    // Four HKDFs as lt_hkdf() computes them.
+    for (int i = 0; i < 4; i++) {
+        uint8_t one = 0x01;
+        ret = ops->hmac_sha256(ck, sizeof(ck), secret, sizeof(secret), key);
+        if (ret == LT_OK) {
+            ret = ops->hmac_sha256_init(ctx, key, sizeof(key));
+        }
+        if (ret == LT_OK) {
+            ret = ops->hmac_sha256_compute(ctx, &one, 1, ck);
+        }
+        if (ret == LT_OK) {
+            ret = ops->hmac_sha256_compute(ctx, ck, sizeof(ck), key);
+        }
+        ret_deinit = ops->hmac_sha256_deinit(ctx);
+        if ((ret != LT_OK) || (ret_deinit != LT_OK)) {
+            return LT_CRYPTO_ERR;
+        }
+    }
+
+    // L3 Commands encrypted and their L3 Results decrypted.
+    ret = ops->aesgcm_encrypt_init(ctx, key, sizeof(key));
+    if (ret == LT_OK) {
+        ret = ops->aesgcm_decrypt_init(ctx, key, sizeof(key));
+    }
+    for (int i = 0; (ret == LT_OK) && (i < LT_CRYPTO_OPS_PROBE_CMDS); i++) {
+        iv[0] = (uint8_t)i;
+        ret = ops->aesgcm_encrypt(ctx, iv, sizeof(iv), (const uint8_t *)"", 0, data, sizeof(data), packet,
+                                  sizeof(packet));
+        if (ret == LT_OK) {
+            ret = ops->aesgcm_decrypt(ctx, iv, sizeof(iv), (const uint8_t *)"", 0, packet, sizeof(packet), data,
+                                      sizeof(data));
+        }
+    }
+    lt_ret_t ret_enc = ops->aesgcm_encrypt_deinit(ctx);
+    ret_deinit = ops->aesgcm_decrypt_deinit(ctx);
+    if ((ret != LT_OK) || (ret_enc != LT_OK) || (ret_deinit != LT_OK)) {
+        return LT_CRYPTO_ERR;
+    }
+
+    return LT_OK;
+}
+
+/** Checks and measures one candidate, returns the duration of its fastest round in microseconds, 0 if it failed. */
+static uint32_t lt_crypto_ops_measure(const lt_crypto_ops_t *ops, void *ctx)
+{
+    uint64_t best = UINT64_MAX;
+
+    if (!lt_crypto_ops_complete(ops) || (ops->crypto_ctx_init(ctx) != LT_OK)) {
+        return 0;
+    }
+    lt_ret_t ret = lt_crypto_ops_kat(ops, ctx);
+    for (int i = 0; (ret == LT_OK) && (i < LT_CRYPTO_OPS_PROBE_ROUNDS); i++) {
+        uint64_t start = lt_port_time_us();
+        ret = lt_crypto_ops_workload(ops, ctx);
+        uint64_t duration = lt_port_time_us() - start;
+        if (duration < best) {
+            best = duration;
+        }
+    }
+    if ((ops->crypto_ctx_deinit(ctx) != LT_OK) || (ret != LT_OK)) {
+        return 0;
+    }
+
+    // Coarse clocks may measure no time at all, 0 means the candidate failed.
+    if (best == 0) {
+        return 1;
+    }
+    return (best > UINT32_MAX) ? UINT32_MAX : (uint32_t)best;
+}
+
+lt_ret_t lt_crypto_ops_probe(lt_crypto_ops_ctx_t *c, lt_crypto_backend_t *backends, const size_t count)
+{
+    lt_crypto_backend_t *best = NULL;
+
+    if (!c || !backends || !count) {
+        return LT_PARAM_ERR;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!backends[i].ops || !backends[i].ctx) {
+            return LT_PARAM_ERR;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        lt_crypto_backend_t *b = &backends[i];
+        b->probe_us = lt_crypto_ops_measure(b->ops, b->ctx);
+        LT_LOG_DEBUG("CAL %s probed, probe_us=%" PRIu32, b->ops->name, b->probe_us);
+        if (b->probe_us && (!best || (b->probe_us < best->probe_us))) {
+            best = b;
+        }
+    }
+    if (!best) {
+        LT_LOG_ERROR("None of the probed CALs works");
+        return LT_CRYPTO_ERR;
+    }
+
+    return lt_crypto_ops_set(c, best->ops, best->ctx);
+}
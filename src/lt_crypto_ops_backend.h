@@ -0,0 +1,100 @@
+#ifndef LT_CRYPTO_OPS_BACKEND_H
+#define LT_CRYPTO_OPS_BACKEND_H
+
+/**
+ * @file lt_crypto_ops_backend.h
+ * @brief Renames the CAL functions to lt_<backend>_*, so several CALs can be linked together with `LT_CRYPTO_OPS`.
+ * @details Included first by `cal/<backend>/lt_<backend>_ops.c`, which defines `LT_CRYPTO_OPS_BACKEND`, includes all
+ * sources of the CAL and defines its `lt_crypto_ops_t` by `LT_CRYPTO_OPS_DEFINE()`. The names without prefix are
+ * implemented by `src/lt_crypto_ops.c`, which dispatches them to the CAL selected for the handle. CALs implementing
+ * streaming AES-GCM define `LT_CRYPTO_OPS_AESGCM_STREAM` too, the streaming members stay NULL for the others.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_common.h"
+
+#ifndef LT_CRYPTO_OPS_BACKEND
+#error "LT_CRYPTO_OPS_BACKEND has to be defined before including lt_crypto_ops_backend.h"
+#endif
+
+#define LT_CRYPTO_OPS_CAT_(a, b, c) a##b##c
+#define LT_CRYPTO_OPS_CAT(a, b, c) LT_CRYPTO_OPS_CAT_(a, b, c)
+/** Name of a CAL function of the backend, e.g. lt_openssl_sha256_init. */
+#define LT_CRYPTO_OPS_NAME(fn) LT_CRYPTO_OPS_CAT(lt_, LT_CRYPTO_OPS_BACKEND, _##fn)
+
+#define lt_crypto_ctx_init LT_CRYPTO_OPS_NAME(crypto_ctx_init)
+#define lt_crypto_ctx_deinit LT_CRYPTO_OPS_NAME(crypto_ctx_deinit)
+#define lt_aesgcm_encrypt_init LT_CRYPTO_OPS_NAME(aesgcm_encrypt_init)
+#define lt_aesgcm_decrypt_init LT_CRYPTO_OPS_NAME(aesgcm_decrypt_init)
+#define lt_aesgcm_encrypt LT_CRYPTO_OPS_NAME(aesgcm_encrypt)
+#define lt_aesgcm_decrypt LT_CRYPTO_OPS_NAME(aesgcm_decrypt)
+#define lt_aesgcm_encrypt_start LT_CRYPTO_OPS_NAME(aesgcm_encrypt_start)
+#define lt_aesgcm_encrypt_update LT_CRYPTO_OPS_NAME(aesgcm_encrypt_update)
+#define lt_aesgcm_encrypt_finish LT_CRYPTO_OPS_NAME(aesgcm_encrypt_finish)
+#define lt_aesgcm_decrypt_start LT_CRYPTO_OPS_NAME(aesgcm_decrypt_start)
+#define lt_aesgcm_decrypt_update LT_CRYPTO_OPS_NAME(aesgcm_decrypt_update)
+#define lt_aesgcm_decrypt_finish LT_CRYPTO_OPS_NAME(aesgcm_decrypt_finish)
+#define lt_aesgcm_encrypt_deinit LT_CRYPTO_OPS_NAME(aesgcm_encrypt_deinit)
+#define lt_aesgcm_decrypt_deinit LT_CRYPTO_OPS_NAME(aesgcm_decrypt_deinit)
+#define lt_sha256_init LT_CRYPTO_OPS_NAME(sha256_init)
+#define lt_sha256_start LT_CRYPTO_OPS_NAME(sha256_start)
+#define lt_sha256_update LT_CRYPTO_OPS_NAME(sha256_update)
+#define lt_sha256_finish LT_CRYPTO_OPS_NAME(sha256_finish)
+#define lt_sha256_deinit LT_CRYPTO_OPS_NAME(sha256_deinit)
+#define lt_hmac_sha256 LT_CRYPTO_OPS_NAME(hmac_sha256)
+#define lt_hmac_sha256_init LT_CRYPTO_OPS_NAME(hmac_sha256_init)
+#define lt_hmac_sha256_compute LT_CRYPTO_OPS_NAME(hmac_sha256_compute)
+#define lt_hmac_sha256_deinit LT_CRYPTO_OPS_NAME(hmac_sha256_deinit)
+#define lt_X25519 LT_CRYPTO_OPS_NAME(X25519)
+#define lt_X25519_scalarmult LT_CRYPTO_OPS_NAME(X25519_scalarmult)
+#define lt_ed25519_verify_batch LT_CRYPTO_OPS_NAME(ed25519_verify_batch)
+
+#if defined(LT_L3_STREAM_ENCRYPT) && defined(LT_CRYPTO_OPS_AESGCM_STREAM)
+#define LT_CRYPTO_OPS_STREAM_ENCRYPT                                                                        \
+    , .aesgcm_encrypt_start = lt_aesgcm_encrypt_start, .aesgcm_encrypt_update = lt_aesgcm_encrypt_update, \
+        .aesgcm_encrypt_finish = lt_aesgcm_encrypt_finish
+#else
+#define LT_CRYPTO_OPS_STREAM_ENCRYPT
+#endif
+
+#if defined(LT_L3_STREAM_DECRYPT) && defined(LT_CRYPTO_OPS_AESGCM_STREAM)
+#define LT_CRYPTO_OPS_STREAM_DECRYPT                                                                        \
+    , .aesgcm_decrypt_start = lt_aesgcm_decrypt_start, .aesgcm_decrypt_update = lt_aesgcm_decrypt_update, \
+        .aesgcm_decrypt_finish = lt_aesgcm_decrypt_finish
+#else
+#define LT_CRYPTO_OPS_STREAM_DECRYPT
+#endif
+
+#ifdef LT_ED25519_VERIFY
+#define LT_CRYPTO_OPS_ED25519_VERIFY , .ed25519_verify_batch = lt_ed25519_verify_batch
+#else
+#define LT_CRYPTO_OPS_ED25519_VERIFY
+#endif
+
+/** Defines the functions of the backend, declared as `extern const lt_crypto_ops_t table` by the CAL header. */
+#define LT_CRYPTO_OPS_DEFINE(table, backend_name)                                                        \
+    const lt_crypto_ops_t table = {.name = backend_name,                                                 \
+                                   .crypto_ctx_init = lt_crypto_ctx_init,                                \
+                                   .crypto_ctx_deinit = lt_crypto_ctx_deinit,                            \
+                                   .aesgcm_encrypt_init = lt_aesgcm_encrypt_init,                        \
+                                   .aesgcm_decrypt_init = lt_aesgcm_decrypt_init,                        \
+                                   .aesgcm_encrypt = lt_aesgcm_encrypt,                                  \
+                                   .aesgcm_decrypt = lt_aesgcm_decrypt,                                  \
+                                   .aesgcm_encrypt_deinit = lt_aesgcm_encrypt_deinit,                    \
+                                   .aesgcm_decrypt_deinit = lt_aesgcm_decrypt_deinit,                    \
+                                   .sha256_init = lt_sha256_init,                                        \
+                                   .sha256_start = lt_sha256_start,                                      \
+                                   .sha256_update = lt_sha256_update,                                    \
+                                   .sha256_finish = lt_sha256_finish,                                    \
+                                   .sha256_deinit = lt_sha256_deinit,                                    \
+                                   .hmac_sha256 = lt_hmac_sha256,                                        \
+                                   .hmac_sha256_init = lt_hmac_sha256_init,                              \
+                                   .hmac_sha256_compute = lt_hmac_sha256_compute,                        \
+                                   .hmac_sha256_deinit = lt_hmac_sha256_deinit,                          \
+                                   .X25519 = lt_X25519,                                                  \
+                                   .X25519_scalarmult = lt_X25519_scalarmult LT_CRYPTO_OPS_STREAM_ENCRYPT \
+                                       LT_CRYPTO_OPS_STREAM_DECRYPT LT_CRYPTO_OPS_ED25519_VERIFY}
+
+#endif  // LT_CRYPTO_OPS_BACKEND_H
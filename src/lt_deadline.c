@@ -0,0 +1,93 @@
+/**
+ * @file lt_deadline.c
+ * @brief Deadline of the API calls definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_deadline.h"
+
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "libtropic_port.h"
+#include "lt_l1.h"
+
+/**
+ * @brief Returns time left until the deadline.
+ *
+ * @param s2        Structure holding l2 state
+ * @return          Time left [us], 0 if the deadline passed, UINT64_MAX if there is no deadline.
+ */
+static uint64_t lt_deadline_left(const lt_l2_state_t *s2)
+{
+    if (!s2->deadline_us) {
+        return UINT64_MAX;
+    }
+
+    const uint64_t now_us = lt_port_time_us();
+
+    return (now_us < s2->deadline_us) ? (s2->deadline_us - now_us) : 0;
+}
+
+lt_ret_t lt_deadline_check(const lt_l2_state_t *s2, const uint32_t wait_ms)
+{
+    const uint64_t left_us = lt_deadline_left(s2);
+
+    if ((left_us == 0) || ((uint64_t)wait_ms * 1000U > left_us)) {
+        return LT_DEADLINE_EXCEEDED;
+    }
+
+    return LT_OK;
+}
+
+uint32_t lt_deadline_left_ms(const lt_l2_state_t *s2)
+{
+    const uint64_t left_us = lt_deadline_left(s2);
+
+    return (uint32_t)lt_min(left_us / 1000U, (uint64_t)UINT32_MAX);
+}
+
+uint32_t lt_deadline_timeout_ms(const lt_l2_state_t *s2, const uint32_t timeout_ms)
+{
+    const uint32_t left_ms = lt_deadline_left_ms(s2);
+
+    if (left_ms >= timeout_ms) {
+        return timeout_ms;
+    }
+
+    return lt_max(left_ms, (uint32_t)LT_L1_TIMEOUT_MS_MIN);
+}
+
+lt_ret_t lt_deadline_set(lt_handle_t *h, const uint32_t budget_us)
+{
+    if (!h || !budget_us) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l2.deadline_us = lt_port_time_us() + budget_us;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_deadline_clear(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l2.deadline_us = 0;
+
+    return LT_OK;
+}
+
+uint32_t lt_deadline_left_us(const lt_handle_t *h)
+{
+    if (!h) {
+        return UINT32_MAX;
+    }
+
+    return (uint32_t)lt_min(lt_deadline_left(&h->l2), (uint64_t)UINT32_MAX);
+}
@@ -0,0 +1,50 @@
+#ifndef LT_DEADLINE_H
+#define LT_DEADLINE_H
+
+/**
+ * @file lt_deadline.h
+ * @brief Deadline of the API calls declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Checks whether waiting for given time ends before the deadline.
+ *
+ * @param s2        Structure holding l2 state
+ * @param wait_ms   Time of the wait [ms], 0 to check only whether the deadline passed
+ * @return          LT_OK if there is no deadline or the wait ends before it, otherwise LT_DEADLINE_EXCEEDED.
+ */
+lt_ret_t lt_deadline_check(const lt_l2_state_t *s2, const uint32_t wait_ms);
+
+/**
+ * @brief Returns time left until the deadline.
+ *
+ * @param s2        Structure holding l2 state
+ * @return          Time left [ms] rounded down, UINT32_MAX if there is no deadline.
+ */
+uint32_t lt_deadline_left_ms(const lt_l2_state_t *s2);
+
+/**
+ * @brief Clips timeout of an SPI transfer to the time left until the deadline.
+ *
+ * @param s2          Structure holding l2 state
+ * @param timeout_ms  Timeout of the transfer
+ * @return            Timeout not longer than the time left, but at least LT_L1_TIMEOUT_MS_MIN.
+ */
+uint32_t lt_deadline_timeout_ms(const lt_l2_state_t *s2, const uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_DEADLINE_H
@@ -0,0 +1,223 @@
+/**
+ * @file lt_ecc_inventory.c
+ * @brief ECC key slot inventory definitions, occupancy and public keys of the slots known to the host
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_ecc_inventory.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+LT_STATIC_ASSERT(LT_ECC_INVENTORY_SLOTS == TR01_ECC_SLOT_31 + 1)
+LT_STATIC_ASSERT(LT_ECC_INVENTORY_PUBKEY_LEN == TR01_CURVE_P256_PUBKEY_LEN)
+
+/** Returns the inventory of the handle, dropped first if it belongs to an earlier Secure Session. */
+static lt_ecc_inventory_t *lt_ecc_inventory_of(lt_handle_t *h)
+{
+    lt_ecc_inventory_t *inv = &h->l3.ecc_inv;
+
+    if (inv->session_cnt != h->l3.session_cnt) {
+        inv->session_cnt = h->l3.session_cnt;
+        inv->known = 0;
+        inv->occupied = 0;
+        inv->pubkey_known = 0;
+    }
+
+    return inv;
+}
+
+/** Length of the public key of the curve. */
+static uint8_t lt_ecc_inventory_pubkey_len(const uint8_t curve)
+{
+    return (curve == (uint8_t)TR01_CURVE_ED25519) ? TR01_CURVE_ED25519_PUBKEY_LEN : TR01_CURVE_P256_PUBKEY_LEN;
+}
+
+bool lt_ecc_inventory_read(lt_handle_t *h, const lt_ecc_slot_t slot, uint8_t *key, const uint8_t key_max_size,
+                           lt_ecc_curve_type_t *curve, lt_ecc_key_origin_t *origin, lt_ret_t *ret)
+{
+    lt_ecc_inventory_t *inv = lt_ecc_inventory_of(h);
+    const uint32_t bit = 1UL << slot;
+
+    if (!(inv->pubkey_known & bit)) {
+        inv->misses++;
+        return false;
+    }
+    inv->hits++;
+
+    const uint8_t len = lt_ecc_inventory_pubkey_len(inv->curve[slot]);
+    if (key_max_size < len) {
+        *ret = LT_PARAM_ERR;
+        return true;
+    }
+
+    memcpy(key, inv->pubkey[slot], len);
+    *curve = (lt_ecc_curve_type_t)inv->curve[slot];
+    *origin = (lt_ecc_key_origin_t)inv->origin[slot];
+    *ret = LT_OK;
+
+    return true;
+}
+
+void lt_ecc_inventory_merge_read(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ret_t ret, const uint8_t *key,
+                                 const lt_ecc_curve_type_t curve, const lt_ecc_key_origin_t origin)
+{
+    if (ret == LT_OK) {
+        lt_ecc_inventory_put_key(h, slot, curve, origin);
+        lt_ecc_inventory_t *inv = &h->l3.ecc_inv;
+        memcpy(inv->pubkey[slot], key, lt_ecc_inventory_pubkey_len((uint8_t)curve));
+        inv->pubkey_known |= 1UL << slot;
+    }
+    else if ((ret == LT_L3_INVALID_KEY) || (ret == LT_L3_SLOT_EMPTY)) {
+        lt_ecc_inventory_put_empty(h, slot);
+    }
+}
+
+void lt_ecc_inventory_put_key(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve,
+                              const lt_ecc_key_origin_t origin)
+{
+    lt_ecc_inventory_t *inv = lt_ecc_inventory_of(h);
+    const uint32_t bit = 1UL << slot;
+
+    inv->known |= bit;
+    inv->occupied |= bit;
+    inv->pubkey_known &= ~bit;
+    inv->curve[slot] = (uint8_t)curve;
+    inv->origin[slot] = (uint8_t)origin;
+}
+
+void lt_ecc_inventory_put_empty(lt_handle_t *h, const lt_ecc_slot_t slot)
+{
+    lt_ecc_inventory_t *inv = lt_ecc_inventory_of(h);
+    const uint32_t bit = 1UL << slot;
+
+    inv->known |= bit;
+    inv->occupied &= ~bit;
+    inv->pubkey_known &= ~bit;
+}
+
+void lt_ecc_inventory_forget(lt_handle_t *h, const lt_ecc_slot_t slot)
+{
+    lt_ecc_inventory_t *inv = lt_ecc_inventory_of(h);
+    const uint32_t bit = 1UL << slot;
+
+    inv->known &= ~bit;
+    inv->occupied &= ~bit;
+    inv->pubkey_known &= ~bit;
+}
+
+bool lt_ecc_inventory_known_empty(lt_handle_t *h, const lt_ecc_slot_t slot)
+{
+    const lt_ecc_inventory_t *inv = lt_ecc_inventory_of(h);
+    const uint32_t bit = 1UL << slot;
+
+    return (inv->known & bit) && !(inv->occupied & bit);
+}
+
+/**
+ * @brief Reads the slot from TROPIC01 by lt_ecc_key_read(), which merges the result into the inventory.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  ECC key slot
+ * @return      LT_OK if the slot is known afterwards, otherwise the error of the read
+ */
+static lt_ret_t lt_ecc_inventory_probe(lt_handle_t *h, const lt_ecc_slot_t slot)
+{
+    uint8_t key[TR01_CURVE_P256_PUBKEY_LEN];
+    lt_ecc_curve_type_t curve;
+    lt_ecc_key_origin_t origin;
+
+    lt_ret_t ret = lt_ecc_key_read(h, slot, key, sizeof(key), &curve, &origin);
+    if ((ret == LT_L3_INVALID_KEY) || (ret == LT_L3_SLOT_EMPTY)) {
+        return LT_OK;
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_ecc_inventory_scan(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+
+    for (uint8_t slot = TR01_ECC_SLOT_0; slot <= TR01_ECC_SLOT_31; slot++) {
+        lt_ecc_inventory_t *inv = lt_ecc_inventory_of(h);
+        const uint32_t bit = 1UL << slot;
+        // Empty slots and keys with known public key need no read.
+        if ((inv->known & bit) && (!(inv->occupied & bit) || (inv->pubkey_known & bit))) {
+            continue;
+        }
+        lt_ret_t ret = lt_ecc_inventory_probe(h, (lt_ecc_slot_t)slot);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_ecc_inventory_find_free(lt_handle_t *h, lt_ecc_slot_t *slot)
+{
+    if (!h || !slot) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+
+    for (uint8_t i = TR01_ECC_SLOT_0; i <= TR01_ECC_SLOT_31; i++) {
+        const uint32_t bit = 1UL << i;
+        // Unknown slots are read in order, only until the first empty one.
+        if (!(lt_ecc_inventory_of(h)->known & bit)) {
+            lt_ret_t ret = lt_ecc_inventory_probe(h, (lt_ecc_slot_t)i);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+        if (!(lt_ecc_inventory_of(h)->occupied & bit)) {
+            *slot = (lt_ecc_slot_t)i;
+            return LT_OK;
+        }
+    }
+
+    return LT_FAIL;
+}
+
+lt_ret_t lt_ecc_inventory_get(lt_handle_t *h, uint32_t *occupied)
+{
+    if (!h || !occupied) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_ecc_inventory_scan(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    *occupied = lt_ecc_inventory_of(h)->occupied;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_ecc_inventory_invalidate(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l3.ecc_inv.known = 0;
+    h->l3.ecc_inv.occupied = 0;
+    h->l3.ecc_inv.pubkey_known = 0;
+
+    return LT_OK;
+}
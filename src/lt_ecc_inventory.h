@@ -0,0 +1,92 @@
+#ifndef LT_ECC_INVENTORY_H
+#define LT_ECC_INVENTORY_H
+
+/**
+ * @file lt_ecc_inventory.h
+ * @brief ECC key slot inventory declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_ECC_INVENTORY
+/**
+ * @brief Answers ECC_Key_Read of the slot from the inventory, if its public key is known.
+ *
+ * @param h             Handle for communication with TROPIC01
+ * @param slot          ECC key slot
+ * @param key           Buffer for the public key
+ * @param key_max_size  Size of the buffer
+ * @param curve         Set to the curve of the key
+ * @param origin        Set to the origin of the key
+ * @param ret           Set to the result of the read if it was answered
+ * @return              true if the read was answered from the inventory
+ */
+bool lt_ecc_inventory_read(lt_handle_t *h, const lt_ecc_slot_t slot, uint8_t *key, const uint8_t key_max_size,
+                           lt_ecc_curve_type_t *curve, lt_ecc_key_origin_t *origin, lt_ret_t *ret);
+
+/**
+ * @brief Merges result of ECC_Key_Read into the inventory: on success the key is known, LT_L3_INVALID_KEY and
+ * LT_L3_SLOT_EMPTY mean the slot holds no usable key, other results change nothing.
+ *
+ * @param h       Handle for communication with TROPIC01
+ * @param slot    ECC key slot
+ * @param ret     Result of the read
+ * @param key     Public key read
+ * @param curve   Curve of the key read
+ * @param origin  Origin of the key read
+ */
+void lt_ecc_inventory_merge_read(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ret_t ret, const uint8_t *key,
+                                 const lt_ecc_curve_type_t curve, const lt_ecc_key_origin_t origin);
+
+/**
+ * @brief Marks the slot as holding a key of the curve, its public key is read by the next lt_ecc_key_read().
+ *
+ * @param h       Handle for communication with TROPIC01
+ * @param slot    ECC key slot
+ * @param curve   Curve of the key
+ * @param origin  TR01_CURVE_GENERATED or TR01_CURVE_STORED
+ */
+void lt_ecc_inventory_put_key(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve,
+                              const lt_ecc_key_origin_t origin);
+
+/**
+ * @brief Marks the slot as empty.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  ECC key slot
+ */
+void lt_ecc_inventory_put_empty(lt_handle_t *h, const lt_ecc_slot_t slot);
+
+/**
+ * @brief Forgets the slot, e.g. while a command changing it is in flight.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  ECC key slot
+ */
+void lt_ecc_inventory_forget(lt_handle_t *h, const lt_ecc_slot_t slot);
+
+/**
+ * @brief Tells whether the slot is known to be empty in the current Secure Session.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  ECC key slot
+ * @return      true if the slot is known to hold no key
+ */
+bool lt_ecc_inventory_known_empty(lt_handle_t *h, const lt_ecc_slot_t slot);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_ECC_INVENTORY_H
@@ -0,0 +1,203 @@
+/**
+ * @file lt_ecc_key_pool.c
+ * @brief Pool of ECC key slots holding keys generated ahead of time
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_secure_memzero.h"
+
+LT_STATIC_ASSERT(LT_ECC_KEY_POOL_PUBKEY_LEN == TR01_CURVE_P256_PUBKEY_LEN)
+
+/** Slot may hold anything, it is erased next. */
+#define LT_ECC_KEY_POOL_DIRTY 0
+/** Slot is empty, a key is generated next. */
+#define LT_ECC_KEY_POOL_EMPTY 1
+/** Key was generated, its public key is read next. */
+#define LT_ECC_KEY_POOL_GENERATED 2
+/** Key and its public key are ready to be handed out. */
+#define LT_ECC_KEY_POOL_READY 3
+
+/** Length of the public key of the curve. */
+static uint8_t lt_ecc_key_pool_pubkey_len(const uint8_t curve)
+{
+    return (curve == (uint8_t)TR01_CURVE_ED25519) ? TR01_CURVE_ED25519_PUBKEY_LEN : TR01_CURVE_P256_PUBKEY_LEN;
+}
+
+/**
+ * @brief Sends the next L3 Command of the slot.
+ *
+ * @param pool  Key pool
+ * @param e     Slot of the pool without a ready key
+ * @return      LT_OK if the slot moved on, LT_FAIL if the slot holds a foreign key (it is erased next), otherwise
+ *              the error of the command
+ */
+static lt_ret_t lt_ecc_key_pool_advance(lt_ecc_key_pool_t *pool, lt_ecc_key_pool_entry_t *e)
+{
+    lt_ecc_curve_type_t curve;
+    lt_ecc_key_origin_t origin;
+    lt_ret_t ret;
+
+    switch (e->state) {
+        case LT_ECC_KEY_POOL_DIRTY:
+            ret = lt_ecc_key_erase(pool->h, (lt_ecc_slot_t)e->slot);
+            if (ret == LT_OK) {
+                e->state = LT_ECC_KEY_POOL_EMPTY;
+            }
+            return ret;
+        case LT_ECC_KEY_POOL_EMPTY:
+            ret = lt_ecc_key_generate(pool->h, (lt_ecc_slot_t)e->slot, (lt_ecc_curve_type_t)pool->curve);
+            // Slot may or may not hold a key if the generation failed.
+            e->state = (ret == LT_OK) ? LT_ECC_KEY_POOL_GENERATED : LT_ECC_KEY_POOL_DIRTY;
+            return ret;
+        default:
+            ret = lt_ecc_key_read(pool->h, (lt_ecc_slot_t)e->slot, e->pubkey, sizeof(e->pubkey), &curve, &origin);
+            if ((ret == LT_OK) && ((curve != (lt_ecc_curve_type_t)pool->curve) || (origin != TR01_CURVE_GENERATED))) {
+                ret = LT_FAIL;
+            }
+            if ((ret == LT_FAIL) || (ret == LT_L3_INVALID_KEY) || (ret == LT_L3_SLOT_EMPTY)) {
+                lt_secure_memzero(e->pubkey, sizeof(e->pubkey));
+                e->state = LT_ECC_KEY_POOL_DIRTY;
+            }
+            else if (ret == LT_OK) {
+                e->state = LT_ECC_KEY_POOL_READY;
+            }
+            return ret;
+    }
+}
+
+lt_ret_t lt_ecc_key_pool_init(lt_ecc_key_pool_t *pool, lt_handle_t *h, const lt_ecc_curve_type_t curve)
+{
+    if (!pool || !h || ((curve != TR01_CURVE_P256) && (curve != TR01_CURVE_ED25519))) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(pool, 0, sizeof(lt_ecc_key_pool_t));
+    pool->h = h;
+    pool->curve = (uint8_t)curve;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_ecc_key_pool_add(lt_ecc_key_pool_t *pool, const lt_ecc_slot_t slot)
+{
+    if (!pool || !pool->h || (slot > TR01_ECC_SLOT_31)) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t i = 0; i < pool->count; i++) {
+        if (pool->entries[i].slot == (uint8_t)slot) {
+            return LT_PARAM_ERR;
+        }
+    }
+    if (pool->count == LT_ECC_KEY_POOL_SIZE) {
+        return LT_FAIL;
+    }
+
+    lt_ecc_key_pool_entry_t *e = &pool->entries[pool->count++];
+    e->slot = (uint8_t)slot;
+    e->state = LT_ECC_KEY_POOL_DIRTY;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_ecc_key_pool_refill_step(lt_handle_t *h, void *ctx, bool *done)
+{
+    lt_ecc_key_pool_t *pool = (lt_ecc_key_pool_t *)ctx;
+
+    if (!h || !pool || (pool->h != h) || !done) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t i = 0; i < pool->count; i++) {
+        if (pool->entries[i].state != LT_ECC_KEY_POOL_READY) {
+            lt_ret_t ret = lt_ecc_key_pool_advance(pool, &pool->entries[i]);
+            *done = (lt_ecc_key_pool_ready(pool) == pool->count);
+            return ret;
+        }
+    }
+    *done = true;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_ecc_key_pool_refill(lt_ecc_key_pool_t *pool)
+{
+    if (!pool) {
+        return LT_PARAM_ERR;
+    }
+
+    bool done = false;
+    while (!done) {
+        done = true;
+        lt_ret_t ret = lt_ecc_key_pool_refill_step(pool->h, pool, &done);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_ecc_key_pool_take(lt_ecc_key_pool_t *pool, lt_ecc_slot_t *slot, uint8_t *pubkey,
+                              const uint8_t pubkey_max_size)
+{
+    if (!pool || !pool->h || !slot || !pubkey || (pubkey_max_size < lt_ecc_key_pool_pubkey_len(pool->curve))) {
+        return LT_PARAM_ERR;
+    }
+    if (pool->count == 0) {
+        return LT_FAIL;
+    }
+
+    uint8_t i = 0;
+    while ((i < pool->count) && (pool->entries[i].state != LT_ECC_KEY_POOL_READY)) {
+        i++;
+    }
+    if (i < pool->count) {
+        pool->hits++;
+    }
+    else {
+        // Every successful step moves the slot on, a foreign key found by the read fails the take.
+        i = 0;
+        pool->misses++;
+        while (pool->entries[0].state != LT_ECC_KEY_POOL_READY) {
+            lt_ret_t ret = lt_ecc_key_pool_advance(pool, &pool->entries[0]);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+    }
+
+    lt_ecc_key_pool_entry_t *e = &pool->entries[i];
+    *slot = (lt_ecc_slot_t)e->slot;
+    memcpy(pubkey, e->pubkey, lt_ecc_key_pool_pubkey_len(pool->curve));
+
+    pool->count--;
+    memmove(e, e + 1, (size_t)(pool->count - i) * sizeof(lt_ecc_key_pool_entry_t));
+    lt_secure_memzero(&pool->entries[pool->count], sizeof(lt_ecc_key_pool_entry_t));
+
+    return LT_OK;
+}
+
+uint8_t lt_ecc_key_pool_ready(const lt_ecc_key_pool_t *pool)
+{
+    if (!pool) {
+        return 0;
+    }
+
+    uint8_t ready = 0;
+    for (uint8_t i = 0; i < pool->count; i++) {
+        if (pool->entries[i].state == LT_ECC_KEY_POOL_READY) {
+            ready++;
+        }
+    }
+
+    return ready;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file lt_ecdsa_sign_stream.c
+ * @brief ECDSA signing of messages hashed part by part
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_l3.h"
+#include "libtropic_macros.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_cmd_desc.h"
+#include "lt_secure_memzero.h"
+#include "lt_sha256.h"
+
+#ifndef LT_ECDSA_SIGN_READ_CHUNK
+/** Size of the buffer on stack the reader callback fills with the message. */
+#define LT_ECDSA_SIGN_READ_CHUNK 128
+#endif
+
+/** Stops hashing of the message and releases SHA-256 context of the handle. */
+static void lt_ecdsa_sign_stop(lt_ecdsa_sign_t *s)
+{
+    lt_ret_t ret_unused = lt_sha256_deinit(s->h->l3.crypto_ctx);
+    LT_UNUSED(ret_unused);
+    s->active = 0;
+}
+
+lt_ret_t lt_ecdsa_sign_init(lt_ecdsa_sign_t *s, lt_handle_t *h, const lt_ecc_slot_t ecc_slot)
+{
+    if (!s || !h || (ecc_slot > TR01_ECC_SLOT_31)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(s, 0, sizeof(lt_ecdsa_sign_t));
+    s->h = h;
+    s->slot = (uint8_t)ecc_slot;
+
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    s->active = 1;
+
+    ret = lt_sha256_start(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        lt_ecdsa_sign_stop(s);
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_ecdsa_sign_update(lt_ecdsa_sign_t *s, const uint8_t *data, const size_t len)
+{
+    if (!s || !s->active || (!data && len)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_sha256_update(s->h->l3.crypto_ctx, data, len);
+    if (ret != LT_OK) {
+        lt_ecdsa_sign_stop(s);
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_ecdsa_sign_read(lt_ecdsa_sign_t *s, lt_ecdsa_sign_reader_t reader, void *reader_ctx)
+{
+    if (!s || !s->active || !reader) {
+        return LT_PARAM_ERR;
+    }
+
+    uint8_t buf[LT_ECDSA_SIGN_READ_CHUNK];
+    lt_ret_t ret;
+    size_t read_len;
+    do {
+        read_len = 0;
+        ret = reader(reader_ctx, buf, sizeof(buf), &read_len);
+        if ((ret == LT_OK) && (read_len > sizeof(buf))) {
+            ret = LT_PARAM_ERR;
+        }
+        if (ret != LT_OK) {
+            lt_ecdsa_sign_stop(s);
+            break;
+        }
+        ret = lt_ecdsa_sign_update(s, buf, read_len);
+    } while ((ret == LT_OK) && read_len);
+
+    lt_secure_memzero(buf, sizeof(buf));
+
+    return ret;
+}
+
+/**
+ * @brief Finishes hashing of the message.
+ *
+ * @param s         Signing context
+ * @param msg_hash  SHA-256 digest is returned here
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_ecdsa_sign_digest(lt_ecdsa_sign_t *s, uint8_t *msg_hash)
+{
+    lt_ret_t ret = lt_sha256_finish(s->h->l3.crypto_ctx, msg_hash);
+    lt_ecdsa_sign_stop(s);
+
+    return ret;
+}
+
+lt_ret_t lt_ecdsa_sign_final(lt_ecdsa_sign_t *s, uint8_t *rs)
+{
+    if (!s || !s->active) {
+        return LT_PARAM_ERR;
+    }
+    if (!rs) {
+        lt_ecdsa_sign_stop(s);
+        return LT_PARAM_ERR;
+    }
+
+    uint8_t msg_hash[LT_SHA256_DIGEST_LENGTH];
+    lt_ret_t ret = lt_ecdsa_sign_digest(s, msg_hash);
+    if (ret == LT_OK) {
+        ret = lt_ecc_ecdsa_sign_digest(s->h, (lt_ecc_slot_t)s->slot, msg_hash, rs);
+    }
+    lt_secure_memzero(msg_hash, sizeof(msg_hash));
+
+    return ret;
+}
+
+/**
+ * @brief Hashes the whole message read by the reader callback.
+ *
+ * @param h           Handle for communication with TROPIC01
+ * @param reader      Reader callback
+ * @param reader_ctx  Passed to reader
+ * @param msg_hash    SHA-256 digest is returned here
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_ecdsa_sign_hash_doc(lt_handle_t *h, lt_ecdsa_sign_reader_t reader, void *reader_ctx,
+                                       uint8_t *msg_hash)
+{
+    lt_ecdsa_sign_t s;
+    // Slot is checked by lt_ecdsa_sign_batch(), it is not used for hashing.
+    lt_ret_t ret = lt_ecdsa_sign_init(&s, h, TR01_ECC_SLOT_0);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_ecdsa_sign_read(&s, reader, reader_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_ecdsa_sign_digest(&s, msg_hash);
+}
+
+lt_ret_t lt_ecdsa_sign_batch(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, lt_ecdsa_sign_reader_t reader,
+                             const lt_ecdsa_sign_doc_t *docs, const size_t docs_cnt)
+{
+    if (!h || (ecc_slot > TR01_ECC_SLOT_31) || !reader || (!docs && docs_cnt)) {
+        return LT_PARAM_ERR;
+    }
+    for (size_t i = 0; i < docs_cnt; i++) {
+        if (!docs[i].rs) {
+            return LT_PARAM_ERR;
+        }
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+    if (!docs_cnt) {
+        return LT_OK;
+    }
+
+    // Digests of the message being signed by TROPIC01 and of the next one.
+    uint8_t msg_hash[2][LT_SHA256_DIGEST_LENGTH];
+    uint8_t cur = 0;
+
+    lt_ret_t ret = lt_ecdsa_sign_hash_doc(h, reader, docs[0].reader_ctx, msg_hash[cur]);
+
+    for (size_t i = 0; (ret == LT_OK) && (i < docs_cnt); i++) {
+        ret = lt_out__ecc_ecdsa_sign_digest(h, ecc_slot, msg_hash[cur]);
+        if (ret != LT_OK) {
+            break;
+        }
+        ret = lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
+        if (ret != LT_OK) {
+            break;
+        }
+
+        // While TROPIC01 signs this message, the next one is hashed.
+        lt_ret_t ret_hash = LT_OK;
+        if (i + 1 < docs_cnt) {
+            ret_hash = lt_ecdsa_sign_hash_doc(h, reader, docs[i + 1].reader_ctx, msg_hash[cur ^ 1]);
+        }
+
+        ret = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_ECDSA_SIGN));
+        if (ret == LT_OK) {
+            ret = lt_in__ecc_ecdsa_sign(h, docs[i].rs);
+        }
+        if (ret == LT_OK) {
+            ret = ret_hash;
+        }
+        cur ^= 1;
+    }
+
+    lt_secure_memzero(msg_hash, sizeof(msg_hash));
+
+    return ret;
+}
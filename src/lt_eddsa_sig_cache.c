@@ -0,0 +1,136 @@
+/**
+ * @file lt_eddsa_sig_cache.c
+ * @brief EdDSA signature cache definitions, deterministic signatures of repeated messages served from the handle
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_eddsa_sig_cache.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_secure_memzero.h"
+#include "lt_sha256.h"
+
+LT_STATIC_ASSERT(LT_EDDSA_SIG_CACHE_SLOTS == TR01_ECC_SLOT_31 + 1)
+LT_STATIC_ASSERT(LT_EDDSA_SIG_CACHE_HASH_LEN == LT_SHA256_DIGEST_LENGTH)
+LT_STATIC_ASSERT(LT_EDDSA_SIG_CACHE_SIG_LEN == TR01_ECDSA_EDDSA_SIGNATURE_LENGTH)
+LT_STATIC_ASSERT(LT_EDDSA_SIG_CACHE_ENTRIES >= 1)
+
+/** Drops all signatures of the cache. */
+static void lt_eddsa_sig_cache_clear(lt_eddsa_sig_cache_t *c)
+{
+    lt_secure_memzero(c->entries, sizeof(c->entries));
+    c->tick = 0;
+}
+
+/** Returns the cache of the handle, dropped first if it belongs to an earlier Secure Session. */
+static lt_eddsa_sig_cache_t *lt_eddsa_sig_cache_of(lt_handle_t *h)
+{
+    lt_eddsa_sig_cache_t *c = &h->l3.eddsa_sig;
+
+    if (c->session_cnt != h->l3.session_cnt) {
+        c->session_cnt = h->l3.session_cnt;
+        lt_eddsa_sig_cache_clear(c);
+    }
+
+    return c;
+}
+
+/** Next LRU tick, the cache is dropped in the rare case the clock wraps around. */
+static uint32_t lt_eddsa_sig_cache_tick(lt_eddsa_sig_cache_t *c)
+{
+    if (c->tick == UINT32_MAX) {
+        lt_eddsa_sig_cache_clear(c);
+    }
+
+    return ++c->tick;
+}
+
+lt_ret_t lt_eddsa_sig_cache_hash(lt_handle_t *h, const uint8_t *msg, const uint16_t msg_len, uint8_t *msg_hash)
+{
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_sha256_start(h->l3.crypto_ctx);
+    if (ret == LT_OK) {
+        ret = lt_sha256_update(h->l3.crypto_ctx, msg, msg_len);
+    }
+    if (ret == LT_OK) {
+        ret = lt_sha256_finish(h->l3.crypto_ctx, msg_hash);
+    }
+
+    lt_ret_t ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
+    LT_UNUSED(ret_unused);
+
+    return ret;
+}
+
+bool lt_eddsa_sig_cache_get(lt_handle_t *h, const lt_ecc_slot_t slot, const uint8_t *msg_hash, uint8_t *rs)
+{
+    lt_eddsa_sig_cache_t *c = lt_eddsa_sig_cache_of(h);
+
+    for (uint16_t i = 0; i < LT_EDDSA_SIG_CACHE_ENTRIES; i++) {
+        lt_eddsa_sig_cache_entry_t *e = &c->entries[i];
+        if (e->last_used && (e->slot == (uint8_t)slot) && (e->gen == c->gen[slot])
+            && !memcmp(e->msg_hash, msg_hash, sizeof(e->msg_hash))) {
+            memcpy(rs, e->rs, sizeof(e->rs));
+            if (c->tick < UINT32_MAX) {
+                e->last_used = ++c->tick;
+            }
+            c->hits++;
+            return true;
+        }
+    }
+    c->misses++;
+
+    return false;
+}
+
+void lt_eddsa_sig_cache_put(lt_handle_t *h, const lt_ecc_slot_t slot, const uint8_t *msg_hash, const uint8_t *rs)
+{
+    lt_eddsa_sig_cache_t *c = lt_eddsa_sig_cache_of(h);
+    const uint32_t tick = lt_eddsa_sig_cache_tick(c);
+
+    // Free entry or the least recently used one, entries of earlier keys are free too.
+    lt_eddsa_sig_cache_entry_t *victim = &c->entries[0];
+    for (uint16_t i = 0; i < LT_EDDSA_SIG_CACHE_ENTRIES; i++) {
+        lt_eddsa_sig_cache_entry_t *e = &c->entries[i];
+        if (!e->last_used || (e->gen != c->gen[e->slot])) {
+            victim = e;
+            break;
+        }
+        if (e->last_used < victim->last_used) {
+            victim = e;
+        }
+    }
+
+    memcpy(victim->msg_hash, msg_hash, sizeof(victim->msg_hash));
+    memcpy(victim->rs, rs, sizeof(victim->rs));
+    victim->slot = (uint8_t)slot;
+    victim->gen = c->gen[slot];
+    victim->last_used = tick;
+}
+
+void lt_eddsa_sig_cache_key_changed(lt_handle_t *h, const lt_ecc_slot_t slot)
+{
+    lt_eddsa_sig_cache_of(h)->gen[slot]++;
+}
+
+lt_ret_t lt_eddsa_sig_cache_invalidate(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_eddsa_sig_cache_clear(&h->l3.eddsa_sig);
+
+    return LT_OK;
+}
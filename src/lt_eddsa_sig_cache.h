@@ -0,0 +1,68 @@
+#ifndef LT_EDDSA_SIG_CACHE_H
+#define LT_EDDSA_SIG_CACHE_H
+
+/**
+ * @file lt_eddsa_sig_cache.h
+ * @brief EdDSA signature cache declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_EDDSA_SIG_CACHE
+/**
+ * @brief Hashes the message by SHA-256 in the crypto context of the handle, for the lookup of its signature.
+ *
+ * @param h         Handle for communication with TROPIC01
+ * @param msg       Message to sign
+ * @param msg_len   Length of the message
+ * @param msg_hash  Buffer for the hash, LT_EDDSA_SIG_CACHE_HASH_LEN bytes
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_eddsa_sig_cache_hash(lt_handle_t *h, const uint8_t *msg, const uint16_t msg_len, uint8_t *msg_hash);
+
+/**
+ * @brief Answers EDDSA_Sign of the message hash with the key in the slot from the cache, if it was signed already.
+ *
+ * @param h         Handle for communication with TROPIC01
+ * @param slot      ECC key slot
+ * @param msg_hash  Hash of the message by lt_eddsa_sig_cache_hash()
+ * @param rs        Buffer for the signature
+ * @return          true if the signature was served from the cache
+ */
+bool lt_eddsa_sig_cache_get(lt_handle_t *h, const lt_ecc_slot_t slot, const uint8_t *msg_hash, uint8_t *rs);
+
+/**
+ * @brief Keeps the signature made by TROPIC01, evicting the least recently used one if the cache is full.
+ *
+ * @param h         Handle for communication with TROPIC01
+ * @param slot      ECC key slot
+ * @param msg_hash  Hash of the message by lt_eddsa_sig_cache_hash()
+ * @param rs        Signature
+ */
+void lt_eddsa_sig_cache_put(lt_handle_t *h, const lt_ecc_slot_t slot, const uint8_t *msg_hash, const uint8_t *rs);
+
+/**
+ * @brief Starts a new generation of the key in the slot, before a command changing the key is sent: signatures of
+ * the earlier key are not served any more.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  ECC key slot
+ */
+void lt_eddsa_sig_cache_key_changed(lt_handle_t *h, const lt_ecc_slot_t slot);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_EDDSA_SIG_CACHE_H
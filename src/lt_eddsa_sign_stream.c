@@ -0,0 +1,115 @@
+/**
+ * @file lt_eddsa_sign_stream.c
+ * @brief EdDSA signing of messages prehashed part by part
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_secure_memzero.h"
+#include "lt_sha256.h"
+
+#ifndef LT_EDDSA_SIGN_READ_CHUNK
+/** Size of the buffer on stack the reader callback fills with the message. */
+#define LT_EDDSA_SIGN_READ_CHUNK 128
+#endif
+
+/** Stops hashing of the message and releases SHA-256 context of the handle. */
+static void lt_eddsa_sign_stop(lt_eddsa_sign_t *s)
+{
+    lt_ret_t ret_unused = lt_sha256_deinit(s->h->l3.crypto_ctx);
+    LT_UNUSED(ret_unused);
+    s->active = 0;
+}
+
+lt_ret_t lt_eddsa_sign_init(lt_eddsa_sign_t *s, lt_handle_t *h, const lt_ecc_slot_t ecc_slot)
+{
+    if (!s || !h || (ecc_slot > TR01_ECC_SLOT_31)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(s, 0, sizeof(lt_eddsa_sign_t));
+    s->h = h;
+    s->slot = (uint8_t)ecc_slot;
+
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    s->active = 1;
+
+    ret = lt_sha256_start(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        lt_eddsa_sign_stop(s);
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_eddsa_sign_update(lt_eddsa_sign_t *s, const uint8_t *data, const size_t len)
+{
+    if (!s || !s->active || (!data && len)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_sha256_update(s->h->l3.crypto_ctx, data, len);
+    if (ret != LT_OK) {
+        lt_eddsa_sign_stop(s);
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_eddsa_sign_read(lt_eddsa_sign_t *s, lt_ecdsa_sign_reader_t reader, void *reader_ctx)
+{
+    if (!s || !s->active || !reader) {
+        return LT_PARAM_ERR;
+    }
+
+    uint8_t buf[LT_EDDSA_SIGN_READ_CHUNK];
+    lt_ret_t ret;
+    size_t read_len;
+    do {
+        read_len = 0;
+        ret = reader(reader_ctx, buf, sizeof(buf), &read_len);
+        if ((ret == LT_OK) && (read_len > sizeof(buf))) {
+            ret = LT_PARAM_ERR;
+        }
+        if (ret != LT_OK) {
+            lt_eddsa_sign_stop(s);
+            break;
+        }
+        ret = lt_eddsa_sign_update(s, buf, read_len);
+    } while ((ret == LT_OK) && read_len);
+
+    lt_secure_memzero(buf, sizeof(buf));
+
+    return ret;
+}
+
+lt_ret_t lt_eddsa_sign_final(lt_eddsa_sign_t *s, uint8_t *rs)
+{
+    if (!s || !s->active) {
+        return LT_PARAM_ERR;
+    }
+    if (!rs) {
+        lt_eddsa_sign_stop(s);
+        return LT_PARAM_ERR;
+    }
+
+    uint8_t msg_hash[LT_SHA256_DIGEST_LENGTH];
+    lt_ret_t ret = lt_sha256_finish(s->h->l3.crypto_ctx, msg_hash);
+    lt_eddsa_sign_stop(s);
+    if (ret == LT_OK) {
+        ret = lt_ecc_eddsa_sign(s->h, (lt_ecc_slot_t)s->slot, msg_hash, sizeof(msg_hash), rs);
+    }
+    lt_secure_memzero(msg_hash, sizeof(msg_hash));
+
+    return ret;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file lt_entropy_pool.c
+ * @brief Entropy pool of TROPIC01 randomness definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_entropy_pool.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_hmac_sha256.h"
+#include "lt_secure_memzero.h"
+
+// Free running counters are mapped to the buffer by modulo, which has to stay consistent when they wrap.
+LT_STATIC_ASSERT((LT_ENTROPY_POOL_SIZE >= 256) && (LT_ENTROPY_POOL_SIZE <= 4096)
+                 && ((LT_ENTROPY_POOL_SIZE & (LT_ENTROPY_POOL_SIZE - 1)) == 0))
+
+// The producer and the consumer may run in different tasks, head is written only by the producer and tail
+// only by the consumer. Acquire/release ordering makes the bytes visible before the counter.
+
+uint16_t lt_entropy_pool_count(const lt_entropy_pool_t *pool)
+{
+    uint32_t head = __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&pool->tail, __ATOMIC_ACQUIRE);
+
+    return (uint16_t)(head - tail);
+}
+
+uint8_t *lt_entropy_pool_space(lt_entropy_pool_t *pool, uint16_t *len)
+{
+    uint32_t offset = pool->head % LT_ENTROPY_POOL_SIZE;
+
+    *len = lt_min((uint16_t)(LT_ENTROPY_POOL_SIZE - lt_entropy_pool_count(pool)),
+                  (uint16_t)(LT_ENTROPY_POOL_SIZE - offset));
+
+    return &pool->buf[offset];
+}
+
+void lt_entropy_pool_publish(lt_entropy_pool_t *pool, const uint16_t len)
+{
+    __atomic_store_n(&pool->head, pool->head + len, __ATOMIC_RELEASE);
+}
+
+bool lt_entropy_pool_take(lt_entropy_pool_t *pool, uint8_t *out, const uint16_t len)
+{
+    if (lt_entropy_pool_count(pool) < len) {
+        return false;
+    }
+
+    // At most two parts, the second one when the bytes wrap around the end of the buffer.
+    uint32_t offset = pool->tail % LT_ENTROPY_POOL_SIZE;
+    uint16_t first = lt_min(len, (uint16_t)(LT_ENTROPY_POOL_SIZE - offset));
+
+    memcpy(out, &pool->buf[offset], first);
+    lt_secure_memzero(&pool->buf[offset], first);
+    memcpy(out + first, pool->buf, len - first);
+    lt_secure_memzero(pool->buf, len - first);
+    __atomic_store_n(&pool->tail, pool->tail + len, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+#ifdef LT_ENTROPY_POOL_DRBG
+/**
+ * @brief V = HMAC(K, V), output of HMAC is not written over its inputs.
+ *
+ * @param pool      Entropy pool with the DRBG state
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_entropy_drbg_next_v(lt_entropy_pool_t *pool)
+{
+    uint8_t v[LT_HMAC_SHA256_HASH_LEN];
+
+    lt_ret_t ret = lt_hmac_sha256(pool->drbg_key, sizeof(pool->drbg_key), pool->drbg_v, sizeof(pool->drbg_v), v);
+    memcpy(pool->drbg_v, v, sizeof(v));
+    lt_secure_memzero(v, sizeof(v));
+
+    return ret;
+}
+
+/**
+ * @brief HMAC_DRBG_Update of NIST SP 800-90A, rev. 1, section 10.1.2.2.
+ *
+ * @param pool      Entropy pool with the DRBG state
+ * @param data      Provided data, NULL if none
+ * @param data_len  Length of data
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_entropy_drbg_update(lt_entropy_pool_t *pool, const uint8_t *data, const uint16_t data_len)
+{
+    uint8_t msg[LT_HMAC_SHA256_HASH_LEN + 1 + LT_ENTROPY_POOL_DRBG_SEED_LEN];
+    uint8_t key[LT_HMAC_SHA256_HASH_LEN];
+    lt_ret_t ret = LT_OK;
+
+    for (uint8_t round = 0; round < 2 && ret == LT_OK; round++) {
+        // K = HMAC(K, V || round || data), V = HMAC(K, V); the second round only with provided data.
+        if (round == 1 && data_len == 0) {
+            break;
+        }
+        memcpy(msg, pool->drbg_v, LT_HMAC_SHA256_HASH_LEN);
+        msg[LT_HMAC_SHA256_HASH_LEN] = round;
+        if (data_len) {
+            memcpy(&msg[LT_HMAC_SHA256_HASH_LEN + 1], data, data_len);
+        }
+        ret = lt_hmac_sha256(pool->drbg_key, sizeof(pool->drbg_key), msg, LT_HMAC_SHA256_HASH_LEN + 1 + data_len, key);
+        if (ret == LT_OK) {
+            memcpy(pool->drbg_key, key, sizeof(key));
+            ret = lt_entropy_drbg_next_v(pool);
+        }
+    }
+
+    lt_secure_memzero(msg, sizeof(msg));
+    lt_secure_memzero(key, sizeof(key));
+    return ret;
+}
+
+lt_ret_t lt_entropy_drbg_reseed(lt_entropy_pool_t *pool, const uint8_t *seed, const uint16_t seed_len)
+{
+    if (seed_len > LT_ENTROPY_POOL_DRBG_SEED_LEN) {
+        return LT_PARAM_ERR;
+    }
+
+    if (!pool->drbg_seeded) {
+        // Instantiate: K = 0x00..., V = 0x01..., then the same update as reseed.
+        memset(pool->drbg_key, 0x00, sizeof(pool->drbg_key));
+        memset(pool->drbg_v, 0x01, sizeof(pool->drbg_v));
+    }
+
+    lt_ret_t ret = lt_entropy_drbg_update(pool, seed, seed_len);
+    pool->drbg_seeded = (ret == LT_OK);
+
+    return ret;
+}
+
+lt_ret_t lt_entropy_drbg_generate(lt_entropy_pool_t *pool, uint8_t *out, const uint16_t len)
+{
+    if (!pool->drbg_seeded) {
+        return LT_FAIL;
+    }
+
+    lt_ret_t ret = LT_OK;
+    for (uint16_t done = 0; done < len && ret == LT_OK; done += LT_HMAC_SHA256_HASH_LEN) {
+        ret = lt_entropy_drbg_next_v(pool);
+        memcpy(&out[done], pool->drbg_v, lt_min((uint16_t)(len - done), (uint16_t)LT_HMAC_SHA256_HASH_LEN));
+    }
+
+    // Backtracking resistance: state is updated after every generate request.
+    if (ret == LT_OK) {
+        ret = lt_entropy_drbg_update(pool, NULL, 0);
+    }
+    if (ret != LT_OK) {
+        lt_secure_memzero(out, len);
+        pool->drbg_seeded = false;
+    }
+
+    return ret;
+}
+#endif
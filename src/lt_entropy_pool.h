@@ -0,0 +1,87 @@
+#ifndef LT_ENTROPY_POOL_H
+#define LT_ENTROPY_POOL_H
+
+/**
+ * @file lt_entropy_pool.h
+ * @brief Entropy pool of TROPIC01 randomness declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Returns number of random bytes in the pool.
+ *
+ * @param pool    Entropy pool
+ * @return        Number of bytes
+ */
+uint16_t lt_entropy_pool_count(const lt_entropy_pool_t *pool);
+
+/**
+ * @brief Returns contiguous free space for the next random bytes, they become available by lt_entropy_pool_publish().
+ * @note Called only by the producer (lt_entropy_pool_refill()).
+ *
+ * @param pool    Entropy pool
+ * @param len     Length of the free space is returned here, 0 if the pool is full
+ * @return        Start of the free space
+ */
+uint8_t *lt_entropy_pool_space(lt_entropy_pool_t *pool, uint16_t *len);
+
+/**
+ * @brief Makes len bytes written into lt_entropy_pool_space() available.
+ * @note Called only by the producer (lt_entropy_pool_refill()).
+ *
+ * @param pool    Entropy pool
+ * @param len     Number of bytes written
+ */
+void lt_entropy_pool_publish(lt_entropy_pool_t *pool, const uint16_t len);
+
+/**
+ * @brief Takes the oldest len bytes out of the pool and wipes them in the pool.
+ * @note Called only by the consumer (lt_entropy_pool_get()).
+ *
+ * @param pool    Entropy pool
+ * @param out     Random bytes are returned here
+ * @param len     Number of bytes
+ * @return        true if the bytes were taken, false if the pool holds less than len bytes
+ */
+bool lt_entropy_pool_take(lt_entropy_pool_t *pool, uint8_t *out, const uint16_t len);
+
+#ifdef LT_ENTROPY_POOL_DRBG
+/**
+ * @brief Mixes seed material into the HMAC-DRBG state (NIST SP 800-90A), instantiates it on first use.
+ *
+ * @param pool      Entropy pool
+ * @param seed      Seed material (TROPIC01 randomness)
+ * @param seed_len  Length of seed, at most LT_ENTROPY_POOL_DRBG_SEED_LEN
+ * @return          LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_entropy_drbg_reseed(lt_entropy_pool_t *pool, const uint8_t *seed, const uint16_t seed_len)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Generates bytes from the HMAC-DRBG state (one generate request, state is updated afterwards).
+ *
+ * @param pool    Entropy pool
+ * @param out     Output buffer
+ * @param len     Number of bytes
+ * @return        LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_entropy_drbg_generate(lt_entropy_pool_t *pool, uint8_t *out, const uint16_t len)
+    __attribute__((warn_unused_result));
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_ENTROPY_POOL_H
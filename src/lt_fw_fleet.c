@@ -0,0 +1,298 @@
+/**
+ * @file lt_fw_fleet.c
+ * @brief Mutable firmware update of several TROPIC01 devices with one image
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_macros.h"
+#include "lt_l2_api_structs.h"
+#include "lt_port_wrap.h"
+
+#ifndef LT_L2_ASYNC
+#error "LT_FW_FLEET requires LT_L2_ASYNC"
+#endif
+
+#ifdef ABAB
+/** Size of the image part written by one Mutable_FW_Update L2 Request, same as in lt_mutable_fw_update(). */
+#define LT_FW_FLEET_ABAB_CHUNK_LEN 128
+
+/** Tells whether L2 Requests of the update start at the offset. */
+static bool lt_fw_fleet_boundary(const lt_fw_fleet_t *f, const uint16_t offset)
+{
+    return (offset <= f->update_data_size) && ((offset % LT_FW_FLEET_ABAB_CHUNK_LEN) == 0);
+}
+
+/** Prepares the next L2 Request of the update in the L2 buffer of the device. */
+static void lt_fw_fleet_prepare(const lt_fw_fleet_t *f, lt_fw_fleet_dev_t *dev)
+{
+    if (!dev->erased) {
+        struct lt_l2_mutable_fw_erase_req_t *p_l2_req = (struct lt_l2_mutable_fw_erase_req_t *)dev->h->l2.buff;
+
+        p_l2_req->req_id = TR01_L2_MUTABLE_FW_ERASE_REQ_ID;
+        p_l2_req->req_len = TR01_L2_MUTABLE_FW_ERASE_REQ_LEN;
+        p_l2_req->bank_id = f->bank_id;
+        dev->next = dev->offset;
+        return;
+    }
+
+    struct lt_l2_mutable_fw_update_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_req_t *)dev->h->l2.buff;
+    uint16_t chunk_len = lt_min((uint16_t)(f->update_data_size - dev->offset), (uint16_t)LT_FW_FLEET_ABAB_CHUNK_LEN);
+
+    p_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_REQ_ID;
+    p_l2_req->req_len = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN_MIN + chunk_len;
+    p_l2_req->bank_id = f->bank_id;
+    p_l2_req->offset = dev->offset;
+    memcpy(p_l2_req->data, f->update_data + dev->offset, chunk_len);
+    dev->next = dev->offset + chunk_len;
+}
+#elif ACAB
+/** Size of the update 'request' at the beginning of the image, including its length byte. */
+#define LT_FW_FLEET_ACAB_REQ_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1U)
+
+/** Returns size of the L2 Request of the image at the offset including its length byte, 0 if it is malformed. */
+static uint16_t lt_fw_fleet_chunk_size(const uint8_t *update_data, const uint16_t update_data_size,
+                                       const uint16_t offset)
+{
+    const size_t dest_capacity = sizeof(struct lt_l2_mutable_fw_update_data_req_t)
+                                 - offsetof(struct lt_l2_mutable_fw_update_data_req_t, req_len);
+
+    if (offset == 0) {
+        return (update_data[0] == TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN) ? LT_FW_FLEET_ACAB_REQ_SIZE : 0;
+    }
+
+    uint16_t copy_len = (uint16_t)(update_data[offset] + 1U);
+    if ((copy_len > update_data_size - offset) || (copy_len > dest_capacity)) {
+        return 0;
+    }
+
+    return copy_len;
+}
+
+/** Tells whether L2 Requests of the update start at the offset, the chunks are walked from the beginning. */
+static bool lt_fw_fleet_boundary(const lt_fw_fleet_t *f, const uint16_t offset)
+{
+    uint16_t pos = 0;
+
+    while ((pos < offset) && (pos < f->update_data_size)) {
+        pos += lt_fw_fleet_chunk_size(f->update_data, f->update_data_size, pos);
+    }
+
+    return pos == offset;
+}
+
+/** Prepares the next L2 Request of the update in the L2 buffer of the device, the image was validated already. */
+static void lt_fw_fleet_prepare(const lt_fw_fleet_t *f, lt_fw_fleet_dev_t *dev)
+{
+    // Both requests have the length byte at the same position, followed by the data of the image.
+    struct lt_l2_mutable_fw_update_data_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_data_req_t *)dev->h->l2.buff;
+    uint16_t copy_len = lt_fw_fleet_chunk_size(f->update_data, f->update_data_size, dev->offset);
+
+    p_l2_req->req_id = (dev->offset == 0) ? TR01_L2_MUTABLE_FW_UPDATE_REQ_ID : TR01_L2_MUTABLE_FW_UPDATE_DATA_REQ;
+    memcpy((uint8_t *)&p_l2_req->req_len, f->update_data + dev->offset, copy_len);
+    dev->next = dev->offset + copy_len;
+}
+#else
+#error "Undefined silicon revision. Please define either ABAB or ACAB."
+#endif
+
+/** Finishes update of the device and reports it. */
+static void lt_fw_fleet_finish(lt_fw_fleet_dev_t *dev, const lt_ret_t ret)
+{
+    dev->ret = ret;
+    if (dev->cb) {
+        dev->cb(dev->h, ret, dev->offset, dev->cb_ctx);
+    }
+}
+
+static void lt_fw_fleet_done(lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx);
+
+/** Sends the next L2 Request of the update, or finishes the device once the whole image was accepted. */
+static void lt_fw_fleet_start(lt_fw_fleet_dev_t *dev)
+{
+    const lt_fw_fleet_t *f = dev->f;
+
+    if (dev->erased && (dev->offset == f->update_data_size)) {
+        lt_fw_fleet_finish(dev, LT_OK);
+        return;
+    }
+
+    lt_fw_fleet_prepare(f, dev);
+    lt_ret_t ret = lt_l2_async_send(dev->op, &dev->h->l2, lt_fw_fleet_done, dev);
+    if (ret != LT_OK) {
+        lt_fw_fleet_finish(dev, ret);
+    }
+}
+
+/** Completion of L2 Request of the device, the next one is sent right away. */
+static void lt_fw_fleet_done(lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx)
+{
+    lt_fw_fleet_dev_t *dev = (lt_fw_fleet_dev_t *)cb_ctx;
+    const struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp
+        = (const struct lt_l2_mutable_fw_update_rsp_t *)dev->h->l2.buff;
+
+    LT_UNUSED(op);
+
+    dev->f->steps++;
+
+    if ((ret == LT_OK) && (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len))) {
+        ret = LT_L2_RSP_LEN_ERROR;
+    }
+    if (ret != LT_OK) {
+        lt_fw_fleet_finish(dev, ret);
+        return;
+    }
+
+    dev->offset = dev->next;
+    dev->erased = true;
+    lt_fw_fleet_start(dev);
+}
+
+lt_ret_t lt_fw_fleet_init(lt_fw_fleet_t *f, const uint8_t *update_data, const uint16_t update_data_size,
+                          const lt_bank_id_t bank_id)
+{
+    if (!f || !update_data || (update_data_size > TR01_MUTABLE_FW_UPDATE_SIZE_MAX)) {
+        return LT_PARAM_ERR;
+    }
+#ifdef ABAB
+    if ((bank_id != TR01_FW_BANK_FW1) && (bank_id != TR01_FW_BANK_FW2) && (bank_id != TR01_FW_BANK_SPECT1)
+        && (bank_id != TR01_FW_BANK_SPECT2)) {
+        return LT_PARAM_ERR;
+    }
+#elif ACAB
+    if (update_data_size <= LT_FW_FLEET_ACAB_REQ_SIZE) {
+        return LT_PARAM_ERR;
+    }
+    // Malformed image is refused before any device gets a part of it.
+    for (uint16_t pos = 0; pos < update_data_size;) {
+        uint16_t copy_len = lt_fw_fleet_chunk_size(update_data, update_data_size, pos);
+        if (copy_len == 0) {
+            return LT_PARAM_ERR;
+        }
+        pos += copy_len;
+    }
+#endif
+
+    memset(f, 0, sizeof(*f));
+    f->update_data = update_data;
+    f->update_data_size = update_data_size;
+    f->bank_id = bank_id;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_fleet_add_device(lt_fw_fleet_t *f, lt_handle_t *h, lt_l2_async_t *op, const uint16_t offset,
+                                lt_fw_fleet_cb_t cb, void *cb_ctx)
+{
+    if (!f || !f->update_data || !h || !op || lt_l2_async_busy(op) || !lt_fw_fleet_boundary(f, offset)) {
+        return LT_PARAM_ERR;
+    }
+    if (f->dev_cnt == LT_FW_FLEET_MAX_DEVICES) {
+        return LT_FAIL;
+    }
+
+    lt_fw_fleet_dev_t *dev = &f->devs[f->dev_cnt++];
+    memset(dev, 0, sizeof(*dev));
+    dev->f = f;
+    dev->h = h;
+    dev->op = op;
+    dev->cb = cb;
+    dev->cb_ctx = cb_ctx;
+    dev->offset = offset;
+#ifdef ABAB
+    // Resumed update writes into the bank erased at its beginning.
+    dev->erased = (offset != 0);
+#else
+    dev->erased = true;
+#endif
+    dev->ret = LT_L1_CHIP_BUSY;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_fleet_process(lt_fw_fleet_t *f)
+{
+    if (!f) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t i = 0; i < f->dev_cnt; i++) {
+        lt_fw_fleet_dev_t *dev = &f->devs[i];
+        if (dev->ret != LT_L1_CHIP_BUSY) {
+            continue;
+        }
+
+        if (lt_l2_async_busy(dev->op)) {
+            // Next part of the image is sent by lt_fw_fleet_done().
+            (void)lt_l2_async_process(dev->op);
+        }
+        else {
+            f->steps++;
+            lt_fw_fleet_start(dev);
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_fleet_run(lt_fw_fleet_t *f)
+{
+    if (!f) {
+        return LT_PARAM_ERR;
+    }
+
+    while (lt_fw_fleet_pending(f)) {
+        uint16_t steps = f->steps;
+        lt_ret_t ret = lt_fw_fleet_process(f);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        if (steps == f->steps) {
+            // All devices are writing their chunks, give TROPIC01 time before the next attempt.
+            ret = lt_l1_delay(&f->devs[0].h->l2, 1);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+    }
+
+    return LT_OK;
+}
+
+uint8_t lt_fw_fleet_pending(const lt_fw_fleet_t *f)
+{
+    if (!f) {
+        return 0;
+    }
+
+    uint8_t pending = 0;
+    for (uint8_t i = 0; i < f->dev_cnt; i++) {
+        if (f->devs[i].ret == LT_L1_CHIP_BUSY) {
+            pending++;
+        }
+    }
+
+    return pending;
+}
+
+lt_ret_t lt_fw_fleet_progress(const lt_fw_fleet_t *f, const uint8_t idx, uint16_t *offset)
+{
+    if (!f || (idx >= f->dev_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    if (offset) {
+        *offset = f->devs[idx].offset;
+    }
+
+    return f->devs[idx].ret;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file lt_fw_image.c
+ * @brief Mutable firmware update image read by parts from a file, flash partition or other storage
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_macros.h"
+#include "lt_l2_api_structs.h"
+
+#ifdef ABAB
+/** Size of the image part written by one Mutable_FW_Update L2 Request, same as in lt_mutable_fw_update(). */
+#define LT_FW_IMAGE_ABAB_CHUNK_LEN 128
+
+lt_ret_t lt_fw_image_open(lt_fw_image_t *img, lt_fw_image_read_t read, void *read_ctx, const uint16_t size,
+                          uint16_t *index, const uint16_t index_len)
+{
+    // Chunks of ABAB images are at fixed offsets, the index is not used.
+    LT_UNUSED(index);
+    LT_UNUSED(index_len);
+
+    if (!img || !read || (size == 0) || (size > TR01_MUTABLE_FW_UPDATE_SIZE_MAX)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(img, 0, sizeof(*img));
+    img->read = read;
+    img->read_ctx = read_ctx;
+    img->size = size;
+    img->chunk_cnt = (uint16_t)((size + LT_FW_IMAGE_ABAB_CHUNK_LEN - 1) / LT_FW_IMAGE_ABAB_CHUNK_LEN);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_image_chunk(const lt_fw_image_t *img, const uint16_t idx, uint16_t *offset, uint16_t *len)
+{
+    if (!img || !offset || (idx >= img->chunk_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    *offset = (uint16_t)(idx * LT_FW_IMAGE_ABAB_CHUNK_LEN);
+    if (len) {
+        *len = lt_min((uint16_t)(img->size - *offset), (uint16_t)LT_FW_IMAGE_ABAB_CHUNK_LEN);
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_image_update(lt_handle_t *h, const lt_fw_image_t *img, const lt_bank_id_t bank_id,
+                            const uint16_t first_chunk, uint16_t *next_chunk)
+{
+    if (!h || !img || !img->read || (first_chunk > img->chunk_cnt)
+        || ((bank_id != TR01_FW_BANK_FW1) && (bank_id != TR01_FW_BANK_FW2) && (bank_id != TR01_FW_BANK_SPECT1)
+            && (bank_id != TR01_FW_BANK_SPECT2))) {
+        return LT_PARAM_ERR;
+    }
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_mutable_fw_update_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
+
+    if (next_chunk) {
+        *next_chunk = first_chunk;
+    }
+
+    lt_ret_t ret;
+    if (first_chunk == 0) {
+        ret = lt_mutable_fw_erase(h, bank_id);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    for (uint16_t i = first_chunk; i < img->chunk_cnt; i++) {
+        uint16_t offset, len;
+        ret = lt_fw_image_chunk(img, i, &offset, &len);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        // The chunk is read right to the L2 Request frame.
+        ret = img->read(img->read_ctx, offset, p_l2_req->data, len);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        p_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_REQ_ID;
+        p_l2_req->req_len = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN_MIN + len;
+        p_l2_req->bank_id = bank_id;
+        p_l2_req->offset = offset;
+
+        ret = lt_l2_send(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        ret = lt_l2_receive(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
+            return LT_L2_RSP_LEN_ERROR;
+        }
+        if (next_chunk) {
+            *next_chunk = i + 1;
+        }
+    }
+
+    return LT_OK;
+}
+#elif ACAB
+/** Size of the update 'request' at the beginning of the image, including its length byte. */
+#define LT_FW_IMAGE_ACAB_REQ_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1U)
+
+/** Reads length of the chunk at the offset including its length byte, LT_PARAM_ERR if it does not fit. */
+static lt_ret_t lt_fw_image_chunk_len(const lt_fw_image_t *img, const uint16_t offset, uint16_t *len)
+{
+    const size_t dest_capacity = sizeof(struct lt_l2_mutable_fw_update_data_req_t)
+                                 - offsetof(struct lt_l2_mutable_fw_update_data_req_t, req_len);
+
+    if (offset == 0) {
+        *len = LT_FW_IMAGE_ACAB_REQ_SIZE;
+        return LT_OK;
+    }
+
+    uint8_t len_byte;
+    lt_ret_t ret = img->read(img->read_ctx, offset, &len_byte, sizeof(len_byte));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    uint16_t copy_len = (uint16_t)(len_byte + 1U);
+    if ((copy_len > img->size - offset) || (copy_len > dest_capacity)) {
+        return LT_PARAM_ERR;
+    }
+    *len = copy_len;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_image_open(lt_fw_image_t *img, lt_fw_image_read_t read, void *read_ctx, const uint16_t size,
+                          uint16_t *index, const uint16_t index_len)
+{
+    if (!img || !read || (size <= LT_FW_IMAGE_ACAB_REQ_SIZE) || (size > TR01_MUTABLE_FW_UPDATE_SIZE_MAX)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(img, 0, sizeof(*img));
+    img->read = read;
+    img->read_ctx = read_ctx;
+    img->size = size;
+
+    uint8_t req_len;
+    lt_ret_t ret = read(read_ctx, 0, &req_len, sizeof(req_len));
+    if (ret == LT_OK && req_len != TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN) {
+        ret = LT_PARAM_ERR;
+    }
+
+    // Only the length bytes are read, the chunks are read when sent.
+    uint16_t len;
+    for (uint16_t pos = 0; (ret == LT_OK) && (pos < size); pos += len) {
+        ret = lt_fw_image_chunk_len(img, pos, &len);
+        if ((ret == LT_OK) && index && (img->chunk_cnt < index_len)) {
+            index[img->chunk_cnt] = pos;
+        }
+        img->chunk_cnt++;
+    }
+    if (ret != LT_OK) {
+        memset(img, 0, sizeof(*img));
+        return ret;
+    }
+
+    img->index = index;
+    img->index_len = index ? lt_min(index_len, img->chunk_cnt) : 0;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_image_chunk(const lt_fw_image_t *img, const uint16_t idx, uint16_t *offset, uint16_t *len)
+{
+    if (!img || !img->read || !offset || (idx >= img->chunk_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    // Walk the lengths from the nearest indexed chunk.
+    uint16_t i = 0;
+    uint16_t pos = 0;
+    if (img->index_len > 0) {
+        i = lt_min(idx, (uint16_t)(img->index_len - 1));
+        pos = img->index[i];
+    }
+
+    uint16_t chunk_len;
+    lt_ret_t ret = lt_fw_image_chunk_len(img, pos, &chunk_len);
+    for (; (ret == LT_OK) && (i < idx); i++) {
+        pos += chunk_len;
+        ret = lt_fw_image_chunk_len(img, pos, &chunk_len);
+    }
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    *offset = pos;
+    if (len) {
+        *len = chunk_len;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_image_update(lt_handle_t *h, const lt_fw_image_t *img, const lt_bank_id_t bank_id,
+                            const uint16_t first_chunk, uint16_t *next_chunk)
+{
+    LT_UNUSED(bank_id);  // bank_id is not used with ACAB, chip handles banks on its own
+    if (!h || !img || !img->read || (first_chunk > img->chunk_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    // Setup a request pointer to l2 buffer, which is placed in handle
+    struct lt_l2_mutable_fw_update_data_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_data_req_t *)h->l2.buff;
+    // Setup a request pointer to l2 buffer with response data
+    struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
+
+    if (next_chunk) {
+        *next_chunk = first_chunk;
+    }
+    if (first_chunk == img->chunk_cnt) {
+        return LT_OK;
+    }
+
+    uint16_t offset, len;
+    lt_ret_t ret = lt_fw_image_chunk(img, first_chunk, &offset, &len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    for (uint16_t i = first_chunk; i < img->chunk_cnt; i++) {
+        if (i > first_chunk) {
+            offset += len;
+            ret = lt_fw_image_chunk_len(img, offset, &len);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+
+        // Update request and data chunks have the length byte at the same position, the chunk is read right to the
+        // L2 Request frame.
+        ret = img->read(img->read_ctx, offset, (uint8_t *)&p_l2_req->req_len, len);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        p_l2_req->req_id = (offset == 0) ? TR01_L2_MUTABLE_FW_UPDATE_REQ_ID : TR01_L2_MUTABLE_FW_UPDATE_DATA_REQ;
+
+        ret = lt_l2_send(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        ret = lt_l2_receive(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
+            return LT_L2_RSP_LEN_ERROR;
+        }
+        if (next_chunk) {
+            *next_chunk = i + 1;
+        }
+    }
+
+    return LT_OK;
+}
+#else
+#error "Undefined silicon revision. Please define either ABAB or ACAB."
+#endif
+
+uint16_t lt_fw_image_chunk_count(const lt_fw_image_t *img) { return img ? img->chunk_cnt : 0; }
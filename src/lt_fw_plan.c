@@ -0,0 +1,266 @@
+/**
+ * @file lt_fw_plan.c
+ * @brief Mutable firmware update of several banks, host preparation of the images overlaps with the bank erase
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_macros.h"
+#include "lt_l2_api_structs.h"
+
+#ifndef LT_CMD_FW_UPDATE
+#error "LT_FW_PLAN requires LT_CMD_FW_UPDATE"
+#endif
+
+/** Reports progress of the step in progress. */
+static void lt_fw_plan_report(const lt_fw_plan_t *p, const uint8_t step, const lt_fw_plan_phase_t phase)
+{
+    if (p->progress) {
+        const uint16_t offset = (step == p->step) ? p->offset : 0;
+        p->progress(p->cb_ctx, step, phase, offset, p->steps[step].update_data_size);
+    }
+}
+
+/** Prepares the image of the step by the prepare callback, unless it is there already. */
+static lt_ret_t lt_fw_plan_prepare(lt_fw_plan_t *p, const uint8_t step)
+{
+    lt_fw_plan_step_t *st = &p->steps[step];
+
+    if (st->update_data) {
+        return LT_OK;
+    }
+
+    const uint8_t *update_data = NULL;
+    uint16_t update_data_size = 0;
+    lt_ret_t ret = p->prepare(p->cb_ctx, step, st->bank_id, &update_data, &update_data_size);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (!update_data || (update_data_size == 0) || (update_data_size > TR01_MUTABLE_FW_UPDATE_SIZE_MAX)) {
+        return LT_PARAM_ERR;
+    }
+
+    st->update_data = update_data;
+    st->update_data_size = update_data_size;
+    lt_fw_plan_report(p, step, LT_FW_PLAN_PHASE_PREPARED);
+
+    return LT_OK;
+}
+
+/** Receives response to Mutable_FW_Erase or Mutable_FW_Update(_Data), ret_prepare is returned if it was received. */
+static lt_ret_t lt_fw_plan_receive(lt_handle_t *h, const lt_ret_t ret_prepare)
+{
+    // Erase and update responses have no data, their lengths are the same.
+    const struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (const struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
+
+    // The response is received also when the preparation failed, so it is not left in TROPIC01.
+    lt_ret_t ret = lt_l2_receive(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    return ret_prepare;
+}
+
+#ifdef ABAB
+/** Size of the image part written by one Mutable_FW_Update L2 Request, same as in lt_mutable_fw_update(). */
+#define LT_FW_PLAN_ABAB_CHUNK_LEN 128
+
+/** Erases the bank of the step while its image is prepared, then writes the image. */
+static lt_ret_t lt_fw_plan_step(lt_handle_t *h, lt_fw_plan_t *p)
+{
+    lt_fw_plan_step_t *st = &p->steps[p->step];
+    struct lt_l2_mutable_fw_erase_req_t *p_erase_req = (struct lt_l2_mutable_fw_erase_req_t *)h->l2.buff;
+    struct lt_l2_mutable_fw_update_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_req_t *)h->l2.buff;
+
+    p_erase_req->req_id = TR01_L2_MUTABLE_FW_ERASE_REQ_ID;
+    p_erase_req->req_len = TR01_L2_MUTABLE_FW_ERASE_REQ_LEN;
+    p_erase_req->bank_id = st->bank_id;
+
+    lt_ret_t ret = lt_l2_send(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_fw_plan_receive(h, lt_fw_plan_prepare(p, p->step));
+    if (ret != LT_OK) {
+        return ret;
+    }
+    lt_fw_plan_report(p, p->step, LT_FW_PLAN_PHASE_ERASED);
+
+    while (p->offset < st->update_data_size) {
+        uint16_t chunk_len = lt_min((uint16_t)(st->update_data_size - p->offset), (uint16_t)LT_FW_PLAN_ABAB_CHUNK_LEN);
+
+        p_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_REQ_ID;
+        p_l2_req->req_len = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN_MIN + chunk_len;
+        p_l2_req->bank_id = st->bank_id;
+        p_l2_req->offset = p->offset;
+        memcpy(p_l2_req->data, st->update_data + p->offset, chunk_len);
+
+        ret = lt_l2_send(&h->l2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        ret = lt_fw_plan_receive(h, LT_OK);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        p->offset += chunk_len;
+        lt_fw_plan_report(p, p->step, LT_FW_PLAN_PHASE_WRITE);
+    }
+
+    return LT_OK;
+}
+#elif ACAB
+/** Size of the update 'request' at the beginning of the image, including its length byte. */
+#define LT_FW_PLAN_ACAB_REQ_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1U)
+
+/** Sends the update request of the step while the image of the next step is prepared, then writes the data chunks. */
+static lt_ret_t lt_fw_plan_step(lt_handle_t *h, lt_fw_plan_t *p)
+{
+    const size_t dest_capacity = sizeof(struct lt_l2_mutable_fw_update_data_req_t)
+                                 - offsetof(struct lt_l2_mutable_fw_update_data_req_t, req_len);
+    lt_fw_plan_step_t *st = &p->steps[p->step];
+    // Both requests have the length byte at the same position, followed by the data of the image.
+    struct lt_l2_mutable_fw_update_data_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_data_req_t *)h->l2.buff;
+
+    // The update request is a part of the image, so only the first step cannot overlap its preparation.
+    lt_ret_t ret = lt_fw_plan_prepare(p, p->step);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if ((st->update_data_size <= LT_FW_PLAN_ACAB_REQ_SIZE)
+        || (st->update_data[0] != TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN)) {
+        return LT_PARAM_ERR;
+    }
+
+    p_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_REQ_ID;
+    memcpy((uint8_t *)&p_l2_req->req_len, st->update_data, LT_FW_PLAN_ACAB_REQ_SIZE);
+
+    ret = lt_l2_send(&h->l2);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    const bool next = (uint8_t)(p->step + 1) < p->step_cnt;
+    ret = lt_fw_plan_receive(h, next ? lt_fw_plan_prepare(p, (uint8_t)(p->step + 1)) : LT_OK);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    p->offset = LT_FW_PLAN_ACAB_REQ_SIZE;
+    lt_fw_plan_report(p, p->step, LT_FW_PLAN_PHASE_ERASED);
+
+    while (p->offset < st->update_data_size) {
+        const size_t copy_len = (size_t)st->update_data[p->offset] + 1U;
+        if ((copy_len > (size_t)(st->update_data_size - p->offset)) || (copy_len > dest_capacity)) {
+            return LT_PARAM_ERR;
+        }
+
+        ret = lt_mutable_fw_update_data_chunk(h, st->update_data + p->offset);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        p->offset += (uint16_t)copy_len;
+        lt_fw_plan_report(p, p->step, LT_FW_PLAN_PHASE_WRITE);
+    }
+
+    return LT_OK;
+}
+#else
+#error "Undefined silicon revision. Please define either ABAB or ACAB."
+#endif
+
+lt_ret_t lt_fw_plan_init(lt_fw_plan_t *p, lt_fw_plan_prepare_t prepare, lt_fw_plan_progress_t progress, void *cb_ctx)
+{
+    if (!p) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(p, 0, sizeof(*p));
+    p->prepare = prepare;
+    p->progress = progress;
+    p->cb_ctx = cb_ctx;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_plan_add(lt_fw_plan_t *p, const lt_bank_id_t bank_id, const uint8_t *update_data,
+                        const uint16_t update_data_size)
+{
+    if (!p || (!update_data && !p->prepare)
+        || (update_data && ((update_data_size == 0) || (update_data_size > TR01_MUTABLE_FW_UPDATE_SIZE_MAX)))) {
+        return LT_PARAM_ERR;
+    }
+#ifdef ABAB
+    if ((bank_id != TR01_FW_BANK_FW1) && (bank_id != TR01_FW_BANK_FW2) && (bank_id != TR01_FW_BANK_SPECT1)
+        && (bank_id != TR01_FW_BANK_SPECT2)) {
+        return LT_PARAM_ERR;
+    }
+#endif
+    if (p->step_cnt == LT_FW_PLAN_MAX_STEPS) {
+        return LT_FAIL;
+    }
+
+    lt_fw_plan_step_t *st = &p->steps[p->step_cnt++];
+    st->update_data = update_data;
+    st->update_data_size = update_data ? update_data_size : 0;
+    st->bank_id = bank_id;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_plan_run(lt_handle_t *h, lt_fw_plan_t *p)
+{
+    if (!h || !p) {
+        return LT_PARAM_ERR;
+    }
+
+#ifdef LT_SILICON_REV_CHECK
+    lt_ret_t ret_rev = lt_silicon_rev_check(h);
+    if (ret_rev != LT_OK) {
+        return ret_rev;
+    }
+#endif
+
+    while (p->step < p->step_cnt) {
+        // A failed step is repeated from its beginning, i.e. from the erase of its bank.
+        p->offset = 0;
+        lt_ret_t ret = lt_fw_plan_step(h, p);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        lt_fw_plan_report(p, p->step, LT_FW_PLAN_PHASE_DONE);
+        p->step++;
+        p->offset = 0;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_plan_progress(const lt_fw_plan_t *p, uint8_t *step, uint16_t *offset)
+{
+    if (!p) {
+        return LT_PARAM_ERR;
+    }
+
+    if (step) {
+        *step = p->step;
+    }
+    if (offset) {
+        *offset = p->offset;
+    }
+
+    return (p->step == p->step_cnt) ? LT_OK : LT_L1_CHIP_BUSY;
+}
@@ -0,0 +1,303 @@
+/**
+ * @file lt_fw_update_resume.c
+ * @brief Mutable firmware update resumable after transient errors and restarts of the process
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "lt_crc16.h"
+#include "lt_l2_api_structs.h"
+#include "lt_port_wrap.h"
+
+#ifndef LT_L2_RESEND_MAX_TRIES
+/** Number of attempts to send the L2 Request again after a transient error, same as the number of Resend_Req. */
+#define LT_L2_RESEND_MAX_TRIES 3
+#endif
+#ifndef LT_L2_RESEND_BACKOFF_MS
+/** Delay before the first repeated attempt, doubled with each further one. */
+#define LT_L2_RESEND_BACKOFF_MS 0
+#endif
+
+// crc16() takes signed 16-bit length.
+LT_STATIC_ASSERT(sizeof(lt_fw_update_checkpoint_t) - offsetof(lt_fw_update_checkpoint_t, image_size) <= INT16_MAX)
+
+#ifdef ABAB
+/** Size of the image part written by one Mutable_FW_Update L2 Request, same as in lt_mutable_fw_update(). */
+#define LT_FW_UPDATE_ABAB_CHUNK_LEN 128
+
+/** Tells whether L2 Requests of the update start at the offset. */
+static bool lt_fw_update_boundary(const uint8_t *update_data, const uint16_t update_data_size, const uint16_t offset)
+{
+    LT_UNUSED(update_data);
+
+    return (offset <= update_data_size) && ((offset % LT_FW_UPDATE_ABAB_CHUNK_LEN) == 0);
+}
+
+/** Prepares the next L2 Request of the update in the L2 buffer, returns offset in the image after it. */
+static uint16_t lt_fw_update_prepare(lt_handle_t *h, const lt_fw_update_session_t *s)
+{
+    if (!s->cp.erased) {
+        struct lt_l2_mutable_fw_erase_req_t *p_l2_req = (struct lt_l2_mutable_fw_erase_req_t *)h->l2.buff;
+
+        p_l2_req->req_id = TR01_L2_MUTABLE_FW_ERASE_REQ_ID;
+        p_l2_req->req_len = TR01_L2_MUTABLE_FW_ERASE_REQ_LEN;
+        p_l2_req->bank_id = s->cp.bank_id;
+        return s->cp.offset;
+    }
+
+    struct lt_l2_mutable_fw_update_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_req_t *)h->l2.buff;
+    uint16_t chunk_len = lt_min((uint16_t)(s->cp.image_size - s->cp.offset), (uint16_t)LT_FW_UPDATE_ABAB_CHUNK_LEN);
+
+    p_l2_req->req_id = TR01_L2_MUTABLE_FW_UPDATE_REQ_ID;
+    p_l2_req->req_len = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN_MIN + chunk_len;
+    p_l2_req->bank_id = s->cp.bank_id;
+    p_l2_req->offset = s->cp.offset;
+    memcpy(p_l2_req->data, s->update_data + s->cp.offset, chunk_len);
+
+    return s->cp.offset + chunk_len;
+}
+#elif ACAB
+/** Size of the update 'request' at the beginning of the image, including its length byte. */
+#define LT_FW_UPDATE_ACAB_REQ_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1U)
+
+/** Returns size of the L2 Request of the image at the offset including its length byte, 0 if it is malformed. */
+static uint16_t lt_fw_update_chunk_size(const uint8_t *update_data, const uint16_t update_data_size,
+                                        const uint16_t offset)
+{
+    const size_t dest_capacity = sizeof(struct lt_l2_mutable_fw_update_data_req_t)
+                                 - offsetof(struct lt_l2_mutable_fw_update_data_req_t, req_len);
+
+    if (offset == 0) {
+        return (update_data[0] == TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN) ? LT_FW_UPDATE_ACAB_REQ_SIZE : 0;
+    }
+
+    uint16_t copy_len = (uint16_t)(update_data[offset] + 1U);
+    if ((copy_len > update_data_size - offset) || (copy_len > dest_capacity)) {
+        return 0;
+    }
+
+    return copy_len;
+}
+
+/** Tells whether L2 Requests of the validated image start at the offset, the chunks are walked from the beginning. */
+static bool lt_fw_update_boundary(const uint8_t *update_data, const uint16_t update_data_size, const uint16_t offset)
+{
+    uint16_t pos = 0;
+
+    while ((pos < offset) && (pos < update_data_size)) {
+        pos += lt_fw_update_chunk_size(update_data, update_data_size, pos);
+    }
+
+    return pos == offset;
+}
+
+/** Prepares the next L2 Request of the update in the L2 buffer, returns offset in the image after it. */
+static uint16_t lt_fw_update_prepare(lt_handle_t *h, const lt_fw_update_session_t *s)
+{
+    // Both requests have the length byte at the same position, followed by the data of the image.
+    struct lt_l2_mutable_fw_update_data_req_t *p_l2_req = (struct lt_l2_mutable_fw_update_data_req_t *)h->l2.buff;
+    uint16_t copy_len = lt_fw_update_chunk_size(s->update_data, s->cp.image_size, s->cp.offset);
+
+    p_l2_req->req_id = (s->cp.offset == 0) ? TR01_L2_MUTABLE_FW_UPDATE_REQ_ID : TR01_L2_MUTABLE_FW_UPDATE_DATA_REQ;
+    memcpy((uint8_t *)&p_l2_req->req_len, s->update_data + s->cp.offset, copy_len);
+
+    return s->cp.offset + copy_len;
+}
+#else
+#error "Undefined silicon revision. Please define either ABAB or ACAB."
+#endif
+
+/** CRC16 of the checkpoint, i.e. of everything following the crc field. */
+static uint16_t lt_fw_update_checkpoint_crc(const lt_fw_update_checkpoint_t *cp)
+{
+    return crc16((const uint8_t *)&cp->image_size,
+                 (int16_t)(sizeof(*cp) - offsetof(lt_fw_update_checkpoint_t, image_size)));
+}
+
+/** Errors after which the L2 Request is sent again, TROPIC01 did not accept it or its response was lost. */
+static bool lt_fw_update_transient(const lt_ret_t ret)
+{
+    return (ret == LT_L1_SPI_ERROR) || (ret == LT_L1_CHIP_BUSY) || (ret == LT_L1_INT_TIMEOUT) || (ret == LT_L2_CRC_ERR)
+           || (ret == LT_L2_IN_CRC_ERR);
+}
+
+lt_ret_t lt_fw_update_session_init(lt_fw_update_session_t *s, const uint8_t *update_data,
+                                   const uint16_t update_data_size, const lt_bank_id_t bank_id)
+{
+    if (!s || !update_data || (update_data_size > TR01_MUTABLE_FW_UPDATE_SIZE_MAX)) {
+        return LT_PARAM_ERR;
+    }
+#ifdef ABAB
+    if ((bank_id != TR01_FW_BANK_FW1) && (bank_id != TR01_FW_BANK_FW2) && (bank_id != TR01_FW_BANK_SPECT1)
+        && (bank_id != TR01_FW_BANK_SPECT2)) {
+        return LT_PARAM_ERR;
+    }
+#elif ACAB
+    if (update_data_size <= LT_FW_UPDATE_ACAB_REQ_SIZE) {
+        return LT_PARAM_ERR;
+    }
+    // Malformed image is refused before any part of it is sent.
+    for (uint16_t pos = 0; pos < update_data_size;) {
+        uint16_t copy_len = lt_fw_update_chunk_size(update_data, update_data_size, pos);
+        if (copy_len == 0) {
+            return LT_PARAM_ERR;
+        }
+        pos += copy_len;
+    }
+#endif
+
+    memset(s, 0, sizeof(*s));
+    s->update_data = update_data;
+    s->cp.magic = LT_FW_UPDATE_CHECKPOINT_MAGIC;
+    s->cp.version = LT_FW_UPDATE_CHECKPOINT_VERSION;
+    s->cp.image_size = update_data_size;
+    s->cp.image_crc = crc16_final(crc16_update(LT_CRC16_INITIAL_VAL, update_data, update_data_size));
+    s->cp.bank_id = (uint8_t)bank_id;
+#ifdef ACAB
+    // ACAB has no erase, the chip handles banks on its own.
+    s->cp.erased = 1;
+#endif
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_update_session_resume(lt_fw_update_session_t *s, const uint8_t *update_data,
+                                     const uint16_t update_data_size, const lt_fw_update_checkpoint_t *cp)
+{
+    if (!cp || (cp->magic != LT_FW_UPDATE_CHECKPOINT_MAGIC) || (cp->version != LT_FW_UPDATE_CHECKPOINT_VERSION)
+        || (cp->crc != lt_fw_update_checkpoint_crc(cp))) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_fw_update_session_init(s, update_data, update_data_size, (lt_bank_id_t)cp->bank_id);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if ((cp->image_size != s->cp.image_size) || (cp->image_crc != s->cp.image_crc)
+        || !lt_fw_update_boundary(update_data, update_data_size, cp->offset)) {
+        LT_LOG_ERROR("FW update checkpoint does not belong to this image");
+        memset(s, 0, sizeof(*s));
+        return LT_PARAM_ERR;
+    }
+
+    s->cp.offset = cp->offset;
+    s->cp.chunks = cp->chunks;
+    s->cp.erased = cp->erased;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_update_session_step(lt_handle_t *h, lt_fw_update_session_t *s)
+{
+    if (!h || !s || !s->update_data) {
+        return LT_PARAM_ERR;
+    }
+    if (lt_fw_update_session_done(s)) {
+        return LT_OK;
+    }
+
+    const struct lt_l2_mutable_fw_update_rsp_t *p_l2_resp = (const struct lt_l2_mutable_fw_update_rsp_t *)h->l2.buff;
+    uint16_t next = 0;
+    lt_ret_t ret = LT_FAIL;
+
+    for (int i = 0; i <= LT_L2_RESEND_MAX_TRIES; i++) {
+        if (i > 0) {
+            s->retries++;
+#if LT_L2_RESEND_BACKOFF_MS > 0
+            // Give the bus some time to settle, the delay doubles with each attempt.
+            lt_ret_t ret_delay = lt_l1_delay(&h->l2, (uint32_t)LT_L2_RESEND_BACKOFF_MS << lt_min(i - 1, 7));
+            if (ret_delay != LT_OK) {
+                return ret_delay;
+            }
+#endif
+        }
+
+        // L2 buffer is overwritten by the response, the request is prepared again for every attempt.
+        next = lt_fw_update_prepare(h, s);
+        ret = lt_l2_send(&h->l2);
+        if (ret == LT_OK) {
+            ret = lt_l2_receive(&h->l2);
+        }
+        if (!lt_fw_update_transient(ret)) {
+            break;
+        }
+    }
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Erase and update responses have the same layout.
+    if (TR01_L2_MUTABLE_FW_UPDATE_RSP_LEN != (p_l2_resp->rsp_len)) {
+        return LT_L2_RSP_LEN_ERROR;
+    }
+
+    if (!s->cp.erased) {
+        s->cp.erased = 1;
+    }
+    else {
+        s->cp.offset = next;
+        s->cp.chunks++;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_update_session_run(lt_handle_t *h, lt_fw_update_session_t *s)
+{
+    if (!h || !s) {
+        return LT_PARAM_ERR;
+    }
+
+    while (!lt_fw_update_session_done(s)) {
+        lt_ret_t ret = lt_fw_update_session_step(h, s);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return LT_OK;
+}
+
+bool lt_fw_update_session_done(const lt_fw_update_session_t *s)
+{
+    return s && s->update_data && s->cp.erased && (s->cp.offset == s->cp.image_size);
+}
+
+lt_ret_t lt_fw_update_session_progress(const lt_fw_update_session_t *s, uint16_t *offset, uint16_t *chunks)
+{
+    if (!s) {
+        return LT_PARAM_ERR;
+    }
+
+    if (offset) {
+        *offset = s->cp.offset;
+    }
+    if (chunks) {
+        *chunks = s->cp.chunks;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_fw_update_session_checkpoint(const lt_fw_update_session_t *s, lt_fw_update_checkpoint_t *cp)
+{
+    if (!s || !s->update_data || !cp) {
+        return LT_PARAM_ERR;
+    }
+
+    memcpy(cp, &s->cp, sizeof(*cp));
+    cp->crc = lt_fw_update_checkpoint_crc(cp);
+
+    return LT_OK;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file lt_health.c
+ * @brief Health monitor of TROPIC01 piggybacking on L3 Results, it sends Ping only when TROPIC01 was idle
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_port.h"
+
+lt_ret_t lt_health_init(lt_health_t *mon, lt_handle_t *h, const uint32_t period_ms)
+{
+    if (!mon || !h || (period_ms == 0)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(mon, 0, sizeof(*mon));
+    mon->h = h;
+    mon->period_ms = period_ms;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_health_poll(lt_health_t *mon)
+{
+    if (!mon) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_handle_t *h = mon->h;
+    mon->stats.checks++;
+
+    if ((h->l3.last_res_us != 0)
+        && (lt_port_time_us() - h->l3.last_res_us < (uint64_t)mon->period_ms * 1000U)) {
+        mon->stats.piggybacked++;
+        return LT_OK;
+    }
+
+#ifdef LT_SUBMIT
+    // Ping has the lowest priority, the L3 Result of the submitted command will answer the check instead.
+    if (h->l3.submitted) {
+        mon->stats.deferred++;
+        return LT_OK;
+    }
+#endif
+
+    // Empty message is the cheapest Ping, lt_ping() only needs valid pointers.
+    uint8_t dummy = 0;
+    mon->stats.pings++;
+    lt_ret_t ret = lt_ping(h, &dummy, &dummy, 0);
+    if (ret != LT_OK) {
+        mon->stats.ping_errors++;
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_health_get_stats(const lt_health_t *mon, lt_health_stats_t *stats)
+{
+    if (!mon || !stats) {
+        return LT_PARAM_ERR;
+    }
+
+    *stats = mon->stats;
+
+    return LT_OK;
+}
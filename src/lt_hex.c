@@ -0,0 +1,58 @@
+/**
+ * @file lt_hex.c
+ * @brief Hex encoding and decoding definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_hex.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+/** Hex digits of the nibbles, upper case followed by lower case. */
+static const char lt_hex_digits[2][16] = {
+    {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'},
+    {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'},
+};
+
+/** Value of the hex digit, -1 if the character is not one. */
+static int lt_hex_nibble(const char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    // Clearing bit 5 maps lower case letters to upper case.
+    char u = (char)(c & ~0x20);
+    if ((u >= 'A') && (u <= 'F')) {
+        return u - 'A' + 10;
+    }
+    return -1;
+}
+
+void lt_hex_encode(char *out, const uint8_t *bytes, const size_t cnt, const bool upper)
+{
+    const char *digits = lt_hex_digits[upper ? 0 : 1];
+
+    for (size_t i = 0; i < cnt; i++) {
+        out[2 * i] = digits[bytes[i] >> 4];
+        out[2 * i + 1] = digits[bytes[i] & 0x0F];
+    }
+}
+
+lt_ret_t lt_hex_decode(uint8_t *out, const char *hex, const size_t cnt)
+{
+    for (size_t i = 0; i < cnt; i++) {
+        int hi = lt_hex_nibble(hex[2 * i]);
+        int lo = lt_hex_nibble(hex[2 * i + 1]);
+        if ((hi < 0) || (lo < 0)) {
+            return LT_PARAM_ERR;
+        }
+        out[i] = (uint8_t)((hi << 4) | lo);
+    }
+
+    return LT_OK;
+}
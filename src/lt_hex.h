@@ -0,0 +1,46 @@
+#ifndef LT_HEX_H
+#define LT_HEX_H
+
+/**
+ * @file lt_hex.h
+ * @brief Hex encoding and decoding declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Encodes bytes as hex characters, two per byte, without a terminating null character.
+ *
+ * @param out    Output buffer of at least 2 * `cnt` characters
+ * @param bytes  Bytes to encode
+ * @param cnt    Number of bytes
+ * @param upper  true for upper case digits A-F, false for lower case
+ */
+void lt_hex_encode(char *out, const uint8_t *bytes, const size_t cnt, const bool upper);
+
+/**
+ * @brief Decodes hex characters, two per byte, upper or lower case.
+ *
+ * @param out  Output buffer of at least `cnt` bytes, contents are undefined on failure
+ * @param hex  Hex characters, 2 * `cnt` of them
+ * @param cnt  Number of bytes
+ * @return     LT_OK if success, LT_PARAM_ERR if a character is not a hex digit.
+ */
+lt_ret_t lt_hex_decode(uint8_t *out, const char *hex, const size_t cnt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_HEX_H
@@ -15,32 +15,42 @@
 #include "lt_hmac_sha256.h"
 #include "lt_secure_memzero.h"
 
-lt_ret_t lt_hkdf(const uint8_t *ck, const uint32_t ck_len, const uint8_t *input, const uint32_t input_len,
-                 const uint8_t nouts, uint8_t *output_1, uint8_t *output_2)
+lt_ret_t lt_hkdf(void *crypto_ctx, const uint8_t *ck, const uint32_t ck_len, const uint8_t *input,
+                 const uint32_t input_len, const uint8_t nouts, uint8_t *output_1, uint8_t *output_2)
 {
     LT_UNUSED(nouts);
 
     uint8_t tmp[LT_HMAC_SHA256_HASH_LEN] = {0};
     uint8_t helper[LT_HMAC_SHA256_HASH_LEN + 1] = {0};
     uint8_t one = 0x01;
-    lt_ret_t ret;
+    lt_ret_t ret, ret_unused;
 
     ret = lt_hmac_sha256(ck, ck_len, input, input_len, tmp);
     if (ret != LT_OK) {
         goto cleanup;
     }
 
-    ret = lt_hmac_sha256(tmp, sizeof(tmp), &one, 1, output_1);
+    // Both expand steps are keyed by tmp, its inner and outer pad are hashed only once.
+    ret = lt_hmac_sha256_init(crypto_ctx, tmp, sizeof(tmp));
     if (ret != LT_OK) {
         goto cleanup;
     }
 
+    ret = lt_hmac_sha256_compute(crypto_ctx, &one, 1, output_1);
+    if (ret != LT_OK) {
+        goto hmac_cleanup;
+    }
+
     memcpy(helper, output_1, LT_HMAC_SHA256_HASH_LEN);  // Copy whole output of SHA256 HMAC.
     helper[LT_HMAC_SHA256_HASH_LEN] = 2;
 
-    ret = lt_hmac_sha256(tmp, sizeof(tmp), helper, sizeof(helper), output_2);
+    ret = lt_hmac_sha256_compute(crypto_ctx, helper, sizeof(helper), output_2);
     lt_secure_memzero(helper, sizeof(helper));
 
+hmac_cleanup:
+    ret_unused = lt_hmac_sha256_deinit(crypto_ctx);
+    LT_UNUSED(ret_unused);
+
 cleanup:
     lt_secure_memzero(tmp, sizeof(tmp));
 
@@ -20,7 +20,9 @@ extern "C" {
 
 /**
  * @brief The HMAC key derivation function as described in TROPIC01 datasheet.
+ * @note HMAC-SHA256 context in crypto_ctx is used, the key schedule of the PRK is derived once for both outputs.
  *
+ * @param crypto_ctx  Crypto context
  * @param ck          CK parameter
  * @param ck_len      Length of CK parameter
  * @param input       Input data
@@ -29,8 +31,9 @@ extern "C" {
  * @param output_1    Output data 1
  * @param output_2    Output data 2
  */
-lt_ret_t lt_hkdf(const uint8_t *ck, const uint32_t ck_len, const uint8_t *input, const uint32_t input_len,
-                 const uint8_t nouts, uint8_t *output_1, uint8_t *output_2) __attribute__((warn_unused_result));
+lt_ret_t lt_hkdf(void *crypto_ctx, const uint8_t *ck, const uint32_t ck_len, const uint8_t *input,
+                 const uint32_t input_len, const uint8_t nouts, uint8_t *output_1, uint8_t *output_2)
+    __attribute__((warn_unused_result));
 
 #ifdef __cplusplus
 }
@@ -36,6 +36,41 @@ extern "C" {
 lt_ret_t lt_hmac_sha256(const uint8_t *key, const uint32_t key_len, const uint8_t *input, const uint32_t input_len,
                         uint8_t *output) __attribute__((warn_unused_result));
 
+/**
+ * @brief Initializes HMAC-SHA256 context with a key, the key schedule is derived once and reused by every
+ * lt_hmac_sha256_compute() until lt_hmac_sha256_deinit().
+ * @note The key buffer has to stay valid until lt_hmac_sha256_deinit(), some providers keep only a reference to it.
+ *
+ * @param  ctx      Crypto context
+ * @param  key      Key data buffer
+ * @param  key_len  Length of data in key buffer
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_hmac_sha256_init(void *ctx, const uint8_t *key, const uint32_t key_len)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Computes HMAC-SHA256 of one message with the key set by lt_hmac_sha256_init().
+ *
+ * @param  ctx        Crypto context
+ * @param  input      Input data buffer
+ * @param  input_len  Length of data in input buffer
+ * @param  output     Output buffer
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_hmac_sha256_compute(void *ctx, const uint8_t *input, const uint32_t input_len, uint8_t *output)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Deinitializes HMAC-SHA256 context and wipes the key schedule.
+ * @warning This function has to be called even if lt_hmac_sha256_compute() failed. If `lt_hmac_sha256_init`
+ * failed, calling this function is not necessary. Calling it on a context not initialized is allowed.
+ *
+ * @param  ctx  Crypto context
+ * @return LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_hmac_sha256_deinit(void *ctx) __attribute__((warn_unused_result));
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,126 @@
+/**
+ * @file lt_i_config_cache.c
+ * @brief I-config cache definitions, I-config objects known to the host without reading them again
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_i_config_cache.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+LT_STATIC_ASSERT(LT_CONFIG_OBJ_CNT <= 32)
+
+/** Addresses of the configuration objects, index in this table is the index in the cache. */
+static const enum lt_config_obj_addr_t lt_i_config_cache_addrs[LT_CONFIG_OBJ_CNT] = {
+    TR01_CFG_START_UP_ADDR,
+    TR01_CFG_SENSORS_ADDR,
+    TR01_CFG_DEBUG_ADDR,
+    TR01_CFG_GPO_ADDR,
+    TR01_CFG_SLEEP_MODE_ADDR,
+    TR01_CFG_UAP_PAIRING_KEY_WRITE_ADDR,
+    TR01_CFG_UAP_PAIRING_KEY_READ_ADDR,
+    TR01_CFG_UAP_PAIRING_KEY_INVALIDATE_ADDR,
+    TR01_CFG_UAP_R_CONFIG_WRITE_ERASE_ADDR,
+    TR01_CFG_UAP_R_CONFIG_READ_ADDR,
+    TR01_CFG_UAP_I_CONFIG_WRITE_ADDR,
+    TR01_CFG_UAP_I_CONFIG_READ_ADDR,
+    TR01_CFG_UAP_PING_ADDR,
+    TR01_CFG_UAP_R_MEM_DATA_WRITE_ADDR,
+    TR01_CFG_UAP_R_MEM_DATA_READ_ADDR,
+    TR01_CFG_UAP_R_MEM_DATA_ERASE_ADDR,
+    TR01_CFG_UAP_RANDOM_VALUE_GET_ADDR,
+    TR01_CFG_UAP_ECC_KEY_GENERATE_ADDR,
+    TR01_CFG_UAP_ECC_KEY_STORE_ADDR,
+    TR01_CFG_UAP_ECC_KEY_READ_ADDR,
+    TR01_CFG_UAP_ECC_KEY_ERASE_ADDR,
+    TR01_CFG_UAP_ECDSA_SIGN_ADDR,
+    TR01_CFG_UAP_EDDSA_SIGN_ADDR,
+    TR01_CFG_UAP_MCOUNTER_INIT_ADDR,
+    TR01_CFG_UAP_MCOUNTER_GET_ADDR,
+    TR01_CFG_UAP_MCOUNTER_UPDATE_ADDR,
+    TR01_CFG_UAP_MAC_AND_DESTROY_ADDR,
+};
+
+/** Index of the object in the cache, -1 for unknown address. */
+static int lt_i_config_cache_index(const enum lt_config_obj_addr_t addr)
+{
+    for (int i = 0; i < LT_CONFIG_OBJ_CNT; i++) {
+        if (lt_i_config_cache_addrs[i] == addr) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+bool lt_i_config_cache_get(lt_i_config_cache_t *cache, const enum lt_config_obj_addr_t addr, uint32_t *obj)
+{
+    int i = lt_i_config_cache_index(addr);
+
+    if ((i < 0) || !(cache->valid & (1UL << i))) {
+        cache->misses++;
+        return false;
+    }
+
+    cache->hits++;
+    *obj = cache->obj[i];
+
+    return true;
+}
+
+void lt_i_config_cache_put(lt_i_config_cache_t *cache, const enum lt_config_obj_addr_t addr, const uint32_t obj)
+{
+    int i = lt_i_config_cache_index(addr);
+
+    if (i < 0) {
+        return;
+    }
+
+    cache->obj[i] = obj;
+    cache->valid |= 1UL << i;
+}
+
+bool lt_i_config_cache_bit_cleared(const lt_i_config_cache_t *cache, const enum lt_config_obj_addr_t addr,
+                                   const uint8_t bit_index)
+{
+    int i = lt_i_config_cache_index(addr);
+
+    return (i >= 0) && (cache->valid & (1UL << i)) && !(cache->obj[i] & (1UL << bit_index));
+}
+
+void lt_i_config_cache_merge_write(lt_i_config_cache_t *cache, const enum lt_config_obj_addr_t addr,
+                                   const uint8_t bit_index, const bool written)
+{
+    int i = lt_i_config_cache_index(addr);
+
+    if (i < 0) {
+        return;
+    }
+
+    if (written) {
+        // Bits are only ever cleared, so the known object stays valid.
+        cache->obj[i] &= ~(1UL << bit_index);
+    }
+    else {
+        cache->valid &= ~(1UL << i);
+    }
+}
+
+lt_ret_t lt_i_config_cache_invalidate(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(h->l3.i_config.obj, 0, sizeof(h->l3.i_config.obj));
+    h->l3.i_config.valid = 0;
+
+    return LT_OK;
+}
@@ -0,0 +1,69 @@
+#ifndef LT_I_CONFIG_CACHE_H
+#define LT_I_CONFIG_CACHE_H
+
+/**
+ * @file lt_i_config_cache.h
+ * @brief I-config cache declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_I_CONFIG_CACHE
+/**
+ * @brief Looks the object up in the cache.
+ *
+ * @param cache   I-config cache
+ * @param addr    Address of a config object
+ * @param obj     Set to the cached object if it is known
+ * @return        true if the object is known
+ */
+bool lt_i_config_cache_get(lt_i_config_cache_t *cache, const enum lt_config_obj_addr_t addr, uint32_t *obj);
+
+/**
+ * @brief Stores the object read from TROPIC01.
+ *
+ * @param cache   I-config cache
+ * @param addr    Address of a config object
+ * @param obj     Object read from TROPIC01
+ */
+void lt_i_config_cache_put(lt_i_config_cache_t *cache, const enum lt_config_obj_addr_t addr, const uint32_t obj);
+
+/**
+ * @brief Tells whether the bit is known to be cleared already, so writing it would not change the I-config.
+ *
+ * @param cache      I-config cache
+ * @param addr       Address of a config object
+ * @param bit_index  Index of the bit
+ * @return           true if the bit is cleared in the known object
+ */
+bool lt_i_config_cache_bit_cleared(const lt_i_config_cache_t *cache, const enum lt_config_obj_addr_t addr,
+                                   const uint8_t bit_index);
+
+/**
+ * @brief Merges result of I-config write into the cache: on success the bit is cleared in the known object, on
+ * failure the object is forgotten, as the bit may or may not have been cleared.
+ *
+ * @param cache      I-config cache
+ * @param addr       Address of a config object
+ * @param bit_index  Index of the written bit
+ * @param written    true if TROPIC01 confirmed the write
+ */
+void lt_i_config_cache_merge_write(lt_i_config_cache_t *cache, const enum lt_config_obj_addr_t addr,
+                                   const uint8_t bit_index, const bool written);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_I_CONFIG_CACHE_H
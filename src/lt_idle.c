@@ -0,0 +1,139 @@
+/**
+ * @file lt_idle.c
+ * @brief Idle manager putting TROPIC01 to sleep after an idle time and restoring the Secure Session after the wake
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_port.h"
+#include "lt_l3_process.h"
+
+lt_ret_t lt_idle_init(lt_idle_t *idle, lt_handle_t *h, const lt_idle_policy_t *policy)
+{
+    if (!idle || !h || !policy) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(idle, 0, sizeof(*idle));
+    idle->h = h;
+    idle->policy = *policy;
+    idle->last_us = lt_port_time_us();
+
+    return LT_OK;
+}
+
+lt_ret_t lt_idle_set_session(lt_idle_t *idle, const uint8_t *stpub, const lt_pkey_index_t pkey_index,
+                             const uint8_t *shipriv, const uint8_t *shipub)
+{
+    if (!idle || !stpub || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv || !shipub) {
+        return LT_PARAM_ERR;
+    }
+
+    idle->stpub = stpub;
+    idle->pkey_index = (uint8_t)pkey_index;
+    idle->shipriv = shipriv;
+    idle->shipub = shipub;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_idle_begin(lt_idle_t *idle)
+{
+    if (!idle) {
+        return LT_PARAM_ERR;
+    }
+
+    idle->active = 1;
+    if (!idle->asleep) {
+        return LT_OK;
+    }
+
+    // TROPIC01 wakes up by itself on the next L2 Request, only the Secure Session has to be restored.
+    idle->asleep = 0;
+    idle->stats.wakes++;
+    idle->stats.slept_ms += (lt_port_time_us() - idle->last_us) / 1000U;
+
+    if (!idle->session_lost || !idle->policy.restore_session || !idle->stpub) {
+        return LT_OK;
+    }
+    idle->session_lost = 0;
+
+    lt_ret_t ret = lt_session_start(idle->h, idle->stpub, (lt_pkey_index_t)idle->pkey_index, idle->shipriv,
+                                    idle->shipub);
+    if (ret != LT_OK) {
+        idle->stats.restore_errors++;
+        return ret;
+    }
+    idle->stats.restores++;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_idle_end(lt_idle_t *idle)
+{
+    if (!idle) {
+        return LT_PARAM_ERR;
+    }
+
+    idle->active = 0;
+    idle->last_us = lt_port_time_us();
+
+    return LT_OK;
+}
+
+lt_ret_t lt_idle_poll(lt_idle_t *idle)
+{
+    if (!idle) {
+        return LT_PARAM_ERR;
+    }
+    if (idle->active || idle->asleep || (idle->policy.idle_ms == 0)
+        || (lt_port_time_us() - idle->last_us < (uint64_t)idle->policy.idle_ms * 1000U)) {
+        return LT_OK;
+    }
+
+    lt_handle_t *h = idle->h;
+    const bool session_on = (h->l3.session_status == LT_SECURE_SESSION_ON);
+
+#ifdef LT_SESSION_CACHE
+    // Keys are generated while the chip is still awake anyway, the restore then needs only the handshake.
+    if (session_on && idle->policy.restore_session && idle->policy.prepare_cache && h->l3.session_cache) {
+        lt_ret_t ret_prepare = lt_session_cache_prepare(h, h->l3.session_cache);
+        if (ret_prepare != LT_OK) {
+            return ret_prepare;
+        }
+    }
+#endif
+
+    lt_ret_t ret = lt_sleep(h, TR01_L2_SLEEP_KIND_SLEEP);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // TROPIC01 drops the Secure Session when going to sleep.
+    lt_l3_invalidate_host_session_data(&h->l3);
+    idle->session_lost = session_on ? 1 : 0;
+    idle->asleep = 1;
+    idle->last_us = lt_port_time_us();
+    idle->stats.sleeps++;
+
+    return LT_OK;
+}
+
+bool lt_idle_asleep(const lt_idle_t *idle) { return idle && idle->asleep; }
+
+lt_ret_t lt_idle_get_stats(const lt_idle_t *idle, lt_idle_stats_t *stats)
+{
+    if (!idle || !stats) {
+        return LT_PARAM_ERR;
+    }
+
+    *stats = idle->stats;
+
+    return LT_OK;
+}
@@ -16,7 +16,26 @@
 #include "libtropic_common.h"
 #include "libtropic_logging.h"
 #include "libtropic_macros.h"
+#include "lt_hex.h"
 #include "lt_port_wrap.h"
+#include "lt_stats.h"
+#include "lt_trace.h"
+
+#ifdef LT_L1_ADAPTIVE_POLL
+#include "lt_l1_poll.h"
+#endif
+
+#ifdef LT_SPI_RECORDER
+#include "lt_spi_recorder.h"
+#endif
+
+#ifdef LT_CPU_LOG_DRAIN
+#include "lt_cpu_log.h"
+#endif
+
+#ifdef LT_DEADLINE
+#include "lt_deadline.h"
+#endif
 
 #ifdef LT_PRINT_SPI_DATA
 #include "stdio.h"
@@ -38,139 +57,439 @@ static void print_hex_chunks(const uint8_t *data, uint8_t len, uint8_t dir)
 }
 #endif
 
-lt_ret_t lt_l1_read(lt_l2_state_t *s2, const uint32_t max_len, const uint32_t timeout_ms)
+#ifdef LT_SPI_RECORDER
+/**
+ * @brief Records received L2 Response frame, RSP_DATA may have been placed out of s2->buff (LT_L2_ZERO_COPY).
+ *
+ * @param s2  Structure holding l2 state
+ */
+static void lt_l1_record_rsp(lt_l2_state_t *s2)
 {
-#ifdef LT_REDUNDANT_ARG_CHECK
-    if (!s2) {
-        return LT_PARAM_ERR;
+    uint8_t rsp_len = s2->buff[TR01_L2_RSP_LEN_OFFSET];
+    const uint8_t *rsp_data = s2->buff + TR01_L2_RSP_DATA_RSP_CRC_OFFSET;
+
+#ifdef LT_L2_ZERO_COPY
+    if (s2->rx_data_placed) {
+        rsp_data = s2->rx_data;
     }
-    if ((timeout_ms < LT_L1_TIMEOUT_MS_MIN) | (timeout_ms > LT_L1_TIMEOUT_MS_MAX)) {
-        return LT_PARAM_ERR;
+#endif
+    if (!lt_spi_recorder_begin(s2->spi_rec, LT_SPI_REC_MISO,
+                               TR01_L2_RSP_DATA_RSP_CRC_OFFSET + rsp_len + TR01_L2_REQ_RSP_CRC_SIZE)) {
+        return;
     }
-    if ((max_len < TR01_L1_LEN_MIN) | (max_len > TR01_L1_LEN_MAX)) {
-        return LT_PARAM_ERR;
+    lt_spi_recorder_append(s2->spi_rec, s2->buff, TR01_L2_RSP_DATA_RSP_CRC_OFFSET);
+    lt_spi_recorder_append(s2->spi_rec, rsp_data, rsp_len);
+    lt_spi_recorder_append(s2->spi_rec, s2->buff + TR01_L2_RSP_DATA_RSP_CRC_OFFSET + rsp_len,
+                           TR01_L2_REQ_RSP_CRC_SIZE);
+    lt_spi_recorder_commit(s2->spi_rec);
+}
+#endif
+
+/**
+ * @brief Waits before the next CHIP_STATUS poll.
+ *
+ * @param s2  Structure holding l2 state
+ * @return    LT_OK if success, LT_L1_CHIP_BUSY if the poll budget is exhausted, otherwise other error code.
+ */
+static lt_ret_t lt_l1_poll_wait(lt_l2_state_t *s2)
+{
+#ifdef LT_L1_ADAPTIVE_POLL
+    uint32_t delay_ms = lt_l1_poll_next_delay(&s2->poll);
+    if (delay_ms == 0) {
+        return LT_L1_CHIP_BUSY;
     }
+    return lt_l1_delay(s2, delay_ms);
 #else
-    LT_UNUSED(max_len);
+    return lt_l1_delay(s2, LT_L1_READ_RETRY_DELAY);
+#endif
+}
+
+/**
+ * @brief Returns number of RSP_DATA/RSP_CRC bytes to clock out together with CHIP_STATUS.
+ *
+ * @param s2  Structure holding l2 state
+ * @return    Number of bytes, 0 to read CHIP_STATUS alone.
+ */
+static uint16_t lt_l1_prefetch_len(const lt_l2_state_t *s2)
+{
+#ifdef LT_L2_RESEND_REREAD
+    // Length of the expected frame is known, whole frame is read in one go.
+    if (s2->rx_len_hint) {
+        return s2->rx_len_hint;
+    }
+#else
+    LT_UNUSED(s2);
+#endif
+#ifdef LT_L1_PREFETCH_LEN
+    return LT_L1_PREFETCH_LEN;
+#else
+    return 0;
 #endif
+}
 
+/**
+ * @brief Receives the rest of L2 Response frame (RSP_DATA and RSP_CRC) and sets chip select high.
+ *
+ * @param s2          Structure holding l2 state
+ * @param done        Number of bytes of RSP_DATA and RSP_CRC already received into s2->buff
+ * @param length      Total length of RSP_DATA and RSP_CRC
+ * @param timeout_ms  Timeout
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l1_read_rest(lt_l2_state_t *s2, const uint16_t done, const uint16_t length,
+                                const uint32_t timeout_ms)
+{
+    lt_spi_seg_t segs[2];
+    uint8_t seg_cnt = 0;
+
+#ifdef LT_L2_ZERO_COPY
+    uint16_t data_len = length - TR01_L2_REQ_RSP_CRC_SIZE;
+    if (s2->rx_data && (data_len <= s2->rx_data_max)) {
+        // RSP_DATA go straight to their final place, only the prefetched part is copied. RSP_CRC stays in s2->buff.
+        uint16_t data_done = lt_min(done, data_len);
+        memcpy(s2->rx_data, s2->buff + TR01_L2_RSP_DATA_RSP_CRC_OFFSET, data_done);
+        if (data_len > data_done) {
+            segs[seg_cnt++] = (lt_spi_seg_t){NULL, s2->rx_data + data_done, data_len - data_done,
+                                             TR01_L2_RSP_DATA_RSP_CRC_OFFSET + data_done};
+        }
+        uint16_t crc_done = done - data_done;
+        if (crc_done < TR01_L2_REQ_RSP_CRC_SIZE) {
+            segs[seg_cnt++] = (lt_spi_seg_t){NULL, NULL, TR01_L2_REQ_RSP_CRC_SIZE - crc_done,
+                                             TR01_L2_RSP_DATA_RSP_CRC_OFFSET + data_len + crc_done};
+        }
+        s2->rx_data_placed = true;
+    }
+    else if (length > done) {
+        segs[seg_cnt++] = (lt_spi_seg_t){NULL, NULL, length - done, TR01_L2_RSP_DATA_RSP_CRC_OFFSET + done};
+    }
+#else
+    if (length > done) {
+        segs[seg_cnt++] = (lt_spi_seg_t){NULL, NULL, length - done, TR01_L2_RSP_DATA_RSP_CRC_OFFSET + done};
+    }
+#endif
+
+    if (seg_cnt == 0) {
+        return lt_l1_spi_csn_high(s2);
+    }
+
+    // Chip select is left high on failure.
+    return lt_l1_spi_transfer_v(s2, segs, seg_cnt, LT_SPI_V_CSN_HIGH, timeout_ms);
+}
+
+/**
+ * @brief Makes one attempt to read L2 Response frame, does not wait for TROPIC01.
+ *
+ * @param s2            Structure holding l2 state
+ * @param prefetch_len  Number of RSP_DATA/RSP_CRC bytes to clock out together with CHIP_STATUS
+ * @param timeout_ms    Timeout
+ * @return              LT_OK if the frame was received, LT_L1_CHIP_BUSY if TROPIC01 has no response ready (CHIP_STATUS
+ *                      is left in s2->buff[0]), otherwise other error code.
+ */
+static lt_ret_t lt_l1_read_attempt(lt_l2_state_t *s2, const uint16_t prefetch_len, const uint32_t timeout_ms)
+{
     lt_ret_t ret;
-    int max_tries = LT_L1_READ_MAX_TRIES;
 
-    while (max_tries > 0) {
-        max_tries--;
+    LT_STATS_INC(s2, l1_polls);
+    s2->buff[0] = TR01_L1_GET_RESPONSE_REQ_ID;
 
-        s2->buff[0] = TR01_L1_GET_RESPONSE_REQ_ID;
+    // Try to read CHIP_STATUS byte. If prefetch is used, speculatively clock out also STATUS, RSP_LEN and first
+    // bytes of RSP_DATA/RSP_CRC in the same transfer, so short responses are received in one go. Extra bytes are
+    // simply ignored if chip is not ready.
+    const lt_spi_seg_t status_seg = {NULL, NULL, prefetch_len ? LT_L1_PREFETCH_HDR_LEN + prefetch_len : 1, 0};
+    // Chip select is left high on failure.
+    ret = lt_l1_spi_transfer_v(s2, &status_seg, 1, LT_SPI_V_CSN_LOW, timeout_ms);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // Check ALARM bit of CHIP_STATUS byte
+    if (s2->buff[0] & TR01_L1_CHIP_MODE_ALARM_bit) {
+        lt_ret_t ret_unused = lt_l1_spi_csn_high(s2);
+        LT_LOG_DEBUG("CHIP_STATUS: 0x%02" PRIX8, s2->buff[0]);
 
-        // Try to read CHIP_STATUS byte
-        ret = lt_l1_spi_csn_low(s2);
+#ifdef LT_RETRIEVE_ALARM_LOG
+        ret_unused = lt_l1_retrieve_alarm_log(s2, timeout_ms);
+#endif
+
+        LT_UNUSED(ret_unused);  // We don't care about it, we return LT_L1_CHIP_ALARM_MODE anyway.
+        return LT_L1_CHIP_ALARM_MODE;
+    }
+
+    // Chip status does not contain any special mode bit and also is not ready, caller tries it again
+    if (!(s2->buff[0] & TR01_L1_CHIP_MODE_READY_bit)) {
+        ret = lt_l1_spi_csn_high(s2);
         if (ret != LT_OK) {
             return ret;
         }
+        return LT_L1_CHIP_BUSY;
+    }
 
-        ret = lt_l1_spi_transfer(s2, 0, 1, timeout_ms);
-        if (ret != LT_OK) {
+    // Proceed further, CHIP_STATUS contains READY bit, signalizing that chip is ready to receive request
+    if (prefetch_len == 0) {
+        // receive STATUS byte and length byte
+        ret = lt_l1_spi_transfer(s2, 1, 2, timeout_ms);
+        if (ret != LT_OK) {  // offset 1
             lt_ret_t ret_unused = lt_l1_spi_csn_high(s2);
             LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
             return ret;
         }
+    }
 
-        // Check ALARM bit of CHIP_STATUS byte
-        if (s2->buff[0] & TR01_L1_CHIP_MODE_ALARM_bit) {
-            lt_ret_t ret_unused = lt_l1_spi_csn_high(s2);
-            LT_LOG_DEBUG("CHIP_STATUS: 0x%02" PRIX8, s2->buff[0]);
+    // 0xFF received in second byte means that chip has no response to send.
+    if (s2->buff[1] == 0xff) {
+        ret = lt_l1_spi_csn_high(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        return LT_L1_CHIP_BUSY;
+    }
 
-#ifdef LT_RETRIEVE_ALARM_LOG
-            ret_unused = lt_l1_retrieve_alarm_log(s2, timeout_ms);
+    // Take length information and add 2B for crc bytes
+    uint16_t length = s2->buff[2] + 2;
+    if (length > (TR01_L1_LEN_MAX - 2)) {
+        lt_ret_t ret_unused = lt_l1_spi_csn_high(s2);
+        LT_UNUSED(ret_unused);  // We don't care about it, we return LT_L1_DATA_LEN_ERROR anyway.
+        return LT_L1_DATA_LEN_ERROR;
+    }
+    // Receive the rest of incomming bytes, including crc, only if they were not prefetched already
+    ret = lt_l1_read_rest(s2, lt_min(length, prefetch_len), length, timeout_ms);
+    if (ret != LT_OK) {
+        return ret;
+    }
+#ifdef LT_PRINT_SPI_DATA
+    print_hex_chunks(s2->buff, s2->buff[2] + 5, LT_L1_SPI_DIR_MISO);
+#endif
+#ifdef LT_SPI_RECORDER
+    lt_l1_record_rsp(s2);
 #endif
 
-            LT_UNUSED(ret_unused);  // We don't care about it, we return LT_L1_CHIP_ALARM_MODE anyway.
-            return LT_L1_CHIP_ALARM_MODE;
-        }
+    return LT_OK;
+}
 
-        // Proceed further in case CHIP_STATUS contains READY bit, signalizing that chip is ready to receive request
-        if (s2->buff[0] & TR01_L1_CHIP_MODE_READY_bit) {
-            // receive STATUS byte and length byte
-            ret = lt_l1_spi_transfer(s2, 1, 2, timeout_ms);
-            if (ret != LT_OK) {  // offset 1
-                lt_ret_t ret_unused = lt_l1_spi_csn_high(s2);
-                LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
-                return ret;
-            }
+#ifdef LT_PORT_SPI_READ_READY
+/**
+ * @brief Evaluates result of the polling done by the port the same way as lt_l1_read_attempt().
+ *
+ * @param s2          Structure holding l2 state
+ * @param ret         Result of the polling
+ * @param timeout_ms  Timeout
+ * @return            LT_OK if the frame was received, LT_NOT_SUPPORTED if the port cannot poll now, otherwise other
+ *                    error code.
+ */
+static lt_ret_t lt_l1_read_offloaded_check(lt_l2_state_t *s2, const lt_ret_t ret, const uint32_t timeout_ms)
+{
+    if (ret != LT_OK) {
+        return ret;
+    }
 
-            // 0xFF received in second byte means that chip has no response to send.
-            if (s2->buff[1] == 0xff) {
-                ret = lt_l1_spi_csn_high(s2);
-                if (ret != LT_OK) {
-                    return ret;
-                }
-                ret = lt_l1_delay(s2, LT_L1_READ_RETRY_DELAY);
-                if (ret != LT_OK) {
-                    return ret;
-                }
-                continue;
-            }
+    if (s2->buff[0] & TR01_L1_CHIP_MODE_ALARM_bit) {
+        LT_LOG_DEBUG("CHIP_STATUS: 0x%02" PRIX8, s2->buff[0]);
+#ifdef LT_RETRIEVE_ALARM_LOG
+        lt_ret_t ret_unused = lt_l1_retrieve_alarm_log(s2, timeout_ms);
+        LT_UNUSED(ret_unused);  // We don't care about it, we return LT_L1_CHIP_ALARM_MODE anyway.
+#else
+        LT_UNUSED(timeout_ms);
+#endif
+        return LT_L1_CHIP_ALARM_MODE;
+    }
+
+    // Port gave up polling.
+    if (!(s2->buff[0] & TR01_L1_CHIP_MODE_READY_bit) || (s2->buff[1] == 0xff)) {
+        return LT_L1_CHIP_BUSY;
+    }
 
-            // Take length information and add 2B for crc bytes
-            uint16_t length = s2->buff[2] + 2;
-            if (length > (TR01_L1_LEN_MAX - 2)) {
-                lt_ret_t ret_unused = lt_l1_spi_csn_high(s2);
-                LT_UNUSED(ret_unused);  // We don't care about it, we return LT_L1_DATA_LEN_ERROR anyway.
-                return LT_L1_DATA_LEN_ERROR;
-            }
-            // Receive the rest of incomming bytes, including crc
-            ret = lt_l1_spi_transfer(s2, 3, length, timeout_ms);
-            if (ret != LT_OK) {  // offset 3
-                lt_ret_t ret_unused = lt_l1_spi_csn_high(s2);
-                LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
-                return ret;
-            }
-            ret = lt_l1_spi_csn_high(s2);
-            if (ret != LT_OK) {
-                return ret;
-            }
 #ifdef LT_PRINT_SPI_DATA
-            print_hex_chunks(s2->buff, s2->buff[2] + 5, LT_L1_SPI_DIR_MISO);
+    print_hex_chunks(s2->buff, s2->buff[2] + 5, LT_L1_SPI_DIR_MISO);
+#endif
+#ifdef LT_SPI_RECORDER
+    lt_l1_record_rsp(s2);
+#endif
+
+    return LT_OK;
+}
+
+/**
+ * @brief Lets the port poll for L2 Response frame.
+ *
+ * @param s2          Structure holding l2 state
+ * @param max_len     Maximal length of the frame, including CHIP_STATUS
+ * @param timeout_ms  Timeout
+ * @return            LT_OK if the frame was received, LT_NOT_SUPPORTED if the port cannot poll now, otherwise other
+ *                    error code.
+ */
+static lt_ret_t lt_l1_read_offloaded(lt_l2_state_t *s2, const uint32_t max_len, const uint32_t timeout_ms)
+{
+    uint16_t max_tries = LT_L1_READ_MAX_TRIES;
+#ifdef LT_DEADLINE
+    // The port polls only as long as the deadline allows.
+    const uint32_t left_tries = lt_deadline_left_ms(s2) / LT_L1_READ_RETRY_DELAY + 1;
+    if (left_tries < max_tries) {
+        max_tries = (uint16_t)left_tries;
+    }
+#endif
+    lt_ret_t ret = lt_l1_spi_read_ready(s2, (uint16_t)lt_min(max_len, TR01_L1_LEN_MAX), LT_L1_READ_RETRY_DELAY,
+                                        max_tries, timeout_ms);
+
+    ret = lt_l1_read_offloaded_check(s2, ret, timeout_ms);
+#ifdef LT_DEADLINE
+    if ((ret == LT_L1_CHIP_BUSY) && (max_tries < LT_L1_READ_MAX_TRIES)) {
+        return LT_DEADLINE_EXCEEDED;
+    }
+#endif
+
+    return ret;
+}
+#endif
+
+/**
+ * @brief Polls CHIP_STATUS until L2 Response frame is ready and receives it, see lt_l1_read().
+ *
+ * @param s2            Structure holding l2 state
+ * @param max_len       Max len of L1 frame
+ * @param timeout_ms    Timeout of one SPI transfer
+ * @return              LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l1_read_poll(lt_l2_state_t *s2, const uint32_t max_len, const uint32_t timeout_ms)
+{
+    lt_ret_t ret;
+    const uint16_t prefetch_len = lt_l1_prefetch_len(s2);
+#ifdef LT_L2_ZERO_COPY
+    s2->rx_data_placed = false;
+#endif
+#ifdef LT_PORT_SPI_READ_READY
+    // The whole polling loop is done by the port, e.g. by the server behind the TCP connection.
+    ret = lt_l1_read_offloaded(s2, max_len, timeout_ms);
+    if (ret != LT_NOT_SUPPORTED) {
+        return ret;
+    }
+#else
+    LT_UNUSED(max_len);
+#endif
+#ifdef LT_L1_ADAPTIVE_POLL
+    int max_tries = LT_L1_POLL_MAX_TRIES;
+    lt_l1_poll_start(&s2->poll);
+#else
+    int max_tries = LT_L1_READ_MAX_TRIES;
+#endif
+
+    while (max_tries > 0) {
+        max_tries--;
+
+        ret = lt_l1_read_attempt(s2, prefetch_len, timeout_ms);
+        if (ret == LT_OK) {
+#ifdef LT_L1_ADAPTIVE_POLL
+            lt_l1_poll_done(&s2->poll);
 #endif
             return LT_OK;
+        }
+        if (ret != LT_L1_CHIP_BUSY) {
+            return ret;
+        }
 
-            // Chip status does not contain any special mode bit and also is not ready,
-            // try it again (until max_tries runs out)
+        // Chip is ready, but has no response to send yet, or it is in Start-up Mode, where INT pin is not
+        // implemented. So we wait a bit before we poll again for CHIP_STATUS.
+        if (s2->buff[0] & (TR01_L1_CHIP_MODE_READY_bit | TR01_L1_CHIP_MODE_STARTUP_bit)) {
+            ret = lt_l1_poll_wait(s2);
+            if (ret != LT_OK) {
+                return ret;
+            }
         }
         else {
-            ret = lt_l1_spi_csn_high(s2);
+#if LT_USE_INT_PIN
+            // Wait for rising edge on the INT pin, which signalizes that L2 Response frame is ready to be received
+            ret = lt_l1_delay_on_int(s2, LT_L1_TIMEOUT_MS_MAX);
             if (ret != LT_OK) {
                 return ret;
             }
-            if (s2->buff[0] & TR01_L1_CHIP_MODE_STARTUP_bit) {
-                // INT pin is not implemented in Start-up Mode
-                // So we wait a bit before we poll again for CHIP_STATUS
-                ret = lt_l1_delay(s2, LT_L1_READ_RETRY_DELAY);
-                if (ret != LT_OK) {
-                    return ret;
-                }
-            }
-            else {
-#if LT_USE_INT_PIN
-                // Wait for rising edge on the INT pin, which signalizes that L2 Response frame is ready to be received
-                ret = lt_l1_delay_on_int(s2, LT_L1_TIMEOUT_MS_MAX);
-                if (ret != LT_OK) {
-                    return ret;
-                }
 #else
-                // INT pin not used, delay for some time
-                ret = lt_l1_delay(s2, LT_L1_READ_RETRY_DELAY);
-                if (ret != LT_OK) {
-                    return ret;
-                }
-#endif
+            // INT pin not used, delay for some time
+            ret = lt_l1_poll_wait(s2);
+            if (ret != LT_OK) {
+                return ret;
             }
+#endif
         }
     }
 
     return LT_L1_CHIP_BUSY;
 }
 
+lt_ret_t lt_l1_read(lt_l2_state_t *s2, const uint32_t max_len, const uint32_t timeout_ms)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+    if ((timeout_ms < LT_L1_TIMEOUT_MS_MIN) | (timeout_ms > LT_L1_TIMEOUT_MS_MAX)) {
+        return LT_PARAM_ERR;
+    }
+    if ((max_len < TR01_L1_LEN_MIN) | (max_len > TR01_L1_LEN_MAX)) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+#ifdef LT_DEADLINE
+    lt_ret_t ret_deadline = lt_deadline_check(s2, 0);
+    if (ret_deadline != LT_OK) {
+        return ret_deadline;
+    }
+#endif
+
+    LT_TRACE_START(s2->trace, LT_TRACE_L1_READ);
+    lt_ret_t ret = lt_l1_read_poll(s2, max_len, timeout_ms);
+    LT_TRACE_END(s2->trace, LT_TRACE_L1_READ);
+    if (ret == LT_L1_CHIP_BUSY) {
+        LT_STATS_INC(s2, l1_chip_busy);
+    }
+
+    return ret;
+}
+
+#ifdef LT_L2_ASYNC
+lt_ret_t lt_l1_read_nowait(lt_l2_state_t *s2, const uint32_t timeout_ms)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s2) {
+        return LT_PARAM_ERR;
+    }
+    if ((timeout_ms < LT_L1_TIMEOUT_MS_MIN) | (timeout_ms > LT_L1_TIMEOUT_MS_MAX)) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+#ifdef LT_DEADLINE
+    lt_ret_t ret_deadline = lt_deadline_check(s2, 0);
+    if (ret_deadline != LT_OK) {
+        return ret_deadline;
+    }
+#endif
+
+#ifdef LT_L2_ZERO_COPY
+    s2->rx_data_placed = false;
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+    // Polling runs in the background of the port (e.g. on the server behind the TCP connection), it is only asked
+    // whether the polling ended. The port signals that to the event loop driving the operation.
+    lt_ret_t ret = lt_l1_spi_read_ready_nowait(s2, TR01_L1_LEN_MAX, LT_L1_READ_RETRY_DELAY, LT_L1_READ_MAX_TRIES,
+                                               timeout_ms);
+    if (ret != LT_L1_CHIP_BUSY) {
+        ret = lt_l1_read_offloaded_check(s2, ret, timeout_ms);
+    }
+    if (ret == LT_NOT_SUPPORTED) {
+        ret = lt_l1_read_attempt(s2, lt_l1_prefetch_len(s2), timeout_ms);
+    }
+#else
+    lt_ret_t ret = lt_l1_read_attempt(s2, lt_l1_prefetch_len(s2), timeout_ms);
+#endif
+    if (ret == LT_L1_CHIP_BUSY) {
+        LT_STATS_INC(s2, l1_chip_busy);
+    }
+
+    return ret;
+}
+#endif
+
 lt_ret_t lt_l1_write(lt_l2_state_t *s2, const uint16_t len, const uint32_t timeout_ms)
 {
 #ifdef LT_REDUNDANT_ARG_CHECK
@@ -185,23 +504,32 @@ lt_ret_t lt_l1_write(lt_l2_state_t *s2, const uint16_t len, const uint32_t timeo
     }
 #endif
 
+#ifdef LT_DEADLINE
+    lt_ret_t ret_deadline = lt_deadline_check(s2, 0);
+    if (ret_deadline != LT_OK) {
+        return ret_deadline;
+    }
+#endif
+
     lt_ret_t ret;
 
-    ret = lt_l1_spi_csn_low(s2);
-    if (ret != LT_OK) {
-        return ret;
-    }
+#ifdef LT_L1_ADAPTIVE_POLL
+    // Response latency is learned per kind of the L2 Request.
+    lt_l1_poll_set_req_id(&s2->poll, s2->buff[0]);
+#endif
+
 #ifdef LT_PRINT_SPI_DATA
     print_hex_chunks(s2->buff, len, LT_L1_SPI_DIR_MOSI);
 #endif
-    ret = lt_l1_spi_transfer(s2, 0, len, timeout_ms);
-    if (ret != LT_OK) {
-        lt_ret_t ret_unused = lt_l1_spi_csn_high(s2);
-        LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
-        return ret;
+#ifdef LT_SPI_RECORDER
+    if (lt_spi_recorder_begin(s2->spi_rec, LT_SPI_REC_MOSI, len)) {
+        lt_spi_recorder_append(s2->spi_rec, s2->buff, len);
+        lt_spi_recorder_commit(s2->spi_rec);
     }
-
-    ret = lt_l1_spi_csn_high(s2);
+#endif
+    // Whole frame in one go, chip select is left high on failure.
+    const lt_spi_seg_t frame_seg = {NULL, NULL, len, 0};
+    ret = lt_l1_spi_transfer_v(s2, &frame_seg, 1, LT_SPI_V_CSN_LOW | LT_SPI_V_CSN_HIGH, timeout_ms);
     if (ret != LT_OK) {
         return ret;
     }
@@ -209,6 +537,71 @@ lt_ret_t lt_l1_write(lt_l2_state_t *s2, const uint16_t len, const uint32_t timeo
     return LT_OK;
 }
 
+#ifdef LT_L2_ZERO_COPY
+lt_ret_t lt_l1_write_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, const uint8_t seg_cnt, const uint32_t timeout_ms)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s2 || !segs || (seg_cnt == 0) || (seg_cnt > LT_SPI_V_SEGS_MAX)) {
+        return LT_PARAM_ERR;
+    }
+    if ((timeout_ms < LT_L1_TIMEOUT_MS_MIN) | (timeout_ms > LT_L1_TIMEOUT_MS_MAX)) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+#ifdef LT_DEADLINE
+    lt_ret_t ret_deadline = lt_deadline_check(s2, 0);
+    if (ret_deadline != LT_OK) {
+        return ret_deadline;
+    }
+#endif
+
+#ifdef LT_L1_ADAPTIVE_POLL
+    // Response latency is learned per kind of the L2 Request, REQ_ID is always first byte of the first segment.
+    lt_l1_poll_set_req_id(&s2->poll, segs[0].tx ? segs[0].tx[0] : s2->buff[segs[0].offset]);
+#endif
+
+#ifdef LT_PRINT_SPI_DATA
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        print_hex_chunks(segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset, segs[i].len, LT_L1_SPI_DIR_MOSI);
+    }
+#endif
+#ifdef LT_SPI_RECORDER
+    uint16_t rec_len = 0;
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        rec_len += segs[i].len;
+    }
+    if (lt_spi_recorder_begin(s2->spi_rec, LT_SPI_REC_MOSI, rec_len)) {
+        for (uint8_t i = 0; i < seg_cnt; i++) {
+            lt_spi_recorder_append(s2->spi_rec, segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset, segs[i].len);
+        }
+        lt_spi_recorder_commit(s2->spi_rec);
+    }
+#endif
+    // Whole frame in one go, chip select is left high on failure.
+    return lt_l1_spi_transfer_v(s2, segs, seg_cnt, LT_SPI_V_CSN_LOW | LT_SPI_V_CSN_HIGH, timeout_ms);
+}
+#endif
+
+/** Number of bytes of the raw alarm log printed by one call of lt_port_log(). */
+#define LT_L1_ALARM_LOG_ROW 16u
+
+/** Prints one row of the raw alarm log, formatted as `0x%02x ` per byte. */
+static void lt_l1_print_alarm_log_row(const uint8_t *data, const size_t len)
+{
+    char row[LT_L1_ALARM_LOG_ROW * 5 + 1];
+
+    for (size_t i = 0; i < len; i++) {
+        row[i * 5] = '0';
+        row[i * 5 + 1] = 'x';
+        lt_hex_encode(&row[i * 5 + 2], &data[i], 1, false);
+        row[i * 5 + 4] = ' ';
+    }
+    row[len * 5] = '\0';
+
+    lt_port_log("%s\n", row);
+}
+
 lt_ret_t lt_l1_retrieve_alarm_log(lt_l2_state_t *s2, const uint32_t timeout_ms)
 {
     LT_LOG_DEBUG("Retrieving alarm log from TROPIC01...");
@@ -243,18 +636,25 @@ lt_ret_t lt_l1_retrieve_alarm_log(lt_l2_state_t *s2, const uint32_t timeout_ms)
     uint8_t log_size = lt_min(s2->buff[TR01_L2_RSP_LEN_OFFSET], TR01_L2_CHUNK_MAX_DATA_SIZE);
     LT_LOG_DEBUG("LOG SIZE: %" PRIu8, log_size);
 
-    LT_LOG_DEBUG("------------ DECODED CPU Log BEGIN ------------");
-    for (size_t i = 0; i < log_size; i++) {  // log_size is guaranteed to be <= TR01_L2_CHUNK_MAX_DATA_SIZE
-        lt_port_log("%c", s2->buff[i + TR01_L2_RSP_DATA_RSP_CRC_OFFSET]);
+#ifdef LT_CPU_LOG_DRAIN
+    if (s2->cpu_log) {
+        // Printing is left to the reader of the CPU log, a slow console does not hold up the caller.
+        if (!lt_cpu_log_push(s2->cpu_log, &s2->buff[TR01_L2_RSP_DATA_RSP_CRC_OFFSET], log_size)) {
+            LT_LOG_WARN("CPU log is full, alarm log dropped.");
+        }
+        return LT_OK;
     }
-    lt_port_log("\n");
+#endif
+
+    LT_LOG_DEBUG("------------ DECODED CPU Log BEGIN ------------");
+    // log_size is guaranteed to be <= TR01_L2_CHUNK_MAX_DATA_SIZE
+    lt_port_log("%.*s\n", (int)log_size, (const char *)&s2->buff[TR01_L2_RSP_DATA_RSP_CRC_OFFSET]);
     LT_LOG_DEBUG("------------- DECODED CPU Log END -------------");
 
     LT_LOG_DEBUG("------------ RAW CPU Log BEGIN ------------");
-    for (size_t i = 0; i < sizeof(s2->buff); i++) {  // Print whole L2 buffer.
-        lt_port_log("0x%02x ", s2->buff[i]);
+    for (size_t i = 0; i < sizeof(s2->buff); i += LT_L1_ALARM_LOG_ROW) {  // Print whole L2 buffer, row by row.
+        lt_l1_print_alarm_log_row(&s2->buff[i], lt_min(sizeof(s2->buff) - i, (size_t)LT_L1_ALARM_LOG_ROW));
     }
-    lt_port_log("\n");
     LT_LOG_DEBUG("------------- RAW CPU Log END -------------");
 
     return LT_OK;
@@ -17,6 +17,7 @@
  */
 
 #include "libtropic_common.h"
+#include "libtropic_port.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +42,9 @@ extern "C" {
 /** Maximal timeout when waiting for activity on SPI bus */
 #define LT_L1_TIMEOUT_MS_MAX 150
 
+/** Number of bytes preceding RSP_DATA in the speculative read: CHIP_STATUS, STATUS and RSP_LEN */
+#define LT_L1_PREFETCH_HDR_LEN 3
+
 /** Get response request's ID */
 #define TR01_L1_GET_RESPONSE_REQ_ID 0xAA
 
@@ -55,6 +59,18 @@ extern "C" {
 lt_ret_t lt_l1_read(lt_l2_state_t *s2, const uint32_t max_len, const uint32_t timeout_ms)
     __attribute__((warn_unused_result));
 
+#ifdef LT_L2_ASYNC
+/**
+ * @brief Makes one attempt to read data from TROPIC01 into host platform, does not wait for TROPIC01
+ *
+ * @param s2          Structure holding l2 state
+ * @param timeout_ms  Timeout
+ * @return            LT_OK if success, LT_L1_CHIP_BUSY if TROPIC01 has no response ready yet, otherwise returns other
+ *                    error code.
+ */
+lt_ret_t lt_l1_read_nowait(lt_l2_state_t *s2, const uint32_t timeout_ms) __attribute__((warn_unused_result));
+#endif
+
 /**
  * @brief Writes data from host platform into TROPIC01
  *
@@ -66,6 +82,20 @@ lt_ret_t lt_l1_read(lt_l2_state_t *s2, const uint32_t max_len, const uint32_t ti
 lt_ret_t lt_l1_write(lt_l2_state_t *s2, const uint16_t len, const uint32_t timeout_ms)
     __attribute__((warn_unused_result));
 
+#ifdef LT_L2_ZERO_COPY
+/**
+ * @brief Writes L2 Request frame scattered over several buffers from host platform into TROPIC01
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Segments of the frame in the order of transmission, see lt_spi_seg_t
+ * @param seg_cnt     Number of segments, at most LT_SPI_V_SEGS_MAX
+ * @param timeout_ms  Timeout
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l1_write_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, const uint8_t seg_cnt, const uint32_t timeout_ms)
+    __attribute__((warn_unused_result));
+#endif
+
 /**
  * @brief Retrieves alarm log from TROPIC01.
  *
@@ -0,0 +1,99 @@
+/**
+ * @file lt_l1_poll.c
+ * @brief Adaptive CHIP_STATUS poll scheduler definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_l1_poll.h"
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_l2_api_structs.h"
+
+/** Learn slot used for all L2 Requests not listed in lt_l1_poll_slot(). */
+#define LT_L1_POLL_SLOT_OTHER (LT_L1_POLL_LEARN_SLOTS - 1)
+/** Learn slot of the start-up of TROPIC01 after reboot, see lt_l1_poll_set_reboot(). */
+#define LT_L1_POLL_SLOT_REBOOT (LT_L1_POLL_LEARN_SLOTS - 2)
+
+/**
+ * @brief Maps REQ_ID of the L2 Request to the index of its learn slot.
+ *
+ * @param req_id  REQ_ID of the L2 Request frame
+ * @return        Index into lt_l1_poll_state_t.expected_ms
+ */
+static uint8_t lt_l1_poll_slot(const uint8_t req_id)
+{
+    switch (req_id) {
+        case TR01_L2_GET_INFO_REQ_ID:
+            return 0;
+        case TR01_L2_HANDSHAKE_REQ_ID:
+            return 1;
+        case TR01_L2_ENCRYPTED_CMD_REQ_ID:
+            return 2;
+        case TR01_L2_RESEND_REQ_ID:
+            return 3;
+        case TR01_L2_SLEEP_REQ_ID:
+            return 4;
+        case TR01_L2_GET_LOG_REQ_ID:
+            return 5;
+        default:
+            return LT_L1_POLL_SLOT_OTHER;
+    }
+}
+
+void lt_l1_poll_set_req_id(lt_l1_poll_state_t *poll, const uint8_t req_id) { poll->slot = lt_l1_poll_slot(req_id); }
+
+void lt_l1_poll_set_reboot(lt_l1_poll_state_t *poll) { poll->slot = LT_L1_POLL_SLOT_REBOOT; }
+
+void lt_l1_poll_start(lt_l1_poll_state_t *poll)
+{
+    poll->waited_ms = 0;
+    poll->attempt = 0;
+}
+
+uint32_t lt_l1_poll_next_delay(lt_l1_poll_state_t *poll)
+{
+    if (poll->waited_ms >= LT_L1_POLL_BUDGET_MS) {
+        return 0;
+    }
+
+    uint32_t delay_ms;
+    uint16_t expected_ms = poll->expected_ms[poll->slot];
+
+    if ((poll->attempt == 0) && (expected_ms > LT_L1_POLL_DELAY_MIN_MS)) {
+        // Sleep for 3/4 of the learned latency first, the rest is covered by the fast backoff polls,
+        // so the learned value does not drift upwards by our own overshoot.
+        delay_ms = lt_min((uint32_t)expected_ms - (expected_ms >> 2), (uint32_t)LT_L1_POLL_BUDGET_MS);
+    }
+    else {
+        // Exponential backoff. Shift is bounded, the delay saturates long before.
+        uint8_t shift = lt_min(poll->attempt, 7);
+        delay_ms = lt_min((uint32_t)LT_L1_POLL_DELAY_MIN_MS << shift, (uint32_t)LT_L1_POLL_DELAY_MAX_MS);
+    }
+
+    // Do not exceed the total budget.
+    delay_ms = lt_min(delay_ms, (uint32_t)(LT_L1_POLL_BUDGET_MS - poll->waited_ms));
+
+    poll->waited_ms += (uint16_t)delay_ms;
+    if (poll->attempt < UINT8_MAX) {
+        poll->attempt++;
+    }
+
+    return delay_ms;
+}
+
+void lt_l1_poll_done(lt_l1_poll_state_t *poll)
+{
+    uint16_t *expected_ms = &poll->expected_ms[poll->slot];
+
+    if (*expected_ms == 0) {
+        *expected_ms = poll->waited_ms;
+    }
+    else {
+        // Exponentially weighted moving average, weight of the new sample is 1/4.
+        *expected_ms = (uint16_t)(((uint32_t)*expected_ms * 3 + poll->waited_ms) >> 2);
+    }
+}
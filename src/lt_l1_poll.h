@@ -0,0 +1,77 @@
+#ifndef LT_L1_POLL_H
+#define LT_L1_POLL_H
+
+/**
+ * @file lt_l1_poll.h
+ * @brief Adaptive CHIP_STATUS poll scheduler declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+#include "lt_l1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Shortest delay (ms) between two CHIP_STATUS polls. */
+#define LT_L1_POLL_DELAY_MIN_MS 1
+/** Longest delay (ms) between two CHIP_STATUS polls, backoff saturates here. */
+#define LT_L1_POLL_DELAY_MAX_MS LT_L1_READ_RETRY_DELAY
+/**
+ * Total time (ms) the scheduler is allowed to spend waiting for one response. Matches the worst case of the fixed
+ * polling (LT_L1_READ_MAX_TRIES * LT_L1_READ_RETRY_DELAY), so slow commands do not time out earlier.
+ */
+#define LT_L1_POLL_BUDGET_MS (LT_L1_READ_MAX_TRIES * LT_L1_READ_RETRY_DELAY)
+/** Max number of CHIP_STATUS polls for one response. Only a safety net, the time budget is hit first. */
+#define LT_L1_POLL_MAX_TRIES 255
+
+/**
+ * @brief Records REQ_ID of the L2 Request frame, which is about to be sent to TROPIC01.
+ *
+ * @param poll    Poll scheduler state
+ * @param req_id  REQ_ID of the L2 Request frame
+ */
+void lt_l1_poll_set_req_id(lt_l1_poll_state_t *poll, const uint8_t req_id);
+
+/**
+ * @brief Selects the learn slot of the start-up of TROPIC01 after reboot, which is polled by Get_Response requests
+ * (used only with LT_REBOOT_POLL).
+ *
+ * @param poll    Poll scheduler state
+ */
+void lt_l1_poll_set_reboot(lt_l1_poll_state_t *poll);
+
+/**
+ * @brief Starts scheduling of polls for one L2 Response frame.
+ *
+ * @param poll    Poll scheduler state
+ */
+void lt_l1_poll_start(lt_l1_poll_state_t *poll);
+
+/**
+ * @brief Returns how long to wait before the next CHIP_STATUS poll.
+ * @details First delay is derived from the latency learned for the current REQ_ID, following delays grow
+ * exponentially from LT_L1_POLL_DELAY_MIN_MS up to LT_L1_POLL_DELAY_MAX_MS.
+ *
+ * @param poll    Poll scheduler state
+ * @return        Delay in ms, 0 if the time budget (LT_L1_POLL_BUDGET_MS) is exhausted.
+ */
+uint32_t lt_l1_poll_next_delay(lt_l1_poll_state_t *poll);
+
+/**
+ * @brief Updates learned latency of the current REQ_ID, called when L2 Response frame was received.
+ *
+ * @param poll    Poll scheduler state
+ */
+void lt_l1_poll_done(lt_l1_poll_state_t *poll);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_L1_POLL_H
@@ -46,6 +46,8 @@ extern "C" {
 
 /** @brief Response length */
 #define TR01_L2_GET_INFO_RSP_LEN_MIN 1u
+/** @brief Length of one block of the certificate store */
+#define TR01_GET_INFO_BLOCK_LEN 128
 
 /**
  * @brief
@@ -8,31 +8,57 @@
 
 #include "lt_l2_frame_check.h"
 
+#include <string.h>
+
 #include "libtropic_common.h"
 #include "lt_crc16.h"
 
-lt_ret_t lt_l2_frame_check(const uint8_t *frame)
+/**
+ * @brief Checks STATUS and CRC of incomming L2 frame
+ *
+ * @param frame       Received L2 frame
+ * @param rsp_data    RSP_DATA of the frame, either inside of the frame or received elsewhere
+ * @param dst         RSP_DATA of valid and RESULT_CONT frames are copied here, NULL to not copy them
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l2_frame_check_data(const uint8_t *frame, const uint8_t *rsp_data, uint8_t *dst)
 {
-#ifdef LT_REDUNDANT_ARG_CHECK
-    if (!frame) {
-        return LT_PARAM_ERR;
-    }
-#endif
     // Take status, len and crc values from incomming frame
     uint8_t status = frame[1];
     uint8_t len = frame[2];
     uint16_t frame_crc = frame[len + 4] | frame[len + 3] << 8;
+    uint16_t crc;
 
     switch (status) {
         // Valid frames, or crc errors in INCOMMING frames are handled here:
         case TR01_L2_STATUS_REQUEST_OK:
         case TR01_L2_STATUS_RESULT_OK:
-            if (frame_crc != crc16(frame + 1, len + 2)) {
+            crc = crc16_update(LT_CRC16_INITIAL_VAL, frame + 1, 2);
+            // RSP_DATA are copied in the same pass as their CRC is calculated, so each byte is read once.
+            crc = crc16_final(dst ? crc16_copy_update(crc, dst, rsp_data, len) : crc16_update(crc, rsp_data, len));
+            if (frame_crc != crc) {
                 return LT_L2_IN_CRC_ERR;
             }
             return LT_OK;
 
-        // L2 statuses returned by Tropic chip are handled here
+        case TR01_L2_STATUS_RESULT_CONT:
+            if (dst) {
+                memcpy(dst, rsp_data, len);
+            }
+            return LT_L2_RES_CONT;
+
+        // Rest of L2 statuses returned by Tropic chip
+        default:
+            return lt_l2_status_check(status);
+    }
+}
+
+lt_ret_t lt_l2_status_check(const uint8_t status)
+{
+    switch (status) {
+        case TR01_L2_STATUS_REQUEST_OK:
+        case TR01_L2_STATUS_RESULT_OK:
+            return LT_OK;
         case TR01_L2_STATUS_REQUEST_CONT:
             return LT_L2_REQ_CONT;
         case TR01_L2_STATUS_RESULT_CONT:
@@ -57,3 +83,35 @@ lt_ret_t lt_l2_frame_check(const uint8_t *frame)
             return LT_L2_STATUS_UNKNOWN;
     }
 }
+
+lt_ret_t lt_l2_frame_check(const uint8_t *frame)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!frame) {
+        return LT_PARAM_ERR;
+    }
+#endif
+    return lt_l2_frame_check_data(frame, frame + 3, NULL);
+}
+
+lt_ret_t lt_l2_frame_check_copy(const uint8_t *frame, uint8_t *dst)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!frame || !dst) {
+        return LT_PARAM_ERR;
+    }
+#endif
+    return lt_l2_frame_check_data(frame, frame + 3, dst);
+}
+
+#ifdef LT_L2_ZERO_COPY
+lt_ret_t lt_l2_frame_check_split(const uint8_t *frame, const uint8_t *rsp_data)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!frame || !rsp_data) {
+        return LT_PARAM_ERR;
+    }
+#endif
+    return lt_l2_frame_check_data(frame, rsp_data, NULL);
+}
+#endif
@@ -50,6 +50,15 @@ extern "C" {
 /** @brief STATUS ﬁeld value */
 #define TR01_L2_STATUS_NO_RESP 0xFF
 
+/**
+ * @brief Translates STATUS field of L2 Response frame to return value, without checking the rest of the frame
+ *
+ * @param status      STATUS field
+ * @return            LT_OK for REQUEST_OK and RESULT_OK, otherwise the error code lt_l2_frame_check() returns for
+ *                    the status.
+ */
+lt_ret_t lt_l2_status_check(const uint8_t status) __attribute__((warn_unused_result));
+
 /**
  * @brief Checks if incomming L2 frame is valid
  *
@@ -58,6 +67,29 @@ extern "C" {
  */
 lt_ret_t lt_l2_frame_check(const uint8_t *frame) __attribute__((warn_unused_result));
 
+/**
+ * @brief Checks if incomming L2 frame is valid and copies its RSP_DATA, CRC is calculated during the copy
+ *
+ * @note RSP_DATA are copied for REQUEST_OK, RESULT_OK and RESULT_CONT statuses only. They may be copied even if CRC error is
+ * returned.
+ *
+ * @param frame       Received L2 frame
+ * @param dst         Destination of RSP_DATA, must have space for RSP_LEN bytes and not overlap with frame
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l2_frame_check_copy(const uint8_t *frame, uint8_t *dst) __attribute__((warn_unused_result));
+
+#ifdef LT_L2_ZERO_COPY
+/**
+ * @brief Checks if incomming L2 frame is valid, its RSP_DATA were received outside of the frame buffer
+ *
+ * @param frame       Received L2 frame, RSP_DATA are not used
+ * @param rsp_data    RSP_DATA of the frame
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l2_frame_check_split(const uint8_t *frame, const uint8_t *rsp_data) __attribute__((warn_unused_result));
+#endif
+
 /** @} */  // end of group_l2_frame_check_functions
 
 #ifdef __cplusplus
@@ -0,0 +1,148 @@
+/**
+ * @file lt_l3_buff_arena.c
+ * @brief Arena of L3 buffers shared by several handles definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_l3_buff_arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_port_wrap.h"
+#include "lt_secure_memzero.h"
+
+#if !LT_SEPARATE_L3_BUFF
+#error "LT_L3_BUFF_ARENA requires LT_SEPARATE_L3_BUFF"
+#endif
+
+// Borrowed buffers are tracked by bits of uint32_t.
+LT_STATIC_ASSERT(LT_L3_BUFF_ARENA_MAX <= 32)
+
+// Handles using one arena may run in different tasks, only the mask of borrowed buffers is shared by them.
+// Acquire/release ordering keeps accesses to a buffer between its borrow and return.
+
+lt_ret_t lt_l3_buff_arena_init(lt_l3_buff_arena_t *arena, uint8_t *mem, const size_t mem_len)
+{
+    if (!arena || !mem || ((uintptr_t)mem % LT_DMA_BUFF_ALIGN) || (mem_len < LT_L3_BUFF_ARENA_STRIDE)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(arena, 0, sizeof(lt_l3_buff_arena_t));
+    arena->mem = mem;
+    arena->cnt = (uint8_t)lt_min(mem_len / LT_L3_BUFF_ARENA_STRIDE, (size_t)LT_L3_BUFF_ARENA_MAX);
+    arena->timeout_ms = LT_L3_BUFF_ARENA_TIMEOUT_MS;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_l3_buff_arena_attach(lt_handle_t *h, lt_l3_buff_arena_t *arena)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_l3_buff_return(&h->l3);
+    h->l3.arena = arena;
+    h->l3.buff = NULL;
+    h->l3.buff_len = arena ? LT_L3_BUFF_ARENA_STRIDE : 0;
+
+    return LT_OK;
+}
+
+uint8_t lt_l3_buff_arena_in_use(const lt_l3_buff_arena_t *arena)
+{
+    if (!arena) {
+        return 0;
+    }
+
+    uint32_t used = __atomic_load_n(&arena->used, __ATOMIC_ACQUIRE);
+    uint8_t n = 0;
+    for (; used; used &= used - 1) {
+        n++;
+    }
+
+    return n;
+}
+
+/** Takes the first free buffer of the arena, returns its index or -1 if all are borrowed. */
+static int lt_l3_buff_arena_take(lt_l3_buff_arena_t *arena)
+{
+    uint32_t used = __atomic_load_n(&arena->used, __ATOMIC_RELAXED);
+
+    for (uint8_t i = 0; i < arena->cnt; i++) {
+        const uint32_t bit = (uint32_t)1 << i;
+        // On failure the exchange reloads the mask, the bit is tried again if another task has just returned it.
+        while (!(used & bit)) {
+            if (__atomic_compare_exchange_n(&arena->used, &used, used | bit, false, __ATOMIC_ACQUIRE,
+                                            __ATOMIC_RELAXED)) {
+                return i;
+            }
+        }
+    }
+
+    return -1;
+}
+
+lt_ret_t lt_l3_buff_borrow(lt_handle_t *h)
+{
+    lt_l3_buff_arena_t *arena = h->l3.arena;
+
+    // The buffer is kept by the handle if the previous L3 Command failed before its result was decoded.
+    if (!arena || h->l3.buff) {
+        return LT_OK;
+    }
+
+    int idx;
+    uint32_t waited_ms = 0;
+    while ((idx = lt_l3_buff_arena_take(arena)) < 0) {
+        if (!waited_ms) {
+            __atomic_fetch_add(&arena->waits, 1, __ATOMIC_RELAXED);
+        }
+        if (waited_ms >= arena->timeout_ms) {
+            return LT_L3_BUFF_ARENA_EMPTY;
+        }
+        lt_ret_t ret = lt_l1_delay(&h->l2, 1);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        waited_ms++;
+    }
+
+    h->l3.buff = arena->mem + (size_t)idx * LT_L3_BUFF_ARENA_STRIDE;
+    __atomic_fetch_add(&arena->borrows, 1, __ATOMIC_RELAXED);
+
+    uint8_t in_use = lt_l3_buff_arena_in_use(arena);
+    uint8_t peak = __atomic_load_n(&arena->peak, __ATOMIC_RELAXED);
+    while ((in_use > peak)
+           && !__atomic_compare_exchange_n(&arena->peak, &peak, in_use, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        // Peak was raised by another task, compared again with the reloaded value.
+    }
+
+    return LT_OK;
+}
+
+void lt_l3_buff_return(lt_l3_state_t *s3)
+{
+    lt_l3_buff_arena_t *arena = s3->arena;
+
+    if (!arena || !s3->buff) {
+        return;
+    }
+
+    const size_t idx = (size_t)(s3->buff - arena->mem) / LT_L3_BUFF_ARENA_STRIDE;
+
+    // Only the last packet (command or decrypted result) is wiped, its size bounded by the buffer.
+    const struct lt_l3_gen_frame_t *p_frame = (const struct lt_l3_gen_frame_t *)s3->buff;
+    lt_secure_memzero(s3->buff, lt_min((size_t)TR01_L3_SIZE_SIZE + p_frame->cmd_size + TR01_L3_TAG_SIZE,
+                                       (size_t)s3->buff_len));
+
+    s3->buff = NULL;
+    __atomic_fetch_and(&arena->used, ~((uint32_t)1 << idx), __ATOMIC_RELEASE);
+}
@@ -0,0 +1,51 @@
+#ifndef LT_L3_BUFF_ARENA_H
+#define LT_L3_BUFF_ARENA_H
+
+/**
+ * @file lt_l3_buff_arena.h
+ * @brief Arena of L3 buffers shared by several handles declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_L3_BUFF_ARENA
+/**
+ * @brief Borrows L3 buffer for the next L3 Command from the arena attached to the handle.
+ * @details Does nothing if no arena is attached or the handle still holds a buffer.
+ *
+ * @param h       Handle for communication with TROPIC01
+ * @return        LT_OK if the handle has the buffer, LT_L3_BUFF_ARENA_EMPTY if none got free in time, otherwise other
+ * error code.
+ */
+lt_ret_t lt_l3_buff_borrow(lt_handle_t *h);
+
+/**
+ * @brief Wipes the L3 buffer held by the handle and returns it to the arena.
+ * @details Does nothing if no arena is attached or the handle holds no buffer.
+ *
+ * @param s3      Layer 3 state of the handle
+ */
+void lt_l3_buff_return(lt_l3_state_t *s3);
+#else
+static inline lt_ret_t lt_l3_buff_borrow(lt_handle_t *h)
+{
+    LT_UNUSED(h);
+    return LT_OK;
+}
+
+static inline void lt_l3_buff_return(lt_l3_state_t *s3) { LT_UNUSED(s3); }
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_L3_BUFF_ARENA_H
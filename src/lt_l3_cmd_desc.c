@@ -0,0 +1,82 @@
+/**
+ * @file lt_l3_cmd_desc.c
+ * @brief Table of L3 command descriptors definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_l3_cmd_desc.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_l3_api_structs.h"
+
+// Sizes of the list have to agree with the structs, so a regenerated lt_l3_api_structs.h is caught at build time.
+#define LT_L3_CMD_CHECK(name, NAME, cmd_min, cmd_fixed, res_min, res_fixed, latency)                  \
+    LT_STATIC_ASSERT((cmd_min) <= LT_L3_CMD_SIZE_MAX(name))                                           \
+    LT_STATIC_ASSERT(!(cmd_fixed) || ((cmd_min) == LT_L3_CMD_SIZE_MAX(name)))                         \
+    LT_STATIC_ASSERT((res_min) <= LT_L3_RES_SIZE_MAX(name))                                           \
+    LT_STATIC_ASSERT(!(res_fixed) || ((res_min) == LT_L3_RES_SIZE_MAX(name)))                         \
+    LT_STATIC_ASSERT(sizeof(struct lt_l3_##name##_res_t) + TR01_L3_TAG_SIZE <= TR01_L3_PACKET_MAX_SIZE) \
+    LT_STATIC_ASSERT((latency) <= UINT16_MAX)
+LT_L3_CMD_LIST(LT_L3_CMD_CHECK)
+#undef LT_L3_CMD_CHECK
+
+LT_STATIC_ASSERT(LT_L3_CMD_SIZE_MAX(ping) == TR01_L3_PING_CMD_DATA_IN_LEN_MAX + TR01_L3_PING_CMD_SIZE_MIN)
+LT_STATIC_ASSERT(LT_L3_RES_SIZE_MAX(ping) == TR01_L3_PING_RES_SIZE_MAX)
+LT_STATIC_ASSERT(LT_L3_RES_SIZE_MAX(random_value_get) == TR01_L3_RANDOM_VALUE_GET_RES_SIZE_MAX)
+LT_STATIC_ASSERT(LT_L3_RES_SIZE_MAX(ecc_key_read) == TR01_L3_ECC_KEY_READ_RES_SIZE_MAX)
+LT_STATIC_ASSERT(LT_L3_CMD_SIZE_MAX(eddsa_sign) == TR01_L3_EDDSA_SIGN_CMD_SIZE_MAX)
+
+#ifdef LT_SUBMIT
+// Submitted commands are described by their type.
+LT_STATIC_ASSERT((int)LT_CMD_PING == (int)LT_L3_CMD_IDX_PING)
+LT_STATIC_ASSERT((int)LT_CMD_PAIRING_KEY_WRITE == (int)LT_L3_CMD_IDX_PAIRING_KEY_WRITE)
+LT_STATIC_ASSERT((int)LT_CMD_PAIRING_KEY_READ == (int)LT_L3_CMD_IDX_PAIRING_KEY_READ)
+LT_STATIC_ASSERT((int)LT_CMD_PAIRING_KEY_INVALIDATE == (int)LT_L3_CMD_IDX_PAIRING_KEY_INVALIDATE)
+LT_STATIC_ASSERT((int)LT_CMD_R_CONFIG_WRITE == (int)LT_L3_CMD_IDX_R_CONFIG_WRITE)
+LT_STATIC_ASSERT((int)LT_CMD_R_CONFIG_READ == (int)LT_L3_CMD_IDX_R_CONFIG_READ)
+LT_STATIC_ASSERT((int)LT_CMD_R_CONFIG_ERASE == (int)LT_L3_CMD_IDX_R_CONFIG_ERASE)
+LT_STATIC_ASSERT((int)LT_CMD_I_CONFIG_WRITE == (int)LT_L3_CMD_IDX_I_CONFIG_WRITE)
+LT_STATIC_ASSERT((int)LT_CMD_I_CONFIG_READ == (int)LT_L3_CMD_IDX_I_CONFIG_READ)
+LT_STATIC_ASSERT((int)LT_CMD_R_MEM_DATA_WRITE == (int)LT_L3_CMD_IDX_R_MEM_DATA_WRITE)
+LT_STATIC_ASSERT((int)LT_CMD_R_MEM_DATA_READ == (int)LT_L3_CMD_IDX_R_MEM_DATA_READ)
+LT_STATIC_ASSERT((int)LT_CMD_R_MEM_DATA_ERASE == (int)LT_L3_CMD_IDX_R_MEM_DATA_ERASE)
+LT_STATIC_ASSERT((int)LT_CMD_RANDOM_VALUE_GET == (int)LT_L3_CMD_IDX_RANDOM_VALUE_GET)
+LT_STATIC_ASSERT((int)LT_CMD_ECC_KEY_GENERATE == (int)LT_L3_CMD_IDX_ECC_KEY_GENERATE)
+LT_STATIC_ASSERT((int)LT_CMD_ECC_KEY_STORE == (int)LT_L3_CMD_IDX_ECC_KEY_STORE)
+LT_STATIC_ASSERT((int)LT_CMD_ECC_KEY_READ == (int)LT_L3_CMD_IDX_ECC_KEY_READ)
+LT_STATIC_ASSERT((int)LT_CMD_ECC_KEY_ERASE == (int)LT_L3_CMD_IDX_ECC_KEY_ERASE)
+LT_STATIC_ASSERT((int)LT_CMD_ECC_ECDSA_SIGN == (int)LT_L3_CMD_IDX_ECDSA_SIGN)
+LT_STATIC_ASSERT((int)LT_CMD_ECC_EDDSA_SIGN == (int)LT_L3_CMD_IDX_EDDSA_SIGN)
+LT_STATIC_ASSERT((int)LT_CMD_MCOUNTER_INIT == (int)LT_L3_CMD_IDX_MCOUNTER_INIT)
+LT_STATIC_ASSERT((int)LT_CMD_MCOUNTER_UPDATE == (int)LT_L3_CMD_IDX_MCOUNTER_UPDATE)
+LT_STATIC_ASSERT((int)LT_CMD_MCOUNTER_GET == (int)LT_L3_CMD_IDX_MCOUNTER_GET)
+LT_STATIC_ASSERT((int)LT_CMD_MAC_AND_DESTROY == (int)LT_L3_CMD_IDX_MAC_AND_DESTROY)
+#endif
+
+const lt_l3_cmd_desc_t lt_l3_cmd_descs[LT_L3_CMD_CNT] = {
+#define LT_L3_CMD_DESC(name, NAME, cmd_min, cmd_fixed, res_min, res_fixed, latency)                      \
+    [LT_L3_CMD_IDX_##NAME] = {.cmd_id = TR01_L3_##NAME##_CMD_ID,                                         \
+                              .cmd_size_min = (cmd_min),                                                 \
+                              .cmd_size_max = LT_L3_CMD_SIZE_MAX(name),                                  \
+                              .res_size_min = (res_min),                                                 \
+                              .res_packet_max = sizeof(struct lt_l3_##name##_res_t) + TR01_L3_TAG_SIZE, \
+                              .latency_ms = (latency)},
+    LT_L3_CMD_LIST(LT_L3_CMD_DESC)
+#undef LT_L3_CMD_DESC
+};
+
+const lt_l3_cmd_desc_t *lt_l3_cmd_desc_find(const uint8_t cmd_id)
+{
+    for (size_t i = 0; i < LT_L3_CMD_CNT; i++) {
+        if (lt_l3_cmd_descs[i].cmd_id == cmd_id) {
+            return &lt_l3_cmd_descs[i];
+        }
+    }
+
+    return NULL;
+}
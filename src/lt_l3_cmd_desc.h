@@ -0,0 +1,138 @@
+#ifndef LT_L3_CMD_DESC_H
+#define LT_L3_CMD_DESC_H
+
+/**
+ * @file lt_l3_cmd_desc.h
+ * @brief Table of L3 command descriptors declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_l3_api_structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief All L3 commands in the order of their IDs.
+ * @details X(name, NAME, cmd_size_min, cmd_fixed, res_size_min, res_fixed, latency_ms) is expanded per command:
+ *   - name, NAME:    Command name as used by lt_l3_api_structs.h, i.e. struct lt_l3_<name>_cmd_t and
+ *                    TR01_L3_<NAME>_CMD_ID.
+ *   - cmd_size_min:  Smallest command size (fields: CMD_ID + CMD_DATA), largest one is taken from the struct.
+ *   - cmd_fixed:     1 if the command has always the size of the struct.
+ *   - res_size_min:  Smallest result size (fields: RESULT + RES_DATA), largest one is taken from the struct.
+ *   - res_fixed:     1 if the result has always the size of the struct.
+ *   - latency_ms:    Expected latency, lower bound of the execution time, so the host does not oversleep. Commands
+ *                    with 0 (e.g. Ping) are quick enough to be polled for right away.
+ */
+#define LT_L3_CMD_LIST(X)                                                                                       \
+    X(ping, PING, TR01_L3_PING_CMD_SIZE_MIN, 0, TR01_L3_PING_RES_SIZE_MIN, 0, 0)                                \
+    X(pairing_key_write, PAIRING_KEY_WRITE, TR01_L3_PAIRING_KEY_WRITE_CMD_SIZE, 1,                              \
+      TR01_L3_PAIRING_KEY_WRITE_RES_SIZE, 1, 10)                                                                \
+    X(pairing_key_read, PAIRING_KEY_READ, TR01_L3_PAIRING_KEY_READ_CMD_SIZE, 1,                                 \
+      TR01_L3_PAIRING_KEY_READ_RES_SIZE, 1, 0)                                                                  \
+    X(pairing_key_invalidate, PAIRING_KEY_INVALIDATE, TR01_L3_PAIRING_KEY_INVALIDATE_CMD_SIZE, 1,               \
+      TR01_L3_PAIRING_KEY_INVALIDATE_RES_SIZE, 1, 10)                                                           \
+    X(r_config_write, R_CONFIG_WRITE, TR01_L3_R_CONFIG_WRITE_CMD_SIZE, 1, TR01_L3_R_CONFIG_WRITE_RES_SIZE, 1,   \
+      10)                                                                                                       \
+    X(r_config_read, R_CONFIG_READ, TR01_L3_R_CONFIG_READ_CMD_SIZE, 1, TR01_L3_R_CONFIG_READ_RES_SIZE, 1, 0)    \
+    X(r_config_erase, R_CONFIG_ERASE, TR01_L3_R_CONFIG_ERASE_CMD_SIZE, 1, TR01_L3_R_CONFIG_ERASE_RES_SIZE, 1,   \
+      20)                                                                                                       \
+    X(i_config_write, I_CONFIG_WRITE, TR01_L3_I_CONFIG_WRITE_CMD_SIZE, 1, TR01_L3_I_CONFIG_WRITE_RES_SIZE, 1,   \
+      10)                                                                                                       \
+    X(i_config_read, I_CONFIG_READ, TR01_L3_I_CONFIG_READ_CMD_SIZE, 1, TR01_L3_I_CONFIG_READ_RES_SIZE, 1, 0)    \
+    X(r_mem_data_write, R_MEM_DATA_WRITE, TR01_L3_R_MEM_DATA_WRITE_CMD_SIZE_MIN, 0,                             \
+      TR01_L3_R_MEM_DATA_WRITE_RES_SIZE, 1, 10)                                                                 \
+    X(r_mem_data_read, R_MEM_DATA_READ, TR01_L3_R_MEM_DATA_READ_CMD_SIZE, 1, TR01_L3_R_MEM_DATA_READ_RES_SIZE_MIN, \
+      0, 0)                                                                                                     \
+    X(r_mem_data_erase, R_MEM_DATA_ERASE, TR01_L3_R_MEM_DATA_ERASE_CMD_SIZE, 1,                                 \
+      TR01_L3_R_MEM_DATA_ERASE_RES_SIZE, 1, 10)                                                                 \
+    X(random_value_get, RANDOM_VALUE_GET, TR01_L3_RANDOM_VALUE_GET_CMD_SIZE, 1,                                 \
+      TR01_L3_RANDOM_VALUE_GET_RES_SIZE_MIN, 0, 0)                                                              \
+    X(ecc_key_generate, ECC_KEY_GENERATE, TR01_L3_ECC_KEY_GENERATE_CMD_SIZE, 1,                                 \
+      TR01_L3_ECC_KEY_GENERATE_RES_SIZE, 1, 15)                                                                 \
+    X(ecc_key_store, ECC_KEY_STORE, TR01_L3_ECC_KEY_STORE_CMD_SIZE, 1, TR01_L3_ECC_KEY_STORE_RES_SIZE, 1, 10)   \
+    X(ecc_key_read, ECC_KEY_READ, TR01_L3_ECC_KEY_READ_CMD_SIZE, 1, TR01_L3_ECC_KEY_READ_RES_SIZE_MIN, 0, 0)    \
+    X(ecc_key_erase, ECC_KEY_ERASE, TR01_L3_ECC_KEY_ERASE_CMD_SIZE, 1, TR01_L3_ECC_KEY_ERASE_RES_SIZE, 1, 10)   \
+    X(ecdsa_sign, ECDSA_SIGN, TR01_L3_ECDSA_SIGN_CMD_SIZE, 1, TR01_L3_ECDSA_SIGN_RES_SIZE, 1, 10)               \
+    X(eddsa_sign, EDDSA_SIGN, TR01_L3_EDDSA_SIGN_CMD_SIZE_MIN, 0, TR01_L3_EDDSA_SIGN_RES_SIZE, 1, 5)            \
+    X(mcounter_init, MCOUNTER_INIT, TR01_L3_MCOUNTER_INIT_CMD_SIZE, 1, TR01_L3_MCOUNTER_INIT_RES_SIZE, 1, 5)    \
+    X(mcounter_update, MCOUNTER_UPDATE, TR01_L3_MCOUNTER_UPDATE_CMD_SIZE, 1, TR01_L3_MCOUNTER_UPDATE_RES_SIZE,  \
+      1, 5)                                                                                                     \
+    X(mcounter_get, MCOUNTER_GET, TR01_L3_MCOUNTER_GET_CMD_SIZE, 1, TR01_L3_MCOUNTER_GET_RES_SIZE, 1, 0)        \
+    X(mac_and_destroy, MAC_AND_DESTROY, TR01_L3_MAC_AND_DESTROY_CMD_SIZE, 1, TR01_L3_MAC_AND_DESTROY_RES_SIZE,  \
+      1, 5)
+
+/** Largest command or result size (fields: CMD_ID/RESULT + DATA) given by the struct of lt_l3_api_structs.h. */
+#define LT_L3_CMD_SIZE_MAX(name) (sizeof(struct lt_l3_##name##_cmd_t) - TR01_L3_SIZE_SIZE)
+#define LT_L3_RES_SIZE_MAX(name) (sizeof(struct lt_l3_##name##_res_t) - TR01_L3_SIZE_SIZE)
+
+/** Index of the command in lt_l3_cmd_descs. */
+typedef enum lt_l3_cmd_idx_t {
+#define LT_L3_CMD_IDX(name, NAME, cmd_min, cmd_fixed, res_min, res_fixed, latency) LT_L3_CMD_IDX_##NAME,
+    LT_L3_CMD_LIST(LT_L3_CMD_IDX)
+#undef LT_L3_CMD_IDX
+        LT_L3_CMD_CNT
+} lt_l3_cmd_idx_t;
+
+/** Descriptor of the L3 command. */
+typedef struct lt_l3_cmd_desc_t {
+    uint8_t cmd_id;          /**< TR01_L3_<NAME>_CMD_ID */
+    uint16_t cmd_size_min;   /**< Smallest command size (fields: CMD_ID + CMD_DATA) */
+    uint16_t cmd_size_max;   /**< Largest command size (fields: CMD_ID + CMD_DATA) */
+    uint16_t res_size_min;   /**< Smallest result size (fields: RESULT + RES_DATA) */
+    uint16_t res_packet_max; /**< Largest result packet (incl. RES_SIZE and TAG) */
+    uint16_t latency_ms;     /**< Built-in expected latency, 0 if the result is polled for right away */
+} lt_l3_cmd_desc_t;
+
+/** Descriptors of all L3 commands, indexed by lt_l3_cmd_idx_t. */
+extern const lt_l3_cmd_desc_t lt_l3_cmd_descs[LT_L3_CMD_CNT];
+
+/**
+ * @brief Finds the descriptor of the L3 command.
+ *
+ * @param cmd_id  L3 command ID
+ * @return        Descriptor, NULL if the command is not known.
+ */
+const lt_l3_cmd_desc_t *lt_l3_cmd_desc_find(const uint8_t cmd_id);
+
+/**
+ * @brief Length of h->l3.buff the L3 Result of the command may be received into.
+ *
+ * @param h    Handle for communication with TROPIC01
+ * @param idx  Index of the command
+ * @return     Largest result packet of the command, limited by the length of the L3 buffer.
+ */
+static inline uint16_t lt_l3_cmd_res_max_len(const lt_handle_t *h, const lt_l3_cmd_idx_t idx)
+{
+    return (uint16_t)lt_min(h->l3.buff_len, lt_l3_cmd_descs[idx].res_packet_max);
+}
+
+/**
+ * @brief Length of h->l3.buff the L3 Command of the command is sent from and its L3 Result received into, as by
+ * `lt_l2_async_send_encrypted_cmd()`.
+ *
+ * @param h    Handle for communication with TROPIC01
+ * @param idx  Index of the command
+ * @return     Larger of the largest command packet and the largest result packet of the command, limited by the
+ *             length of the L3 buffer.
+ */
+static inline uint16_t lt_l3_cmd_packet_max_len(const lt_handle_t *h, const lt_l3_cmd_idx_t idx)
+{
+    const uint16_t cmd_packet_max = TR01_L3_SIZE_SIZE + lt_l3_cmd_descs[idx].cmd_size_max + TR01_L3_TAG_SIZE;
+    const uint16_t packet_max = lt_max(cmd_packet_max, lt_l3_cmd_descs[idx].res_packet_max);
+
+    return (uint16_t)lt_min(h->l3.buff_len, packet_max);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_L3_CMD_DESC_H
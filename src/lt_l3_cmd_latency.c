@@ -0,0 +1,46 @@
+/**
+ * @file lt_l3_cmd_latency.c
+ * @brief Expected latency of L3 commands definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_l3_cmd_latency.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+#include "lt_l3_cmd_desc.h"
+
+static uint16_t lt_l3_cmd_latency_find(const lt_l3_cmd_latency_t *tbl, const size_t cnt, const uint8_t cmd_id,
+                                       bool *found)
+{
+    for (size_t i = 0; i < cnt; i++) {
+        if (tbl[i].cmd_id == cmd_id) {
+            *found = true;
+            return tbl[i].latency_ms;
+        }
+    }
+
+    *found = false;
+    return 0;
+}
+
+uint16_t lt_l3_cmd_latency_get(const lt_handle_t *h, const uint8_t cmd_id)
+{
+    bool found;
+    uint16_t latency_ms;
+
+    if (h->l3.cmd_latency_tbl) {
+        latency_ms = lt_l3_cmd_latency_find(h->l3.cmd_latency_tbl, h->l3.cmd_latency_tbl_cnt, cmd_id, &found);
+        if (found) {
+            return latency_ms;
+        }
+    }
+
+    // Built-in latencies of the command descriptors, commands not known are polled for right away.
+    const lt_l3_cmd_desc_t *desc = lt_l3_cmd_desc_find(cmd_id);
+    return desc ? desc->latency_ms : 0;
+}
@@ -0,0 +1,34 @@
+#ifndef LT_L3_CMD_LATENCY_H
+#define LT_L3_CMD_LATENCY_H
+
+/**
+ * @file lt_l3_cmd_latency.h
+ * @brief Expected latency of L3 commands declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Returns expected time TROPIC01 needs to execute the L3 command.
+ * @details User table set by lt_set_l3_cmd_latency_table() is searched first, then the built-in table.
+ *
+ * @param h       Handle for communication with TROPIC01
+ * @param cmd_id  L3 command ID
+ * @return        Expected latency in ms, 0 if not known.
+ */
+uint16_t lt_l3_cmd_latency_get(const lt_handle_t *h, const uint8_t cmd_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_L3_CMD_LATENCY_H
@@ -16,10 +16,32 @@
 #include "libtropic_common.h"
 #include "libtropic_l2.h"
 #include "libtropic_logging.h"
+#include "libtropic_macros.h"
 #include "lt_aesgcm.h"
 #include "lt_crypto_common.h"
 #include "lt_l1.h"
+#include "lt_l3_buff_arena.h"
 #include "lt_secure_memzero.h"
+#include "lt_sha256.h"
+#include "lt_stats.h"
+#include "lt_trace.h"
+
+#ifdef LT_STATS
+#include "libtropic_port.h"
+#endif
+
+#ifdef LT_METRICS
+#include "lt_metrics.h"
+#endif
+
+#ifdef LT_SPI_RECORDER
+#include "lt_spi_recorder.h"
+#endif
+
+static uint32_t lt_l3_nonce_value(const uint8_t *nonce)
+{
+    return ((uint32_t)nonce[3] << 24) | ((uint32_t)nonce[2] << 16) | ((uint32_t)nonce[1] << 8) | (nonce[0]);
+}
 
 static lt_ret_t lt_l3_nonce_increase(uint8_t *nonce)
 {
@@ -28,7 +50,7 @@ static lt_ret_t lt_l3_nonce_increase(uint8_t *nonce)
         return LT_PARAM_ERR;
     }
 #endif
-    uint32_t nonce_int = (nonce[3] << 24) | (nonce[2] << 16) | (nonce[1] << 8) | (nonce[0]);
+    uint32_t nonce_int = lt_l3_nonce_value(nonce);
 
     if (nonce_int == UINT32_MAX) {
         return LT_NONCE_OVERFLOW;
@@ -44,12 +66,94 @@ static lt_ret_t lt_l3_nonce_increase(uint8_t *nonce)
     return LT_OK;
 }
 
+uint32_t lt_l3_nonce_get(const lt_l3_state_t *s3)
+{
+    uint32_t enc = lt_l3_nonce_value(s3->encryption_IV);
+    uint32_t dec = lt_l3_nonce_value(s3->decryption_IV);
+
+    return (enc > dec) ? enc : dec;
+}
+
+#ifdef LT_STATS
+/**
+ * @brief Remembers L3 Command ID and time of encryption of the L3 Command, so its execution time can be accumulated
+ * when the L3 Result with the same nonce is decrypted (at most two L3 Commands are in flight, see lt_sign_queue_t).
+ *
+ * @param s3      Structure holding l3 state
+ * @param cmd_id  L3 Command ID
+ */
+static void lt_l3_stats_cmd_start(lt_l3_state_t *s3, const uint8_t cmd_id)
+{
+    uint8_t idx = lt_l3_nonce_value(s3->encryption_IV) & 1;
+
+    if (!s3->rt_stats) {
+        return;
+    }
+
+    s3->rt_stats_cmd_id[idx] = cmd_id;
+    s3->rt_stats_cmd_start_us[idx] = lt_port_time_us();
+}
+
+/**
+ * @brief Accumulates execution time of the L3 Command, whose L3 Result was just decrypted.
+ *
+ * @param s3      Structure holding l3 state
+ */
+static void lt_l3_stats_cmd_end(lt_l3_state_t *s3)
+{
+    lt_stats_t *stats = s3->rt_stats;
+    uint8_t idx = lt_l3_nonce_value(s3->decryption_IV) & 1;
+
+    if (!stats) {
+        return;
+    }
+
+    for (int i = 0; i < LT_STATS_L3_CMDS; i++) {
+        lt_stats_l3_cmd_t *cmd = &stats->l3_cmds[i];
+        if ((cmd->count == 0) || (cmd->cmd_id == s3->rt_stats_cmd_id[idx])) {
+            uint64_t time_us = lt_port_time_us() - s3->rt_stats_cmd_start_us[idx];
+            cmd->cmd_id = s3->rt_stats_cmd_id[idx];
+            cmd->count++;
+            cmd->time_us += time_us;
+#ifdef LT_METRICS
+            cmd->hist[lt_metrics_bucket(time_us)]++;
+#endif
+            return;
+        }
+    }
+    stats->l3_cmds_untracked++;
+}
+
+/**
+ * @brief Updates the highest nonce reached.
+ *
+ * @param s3      Structure holding l3 state
+ */
+static void lt_l3_stats_nonce(lt_l3_state_t *s3)
+{
+    uint32_t nonce = lt_l3_nonce_get(s3);
+
+    if (s3->rt_stats && (nonce > s3->rt_stats->l3_nonce_max)) {
+        s3->rt_stats->l3_nonce_max = nonce;
+    }
+}
+#endif
+
+#if LT_SEPARATE_L3_BUFF
+#define LT_L3_BUFF_CAPACITY(s3) ((size_t)(s3)->buff_len)
+#else
+#define LT_L3_BUFF_CAPACITY(s3) sizeof((s3)->buff)
+#endif
+
 void lt_l3_invalidate_host_session_data(lt_l3_state_t *s3)
 {
     s3->session_status = LT_SECURE_SESSION_OFF;
 
     lt_secure_memzero(s3->encryption_IV, sizeof(s3->encryption_IV));
     lt_secure_memzero(s3->decryption_IV, sizeof(s3->decryption_IV));
+#ifdef LT_SESSION_EXPORT
+    lt_secure_memzero(s3->session_keys, sizeof(s3->session_keys));
+#endif
 
     lt_ret_t ret = lt_crypto_ctx_deinit(s3->crypto_ctx);
     if (ret != LT_OK) {
@@ -57,35 +161,120 @@ void lt_l3_invalidate_host_session_data(lt_l3_state_t *s3)
     }
 
 #if LT_SEPARATE_L3_BUFF
-    lt_secure_memzero(s3->buff, s3->buff_len);
-#else
-    lt_secure_memzero(s3->buff, sizeof(s3->buff));
+#ifdef LT_L3_BUFF_ARENA
+    if (s3->arena) {
+        // The buffer is wiped when returned, the handle may hold none.
+        lt_l3_buff_return(s3);
+        return;
+    }
 #endif
+#endif
+    // Only the part which held plaintext since the last wipe, the rest held at most ciphertext.
+    if (s3->buff_dirty) {
+        lt_secure_memzero(s3->buff, lt_min((size_t)s3->buff_dirty, LT_L3_BUFF_CAPACITY(s3)));
+        s3->buff_dirty = 0;
+    }
 }
 
-lt_ret_t lt_l3_encrypt_request(lt_l3_state_t *s3)
+/**
+ * @brief Raises the part of the L3 buffer zeroed by lt_l3_invalidate_host_session_data() to cover a frame, which is
+ * going to hold plaintext.
+ *
+ * @param s3          Structure holding l3 state
+ * @param p_frame     Frame in the L3 buffer, other buffers are not tracked
+ */
+static void lt_l3_buff_dirty(lt_l3_state_t *s3, const struct lt_l3_gen_frame_t *p_frame)
 {
-#ifdef LT_REDUNDANT_ARG_CHECK
-    if (!s3) {
-        return LT_PARAM_ERR;
+    if ((const uint8_t *)p_frame != s3->buff) {
+        return;
     }
-#endif
 
-    struct lt_l3_gen_frame_t *p_frame = (struct lt_l3_gen_frame_t *)s3->buff;
+    const size_t frame_len = (size_t)TR01_L3_SIZE_SIZE + p_frame->cmd_size + TR01_L3_TAG_SIZE;
+    const size_t len = lt_min(frame_len, LT_L3_BUFF_CAPACITY(s3));
+    if (len > s3->buff_dirty) {
+        s3->buff_dirty = (uint16_t)len;
+    }
+}
 
-    // p_frame->data is both input plaintext and output ciphertext buffer,
-    // it is large enough to hold both plaintext and ciphertext + tag.
-    int ret = lt_aesgcm_encrypt(s3->crypto_ctx, s3->encryption_IV, TR01_L3_IV_SIZE, (uint8_t *)"", 0, p_frame->data,
-                                p_frame->cmd_size, p_frame->data, p_frame->cmd_size + TR01_L3_TAG_SIZE);
+/** SHA256("Noise_KK1_25519_AESGCM_SHA256\x00\x00\x00"), the first step of the handshake transcript hash. */
+static const uint8_t lt_l3_protocol_name_hash[LT_SHA256_DIGEST_LENGTH]
+    = {0xdc, 0x3c, 0xec, 0x09, 0x55, 0x41, 0xd8, 0x08, 0x3c, 0x2d, 0x1a, 0xf6, 0xb2, 0xf4, 0x03, 0x0f,
+       0xa3, 0xd6, 0x3e, 0x4d, 0x78, 0x70, 0xd6, 0x76, 0x6c, 0x80, 0x60, 0x60, 0x10, 0x5a, 0xe8, 0xdc};
+
+lt_ret_t lt_l3_transcript_update(void *crypto_ctx, uint8_t *hash, const uint8_t *data, const size_t data_len)
+{
+    lt_ret_t ret = lt_sha256_start(crypto_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_sha256_update(crypto_ctx, hash, LT_SHA256_DIGEST_LENGTH);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_sha256_update(crypto_ctx, data, data_len);
     if (ret != LT_OK) {
-        lt_l3_invalidate_host_session_data(s3);
         return ret;
     }
 
+    return lt_sha256_finish(crypto_ctx, hash);
+}
+
+lt_ret_t lt_l3_transcript_prefix(void *crypto_ctx, const uint8_t *shipub, const uint8_t *stpub, uint8_t *hash)
+{
+    // h = SHA_256(protocol_name), protocol_name is the constant Noise_KK1_25519_AESGCM_SHA256\x00\x00\x00
+    memcpy(hash, lt_l3_protocol_name_hash, LT_SHA256_DIGEST_LENGTH);
+
+    // h = SHA256(h||SHiPUB)
+    lt_ret_t ret = lt_l3_transcript_update(crypto_ctx, hash, shipub, TR01_SHIPUB_LEN);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    // h = SHA256(h||STPUB)
+    return lt_l3_transcript_update(crypto_ctx, hash, stpub, TR01_STPUB_LEN);
+}
+
+/**
+ * @brief Records start of L3 Command, whose plaintext is in the frame, into statistics and SPI recorder.
+ *
+ * @param s3          Structure holding l3 state
+ * @param p_frame     L3 Command before encryption
+ */
+static void lt_l3_cmd_begin(lt_l3_state_t *s3, const struct lt_l3_gen_frame_t *p_frame)
+{
+    lt_l3_buff_dirty(s3, p_frame);
+#ifdef LT_STATS
+    // L3 Command ID is the first byte of the plaintext.
+    lt_l3_stats_cmd_start(s3, p_frame->data[0]);
+#endif
+#ifdef LT_SPI_RECORDER
+    const uint8_t rec_cmd[] = {p_frame->data[0], p_frame->cmd_size & 0xFF, p_frame->cmd_size >> 8};
+    if (lt_spi_recorder_begin(s3->spi_rec, LT_SPI_REC_L3_CMD, sizeof(rec_cmd))) {
+        lt_spi_recorder_append(s3->spi_rec, rec_cmd, sizeof(rec_cmd));
+        lt_spi_recorder_commit(s3->spi_rec);
+    }
+#endif
+}
+
+/**
+ * @brief Increases encryption nonce once the L3 Command was encrypted with it.
+ *
+ * @param s3          Structure holding l3 state
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l3_encryption_nonce_increase(lt_l3_state_t *s3)
+{
+#ifdef LT_STATS
+    lt_ret_t ret = lt_l3_nonce_increase(s3->encryption_IV);
+    lt_l3_stats_nonce(s3);
+
+    return ret;
+#else
     return lt_l3_nonce_increase(s3->encryption_IV);
+#endif
 }
 
-lt_ret_t lt_l3_decrypt_response(lt_l3_state_t *s3)
+lt_ret_t lt_l3_encrypt_request(lt_l3_state_t *s3)
 {
 #ifdef LT_REDUNDANT_ARG_CHECK
     if (!s3) {
@@ -93,33 +282,64 @@ lt_ret_t lt_l3_decrypt_response(lt_l3_state_t *s3)
     }
 #endif
 
-    struct lt_l3_gen_frame_t *p_frame = (struct lt_l3_gen_frame_t *)s3->buff;
+    return lt_l3_encrypt_request_buff(s3, s3->buff);
+}
 
-    if (p_frame->cmd_size > TR01_L3_RES_CIPHERTEXT_MAX_SIZE) {
-        lt_l3_invalidate_host_session_data(s3);
-        return LT_L3_RES_SIZE_ERROR;
+lt_ret_t lt_l3_encrypt_request_buff(lt_l3_state_t *s3, uint8_t *buff)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s3 || !buff) {
+        return LT_PARAM_ERR;
     }
+#endif
 
-    // This check makes sure the decryption function does not go past buffer bounds.
-    if (TR01_L3_SIZE_SIZE + p_frame->cmd_size + TR01_L3_TAG_SIZE > s3->buff_len) {
-        lt_l3_invalidate_host_session_data(s3);
-        return LT_L3_BUFFER_TOO_SMALL;
-    }
+    struct lt_l3_gen_frame_t *p_frame = (struct lt_l3_gen_frame_t *)buff;
 
-    lt_ret_t ret
-        = lt_aesgcm_decrypt(s3->crypto_ctx, s3->decryption_IV, TR01_L3_IV_SIZE, (uint8_t *)"", 0, p_frame->data,
-                            p_frame->cmd_size + TR01_L3_TAG_SIZE, p_frame->data, p_frame->cmd_size);
+    lt_l3_cmd_begin(s3, p_frame);
+
+    // p_frame->data is both input plaintext and output ciphertext buffer,
+    // it is large enough to hold both plaintext and ciphertext + tag.
+    LT_TRACE_START(s3->trace, LT_TRACE_CAL_ENCRYPT);
+    int ret = lt_aesgcm_encrypt(s3->crypto_ctx, s3->encryption_IV, TR01_L3_IV_SIZE, (uint8_t *)"", 0, p_frame->data,
+                                p_frame->cmd_size, p_frame->data, p_frame->cmd_size + TR01_L3_TAG_SIZE);
+    LT_TRACE_END(s3->trace, LT_TRACE_CAL_ENCRYPT);
     if (ret != LT_OK) {
         lt_l3_invalidate_host_session_data(s3);
         return ret;
     }
 
-    ret = lt_l3_nonce_increase(s3->decryption_IV);
+    return lt_l3_encryption_nonce_increase(s3);
+}
+
+/**
+ * @brief Finishes L3 Result which was decrypted and authenticated: increases decryption nonce and translates RESULT
+ * into return value.
+ *
+ * @param s3          Structure holding l3 state
+ * @param result      Decrypted RESULT and following bytes
+ * @return            LT_OK if RESULT is OK, otherwise returns other error code.
+ */
+static lt_ret_t lt_l3_result_decrypted(lt_l3_state_t *s3, const uint8_t *result)
+{
+#ifdef LT_STATS
+    lt_l3_stats_cmd_end(s3);
+#endif
+#ifdef LT_HEALTH
+    // Any authenticated result, even not OK one, proves TROPIC01 and the Secure Session work.
+    s3->last_res_us = lt_port_time_us();
+#endif
+#ifdef LT_SPI_RECORDER
+    if (lt_spi_recorder_begin(s3->spi_rec, LT_SPI_REC_L3_RES, TR01_L3_RESULT_SIZE)) {
+        lt_spi_recorder_append(s3->spi_rec, result, TR01_L3_RESULT_SIZE);
+        lt_spi_recorder_commit(s3->spi_rec);
+    }
+#endif
+    lt_ret_t ret = lt_l3_nonce_increase(s3->decryption_IV);
     if (LT_OK != ret) {
         return ret;
     }
 
-    switch (p_frame->data[0]) {
+    switch (result[0]) {
         case TR01_L3_RESULT_FAIL:
             return LT_L3_FAIL;
         case TR01_L3_RESULT_UNAUTHORIZED:
@@ -148,3 +368,225 @@ lt_ret_t lt_l3_decrypt_response(lt_l3_state_t *s3)
             return LT_L3_RESULT_UNKNOWN;
     }
 }
+
+#ifdef LT_L3_STREAM_ENCRYPT
+lt_ret_t lt_l3_encrypt_stream_start(lt_l3_state_t *s3)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s3) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+    lt_l3_cmd_begin(s3, (const struct lt_l3_gen_frame_t *)s3->buff);
+
+    lt_ret_t ret
+        = lt_aesgcm_encrypt_start(s3->crypto_ctx, s3->encryption_IV, TR01_L3_IV_SIZE, (uint8_t *)"", 0);
+    if (ret != LT_OK) {
+        lt_l3_invalidate_host_session_data(s3);
+        return ret;
+    }
+
+    // The nonce was taken by the CAL, so it is increased right away as in lt_l3_encrypt_request().
+    return lt_l3_encryption_nonce_increase(s3);
+}
+
+lt_ret_t lt_l3_encrypt_stream_chunk(void *cb_ctx, uint8_t *chunk, const uint8_t len)
+{
+    lt_l3_state_t *s3 = (lt_l3_state_t *)cb_ctx;
+    const struct lt_l3_gen_frame_t *p_frame = (const struct lt_l3_gen_frame_t *)s3->buff;
+
+    // Positions in the L3 packet: plain CMD_SIZE, ciphertext from TR01_L3_SIZE_SIZE, TAG from tag_pos.
+    const size_t start = (size_t)(chunk - s3->buff);
+    const size_t end = start + len;
+    const size_t tag_pos = TR01_L3_SIZE_SIZE + p_frame->cmd_size;
+    const size_t from = lt_max(start, (size_t)TR01_L3_SIZE_SIZE);
+    const size_t to = lt_min(end, tag_pos);
+
+    lt_ret_t ret = LT_OK;
+    LT_TRACE_START(s3->trace, LT_TRACE_CAL_ENCRYPT);
+    if (from < to) {
+        ret = lt_aesgcm_encrypt_update(s3->crypto_ctx, s3->buff + from, (uint32_t)(to - from), s3->buff + from);
+    }
+    // TAG is computed for the chunk in which it starts, it might continue in the next one.
+    if ((ret == LT_OK) && (start <= tag_pos) && (tag_pos < end)) {
+        ret = lt_aesgcm_encrypt_finish(s3->crypto_ctx, s3->buff + tag_pos, TR01_L3_TAG_SIZE);
+    }
+    LT_TRACE_END(s3->trace, LT_TRACE_CAL_ENCRYPT);
+    if (ret != LT_OK) {
+        lt_l3_invalidate_host_session_data(s3);
+    }
+
+    return ret;
+}
+#endif
+
+lt_ret_t lt_l3_decrypt_response(lt_l3_state_t *s3)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s3) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+    return lt_l3_decrypt_response_buff(s3, s3->buff, s3->buff_len);
+}
+
+lt_ret_t lt_l3_decrypt_response_buff(lt_l3_state_t *s3, uint8_t *buff, const uint16_t buff_len)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s3 || !buff) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+    struct lt_l3_gen_frame_t *p_frame = (struct lt_l3_gen_frame_t *)buff;
+
+    if (p_frame->cmd_size > TR01_L3_RES_CIPHERTEXT_MAX_SIZE) {
+        lt_l3_invalidate_host_session_data(s3);
+        return LT_L3_RES_SIZE_ERROR;
+    }
+
+    // This check makes sure the decryption function does not go past buffer bounds.
+    if (TR01_L3_SIZE_SIZE + p_frame->cmd_size + TR01_L3_TAG_SIZE > buff_len) {
+        lt_l3_invalidate_host_session_data(s3);
+        return LT_L3_BUFFER_TOO_SMALL;
+    }
+
+    // The result is decrypted in place.
+    lt_l3_buff_dirty(s3, p_frame);
+
+    LT_TRACE_START(s3->trace, LT_TRACE_CAL_DECRYPT);
+    lt_ret_t ret
+        = lt_aesgcm_decrypt(s3->crypto_ctx, s3->decryption_IV, TR01_L3_IV_SIZE, (uint8_t *)"", 0, p_frame->data,
+                            p_frame->cmd_size + TR01_L3_TAG_SIZE, p_frame->data, p_frame->cmd_size);
+    LT_TRACE_END(s3->trace, LT_TRACE_CAL_DECRYPT);
+    if (ret != LT_OK) {
+        lt_l3_invalidate_host_session_data(s3);
+        return ret;
+    }
+
+    return lt_l3_result_decrypted(s3, p_frame->data);
+}
+
+#ifdef LT_L3_STREAM_DECRYPT
+void lt_l3_decrypt_stream_start(lt_l3_decrypt_stream_t *st, lt_l3_state_t *s3, const uint8_t hdr_len, uint8_t *out,
+                                const uint16_t out_len, const uint16_t res_size_max)
+{
+    memset(st, 0, sizeof(lt_l3_decrypt_stream_t));
+    st->s3 = s3;
+    st->hdr_len = lt_min(hdr_len, (uint8_t)sizeof(st->hdr));
+    st->out = out;
+    st->out_len = out_len;
+    st->res_size_max = res_size_max;
+}
+
+/**
+ * @brief Fails the streamed L3 Result which cannot be authenticated: wipes unauthenticated plaintext and invalidates
+ * host's session data.
+ *
+ * @param st          Stream state
+ * @param ret         Return value to pass through
+ * @return            ret
+ */
+static lt_ret_t lt_l3_decrypt_stream_fail(lt_l3_decrypt_stream_t *st, const lt_ret_t ret)
+{
+    if (st->out) {
+        lt_secure_memzero(st->out, st->out_len);
+    }
+    lt_secure_memzero(st->hdr, sizeof(st->hdr));
+    lt_secure_memzero(st->discard, sizeof(st->discard));
+    lt_l3_invalidate_host_session_data(st->s3);
+
+    return ret;
+}
+
+lt_ret_t lt_l3_decrypt_stream_chunk(void *cb_ctx, const uint8_t *chunk, const uint8_t len)
+{
+    lt_l3_decrypt_stream_t *st = (lt_l3_decrypt_stream_t *)cb_ctx;
+    uint8_t i = 0;
+
+    // RES_SIZE, decryption starts once both bytes are known.
+    while ((i < len) && (st->pos < TR01_L3_SIZE_SIZE)) {
+        st->size[st->pos++] = chunk[i++];
+        if (st->pos == TR01_L3_SIZE_SIZE) {
+            memcpy(&st->res_size, st->size, sizeof(st->res_size));
+            if ((st->res_size > TR01_L3_RES_CIPHERTEXT_MAX_SIZE) || (st->res_size > st->res_size_max)) {
+                return lt_l3_decrypt_stream_fail(st, LT_L3_RES_SIZE_ERROR);
+            }
+            lt_ret_t ret = lt_aesgcm_decrypt_start(st->s3->crypto_ctx, st->s3->decryption_IV, TR01_L3_IV_SIZE,
+                                                   (uint8_t *)"", 0);
+            if (ret != LT_OK) {
+                return lt_l3_decrypt_stream_fail(st, ret);
+            }
+        }
+    }
+
+    // Ciphertext, header goes to the stream state, data to the caller's buffer, the rest is discarded.
+    const uint16_t ct_end = TR01_L3_SIZE_SIZE + st->res_size;
+    while ((i < len) && (st->pos < ct_end)) {
+        const uint16_t pt_pos = st->pos - TR01_L3_SIZE_SIZE;
+        uint16_t n = lt_min((uint16_t)(len - i), (uint16_t)(ct_end - st->pos));
+        uint8_t *dst;
+
+        if (pt_pos < st->hdr_len) {
+            dst = st->hdr + pt_pos;
+            n = lt_min(n, (uint16_t)(st->hdr_len - pt_pos));
+        }
+        else if (pt_pos - st->hdr_len < st->out_len) {
+            dst = st->out + (pt_pos - st->hdr_len);
+            n = lt_min(n, (uint16_t)(st->out_len - (pt_pos - st->hdr_len)));
+        }
+        else {
+            dst = st->discard;
+            n = lt_min(n, (uint16_t)sizeof(st->discard));
+        }
+
+        LT_TRACE_START(st->s3->trace, LT_TRACE_CAL_DECRYPT);
+        lt_ret_t ret = lt_aesgcm_decrypt_update(st->s3->crypto_ctx, chunk + i, n, dst);
+        LT_TRACE_END(st->s3->trace, LT_TRACE_CAL_DECRYPT);
+        if (ret != LT_OK) {
+            return lt_l3_decrypt_stream_fail(st, ret);
+        }
+        i += n;
+        st->pos += n;
+    }
+
+    // TAG
+    while ((i < len) && (st->pos < ct_end + TR01_L3_TAG_SIZE)) {
+        st->tag[st->pos++ - ct_end] = chunk[i++];
+    }
+
+    // Nothing is expected behind the TAG.
+    if (i < len) {
+        return lt_l3_decrypt_stream_fail(st, LT_L3_RES_SIZE_ERROR);
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_l3_decrypt_stream_finish(lt_l3_decrypt_stream_t *st, const lt_ret_t l2_ret)
+{
+    if (l2_ret != LT_OK) {
+        // Session data were already invalidated if the stream itself failed.
+        if (st->out) {
+            lt_secure_memzero(st->out, st->out_len);
+        }
+        return l2_ret;
+    }
+
+    if (st->pos != TR01_L3_SIZE_SIZE + st->res_size + TR01_L3_TAG_SIZE) {
+        return lt_l3_decrypt_stream_fail(st, LT_L3_RES_SIZE_ERROR);
+    }
+
+    LT_TRACE_START(st->s3->trace, LT_TRACE_CAL_DECRYPT);
+    lt_ret_t ret = lt_aesgcm_decrypt_finish(st->s3->crypto_ctx, st->tag, TR01_L3_TAG_SIZE);
+    LT_TRACE_END(st->s3->trace, LT_TRACE_CAL_DECRYPT);
+    if (ret != LT_OK) {
+        return lt_l3_decrypt_stream_fail(st, ret);
+    }
+    lt_secure_memzero(st->discard, sizeof(st->discard));
+
+    return lt_l3_result_decrypted(st->s3, st->hdr);
+}
+#endif
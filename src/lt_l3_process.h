@@ -16,6 +16,9 @@
  * @license For the license see LICENSE.md in the root directory of this source tree.
  */
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "libtropic_common.h"
 
 #ifdef __cplusplus
@@ -80,13 +83,177 @@ lt_ret_t lt_l3_encrypt_request(lt_l3_state_t *s3) __attribute__((warn_unused_res
  */
 lt_ret_t lt_l3_decrypt_response(lt_l3_state_t *s3) __attribute__((warn_unused_result));
 
+/**
+ * @brief Same as lt_l3_encrypt_request(), but for L3 Command prepared in a buffer other than the L3 buffer.
+ * @note Commands are encrypted in the order they are sent to TROPIC01, as each one takes the next nonce.
+ *
+ * @param s3          Structure holding l3 state
+ * @param buff        Buffer with L3 Command, large enough for its ciphertext and tag
+ *
+ * @retval            LT_OK Function executed successfully
+ * @retval            other Function did not execute successully
+ */
+lt_ret_t lt_l3_encrypt_request_buff(lt_l3_state_t *s3, uint8_t *buff) __attribute__((warn_unused_result));
+
+/**
+ * @brief Same as lt_l3_decrypt_response(), but for L3 Result received into a buffer other than the L3 buffer.
+ *
+ * @param s3          Structure holding l3 state
+ * @param buff        Buffer with encrypted L3 Result, decrypted in place
+ * @param buff_len    Length of buff
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l3_decrypt_response_buff(lt_l3_state_t *s3, uint8_t *buff, const uint16_t buff_len)
+    __attribute__((warn_unused_result));
+
+#ifdef LT_L3_STREAM_ENCRYPT
+/**
+ * @name Streaming encryption states
+ * @brief Values of lt_l3_state_t::encrypt_stream.
+ * @{
+ */
+/** @brief L3 Command is encrypted in L3 buffer by lt_out__*(). */
+#define LT_L3_ENCRYPT_STREAM_OFF 0
+/** @brief L3 Command prepared by lt_out__*() has to be encrypted while being sent. */
+#define LT_L3_ENCRYPT_STREAM_REQ 1
+/** @brief Encryption of L3 Command in L3 buffer was started by lt_l3_encrypt_stream_start(). */
+#define LT_L3_ENCRYPT_STREAM_ON 2
+/** @} */
+
+/**
+ * @brief Starts encryption of L3 Command in L3 buffer, which is then encrypted chunk by chunk while being sent.
+ * @note Chunks are passed by lt_l3_encrypt_stream_chunk() as a callback of lt_l2_send_encrypted_cmd_stream().
+ *
+ * @param s3          Structure holding l3 state
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l3_encrypt_stream_start(lt_l3_state_t *s3) __attribute__((warn_unused_result));
+
+/**
+ * @brief Encrypts chunk of L3 Command in L3 buffer in place, has the signature of lt_l2_tx_chunk_cb_t.
+ * @note Chunks have to be passed in order, TAG is written behind the ciphertext by the chunk in which it starts.
+ *
+ * @param cb_ctx      Structure holding l3 state
+ * @param chunk       Chunk of L3 packet in L3 buffer
+ * @param len         Length of chunk
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l3_encrypt_stream_chunk(void *cb_ctx, uint8_t *chunk, const uint8_t len)
+    __attribute__((warn_unused_result));
+#endif
+
+#ifdef LT_L3_STREAM_DECRYPT
+/**
+ * @brief State of L3 Result decrypted chunk by chunk as it is received, see lt_l3_decrypt_stream_start().
+ */
+typedef struct lt_l3_decrypt_stream_t {
+    /** @private @brief Structure holding l3 state */
+    lt_l3_state_t *s3;
+    /** @private @brief Destination of plaintext behind the header */
+    uint8_t *out;
+    /** @private @brief Length of out, the rest of plaintext is discarded */
+    uint16_t out_len;
+    /** @private @brief Largest expected RES_SIZE */
+    uint16_t res_size_max;
+    /** @private @brief Bytes of L3 packet consumed so far */
+    uint16_t pos;
+    /** @brief RES_SIZE of the L3 Result, valid after lt_l3_decrypt_stream_finish() succeeds */
+    uint16_t res_size;
+    /** @private @brief Received RES_SIZE bytes */
+    uint8_t size[TR01_L3_SIZE_SIZE];
+    /** @private @brief Length of the header */
+    uint8_t hdr_len;
+    /** @brief Header of plaintext: RESULT followed by up to 3 bytes of padding */
+    uint8_t hdr[TR01_L3_RESULT_SIZE + 3];
+    /** @private @brief Received TAG */
+    uint8_t tag[TR01_L3_TAG_SIZE];
+    /** @private @brief Space for discarded plaintext */
+    uint8_t discard[TR01_L3_TAG_SIZE];
+} lt_l3_decrypt_stream_t;
+
+/**
+ * @brief Prepares decryption of L3 Result of which data behind the header are decrypted straight into caller's
+ * buffer, without assembling the L3 packet in L3 buffer.
+ * @note Chunks are passed by lt_l3_decrypt_stream_chunk() as a callback of lt_l2_recv_encrypted_res_stream().
+ *
+ * @param st            Stream state
+ * @param s3            Structure holding l3 state
+ * @param hdr_len       Length of plaintext header (RESULT and padding) kept in st
+ * @param out           Buffer for data behind the header
+ * @param out_len       Length of out
+ * @param res_size_max  Largest expected RES_SIZE, larger L3 Result fails with LT_L3_RES_SIZE_ERROR
+ */
+void lt_l3_decrypt_stream_start(lt_l3_decrypt_stream_t *st, lt_l3_state_t *s3, const uint8_t hdr_len, uint8_t *out,
+                                const uint16_t out_len, const uint16_t res_size_max);
+
+/**
+ * @brief Decrypts chunk of encrypted L3 Result, has the signature of lt_l2_chunk_cb_t.
+ * @warning Plaintext in the output buffer is not authenticated until lt_l3_decrypt_stream_finish() succeeds.
+ *
+ * @param cb_ctx        Stream state
+ * @param chunk         Chunk of L3 packet
+ * @param len           Length of chunk
+ * @return              LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l3_decrypt_stream_chunk(void *cb_ctx, const uint8_t *chunk, const uint8_t len)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Verifies TAG of the streamed L3 Result, same as lt_l3_decrypt_response() does for L3 buffer.
+ * @note The output buffer is wiped on any failure, so no unauthenticated plaintext is left in it.
+ *
+ * @param st            Stream state
+ * @param l2_ret        Return value of lt_l2_recv_encrypted_res_stream()
+ * @return              LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l3_decrypt_stream_finish(lt_l3_decrypt_stream_t *st, const lt_ret_t l2_ret)
+    __attribute__((warn_unused_result));
+#endif
+
 /**
  * @brief Invalidates host's session data
+ * @note Only the part of the L3 buffer which held plaintext since the last call is zeroed.
  *
  * @param s3          Structure holding l3 state
  */
 void lt_l3_invalidate_host_session_data(lt_l3_state_t *s3);
 
+/**
+ * @brief Returns number of L3 Command/Result pairs encrypted in the current Secure Session, i.e. the higher of the
+ * encryption and decryption nonces.
+ *
+ * @param s3          Structure holding l3 state
+ * @return            Nonce value
+ */
+uint32_t lt_l3_nonce_get(const lt_l3_state_t *s3);
+
+/**
+ * @brief Mixes data into handshake transcript hash: h = SHA256(h||data).
+ * @note SHA-256 context in crypto_ctx has to be initialized by lt_sha256_init().
+ *
+ * @param crypto_ctx  Crypto context
+ * @param hash        Transcript hash, updated in place
+ * @param data        Data to mix in
+ * @param data_len    Length of data
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l3_transcript_update(void *crypto_ctx, uint8_t *hash, const uint8_t *data, const size_t data_len)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Computes the part of handshake transcript hash, which depends only on SHiPUB and STPUB:
+ * h = SHA256(SHA256(SHA256(protocol_name)||SHiPUB)||STPUB). SHA256(protocol_name) is a precomputed constant.
+ * @note SHA-256 context in crypto_ctx has to be initialized by lt_sha256_init().
+ *
+ * @param crypto_ctx  Crypto context
+ * @param shipub      Secure host public key
+ * @param stpub       STPUB from device's certificate
+ * @param hash        Transcript hash is returned here
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l3_transcript_prefix(void *crypto_ctx, const uint8_t *shipub, const uint8_t *stpub, uint8_t *hash)
+    __attribute__((warn_unused_result));
+
 /** @} */  // end of group_l3_functions group
 
 #ifdef __cplusplus
@@ -0,0 +1,185 @@
+/**
+ * @file lt_link_tune.c
+ * @brief Tuning of the SPI clock by Ping round-trips and lowering it when CRC errors accumulate
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_link_tune.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "lt_port_wrap.h"
+
+/** Length of one run of the stress pattern. */
+#define LT_LINK_TUNE_PATTERN_RUN 8
+
+void lt_link_tune_frame(lt_l2_state_t *s2, const lt_ret_t ret)
+{
+    lt_link_tune_state_t *link = &s2->link;
+
+    // Corrupted L2 Request frames are reported by TROPIC01, corrupted L2 Response frames are found by the host.
+    if ((ret == LT_L2_CRC_ERR) || (ret == LT_L2_IN_CRC_ERR)) {
+        link->info.errors++;
+        link->window_errors++;
+    }
+    link->window_frames++;
+    if ((link->window_frames < LT_LINK_TUNE_WINDOW) && (link->window_errors < LT_LINK_TUNE_MAX_ERRORS)) {
+        return;
+    }
+
+    bool downshift = (link->window_errors >= LT_LINK_TUNE_MAX_ERRORS);
+    link->window_frames = 0;
+    link->window_errors = 0;
+    if (!downshift || link->tuning || !link->speeds_hz || (link->speed_idx == 0)) {
+        return;
+    }
+
+    const uint32_t speed_hz = link->speeds_hz[link->speed_idx - 1];
+    if (lt_l1_spi_set_speed(s2, speed_hz) != LT_OK) {
+        LT_LOG_WARN("Lowering SPI clock to %" PRIu32 " Hz failed!", speed_hz);
+        return;
+    }
+    link->speed_idx--;
+    link->info.speed_hz = speed_hz;
+    link->info.downshifts++;
+    LT_LOG_WARN("Too many CRC errors, SPI clock lowered to %" PRIu32 " Hz.", speed_hz);
+}
+
+void lt_link_tune_pattern(uint8_t *buff, const uint16_t len, const uint32_t seed)
+{
+    // Xorshift needs a nonzero state.
+    uint32_t x = (seed * 2654435761U) | 1U;
+
+    for (uint16_t i = 0; i < len; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        switch ((i / LT_LINK_TUNE_PATTERN_RUN + seed) % 4) {
+            case 0:
+                // Highest toggle rate of MOSI and MISO.
+                buff[i] = (i & 1) ? 0x55 : 0xAA;
+                break;
+            case 1:
+                buff[i] = 0xFF;
+                break;
+            case 2:
+                buff[i] = 0x00;
+                break;
+            default:
+                buff[i] = (uint8_t)x;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Pings TROPIC01 with stress patterns at the current SPI clock.
+ *
+ * @param h         Handle for communication with TROPIC01
+ * @param step      Index of the SPI clock, selects the patterns
+ * @param pings     Number of pings
+ * @param ping_len  Length of one ping message
+ * @return          LT_OK if all messages were echoed, LT_FAIL if a message differs, otherwise error of lt_ping()
+ */
+static lt_ret_t lt_link_tune_step(lt_handle_t *h, const uint8_t step, const uint8_t pings, const uint16_t ping_len)
+{
+    uint8_t msg_out[LT_LINK_TUNE_PING_LEN_MAX];
+    uint8_t msg_in[LT_LINK_TUNE_PING_LEN_MAX];
+
+    for (uint8_t i = 0; i < pings; i++) {
+        lt_link_tune_pattern(msg_out, ping_len, ((uint32_t)step << 8) | i);
+        memset(msg_in, 0, ping_len);
+        lt_ret_t ret = lt_ping(h, msg_out, msg_in, ping_len);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        if (memcmp(msg_out, msg_in, ping_len)) {
+            return LT_FAIL;
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_link_tune(lt_handle_t *h, const uint32_t *speeds_hz, const uint8_t speed_cnt, const uint8_t pings,
+                      const uint16_t ping_len)
+{
+    if (!h || !speeds_hz || !speed_cnt || !pings || !ping_len || (ping_len > LT_LINK_TUNE_PING_LEN_MAX)
+        || !speeds_hz[0]) {
+        return LT_PARAM_ERR;
+    }
+    for (uint8_t i = 1; i < speed_cnt; i++) {
+        if (speeds_hz[i] <= speeds_hz[i - 1]) {
+            return LT_PARAM_ERR;
+        }
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+
+    lt_link_tune_state_t *link = &h->l2.link;
+    memset(link, 0, sizeof(*link));
+
+    // Ramp up until a ping fails or any frame has to be resent, errors are only counted meanwhile.
+    lt_ret_t ret = LT_OK;
+    uint8_t passed = 0;
+    link->tuning = true;
+    for (; passed < speed_cnt; passed++) {
+        uint32_t errors = link->info.errors;
+        ret = lt_l1_spi_set_speed(&h->l2, speeds_hz[passed]);
+        if (ret == LT_OK) {
+            ret = lt_link_tune_step(h, passed, pings, ping_len);
+        }
+        if ((ret != LT_OK) || (link->info.errors != errors)) {
+            break;
+        }
+    }
+    link->tuning = false;
+    link->window_frames = 0;
+    link->window_errors = 0;
+    link->info.errors = 0;
+
+    uint8_t idx = speed_cnt - 1;
+    if (passed < speed_cnt) {
+        // Back to the fastest clock which passed, or to the slowest one.
+        idx = passed ? passed - 1 : 0;
+        lt_ret_t ret_speed = lt_l1_spi_set_speed(&h->l2, speeds_hz[idx]);
+        if (ret != LT_OK) {
+            // Nonces of the Secure Session may be out of sync after the failed ping.
+            LT_LOG_WARN("Ping at %" PRIu32 " Hz failed, aborting Secure Session.", speeds_hz[passed]);
+            lt_ret_t ret_unused = lt_session_abort(h);
+            LT_UNUSED(ret_unused);
+        }
+        if (ret_speed != LT_OK) {
+            return ret_speed;
+        }
+        if (!passed) {
+            return (ret != LT_OK) ? ret : LT_L2_CRC_ERR;
+        }
+    }
+
+    link->speeds_hz = speeds_hz;
+    link->speed_idx = idx;
+    link->info.speed_hz = speeds_hz[idx];
+
+    return LT_OK;
+}
+
+lt_ret_t lt_get_link_info(const lt_handle_t *h, lt_link_info_t *info)
+{
+    if (!h || !info) {
+        return LT_PARAM_ERR;
+    }
+
+    *info = h->l2.link.info;
+
+    return LT_OK;
+}
@@ -0,0 +1,63 @@
+#ifndef LT_LINK_TUNE_H
+#define LT_LINK_TUNE_H
+
+/**
+ * @file lt_link_tune.h
+ * @brief SPI link tuning declarations (used internally), see lt_link_tune()
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_LINK_TUNE
+#ifndef LT_LINK_TUNE_WINDOW
+/** Number of checked L2 Response frames in one window of the link quality monitoring. */
+#define LT_LINK_TUNE_WINDOW 64
+#endif
+
+#ifndef LT_LINK_TUNE_MAX_ERRORS
+/** Number of CRC errors within one window, which lowers the SPI clock by one step. */
+#define LT_LINK_TUNE_MAX_ERRORS 4
+#endif
+
+/**
+ * @brief Counts the result of the check of one L2 Response frame into the link quality, lowers the SPI clock when
+ * LT_LINK_TUNE_MAX_ERRORS errors were counted within LT_LINK_TUNE_WINDOW frames.
+ * @note Called between L1 frames only, so the clock can be changed.
+ *
+ * @param s2    Structure holding l2 state
+ * @param ret   Return value of lt_l2_frame_check()
+ */
+void lt_link_tune_frame(lt_l2_state_t *s2, const lt_ret_t ret);
+
+/**
+ * @brief Fills the buffer with the stress pattern pinged by lt_link_tune(): alternating bits, runs of ones and zeros
+ * and pseudorandom bytes.
+ *
+ * @param buff  Buffer to fill
+ * @param len   Length of the buffer
+ * @param seed  Selects the order of the runs and the pseudorandom bytes
+ */
+void lt_link_tune_pattern(uint8_t *buff, const uint16_t len, const uint32_t seed);
+
+/** Counts the result of the frame check into the link quality. */
+#define LT_LINK_TUNE_FRAME(s2, ret) lt_link_tune_frame((s2), (ret))
+#else
+#define LT_LINK_TUNE_FRAME(s2, ret) \
+    do {                            \
+    } while (0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_LINK_TUNE_H
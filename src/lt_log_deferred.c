@@ -0,0 +1,530 @@
+/**
+ * @file lt_log_deferred.c
+ * @brief Deferred logging, messages are stored unformatted into a lock-free queue and formatted by its consumer
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port.h"
+
+/** Number of messages the deferred log holds, power of two. */
+#ifndef LT_LOG_DEFERRED_SLOTS
+#define LT_LOG_DEFERRED_SLOTS 32
+#endif
+
+/** Space for raw arguments of one message, including copies of strings. */
+#ifndef LT_LOG_DEFERRED_ARGS_SIZE
+#define LT_LOG_DEFERRED_ARGS_SIZE 64
+#endif
+
+/** Longest message printed by lt_log_deferred_process(). */
+#ifndef LT_LOG_DEFERRED_LINE_SIZE
+#define LT_LOG_DEFERRED_LINE_SIZE 256
+#endif
+
+/** Longest conversion specification (e.g. `%-08.3lld`) of a format string. */
+#define LT_LOG_SPEC_SIZE_MAX 16
+
+LT_STATIC_ASSERT((LT_LOG_DEFERRED_SLOTS & (LT_LOG_DEFERRED_SLOTS - 1)) == 0)
+LT_STATIC_ASSERT(LT_LOG_DEFERRED_ARGS_SIZE <= UINT16_MAX)
+
+/** Type of the argument of a conversion specification. */
+typedef enum {
+    LT_LOG_ARG_NONE,  // `%%` or unsupported conversion
+    LT_LOG_ARG_INT,
+    LT_LOG_ARG_LONG,
+    LT_LOG_ARG_LLONG,
+    LT_LOG_ARG_INTMAX,
+    LT_LOG_ARG_SIZE,
+    LT_LOG_ARG_PTRDIFF,
+    LT_LOG_ARG_DOUBLE,
+    LT_LOG_ARG_LDOUBLE,
+    LT_LOG_ARG_PTR,
+    LT_LOG_ARG_STR
+} lt_log_arg_t;
+
+/** Conversion specification parsed from a format string. */
+typedef struct {
+    const char *start;  // Points to `%`.
+    size_t len;         // Length including the conversion character.
+    lt_log_arg_t arg;
+    uint8_t stars;      // Number of `*` (width and precision passed as int arguments).
+    bool has_prec;      // Precision given either by digits or by `*`.
+    bool prec_star;     // Precision passed as the last int argument.
+    int prec;           // Precision given by digits.
+} lt_log_spec_t;
+
+/**
+ * Message of the deferred log.
+ *
+ * Slots form a bounded multi-producer queue; `seq` is relative to the index of the slot, so the zero-initialized
+ * array is an empty queue: the slot is free for position `pos` if `seq + index == pos` and holds the message of
+ * position `pos` if `seq + index == pos + 1`.
+ */
+typedef struct {
+    uint32_t seq;
+    uint16_t args_len;
+    const char *format;
+    uint8_t args[LT_LOG_DEFERRED_ARGS_SIZE];
+} lt_log_slot_t;
+
+static lt_log_slot_t lt_log_slots[LT_LOG_DEFERRED_SLOTS];
+static uint32_t lt_log_enqueue_pos;
+static uint32_t lt_log_dequeue_pos;
+static uint32_t lt_log_dropped;
+
+/**
+ * Finds the next conversion specification in the format string.
+ *
+ * @return Pointer behind the specification, NULL if there is none
+ */
+static const char *lt_log_spec_next(const char *p, lt_log_spec_t *spec)
+{
+    p = strchr(p, '%');
+    if (!p) {
+        return NULL;
+    }
+
+    spec->start = p++;
+    spec->arg = LT_LOG_ARG_INT;
+    spec->stars = 0;
+    spec->has_prec = false;
+    spec->prec_star = false;
+    spec->prec = 0;
+
+    while (*p && strchr("-+ #0", *p)) {
+        p++;
+    }
+    if (*p == '*') {
+        spec->stars++;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (*p == '.') {
+        spec->has_prec = true;
+        p++;
+        if (*p == '*') {
+            spec->stars++;
+            spec->prec_star = true;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9') {
+            spec->prec = spec->prec * 10 + (*p++ - '0');
+        }
+    }
+
+    if (p[0] == 'h') {
+        p += (p[1] == 'h') ? 2 : 1;  // Promoted to int.
+    }
+    else if (p[0] == 'l' && p[1] == 'l') {
+        spec->arg = LT_LOG_ARG_LLONG;
+        p += 2;
+    }
+    else if (*p == 'l') {
+        spec->arg = LT_LOG_ARG_LONG;
+        p++;
+    }
+    else if (*p == 'j') {
+        spec->arg = LT_LOG_ARG_INTMAX;
+        p++;
+    }
+    else if (*p == 'z') {
+        spec->arg = LT_LOG_ARG_SIZE;
+        p++;
+    }
+    else if (*p == 't') {
+        spec->arg = LT_LOG_ARG_PTRDIFF;
+        p++;
+    }
+    else if (*p == 'L') {
+        spec->arg = LT_LOG_ARG_LDOUBLE;
+        p++;
+    }
+
+    switch (*p) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            if (spec->arg == LT_LOG_ARG_LDOUBLE) {
+                spec->arg = LT_LOG_ARG_NONE;
+            }
+            break;
+        case 'c':
+            spec->arg = LT_LOG_ARG_INT;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if (spec->arg != LT_LOG_ARG_LDOUBLE) {
+                spec->arg = LT_LOG_ARG_DOUBLE;
+            }
+            break;
+        case 's':
+            spec->arg = LT_LOG_ARG_STR;
+            break;
+        case 'p':
+            spec->arg = LT_LOG_ARG_PTR;
+            break;
+        case '\0':
+            spec->arg = LT_LOG_ARG_NONE;
+            spec->len = (size_t)(p - spec->start);
+            return p;
+        default:  // `%%`, `%n` and unknown conversions do not take an argument.
+            spec->arg = LT_LOG_ARG_NONE;
+            break;
+    }
+
+    p++;
+    spec->len = (size_t)(p - spec->start);
+
+    return p;
+}
+
+/** Appends the value to the raw arguments of the message, fails if it does not fit. */
+static bool lt_log_put(lt_log_slot_t *slot, const void *value, const size_t len)
+{
+    if (slot->args_len + len > sizeof(slot->args)) {
+        return false;
+    }
+    memcpy(slot->args + slot->args_len, value, len);
+    slot->args_len += (uint16_t)len;
+
+    return true;
+}
+
+/** Stores the arguments described by the format string into the message, stops when the message is full. */
+static void lt_log_pack(lt_log_slot_t *slot, const char *format, va_list args)
+{
+    lt_log_spec_t spec;
+    const char *p = format;
+
+    while ((p = lt_log_spec_next(p, &spec)) != NULL) {
+        int prec = spec.prec;
+        int star = 0;
+        bool ok = true;
+
+        for (uint8_t i = 0; ok && i < spec.stars; i++) {
+            star = va_arg(args, int);
+            ok = lt_log_put(slot, &star, sizeof(star));
+        }
+        if (spec.prec_star) {
+            prec = star;
+        }
+
+        switch (spec.arg) {
+            case LT_LOG_ARG_NONE:
+                break;
+            case LT_LOG_ARG_INT: {
+                int v = va_arg(args, int);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_LONG: {
+                long v = va_arg(args, long);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_LLONG: {
+                long long v = va_arg(args, long long);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_INTMAX: {
+                intmax_t v = va_arg(args, intmax_t);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_SIZE: {
+                size_t v = va_arg(args, size_t);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_PTRDIFF: {
+                ptrdiff_t v = va_arg(args, ptrdiff_t);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_DOUBLE: {
+                double v = va_arg(args, double);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_LDOUBLE: {
+                long double v = va_arg(args, long double);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_PTR: {
+                void *v = va_arg(args, void *);
+                ok = ok && lt_log_put(slot, &v, sizeof(v));
+                break;
+            }
+            case LT_LOG_ARG_STR: {
+                const char *v = va_arg(args, const char *);
+                size_t space = sizeof(slot->args) - slot->args_len;
+                if (!v) {
+                    v = "(null)";
+                }
+                if (!ok || space == 0) {
+                    ok = false;
+                    break;
+                }
+                // Strings are copied with their terminating NUL, truncated to the space left in the message.
+                size_t len = (spec.has_prec && prec >= 0 && (size_t)prec < space - 1) ? (size_t)prec : space - 1;
+                len = strnlen(v, len);
+                memcpy(slot->args + slot->args_len, v, len);
+                slot->args[slot->args_len + len] = '\0';
+                slot->args_len += (uint16_t)(len + 1);
+                break;
+            }
+        }
+
+        if (!ok) {
+            return;
+        }
+    }
+}
+
+void lt_log_deferred(const char *format, ...)
+{
+    uint32_t pos = __atomic_load_n(&lt_log_enqueue_pos, __ATOMIC_RELAXED);
+    lt_log_slot_t *slot;
+
+    for (;;) {
+        uint32_t idx = pos & (LT_LOG_DEFERRED_SLOTS - 1);
+        slot = &lt_log_slots[idx];
+        int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) + idx - pos);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&lt_log_enqueue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            __atomic_fetch_add(&lt_log_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+        else {
+            pos = __atomic_load_n(&lt_log_enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    va_list args;
+    va_start(args, format);
+    slot->format = format;
+    slot->args_len = 0;
+    lt_log_pack(slot, format, args);
+    va_end(args);
+
+    __atomic_store_n(&slot->seq, pos + 1 - (pos & (LT_LOG_DEFERRED_SLOTS - 1)), __ATOMIC_RELEASE);
+}
+
+// Conversion specifications are copied out of the format strings, which were checked at the call sites.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+
+/** Takes the value of the given type from the raw arguments, fails if the message was truncated before it. */
+#define LT_LOG_TAKE(type, v)                                                               \
+    (((offset + sizeof(type)) <= slot->args_len)                                           \
+         ? (memcpy(&(v), slot->args + offset, sizeof(type)), offset += sizeof(type), true) \
+         : false)
+
+/** Formats one conversion specification with its width and precision arguments taken before. */
+#define LT_LOG_FORMAT(value)                                                         \
+    ((spec.stars == 0)   ? snprintf(out, rem, spec_buff, value)                      \
+     : (spec.stars == 1) ? snprintf(out, rem, spec_buff, stars[0], value)            \
+                         : snprintf(out, rem, spec_buff, stars[0], stars[1], value))
+
+/** Formats the message stored in the slot. */
+static size_t lt_log_unpack(const lt_log_slot_t *slot, char *line, const size_t size)
+{
+    char spec_buff[LT_LOG_SPEC_SIZE_MAX + 1];
+    lt_log_spec_t spec;
+    const char *p = slot->format;
+    const char *next;
+    size_t offset = 0;
+    size_t len = 0;
+
+    while (len + 1 < size) {
+        char *out = line + len;
+        size_t rem = size - len;
+        int n = 0;
+
+        next = lt_log_spec_next(p, &spec);
+        size_t literal = next ? (size_t)(spec.start - p) : strlen(p);
+        if (literal > rem - 1) {
+            literal = rem - 1;
+        }
+        memcpy(out, p, literal);
+        len += literal;
+        if (!next || len + 1 >= size) {
+            break;
+        }
+        out = line + len;
+        rem = size - len;
+        p = next;
+
+        int stars[2] = {0, 0};
+        bool ok = (spec.len <= LT_LOG_SPEC_SIZE_MAX);
+        for (uint8_t i = 0; ok && i < spec.stars; i++) {
+            ok = LT_LOG_TAKE(int, stars[i]);
+        }
+        if (ok) {
+            memcpy(spec_buff, spec.start, spec.len);
+            spec_buff[spec.len] = '\0';
+        }
+
+        switch (ok ? spec.arg : LT_LOG_ARG_NONE) {
+            case LT_LOG_ARG_NONE:
+                if (!ok) {
+                    n = snprintf(out, rem, "?");
+                }
+                else if (spec.start[spec.len - 1] == '%') {
+                    n = snprintf(out, rem, "%%");
+                }
+                break;
+            case LT_LOG_ARG_INT: {
+                int v;
+                n = LT_LOG_TAKE(int, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_LONG: {
+                long v;
+                n = LT_LOG_TAKE(long, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_LLONG: {
+                long long v;
+                n = LT_LOG_TAKE(long long, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_INTMAX: {
+                intmax_t v;
+                n = LT_LOG_TAKE(intmax_t, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_SIZE: {
+                size_t v;
+                n = LT_LOG_TAKE(size_t, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_PTRDIFF: {
+                ptrdiff_t v;
+                n = LT_LOG_TAKE(ptrdiff_t, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_DOUBLE: {
+                double v;
+                n = LT_LOG_TAKE(double, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_LDOUBLE: {
+                long double v;
+                n = LT_LOG_TAKE(long double, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_PTR: {
+                void *v;
+                n = LT_LOG_TAKE(void *, v) ? LT_LOG_FORMAT(v) : snprintf(out, rem, "?");
+                break;
+            }
+            case LT_LOG_ARG_STR:
+                if (offset < slot->args_len) {
+                    const char *v = (const char *)slot->args + offset;
+                    offset += strlen(v) + 1;
+                    n = LT_LOG_FORMAT(v);
+                }
+                else {
+                    n = snprintf(out, rem, "?");
+                }
+                break;
+        }
+
+        if (n > 0) {
+            len += ((size_t)n < rem) ? (size_t)n : rem - 1;
+        }
+    }
+
+    line[len] = '\0';
+
+    return len;
+}
+
+#pragma GCC diagnostic pop
+
+size_t lt_log_deferred_read(char *line, const size_t size)
+{
+    if (!line || size == 0) {
+        return 0;
+    }
+    line[0] = '\0';
+
+    uint32_t pos = __atomic_load_n(&lt_log_dequeue_pos, __ATOMIC_RELAXED);
+    lt_log_slot_t *slot;
+
+    for (;;) {
+        uint32_t idx = pos & (LT_LOG_DEFERRED_SLOTS - 1);
+        slot = &lt_log_slots[idx];
+        int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) + idx - (pos + 1));
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&lt_log_dequeue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            return 0;
+        }
+        else {
+            pos = __atomic_load_n(&lt_log_dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    size_t len = lt_log_unpack(slot, line, size);
+
+    __atomic_store_n(&slot->seq, pos + LT_LOG_DEFERRED_SLOTS - (pos & (LT_LOG_DEFERRED_SLOTS - 1)), __ATOMIC_RELEASE);
+
+    return len;
+}
+
+uint32_t lt_log_deferred_process(const uint32_t max_msgs)
+{
+    char line[LT_LOG_DEFERRED_LINE_SIZE];
+    uint32_t printed = 0;
+
+    while (printed < max_msgs) {
+        uint32_t dropped = __atomic_exchange_n(&lt_log_dropped, 0, __ATOMIC_RELAXED);
+        if (dropped) {
+            lt_port_log("WARNING [----] %" PRIu32 " deferred log messages dropped\n", dropped);
+        }
+        if (lt_log_deferred_read(line, sizeof(line)) == 0) {
+            break;
+        }
+        lt_port_log("%s", line);
+        printed++;
+    }
+
+    return printed;
+}
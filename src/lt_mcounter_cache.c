@@ -0,0 +1,114 @@
+/**
+ * @file lt_mcounter_cache.c
+ * @brief Monotonic counter with the value cached on the host
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+
+/** Tells whether the cached value belongs to the current Secure Session. */
+static int lt_mcounter_cached(const lt_mcounter_t *c)
+{
+    return c->cached && (c->h->l3.session_status == LT_SECURE_SESSION_ON)
+           && (c->session_cnt == c->h->l3.session_cnt);
+}
+
+static void lt_mcounter_cache(lt_mcounter_t *c, const uint32_t value)
+{
+    c->value = value;
+    c->session_cnt = c->h->l3.session_cnt;
+    c->cached = 1;
+}
+
+lt_ret_t lt_mcounter_open(lt_mcounter_t *c, lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index)
+{
+    if (!c || !h || (mcounter_index > TR01_MCOUNTER_INDEX_15)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(c, 0, sizeof(lt_mcounter_t));
+    c->h = h;
+    c->index = (uint8_t)mcounter_index;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_mcounter_set(lt_mcounter_t *c, const uint32_t mcounter_value)
+{
+    if (!c || !c->h) {
+        return LT_PARAM_ERR;
+    }
+
+    c->cached = 0;
+    lt_ret_t ret = lt_mcounter_init(c->h, (enum lt_mcounter_index_t)c->index, mcounter_value);
+    if (ret == LT_OK) {
+        lt_mcounter_cache(c, mcounter_value);
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_mcounter_value(lt_mcounter_t *c, uint32_t *mcounter_value)
+{
+    if (!c || !c->h || !mcounter_value) {
+        return LT_PARAM_ERR;
+    }
+
+    if (!lt_mcounter_cached(c)) {
+        uint32_t value;
+        lt_ret_t ret = lt_mcounter_get(c->h, (enum lt_mcounter_index_t)c->index, &value);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        lt_mcounter_cache(c, value);
+    }
+
+    *mcounter_value = c->value;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_mcounter_consume(lt_mcounter_t *c, const uint32_t n, uint32_t *mcounter_value)
+{
+    uint32_t value;
+    lt_ret_t ret = lt_mcounter_value(c, &value);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (value < n) {
+        return LT_FAIL;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        ret = lt_mcounter_update(c->h, (enum lt_mcounter_index_t)c->index);
+        if (ret != LT_OK) {
+            // It is not known whether the last update was executed.
+            c->cached = 0;
+            return ret;
+        }
+    }
+
+    c->value = value - n;
+    if (mcounter_value) {
+        *mcounter_value = c->value;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_mcounter_invalidate(lt_mcounter_t *c)
+{
+    if (!c) {
+        return LT_PARAM_ERR;
+    }
+
+    c->cached = 0;
+
+    return LT_OK;
+}
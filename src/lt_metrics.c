@@ -0,0 +1,291 @@
+/**
+ * @file lt_metrics.c
+ * @brief Export of runtime statistics and of the device pool in the OpenMetrics text format
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_metrics.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+/** Longest line written at once, label values of the devices are written separately. */
+#define LT_METRICS_LINE 128
+
+/** Upper bounds of the latency buckets but the last one in microseconds. */
+static const uint32_t lt_metrics_bounds_us[LT_METRICS_BUCKETS - 1] = {1000, 2000, 5000, 10000, 20000, 50000, 100000};
+
+/** Upper bounds of the latency buckets as values of the le label. */
+static const char *const lt_metrics_bounds_le[LT_METRICS_BUCKETS]
+    = {"0.001", "0.002", "0.005", "0.01", "0.02", "0.05", "0.1", "+Inf"};
+
+/** Counter of lt_stats_t. */
+typedef struct lt_metrics_counter_t {
+    const char *name;
+    const char *help;
+    size_t offset;
+    bool wide;
+} lt_metrics_counter_t;
+
+#define LT_METRICS_COUNTER(field, help) {"libtropic_" #field, help, offsetof(lt_stats_t, field), false}
+
+static const lt_metrics_counter_t lt_metrics_counters[] = {
+    LT_METRICS_COUNTER(l1_polls, "CHIP_STATUS polls for L2 Response frames."),
+    LT_METRICS_COUNTER(l1_chip_busy, "L2 Response frame reads which returned LT_L1_CHIP_BUSY."),
+    {"libtropic_l1_spi_bytes", "Bytes clocked over SPI.", offsetof(lt_stats_t, l1_spi_bytes), true},
+    LT_METRICS_COUNTER(l2_crc_errors, "L2 Response frames with invalid CRC."),
+    LT_METRICS_COUNTER(l2_resends, "Resend_Req L2 Requests sent."),
+    LT_METRICS_COUNTER(l2_chunks_tx, "L2 chunks of encrypted L3 Commands sent."),
+    LT_METRICS_COUNTER(l2_chunks_rx, "L2 chunks of encrypted L3 Results received."),
+    LT_METRICS_COUNTER(l3_handshakes, "Secure Sessions established."),
+    LT_METRICS_COUNTER(l3_handshake_errors, "Handshakes which failed on the host side."),
+    LT_METRICS_COUNTER(l3_cmds_untracked, "L3 Results of commands which did not fit into the statistics."),
+};
+
+LT_STATIC_ASSERT(sizeof(((lt_stats_t *)0)->l1_spi_bytes) == sizeof(uint64_t))
+
+uint8_t lt_metrics_bucket(const uint64_t time_us)
+{
+    uint8_t i = 0;
+
+    while ((i < LT_METRICS_BUCKETS - 1) && (time_us > lt_metrics_bounds_us[i])) {
+        i++;
+    }
+
+    return i;
+}
+
+/** Writes the line formatted by snprintf() into it. */
+static lt_ret_t lt_metrics_line(lt_metrics_write_t write, void *write_ctx, const char *line, const int len)
+{
+    if ((len < 0) || (len >= LT_METRICS_LINE)) {
+        return LT_FAIL;
+    }
+
+    return write(write_ctx, line, (size_t)len);
+}
+
+/** Writes TYPE and HELP of the metric family. */
+static lt_ret_t lt_metrics_family(lt_metrics_write_t write, void *write_ctx, const char *name, const char *type,
+                                  const char *help)
+{
+    char line[LT_METRICS_LINE];
+    int len = snprintf(line, sizeof(line), "# TYPE %s %s\n", name, type);
+    lt_ret_t ret = lt_metrics_line(write, write_ctx, line, len);
+
+    if (ret == LT_OK) {
+        len = snprintf(line, sizeof(line), "# HELP %s %s\n", name, help);
+        ret = lt_metrics_line(write, write_ctx, line, len);
+    }
+
+    return ret;
+}
+
+/**
+ * Writes one sample: name, the device label with its value escaped, further labels (each preceded by a comma) and the
+ * value.
+ */
+static lt_ret_t lt_metrics_sample(lt_metrics_write_t write, void *write_ctx, const char *name, const char *device,
+                                  const char *labels, const char *value)
+{
+    char line[LT_METRICS_LINE];
+    int len = snprintf(line, sizeof(line), "%s{device=\"", name);
+    lt_ret_t ret = lt_metrics_line(write, write_ctx, line, len);
+
+    for (const char *c = device; (ret == LT_OK) && *c; c++) {
+        if (*c == '\n') {
+            ret = write(write_ctx, "\\n", 2);
+            continue;
+        }
+        if ((*c == '"') || (*c == '\\')) {
+            ret = write(write_ctx, "\\", 1);
+        }
+        if (ret == LT_OK) {
+            ret = write(write_ctx, c, 1);
+        }
+    }
+    if (ret == LT_OK) {
+        len = snprintf(line, sizeof(line), "\"%s} %s\n", labels, value);
+        ret = lt_metrics_line(write, write_ctx, line, len);
+    }
+
+    return ret;
+}
+
+/** Writes one sample with an integer value. */
+static lt_ret_t lt_metrics_sample_u64(lt_metrics_write_t write, void *write_ctx, const char *name,
+                                      const char *device, const char *labels, const uint64_t value)
+{
+    char str[24];
+    snprintf(str, sizeof(str), "%" PRIu64, value);
+
+    return lt_metrics_sample(write, write_ctx, name, device, labels, str);
+}
+
+/** Writes the histogram samples of one L3 Command ID of the device. */
+static lt_ret_t lt_metrics_cmd(lt_metrics_write_t write, void *write_ctx, const char *device,
+                               const lt_stats_l3_cmd_t *cmd)
+{
+    char labels[40];
+    char value[32];
+    uint64_t cumulative = 0;
+    lt_ret_t ret = LT_OK;
+
+    for (int i = 0; (ret == LT_OK) && (i < LT_METRICS_BUCKETS); i++) {
+        cumulative += cmd->hist[i];
+        snprintf(labels, sizeof(labels), ",cmd_id=\"0x%02" PRIx8 "\",le=\"%s\"", cmd->cmd_id, lt_metrics_bounds_le[i]);
+        ret = lt_metrics_sample_u64(write, write_ctx, "libtropic_l3_cmd_seconds_bucket", device, labels, cumulative);
+    }
+
+    snprintf(labels, sizeof(labels), ",cmd_id=\"0x%02" PRIx8 "\"", cmd->cmd_id);
+    if (ret == LT_OK) {
+        ret = lt_metrics_sample_u64(write, write_ctx, "libtropic_l3_cmd_seconds_count", device, labels, cmd->count);
+    }
+    if (ret == LT_OK) {
+        snprintf(value, sizeof(value), "%" PRIu64 ".%06" PRIu64, cmd->time_us / 1000000, cmd->time_us % 1000000);
+        ret = lt_metrics_sample(write, write_ctx, "libtropic_l3_cmd_seconds_sum", device, labels, value);
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_metrics_write_stats(const lt_metrics_dev_t *devs, const size_t cnt, lt_metrics_write_t write,
+                                void *write_ctx)
+{
+    if (!devs || !cnt || !write) {
+        return LT_PARAM_ERR;
+    }
+    for (size_t i = 0; i < cnt; i++) {
+        if (!devs[i].name || !devs[i].stats) {
+            return LT_PARAM_ERR;
+        }
+    }
+
+    char name[LT_METRICS_LINE];
+    lt_ret_t ret = LT_OK;
+
+    for (size_t f = 0; (ret == LT_OK) && (f < sizeof(lt_metrics_counters) / sizeof(lt_metrics_counters[0])); f++) {
+        const lt_metrics_counter_t *counter = &lt_metrics_counters[f];
+        ret = lt_metrics_family(write, write_ctx, counter->name, "counter", counter->help);
+        snprintf(name, sizeof(name), "%s_total", counter->name);
+        for (size_t i = 0; (ret == LT_OK) && (i < cnt); i++) {
+            const uint8_t *field = (const uint8_t *)devs[i].stats + counter->offset;
+            uint64_t value = counter->wide ? *(const uint64_t *)field : *(const uint32_t *)field;
+            ret = lt_metrics_sample_u64(write, write_ctx, name, devs[i].name, "", value);
+        }
+    }
+
+    if (ret == LT_OK) {
+        ret = lt_metrics_family(write, write_ctx, "libtropic_l3_nonce", "gauge",
+                                "Nonce of the current Secure Session.");
+    }
+    for (size_t i = 0; (ret == LT_OK) && (i < cnt); i++) {
+        ret = lt_metrics_sample_u64(write, write_ctx, "libtropic_l3_nonce", devs[i].name, "",
+                                    devs[i].stats->l3_nonce);
+    }
+    if (ret == LT_OK) {
+        ret = lt_metrics_family(write, write_ctx, "libtropic_l3_nonce_headroom", "gauge",
+                                "Nonces left before the current Secure Session has to be restarted.");
+    }
+    for (size_t i = 0; (ret == LT_OK) && (i < cnt); i++) {
+        ret = lt_metrics_sample_u64(write, write_ctx, "libtropic_l3_nonce_headroom", devs[i].name, "",
+                                    UINT32_MAX - devs[i].stats->l3_nonce);
+    }
+    if (ret == LT_OK) {
+        ret = lt_metrics_family(write, write_ctx, "libtropic_l3_nonce_max", "gauge",
+                                "Highest nonce reached in any Secure Session.");
+    }
+    for (size_t i = 0; (ret == LT_OK) && (i < cnt); i++) {
+        ret = lt_metrics_sample_u64(write, write_ctx, "libtropic_l3_nonce_max", devs[i].name, "",
+                                    devs[i].stats->l3_nonce_max);
+    }
+
+    if (ret == LT_OK) {
+        ret = lt_metrics_family(write, write_ctx, "libtropic_l3_cmd_seconds", "histogram",
+                                "Time from encryption of the L3 Command to decryption of its L3 Result.");
+    }
+    if (ret == LT_OK) {
+        static const char unit[] = "# UNIT libtropic_l3_cmd_seconds seconds\n";
+        ret = write(write_ctx, unit, sizeof(unit) - 1);
+    }
+    for (size_t i = 0; (ret == LT_OK) && (i < cnt); i++) {
+        for (int c = 0; (ret == LT_OK) && (c < LT_STATS_L3_CMDS) && devs[i].stats->l3_cmds[c].count; c++) {
+            ret = lt_metrics_cmd(write, write_ctx, devs[i].name, &devs[i].stats->l3_cmds[c]);
+        }
+    }
+
+    return ret;
+}
+
+#ifdef LT_POOL
+/** Metric families of the device pool, the value of each is returned by lt_metrics_pool_value(). */
+static const char *const lt_metrics_pool_families[][3] = {
+    {"libtropic_pool_queue_depth", "gauge", "Callers assigned to the device, executing or waiting."},
+    {"libtropic_pool_healthy", "gauge", "1 unless the device is quarantined."},
+    {"libtropic_pool_ops", "counter", "Operations executed by the device."},
+    {"libtropic_pool_quarantines", "counter", "Times the device was quarantined."},
+    {"libtropic_pool_handshakes", "counter", "Successful re-handshakes of the quarantined device."},
+};
+
+static uint64_t lt_metrics_pool_value(const lt_pool_t *pool, const uint8_t idx, const size_t family)
+{
+    switch (family) {
+        case 0:
+            return lt_pool_depth(pool, idx);
+        case 1:
+            return lt_pool_is_healthy(pool, idx);
+        case 2:
+            return pool->devs[idx].ops;
+        case 3:
+            return pool->devs[idx].failures;
+        default:
+            return pool->devs[idx].handshakes;
+    }
+}
+
+lt_ret_t lt_metrics_write_pool(const lt_pool_t *pool, const char *const *names, lt_metrics_write_t write,
+                               void *write_ctx)
+{
+    if (!pool || !write) {
+        return LT_PARAM_ERR;
+    }
+
+    const size_t families = sizeof(lt_metrics_pool_families) / sizeof(lt_metrics_pool_families[0]);
+    char name[LT_METRICS_LINE];
+    char index[4];
+    lt_ret_t ret = LT_OK;
+
+    for (size_t f = 0; (ret == LT_OK) && (f < families); f++) {
+        const char *const *family = lt_metrics_pool_families[f];
+        ret = lt_metrics_family(write, write_ctx, family[0], family[1], family[2]);
+        // Samples of counters end by _total, the names of their families do not.
+        snprintf(name, sizeof(name), "%s%s", family[0], (strcmp(family[1], "counter") == 0) ? "_total" : "");
+        for (uint8_t i = 0; (ret == LT_OK) && (i < pool->dev_cnt); i++) {
+            const char *device = names ? names[i] : index;
+            snprintf(index, sizeof(index), "%" PRIu8, i);
+            ret = lt_metrics_sample_u64(write, write_ctx, name, device ? device : index, "",
+                                        lt_metrics_pool_value(pool, i, f));
+        }
+    }
+
+    return ret;
+}
+#endif
+
+lt_ret_t lt_metrics_write_eof(lt_metrics_write_t write, void *write_ctx)
+{
+    if (!write) {
+        return LT_PARAM_ERR;
+    }
+
+    return write(write_ctx, "# EOF\n", 6);
+}
@@ -0,0 +1,30 @@
+#ifndef LT_METRICS_H
+#define LT_METRICS_H
+
+/**
+ * @file lt_metrics.h
+ * @brief Latency buckets of the metrics exporter (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Returns the latency bucket of lt_stats_l3_cmd_t::hist taking the execution time.
+ *
+ * @param time_us  Time from encryption of the L3 Command to decryption of its L3 Result in microseconds
+ * @return         Index of the bucket, less than LT_METRICS_BUCKETS.
+ */
+uint8_t lt_metrics_bucket(const uint64_t time_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_METRICS_H
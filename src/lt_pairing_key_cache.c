@@ -0,0 +1,103 @@
+/**
+ * @file lt_pairing_key_cache.c
+ * @brief Pairing key cache definitions, pairing keys unwrapped by the application's provider only once
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "lt_secure_memzero.h"
+
+/** Wipes keys of the slot and marks it as not cached. */
+static void lt_pairing_key_cache_wipe(lt_pairing_key_cache_t *cache, const lt_pkey_index_t pkey_index)
+{
+    lt_secure_memzero(cache->shipriv[pkey_index], sizeof(cache->shipriv[pkey_index]));
+    lt_secure_memzero(cache->shipub[pkey_index], sizeof(cache->shipub[pkey_index]));
+    cache->cached &= (uint8_t)~(1U << pkey_index);
+}
+
+lt_ret_t lt_pairing_key_cache_init(lt_pairing_key_cache_t *cache, lt_pairing_key_unwrap_fn_t unwrap, void *unwrap_ctx)
+{
+    if (!cache || !unwrap) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_secure_memzero(cache, sizeof(*cache));
+    cache->unwrap = unwrap;
+    cache->unwrap_ctx = unwrap_ctx;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_pairing_key_cache_get(lt_pairing_key_cache_t *cache, const lt_pkey_index_t pkey_index,
+                                  const uint8_t **shipriv, const uint8_t **shipub)
+{
+    if (!cache || !cache->unwrap || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3) || !shipriv || !shipub) {
+        return LT_PARAM_ERR;
+    }
+
+    if (!(cache->cached & (1U << pkey_index))) {
+        lt_ret_t ret = cache->unwrap(cache->unwrap_ctx, pkey_index, cache->shipriv[pkey_index],
+                                     cache->shipub[pkey_index]);
+        if (ret != LT_OK) {
+            // Provider may have failed half way through.
+            lt_pairing_key_cache_wipe(cache, pkey_index);
+            return ret;
+        }
+        cache->cached |= (uint8_t)(1U << pkey_index);
+    }
+
+    *shipriv = cache->shipriv[pkey_index];
+    *shipub = cache->shipub[pkey_index];
+
+    return LT_OK;
+}
+
+lt_ret_t lt_pairing_key_cache_forget(lt_pairing_key_cache_t *cache, const lt_pkey_index_t pkey_index)
+{
+    if (!cache || !cache->unwrap || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_pairing_key_cache_wipe(cache, pkey_index);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_pairing_key_cache_deinit(lt_pairing_key_cache_t *cache)
+{
+    if (!cache) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_secure_memzero(cache, sizeof(*cache));
+
+    return LT_OK;
+}
+
+lt_ret_t lt_pairing_key_cache_start_session(lt_handle_t *h, lt_pairing_key_cache_t *cache,
+                                             const lt_pkey_index_t pkey_index)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    const uint8_t *shipriv;
+    const uint8_t *shipub;
+    lt_ret_t ret = lt_pairing_key_cache_get(cache, pkey_index, &shipriv, &shipub);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_verify_chip_and_start_secure_session(h, shipriv, shipub, pkey_index);
+    if (ret == LT_L2_HSK_ERR) {
+        // Keys of the slot may have been changed since they were unwrapped.
+        lt_pairing_key_cache_wipe(cache, pkey_index);
+    }
+
+    return ret;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file lt_pairing_pub_cache.c
+ * @brief Pairing public key cache definitions, results of Pairing_Key_Read known to the host
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_pairing_pub_cache.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+LT_STATIC_ASSERT(LT_PAIRING_PUB_CACHE_SLOTS == TR01_PAIRING_KEY_SLOT_INDEX_3 + 1)
+LT_STATIC_ASSERT(LT_PAIRING_PUB_CACHE_KEY_LEN == TR01_SHIPUB_LEN)
+
+/** Returns the cache of the handle, dropped first if it belongs to an earlier Secure Session. */
+static lt_pairing_pub_cache_t *lt_pairing_pub_cache_of(lt_handle_t *h)
+{
+    lt_pairing_pub_cache_t *c = &h->l3.pairing_pub;
+
+    if (c->session_cnt != h->l3.session_cnt) {
+        c->session_cnt = h->l3.session_cnt;
+        c->known = 0;
+    }
+
+    return c;
+}
+
+/** Keeps result of the slot, with the public key if the result is LT_OK. */
+static void lt_pairing_pub_cache_put(lt_handle_t *h, const uint8_t slot, const lt_ret_t ret, const uint8_t *pub)
+{
+    lt_pairing_pub_cache_t *c = lt_pairing_pub_cache_of(h);
+
+    c->known |= (uint8_t)(1U << slot);
+    c->result[slot] = (uint8_t)ret;
+    if (ret == LT_OK) {
+        memcpy(c->pub[slot], pub, LT_PAIRING_PUB_CACHE_KEY_LEN);
+    }
+}
+
+void lt_pairing_pub_cache_forget(lt_handle_t *h, const uint8_t slot)
+{
+    lt_pairing_pub_cache_t *c = lt_pairing_pub_cache_of(h);
+
+    c->known &= (uint8_t)~(1U << slot);
+}
+
+bool lt_pairing_pub_cache_known_invalid(lt_handle_t *h, const uint8_t slot)
+{
+    const lt_pairing_pub_cache_t *c = lt_pairing_pub_cache_of(h);
+
+    return (c->known & (1U << slot)) && (c->result[slot] == (uint8_t)LT_L3_SLOT_INVALID);
+}
+
+bool lt_pairing_pub_cache_read(lt_handle_t *h, const uint8_t slot, uint8_t *pub, lt_ret_t *ret)
+{
+    lt_pairing_pub_cache_t *c = lt_pairing_pub_cache_of(h);
+
+    if (!(c->known & (1U << slot))) {
+        c->misses++;
+        return false;
+    }
+    c->hits++;
+
+    *ret = (lt_ret_t)c->result[slot];
+    if (*ret == LT_OK) {
+        memcpy(pub, c->pub[slot], LT_PAIRING_PUB_CACHE_KEY_LEN);
+    }
+
+    return true;
+}
+
+void lt_pairing_pub_cache_merge_read(lt_handle_t *h, const uint8_t slot, const lt_ret_t ret, const uint8_t *pub)
+{
+    if ((ret == LT_OK) || (ret == LT_L3_SLOT_EMPTY) || (ret == LT_L3_SLOT_INVALID)) {
+        lt_pairing_pub_cache_put(h, slot, ret, pub);
+    }
+}
+
+void lt_pairing_pub_cache_merge_write(lt_handle_t *h, const uint8_t slot, const lt_ret_t ret, const uint8_t *pub)
+{
+    if (ret == LT_OK) {
+        lt_pairing_pub_cache_put(h, slot, LT_OK, pub);
+    }
+    else {
+        lt_pairing_pub_cache_forget(h, slot);
+    }
+}
+
+void lt_pairing_pub_cache_merge_invalidate(lt_handle_t *h, const uint8_t slot, const lt_ret_t ret)
+{
+    if (ret == LT_OK) {
+        lt_pairing_pub_cache_put(h, slot, LT_L3_SLOT_INVALID, NULL);
+    }
+    else {
+        lt_pairing_pub_cache_forget(h, slot);
+    }
+}
+
+lt_ret_t lt_pairing_pub_cache_invalidate(lt_handle_t *h)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l3.pairing_pub.known = 0;
+
+    return LT_OK;
+}
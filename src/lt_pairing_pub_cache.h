@@ -0,0 +1,87 @@
+#ifndef LT_PAIRING_PUB_CACHE_H
+#define LT_PAIRING_PUB_CACHE_H
+
+/**
+ * @file lt_pairing_pub_cache.h
+ * @brief Pairing public key cache declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_PAIRING_PUB_CACHE
+/**
+ * @brief Answers Pairing_Key_Read of the slot from the cache, if the slot was read in the Secure Session.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  Pairing key slot 0-3
+ * @param pub   Buffer for the public key
+ * @param ret   Set to the result of the read if it was answered
+ * @return      true if the read was answered from the cache
+ */
+bool lt_pairing_pub_cache_read(lt_handle_t *h, const uint8_t slot, uint8_t *pub, lt_ret_t *ret);
+
+/**
+ * @brief Merges result of Pairing_Key_Read into the cache: the public key, LT_L3_SLOT_EMPTY and LT_L3_SLOT_INVALID are
+ * kept, other results change nothing.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  Pairing key slot 0-3
+ * @param ret   Result of the read
+ * @param pub   Public key read
+ */
+void lt_pairing_pub_cache_merge_read(lt_handle_t *h, const uint8_t slot, const lt_ret_t ret, const uint8_t *pub);
+
+/**
+ * @brief Merges result of Pairing_Key_Write into the cache: on success the slot holds the written key, otherwise the
+ * slot is forgotten.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  Pairing key slot 0-3
+ * @param ret   Result of the write
+ * @param pub   Public key written
+ */
+void lt_pairing_pub_cache_merge_write(lt_handle_t *h, const uint8_t slot, const lt_ret_t ret, const uint8_t *pub);
+
+/**
+ * @brief Merges result of Pairing_Key_Invalidate into the cache: on success the slot is invalid, otherwise the slot is
+ * forgotten.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  Pairing key slot 0-3
+ * @param ret   Result of the invalidation
+ */
+void lt_pairing_pub_cache_merge_invalidate(lt_handle_t *h, const uint8_t slot, const lt_ret_t ret);
+
+/**
+ * @brief Forgets the slot, e.g. while a command changing it is in flight.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  Pairing key slot 0-3
+ */
+void lt_pairing_pub_cache_forget(lt_handle_t *h, const uint8_t slot);
+
+/**
+ * @brief Tells whether the slot is known to be invalidated in the current Secure Session.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  Pairing key slot 0-3
+ * @return      true if Pairing_Key_Read of the slot is known to return LT_L3_SLOT_INVALID
+ */
+bool lt_pairing_pub_cache_known_invalid(lt_handle_t *h, const uint8_t slot);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_PAIRING_PUB_CACHE_H
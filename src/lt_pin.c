@@ -0,0 +1,396 @@
+/**
+ * @file lt_pin.c
+ * @brief PIN verification engine based on MAC-and-Destroy
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_l3.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "lt_hmac_sha256.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_cmd_desc.h"
+#include "lt_secure_memzero.h"
+
+/**
+ * @brief Data of the engine stored in R-Memory, only ci of the used rounds are stored.
+ */
+struct lt_pin_nvm_t {
+    /** Number of remaining attempts. */
+    uint8_t i;
+    /** Number of rounds the PIN was set up with. */
+    uint8_t rounds;
+    /** Tag t = KDF(s, 0x00) of the secret. */
+    uint8_t t[LT_HMAC_SHA256_HASH_LEN];
+    /** Secret encrypted by the key of each round. */
+    uint8_t ci[LT_PIN_ROUNDS_MAX][TR01_MAC_AND_DESTROY_DATA_SIZE];
+} __attribute__((__packed__));
+
+/** Size of the stored data of the engine with given number of rounds. */
+#define LT_PIN_NVM_SIZE(rounds) (offsetof(struct lt_pin_nvm_t, ci) + (size_t)(rounds) * TR01_MAC_AND_DESTROY_DATA_SIZE)
+
+/** PIN concatenated with the additional data, input of the KDFs. */
+struct lt_pin_input_t {
+    uint8_t data[LT_PIN_LEN_MAX + LT_PIN_ADD_LEN_MAX];
+    uint8_t len;
+};
+
+static lt_ret_t lt_pin_input(struct lt_pin_input_t *in, const uint8_t *pin, const uint8_t pin_len, const uint8_t *add,
+                             const uint8_t add_len)
+{
+    if (!pin || (pin_len < LT_PIN_LEN_MIN) || (pin_len > LT_PIN_LEN_MAX) || (add_len > LT_PIN_ADD_LEN_MAX)
+        || (!add && add_len)) {
+        return LT_PARAM_ERR;
+    }
+
+    memcpy(in->data, pin, pin_len);
+    if (add_len) {
+        memcpy(in->data + pin_len, add, add_len);
+    }
+    in->len = pin_len + add_len;
+
+    return LT_OK;
+}
+
+/** KDF(key, label) with one byte label, as used by the Application note. */
+static lt_ret_t lt_pin_kdf_label(const uint8_t *key, const uint8_t label, uint8_t *output)
+{
+    return lt_hmac_sha256(key, LT_HMAC_SHA256_HASH_LEN, &label, 1, output);
+}
+
+static void lt_pin_xor(const uint8_t *a, const uint8_t *b, uint8_t *output)
+{
+    for (uint8_t i = 0; i < TR01_MAC_AND_DESTROY_DATA_SIZE; i++) {
+        output[i] = a[i] ^ b[i];
+    }
+}
+
+/** Compares the tags in constant time. */
+static uint8_t lt_pin_tag_equal(const uint8_t *a, const uint8_t *b)
+{
+    uint8_t diff = 0;
+    for (uint8_t i = 0; i < LT_HMAC_SHA256_HASH_LEN; i++) {
+        diff |= a[i] ^ b[i];
+    }
+
+    return diff == 0;
+}
+
+/** Sends MAC_And_Destroy L3 Command, the host can work until lt_pin_macandd_recv(). */
+static lt_ret_t lt_pin_macandd_send(lt_handle_t *h, const uint8_t slot, const uint8_t *data_out)
+{
+    lt_ret_t ret = lt_out__mac_and_destroy(h, (lt_mac_and_destroy_slot_t)slot, data_out);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
+}
+
+/** Receives MAC_And_Destroy L3 Result of the command sent by lt_pin_macandd_send(). */
+static lt_ret_t lt_pin_macandd_recv(lt_handle_t *h, uint8_t *data_in)
+{
+    lt_ret_t ret
+        = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, LT_L3_CMD_IDX_MAC_AND_DESTROY));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_in__mac_and_destroy(h, data_in);
+}
+
+/** Caches the released key for the current Secure Session. */
+static lt_ret_t lt_pin_cache(lt_pin_t *p, const uint8_t *v, const uint8_t *key)
+{
+    lt_ret_t ret = lt_hmac_sha256(key, LT_PIN_KEY_LEN, v, LT_HMAC_SHA256_HASH_LEN, p->pin_tag);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    memcpy(p->key, key, LT_PIN_KEY_LEN);
+    p->session_cnt = p->h->l3.session_cnt;
+    p->cached = 1;
+
+    return LT_OK;
+}
+
+/** Writes the stored data of the engine into R-Memory. */
+static lt_ret_t lt_pin_nvm_write(lt_pin_t *p, const struct lt_pin_nvm_t *nvm)
+{
+    lt_ret_t ret = lt_r_mem_data_erase(p->h, p->r_mem_slot);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_r_mem_data_write(p->h, p->r_mem_slot, (const uint8_t *)nvm, (uint16_t)LT_PIN_NVM_SIZE(p->rounds));
+}
+
+lt_ret_t lt_pin_init(lt_pin_t *p, lt_handle_t *h, const lt_mac_and_destroy_slot_t macandd_slot, const uint8_t rounds,
+                     const uint16_t r_mem_slot)
+{
+    if (!p || !h || !rounds || (rounds > LT_PIN_ROUNDS_MAX)
+        || ((uint16_t)macandd_slot + rounds - 1 > TR01_MAC_AND_DESTROY_SLOT_127)
+        || (r_mem_slot > TR01_R_MEM_DATA_SLOT_MAX)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_secure_memzero(p, sizeof(lt_pin_t));
+    p->h = h;
+    p->r_mem_slot = r_mem_slot;
+    p->macandd_slot = (uint8_t)macandd_slot;
+    p->rounds = rounds;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_pin_lock(lt_pin_t *p)
+{
+    if (!p) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_secure_memzero(p->pin_tag, sizeof(p->pin_tag));
+    lt_secure_memzero(p->key, sizeof(p->key));
+    p->cached = 0;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_pin_setup(lt_pin_t *p, const uint8_t *master_secret, const uint8_t *pin, const uint8_t pin_len,
+                      const uint8_t *add, const uint8_t add_len, uint8_t *key)
+{
+    if (!p || !p->h || !master_secret || !key) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_pin_input_t in;
+    lt_ret_t ret = lt_pin_input(&in, pin, pin_len, add, add_len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (p->h->l3.session_status != LT_SECURE_SESSION_ON) {
+        lt_secure_memzero(&in, sizeof(in));
+        return LT_HOST_NO_SESSION;
+    }
+
+    lt_handle_t *h = p->h;
+    const uint8_t zeros[LT_HMAC_SHA256_HASH_LEN] = {0};
+    uint8_t u[LT_HMAC_SHA256_HASH_LEN];
+    uint8_t v[LT_HMAC_SHA256_HASH_LEN];
+    uint8_t w_i[TR01_MAC_AND_DESTROY_DATA_SIZE];
+    uint8_t k_i[LT_HMAC_SHA256_HASH_LEN];
+    uint8_t ignore[TR01_MAC_AND_DESTROY_DATA_SIZE];
+    struct lt_pin_nvm_t nvm;
+    memset(&nvm, 0, sizeof(nvm));
+    memset(key, 0, LT_PIN_KEY_LEN);
+    lt_pin_lock(p);
+
+    nvm.i = p->rounds;
+    nvm.rounds = p->rounds;
+
+    // t = KDF(s, 0x00), u = KDF(s, 0x01), v = KDF(0, PIN||A)
+    ret = lt_pin_kdf_label(master_secret, 0x00, nvm.t);
+    if (ret == LT_OK) {
+        ret = lt_pin_kdf_label(master_secret, 0x01, u);
+    }
+    if (ret == LT_OK) {
+        ret = lt_hmac_sha256(zeros, sizeof(zeros), in.data, in.len, v);
+    }
+
+    for (uint8_t i = 0; (ret == LT_OK) && (i < p->rounds); i++) {
+        const uint8_t slot = p->macandd_slot + i;
+
+        // Initialize the slot with u, then get w_i = MACANDD(i, v), which destroys it.
+        ret = lt_pin_macandd_send(h, slot, u);
+        if (ret == LT_OK) {
+            ret = lt_pin_macandd_recv(h, ignore);
+        }
+        if (ret == LT_OK) {
+            ret = lt_pin_macandd_send(h, slot, v);
+        }
+        if (ret == LT_OK) {
+            ret = lt_pin_macandd_recv(h, w_i);
+        }
+        if (ret != LT_OK) {
+            break;
+        }
+
+        // Initialize the slot with u again and derive k_i = KDF(w_i, PIN||A) while TROPIC01 executes it.
+        ret = lt_pin_macandd_send(h, slot, u);
+        if (ret != LT_OK) {
+            break;
+        }
+        lt_ret_t ret_kdf = lt_hmac_sha256(w_i, sizeof(w_i), in.data, in.len, k_i);
+        if (ret_kdf == LT_OK) {
+            lt_pin_xor(master_secret, k_i, nvm.ci[i]);
+        }
+        ret = lt_pin_macandd_recv(h, ignore);
+        if (ret == LT_OK) {
+            ret = ret_kdf;
+        }
+    }
+
+    if (ret == LT_OK) {
+        ret = lt_pin_nvm_write(p, &nvm);
+    }
+    if (ret == LT_OK) {
+        ret = lt_pin_kdf_label(master_secret, '2', key);
+    }
+    if (ret == LT_OK) {
+        ret = lt_pin_cache(p, v, key);
+    }
+    if (ret != LT_OK) {
+        lt_secure_memzero(key, LT_PIN_KEY_LEN);
+    }
+
+    lt_secure_memzero(&in, sizeof(in));
+    lt_secure_memzero(u, sizeof(u));
+    lt_secure_memzero(v, sizeof(v));
+    lt_secure_memzero(w_i, sizeof(w_i));
+    lt_secure_memzero(k_i, sizeof(k_i));
+    lt_secure_memzero(&nvm, sizeof(nvm));
+
+    return ret;
+}
+
+lt_ret_t lt_pin_verify(lt_pin_t *p, const uint8_t *pin, const uint8_t pin_len, const uint8_t *add,
+                       const uint8_t add_len, uint8_t *key)
+{
+    if (!p || !p->h || !key) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_pin_input_t in;
+    lt_ret_t ret = lt_pin_input(&in, pin, pin_len, add, add_len);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (p->h->l3.session_status != LT_SECURE_SESSION_ON) {
+        lt_secure_memzero(&in, sizeof(in));
+        lt_pin_lock(p);
+        return LT_HOST_NO_SESSION;
+    }
+
+    lt_handle_t *h = p->h;
+    const uint8_t zeros[LT_HMAC_SHA256_HASH_LEN] = {0};
+    uint8_t v_[LT_HMAC_SHA256_HASH_LEN];
+    uint8_t w_[TR01_MAC_AND_DESTROY_DATA_SIZE];
+    uint8_t k_[LT_HMAC_SHA256_HASH_LEN];
+    uint8_t s_[TR01_MAC_AND_DESTROY_DATA_SIZE];
+    uint8_t t_[LT_HMAC_SHA256_HASH_LEN];
+    uint8_t u[LT_HMAC_SHA256_HASH_LEN];
+    uint8_t ignore[TR01_MAC_AND_DESTROY_DATA_SIZE];
+    struct lt_pin_nvm_t nvm;
+    memset(&nvm, 0, sizeof(nvm));
+    memset(key, 0, LT_PIN_KEY_LEN);
+
+    // v' = KDF(0, PIN'||A)
+    ret = lt_hmac_sha256(zeros, sizeof(zeros), in.data, in.len, v_);
+    if (ret != LT_OK) {
+        goto exit;
+    }
+
+    if (p->cached && (p->session_cnt == h->l3.session_cnt)) {
+        ret = lt_hmac_sha256(p->key, sizeof(p->key), v_, sizeof(v_), t_);
+        if (ret != LT_OK) {
+            goto exit;
+        }
+        if (lt_pin_tag_equal(t_, p->pin_tag)) {
+            memcpy(key, p->key, LT_PIN_KEY_LEN);
+            goto exit;
+        }
+    }
+    // Wrong PIN or a new Secure Session, the key is released only by TROPIC01 from now on.
+    lt_pin_lock(p);
+
+    uint16_t read_size = 0;
+    ret = lt_r_mem_data_read(h, p->r_mem_slot, (uint8_t *)&nvm, (uint16_t)LT_PIN_NVM_SIZE(p->rounds), &read_size);
+    if (ret != LT_OK) {
+        goto exit;
+    }
+    if ((read_size != LT_PIN_NVM_SIZE(p->rounds)) || (nvm.rounds != p->rounds) || (nvm.i > p->rounds)) {
+        LT_LOG_ERROR("PIN data in R-Memory slot %d do not match the engine.", (int)p->r_mem_slot);
+        ret = LT_FAIL;
+        goto exit;
+    }
+    if (nvm.i == 0) {
+        ret = LT_FAIL;
+        goto exit;
+    }
+
+    // The attempt is consumed before it is verified, so it cannot be retried by cutting the power.
+    nvm.i--;
+    ret = lt_pin_nvm_write(p, &nvm);
+    if (ret != LT_OK) {
+        goto exit;
+    }
+
+    // w' = MACANDD(i, v'), k'_i = KDF(w', PIN'||A), s' = DEC(k'_i, c_i), t' = KDF(s', 0x00)
+    ret = lt_pin_macandd_send(h, p->macandd_slot + nvm.i, v_);
+    if (ret == LT_OK) {
+        ret = lt_pin_macandd_recv(h, w_);
+    }
+    if (ret == LT_OK) {
+        ret = lt_hmac_sha256(w_, sizeof(w_), in.data, in.len, k_);
+    }
+    if (ret == LT_OK) {
+        lt_pin_xor(nvm.ci[nvm.i], k_, s_);
+        ret = lt_pin_kdf_label(s_, 0x00, t_);
+    }
+    if (ret != LT_OK) {
+        goto exit;
+    }
+    if (!lt_pin_tag_equal(t_, nvm.t)) {
+        ret = LT_FAIL;
+        goto exit;
+    }
+
+    // Correct PIN, slots from the one just used up to the last one are initialized again by u = KDF(s', 0x01). The
+    // commands go back-to-back, the key is derived while TROPIC01 executes the last one.
+    ret = lt_pin_kdf_label(s_, 0x01, u);
+    for (uint8_t x = nvm.i; (ret == LT_OK) && (x < p->rounds); x++) {
+        ret = lt_pin_macandd_send(h, p->macandd_slot + x, u);
+        if (ret != LT_OK) {
+            break;
+        }
+        lt_ret_t ret_kdf = LT_OK;
+        if (x == p->rounds - 1) {
+            ret_kdf = lt_pin_kdf_label(s_, '2', key);
+        }
+        ret = lt_pin_macandd_recv(h, ignore);
+        if (ret == LT_OK) {
+            ret = ret_kdf;
+        }
+    }
+
+    if (ret == LT_OK) {
+        nvm.i = p->rounds;
+        ret = lt_pin_nvm_write(p, &nvm);
+    }
+    if (ret == LT_OK) {
+        ret = lt_pin_cache(p, v_, key);
+    }
+
+exit:
+    if (ret != LT_OK) {
+        lt_secure_memzero(key, LT_PIN_KEY_LEN);
+    }
+    lt_secure_memzero(&in, sizeof(in));
+    lt_secure_memzero(v_, sizeof(v_));
+    lt_secure_memzero(w_, sizeof(w_));
+    lt_secure_memzero(k_, sizeof(k_));
+    lt_secure_memzero(s_, sizeof(s_));
+    lt_secure_memzero(t_, sizeof(t_));
+    lt_secure_memzero(u, sizeof(u));
+    lt_secure_memzero(&nvm, sizeof(nvm));
+
+    return ret;
+}
@@ -0,0 +1,978 @@
+/**
+ * @file lt_pool.c
+ * @brief Pool of TROPIC01 devices executing stateless operations on the least loaded healthy device
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_l3_process.h"
+#include "lt_port_wrap.h"
+#include "lt_secure_memzero.h"
+#ifdef LT_POOL_HEDGE
+#include "libtropic_l2.h"
+#include "libtropic_port.h"
+#include "lt_l1.h"
+#endif
+
+LT_STATIC_ASSERT((LT_POOL_MAX_DEVICES >= 1) && (LT_POOL_MAX_DEVICES <= 255))
+LT_STATIC_ASSERT(LT_POOL_BACKOFF_MAX_SHIFT <= 7)
+
+#ifdef LT_POOL_HEDGE
+LT_STATIC_ASSERT(LT_POOL_HEDGE_WINDOW <= UINT16_MAX)
+LT_STATIC_ASSERT((LT_POOL_HEDGE_MIN_SAMPLES >= 1) && (LT_POOL_HEDGE_MIN_SAMPLES <= LT_POOL_HEDGE_WINDOW / 2))
+
+#ifndef LT_POOL_HEDGE_TIMEOUT_MS
+/** Hedged device gives up an operation busy this long, as lt_l1_read() gives up after LT_L1_READ_MAX_TRIES. */
+#define LT_POOL_HEDGE_TIMEOUT_MS (LT_L1_READ_MAX_TRIES * LT_L1_READ_RETRY_DELAY)
+#endif
+#endif
+
+/** Waits until no other caller uses the handle of the device. */
+static lt_ret_t lt_pool_dev_lock(lt_pool_dev_t *dev)
+{
+    while (__atomic_exchange_n(&dev->busy, true, __ATOMIC_ACQUIRE)) {
+        lt_ret_t ret = lt_l1_delay(&dev->h->l2, 1);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return LT_OK;
+}
+
+static bool lt_pool_dev_trylock(lt_pool_dev_t *dev) { return !__atomic_exchange_n(&dev->busy, true, __ATOMIC_ACQUIRE); }
+
+static void lt_pool_dev_unlock(lt_pool_dev_t *dev) { __atomic_store_n(&dev->busy, false, __ATOMIC_RELEASE); }
+
+/** Executes the operation on the locked device, by its executor if it has one. */
+static lt_ret_t lt_pool_dev_run(lt_pool_dev_t *dev, lt_pool_op_t op, void *op_ctx)
+{
+    if (dev->exec) {
+        return dev->exec(dev->exec_ctx, dev->h, op, op_ctx);
+    }
+
+    return op(dev->h, op_ctx);
+}
+
+/** Unlocks the device and removes the caller from its callers. */
+static void lt_pool_dev_release(lt_pool_dev_t *dev)
+{
+    lt_pool_dev_unlock(dev);
+    __atomic_sub_fetch(&dev->depth, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Tells whether the operation failed because of the device rather than because of its arguments or state of
+ * TROPIC01 (e.g. empty slot).
+ */
+static bool lt_pool_dev_failed(const lt_pool_dev_t *dev, const lt_ret_t ret)
+{
+    if (dev->h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return true;
+    }
+
+    switch (ret) {
+        case LT_HOST_NO_SESSION:
+        case LT_L3_HARDWARE_FAIL:
+            return true;
+        default:
+            return ((ret >= LT_L1_SPI_ERROR) && (ret <= LT_L1_INT_TIMEOUT))
+                   || ((ret >= LT_L2_REQ_CONT) && (ret <= LT_L2_STATUS_UNKNOWN));
+    }
+}
+
+/** Excludes the device from dispatching, its Secure Session is dropped as TROPIC01 state is unknown. */
+static void lt_pool_dev_quarantine(lt_pool_dev_t *dev)
+{
+    lt_l3_invalidate_host_session_data(&dev->h->l3);
+    dev->handshake_failures = 0;
+    dev->backoff = 0;
+    dev->failures++;
+    __atomic_store_n(&dev->quarantined, true, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Assigns the caller to the healthy untried device with the fewest callers, NULL if there is none. Standby
+ * devices are assigned only when no other device is left.
+ */
+static lt_pool_dev_t *lt_pool_pick(lt_pool_t *pool, const bool *tried)
+{
+    lt_pool_dev_t *best = NULL;
+    uint8_t best_depth = 0;
+
+    for (uint8_t i = 0; i < pool->dev_cnt; i++) {
+        lt_pool_dev_t *dev = &pool->devs[i];
+        if (tried[i] || __atomic_load_n(&dev->quarantined, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+
+        uint8_t depth = __atomic_load_n(&dev->depth, __ATOMIC_RELAXED);
+        if (!best || (dev->standby < best->standby) || ((dev->standby == best->standby) && (depth < best_depth))) {
+            best = dev;
+            best_depth = depth;
+        }
+    }
+
+    if (best) {
+        __atomic_add_fetch(&best->depth, 1, __ATOMIC_RELAXED);
+    }
+
+    return best;
+}
+
+#ifndef LT_POOL_HEDGE
+/** Executes the operation on the least loaded healthy device, retries on the next one if the device fails. */
+static lt_ret_t lt_pool_exec(lt_pool_t *pool, lt_pool_op_t op, void *op_ctx)
+{
+    bool tried[LT_POOL_MAX_DEVICES] = {false};
+    lt_ret_t ret = LT_HOST_NO_SESSION;
+    lt_pool_dev_t *dev;
+
+    while ((dev = lt_pool_pick(pool, tried)) != NULL) {
+        tried[dev - pool->devs] = true;
+
+        lt_ret_t lock_ret = lt_pool_dev_lock(dev);
+        if (lock_ret != LT_OK) {
+            __atomic_sub_fetch(&dev->depth, 1, __ATOMIC_RELAXED);
+            return lock_ret;
+        }
+
+        // The caller executing before us may have quarantined the device.
+        bool failed = true;
+        if (!dev->quarantined) {
+            ret = lt_pool_dev_run(dev, op, op_ctx);
+            dev->ops++;
+            failed = lt_pool_dev_failed(dev, ret);
+            if (failed) {
+                lt_pool_dev_quarantine(dev);
+            }
+        }
+
+        lt_pool_dev_release(dev);
+
+        if (!failed) {
+            return ret;
+        }
+    }
+
+    return ret;
+}
+#else
+/** Adds latency of a finished operation to the histogram, it is left out while another caller updates it. */
+static void lt_pool_hedge_record(lt_pool_t *pool, const uint64_t time_us)
+{
+    if (__atomic_exchange_n(&pool->lat_busy, true, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    uint64_t ms = time_us / 1000;
+    uint8_t bucket = 0;
+    while (ms && (bucket < LT_POOL_HEDGE_BUCKETS - 1)) {
+        ms >>= 1;
+        bucket++;
+    }
+    __atomic_add_fetch(&pool->lat_hist[bucket], 1, __ATOMIC_RELAXED);
+
+    uint16_t cnt = (uint16_t)(__atomic_load_n(&pool->lat_cnt, __ATOMIC_RELAXED) + 1);
+    if (cnt >= LT_POOL_HEDGE_WINDOW) {
+        // Rounding up keeps at least half of the window, so hedging goes on.
+        cnt = 0;
+        for (uint8_t i = 0; i < LT_POOL_HEDGE_BUCKETS; i++) {
+            uint16_t halved = (uint16_t)((__atomic_load_n(&pool->lat_hist[i], __ATOMIC_RELAXED) + 1) / 2);
+            __atomic_store_n(&pool->lat_hist[i], halved, __ATOMIC_RELAXED);
+            cnt = (uint16_t)(cnt + halved);
+        }
+    }
+    __atomic_store_n(&pool->lat_cnt, cnt, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&pool->lat_busy, false, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Assigns the caller to an idle healthy untried device with asynchronous L2 operation, standby devices first,
+ * and locks it. NULL if there is none, the caller never waits for a busy device here.
+ */
+static lt_pool_dev_t *lt_pool_pick_hedge(lt_pool_t *pool, const bool *tried)
+{
+    for (int standby = 1; standby >= 0; standby--) {
+        for (uint8_t i = 0; i < pool->dev_cnt; i++) {
+            lt_pool_dev_t *dev = &pool->devs[i];
+            if (tried[i] || !dev->op || (dev->standby != (bool)standby)
+                || __atomic_load_n(&dev->quarantined, __ATOMIC_ACQUIRE)
+                || __atomic_load_n(&dev->depth, __ATOMIC_RELAXED)) {
+                continue;
+            }
+
+            __atomic_add_fetch(&dev->depth, 1, __ATOMIC_RELAXED);
+            if (lt_pool_dev_trylock(dev)) {
+                if (!dev->quarantined) {
+                    return dev;
+                }
+                lt_pool_dev_unlock(dev);
+            }
+            __atomic_sub_fetch(&dev->depth, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    return NULL;
+}
+
+/** Drops the L3 Command in flight on the device, TROPIC01 may still execute it, so the Secure Session is dropped. */
+static void lt_pool_dev_drop_cmd(lt_pool_dev_t *dev)
+{
+    lt_l2_async_cancel(dev->op);
+    dev->h->l3.submitted = NULL;
+    lt_l3_invalidate_host_session_data(&dev->h->l3);
+}
+
+/**
+ * @brief Abandons the operation of the device whose hedged duplicate finished first. The device did not fail, so
+ * lt_pool_maintain() starts its Secure Session right away.
+ */
+static void lt_pool_dev_abandon(lt_pool_dev_t *dev)
+{
+    lt_pool_dev_drop_cmd(dev);
+    dev->handshake_failures = 0;
+    dev->backoff = 0;
+    dev->abandoned++;
+    __atomic_store_n(&dev->quarantined, true, __ATOMIC_RELEASE);
+}
+
+/** Device executing the operation in lt_pool_exec_hedged(). */
+struct lt_pool_lane_t {
+    lt_pool_dev_t *dev;
+    /** Start of the operation. */
+    uint64_t start_us;
+    /** Last transfer of an L2 frame, TROPIC01 is busy since then. */
+    uint64_t busy_us;
+};
+
+/**
+ * @brief Starts the operation on the locked device of the lane. A device without asynchronous L2 operation executes
+ * it whole by the blocking function.
+ *
+ * @return true if the operation is in flight, otherwise its result is in ret
+ */
+static bool lt_pool_lane_start(struct lt_pool_lane_t *lane, lt_pool_op_t op, void *op_ctx, lt_cmd_t *cmd,
+                               lt_ret_t *ret)
+{
+    lane->start_us = lt_port_time_us();
+    lane->busy_us = lane->start_us;
+    if (!lane->dev->op) {
+        *ret = lt_pool_dev_run(lane->dev, op, op_ctx);
+        return false;
+    }
+
+    *ret = lt_submit_async(lane->dev->h, cmd, lane->dev->op);
+    return *ret == LT_OK;
+}
+
+/**
+ * @brief Advances the operation of the lane by one L2 frame. An operation busy for LT_POOL_HEDGE_TIMEOUT_MS fails by
+ * LT_L1_CHIP_BUSY.
+ *
+ * @param lane      Lane with the operation in flight
+ * @param ret       Result of the operation, if it is not in flight anymore
+ * @param progress  Set to true if an L2 frame was transferred
+ * @return true if the operation is in flight, otherwise its result is in ret
+ */
+static bool lt_pool_lane_poll(struct lt_pool_lane_t *lane, lt_ret_t *ret, bool *progress)
+{
+    const lt_l2_async_t *op = lane->dev->op;
+    const lt_l2_async_state_t state = op->state;
+    const uint16_t offset = op->offset;
+    const uint16_t loops = op->loops;
+    lt_cmd_t *done;
+
+    *ret = lt_complete_async(lane->dev->h, lane->dev->op, &done);
+    if (*ret != LT_L1_CHIP_BUSY) {
+        *progress = true;
+        return false;
+    }
+    if ((op->state != state) || (op->offset != offset) || (op->loops != loops)) {
+        *progress = true;
+        lane->busy_us = lt_port_time_us();
+        return true;
+    }
+    if (lt_port_time_us() - lane->busy_us < (uint64_t)LT_POOL_HEDGE_TIMEOUT_MS * 1000U) {
+        return true;
+    }
+
+    lt_pool_dev_drop_cmd(lane->dev);
+    return false;
+}
+
+/**
+ * @brief Finishes the lane by the result of its device. A failed device is quarantined, otherwise the other lane is
+ * abandoned.
+ *
+ * @return true if the operation is done, false if the device failed
+ */
+static bool lt_pool_lane_done(lt_pool_t *pool, struct lt_pool_lane_t *lanes, const int i, const lt_ret_t ret)
+{
+    lt_pool_dev_t *dev = lanes[i].dev;
+    lanes[i].dev = NULL;
+    dev->ops++;
+
+    if (lt_pool_dev_failed(dev, ret)) {
+        lt_pool_dev_quarantine(dev);
+        lt_pool_dev_release(dev);
+        return false;
+    }
+
+    lt_pool_hedge_record(pool, lt_port_time_us() - lanes[i].start_us);
+    if (i == 1) {
+        dev->hedge_wins++;
+    }
+
+    lt_pool_dev_t *other = lanes[1 - i].dev;
+    if (other) {
+        lanes[1 - i].dev = NULL;
+        lt_pool_dev_abandon(other);
+        lt_pool_dev_release(other);
+    }
+    lt_pool_dev_release(dev);
+
+    return true;
+}
+
+/**
+ * @brief Executes the operation on the least loaded healthy device as lt_pool_exec() does. Once the operation runs
+ * longer than the hedge delay, its duplicate is started on another idle device and the result of the device
+ * finishing first is returned.
+ */
+static lt_ret_t lt_pool_exec_hedged(lt_pool_t *pool, lt_pool_op_t op, void *op_ctx, lt_cmd_t *cmd)
+{
+    bool tried[LT_POOL_MAX_DEVICES] = {false};
+    struct lt_pool_lane_t lanes[2] = {{NULL, 0, 0}, {NULL, 0, 0}};
+    lt_ret_t ret = LT_HOST_NO_SESSION;
+    uint32_t delay_ms = 0;
+    bool hedged = false;
+
+    for (;;) {
+        if (!lanes[0].dev && !lanes[1].dev) {
+            lt_pool_dev_t *dev = lt_pool_pick(pool, tried);
+            if (!dev) {
+                return ret;
+            }
+            tried[dev - pool->devs] = true;
+
+            lt_ret_t lock_ret = lt_pool_dev_lock(dev);
+            if (lock_ret != LT_OK) {
+                __atomic_sub_fetch(&dev->depth, 1, __ATOMIC_RELAXED);
+                return lock_ret;
+            }
+
+            // The caller executing before us may have quarantined the device.
+            if (dev->quarantined) {
+                lt_pool_dev_release(dev);
+                continue;
+            }
+
+            lanes[0].dev = dev;
+            delay_ms = lt_pool_hedge_delay_ms(pool);
+            hedged = false;
+            if (!lt_pool_lane_start(&lanes[0], op, op_ctx, cmd, &ret) && lt_pool_lane_done(pool, lanes, 0, ret)) {
+                return ret;
+            }
+            continue;
+        }
+
+        bool progress = false;
+        for (int i = 0; i < 2; i++) {
+            lt_ret_t lane_ret;
+            if (!lanes[i].dev || lt_pool_lane_poll(&lanes[i], &lane_ret, &progress)) {
+                continue;
+            }
+
+            ret = lane_ret;
+            if (lt_pool_lane_done(pool, lanes, i, ret)) {
+                return ret;
+            }
+        }
+
+        if (!hedged && lanes[0].dev && delay_ms
+            && (lt_port_time_us() - lanes[0].start_us >= (uint64_t)delay_ms * 1000U)) {
+            hedged = true;
+            lanes[1].dev = lt_pool_pick_hedge(pool, tried);
+            if (lanes[1].dev) {
+                tried[lanes[1].dev - pool->devs] = true;
+                lanes[1].dev->hedges++;
+                progress = true;
+                lt_ret_t lane_ret;
+                if (!lt_pool_lane_start(&lanes[1], op, op_ctx, cmd, &lane_ret)
+                    && lt_pool_lane_done(pool, lanes, 1, lane_ret)) {
+                    return lane_ret;
+                }
+            }
+        }
+
+        if (!progress) {
+            lt_pool_dev_t *dev = lanes[0].dev ? lanes[0].dev : lanes[1].dev;
+            lt_ret_t delay_ret = lt_l1_delay(&dev->h->l2, 1);
+            if (delay_ret != LT_OK) {
+                for (int i = 0; i < 2; i++) {
+                    if (lanes[i].dev) {
+                        lt_pool_dev_drop_cmd(lanes[i].dev);
+                        lt_pool_dev_quarantine(lanes[i].dev);
+                        lt_pool_dev_release(lanes[i].dev);
+                    }
+                }
+                return delay_ret;
+            }
+        }
+    }
+}
+#endif
+
+lt_ret_t lt_pool_init(lt_pool_t *pool)
+{
+    if (!pool) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+
+    return LT_OK;
+}
+
+lt_ret_t lt_pool_add_device(lt_pool_t *pool, lt_handle_t *h, const uint8_t *stpub, const lt_pkey_index_t pkey_index,
+                            const uint8_t *shipriv, const uint8_t *shipub)
+{
+    if (!pool || !h || !stpub || !shipriv || !shipub || (pkey_index > TR01_PAIRING_KEY_SLOT_INDEX_3)) {
+        return LT_PARAM_ERR;
+    }
+    if (pool->dev_cnt == LT_POOL_MAX_DEVICES) {
+        return LT_FAIL;
+    }
+
+    lt_pool_dev_t *dev = &pool->devs[pool->dev_cnt++];
+    memset(dev, 0, sizeof(*dev));
+    dev->h = h;
+    dev->stpub = stpub;
+    dev->pkey_index = pkey_index;
+    dev->shipriv = shipriv;
+    dev->shipub = shipub;
+
+    if (h->l3.session_status == LT_SECURE_SESSION_ON) {
+        return LT_OK;
+    }
+
+    lt_ret_t ret = lt_session_start(h, stpub, pkey_index, shipriv, shipub);
+    if (ret != LT_OK) {
+        dev->quarantined = true;
+        dev->handshake_failures = 1;
+        dev->backoff = 1;
+    }
+
+    return ret;
+}
+
+/** Arguments of the signing operations. */
+struct lt_pool_sign_ctx_t {
+    lt_ecc_slot_t ecc_slot;
+    const uint8_t *msg;
+    uint32_t msg_len;
+    uint8_t *rs;
+};
+
+static lt_ret_t lt_pool_ecdsa_sign_op(lt_handle_t *h, void *op_ctx)
+{
+    const struct lt_pool_sign_ctx_t *ctx = (const struct lt_pool_sign_ctx_t *)op_ctx;
+    return lt_ecc_ecdsa_sign(h, ctx->ecc_slot, ctx->msg, ctx->msg_len, ctx->rs);
+}
+
+static lt_ret_t lt_pool_eddsa_sign_op(lt_handle_t *h, void *op_ctx)
+{
+    const struct lt_pool_sign_ctx_t *ctx = (const struct lt_pool_sign_ctx_t *)op_ctx;
+    return lt_ecc_eddsa_sign(h, ctx->ecc_slot, ctx->msg, (uint16_t)ctx->msg_len, ctx->rs);
+}
+
+lt_ret_t lt_pool_ecdsa_sign(lt_pool_t *pool, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint32_t msg_len,
+                            uint8_t *rs)
+{
+    if (!pool) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_pool_sign_ctx_t ctx = {.ecc_slot = ecc_slot, .msg = msg, .msg_len = msg_len, .rs = rs};
+#ifdef LT_POOL_HEDGE
+    lt_cmd_t cmd = {.type = LT_CMD_ECC_ECDSA_SIGN,
+                    .args.ecc_ecdsa_sign = {.msg = msg, .rs = rs, .msg_len = msg_len, .slot = ecc_slot}};
+    return lt_pool_exec_hedged(pool, lt_pool_ecdsa_sign_op, &ctx, &cmd);
+#else
+    return lt_pool_exec(pool, lt_pool_ecdsa_sign_op, &ctx);
+#endif
+}
+
+lt_ret_t lt_pool_eddsa_sign(lt_pool_t *pool, const lt_ecc_slot_t ecc_slot, const uint8_t *msg, const uint16_t msg_len,
+                            uint8_t *rs)
+{
+    if (!pool) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_pool_sign_ctx_t ctx = {.ecc_slot = ecc_slot, .msg = msg, .msg_len = msg_len, .rs = rs};
+#ifdef LT_POOL_HEDGE
+    lt_cmd_t cmd = {.type = LT_CMD_ECC_EDDSA_SIGN,
+                    .args.ecc_eddsa_sign = {.msg = msg, .rs = rs, .msg_len = msg_len, .slot = ecc_slot}};
+    return lt_pool_exec_hedged(pool, lt_pool_eddsa_sign_op, &ctx, &cmd);
+#else
+    return lt_pool_exec(pool, lt_pool_eddsa_sign_op, &ctx);
+#endif
+}
+
+/** Arguments of the random value operation. */
+struct lt_pool_random_ctx_t {
+    uint8_t *rnd_bytes;
+    uint16_t rnd_bytes_cnt;
+};
+
+static lt_ret_t lt_pool_random_value_get_op(lt_handle_t *h, void *op_ctx)
+{
+    const struct lt_pool_random_ctx_t *ctx = (const struct lt_pool_random_ctx_t *)op_ctx;
+    return lt_random_value_get(h, ctx->rnd_bytes, ctx->rnd_bytes_cnt);
+}
+
+lt_ret_t lt_pool_random_value_get(lt_pool_t *pool, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt)
+{
+    if (!pool) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_pool_random_ctx_t ctx = {.rnd_bytes = rnd_bytes, .rnd_bytes_cnt = rnd_bytes_cnt};
+#ifdef LT_POOL_HEDGE
+    lt_cmd_t cmd = {.type = LT_CMD_RANDOM_VALUE_GET,
+                    .args.random_value_get = {.rnd_bytes = rnd_bytes, .rnd_bytes_cnt = rnd_bytes_cnt}};
+    return lt_pool_exec_hedged(pool, lt_pool_random_value_get_op, &ctx, &cmd);
+#else
+    return lt_pool_exec(pool, lt_pool_random_value_get_op, &ctx);
+#endif
+}
+
+/** Arguments of the ping operation. */
+struct lt_pool_ping_ctx_t {
+    const uint8_t *msg_out;
+    uint8_t *msg_in;
+    uint16_t msg_len;
+};
+
+static lt_ret_t lt_pool_ping_op(lt_handle_t *h, void *op_ctx)
+{
+    const struct lt_pool_ping_ctx_t *ctx = (const struct lt_pool_ping_ctx_t *)op_ctx;
+    return lt_ping(h, ctx->msg_out, ctx->msg_in, ctx->msg_len);
+}
+
+lt_ret_t lt_pool_ping(lt_pool_t *pool, const uint8_t *msg_out, uint8_t *msg_in, const uint16_t msg_len)
+{
+    if (!pool) {
+        return LT_PARAM_ERR;
+    }
+
+    struct lt_pool_ping_ctx_t ctx = {.msg_out = msg_out, .msg_in = msg_in, .msg_len = msg_len};
+#ifdef LT_POOL_HEDGE
+    lt_cmd_t cmd = {.type = LT_CMD_PING, .args.ping = {.msg_out = msg_out, .msg_in = msg_in, .msg_len = msg_len}};
+    return lt_pool_exec_hedged(pool, lt_pool_ping_op, &ctx, &cmd);
+#else
+    return lt_pool_exec(pool, lt_pool_ping_op, &ctx);
+#endif
+}
+
+/** Arguments of the key replication shared by the devices. */
+struct lt_pool_replicate_ctx_t {
+    const uint8_t *key;
+    lt_ecc_slot_t slot;
+    lt_ecc_curve_type_t curve;
+    bool replace;
+};
+
+/** Key replication on one device of the pool. */
+struct lt_pool_replica_t {
+    const struct lt_pool_replicate_ctx_t *ctx;
+    /** Locked device, NULL if the device was skipped. */
+    lt_pool_dev_t *dev;
+    /** Public key read back from the slot. */
+    uint8_t pubkey[TR01_CURVE_P256_PUBKEY_LEN];
+    lt_ecc_curve_type_t curve;
+    lt_ecc_key_origin_t origin;
+    /** The key was stored by this replication, the slot did not hold a key already. */
+    bool stored;
+    lt_ret_t ret;
+#ifdef LT_POOL_HEDGE
+    struct lt_pool_lane_t lane;
+    lt_cmd_t cmd;
+    /** L3 Command in flight, LT_CMD_ECC_KEY_ERASE, LT_CMD_ECC_KEY_STORE or LT_CMD_ECC_KEY_READ. */
+    lt_cmd_type_t step;
+    bool in_flight;
+#endif
+};
+
+/** Erases the slot if asked to, stores the key unless the slot holds a key already and reads its public key back. */
+static lt_ret_t lt_pool_replicate_op(lt_handle_t *h, void *op_ctx)
+{
+    struct lt_pool_replica_t *r = (struct lt_pool_replica_t *)op_ctx;
+    const struct lt_pool_replicate_ctx_t *ctx = r->ctx;
+    lt_ret_t ret;
+
+    if (ctx->replace) {
+        ret = lt_ecc_key_erase(h, ctx->slot);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    ret = lt_ecc_key_store(h, ctx->slot, ctx->curve, ctx->key);
+    if (ret == LT_OK) {
+        r->stored = true;
+    }
+    else if (ret != LT_L3_SLOT_NOT_EMPTY) {
+        return ret;
+    }
+
+    return lt_ecc_key_read(h, ctx->slot, r->pubkey, sizeof(r->pubkey), &r->curve, &r->origin);
+}
+
+#ifdef LT_POOL_HEDGE
+/** Fills the L3 Command of the step of the replica. */
+static void lt_pool_replica_cmd(struct lt_pool_replica_t *r)
+{
+    const struct lt_pool_replicate_ctx_t *ctx = r->ctx;
+
+    r->cmd.type = r->step;
+    switch (r->step) {
+        case LT_CMD_ECC_KEY_ERASE:
+            r->cmd.args.ecc_key_erase.slot = ctx->slot;
+            break;
+        case LT_CMD_ECC_KEY_STORE:
+            r->cmd.args.ecc_key_store.key = ctx->key;
+            r->cmd.args.ecc_key_store.slot = ctx->slot;
+            r->cmd.args.ecc_key_store.curve = ctx->curve;
+            break;
+        default:
+            r->cmd.args.ecc_key_read.key = r->pubkey;
+            r->cmd.args.ecc_key_read.curve = &r->curve;
+            r->cmd.args.ecc_key_read.origin = &r->origin;
+            r->cmd.args.ecc_key_read.slot = ctx->slot;
+            r->cmd.args.ecc_key_read.key_max_size = sizeof(r->pubkey);
+            break;
+    }
+}
+
+/**
+ * @brief Starts the step of the replica. A device without asynchronous L2 operation executes all steps by the
+ * blocking functions instead.
+ */
+static void lt_pool_replica_start(struct lt_pool_replica_t *r)
+{
+    lt_pool_replica_cmd(r);
+    r->in_flight = lt_pool_lane_start(&r->lane, lt_pool_replicate_op, r, &r->cmd, &r->ret);
+}
+
+/** Handles the result of the step in flight, starts the next step if there is one. */
+static void lt_pool_replica_step_done(struct lt_pool_replica_t *r, const lt_ret_t ret)
+{
+    r->in_flight = false;
+    r->ret = ret;
+    if (r->step == LT_CMD_ECC_KEY_STORE) {
+        r->stored = (ret == LT_OK);
+        if (ret == LT_L3_SLOT_NOT_EMPTY) {
+            r->ret = LT_OK;
+        }
+    }
+    if ((r->ret != LT_OK) || (r->step == LT_CMD_ECC_KEY_READ)) {
+        return;
+    }
+
+    r->step = (r->step == LT_CMD_ECC_KEY_ERASE) ? LT_CMD_ECC_KEY_STORE : LT_CMD_ECC_KEY_READ;
+    lt_pool_replica_start(r);
+}
+
+/**
+ * @brief Runs the replication on the locked devices at once. L3 Commands of devices with asynchronous L2 operation
+ * are sent first, so their TROPIC01s execute them while devices without it are driven by the blocking functions.
+ */
+static lt_ret_t lt_pool_replicate_run(struct lt_pool_replica_t *replicas, const uint8_t cnt)
+{
+    for (int async = 1; async >= 0; async--) {
+        for (uint8_t i = 0; i < cnt; i++) {
+            struct lt_pool_replica_t *r = &replicas[i];
+            if (r->dev && ((r->dev->op != NULL) == async)) {
+                r->step = r->ctx->replace ? LT_CMD_ECC_KEY_ERASE : LT_CMD_ECC_KEY_STORE;
+                lt_pool_replica_start(r);
+            }
+        }
+    }
+
+    for (;;) {
+        bool in_flight = false;
+        bool progress = false;
+        lt_pool_dev_t *any = NULL;
+        for (uint8_t i = 0; i < cnt; i++) {
+            struct lt_pool_replica_t *r = &replicas[i];
+            lt_ret_t ret;
+            if (!r->in_flight) {
+                continue;
+            }
+            if (!lt_pool_lane_poll(&r->lane, &ret, &progress)) {
+                lt_pool_replica_step_done(r, ret);
+            }
+            if (r->in_flight) {
+                in_flight = true;
+                any = r->dev;
+            }
+        }
+        if (!in_flight) {
+            return LT_OK;
+        }
+        if (progress) {
+            continue;
+        }
+
+        lt_ret_t delay_ret = lt_l1_delay(&any->h->l2, 1);
+        if (delay_ret != LT_OK) {
+            for (uint8_t i = 0; i < cnt; i++) {
+                if (replicas[i].in_flight) {
+                    lt_pool_dev_drop_cmd(replicas[i].dev);
+                    replicas[i].in_flight = false;
+                    replicas[i].ret = delay_ret;
+                }
+            }
+            return delay_ret;
+        }
+    }
+}
+#else
+/** Runs the replication on the locked devices one after another, over their open Secure Sessions. */
+static lt_ret_t lt_pool_replicate_run(struct lt_pool_replica_t *replicas, const uint8_t cnt)
+{
+    for (uint8_t i = 0; i < cnt; i++) {
+        if (replicas[i].dev) {
+            replicas[i].ret = lt_pool_dev_run(replicas[i].dev, lt_pool_replicate_op, &replicas[i]);
+        }
+    }
+
+    return LT_OK;
+}
+#endif
+
+/**
+ * @brief Picks the public key the other devices are verified against: of a device which stored the key by this
+ * replication, otherwise of any device which read it, NULL if there is none.
+ */
+static const struct lt_pool_replica_t *lt_pool_replica_reference(const struct lt_pool_replica_t *replicas,
+                                                                 const uint8_t cnt)
+{
+    const struct lt_pool_replica_t *ref = NULL;
+
+    for (uint8_t i = 0; i < cnt; i++) {
+        if (replicas[i].dev && (replicas[i].ret == LT_OK) && (!ref || (replicas[i].stored && !ref->stored))) {
+            ref = &replicas[i];
+        }
+    }
+
+    return ref;
+}
+
+lt_ret_t lt_pool_replicate_key(lt_pool_t *pool, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve,
+                               uint8_t *key, const bool replace, uint8_t *pubkey, lt_ret_t *results)
+{
+    if (!pool || !key || (slot > TR01_ECC_SLOT_31) || ((curve != TR01_CURVE_P256) && (curve != TR01_CURVE_ED25519))) {
+        return LT_PARAM_ERR;
+    }
+
+    const struct lt_pool_replicate_ctx_t ctx = {.key = key, .slot = slot, .curve = curve, .replace = replace};
+    struct lt_pool_replica_t replicas[LT_POOL_MAX_DEVICES];
+    const uint8_t cnt = pool->dev_cnt;
+    lt_ret_t ret = LT_OK;
+
+    // Devices are locked in their order, so concurrent replications cannot deadlock.
+    memset(replicas, 0, sizeof(replicas));
+    for (uint8_t i = 0; i < cnt; i++) {
+        lt_pool_dev_t *dev = &pool->devs[i];
+        replicas[i].ctx = &ctx;
+        replicas[i].ret = LT_HOST_NO_SESSION;
+
+        __atomic_add_fetch(&dev->depth, 1, __ATOMIC_RELAXED);
+        ret = lt_pool_dev_lock(dev);
+        if (ret != LT_OK) {
+            __atomic_sub_fetch(&dev->depth, 1, __ATOMIC_RELAXED);
+            break;
+        }
+        if (dev->quarantined) {
+            lt_pool_dev_release(dev);
+            continue;
+        }
+        replicas[i].dev = dev;
+#ifdef LT_POOL_HEDGE
+        replicas[i].lane.dev = dev;
+#endif
+    }
+
+    if (ret != LT_OK) {
+        for (uint8_t i = 0; i < cnt; i++) {
+            if (replicas[i].dev) {
+                lt_pool_dev_release(replicas[i].dev);
+            }
+        }
+        lt_secure_memzero(key, TR01_CURVE_PRIVKEY_LEN);
+        return ret;
+    }
+
+    ret = lt_pool_replicate_run(replicas, cnt);
+    lt_secure_memzero(key, TR01_CURVE_PRIVKEY_LEN);
+
+    for (uint8_t i = 0; i < cnt; i++) {
+        lt_pool_dev_t *dev = replicas[i].dev;
+        if (dev) {
+            dev->ops++;
+            if (lt_pool_dev_failed(dev, replicas[i].ret)) {
+                lt_pool_dev_quarantine(dev);
+            }
+            lt_pool_dev_release(dev);
+        }
+    }
+
+    const struct lt_pool_replica_t *ref = lt_pool_replica_reference(replicas, cnt);
+    const size_t pubkey_len = (curve == TR01_CURVE_P256) ? TR01_CURVE_P256_PUBKEY_LEN : TR01_CURVE_ED25519_PUBKEY_LEN;
+    for (uint8_t i = 0; i < cnt; i++) {
+        struct lt_pool_replica_t *r = &replicas[i];
+        if ((r->ret == LT_OK)
+            && ((r->curve != curve) || (r->origin != TR01_CURVE_STORED)
+                || memcmp(r->pubkey, ref->pubkey, pubkey_len))) {
+            r->ret = LT_FAIL;
+        }
+        if (results) {
+            results[i] = r->ret;
+        }
+        if (ret == LT_OK) {
+            ret = r->ret;
+        }
+    }
+
+    if (pubkey && ref && (ref->curve == curve) && (ref->origin == TR01_CURVE_STORED)) {
+        memcpy(pubkey, ref->pubkey, pubkey_len);
+    }
+    if (cnt == 0) {
+        ret = LT_HOST_NO_SESSION;
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_pool_maintain(lt_pool_t *pool)
+{
+    if (!pool) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t i = 0; i < pool->dev_cnt; i++) {
+        lt_pool_dev_t *dev = &pool->devs[i];
+        if (!__atomic_load_n(&dev->quarantined, __ATOMIC_ACQUIRE) || !lt_pool_dev_trylock(dev)) {
+            continue;
+        }
+
+        if (dev->backoff) {
+            dev->backoff--;
+        }
+        else if (lt_session_start(dev->h, dev->stpub, dev->pkey_index, dev->shipriv, dev->shipub) == LT_OK) {
+            dev->handshake_failures = 0;
+            dev->handshakes++;
+            __atomic_store_n(&dev->quarantined, false, __ATOMIC_RELEASE);
+        }
+        else {
+            if (dev->handshake_failures < UINT8_MAX) {
+                dev->handshake_failures++;
+            }
+            dev->backoff = (uint8_t)((1U << lt_min(dev->handshake_failures, LT_POOL_BACKOFF_MAX_SHIFT)) - 1);
+        }
+
+        lt_pool_dev_unlock(dev);
+    }
+
+    return LT_OK;
+}
+
+uint8_t lt_pool_depth(const lt_pool_t *pool, const uint8_t idx)
+{
+    if (!pool || (idx >= pool->dev_cnt)) {
+        return 0;
+    }
+
+    return __atomic_load_n(&pool->devs[idx].depth, __ATOMIC_RELAXED);
+}
+
+bool lt_pool_is_healthy(const lt_pool_t *pool, const uint8_t idx)
+{
+    if (!pool || (idx >= pool->dev_cnt)) {
+        return false;
+    }
+
+    return !__atomic_load_n(&pool->devs[idx].quarantined, __ATOMIC_ACQUIRE);
+}
+
+lt_ret_t lt_pool_set_standby(lt_pool_t *pool, const uint8_t idx, const bool standby)
+{
+    if (!pool || (idx >= pool->dev_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    pool->devs[idx].standby = standby;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_pool_set_executor(lt_pool_t *pool, const uint8_t idx, lt_pool_executor_t exec, void *exec_ctx)
+{
+    if (!pool || (idx >= pool->dev_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    pool->devs[idx].exec = exec;
+    pool->devs[idx].exec_ctx = exec_ctx;
+
+    return LT_OK;
+}
+
+#ifdef LT_POOL_HEDGE
+lt_ret_t lt_pool_set_hedge_op(lt_pool_t *pool, const uint8_t idx, struct lt_l2_async_t *op)
+{
+    if (!pool || (idx >= pool->dev_cnt) || (op && lt_l2_async_busy(op))) {
+        return LT_PARAM_ERR;
+    }
+
+    pool->devs[idx].op = op;
+
+    return LT_OK;
+}
+
+uint32_t lt_pool_hedge_delay_ms(const lt_pool_t *pool)
+{
+    if (!pool) {
+        return 0;
+    }
+
+    uint16_t cnt = __atomic_load_n(&pool->lat_cnt, __ATOMIC_RELAXED);
+    if (cnt < LT_POOL_HEDGE_MIN_SAMPLES) {
+        return 0;
+    }
+
+    // Upper bound of the bucket holding the 99th percentile.
+    uint32_t rank = (uint32_t)cnt - cnt / 100U;
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < LT_POOL_HEDGE_BUCKETS - 1; i++) {
+        sum += __atomic_load_n(&pool->lat_hist[i], __ATOMIC_RELAXED);
+        if (sum >= rank) {
+            return 1U << i;
+        }
+    }
+
+    return 1U << (LT_POOL_HEDGE_BUCKETS - 1);
+}
+#endif
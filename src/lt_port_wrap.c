@@ -11,9 +11,79 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "libtropic_common.h"
+#include "libtropic_macros.h"
 #include "libtropic_port.h"
+#include "lt_l1.h"
+#include "lt_stats.h"
+#include "lt_trace.h"
+
+#ifdef LT_DEADLINE
+#include "lt_deadline.h"
+#endif
+
+#ifdef LT_PORT_RECORD
+/** Start of a recorded call of the port, 0 if no port recorder is set. */
+#define LT_PORT_REC_START(s2) ((s2)->port_rec ? lt_port_time_us() : 0)
+
+/** Reports one call of the port to the port recorder, if set. */
+static void lt_port_rec(lt_l2_state_t *s2, lt_port_rec_t *rec, const uint64_t start_us)
+{
+    if (!s2->port_rec) {
+        return;
+    }
+    rec->dur_us = (uint32_t)(lt_port_time_us() - start_us);
+    s2->port_rec(s2->port_rec_ctx, rec);
+}
+
+/** Reports a call of the port without data to the port recorder, if set. */
+static void lt_port_rec_call(lt_l2_state_t *s2, const lt_port_rec_type_t type, const lt_ret_t ret, const uint32_t arg,
+                             const uint64_t start_us)
+{
+    lt_port_rec_t rec = {.type = type, .ret = ret, .arg = arg};
+
+    lt_port_rec(s2, &rec, start_us);
+}
+#endif
+
+#if defined(LT_PORT_CACHE_MAINT) && defined(LT_PORT_SPI_TRANSFER_V)
+/**
+ * @brief Cleans the data cache over the bytes the segments send and receive, before DMA of the port transfers them.
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Segments to transfer, already checked to fit the handle's buffer
+ * @param seg_cnt     Number of segments
+ */
+static void lt_l1_cache_clean_segs(lt_l2_state_t *s2, const lt_spi_seg_t *segs, const uint8_t seg_cnt)
+{
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        const uint8_t *tx = segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset;
+        const uint8_t *rx = segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset;
+
+        lt_port_cache_clean(s2, tx, segs[i].len);
+        // Dirty lines over the received bytes could be evicted in the middle of the transfer and overwrite them.
+        if (rx != tx) {
+            lt_port_cache_clean(s2, rx, segs[i].len);
+        }
+    }
+}
+
+/**
+ * @brief Invalidates the data cache over the bytes the segments received by DMA of the port.
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Transferred segments
+ * @param seg_cnt     Number of segments
+ */
+static void lt_l1_cache_invalidate_segs(lt_l2_state_t *s2, const lt_spi_seg_t *segs, const uint8_t seg_cnt)
+{
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        lt_port_cache_invalidate(s2, segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset, segs[i].len);
+    }
+}
+#endif
 
 lt_ret_t lt_l1_init(lt_l2_state_t *s2)
 {
@@ -22,7 +92,15 @@ lt_ret_t lt_l1_init(lt_l2_state_t *s2)
         return LT_PARAM_ERR;
     }
 #endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+    lt_ret_t ret = lt_port_init(s2);
+    lt_port_rec_call(s2, LT_PORT_REC_INIT, ret, 0, rec_start_us);
+
+    return ret;
+#else
     return lt_port_init(s2);
+#endif
 }
 
 lt_ret_t lt_l1_deinit(lt_l2_state_t *s2)
@@ -32,7 +110,15 @@ lt_ret_t lt_l1_deinit(lt_l2_state_t *s2)
         return LT_PARAM_ERR;
     }
 #endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+    lt_ret_t ret = lt_port_deinit(s2);
+    lt_port_rec_call(s2, LT_PORT_REC_DEINIT, ret, 0, rec_start_us);
+
+    return ret;
+#else
     return lt_port_deinit(s2);
+#endif
 }
 
 lt_ret_t lt_l1_spi_csn_low(lt_l2_state_t *s2)
@@ -42,7 +128,15 @@ lt_ret_t lt_l1_spi_csn_low(lt_l2_state_t *s2)
         return LT_PARAM_ERR;
     }
 #endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+    lt_ret_t ret = lt_port_spi_csn_low(s2);
+    lt_port_rec_call(s2, LT_PORT_REC_CSN_LOW, ret, 0, rec_start_us);
+
+    return ret;
+#else
     return lt_port_spi_csn_low(s2);
+#endif
 }
 
 lt_ret_t lt_l1_spi_csn_high(lt_l2_state_t *s2)
@@ -52,7 +146,15 @@ lt_ret_t lt_l1_spi_csn_high(lt_l2_state_t *s2)
         return LT_PARAM_ERR;
     }
 #endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+    lt_ret_t ret = lt_port_spi_csn_high(s2);
+    lt_port_rec_call(s2, LT_PORT_REC_CSN_HIGH, ret, 0, rec_start_us);
+
+    return ret;
+#else
     return lt_port_spi_csn_high(s2);
+#endif
 }
 
 lt_ret_t lt_l1_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms)
@@ -62,8 +164,298 @@ lt_ret_t lt_l1_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len,
         return LT_PARAM_ERR;
     }
 #endif
-    return lt_port_spi_transfer(s2, offset, tx_len, timeout_ms);
+#ifdef LT_PORT_RECORD
+    // The port overwrites sent bytes by the received ones, so they are saved for the recorder first.
+    uint8_t rec_tx[TR01_L1_LEN_MAX];
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+    if (s2->port_rec && ((size_t)offset + tx_len <= sizeof(s2->buff))) {
+        memcpy(rec_tx, s2->buff + offset, tx_len);
+    }
+#endif
+#ifdef LT_PORT_CACHE_MAINT
+    // Bytes out of the buffer are refused by the port, their cache lines would belong to other members.
+    bool cache_maint = ((size_t)offset + tx_len <= sizeof(s2->buff));
+    if (cache_maint) {
+        lt_port_cache_clean(s2, s2->buff + offset, tx_len);
+    }
+#endif
+#ifdef LT_DEADLINE
+    timeout_ms = lt_deadline_timeout_ms(s2, timeout_ms);
+#endif
+    LT_TRACE_START(s2->trace, LT_TRACE_L1_SPI);
+    lt_ret_t ret = lt_port_spi_transfer(s2, offset, tx_len, timeout_ms);
+    LT_TRACE_END(s2->trace, LT_TRACE_L1_SPI);
+#ifdef LT_PORT_CACHE_MAINT
+    if (cache_maint) {
+        lt_port_cache_invalidate(s2, s2->buff + offset, tx_len);
+    }
+#endif
+    if (ret == LT_OK) {
+        LT_STATS_ADD(s2, l1_spi_bytes, tx_len);
+    }
+#ifdef LT_PORT_RECORD
+    if ((size_t)offset + tx_len <= sizeof(s2->buff)) {
+        lt_port_rec_t rec = {.type = LT_PORT_REC_TRANSFER,
+                             .ret = ret,
+                             .tx = rec_tx,
+                             .rx = s2->buff + offset,
+                             .len = tx_len,
+                             .offset = offset};
+        lt_port_rec(s2, &rec, rec_start_us);
+    }
+#endif
+
+    return ret;
+}
+
+/**
+ * @brief Transfers the segments by the port, or by the fallback built on top of lt_port_spi_transfer().
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Segments to transfer
+ * @param seg_cnt     Number of segments
+ * @param flags       Combination of LT_SPI_V_CSN_LOW and LT_SPI_V_CSN_HIGH
+ * @param timeout_ms  Timeout
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_l1_spi_transfer_segs(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                        uint32_t timeout_ms)
+{
+#ifdef LT_PORT_SPI_TRANSFER_V
+#ifdef LT_PORT_CACHE_MAINT
+    // Segments out of the buffer are refused by the port, their cache lines would belong to other members.
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        if ((size_t)segs[i].offset + segs[i].len > sizeof(s2->buff)) {
+            return lt_port_spi_transfer_v(s2, segs, seg_cnt, flags, timeout_ms);
+        }
+    }
+    lt_l1_cache_clean_segs(s2, segs, seg_cnt);
+    lt_ret_t ret = lt_port_spi_transfer_v(s2, segs, seg_cnt, flags, timeout_ms);
+    lt_l1_cache_invalidate_segs(s2, segs, seg_cnt);
+
+    return ret;
+#else
+    return lt_port_spi_transfer_v(s2, segs, seg_cnt, flags, timeout_ms);
+#endif
+#else
+    lt_ret_t ret, ret_unused;
+
+    if (flags & LT_SPI_V_CSN_LOW) {
+        ret = lt_port_spi_csn_low(s2);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        uint8_t *frame_pos = s2->buff + segs[i].offset;
+
+        if ((size_t)segs[i].offset + segs[i].len > sizeof(s2->buff)) {
+            ret = LT_L1_DATA_LEN_ERROR;
+            goto csn_cleanup;
+        }
+        // Segments outside of the handle's buffer have to be staged there, as the port transfers only from it.
+        if (segs[i].tx && (segs[i].tx != frame_pos)) {
+            memcpy(frame_pos, segs[i].tx, segs[i].len);
+        }
+#ifdef LT_PORT_CACHE_MAINT
+        lt_port_cache_clean(s2, frame_pos, segs[i].len);
+#endif
+        ret = lt_port_spi_transfer(s2, segs[i].offset, segs[i].len, timeout_ms);
+#ifdef LT_PORT_CACHE_MAINT
+        lt_port_cache_invalidate(s2, frame_pos, segs[i].len);
+#endif
+        if (ret != LT_OK) {
+            goto csn_cleanup;
+        }
+        if (segs[i].rx && (segs[i].rx != frame_pos)) {
+            memcpy(segs[i].rx, frame_pos, segs[i].len);
+        }
+    }
+
+    if (flags & LT_SPI_V_CSN_HIGH) {
+        return lt_port_spi_csn_high(s2);
+    }
+
+    return LT_OK;
+
+csn_cleanup:
+    ret_unused = lt_port_spi_csn_high(s2);
+    LT_UNUSED(ret_unused);  // We don't care about it, we return ret from SPI transfer anyway.
+    return ret;
+#endif
+}
+
+#ifdef LT_PORT_RECORD
+/**
+ * @brief Reports the vectored transfer to the port recorder as the calls of the port it replaces, i.e. chip select
+ * and one transfer per segment. A failed transfer is reported as a failure of the first segment followed by the chip
+ * select set high, the cleanup done by the ports.
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Transferred segments
+ * @param seg_cnt     Number of segments
+ * @param flags       Combination of LT_SPI_V_CSN_LOW and LT_SPI_V_CSN_HIGH
+ * @param tx          Bytes sent in all segments, back to back
+ * @param ret         Returned value of the transfer
+ * @param start_us    Start of the transfer
+ */
+static void lt_port_rec_segs(lt_l2_state_t *s2, const lt_spi_seg_t *segs, const uint8_t seg_cnt, const uint8_t flags,
+                             const uint8_t *tx, const lt_ret_t ret, const uint64_t start_us)
+{
+    if (flags & LT_SPI_V_CSN_LOW) {
+        lt_port_rec_call(s2, LT_PORT_REC_CSN_LOW, LT_OK, 0, start_us);
+    }
+
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        lt_port_rec_t rec = {.type = LT_PORT_REC_TRANSFER,
+                             .ret = ret,
+                             .tx = tx,
+                             .rx = segs[i].rx ? segs[i].rx : s2->buff + segs[i].offset,
+                             .len = segs[i].len,
+                             .offset = segs[i].offset};
+        // Whole duration of the transfer is reported with its last call.
+        lt_port_rec(s2, &rec, ((i == seg_cnt - 1) || (ret != LT_OK)) ? start_us : lt_port_time_us());
+        if (ret != LT_OK) {
+            lt_port_rec_call(s2, LT_PORT_REC_CSN_HIGH, LT_OK, 0, lt_port_time_us());
+            return;
+        }
+        tx += segs[i].len;
+    }
+
+    if (flags & LT_SPI_V_CSN_HIGH) {
+        lt_port_rec_call(s2, LT_PORT_REC_CSN_HIGH, LT_OK, 0, lt_port_time_us());
+    }
+}
+#endif
+
+lt_ret_t lt_l1_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                              uint32_t timeout_ms)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s2 || (!segs && seg_cnt) || (seg_cnt > LT_SPI_V_SEGS_MAX)) {
+        return LT_PARAM_ERR;
+    }
+#endif
+#ifdef LT_PORT_RECORD
+    uint8_t rec_tx[TR01_L1_LEN_MAX];
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+    size_t rec_tx_len = 0;
+    bool rec_segs = (s2->port_rec != NULL);
+    for (uint8_t i = 0; rec_segs && (i < seg_cnt); i++) {
+        if ((rec_tx_len + segs[i].len > sizeof(rec_tx)) || ((size_t)segs[i].offset + segs[i].len > sizeof(s2->buff))) {
+            rec_segs = false;
+            break;
+        }
+        memcpy(rec_tx + rec_tx_len, segs[i].tx ? segs[i].tx : s2->buff + segs[i].offset, segs[i].len);
+        rec_tx_len += segs[i].len;
+    }
+#endif
+#ifdef LT_DEADLINE
+    timeout_ms = lt_deadline_timeout_ms(s2, timeout_ms);
+#endif
+    LT_TRACE_START(s2->trace, LT_TRACE_L1_SPI);
+    lt_ret_t ret = lt_l1_spi_transfer_segs(s2, segs, seg_cnt, flags, timeout_ms);
+    LT_TRACE_END(s2->trace, LT_TRACE_L1_SPI);
+#ifdef LT_PORT_RECORD
+    if (rec_segs) {
+        lt_port_rec_segs(s2, segs, seg_cnt, flags, rec_tx, ret, rec_start_us);
+    }
+#endif
+#ifdef LT_STATS
+    if (ret == LT_OK) {
+        for (uint8_t i = 0; i < seg_cnt; i++) {
+            LT_STATS_ADD(s2, l1_spi_bytes, segs[i].len);
+        }
+    }
+#endif
+
+    return ret;
+}
+
+#ifdef LT_PORT_SPI_READ_READY
+lt_ret_t lt_l1_spi_read_ready(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms, uint16_t max_tries,
+                              uint32_t timeout_ms)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s2 || (max_len < TR01_L1_LEN_MIN) || (max_len > TR01_L1_LEN_MAX)) {
+        return LT_PARAM_ERR;
+    }
+#endif
+#ifdef LT_PORT_CACHE_MAINT
+    if (max_len <= sizeof(s2->buff)) {
+        lt_port_cache_clean(s2, s2->buff, max_len);
+    }
+#endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+#endif
+    lt_ret_t ret = lt_port_spi_read_ready(s2, max_len, retry_delay_ms, max_tries, timeout_ms);
+#ifdef LT_PORT_CACHE_MAINT
+    if (max_len <= sizeof(s2->buff)) {
+        lt_port_cache_invalidate(s2, s2->buff, max_len);
+    }
+#endif
+#ifdef LT_PORT_RECORD
+    if (s2->port_rec) {
+        // Whole frame if received, otherwise CHIP_STATUS and STATUS of the last attempt.
+        uint16_t len = TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE;
+        if ((ret == LT_OK) && (s2->buff[0] & TR01_L1_CHIP_MODE_READY_bit) && (s2->buff[1] != 0xff)) {
+            len = TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE + TR01_L2_REQ_RSP_LEN_SIZE + s2->buff[2]
+                  + TR01_L2_REQ_RSP_CRC_SIZE;
+        }
+        if (len > max_len) {
+            len = max_len;
+        }
+        lt_port_rec_t rec = {
+            .type = LT_PORT_REC_READ_READY, .ret = ret, .arg = max_len, .rx = s2->buff, .len = len};
+        lt_port_rec(s2, &rec, rec_start_us);
+    }
+#endif
+
+    return ret;
 }
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+lt_ret_t lt_l1_spi_read_ready_nowait(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms,
+                                     uint16_t max_tries, uint32_t timeout_ms)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s2 || (max_len < TR01_L1_LEN_MIN) || (max_len > TR01_L1_LEN_MAX)) {
+        return LT_PARAM_ERR;
+    }
+#endif
+#ifdef LT_PORT_CACHE_MAINT
+    // Clean lines are not written back, so the polling which already runs in the background is not disturbed.
+    if (max_len <= sizeof(s2->buff)) {
+        lt_port_cache_clean(s2, s2->buff, max_len);
+    }
+    lt_ret_t ret = lt_port_spi_read_ready_nowait(s2, max_len, retry_delay_ms, max_tries, timeout_ms);
+    if ((ret == LT_OK) && (max_len <= sizeof(s2->buff))) {
+        lt_port_cache_invalidate(s2, s2->buff, max_len);
+    }
+
+    return ret;
+#else
+    return lt_port_spi_read_ready_nowait(s2, max_len, retry_delay_ms, max_tries, timeout_ms);
+#endif
+}
+#endif
+
+#ifdef LT_PORT_L3_TUNNEL
+lt_ret_t lt_l1_l3_tunnel(lt_l2_state_t *s2, const uint8_t *cmd, uint16_t cmd_len, const uint8_t **res,
+                         uint16_t *res_len, uint32_t timeout_ms)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s2 || !cmd || !res || !res_len || (cmd_len > TR01_L3_PACKET_MAX_SIZE)) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+    return lt_port_l3_tunnel(s2, cmd, cmd_len, res, res_len, timeout_ms);
+}
+#endif
 
 lt_ret_t lt_l1_delay(lt_l2_state_t *s2, uint32_t ms)
 {
@@ -72,9 +464,46 @@ lt_ret_t lt_l1_delay(lt_l2_state_t *s2, uint32_t ms)
         return LT_PARAM_ERR;
     }
 #endif
-    return lt_port_delay(s2, ms);
+#ifdef LT_DEADLINE
+    // Delay which would end after the deadline is not started at all.
+    lt_ret_t ret_deadline = lt_deadline_check(s2, ms);
+    if (ret_deadline != LT_OK) {
+        return ret_deadline;
+    }
+#endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+#endif
+    LT_TRACE_START(s2->trace, LT_TRACE_L1_WAIT);
+    lt_ret_t ret = lt_port_delay(s2, ms);
+    LT_TRACE_END(s2->trace, LT_TRACE_L1_WAIT);
+#ifdef LT_PORT_RECORD
+    lt_port_rec_call(s2, LT_PORT_REC_DELAY, ret, ms, rec_start_us);
+#endif
+
+    return ret;
 }
 
+#ifdef LT_PORT_SPI_SET_SPEED
+lt_ret_t lt_l1_spi_set_speed(lt_l2_state_t *s2, uint32_t hz)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!s2 || !hz) {
+        return LT_PARAM_ERR;
+    }
+#endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+#endif
+    lt_ret_t ret = lt_port_spi_set_speed(s2, hz);
+#ifdef LT_PORT_RECORD
+    lt_port_rec_call(s2, LT_PORT_REC_SET_SPEED, ret, hz, rec_start_us);
+#endif
+
+    return ret;
+}
+#endif
+
 #if LT_USE_INT_PIN
 
 lt_ret_t lt_l1_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
@@ -84,7 +513,33 @@ lt_ret_t lt_l1_delay_on_int(lt_l2_state_t *s2, uint32_t ms)
         return LT_PARAM_ERR;
     }
 #endif
-    return lt_port_delay_on_int(s2, ms);
+#ifdef LT_DEADLINE
+    // The wait for the INT pin ends at the deadline at the latest.
+    const uint32_t left_ms = lt_deadline_left_ms(s2);
+    const bool clipped = (ms > left_ms);
+    if (left_ms == 0) {
+        return LT_DEADLINE_EXCEEDED;
+    }
+    if (clipped) {
+        ms = left_ms;
+    }
+#endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(s2);
+#endif
+    LT_TRACE_START(s2->trace, LT_TRACE_L1_WAIT);
+    lt_ret_t ret = lt_port_delay_on_int(s2, ms);
+    LT_TRACE_END(s2->trace, LT_TRACE_L1_WAIT);
+#ifdef LT_PORT_RECORD
+    lt_port_rec_call(s2, LT_PORT_REC_DELAY_ON_INT, ret, ms, rec_start_us);
+#endif
+#ifdef LT_DEADLINE
+    if (clipped && (ret == LT_L1_INT_TIMEOUT)) {
+        ret = LT_DEADLINE_EXCEEDED;
+    }
+#endif
+
+    return ret;
 }
 #endif
 
@@ -95,5 +550,14 @@ lt_ret_t lt_random_bytes(lt_handle_t *h, void *buff, size_t count)
         return LT_PARAM_ERR;
     }
 #endif
+#ifdef LT_PORT_RECORD
+    uint64_t rec_start_us = LT_PORT_REC_START(&h->l2);
+    lt_ret_t ret = lt_port_random_bytes(&h->l2, buff, count);
+    lt_port_rec_t rec = {.type = LT_PORT_REC_RANDOM, .ret = ret, .rx = (const uint8_t *)buff, .len = (uint32_t)count};
+    lt_port_rec(&h->l2, &rec, rec_start_us);
+
+    return ret;
+#else
     return lt_port_random_bytes(&h->l2, buff, count);
+#endif
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include <stddef.h>
 
 #include "libtropic_common.h"
+#include "libtropic_port.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -69,6 +70,72 @@ lt_ret_t lt_l1_spi_csn_high(lt_l2_state_t *s2) __attribute__((warn_unused_result
 lt_ret_t lt_l1_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms)
     __attribute__((warn_unused_result));
 
+/**
+ * @brief Does vectored L1 transfer. This is wrapper for platform defined function, if the port does not provide it
+ * (`LT_PORT_SPI_TRANSFER_V` is not defined), it is emulated using lt_port_spi_transfer() and chip select functions.
+ * @note On failure, chip select pin is left high.
+ *
+ * @param s2          Structure holding l2 state
+ * @param segs        Segments to transfer
+ * @param seg_cnt     Number of segments, at most LT_SPI_V_SEGS_MAX
+ * @param flags       Combination of LT_SPI_V_CSN_LOW and LT_SPI_V_CSN_HIGH
+ * @param timeout_ms  Timeout
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l1_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                              uint32_t timeout_ms) __attribute__((warn_unused_result));
+
+#ifdef LT_PORT_SPI_READ_READY
+/**
+ * @brief Polls for L2 Response frame and receives it. This is wrapper for platform defined function.
+ *
+ * @param s2              Structure holding l2 state
+ * @param max_len         Maximal length of the frame, including CHIP_STATUS
+ * @param retry_delay_ms  Delay between attempts
+ * @param max_tries       Maximal number of attempts
+ * @param timeout_ms      Timeout of one attempt
+ * @return                LT_OK if polling ended, LT_NOT_SUPPORTED if the port cannot poll now, otherwise returns
+ *                        other error code.
+ */
+lt_ret_t lt_l1_spi_read_ready(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms, uint16_t max_tries,
+                              uint32_t timeout_ms) __attribute__((warn_unused_result));
+#endif
+
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+/**
+ * @brief Starts polling for L2 Response frame in the background or receives the frame if the polling ended. This is
+ * wrapper for platform defined function.
+ *
+ * @param s2              Structure holding l2 state
+ * @param max_len         Maximal length of the frame, including CHIP_STATUS
+ * @param retry_delay_ms  Delay between attempts
+ * @param max_tries       Maximal number of attempts
+ * @param timeout_ms      Timeout of one attempt
+ * @return                LT_OK if polling ended, LT_L1_CHIP_BUSY if it still runs, LT_NOT_SUPPORTED if the port
+ *                        cannot poll now, otherwise returns other error code.
+ */
+lt_ret_t lt_l1_spi_read_ready_nowait(lt_l2_state_t *s2, uint16_t max_len, uint32_t retry_delay_ms,
+                                     uint16_t max_tries, uint32_t timeout_ms) __attribute__((warn_unused_result));
+#endif
+
+#ifdef LT_PORT_L3_TUNNEL
+/**
+ * @brief Transfers encrypted L3 Command packet through a bridge next to TROPIC01. This is wrapper for platform
+ * defined function.
+ *
+ * @param s2          Structure holding l2 state
+ * @param cmd         Encrypted L3 Command packet
+ * @param cmd_len     Length of cmd
+ * @param res         Response of the bridge (CHIP_STATUS, STATUS and L3 Result packet) is returned here
+ * @param res_len     Length of the response is returned here
+ * @param timeout_ms  Timeout of the whole transfer
+ * @return            LT_OK if the response was received, LT_NOT_SUPPORTED if the bridge is not available now,
+ *                    otherwise returns other error code.
+ */
+lt_ret_t lt_l1_l3_tunnel(lt_l2_state_t *s2, const uint8_t *cmd, uint16_t cmd_len, const uint8_t **res,
+                         uint16_t *res_len, uint32_t timeout_ms) __attribute__((warn_unused_result));
+#endif
+
 /**
  * @brief Platform's definition for delay, specifies what host
  *        platform should do when libtropic's functions need some delay.
@@ -80,6 +147,17 @@ lt_ret_t lt_l1_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len,
  */
 lt_ret_t lt_l1_delay(lt_l2_state_t *s2, uint32_t ms) __attribute__((warn_unused_result));
 
+#ifdef LT_PORT_SPI_SET_SPEED
+/**
+ * @brief Changes the SPI clock. This is wrapper for platform defined function.
+ *
+ * @param s2          Structure holding l2 state
+ * @param hz          Requested SPI clock in Hz
+ * @return            LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_l1_spi_set_speed(lt_l2_state_t *s2, uint32_t hz) __attribute__((warn_unused_result));
+#endif
+
 #if LT_USE_INT_PIN
 /**
  * @brief Specifies what platform should do when waiting for signal from interrupt pin
@@ -0,0 +1,483 @@
+/**
+ * @file lt_provision.c
+ * @brief Provisioning station bringing several TROPIC01 devices to one declarative profile
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_macros.h"
+#include "lt_port_wrap.h"
+
+#ifndef LT_L2_ASYNC
+#error "LT_PROVISION requires LT_L2_ASYNC"
+#endif
+
+/** Value of an R-config object after R_Config_Erase, same as in lt_apply_R_config(). */
+#define LT_PROVISION_OBJ_ERASED 0xFFFFFFFFU
+
+LT_STATIC_ASSERT(LT_CONFIG_OBJ_CNT <= 32)
+
+/**
+ * @brief Phases of provisioning of a device, in order. All reads go before the first write, so a device which cannot
+ * be brought to the profile is refused before anything is written to its NVM.
+ */
+typedef enum lt_provision_phase_t {
+    LT_PROVISION_READ_PAIRING = 0,
+    LT_PROVISION_READ_R,
+    LT_PROVISION_READ_I,
+    LT_PROVISION_READ_ECC,
+    LT_PROVISION_ERASE_R,
+    LT_PROVISION_WRITE_R,
+    LT_PROVISION_WRITE_I,
+    LT_PROVISION_WRITE_PAIRING,
+    LT_PROVISION_GENERATE_ECC,
+    LT_PROVISION_VERIFY_R,
+    LT_PROVISION_VERIFY_I,
+    LT_PROVISION_VERIFY_PAIRING,
+    LT_PROVISION_VERIFY_ECC,
+    LT_PROVISION_DONE
+} lt_provision_phase_t;
+
+/** Number of positions of the phase, i.e. of candidate L3 Commands. */
+static uint16_t lt_provision_phase_len(const lt_provision_profile_t *profile, const uint8_t phase)
+{
+    switch (phase) {
+        case LT_PROVISION_READ_PAIRING:
+        case LT_PROVISION_WRITE_PAIRING:
+        case LT_PROVISION_VERIFY_PAIRING:
+            return TR01_PAIRING_KEY_SLOT_INDEX_3 + 1;
+        case LT_PROVISION_READ_R:
+        case LT_PROVISION_WRITE_R:
+        case LT_PROVISION_VERIFY_R:
+            return profile->r_config ? LT_CONFIG_OBJ_CNT : 0;
+        case LT_PROVISION_READ_I:
+        case LT_PROVISION_VERIFY_I:
+            return profile->i_config ? LT_CONFIG_OBJ_CNT : 0;
+        case LT_PROVISION_WRITE_I:
+            return profile->i_config ? LT_CONFIG_OBJ_CNT * 32 : 0;
+        case LT_PROVISION_ERASE_R:
+            return 1;
+        default:
+            return profile->key_cnt;
+    }
+}
+
+/** Tells whether the device needs the L3 Command at the position of the phase. */
+static bool lt_provision_needed(const lt_provision_dev_t *dev, const uint8_t phase, const uint16_t pos)
+{
+    const lt_provision_profile_t *profile = dev->p->profile;
+
+    switch (phase) {
+        case LT_PROVISION_READ_PAIRING:
+            return profile->pairing_pub[pos] != NULL;
+        case LT_PROVISION_ERASE_R:
+            return dev->r_erase;
+        case LT_PROVISION_WRITE_R:
+        case LT_PROVISION_VERIFY_R:
+            return (dev->r_write >> pos) & 1;
+        case LT_PROVISION_WRITE_I:
+            // Only bits which are 1 on the device and 0 in the profile are written.
+            return ((dev->i_cur.obj[pos / 32] & ~profile->i_config->obj[pos / 32]) >> (pos % 32)) & 1;
+        case LT_PROVISION_VERIFY_I:
+            return (dev->i_write >> pos) & 1;
+        case LT_PROVISION_WRITE_PAIRING:
+        case LT_PROVISION_VERIFY_PAIRING:
+            return (dev->pairing_write >> pos) & 1;
+        case LT_PROVISION_GENERATE_ECC:
+        case LT_PROVISION_VERIFY_ECC:
+            return (dev->ecc_write >> pos) & 1;
+        default:
+            return true;
+    }
+}
+
+/** Fills the L3 Command at the position of the phase. */
+static void lt_provision_cmd(lt_provision_dev_t *dev, const uint8_t phase, const uint16_t pos)
+{
+    const lt_provision_profile_t *profile = dev->p->profile;
+    lt_cmd_t *cmd = &dev->cmd;
+
+    switch (phase) {
+        case LT_PROVISION_READ_PAIRING:
+        case LT_PROVISION_VERIFY_PAIRING:
+            cmd->type = LT_CMD_PAIRING_KEY_READ;
+            cmd->args.pairing_key_read.pairing_pub = dev->key;
+            cmd->args.pairing_key_read.slot = (uint8_t)pos;
+            break;
+        case LT_PROVISION_READ_R:
+        case LT_PROVISION_VERIFY_R:
+            cmd->type = LT_CMD_R_CONFIG_READ;
+            cmd->args.r_config_read.addr = cfg_desc_table[pos].addr;
+            cmd->args.r_config_read.obj = &dev->obj;
+            break;
+        case LT_PROVISION_READ_I:
+        case LT_PROVISION_VERIFY_I:
+            cmd->type = LT_CMD_I_CONFIG_READ;
+            cmd->args.i_config_read.addr = cfg_desc_table[pos].addr;
+            cmd->args.i_config_read.obj = &dev->obj;
+            break;
+        case LT_PROVISION_READ_ECC:
+        case LT_PROVISION_VERIFY_ECC:
+            cmd->type = LT_CMD_ECC_KEY_READ;
+            cmd->args.ecc_key_read.key = dev->key;
+            cmd->args.ecc_key_read.curve = &dev->curve;
+            cmd->args.ecc_key_read.origin = &dev->origin;
+            cmd->args.ecc_key_read.slot = profile->keys[pos].slot;
+            cmd->args.ecc_key_read.key_max_size = sizeof(dev->key);
+            break;
+        case LT_PROVISION_ERASE_R:
+            cmd->type = LT_CMD_R_CONFIG_ERASE;
+            break;
+        case LT_PROVISION_WRITE_R:
+            cmd->type = LT_CMD_R_CONFIG_WRITE;
+            cmd->args.r_config_write.addr = cfg_desc_table[pos].addr;
+            cmd->args.r_config_write.obj = profile->r_config->obj[pos];
+            break;
+        case LT_PROVISION_WRITE_I:
+            cmd->type = LT_CMD_I_CONFIG_WRITE;
+            cmd->args.i_config_write.addr = cfg_desc_table[pos / 32].addr;
+            cmd->args.i_config_write.bit_index = (uint8_t)(pos % 32);
+            break;
+        case LT_PROVISION_WRITE_PAIRING:
+            cmd->type = LT_CMD_PAIRING_KEY_WRITE;
+            cmd->args.pairing_key_write.pairing_pub = profile->pairing_pub[pos];
+            cmd->args.pairing_key_write.slot = (uint8_t)pos;
+            break;
+        default:
+            cmd->type = LT_CMD_ECC_KEY_GENERATE;
+            cmd->args.ecc_key_generate.slot = profile->keys[pos].slot;
+            cmd->args.ecc_key_generate.curve = profile->keys[pos].curve;
+            break;
+    }
+}
+
+/** Length of the public key of the curve. */
+static uint8_t lt_provision_pubkey_len(const lt_ecc_curve_type_t curve)
+{
+    return (curve == TR01_CURVE_P256) ? TR01_CURVE_P256_PUBKEY_LEN : TR01_CURVE_ED25519_PUBKEY_LEN;
+}
+
+/** Tells whether the ECC key read from the device is the profile key, and reports its public key. */
+static bool lt_provision_key_match(lt_provision_dev_t *dev, const uint16_t pos)
+{
+    const lt_ecc_curve_type_t curve = dev->p->profile->keys[pos].curve;
+
+    if ((dev->curve != curve) || (dev->origin != TR01_CURVE_GENERATED)) {
+        return false;
+    }
+    if (dev->pubkeys) {
+        memset(dev->pubkeys + pos * LT_PROVISION_PUBKEY_LEN, 0, LT_PROVISION_PUBKEY_LEN);
+        memcpy(dev->pubkeys + pos * LT_PROVISION_PUBKEY_LEN, dev->key, lt_provision_pubkey_len(curve));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decides what has to be written to R-config once all of it was read, the same way `lt_apply_R_config()` does.
+ */
+static void lt_provision_plan_r(lt_provision_dev_t *dev)
+{
+    const struct lt_config_t *config = dev->p->profile->r_config;
+
+    for (uint8_t i = 0; i < LT_CONFIG_OBJ_CNT; i++) {
+        if ((config->obj[i] != dev->r_cur.obj[i]) && (dev->r_cur.obj[i] != LT_PROVISION_OBJ_ERASED)) {
+            dev->r_erase = true;
+        }
+    }
+    if (dev->r_erase) {
+        memset(dev->r_cur.obj, 0xFF, sizeof(dev->r_cur.obj));
+    }
+    for (uint8_t i = 0; i < LT_CONFIG_OBJ_CNT; i++) {
+        if (config->obj[i] != dev->r_cur.obj[i]) {
+            dev->r_write |= 1UL << i;
+        }
+        else {
+            dev->skipped++;
+        }
+    }
+}
+
+/**
+ * @brief Handles the result of the L3 Command at the position of the phase.
+ *
+ * @return LT_OK to go on with the next L3 Command, otherwise the result of the device
+ */
+static lt_ret_t lt_provision_handle(lt_provision_dev_t *dev, const uint8_t phase, const uint16_t pos,
+                                    const lt_ret_t ret)
+{
+    const lt_provision_profile_t *profile = dev->p->profile;
+
+    switch (phase) {
+        case LT_PROVISION_READ_PAIRING:
+            if (ret == LT_L3_SLOT_EMPTY) {
+                dev->pairing_write |= (uint8_t)(1U << pos);
+                return LT_OK;
+            }
+            if (ret != LT_OK) {
+                return ret;
+            }
+            if (memcmp(dev->key, profile->pairing_pub[pos], TR01_SHIPUB_LEN) != 0) {
+                return LT_FAIL;
+            }
+            dev->skipped++;
+            return LT_OK;
+        case LT_PROVISION_READ_R:
+            if (ret != LT_OK) {
+                return ret;
+            }
+            dev->r_cur.obj[pos] = dev->obj;
+            if (pos == LT_CONFIG_OBJ_CNT - 1) {
+                lt_provision_plan_r(dev);
+            }
+            return LT_OK;
+        case LT_PROVISION_READ_I:
+            if (ret != LT_OK) {
+                return ret;
+            }
+            // I-config bits can only be cleared.
+            if ((profile->i_config->obj[pos] & ~dev->obj) != 0) {
+                return LT_FAIL;
+            }
+            dev->i_cur.obj[pos] = dev->obj;
+            if (dev->obj == profile->i_config->obj[pos]) {
+                dev->skipped++;
+            }
+            return LT_OK;
+        case LT_PROVISION_READ_ECC:
+            if ((ret == LT_L3_INVALID_KEY) || (ret == LT_L3_SLOT_EMPTY)) {
+                dev->ecc_write |= 1UL << pos;
+                return LT_OK;
+            }
+            if (ret != LT_OK) {
+                return ret;
+            }
+            if (!lt_provision_key_match(dev, pos)) {
+                return LT_FAIL;
+            }
+            dev->skipped++;
+            return LT_OK;
+        case LT_PROVISION_WRITE_I:
+            if (ret != LT_OK) {
+                return ret;
+            }
+            dev->i_cur.obj[pos / 32] &= ~(1UL << (pos % 32));
+            dev->i_write |= 1UL << (pos / 32);
+            return LT_OK;
+        case LT_PROVISION_VERIFY_R:
+            if (ret != LT_OK) {
+                return ret;
+            }
+            return (dev->obj == profile->r_config->obj[pos]) ? LT_OK : LT_FAIL;
+        case LT_PROVISION_VERIFY_I:
+            if (ret != LT_OK) {
+                return ret;
+            }
+            return (dev->obj == profile->i_config->obj[pos]) ? LT_OK : LT_FAIL;
+        case LT_PROVISION_VERIFY_PAIRING:
+            if (ret != LT_OK) {
+                return ret;
+            }
+            return (memcmp(dev->key, profile->pairing_pub[pos], TR01_SHIPUB_LEN) == 0) ? LT_OK : LT_FAIL;
+        case LT_PROVISION_VERIFY_ECC:
+            if (ret != LT_OK) {
+                return ret;
+            }
+            return lt_provision_key_match(dev, pos) ? LT_OK : LT_FAIL;
+        default:
+            // Erase and writes have nothing to decode.
+            return ret;
+    }
+}
+
+/** Finishes provisioning of the device and reports it. */
+static void lt_provision_finish(lt_provision_dev_t *dev, const lt_ret_t ret)
+{
+    dev->ret = ret;
+    if (dev->cb) {
+        dev->cb(dev->h, ret, dev->cb_ctx);
+    }
+}
+
+/** Submits the next L3 Command the device needs after the given position, or finishes the device if there is none. */
+static void lt_provision_next(lt_provision_dev_t *dev, uint8_t phase, uint16_t pos)
+{
+    const lt_provision_profile_t *profile = dev->p->profile;
+
+    for (; phase < LT_PROVISION_DONE; phase++, pos = 0) {
+        const uint16_t len = lt_provision_phase_len(profile, phase);
+        while ((pos < len) && !lt_provision_needed(dev, phase, pos)) {
+            pos++;
+        }
+        if (pos < len) {
+            break;
+        }
+    }
+    if (phase == LT_PROVISION_DONE) {
+        lt_provision_finish(dev, LT_OK);
+        return;
+    }
+
+    lt_provision_cmd(dev, phase, pos);
+    lt_ret_t ret = lt_submit_async(dev->h, &dev->cmd, dev->op);
+    if (ret != LT_OK) {
+        lt_provision_finish(dev, ret);
+        return;
+    }
+    dev->phase = phase;
+    dev->pos = pos;
+    dev->submitted = true;
+    dev->sent++;
+}
+
+lt_ret_t lt_provision_init(lt_provision_t *p, const lt_provision_profile_t *profile)
+{
+    if (!p || !profile || (profile->key_cnt > LT_PROVISION_MAX_KEYS) || (profile->key_cnt && !profile->keys)) {
+        return LT_PARAM_ERR;
+    }
+    for (uint8_t i = 0; i < profile->key_cnt; i++) {
+        if ((profile->keys[i].slot > TR01_ECC_SLOT_31)
+            || ((profile->keys[i].curve != TR01_CURVE_P256) && (profile->keys[i].curve != TR01_CURVE_ED25519))) {
+            return LT_PARAM_ERR;
+        }
+    }
+
+    memset(p, 0, sizeof(*p));
+    p->profile = profile;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_provision_add_device(lt_provision_t *p, lt_handle_t *h, lt_l2_async_t *op, uint8_t *pubkeys,
+                                 lt_provision_cb_t cb, void *cb_ctx)
+{
+    if (!p || !p->profile || !h || !op || lt_l2_async_busy(op)) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+    if ((p->dev_cnt == LT_PROVISION_MAX_DEVICES) || h->l3.submitted) {
+        return LT_FAIL;
+    }
+
+    lt_provision_dev_t *dev = &p->devs[p->dev_cnt++];
+    memset(dev, 0, sizeof(*dev));
+    dev->p = p;
+    dev->h = h;
+    dev->op = op;
+    dev->pubkeys = pubkeys;
+    dev->cb = cb;
+    dev->cb_ctx = cb_ctx;
+    dev->ret = LT_L1_CHIP_BUSY;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_provision_process(lt_provision_t *p)
+{
+    if (!p) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t i = 0; i < p->dev_cnt; i++) {
+        lt_provision_dev_t *dev = &p->devs[i];
+        if (dev->ret != LT_L1_CHIP_BUSY) {
+            continue;
+        }
+
+        if (!dev->submitted) {
+            p->steps++;
+            lt_provision_next(dev, LT_PROVISION_READ_PAIRING, 0);
+            continue;
+        }
+
+        const lt_l2_async_state_t state = dev->op->state;
+        const uint16_t offset = dev->op->offset;
+        const uint16_t loops = dev->op->loops;
+        lt_cmd_t *done;
+        lt_ret_t ret = lt_complete_async(dev->h, dev->op, &done);
+        if (ret == LT_L1_CHIP_BUSY) {
+            if ((dev->op->state != state) || (dev->op->offset != offset) || (dev->op->loops != loops)) {
+                p->steps++;
+            }
+            continue;
+        }
+
+        p->steps++;
+        dev->submitted = false;
+        ret = lt_provision_handle(dev, dev->phase, dev->pos, ret);
+        if (ret != LT_OK) {
+            lt_provision_finish(dev, ret);
+            continue;
+        }
+        lt_provision_next(dev, dev->phase, dev->pos + 1);
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_provision_run(lt_provision_t *p)
+{
+    if (!p) {
+        return LT_PARAM_ERR;
+    }
+
+    while (lt_provision_pending(p)) {
+        uint16_t steps = p->steps;
+        lt_ret_t ret = lt_provision_process(p);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        if (steps == p->steps) {
+            // All devices are executing their commands, give TROPIC01 time before the next attempt.
+            ret = lt_l1_delay(&p->devs[0].h->l2, 1);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+    }
+
+    return LT_OK;
+}
+
+uint8_t lt_provision_pending(const lt_provision_t *p)
+{
+    if (!p) {
+        return 0;
+    }
+
+    uint8_t pending = 0;
+    for (uint8_t i = 0; i < p->dev_cnt; i++) {
+        if (p->devs[i].ret == LT_L1_CHIP_BUSY) {
+            pending++;
+        }
+    }
+
+    return pending;
+}
+
+lt_ret_t lt_provision_result(const lt_provision_t *p, const uint8_t idx, uint16_t *sent, uint16_t *skipped)
+{
+    if (!p || (idx >= p->dev_cnt)) {
+        return LT_PARAM_ERR;
+    }
+
+    if (sent) {
+        *sent = p->devs[idx].sent;
+    }
+    if (skipped) {
+        *skipped = p->devs[idx].skipped;
+    }
+
+    return p->devs[idx].ret;
+}
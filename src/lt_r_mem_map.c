@@ -0,0 +1,421 @@
+/**
+ * @file lt_r_mem_map.c
+ * @brief R-mem occupancy map definitions, occupancy of user data slots with a summary persisted in R-mem
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_r_mem_map.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_secure_memzero.h"
+
+LT_STATIC_ASSERT(LT_R_MEM_MAP_SLOTS == LT_R_MEM_MAP_WORDS * 32)
+
+/** Summary was not looked at in this Secure Session, it may be current. */
+#define LT_R_MEM_MAP_SUMMARY_UNKNOWN 0
+/** Summary matches the map and its stamp equals the monotonic counter. */
+#define LT_R_MEM_MAP_SUMMARY_CURRENT 1
+/** Summary is missing or its stamp differs from the monotonic counter. */
+#define LT_R_MEM_MAP_SUMMARY_STALE 2
+
+/** Magic at the start of the summary. */
+#define LT_R_MEM_MAP_MAGIC "LTRM"
+/** Length of the magic. */
+#define LT_R_MEM_MAP_MAGIC_LEN 4
+/** Summary: magic, stamp and bitmap of occupied slots, all little endian. */
+#define LT_R_MEM_MAP_SUMMARY_LEN (LT_R_MEM_MAP_MAGIC_LEN + 4 + (4 * LT_R_MEM_MAP_WORDS))
+/** Largest R-mem user data slot of all Application FW versions (see lt_tr01_attrs.c), slots are probed into it. */
+#define LT_R_MEM_MAP_PROBE_LEN 475
+
+/** Marks the summary slot as the only known slot, it is reserved and counts as occupied. */
+static void lt_r_mem_map_reset(lt_r_mem_map_t *m)
+{
+    memset(m->known, 0, sizeof(m->known));
+    memset(m->occupied, 0, sizeof(m->occupied));
+    m->known[m->summary_slot / 32] |= 1UL << (m->summary_slot % 32);
+    m->occupied[m->summary_slot / 32] |= 1UL << (m->summary_slot % 32);
+    m->unknown = LT_R_MEM_MAP_SLOTS - 1;
+    m->scan_next = 0;
+    m->loaded = 0;
+    m->summary = LT_R_MEM_MAP_SUMMARY_UNKNOWN;
+}
+
+/** Returns the map attached to the handle, reset first if it belongs to an earlier Secure Session. */
+static lt_r_mem_map_t *lt_r_mem_map_of(lt_handle_t *h)
+{
+    lt_r_mem_map_t *m = h->l3.r_mem_map;
+
+    if (m && (m->session_cnt != h->l3.session_cnt)) {
+        m->session_cnt = h->l3.session_cnt;
+        lt_r_mem_map_reset(m);
+    }
+
+    return m;
+}
+
+/** Tells whether the map is usable: attached to its handle with a Secure Session on. */
+static lt_ret_t lt_r_mem_map_check(const lt_r_mem_map_t *m)
+{
+    if (!m || !m->h || (m->h->l3.r_mem_map != m)) {
+        return LT_PARAM_ERR;
+    }
+    if (m->h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+    lt_r_mem_map_of(m->h);
+
+    return LT_OK;
+}
+
+static bool lt_r_mem_map_known(const lt_r_mem_map_t *m, const uint16_t slot)
+{
+    return (m->known[slot / 32] >> (slot % 32)) & 1;
+}
+
+static bool lt_r_mem_map_occupied(const lt_r_mem_map_t *m, const uint16_t slot)
+{
+    return (m->occupied[slot / 32] >> (slot % 32)) & 1;
+}
+
+static void lt_r_mem_map_put(lt_r_mem_map_t *m, const uint16_t slot, const bool occupied)
+{
+    const uint32_t bit = 1UL << (slot % 32);
+
+    if (!lt_r_mem_map_known(m, slot)) {
+        m->known[slot / 32] |= bit;
+        m->unknown--;
+    }
+    if (occupied) {
+        m->occupied[slot / 32] |= bit;
+    }
+    else {
+        m->occupied[slot / 32] &= ~bit;
+    }
+}
+
+static void lt_r_mem_map_forget(lt_r_mem_map_t *m, const uint16_t slot)
+{
+    const uint32_t bit = 1UL << (slot % 32);
+
+    if (lt_r_mem_map_known(m, slot)) {
+        m->known[slot / 32] &= ~bit;
+        m->occupied[slot / 32] &= ~bit;
+        m->unknown++;
+    }
+}
+
+static void lt_r_mem_map_put_u32(uint8_t *p, const uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t lt_r_mem_map_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+lt_ret_t lt_r_mem_map_before_change(lt_handle_t *h, const uint16_t slot)
+{
+    lt_r_mem_map_t *m = lt_r_mem_map_of(h);
+
+    if (!m || (slot == m->summary_slot) || (m->summary == LT_R_MEM_MAP_SUMMARY_STALE)) {
+        return LT_OK;
+    }
+
+    lt_ret_t ret = lt_mcounter_update(h, (enum lt_mcounter_index_t)m->mcounter_index);
+    if (ret != LT_OK) {
+        // Counter is exhausted or not usable, a missing summary is never current either.
+        ret = lt_r_mem_data_erase(h, m->summary_slot);
+    }
+    if (ret == LT_OK) {
+        m->summary = LT_R_MEM_MAP_SUMMARY_STALE;
+    }
+
+    return ret;
+}
+
+void lt_r_mem_map_merge_write(lt_handle_t *h, const uint16_t slot, const lt_ret_t ret)
+{
+    lt_r_mem_map_t *m = lt_r_mem_map_of(h);
+
+    if (!m || (slot == m->summary_slot)) {
+        return;
+    }
+    if ((ret == LT_OK) || (ret == LT_L3_SLOT_NOT_EMPTY)) {
+        lt_r_mem_map_put(m, slot, true);
+    }
+    else {
+        lt_r_mem_map_forget(m, slot);
+    }
+}
+
+void lt_r_mem_map_merge_read(lt_handle_t *h, const uint16_t slot, const lt_ret_t ret)
+{
+    lt_r_mem_map_t *m = lt_r_mem_map_of(h);
+
+    if (!m || (slot == m->summary_slot)) {
+        return;
+    }
+    if (ret == LT_OK) {
+        lt_r_mem_map_put(m, slot, true);
+    }
+    else if (ret == LT_L3_R_MEM_DATA_READ_SLOT_EMPTY) {
+        lt_r_mem_map_put(m, slot, false);
+    }
+}
+
+void lt_r_mem_map_merge_erase(lt_handle_t *h, const uint16_t slot, const lt_ret_t ret)
+{
+    lt_r_mem_map_t *m = lt_r_mem_map_of(h);
+
+    if (!m) {
+        return;
+    }
+    if (slot == m->summary_slot) {
+        // A missing summary is never current, lt_r_mem_map_flush() writes it again.
+        if (ret == LT_OK) {
+            m->summary = LT_R_MEM_MAP_SUMMARY_STALE;
+        }
+        return;
+    }
+    if (ret == LT_OK) {
+        lt_r_mem_map_put(m, slot, false);
+    }
+    else {
+        lt_r_mem_map_forget(m, slot);
+    }
+}
+
+bool lt_r_mem_map_known_empty(lt_handle_t *h, const uint16_t slot)
+{
+    const lt_r_mem_map_t *m = lt_r_mem_map_of(h);
+
+    return m && lt_r_mem_map_known(m, slot) && !lt_r_mem_map_occupied(m, slot);
+}
+
+/**
+ * @brief Reads the slot by lt_r_mem_data_read(), which merges the result into the map.
+ *
+ * @param m     Occupancy map
+ * @param slot  R-mem slot
+ * @return      LT_OK if the slot is known afterwards, otherwise the error of the read
+ */
+static lt_ret_t lt_r_mem_map_probe(lt_r_mem_map_t *m, const uint16_t slot)
+{
+    uint8_t data[LT_R_MEM_MAP_PROBE_LEN];
+    uint16_t data_len = 0;
+
+    m->probes++;
+    lt_ret_t ret = lt_r_mem_data_read(m->h, slot, data, sizeof(data), &data_len);
+    lt_secure_memzero(data, sizeof(data));
+
+    return lt_r_mem_map_known(m, slot) ? LT_OK : ret;
+}
+
+lt_ret_t lt_r_mem_map_attach(lt_r_mem_map_t *m, lt_handle_t *h, const uint16_t summary_slot,
+                             const enum lt_mcounter_index_t mcounter_index)
+{
+    if (!m || !h || (summary_slot > TR01_R_MEM_DATA_SLOT_MAX) || (mcounter_index > TR01_MCOUNTER_INDEX_15)) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(m, 0, sizeof(lt_r_mem_map_t));
+    m->h = h;
+    m->summary_slot = summary_slot;
+    m->mcounter_index = (uint8_t)mcounter_index;
+    m->session_cnt = h->l3.session_cnt;
+    lt_r_mem_map_reset(m);
+    h->l3.r_mem_map = m;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_r_mem_map_detach(lt_r_mem_map_t *m)
+{
+    if (!m || !m->h) {
+        return LT_PARAM_ERR;
+    }
+
+    if (m->h->l3.r_mem_map == m) {
+        m->h->l3.r_mem_map = NULL;
+    }
+    m->h = NULL;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_r_mem_map_load(lt_r_mem_map_t *m)
+{
+    lt_ret_t ret = lt_r_mem_map_check(m);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    uint8_t summary[LT_R_MEM_MAP_SUMMARY_LEN];
+    uint16_t summary_len = 0;
+    bool current = false;
+
+    ret = lt_r_mem_data_read(m->h, m->summary_slot, summary, sizeof(summary), &summary_len);
+    if ((ret == LT_OK) && (summary_len == LT_R_MEM_MAP_SUMMARY_LEN)
+        && !memcmp(summary, LT_R_MEM_MAP_MAGIC, LT_R_MEM_MAP_MAGIC_LEN)) {
+        uint32_t value;
+        ret = lt_mcounter_get(m->h, (enum lt_mcounter_index_t)m->mcounter_index, &value);
+        if ((ret != LT_OK) && (ret != LT_L3_COUNTER_INVALID)) {
+            return ret;
+        }
+        current = (ret == LT_OK) && (lt_r_mem_map_get_u32(summary + LT_R_MEM_MAP_MAGIC_LEN) == value);
+    }
+    // Foreign data too long for the summary are reported as LT_PARAM_ERR, the slot is still known to be stale.
+    else if ((ret != LT_OK) && (ret != LT_L3_R_MEM_DATA_READ_SLOT_EMPTY) && (ret != LT_PARAM_ERR)) {
+        return ret;
+    }
+
+    m->loaded = 1;
+    if (!current) {
+        // Slots learned in this Secure Session stay known, the rest is left to the scan.
+        m->summary = LT_R_MEM_MAP_SUMMARY_STALE;
+        return LT_OK;
+    }
+
+    for (uint8_t i = 0; i < LT_R_MEM_MAP_WORDS; i++) {
+        m->known[i] = UINT32_MAX;
+        m->occupied[i] = lt_r_mem_map_get_u32(summary + LT_R_MEM_MAP_MAGIC_LEN + 4 + (4 * i));
+    }
+    m->occupied[m->summary_slot / 32] |= 1UL << (m->summary_slot % 32);
+    m->unknown = 0;
+    m->summary = LT_R_MEM_MAP_SUMMARY_CURRENT;
+    m->loads++;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_r_mem_map_scan_step(lt_handle_t *h, void *ctx, bool *done)
+{
+    lt_r_mem_map_t *m = (lt_r_mem_map_t *)ctx;
+
+    if (!h || !m || (m->h != h) || !done) {
+        return LT_PARAM_ERR;
+    }
+    lt_ret_t ret = lt_r_mem_map_check(m);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (!m->loaded) {
+        ret = lt_r_mem_map_load(m);
+        *done = (m->unknown == 0) && (m->summary == LT_R_MEM_MAP_SUMMARY_CURRENT);
+        return ret;
+    }
+
+    if (m->unknown) {
+        uint16_t slot = m->scan_next;
+        while (lt_r_mem_map_known(m, slot)) {
+            slot = (slot == TR01_R_MEM_DATA_SLOT_MAX) ? 0 : (slot + 1);
+        }
+        m->scan_next = (slot == TR01_R_MEM_DATA_SLOT_MAX) ? 0 : (slot + 1);
+        *done = false;
+        return lt_r_mem_map_probe(m, slot);
+    }
+
+    *done = true;
+    return lt_r_mem_map_flush(m);
+}
+
+lt_ret_t lt_r_mem_map_flush(lt_r_mem_map_t *m)
+{
+    lt_ret_t ret = lt_r_mem_map_check(m);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    if (m->unknown) {
+        return LT_FAIL;
+    }
+    if (m->summary == LT_R_MEM_MAP_SUMMARY_CURRENT) {
+        return LT_OK;
+    }
+
+    uint32_t value;
+    ret = lt_mcounter_get(m->h, (enum lt_mcounter_index_t)m->mcounter_index, &value);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    uint8_t summary[LT_R_MEM_MAP_SUMMARY_LEN];
+    memcpy(summary, LT_R_MEM_MAP_MAGIC, LT_R_MEM_MAP_MAGIC_LEN);
+    lt_r_mem_map_put_u32(summary + LT_R_MEM_MAP_MAGIC_LEN, value);
+    for (uint8_t i = 0; i < LT_R_MEM_MAP_WORDS; i++) {
+        lt_r_mem_map_put_u32(summary + LT_R_MEM_MAP_MAGIC_LEN + 4 + (4 * i), m->occupied[i]);
+    }
+
+    ret = lt_r_mem_data_erase(m->h, m->summary_slot);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_r_mem_data_write(m->h, m->summary_slot, summary, sizeof(summary));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    m->loaded = 1;
+    m->summary = LT_R_MEM_MAP_SUMMARY_CURRENT;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_r_mem_map_is_occupied(lt_r_mem_map_t *m, const uint16_t udata_slot, bool *occupied)
+{
+    if (!occupied || (udata_slot > TR01_R_MEM_DATA_SLOT_MAX)) {
+        return LT_PARAM_ERR;
+    }
+    lt_ret_t ret = lt_r_mem_map_check(m);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (!lt_r_mem_map_known(m, udata_slot)) {
+        ret = lt_r_mem_map_probe(m, udata_slot);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+    *occupied = lt_r_mem_map_occupied(m, udata_slot);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_r_mem_map_find_free(lt_r_mem_map_t *m, const uint16_t first, uint16_t *udata_slot)
+{
+    if (!udata_slot || (first > TR01_R_MEM_DATA_SLOT_MAX)) {
+        return LT_PARAM_ERR;
+    }
+    lt_ret_t ret = lt_r_mem_map_check(m);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    for (uint16_t slot = first; slot <= TR01_R_MEM_DATA_SLOT_MAX; slot++) {
+        // Unknown slots are read in order, only until the first empty one.
+        if (!lt_r_mem_map_known(m, slot)) {
+            ret = lt_r_mem_map_probe(m, slot);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+        if (!lt_r_mem_map_occupied(m, slot)) {
+            *udata_slot = slot;
+            return LT_OK;
+        }
+    }
+
+    return LT_FAIL;
+}
@@ -0,0 +1,76 @@
+#ifndef LT_R_MEM_MAP_H
+#define LT_R_MEM_MAP_H
+
+/**
+ * @file lt_r_mem_map.h
+ * @brief R-mem occupancy map declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_R_MEM_MAP
+/**
+ * @brief Makes the summary of the map attached to the handle stale before the slot is changed, by decrementing the
+ * monotonic counter (or erasing the summary if the counter can not be decremented). Sends nothing if no map is
+ * attached, the slot is the summary slot or the summary is known to be stale already.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  R-mem slot about to be written or erased
+ * @return      LT_OK if the slot may be changed, otherwise the change must not be sent
+ */
+lt_ret_t lt_r_mem_map_before_change(lt_handle_t *h, const uint16_t slot);
+
+/**
+ * @brief Merges result of R_Mem_Data_Write into the map: on success or LT_L3_SLOT_NOT_EMPTY the slot holds data,
+ * otherwise its occupancy is forgotten.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  R-mem slot
+ * @param ret   Result of the write
+ */
+void lt_r_mem_map_merge_write(lt_handle_t *h, const uint16_t slot, const lt_ret_t ret);
+
+/**
+ * @brief Merges result of R_Mem_Data_Read into the map: on success the slot holds data,
+ * LT_L3_R_MEM_DATA_READ_SLOT_EMPTY means it is empty, other results change nothing.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  R-mem slot
+ * @param ret   Result of the read
+ */
+void lt_r_mem_map_merge_read(lt_handle_t *h, const uint16_t slot, const lt_ret_t ret);
+
+/**
+ * @brief Merges result of R_Mem_Data_Erase into the map: on success the slot is empty, otherwise its occupancy is
+ * forgotten. Erased summary makes the summary stale.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  R-mem slot
+ * @param ret   Result of the erase
+ */
+void lt_r_mem_map_merge_erase(lt_handle_t *h, const uint16_t slot, const lt_ret_t ret);
+
+/**
+ * @brief Tells whether the map attached to the handle knows the slot to be empty. The summary slot never is.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param slot  R-mem slot
+ * @return      true if a map is attached and the slot is known to hold no data
+ */
+bool lt_r_mem_map_known_empty(lt_handle_t *h, const uint16_t slot);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_R_MEM_MAP_H
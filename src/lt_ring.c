@@ -0,0 +1,164 @@
+/**
+ * @file lt_ring.c
+ * @brief Lock-free submission and completion rings definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+LT_STATIC_ASSERT((LT_RING_CACHE_LINE >= 4) && !(LT_RING_CACHE_LINE & (LT_RING_CACHE_LINE - 1)))
+
+/** Tells whether the capacity is a power of two which keeps free running positions unambiguous. */
+static bool lt_ring_cap_valid(const uint32_t cap) { return (cap >= 2) && (cap <= (1U << 31)) && !(cap & (cap - 1)); }
+
+lt_ret_t lt_mpsc_ring_init(lt_mpsc_ring_t *ring, lt_mpsc_slot_t *slots, const uint32_t cap)
+{
+    if (!ring || !slots || !lt_ring_cap_valid(cap)) {
+        return LT_PARAM_ERR;
+    }
+
+    ring->enq_pos = 0;
+    ring->deq_pos = 0;
+    ring->slots = slots;
+    ring->mask = cap - 1;
+    // Slot i is free for the push at position i.
+    for (uint32_t i = 0; i < cap; i++) {
+        slots[i].seq = i;
+        slots[i].item = NULL;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_mpsc_ring_push(lt_mpsc_ring_t *ring, void *item)
+{
+    if (!ring || !item) {
+        return LT_PARAM_ERR;
+    }
+
+    uint32_t pos = __atomic_load_n(&ring->enq_pos, __ATOMIC_RELAXED);
+    lt_mpsc_slot_t *slot;
+
+    for (;;) {
+        slot = &ring->slots[pos & ring->mask];
+        int32_t dif = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+        if (dif == 0) {
+            // The slot is ours once the position is claimed, a failed claim reloads the position.
+            if (__atomic_compare_exchange_n(&ring->enq_pos, &pos, pos + 1, true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        }
+        else if (dif < 0) {
+            // The slot still holds the item of the previous round.
+            return LT_RING_FULL;
+        }
+        else {
+            pos = __atomic_load_n(&ring->enq_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->item = item;
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+
+    return LT_OK;
+}
+
+void *lt_mpsc_ring_pop(lt_mpsc_ring_t *ring)
+{
+    if (!ring) {
+        return NULL;
+    }
+
+    const uint32_t pos = ring->deq_pos;
+    lt_mpsc_slot_t *slot = &ring->slots[pos & ring->mask];
+    if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos + 1) {
+        return NULL;
+    }
+
+    void *item = slot->item;
+    // Free for the push one round later.
+    __atomic_store_n(&slot->seq, pos + ring->mask + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->deq_pos, pos + 1, __ATOMIC_RELAXED);
+
+    return item;
+}
+
+uint32_t lt_mpsc_ring_count(const lt_mpsc_ring_t *ring)
+{
+    if (!ring) {
+        return 0;
+    }
+
+    const uint32_t deq_pos = __atomic_load_n(&ring->deq_pos, __ATOMIC_RELAXED);
+    const uint32_t enq_pos = __atomic_load_n(&ring->enq_pos, __ATOMIC_RELAXED);
+
+    return lt_min(enq_pos - deq_pos, ring->mask + 1);
+}
+
+lt_ret_t lt_spsc_ring_init(lt_spsc_ring_t *ring, void **items, const uint32_t cap)
+{
+    if (!ring || !items || !lt_ring_cap_valid(cap)) {
+        return LT_PARAM_ERR;
+    }
+
+    ring->head = 0;
+    ring->tail = 0;
+    ring->items = items;
+    ring->mask = cap - 1;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_spsc_ring_push(lt_spsc_ring_t *ring, void *item)
+{
+    if (!ring || !item) {
+        return LT_PARAM_ERR;
+    }
+
+    // Head is written only by the producer, tail only by the consumer.
+    const uint32_t head = ring->head;
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) > ring->mask) {
+        return LT_RING_FULL;
+    }
+
+    ring->items[head & ring->mask] = item;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+    return LT_OK;
+}
+
+void *lt_spsc_ring_pop(lt_spsc_ring_t *ring)
+{
+    if (!ring) {
+        return NULL;
+    }
+
+    const uint32_t tail = ring->tail;
+    if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail) {
+        return NULL;
+    }
+
+    void *item = ring->items[tail & ring->mask];
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+
+    return item;
+}
+
+uint32_t lt_spsc_ring_count(const lt_spsc_ring_t *ring)
+{
+    if (!ring) {
+        return 0;
+    }
+
+    const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file lt_sched.c
+ * @brief Scheduler of jobs in priority classes for one TROPIC01, bulk jobs are executed step by step
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+LT_STATIC_ASSERT((LT_SCHED_QUEUE_LEN >= 1) && (LT_SCHED_QUEUE_LEN <= 255))
+
+lt_ret_t lt_sched_init(lt_sched_t *s, lt_handle_t *h)
+{
+    if (!s || !h) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(s, 0, sizeof(*s));
+    s->h = h;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sched_submit(lt_sched_t *s, const lt_sched_prio_t prio, lt_sched_fn_t fn, void *ctx, lt_ret_t *ret)
+{
+    if (!s || (prio >= LT_SCHED_PRIOS) || !fn) {
+        return LT_PARAM_ERR;
+    }
+    if (s->queue_cnt >= LT_SCHED_QUEUE_LEN) {
+        return LT_FAIL;
+    }
+
+    lt_sched_job_t *job = &s->queue[s->queue_cnt++];
+    job->fn = fn;
+    job->ctx = ctx;
+    job->ret = ret;
+    job->prio = (uint8_t)prio;
+    job->started = 0;
+
+    return LT_OK;
+}
+
+/**
+ * @brief Picks the next job: the oldest one of the highest priority class, so jobs of one class keep their order.
+ *
+ * @param s  Scheduler with non-empty queue
+ * @return   Index of the job in the queue
+ */
+static uint8_t lt_sched_next(const lt_sched_t *s)
+{
+    uint8_t next = 0;
+    for (uint8_t i = 1; i < s->queue_cnt; i++) {
+        if (s->queue[i].prio < s->queue[next].prio) {
+            next = i;
+        }
+    }
+
+    return next;
+}
+
+lt_ret_t lt_sched_step(lt_sched_t *s)
+{
+    if (!s) {
+        return LT_PARAM_ERR;
+    }
+    if (s->queue_cnt == 0) {
+        return LT_FAIL;
+    }
+
+    uint8_t i = lt_sched_next(s);
+    if (!s->queue[i].started) {
+        for (uint8_t j = 0; j < s->queue_cnt; j++) {
+            if (s->queue[j].started) {
+                s->stats.preemptions++;
+                break;
+            }
+        }
+    }
+
+    // The step may submit further jobs, they are appended and do not move this one.
+    lt_sched_job_t job = s->queue[i];
+    s->queue[i].started = 1;
+    bool done = true;
+    lt_ret_t ret = job.fn(s->h, job.ctx, &done);
+    s->stats.steps++;
+
+    if (done || (ret != LT_OK)) {
+        s->queue_cnt--;
+        memmove(&s->queue[i], &s->queue[i + 1], (size_t)(s->queue_cnt - i) * sizeof(s->queue[0]));
+        s->stats.jobs[job.prio]++;
+        if (job.ret) {
+            *job.ret = ret;
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sched_run(lt_sched_t *s)
+{
+    if (!s) {
+        return LT_PARAM_ERR;
+    }
+
+    while (s->queue_cnt) {
+        lt_ret_t ret = lt_sched_step(s);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return LT_OK;
+}
+
+uint8_t lt_sched_pending(const lt_sched_t *s) { return s ? s->queue_cnt : 0; }
+
+lt_ret_t lt_sched_get_stats(const lt_sched_t *s, lt_sched_stats_t *stats)
+{
+    if (!s || !stats) {
+        return LT_PARAM_ERR;
+    }
+
+    *stats = s->stats;
+
+    return LT_OK;
+}
@@ -9,6 +9,7 @@
 #include "lt_secure_memzero.h"
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 // explicit_bzero() may be declared in strings.h, so include it if it's available.
 #ifdef LT_HAVE_STRINGS_H
@@ -46,11 +47,38 @@ void lt_secure_memzero(void *const ptr, const size_t count)
     }
 
 #else
-#warning Zeroing of the memory is done using volatile pointers, which may not be safe.
+#warning Zeroing of the memory is done using volatile pointers and a compiler barrier, which may not be safe.
 
-    volatile unsigned char *volatile _ptr = (volatile unsigned char *volatile)ptr;
-    for (size_t i = 0U; i < count; i++) {
-        _ptr[i] = 0U;
+    // Bytes up to word alignment, then words by four and the remaining words and bytes. Volatile writes cannot be
+    // dropped, word-wide ones take a fraction of the cycles on the ~4 kB L3 buffer.
+    volatile unsigned char *_ptr = (volatile unsigned char *)ptr;
+    size_t n = count;
+    while (n && ((uintptr_t)_ptr & (sizeof(uintptr_t) - 1U))) {
+        *_ptr++ = 0U;
+        n--;
     }
+
+    // Aligned above, casting through void * keeps -Wcast-align quiet.
+    volatile uintptr_t *_word = (volatile uintptr_t *)(volatile void *)_ptr;
+    for (; n >= 4U * sizeof(uintptr_t); n -= 4U * sizeof(uintptr_t)) {
+        _word[0] = 0U;
+        _word[1] = 0U;
+        _word[2] = 0U;
+        _word[3] = 0U;
+        _word += 4;
+    }
+    for (; n >= sizeof(uintptr_t); n -= sizeof(uintptr_t)) {
+        *_word++ = 0U;
+    }
+
+    _ptr = (volatile unsigned char *)_word;
+    while (n--) {
+        *_ptr++ = 0U;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    // Compiler barrier, the memory is treated as read afterwards, so no write above can be considered dead.
+    __asm__ __volatile__("" : : "r"(ptr) : "memory");
+#endif
 #endif
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * @file lt_session_cache_eph.c
+ * @brief Ring of ephemeral key pairs prepared in a session cache definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_session_cache_eph.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "lt_port_wrap.h"
+#include "lt_secure_memzero.h"
+#include "lt_x25519.h"
+
+// Free running uint8_t counters are mapped to slots by modulo, which has to stay consistent when they wrap.
+LT_STATIC_ASSERT((LT_SESSION_CACHE_EPH_KEYS > 0) && (LT_SESSION_CACHE_EPH_KEYS <= 128)
+                 && ((LT_SESSION_CACHE_EPH_KEYS & (LT_SESSION_CACHE_EPH_KEYS - 1)) == 0))
+
+// The producer and the consumer may run in different tasks, head is written only by the producer and tail
+// only by the consumer. Acquire/release ordering makes the slot contents visible before the counter.
+
+uint8_t lt_session_cache_eph_count(const lt_session_cache_t *cache)
+{
+    uint8_t head = __atomic_load_n(&cache->eph_head, __ATOMIC_ACQUIRE);
+    uint8_t tail = __atomic_load_n(&cache->eph_tail, __ATOMIC_ACQUIRE);
+
+    return (uint8_t)(head - tail);
+}
+
+lt_session_eph_t *lt_session_cache_eph_slot(lt_session_cache_t *cache)
+{
+    if (lt_session_cache_eph_count(cache) >= LT_SESSION_CACHE_EPH_KEYS) {
+        return NULL;
+    }
+
+    return &cache->eph[cache->eph_head % LT_SESSION_CACHE_EPH_KEYS];
+}
+
+void lt_session_cache_eph_publish(lt_session_cache_t *cache)
+{
+    __atomic_store_n(&cache->eph_head, (uint8_t)(cache->eph_head + 1), __ATOMIC_RELEASE);
+}
+
+bool lt_session_cache_eph_take(lt_session_cache_t *cache, lt_session_eph_t *eph)
+{
+    if (lt_session_cache_eph_count(cache) == 0) {
+        return false;
+    }
+
+    lt_session_eph_t *slot = &cache->eph[cache->eph_tail % LT_SESSION_CACHE_EPH_KEYS];
+    memcpy(eph, slot, sizeof(*eph));
+    lt_secure_memzero(slot, sizeof(*slot));
+    __atomic_store_n(&cache->eph_tail, (uint8_t)(cache->eph_tail + 1), __ATOMIC_RELEASE);
+
+    return true;
+}
+
+lt_ret_t lt_session_cache_eph_gen(lt_handle_t *h, const lt_session_cache_t *cache, lt_session_eph_t *eph)
+{
+    // Create ephemeral host keys
+    lt_ret_t ret = lt_random_bytes(h, eph->keys.ehpriv, sizeof(eph->keys.ehpriv));
+    if (ret == LT_OK) {
+        ret = lt_X25519_scalarmult(eph->keys.ehpriv, eph->keys.ehpub);
+    }
+    // X25519(EHPRIV, STPUB) does not depend on TROPIC01's ephemeral key
+    if (ret == LT_OK) {
+        ret = lt_X25519(eph->keys.ehpriv, cache->stpub, eph->eh_st_shared);
+    }
+    if (ret != LT_OK) {
+        lt_secure_memzero(eph, sizeof(*eph));
+    }
+
+    return ret;
+}
+
+void lt_session_cache_eph_drop(lt_session_cache_t *cache)
+{
+    lt_secure_memzero(&cache->eph_cur, sizeof(cache->eph_cur));
+    cache->eph_in_use = false;
+}
@@ -0,0 +1,78 @@
+#ifndef LT_SESSION_CACHE_EPH_H
+#define LT_SESSION_CACHE_EPH_H
+
+/**
+ * @file lt_session_cache_eph.h
+ * @brief Ring of ephemeral key pairs prepared in a session cache declarations (used internally)
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Returns number of key pairs prepared in the session cache.
+ *
+ * @param cache   Session cache
+ * @return        Number of key pairs
+ */
+uint8_t lt_session_cache_eph_count(const lt_session_cache_t *cache);
+
+/**
+ * @brief Returns slot for the next key pair, the key pair becomes available by lt_session_cache_eph_publish().
+ * @note Called only by the producer (lt_session_cache_prepare()).
+ *
+ * @param cache   Session cache
+ * @return        Free slot, NULL if all key pairs are prepared
+ */
+lt_session_eph_t *lt_session_cache_eph_slot(lt_session_cache_t *cache);
+
+/**
+ * @brief Makes the key pair written into lt_session_cache_eph_slot() available.
+ * @note Called only by the producer (lt_session_cache_prepare()).
+ *
+ * @param cache   Session cache
+ */
+void lt_session_cache_eph_publish(lt_session_cache_t *cache);
+
+/**
+ * @brief Takes the oldest prepared key pair out of the session cache and wipes its slot.
+ * @note Called only by the consumer (the handshake).
+ *
+ * @param cache   Session cache
+ * @param eph     Key pair is returned here
+ * @return        true if a key pair was taken, false if none is prepared
+ */
+bool lt_session_cache_eph_take(lt_session_cache_t *cache, lt_session_eph_t *eph);
+
+/**
+ * @brief Generates ephemeral key pair and its X25519 with STPUB of the session cache.
+ *
+ * @param h       Handle for communication with TROPIC01
+ * @param cache   Session cache
+ * @param eph     Key pair is returned here, wiped on failure
+ * @return        LT_OK if success, otherwise returns other error code.
+ */
+lt_ret_t lt_session_cache_eph_gen(lt_handle_t *h, const lt_session_cache_t *cache, lt_session_eph_t *eph)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Wipes the key pair of the session cache sent in Handshake_Req, e.g. of an abandoned handshake.
+ *
+ * @param cache   Session cache
+ */
+void lt_session_cache_eph_drop(lt_session_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_SESSION_CACHE_EPH_H
@@ -0,0 +1,140 @@
+/**
+ * @file lt_session_export.c
+ * @brief Export and import of a live Secure Session definitions
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "lt_aesgcm.h"
+#include "lt_l3_process.h"
+#include "lt_port_wrap.h"
+#include "lt_secure_memzero.h"
+
+/** Header of the blob authenticated together with the sealed state. */
+#define LT_SESSION_BLOB_HDR_LEN offsetof(lt_session_blob_t, iv)
+
+/** Offsets of the parts of the sealed state. */
+#define LT_SESSION_STATE_ENC_IV 0
+#define LT_SESSION_STATE_DEC_IV (LT_SESSION_STATE_ENC_IV + TR01_L3_IV_SIZE)
+#define LT_SESSION_STATE_KCMD (LT_SESSION_STATE_DEC_IV + TR01_L3_IV_SIZE)
+#define LT_SESSION_STATE_KRES (LT_SESSION_STATE_KCMD + TR01_AES256_KEY_LEN)
+
+lt_ret_t lt_session_export(lt_handle_t *h, const uint8_t *wrap_key, lt_session_blob_t *blob)
+{
+    if (!h || !wrap_key || !blob) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+#ifdef LT_SUBMIT
+    // The nonce of the L3 Result in flight would be consumed by both processes.
+    if (h->l3.submitted) {
+        return LT_FAIL;
+    }
+#endif
+
+    uint8_t state[LT_SESSION_BLOB_STATE_LEN];
+    memcpy(&state[LT_SESSION_STATE_ENC_IV], h->l3.encryption_IV, TR01_L3_IV_SIZE);
+    memcpy(&state[LT_SESSION_STATE_DEC_IV], h->l3.decryption_IV, TR01_L3_IV_SIZE);
+    memcpy(&state[LT_SESSION_STATE_KCMD], h->l3.session_keys[0], TR01_AES256_KEY_LEN);
+    memcpy(&state[LT_SESSION_STATE_KRES], h->l3.session_keys[1], TR01_AES256_KEY_LEN);
+
+    // From now on the blob is the only owner of the nonces, TROPIC01 keeps the session.
+    lt_l3_invalidate_host_session_data(&h->l3);
+
+    memset(blob, 0, sizeof(lt_session_blob_t));
+    blob->magic = LT_SESSION_BLOB_MAGIC;
+    blob->version = LT_SESSION_BLOB_VERSION;
+
+    lt_ret_t ret = lt_random_bytes(h, blob->iv, sizeof(blob->iv));
+    if (ret != LT_OK) {
+        goto cleanup;
+    }
+
+    ret = lt_aesgcm_encrypt_init(h->l3.crypto_ctx, wrap_key, LT_SESSION_WRAP_KEY_LEN);
+    if (ret != LT_OK) {
+        goto cleanup;
+    }
+    ret = lt_aesgcm_encrypt(h->l3.crypto_ctx, blob->iv, sizeof(blob->iv), (const uint8_t *)blob,
+                            LT_SESSION_BLOB_HDR_LEN, state, sizeof(state), blob->sealed, sizeof(blob->sealed));
+    lt_ret_t ret_deinit = lt_aesgcm_encrypt_deinit(h->l3.crypto_ctx);
+    if (ret == LT_OK) {
+        ret = ret_deinit;
+    }
+
+cleanup:
+    lt_secure_memzero(state, sizeof(state));
+    if (ret != LT_OK) {
+        lt_secure_memzero(blob, sizeof(lt_session_blob_t));
+    }
+
+    return ret;
+}
+
+lt_ret_t lt_session_import(lt_handle_t *h, const uint8_t *wrap_key, lt_session_blob_t *blob)
+{
+    if (!h || !wrap_key || !blob) {
+        return LT_PARAM_ERR;
+    }
+    if ((blob->magic != LT_SESSION_BLOB_MAGIC) || (blob->version != LT_SESSION_BLOB_VERSION)) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_l3_invalidate_host_session_data(&h->l3);
+
+    uint8_t state[LT_SESSION_BLOB_STATE_LEN];
+    lt_ret_t ret = lt_aesgcm_decrypt_init(h->l3.crypto_ctx, wrap_key, LT_SESSION_WRAP_KEY_LEN);
+    if (ret != LT_OK) {
+        goto cleanup;
+    }
+    ret = lt_aesgcm_decrypt(h->l3.crypto_ctx, blob->iv, sizeof(blob->iv), (const uint8_t *)blob,
+                            LT_SESSION_BLOB_HDR_LEN, blob->sealed, sizeof(blob->sealed), state, sizeof(state));
+    lt_ret_t ret_deinit = lt_aesgcm_decrypt_deinit(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        ret = LT_CRYPTO_ERR;
+        goto cleanup;
+    }
+    if (ret_deinit != LT_OK) {
+        ret = ret_deinit;
+        goto cleanup;
+    }
+
+    ret = lt_aesgcm_encrypt_init(h->l3.crypto_ctx, &state[LT_SESSION_STATE_KCMD], TR01_AES256_KEY_LEN);
+    if (ret != LT_OK) {
+        goto cleanup;
+    }
+    ret = lt_aesgcm_decrypt_init(h->l3.crypto_ctx, &state[LT_SESSION_STATE_KRES], TR01_AES256_KEY_LEN);
+    if (ret != LT_OK) {
+        goto cleanup;
+    }
+
+    memcpy(h->l3.encryption_IV, &state[LT_SESSION_STATE_ENC_IV], TR01_L3_IV_SIZE);
+    memcpy(h->l3.decryption_IV, &state[LT_SESSION_STATE_DEC_IV], TR01_L3_IV_SIZE);
+    memcpy(h->l3.session_keys[0], &state[LT_SESSION_STATE_KCMD], TR01_AES256_KEY_LEN);
+    memcpy(h->l3.session_keys[1], &state[LT_SESSION_STATE_KRES], TR01_AES256_KEY_LEN);
+    h->l3.session_status = LT_SECURE_SESSION_ON;
+#if defined(LT_PIN) || defined(LT_MCOUNTER_CACHE) || defined(LT_ECC_INVENTORY) || defined(LT_R_MEM_MAP) \
+    || defined(LT_PAIRING_PUB_CACHE) || defined(LT_EDDSA_SIG_CACHE)
+    // Data cached for the session of the exporting process are not in the handle.
+    h->l3.session_cnt++;
+#endif
+
+    // Consumed, the same buffer cannot be imported again.
+    lt_secure_memzero(blob, sizeof(lt_session_blob_t));
+
+cleanup:
+    lt_secure_memzero(state, sizeof(state));
+    if (ret != LT_OK) {
+        lt_l3_invalidate_host_session_data(&h->l3);
+    }
+
+    return ret;
+}
@@ -0,0 +1,612 @@
+/**
+ * @file lt_sign_queue.c
+ * @brief Queue of ECDSA signing jobs executed by a pool of TROPIC01 devices
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_macros.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_port_wrap.h"
+
+#ifndef LT_L2_ASYNC
+#error "LT_SIGN_QUEUE requires LT_L2_ASYNC"
+#endif
+
+LT_STATIC_ASSERT(LT_SIGN_QUEUE_BUFF_LEN >= sizeof(struct lt_l3_ecdsa_sign_res_t) + TR01_L3_TAG_SIZE)
+LT_STATIC_ASSERT(LT_SIGN_QUEUE_BUFF_LEN >= sizeof(struct lt_l3_ecdsa_sign_cmd_t) + TR01_L3_TAG_SIZE)
+LT_STATIC_ASSERT(LT_SIGN_QUEUE_DIGEST_LEN == LT_MEMBER_SIZE(struct lt_l3_ecdsa_sign_cmd_t, msg_hash))
+LT_STATIC_ASSERT((LT_SIGN_QUEUE_LEN >= 1) && (LT_SIGN_QUEUE_LEN <= 255))
+
+static void lt_sign_queue_dispatch(lt_sign_queue_t *q);
+
+/** Puts job back in front of the waiting jobs, there is always room as the pending jobs are limited. */
+static void lt_sign_queue_push_front(lt_sign_queue_t *q, const lt_sign_job_t *job)
+{
+    q->head = (uint8_t)((q->head + LT_SIGN_QUEUE_LEN - 1) % LT_SIGN_QUEUE_LEN);
+    q->jobs[q->head] = *job;
+    q->cnt++;
+}
+
+static void lt_sign_queue_pop(lt_sign_queue_t *q, lt_sign_job_t *job)
+{
+    *job = q->jobs[q->head];
+    q->head = (uint8_t)((q->head + 1) % LT_SIGN_QUEUE_LEN);
+    q->cnt--;
+}
+
+static bool lt_sign_queue_dev_usable(const lt_sign_queue_dev_t *dev)
+{
+#ifdef LT_CRYPTO_WORKER
+    // Session state belongs to the crypto worker while it has a work.
+    if (dev->failed || dev->work_busy) {
+        return !dev->failed;
+    }
+#endif
+    return dev->h->l3.session_status == LT_SECURE_SESSION_ON;
+}
+
+/**
+ * @brief Drops Secure Session of the device after a failed transfer: TROPIC01 state is unknown and the command
+ * encrypted ahead would not match its nonce anymore. The job encrypted ahead goes back to the queue.
+ */
+static void lt_sign_queue_dev_fail(lt_sign_queue_dev_t *dev)
+{
+    lt_l3_invalidate_host_session_data(&dev->h->l3);
+    if (dev->cnt) {
+        lt_sign_queue_push_front(dev->q, &dev->jobs[dev->cur]);
+        dev->cnt = 0;
+    }
+}
+
+static void lt_sign_queue_done(lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx);
+
+/** Sends the packet encrypted ahead, on failure its job finishes with the error. */
+static void lt_sign_queue_start(lt_sign_queue_dev_t *dev)
+{
+    lt_ret_t ret = lt_l2_async_send_encrypted_cmd(dev->op, &dev->h->l2, dev->buff[dev->cur], LT_SIGN_QUEUE_BUFF_LEN,
+                                                  lt_sign_queue_done, dev);
+    if (ret != LT_OK) {
+        lt_sign_job_t job = dev->jobs[dev->cur];
+        dev->cnt = 0;
+        lt_l3_invalidate_host_session_data(&dev->h->l3);
+        job.cb(ret, NULL, job.cb_ctx);
+    }
+}
+
+/** Writes plaintext ECDSA_Sign L3 Command of the job into the packet. */
+static void lt_sign_queue_fill(uint8_t *buff, const lt_sign_job_t *job)
+{
+    struct lt_l3_ecdsa_sign_cmd_t *p_l3_cmd = (struct lt_l3_ecdsa_sign_cmd_t *)buff;
+
+    p_l3_cmd->cmd_size = TR01_L3_ECDSA_SIGN_CMD_SIZE;
+    p_l3_cmd->cmd_id = TR01_L3_ECDSA_SIGN_CMD_ID;
+    p_l3_cmd->slot = job->slot;
+    memset(p_l3_cmd->padding, 0, sizeof(p_l3_cmd->padding));
+    memcpy(p_l3_cmd->msg_hash, job->digest, sizeof(p_l3_cmd->msg_hash));
+}
+
+/**
+ * @brief Copies signature out of the decrypted L3 Result.
+ *
+ * @return LT_OK, or LT_L3_RES_SIZE_ERROR if the result has wrong size, its Secure Session is then invalidated
+ */
+static lt_ret_t lt_sign_queue_signature(lt_sign_queue_dev_t *dev, const uint8_t *buff, uint8_t *rs)
+{
+    const struct lt_l3_ecdsa_sign_res_t *p_l3_res = (const struct lt_l3_ecdsa_sign_res_t *)buff;
+
+    if (p_l3_res->res_size != TR01_L3_ECDSA_SIGN_RES_SIZE) {
+        lt_l3_invalidate_host_session_data(&dev->h->l3);
+        return LT_L3_RES_SIZE_ERROR;
+    }
+    memcpy(rs, p_l3_res->r, sizeof(p_l3_res->r));
+    memcpy(rs + sizeof(p_l3_res->r), p_l3_res->s, sizeof(p_l3_res->s));
+
+    return LT_OK;
+}
+
+#ifdef LT_CRYPTO_WORKER
+/*
+ * With a crypto worker, each packet goes through the states below in the order the jobs were staged: encryption,
+ * sending and decryption each follow their own index (seal, cur, open), so nonces are used in order. The worker owns
+ * the L3 state of the device while it has a work, the I/O thread meanwhile only transfers the other packet.
+ */
+/** Packet is unused. */
+#define LT_SIGN_QUEUE_PKT_FREE 0
+/** Plaintext L3 Command waits for encryption. */
+#define LT_SIGN_QUEUE_PKT_PLAIN 1
+/** Encrypted L3 Command waits for sending. */
+#define LT_SIGN_QUEUE_PKT_SEALED 2
+/** L3 Command is executed by TROPIC01. */
+#define LT_SIGN_QUEUE_PKT_SENT 3
+/** Encrypted L3 Result waits for decryption. */
+#define LT_SIGN_QUEUE_PKT_RESULT 4
+/** Transfer failed, the job finishes with pkt_ret. */
+#define LT_SIGN_QUEUE_PKT_FAILED 5
+
+void lt_crypto_work_run(lt_crypto_work_t *work)
+{
+    if (work->decrypt) {
+        work->ret = lt_l3_decrypt_response_buff(work->s3, work->buff, work->buff_len);
+    }
+    else {
+        work->ret = lt_l3_encrypt_request_buff(work->s3, work->buff);
+    }
+
+    __atomic_store_n(&work->done, 1, __ATOMIC_RELEASE);
+}
+
+/** Hands encryption or decryption of the packet to the crypto worker, runs it here if the worker refuses it. */
+static void lt_sign_queue_work_submit(lt_sign_queue_dev_t *dev, const uint8_t idx, const bool decrypt)
+{
+    lt_crypto_work_t *work = &dev->work;
+
+    work->s3 = &dev->h->l3;
+    work->buff = dev->buff[idx];
+    work->buff_len = LT_SIGN_QUEUE_BUFF_LEN;
+    work->decrypt = decrypt;
+    work->ret = LT_FAIL;
+    __atomic_store_n(&work->done, 0, __ATOMIC_RELAXED);
+    dev->work_busy = true;
+
+    if (dev->q->worker(dev->q->worker_ctx, work) != LT_OK) {
+        lt_crypto_work_run(work);
+    }
+}
+
+/**
+ * @brief Sends the next encrypted packet if the device is idle, then hands the next packet to the crypto worker,
+ * L3 Results first as they finish jobs. Never calls callbacks of the jobs.
+ */
+static void lt_sign_queue_dev_kick(lt_sign_queue_dev_t *dev)
+{
+    if (dev->failed) {
+        return;
+    }
+
+    if ((dev->pkt[dev->cur] == LT_SIGN_QUEUE_PKT_SEALED) && !lt_l2_async_busy(dev->op)) {
+        lt_ret_t ret = lt_l2_async_send_encrypted_cmd(dev->op, &dev->h->l2, dev->buff[dev->cur],
+                                                      LT_SIGN_QUEUE_BUFF_LEN, lt_sign_queue_done, dev);
+        if (ret == LT_OK) {
+            dev->pkt[dev->cur] = LT_SIGN_QUEUE_PKT_SENT;
+        }
+        else {
+            dev->pkt[dev->cur] = LT_SIGN_QUEUE_PKT_FAILED;
+            dev->pkt_ret[dev->cur] = ret;
+            dev->failed = true;
+            return;
+        }
+    }
+
+    if (dev->work_busy) {
+        return;
+    }
+    if (dev->pkt[dev->open] == LT_SIGN_QUEUE_PKT_RESULT) {
+        if (dev->h->l3.session_status != LT_SECURE_SESSION_ON) {
+            // Session was lost while the command was executed.
+            dev->failed = true;
+            return;
+        }
+        lt_sign_queue_work_submit(dev, dev->open, true);
+    }
+    else if (dev->pkt[dev->seal] == LT_SIGN_QUEUE_PKT_PLAIN) {
+        lt_sign_queue_work_submit(dev, dev->seal, false);
+    }
+}
+
+/** Stages plaintext ECDSA_Sign of the job into the free packet of the device, encrypted by the crypto worker. */
+static void lt_sign_queue_stage_plain(lt_sign_queue_dev_t *dev, const lt_sign_job_t *job)
+{
+    uint8_t idx = dev->tail;
+
+    lt_sign_queue_fill(dev->buff[idx], job);
+    dev->jobs[idx] = *job;
+    dev->pkt[idx] = LT_SIGN_QUEUE_PKT_PLAIN;
+    dev->tail ^= 1;
+    dev->cnt++;
+
+    lt_sign_queue_dev_kick(dev);
+}
+
+/**
+ * @brief Takes all jobs off the failed device once the worker is done: jobs not sent yet go back to the queue, the
+ * others finish with an error. Its Secure Session is invalidated.
+ */
+static void lt_sign_queue_dev_drain(lt_sign_queue_dev_t *dev)
+{
+    lt_sign_job_t finished[2];
+    lt_ret_t rets[2];
+    uint8_t finished_cnt = 0;
+
+    lt_l3_invalidate_host_session_data(&dev->h->l3);
+
+    // Newer job first, so the older one ends up in front of the queue.
+    for (uint8_t i = 0; i < 2; i++) {
+        uint8_t idx = dev->open ^ 1 ^ i;
+        switch (dev->pkt[idx]) {
+            case LT_SIGN_QUEUE_PKT_PLAIN:
+            case LT_SIGN_QUEUE_PKT_SEALED:
+                lt_sign_queue_push_front(dev->q, &dev->jobs[idx]);
+                break;
+            case LT_SIGN_QUEUE_PKT_FAILED:
+                rets[finished_cnt] = dev->pkt_ret[idx];
+                finished[finished_cnt++] = dev->jobs[idx];
+                break;
+            case LT_SIGN_QUEUE_PKT_RESULT:
+                rets[finished_cnt] = LT_HOST_NO_SESSION;
+                finished[finished_cnt++] = dev->jobs[idx];
+                break;
+            default:
+                break;
+        }
+    }
+
+    memset(dev->pkt, LT_SIGN_QUEUE_PKT_FREE, sizeof(dev->pkt));
+    dev->cnt = 0;
+    dev->tail = dev->seal = dev->cur = dev->open = 0;
+    dev->failed = false;
+
+    // Older job first.
+    while (finished_cnt) {
+        finished_cnt--;
+        finished[finished_cnt].cb(rets[finished_cnt], NULL, finished[finished_cnt].cb_ctx);
+    }
+}
+
+/**
+ * @brief Finishes the work of the crypto worker if it is done: sends the encrypted packet or reports the job whose
+ * L3 Result was decrypted.
+ *
+ * @return true if the device made progress
+ */
+static bool lt_sign_queue_dev_collect(lt_sign_queue_dev_t *dev)
+{
+    bool progress = false;
+
+    if (dev->work_busy && __atomic_load_n(&dev->work.done, __ATOMIC_ACQUIRE)) {
+        dev->work_busy = false;
+        progress = true;
+
+        if (!dev->work.decrypt) {
+            if (dev->work.ret != LT_OK) {
+                // Encryption invalidated the session, the job goes back to the queue.
+                dev->failed = true;
+            }
+            else {
+                dev->pkt[dev->seal] = LT_SIGN_QUEUE_PKT_SEALED;
+                dev->seal ^= 1;
+            }
+        }
+        else {
+            uint8_t idx = dev->open;
+            lt_sign_job_t job = dev->jobs[idx];
+            uint8_t rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+
+            // L3 errors of the result keep the Secure Session, decryption errors invalidate it.
+            lt_ret_t ret = dev->work.ret;
+            if (ret == LT_OK) {
+                ret = lt_sign_queue_signature(dev, dev->buff[idx], rs);
+            }
+            dev->pkt[idx] = LT_SIGN_QUEUE_PKT_FREE;
+            dev->open ^= 1;
+            dev->cnt--;
+            if (dev->h->l3.session_status != LT_SECURE_SESSION_ON) {
+                dev->failed = true;
+            }
+
+            lt_sign_queue_dev_kick(dev);
+            job.cb(ret, (ret == LT_OK) ? rs : NULL, job.cb_ctx);
+        }
+    }
+
+    if (dev->failed && !dev->work_busy) {
+        lt_sign_queue_dev_drain(dev);
+        return true;
+    }
+
+    lt_sign_queue_dev_kick(dev);
+
+    return progress;
+}
+#endif
+
+/** Encrypts ECDSA_Sign of the job into the free packet of the device, sends it if the device is idle. */
+static lt_ret_t lt_sign_queue_stage(lt_sign_queue_dev_t *dev, const lt_sign_job_t *job)
+{
+#ifdef LT_CRYPTO_WORKER
+    if (dev->q->worker) {
+        lt_sign_queue_stage_plain(dev, job);
+        return LT_OK;
+    }
+#endif
+
+    uint8_t idx = dev->cur ^ dev->cnt;
+    lt_sign_queue_fill(dev->buff[idx], job);
+
+    lt_ret_t ret = lt_l3_encrypt_request_buff(&dev->h->l3, dev->buff[idx]);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    dev->jobs[idx] = *job;
+    dev->cnt++;
+    if (dev->cnt == 1) {
+        lt_sign_queue_start(dev);
+    }
+
+    return LT_OK;
+}
+
+/** Completion of ECDSA_Sign on the device: starts the packet encrypted ahead, then reports the finished job. */
+static void lt_sign_queue_done(lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx)
+{
+    lt_sign_queue_dev_t *dev = (lt_sign_queue_dev_t *)cb_ctx;
+    uint8_t idx = dev->cur;
+    lt_sign_job_t job = dev->jobs[idx];
+    uint8_t rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+
+    LT_UNUSED(op);
+
+#ifdef LT_CRYPTO_WORKER
+    if (dev->q->worker) {
+        // Decryption is left to the crypto worker, the job is reported by lt_sign_queue_process().
+        dev->pkt[idx] = (ret == LT_OK) ? LT_SIGN_QUEUE_PKT_RESULT : LT_SIGN_QUEUE_PKT_FAILED;
+        dev->pkt_ret[idx] = ret;
+        dev->cur ^= 1;
+        if (ret != LT_OK) {
+            dev->failed = true;
+        }
+        lt_sign_queue_dev_kick(dev);
+        return;
+    }
+#endif
+
+    dev->cur ^= 1;
+    dev->cnt--;
+
+    if (ret != LT_OK) {
+        lt_sign_queue_dev_fail(dev);
+    }
+    else if (!lt_sign_queue_dev_usable(dev)) {
+        // Session was lost while the command was executed.
+        ret = LT_HOST_NO_SESSION;
+    }
+    else {
+        // L3 errors of the result keep the Secure Session, decryption errors invalidate it.
+        ret = lt_l3_decrypt_response_buff(&dev->h->l3, dev->buff[idx], LT_SIGN_QUEUE_BUFF_LEN);
+        if (ret == LT_OK) {
+            ret = lt_sign_queue_signature(dev, dev->buff[idx], rs);
+        }
+
+        if (!lt_sign_queue_dev_usable(dev)) {
+            lt_sign_queue_dev_fail(dev);
+        }
+        else if (dev->cnt) {
+            lt_sign_queue_start(dev);
+        }
+    }
+
+    job.cb(ret, (ret == LT_OK) ? rs : NULL, job.cb_ctx);
+    lt_sign_queue_dispatch(dev->q);
+}
+
+/** Returns usable device with the fewest jobs which can take one more, NULL if there is none. */
+static lt_sign_queue_dev_t *lt_sign_queue_pick(lt_sign_queue_t *q)
+{
+    lt_sign_queue_dev_t *best = NULL;
+
+    for (uint8_t i = 0; i < q->dev_cnt; i++) {
+        lt_sign_queue_dev_t *dev = &q->devs[i];
+        if ((dev->cnt < 2) && lt_sign_queue_dev_usable(dev) && (!best || (dev->cnt < best->cnt))) {
+            best = dev;
+        }
+    }
+
+    return best;
+}
+
+/** Hands waiting jobs to the devices, fails them if no device has a Secure Session anymore. */
+static void lt_sign_queue_dispatch(lt_sign_queue_t *q)
+{
+    while (q->cnt) {
+        lt_sign_queue_dev_t *dev = lt_sign_queue_pick(q);
+        if (!dev) {
+            break;
+        }
+
+        lt_sign_job_t job;
+        lt_sign_queue_pop(q, &job);
+        if (lt_sign_queue_stage(dev, &job) != LT_OK) {
+            // Encryption failure invalidated the session of the device, try the others. Job executed by the
+            // device finishes with an error.
+            lt_sign_queue_push_front(q, &job);
+        }
+    }
+
+    for (uint8_t i = 0; i < q->dev_cnt; i++) {
+        if (lt_sign_queue_dev_usable(&q->devs[i])) {
+            return;
+        }
+    }
+
+    while (q->cnt) {
+        lt_sign_job_t job;
+        lt_sign_queue_pop(q, &job);
+        job.cb(LT_HOST_NO_SESSION, NULL, job.cb_ctx);
+    }
+}
+
+lt_ret_t lt_sign_queue_init(lt_sign_queue_t *q)
+{
+    if (!q) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(q, 0, sizeof(*q));
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sign_queue_add_device(lt_sign_queue_t *q, lt_handle_t *h, lt_l2_async_t *op)
+{
+    if (!q || !h || !op || lt_l2_async_busy(op)) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+    if (q->dev_cnt == LT_SIGN_QUEUE_MAX_DEVICES) {
+        return LT_FAIL;
+    }
+
+    lt_sign_queue_dev_t *dev = &q->devs[q->dev_cnt++];
+    memset(dev, 0, sizeof(*dev));
+    dev->q = q;
+    dev->h = h;
+    dev->op = op;
+
+    return LT_OK;
+}
+
+#ifdef LT_CRYPTO_WORKER
+lt_ret_t lt_sign_queue_set_crypto_worker(lt_sign_queue_t *q, lt_crypto_worker_submit_t worker, void *worker_ctx)
+{
+    if (!q || lt_sign_queue_pending(q)) {
+        return LT_PARAM_ERR;
+    }
+
+    for (uint8_t i = 0; i < q->dev_cnt; i++) {
+        lt_sign_queue_dev_t *dev = &q->devs[i];
+        memset(dev->pkt, LT_SIGN_QUEUE_PKT_FREE, sizeof(dev->pkt));
+        dev->cur = dev->tail = dev->seal = dev->open = 0;
+    }
+    q->worker = worker;
+    q->worker_ctx = worker_ctx;
+
+    return LT_OK;
+}
+#endif
+
+lt_ret_t lt_sign_queue_submit(lt_sign_queue_t *q, const lt_ecc_slot_t slot, const uint8_t *digest,
+                              lt_sign_queue_cb_t cb, void *cb_ctx)
+{
+    if (!q || !digest || !cb || (slot > TR01_ECC_SLOT_31)) {
+        return LT_PARAM_ERR;
+    }
+    if (lt_sign_queue_pending(q) >= LT_SIGN_QUEUE_LEN) {
+        return LT_FAIL;
+    }
+
+    lt_sign_job_t *job = &q->jobs[(q->head + q->cnt) % LT_SIGN_QUEUE_LEN];
+    job->cb = cb;
+    job->cb_ctx = cb_ctx;
+    memcpy(job->digest, digest, sizeof(job->digest));
+    job->slot = (uint8_t)slot;
+    q->cnt++;
+
+    lt_sign_queue_dispatch(q);
+
+    return LT_OK;
+}
+
+lt_ret_t lt_sign_queue_process(lt_sign_queue_t *q)
+{
+    if (!q) {
+        return LT_PARAM_ERR;
+    }
+
+#ifdef LT_CRYPTO_WORKER
+    if (q->worker) {
+        for (uint8_t i = 0; i < q->dev_cnt; i++) {
+            lt_sign_queue_dev_t *dev = &q->devs[i];
+            (void)lt_sign_queue_dev_collect(dev);
+            if (lt_l2_async_busy(dev->op)) {
+                // Result is handed to the crypto worker by lt_sign_queue_done().
+                (void)lt_l2_async_process(dev->op);
+            }
+        }
+        // Jobs finished by the worker freed room on their devices.
+        lt_sign_queue_dispatch(q);
+
+        return LT_OK;
+    }
+#endif
+
+    for (uint8_t i = 0; i < q->dev_cnt; i++) {
+        lt_sign_queue_dev_t *dev = &q->devs[i];
+        if (dev->cnt) {
+            // Result is reported through lt_sign_queue_done().
+            (void)lt_l2_async_process(dev->op);
+        }
+    }
+
+    return LT_OK;
+}
+
+#ifdef LT_CRYPTO_WORKER
+/** Returns true if a crypto worker has a work of the queue, it finishes within microseconds. */
+static bool lt_sign_queue_work_busy(const lt_sign_queue_t *q)
+{
+    for (uint8_t i = 0; i < q->dev_cnt; i++) {
+        if (q->devs[i].work_busy) {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif
+
+lt_ret_t lt_sign_queue_run(lt_sign_queue_t *q)
+{
+    if (!q) {
+        return LT_PARAM_ERR;
+    }
+
+    uint16_t pending = lt_sign_queue_pending(q);
+    while (pending) {
+        lt_ret_t ret = lt_sign_queue_process(q);
+        if (ret != LT_OK) {
+            return ret;
+        }
+
+        uint16_t left = lt_sign_queue_pending(q);
+        bool idle = (left == pending);
+#ifdef LT_CRYPTO_WORKER
+        // Crypto workers finish within microseconds, only TROPIC01 is worth waiting for.
+        idle = idle && !lt_sign_queue_work_busy(q);
+#endif
+        if (idle) {
+            // Nothing finished, give TROPIC01 time before the next attempt.
+            ret = lt_l1_delay(&q->devs[0].h->l2, 1);
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+        pending = left;
+    }
+
+    return LT_OK;
+}
+
+uint16_t lt_sign_queue_pending(const lt_sign_queue_t *q)
+{
+    if (!q) {
+        return 0;
+    }
+
+    uint16_t pending = q->cnt;
+    for (uint8_t i = 0; i < q->dev_cnt; i++) {
+        pending += q->devs[i].cnt;
+    }
+
+    return pending;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file lt_silicon_rev.c
+ * @brief Runtime detection of TROPIC01 silicon revision and its check against the revision Libtropic was built for
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+
+// Only detection, there is no runtime dispatch: L2 Requests and code paths of the other revision are not built.
+#ifdef ABAB
+#define LT_SILICON_REV_BUILT LT_SILICON_REV_ABAB
+#elif ACAB
+#define LT_SILICON_REV_BUILT LT_SILICON_REV_ACAB
+#else
+#error "Undefined silicon revision. Please define either ABAB or ACAB."
+#endif
+
+lt_ret_t lt_get_silicon_rev(lt_handle_t *h, lt_silicon_rev_t *rev)
+{
+    if (!h || !rev) {
+        return LT_PARAM_ERR;
+    }
+
+    // Detected once per lt_init(), the revision of a chip does not change.
+    if (h->tr01_attrs.silicon_rev != LT_SILICON_REV_UNKNOWN) {
+        *rev = (lt_silicon_rev_t)h->tr01_attrs.silicon_rev;
+        return LT_OK;
+    }
+
+    // Bootloaders of the revisions return FW headers of different size, as in lt_print_fw_header().
+    uint8_t header[TR01_L2_GET_INFO_FW_HEADER_SIZE];
+    uint16_t read_header_size;
+    lt_ret_t ret = lt_get_info_fw_bank(h, TR01_FW_BANK_FW1, header, sizeof(header), &read_header_size);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    switch (read_header_size) {
+        case TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V1:
+            h->tr01_attrs.silicon_rev = LT_SILICON_REV_ABAB;
+            break;
+        case TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V2:
+        case TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V2_EMPTY_BANK:
+            h->tr01_attrs.silicon_rev = LT_SILICON_REV_ACAB;
+            break;
+        default:
+            return LT_L2_RSP_LEN_ERROR;
+    }
+    *rev = (lt_silicon_rev_t)h->tr01_attrs.silicon_rev;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_silicon_rev_check(lt_handle_t *h)
+{
+    lt_silicon_rev_t rev;
+    lt_ret_t ret = lt_get_silicon_rev(h, &rev);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    if (rev != LT_SILICON_REV_BUILT) {
+        LT_LOG_ERROR("TROPIC01 silicon revision %d differs from the built one %d", (int)rev, (int)LT_SILICON_REV_BUILT);
+        return LT_SILICON_REV_MISMATCH;
+    }
+
+    return LT_OK;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file lt_spi_recorder.c
+ * @brief SPI recorder, lock-free ring buffer of timestamped frames exchanged with TROPIC01
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include "lt_spi_recorder.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+#include "libtropic_port.h"
+
+/** Smallest ring buffer, the longest L1 frame with its header has to fit. */
+#define LT_SPI_REC_SIZE_MIN 512
+
+LT_STATIC_ASSERT(LT_SPI_REC_SIZE_MIN >= LT_SPI_REC_HDR_SIZE + TR01_L1_LEN_MAX)
+
+/** Copies data into the ring buffer at the write position, wrapping around its end. */
+static void lt_spi_recorder_copy_in(lt_spi_recorder_t *rec, const uint8_t *data, const uint32_t len)
+{
+    uint32_t pos = rec->wr & (rec->size - 1);
+    uint32_t first = rec->size - pos;
+
+    if (first > len) {
+        first = len;
+    }
+    memcpy(rec->buff + pos, data, first);
+    memcpy(rec->buff, data + first, len - first);
+    rec->wr += len;
+}
+
+lt_ret_t lt_spi_recorder_init(lt_spi_recorder_t *rec, uint8_t *buff, const uint32_t size)
+{
+    if (!rec || !buff || (size < LT_SPI_REC_SIZE_MIN) || (size & (size - 1))) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(rec, 0, sizeof(lt_spi_recorder_t));
+    rec->buff = buff;
+    rec->size = size;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_spi_recorder_attach(lt_handle_t *h, lt_spi_recorder_t *rec)
+{
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+
+    h->l2.spi_rec = rec;
+    h->l3.spi_rec = rec;
+
+    return LT_OK;
+}
+
+uint32_t lt_spi_recorder_read(lt_spi_recorder_t *rec, uint8_t *out, const uint32_t max_len)
+{
+    if (!rec || !out) {
+        return 0;
+    }
+
+    // Only the reader writes tail, data up to head were published by lt_spi_recorder_commit().
+    uint32_t tail = rec->tail;
+    uint32_t len = __atomic_load_n(&rec->head, __ATOMIC_ACQUIRE) - tail;
+    if (len > max_len) {
+        len = max_len;
+    }
+
+    uint32_t pos = tail & (rec->size - 1);
+    uint32_t first = rec->size - pos;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(out, rec->buff + pos, first);
+    memcpy(out + first, rec->buff, len - first);
+
+    // Space is given back to the writer only after the data were copied out.
+    __atomic_store_n(&rec->tail, tail + len, __ATOMIC_RELEASE);
+
+    return len;
+}
+
+uint32_t lt_spi_recorder_dropped(const lt_spi_recorder_t *rec)
+{
+    if (!rec) {
+        return 0;
+    }
+
+    return __atomic_load_n(&rec->dropped, __ATOMIC_RELAXED);
+}
+
+bool lt_spi_recorder_begin(lt_spi_recorder_t *rec, const uint8_t type, const uint16_t len)
+{
+    if (!rec) {
+        return false;
+    }
+
+    uint32_t head = rec->head;
+    uint32_t used = head - __atomic_load_n(&rec->tail, __ATOMIC_ACQUIRE);
+    if ((uint32_t)LT_SPI_REC_HDR_SIZE + len > rec->size - used) {
+        __atomic_store_n(&rec->dropped, rec->dropped + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    uint64_t time_us = lt_port_time_us();
+    uint8_t hdr[LT_SPI_REC_HDR_SIZE] = {type, 0, len & 0xFF, len >> 8};
+    for (int i = 0; i < 8; i++) {
+        hdr[4 + i] = (uint8_t)(time_us >> (8 * i));
+    }
+
+    rec->wr = head;
+    lt_spi_recorder_copy_in(rec, hdr, sizeof(hdr));
+
+    return true;
+}
+
+void lt_spi_recorder_append(lt_spi_recorder_t *rec, const uint8_t *data, const uint16_t len)
+{
+    lt_spi_recorder_copy_in(rec, data, len);
+}
+
+void lt_spi_recorder_commit(lt_spi_recorder_t *rec) { __atomic_store_n(&rec->head, rec->wr, __ATOMIC_RELEASE); }
@@ -0,0 +1,54 @@
+#ifndef LT_SPI_RECORDER_H
+#define LT_SPI_RECORDER_H
+
+/**
+ * @file lt_spi_recorder.h
+ * @brief SPI recorder declarations (used internally), see lt_spi_recorder_init()
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef LT_SPI_RECORDER
+/**
+ * @brief Starts a record, its data are then added by lt_spi_recorder_append() and published by
+ * lt_spi_recorder_commit().
+ *
+ * @param rec   SPI recorder, may be NULL
+ * @param type  Type of the record, see lt_spi_rec_type_t
+ * @param len   Total length of the data of the record
+ * @return      true if the record was started, false if rec is NULL or the record was dropped, as it does not fit
+ */
+bool lt_spi_recorder_begin(lt_spi_recorder_t *rec, const uint8_t type, const uint16_t len);
+
+/**
+ * @brief Adds data to the record started by lt_spi_recorder_begin().
+ *
+ * @param rec   SPI recorder
+ * @param data  Data
+ * @param len   Length of data
+ */
+void lt_spi_recorder_append(lt_spi_recorder_t *rec, const uint8_t *data, const uint16_t len);
+
+/**
+ * @brief Publishes the record to the reader.
+ *
+ * @param rec   SPI recorder
+ */
+void lt_spi_recorder_commit(lt_spi_recorder_t *rec);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_SPI_RECORDER_H
@@ -0,0 +1,37 @@
+#ifndef LT_STATS_H
+#define LT_STATS_H
+
+/**
+ * @file lt_stats.h
+ * @brief Runtime statistics counting sites (used internally), see lt_get_stats()
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_common.h"
+
+#ifdef LT_STATS
+/**
+ * @brief Adds n to the counter of runtime statistics of the layer state (s2 or s3), if lt_init() attached them.
+ */
+#define LT_STATS_ADD(state, field, n)            \
+    do {                                         \
+        lt_stats_t *_stats_ = (state)->rt_stats; \
+        if (_stats_) {                           \
+            _stats_->field += (n);               \
+        }                                        \
+    } while (0)
+#else
+// Arguments are not evaluated, so call sites may refer to members which exist only with LT_STATS.
+#define LT_STATS_ADD(state, field, n) \
+    do {                              \
+    } while (0)
+#endif
+
+/**
+ * @brief Increments the counter of runtime statistics of the layer state (s2 or s3).
+ */
+#define LT_STATS_INC(state, field) LT_STATS_ADD(state, field, 1)
+
+#endif  // LT_STATS_H
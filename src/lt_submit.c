@@ -0,0 +1,528 @@
+/**
+ * @file lt_submit.c
+ * @brief Submit/complete API for L3 operations
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_l3.h"
+#include "libtropic_macros.h"
+#include "lt_ecc_inventory.h"
+#include "lt_eddsa_sig_cache.h"
+#include "lt_i_config_cache.h"
+#include "lt_l3_cmd_desc.h"
+#include "lt_pairing_pub_cache.h"
+#include "lt_r_mem_map.h"
+
+/**
+ * @brief Checks output buffers of the operation, lt_in__*() would fail on them only after TROPIC01 executed the
+ * command.
+ *
+ * @param cmd   Operation
+ * @return      true if all output buffers of the operation are set
+ */
+static bool lt_submit_outputs_valid(const lt_cmd_t *cmd)
+{
+    switch (cmd->type) {
+        case LT_CMD_PING:
+            return cmd->args.ping.msg_in != NULL;
+        case LT_CMD_PAIRING_KEY_READ:
+            return cmd->args.pairing_key_read.pairing_pub != NULL;
+        case LT_CMD_R_CONFIG_READ:
+            return cmd->args.r_config_read.obj != NULL;
+        case LT_CMD_I_CONFIG_READ:
+            return cmd->args.i_config_read.obj != NULL;
+        case LT_CMD_R_MEM_DATA_READ:
+            return cmd->args.r_mem_data_read.data && cmd->args.r_mem_data_read.data_read_size;
+        case LT_CMD_RANDOM_VALUE_GET:
+            return cmd->args.random_value_get.rnd_bytes != NULL;
+        case LT_CMD_ECC_KEY_READ:
+            return cmd->args.ecc_key_read.key && cmd->args.ecc_key_read.curve && cmd->args.ecc_key_read.origin;
+        case LT_CMD_ECC_ECDSA_SIGN:
+            return cmd->args.ecc_ecdsa_sign.rs != NULL;
+        case LT_CMD_ECC_EDDSA_SIGN:
+            return cmd->args.ecc_eddsa_sign.rs != NULL;
+        case LT_CMD_MCOUNTER_GET:
+            return cmd->args.mcounter_get.mcounter_value != NULL;
+        case LT_CMD_MAC_AND_DESTROY:
+            return cmd->args.mac_and_destroy.data_in != NULL;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Encodes L3 Command of the operation into L3 buffer, see lt_out__*().
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param cmd   Operation
+ * @return      LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_submit_out(lt_handle_t *h, const lt_cmd_t *cmd)
+{
+    switch (cmd->type) {
+        case LT_CMD_PING:
+            return lt_out__ping(h, cmd->args.ping.msg_out, cmd->args.ping.msg_len);
+        case LT_CMD_PAIRING_KEY_WRITE:
+            return lt_out__pairing_key_write(h, cmd->args.pairing_key_write.pairing_pub,
+                                             cmd->args.pairing_key_write.slot);
+        case LT_CMD_PAIRING_KEY_READ:
+            return lt_out__pairing_key_read(h, cmd->args.pairing_key_read.slot);
+        case LT_CMD_PAIRING_KEY_INVALIDATE:
+            return lt_out__pairing_key_invalidate(h, cmd->args.pairing_key_invalidate.slot);
+#ifdef LT_CMD_CONFIG
+        case LT_CMD_R_CONFIG_WRITE:
+            return lt_out__r_config_write(h, cmd->args.r_config_write.addr, cmd->args.r_config_write.obj);
+        case LT_CMD_R_CONFIG_READ:
+            return lt_out__r_config_read(h, cmd->args.r_config_read.addr);
+        case LT_CMD_R_CONFIG_ERASE:
+            return lt_out__r_config_erase(h);
+        case LT_CMD_I_CONFIG_WRITE:
+            return lt_out__i_config_write(h, cmd->args.i_config_write.addr, cmd->args.i_config_write.bit_index);
+        case LT_CMD_I_CONFIG_READ:
+            return lt_out__i_config_read(h, cmd->args.i_config_read.addr);
+#endif
+#ifdef LT_CMD_R_MEM
+        case LT_CMD_R_MEM_DATA_WRITE:
+            return lt_out__r_mem_data_write(h, cmd->args.r_mem_data_write.udata_slot, cmd->args.r_mem_data_write.data,
+                                            cmd->args.r_mem_data_write.data_size);
+        case LT_CMD_R_MEM_DATA_READ:
+            return lt_out__r_mem_data_read(h, cmd->args.r_mem_data_read.udata_slot);
+        case LT_CMD_R_MEM_DATA_ERASE:
+            return lt_out__r_mem_data_erase(h, cmd->args.r_mem_data_erase.udata_slot);
+#endif
+        case LT_CMD_RANDOM_VALUE_GET:
+            return lt_out__random_value_get(h, cmd->args.random_value_get.rnd_bytes_cnt);
+#ifdef LT_CMD_ECC
+        case LT_CMD_ECC_KEY_GENERATE:
+            return lt_out__ecc_key_generate(h, cmd->args.ecc_key_generate.slot, cmd->args.ecc_key_generate.curve);
+        case LT_CMD_ECC_KEY_STORE:
+            return lt_out__ecc_key_store(h, cmd->args.ecc_key_store.slot, cmd->args.ecc_key_store.curve,
+                                         cmd->args.ecc_key_store.key);
+        case LT_CMD_ECC_KEY_READ:
+            return lt_out__ecc_key_read(h, cmd->args.ecc_key_read.slot);
+        case LT_CMD_ECC_KEY_ERASE:
+            return lt_out__ecc_key_erase(h, cmd->args.ecc_key_erase.slot);
+        case LT_CMD_ECC_ECDSA_SIGN:
+            return lt_out__ecc_ecdsa_sign(h, cmd->args.ecc_ecdsa_sign.slot, cmd->args.ecc_ecdsa_sign.msg,
+                                          cmd->args.ecc_ecdsa_sign.msg_len);
+        case LT_CMD_ECC_EDDSA_SIGN:
+            return lt_out__ecc_eddsa_sign(h, cmd->args.ecc_eddsa_sign.slot, cmd->args.ecc_eddsa_sign.msg,
+                                          cmd->args.ecc_eddsa_sign.msg_len);
+#endif
+#ifdef LT_CMD_MCOUNTER
+        case LT_CMD_MCOUNTER_INIT:
+            return lt_out__mcounter_init(h, cmd->args.mcounter_init.mcounter_index,
+                                         cmd->args.mcounter_init.mcounter_value);
+        case LT_CMD_MCOUNTER_UPDATE:
+            return lt_out__mcounter_update(h, cmd->args.mcounter_update.mcounter_index);
+        case LT_CMD_MCOUNTER_GET:
+            return lt_out__mcounter_get(h, cmd->args.mcounter_get.mcounter_index);
+#endif
+#ifdef LT_CMD_MAC_DESTROY
+        case LT_CMD_MAC_AND_DESTROY:
+            return lt_out__mac_and_destroy(h, cmd->args.mac_and_destroy.slot, cmd->args.mac_and_destroy.data_out);
+#endif
+        default:
+            return LT_PARAM_ERR;
+    }
+}
+
+/**
+ * @brief Decodes L3 Result of the operation from L3 buffer into its output buffers, see lt_in__*().
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param cmd   Operation
+ * @return      LT_OK if success, otherwise returns other error code.
+ */
+static lt_ret_t lt_submit_in(lt_handle_t *h, lt_cmd_t *cmd)
+{
+    switch (cmd->type) {
+        case LT_CMD_PING:
+            return lt_in__ping(h, cmd->args.ping.msg_in, cmd->args.ping.msg_len);
+        case LT_CMD_PAIRING_KEY_WRITE:
+            return lt_in__pairing_key_write(h);
+        case LT_CMD_PAIRING_KEY_READ:
+            return lt_in__pairing_key_read(h, cmd->args.pairing_key_read.pairing_pub);
+        case LT_CMD_PAIRING_KEY_INVALIDATE:
+            return lt_in__pairing_key_invalidate(h);
+#ifdef LT_CMD_CONFIG
+        case LT_CMD_R_CONFIG_WRITE:
+            return lt_in__r_config_write(h);
+        case LT_CMD_R_CONFIG_READ:
+            return lt_in__r_config_read(h, cmd->args.r_config_read.obj);
+        case LT_CMD_R_CONFIG_ERASE:
+            return lt_in__r_config_erase(h);
+        case LT_CMD_I_CONFIG_WRITE:
+            return lt_in__i_config_write(h);
+        case LT_CMD_I_CONFIG_READ:
+            return lt_in__i_config_read(h, cmd->args.i_config_read.obj);
+#endif
+#ifdef LT_CMD_R_MEM
+        case LT_CMD_R_MEM_DATA_WRITE:
+            return lt_in__r_mem_data_write(h);
+        case LT_CMD_R_MEM_DATA_READ:
+            return lt_in__r_mem_data_read(h, cmd->args.r_mem_data_read.data, cmd->args.r_mem_data_read.data_max_size,
+                                          cmd->args.r_mem_data_read.data_read_size);
+        case LT_CMD_R_MEM_DATA_ERASE:
+            return lt_in__r_mem_data_erase(h);
+#endif
+        case LT_CMD_RANDOM_VALUE_GET:
+            return lt_in__random_value_get(h, cmd->args.random_value_get.rnd_bytes,
+                                           cmd->args.random_value_get.rnd_bytes_cnt);
+#ifdef LT_CMD_ECC
+        case LT_CMD_ECC_KEY_GENERATE:
+            return lt_in__ecc_key_generate(h);
+        case LT_CMD_ECC_KEY_STORE:
+            return lt_in__ecc_key_store(h);
+        case LT_CMD_ECC_KEY_READ:
+            return lt_in__ecc_key_read(h, cmd->args.ecc_key_read.key, cmd->args.ecc_key_read.key_max_size,
+                                       cmd->args.ecc_key_read.curve, cmd->args.ecc_key_read.origin);
+        case LT_CMD_ECC_KEY_ERASE:
+            return lt_in__ecc_key_erase(h);
+        case LT_CMD_ECC_ECDSA_SIGN:
+            return lt_in__ecc_ecdsa_sign(h, cmd->args.ecc_ecdsa_sign.rs);
+        case LT_CMD_ECC_EDDSA_SIGN:
+            return lt_in__ecc_eddsa_sign(h, cmd->args.ecc_eddsa_sign.rs);
+#endif
+#ifdef LT_CMD_MCOUNTER
+        case LT_CMD_MCOUNTER_INIT:
+            return lt_in__mcounter_init(h);
+        case LT_CMD_MCOUNTER_UPDATE:
+            return lt_in__mcounter_update(h);
+        case LT_CMD_MCOUNTER_GET:
+            return lt_in__mcounter_get(h, cmd->args.mcounter_get.mcounter_value);
+#endif
+#ifdef LT_CMD_MAC_DESTROY
+        case LT_CMD_MAC_AND_DESTROY:
+            return lt_in__mac_and_destroy(h, cmd->args.mac_and_destroy.data_in);
+#endif
+        default:
+            return LT_PARAM_ERR;
+    }
+}
+
+/**
+ * @brief Keeps I-config cache consistent with I_Config_Write and I_Config_Read operations, as lt_i_config_write()
+ * and lt_i_config_read() do.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param cmd   Operation
+ * @param ret   Result of the operation
+ */
+static void lt_submit_i_config_cache(lt_handle_t *h, const lt_cmd_t *cmd, const lt_ret_t ret)
+{
+#ifdef LT_I_CONFIG_CACHE
+    if (cmd->type == LT_CMD_I_CONFIG_WRITE) {
+        lt_i_config_cache_merge_write(&h->l3.i_config, cmd->args.i_config_write.addr,
+                                      cmd->args.i_config_write.bit_index, ret == LT_OK);
+    }
+    else if ((cmd->type == LT_CMD_I_CONFIG_READ) && (ret == LT_OK)) {
+        lt_i_config_cache_put(&h->l3.i_config, cmd->args.i_config_read.addr, *cmd->args.i_config_read.obj);
+    }
+#else
+    LT_UNUSED(h);
+    LT_UNUSED(cmd);
+    LT_UNUSED(ret);
+#endif
+}
+
+/**
+ * @brief Keeps ECC key slot inventory consistent with ECC_Key_* operations, as lt_ecc_key_generate(),
+ * lt_ecc_key_store(), lt_ecc_key_read() and lt_ecc_key_erase() do.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param cmd   Operation
+ * @param ret   Result of the operation
+ */
+static void lt_submit_ecc_inventory(lt_handle_t *h, const lt_cmd_t *cmd, const lt_ret_t ret)
+{
+#ifdef LT_ECC_INVENTORY
+    switch (cmd->type) {
+        case LT_CMD_ECC_KEY_GENERATE:
+        case LT_CMD_ECC_KEY_STORE:
+            // Slot may or may not have changed if the operation failed.
+            if (ret != LT_OK) {
+                lt_ecc_inventory_forget(h, cmd->type == LT_CMD_ECC_KEY_GENERATE ? cmd->args.ecc_key_generate.slot
+                                                                                : cmd->args.ecc_key_store.slot);
+            }
+            else if (cmd->type == LT_CMD_ECC_KEY_GENERATE) {
+                lt_ecc_inventory_put_key(h, cmd->args.ecc_key_generate.slot, cmd->args.ecc_key_generate.curve,
+                                         TR01_CURVE_GENERATED);
+            }
+            else {
+                lt_ecc_inventory_put_key(h, cmd->args.ecc_key_store.slot, cmd->args.ecc_key_store.curve,
+                                         TR01_CURVE_STORED);
+            }
+            break;
+        case LT_CMD_ECC_KEY_READ:
+            lt_ecc_inventory_merge_read(h, cmd->args.ecc_key_read.slot, ret, cmd->args.ecc_key_read.key,
+                                        *cmd->args.ecc_key_read.curve, *cmd->args.ecc_key_read.origin);
+            break;
+        case LT_CMD_ECC_KEY_ERASE:
+            if (ret == LT_OK) {
+                lt_ecc_inventory_put_empty(h, cmd->args.ecc_key_erase.slot);
+            }
+            else {
+                lt_ecc_inventory_forget(h, cmd->args.ecc_key_erase.slot);
+            }
+            break;
+        default:
+            break;
+    }
+#else
+    LT_UNUSED(h);
+    LT_UNUSED(cmd);
+    LT_UNUSED(ret);
+#endif
+}
+
+/**
+ * @brief Keeps pairing public key cache consistent with Pairing_Key_* operations, as lt_pairing_key_write(),
+ * lt_pairing_key_read() and lt_pairing_key_invalidate() do.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param cmd   Operation
+ * @param ret   Result of the operation
+ */
+static void lt_submit_pairing_pub_cache(lt_handle_t *h, const lt_cmd_t *cmd, const lt_ret_t ret)
+{
+#ifdef LT_PAIRING_PUB_CACHE
+    switch (cmd->type) {
+        case LT_CMD_PAIRING_KEY_WRITE:
+            lt_pairing_pub_cache_merge_write(h, cmd->args.pairing_key_write.slot, ret,
+                                             cmd->args.pairing_key_write.pairing_pub);
+            break;
+        case LT_CMD_PAIRING_KEY_READ:
+            lt_pairing_pub_cache_merge_read(h, cmd->args.pairing_key_read.slot, ret,
+                                            cmd->args.pairing_key_read.pairing_pub);
+            break;
+        case LT_CMD_PAIRING_KEY_INVALIDATE:
+            lt_pairing_pub_cache_merge_invalidate(h, cmd->args.pairing_key_invalidate.slot, ret);
+            break;
+        default:
+            break;
+    }
+#else
+    LT_UNUSED(h);
+    LT_UNUSED(cmd);
+    LT_UNUSED(ret);
+#endif
+}
+
+/**
+ * @brief Starts a new generation of the key in the slot before ECC_Key_Generate, ECC_Key_Store and ECC_Key_Erase
+ * operations are sent, as lt_ecc_key_generate(), lt_ecc_key_store() and lt_ecc_key_erase() do.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param cmd   Operation
+ */
+static void lt_submit_eddsa_sig_cache_prepare(lt_handle_t *h, const lt_cmd_t *cmd)
+{
+#ifdef LT_EDDSA_SIG_CACHE
+    switch (cmd->type) {
+        case LT_CMD_ECC_KEY_GENERATE:
+            lt_eddsa_sig_cache_key_changed(h, cmd->args.ecc_key_generate.slot);
+            break;
+        case LT_CMD_ECC_KEY_STORE:
+            lt_eddsa_sig_cache_key_changed(h, cmd->args.ecc_key_store.slot);
+            break;
+        case LT_CMD_ECC_KEY_ERASE:
+            lt_eddsa_sig_cache_key_changed(h, cmd->args.ecc_key_erase.slot);
+            break;
+        default:
+            break;
+    }
+#else
+    LT_UNUSED(h);
+    LT_UNUSED(cmd);
+#endif
+}
+
+/**
+ * @brief Makes the summary of the R-mem occupancy map stale before R_Mem_Data_Write and R_Mem_Data_Erase operations
+ * are sent, as lt_r_mem_data_write() and lt_r_mem_data_erase() do.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param cmd   Operation
+ * @return      LT_OK if the operation may be sent
+ */
+static lt_ret_t lt_submit_r_mem_map_prepare(lt_handle_t *h, const lt_cmd_t *cmd)
+{
+#ifdef LT_R_MEM_MAP
+    if (cmd->type == LT_CMD_R_MEM_DATA_WRITE) {
+        return lt_r_mem_map_before_change(h, cmd->args.r_mem_data_write.udata_slot);
+    }
+    if (cmd->type == LT_CMD_R_MEM_DATA_ERASE) {
+        return lt_r_mem_map_before_change(h, cmd->args.r_mem_data_erase.udata_slot);
+    }
+#else
+    LT_UNUSED(h);
+    LT_UNUSED(cmd);
+#endif
+    return LT_OK;
+}
+
+/**
+ * @brief Keeps the R-mem occupancy map consistent with R_Mem_Data_* operations, as lt_r_mem_data_write(),
+ * lt_r_mem_data_read() and lt_r_mem_data_erase() do.
+ *
+ * @param h     Handle for communication with TROPIC01
+ * @param cmd   Operation
+ * @param ret   Result of the operation
+ */
+static void lt_submit_r_mem_map(lt_handle_t *h, const lt_cmd_t *cmd, const lt_ret_t ret)
+{
+#ifdef LT_R_MEM_MAP
+    switch (cmd->type) {
+        case LT_CMD_R_MEM_DATA_WRITE:
+            lt_r_mem_map_merge_write(h, cmd->args.r_mem_data_write.udata_slot, ret);
+            break;
+        case LT_CMD_R_MEM_DATA_READ:
+            lt_r_mem_map_merge_read(h, cmd->args.r_mem_data_read.udata_slot, ret);
+            break;
+        case LT_CMD_R_MEM_DATA_ERASE:
+            lt_r_mem_map_merge_erase(h, cmd->args.r_mem_data_erase.udata_slot, ret);
+            break;
+        default:
+            break;
+    }
+#else
+    LT_UNUSED(h);
+    LT_UNUSED(cmd);
+    LT_UNUSED(ret);
+#endif
+}
+
+lt_ret_t lt_submit(lt_handle_t *h, lt_cmd_t *cmd)
+{
+    if (!h || !cmd || !lt_submit_outputs_valid(cmd)) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+    if (h->l3.submitted) {
+        return LT_FAIL;
+    }
+
+    lt_ret_t ret = lt_submit_r_mem_map_prepare(h, cmd);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_submit_out(h, cmd);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    lt_submit_eddsa_sig_cache_prepare(h, cmd);
+
+    ret = lt_l2_send_encrypted_cmd(&h->l2, h->l3.buff, h->l3.buff_len);
+    if (ret != LT_OK) {
+        lt_submit_i_config_cache(h, cmd, ret);
+        lt_submit_ecc_inventory(h, cmd, ret);
+        lt_submit_r_mem_map(h, cmd, ret);
+        lt_submit_pairing_pub_cache(h, cmd, ret);
+        return ret;
+    }
+
+    h->l3.submitted = cmd;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_complete(lt_handle_t *h, lt_cmd_t **cmd)
+{
+    if (!h || !cmd || !h->l3.submitted) {
+        return LT_PARAM_ERR;
+    }
+
+    *cmd = h->l3.submitted;
+    h->l3.submitted = NULL;
+
+    // Type was checked by lt_submit_out(), lt_cmd_type_t follows the order of the command descriptors.
+    lt_ret_t ret
+        = lt_l2_recv_encrypted_res(&h->l2, h->l3.buff, lt_l3_cmd_res_max_len(h, (lt_l3_cmd_idx_t)(*cmd)->type));
+    if (ret == LT_OK) {
+        ret = lt_submit_in(h, *cmd);
+    }
+    lt_submit_i_config_cache(h, *cmd, ret);
+    lt_submit_ecc_inventory(h, *cmd, ret);
+    lt_submit_r_mem_map(h, *cmd, ret);
+    lt_submit_pairing_pub_cache(h, *cmd, ret);
+
+    return ret;
+}
+
+#ifdef LT_L2_ASYNC
+lt_ret_t lt_submit_async(lt_handle_t *h, lt_cmd_t *cmd, struct lt_l2_async_t *op)
+{
+    if (!h || !cmd || !op || !lt_submit_outputs_valid(cmd)) {
+        return LT_PARAM_ERR;
+    }
+    if (h->l3.session_status != LT_SECURE_SESSION_ON) {
+        return LT_HOST_NO_SESSION;
+    }
+    if (h->l3.submitted || lt_l2_async_busy(op)) {
+        return LT_FAIL;
+    }
+
+    lt_ret_t ret = lt_submit_r_mem_map_prepare(h, cmd);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    ret = lt_submit_out(h, cmd);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    lt_submit_eddsa_sig_cache_prepare(h, cmd);
+
+    // The L3 Result is received into the same buffer, which has to fit the L3 Command as well.
+    ret = lt_l2_async_send_encrypted_cmd(op, &h->l2, h->l3.buff,
+                                         lt_l3_cmd_packet_max_len(h, (lt_l3_cmd_idx_t)cmd->type), NULL, NULL);
+    if (ret != LT_OK) {
+        lt_submit_i_config_cache(h, cmd, ret);
+        lt_submit_ecc_inventory(h, cmd, ret);
+        lt_submit_r_mem_map(h, cmd, ret);
+        lt_submit_pairing_pub_cache(h, cmd, ret);
+        return ret;
+    }
+
+    h->l3.submitted = cmd;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_complete_async(lt_handle_t *h, struct lt_l2_async_t *op, lt_cmd_t **cmd)
+{
+    if (!h || !op || !cmd || !h->l3.submitted) {
+        return LT_PARAM_ERR;
+    }
+
+    lt_ret_t ret = lt_l2_async_process(op);
+    if (ret == LT_L1_CHIP_BUSY) {
+        return ret;
+    }
+
+    *cmd = h->l3.submitted;
+    h->l3.submitted = NULL;
+
+    if (ret == LT_OK) {
+        ret = lt_submit_in(h, *cmd);
+    }
+    lt_submit_i_config_cache(h, *cmd, ret);
+    lt_submit_ecc_inventory(h, *cmd, ret);
+    lt_submit_r_mem_map(h, *cmd, ret);
+    lt_submit_pairing_pub_cache(h, *cmd, ret);
+
+    return ret;
+}
+#endif
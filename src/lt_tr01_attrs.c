@@ -8,14 +8,63 @@
 
 #include "lt_tr01_attrs.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
 #include "libtropic.h"
 #include "libtropic_common.h"
 #include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "lt_crc16.h"
 
 #define LT_LATEST_RISCV_FW_VER_MAJOR 2
 #define LT_LATEST_RISCV_FW_VER_MINOR 0
 #define LT_LATEST_RISCV_FW_VER_PATCH 0
 
+/**
+ * @brief Sets the attributes for the given Application FW version.
+ *
+ * @param h             Handle for communication with TROPIC01
+ * @param riscv_fw_ver  Application FW version as returned by lt_get_info_riscv_fw_ver()
+ * @retval              LT_OK Function executed successfully
+ * @retval              LT_APP_FW_TOO_NEW Application FW is not supported by this version of libtropic
+ */
+static lt_ret_t lt_tr01_attrs_set(lt_handle_t *h, const uint8_t *riscv_fw_ver)
+{
+    // Check if the Application FW version is supported by the current version of libtropic
+    // TODO: handle FW versions older than 1.0.0
+    if (riscv_fw_ver[3] > LT_LATEST_RISCV_FW_VER_MAJOR
+        || (riscv_fw_ver[3] == LT_LATEST_RISCV_FW_VER_MAJOR && riscv_fw_ver[2] > LT_LATEST_RISCV_FW_VER_MINOR)
+        || (riscv_fw_ver[3] == LT_LATEST_RISCV_FW_VER_MAJOR && riscv_fw_ver[2] == LT_LATEST_RISCV_FW_VER_MINOR
+            && riscv_fw_ver[1] > LT_LATEST_RISCV_FW_VER_PATCH)) {
+        return LT_APP_FW_TOO_NEW;
+    }
+
+    // Initialize the TROPIC01 attributes structure
+    // this is the most crucial part - has to be efficient and logically correct
+    if (riscv_fw_ver[3] < 2) {
+        h->tr01_attrs.r_mem_udata_slot_size_max = 444;
+    }
+    else {
+        h->tr01_attrs.r_mem_udata_slot_size_max = 475;
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_tr01_attrs_read(lt_handle_t *h)
+{
+    uint8_t riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE];
+
+    lt_ret_t ret = lt_get_info_riscv_fw_ver(h, riscv_fw_ver);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_tr01_attrs_set(h, riscv_fw_ver);
+}
+
 lt_ret_t lt_init_tr01_attrs(lt_handle_t *h)
 {
 #ifdef LT_REDUNDANT_ARG_CHECK
@@ -26,7 +75,6 @@ lt_ret_t lt_init_tr01_attrs(lt_handle_t *h)
 
     lt_ret_t ret;
     lt_tr01_mode_t tr01_mode;
-    uint8_t riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE];
 
     // 1. Set some default dummy values for the attributes
     h->tr01_attrs.r_mem_udata_slot_size_max = 0;
@@ -45,29 +93,106 @@ lt_ret_t lt_init_tr01_attrs(lt_handle_t *h)
         }
     }
 
-    // 4. Read Application FW version
-    ret = lt_get_info_riscv_fw_ver(h, riscv_fw_ver);
+    // 4. Read Application FW version, check it and initialize the TROPIC01 attributes structure
+    return lt_tr01_attrs_read(h);
+}
+#ifdef LT_WARM_INIT
+
+// crc16() takes signed 16-bit length.
+LT_STATIC_ASSERT(sizeof(lt_tr01_attrs_cache_t) - offsetof(lt_tr01_attrs_cache_t, chip_id) <= INT16_MAX)
+
+/** CRC16 of the cached data, i.e. of everything following the crc field. */
+static uint16_t lt_tr01_attrs_cache_crc(const lt_tr01_attrs_cache_t *cache)
+{
+    return crc16((const uint8_t *)&cache->chip_id,
+                 (int16_t)(sizeof(*cache) - offsetof(lt_tr01_attrs_cache_t, chip_id)));
+}
+
+lt_ret_t lt_tr01_attrs_export(lt_handle_t *h, lt_tr01_attrs_cache_t *cache)
+{
+    if (!h || !cache) {
+        return LT_PARAM_ERR;
+    }
+
+    // Attributes of the running FW are exported, even if the handle still uses cached ones.
+    lt_ret_t ret = lt_tr01_attrs_verify(h);
     if (ret != LT_OK) {
         return ret;
     }
 
-    // 5. Check if the Application FW version is supported by the current version of libtropic
-    // TODO: handle FW versions older than 1.0.0
-    if (riscv_fw_ver[3] > LT_LATEST_RISCV_FW_VER_MAJOR
-        || (riscv_fw_ver[3] == LT_LATEST_RISCV_FW_VER_MAJOR && riscv_fw_ver[2] > LT_LATEST_RISCV_FW_VER_MINOR)
-        || (riscv_fw_ver[3] == LT_LATEST_RISCV_FW_VER_MAJOR && riscv_fw_ver[2] == LT_LATEST_RISCV_FW_VER_MINOR
-            && riscv_fw_ver[1] > LT_LATEST_RISCV_FW_VER_PATCH)) {
-        return LT_APP_FW_TOO_NEW;
+    memset(cache, 0, sizeof(*cache));
+    ret = lt_get_info_chip_id(h, &cache->chip_id);
+    if (ret == LT_OK) {
+        ret = lt_get_info_riscv_fw_ver(h, cache->riscv_fw_ver);
+    }
+    if (ret != LT_OK) {
+        memset(cache, 0, sizeof(*cache));
+        return ret;
     }
 
-    // 6. Initialize the TROPIC01 attributes structure
-    // this is the most crucial part - has to be efficient and logically correct
-    if (riscv_fw_ver[3] < 2) {
-        h->tr01_attrs.r_mem_udata_slot_size_max = 444;
+    cache->r_mem_udata_slot_size_max = h->tr01_attrs.r_mem_udata_slot_size_max;
+    cache->magic = LT_TR01_ATTRS_CACHE_MAGIC;
+    cache->version = LT_TR01_ATTRS_CACHE_VERSION;
+    cache->crc = lt_tr01_attrs_cache_crc(cache);
+
+    return LT_OK;
+}
+
+bool lt_tr01_attrs_cache_valid(const lt_tr01_attrs_cache_t *cache)
+{
+    if (!cache || (cache->magic != LT_TR01_ATTRS_CACHE_MAGIC) || (cache->version != LT_TR01_ATTRS_CACHE_VERSION)) {
+        return false;
     }
-    else {
-        h->tr01_attrs.r_mem_udata_slot_size_max = 475;
+
+    return cache->crc == lt_tr01_attrs_cache_crc(cache);
+}
+
+lt_ret_t lt_tr01_attrs_cache_chip_id(const lt_tr01_attrs_cache_t *cache, struct lt_chip_id_t *chip_id)
+{
+    if (!chip_id || !lt_tr01_attrs_cache_valid(cache)) {
+        return LT_PARAM_ERR;
     }
 
+    memcpy(chip_id, &cache->chip_id, sizeof(*chip_id));
+
     return LT_OK;
-}
\ No newline at end of file
+}
+
+lt_ret_t lt_tr01_attrs_from_cache(lt_handle_t *h, const lt_tr01_attrs_cache_t *cache)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+    // Cache which is not valid, or does not match its FW version, is not used.
+    if (!lt_tr01_attrs_cache_valid(cache) || (lt_tr01_attrs_set(h, cache->riscv_fw_ver) != LT_OK)
+        || (h->tr01_attrs.r_mem_udata_slot_size_max != cache->r_mem_udata_slot_size_max)) {
+        LT_LOG_INFO("TROPIC01 attributes cache is not valid, reading the attributes from TROPIC01");
+        return lt_init_tr01_attrs(h);
+    }
+
+    h->tr01_attrs.unverified = 1;
+
+    return LT_OK;
+}
+
+lt_ret_t lt_tr01_attrs_verify(lt_handle_t *h)
+{
+#ifdef LT_REDUNDANT_ARG_CHECK
+    if (!h) {
+        return LT_PARAM_ERR;
+    }
+#endif
+
+    if (!h->tr01_attrs.unverified) {
+        return LT_OK;
+    }
+
+    LT_LOG_INFO("Operation failed with cached TROPIC01 attributes, reading them from TROPIC01");
+    h->tr01_attrs.unverified = 0;
+
+    return lt_init_tr01_attrs(h);
+}
+#endif
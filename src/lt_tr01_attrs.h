@@ -22,4 +22,39 @@
  */
 lt_ret_t lt_init_tr01_attrs(lt_handle_t *h) __attribute__((warn_unused_result));
 
+/**
+ * @brief Reads the Application FW version and initializes the lt_tr01_attrs_t structure from it, i.e. the part of
+ * lt_init_tr01_attrs() done once TROPIC01 is executing the Application FW.
+ *
+ * @param h   Handle for communication with TROPIC01
+ * @retval    LT_OK Function executed successfully
+ * @retval    other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ */
+lt_ret_t lt_tr01_attrs_read(lt_handle_t *h) __attribute__((warn_unused_result));
+
+#ifdef LT_WARM_INIT
+/**
+ * @brief Initializes the lt_tr01_attrs_t structure from attributes cached by a previous run, without any communication.
+ * The attributes are marked unverified until lt_tr01_attrs_verify(). Cache which is not valid falls back to
+ * lt_init_tr01_attrs().
+ *
+ * @param h      Handle for communication with TROPIC01
+ * @param cache  Attributes exported by lt_tr01_attrs_export()
+ * @retval       LT_OK Function executed successfully
+ * @retval       other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ */
+lt_ret_t lt_tr01_attrs_from_cache(lt_handle_t *h, const lt_tr01_attrs_cache_t *cache)
+    __attribute__((warn_unused_result));
+
+/**
+ * @brief Reads the attributes from TROPIC01 as lt_init_tr01_attrs() does, if they were taken from the cache and not
+ * verified yet. Called after the first failure of an operation depending on them.
+ *
+ * @param h   Handle for communication with TROPIC01
+ * @retval    LT_OK Function executed successfully
+ * @retval    other Function did not execute successully, you might use lt_ret_verbose() to get verbose encoding
+ */
+lt_ret_t lt_tr01_attrs_verify(lt_handle_t *h) __attribute__((warn_unused_result));
+#endif
+
 #endif  // LT_TR01_ATTRS_H
\ No newline at end of file
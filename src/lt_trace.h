@@ -0,0 +1,48 @@
+#ifndef LT_TRACE_H
+#define LT_TRACE_H
+
+/**
+ * @file lt_trace.h
+ * @brief Trace hook call sites (used internally), see lt_set_trace_hooks()
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "libtropic_common.h"
+
+#ifdef LT_TRACE
+#include "libtropic_port.h"
+
+/**
+ * @brief Calls start hook of the table (pointer to lt_trace_hooks_t, may be NULL) for the phase.
+ */
+#define LT_TRACE_START(hooks, phase)                                  \
+    do {                                                              \
+        const lt_trace_hooks_t *_hooks_ = (hooks);                    \
+        if (_hooks_ && _hooks_->start) {                              \
+            _hooks_->start(_hooks_->ctx, (phase), lt_port_time_us()); \
+        }                                                             \
+    } while (0)
+
+/**
+ * @brief Calls end hook of the table (pointer to lt_trace_hooks_t, may be NULL) for the phase.
+ */
+#define LT_TRACE_END(hooks, phase)                                  \
+    do {                                                            \
+        const lt_trace_hooks_t *_hooks_ = (hooks);                  \
+        if (_hooks_ && _hooks_->end) {                              \
+            _hooks_->end(_hooks_->ctx, (phase), lt_port_time_us()); \
+        }                                                           \
+    } while (0)
+#else
+// Arguments are not evaluated, so call sites may refer to members which exist only with LT_TRACE.
+#define LT_TRACE_START(hooks, phase) \
+    do {                             \
+    } while (0)
+#define LT_TRACE_END(hooks, phase) \
+    do {                           \
+    } while (0)
+#endif
+
+#endif  // LT_TRACE_H
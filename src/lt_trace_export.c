@@ -0,0 +1,231 @@
+/**
+ * @file lt_trace_export.c
+ * @brief Recording of trace hook events and their export in the Chrome trace event format
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+/** Longest JSON record written at once, the thread name is written separately. */
+#define LT_TRACE_EXPORT_LINE 128
+
+/** Names and categories of the exported slices, indexed by lt_trace_phase_t. */
+static const char *const lt_trace_export_names[][2] = {
+    [LT_TRACE_L1_SPI] = {"SPI transfer", "L1"},
+    [LT_TRACE_L1_WAIT] = {"wait", "L1"},
+    [LT_TRACE_L1_READ] = {"L1 read", "L1"},
+    [LT_TRACE_L2_CRC] = {"CRC", "L2"},
+    [LT_TRACE_L2_ENC_CMD] = {"L3 command send", "L2"},
+    [LT_TRACE_L2_ENC_RES] = {"L3 result receive", "L2"},
+    [LT_TRACE_CAL_ENCRYPT] = {"encrypt", "CAL"},
+    [LT_TRACE_CAL_DECRYPT] = {"decrypt", "CAL"},
+};
+
+LT_STATIC_ASSERT(sizeof(lt_trace_export_names) / sizeof(lt_trace_export_names[0]) == LT_TRACE_CAL_DECRYPT + 1)
+
+static void lt_trace_export_record(void *ctx, const lt_trace_phase_t phase, const uint64_t time_us, const uint8_t end)
+{
+    lt_trace_export_t *exp = (lt_trace_export_t *)ctx;
+
+    if (exp->count == exp->size) {
+        exp->dropped++;
+        return;
+    }
+
+    lt_trace_event_t *e = &exp->events[exp->count++];
+    e->time_us = time_us;
+    e->phase = (uint8_t)phase;
+    e->end = end;
+}
+
+static void lt_trace_export_start(void *ctx, lt_trace_phase_t phase, uint64_t time_us)
+{
+    lt_trace_export_record(ctx, phase, time_us, 0);
+}
+
+static void lt_trace_export_end(void *ctx, lt_trace_phase_t phase, uint64_t time_us)
+{
+    lt_trace_export_record(ctx, phase, time_us, 1);
+}
+
+lt_ret_t lt_trace_export_init(lt_trace_export_t *exp, lt_trace_event_t *events, const uint32_t size,
+                              const uint32_t tid, const char *name)
+{
+    if (!exp || !events || !size) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(exp, 0, sizeof(lt_trace_export_t));
+    exp->hooks.start = lt_trace_export_start;
+    exp->hooks.end = lt_trace_export_end;
+    exp->hooks.ctx = exp;
+    exp->events = events;
+    exp->size = size;
+    exp->tid = tid;
+    exp->name = name;
+
+    return LT_OK;
+}
+
+void lt_trace_export_clear(lt_trace_export_t *exp)
+{
+    if (!exp) {
+        return;
+    }
+
+    exp->count = 0;
+    exp->dropped = 0;
+}
+
+uint32_t lt_trace_export_dropped(const lt_trace_export_t *exp)
+{
+    if (!exp) {
+        return 0;
+    }
+
+    return exp->dropped;
+}
+
+/** Writes the line formatted by snprintf() into it. */
+static lt_ret_t lt_trace_export_line(lt_trace_export_write_t write, void *write_ctx, const char *line, const int len)
+{
+    if ((len < 0) || (len >= LT_TRACE_EXPORT_LINE)) {
+        return LT_FAIL;
+    }
+
+    return write(write_ctx, line, (size_t)len);
+}
+
+/** Writes the name as a JSON string, quotes and backslashes are escaped and control characters left out. */
+static lt_ret_t lt_trace_export_string(lt_trace_export_write_t write, void *write_ctx, const char *name)
+{
+    lt_ret_t ret = write(write_ctx, "\"", 1);
+
+    for (const char *c = name; (ret == LT_OK) && *c; c++) {
+        if ((*c == '"') || (*c == '\\')) {
+            ret = write(write_ctx, "\\", 1);
+        }
+        if ((ret == LT_OK) && ((unsigned char)*c >= 0x20)) {
+            ret = write(write_ctx, c, 1);
+        }
+    }
+    if (ret == LT_OK) {
+        ret = write(write_ctx, "\"", 1);
+    }
+
+    return ret;
+}
+
+/** Writes the thread name and the events of one exporter, each record is preceded by a comma. */
+static lt_ret_t lt_trace_export_thread(const lt_trace_export_t *exp, lt_trace_export_write_t write, void *write_ctx)
+{
+    char line[LT_TRACE_EXPORT_LINE];
+    lt_ret_t ret;
+    int len;
+
+    if (exp->name) {
+        len = snprintf(line, sizeof(line), ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32
+                       ",\"args\":{\"name\":", exp->tid);
+        ret = lt_trace_export_line(write, write_ctx, line, len);
+        if (ret == LT_OK) {
+            ret = lt_trace_export_string(write, write_ctx, exp->name);
+        }
+        if (ret == LT_OK) {
+            ret = write(write_ctx, "}}", 2);
+        }
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    // Phases nest, so the depth tells how many of them were left open by dropped events.
+    uint32_t depth = 0;
+    uint32_t res_depth = 0;
+    uint64_t last_us = 0;
+    for (uint32_t i = 0; i < exp->count; i++) {
+        const lt_trace_event_t *e = &exp->events[i];
+        last_us = e->time_us;
+
+        if (e->end) {
+            if (depth > 0) {
+                depth--;
+            }
+            if ((e->phase == LT_TRACE_L2_ENC_RES) && (res_depth > 0)) {
+                res_depth--;
+            }
+            len = snprintf(line, sizeof(line), ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%" PRIu64 "}",
+                           exp->tid, e->time_us);
+        }
+        else {
+            const char *name = lt_trace_export_names[e->phase][0];
+            const char *cat = lt_trace_export_names[e->phase][1];
+            if (e->phase == LT_TRACE_L2_ENC_RES) {
+                res_depth++;
+            }
+            else if ((e->phase == LT_TRACE_L1_WAIT) && res_depth) {
+                // TROPIC01 is executing the L3 command.
+                name = "chip compute";
+                cat = "TROPIC01";
+            }
+            depth++;
+            len = snprintf(line, sizeof(line),
+                           ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"B\",\"pid\":1,\"tid\":%" PRIu32
+                           ",\"ts\":%" PRIu64 "}",
+                           name, cat, exp->tid, e->time_us);
+        }
+
+        ret = lt_trace_export_line(write, write_ctx, line, len);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    for (; depth > 0; depth--) {
+        len = snprintf(line, sizeof(line), ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%" PRIu64 "}",
+                       exp->tid, last_us);
+        ret = lt_trace_export_line(write, write_ctx, line, len);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return LT_OK;
+}
+
+lt_ret_t lt_trace_export_json(const lt_trace_export_t *const *exps, const size_t cnt, lt_trace_export_write_t write,
+                              void *write_ctx)
+{
+    if (!exps || !cnt || !write) {
+        return LT_PARAM_ERR;
+    }
+    for (size_t i = 0; i < cnt; i++) {
+        if (!exps[i] || !exps[i]->events) {
+            return LT_PARAM_ERR;
+        }
+    }
+
+    // Process name comes first, so every following record is preceded by a comma.
+    static const char head[]
+        = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"libtropic\"}}";
+    lt_ret_t ret = write(write_ctx, head, sizeof(head) - 1);
+
+    for (size_t i = 0; (ret == LT_OK) && (i < cnt); i++) {
+        ret = lt_trace_export_thread(exps[i], write, write_ctx);
+    }
+    if (ret == LT_OK) {
+        ret = write(write_ctx, "\n]}\n", 4);
+    }
+
+    return ret;
+}
@@ -0,0 +1,409 @@
+/**
+ * @file lt_avp_benchmark.c
+ * @brief Benchmark of the AVP operations under an agent workload, see lt_avp_benchmark_run().
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_port.h"
+#include "lt_benchmark.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+/** @brief PIN of the benchmarked vault. */
+#define AVP_BENCH_PIN "bench-1234"
+
+/** @brief Session TTL of the benchmarked vault, long enough for the whole run. */
+#define AVP_BENCH_TTL_S 3600
+
+/** @brief Length of the signed message, i.e. a digest. */
+#define AVP_BENCH_SIGN_MSG_LEN 32
+
+/** @brief Longest length of a benchmark secret name. */
+#define AVP_BENCH_NAME_LEN 32
+
+/** @brief Names of the signing keys. */
+#define AVP_BENCH_KEY_ED25519 "bench/key-ed25519"
+#define AVP_BENCH_KEY_P256 "bench/key-p256"
+
+static const uint16_t value_lens[] = {LT_AVP_BENCH_VALUE_LENS};
+
+#define AVP_BENCH_SECRETS (sizeof(value_lens) / sizeof(value_lens[0]))
+
+/**
+ * @brief One benchmarked AVP operation.
+ */
+typedef struct avp_bench_t {
+    /** @brief Name of the benchmarked AVP operation. */
+    const char *name;
+    /** @brief Bytes of the values the operation is done on. */
+    uint32_t value_bytes;
+    /** @brief Benchmark secret the operation is done on, AVP_BENCH_SECRETS for all of them or none. */
+    size_t secret;
+    /** @brief Called before each measured call and not measured, may be NULL. */
+    avp_ret_t (*prepare)(const struct avp_bench_t *b);
+    /** @brief Measured call. */
+    avp_ret_t (*run)(const struct avp_bench_t *b);
+} avp_bench_t;
+
+// Shared with cleanup function
+static lt_handle_t *g_h;
+static avp_vault_t vault;
+
+/** @brief L2 Responses of plain L2 Requests and L3 Results received since start, counted by the wrappers below. */
+static uint64_t l2_reqs, l3_cmds;
+
+static uint32_t samples[LT_AVP_BENCH_ITERATIONS];
+
+static char names[AVP_BENCH_SECRETS][AVP_BENCH_NAME_LEN];
+static const char *name_ptrs[AVP_BENCH_SECRETS];
+static uint8_t value[LT_AVP_BENCH_VALUE_LEN_MAX], retrieved[LT_AVP_BENCH_VALUE_LEN_MAX];
+static avp_retrieve_item_t items[AVP_BENCH_SECRETS];
+static avp_secret_metadata_t metas[AVP_BENCH_SECRETS];
+static uint8_t msg[AVP_BENCH_SIGN_MSG_LEN], signature[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+
+// The AVP benchmark is linked with `--wrap=lt_l2_receive` and `--wrap=lt_l2_recv_encrypted_res`, so every chip
+// round-trip done by the AVP layer and libtropic goes through these wrappers. Resends inside libtropic_l2.c are not
+// counted.
+lt_ret_t __real_lt_l2_receive(lt_l2_state_t *s2);
+lt_ret_t __wrap_lt_l2_receive(lt_l2_state_t *s2);
+
+lt_ret_t __wrap_lt_l2_receive(lt_l2_state_t *s2)
+{
+    l2_reqs++;
+    return __real_lt_l2_receive(s2);
+}
+
+lt_ret_t __real_lt_l2_recv_encrypted_res(lt_l2_state_t *s2, uint8_t *buff, uint16_t max_len);
+lt_ret_t __wrap_lt_l2_recv_encrypted_res(lt_l2_state_t *s2, uint8_t *buff, uint16_t max_len);
+
+lt_ret_t __wrap_lt_l2_recv_encrypted_res(lt_l2_state_t *s2, uint8_t *buff, uint16_t max_len)
+{
+    l3_cmds++;
+    return __real_lt_l2_recv_encrypted_res(s2, buff, max_len);
+}
+
+#ifdef LT_L3_STREAM_DECRYPT
+lt_ret_t __real_lt_l2_recv_encrypted_res_stream(lt_l2_state_t *s2, lt_l2_chunk_cb_t cb, void *cb_ctx);
+lt_ret_t __wrap_lt_l2_recv_encrypted_res_stream(lt_l2_state_t *s2, lt_l2_chunk_cb_t cb, void *cb_ctx);
+
+lt_ret_t __wrap_lt_l2_recv_encrypted_res_stream(lt_l2_state_t *s2, lt_l2_chunk_cb_t cb, void *cb_ctx)
+{
+    l3_cmds++;
+    return __real_lt_l2_recv_encrypted_res_stream(s2, cb, cb_ctx);
+}
+#endif
+
+/** @brief Initializes the vault on the device of the benchmark handle and starts its Secure Session. */
+static avp_ret_t vault_open(void)
+{
+    vault.lt_handle.l3.crypto_ctx = g_h->l3.crypto_ctx;
+    avp_ret_t ret = avp_init(&vault, g_h->l2.device);
+    if (ret != AVP_OK) {
+        return ret;
+    }
+
+    lt_ret_t lt_ret = lt_verify_chip_and_start_secure_session(&vault.lt_handle, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB,
+                                                              TR01_PAIRING_KEY_SLOT_INDEX_0);
+    if (lt_ret != LT_OK) {
+        LT_LOG_ERROR("Failed to establish secure session, ret=%s", lt_ret_verbose(lt_ret));
+        (void)avp_deinit(&vault);
+        return AVP_ERR_HARDWARE_ERROR;
+    }
+
+    return AVP_OK;
+}
+
+static avp_ret_t bench_deinit(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    return avp_deinit(&vault);
+}
+
+/** @brief Cold start of an agent: handle initialization, Secure Session and the first AUTHENTICATE. */
+static avp_ret_t bench_cold_start(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    avp_ret_t ret = vault_open();
+    if (ret != AVP_OK) {
+        return ret;
+    }
+
+    return avp_authenticate(&vault, NULL, AVP_BENCH_PIN, AVP_BENCH_TTL_S);
+}
+
+static avp_ret_t bench_authenticate(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    return avp_authenticate(&vault, NULL, AVP_BENCH_PIN, AVP_BENCH_TTL_S);
+}
+
+static avp_ret_t bench_retrieve(const avp_bench_t *b)
+{
+    size_t len = sizeof(retrieved);
+    avp_ret_t ret = avp_retrieve(&vault, names[b->secret], retrieved, &len);
+    if ((ret == AVP_OK) && (len != value_lens[b->secret])) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    return ret;
+}
+
+static avp_ret_t bench_retrieve_many(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    // Values are not checked, so all of them are read into one buffer.
+    for (size_t i = 0; i < AVP_BENCH_SECRETS; i++) {
+        items[i] = (avp_retrieve_item_t){.value = retrieved, .value_len = sizeof(retrieved)};
+    }
+
+    return avp_retrieve_many(&vault, name_ptrs, items, AVP_BENCH_SECRETS);
+}
+
+static avp_ret_t bench_list(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    size_t count;
+    return avp_list(&vault, metas, AVP_BENCH_SECRETS, &count);
+}
+
+/** @brief Changes the value, so every rotation stores a new one. */
+static avp_ret_t bench_value_change(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    value[0]++;
+    return AVP_OK;
+}
+
+static avp_ret_t bench_store(const avp_bench_t *b)
+{
+    return avp_store(&vault, names[b->secret], value, value_lens[b->secret]);
+}
+
+/** @brief Rotation of all benchmark secrets in one batch. */
+static avp_ret_t bench_store_batch(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    avp_ret_t ret = avp_batch_begin(&vault);
+    for (size_t i = 0; (ret == AVP_OK) && (i < AVP_BENCH_SECRETS); i++) {
+        ret = avp_store(&vault, names[i], value, value_lens[i]);
+    }
+    if (ret != AVP_OK) {
+        return ret;
+    }
+
+    return avp_batch_commit(&vault);
+}
+
+static avp_ret_t bench_sign_ed25519(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    size_t len = sizeof(signature);
+    return avp_hw_sign(&vault, AVP_BENCH_KEY_ED25519, msg, sizeof(msg), signature, &len);
+}
+
+static avp_ret_t bench_sign_p256(const avp_bench_t *b)
+{
+    LT_UNUSED(b);
+    size_t len = sizeof(signature);
+    return avp_hw_sign(&vault, AVP_BENCH_KEY_P256, msg, sizeof(msg), signature, &len);
+}
+
+static int cmp_samples(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/** @brief Nearest-rank percentile of the sorted samples. */
+static uint32_t percentile(const uint32_t *sorted, uint16_t cnt, uint8_t p)
+{
+    uint32_t rank = ((uint32_t)p * cnt + 99) / 100;
+    return sorted[rank ? rank - 1 : 0];
+}
+
+static void run_bench(const avp_bench_t *b)
+{
+    uint64_t total_l2 = 0, total_l3 = 0, t0, l2_0, l3_0;
+    avp_ret_t ret;
+
+    LT_LOG_INFO("Benchmarking %s (%" PRIu32 " B) %d times...", b->name, b->value_bytes, LT_AVP_BENCH_ITERATIONS);
+    for (uint16_t i = 0; i < LT_AVP_BENCH_ITERATIONS; i++) {
+        if (b->prepare) {
+            ret = b->prepare(b);
+            if (AVP_OK != ret) {
+                LT_LOG_ERROR("Preparation of %s failed, ret=%s", b->name, avp_strerror(ret));
+                LT_TEST_ASSERT(AVP_OK, ret);
+            }
+        }
+
+        l2_0 = l2_reqs;
+        l3_0 = l3_cmds;
+        t0 = lt_bench_time_us();
+        ret = b->run(b);
+        samples[i] = (uint32_t)(lt_bench_time_us() - t0);
+        total_l2 += l2_reqs - l2_0;
+        total_l3 += l3_cmds - l3_0;
+
+        if (AVP_OK != ret) {
+            LT_LOG_ERROR("%s failed, ret=%s", b->name, avp_strerror(ret));
+            LT_TEST_ASSERT(AVP_OK, ret);
+        }
+    }
+
+    qsort(samples, LT_AVP_BENCH_ITERATIONS, sizeof(samples[0]), cmp_samples);
+
+    // Round-trips per operation are logged with two decimals.
+    const uint32_t l2_x100 = (uint32_t)(total_l2 * 100 / LT_AVP_BENCH_ITERATIONS);
+    const uint32_t l3_x100 = (uint32_t)(total_l3 * 100 / LT_AVP_BENCH_ITERATIONS);
+    const uint32_t rt_x100 = l2_x100 + l3_x100;
+
+    lt_port_log("{\"avp_benchmark\":\"%s\",\"value_bytes\":%" PRIu32 ",\"iterations\":%d,\"min_us\":%" PRIu32
+                ",\"p50_us\":%" PRIu32 ",\"p99_us\":%" PRIu32 ",\"max_us\":%" PRIu32 ",\"l2_reqs\":%" PRIu32
+                ".%02" PRIu32 ",\"l3_cmds\":%" PRIu32 ".%02" PRIu32 ",\"round_trips\":%" PRIu32 ".%02" PRIu32 "}\n",
+                b->name, b->value_bytes, LT_AVP_BENCH_ITERATIONS, samples[0],
+                percentile(samples, LT_AVP_BENCH_ITERATIONS, 50), percentile(samples, LT_AVP_BENCH_ITERATIONS, 99),
+                samples[LT_AVP_BENCH_ITERATIONS - 1], l2_x100 / 100, l2_x100 % 100, l3_x100 / 100, l3_x100 % 100,
+                rt_x100 / 100, rt_x100 % 100);
+}
+
+static lt_ret_t lt_avp_benchmark_cleanup(void)
+{
+    avp_ret_t ret;
+    lt_ret_t lt_ret;
+
+    // The vault may be left deinitialized by a failed cold start.
+    LT_LOG_INFO("Reopening the vault");
+    (void)avp_deinit(&vault);
+    ret = vault_open();
+    if (AVP_OK == ret) {
+        ret = avp_authenticate(&vault, NULL, AVP_BENCH_PIN, AVP_BENCH_TTL_S);
+    }
+    if (AVP_OK != ret) {
+        LT_LOG_ERROR("Failed to reopen the vault, ret=%s", avp_strerror(ret));
+        return LT_FAIL;
+    }
+
+    LT_LOG_INFO("Deleting the secrets and keys used by the benchmarks");
+    for (size_t i = 0; i < AVP_BENCH_SECRETS; i++) {
+        bool deleted;
+        ret = avp_delete(&vault, names[i], &deleted);
+        if (AVP_OK != ret) {
+            LT_LOG_ERROR("Failed to delete secret %s, ret=%s", names[i], avp_strerror(ret));
+            return LT_FAIL;
+        }
+    }
+    const char *keys[] = {AVP_BENCH_KEY_ED25519, AVP_BENCH_KEY_P256};
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        ret = avp_hw_key_delete(&vault, keys[i]);
+        if ((AVP_OK != ret) && (AVP_ERR_SECRET_NOT_FOUND != ret)) {
+            LT_LOG_ERROR("Failed to delete key %s, ret=%s", keys[i], avp_strerror(ret));
+            return LT_FAIL;
+        }
+    }
+    ret = avp_flush(&vault);
+    if (AVP_OK != ret) {
+        LT_LOG_ERROR("Failed to flush the vault, ret=%s", avp_strerror(ret));
+        return LT_FAIL;
+    }
+
+    // Next run sets the PIN again.
+    LT_LOG_INFO("Erasing the PIN slot");
+    lt_ret = lt_r_mem_data_erase(&vault.lt_handle, AVP_PIN_SLOT);
+    if (LT_OK != lt_ret) {
+        LT_LOG_ERROR("Failed to erase R-Memory slot.");
+        return lt_ret;
+    }
+
+    LT_LOG_INFO("Aborting secure session");
+    lt_ret = lt_session_abort(&vault.lt_handle);
+    if (LT_OK != lt_ret) {
+        LT_LOG_ERROR("Failed to abort secure session.");
+        return lt_ret;
+    }
+
+    LT_LOG_INFO("Deinitializing the vault");
+    ret = avp_deinit(&vault);
+    if (AVP_OK != ret) {
+        LT_LOG_ERROR("Failed to deinitialize the vault.");
+        return LT_FAIL;
+    }
+
+    return LT_OK;
+}
+
+void lt_avp_benchmark_run(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_avp_benchmark_run()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    g_h = h;
+
+    LT_LOG_INFO("Initializing the vault and starting Secure Session with key %d", (int)TR01_PAIRING_KEY_SLOT_INDEX_0);
+    LT_TEST_ASSERT(AVP_OK, vault_open());
+
+    // A PIN left by an interrupted run is the benchmark PIN as well.
+    LT_LOG_INFO("Setting the PIN and authenticating");
+    avp_ret_t ret = avp_set_pin(&vault, NULL, AVP_BENCH_PIN);
+    LT_TEST_ASSERT(1, (AVP_OK == ret) || (AVP_ERR_AUTHENTICATION_FAILED == ret));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, AVP_BENCH_PIN, AVP_BENCH_TTL_S));
+    LT_LOG_LINE();
+
+    lt_test_cleanup_function = &lt_avp_benchmark_cleanup;
+
+    LT_LOG_INFO("Storing %d secrets and generating signing keys", (int)AVP_BENCH_SECRETS);
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, value, sizeof(value)));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, msg, sizeof(msg)));
+    uint32_t values_len = 0;
+    for (size_t i = 0; i < AVP_BENCH_SECRETS; i++) {
+        LT_TEST_ASSERT(1, value_lens[i] <= LT_AVP_BENCH_VALUE_LEN_MAX);
+        values_len += value_lens[i];
+        snprintf(names[i], sizeof(names[i]), "bench/value-%" PRIu16, value_lens[i]);
+        name_ptrs[i] = names[i];
+        LT_TEST_ASSERT(AVP_OK, avp_store(&vault, names[i], value, value_lens[i]));
+    }
+    // Keys are generated again, a previous run may have left them.
+    (void)avp_hw_key_delete(&vault, AVP_BENCH_KEY_ED25519);
+    (void)avp_hw_key_delete(&vault, AVP_BENCH_KEY_P256);
+    LT_TEST_ASSERT(AVP_OK, avp_hw_key_generate(&vault, AVP_BENCH_KEY_ED25519, TR01_CURVE_ED25519));
+    LT_TEST_ASSERT(AVP_OK, avp_hw_key_generate(&vault, AVP_BENCH_KEY_P256, TR01_CURVE_P256));
+    LT_LOG_LINE();
+
+    const uint32_t last_len = value_lens[AVP_BENCH_SECRETS - 1];
+    run_bench(&(avp_bench_t){"cold_start", 0, AVP_BENCH_SECRETS, bench_deinit, bench_cold_start});
+    run_bench(&(avp_bench_t){"avp_authenticate", 0, AVP_BENCH_SECRETS, NULL, bench_authenticate});
+    for (size_t i = 0; i < AVP_BENCH_SECRETS; i++) {
+        run_bench(&(avp_bench_t){"avp_retrieve", value_lens[i], i, NULL, bench_retrieve});
+    }
+    run_bench(&(avp_bench_t){"avp_retrieve_many", values_len, AVP_BENCH_SECRETS, NULL, bench_retrieve_many});
+    run_bench(&(avp_bench_t){"avp_list", 0, AVP_BENCH_SECRETS, NULL, bench_list});
+    for (size_t i = 0; i < AVP_BENCH_SECRETS; i++) {
+        run_bench(&(avp_bench_t){"avp_store", value_lens[i], i, bench_value_change, bench_store});
+    }
+    // The value stays the same, so it shows what STORE costs when nothing changed (AVP_STORE_DEDUP).
+    run_bench(&(avp_bench_t){"avp_store_unchanged", last_len, AVP_BENCH_SECRETS - 1, NULL, bench_store});
+    run_bench(&(avp_bench_t){"avp_batch_commit", values_len, AVP_BENCH_SECRETS, bench_value_change, bench_store_batch});
+    run_bench(
+        &(avp_bench_t){"avp_hw_sign_ed25519", AVP_BENCH_SIGN_MSG_LEN, AVP_BENCH_SECRETS, NULL, bench_sign_ed25519});
+    run_bench(&(avp_bench_t){"avp_hw_sign_p256", AVP_BENCH_SIGN_MSG_LEN, AVP_BENCH_SECRETS, NULL, bench_sign_p256});
+    LT_LOG_LINE();
+
+    // Call cleanup function, but don't call it from LT_TEST_ASSERT anymore.
+    lt_test_cleanup_function = NULL;
+    LT_LOG_INFO("Starting post-benchmark cleanup");
+    LT_TEST_ASSERT(LT_OK, lt_avp_benchmark_cleanup());
+    LT_LOG_INFO("Post-benchmark cleanup was successful");
+}
@@ -0,0 +1,20 @@
+/**
+ * @file lt_bench_clock_esp_idf.c
+ * @brief Benchmark clock and memory probe for ESP-IDF host platforms.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "lt_benchmark.h"
+
+uint64_t lt_bench_time_us(void) { return (uint64_t)esp_timer_get_time(); }
+
+uint64_t lt_bench_mem_bytes(void)
+{
+    return (uint64_t)(heap_caps_get_total_size(MALLOC_CAP_DEFAULT) - heap_caps_get_free_size(MALLOC_CAP_DEFAULT));
+}
@@ -0,0 +1,36 @@
+/**
+ * @file lt_bench_clock_posix.c
+ * @brief Benchmark clock and memory probe for POSIX host platforms (model, Linux SPI, USB devkit).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "lt_benchmark.h"
+
+uint64_t lt_bench_time_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+uint64_t lt_bench_mem_bytes(void)
+{
+    struct rusage ru;
+
+    if (getrusage(RUSAGE_SELF, &ru) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return (uint64_t)ru.ru_maxrss;
+#else
+    // Linux reports kilobytes.
+    return (uint64_t)ru.ru_maxrss * 1024;
+#endif
+}
@@ -0,0 +1,35 @@
+/**
+ * @file lt_bench_clock_stm32.c
+ * @brief Benchmark clock for STM32 host platforms, built from the HAL tick and the SysTick counter.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "lt_benchmark.h"
+
+// SysTick registers are architectural on all Cortex-M cores, so they are accessed directly and the benchmarks
+// do not depend on the device headers of the particular STM32 family.
+#define SYST_LOAD (*(volatile const uint32_t *)0xE000E014UL)
+#define SYST_VAL (*(volatile const uint32_t *)0xE000E018UL)
+
+// Provided by the STM32 HAL, SysTick is configured by HAL_Init() to interrupt every 1 ms.
+uint32_t HAL_GetTick(void);
+
+uint64_t lt_bench_time_us(void)
+{
+    uint32_t tick, val, load = SYST_LOAD;
+
+    // Read again if the tick was incremented meanwhile, SysTick counts down to 0 and reloads.
+    do {
+        tick = HAL_GetTick();
+        val = SYST_VAL;
+    } while (tick != HAL_GetTick());
+
+    return (uint64_t)tick * 1000 + (uint64_t)(load - val) * 1000 / (load + 1);
+}
+
+// Libtropic does not allocate and the STM32 HALs have no heap accounting, so memory is not measured.
+uint64_t lt_bench_mem_bytes(void) { return 0; }
@@ -0,0 +1,372 @@
+/**
+ * @file lt_benchmark.c
+ * @brief Microbenchmarks of the libtropic API, see lt_benchmark_run().
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include "lt_benchmark.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+/** @brief Maximal possible size of UDATA slot in User R-Memory accross all Application FWs. */
+#define R_MEM_DATA_SIZE_MAX 475
+
+/** @brief Length of the buffers for certificates. */
+#define CERTS_BUF_LEN 700
+
+/** @brief Length of the short Ping message. */
+#define PING_SHORT_LEN 32
+
+/** @brief Length of the signed message, i.e. a digest. */
+#define SIGN_MSG_LEN 32
+
+/** @brief Maximal length of the message signed by lt_ecc_eddsa_sign(), it has to fit into one L3 Command. */
+#define EDDSA_MSG_LEN_MAX 4096
+
+#ifdef LT_EDDSA_SIGN_STREAM
+/** @brief Length of the message prehashed by the EdDSA streaming benchmark, longer than one L3 Command. */
+#define BENCH_EDDSA_STREAM_MSG_LEN (4 * EDDSA_MSG_LEN_MAX)
+#endif
+
+#ifdef LT_ED25519_VERIFY
+/** @brief Number of signatures verified by one call of the batch verification benchmark. */
+#define BENCH_ED25519_BATCH 32
+#endif
+
+/** @brief Slot with the P256 key used by the ECDSA benchmark. */
+#define BENCH_ECDSA_SLOT TR01_ECC_SLOT_31
+
+/** @brief Slot with the Ed25519 key used by the EdDSA benchmark. */
+#define BENCH_EDDSA_SLOT TR01_ECC_SLOT_30
+
+/** @brief User Data slot used by the R-Memory benchmarks. */
+#define BENCH_R_MEM_SLOT TR01_R_MEM_DATA_SLOT_MAX
+
+/**
+ * @brief One benchmarked call.
+ */
+typedef struct lt_bench_t {
+    /** @brief Name of the benchmarked API function. */
+    const char *name;
+    /** @brief Number of payload bytes processed by one call, used for throughput. */
+    uint16_t payload_len;
+    /** @brief Called before each measured call and not measured, may be NULL. */
+    lt_ret_t (*prepare)(lt_handle_t *h);
+    /** @brief Measured call. */
+    lt_ret_t (*run)(lt_handle_t *h);
+} lt_bench_t;
+
+// Shared with cleanup function
+static lt_handle_t *g_h;
+
+/** @brief Bytes clocked over SPI since start, counted by the wrappers below. */
+static uint64_t wire_bytes;
+
+static uint32_t samples[LT_BENCH_ITERATIONS];
+
+static uint8_t msg_out[TR01_PING_LEN_MAX], msg_in[TR01_PING_LEN_MAX], rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+static uint8_t r_mem_data[R_MEM_DATA_SIZE_MAX];
+static uint16_t r_mem_data_len;
+static uint8_t stpub[TR01_STPUB_LEN];
+static uint8_t cert1[CERTS_BUF_LEN], cert2[CERTS_BUF_LEN], cert3[CERTS_BUF_LEN], cert4[CERTS_BUF_LEN];
+static struct lt_cert_store_t store = {.certs = {cert1, cert2, cert3, cert4},
+                                       .buf_len = {CERTS_BUF_LEN, CERTS_BUF_LEN, CERTS_BUF_LEN, CERTS_BUF_LEN}};
+#ifdef LT_ED25519_VERIFY
+static uint8_t verify_pubkey[TR01_CURVE_ED25519_PUBKEY_LEN];
+static uint8_t verify_rs[BENCH_ED25519_BATCH][TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+static lt_ed25519_verify_t verify_items[BENCH_ED25519_BATCH];
+#endif
+
+// The benchmark is linked with `--wrap=lt_port_spi_transfer` (and `--wrap=lt_port_spi_transfer_v`), so every L1
+// transfer of libtropic goes through these wrappers, whichever HAL is used.
+lt_ret_t __real_lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms);
+lt_ret_t __wrap_lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms);
+
+lt_ret_t __wrap_lt_port_spi_transfer(lt_l2_state_t *s2, uint8_t offset, uint16_t tx_len, uint32_t timeout_ms)
+{
+    wire_bytes += tx_len;
+    return __real_lt_port_spi_transfer(s2, offset, tx_len, timeout_ms);
+}
+
+#ifdef LT_PORT_SPI_TRANSFER_V
+lt_ret_t __real_lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                       uint32_t timeout_ms);
+lt_ret_t __wrap_lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                       uint32_t timeout_ms);
+
+lt_ret_t __wrap_lt_port_spi_transfer_v(lt_l2_state_t *s2, const lt_spi_seg_t *segs, uint8_t seg_cnt, uint8_t flags,
+                                       uint32_t timeout_ms)
+{
+    for (uint8_t i = 0; i < seg_cnt; i++) {
+        wire_bytes += segs[i].len;
+    }
+    return __real_lt_port_spi_transfer_v(s2, segs, seg_cnt, flags, timeout_ms);
+}
+#endif
+
+static lt_ret_t bench_ping_short(lt_handle_t *h) { return lt_ping(h, msg_out, msg_in, PING_SHORT_LEN); }
+
+static lt_ret_t bench_ping_long(lt_handle_t *h) { return lt_ping(h, msg_out, msg_in, TR01_PING_LEN_MAX); }
+
+static lt_ret_t bench_random_value_get(lt_handle_t *h)
+{
+    return lt_random_value_get(h, msg_in, TR01_RANDOM_VALUE_GET_LEN_MAX);
+}
+
+static lt_ret_t bench_ecdsa_sign(lt_handle_t *h)
+{
+    return lt_ecc_ecdsa_sign(h, BENCH_ECDSA_SLOT, msg_out, SIGN_MSG_LEN, rs);
+}
+
+static lt_ret_t bench_eddsa_sign(lt_handle_t *h)
+{
+    return lt_ecc_eddsa_sign(h, BENCH_EDDSA_SLOT, msg_out, SIGN_MSG_LEN, rs);
+}
+
+static lt_ret_t bench_eddsa_sign_max(lt_handle_t *h)
+{
+    return lt_ecc_eddsa_sign(h, BENCH_EDDSA_SLOT, msg_out, EDDSA_MSG_LEN_MAX, rs);
+}
+
+#ifdef LT_EDDSA_SIGN_STREAM
+static lt_ret_t bench_eddsa_sign_stream(lt_handle_t *h)
+{
+    lt_eddsa_sign_t s;
+    lt_ret_t ret = lt_eddsa_sign_init(&s, h, BENCH_EDDSA_SLOT);
+    for (uint16_t i = 0; (ret == LT_OK) && (i < BENCH_EDDSA_STREAM_MSG_LEN / EDDSA_MSG_LEN_MAX); i++) {
+        ret = lt_eddsa_sign_update(&s, msg_out, EDDSA_MSG_LEN_MAX);
+    }
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_eddsa_sign_final(&s, rs);
+}
+#endif
+
+#ifdef LT_ED25519_VERIFY
+static lt_ret_t bench_ed25519_verify(lt_handle_t *h)
+{
+    LT_UNUSED(h);
+    return lt_ed25519_verify_batch(verify_items, 1);
+}
+
+static lt_ret_t bench_ed25519_verify_batch(lt_handle_t *h)
+{
+    LT_UNUSED(h);
+    return lt_ed25519_verify_batch(verify_items, BENCH_ED25519_BATCH);
+}
+#endif
+
+static lt_ret_t bench_r_mem_erase(lt_handle_t *h) { return lt_r_mem_data_erase(h, BENCH_R_MEM_SLOT); }
+
+static lt_ret_t bench_r_mem_write(lt_handle_t *h)
+{
+    return lt_r_mem_data_write(h, BENCH_R_MEM_SLOT, r_mem_data, r_mem_data_len);
+}
+
+static lt_ret_t bench_r_mem_read(lt_handle_t *h)
+{
+    uint16_t read_size;
+    return lt_r_mem_data_read(h, BENCH_R_MEM_SLOT, msg_in, sizeof(msg_in), &read_size);
+}
+
+static lt_ret_t bench_session_abort(lt_handle_t *h) { return lt_session_abort(h); }
+
+static lt_ret_t bench_session_start(lt_handle_t *h)
+{
+    return lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB);
+}
+
+static lt_ret_t bench_get_info_cert_store(lt_handle_t *h) { return lt_get_info_cert_store(h, &store); }
+
+static int cmp_samples(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/** @brief Nearest-rank percentile of the sorted samples. */
+static uint32_t percentile(const uint32_t *sorted, uint16_t cnt, uint8_t p)
+{
+    uint32_t rank = ((uint32_t)p * cnt + 99) / 100;
+    return sorted[rank ? rank - 1 : 0];
+}
+
+static void run_bench(lt_handle_t *h, const lt_bench_t *b)
+{
+    uint64_t total_us = 0, total_wire = 0, t0, wire0;
+    lt_ret_t ret;
+
+    LT_LOG_INFO("Benchmarking %s (%" PRIu16 " B) %d times...", b->name, b->payload_len, LT_BENCH_ITERATIONS);
+    for (uint16_t i = 0; i < LT_BENCH_ITERATIONS; i++) {
+        if (b->prepare) {
+            ret = b->prepare(h);
+            if (LT_OK != ret) {
+                LT_LOG_ERROR("Preparation of %s failed, ret=%s", b->name, lt_ret_verbose(ret));
+                LT_TEST_ASSERT(LT_OK, ret);
+            }
+        }
+
+        wire0 = wire_bytes;
+        t0 = lt_bench_time_us();
+        ret = b->run(h);
+        samples[i] = (uint32_t)(lt_bench_time_us() - t0);
+        total_wire += wire_bytes - wire0;
+
+        if (LT_OK != ret) {
+            LT_LOG_ERROR("%s failed, ret=%s", b->name, lt_ret_verbose(ret));
+            LT_TEST_ASSERT(LT_OK, ret);
+        }
+        total_us += samples[i];
+    }
+
+    qsort(samples, LT_BENCH_ITERATIONS, sizeof(samples[0]), cmp_samples);
+
+    uint32_t mean_us = (uint32_t)(total_us / LT_BENCH_ITERATIONS);
+    uint32_t throughput = mean_us ? (uint32_t)((uint64_t)b->payload_len * 1000000 / mean_us) : 0;
+
+    lt_port_log("{\"benchmark\":\"%s\",\"payload_bytes\":%" PRIu16 ",\"iterations\":%d,\"min_us\":%" PRIu32
+                ",\"p50_us\":%" PRIu32 ",\"p99_us\":%" PRIu32 ",\"max_us\":%" PRIu32 ",\"throughput_bps\":%" PRIu32
+                ",\"wire_bytes\":%" PRIu32 "}\n",
+                b->name, b->payload_len, LT_BENCH_ITERATIONS, samples[0], percentile(samples, LT_BENCH_ITERATIONS, 50),
+                percentile(samples, LT_BENCH_ITERATIONS, 99), samples[LT_BENCH_ITERATIONS - 1], throughput,
+                (uint32_t)(total_wire / LT_BENCH_ITERATIONS));
+}
+
+static lt_ret_t lt_benchmark_cleanup(void)
+{
+    lt_ret_t ret;
+
+    LT_LOG_INFO("Starting secure session with slot %d", (int)TR01_PAIRING_KEY_SLOT_INDEX_0);
+    ret = lt_verify_chip_and_start_secure_session(g_h, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB,
+                                                  TR01_PAIRING_KEY_SLOT_INDEX_0);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to establish secure session.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Erasing ECC key slots and R-Memory slot used by the benchmarks");
+    ret = lt_ecc_key_erase(g_h, BENCH_ECDSA_SLOT);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to erase ECC key slot.");
+        return ret;
+    }
+    ret = lt_ecc_key_erase(g_h, BENCH_EDDSA_SLOT);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to erase ECC key slot.");
+        return ret;
+    }
+    ret = lt_r_mem_data_erase(g_h, BENCH_R_MEM_SLOT);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to erase R-Memory slot.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Aborting secure session");
+    ret = lt_session_abort(g_h);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to abort secure session.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Deinitializing handle");
+    ret = lt_deinit(g_h);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to deinitialize handle.");
+        return ret;
+    }
+
+    return LT_OK;
+}
+
+void lt_benchmark_run(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_benchmark_run()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    g_h = h;
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Reading certificate store and STPUB");
+    LT_TEST_ASSERT(LT_OK, lt_get_info_cert_store(h, &store));
+    LT_TEST_ASSERT(LT_OK, lt_get_st_pub(&store, stpub));
+
+    LT_LOG_INFO("Starting Secure Session with key %d", (int)TR01_PAIRING_KEY_SLOT_INDEX_0);
+    LT_TEST_ASSERT(LT_OK, lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB));
+    LT_LOG_LINE();
+
+    lt_test_cleanup_function = &lt_benchmark_cleanup;
+
+    LT_LOG_INFO("Preparing keys, messages and R-Memory data");
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, msg_out, sizeof(msg_out)));
+    r_mem_data_len = h->tr01_attrs.r_mem_udata_slot_size_max;
+    if (r_mem_data_len > sizeof(r_mem_data)) {
+        r_mem_data_len = sizeof(r_mem_data);
+    }
+    memcpy(r_mem_data, msg_out, r_mem_data_len);
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_generate(h, BENCH_ECDSA_SLOT, TR01_CURVE_P256));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_generate(h, BENCH_EDDSA_SLOT, TR01_CURVE_ED25519));
+#ifdef LT_ED25519_VERIFY
+    lt_ecc_curve_type_t curve;
+    lt_ecc_key_origin_t origin;
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_read(h, BENCH_EDDSA_SLOT, verify_pubkey, sizeof(verify_pubkey), &curve, &origin));
+    for (int i = 0; i < BENCH_ED25519_BATCH; i++) {
+        // Every signature is made over a different part of the random message.
+        LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, BENCH_EDDSA_SLOT, msg_out + i, SIGN_MSG_LEN, verify_rs[i]));
+        verify_items[i] = (lt_ed25519_verify_t){
+            .pubkey = verify_pubkey, .msg = msg_out + i, .msg_len = SIGN_MSG_LEN, .signature = verify_rs[i]};
+    }
+    LT_TEST_ASSERT(LT_OK, lt_ed25519_verify_batch(verify_items, BENCH_ED25519_BATCH));
+#endif
+    uint16_t certs_len = 0;
+    for (int i = 0; i < LT_NUM_CERTIFICATES; i++) {
+        certs_len += store.cert_len[i];
+    }
+    LT_LOG_LINE();
+
+    const lt_bench_t benches[] = {
+        {"lt_ping", PING_SHORT_LEN, NULL, bench_ping_short},
+        {"lt_ping", TR01_PING_LEN_MAX, NULL, bench_ping_long},
+        {"lt_random_value_get", TR01_RANDOM_VALUE_GET_LEN_MAX, NULL, bench_random_value_get},
+        {"lt_ecc_ecdsa_sign", SIGN_MSG_LEN, NULL, bench_ecdsa_sign},
+        {"lt_ecc_eddsa_sign", SIGN_MSG_LEN, NULL, bench_eddsa_sign},
+        {"lt_ecc_eddsa_sign", EDDSA_MSG_LEN_MAX, NULL, bench_eddsa_sign_max},
+#ifdef LT_EDDSA_SIGN_STREAM
+        {"lt_eddsa_sign_final", BENCH_EDDSA_STREAM_MSG_LEN, NULL, bench_eddsa_sign_stream},
+#endif
+#ifdef LT_ED25519_VERIFY
+        {"lt_ed25519_verify_batch", SIGN_MSG_LEN, NULL, bench_ed25519_verify},
+        {"lt_ed25519_verify_batch", BENCH_ED25519_BATCH * SIGN_MSG_LEN, NULL, bench_ed25519_verify_batch},
+#endif
+        {"lt_r_mem_data_write", r_mem_data_len, bench_r_mem_erase, bench_r_mem_write},
+        {"lt_r_mem_data_read", r_mem_data_len, NULL, bench_r_mem_read},
+        {"lt_session_start", 0, bench_session_abort, bench_session_start},
+        {"lt_get_info_cert_store", certs_len, NULL, bench_get_info_cert_store},
+    };
+
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        run_bench(h, &benches[i]);
+    }
+    LT_LOG_LINE();
+
+    // Call cleanup function, but don't call it from LT_TEST_ASSERT anymore.
+    lt_test_cleanup_function = NULL;
+    LT_LOG_INFO("Starting post-benchmark cleanup");
+    LT_TEST_ASSERT(LT_OK, lt_benchmark_cleanup());
+    LT_LOG_INFO("Post-benchmark cleanup was successful");
+}
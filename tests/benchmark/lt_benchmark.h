@@ -0,0 +1,208 @@
+#ifndef LT_BENCHMARK_H
+#define LT_BENCHMARK_H
+
+/**
+ * @file lt_benchmark.h
+ * @brief Microbenchmarks of the libtropic API, built instead of functional tests when `LT_BENCHMARK` is enabled.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Number of measured calls of each benchmarked function. */
+#ifndef LT_BENCH_ITERATIONS
+#define LT_BENCH_ITERATIONS 100
+#endif
+
+/**
+ * @brief Platform clock used by the benchmarks, see `tests/benchmark/lt_bench_clock_*.c`.
+ *
+ * @return Monotonic time in microseconds, the starting point is arbitrary
+ */
+uint64_t lt_bench_time_us(void);
+
+/**
+ * @brief Platform memory probe used by the soak test, implemented next to lt_bench_time_us().
+ *
+ * @return Memory used by the host process in bytes (peak resident set size on POSIX, used heap on ESP-IDF),
+ *         0 if the platform does not measure it
+ */
+uint64_t lt_bench_mem_bytes(void);
+
+/**
+ * @brief Measures latency, throughput and bytes-on-wire of the main libtropic API functions.
+ *
+ * Each of `lt_ping`, `lt_random_value_get`, `lt_ecc_ecdsa_sign`, `lt_ecc_eddsa_sign`, `lt_r_mem_data_write`,
+ * `lt_r_mem_data_read`, `lt_session_start` and `lt_get_info_cert_store` is called `LT_BENCH_ITERATIONS` times
+ * and one JSON object per line is logged with the result, e.g.:
+ *
+ * `{"benchmark":"lt_ping","payload_bytes":4096,"iterations":100,"min_us":..,"p50_us":..,"p99_us":..,"max_us":..,
+ * "throughput_bps":..,"wire_bytes":..}`
+ *
+ * `throughput_bps` is payload bytes per second over the mean latency and `wire_bytes` is the mean number of bytes
+ * clocked over SPI per call (counted around `lt_port_spi_transfer()`).
+ *
+ * With `LT_ED25519_VERIFY`, host-side `lt_ed25519_verify_batch` is measured for one signature and for a batch of
+ * signatures made by TROPIC01, the payload is the length of the signed messages.
+ *
+ * @note ECC key slots 30 and 31 and the last R-Memory User Data slot are overwritten and erased at the end.
+ *
+ * @param h           Handle for communication with TROPIC01
+ */
+void lt_benchmark_run(lt_handle_t *h);
+
+/**
+ * @brief Measures latency and throughput of the CAL primitives as libtropic uses them, without TROPIC01.
+ *
+ * Built instead of functional tests when `LT_CAL_BENCHMARK` is enabled, so the CALs can be compared on each platform.
+ * AES-GCM encryption and decryption of 32 B and 4096 B with 12 B IV and no AAD, the handshake transcript hash of
+ * `lt_session_start`, `lt_hmac_sha256`, one HKDF of `lt_hkdf`, and X25519 key generation and DH are each called
+ * `LT_BENCH_ITERATIONS` times. The result is logged as by lt_benchmark_run(), without `wire_bytes`.
+ *
+ * @param h           Handle with the CAL context, the handle is not initialized
+ */
+void lt_cal_benchmark_run(lt_handle_t *h);
+
+/** @brief Number of L3 operations of the soak test. */
+#ifndef LT_SOAK_OPS
+#define LT_SOAK_OPS 1000000
+#endif
+
+/** @brief Number of operations in one reporting window of the soak test. */
+#ifndef LT_SOAK_WINDOW
+#define LT_SOAK_WINDOW 10000
+#endif
+
+/** @brief Weights of ECDSA sign, EdDSA sign, Random_Value_Get, R-Memory write, R-Memory read and Ping. */
+#ifndef LT_SOAK_MIX
+#define LT_SOAK_MIX 4, 4, 6, 1, 3, 2
+#endif
+
+/** @brief Nonce at which the soak test starts a new Secure Session, so sessions are re-established repeatedly. */
+#ifndef LT_SOAK_SESSION_NONCE
+#define LT_SOAK_SESSION_NONCE 100000
+#endif
+
+/** @brief Longest burst of back-to-back operations, bursts are separated by idle periods. */
+#ifndef LT_SOAK_BURST_MAX
+#define LT_SOAK_BURST_MAX 32
+#endif
+
+/** @brief Longest idle period between bursts in milliseconds, 0 runs the operations back-to-back. */
+#ifndef LT_SOAK_IDLE_MAX_MS
+#define LT_SOAK_IDLE_MAX_MS 5
+#endif
+
+/** @brief Seed of the workload generator, the same seed gives the same sequence of operations. */
+#ifndef LT_SOAK_SEED
+#define LT_SOAK_SEED 0x2545F491
+#endif
+
+/**
+ * @brief Runs a long mix of L3 operations in one Secure Session after another and reports drift of the run.
+ *
+ * Built instead of functional tests when `LT_SOAK` is enabled. `LT_SOAK_OPS` operations are drawn by a seeded
+ * generator with the weights of `LT_SOAK_MIX`, in bursts of up to `LT_SOAK_BURST_MAX` operations separated by idle
+ * periods of up to `LT_SOAK_IDLE_MAX_MS`. Payload lengths are random, data read from R-Memory are compared with the
+ * data written last. A new Secure Session is started when the nonce reaches `LT_SOAK_SESSION_NONCE` or an operation
+ * returns `LT_NONCE_OVERFLOW`.
+ *
+ * After every `LT_SOAK_WINDOW` operations, one JSON object per line is logged for each operation, e.g.:
+ *
+ * `{"soak":"lt_ping","window":3,"calls":..,"p50_us":..,"p99_us":..,"max_us":..,"drift_p50_pct":..}`
+ *
+ * where the drift is the change of the median against the first window, and one object for the whole run:
+ *
+ * `{"soak":"window","window":3,"ops":..,"elapsed_s":..,"sessions":..,"nonce":..,"nonce_headroom":..,
+ * "resends":..,"resends_per_mop":..,"crc_errors":..,"spi_bytes":..,"mem_bytes":..,"mem_growth_bytes":..}`
+ *
+ * Counters come from lt_get_stats(), so `LT_STATS` is required.
+ *
+ * @note ECC key slots 30 and 31 and the last R-Memory User Data slot are overwritten and erased at the end.
+ *
+ * @param h           Handle for communication with TROPIC01
+ */
+void lt_soak_run(lt_handle_t *h);
+
+/** @brief Number of boots of each variant of the boot profile. */
+#ifndef LT_BOOT_PROFILE_RUNS
+#define LT_BOOT_PROFILE_RUNS 10
+#endif
+
+/**
+ * @brief Profiles the time from the start of the application to the first signature, without and with caches.
+ *
+ * Built instead of functional tests when `LT_BOOT_PROFILE` is enabled. Each boot initializes the handle, gets the
+ * certificate store, parses STPUB, verifies the certificate chain (with `LT_CERT_CHAIN`), starts the Secure Session
+ * and signs a 32 B message by `lt_ecc_ecdsa_sign`, then the session is aborted and the handle deinitialized. The cold
+ * boot does it `LT_BOOT_PROFILE_RUNS` times without caches, the warm boot as many times with the caches enabled in
+ * the build and filled beforehand: `lt_init_warm` (`LT_WARM_INIT`), `lt_cert_cache_get_store` (`LT_CERT_CACHE`),
+ * CA certificates in the memo of the chain verifier and `lt_session_start_cached` (`LT_SESSION_CACHE`).
+ *
+ * The mean time of each phase is split by the trace hooks into SPI transfers, waiting for TROPIC01, CRC, AES-GCM and
+ * the rest done by the host, one JSON object per line is logged for each phase and the total of each boot, e.g.:
+ *
+ * `{"boot":"warm","port":"linux_spi","phase":"lt_init_warm","runs":10,"us":..,"spi_us":..,"wait_us":..,"crc_us":..,
+ * "aes_us":..,"host_us":..,"saved_us":..}`
+ *
+ * where `saved_us` of the warm boot is the time saved against the same phase of the cold boot. Requires `LT_TRACE`.
+ *
+ * @note ECC key slot 31 is overwritten and erased at the end.
+ *
+ * @param h           Handle for communication with TROPIC01
+ */
+void lt_boot_profile_run(lt_handle_t *h);
+
+/** @brief Number of measured calls of each AVP operation, STOREs wear the R-Memory slots. */
+#ifndef LT_AVP_BENCH_ITERATIONS
+#define LT_AVP_BENCH_ITERATIONS 20
+#endif
+
+/** @brief Value lengths of the secrets of the AVP benchmark, one secret of each length. */
+#ifndef LT_AVP_BENCH_VALUE_LENS
+#define LT_AVP_BENCH_VALUE_LENS 32, 256, 1024, 4096
+#endif
+
+/** @brief Size of the value buffers of the AVP benchmark, at least the longest of `LT_AVP_BENCH_VALUE_LENS`. */
+#ifndef LT_AVP_BENCH_VALUE_LEN_MAX
+#define LT_AVP_BENCH_VALUE_LEN_MAX 4096
+#endif
+
+/**
+ * @brief Measures latency and chip round-trips of the AVP operations (avp/avp_tropic.c) under an agent workload.
+ *
+ * Built instead of functional tests when `LT_AVP_BENCHMARK` is enabled. The vault is opened on the device and CAL
+ * context of the handle, its PIN is set and one secret of each length of `LT_AVP_BENCH_VALUE_LENS` is stored. Then
+ * each operation is called `LT_AVP_BENCH_ITERATIONS` times: cold start (`avp_init`, Secure Session and the first
+ * `avp_authenticate`), repeated `avp_authenticate`, `avp_retrieve` of each secret, `avp_retrieve_many` of all of
+ * them, `avp_list`, rotation by `avp_store` of each secret, `avp_store` of an unchanged value, rotation of all
+ * secrets in one batch (`avp_batch_commit`) and `avp_hw_sign` by an Ed25519 and a P256 key. One JSON object per
+ * line is logged for each operation, e.g.:
+ *
+ * `{"avp_benchmark":"avp_retrieve","value_bytes":1024,"iterations":20,"min_us":..,"p50_us":..,"p99_us":..,
+ * "max_us":..,"l2_reqs":..,"l3_cmds":..,"round_trips":..}`
+ *
+ * where `l2_reqs` and `l3_cmds` are the mean numbers of plain L2 Requests and L3 Commands per operation (counted
+ * around `lt_l2_receive()` and `lt_l2_recv_encrypted_res()`) and `round_trips` their sum. The AVP compile-time
+ * options benchmarked (e.g. `AVP_SECRET_CACHE`) are set by `LT_AVP_BENCHMARK_DEFS`.
+ *
+ * @note The R-Memory and ECC key slots of the AVP layout are used, run it on a chip without a vault. The secrets and
+ *       keys are deleted and the PIN slot erased at the end.
+ *
+ * @param h           Handle with the device and CAL context, the handle is not initialized
+ */
+void lt_avp_benchmark_run(lt_handle_t *h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_BENCHMARK_H
@@ -0,0 +1,504 @@
+/**
+ * @file lt_boot_profile.c
+ * @brief Profile of the time to the first signature after boot, cold and with warm caches, see lt_boot_profile_run().
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port.h"
+#include "lt_benchmark.h"
+#include "lt_sha256.h"
+#include "lt_test_common.h"
+
+#ifndef LT_TRACE
+#error "The boot profile requires LT_TRACE"
+#endif
+
+#ifndef LT_BOOT_PROFILE_PORT
+#define LT_BOOT_PROFILE_PORT "unknown"
+#endif
+
+/** @brief Length of the buffers for certificates. */
+#define CERTS_BUF_LEN 700
+
+/** @brief Length of the signed message, i.e. a digest. */
+#define SIGN_MSG_LEN 32
+
+/** @brief Slot with the P256 key signing the first message. */
+#define BOOT_ECDSA_SLOT TR01_ECC_SLOT_31
+
+/**
+ * @brief Phases of the boot, in the order they are done.
+ */
+typedef enum lt_boot_phase_t {
+    BOOT_INIT,
+    BOOT_CERT_STORE,
+    BOOT_ST_PUB,
+    BOOT_CHAIN,
+    BOOT_SESSION,
+    BOOT_SIGN,
+    BOOT_PHASE_CNT
+} lt_boot_phase_t;
+
+/**
+ * @brief Time of one phase summed over the runs, split by the trace hooks.
+ */
+typedef struct lt_boot_time_t {
+    uint64_t us;
+    uint64_t spi_us;
+    uint64_t wait_us;
+    uint64_t crc_us;
+    uint64_t aes_us;
+} lt_boot_time_t;
+
+/**
+ * @brief Phases of one variant of the boot, a phase without a name was not done.
+ */
+typedef struct lt_boot_variant_t {
+    const char *name;
+    const char *phases[BOOT_PHASE_CNT];
+    lt_boot_time_t times[BOOT_PHASE_CNT];
+} lt_boot_variant_t;
+
+// Shared with cleanup function
+static lt_handle_t *g_h;
+static bool initialized;
+
+static lt_boot_variant_t cold = {.name = "cold"}, warm = {.name = "warm"};
+
+// Filled by the trace hooks during the current phase
+static lt_boot_time_t trace_time;
+static uint64_t trace_start[LT_TRACE_CAL_DECRYPT + 1];
+
+static uint8_t msg[SIGN_MSG_LEN], rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+static uint8_t stpub[TR01_STPUB_LEN];
+static uint8_t cert1[CERTS_BUF_LEN], cert2[CERTS_BUF_LEN], cert3[CERTS_BUF_LEN], cert4[CERTS_BUF_LEN];
+static struct lt_cert_store_t store = {.certs = {cert1, cert2, cert3, cert4},
+                                       .buf_len = {CERTS_BUF_LEN, CERTS_BUF_LEN, CERTS_BUF_LEN, CERTS_BUF_LEN}};
+
+#ifdef LT_WARM_INIT
+static lt_tr01_attrs_cache_t attrs_cache;
+#endif
+#ifdef LT_CERT_CACHE
+static lt_cert_cache_t cert_cache;
+static struct lt_cert_store_t cached_store;
+#endif
+#ifdef LT_CERT_CHAIN
+static lt_cert_chain_t chain;
+static bool chain_verifiable;
+#endif
+#ifdef LT_SESSION_CACHE
+static lt_session_cache_t session_cache;
+#endif
+
+static void trace_start_hook(void *ctx, lt_trace_phase_t phase, uint64_t time_us)
+{
+    LT_UNUSED(ctx);
+    trace_start[phase] = time_us;
+}
+
+/** @brief Only phases which do not nest others are summed, see lt_set_trace_hooks(). */
+static void trace_end_hook(void *ctx, lt_trace_phase_t phase, uint64_t time_us)
+{
+    LT_UNUSED(ctx);
+    const uint64_t us = time_us - trace_start[phase];
+
+    switch (phase) {
+        case LT_TRACE_L1_SPI:
+            trace_time.spi_us += us;
+            break;
+        case LT_TRACE_L1_WAIT:
+            trace_time.wait_us += us;
+            break;
+        case LT_TRACE_L2_CRC:
+            trace_time.crc_us += us;
+            break;
+        case LT_TRACE_CAL_ENCRYPT:
+        case LT_TRACE_CAL_DECRYPT:
+            trace_time.aes_us += us;
+            break;
+        default:
+            break;
+    }
+}
+
+static const lt_trace_hooks_t trace_hooks = {.start = trace_start_hook, .end = trace_end_hook, .ctx = NULL};
+
+static uint64_t phase_t0;
+
+static void phase_begin(void)
+{
+    memset(&trace_time, 0, sizeof(trace_time));
+    phase_t0 = lt_bench_time_us();
+}
+
+static void phase_end(lt_boot_variant_t *v, const lt_boot_phase_t phase, const char *name)
+{
+    lt_boot_time_t *t = &v->times[phase];
+
+    t->us += lt_bench_time_us() - phase_t0;
+    t->spi_us += trace_time.spi_us;
+    t->wait_us += trace_time.wait_us;
+    t->crc_us += trace_time.crc_us;
+    t->aes_us += trace_time.aes_us;
+    v->phases[phase] = name;
+}
+
+#ifdef LT_CERT_CHAIN
+/**
+ * @brief Accepts every signature. Signatures are verified by the crypto library of the application, the profile
+ * measures the part of the verification done by libtropic (hashing, parsing and the memo of verified CAs).
+ */
+static lt_ret_t accept_sig(const lt_cert_sig_t *sig, void *ctx)
+{
+    LT_UNUSED(sig);
+    LT_UNUSED(ctx);
+    return LT_OK;
+}
+
+/** @brief Trusts the root of the store read during setup, the profile does not check the authenticity of the chip. */
+static lt_ret_t trust_root(lt_handle_t *h, const struct lt_cert_store_t *s)
+{
+    uint8_t root_hash[LT_CERT_CHAIN_HASH_LEN];
+    const int root = LT_NUM_CERTIFICATES - 1;
+
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_sha256_start(h->l3.crypto_ctx);
+    if (ret == LT_OK) {
+        ret = lt_sha256_update(h->l3.crypto_ctx, s->certs[root], s->cert_len[root]);
+    }
+    if (ret == LT_OK) {
+        ret = lt_sha256_finish(h->l3.crypto_ctx, root_hash);
+    }
+    lt_ret_t ret_unused = lt_sha256_deinit(h->l3.crypto_ctx);
+    LT_UNUSED(ret_unused);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_cert_chain_init(&chain, root_hash);
+}
+#endif
+
+/** @brief Boots as an application without any cache does, from the handle to the first signature. */
+static lt_ret_t boot_cold(lt_handle_t *h)
+{
+    lt_ret_t ret;
+
+    phase_begin();
+    ret = lt_init(h);
+    phase_end(&cold, BOOT_INIT, "lt_init");
+    if (ret != LT_OK) {
+        return ret;
+    }
+    initialized = true;
+
+    phase_begin();
+    ret = lt_get_info_cert_store(h, &store);
+    phase_end(&cold, BOOT_CERT_STORE, "lt_get_info_cert_store");
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    phase_begin();
+    ret = lt_get_st_pub(&store, stpub);
+    phase_end(&cold, BOOT_ST_PUB, "lt_get_st_pub");
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+#ifdef LT_CERT_CHAIN
+    if (chain_verifiable) {
+        ret = lt_cert_chain_memo_clear(&chain);
+        if (ret != LT_OK) {
+            return ret;
+        }
+        phase_begin();
+        ret = lt_cert_chain_verify(h, &chain, &store, accept_sig, NULL);
+        phase_end(&cold, BOOT_CHAIN, "lt_cert_chain_verify");
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+#endif
+
+    phase_begin();
+    ret = lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB);
+    phase_end(&cold, BOOT_SESSION, "lt_session_start");
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    phase_begin();
+    ret = lt_ecc_ecdsa_sign(h, BOOT_ECDSA_SLOT, msg, sizeof(msg), rs);
+    phase_end(&cold, BOOT_SIGN, "lt_ecc_ecdsa_sign");
+
+    return ret;
+}
+
+/** @brief Boots with the caches filled by a previous run, phases without a cache are done as by boot_cold(). */
+static lt_ret_t boot_warm(lt_handle_t *h)
+{
+    lt_ret_t ret;
+
+    phase_begin();
+#ifdef LT_WARM_INIT
+    ret = lt_init_warm(h, &attrs_cache);
+    phase_end(&warm, BOOT_INIT, "lt_init_warm");
+#else
+    ret = lt_init(h);
+    phase_end(&warm, BOOT_INIT, "lt_init");
+#endif
+    if (ret != LT_OK) {
+        return ret;
+    }
+    initialized = true;
+
+    struct lt_cert_store_t *s = &store;
+    phase_begin();
+#ifdef LT_CERT_CACHE
+    ret = lt_cert_cache_get_store(&cert_cache, &cached_store);
+    s = &cached_store;
+    phase_end(&warm, BOOT_CERT_STORE, "lt_cert_cache_get_store");
+#else
+    ret = lt_get_info_cert_store(h, s);
+    phase_end(&warm, BOOT_CERT_STORE, "lt_get_info_cert_store");
+#endif
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    phase_begin();
+    ret = lt_get_st_pub(s, stpub);
+    phase_end(&warm, BOOT_ST_PUB, "lt_get_st_pub");
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+#ifdef LT_CERT_CHAIN
+    // CA certificates are in the memo since the cold boot.
+    if (chain_verifiable) {
+        phase_begin();
+        ret = lt_cert_chain_verify(h, &chain, s, accept_sig, NULL);
+        phase_end(&warm, BOOT_CHAIN, "lt_cert_chain_verify");
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+#endif
+
+    phase_begin();
+#ifdef LT_SESSION_CACHE
+    ret = lt_session_start_cached(h, &session_cache, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PRIV);
+    phase_end(&warm, BOOT_SESSION, "lt_session_start_cached");
+#else
+    ret = lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB);
+    phase_end(&warm, BOOT_SESSION, "lt_session_start");
+#endif
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    phase_begin();
+    ret = lt_ecc_ecdsa_sign(h, BOOT_ECDSA_SLOT, msg, sizeof(msg), rs);
+    phase_end(&warm, BOOT_SIGN, "lt_ecc_ecdsa_sign");
+
+    return ret;
+}
+
+/** @brief Ends the session and deinitializes the handle, as the application does before the power is cut. */
+static lt_ret_t shutdown(lt_handle_t *h)
+{
+#ifdef LT_SESSION_CACHE
+    // Ephemeral keys of the next handshake are prepared in idle time, i.e. they are not part of the boot.
+    lt_ret_t ret = lt_session_cache_prepare(h, &session_cache);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_session_abort(h);
+#else
+    lt_ret_t ret = lt_session_abort(h);
+#endif
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_deinit(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    initialized = false;
+
+    return LT_OK;
+}
+
+static void report_phase(const lt_boot_variant_t *v, const char *phase, const lt_boot_time_t *t, int64_t saved_us)
+{
+    const uint32_t n = LT_BOOT_PROFILE_RUNS;
+    const uint64_t traced_us = t->spi_us + t->wait_us + t->crc_us + t->aes_us;
+    const uint64_t host_us = (t->us > traced_us) ? t->us - traced_us : 0;
+
+    lt_port_log("{\"boot\":\"%s\",\"port\":\"%s\",\"phase\":\"%s\",\"runs\":%" PRIu32 ",\"us\":%" PRIu64
+                ",\"spi_us\":%" PRIu64 ",\"wait_us\":%" PRIu64 ",\"crc_us\":%" PRIu64 ",\"aes_us\":%" PRIu64
+                ",\"host_us\":%" PRIu64,
+                v->name, LT_BOOT_PROFILE_PORT, phase, n, t->us / n, t->spi_us / n, t->wait_us / n, t->crc_us / n,
+                t->aes_us / n, host_us / n);
+    if (v == &warm) {
+        lt_port_log(",\"saved_us\":%" PRId64, saved_us / (int64_t)n);
+    }
+    lt_port_log("}\n");
+}
+
+/** @brief Logs mean times of the phases of the variant, those of the warm boot with the time saved by the caches. */
+static void report(const lt_boot_variant_t *v)
+{
+    lt_boot_time_t total = {0};
+    uint64_t cold_us = 0;
+
+    for (int p = 0; p < BOOT_PHASE_CNT; p++) {
+        const lt_boot_time_t *t = &v->times[p];
+        cold_us += cold.times[p].us;
+        if (!v->phases[p]) {
+            continue;
+        }
+
+        report_phase(v, v->phases[p], t, (int64_t)cold.times[p].us - (int64_t)t->us);
+        total.us += t->us;
+        total.spi_us += t->spi_us;
+        total.wait_us += t->wait_us;
+        total.crc_us += t->crc_us;
+        total.aes_us += t->aes_us;
+    }
+    report_phase(v, "total", &total, (int64_t)cold_us - (int64_t)total.us);
+}
+
+static lt_ret_t lt_boot_profile_cleanup(void)
+{
+    lt_ret_t ret;
+
+    LT_UNUSED(lt_set_trace_hooks(g_h, NULL));
+    if (!initialized) {
+        LT_LOG_INFO("Initializing handle");
+        ret = lt_init(g_h);
+        if (LT_OK != ret) {
+            LT_LOG_ERROR("Failed to initialize handle.");
+            return ret;
+        }
+        initialized = true;
+    }
+
+    LT_LOG_INFO("Starting secure session with slot %d", (int)TR01_PAIRING_KEY_SLOT_INDEX_0);
+    ret = lt_verify_chip_and_start_secure_session(g_h, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB,
+                                                  TR01_PAIRING_KEY_SLOT_INDEX_0);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to establish secure session.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Erasing ECC key slot used by the boot profile");
+    ret = lt_ecc_key_erase(g_h, BOOT_ECDSA_SLOT);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to erase ECC key slot.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Aborting secure session");
+    ret = lt_session_abort(g_h);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to abort secure session.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Deinitializing handle");
+    ret = lt_deinit(g_h);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to deinitialize handle.");
+        return ret;
+    }
+    initialized = false;
+
+    return LT_OK;
+}
+
+void lt_boot_profile_run(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_boot_profile_run()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    g_h = h;
+
+    // Hooks are kept across lt_init() and lt_deinit(), so the initialization is split too.
+    LT_TEST_ASSERT(LT_OK, lt_set_trace_hooks(h, &trace_hooks));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    initialized = true;
+
+    LT_LOG_INFO("Reading certificate store and STPUB");
+    LT_TEST_ASSERT(LT_OK, lt_get_info_cert_store(h, &store));
+    LT_TEST_ASSERT(LT_OK, lt_get_st_pub(&store, stpub));
+
+    LT_LOG_INFO("Starting Secure Session with key %d", (int)TR01_PAIRING_KEY_SLOT_INDEX_0);
+    LT_TEST_ASSERT(LT_OK, lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB));
+    LT_LOG_LINE();
+
+    lt_test_cleanup_function = &lt_boot_profile_cleanup;
+
+    LT_LOG_INFO("Preparing the signing key and the caches");
+    LT_TEST_ASSERT(LT_OK, lt_random_value_get(h, msg, sizeof(msg)));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_generate(h, BOOT_ECDSA_SLOT, TR01_CURVE_P256));
+#ifdef LT_WARM_INIT
+    LT_TEST_ASSERT(LT_OK, lt_tr01_attrs_export(h, &attrs_cache));
+#endif
+#ifdef LT_CERT_CACHE
+    LT_TEST_ASSERT(LT_OK, lt_cert_cache_fill(h, &cert_cache));
+#endif
+#ifdef LT_CERT_CHAIN
+    LT_TEST_ASSERT(LT_OK, trust_root(h, &store));
+    chain_verifiable = (LT_OK == lt_cert_chain_verify(h, &chain, &store, accept_sig, NULL));
+    if (!chain_verifiable) {
+        LT_LOG_WARN("Certificate chain of the store cannot be parsed, lt_cert_chain_verify() is left out");
+    }
+#endif
+#ifdef LT_SESSION_CACHE
+    LT_TEST_ASSERT(LT_OK, lt_session_cache_init(h, &session_cache, stpub, LT_TEST_SH0_PUB));
+#endif
+    LT_TEST_ASSERT(LT_OK, shutdown(h));
+    LT_LOG_LINE();
+
+    // The handle is deinitialized between the boots, the cleanup function initializes it again if needed.
+    LT_LOG_INFO("Booting %d times without caches...", LT_BOOT_PROFILE_RUNS);
+    for (int i = 0; i < LT_BOOT_PROFILE_RUNS; i++) {
+        LT_TEST_ASSERT(LT_OK, boot_cold(h));
+        LT_TEST_ASSERT(LT_OK, shutdown(h));
+    }
+
+    LT_LOG_INFO("Booting %d times with warm caches...", LT_BOOT_PROFILE_RUNS);
+    for (int i = 0; i < LT_BOOT_PROFILE_RUNS; i++) {
+        LT_TEST_ASSERT(LT_OK, boot_warm(h));
+        LT_TEST_ASSERT(LT_OK, shutdown(h));
+    }
+    LT_LOG_LINE();
+
+    report(&cold);
+    report(&warm);
+    LT_LOG_LINE();
+
+    // Call cleanup function, but don't call it from LT_TEST_ASSERT anymore.
+    lt_test_cleanup_function = NULL;
+    LT_LOG_INFO("Starting post-profile cleanup");
+    LT_TEST_ASSERT(LT_OK, lt_boot_profile_cleanup());
+    LT_LOG_INFO("Post-profile cleanup was successful");
+}
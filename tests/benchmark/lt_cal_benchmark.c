@@ -0,0 +1,236 @@
+/**
+ * @file lt_cal_benchmark.c
+ * @brief Microbenchmarks of the CAL primitives used by libtropic, see lt_cal_benchmark_run().
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port.h"
+#include "lt_aesgcm.h"
+#include "lt_benchmark.h"
+#include "lt_crypto_common.h"
+#include "lt_hkdf.h"
+#include "lt_hmac_sha256.h"
+#include "lt_l3_process.h"
+#include "lt_sha256.h"
+#include "lt_test_common.h"
+#include "lt_x25519.h"
+
+/** @brief Length of the short AES-GCM message, e.g. an L3 Command of a digest to sign. */
+#define AESGCM_SHORT_LEN 32
+
+/** @brief Length of the long AES-GCM message, about the longest L3 Command or Result. */
+#define AESGCM_LONG_LEN 4096
+
+/** @brief Length of the data mixed into the handshake transcript hash by lt_session_start(). */
+#define TRANSCRIPT_LEN (TR01_SHIPUB_LEN + TR01_STPUB_LEN + TR01_EHPUB_LEN + 1 + TR01_ETPUB_LEN)
+
+/**
+ * @brief One benchmarked CAL primitive.
+ */
+typedef struct lt_cal_bench_t {
+    /** @brief Name of the benchmarked primitive. */
+    const char *name;
+    /** @brief Number of payload bytes processed by one call, used for throughput. */
+    uint16_t payload_len;
+    /** @brief Measured call. */
+    lt_ret_t (*run)(void *crypto_ctx);
+} lt_cal_bench_t;
+
+static uint32_t samples[LT_BENCH_ITERATIONS];
+
+static uint8_t key[TR01_AES256_KEY_LEN], iv[TR01_L3_IV_SIZE];
+static uint8_t plaintext[AESGCM_LONG_LEN], plaintext_out[AESGCM_LONG_LEN];
+static uint8_t ciphertext_short[AESGCM_SHORT_LEN + TR01_L3_TAG_SIZE];
+static uint8_t ciphertext_long[AESGCM_LONG_LEN + TR01_L3_TAG_SIZE], ciphertext_out[AESGCM_LONG_LEN + TR01_L3_TAG_SIZE];
+static uint8_t shipub[TR01_SHIPUB_LEN], stpriv[TR01_X25519_KEY_LEN], stpub[TR01_STPUB_LEN], etpub[TR01_ETPUB_LEN];
+static uint8_t ehpriv[TR01_X25519_KEY_LEN], ehpub[TR01_EHPUB_LEN], shared_secret[TR01_X25519_KEY_LEN];
+static uint8_t ck[LT_HMAC_SHA256_HASH_LEN], hash[LT_SHA256_DIGEST_LENGTH];
+static uint8_t output_1[LT_HMAC_SHA256_HASH_LEN], output_2[LT_HMAC_SHA256_HASH_LEN];
+
+/** @brief Fills the buffer by a pattern, the cost of the measured primitives does not depend on the data. */
+static void fill(uint8_t *buf, const size_t len, const uint8_t seed)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(seed + 31 * i);
+    }
+}
+
+// The same IV is used by every call, it does not change the cost and the keys are never used for real data.
+static lt_ret_t bench_aesgcm_encrypt_short(void *crypto_ctx)
+{
+    return lt_aesgcm_encrypt(crypto_ctx, iv, sizeof(iv), NULL, 0, plaintext, AESGCM_SHORT_LEN, ciphertext_out,
+                             AESGCM_SHORT_LEN + TR01_L3_TAG_SIZE);
+}
+
+static lt_ret_t bench_aesgcm_encrypt_long(void *crypto_ctx)
+{
+    return lt_aesgcm_encrypt(crypto_ctx, iv, sizeof(iv), NULL, 0, plaintext, AESGCM_LONG_LEN, ciphertext_out,
+                             sizeof(ciphertext_out));
+}
+
+static lt_ret_t bench_aesgcm_decrypt_short(void *crypto_ctx)
+{
+    return lt_aesgcm_decrypt(crypto_ctx, iv, sizeof(iv), NULL, 0, ciphertext_short, sizeof(ciphertext_short),
+                             plaintext_out, AESGCM_SHORT_LEN);
+}
+
+static lt_ret_t bench_aesgcm_decrypt_long(void *crypto_ctx)
+{
+    return lt_aesgcm_decrypt(crypto_ctx, iv, sizeof(iv), NULL, 0, ciphertext_long, sizeof(ciphertext_long),
+                             plaintext_out, AESGCM_LONG_LEN);
+}
+
+/** Handshake transcript hash as computed by lt_session_start(), without the cached prefix. */
+static lt_ret_t bench_transcript(void *crypto_ctx)
+{
+    const uint8_t pkey_index = TR01_PAIRING_KEY_SLOT_INDEX_0;
+
+    lt_ret_t ret = lt_l3_transcript_prefix(crypto_ctx, shipub, stpub, hash);
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_l3_transcript_update(crypto_ctx, hash, ehpub, sizeof(ehpub));
+    if (ret != LT_OK) {
+        return ret;
+    }
+    ret = lt_l3_transcript_update(crypto_ctx, hash, &pkey_index, 1);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_l3_transcript_update(crypto_ctx, hash, etpub, sizeof(etpub));
+}
+
+static lt_ret_t bench_hmac_sha256(void *crypto_ctx)
+{
+    LT_UNUSED(crypto_ctx);
+    return lt_hmac_sha256(ck, sizeof(ck), shared_secret, sizeof(shared_secret), output_1);
+}
+
+/** One of the four HKDFs of lt_session_start(): ck, kAUTH = HKDF(ck, X25519(EHPRIV, STPUB), 2). */
+static lt_ret_t bench_hkdf(void *crypto_ctx)
+{
+    return lt_hkdf(crypto_ctx, ck, sizeof(ck), shared_secret, sizeof(shared_secret), 2, output_1, output_2);
+}
+
+static lt_ret_t bench_x25519_keygen(void *crypto_ctx)
+{
+    LT_UNUSED(crypto_ctx);
+    return lt_X25519_scalarmult(ehpriv, ehpub);
+}
+
+static lt_ret_t bench_x25519(void *crypto_ctx)
+{
+    LT_UNUSED(crypto_ctx);
+    return lt_X25519(ehpriv, stpub, shared_secret);
+}
+
+static int cmp_samples(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/** @brief Nearest-rank percentile of the sorted samples. */
+static uint32_t percentile(const uint32_t *sorted, uint16_t cnt, uint8_t p)
+{
+    uint32_t rank = ((uint32_t)p * cnt + 99) / 100;
+    return sorted[rank ? rank - 1 : 0];
+}
+
+static void run_cal_bench(void *crypto_ctx, const lt_cal_bench_t *b)
+{
+    uint64_t total_us = 0, t0;
+    lt_ret_t ret;
+
+    LT_LOG_INFO("Benchmarking %s (%" PRIu16 " B) %d times...", b->name, b->payload_len, LT_BENCH_ITERATIONS);
+    for (uint16_t i = 0; i < LT_BENCH_ITERATIONS; i++) {
+        t0 = lt_bench_time_us();
+        ret = b->run(crypto_ctx);
+        samples[i] = (uint32_t)(lt_bench_time_us() - t0);
+
+        if (LT_OK != ret) {
+            LT_LOG_ERROR("%s failed, ret=%s", b->name, lt_ret_verbose(ret));
+            LT_TEST_ASSERT(LT_OK, ret);
+        }
+        total_us += samples[i];
+    }
+
+    qsort(samples, LT_BENCH_ITERATIONS, sizeof(samples[0]), cmp_samples);
+
+    uint32_t mean_us = (uint32_t)(total_us / LT_BENCH_ITERATIONS);
+    uint32_t throughput = mean_us ? (uint32_t)((uint64_t)b->payload_len * 1000000 / mean_us) : 0;
+
+    lt_port_log("{\"benchmark\":\"%s\",\"payload_bytes\":%" PRIu16 ",\"iterations\":%d,\"min_us\":%" PRIu32
+                ",\"p50_us\":%" PRIu32 ",\"p99_us\":%" PRIu32 ",\"max_us\":%" PRIu32 ",\"throughput_bps\":%" PRIu32
+                "}\n",
+                b->name, b->payload_len, LT_BENCH_ITERATIONS, samples[0], percentile(samples, LT_BENCH_ITERATIONS, 50),
+                percentile(samples, LT_BENCH_ITERATIONS, 99), samples[LT_BENCH_ITERATIONS - 1], throughput);
+}
+
+void lt_cal_benchmark_run(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_cal_benchmark_run()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    void *crypto_ctx = h->l3.crypto_ctx;
+
+    // Only the CAL is used, TROPIC01 is not needed.
+    LT_LOG_INFO("Initializing CAL context");
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ctx_init(crypto_ctx));
+
+    LT_LOG_INFO("Preparing keys and messages");
+    fill(key, sizeof(key), 1);
+    fill(iv, sizeof(iv), 2);
+    fill(plaintext, sizeof(plaintext), 3);
+    fill(shipub, sizeof(shipub), 4);
+    fill(etpub, sizeof(etpub), 5);
+    fill(ehpriv, sizeof(ehpriv), 6);
+    fill(ck, sizeof(ck), 7);
+    fill(stpriv, sizeof(stpriv), 8);
+    // A valid public key, so the shared secret keying HMAC and HKDF is not all zeros.
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(stpriv, stpub));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(ehpriv, ehpub));
+    LT_TEST_ASSERT(LT_OK, lt_X25519(ehpriv, stpub, shared_secret));
+    LT_TEST_ASSERT(LT_OK, lt_sha256_init(crypto_ctx));
+
+    // Keys of both directions are set once, as for a Secure Session.
+    LT_TEST_ASSERT(LT_OK, lt_aesgcm_encrypt_init(crypto_ctx, key, sizeof(key)));
+    LT_TEST_ASSERT(LT_OK, lt_aesgcm_decrypt_init(crypto_ctx, key, sizeof(key)));
+    LT_TEST_ASSERT(LT_OK, lt_aesgcm_encrypt(crypto_ctx, iv, sizeof(iv), NULL, 0, plaintext, AESGCM_SHORT_LEN,
+                                            ciphertext_short, sizeof(ciphertext_short)));
+    LT_TEST_ASSERT(LT_OK, lt_aesgcm_encrypt(crypto_ctx, iv, sizeof(iv), NULL, 0, plaintext, AESGCM_LONG_LEN,
+                                            ciphertext_long, sizeof(ciphertext_long)));
+    LT_LOG_LINE();
+
+    const lt_cal_bench_t benches[] = {
+        {"lt_aesgcm_encrypt", AESGCM_SHORT_LEN, bench_aesgcm_encrypt_short},
+        {"lt_aesgcm_encrypt", AESGCM_LONG_LEN, bench_aesgcm_encrypt_long},
+        {"lt_aesgcm_decrypt", AESGCM_SHORT_LEN, bench_aesgcm_decrypt_short},
+        {"lt_aesgcm_decrypt", AESGCM_LONG_LEN, bench_aesgcm_decrypt_long},
+        {"lt_l3_transcript", TRANSCRIPT_LEN, bench_transcript},
+        {"lt_hmac_sha256", TR01_X25519_KEY_LEN, bench_hmac_sha256},
+        {"lt_hkdf", TR01_X25519_KEY_LEN, bench_hkdf},
+        {"lt_X25519_scalarmult", 0, bench_x25519_keygen},
+        {"lt_X25519", 0, bench_x25519},
+    };
+
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        run_cal_bench(crypto_ctx, &benches[i]);
+    }
+    LT_LOG_LINE();
+
+    LT_LOG_INFO("Deinitializing CAL context");
+    LT_TEST_ASSERT(LT_OK, lt_sha256_deinit(crypto_ctx));
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ctx_deinit(crypto_ctx));
+}
@@ -0,0 +1,378 @@
+/**
+ * @file lt_soak.c
+ * @brief Soak test of long-running Secure Sessions with a mixed workload, see lt_soak_run().
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see LICENSE.md in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port.h"
+#include "lt_benchmark.h"
+#include "lt_test_common.h"
+
+#ifndef LT_STATS
+#error "The soak test requires LT_STATS"
+#endif
+
+/** @brief Maximal possible size of UDATA slot in User R-Memory accross all Application FWs. */
+#define R_MEM_DATA_SIZE_MAX 475
+
+/** @brief Length of the buffers for certificates. */
+#define CERTS_BUF_LEN 700
+
+/** @brief Length of the signed message, i.e. a digest. */
+#define SIGN_MSG_LEN 32
+
+/** @brief Slot with the P256 key used by the ECDSA operation. */
+#define SOAK_ECDSA_SLOT TR01_ECC_SLOT_31
+
+/** @brief Slot with the Ed25519 key used by the EdDSA operation. */
+#define SOAK_EDDSA_SLOT TR01_ECC_SLOT_30
+
+/** @brief User Data slot used by the R-Memory operations. */
+#define SOAK_R_MEM_SLOT TR01_R_MEM_DATA_SLOT_MAX
+
+/** @brief Samples of a window hold the operation in the top bits and the latency below. */
+#define SOAK_OP_SHIFT 28
+
+/** @brief Longest latency stored in a sample, longer ones are clamped. */
+#define SOAK_US_MAX ((1UL << SOAK_OP_SHIFT) - 1)
+
+/**
+ * @brief Operations of the workload, in the order of the weights in LT_SOAK_MIX.
+ */
+typedef enum lt_soak_op_t {
+    SOAK_ECDSA_SIGN,
+    SOAK_EDDSA_SIGN,
+    SOAK_RANDOM_VALUE_GET,
+    SOAK_R_MEM_WRITE,
+    SOAK_R_MEM_READ,
+    SOAK_PING,
+    SOAK_OP_CNT
+} lt_soak_op_t;
+
+// Shared with cleanup function
+static lt_handle_t *g_h;
+
+static const uint8_t weights[SOAK_OP_CNT] = {LT_SOAK_MIX};
+
+static const char *const op_names[SOAK_OP_CNT] = {
+    [SOAK_ECDSA_SIGN] = "lt_ecc_ecdsa_sign",
+    [SOAK_EDDSA_SIGN] = "lt_ecc_eddsa_sign",
+    [SOAK_RANDOM_VALUE_GET] = "lt_random_value_get",
+    [SOAK_R_MEM_WRITE] = "lt_r_mem_data_write",
+    [SOAK_R_MEM_READ] = "lt_r_mem_data_read",
+    [SOAK_PING] = "lt_ping",
+};
+
+static uint32_t samples[LT_SOAK_WINDOW];
+static uint32_t base_p50[SOAK_OP_CNT];
+
+static uint32_t prng_state = LT_SOAK_SEED;
+
+static uint8_t msg_out[TR01_PING_LEN_MAX], msg_in[TR01_PING_LEN_MAX], rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+static uint8_t r_mem_data[R_MEM_DATA_SIZE_MAX];
+static uint16_t r_mem_data_len, r_mem_slot_size;
+static uint8_t stpub[TR01_STPUB_LEN];
+static uint8_t cert1[CERTS_BUF_LEN], cert2[CERTS_BUF_LEN], cert3[CERTS_BUF_LEN], cert4[CERTS_BUF_LEN];
+static struct lt_cert_store_t store = {.certs = {cert1, cert2, cert3, cert4},
+                                       .buf_len = {CERTS_BUF_LEN, CERTS_BUF_LEN, CERTS_BUF_LEN, CERTS_BUF_LEN}};
+
+/** @brief Xorshift32, the workload does not need a better generator and it is the same on every platform. */
+static uint32_t prng_next(void)
+{
+    prng_state ^= prng_state << 13;
+    prng_state ^= prng_state >> 17;
+    prng_state ^= prng_state << 5;
+    return prng_state;
+}
+
+/** @brief Random number from 1 to max. */
+static uint16_t prng_len(const uint16_t max) { return (uint16_t)(prng_next() % max + 1); }
+
+static lt_soak_op_t pick_op(void)
+{
+    uint32_t total = 0;
+    for (int i = 0; i < SOAK_OP_CNT; i++) {
+        total += weights[i];
+    }
+
+    uint32_t r = prng_next() % total;
+    int op = 0;
+    while (r >= weights[op]) {
+        r -= weights[op++];
+    }
+
+    return (lt_soak_op_t)op;
+}
+
+/** @brief Erases the slot and writes it with new data, only the write is measured. */
+static lt_ret_t soak_r_mem_write(lt_handle_t *h, uint32_t *time_us)
+{
+    lt_ret_t ret = lt_r_mem_data_erase(h, SOAK_R_MEM_SLOT);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    r_mem_data_len = prng_len(r_mem_slot_size);
+    for (uint16_t i = 0; i < r_mem_data_len; i++) {
+        r_mem_data[i] = (uint8_t)prng_next();
+    }
+
+    uint64_t t0 = lt_bench_time_us();
+    ret = lt_r_mem_data_write(h, SOAK_R_MEM_SLOT, r_mem_data, r_mem_data_len);
+    *time_us = (uint32_t)(lt_bench_time_us() - t0);
+
+    return ret;
+}
+
+/** @brief Reads the slot back, the data has to be the data written last. */
+static lt_ret_t soak_r_mem_read(lt_handle_t *h, uint32_t *time_us)
+{
+    uint16_t read_size;
+
+    uint64_t t0 = lt_bench_time_us();
+    lt_ret_t ret = lt_r_mem_data_read(h, SOAK_R_MEM_SLOT, msg_in, sizeof(msg_in), &read_size);
+    *time_us = (uint32_t)(lt_bench_time_us() - t0);
+
+    if ((ret == LT_OK) && ((read_size != r_mem_data_len) || memcmp(msg_in, r_mem_data, r_mem_data_len))) {
+        LT_LOG_ERROR("R-Memory slot does not contain the data written last");
+        return LT_FAIL;
+    }
+
+    return ret;
+}
+
+static lt_ret_t run_op(lt_handle_t *h, const lt_soak_op_t op, uint32_t *time_us)
+{
+    uint64_t t0;
+    lt_ret_t ret;
+
+    switch (op) {
+        case SOAK_R_MEM_WRITE:
+            return soak_r_mem_write(h, time_us);
+        case SOAK_R_MEM_READ:
+            return soak_r_mem_read(h, time_us);
+        default:
+            break;
+    }
+
+    t0 = lt_bench_time_us();
+    switch (op) {
+        case SOAK_ECDSA_SIGN:
+            ret = lt_ecc_ecdsa_sign(h, SOAK_ECDSA_SLOT, msg_out, SIGN_MSG_LEN, rs);
+            break;
+        case SOAK_EDDSA_SIGN:
+            ret = lt_ecc_eddsa_sign(h, SOAK_EDDSA_SLOT, msg_out, prng_len(SIGN_MSG_LEN * 4), rs);
+            break;
+        case SOAK_RANDOM_VALUE_GET:
+            ret = lt_random_value_get(h, msg_in, prng_len(TR01_RANDOM_VALUE_GET_LEN_MAX));
+            break;
+        default:
+            ret = lt_ping(h, msg_out, msg_in, prng_len(TR01_PING_LEN_MAX));
+            break;
+    }
+    *time_us = (uint32_t)(lt_bench_time_us() - t0);
+
+    return ret;
+}
+
+static lt_ret_t restart_session(lt_handle_t *h)
+{
+    lt_ret_t ret = lt_session_abort(h);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB);
+}
+
+static int cmp_samples(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/** @brief Nearest-rank percentile of the latencies of sorted samples of one operation. */
+static uint32_t percentile(const uint32_t *sorted, uint32_t cnt, uint8_t p)
+{
+    uint32_t rank = (p * cnt + 99) / 100;
+    return sorted[rank ? rank - 1 : 0] & SOAK_US_MAX;
+}
+
+/** @brief Logs the latencies of each operation in the window, samples are sorted by operation and latency. */
+static void report_ops(const uint32_t window, const uint32_t cnt)
+{
+    qsort(samples, cnt, sizeof(samples[0]), cmp_samples);
+
+    for (uint32_t first = 0, last; first < cnt; first = last) {
+        const uint32_t op = samples[first] >> SOAK_OP_SHIFT;
+        for (last = first; (last < cnt) && ((samples[last] >> SOAK_OP_SHIFT) == op); last++) {
+        }
+
+        uint32_t p50 = percentile(samples + first, last - first, 50);
+        if (!base_p50[op]) {
+            base_p50[op] = p50 ? p50 : 1;
+        }
+        int32_t drift = (int32_t)(((int64_t)p50 - base_p50[op]) * 100 / base_p50[op]);
+
+        lt_port_log("{\"soak\":\"%s\",\"window\":%" PRIu32 ",\"calls\":%" PRIu32 ",\"p50_us\":%" PRIu32
+                    ",\"p99_us\":%" PRIu32 ",\"max_us\":%" PRIu32 ",\"drift_p50_pct\":%" PRId32 "}\n",
+                    op_names[op], window, last - first, p50, percentile(samples + first, last - first, 99),
+                    samples[last - 1] & SOAK_US_MAX, drift);
+    }
+}
+
+static lt_ret_t lt_soak_cleanup(void)
+{
+    lt_ret_t ret;
+
+    LT_LOG_INFO("Starting secure session with slot %d", (int)TR01_PAIRING_KEY_SLOT_INDEX_0);
+    ret = lt_verify_chip_and_start_secure_session(g_h, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB,
+                                                  TR01_PAIRING_KEY_SLOT_INDEX_0);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to establish secure session.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Erasing ECC key slots and R-Memory slot used by the soak test");
+    ret = lt_ecc_key_erase(g_h, SOAK_ECDSA_SLOT);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to erase ECC key slot.");
+        return ret;
+    }
+    ret = lt_ecc_key_erase(g_h, SOAK_EDDSA_SLOT);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to erase ECC key slot.");
+        return ret;
+    }
+    ret = lt_r_mem_data_erase(g_h, SOAK_R_MEM_SLOT);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to erase R-Memory slot.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Aborting secure session");
+    ret = lt_session_abort(g_h);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to abort secure session.");
+        return ret;
+    }
+
+    LT_LOG_INFO("Deinitializing handle");
+    ret = lt_deinit(g_h);
+    if (LT_OK != ret) {
+        LT_LOG_ERROR("Failed to deinitialize handle.");
+        return ret;
+    }
+
+    return LT_OK;
+}
+
+void lt_soak_run(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_soak_run()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    g_h = h;
+
+    lt_stats_t stats;
+    uint32_t sessions = 1, nonce_overflows = 0, window = 0, cnt = 0, time_us;
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Reading certificate store and STPUB");
+    LT_TEST_ASSERT(LT_OK, lt_get_info_cert_store(h, &store));
+    LT_TEST_ASSERT(LT_OK, lt_get_st_pub(&store, stpub));
+
+    LT_LOG_INFO("Starting Secure Session with key %d", (int)TR01_PAIRING_KEY_SLOT_INDEX_0);
+    LT_TEST_ASSERT(LT_OK, lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PRIV, LT_TEST_SH0_PUB));
+    LT_LOG_LINE();
+
+    lt_test_cleanup_function = &lt_soak_cleanup;
+
+    LT_LOG_INFO("Preparing keys, messages and R-Memory data");
+    LT_TEST_ASSERT(LT_OK, lt_random_value_get(h, msg_out, TR01_RANDOM_VALUE_GET_LEN_MAX));
+    for (uint16_t i = TR01_RANDOM_VALUE_GET_LEN_MAX; i < sizeof(msg_out); i++) {
+        msg_out[i] = (uint8_t)prng_next();
+    }
+    r_mem_slot_size = h->tr01_attrs.r_mem_udata_slot_size_max;
+    if (r_mem_slot_size > sizeof(r_mem_data)) {
+        r_mem_slot_size = sizeof(r_mem_data);
+    }
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_generate(h, SOAK_ECDSA_SLOT, TR01_CURVE_P256));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_generate(h, SOAK_EDDSA_SLOT, TR01_CURVE_ED25519));
+    LT_TEST_ASSERT(LT_OK, soak_r_mem_write(h, &time_us));
+    LT_TEST_ASSERT(LT_OK, lt_reset_stats(h));
+    LT_LOG_LINE();
+
+    LT_LOG_INFO("Running %d operations, seed 0x%08" PRIx32 "...", LT_SOAK_OPS, (uint32_t)LT_SOAK_SEED);
+    const uint64_t start_us = lt_bench_time_us();
+    const uint64_t mem_base = lt_bench_mem_bytes();
+    uint32_t burst = prng_len(LT_SOAK_BURST_MAX);
+
+    for (uint32_t i = 0; i < LT_SOAK_OPS; i++) {
+        const lt_soak_op_t op = pick_op();
+
+        lt_ret_t ret = run_op(h, op, &time_us);
+        if (LT_NONCE_OVERFLOW == ret) {
+            // Nonces of the session are exhausted, the operation is repeated in a new one.
+            nonce_overflows++;
+            sessions++;
+            LT_TEST_ASSERT(LT_OK, restart_session(h));
+            ret = run_op(h, op, &time_us);
+        }
+        if (LT_OK != ret) {
+            LT_LOG_ERROR("%s failed after %" PRIu32 " operations, ret=%s", op_names[op], i, lt_ret_verbose(ret));
+            LT_TEST_ASSERT(LT_OK, ret);
+        }
+        samples[cnt++] = ((uint32_t)op << SOAK_OP_SHIFT) | (time_us < SOAK_US_MAX ? time_us : SOAK_US_MAX);
+
+        LT_TEST_ASSERT(LT_OK, lt_get_stats(h, &stats));
+        if (stats.l3_nonce >= LT_SOAK_SESSION_NONCE) {
+            sessions++;
+            LT_TEST_ASSERT(LT_OK, restart_session(h));
+        }
+
+        if ((cnt == LT_SOAK_WINDOW) || (i + 1 == LT_SOAK_OPS)) {
+            report_ops(window, cnt);
+
+            const uint64_t mem = lt_bench_mem_bytes();
+            const uint64_t ops = (uint64_t)i + 1;
+            lt_port_log("{\"soak\":\"window\",\"window\":%" PRIu32 ",\"ops\":%" PRIu64 ",\"elapsed_s\":%" PRIu64
+                        ",\"sessions\":%" PRIu32 ",\"nonce_overflows\":%" PRIu32 ",\"nonce\":%" PRIu32
+                        ",\"nonce_headroom\":%" PRIu32 ",\"resends\":%" PRIu32 ",\"resends_per_mop\":%" PRIu64
+                        ",\"crc_errors\":%" PRIu32 ",\"spi_bytes\":%" PRIu64 ",\"mem_bytes\":%" PRIu64
+                        ",\"mem_growth_bytes\":%" PRId64 "}\n",
+                        window, ops, (lt_bench_time_us() - start_us) / 1000000, sessions, nonce_overflows,
+                        stats.l3_nonce, UINT32_MAX - stats.l3_nonce_max, stats.l2_resends,
+                        (uint64_t)stats.l2_resends * 1000000 / ops, stats.l2_crc_errors, stats.l1_spi_bytes, mem,
+                        (int64_t)(mem - mem_base));
+            window++;
+            cnt = 0;
+        }
+
+        if (--burst == 0) {
+            burst = prng_len(LT_SOAK_BURST_MAX);
+#if LT_SOAK_IDLE_MAX_MS > 0
+            LT_TEST_ASSERT(LT_OK, lt_port_delay(&h->l2, prng_next() % (LT_SOAK_IDLE_MAX_MS + 1)));
+#endif
+        }
+    }
+    LT_LOG_LINE();
+
+    // Call cleanup function, but don't call it from LT_TEST_ASSERT anymore.
+    lt_test_cleanup_function = NULL;
+    LT_LOG_INFO("Starting post-soak cleanup");
+    LT_TEST_ASSERT(LT_OK, lt_soak_cleanup());
+    LT_LOG_INFO("Post-soak cleanup was successful");
+}
@@ -66,6 +66,7 @@ void lt_assert_fail_handler(void);
 #define LT_FINISH_TEST()               \
     {                                  \
         LT_LOG_INFO("TEST FINISHED!"); \
+        LT_LOG_FLUSH();                \
     }
 
 /**
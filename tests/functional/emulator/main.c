@@ -0,0 +1,94 @@
+/**
+ * @file main.c
+ * @brief Common entrypoint for running functional tests against TROPIC01 emulated in the test process.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_functional_tests.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_emulator.h"
+#include "libtropic_posix_rng.h"
+#include "lt_test_common.h"
+
+#if LT_USE_TREZOR_CRYPTO
+#include "libtropic_trezor_crypto.h"
+#define CRYPTO_CTX_TYPE lt_ctx_trezor_crypto_t
+#elif LT_USE_MBEDTLS_V4
+#include "libtropic_mbedtls_v4.h"
+#include "psa/crypto.h"
+#define CRYPTO_CTX_TYPE lt_ctx_mbedtls_v4_t
+#elif LT_USE_OPENSSL
+#include "libtropic_openssl.h"
+#define CRYPTO_CTX_TYPE lt_ctx_openssl_t
+#elif LT_USE_WOLFCRYPT
+#include "libtropic_wolfcrypt.h"
+#include "wolfssl/wolfcrypt/error-crypt.h"
+#include "wolfssl/wolfcrypt/wc_port.h"
+#define CRYPTO_CTX_TYPE lt_ctx_wolfcrypt_t
+#endif
+
+int main(void)
+{
+    // CFP initialization
+#if LT_USE_MBEDTLS_V4
+    psa_status_t status = psa_crypto_init();
+    if (status != PSA_SUCCESS) {
+        LT_LOG_ERROR("PSA Crypto initialization failed, status=%d (psa_status_t)", status);
+        return -1;
+    }
+#elif LT_USE_WOLFCRYPT
+    int ret = wolfCrypt_Init();
+    if (ret != 0) {
+        LT_LOG_ERROR("WolfCrypt initialization failed, ret=%d (%s)", ret, wc_GetErrorString(ret));
+        return ret;
+    }
+#endif
+
+    // Handle initialization
+    lt_handle_t lt_handle = {0};
+#if LT_SEPARATE_L3_BUFF
+    uint8_t l3_buffer[LT_SIZE_OF_L3_BUFF] __attribute__((aligned(16))) = {0};
+    lt_handle.l3.buff = l3_buffer;
+    lt_handle.l3.buff_len = sizeof(l3_buffer);
+#endif
+
+    // Device mappings
+    // LT_EMULATOR_SEED is defined in CMakeLists.txt, it seeds both the emulated TROPIC01 and the host random bytes.
+    // The device is static, as the emulated TROPIC01 does not fit on a small stack.
+    static lt_dev_emulator_t device;
+    device.seed = LT_EMULATOR_SEED;
+    lt_posix_rng_seed(LT_EMULATOR_SEED);
+    // Pairing key in slot 0 is the one the tests start the Secure Session with.
+    if (LT_OK != lt_emulator_hal_set_pairing_key(&device, TR01_PAIRING_KEY_SLOT_INDEX_0, LT_TEST_SH0_PUB)) {
+        LT_LOG_ERROR("Pairing key of the emulator could not be set!");
+        return -1;
+    }
+    lt_handle.l2.device = &device;
+
+    // CAL context (selectable)
+    CRYPTO_CTX_TYPE crypto_ctx;
+    lt_handle.l3.crypto_ctx = &crypto_ctx;
+
+    // Test code (correct test function is selected automatically per binary)
+    // __lt_handle__ identifier is used by the test registry.
+    lt_handle_t *__lt_handle__ = &lt_handle;
+#include "lt_test_registry.c.inc"
+
+#if LT_USE_MBEDTLS_V4
+    mbedtls_psa_crypto_free();
+#elif LT_USE_WOLFCRYPT
+    ret = wolfCrypt_Cleanup();
+    if (ret != 0) {
+        LT_LOG_ERROR("WolfCrypt cleanup failed, ret=%d (%s)", ret, wc_GetErrorString(ret));
+        return ret;
+    }
+#endif
+
+    return 0;
+}
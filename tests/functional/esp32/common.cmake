@@ -48,9 +48,16 @@ idf_build_process(${TARGET})
 #                                                                         #
 ###########################################################################
 
+# Benchmark uses esp_timer for timing and heap_caps for memory of the soak test.
+set(LT_BENCHMARK_CLOCK "esp_idf")
+
 # Add path to libtropic's functional tests
 add_subdirectory(${PATH_FN_TESTS} "libtropic_functional_tests")
 
+if(LT_BENCHMARK OR LT_CAL_BENCHMARK OR LT_SOAK)
+    target_link_libraries(libtropic_functional_tests PRIVATE idf::esp_timer idf::heap)
+endif()
+
 ###########################################################################
 #                                                                         #
 #   Crypto backend handling                                               #
@@ -76,7 +83,7 @@ endif()
 add_subdirectory("${PATH_LIBTROPIC}/hal/esp-idf" "esp_idf_hal")
 target_sources(tropic PRIVATE ${LT_HAL_SRCS})
 target_include_directories(tropic PUBLIC ${LT_HAL_INC_DIRS})
-target_link_libraries(tropic PUBLIC idf::freertos idf::spi_flash idf::esp_driver_spi idf::esp_driver_gpio)
+target_link_libraries(tropic PUBLIC idf::freertos idf::spi_flash idf::esp_driver_spi idf::esp_driver_gpio idf::esp_timer)
 
 set(SOURCES
     ${CMAKE_CURRENT_SOURCE_DIR}/main.c
@@ -7,18 +7,19 @@
  */
 
 #include <arpa/inet.h>
-#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#include <unistd.h>
 
 #include "libtropic.h"
 #include "libtropic_common.h"
 #include "libtropic_functional_tests.h"
 #include "libtropic_logging.h"
 #include "libtropic_port_posix_tcp.h"
+#ifdef LT_REPLAY_RECORD_PATH
+#include "libtropic_replay_record.h"
+#endif
 
 #if LT_USE_TREZOR_CRYPTO
 #include "libtropic_trezor_crypto.h"
@@ -64,29 +65,41 @@ int main(void)
 
     // Device mappings
     // Initialize device before handing handle to the test.
-    lt_dev_posix_tcp_t device;
+    lt_dev_posix_tcp_t device = {0};
     device.addr = inet_addr("127.0.0.1");
     device.port = 28992;
+    // Port of the model instance is set by model_runner.py when more instances run in parallel.
+    const char *model_port = getenv("LT_MODEL_PORT");
+    if (model_port) {
+        device.port = (in_port_t)strtoul(model_port, NULL, 10);
+    }
     lt_handle.l2.device = &device;
 
-    // Generate a seed for the PRNG and seed it.
-    unsigned int prng_seed;
-    if (0 != getentropy(&prng_seed, sizeof(prng_seed))) {
-        LT_LOG_ERROR("main: getentropy() failed (%s)!", strerror(errno));
-        return -1;
-    }
-    srand(prng_seed);
-    LT_LOG_INFO("PRNG initialized with seed=%u\n", prng_seed);
+    // Host random bytes are generated by the TCP port itself (see libtropic_posix_rng.h), no PRNG is seeded.
 
     // CAL context (selectable)
     CRYPTO_CTX_TYPE crypto_ctx;
     lt_handle.l3.crypto_ctx = &crypto_ctx;
 
+#ifdef LT_REPLAY_RECORD_PATH
+    // Record the test for the replay HAL (see tests/functional/replay/).
+    lt_replay_recorder_t recorder;
+    if (LT_OK != lt_replay_record_start(&lt_handle, &recorder, LT_REPLAY_RECORD_PATH)) {
+        return -1;
+    }
+#endif
+
     // Test code (correct test function is selected automatically per binary)
     // __lt_handle__ identifier is used by the test registry.
     lt_handle_t *__lt_handle__ = &lt_handle;
 #include "lt_test_registry.c.inc"
 
+#ifdef LT_REPLAY_RECORD_PATH
+    if (LT_OK != lt_replay_record_stop(&lt_handle, &recorder)) {
+        return -1;
+    }
+#endif
+
 #if LT_USE_MBEDTLS_V4
     mbedtls_psa_crypto_free();
 #elif LT_USE_WOLFCRYPT
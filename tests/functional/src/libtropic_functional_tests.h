@@ -19,6 +19,10 @@
 
 #include "libtropic_common.h"
 
+#ifdef LT_BENCHMARK
+#include "lt_benchmark.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
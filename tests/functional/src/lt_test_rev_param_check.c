@@ -41,6 +41,14 @@ void lt_test_rev_param_check(lt_handle_t *h)
         LT_TEST_ASSERT(LT_PARAM_ERR, lt_get_info_cert_store(h, NULL));
     }
 
+    {
+        lt_cert_store_t dummy_store = {0};
+        LT_TEST_ASSERT(LT_PARAM_ERR, lt_get_info_cert_store_partial(NULL, &dummy_store, LT_CERT_KIND_DEVICE));
+        LT_TEST_ASSERT(LT_PARAM_ERR, lt_get_info_cert_store_partial(h, NULL, LT_CERT_KIND_DEVICE));
+        LT_TEST_ASSERT(LT_PARAM_ERR,
+                       lt_get_info_cert_store_partial(h, &dummy_store, (lt_cert_kind_t)(LT_CERT_KIND_TROPIC_ROOT + 1)));
+    }
+
     {
         lt_cert_store_t dummy_store = {0};
         uint8_t dummy_stpub[1];
@@ -48,6 +56,12 @@ void lt_test_rev_param_check(lt_handle_t *h)
         LT_TEST_ASSERT(LT_PARAM_ERR, lt_get_st_pub(&dummy_store, NULL));
     }
 
+    {
+        uint8_t dummy_stpub[1];
+        LT_TEST_ASSERT(LT_PARAM_ERR, lt_get_info_st_pub(NULL, dummy_stpub));
+        LT_TEST_ASSERT(LT_PARAM_ERR, lt_get_info_st_pub(h, NULL));
+    }
+
     {
         lt_chip_id_t dummy_chip_id = {0};
         LT_TEST_ASSERT(LT_PARAM_ERR, lt_get_info_chip_id(NULL, &dummy_chip_id));
@@ -294,6 +308,9 @@ void lt_test_rev_param_check(lt_handle_t *h)
         LT_TEST_ASSERT(LT_PARAM_ERR, lt_write_whole_R_config(NULL, &cfg));
         LT_TEST_ASSERT(LT_PARAM_ERR, lt_write_whole_R_config(h, NULL));
 
+        LT_TEST_ASSERT(LT_PARAM_ERR, lt_apply_R_config(NULL, &cfg, NULL));
+        LT_TEST_ASSERT(LT_PARAM_ERR, lt_apply_R_config(h, NULL, NULL));
+
         LT_TEST_ASSERT(LT_PARAM_ERR, lt_read_whole_I_config(NULL, &cfg));
         LT_TEST_ASSERT(LT_PARAM_ERR, lt_read_whole_I_config(h, NULL));
 
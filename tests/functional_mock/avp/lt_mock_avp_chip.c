@@ -0,0 +1,498 @@
+/**
+ * @file lt_mock_avp_chip.c
+ * @brief RAM model of TROPIC01 for the functional mock tests of the AVP layer.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include "lt_mock_avp_chip.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_macros.h"
+
+/** Number of monotonic counters. */
+#define MOCK_MCOUNTERS (TR01_MCOUNTER_INDEX_15 + 1)
+/** Number of ECC key slots. */
+#define MOCK_ECC_SLOTS (TR01_ECC_SLOT_31 + 1)
+
+/** Contents of the R-memory slot of the PIN engine: attempts (1 B) | PIN length (1 B) | PIN. */
+#define MOCK_PIN_HDR_LEN 2
+
+/** State of the modelled chip. */
+static struct {
+    uint8_t r_mem[TR01_R_MEM_DATA_SLOT_MAX + 1][LT_MOCK_AVP_R_MEM_SLOT_SIZE];
+    uint16_t r_mem_len[TR01_R_MEM_DATA_SLOT_MAX + 1];
+    uint32_t mcounter[MOCK_MCOUNTERS];
+    bool mcounter_valid[MOCK_MCOUNTERS];
+    lt_ecc_curve_type_t ecc_curve[MOCK_ECC_SLOTS];
+    uint8_t ecc_pubkey[MOCK_ECC_SLOTS][TR01_CURVE_P256_PUBKEY_LEN];
+    bool ecc_used[MOCK_ECC_SLOTS];
+    /** R-memory slot of the PIN engine, set by lt_pin_init(). */
+    uint16_t pin_slot;
+    unsigned calls[LT_MOCK_AVP_OPS];
+    /** Failure set by lt_mock_avp_fail(), fail_nth is 0 when none is pending. */
+    lt_mock_avp_op_t fail_op;
+    uint16_t fail_slot;
+    unsigned fail_nth;
+    uint32_t clock_s;
+} chip;
+
+void lt_mock_avp_chip_reset(void)
+{
+    memset(&chip, 0, sizeof(chip));
+}
+
+void lt_mock_avp_fail(const lt_mock_avp_op_t op, const uint16_t slot, const unsigned nth)
+{
+    chip.fail_op = op;
+    chip.fail_slot = slot;
+    chip.fail_nth = nth;
+}
+
+bool lt_mock_avp_fail_pending(void) { return chip.fail_nth != 0; }
+
+unsigned lt_mock_avp_calls(const lt_mock_avp_op_t op) { return chip.calls[op]; }
+
+unsigned lt_mock_avp_calls_all(void)
+{
+    unsigned sum = 0;
+    for (size_t op = 0; op < LT_MOCK_AVP_OPS; op++) {
+        sum += chip.calls[op];
+    }
+
+    return sum;
+}
+
+void lt_mock_avp_calls_reset(void) { memset(chip.calls, 0, sizeof(chip.calls)); }
+
+uint8_t *lt_mock_avp_r_mem(const uint16_t slot, uint16_t *len)
+{
+    *len = chip.r_mem_len[slot];
+    return chip.r_mem[slot];
+}
+
+uint8_t lt_mock_avp_pin_attempts(void)
+{
+    return (chip.r_mem_len[chip.pin_slot] != 0) ? chip.r_mem[chip.pin_slot][0] : 0;
+}
+
+uint32_t lt_mock_avp_clock_s(void) { return chip.clock_s; }
+
+void lt_mock_avp_clock_advance(const uint32_t s) { chip.clock_s += s; }
+
+/** Counts the call, returns true if it is the one to fail. */
+static bool mock_call(const lt_mock_avp_op_t op, const uint16_t slot)
+{
+    chip.calls[op]++;
+    if (chip.fail_nth == 0 || chip.fail_op != op || (chip.fail_slot != LT_MOCK_AVP_ANY_SLOT && chip.fail_slot != slot)) {
+        return false;
+    }
+
+    return --chip.fail_nth == 0;
+}
+
+/** Deterministic bytes derived from the seed, stand-in for keys and signatures. */
+static void mock_fill(uint8_t *out, const size_t len, uint32_t seed)
+{
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1103515245U + 12345U;
+        out[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+lt_ret_t __wrap_lt_init(lt_handle_t *h)
+{
+    if (mock_call(LT_MOCK_AVP_INIT, LT_MOCK_AVP_ANY_SLOT)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    h->tr01_attrs.r_mem_udata_slot_size_max = LT_MOCK_AVP_R_MEM_SLOT_SIZE;
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_deinit(lt_handle_t *h)
+{
+    LT_UNUSED(h);
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt)
+{
+    LT_UNUSED(h);
+    if (mock_call(LT_MOCK_AVP_RANDOM, LT_MOCK_AVP_ANY_SLOT)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    for (uint16_t i = 0; i < rnd_bytes_cnt; i++) {
+        rnd_bytes[i] = (uint8_t)rand();
+    }
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot, uint8_t *data,
+                                   const uint16_t data_max_size, uint16_t *data_read_size)
+{
+    LT_UNUSED(h);
+    if (udata_slot > TR01_R_MEM_DATA_SLOT_MAX) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_R_MEM_READ, udata_slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    *data_read_size = chip.r_mem_len[udata_slot];
+    if (*data_read_size == 0) {
+        return LT_L3_R_MEM_DATA_READ_SLOT_EMPTY;
+    }
+    if (data_max_size < *data_read_size) {
+        return LT_PARAM_ERR;
+    }
+
+    memcpy(data, chip.r_mem[udata_slot], *data_read_size);
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, const uint8_t *data,
+                                    const uint16_t data_size)
+{
+    LT_UNUSED(h);
+    if (udata_slot > TR01_R_MEM_DATA_SLOT_MAX || data_size == 0 || data_size > LT_MOCK_AVP_R_MEM_SLOT_SIZE) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_R_MEM_WRITE, udata_slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    if (chip.r_mem_len[udata_slot] != 0) {
+        return LT_L3_SLOT_NOT_EMPTY;
+    }
+
+    memcpy(chip.r_mem[udata_slot], data, data_size);
+    chip.r_mem_len[udata_slot] = data_size;
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot)
+{
+    LT_UNUSED(h);
+    if (udata_slot > TR01_R_MEM_DATA_SLOT_MAX) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_R_MEM_ERASE, udata_slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    memset(chip.r_mem[udata_slot], 0, sizeof(chip.r_mem[udata_slot]));
+    chip.r_mem_len[udata_slot] = 0;
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index,
+                                uint32_t *mcounter_value)
+{
+    LT_UNUSED(h);
+    if (mcounter_index >= MOCK_MCOUNTERS) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_MCOUNTER_GET, (uint16_t)mcounter_index)) {
+        return LT_L1_SPI_ERROR;
+    }
+    if (!chip.mcounter_valid[mcounter_index]) {
+        return LT_L3_COUNTER_INVALID;
+    }
+
+    *mcounter_value = chip.mcounter[mcounter_index];
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index,
+                                 const uint32_t mcounter_value)
+{
+    LT_UNUSED(h);
+    if (mcounter_index >= MOCK_MCOUNTERS || mcounter_value > TR01_MCOUNTER_VALUE_MAX) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_MCOUNTER_INIT, (uint16_t)mcounter_index)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    chip.mcounter[mcounter_index] = mcounter_value;
+    chip.mcounter_valid[mcounter_index] = true;
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_mcounter_update(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index)
+{
+    LT_UNUSED(h);
+    if (mcounter_index >= MOCK_MCOUNTERS) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_MCOUNTER_UPDATE, (uint16_t)mcounter_index)) {
+        return LT_L1_SPI_ERROR;
+    }
+    if (!chip.mcounter_valid[mcounter_index]) {
+        return LT_L3_COUNTER_INVALID;
+    }
+    if (chip.mcounter[mcounter_index] == 0) {
+        return LT_L3_UPDATE_ERR;
+    }
+
+    chip.mcounter[mcounter_index]--;
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t ecc_slot)
+{
+    LT_UNUSED(h);
+    if (ecc_slot >= MOCK_ECC_SLOTS) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_ECC_ERASE, (uint16_t)ecc_slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    chip.ecc_used[ecc_slot] = false;
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve)
+{
+    LT_UNUSED(h);
+    if (slot >= MOCK_ECC_SLOTS || (curve != TR01_CURVE_P256 && curve != TR01_CURVE_ED25519)) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_ECC_GENERATE, (uint16_t)slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+    if (chip.ecc_used[slot]) {
+        return LT_L3_FAIL;
+    }
+
+    chip.ecc_used[slot] = true;
+    chip.ecc_curve[slot] = curve;
+    mock_fill(chip.ecc_pubkey[slot], sizeof(chip.ecc_pubkey[slot]), (uint32_t)rand());
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, uint8_t *key,
+                                const uint8_t key_max_size, lt_ecc_curve_type_t *curve, lt_ecc_key_origin_t *origin)
+{
+    LT_UNUSED(h);
+    if (ecc_slot >= MOCK_ECC_SLOTS) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_ECC_READ, (uint16_t)ecc_slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+    if (!chip.ecc_used[ecc_slot]) {
+        return LT_L3_INVALID_KEY;
+    }
+
+    size_t len =
+        (chip.ecc_curve[ecc_slot] == TR01_CURVE_P256) ? TR01_CURVE_P256_PUBKEY_LEN : TR01_CURVE_ED25519_PUBKEY_LEN;
+    if (key_max_size < len) {
+        return LT_PARAM_ERR;
+    }
+
+    memcpy(key, chip.ecc_pubkey[ecc_slot], len);
+    *curve = chip.ecc_curve[ecc_slot];
+    *origin = TR01_CURVE_GENERATED;
+    return LT_OK;
+}
+
+/** Signature of the message by the key in the slot, a stand-in which differs per key and message. */
+static lt_ret_t mock_sign(const lt_mock_avp_op_t op, const lt_ecc_slot_t ecc_slot, const lt_ecc_curve_type_t curve,
+                          const uint8_t *msg, const size_t msg_len, uint8_t *rs)
+{
+    if (ecc_slot >= MOCK_ECC_SLOTS) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(op, (uint16_t)ecc_slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+    if (!chip.ecc_used[ecc_slot] || chip.ecc_curve[ecc_slot] != curve) {
+        return LT_L3_INVALID_KEY;
+    }
+
+    uint32_t seed = chip.ecc_pubkey[ecc_slot][0];
+    for (size_t i = 0; i < msg_len; i++) {
+        seed = (seed ^ msg[i]) * 16777619U;
+    }
+    mock_fill(rs, TR01_ECDSA_EDDSA_SIGNATURE_LENGTH, seed);
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg,
+                                  const uint32_t msg_len, uint8_t *rs)
+{
+    LT_UNUSED(h);
+    return mock_sign(LT_MOCK_AVP_ECDSA_SIGN, ecc_slot, TR01_CURVE_P256, msg, msg_len, rs);
+}
+
+lt_ret_t __wrap_lt_ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg,
+                                  const uint16_t msg_len, uint8_t *rs)
+{
+    LT_UNUSED(h);
+    return mock_sign(LT_MOCK_AVP_EDDSA_SIGN, ecc_slot, TR01_CURVE_ED25519, msg, msg_len, rs);
+}
+
+lt_ret_t __wrap_lt_get_info_chip_id(lt_handle_t *h, struct lt_chip_id_t *chip_id)
+{
+    LT_UNUSED(h);
+    if (mock_call(LT_MOCK_AVP_GET_INFO, LT_MOCK_AVP_ANY_SLOT)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    memset(chip_id, 0, sizeof(*chip_id));
+    mock_fill((uint8_t *)&chip_id->ser_num, sizeof(chip_id->ser_num), 0x5e);
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_get_info_riscv_fw_ver(lt_handle_t *h, uint8_t *ver)
+{
+    LT_UNUSED(h);
+    if (mock_call(LT_MOCK_AVP_GET_INFO, LT_MOCK_AVP_ANY_SLOT)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    // Version 2.0.1 of the Application FW
+    const uint8_t riscv_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE] = {0x00, 0x01, 0x00, 0x02};
+    memcpy(ver, riscv_ver, sizeof(riscv_ver));
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_get_info_spect_fw_ver(lt_handle_t *h, uint8_t *ver)
+{
+    LT_UNUSED(h);
+    if (mock_call(LT_MOCK_AVP_GET_INFO, LT_MOCK_AVP_ANY_SLOT)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    // Version 1.0.0 of the SPECT FW
+    const uint8_t spect_ver[TR01_L2_GET_INFO_SPECT_FW_SIZE] = {0x00, 0x00, 0x00, 0x01};
+    memcpy(ver, spect_ver, sizeof(spect_ver));
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_get_info_cert_store(lt_handle_t *h, struct lt_cert_store_t *store)
+{
+    LT_UNUSED(h);
+    if (mock_call(LT_MOCK_AVP_GET_INFO, LT_MOCK_AVP_ANY_SLOT)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    // Certificates of 400 B each, filled with their index
+    for (size_t k = 0; k < LT_NUM_CERTIFICATES; k++) {
+        store->cert_len[k] = 400;
+        if (store->buf_len[k] < store->cert_len[k]) {
+            return LT_PARAM_ERR;
+        }
+        memset(store->certs[k], (int)k, store->cert_len[k]);
+    }
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_pin_init(lt_pin_t *p, lt_handle_t *h, const lt_mac_and_destroy_slot_t macandd_slot,
+                            const uint8_t rounds, const uint16_t r_mem_slot)
+{
+    if (!p || !h || rounds == 0 || rounds > LT_PIN_ROUNDS_MAX || r_mem_slot > TR01_R_MEM_DATA_SLOT_MAX) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(p, 0, sizeof(*p));
+    p->h = h;
+    p->macandd_slot = (uint8_t)macandd_slot;
+    p->rounds = rounds;
+    p->r_mem_slot = r_mem_slot;
+    chip.pin_slot = r_mem_slot;
+    return LT_OK;
+}
+
+/** Releases the key of the PIN and caches it in the engine as lt_pin_setup() and lt_pin_verify() do. */
+static void mock_pin_unlock(lt_pin_t *p, const uint8_t *pin, const uint8_t pin_len, uint8_t *key)
+{
+    memset(p->pin_tag, 0, sizeof(p->pin_tag));
+    memcpy(p->pin_tag, pin, pin_len);
+    mock_fill(p->key, sizeof(p->key), pin_len);
+    memcpy(key, p->key, LT_PIN_KEY_LEN);
+    p->cached = 1;
+}
+
+lt_ret_t __wrap_lt_pin_setup(lt_pin_t *p, const uint8_t *master_secret, const uint8_t *pin, const uint8_t pin_len,
+                             const uint8_t *add, const uint8_t add_len, uint8_t *key)
+{
+    LT_UNUSED(master_secret);
+    LT_UNUSED(add);
+    LT_UNUSED(add_len);
+    if (!p || !pin || !key || pin_len < LT_PIN_LEN_MIN || pin_len > LT_PIN_LEN_MAX) {
+        return LT_PARAM_ERR;
+    }
+    if (mock_call(LT_MOCK_AVP_PIN_SETUP, p->r_mem_slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+
+    uint8_t *slot = chip.r_mem[p->r_mem_slot];
+    slot[0] = p->rounds;
+    slot[1] = pin_len;
+    memcpy(&slot[MOCK_PIN_HDR_LEN], pin, pin_len);
+    chip.r_mem_len[p->r_mem_slot] = MOCK_PIN_HDR_LEN + pin_len;
+
+    mock_pin_unlock(p, pin, pin_len, key);
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_pin_verify(lt_pin_t *p, const uint8_t *pin, const uint8_t pin_len, const uint8_t *add,
+                              const uint8_t add_len, uint8_t *key)
+{
+    LT_UNUSED(add);
+    LT_UNUSED(add_len);
+    if (!p || !pin || !key || pin_len < LT_PIN_LEN_MIN || pin_len > LT_PIN_LEN_MAX) {
+        return LT_PARAM_ERR;
+    }
+
+    // Key cached by the engine is released without MAC-and-Destroy
+    uint8_t tag[LT_PIN_KEY_LEN] = {0};
+    memcpy(tag, pin, pin_len);
+    if (p->cached && memcmp(tag, p->pin_tag, sizeof(tag)) == 0) {
+        memcpy(key, p->key, LT_PIN_KEY_LEN);
+        return LT_OK;
+    }
+
+    if (mock_call(LT_MOCK_AVP_PIN_VERIFY, p->r_mem_slot)) {
+        return LT_L1_SPI_ERROR;
+    }
+    uint8_t *slot = chip.r_mem[p->r_mem_slot];
+    if (chip.r_mem_len[p->r_mem_slot] == 0) {
+        return LT_L3_R_MEM_DATA_READ_SLOT_EMPTY;
+    }
+    if (slot[0] == 0) {
+        return LT_FAIL;
+    }
+    if (slot[1] != pin_len || memcmp(&slot[MOCK_PIN_HDR_LEN], pin, pin_len) != 0) {
+        // Wrong PIN destroys one attempt
+        slot[0]--;
+        p->cached = 0;
+        return LT_FAIL;
+    }
+
+    slot[0] = p->rounds;
+    mock_pin_unlock(p, pin, pin_len, key);
+    return LT_OK;
+}
+
+lt_ret_t __wrap_lt_pin_lock(lt_pin_t *p)
+{
+    if (!p) {
+        return LT_PARAM_ERR;
+    }
+
+    memset(p->pin_tag, 0, sizeof(p->pin_tag));
+    memset(p->key, 0, sizeof(p->key));
+    p->cached = 0;
+    return LT_OK;
+}
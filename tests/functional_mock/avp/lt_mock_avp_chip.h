@@ -0,0 +1,162 @@
+#ifndef LT_MOCK_AVP_CHIP_H
+#define LT_MOCK_AVP_CHIP_H
+
+/**
+ * @file lt_mock_avp_chip.h
+ * @brief RAM model of TROPIC01 for the functional mock tests of the AVP layer.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ *
+ * The AVP tests are linked with `--wrap=<function>` for every libtropic function called by the AVP layer (see
+ * LT_MOCK_AVP_WRAPPED in CMakeLists.txt), so these calls are served by the model instead of going to the mock HAL.
+ * The model keeps R-memory, monotonic counters, ECC key slots and the PIN engine state, counts the calls and fails
+ * selected ones on request. Its state outlives a vault, so a new vault sees what an old one left on the chip.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libtropic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief R_Mem_Data User Data slot size reported by the model in `tr01_attrs` (RISC-V FW 1.0.0 and later). */
+#define LT_MOCK_AVP_R_MEM_SLOT_SIZE 444
+
+/** @brief Slot argument of lt_mock_avp_fail() matching any slot. */
+#define LT_MOCK_AVP_ANY_SLOT 0xFFFF
+
+/** @brief Operations of the model, counted by lt_mock_avp_calls() and failed by lt_mock_avp_fail(). */
+typedef enum {
+    LT_MOCK_AVP_INIT = 0,
+    LT_MOCK_AVP_RANDOM,
+    LT_MOCK_AVP_R_MEM_READ,
+    LT_MOCK_AVP_R_MEM_WRITE,
+    LT_MOCK_AVP_R_MEM_ERASE,
+    LT_MOCK_AVP_MCOUNTER_GET,
+    LT_MOCK_AVP_MCOUNTER_INIT,
+    LT_MOCK_AVP_MCOUNTER_UPDATE,
+    LT_MOCK_AVP_ECC_GENERATE,
+    LT_MOCK_AVP_ECC_READ,
+    LT_MOCK_AVP_ECC_ERASE,
+    LT_MOCK_AVP_ECDSA_SIGN,
+    LT_MOCK_AVP_EDDSA_SIGN,
+    LT_MOCK_AVP_GET_INFO,
+    LT_MOCK_AVP_PIN_SETUP,
+    /** @brief PIN verification by MAC-and-Destroy, a key reused from the cache of the PIN engine is not counted. */
+    LT_MOCK_AVP_PIN_VERIFY,
+    LT_MOCK_AVP_OPS
+} lt_mock_avp_op_t;
+
+/**
+ * @brief Resets the model to a blank chip: empty R-memory and ECC slots, uninitialized counters, no PIN.
+ * @note Also clears the call counters, the pending failure and the clock.
+ */
+void lt_mock_avp_chip_reset(void);
+
+/**
+ * @brief Fails one later call of the operation with LT_L1_SPI_ERROR, the chip state is not changed by it.
+ *
+ * @param op    Operation to fail
+ * @param slot  R-memory, ECC or counter slot the call has to address, LT_MOCK_AVP_ANY_SLOT for any
+ * @param nth   Matching call to fail, 1 for the next one
+ */
+void lt_mock_avp_fail(const lt_mock_avp_op_t op, const uint16_t slot, const unsigned nth);
+
+/**
+ * @brief Tells whether the failure set by lt_mock_avp_fail() is still pending.
+ *
+ * @return true if the failure was not injected yet
+ */
+bool lt_mock_avp_fail_pending(void);
+
+/**
+ * @brief Returns number of calls of the operation since the last lt_mock_avp_calls_reset().
+ *
+ * @param op  Operation
+ * @return    Number of calls, failed ones included
+ */
+unsigned lt_mock_avp_calls(const lt_mock_avp_op_t op);
+
+/**
+ * @brief Returns number of calls of all operations talking to TROPIC01 since the last lt_mock_avp_calls_reset().
+ *
+ * @return Number of calls
+ */
+unsigned lt_mock_avp_calls_all(void);
+
+/** @brief Clears the call counters. */
+void lt_mock_avp_calls_reset(void);
+
+/**
+ * @brief Returns contents of the R-memory slot.
+ *
+ * @param slot  R-memory slot
+ * @param len   Length of the contents, 0 if the slot is empty
+ * @return      Contents, may be changed by the test (e.g. to simulate another host or a corruption)
+ */
+uint8_t *lt_mock_avp_r_mem(const uint16_t slot, uint16_t *len);
+
+/**
+ * @brief Returns number of remaining PIN attempts.
+ *
+ * @return Remaining attempts, 0 if no PIN is set
+ */
+uint8_t lt_mock_avp_pin_attempts(void);
+
+/**
+ * @brief Monotonic clock of the AVP layer in seconds, AVP_CLOCK_S() of the AVP tests.
+ *
+ * @return Time in seconds
+ */
+uint32_t lt_mock_avp_clock_s(void);
+
+/**
+ * @brief Moves the clock of lt_mock_avp_clock_s() forward.
+ *
+ * @param s  Seconds to add
+ */
+void lt_mock_avp_clock_advance(const uint32_t s);
+
+// Wrappers of the libtropic functions, called instead of them thanks to `--wrap`.
+lt_ret_t __wrap_lt_init(lt_handle_t *h);
+lt_ret_t __wrap_lt_deinit(lt_handle_t *h);
+lt_ret_t __wrap_lt_random_value_get(lt_handle_t *h, uint8_t *rnd_bytes, const uint16_t rnd_bytes_cnt);
+lt_ret_t __wrap_lt_r_mem_data_read(lt_handle_t *h, const uint16_t udata_slot, uint8_t *data,
+                                   const uint16_t data_max_size, uint16_t *data_read_size);
+lt_ret_t __wrap_lt_r_mem_data_write(lt_handle_t *h, const uint16_t udata_slot, const uint8_t *data,
+                                    const uint16_t data_size);
+lt_ret_t __wrap_lt_r_mem_data_erase(lt_handle_t *h, const uint16_t udata_slot);
+lt_ret_t __wrap_lt_mcounter_get(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index,
+                                uint32_t *mcounter_value);
+lt_ret_t __wrap_lt_mcounter_init(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index,
+                                 const uint32_t mcounter_value);
+lt_ret_t __wrap_lt_mcounter_update(lt_handle_t *h, const enum lt_mcounter_index_t mcounter_index);
+lt_ret_t __wrap_lt_ecc_key_erase(lt_handle_t *h, const lt_ecc_slot_t ecc_slot);
+lt_ret_t __wrap_lt_ecc_key_generate(lt_handle_t *h, const lt_ecc_slot_t slot, const lt_ecc_curve_type_t curve);
+lt_ret_t __wrap_lt_ecc_key_read(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, uint8_t *key,
+                                const uint8_t key_max_size, lt_ecc_curve_type_t *curve, lt_ecc_key_origin_t *origin);
+lt_ret_t __wrap_lt_ecc_ecdsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg,
+                                  const uint32_t msg_len, uint8_t *rs);
+lt_ret_t __wrap_lt_ecc_eddsa_sign(lt_handle_t *h, const lt_ecc_slot_t ecc_slot, const uint8_t *msg,
+                                  const uint16_t msg_len, uint8_t *rs);
+lt_ret_t __wrap_lt_get_info_chip_id(lt_handle_t *h, struct lt_chip_id_t *chip_id);
+lt_ret_t __wrap_lt_get_info_riscv_fw_ver(lt_handle_t *h, uint8_t *ver);
+lt_ret_t __wrap_lt_get_info_spect_fw_ver(lt_handle_t *h, uint8_t *ver);
+lt_ret_t __wrap_lt_get_info_cert_store(lt_handle_t *h, struct lt_cert_store_t *store);
+lt_ret_t __wrap_lt_pin_init(lt_pin_t *p, lt_handle_t *h, const lt_mac_and_destroy_slot_t macandd_slot,
+                            const uint8_t rounds, const uint16_t r_mem_slot);
+lt_ret_t __wrap_lt_pin_setup(lt_pin_t *p, const uint8_t *master_secret, const uint8_t *pin, const uint8_t pin_len,
+                             const uint8_t *add, const uint8_t add_len, uint8_t *key);
+lt_ret_t __wrap_lt_pin_verify(lt_pin_t *p, const uint8_t *pin, const uint8_t pin_len, const uint8_t *add,
+                              const uint8_t add_len, uint8_t *key);
+lt_ret_t __wrap_lt_pin_lock(lt_pin_t *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_MOCK_AVP_CHIP_H
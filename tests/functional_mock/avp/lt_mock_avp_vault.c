@@ -0,0 +1,40 @@
+/**
+ * @file lt_mock_avp_vault.c
+ * @brief Helpers setting up AVP vaults over the chip model for the functional mock tests of the AVP layer.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include "lt_mock_avp_vault.h"
+
+#include "lt_mock_avp_chip.h"
+
+avp_ret_t lt_mock_avp_vault_init(lt_handle_t *h, avp_vault_t *vault)
+{
+    vault->lt_handle.l3.crypto_ctx = h->l3.crypto_ctx;
+    return avp_init(vault, h->l2.device);
+}
+
+avp_ret_t lt_mock_avp_vault_open(lt_handle_t *h, avp_vault_t *vault, const char *workspace, const uint32_t ttl_s)
+{
+    lt_mock_avp_chip_reset();
+
+    avp_ret_t ret = lt_mock_avp_vault_init(h, vault);
+    if (ret == AVP_OK) {
+        ret = avp_set_pin(vault, NULL, LT_MOCK_AVP_PIN);
+    }
+    if (ret == AVP_OK) {
+        ret = avp_authenticate(vault, workspace, LT_MOCK_AVP_PIN, ttl_s);
+    }
+
+    lt_mock_avp_calls_reset();
+    return ret;
+}
+
+void lt_mock_avp_value(uint8_t *buf, const size_t len, const uint8_t seed)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(seed + i * 7 + (i >> 8));
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef LT_MOCK_AVP_VAULT_H
+#define LT_MOCK_AVP_VAULT_H
+
+/**
+ * @file lt_mock_avp_vault.h
+ * @brief Helpers setting up AVP vaults over the chip model for the functional mock tests of the AVP layer.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief PIN set by lt_mock_avp_vault_open(). */
+#define LT_MOCK_AVP_PIN "271828"
+
+/**
+ * @brief Initializes the vault by avp_init() with the device and CAL context of the handle of the test.
+ * @note A vault abandoned without avp_deinit() and a new one initialized by this simulate a reset of the host.
+ *
+ * @param h      Handle for communication with TROPIC01 passed to the test
+ * @param vault  Vault to initialize
+ * @return       Result of avp_init()
+ */
+avp_ret_t lt_mock_avp_vault_init(lt_handle_t *h, avp_vault_t *vault);
+
+/**
+ * @brief Resets the chip model to a blank chip, initializes the vault, sets LT_MOCK_AVP_PIN and authenticates.
+ * @note Clears the call counters of the chip model afterwards.
+ *
+ * @param h          Handle for communication with TROPIC01 passed to the test
+ * @param vault      Vault to initialize
+ * @param workspace  Workspace to authenticate to, NULL for "default"
+ * @param ttl_s      Session TTL in seconds, 0 for default
+ * @return           AVP_OK on success, result of the first failed operation otherwise
+ */
+avp_ret_t lt_mock_avp_vault_open(lt_handle_t *h, avp_vault_t *vault, const char *workspace, const uint32_t ttl_s);
+
+/**
+ * @brief Fills the buffer with a pattern of the seed, the value of a test secret.
+ *
+ * @param buf   Buffer to fill
+ * @param len   Length of buf
+ * @param seed  Seed of the pattern, different seeds give different values
+ */
+void lt_mock_avp_value(uint8_t *buf, const size_t len, const uint8_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LT_MOCK_AVP_VAULT_H
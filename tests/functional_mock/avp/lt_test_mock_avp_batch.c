@@ -0,0 +1,157 @@
+/**
+ * @file lt_test_mock_avp_batch.c
+ * @brief Test AVP batch commit through the journal, its replay and erases failing on the chip.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Returns number of secret slots holding data on the chip, the last of them in slot. */
+static unsigned avp_test_used_slots(uint16_t *slot)
+{
+    unsigned used = 0;
+    uint16_t len;
+
+    for (uint16_t s = 0; s < AVP_TROPIC_KEY_SLOTS; s++) {
+        lt_mock_avp_r_mem(AVP_SECRET_FIRST_SLOT + s, &len);
+        if (len > 0) {
+            used++;
+            if (slot != NULL) {
+                *slot = s;
+            }
+        }
+    }
+
+    return used;
+}
+
+/** Reads the secret back and compares it with the expected value. */
+static void avp_test_check(avp_vault_t *vault, const char *name, const char *expected)
+{
+    uint8_t value[32];
+    size_t value_len = sizeof(value);
+
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(vault, name, value, &value_len));
+    LT_TEST_ASSERT(strlen(expected), value_len);
+    LT_TEST_ASSERT(0, memcmp(expected, value, value_len));
+}
+
+/** Checks the secret is not stored. */
+static void avp_test_missing(avp_vault_t *vault, const char *name)
+{
+    uint8_t value[32];
+    size_t value_len = sizeof(value);
+
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_retrieve(vault, name, value, &value_len));
+}
+
+/** Checks no commit record is left on the chip. */
+static void avp_test_journal_empty(void)
+{
+    uint16_t len;
+
+    lt_mock_avp_r_mem(AVP_JOURNAL_SLOT, &len);
+    LT_TEST_ASSERT(0, len);
+}
+
+void lt_test_mock_avp_batch(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_batch()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    uint16_t len, slot;
+    bool deleted;
+
+    LT_LOG_INFO("Verifying a batch is applied by its commit...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, 0));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_batch_commit(&vault));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "a", (const uint8_t *)"a1", 2));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "b", (const uint8_t *)"b1", 2));
+    LT_TEST_ASSERT(AVP_OK, avp_batch_begin(&vault));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_batch_begin(&vault));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "a", (const uint8_t *)"a2", 2));
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "b", &deleted));
+    LT_TEST_ASSERT(true, deleted);
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "c", (const uint8_t *)"c1", 2));
+    // Released slots keep their contents until the commit
+    LT_TEST_ASSERT(4, avp_test_used_slots(NULL));
+    LT_TEST_ASSERT(AVP_OK, avp_batch_commit(&vault));
+    LT_TEST_ASSERT(2, avp_test_used_slots(NULL));
+    avp_test_journal_empty();
+    avp_test_check(&vault, "a", "a2");
+    avp_test_missing(&vault, "b");
+    avp_test_check(&vault, "c", "c1");
+
+    LT_LOG_INFO("Verifying a commit failing before its record leaves the batch unapplied...");
+    LT_TEST_ASSERT(AVP_OK, avp_batch_begin(&vault));
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "c", &deleted));
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_WRITE, AVP_JOURNAL_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_batch_commit(&vault));
+    avp_test_journal_empty();
+    LT_TEST_ASSERT(2, avp_test_used_slots(NULL));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    avp_test_check(&vault, "a", "a2");
+    avp_test_check(&vault, "c", "c1");
+
+    LT_LOG_INFO("Verifying a new vault replays the journal of a commit interrupted after its record...");
+    LT_TEST_ASSERT(AVP_OK, avp_batch_begin(&vault));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "a", (const uint8_t *)"a4", 2));
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "c", &deleted));
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_WRITE, AVP_DIR_FIRST_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_batch_commit(&vault));
+    lt_mock_avp_r_mem(AVP_JOURNAL_SLOT, &len);
+    LT_TEST_ASSERT(true, len > 0);
+    // Directory slot is erased and not written again, only the journal describes the secrets
+    lt_mock_avp_r_mem(AVP_DIR_FIRST_SLOT, &len);
+    LT_TEST_ASSERT(0, len);
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    avp_test_journal_empty();
+    avp_test_check(&vault, "a", "a4");
+    avp_test_missing(&vault, "c");
+    LT_TEST_ASSERT(1, avp_test_used_slots(NULL));
+
+    LT_LOG_INFO("Verifying a released slot failing to erase at commit stays queued for avp_idle()...");
+    LT_TEST_ASSERT(1, avp_test_used_slots(&slot));
+    LT_TEST_ASSERT(AVP_OK, avp_batch_begin(&vault));
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "a", &deleted));
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_ERASE, AVP_SECRET_FIRST_SLOT + slot, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_batch_commit(&vault));
+    LT_TEST_ASSERT(1, avp_test_used_slots(NULL));
+    LT_TEST_ASSERT(1, (vault.erase_pending[slot / 8] >> (slot % 8)) & 1);
+    LT_TEST_ASSERT(AVP_OK, avp_flush(&vault));
+    LT_TEST_ASSERT(0, avp_test_used_slots(NULL));
+    LT_TEST_ASSERT(0, (vault.erase_pending[slot / 8] >> (slot % 8)) & 1);
+    // Record of the commit is still there, it is replayed at the next AUTHENTICATE
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    avp_test_journal_empty();
+    avp_test_missing(&vault, "a");
+
+    LT_LOG_INFO("Verifying a slot failing to erase at DELETE stays queued for avp_idle()...");
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "d", (const uint8_t *)"d1", 2));
+    LT_TEST_ASSERT(1, avp_test_used_slots(&slot));
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_ERASE, AVP_SECRET_FIRST_SLOT + slot, 1);
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "d", &deleted));
+    LT_TEST_ASSERT(false, deleted);
+    avp_test_missing(&vault, "d");
+    LT_TEST_ASSERT(1, avp_test_used_slots(NULL));
+    LT_TEST_ASSERT(1, (vault.erase_pending[slot / 8] >> (slot % 8)) & 1);
+    LT_TEST_ASSERT(AVP_OK, avp_flush(&vault));
+    LT_TEST_ASSERT(0, avp_test_used_slots(NULL));
+
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+}
@@ -0,0 +1,166 @@
+/**
+ * @file lt_test_mock_avp_cache.c
+ * @brief Test AVP secret cache, refresh-ahead by avp_idle() and prefetch after AUTHENTICATE.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Session outlasting the clock moves of the test. */
+#define AVP_TEST_TTL_S 3600
+
+/** Value longer than AVP_SECRET_CACHE_VALUE_LEN, never cached. */
+#define AVP_TEST_BIG_LEN (AVP_SECRET_CACHE_VALUE_LEN + 100)
+
+/** Reads the secret and checks its value and the number of R-memory reads it took. */
+static void avp_test_retrieve(avp_vault_t *vault, const char *name, const uint8_t *expected, const size_t len,
+                              const unsigned reads)
+{
+    uint8_t value[AVP_TEST_BIG_LEN];
+    size_t value_len = sizeof(value);
+
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(vault, name, value, &value_len));
+    LT_TEST_ASSERT(len, value_len);
+    LT_TEST_ASSERT(0, memcmp(expected, value, len));
+    LT_TEST_ASSERT(reads, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+}
+
+void lt_test_mock_avp_cache(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_cache()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    uint8_t db[32], api[32], big[AVP_TEST_BIG_LEN];
+    uint8_t value[sizeof(db)];
+    size_t value_len;
+
+    lt_mock_avp_value(db, sizeof(db), 1);
+    lt_mock_avp_value(api, sizeof(api), 2);
+    lt_mock_avp_value(big, sizeof(big), 3);
+
+    LT_LOG_INFO("Verifying RETRIEVE is served from the cache after the first read...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "db", db, sizeof(db)));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "api", api, sizeof(api)));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "big", big, sizeof(big)));
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 1);
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 0);
+    LT_TEST_ASSERT(1, vault.metrics.secret_cache_hits);
+    LT_TEST_ASSERT(1, vault.metrics.secret_cache_misses);
+    value_len = sizeof(db) - 1;
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_retrieve(&vault, "db", value, &value_len));
+
+    LT_LOG_INFO("Verifying values longer than AVP_SECRET_CACHE_VALUE_LEN are always read...");
+    avp_test_retrieve(&vault, "big", big, sizeof(big), 2);
+    avp_test_retrieve(&vault, "big", big, sizeof(big), 2);
+
+    LT_LOG_INFO("Verifying STORE of a cached secret caches the new value...");
+    lt_mock_avp_value(db, sizeof(db), 4);
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "db", db, sizeof(db)));
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 0);
+
+    LT_LOG_INFO("Verifying the cache is purged by AUTHENTICATE and by the end of the session...");
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 1);
+    lt_mock_avp_clock_advance(AVP_TEST_TTL_S);
+    value_len = sizeof(value);
+    LT_TEST_ASSERT(AVP_ERR_SESSION_EXPIRED, avp_retrieve(&vault, "db", value, &value_len));
+    for (size_t i = 0; i < AVP_SECRET_CACHE_ENTRIES; i++) {
+        LT_TEST_ASSERT(false, vault.cache[i].used);
+    }
+
+    LT_LOG_INFO("Verifying avp_idle() reads the cached secrets again before their TTL...");
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    // Run the scheduled prefetch first, the manifest is still empty
+    LT_TEST_ASSERT(AVP_OK, avp_prefetch(&vault));
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 1);
+    lt_mock_avp_clock_advance(AVP_SECRET_REFRESH_TTL_S - AVP_SECRET_REFRESH_AHEAD_S - 1);
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 0));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+    lt_mock_avp_clock_advance(1);
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 0));
+    LT_TEST_ASSERT(1, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+    lt_mock_avp_clock_advance(AVP_SECRET_REFRESH_TTL_S - 1);
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 0);
+
+    LT_LOG_INFO("Verifying an entry not refreshed in time is read from TROPIC01...");
+    lt_mock_avp_clock_advance(1);
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 1);
+
+    LT_LOG_INFO("Verifying a change of the secrets by another host is refreshed by avp_idle()...");
+    LT_TEST_ASSERT(LT_OK, __wrap_lt_mcounter_update(&vault.lt_handle, AVP_MCOUNTER_INDEX));
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 0));
+    LT_TEST_ASSERT(true, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ) > 1);
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 0);
+
+    LT_LOG_INFO("Verifying a chip error of the refresh drops the entry...");
+    lt_mock_avp_clock_advance(AVP_SECRET_REFRESH_TTL_S - AVP_SECRET_REFRESH_AHEAD_S);
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_READ, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_idle(&vault, 0));
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 1);
+
+    LT_LOG_INFO("Verifying avp_prefetch_set() errors...");
+    const char *const too_many[AVP_PREFETCH_ENTRIES + 1] = {"db"};
+    const char *const invalid[] = {"api", "9db"};
+    LT_TEST_ASSERT(AVP_ERR_CAPACITY_EXCEEDED, avp_prefetch_set(&vault, too_many, AVP_PREFETCH_ENTRIES + 1));
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_prefetch_set(&vault, invalid, 2));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_prefetch_set(&vault, NULL, 1));
+    LT_TEST_ASSERT(AVP_OK, avp_prefetch_set(&vault, NULL, 0));
+
+    LT_LOG_INFO("Verifying the recently used secrets are saved in the manifest...");
+    uint16_t manifest_len;
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 0));
+    lt_mock_avp_r_mem(AVP_PREFETCH_SLOT, &manifest_len);
+    LT_TEST_ASSERT(true, manifest_len > 0);
+    // Set of the recently used secrets did not change, the manifest is not written again
+    LT_TEST_ASSERT(0, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_WRITE));
+
+    LT_LOG_INFO("Verifying the configured and the recently used secrets are prefetched after AUTHENTICATE...");
+    const char *const names[] = {"api"};
+    LT_TEST_ASSERT(AVP_OK, avp_prefetch_set(&vault, names, 1));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(AVP_OK, avp_prefetch(&vault));
+    avp_test_retrieve(&vault, "api", api, sizeof(api), 0);
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 0);
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_prefetch(&vault));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls_all());
+    // "api" is used now, it enters the manifest
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 0));
+    LT_TEST_ASSERT(true, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_WRITE) > 0);
+
+    LT_LOG_INFO("Verifying a new vault is prefetched from the manifest by avp_idle()...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 0));
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 0);
+    avp_test_retrieve(&vault, "api", api, sizeof(api), 0);
+
+    LT_LOG_INFO("Verifying a chip error of the prefetch...");
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_READ, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_prefetch(&vault));
+    avp_test_retrieve(&vault, "db", db, sizeof(db), 1);
+
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_prefetch(&vault));
+}
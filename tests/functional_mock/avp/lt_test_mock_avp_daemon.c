@@ -0,0 +1,216 @@
+/**
+ * @file lt_test_mock_avp_daemon.c
+ * @brief Test AVP vault daemon serving agent processes and its secure arena.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "avp_daemon.h"
+#include "avp_secure_arena.h"
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Requests of each agent process of the concurrent part. */
+#define AVP_TEST_ROUNDS 8
+
+/** Socket of the daemon. */
+static char avp_test_path[AVP_DAEMON_PATH_MAX];
+
+/** Reads the secret through the agent and compares it with the expected value. */
+static void avp_test_check(avp_agent_t *agent, const char *name, const char *expected)
+{
+    uint8_t value[32];
+    size_t value_len = sizeof(value);
+
+    LT_TEST_ASSERT(AVP_OK, avp_agent_retrieve(agent, name, value, &value_len));
+    LT_TEST_ASSERT(strlen(expected), value_len);
+    LT_TEST_ASSERT(0, memcmp(expected, value, value_len));
+}
+
+/** Agent process of the first part: two agents of one workspace, a third one refused. */
+static void avp_test_agents(const unsigned id)
+{
+    (void)id;
+    avp_agent_t a1, a2, a3;
+    avp_secret_metadata_t secrets[4];
+    char text[4096];
+    size_t count, text_len;
+    bool deleted;
+
+    LT_LOG_INFO("Verifying connections beyond AVP_DAEMON_CLIENTS are refused...");
+    LT_TEST_ASSERT(AVP_OK, avp_agent_connect(&a1, avp_test_path));
+    LT_TEST_ASSERT(AVP_OK, avp_agent_connect(&a2, avp_test_path));
+    LT_TEST_ASSERT(AVP_ERR_CAPACITY_EXCEEDED, avp_agent_connect(&a3, avp_test_path));
+
+    LT_LOG_INFO("Verifying an agent must AUTHENTICATE with the right PIN first...");
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_agent_store(&a1, "token", (const uint8_t *)"one", 3));
+    LT_TEST_ASSERT(AVP_ERR_AUTHENTICATION_FAILED, avp_agent_authenticate(&a1, NULL, "000000", 0));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_agent_store(&a1, "token", (const uint8_t *)"one", 3));
+    LT_TEST_ASSERT(AVP_OK, avp_agent_authenticate(&a1, NULL, LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_agent_list(&a2, secrets, 4, &count));
+
+    LT_LOG_INFO("Verifying agents of one workspace share its secrets...");
+    LT_TEST_ASSERT(AVP_OK, avp_agent_store(&a1, "token", (const uint8_t *)"one", 3));
+    LT_TEST_ASSERT(AVP_OK, avp_agent_authenticate(&a2, NULL, LT_MOCK_AVP_PIN, 0));
+    avp_test_check(&a2, "token", "one");
+    LT_TEST_ASSERT(AVP_OK, avp_agent_store(&a2, "token", (const uint8_t *)"two", 3));
+    avp_test_check(&a1, "token", "two");
+    LT_TEST_ASSERT(AVP_OK, avp_agent_list(&a1, secrets, 4, &count));
+    LT_TEST_ASSERT(1, count);
+    LT_TEST_ASSERT(0, strcmp("token", secrets[0].name));
+
+    LT_LOG_INFO("Verifying DELETE through an agent...");
+    LT_TEST_ASSERT(AVP_OK, avp_agent_delete(&a1, "token", &deleted));
+    LT_TEST_ASSERT(true, deleted);
+    LT_TEST_ASSERT(AVP_OK, avp_agent_delete(&a2, "token", &deleted));
+    LT_TEST_ASSERT(false, deleted);
+    uint8_t value[8];
+    size_t value_len = sizeof(value);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_agent_retrieve(&a2, "token", value, &value_len));
+
+    LT_LOG_INFO("Verifying METRICS counts the requests and the refused connection...");
+    LT_TEST_ASSERT(AVP_OK, avp_agent_metrics(&a1, text, sizeof(text), &text_len));
+    LT_TEST_ASSERT(true, text_len < sizeof(text));
+    LT_TEST_ASSERT(true, strstr(text, "avp_daemon_requests_total{op=\"authenticate\"} 3\n") != NULL);
+    LT_TEST_ASSERT(true, strstr(text, "avp_daemon_requests_total{op=\"delete\"} 2\n") != NULL);
+    LT_TEST_ASSERT(true, strstr(text, "avp_daemon_agents 2\n") != NULL);
+    LT_TEST_ASSERT(true, strstr(text, "avp_daemon_refused_total 1\n") != NULL);
+
+    avp_agent_disconnect(&a1);
+    avp_agent_disconnect(&a2);
+}
+
+/** Agent process of the concurrent part, stores and reads back its own secret. */
+static void avp_test_worker(const unsigned id)
+{
+    avp_agent_t agent;
+    char name[16], expected[16];
+
+    snprintf(name, sizeof(name), "w%u", id);
+    LT_TEST_ASSERT(AVP_OK, avp_agent_connect(&agent, avp_test_path));
+    LT_TEST_ASSERT(AVP_OK, avp_agent_authenticate(&agent, NULL, LT_MOCK_AVP_PIN, 0));
+    for (unsigned k = 0; k < AVP_TEST_ROUNDS; k++) {
+        snprintf(expected, sizeof(expected), "w%u-%u", id, k);
+        LT_TEST_ASSERT(AVP_OK, avp_agent_store(&agent, name, (const uint8_t *)expected, strlen(expected)));
+        avp_test_check(&agent, name, expected);
+    }
+    avp_agent_disconnect(&agent);
+}
+
+/** Serves the agent processes until all of them exit, checks they all succeeded. */
+static void avp_test_serve(avp_daemon_t *daemon, size_t processes)
+{
+    int status;
+
+    while (processes > 0) {
+        LT_TEST_ASSERT(AVP_OK, avp_daemon_run(daemon, 10, NULL));
+        pid_t pid = waitpid(-1, &status, WNOHANG);
+        if (pid > 0) {
+            LT_TEST_ASSERT(true, WIFEXITED(status));
+            LT_TEST_ASSERT(0, WEXITSTATUS(status));
+            processes--;
+        }
+    }
+}
+
+/** Runs the agent function in a child process. */
+static void avp_test_spawn(void (*agent_fn)(unsigned), const unsigned id)
+{
+    // Logs buffered so far would be written by the child too
+    fflush(stdout);
+    pid_t pid = fork();
+    LT_TEST_ASSERT(true, pid >= 0);
+    if (pid == 0) {
+        agent_fn(id);
+        fflush(stdout);
+        _exit(0);
+    }
+}
+
+void lt_test_mock_avp_daemon(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_daemon()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    avp_daemon_t daemon;
+    avp_arena_t arena;
+    size_t len;
+
+    LT_LOG_INFO("Verifying the secure arena hands out wiped blocks of the fitting class...");
+    const uint16_t blocks[AVP_ARENA_CLASSES] = {2, 1};
+    LT_TEST_ASSERT(AVP_OK, avp_arena_open(&arena, blocks));
+    uint8_t *b1 = avp_arena_alloc(&arena, 10);
+    uint8_t *b2 = avp_arena_alloc(&arena, AVP_ARENA_MIN_BLOCK);
+    uint8_t *b3 = avp_arena_alloc(&arena, 1);
+    LT_TEST_ASSERT(true, b1 != NULL && b2 != NULL && b3 != NULL);
+    LT_TEST_ASSERT(0, (uintptr_t)b1 % AVP_ARENA_ALIGN);
+    // Smallest class is used up, the next one is taken
+    LT_TEST_ASSERT(true, avp_arena_owns(&arena, b3, &len));
+    LT_TEST_ASSERT(1, len);
+    LT_TEST_ASSERT(true, avp_arena_alloc(&arena, 1) == NULL);
+    LT_TEST_ASSERT(true, avp_arena_alloc(&arena, 0) == NULL);
+    LT_TEST_ASSERT(true, avp_arena_alloc(&arena, AVP_ARENA_BLOCK_LEN(AVP_ARENA_CLASSES - 1) + 1) == NULL);
+    memset(b1, 0xa5, 10);
+    LT_TEST_ASSERT(AVP_OK, avp_arena_free(&arena, b1));
+    LT_TEST_ASSERT(false, avp_arena_owns(&arena, b1, NULL));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_arena_free(&arena, b1));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_arena_free(&arena, b2 + 1));
+    LT_TEST_ASSERT(AVP_OK, avp_arena_free(&arena, NULL));
+    b1 = avp_arena_alloc(&arena, 10);
+    LT_TEST_ASSERT(true, b1 != NULL);
+    for (size_t i = 0; i < 10; i++) {
+        LT_TEST_ASSERT(0, b1[i]);
+    }
+    avp_arena_close(&arena);
+
+    LT_LOG_INFO("Verifying the daemon serves agent processes...");
+    snprintf(avp_test_path, sizeof(avp_test_path), "/tmp/lt_test_mock_avp_daemon_%d.sock", (int)getpid());
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, 0));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_daemon_open(&daemon, NULL, avp_test_path));
+    LT_TEST_ASSERT(AVP_OK, avp_daemon_open(&daemon, &vault, avp_test_path));
+    avp_test_spawn(avp_test_agents, 0);
+    avp_test_serve(&daemon, 1);
+
+    LT_LOG_INFO("Verifying concurrent agents are served...");
+    const uint64_t stores = daemon.metrics.requests[AVP_DAEMON_OP_STORE];
+    for (unsigned id = 0; id < AVP_DAEMON_CLIENTS; id++) {
+        avp_test_spawn(avp_test_worker, id);
+    }
+    avp_test_serve(&daemon, AVP_DAEMON_CLIENTS);
+    LT_TEST_ASSERT(AVP_DAEMON_CLIENTS * AVP_TEST_ROUNDS, daemon.metrics.requests[AVP_DAEMON_OP_STORE] - stores);
+
+    LT_LOG_INFO("Verifying the vault holds the secrets stored by the agents...");
+    char name[16], expected[16];
+    uint8_t value[16];
+    for (unsigned id = 0; id < AVP_DAEMON_CLIENTS; id++) {
+        snprintf(name, sizeof(name), "w%u", id);
+        snprintf(expected, sizeof(expected), "w%u-%u", id, AVP_TEST_ROUNDS - 1);
+        size_t value_len = sizeof(value);
+        LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, name, value, &value_len));
+        LT_TEST_ASSERT(strlen(expected), value_len);
+        LT_TEST_ASSERT(0, memcmp(expected, value, value_len));
+    }
+
+    LT_LOG_INFO("Verifying the daemon cannot be run after it is closed...");
+    avp_daemon_close(&daemon);
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_daemon_run(&daemon, 0, NULL));
+    LT_TEST_ASSERT(true, access(avp_test_path, F_OK) != 0);
+
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+}
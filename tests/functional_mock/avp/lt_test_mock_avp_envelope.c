@@ -0,0 +1,304 @@
+/**
+ * @file lt_test_mock_avp_envelope.c
+ * @brief Test AVP envelope encryption with a host store in RAM and with the host log (avp_host_log.c).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "avp_host_log.h"
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Value too long for one R-memory slot when stored as is. */
+#define AVP_TEST_VALUE_LEN 2000
+
+/** Ciphertexts kept by the RAM host store. */
+#define AVP_TEST_BLOBS 4
+
+/** Ciphertext of one version of a secret in the RAM host store. */
+typedef struct avp_test_blob_t {
+    char name[16];
+    uint32_t version;
+    uint8_t data[AVP_TEST_VALUE_LEN + AVP_ENVELOPE_TAG_LEN];
+    size_t len;
+    bool used;
+} avp_test_blob_t;
+
+/** RAM host store, avp_host_store_t context. */
+typedef struct avp_test_host_t {
+    avp_test_blob_t blobs[AVP_TEST_BLOBS];
+    /** Result of the next put, AVP_OK to store */
+    avp_ret_t put_ret;
+} avp_test_host_t;
+
+static avp_test_blob_t *avp_test_blob_find(avp_test_host_t *host, const char *name, const uint32_t version)
+{
+    for (size_t i = 0; i < AVP_TEST_BLOBS; i++) {
+        avp_test_blob_t *blob = &host->blobs[i];
+        if (blob->used && blob->version == version && strcmp(blob->name, name) == 0) {
+            return blob;
+        }
+    }
+
+    return NULL;
+}
+
+static unsigned avp_test_blob_count(const avp_test_host_t *host)
+{
+    unsigned count = 0;
+    for (size_t i = 0; i < AVP_TEST_BLOBS; i++) {
+        count += host->blobs[i].used;
+    }
+
+    return count;
+}
+
+static avp_ret_t avp_test_put(void *ctx, const char *name, uint32_t version, const uint8_t *data, size_t len)
+{
+    avp_test_host_t *host = ctx;
+    if (host->put_ret != AVP_OK) {
+        avp_ret_t ret = host->put_ret;
+        host->put_ret = AVP_OK;
+        return ret;
+    }
+
+    avp_test_blob_t *blob = avp_test_blob_find(host, name, version);
+    for (size_t i = 0; i < AVP_TEST_BLOBS && blob == NULL; i++) {
+        blob = host->blobs[i].used ? NULL : &host->blobs[i];
+    }
+    if (blob == NULL || len > sizeof(blob->data) || strlen(name) >= sizeof(blob->name)) {
+        return AVP_ERR_CAPACITY_EXCEEDED;
+    }
+
+    strcpy(blob->name, name);
+    blob->version = version;
+    memcpy(blob->data, data, len);
+    blob->len = len;
+    blob->used = true;
+    return AVP_OK;
+}
+
+static avp_ret_t avp_test_get(void *ctx, const char *name, uint32_t version, uint8_t *data, size_t *len)
+{
+    avp_test_blob_t *blob = avp_test_blob_find(ctx, name, version);
+    if (blob == NULL) {
+        return AVP_ERR_SECRET_NOT_FOUND;
+    }
+    if (*len < blob->len) {
+        return AVP_ERR_INTERNAL;
+    }
+
+    memcpy(data, blob->data, blob->len);
+    *len = blob->len;
+    return AVP_OK;
+}
+
+static avp_ret_t avp_test_remove(void *ctx, const char *name, uint32_t keep_version)
+{
+    avp_test_host_t *host = ctx;
+    for (size_t i = 0; i < AVP_TEST_BLOBS; i++) {
+        avp_test_blob_t *blob = &host->blobs[i];
+        if (blob->used && strcmp(blob->name, name) == 0 && (keep_version == 0 || blob->version != keep_version)) {
+            blob->used = false;
+        }
+    }
+
+    return AVP_OK;
+}
+
+/** Returns number of secret slots holding data on the chip. */
+static unsigned avp_test_used_slots(void)
+{
+    unsigned used = 0;
+    uint16_t len;
+
+    for (uint16_t slot = 0; slot < AVP_TROPIC_KEY_SLOTS; slot++) {
+        lt_mock_avp_r_mem(AVP_SECRET_FIRST_SLOT + slot, &len);
+        used += (len > 0);
+    }
+
+    return used;
+}
+
+/** Reads the secret and returns the result, the value is compared on success. */
+static avp_ret_t avp_test_retrieve(avp_vault_t *vault, const char *name, const uint8_t *expected, const size_t len)
+{
+    uint8_t value[AVP_TEST_VALUE_LEN];
+    size_t value_len = sizeof(value);
+
+    avp_ret_t ret = avp_retrieve(vault, name, value, &value_len);
+    if (ret == AVP_OK) {
+        LT_TEST_ASSERT(len, value_len);
+        LT_TEST_ASSERT(0, memcmp(expected, value, len));
+    }
+
+    return ret;
+}
+
+/** Returns size of the file, 0 if it does not exist. */
+static long avp_test_file_size(const char *path, const char *suffix)
+{
+    char file[AVP_HOST_LOG_PATH_MAX + 8];
+    struct stat st;
+
+    snprintf(file, sizeof(file), "%s%s", path, suffix);
+    return (stat(file, &st) == 0) ? (long)st.st_size : 0;
+}
+
+static void avp_test_file_remove(const char *path, const char *suffix)
+{
+    char file[AVP_HOST_LOG_PATH_MAX + 8];
+
+    snprintf(file, sizeof(file), "%s%s", path, suffix);
+    unlink(file);
+}
+
+void lt_test_mock_avp_envelope(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_envelope()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    avp_test_host_t host;
+    avp_host_store_t store = {avp_test_put, avp_test_get, avp_test_remove, &host};
+    avp_host_store_t incomplete = {avp_test_put, avp_test_get, NULL, &host};
+    uint8_t value[AVP_TEST_VALUE_LEN], old[AVP_TEST_VALUE_LEN];
+    avp_test_blob_t stale;
+    bool deleted;
+
+    memset(&host, 0, sizeof(host));
+    lt_mock_avp_value(value, sizeof(value), 1);
+    // Data keys are drawn from the chip model, the L3 layer does not use the CAL context meanwhile
+    void *crypto_ctx = h->l3.crypto_ctx;
+
+    LT_LOG_INFO("Verifying avp_envelope_enable() parameters...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, 0));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "legacy", value, 100));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_envelope_enable(&vault, &incomplete, crypto_ctx));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_envelope_enable(&vault, &store, NULL));
+    LT_TEST_ASSERT(AVP_OK, avp_envelope_enable(&vault, &store, crypto_ctx));
+
+    LT_LOG_INFO("Verifying an enveloped secret takes one slot and one read...");
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "blob", value, sizeof(value)));
+    LT_TEST_ASSERT(2, avp_test_used_slots());
+    LT_TEST_ASSERT(1, avp_test_blob_count(&host));
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+    LT_TEST_ASSERT(1, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "legacy", value, 100));
+
+    LT_LOG_INFO("Verifying a new version replaces the ciphertext of the old one...");
+    memcpy(old, value, sizeof(old));
+    stale = host.blobs[0];
+    lt_mock_avp_value(value, sizeof(value), 2);
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "blob", value, sizeof(value)));
+    LT_TEST_ASSERT(1, avp_test_blob_count(&host));
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+
+    LT_LOG_INFO("Verifying a tampered, swapped or missing ciphertext is refused...");
+    avp_test_blob_t *blob = avp_test_blob_find(&host, "blob", stale.version + 1);
+    LT_TEST_ASSERT(true, blob != NULL);
+    blob->data[10] ^= 0x01;
+    LT_TEST_ASSERT(AVP_ERR_CRYPTO_ERROR, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+    blob->data[10] ^= 0x01;
+    avp_test_blob_t current = *blob;
+    // Old version offered for the new one, as a host rolling the secret back would do
+    *blob = stale;
+    blob->version = current.version;
+    LT_TEST_ASSERT(AVP_ERR_CRYPTO_ERROR, avp_test_retrieve(&vault, "blob", old, sizeof(old)));
+    blob->used = false;
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+    *blob = current;
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+
+    LT_LOG_INFO("Verifying a failed put keeps the stored version...");
+    host.put_ret = AVP_ERR_HARDWARE_ERROR;
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_store(&vault, "blob", old, sizeof(old)));
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+
+    LT_LOG_INFO("Verifying a vault without the host store cannot read an enveloped secret...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+    LT_TEST_ASSERT(AVP_OK, avp_envelope_enable(&vault, &store, crypto_ctx));
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+
+    LT_LOG_INFO("Verifying DELETE removes the ciphertexts...");
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "blob", &deleted));
+    LT_TEST_ASSERT(true, deleted);
+    LT_TEST_ASSERT(0, avp_test_blob_count(&host));
+
+    LT_LOG_INFO("Verifying the host log stores the ciphertexts across reopening...");
+    avp_host_log_t log;
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/lt_test_mock_avp_envelope_%ld", (long)getpid());
+    avp_test_file_remove(path, ".log");
+    avp_test_file_remove(path, ".idx");
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_host_log_open(&log, "", NULL));
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_open(&log, path, NULL));
+    avp_host_log_store(&log, &store);
+    LT_TEST_ASSERT(AVP_OK, avp_envelope_enable(&vault, &store, crypto_ctx));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "blob", value, sizeof(value)));
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_close(&log));
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_open(&log, path, NULL));
+    avp_host_log_store(&log, &store);
+    LT_TEST_ASSERT(AVP_OK, avp_envelope_enable(&vault, &store, crypto_ctx));
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+
+    LT_LOG_INFO("Verifying the host log rebuilds a lost index...");
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_close(&log));
+    avp_test_file_remove(path, ".idx");
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_open(&log, path, NULL));
+    avp_host_log_store(&log, &store);
+    LT_TEST_ASSERT(AVP_OK, avp_envelope_enable(&vault, &store, crypto_ctx));
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+
+    LT_LOG_INFO("Verifying compaction of the host log drops the replaced versions...");
+    LT_TEST_ASSERT(false, avp_host_log_compact_due(&log));
+    for (uint8_t k = 0; k < 4; k++) {
+        lt_mock_avp_value(value, sizeof(value), (uint8_t)(k + 3));
+        LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "blob", value, sizeof(value)));
+    }
+    LT_TEST_ASSERT(true, avp_host_log_compact_due(&log));
+    long log_size = avp_test_file_size(path, ".log");
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_compact(&log));
+    LT_TEST_ASSERT(true, avp_test_file_size(path, ".log") < log_size / 2);
+    LT_TEST_ASSERT(false, avp_host_log_compact_due(&log));
+    LT_TEST_ASSERT(AVP_OK, avp_test_retrieve(&vault, "blob", value, sizeof(value)));
+
+    LT_LOG_INFO("Verifying a corrupted host log record is refused...");
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_close(&log));
+    char file[AVP_HOST_LOG_PATH_MAX + 8];
+    snprintf(file, sizeof(file), "%s.log", path);
+    FILE *f = fopen(file, "r+b");
+    LT_TEST_ASSERT(true, f != NULL);
+    LT_TEST_ASSERT(0, fseek(f, -10, SEEK_END));
+    int c = fgetc(f);
+    LT_TEST_ASSERT(0, fseek(f, -10, SEEK_END));
+    LT_TEST_ASSERT(c ^ 0x01, fputc(c ^ 0x01, f));
+    LT_TEST_ASSERT(0, fclose(f));
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_open(&log, path, NULL));
+    avp_host_log_store(&log, &store);
+    LT_TEST_ASSERT(AVP_OK, avp_envelope_enable(&vault, &store, crypto_ctx));
+    LT_TEST_ASSERT(true, avp_test_retrieve(&vault, "blob", value, sizeof(value)) != AVP_OK);
+    LT_TEST_ASSERT(AVP_OK, avp_host_log_close(&log));
+
+    avp_test_file_remove(path, ".log");
+    avp_test_file_remove(path, ".idx");
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+}
@@ -0,0 +1,125 @@
+/**
+ * @file lt_test_mock_avp_erase.c
+ * @brief Test AVP wear leveling of rotated secrets and the deferred erase of released slots.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Number of rotations of one secret. */
+#define AVP_TEST_ROTATIONS 10
+
+/** Returns number of secret slots holding data on the chip. */
+static unsigned avp_test_used_slots(void)
+{
+    unsigned used = 0;
+    uint16_t len;
+
+    for (uint16_t slot = 0; slot < AVP_TROPIC_KEY_SLOTS; slot++) {
+        lt_mock_avp_r_mem(AVP_SECRET_FIRST_SLOT + slot, &len);
+        used += (len > 0);
+    }
+
+    return used;
+}
+
+void lt_test_mock_avp_erase(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_erase()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    uint8_t value[32], read[sizeof(value)];
+    size_t read_len;
+    uint16_t len;
+    bool deleted;
+
+    LT_LOG_INFO("Verifying STORE of an existing secret writes a free slot and keeps the old one...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, 0));
+    lt_mock_avp_value(value, sizeof(value), 0);
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "token", value, sizeof(value)));
+    lt_mock_avp_value(value, sizeof(value), 1);
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "token", value, sizeof(value)));
+    LT_TEST_ASSERT(2, avp_test_used_slots());
+    LT_TEST_ASSERT(1, vault.erase_pending[0] & 1);
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, "token", read, &read_len));
+    LT_TEST_ASSERT(0, memcmp(value, read, sizeof(value)));
+
+    LT_LOG_INFO("Verifying avp_idle() erases at most max_erases slots and saves the wear table...");
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 0));
+    LT_TEST_ASSERT(2, avp_test_used_slots());
+    lt_mock_avp_r_mem(AVP_WEAR_SLOT, &len);
+    LT_TEST_ASSERT(true, len > 0);
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 1));
+    LT_TEST_ASSERT(1, avp_test_used_slots());
+    lt_mock_avp_r_mem(AVP_SECRET_FIRST_SLOT, &len);
+    LT_TEST_ASSERT(0, len);
+
+    LT_LOG_INFO("Verifying repeated rotation of one secret moves around the slots...");
+    for (uint8_t k = 0; k < AVP_TEST_ROTATIONS; k++) {
+        lt_mock_avp_value(value, sizeof(value), (uint8_t)(k + 2));
+        LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "token", value, sizeof(value)));
+        LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 1));
+    }
+    for (size_t slot = 0; slot < AVP_TEST_ROTATIONS + 2; slot++) {
+        LT_TEST_ASSERT(1, vault.slot_writes[slot]);
+    }
+    LT_TEST_ASSERT(0, vault.slot_writes[AVP_TEST_ROTATIONS + 2]);
+    LT_TEST_ASSERT(1, avp_test_used_slots());
+
+    LT_LOG_INFO("Verifying a new vault reads the wear table back...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(1, vault.slot_writes[AVP_TEST_ROTATIONS + 1]);
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, "token", read, &read_len));
+    LT_TEST_ASSERT(0, memcmp(value, read, sizeof(value)));
+
+    LT_LOG_INFO("Verifying DELETE only queues the slots for erase...");
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "a", value, sizeof(value)));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "b", value, sizeof(value)));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "c", value, sizeof(value)));
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "a", &deleted));
+    LT_TEST_ASSERT(true, deleted);
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "b", &deleted));
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "c", &deleted));
+    LT_TEST_ASSERT(4, avp_test_used_slots());
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_retrieve(&vault, "a", read, &read_len));
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 2));
+    LT_TEST_ASSERT(2, avp_test_used_slots());
+
+    LT_LOG_INFO("Verifying a failed erase stays queued...");
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_ERASE, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_flush(&vault));
+    LT_TEST_ASSERT(2, avp_test_used_slots());
+    LT_TEST_ASSERT(AVP_OK, avp_flush(&vault));
+    LT_TEST_ASSERT(1, avp_test_used_slots());
+
+    LT_LOG_INFO("Verifying the queue of a reset vault is taken from the wear table...");
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "token", &deleted));
+    LT_TEST_ASSERT(AVP_OK, avp_idle(&vault, 0));
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(1, avp_test_used_slots());
+
+    LT_LOG_INFO("Verifying avp_deinit() erases the queued slots...");
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+    LT_TEST_ASSERT(0, avp_test_used_slots());
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_idle(&vault, 1));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_flush(&vault));
+}
@@ -0,0 +1,174 @@
+/**
+ * @file lt_test_mock_avp_keys.c
+ * @brief Test AVP hardware operations: cached attestation, named signing keys and HW_SIGN.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Certificates of the chip model, 400 B each. */
+#define AVP_TEST_CHAIN_LEN (LT_NUM_CERTIFICATES * 400)
+
+void lt_test_mock_avp_keys(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_keys()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    avp_attestation_t att;
+    avp_attestation_ref_t ref;
+    const uint8_t msg[] = "challenge";
+    uint8_t sig[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+    size_t sig_len;
+    uint8_t pubkey[TR01_CURVE_P256_PUBKEY_LEN];
+    size_t pubkey_len;
+    lt_ecc_curve_type_t curve;
+
+    LT_LOG_INFO("Verifying HW_CHALLENGE reads the identity and the certificate chain once...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, 0));
+    LT_TEST_ASSERT(AVP_OK, avp_hw_challenge(&vault, &att));
+    LT_TEST_ASSERT(4, lt_mock_avp_calls(LT_MOCK_AVP_GET_INFO));
+    LT_TEST_ASSERT(true, att.verified);
+    LT_TEST_ASSERT(0, strcmp("Tropic Square", att.manufacturer));
+    LT_TEST_ASSERT(0, strcmp("RISC-V 2.0.1 SPECT 1.0.0", att.firmware_version));
+    LT_TEST_ASSERT(2 * sizeof(lt_ser_num_t), strlen(att.serial));
+    LT_TEST_ASSERT(AVP_TEST_CHAIN_LEN, att.certificate_len);
+    LT_TEST_ASSERT(LT_NUM_CERTIFICATES - 1, att.certificate[AVP_TEST_CHAIN_LEN - 1]);
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_hw_challenge_ref(&vault, &ref));
+    LT_TEST_ASSERT(AVP_OK, avp_hw_challenge(&vault, &att));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls_all());
+    LT_TEST_ASSERT(AVP_TEST_CHAIN_LEN, ref.certificate_len);
+    LT_TEST_ASSERT(0, memcmp(att.certificate, ref.certificate, ref.certificate_len));
+    LT_TEST_ASSERT(0, strcmp(att.serial, ref.serial));
+    LT_TEST_ASSERT(1, vault.metrics.cert_cache_misses);
+    LT_TEST_ASSERT(2, vault.metrics.cert_cache_hits);
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_hw_challenge(&vault, NULL));
+
+    LT_LOG_INFO("Verifying a chip error of HW_CHALLENGE is not cached...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    lt_mock_avp_fail(LT_MOCK_AVP_GET_INFO, LT_MOCK_AVP_ANY_SLOT, 4);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_hw_challenge_ref(&vault, &ref));
+    LT_TEST_ASSERT(true, ref.certificate == NULL);
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_hw_challenge(&vault, &att));
+    LT_TEST_ASSERT(4, lt_mock_avp_calls(LT_MOCK_AVP_GET_INFO));
+    LT_TEST_ASSERT(AVP_TEST_CHAIN_LEN, att.certificate_len);
+
+    LT_LOG_INFO("Verifying generation of named signing keys...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, 0));
+    LT_TEST_ASSERT(AVP_OK, avp_hw_key_generate(&vault, "signer", TR01_CURVE_P256));
+    LT_TEST_ASSERT(AVP_OK, avp_hw_key_generate(&vault, "edkey", TR01_CURVE_ED25519));
+    LT_TEST_ASSERT(2, lt_mock_avp_calls(LT_MOCK_AVP_ECC_GENERATE));
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_hw_key_generate(&vault, "signer", TR01_CURVE_ED25519));
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_hw_key_generate(&vault, "9key", TR01_CURVE_P256));
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_hw_key_generate(&vault, "other", (lt_ecc_curve_type_t)0));
+    lt_mock_avp_fail(LT_MOCK_AVP_ECC_GENERATE, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_hw_key_generate(&vault, "broken", TR01_CURVE_P256));
+
+    LT_LOG_INFO("Verifying public keys and HW_SIGN are served by the cached curve and public key...");
+    lt_mock_avp_calls_reset();
+    pubkey_len = sizeof(pubkey);
+    LT_TEST_ASSERT(AVP_OK, avp_hw_public_key(&vault, "signer", pubkey, &pubkey_len, &curve));
+    LT_TEST_ASSERT(TR01_CURVE_P256_PUBKEY_LEN, pubkey_len);
+    LT_TEST_ASSERT(TR01_CURVE_P256, curve);
+    pubkey_len = sizeof(pubkey);
+    LT_TEST_ASSERT(AVP_OK, avp_hw_public_key(&vault, "edkey", pubkey, &pubkey_len, NULL));
+    LT_TEST_ASSERT(TR01_CURVE_ED25519_PUBKEY_LEN, pubkey_len);
+    sig_len = sizeof(sig);
+    LT_TEST_ASSERT(AVP_OK, avp_hw_sign(&vault, "signer", msg, sizeof(msg), sig, &sig_len));
+    LT_TEST_ASSERT(TR01_ECDSA_EDDSA_SIGNATURE_LENGTH, sig_len);
+    sig_len = sizeof(sig);
+    LT_TEST_ASSERT(AVP_OK, avp_hw_sign(&vault, "edkey", msg, sizeof(msg), sig, &sig_len));
+    LT_TEST_ASSERT(1, lt_mock_avp_calls(LT_MOCK_AVP_ECDSA_SIGN));
+    LT_TEST_ASSERT(1, lt_mock_avp_calls(LT_MOCK_AVP_EDDSA_SIGN));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls(LT_MOCK_AVP_ECC_READ));
+    pubkey_len = TR01_CURVE_ED25519_PUBKEY_LEN;
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_hw_public_key(&vault, "signer", pubkey, &pubkey_len, NULL));
+    sig_len = TR01_ECDSA_EDDSA_SIGNATURE_LENGTH - 1;
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_hw_sign(&vault, "signer", msg, sizeof(msg), sig, &sig_len));
+    sig_len = sizeof(sig);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_hw_sign(&vault, "broken", msg, sizeof(msg), sig, &sig_len));
+    lt_mock_avp_fail(LT_MOCK_AVP_ECDSA_SIGN, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_hw_sign(&vault, "signer", msg, sizeof(msg), sig, &sig_len));
+
+    LT_LOG_INFO("Verifying HW_CHALLENGE with a signature costs a single chip operation once cached...");
+    LT_TEST_ASSERT(AVP_OK, avp_hw_challenge_ref(&vault, &ref));
+    lt_mock_avp_calls_reset();
+    sig_len = sizeof(sig);
+    LT_TEST_ASSERT(AVP_OK, avp_hw_challenge_sign(&vault, "edkey", msg, sizeof(msg), NULL, sig, &sig_len));
+    LT_TEST_ASSERT(1, lt_mock_avp_calls_all());
+    sig_len = sizeof(sig);
+    LT_TEST_ASSERT(AVP_OK, avp_hw_challenge_sign(&vault, "signer", msg, sizeof(msg), &att, sig, &sig_len));
+    LT_TEST_ASSERT(AVP_TEST_CHAIN_LEN, att.certificate_len);
+    LT_TEST_ASSERT(2, lt_mock_avp_calls_all());
+
+    LT_LOG_INFO("Verifying a new vault reads the key directory and each public key once...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    lt_mock_avp_calls_reset();
+    for (size_t i = 0; i < 2; i++) {
+        pubkey_len = sizeof(pubkey);
+        LT_TEST_ASSERT(AVP_OK, avp_hw_public_key(&vault, "signer", pubkey, &pubkey_len, &curve));
+        LT_TEST_ASSERT(TR01_CURVE_P256, curve);
+    }
+    LT_TEST_ASSERT(1, lt_mock_avp_calls(LT_MOCK_AVP_ECC_READ));
+    LT_TEST_ASSERT(1, vault.metrics.pubkey_cache_misses);
+    LT_TEST_ASSERT(1, vault.metrics.pubkey_cache_hits);
+    lt_mock_avp_fail(LT_MOCK_AVP_ECC_READ, LT_MOCK_AVP_ANY_SLOT, 1);
+    sig_len = sizeof(sig);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_hw_sign(&vault, "edkey", msg, sizeof(msg), sig, &sig_len));
+    LT_TEST_ASSERT(AVP_OK, avp_hw_sign(&vault, "edkey", msg, sizeof(msg), sig, &sig_len));
+
+    LT_LOG_INFO("Verifying a key erased by another application is reported as not found...");
+    // "signer" is the first key, in AVP_ECC_FIRST_SLOT
+    LT_TEST_ASSERT(LT_OK, __wrap_lt_ecc_key_erase(&vault.lt_handle, AVP_ECC_FIRST_SLOT));
+    sig_len = sizeof(sig);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_hw_sign(&vault, "signer", msg, sizeof(msg), sig, &sig_len));
+    pubkey_len = sizeof(pubkey);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_hw_public_key(&vault, "signer", pubkey, &pubkey_len, NULL));
+
+    LT_LOG_INFO("Verifying deletion of a signing key...");
+    LT_TEST_ASSERT(AVP_OK, avp_hw_key_delete(&vault, "signer"));
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_hw_key_delete(&vault, "signer"));
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_hw_key_delete(&vault, "9key"));
+    lt_mock_avp_fail(LT_MOCK_AVP_ECC_ERASE, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_hw_key_delete(&vault, "edkey"));
+    // Name is dropped before the key, the slot is reused by the next generation
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_hw_sign(&vault, "edkey", msg, sizeof(msg), sig, &sig_len));
+
+    LT_LOG_INFO("Verifying generation fails once all ECC key slots are named...");
+    char key_name[16];
+    for (size_t k = 0; k < AVP_ECC_KEY_SLOTS; k++) {
+        snprintf(key_name, sizeof(key_name), "k%u", (unsigned)k);
+        LT_TEST_ASSERT(AVP_OK, avp_hw_key_generate(&vault, key_name, TR01_CURVE_ED25519));
+    }
+    LT_TEST_ASSERT(AVP_ERR_CAPACITY_EXCEEDED, avp_hw_key_generate(&vault, "extra", TR01_CURVE_ED25519));
+
+    LT_LOG_INFO("Verifying HW_ATTEST...");
+    LT_TEST_ASSERT(AVP_OK, avp_hw_attest(&vault, "anything", &att));
+    LT_TEST_ASSERT(true, att.verified);
+    LT_TEST_ASSERT(AVP_OK, avp_hw_attest_ref(&vault, "anything", &ref));
+    LT_TEST_ASSERT(0, strcmp("TROPIC01", ref.model));
+
+    LT_LOG_INFO("Verifying the operations need a session...");
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+    sig_len = sizeof(sig);
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_hw_sign(&vault, "k0", msg, sizeof(msg), sig, &sig_len));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_hw_key_generate(&vault, "extra", TR01_CURVE_P256));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_hw_attest(&vault, "anything", &att));
+}
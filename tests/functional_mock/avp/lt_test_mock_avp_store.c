@@ -0,0 +1,126 @@
+/**
+ * @file lt_test_mock_avp_store.c
+ * @brief Test AVP compression of stored values and the skipped STORE of an unchanged value.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Value spanning three R-memory slots when stored as is. */
+#define AVP_TEST_VALUE_LEN 1000
+
+/** Returns number of secret slots holding data on the chip. */
+static unsigned avp_test_used_slots(void)
+{
+    unsigned used = 0;
+    uint16_t len;
+
+    for (uint16_t slot = 0; slot < AVP_TROPIC_KEY_SLOTS; slot++) {
+        lt_mock_avp_r_mem(AVP_SECRET_FIRST_SLOT + slot, &len);
+        used += (len > 0);
+    }
+
+    return used;
+}
+
+/** Fills the buffer with xorshift32 output, which does not compress. */
+static void avp_test_noise(uint8_t *buf, const size_t len)
+{
+    uint32_t x = 0x2545F491;
+
+    for (size_t i = 0; i < len; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = (uint8_t)x;
+    }
+}
+
+/** Reads the secret back and compares it with the expected value. */
+static void avp_test_check(avp_vault_t *vault, const char *name, const uint8_t *expected, const size_t len)
+{
+    uint8_t value[AVP_TEST_VALUE_LEN];
+    size_t value_len = sizeof(value);
+
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(vault, name, value, &value_len));
+    LT_TEST_ASSERT(len, value_len);
+    LT_TEST_ASSERT(0, memcmp(expected, value, len));
+}
+
+void lt_test_mock_avp_store(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_store()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    uint8_t text[AVP_TEST_VALUE_LEN], noise[AVP_TEST_VALUE_LEN];
+    uint8_t value[AVP_TEST_VALUE_LEN];
+    size_t value_len;
+
+    // Configuration file like text, repeating itself
+    for (size_t i = 0; i < sizeof(text); i++) {
+        text[i] = (uint8_t)"timeout=30;retries=5;\n"[i % 22];
+    }
+    avp_test_noise(noise, sizeof(noise));
+
+    LT_LOG_INFO("Verifying a compressible value takes fewer slots and reads back...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, 0));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "config", text, sizeof(text)));
+    LT_TEST_ASSERT(1, avp_test_used_slots());
+    avp_test_check(&vault, "config", text, sizeof(text));
+    value_len = sizeof(text) - 1;
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_retrieve(&vault, "config", value, &value_len));
+
+    LT_LOG_INFO("Verifying an incompressible value is stored as is...");
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "noise", noise, sizeof(noise)));
+    LT_TEST_ASSERT(4, avp_test_used_slots());
+    avp_test_check(&vault, "noise", noise, sizeof(noise));
+
+    LT_LOG_INFO("Verifying a new vault reads the compressed value...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    avp_test_check(&vault, "config", text, sizeof(text));
+
+    LT_LOG_INFO("Verifying STORE of the value stored by this vault talks to no chip...");
+    // Catalog of a new vault holds no value hashes, the first STORE writes
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "noise", noise, sizeof(noise)));
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "noise", noise, sizeof(noise)));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls_all());
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "config", text, sizeof(text)));
+    LT_TEST_ASSERT(true, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_WRITE) > 0);
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "config", text, sizeof(text)));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls_all());
+
+    LT_LOG_INFO("Verifying a changed value is written...");
+    noise[0] ^= 1;
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "noise", noise, sizeof(noise)));
+    LT_TEST_ASSERT(true, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_WRITE) >= 3);
+    avp_test_check(&vault, "noise", noise, sizeof(noise));
+
+    LT_LOG_INFO("Verifying a failed STORE is not taken for a stored value...");
+    text[0] = 'T';
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_WRITE, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_store(&vault, "config", text, sizeof(text)));
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "config", text, sizeof(text)));
+    LT_TEST_ASSERT(true, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_WRITE) > 0);
+    avp_test_check(&vault, "config", text, sizeof(text));
+
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+}
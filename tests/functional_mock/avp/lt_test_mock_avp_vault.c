@@ -0,0 +1,263 @@
+/**
+ * @file lt_test_mock_avp_vault.c
+ * @brief Test AVP vault operations: PIN login, session TTL, name index, chunked values, batched RETRIEVE and LIST.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Session TTL of the test. */
+#define AVP_TEST_TTL_S 10
+/** Length of the value spanning the head slot and two extent slots. */
+#define AVP_TEST_BIG_LEN 1000
+
+void lt_test_mock_avp_vault(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_vault()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    uint8_t value[AVP_TEST_BIG_LEN];
+    uint8_t read[AVP_TEST_BIG_LEN];
+    size_t read_len;
+
+    LT_LOG_INFO("Verifying PIN login on a blank chip...");
+    lt_mock_avp_chip_reset();
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_store(&vault, "token", value, 1));
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_set_pin(&vault, NULL, "12"));
+    LT_TEST_ASSERT(AVP_OK, avp_set_pin(&vault, NULL, LT_MOCK_AVP_PIN));
+    LT_TEST_ASSERT(AVP_PIN_ATTEMPTS, lt_mock_avp_pin_attempts());
+    // Only the first PIN is set without the old one
+    LT_TEST_ASSERT(AVP_ERR_AUTHENTICATION_FAILED, avp_set_pin(&vault, NULL, "0000"));
+    LT_TEST_ASSERT(AVP_ERR_AUTHENTICATION_FAILED, avp_set_pin(&vault, "0000", "1111"));
+    LT_TEST_ASSERT(AVP_PIN_ATTEMPTS - 1, lt_mock_avp_pin_attempts());
+
+    LT_LOG_INFO("Verifying wrong PINs and a chip error fail AUTHENTICATE...");
+    LT_TEST_ASSERT(AVP_ERR_AUTHENTICATION_FAILED, avp_authenticate(&vault, NULL, NULL, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(AVP_ERR_AUTHENTICATION_FAILED, avp_authenticate(&vault, NULL, "12", AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(AVP_ERR_AUTHENTICATION_FAILED, avp_authenticate(&vault, NULL, "0000", AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(AVP_PIN_ATTEMPTS - 2, lt_mock_avp_pin_attempts());
+    lt_mock_avp_fail(LT_MOCK_AVP_PIN_VERIFY, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(false, avp_session_active(&vault));
+
+    LT_LOG_INFO("Verifying the correct PIN restores all attempts...");
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(AVP_PIN_ATTEMPTS, lt_mock_avp_pin_attempts());
+    LT_TEST_ASSERT(true, avp_session_active(&vault));
+
+    LT_LOG_INFO("Verifying AUTHENTICATE within the TTL reuses the key unlocked by the PIN...");
+    lt_mock_avp_calls_reset();
+    lt_mock_avp_clock_advance(AVP_TEST_TTL_S / 2);
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls(LT_MOCK_AVP_PIN_VERIFY));
+
+    LT_LOG_INFO("Verifying the session expires after its TTL on the monotonic clock...");
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "token", (const uint8_t *)"s3cr3t", 6));
+    lt_mock_avp_clock_advance(AVP_TEST_TTL_S - 1);
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, "token", read, &read_len));
+    lt_mock_avp_clock_advance(1);
+    LT_TEST_ASSERT(false, avp_session_active(&vault));
+    LT_TEST_ASSERT(AVP_ERR_SESSION_EXPIRED, avp_retrieve(&vault, "token", read, &read_len));
+    LT_TEST_ASSERT(AVP_ERR_SESSION_EXPIRED, avp_store(&vault, "token", value, 1));
+
+    LT_LOG_INFO("Verifying AUTHENTICATE after the TTL of the unlocked key verifies the PIN by TROPIC01...");
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, AVP_TEST_TTL_S));
+    LT_TEST_ASSERT(1, lt_mock_avp_calls(LT_MOCK_AVP_PIN_VERIFY));
+    LT_TEST_ASSERT(AVP_OK, avp_set_pin(&vault, LT_MOCK_AVP_PIN, LT_MOCK_AVP_PIN));
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+
+    LT_LOG_INFO("Verifying validation of secret names...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, NULL, 0));
+    char name[AVP_MAX_SECRET_NAME_LEN + 2];
+    memset(name, 'n', AVP_MAX_SECRET_NAME_LEN + 1);
+    name[AVP_MAX_SECRET_NAME_LEN + 1] = '\0';
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_store(&vault, name, value, 1));
+    name[AVP_MAX_SECRET_NAME_LEN] = '\0';
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, name, value, 1));
+    const char *const bad_names[] = {"", "9lives", "_x", "with space", "semi;colon", "caf\xc3\xa9"};
+    for (size_t i = 0; i < sizeof(bad_names) / sizeof(bad_names[0]); i++) {
+        LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_store(&vault, bad_names[i], value, 1));
+        LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_retrieve(&vault, bad_names[i], read, &read_len));
+    }
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "Db_user-1.name", (const uint8_t *)"admin", 5));
+
+    LT_LOG_INFO("Verifying values spanning several R-memory slots...");
+    lt_mock_avp_value(value, sizeof(value), 0x11);
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "big", value, sizeof(value)));
+    read_len = sizeof(read);
+    memset(read, 0, sizeof(read));
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, "big", read, &read_len));
+    LT_TEST_ASSERT(sizeof(value), read_len);
+    LT_TEST_ASSERT(0, memcmp(value, read, sizeof(value)));
+    read_len = sizeof(read) - 1;
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_retrieve(&vault, "big", read, &read_len));
+    read_len = 10;
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_retrieve(&vault, "big", read, &read_len));
+
+    LT_LOG_INFO("Verifying a value exceeding the capacity is refused without writing...");
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_ERR_INTERNAL, avp_store(&vault, "huge", value, AVP_MAX_SECRET_VALUE_LEN + 1));
+    LT_TEST_ASSERT(AVP_ERR_CAPACITY_EXCEEDED, avp_store(&vault, "huge", value, AVP_MAX_SECRET_VALUE_LEN));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_WRITE));
+
+    LT_LOG_INFO("Verifying a failed STORE keeps the secrets stored before...");
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_WRITE, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_store(&vault, "lost", value, 8));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_retrieve(&vault, "lost", read, &read_len));
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, "big", read, &read_len));
+    LT_TEST_ASSERT(0, memcmp(value, read, sizeof(value)));
+
+    LT_LOG_INFO("Verifying the directory is read back by a new vault...");
+    // Host reset: the vault is abandoned, the chip keeps its contents
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, "Db_user-1.name", read, &read_len));
+    LT_TEST_ASSERT(5, read_len);
+    LT_TEST_ASSERT(0, memcmp("admin", read, 5));
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, name, read, &read_len));
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(&vault, "big", read, &read_len));
+    LT_TEST_ASSERT(0, memcmp(value, read, sizeof(value)));
+
+    LT_LOG_INFO("Verifying lookup of an unknown name needs no chip round-trip...");
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_retrieve(&vault, "unknown", read, &read_len));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls_all());
+
+    LT_LOG_INFO("Verifying a chip error of RETRIEVE...");
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_READ, LT_MOCK_AVP_ANY_SLOT, 1);
+    read_len = sizeof(read);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_retrieve(&vault, "big", read, &read_len));
+
+    LT_LOG_INFO("Verifying avp_retrieve_many() reports the status of each secret...");
+    uint8_t small[8];
+    avp_retrieve_item_t items[4];
+    const char *const many[4] = {"Db_user-1.name", "unknown", "9lives", "big"};
+    items[0] = (avp_retrieve_item_t){.value = small, .value_len = sizeof(small)};
+    items[1] = (avp_retrieve_item_t){.value = small, .value_len = sizeof(small)};
+    items[2] = (avp_retrieve_item_t){.value = small, .value_len = sizeof(small)};
+    items[3] = (avp_retrieve_item_t){.value = read, .value_len = sizeof(read)};
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_retrieve_many(&vault, many, items, 4));
+    LT_TEST_ASSERT(AVP_OK, items[0].status);
+    LT_TEST_ASSERT(5, items[0].value_len);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, items[1].status);
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, items[2].status);
+    LT_TEST_ASSERT(AVP_OK, items[3].status);
+    LT_TEST_ASSERT(sizeof(value), items[3].value_len);
+    LT_TEST_ASSERT(0, memcmp(value, read, sizeof(value)));
+    // Head slot of each found secret and two extents of the big one
+    LT_TEST_ASSERT(4, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve_many(&vault, many, items, 1));
+
+    LT_LOG_INFO("Verifying avp_retrieve_many() skips the reads after a chip error...");
+    items[0].value_len = sizeof(small);
+    items[3].value_len = sizeof(read);
+    lt_mock_avp_calls_reset();
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_READ, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_retrieve_many(&vault, many, items, 4));
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, items[0].status);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, items[1].status);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, items[3].status);
+    LT_TEST_ASSERT(1, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+
+    LT_LOG_INFO("Verifying LIST reads the metadata from TROPIC01 only once...");
+    size_t count = 0;
+    avp_secret_metadata_t list[4];
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_list(&vault, NULL, 0, &count));
+    LT_TEST_ASSERT(3, count);
+    LT_TEST_ASSERT(0, lt_mock_avp_calls_all());
+    LT_TEST_ASSERT(AVP_OK, avp_list(&vault, list, 4, &count));
+    LT_TEST_ASSERT(3, count);
+    LT_TEST_ASSERT(3, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_list(&vault, list, 2, &count));
+    LT_TEST_ASSERT(2, count);
+    LT_TEST_ASSERT(0, lt_mock_avp_calls_all());
+    bool listed = false;
+    for (size_t i = 0; i < 2; i++) {
+        listed |= (strcmp(list[i].name, "Db_user-1.name") == 0) && (list[i].version == 1);
+    }
+    LT_TEST_ASSERT(true, listed);
+
+    LT_LOG_INFO("Verifying a chip error of LIST...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_READ, LT_MOCK_AVP_ANY_SLOT, 2);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_list(&vault, list, 4, &count));
+    LT_TEST_ASSERT(AVP_OK, avp_list(&vault, list, 4, &count));
+    LT_TEST_ASSERT(3, count);
+
+    LT_LOG_INFO("Verifying the listing cursor with a name prefix...");
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "app.db", value, 4));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "app.key", value, 4));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "application", value, 4));
+    avp_list_cursor_t cursor;
+    const avp_secret_metadata_t *meta;
+    memset(name, 'p', AVP_MAX_SECRET_NAME_LEN + 1);
+    name[AVP_MAX_SECRET_NAME_LEN + 1] = '\0';
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_list_begin(&vault, &cursor, name));
+    LT_TEST_ASSERT(AVP_OK, avp_list_begin(&vault, &cursor, "app."));
+    count = 0;
+    while (avp_list_next(&vault, &cursor, &meta) == AVP_OK) {
+        LT_TEST_ASSERT(0, strncmp(meta->name, "app.", 4));
+        count++;
+    }
+    LT_TEST_ASSERT(2, count);
+    LT_TEST_ASSERT(1, meta == NULL);
+
+    LT_LOG_INFO("Verifying the listing cursor over all secrets stops at avp_list_end()...");
+    LT_TEST_ASSERT(AVP_OK, avp_list_begin(&vault, &cursor, NULL));
+    count = 0;
+    while (avp_list_next(&vault, &cursor, &meta) == AVP_OK) {
+        count++;
+    }
+    LT_TEST_ASSERT(6, count);
+    LT_TEST_ASSERT(AVP_OK, avp_list_begin(&vault, &cursor, ""));
+    LT_TEST_ASSERT(AVP_OK, avp_list_next(&vault, &cursor, &meta));
+    LT_TEST_ASSERT(AVP_OK, avp_list_end(&vault, &cursor));
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_list_next(&vault, &cursor, &meta));
+
+    LT_LOG_INFO("Verifying DELETE...");
+    bool deleted = false;
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "big", &deleted));
+    LT_TEST_ASSERT(true, deleted);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_retrieve(&vault, "big", read, &read_len));
+    LT_TEST_ASSERT(AVP_OK, avp_delete(&vault, "big", &deleted));
+    LT_TEST_ASSERT(false, deleted);
+    LT_TEST_ASSERT(AVP_ERR_INVALID_NAME, avp_delete(&vault, "9lives", &deleted));
+    lt_mock_avp_fail(LT_MOCK_AVP_R_MEM_ERASE, LT_MOCK_AVP_ANY_SLOT, 1);
+    LT_TEST_ASSERT(AVP_ERR_HARDWARE_ERROR, avp_delete(&vault, "app.db", &deleted));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, NULL, LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(AVP_OK, avp_list(&vault, NULL, 0, &count));
+    LT_TEST_ASSERT(5, count);
+
+    LT_LOG_INFO("Deinitializing vault");
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+    LT_TEST_ASSERT(AVP_ERR_NOT_INITIALIZED, avp_list(&vault, NULL, 0, &count));
+}
@@ -0,0 +1,107 @@
+/**
+ * @file lt_test_mock_avp_workspaces.c
+ * @brief Test AVP workspace partitions of the secret slots.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "avp_tropic.h"
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_avp_chip.h"
+#include "lt_mock_avp_vault.h"
+#include "lt_test_common.h"
+
+/** Reads the secret back and compares it with the expected value. */
+static void avp_test_check(avp_vault_t *vault, const char *name, const char *expected)
+{
+    uint8_t value[32];
+    size_t value_len = sizeof(value);
+
+    LT_TEST_ASSERT(AVP_OK, avp_retrieve(vault, name, value, &value_len));
+    LT_TEST_ASSERT(strlen(expected), value_len);
+    LT_TEST_ASSERT(0, memcmp(expected, value, value_len));
+}
+
+void lt_test_mock_avp_workspaces(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_avp_workspaces()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    avp_vault_t vault;
+    avp_discover_response_t discover;
+    avp_secret_metadata_t secrets[AVP_WORKSPACE_SLOTS];
+    uint8_t value[32];
+    size_t value_len, count;
+    uint16_t len;
+
+    memset(value, 0x5a, sizeof(value));
+
+    LT_LOG_INFO("Verifying DISCOVER reports the capacity of one partition...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_open(h, &vault, "alpha", 0));
+    LT_TEST_ASSERT(AVP_OK, avp_discover(&vault, &discover));
+    LT_TEST_ASSERT(AVP_WORKSPACE_SLOTS, discover.max_secrets);
+
+    LT_LOG_INFO("Verifying secrets of a workspace are not seen by another one...");
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "token", (const uint8_t *)"alpha-token", 11));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "beta", LT_MOCK_AVP_PIN, 0));
+    value_len = sizeof(value);
+    LT_TEST_ASSERT(AVP_ERR_SECRET_NOT_FOUND, avp_retrieve(&vault, "token", value, &value_len));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "token", (const uint8_t *)"beta-token", 10));
+    LT_TEST_ASSERT(AVP_OK, avp_list(&vault, secrets, AVP_WORKSPACE_SLOTS, &count));
+    LT_TEST_ASSERT(1, count);
+    avp_test_check(&vault, "token", "beta-token");
+    lt_mock_avp_r_mem(AVP_SECRET_FIRST_SLOT + AVP_WORKSPACE_SLOTS, &len);
+    LT_TEST_ASSERT(true, len > 0);
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "alpha", LT_MOCK_AVP_PIN, 0));
+    avp_test_check(&vault, "token", "alpha-token");
+
+    LT_LOG_INFO("Verifying a workspace beyond the partitions is refused...");
+    LT_TEST_ASSERT(AVP_ERR_CAPACITY_EXCEEDED, avp_authenticate(&vault, "gamma", LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "alpha", LT_MOCK_AVP_PIN, 0));
+    lt_mock_avp_r_mem(AVP_WORKSPACE_SLOT, &len);
+    LT_TEST_ASSERT(true, len > 0);
+
+    LT_LOG_INFO("Verifying switching to an unchanged workspace reads no directory slot...");
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "beta", LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+
+    LT_LOG_INFO("Verifying a change of a partition by another host is read at AUTHENTICATE...");
+    LT_TEST_ASSERT(LT_OK, __wrap_lt_mcounter_update(&vault.lt_handle, AVP_WORKSPACE_MCOUNTER(0)));
+    lt_mock_avp_calls_reset();
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "beta", LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(0, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "alpha", LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(true, lt_mock_avp_calls(LT_MOCK_AVP_R_MEM_READ) >= AVP_WORKSPACE_DIR_SLOTS);
+    avp_test_check(&vault, "token", "alpha-token");
+
+    LT_LOG_INFO("Verifying a workspace is limited to its partition...");
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "beta", LT_MOCK_AVP_PIN, 0));
+    char name[16];
+    for (size_t k = 1; k < AVP_WORKSPACE_SLOTS; k++) {
+        snprintf(name, sizeof(name), "s%u", (unsigned)k);
+        LT_TEST_ASSERT(AVP_OK, avp_store(&vault, name, value, 1));
+    }
+    LT_TEST_ASSERT(AVP_ERR_CAPACITY_EXCEEDED, avp_store(&vault, "extra", value, 1));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "alpha", LT_MOCK_AVP_PIN, 0));
+    LT_TEST_ASSERT(AVP_OK, avp_store(&vault, "extra", value, 1));
+
+    LT_LOG_INFO("Verifying a new vault reads the workspace table back...");
+    LT_TEST_ASSERT(AVP_OK, lt_mock_avp_vault_init(h, &vault));
+    LT_TEST_ASSERT(AVP_OK, avp_authenticate(&vault, "beta", LT_MOCK_AVP_PIN, 0));
+    avp_test_check(&vault, "token", "beta-token");
+    LT_TEST_ASSERT(AVP_OK, avp_list(&vault, secrets, AVP_WORKSPACE_SLOTS, &count));
+    LT_TEST_ASSERT(AVP_WORKSPACE_SLOTS, count);
+    LT_TEST_ASSERT(AVP_ERR_CAPACITY_EXCEEDED, avp_authenticate(&vault, "gamma", LT_MOCK_AVP_PIN, 0));
+
+    LT_TEST_ASSERT(AVP_OK, avp_deinit(&vault));
+}
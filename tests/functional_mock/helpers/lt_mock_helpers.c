@@ -9,6 +9,7 @@
 #include "lt_mock_helpers.h"
 
 #include <memory.h>
+#include <stdbool.h>
 #include <stdlib.h>
 
 #include "libtropic_common.h"
@@ -73,6 +74,23 @@ lt_ret_t mock_init_communication(lt_handle_t *h, const uint8_t riscv_fw_ver[4])
     return LT_OK;
 }
 
+lt_ret_t mock_fw_bank_header(lt_handle_t *h, const uint8_t header_size)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+
+    if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))) {
+        return LT_FAIL;
+    }
+
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = header_size,
+                                                 .object = {0}};
+    add_resp_crc(&get_info_resp);
+
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp, calc_mocked_resp_len(&get_info_resp));
+}
+
 lt_ret_t mock_session_start(lt_handle_t *h, const uint8_t kcmd[TR01_AES256_KEY_LEN],
                             const uint8_t kres[TR01_AES256_KEY_LEN])
 {
@@ -99,6 +117,15 @@ lt_ret_t mock_session_start(lt_handle_t *h, const uint8_t kcmd[TR01_AES256_KEY_L
 
     // Mark session status as started.
     h->l3.session_status = LT_SECURE_SESSION_ON;
+#ifdef LT_SESSION_EXPORT
+    memcpy(h->l3.session_keys[0], kcmd, TR01_AES256_KEY_LEN);
+    memcpy(h->l3.session_keys[1], kres, TR01_AES256_KEY_LEN);
+#endif
+#if defined(LT_PIN) || defined(LT_MCOUNTER_CACHE) || defined(LT_ECC_INVENTORY) || defined(LT_R_MEM_MAP) \
+    || defined(LT_PAIRING_PUB_CACHE) || defined(LT_EDDSA_SIG_CACHE)
+    // Caches tied to the Secure Session tell sessions apart by the counter, as after a real handshake.
+    h->l3.session_cnt++;
+#endif
 
     return LT_OK;
 }
@@ -112,52 +139,49 @@ lt_ret_t mock_session_abort(lt_handle_t *h)
 
 lt_ret_t mock_l3_result(lt_handle_t *h, const uint8_t *result_plaintext, const size_t result_plaintext_size)
 {
-    uint8_t l2_frame[TR01_L2_MAX_FRAME_SIZE];
+    uint8_t packet[TR01_L3_PACKET_MAX_SIZE];
+    uint8_t l2_frame[TR01_L1_LEN_MAX];  // Full chunk with CHIP_STATUS.
 
     size_t packet_size = TR01_L3_SIZE_SIZE + result_plaintext_size + TR01_L3_TAG_SIZE;
-    size_t frame_size = TR01_L1_CHIP_STATUS_SIZE + TR01_L2_STATUS_SIZE + TR01_L2_REQ_RSP_LEN_SIZE + packet_size
-                        + TR01_L2_REQ_RSP_CRC_SIZE;
 
-    if (packet_size > TR01_L2_CHUNK_MAX_DATA_SIZE) {
-        LT_LOG_ERROR("Payloads >%u B not supported due to chunking not implemented.", TR01_L2_CHUNK_MAX_DATA_SIZE);
+    if (packet_size > sizeof(packet)) {
+        LT_LOG_ERROR("Payloads >%zu B not supported.", sizeof(packet) - TR01_L3_SIZE_SIZE - TR01_L3_TAG_SIZE);
         return LT_PARAM_ERR;
     }
 
-    // This will happen only if the internal macros are implemented incorrectly.
-    if (frame_size > TR01_L2_MAX_FRAME_SIZE) {
-        LT_LOG_ERROR("Implementation error! Total frame size won't fit to the buffer. Need at least: %zu", frame_size);
-        return LT_FAIL;
-    }
-
-    l2_frame[TR01_L2_CHIP_STATUS_OFFSET] = TR01_L1_CHIP_MODE_READY_bit;
-    l2_frame[TR01_L2_STATUS_OFFSET] = TR01_L2_STATUS_RESULT_OK;
-    l2_frame[TR01_L2_RSP_LEN_OFFSET] = (uint8_t)packet_size;
-
-    l2_frame[TR01_L2_RSP_DATA_RSP_CRC_OFFSET] = result_plaintext_size;
-    l2_frame[TR01_L2_RSP_DATA_RSP_CRC_OFFSET + 1] = 0x00;
+    packet[0] = result_plaintext_size & 0x00FF;
+    packet[1] = result_plaintext_size >> 8;
 
     lt_ret_t ret;
     if (LT_OK
-        != (ret
-            = lt_aesgcm_encrypt(h->l3.crypto_ctx, h->l3.decryption_IV, TR01_L3_IV_SIZE, NULL, 0, result_plaintext,
-                                result_plaintext_size, &l2_frame[TR01_L2_RSP_DATA_RSP_CRC_OFFSET + TR01_L3_SIZE_SIZE],
-                                result_plaintext_size + TR01_L3_TAG_SIZE))) {
+        != (ret = lt_aesgcm_encrypt(h->l3.crypto_ctx, h->l3.decryption_IV, TR01_L3_IV_SIZE, NULL, 0, result_plaintext,
+                                    result_plaintext_size, &packet[TR01_L3_SIZE_SIZE],
+                                    result_plaintext_size + TR01_L3_TAG_SIZE))) {
         LT_LOG_ERROR("Encryption failed! ret=%d", ret);
         return ret;
     }
     // As the mock helpers share CAL interface with Libtropic (simplification), IV is handled in the Libtropic itself ->
     // no need to increment here.
 
-    uint16_t crc
-        = crc16(&l2_frame[TR01_L2_STATUS_OFFSET], TR01_L2_STATUS_SIZE + TR01_L2_REQ_RSP_LEN_SIZE + packet_size);
-    size_t crc_offset = TR01_L2_RSP_DATA_RSP_CRC_OFFSET + packet_size;
-    l2_frame[crc_offset] = crc >> 8;
-    l2_frame[crc_offset + 1] = crc & 0x00FF;
-
-    ret = lt_mock_hal_enqueue_response(&h->l2, l2_frame, frame_size);
-    if (LT_OK != ret) {
-        LT_LOG_ERROR("Failed to enqueue response with L3 Result!");
-        return ret;
+    // Split the packet into L2 Response frames, all but the last one with status RESULT_CONT.
+    for (size_t packet_offset = 0; packet_offset < packet_size; packet_offset += TR01_L2_CHUNK_MAX_DATA_SIZE) {
+        size_t chunk_size = packet_size - packet_offset;
+        bool last_chunk = chunk_size <= TR01_L2_CHUNK_MAX_DATA_SIZE;
+        if (!last_chunk) {
+            chunk_size = TR01_L2_CHUNK_MAX_DATA_SIZE;
+        }
+
+        l2_frame[TR01_L2_CHIP_STATUS_OFFSET] = TR01_L1_CHIP_MODE_READY_bit;
+        l2_frame[TR01_L2_STATUS_OFFSET] = last_chunk ? TR01_L2_STATUS_RESULT_OK : TR01_L2_STATUS_RESULT_CONT;
+        l2_frame[TR01_L2_RSP_LEN_OFFSET] = (uint8_t)chunk_size;
+        memcpy(&l2_frame[TR01_L2_RSP_DATA_RSP_CRC_OFFSET], &packet[packet_offset], chunk_size);
+        add_resp_crc(l2_frame);
+
+        ret = lt_mock_hal_enqueue_response(&h->l2, l2_frame, calc_mocked_resp_len(l2_frame));
+        if (LT_OK != ret) {
+            LT_LOG_ERROR("Failed to enqueue response with L3 Result!");
+            return ret;
+        }
     }
 
     return LT_OK;
@@ -165,34 +189,49 @@ lt_ret_t mock_l3_result(lt_handle_t *h, const uint8_t *result_plaintext, const s
 
 lt_ret_t mock_l3_command_responses(lt_handle_t *h, const size_t chunk_count)
 {
-    if (chunk_count > 1) {
-        LT_LOG_ERROR("Only single chunk supported now!");
-        return LT_PARAM_ERR;
+    for (size_t i = 0; i < chunk_count; i++) {
+        uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+        lt_ret_t ret = lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready));
+        if (LT_OK != ret) {
+            LT_LOG_ERROR("Failed to enqueue L3 Command response 1/2 (CHIP_READY).");
+            return ret;
+        }
+
+        // All chunks but the last one are acknowledged by REQ_CONT.
+        uint8_t req_ok_frame[5] = {
+            TR01_L1_CHIP_MODE_READY_bit,
+            (i == chunk_count - 1) ? TR01_L2_STATUS_REQUEST_OK : TR01_L2_STATUS_REQUEST_CONT,
+            0x00,  // Zero RSP length
+            0x00,  // | Dummy CRC -- will be calculated later
+            0x00   // |
+        };
+
+        uint16_t crc = crc16(req_ok_frame + 1, 2);
+        req_ok_frame[TR01_L2_RSP_DATA_RSP_CRC_OFFSET] = crc >> 8;
+        req_ok_frame[TR01_L2_RSP_DATA_RSP_CRC_OFFSET + 1] = crc & 0x00FF;
+
+        ret = lt_mock_hal_enqueue_response(&h->l2, req_ok_frame, sizeof(req_ok_frame));
+        if (LT_OK != ret) {
+            LT_LOG_ERROR("Failed to enqueue L3 Command response 2/2 (L2 Response)");
+            return ret;
+        }
     }
 
-    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
-    lt_ret_t ret = lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready));
-    if (LT_OK != ret) {
-        LT_LOG_ERROR("Failed to enqueue L3 Command response 1/2 (CHIP_READY).");
-        return ret;
-    }
-
-    uint8_t req_ok_frame[5] = {
-        TR01_L1_CHIP_MODE_READY_bit, TR01_L2_STATUS_REQUEST_OK,
-        0x00,  // Zero RSP length
-        0x00,  // | Dummy CRC -- will be calculated later
-        0x00   // |
-    };
+    return LT_OK;
+}
 
-    uint16_t crc = crc16(req_ok_frame + 1, 2);
-    req_ok_frame[TR01_L2_RSP_DATA_RSP_CRC_OFFSET] = crc >> 8;
-    req_ok_frame[TR01_L2_RSP_DATA_RSP_CRC_OFFSET + 1] = crc & 0x00FF;
+lt_ret_t mock_l3_command_result(lt_handle_t *h, uint8_t *nonce, const uint8_t *result_plaintext,
+                                const size_t result_plaintext_size)
+{
+    uint8_t iv[TR01_L3_IV_SIZE];
+    memcpy(iv, h->l3.decryption_IV, sizeof(iv));
+    h->l3.decryption_IV[0] = (*nonce)++;
 
-    ret = lt_mock_hal_enqueue_response(&h->l2, req_ok_frame, sizeof(req_ok_frame));
-    if (LT_OK != ret) {
-        LT_LOG_ERROR("Failed to enqueue L3 Command response 2/2 (L2 Response)");
-        return ret;
+    lt_ret_t ret = mock_l3_command_responses(h, 1);
+    if (ret == LT_OK) {
+        ret = mock_l3_result(h, result_plaintext, result_plaintext_size);
     }
 
-    return LT_OK;
+    memcpy(h->l3.decryption_IV, iv, sizeof(iv));
+    return ret;
 }
@@ -49,6 +49,19 @@ size_t calc_mocked_resp_len(const void *resp_buf);
  */
 lt_ret_t mock_init_communication(lt_handle_t *h, const uint8_t riscv_fw_ver[4]);
 
+/**
+ * @brief Mock Get_Info L2 Request reading FW header from a firmware bank.
+ *
+ * @details The header is zeroed, only its size matters, e.g. for the silicon revision detected by
+ * lt_get_silicon_rev() before the first mutable firmware update when LT_SILICON_REV_CHECK is enabled.
+ *
+ * @param h Pointer to the lt_handle_t structure.
+ * @param header_size Size of the mocked header (one of TR01_L2_GET_INFO_FW_HEADER_SIZE_*).
+ *
+ * @return lt_ret_t LT_OK on success, error code otherwise.
+ */
+lt_ret_t mock_fw_bank_header(lt_handle_t *h, const uint8_t header_size);
+
 /**
  * @brief Initialize and start a mocked Secure Session for functional mock tests.
  *
@@ -87,8 +100,8 @@ lt_ret_t mock_session_abort(lt_handle_t *h);
  * You only need to provide plaintext part (RESULT field + any data if applicable). It will
  * be encrypted, tag will be added and inserted to an appropriate L2 Response frame.
  *
- * @warning Currently only Results that fit to a single chunk are supported, as chunking
- * is not implemented yet.
+ * Results longer than a single chunk are split into several L2 Response frames, all but the last one with status
+ * RESULT_CONT.
  *
  * @param h Pointer to an lt_handle_t to use (for encryption and enqueuing).
  * @param result_plaintext Plaintext of the L3 Result data to use.
@@ -106,12 +119,28 @@ lt_ret_t mock_l3_result(lt_handle_t *h, const uint8_t *result_plaintext, const s
  *   2. reply to Get_Response -> L2 Response with status REQ_OK (last chunk) or REQ_CONT (not the last chunk)
  *
  * @param h Pointer to an lt_handle_t to use (for encryption and enqueuing).
- * @param chunk_count Count of the L3 Command chunks. Only single chunk supported now.
+ * @param chunk_count Count of the L3 Command chunks.
  *
  * @return LT_OK on success, or an appropriate lt_ret_t error code on failure.
  */
 lt_ret_t mock_l3_command_responses(lt_handle_t *h, const size_t chunk_count);
 
+/**
+ * @brief Mock acknowledgement of a single-chunk L3 Command and its L3 Result encrypted with the given decryption nonce.
+ *
+ * Nonce of the handle is not changed, so results of several L3 Commands executed by one call of Libtropic can be
+ * mocked ahead, each with the next nonce.
+ *
+ * @param h Pointer to an lt_handle_t to use (for encryption and enqueuing).
+ * @param nonce Decryption nonce of the L3 Result, incremented for the next one.
+ * @param result_plaintext Plaintext of the L3 Result data to use.
+ * @param result_plaintext_size Size of the result_plaintext.
+ *
+ * @return LT_OK on success, or an appropriate lt_ret_t error code on failure.
+ */
+lt_ret_t mock_l3_command_result(lt_handle_t *h, uint8_t *nonce, const uint8_t *result_plaintext,
+                                const size_t result_plaintext_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,19 @@ void lt_test_mock_attrs(lt_handle_t *h);
  */
 void lt_test_mock_invalid_in_crc(lt_handle_t *h);
 
+/**
+ * @brief Test for copying of L2 data in the same pass as their CRC16 is calculated.
+ *
+ * Test steps:
+ *  1. Verify that crc16_copy_update() copies the data and returns the same CRC as crc16_update() for lengths around
+ *     the slice sizes.
+ *  2. Verify that lt_l2_frame_check_copy() copies RSP_DATA of a valid frame, detects a corrupted one and copies
+ *     RSP_DATA of a RESULT_CONT frame.
+ *
+ * @param h Handle for communication with TROPIC01 (not used)
+ */
+void lt_test_mock_crc16_copy(lt_handle_t *h);
+
 /**
  * @brief Test for handling HARDWARE_FAIL return code.
  *
@@ -55,6 +68,953 @@ void lt_test_mock_invalid_in_crc(lt_handle_t *h);
  */
 void lt_test_mock_hardware_fail(lt_handle_t *h);
 
+/**
+ * @brief Test for L3 Commands and L3 Results split into several L2 chunks.
+ *
+ * Test steps:
+ * 1. Mock Secure Session initialization.
+ * 2. Mock replies to R_Mem_Data_Write sent in 2 chunks and verify that Libtropic returns LT_OK.
+ * 3. Mock R_Mem_Data_Read Result received in 2 chunks and verify that the read data match the mocked ones.
+ *    With the `SIGN_RANDOM` L3 buffer profile, verify instead that both commands return LT_L3_BUFFER_TOO_SMALL.
+ * 4. Mock Secure Session deinitialization.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_l3_chunking(lt_handle_t *h);
+
+/**
+ * @brief Test for recovery from invalid L2 Response frames.
+ *
+ * Test steps:
+ *  1. Mock a response with GEN_ERR status for a dummy request (Get_Info is used).
+ *  2. Mock a valid response to the following Resend_Req.
+ *  3. Send request and verify that Libtropic recovers the response.
+ *  4. If LT_L2_STATS is enabled, verify the L2 error recovery counters.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_resend(lt_handle_t *h);
+
+/**
+ * @brief Test for asynchronous L2 engine. Skipped if LT_L2_ASYNC is not enabled.
+ *
+ * Test steps:
+ *  1. Mock a "no response yet" reply followed by a valid response to Get_Info.
+ *  2. Start the request by lt_l2_async_send() and verify that the first lt_l2_async_process() reports it is pending.
+ *  3. Verify that another operation cannot be started while the request is in flight.
+ *  4. Verify that the second lt_l2_async_process() finishes the request and calls the completion callback.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_l2_async(lt_handle_t *h);
+
+/**
+ * @brief Test for non-blocking polling for L2 Response offloaded to the port. Skipped if
+ * LT_PORT_SPI_READ_READY_NOWAIT is not enabled.
+ *
+ * Test steps:
+ *  1. Mock Get_Info reply and start the request by lt_l2_async_send().
+ *  2. Verify that the first lt_l2_async_process() hands the polling to the port without reading any frame.
+ *  3. Verify that the second lt_l2_async_process() receives the response and calls the completion callback.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_read_ready_nowait(lt_handle_t *h);
+
+/**
+ * @brief Test for transfer of L3 packets through a bridge of the port. Skipped if LT_PORT_L3_TUNNEL is not enabled.
+ *
+ * Test steps:
+ *  1. Ping with a message taking several L2 chunks and verify it is passed to the bridge by a single port call.
+ *  2. Make the bridge not available and verify the Ping is transferred in L2 chunks by libtropic.
+ *  3. Mock TAG_ERR L2 Response and verify the bridge's STATUS is reported by lt_ping().
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_l3_tunnel(lt_handle_t *h);
+
+/**
+ * @brief Test for Secure Channel Handshake against TROPIC01's side of the handshake simulated by the test.
+ *
+ * Test steps:
+ *  1. Mock Handshake_Rsp computed from the host's ephemeral key and start Secure Session by lt_session_start().
+ *  2. If LT_SESSION_CACHE is enabled, start Secure Session by lt_session_start_cached() without and with ephemeral
+ *     keys prepared by lt_session_cache_prepare() and verify the cache counters, then by lt_session_start() with
+ *     transcript prefix and prepared ephemeral keys taken from the cache attached by lt_session_cache_attach().
+ *  3. If LT_BRINGUP is enabled, bring up the device by lt_bringup_run() with invalid certificate store (reported as
+ *     LT_CERT_STORE_INVALID), then with valid one, and verify STPUB reported to the callback and Secure Session.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_session_start(lt_handle_t *h);
+
+/**
+ * @brief Test for queue of ECDSA signing jobs. Skipped if LT_SIGN_QUEUE is not enabled.
+ *
+ * Test steps:
+ *  1. Mock ECDSA_Sign results of three jobs, the second one with INVALID_KEY.
+ *  2. Submit the jobs and verify the command of the second job was encrypted while the first one executes.
+ *  3. Run the queue and verify the signatures and errors reported to the callbacks, Secure Session stays on.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_sign_queue(lt_handle_t *h);
+
+/**
+ * @brief Test for offload of AES-GCM of the signing queue to a crypto worker. Skipped if LT_CRYPTO_WORKER is not
+ * enabled.
+ *
+ * Test steps:
+ *  1. Set up a signing queue with a worker keeping the works until the test executes them.
+ *  2. Submit three jobs and verify the first command is sent while the worker encrypts the second one.
+ *  3. Run the worker and the queue and verify the signatures and the nonces used.
+ *  4. Make the worker refuse all works and verify the queue executes the next jobs itself.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_crypto_worker(lt_handle_t *h);
+
+/**
+ * @brief Test for pool of TROPIC01 devices. Skipped if LT_POOL is not enabled.
+ *
+ * Test steps:
+ *  1. Add device with running Secure Session to the pool and ping it through the pool.
+ *  2. Set an executor of the device and verify the next ping is run by it.
+ *  3. Mock HARDWARE_FAIL and verify the device is quarantined and its Secure Session dropped.
+ *  4. Verify operations fail with LT_HOST_NO_SESSION as no healthy device is left.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_pool(lt_handle_t *h);
+
+/**
+ * @brief Test for hedged operations and warm standby devices of the device pool. Skipped if LT_POOL_HEDGE is not
+ * enabled.
+ *
+ * Test steps:
+ *  1. Add two devices with running Secure Sessions to the pool, the second one as a warm standby.
+ *  2. Ping LT_POOL_HEDGE_MIN_SAMPLES times and verify only the first device executed the pings and the hedge delay is
+ *     known afterwards.
+ *  3. Make the first TROPIC01 slow and verify the result of Random_Value_Get comes from the hedged duplicate on the
+ *     standby device.
+ *  4. Verify the first device was abandoned without counting a failure and its Secure Session dropped.
+ *  5. Ping again and verify the standby device takes it over without a handshake.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_pool_hedge(lt_handle_t *h);
+
+/**
+ * @brief Test for replication of an ECC key across the device pool. Skipped if LT_POOL is not enabled.
+ *
+ * Test steps:
+ *  1. Add two devices with running Secure Sessions to the pool, with LT_POOL_HEDGE attach asynchronous L2
+ *     operations to both.
+ *  2. Verify invalid parameters are refused.
+ *  3. Replicate the key and verify both devices stored it, the public key is returned and the key is zeroized.
+ *  4. Verify a device already holding the key is only verified.
+ *  5. Verify a device holding a different key fails by LT_FAIL and stays healthy.
+ *  6. Rotate the key and verify the slots are erased first.
+ *  7. Verify a device failing by HARDWARE_FAIL is quarantined and skipped by the next replication.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_pool_replicate(lt_handle_t *h);
+
+/**
+ * @brief Test for streamed mutable firmware update. Skipped if LT_HELPERS is not enabled or silicon revision is not
+ * ACAB.
+ *
+ * Test steps:
+ *  1. Stream an image with valid hash chain by lt_do_mutable_fw_update_stream() and verify it was read whole.
+ *  2. Corrupt the second chunk and verify LT_FW_UPDATE_HASH_ERR is returned before the chunk is sent.
+ *  3. Stream the image without its last chunk and verify LT_FW_UPDATE_HASH_ERR is returned.
+ *  4. Feed the image chunk by chunk by lt_do_mutable_fw_update_feed() and verify all chunks were sent.
+ *  5. Corrupt length of the update request and verify LT_PARAM_ERR is returned.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_fw_update_stream(lt_handle_t *h);
+
+/**
+ * @brief Test for streamed parsing of STPUB from the certificate store.
+ *
+ * Test steps:
+ *  1. Mock only the first 2 Get_Info blocks of a certificate store with a production device certificate.
+ *  2. Read STPUB by lt_get_info_st_pub() and verify it matches the certificate.
+ *  3. Verify no more blocks were requested.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_cert_stream(lt_handle_t *h);
+
+/**
+ * @brief Test for host-side verification of the certificate chain. Skipped if LT_CERT_CHAIN is not enabled.
+ *
+ * Test steps:
+ *  1. Verify a production certificate chain with a stand-in signature verifier and check all 3 signatures are
+ *     verified.
+ *  2. Verify it again and check only the device certificate is verified, the CA certificates are memoized.
+ *  3. Verify it with a failing verifier and check LT_CERT_CHAIN_INVALID is returned.
+ *  4. Verify it against another root and check LT_CERT_CHAIN_INVALID is returned without verifying any signature.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_cert_chain(lt_handle_t *h);
+
+/**
+ * @brief Test for diff-based R-Config apply. Skipped if LT_HELPERS is not enabled.
+ *
+ * Test steps:
+ *  1. Apply config differing from the known current config in one erased object and verify only one
+ *     R_Config_Write is sent and the current config is updated.
+ *  2. Apply the same config again and verify no L3 Command is sent.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_r_config_apply(lt_handle_t *h);
+
+/**
+ * @brief Test for I-config cache in the handle. Skipped if LT_I_CONFIG_CACHE is not enabled.
+ *
+ * Test steps:
+ *  1. Read an I-config object twice and verify only the first read is sent to TROPIC01.
+ *  2. Clear a bit and verify the cached object follows, clearing it again sends no L3 Command.
+ *  3. Invalidate the cache and verify the object is read from TROPIC01 again.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_i_config_cache(lt_handle_t *h);
+
+/**
+ * @brief Test for trace hooks. Skipped if LT_TRACE is not enabled.
+ *
+ * Test steps:
+ *  1. Initialize the handle with trace hooks set and verify every started phase has ended, timestamps do not go
+ *     back and L1 and L2 phases of the Get_Info requests were traced.
+ *  2. Remove the hooks and verify they are not called anymore.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_trace_hooks(lt_handle_t *h);
+
+/**
+ * @brief Test for SPI recorder. Skipped if LT_SPI_RECORDER is not enabled.
+ *
+ * Test steps:
+ *  1. Record Get_Info and verify the request and the response are read out of the ring buffer.
+ *  2. Send more requests than fit into the ring buffer and verify the rest of records is dropped.
+ *  3. Detach the recorder and verify nothing is recorded anymore.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_spi_recorder(lt_handle_t *h);
+
+/**
+ * @brief Test for deferred logging. Skipped if LT_LOG_DEFERRED is not enabled.
+ *
+ * Test steps:
+ *  1. Log a message with arguments of all supported types and verify it is formatted the same as by `snprintf`.
+ *  2. Verify a message longer than the buffer is truncated.
+ *  3. Log more messages than fit into the deferred log and verify the oldest ones are kept.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_log_deferred(lt_handle_t *h);
+
+/**
+ * @brief Test for latency emulation of the mock HAL.
+ *
+ * Test steps:
+ *  1. Emulate busy polls after Get_Info and verify Libtropic polls until the response is ready.
+ *  2. Verify the latency applies to every Get_Info until removed.
+ *  3. Emulate a time based busy period with not ready CHIP_STATUS after the next request only and verify it.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_latency(lt_handle_t *h);
+
+/**
+ * @brief Test for arena of L3 buffers. Skipped if LT_L3_BUFF_ARENA is not enabled.
+ *
+ * Test steps:
+ *  1. Verify arguments of the arena initialization and attach an arena with a single buffer.
+ *  2. Mock Ping and verify the buffer is borrowed and returned, also when TROPIC01 returns a failure.
+ *  3. Verify another handle cannot borrow the buffer held by an L3 Command in progress.
+ *  4. Terminate the Secure Session and verify the held buffer is returned.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_l3_buff_arena(lt_handle_t *h);
+
+/**
+ * @brief Test for decryption of L3 Results straight into caller's buffer. Skipped if LT_L3_STREAM_DECRYPT is not
+ * enabled.
+ *
+ * Test steps:
+ *  1. Mock Random_Value_Get and verify the random bytes are decrypted into the output buffer.
+ *  2. Mock R_Mem_Data_Read into a too small buffer and verify no data are left in it.
+ *  3. Mock Random_Value_Get with invalid tag, verify the output buffer is wiped and the session invalidated.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_l3_stream_decrypt(lt_handle_t *h);
+
+/**
+ * @brief Test for encryption of L3 Commands chunk by chunk while they are sent. Skipped if LT_L3_STREAM_ENCRYPT is not
+ * enabled.
+ *
+ * Test steps:
+ *  1. Encrypt Ping command chunk by chunk and compare it with the same command encrypted at once.
+ *  2. Mock Ping sent in 3 chunks and verify the echoed message.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_l3_stream_encrypt(lt_handle_t *h);
+
+/**
+ * @brief Test for execution of small L3 commands in a single L2 chunk without the L3 buffer. Skipped if
+ * LT_L3_FAST_PATH is not enabled.
+ *
+ * Test steps:
+ *  1. Mock Mcounter_Get, R_Config_Read, ECC_Key_Erase and short Ping and verify L3 buffer is not touched.
+ *  2. Mock Ping too long for the fast path and verify it uses L3 buffer.
+ *  3. Mock Mcounter_Get result of wrong size and verify the session is invalidated.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_l3_fast_path(lt_handle_t *h);
+
+/**
+ * @brief Test for submit/complete API for L3 operations. Skipped if LT_SUBMIT is not enabled.
+ *
+ * Test steps:
+ *  1. Verify completion without submitted operation and submission without output buffer are refused.
+ *  2. Submit Ping, verify another submission is refused, then complete Ping and verify the echoed message.
+ *  3. Submit and complete Mcounter_Get and failing ECC_Key_Erase.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_submit(lt_handle_t *h);
+
+/**
+ * @brief Test for ECDSA signing of messages hashed part by part. Skipped if LT_ECDSA_SIGN_STREAM is not enabled.
+ *
+ * Test steps:
+ *  1. Sign message hashed in two parts and verify the finished context is rejected.
+ *  2. Sign batch of messages read by callback and verify all signatures.
+ *  3. Sign batch where reading of the second message fails, verify the first one is signed and the rest skipped.
+ *  4. Verify invalid parameters are rejected.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_ecdsa_sign_stream(lt_handle_t *h);
+
+/**
+ * @brief Test for EdDSA signing of messages prehashed part by part. Skipped if LT_EDDSA_SIGN_STREAM is not enabled.
+ *
+ * Test steps:
+ *  1. Verify message longer than one L3 Command is refused by lt_ecc_eddsa_sign().
+ *  2. Sign the message prehashed in two parts and verify the finished context is rejected.
+ *  3. Sign the message read by callback.
+ *  4. Verify failing callback abandons the signing and invalid slot is rejected.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_eddsa_sign_stream(lt_handle_t *h);
+
+/**
+ * @brief Test for PIN verification engine based on MAC-and-Destroy. Skipped if LT_PIN is not enabled.
+ *
+ * Test steps:
+ *  1. Verify invalid engine parameters and PIN are rejected.
+ *  2. Set up PIN with all Mac-and-Destroy commands mocked ahead and verify the released key.
+ *  3. Verify the PIN again and check it was answered from the cache without communication.
+ *  4. Verify wrong PIN is refused by TROPIC01, then verify the correct PIN restores the attempts.
+ *  5. Verify other additional data and locked engine are not answered from the cache.
+ *  6. Verify the engine refuses to work without Secure Session.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_pin(lt_handle_t *h);
+
+/**
+ * @brief Test for monotonic counter with the value cached on the host. Skipped if LT_MCOUNTER_CACHE is not enabled.
+ *
+ * Test steps:
+ *  1. Verify invalid counter index is rejected.
+ *  2. Read the value and verify the second read is answered from the cache.
+ *  3. Consume several units in one burst and verify too many units are refused without communication.
+ *  4. Verify failed update drops the cached value and it is read again.
+ *  5. Set and invalidate the counter and verify the cached value follows.
+ *  6. Verify the cached value is not used without Secure Session.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_mcounter_cache(lt_handle_t *h);
+
+/**
+ * @brief Test for warm initialization from cached TROPIC01 attributes. Skipped if LT_WARM_INIT is not enabled.
+ *
+ * Test steps:
+ *  1. Initialize handle by lt_init() and export its attributes together with CHIP_ID.
+ *  2. Initialize handle by lt_init_warm() and verify no communication took place.
+ *  3. Verify the first failed operation reads the attributes of updated FW from TROPIC01, the next one does not.
+ *  4. Verify corrupted cache is detected and lt_init_warm() falls back to lt_init().
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_warm_init(lt_handle_t *h);
+
+/**
+ * @brief Test for shared memory cache of TROPIC01 identity data. Skipped if LT_POSIX_SHM_CACHE is not enabled.
+ *
+ * Test steps:
+ *  1. Map the segment twice, as two processes do, and verify invalid parameters and an empty segment.
+ *  2. Initialize handle through the first mapping and verify the entry is filled from TROPIC01 and published.
+ *  3. Initialize handle through the second mapping and verify no communication took place.
+ *  4. Verify the entry is found by CHIP_ID and publishing the same chip replaces it.
+ *  5. Fill the segment with other chips and verify the least recently published entry is replaced.
+ *  6. Verify a segment of another layout is refused.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_posix_shm_cache(lt_handle_t *h);
+
+/**
+ * @brief Test for mutable firmware update of several TROPIC01 devices with one image. Skipped if LT_FW_FLEET is not
+ * enabled or silicon revision is not ACAB.
+ *
+ * Test steps:
+ *  1. Verify malformed image and offset which is not a boundary of the L2 Requests are rejected.
+ *  2. Update device with the whole image.
+ *  3. Verify update failing on the second chunk reports the offset of the chunk.
+ *  4. Resume the update from the reported offset.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_fw_fleet(lt_handle_t *h);
+
+/**
+ * @brief Test for multi-bank mutable firmware update overlapping preparation of the images with the bank erase.
+ * Skipped if LT_FW_PLAN is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks and the limit of LT_FW_PLAN_MAX_STEPS steps.
+ *  2. Verify update of two banks, the second image is prepared while TROPIC01 processes the request erasing a bank,
+ *     and the progress of both steps is reported.
+ *  3. Verify failed preparation ends the plan after the response of the erase and running the plan again continues
+ *     with the failed step.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_fw_plan(lt_handle_t *h);
+
+/**
+ * @brief Test for resumable mutable firmware update with checkpoints. Skipped if LT_FW_UPDATE_RESUME is not enabled or
+ * silicon revision is not ACAB.
+ *
+ * Test steps:
+ *  1. Verify malformed image is rejected.
+ *  2. Send the update request and the first chunk, which is sent again after TROPIC01 was busy.
+ *  3. Verify chunk rejected by TROPIC01 keeps the position of the update.
+ *  4. Verify corrupted checkpoint and checkpoint of another image are refused.
+ *  5. Resume the update from the exported checkpoint and finish it.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_fw_update_resume(lt_handle_t *h);
+
+/**
+ * @brief Test for mutable firmware update image read by parts. Skipped if LT_FW_IMAGE is not enabled or silicon
+ * revision is not ACAB.
+ *
+ * Test steps:
+ *  1. Verify malformed image and failing reader are rejected.
+ *  2. Open image, verify only the length bytes are read and the index is filled.
+ *  3. Look up chunks inside and outside of the index.
+ *  4. Update with the whole image.
+ *  5. Verify update rejected on a chunk reports it and resume the update from it.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_fw_image(lt_handle_t *h);
+
+/**
+ * @brief Test for runtime detection of TROPIC01 silicon revision. Skipped if LT_SILICON_REV_CHECK is not enabled.
+ *
+ * Test steps:
+ *  1. Mock FW header of the built silicon revision and verify it is detected and passes the check.
+ *  2. Verify the detected revision is returned again without any communication.
+ *  3. Initialize the handle again, mock FW header of the other revision and verify mutable firmware update returns
+ *     LT_SILICON_REV_MISMATCH without sending its L2 Request.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_silicon_rev(lt_handle_t *h);
+
+/**
+ * @brief Test for idle manager putting TROPIC01 to sleep. Skipped if LT_IDLE_MGR is not enabled.
+ *
+ * Test steps:
+ *  1. Verify TROPIC01 is not put to sleep before the idle time or while it is in use.
+ *  2. Verify TROPIC01 is put to sleep after the idle time and the Secure Session is invalidated.
+ *  3. Wake TROPIC01 and verify rejected restore of the Secure Session is reported.
+ *  4. Sleep and wake without Secure Session and verify nothing is sent on the wake.
+ *  5. Verify the counters.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_idle(lt_handle_t *h);
+
+/**
+ * @brief Test for health monitor piggybacking on L3 Results. Skipped if LT_HEALTH is not enabled.
+ *
+ * Test steps:
+ *  1. Verify Ping is sent when no L3 Result arrived yet and not sent within the period after an L3 Result.
+ *  2. Verify failed Ping after the period is reported and counted.
+ *  3. Verify Ping fails without Secure Session.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_health(lt_handle_t *h);
+
+/**
+ * @brief Test for priority scheduler of jobs. Skipped if LT_SCHED is not enabled.
+ *
+ * Test steps:
+ *  1. Queue two bulk jobs and a normal one, the first step of the bulk job submits an urgent job.
+ *  2. Verify the normal job goes first and the urgent one right after the first step of the bulk job.
+ *  3. Verify results, the failing bulk job finishes early with the error of its step.
+ *  4. Verify the counters and that the full queue is refused.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_sched(lt_handle_t *h);
+
+/**
+ * @brief Test for host-side batch verification of Ed25519 signatures. Skipped if LT_ED25519_VERIFY is not enabled.
+ *
+ * Test steps:
+ *  1. Verify RFC 8032 signatures one at a time and in a batch longer than one group, public keys repeat.
+ *  2. Corrupt message, R, S and public key of four signatures, verify only those are reported not valid.
+ *  3. Verify NULL items, public key, signature and message are refused.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_ed25519_verify(lt_handle_t *h);
+
+/**
+ * @brief Test for CAL selected at runtime through function tables. Skipped if LT_CRYPTO_OPS is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameters of lt_crypto_ops_set(), lt_crypto_ops_set_global() and lt_crypto_ops_probe() are checked.
+ *  2. Verify the process-wide CAL stays the one set up by main() and selecting a different one fails.
+ *  3. Probe the CAL set up by main(), Trezor crypto CAL and a broken CAL, verify the fastest working one is selected
+ *     and the broken one is skipped.
+ *  4. Verify probe of only the broken CAL fails and keeps the selection.
+ *  5. Run a mocked Secure Session and Ping with each working CAL, with LT_L3_STREAM_DECRYPT also Random_Value_Get.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_crypto_ops(lt_handle_t *h);
+
+/**
+ * @brief Test for the pairing key cache. Skipped if LT_PAIRING_KEY_CACHE is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks.
+ *  2. Verify the provider is called once per slot and the keys are cached.
+ *  3. Verify a forgotten slot is wiped and unwrapped again.
+ *  4. Verify failure of the provider is returned and nothing is cached.
+ *  5. Verify deinit wipes all slots.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_pairing_key_cache(lt_handle_t *h);
+
+/**
+ * @brief Test for the ECC key slot inventory in the handle. Skipped if LT_ECC_INVENTORY is not enabled.
+ *
+ * Test steps:
+ *  1. Find a free slot and verify the slots are read only until the first empty one.
+ *  2. Verify a key read once is answered from the inventory.
+ *  3. Verify generate and erase update the inventory, a failed erase makes the slot unknown.
+ *  4. Verify the inventory is dropped by a new Secure Session and by lt_ecc_inventory_invalidate().
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_ecc_inventory(lt_handle_t *h);
+
+/**
+ * @brief Test for the occupancy map of R-mem user data slots. Skipped if LT_R_MEM_MAP is not enabled.
+ *
+ * Test steps:
+ *  1. Load a current summary and verify lookups send nothing.
+ *  2. Verify the counter is decremented before the first change only, a failed write makes the slot unknown.
+ *  3. Verify a flush writes the summary and the next change decrements the counter again.
+ *  4. Verify a stale summary in a new Secure Session leaves the slots to probing and scan steps.
+ *  5. Verify a detached map is not updated by R-mem operations.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_r_mem_map(lt_handle_t *h);
+
+/**
+ * @brief Test for the pool of ECC keys generated ahead of time. Skipped if LT_ECC_KEY_POOL is not enabled.
+ *
+ * Test steps:
+ *  1. Refill the pool step by step and verify every slot is erased, generated and read.
+ *  2. Verify ready keys are handed out with their public keys without an L3 Command.
+ *  3. Verify a key is generated on demand when none is ready.
+ *  4. Verify a failed generation and a foreign key make the slot erased again.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_ecc_key_pool(lt_handle_t *h);
+
+/**
+ * @brief Test for the pairing public key cache. Skipped if LT_PAIRING_PUB_CACHE is not enabled.
+ *
+ * Test steps:
+ *  1. Verify a read is sent once and answered from the cache afterwards, including an empty slot.
+ *  2. Verify a write and an invalidation update the cached slot.
+ *  3. Verify a failed write makes the slot read again.
+ *  4. Verify lt_pairing_pub_cache_invalidate() and a new session drop the cache.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_pairing_pub_cache(lt_handle_t *h);
+
+/**
+ * @brief Test for the drain of the log of TROPIC01's RISC-V FW. Skipped if LT_CPU_LOG_DRAIN is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks.
+ *  2. Verify every drain step sends one Get_Log_Req and the drain is done on an empty message.
+ *  3. Verify the log is printed in slices.
+ *  4. Verify nothing is sent while the ring buffer has no space for the longest message.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_cpu_log(lt_handle_t *h);
+
+/**
+ * @brief Test for the hex encoding shared by lt_print_bytes() and the debug helpers.
+ *
+ * Test steps:
+ *  1. Verify all byte values are encoded in upper and lower case.
+ *  2. Verify encoded bytes are decoded back, characters which are not hex digits are refused.
+ *  3. Verify lt_print_bytes() output and its buffer size check (if LT_HELPERS is enabled).
+ *
+ * @param h Handle for communication with TROPIC01 (not used)
+ */
+void lt_test_mock_hex(lt_handle_t *h);
+
+/**
+ * @brief Test for the export of trace hook events in the Chrome trace event format. Skipped if LT_TRACE_EXPORT is not
+ * enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks.
+ *  2. Verify phases of lt_init() are recorded by the exporter set as trace hooks.
+ *  3. Verify waits inside an L3 Result are exported as chip compute and phases left open by dropped events are closed.
+ *  4. Verify the exported JSON of two exporters and that an error of the writer ends the export.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_trace_export(lt_handle_t *h);
+
+/**
+ * @brief Test for the export of runtime statistics in the OpenMetrics text format. Skipped if LT_METRICS is not
+ * enabled.
+ *
+ * Test steps:
+ *  1. Verify latency buckets and parameter checks.
+ *  2. Verify executions of L3 Commands are counted in the latency histogram.
+ *  3. Verify the exported counters, gauges and histograms of two devices.
+ *  4. Verify an error of the writer ends the export.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_metrics(lt_handle_t *h);
+
+/**
+ * @brief Test for polling for readiness of TROPIC01 after reboot. Skipped if LT_REBOOT_POLL is not enabled.
+ *
+ * Test steps:
+ *  1. Reboot while TROPIC01 reads as 0xFF, not ready and in the mode it is leaving, and verify polling continues until
+ *     it is ready in Application Mode, sooner than LT_TR01_REBOOT_DELAY_MS.
+ *  2. Verify reboot into Maintenance Mode waits for the START bit.
+ *  3. Verify reboot finishes after a single poll if TROPIC01 is ready right after the minimal delay.
+ *  4. Verify Alarm Mode ends polling and lt_reboot() returns LT_L1_CHIP_ALARM_MODE.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_reboot_poll(lt_handle_t *h);
+
+/**
+ * @brief Test for asynchronous reboot and initialization of TROPIC01. Skipped if LT_REBOOT_ASYNC is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks and that a reboot which was not started is not busy.
+ *  2. Verify asynchronous initialization of TROPIC01 executing Application FW finishes by the first process call.
+ *  3. Verify nothing is read before LT_TR01_REBOOT_MIN_DELAY_MS, then CHIP_STATUS is polled until TROPIC01 is ready
+ *     in Application Mode and the callback is called once.
+ *  4. Verify reboot into Maintenance Mode waits for the START bit.
+ *  5. Verify Alarm Mode ends polling with LT_L1_CHIP_ALARM_MODE.
+ *  6. Verify asynchronous initialization reboots TROPIC01 in Maintenance Mode and reads the attributes afterwards.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_reboot_async(lt_handle_t *h);
+
+/**
+ * @brief Test for tuning of the SPI clock by Ping round-trips and its lowering on CRC errors. Skipped if LT_LINK_TUNE
+ * is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks and that lt_link_tune() requires a Secure Session.
+ *  2. Tune over four clocks with the mocked link corrupting frames above the third one, verify the third clock is
+ *     kept, the Secure Session is aborted after the failed Ping and counters are zero.
+ *  3. Degrade the link below the tuned clock and verify LT_LINK_TUNE_MAX_ERRORS resent frames lower the clock by one
+ *     step.
+ *  4. Verify frames are not corrupted at the lowered clock.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_link_tune(lt_handle_t *h);
+
+/**
+ * @brief Test for placement of the buffers for DMA and cache maintenance of the port. Skipped if neither LT_BUFF_ALIGN
+ * nor LT_PORT_CACHE_MAINT is enabled.
+ *
+ * Test steps:
+ *  1. With LT_BUFF_ALIGN, verify the L2 and L3 buffers are aligned to LT_DMA_BUFF_ALIGN and their sizes rounded up to
+ *     it.
+ *  2. With LT_PORT_CACHE_MAINT, initialize the handle and verify the port cleaned and invalidated the same, non-zero
+ *     number of bytes.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_dma_buff(lt_handle_t *h);
+
+/**
+ * @brief Test for the deadline of the API calls. Skipped if LT_DEADLINE is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks and that no deadline is set after initialization.
+ *  2. Set a deadline shorter than LT_L1_READ_RETRY_DELAY, mock busy TROPIC01 and verify Get_Info returns
+ *     LT_DEADLINE_EXCEEDED without waiting for the next poll.
+ *  3. Verify nothing is sent once the deadline passed, and the same request succeeds after the deadline is cleared.
+ *  4. Verify a request finishing within the deadline succeeds and the time left is reported.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_deadline(lt_handle_t *h);
+
+/**
+ * @brief Test for export and import of a live Secure Session. Skipped if LT_SESSION_EXPORT is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks and that a handle without Secure Session cannot export.
+ *  2. Start a mocked Secure Session, send Ping and export the session, verify the handle gave it up.
+ *  3. Reinitialize the handle and verify blobs sealed by another key, modified or of another version are refused.
+ *  4. Import the blob, verify the nonces are restored, the blob is consumed and Ping succeeds in the resumed session.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_session_export(lt_handle_t *h);
+
+/**
+ * @brief Test for lock-free submission and completion rings. Skipped if LT_RING is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks, capacities which are not a power of two are refused.
+ *  2. Fill both rings and verify the next push is refused by LT_RING_FULL.
+ *  3. Pop the items and verify their order, then push and pop across the wrap-around of the positions.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_ring(lt_handle_t *h);
+
+/**
+ * @brief Test for bulk erase of R-mem, ECC and pairing key slots. Skipped if LT_BULK_ERASE is not enabled.
+ *
+ * Test steps:
+ *  1. Verify parameter checks and that a handle without Secure Session cannot erase.
+ *  2. Start a mocked Secure Session and erase R-mem, ECC and pairing key slots back-to-back, one of them refused.
+ *  3. Verify the progress reports and that only the refused slot stays selected, then erase it by the same set.
+ *  4. With LT_ECC_INVENTORY, verify a slot known to be empty is skipped without an L3 Command.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_bulk_erase(lt_handle_t *h);
+
+/**
+ * @brief Test for the EdDSA signature cache in the handle. Skipped if LT_EDDSA_SIG_CACHE is not enabled.
+ *
+ * Test steps:
+ *  1. Verify a message signed once by a key is served from the cache, other messages and keys are sent.
+ *  2. Verify a failed signing is not cached.
+ *  3. Verify generate and a failed erase of a slot make its messages signed by TROPIC01 again.
+ *  4. Verify the cache is dropped by lt_eddsa_sig_cache_invalidate() and by a new Secure Session.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_eddsa_sig_cache(lt_handle_t *h);
+
+/**
+ * @brief Test for the provisioning station. Skipped if LT_PROVISION is not enabled.
+ *
+ * Test steps:
+ *  1. Verify invalid profiles and a device without Secure Session are refused.
+ *  2. Verify only the pairing keys, R-config objects and ECC keys which differ from the profile are written, all of
+ *     them are read back and public keys of the profile keys are reported.
+ *  3. Verify a device whose I-config bit would have to be set again fails before anything is written.
+ *  4. Verify only the I-config bit cleared by the profile is written.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_provision(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP vault operations on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify PIN setup and AUTHENTICATE: blank chip, wrong PINs, chip error, restored attempts.
+ *  2. Verify AUTHENTICATE within the TTL reuses the unlocked key and the session expires on the monotonic clock.
+ *  3. Verify validation of secret names.
+ *  4. Verify values spanning several R-memory slots, too small buffers and values exceeding the capacity.
+ *  5. Verify a failed STORE keeps the secrets stored before and a new vault reads the directory back.
+ *  6. Verify lookup of an unknown name needs no chip round-trip.
+ *  7. Verify avp_retrieve_many() reports the status of each secret and skips the reads after a chip error.
+ *  8. Verify LIST reads the metadata only once, and the listing cursor with and without a name prefix.
+ *  9. Verify DELETE, also with a chip error.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_vault(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP hardware operations on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify HW_CHALLENGE reads the identity and the certificate chain once, a chip error is not cached.
+ *  2. Verify generation of named signing keys: duplicate and invalid names, invalid curve, chip error.
+ *  3. Verify public keys and HW_SIGN are served from the cached curve and public key, also with chip errors.
+ *  4. Verify HW_CHALLENGE with a signature costs a single chip operation once the identity is cached.
+ *  5. Verify a new vault reads each public key once and a key erased by another application is not found.
+ *  6. Verify deletion of signing keys and generation until all ECC key slots are named.
+ *  7. Verify HW_ATTEST and that the operations need a session.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_keys(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP secret cache, its refresh and the prefetch on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify RETRIEVE is served from the cache after the first read, long values are always read.
+ *  2. Verify STORE of a cached secret caches the new value.
+ *  3. Verify the cache is purged by AUTHENTICATE and by the end of the session.
+ *  4. Verify avp_idle() reads the cached secrets again before their TTL, after a change by another host and that
+ *     an entry not refreshed in time or failed to refresh is read from TROPIC01.
+ *  5. Verify avp_prefetch_set() errors and that the recently used secrets are saved in the manifest.
+ *  6. Verify the configured and the recently used secrets are prefetched after AUTHENTICATE, also by a new vault.
+ *  7. Verify a chip error of the prefetch.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_cache(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP wear leveling and deferred erase on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify STORE of an existing secret writes a free slot and keeps the old one until avp_idle().
+ *  2. Verify avp_idle() erases at most max_erases slots and saves the wear table.
+ *  3. Verify repeated rotation of one secret moves around the slots and a new vault reads the wear table back.
+ *  4. Verify DELETE only queues the slots for erase and a failed erase stays queued.
+ *  5. Verify the queue of a reset vault is taken from the wear table and avp_deinit() erases it.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_erase(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP compression and STORE deduplication on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify a compressible value takes fewer slots and reads back, also by a new vault.
+ *  2. Verify an incompressible value is stored as is.
+ *  3. Verify STORE of the value stored by this vault talks to no chip, a changed value is written.
+ *  4. Verify a failed STORE is not taken for a stored value.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_store(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP workspace partitions on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify DISCOVER reports the capacity of one partition.
+ *  2. Verify secrets of a workspace are not seen by another one and a workspace beyond the partitions is refused.
+ *  3. Verify switching to an unchanged workspace reads no directory slot, a changed one is read again.
+ *  4. Verify a workspace is limited to its partition.
+ *  5. Verify a new vault reads the workspace table back.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_workspaces(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP envelope encryption and the host log on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify avp_envelope_enable() parameters.
+ *  2. Verify an enveloped secret takes one slot and one read, a secret stored before is still read from R-memory.
+ *  3. Verify a new version replaces the ciphertext of the old one.
+ *  4. Verify a tampered, swapped or missing ciphertext is refused and a failed put keeps the stored version.
+ *  5. Verify a vault without the host store cannot read an enveloped secret and DELETE removes the ciphertexts.
+ *  6. Verify the host log stores the ciphertexts across reopening and rebuilds a lost index.
+ *  7. Verify compaction of the host log and that a corrupted record is refused.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_envelope(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP vault daemon and its secure arena on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify the secure arena allocates from the fitting size class, refuses invalid frees and wipes freed blocks.
+ *  2. Verify connections beyond AVP_DAEMON_CLIENTS are refused.
+ *  3. Verify an agent must AUTHENTICATE with the right PIN before other operations.
+ *  4. Verify agents of one workspace share its secrets through STORE, RETRIEVE, LIST and DELETE.
+ *  5. Verify METRICS counts the requests and the refused connection.
+ *  6. Verify concurrent agent processes are served and the vault holds their secrets.
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_daemon(lt_handle_t *h);
+
+/**
+ * @brief Test for the AVP batch commit and its journal on the chip model. Built only with LT_PIN.
+ *
+ * Test steps:
+ *  1. Verify a batch is applied by its commit and its released slots are erased.
+ *  2. Verify a commit failing before its record leaves the batch unapplied.
+ *  3. Verify a new vault replays the journal of a commit interrupted after its record.
+ *  4. Verify a released slot failing to erase at commit stays queued and is erased by avp_flush().
+ *  5. Verify a slot failing to erase at DELETE stays queued and is erased by avp_flush().
+ *
+ * @param h Handle for communication with TROPIC01
+ */
+void lt_test_mock_avp_batch(lt_handle_t *h);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,144 @@
+/**
+ * @file lt_test_mock_bulk_erase.c
+ * @brief Test bulk erase of R-mem, ECC and pairing key slots (LT_BULK_ERASE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_BULK_ERASE
+/** Max number of progress reports recorded by the test. */
+#define BULK_ERASE_TEST_REPORTS 8
+
+/** Progress reports of the bulk erase. */
+typedef struct bulk_erase_test_log_t {
+    uint8_t count;
+    lt_bulk_erase_kind_t kind[BULK_ERASE_TEST_REPORTS];
+    uint16_t slot[BULK_ERASE_TEST_REPORTS];
+    lt_ret_t ret[BULK_ERASE_TEST_REPORTS];
+    uint16_t done;
+    uint16_t total;
+} bulk_erase_test_log_t;
+
+static void bulk_erase_test_progress(void *cb_ctx, lt_bulk_erase_kind_t kind, uint16_t slot, lt_ret_t ret,
+                                     uint16_t done, uint16_t total)
+{
+    bulk_erase_test_log_t *log = (bulk_erase_test_log_t *)cb_ctx;
+
+    if (log->count < BULK_ERASE_TEST_REPORTS) {
+        log->kind[log->count] = kind;
+        log->slot[log->count] = slot;
+        log->ret[log->count] = ret;
+        log->count++;
+    }
+    log->done = done;
+    log->total = total;
+}
+
+#endif
+
+void lt_test_mock_bulk_erase(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_bulk_erase()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_BULK_ERASE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_BULK_ERASE is not enabled, skipping.");
+#else
+    lt_bulk_erase_set_t set;
+    bulk_erase_test_log_t log;
+    memset(&set, 0, sizeof(set));
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Checking parameters...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_bulk_erase_add_r_mem(NULL, 0, 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_bulk_erase_add_r_mem(&set, 4, 3));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_bulk_erase_add_r_mem(&set, 0, TR01_R_MEM_DATA_SLOT_MAX + 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_bulk_erase_add_ecc(&set, TR01_ECC_SLOT_2, TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_bulk_erase_add_pairing(&set, 0, 4));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_bulk_erase(NULL, &set, NULL, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_bulk_erase(h, NULL, NULL, NULL));
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_bulk_erase(h, &set, NULL, NULL));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+
+    LT_LOG_INFO("Erasing nothing, no L3 Command has to be sent...");
+    LT_TEST_ASSERT(LT_OK, lt_bulk_erase(h, &set, NULL, NULL));
+    LT_TEST_ASSERT(0, set.sent);
+
+    LT_LOG_INFO("Erasing R-mem slots 3-4, ECC key slot 1 and pairing key slot 2, ECC key slot 1 is refused...");
+    LT_TEST_ASSERT(LT_OK, lt_bulk_erase_add_r_mem(&set, 3, 4));
+    LT_TEST_ASSERT(LT_OK, lt_bulk_erase_add_ecc(&set, TR01_ECC_SLOT_1, TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(LT_OK, lt_bulk_erase_add_pairing(&set, 2, 2));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, &nonce, &(uint8_t){TR01_L3_RESULT_OK}, TR01_L3_RESULT_SIZE));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, &nonce, &(uint8_t){TR01_L3_RESULT_OK}, TR01_L3_RESULT_SIZE));
+    LT_TEST_ASSERT(LT_OK,
+                   mock_l3_command_result(h, &nonce, &(uint8_t){TR01_L3_RESULT_UNAUTHORIZED}, TR01_L3_RESULT_SIZE));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, &nonce, &(uint8_t){TR01_L3_RESULT_OK}, TR01_L3_RESULT_SIZE));
+    memset(&log, 0, sizeof(log));
+    LT_TEST_ASSERT(LT_L3_UNAUTHORIZED, lt_bulk_erase(h, &set, bulk_erase_test_progress, &log));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(4, set.sent);
+    LT_TEST_ASSERT(4, log.count);
+    LT_TEST_ASSERT(4, log.done);
+    LT_TEST_ASSERT(4, log.total);
+    LT_TEST_ASSERT(1, (log.kind[0] == LT_BULK_ERASE_R_MEM) && (log.slot[0] == 3) && (log.ret[0] == LT_OK));
+    LT_TEST_ASSERT(1, (log.kind[1] == LT_BULK_ERASE_R_MEM) && (log.slot[1] == 4));
+    LT_TEST_ASSERT(1, (log.kind[2] == LT_BULK_ERASE_ECC) && (log.slot[2] == 1));
+    LT_TEST_ASSERT(LT_L3_UNAUTHORIZED, log.ret[2]);
+    LT_TEST_ASSERT(1, (log.kind[3] == LT_BULK_ERASE_PAIRING) && (log.slot[3] == 2) && (log.ret[3] == LT_OK));
+
+    LT_LOG_INFO("Only the refused slot has to stay selected...");
+    LT_TEST_ASSERT(0, (int)set.r_mem[0]);
+    LT_TEST_ASSERT(1, set.ecc == (1UL << TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(0, set.pairing);
+
+    LT_LOG_INFO("Passing the set again, the refused slot is erased...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, &nonce, &(uint8_t){TR01_L3_RESULT_OK}, TR01_L3_RESULT_SIZE));
+    memset(&log, 0, sizeof(log));
+    LT_TEST_ASSERT(LT_OK, lt_bulk_erase(h, &set, bulk_erase_test_progress, &log));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(5, set.sent);
+    LT_TEST_ASSERT(1, log.count);
+    LT_TEST_ASSERT(0, (int)set.ecc);
+
+#ifdef LT_ECC_INVENTORY
+    LT_LOG_INFO("Erasing ECC key slot 1 again, it is known to be empty and has to be skipped...");
+    LT_TEST_ASSERT(LT_OK, lt_bulk_erase_add_ecc(&set, TR01_ECC_SLOT_1, TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(LT_OK, lt_bulk_erase(h, &set, NULL, NULL));
+    LT_TEST_ASSERT(5, set.sent);
+    LT_TEST_ASSERT(1, set.skipped);
+    LT_TEST_ASSERT(0, (int)set.ecc);
+#endif
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
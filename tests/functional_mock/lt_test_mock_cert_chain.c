@@ -0,0 +1,256 @@
+/**
+ * @file lt_test_mock_cert_chain.c
+ * @brief Test host-side verification of the certificate chain (LT_CERT_CHAIN).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_test_common.h"
+
+#ifdef LT_CERT_CHAIN
+/** Device certificate. */
+static const uint8_t cert_device[] = {
+    0x30, 0x82, 0x01, 0xdb, 0x30, 0x82, 0x01, 0x62, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x10, 0x02,
+    0xf0, 0x02, 0x00, 0x08, 0x82, 0x19, 0x06, 0x1b, 0x09, 0x33, 0x00, 0x00, 0x04, 0x00, 0x09, 0x30,
+    0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x03, 0x30, 0x4c, 0x31, 0x0b, 0x30,
+    0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x43, 0x5a, 0x31, 0x1d, 0x30, 0x1b, 0x06, 0x03,
+    0x55, 0x04, 0x0a, 0x0c, 0x14, 0x54, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75, 0x61,
+    0x72, 0x65, 0x20, 0x73, 0x2e, 0x72, 0x2e, 0x6f, 0x2e, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55,
+    0x04, 0x03, 0x0c, 0x15, 0x54, 0x52, 0x4f, 0x50, 0x49, 0x43, 0x30, 0x31, 0x2d, 0x58, 0x20, 0x54,
+    0x45, 0x53, 0x54, 0x20, 0x43, 0x41, 0x20, 0x76, 0x31, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x35, 0x30,
+    0x36, 0x32, 0x37, 0x30, 0x38, 0x34, 0x30, 0x35, 0x35, 0x5a, 0x17, 0x0d, 0x34, 0x35, 0x30, 0x36,
+    0x32, 0x37, 0x30, 0x38, 0x34, 0x30, 0x35, 0x35, 0x5a, 0x30, 0x1c, 0x31, 0x1a, 0x30, 0x18, 0x06,
+    0x03, 0x55, 0x04, 0x03, 0x0c, 0x11, 0x54, 0x52, 0x4f, 0x50, 0x49, 0x43, 0x30, 0x31, 0x20, 0x65,
+    0x53, 0x45, 0x20, 0x54, 0x45, 0x53, 0x54, 0x30, 0x2a, 0x30, 0x05, 0x06, 0x03, 0x2b, 0x65, 0x6e,
+    0x03, 0x21, 0x00, 0x95, 0x08, 0xf0, 0x32, 0x1c, 0xb1, 0xd2, 0xe5, 0xd1, 0xf1, 0xa4, 0x60, 0x9c,
+    0x05, 0x41, 0xb7, 0x80, 0xe6, 0xdd, 0x50, 0xd6, 0x48, 0x2b, 0x6b, 0x08, 0xb2, 0xc2, 0x7e, 0x7b,
+    0x76, 0x26, 0x47, 0xa3, 0x81, 0x84, 0x30, 0x81, 0x81, 0x30, 0x0c, 0x06, 0x03, 0x55, 0x1d, 0x13,
+    0x01, 0x01, 0xff, 0x04, 0x02, 0x30, 0x00, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01,
+    0xff, 0x04, 0x04, 0x03, 0x02, 0x03, 0x08, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18,
+    0x30, 0x16, 0x80, 0x14, 0x7b, 0xf3, 0x8c, 0x79, 0x9b, 0x7a, 0x4b, 0x2e, 0xbf, 0x41, 0x05, 0x7d,
+    0xd5, 0xd2, 0x6a, 0xeb, 0x5d, 0xa0, 0x40, 0xf3, 0x30, 0x40, 0x06, 0x03, 0x55, 0x1d, 0x1f, 0x04,
+    0x39, 0x30, 0x37, 0x30, 0x35, 0xa0, 0x33, 0xa0, 0x31, 0x86, 0x2f, 0x68, 0x74, 0x74, 0x70, 0x3a,
+    0x2f, 0x2f, 0x70, 0x6b, 0x69, 0x2e, 0x74, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x73, 0x71, 0x75, 0x61,
+    0x72, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x6c, 0x33, 0x2f, 0x74, 0x30, 0x31, 0x2d, 0x54, 0x76,
+    0x31, 0x2d, 0x74, 0x65, 0x73, 0x74, 0x2e, 0x63, 0x72, 0x6c, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86,
+    0x48, 0xce, 0x3d, 0x04, 0x03, 0x03, 0x03, 0x67, 0x00, 0x30, 0x64, 0x02, 0x30, 0x41, 0x1d, 0x4e,
+    0x3f, 0xf8, 0xc5, 0x1f, 0x7e, 0x76, 0x4c, 0xa6, 0x33, 0x05, 0x2c, 0x32, 0x40, 0x0d, 0xf7, 0x69,
+    0xe7, 0xaa, 0x39, 0x00, 0x65, 0xc3, 0xd7, 0xa0, 0x88, 0xa7, 0xda, 0x9a, 0x48, 0xac, 0xf2, 0x09,
+    0xd5, 0x09, 0x83, 0x3a, 0x81, 0x18, 0x52, 0x9c, 0xf8, 0xe3, 0x54, 0x94, 0xb4, 0x02, 0x30, 0x6d,
+    0x6d, 0x42, 0xa5, 0x0c, 0x13, 0xf8, 0x1d, 0x52, 0x51, 0x0b, 0x6b, 0xc5, 0xef, 0x16, 0x5f, 0xa3,
+    0x01, 0x82, 0xc5, 0xe3, 0x2f, 0x5d, 0x4e, 0xa9, 0xc0, 0x46, 0x8b, 0x3b, 0x02, 0xf7, 0xa2, 0x8c,
+    0xee, 0x79, 0xdb, 0xcf, 0x54, 0x6f, 0xdb, 0x55, 0xe0, 0xf0, 0x3a, 0xd0, 0xd5, 0x98, 0xf7};
+
+/** TROPIC01-X CA certificate, issuer of the device certificate. */
+static const uint8_t cert_xxxx[] = {
+    0x30, 0x82, 0x02, 0x68, 0x30, 0x82, 0x01, 0xee, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x02, 0x27,
+    0x11, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x03, 0x30, 0x4a, 0x31,
+    0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x43, 0x5a, 0x31, 0x1d, 0x30, 0x1b,
+    0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x14, 0x54, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71,
+    0x75, 0x61, 0x72, 0x65, 0x20, 0x73, 0x2e, 0x72, 0x2e, 0x6f, 0x2e, 0x31, 0x1c, 0x30, 0x1a, 0x06,
+    0x03, 0x55, 0x04, 0x03, 0x0c, 0x13, 0x54, 0x52, 0x4f, 0x50, 0x49, 0x43, 0x30, 0x31, 0x20, 0x54,
+    0x45, 0x53, 0x54, 0x20, 0x43, 0x41, 0x20, 0x76, 0x31, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x35, 0x30,
+    0x33, 0x32, 0x34, 0x31, 0x33, 0x31, 0x34, 0x34, 0x33, 0x5a, 0x18, 0x0f, 0x32, 0x30, 0x36, 0x30,
+    0x30, 0x33, 0x32, 0x34, 0x31, 0x33, 0x31, 0x34, 0x34, 0x33, 0x5a, 0x30, 0x4c, 0x31, 0x0b, 0x30,
+    0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x43, 0x5a, 0x31, 0x1d, 0x30, 0x1b, 0x06, 0x03,
+    0x55, 0x04, 0x0a, 0x0c, 0x14, 0x54, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75, 0x61,
+    0x72, 0x65, 0x20, 0x73, 0x2e, 0x72, 0x2e, 0x6f, 0x2e, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55,
+    0x04, 0x03, 0x0c, 0x15, 0x54, 0x52, 0x4f, 0x50, 0x49, 0x43, 0x30, 0x31, 0x2d, 0x58, 0x20, 0x54,
+    0x45, 0x53, 0x54, 0x20, 0x43, 0x41, 0x20, 0x76, 0x31, 0x30, 0x76, 0x30, 0x10, 0x06, 0x07, 0x2a,
+    0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x05, 0x2b, 0x81, 0x04, 0x00, 0x22, 0x03, 0x62, 0x00,
+    0x04, 0xb5, 0xb7, 0x29, 0xf4, 0x82, 0x5b, 0xca, 0x3a, 0xda, 0x2d, 0xee, 0xae, 0xca, 0xca, 0xb5,
+    0xc4, 0x77, 0x96, 0xe4, 0x7f, 0x72, 0x27, 0x89, 0x88, 0xa0, 0xe6, 0xbd, 0xf2, 0xa8, 0x3c, 0x02,
+    0xca, 0xe2, 0x2d, 0xca, 0xa6, 0x43, 0xbc, 0x7c, 0xac, 0xd4, 0x5d, 0xe5, 0x15, 0x35, 0x45, 0x97,
+    0xde, 0x07, 0x72, 0x33, 0x88, 0xff, 0x79, 0x86, 0x42, 0x3f, 0x83, 0x8f, 0x25, 0x3f, 0x30, 0x4c,
+    0xe0, 0xad, 0x0a, 0xf0, 0x21, 0x53, 0x05, 0xa7, 0x80, 0x50, 0x7a, 0x57, 0x94, 0x41, 0xaa, 0xc2,
+    0x56, 0x3b, 0xcd, 0x8f, 0xcf, 0x10, 0x61, 0x2d, 0x3c, 0xb7, 0x88, 0x2b, 0xfa, 0x6c, 0xe4, 0xcd,
+    0xd3, 0xa3, 0x81, 0xa2, 0x30, 0x81, 0x9f, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16,
+    0x04, 0x14, 0x7b, 0xf3, 0x8c, 0x79, 0x9b, 0x7a, 0x4b, 0x2e, 0xbf, 0x41, 0x05, 0x7d, 0xd5, 0xd2,
+    0x6a, 0xeb, 0x5d, 0xa0, 0x40, 0xf3, 0x30, 0x12, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff,
+    0x04, 0x08, 0x30, 0x06, 0x01, 0x01, 0xff, 0x02, 0x01, 0x00, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d,
+    0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d,
+    0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0xcc, 0x69, 0x7a, 0x4a, 0x99, 0x65, 0xfb, 0x80, 0xcc,
+    0x0b, 0x3b, 0x2d, 0x8e, 0xde, 0x93, 0x5e, 0xcb, 0x2a, 0x69, 0x5a, 0x30, 0x39, 0x06, 0x03, 0x55,
+    0x1d, 0x1f, 0x04, 0x32, 0x30, 0x30, 0x30, 0x2e, 0xa0, 0x2c, 0xa0, 0x2a, 0x86, 0x28, 0x68, 0x74,
+    0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x70, 0x6b, 0x69, 0x2e, 0x74, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x73,
+    0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x6c, 0x32, 0x2f, 0x74, 0x30, 0x31,
+    0x76, 0x31, 0x2e, 0x63, 0x72, 0x6c, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04,
+    0x03, 0x03, 0x03, 0x68, 0x00, 0x30, 0x65, 0x02, 0x31, 0x00, 0x8e, 0xea, 0x68, 0xa9, 0xa1, 0x9b,
+    0xbd, 0x69, 0x2c, 0xf0, 0x6d, 0x54, 0x59, 0x3d, 0xce, 0x28, 0x61, 0x43, 0xa3, 0x7d, 0x76, 0x70,
+    0x13, 0x54, 0x25, 0x82, 0x1b, 0xb0, 0x44, 0xd9, 0xf2, 0xdc, 0x78, 0x18, 0x40, 0x45, 0x81, 0x1b,
+    0x30, 0x26, 0x4e, 0x77, 0x72, 0x35, 0x42, 0x2f, 0xdc, 0xeb, 0x02, 0x30, 0x3e, 0x22, 0xa2, 0x99,
+    0xde, 0x91, 0x73, 0x3b, 0xd3, 0xec, 0x3a, 0x95, 0x78, 0xff, 0x6c, 0x7f, 0xc0, 0x19, 0x99, 0xa3,
+    0xa2, 0xc9, 0x8c, 0xe4, 0xad, 0x99, 0x91, 0x0c, 0xc2, 0x3b, 0xb1, 0xc2, 0xfb, 0x61, 0x7b, 0x71,
+    0xa0, 0xc0, 0x67, 0x13, 0x3c, 0x66, 0x79, 0xc0, 0x68, 0x64, 0x78, 0xdf};
+
+/** TROPIC01 CA certificate. */
+static const uint8_t cert_tropic01[] = {
+    0x30, 0x82, 0x02, 0x93, 0x30, 0x82, 0x01, 0xf6, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x02, 0x03,
+    0xe9, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x04, 0x30, 0x54, 0x31,
+    0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x43, 0x5a, 0x31, 0x1d, 0x30, 0x1b,
+    0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x14, 0x54, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71,
+    0x75, 0x61, 0x72, 0x65, 0x20, 0x73, 0x2e, 0x72, 0x2e, 0x6f, 0x2e, 0x31, 0x26, 0x30, 0x24, 0x06,
+    0x03, 0x55, 0x04, 0x03, 0x0c, 0x1d, 0x54, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75,
+    0x61, 0x72, 0x65, 0x20, 0x54, 0x45, 0x53, 0x54, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41,
+    0x20, 0x76, 0x31, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x35, 0x30, 0x33, 0x32, 0x34, 0x31, 0x33, 0x31,
+    0x34, 0x34, 0x32, 0x5a, 0x18, 0x0f, 0x32, 0x30, 0x36, 0x35, 0x30, 0x33, 0x32, 0x34, 0x31, 0x33,
+    0x31, 0x34, 0x34, 0x32, 0x5a, 0x30, 0x4a, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06,
+    0x13, 0x02, 0x43, 0x5a, 0x31, 0x1d, 0x30, 0x1b, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x14, 0x54,
+    0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75, 0x61, 0x72, 0x65, 0x20, 0x73, 0x2e, 0x72,
+    0x2e, 0x6f, 0x2e, 0x31, 0x1c, 0x30, 0x1a, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x13, 0x54, 0x52,
+    0x4f, 0x50, 0x49, 0x43, 0x30, 0x31, 0x20, 0x54, 0x45, 0x53, 0x54, 0x20, 0x43, 0x41, 0x20, 0x76,
+    0x31, 0x30, 0x76, 0x30, 0x10, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x05,
+    0x2b, 0x81, 0x04, 0x00, 0x22, 0x03, 0x62, 0x00, 0x04, 0x76, 0x7a, 0x06, 0xca, 0x5c, 0xda, 0xa1,
+    0xda, 0x5b, 0x81, 0x77, 0xdc, 0x4f, 0x92, 0xd9, 0x6b, 0xdc, 0x6d, 0x34, 0xc8, 0x33, 0xfb, 0xcb,
+    0x67, 0x43, 0x6f, 0xbc, 0x5d, 0xf8, 0x0d, 0xe0, 0x61, 0xb2, 0x91, 0x82, 0x2b, 0x32, 0x82, 0xd9,
+    0xd1, 0x0a, 0x63, 0x3d, 0x6d, 0x5c, 0x39, 0x15, 0xcc, 0xc4, 0x61, 0x8b, 0x01, 0x5d, 0x23, 0x87,
+    0x89, 0x13, 0xd9, 0xd1, 0x2d, 0x50, 0x6d, 0x1d, 0x12, 0xdb, 0x0c, 0x5d, 0xc2, 0x79, 0x66, 0x78,
+    0x74, 0x5f, 0xc6, 0x44, 0xe9, 0x3b, 0x17, 0x41, 0x70, 0x45, 0x16, 0x46, 0x67, 0x70, 0x3f, 0xeb,
+    0xcb, 0x42, 0xb8, 0x6a, 0xb8, 0x8d, 0x81, 0xd8, 0xc4, 0xa3, 0x81, 0xa2, 0x30, 0x81, 0x9f, 0x30,
+    0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0xcc, 0x69, 0x7a, 0x4a, 0x99, 0x65,
+    0xfb, 0x80, 0xcc, 0x0b, 0x3b, 0x2d, 0x8e, 0xde, 0x93, 0x5e, 0xcb, 0x2a, 0x69, 0x5a, 0x30, 0x12,
+    0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x08, 0x30, 0x06, 0x01, 0x01, 0xff, 0x02,
+    0x01, 0x01, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02,
+    0x01, 0x06, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x2e,
+    0x9b, 0xa5, 0x40, 0x34, 0x39, 0x25, 0x34, 0x8a, 0xc6, 0x01, 0x6b, 0xe5, 0x0d, 0x70, 0x2d, 0x78,
+    0x68, 0xb6, 0x88, 0x30, 0x39, 0x06, 0x03, 0x55, 0x1d, 0x1f, 0x04, 0x32, 0x30, 0x30, 0x30, 0x2e,
+    0xa0, 0x2c, 0xa0, 0x2a, 0x86, 0x28, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x70, 0x6b, 0x69,
+    0x2e, 0x74, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x63, 0x6f,
+    0x6d, 0x2f, 0x6c, 0x31, 0x2f, 0x74, 0x73, 0x72, 0x76, 0x31, 0x2e, 0x63, 0x72, 0x6c, 0x30, 0x0a,
+    0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x04, 0x03, 0x81, 0x8a, 0x00, 0x30, 0x81,
+    0x86, 0x02, 0x41, 0x10, 0x0b, 0xa6, 0x8d, 0xf6, 0x0c, 0x0d, 0xa8, 0x12, 0xa1, 0xbf, 0xc8, 0x56,
+    0xe8, 0x75, 0x01, 0x93, 0x18, 0x00, 0xaa, 0x70, 0xfa, 0x0e, 0xe8, 0xde, 0x3f, 0xc3, 0x43, 0x6c,
+    0x99, 0x4f, 0x49, 0x47, 0xae, 0xb5, 0x54, 0x11, 0xb6, 0x3a, 0xc8, 0x5f, 0x35, 0xe3, 0x1a, 0x72,
+    0x8d, 0x23, 0x4d, 0x98, 0xb9, 0xe8, 0x60, 0x36, 0x77, 0x14, 0x08, 0x90, 0x61, 0xd8, 0x6d, 0x34,
+    0xff, 0xb9, 0x88, 0xf9, 0x02, 0x41, 0x35, 0xeb, 0xc4, 0xef, 0x2d, 0x2c, 0x7c, 0xae, 0x46, 0x2d,
+    0x1f, 0x31, 0xf8, 0x4d, 0xc7, 0xf9, 0xd5, 0x80, 0xcd, 0xc6, 0xc8, 0x5b, 0xa0, 0x25, 0xc8, 0x66,
+    0x40, 0x15, 0x3b, 0xfc, 0xf2, 0xfb, 0x62, 0xb2, 0xd3, 0xc7, 0x7e, 0xee, 0xe3, 0x45, 0x47, 0xce,
+    0x7f, 0x51, 0x74, 0x1c, 0x68, 0x13, 0xd2, 0x59, 0x31, 0xd2, 0x79, 0x6d, 0x33, 0xb0, 0x94, 0x04,
+    0xfa, 0xe6, 0xee, 0x3c, 0x19, 0x93, 0x0f};
+
+/** Tropic Square Root CA certificate. */
+static const uint8_t cert_root[] = {
+    0x30, 0x82, 0x02, 0x61, 0x30, 0x82, 0x01, 0xc4, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x01, 0x65,
+    0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x04, 0x30, 0x54, 0x31, 0x0b,
+    0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x43, 0x5a, 0x31, 0x1d, 0x30, 0x1b, 0x06,
+    0x03, 0x55, 0x04, 0x0a, 0x0c, 0x14, 0x54, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75,
+    0x61, 0x72, 0x65, 0x20, 0x73, 0x2e, 0x72, 0x2e, 0x6f, 0x2e, 0x31, 0x26, 0x30, 0x24, 0x06, 0x03,
+    0x55, 0x04, 0x03, 0x0c, 0x1d, 0x54, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75, 0x61,
+    0x72, 0x65, 0x20, 0x54, 0x45, 0x53, 0x54, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20,
+    0x76, 0x31, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x35, 0x30, 0x33, 0x32, 0x34, 0x31, 0x33, 0x31, 0x34,
+    0x33, 0x38, 0x5a, 0x18, 0x0f, 0x32, 0x30, 0x37, 0x35, 0x30, 0x33, 0x32, 0x34, 0x31, 0x33, 0x31,
+    0x34, 0x33, 0x38, 0x5a, 0x30, 0x54, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13,
+    0x02, 0x43, 0x5a, 0x31, 0x1d, 0x30, 0x1b, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x14, 0x54, 0x72,
+    0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75, 0x61, 0x72, 0x65, 0x20, 0x73, 0x2e, 0x72, 0x2e,
+    0x6f, 0x2e, 0x31, 0x26, 0x30, 0x24, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x1d, 0x54, 0x72, 0x6f,
+    0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75, 0x61, 0x72, 0x65, 0x20, 0x54, 0x45, 0x53, 0x54, 0x20,
+    0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x20, 0x76, 0x31, 0x30, 0x81, 0x9b, 0x30, 0x10, 0x06,
+    0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x05, 0x2b, 0x81, 0x04, 0x00, 0x23, 0x03,
+    0x81, 0x86, 0x00, 0x04, 0x01, 0x35, 0xc7, 0xa2, 0x4d, 0x16, 0xb3, 0x74, 0xb2, 0x07, 0xad, 0xe8,
+    0xfe, 0x50, 0xf5, 0x03, 0xad, 0x34, 0xe0, 0xe5, 0x96, 0xc8, 0x3f, 0xc9, 0x8a, 0xdb, 0x4c, 0x43,
+    0x88, 0xca, 0x0a, 0xd9, 0xb2, 0x4e, 0x77, 0xe9, 0x84, 0xb8, 0x97, 0x82, 0x53, 0xa8, 0xe0, 0xd6,
+    0xfd, 0x68, 0xea, 0xa8, 0xd9, 0xc9, 0xa9, 0xa6, 0xc8, 0x83, 0x5a, 0x13, 0x8c, 0xcc, 0xff, 0x51,
+    0x13, 0x0d, 0xa1, 0x09, 0x86, 0x80, 0x00, 0xcd, 0xf7, 0xfa, 0xd5, 0xa0, 0x2b, 0xbd, 0x84, 0x45,
+    0x3c, 0x56, 0x36, 0xf2, 0x5f, 0x1c, 0x39, 0x5b, 0xdc, 0x22, 0xee, 0x7b, 0x44, 0x1a, 0x81, 0xb5,
+    0x9f, 0x20, 0x40, 0x53, 0x89, 0xf4, 0x7d, 0x65, 0xf0, 0x74, 0xa6, 0x02, 0xf9, 0x33, 0x2d, 0xf1,
+    0x33, 0x79, 0xf2, 0x7d, 0x65, 0x4f, 0x4e, 0x1b, 0x0f, 0xd4, 0x56, 0xc1, 0xa9, 0x9f, 0x54, 0x36,
+    0x64, 0x0f, 0x7e, 0xe0, 0x4e, 0x1b, 0x48, 0x81, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x1d, 0x06, 0x03,
+    0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x2e, 0x9b, 0xa5, 0x40, 0x34, 0x39, 0x25, 0x34, 0x8a,
+    0xc6, 0x01, 0x6b, 0xe5, 0x0d, 0x70, 0x2d, 0x78, 0x68, 0xb6, 0x88, 0x30, 0x0f, 0x06, 0x03, 0x55,
+    0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06, 0x03,
+    0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x0a, 0x06, 0x08,
+    0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x04, 0x03, 0x81, 0x8a, 0x00, 0x30, 0x81, 0x86, 0x02,
+    0x41, 0x6a, 0x2d, 0x9d, 0x72, 0xb4, 0x35, 0x30, 0x35, 0x72, 0x5e, 0x9d, 0x60, 0x7f, 0x62, 0xf9,
+    0x27, 0xe8, 0x87, 0xb6, 0x07, 0xc9, 0xfe, 0x7f, 0xd7, 0xbd, 0xdf, 0x00, 0xa4, 0xd9, 0x4b, 0x5d,
+    0x57, 0xf3, 0xc9, 0x37, 0x70, 0xa2, 0xbe, 0x25, 0xc1, 0x3f, 0x59, 0xee, 0x9f, 0x41, 0x97, 0x17,
+    0x9f, 0x94, 0x06, 0xec, 0x2a, 0x8c, 0xea, 0xb1, 0xd5, 0x19, 0x05, 0x47, 0xec, 0x24, 0x48, 0x6f,
+    0x8b, 0x95, 0x02, 0x41, 0x3c, 0x0a, 0x74, 0xa1, 0x61, 0x3b, 0xd5, 0xdb, 0x29, 0xf5, 0x8e, 0xa4,
+    0xc7, 0x92, 0xcf, 0xfe, 0x01, 0xe0, 0xbe, 0x5c, 0x28, 0x22, 0x24, 0xe7, 0xff, 0x93, 0xf5, 0x12,
+    0x58, 0xa5, 0xf2, 0x2e, 0x3b, 0xa4, 0xa1, 0x83, 0xe8, 0x82, 0xa5, 0xc5, 0x4f, 0x5c, 0x39, 0xce,
+    0x14, 0x02, 0xd1, 0xb2, 0x67, 0x4c, 0xc3, 0x4a, 0x41, 0x82, 0xea, 0xf0, 0x61, 0xc4, 0xf6, 0x6e,
+    0x30, 0xe9, 0x68, 0x32, 0x12};
+
+/** SHA-256 of the root certificate. */
+static const uint8_t root_hash[] = {
+    0x71, 0x75, 0xc7, 0x09, 0x79, 0x05, 0xf3, 0x4f, 0x7e, 0x60, 0x56, 0x07, 0x6c, 0x3e, 0x9b, 0xe8,
+    0xc5, 0xc6, 0x98, 0x6f, 0x98, 0x74, 0xfd, 0xaf, 0x73, 0x8d, 0x4b, 0x68, 0x85, 0xeb, 0x3f, 0xe3};
+
+/** Stands in for the application's signature verification, records the requested verifications. */
+struct test_verifier_t {
+    lt_ret_t result;
+    int calls;
+    lt_cert_sig_alg_t last_alg;
+    uint16_t last_pubkey_len;
+};
+
+static lt_ret_t test_verify(const lt_cert_sig_t *sig, void *ctx)
+{
+    struct test_verifier_t *v = ctx;
+
+    v->calls++;
+    v->last_alg = sig->alg;
+    v->last_pubkey_len = sig->pubkey_len;
+
+    return v->result;
+}
+#endif
+
+void lt_test_mock_cert_chain(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_cert_chain()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_CERT_CHAIN
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_CERT_CHAIN is not enabled, skipping.");
+#else
+    uint8_t *certs[LT_NUM_CERTIFICATES]
+        = {(uint8_t *)cert_device, (uint8_t *)cert_xxxx, (uint8_t *)cert_tropic01, (uint8_t *)cert_root};
+    struct lt_cert_store_t store = {
+        .certs = {certs[0], certs[1], certs[2], certs[3]},
+        .buf_len = {sizeof(cert_device), sizeof(cert_xxxx), sizeof(cert_tropic01), sizeof(cert_root)},
+        .cert_len = {sizeof(cert_device), sizeof(cert_xxxx), sizeof(cert_tropic01), sizeof(cert_root)},
+    };
+    struct test_verifier_t verifier = {.result = LT_OK};
+    lt_cert_chain_t chain;
+
+    LT_LOG_INFO("Verifying the chain for the first time, all 3 signatures have to be verified...");
+    LT_TEST_ASSERT(LT_OK, lt_cert_chain_init(&chain, root_hash));
+    LT_TEST_ASSERT(LT_OK, lt_cert_chain_verify(h, &chain, &store, test_verify, &verifier));
+    LT_TEST_ASSERT(3, verifier.calls);
+    LT_TEST_ASSERT(0, (int)chain.memo_hits);
+    // Device certificate is verified last, by the P-384 key of TROPIC01-X CA.
+    LT_TEST_ASSERT(LT_CERT_SIG_ECDSA_SHA384, verifier.last_alg);
+    LT_TEST_ASSERT(97, verifier.last_pubkey_len);
+
+    LT_LOG_INFO("Verifying the chain again, only the device certificate has to be verified...");
+    verifier.calls = 0;
+    LT_TEST_ASSERT(LT_OK, lt_cert_chain_verify(h, &chain, &store, test_verify, &verifier));
+    LT_TEST_ASSERT(1, verifier.calls);
+    LT_TEST_ASSERT(2, (int)chain.memo_hits);
+
+    LT_LOG_INFO("Verifying the chain with invalid device certificate signature...");
+    verifier.result = LT_FAIL;
+    LT_TEST_ASSERT(LT_CERT_CHAIN_INVALID, lt_cert_chain_verify(h, &chain, &store, test_verify, &verifier));
+
+    LT_LOG_INFO("Verifying the chain against another root, no signature has to be verified...");
+    uint8_t other_root_hash[LT_CERT_CHAIN_HASH_LEN];
+    memcpy(other_root_hash, root_hash, sizeof(other_root_hash));
+    other_root_hash[0] ^= 0x01;
+    verifier.result = LT_OK;
+    verifier.calls = 0;
+    LT_TEST_ASSERT(LT_OK, lt_cert_chain_init(&chain, other_root_hash));
+    LT_TEST_ASSERT(LT_CERT_CHAIN_INVALID, lt_cert_chain_verify(h, &chain, &store, test_verify, &verifier));
+    LT_TEST_ASSERT(0, verifier.calls);
+#endif
+}
@@ -0,0 +1,99 @@
+/**
+ * @file lt_test_mock_cert_stream.c
+ * @brief Test streamed parsing of STPUB from the certificate store.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+/** Length of one Get_Info block of the certificate store. */
+#define CERT_STORE_BLOCK_LEN 128
+
+/** Length of the certificate store header: version, number of certificates and their 16-bit lengths. */
+#define CERT_STORE_HEADER_LEN (2 + 2 * LT_NUM_CERTIFICATES)
+
+/** Length of the device certificate in the mocked certificate store. */
+#define DEVICE_CERT_LEN 479
+
+/** Beginning of a production device certificate, up to and including STPUB. The rest is never read. */
+static const uint8_t device_cert_head[] = {
+    0x30, 0x82, 0x01, 0xdb, 0x30, 0x82, 0x01, 0x62, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x10, 0x02,
+    0xf0, 0x02, 0x00, 0x08, 0x82, 0x19, 0x06, 0x1b, 0x09, 0x33, 0x00, 0x00, 0x04, 0x00, 0x09, 0x30,
+    0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x03, 0x30, 0x4c, 0x31, 0x0b, 0x30,
+    0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x43, 0x5a, 0x31, 0x1d, 0x30, 0x1b, 0x06, 0x03,
+    0x55, 0x04, 0x0a, 0x0c, 0x14, 0x54, 0x72, 0x6f, 0x70, 0x69, 0x63, 0x20, 0x53, 0x71, 0x75, 0x61,
+    0x72, 0x65, 0x20, 0x73, 0x2e, 0x72, 0x2e, 0x6f, 0x2e, 0x31, 0x1e, 0x30, 0x1c, 0x06, 0x03, 0x55,
+    0x04, 0x03, 0x0c, 0x15, 0x54, 0x52, 0x4f, 0x50, 0x49, 0x43, 0x30, 0x31, 0x2d, 0x58, 0x20, 0x54,
+    0x45, 0x53, 0x54, 0x20, 0x43, 0x41, 0x20, 0x76, 0x31, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x35, 0x30,
+    0x36, 0x32, 0x37, 0x30, 0x38, 0x34, 0x30, 0x35, 0x35, 0x5a, 0x17, 0x0d, 0x34, 0x35, 0x30, 0x36,
+    0x32, 0x37, 0x30, 0x38, 0x34, 0x30, 0x35, 0x35, 0x5a, 0x30, 0x1c, 0x31, 0x1a, 0x30, 0x18, 0x06,
+    0x03, 0x55, 0x04, 0x03, 0x0c, 0x11, 0x54, 0x52, 0x4f, 0x50, 0x49, 0x43, 0x30, 0x31, 0x20, 0x65,
+    0x53, 0x45, 0x20, 0x54, 0x45, 0x53, 0x54, 0x30, 0x2a, 0x30, 0x05, 0x06, 0x03, 0x2b, 0x65, 0x6e,
+    0x03, 0x21, 0x00, 0x95, 0x08, 0xf0, 0x32, 0x1c, 0xb1, 0xd2, 0xe5, 0xd1, 0xf1, 0xa4, 0x60, 0x9c,
+    0x05, 0x41, 0xb7, 0x80, 0xe6, 0xdd, 0x50, 0xd6, 0x48, 0x2b, 0x6b, 0x08, 0xb2, 0xc2, 0x7e, 0x7b,
+    0x76, 0x26, 0x47, 0xa3, 0x81, 0x84, 0x30, 0x81, 0x81, 0x30, 0x0c, 0x06, 0x03, 0x55, 0x1d, 0x13,
+    0x01, 0x01, 0xff, 0x04, 0x02, 0x30,
+};
+
+/** STPUB of the device certificate. */
+static const uint8_t device_cert_stpub[TR01_STPUB_LEN]
+    = {0x95, 0x08, 0xf0, 0x32, 0x1c, 0xb1, 0xd2, 0xe5, 0xd1, 0xf1, 0xa4, 0x60, 0x9c, 0x05, 0x41, 0xb7,
+       0x80, 0xe6, 0xdd, 0x50, 0xd6, 0x48, 0x2b, 0x6b, 0x08, 0xb2, 0xc2, 0x7e, 0x7b, 0x76, 0x26, 0x47};
+
+void lt_test_mock_cert_stream(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_cert_stream()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    // Header (version, number of certificates, their lengths) followed by the device certificate.
+    uint8_t store[2 * CERT_STORE_BLOCK_LEN] = {0};
+    const uint8_t header[CERT_STORE_HEADER_LEN]
+        = {LT_CERT_STORE_VERSION, LT_NUM_CERTIFICATES, DEVICE_CERT_LEN >> 8, DEVICE_CERT_LEN & 0xff,
+           0x02, 0x00, 0x02, 0x00, 0x02, 0x00};
+    memcpy(store, header, sizeof(header));
+    memcpy(store + sizeof(header), device_cert_head, sizeof(device_cert_head));
+
+    LT_LOG_INFO("Mocking only the first 2 blocks of the certificate store...");
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    for (int i = 0; i < 2; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+        struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                     .status = TR01_L2_STATUS_REQUEST_OK,
+                                                     .rsp_len = CERT_STORE_BLOCK_LEN};
+        memcpy(get_info_resp.object, store + i * CERT_STORE_BLOCK_LEN, CERT_STORE_BLOCK_LEN);
+        add_resp_crc(&get_info_resp);
+        LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp,
+                                                           calc_mocked_resp_len(&get_info_resp)));
+    }
+
+    LT_LOG_INFO("Reading STPUB, reading has to stop right after it...");
+    uint8_t stpub[TR01_STPUB_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_get_info_st_pub(h, stpub));
+    LT_TEST_ASSERT(0, memcmp(stpub, device_cert_stpub, sizeof(stpub)));
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+}
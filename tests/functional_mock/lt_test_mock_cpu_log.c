@@ -0,0 +1,125 @@
+/**
+ * @file lt_test_mock_cpu_log.c
+ * @brief Test drain of the log of TROPIC01's RISC-V FW into the CPU log (LT_CPU_LOG_DRAIN).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_CPU_LOG_DRAIN
+/** Size of the ring buffer of the test, smallest one allowed. */
+#define CPU_LOG_TEST_SIZE 512
+
+/** Mocks Get_Log response with the message. */
+static lt_ret_t cpu_log_test_mock_get_log(lt_handle_t *h, const char *msg, const uint8_t len)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_get_log_rsp_t get_log_resp
+        = {.chip_status = TR01_L1_CHIP_MODE_READY_bit, .status = TR01_L2_STATUS_REQUEST_OK, .rsp_len = len};
+    memcpy(get_log_resp.log_msg, msg, len);
+    add_resp_crc(&get_log_resp);
+
+    lt_ret_t ret = lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_log_resp, calc_mocked_resp_len(&get_log_resp));
+}
+#endif
+
+void lt_test_mock_cpu_log(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_cpu_log()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_CPU_LOG_DRAIN
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_CPU_LOG_DRAIN is not enabled, skipping.");
+#else
+    lt_cpu_log_t log;
+    uint8_t log_buff[CPU_LOG_TEST_SIZE];
+    uint8_t out[CPU_LOG_TEST_SIZE];
+    uint8_t long_msg[TR01_L2_CHUNK_MAX_DATA_SIZE];
+    bool done;
+
+    LT_LOG_INFO("Checking parameters...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_cpu_log_init(&log, log_buff, CPU_LOG_TEST_SIZE / 2));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_cpu_log_init(&log, log_buff, CPU_LOG_TEST_SIZE - 1));
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_init(&log, log_buff, CPU_LOG_TEST_SIZE));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_cpu_log_attach(NULL, &log));
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_attach(h, &log));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_cpu_log_drain_step(h, NULL, &done));
+    LT_TEST_ASSERT(0, (int)lt_cpu_log_read(&log, out, sizeof(out)));
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+
+    LT_LOG_INFO("Draining two messages, one Get_Log_Req per step until TROPIC01 has no message...");
+    LT_TEST_ASSERT(LT_OK, cpu_log_test_mock_get_log(h, "Hello\n", 6));
+    LT_TEST_ASSERT(LT_OK, cpu_log_test_mock_get_log(h, "World\n", 6));
+    LT_TEST_ASSERT(LT_OK, cpu_log_test_mock_get_log(h, "", 0));
+    done = true;
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_drain_step(h, &log, &done));
+    LT_TEST_ASSERT(0, done);
+    done = true;
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_drain_step(h, &log, &done));
+    LT_TEST_ASSERT(0, done);
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_drain_step(h, &log, &done));
+    LT_TEST_ASSERT(1, done);
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(12, (int)lt_cpu_log_read(&log, out, sizeof(out)));
+    LT_TEST_ASSERT(0, memcmp(out, "Hello\nWorld\n", 12));
+
+    LT_LOG_INFO("Printing the log in slices...");
+    LT_TEST_ASSERT(LT_OK, cpu_log_test_mock_get_log(h, "Print me\n", 9));
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_drain_step(h, &log, &done));
+    LT_TEST_ASSERT(3, (int)lt_cpu_log_print(&log, 3));
+    LT_TEST_ASSERT(6, (int)lt_cpu_log_print(&log, 100));
+    LT_TEST_ASSERT(0, (int)lt_cpu_log_print(&log, 100));
+
+    LT_LOG_INFO("Draining with no space for the longest message, nothing has to be sent...");
+    memset(long_msg, 'x', sizeof(long_msg));
+    LT_TEST_ASSERT(LT_OK, cpu_log_test_mock_get_log(h, (const char *)long_msg, sizeof(long_msg)));
+    LT_TEST_ASSERT(LT_OK, cpu_log_test_mock_get_log(h, (const char *)long_msg, sizeof(long_msg)));
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_drain_step(h, &log, &done));
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_drain_step(h, &log, &done));
+    done = false;
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_drain_step(h, &log, &done));
+    LT_TEST_ASSERT(1, done);
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(0, (int)lt_cpu_log_dropped(&log));
+
+    LT_LOG_INFO("Reading the messages wrapped around the end of the ring buffer...");
+    LT_TEST_ASSERT(2 * sizeof(long_msg), lt_cpu_log_read(&log, out, sizeof(out)));
+    LT_TEST_ASSERT(0, memcmp(out, long_msg, sizeof(long_msg)));
+    LT_TEST_ASSERT(0, memcmp(out + sizeof(long_msg), long_msg, sizeof(long_msg)));
+
+    LT_TEST_ASSERT(LT_OK, lt_cpu_log_attach(h, NULL));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
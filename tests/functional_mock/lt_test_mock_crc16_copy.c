@@ -0,0 +1,62 @@
+/**
+ * @file lt_test_mock_crc16_copy.c
+ * @brief Test copying of L2 data in the same pass as their CRC16 is calculated.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_crc16.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_crc16_copy(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_crc16_copy()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    LT_UNUSED(h);
+    uint8_t src[TR01_L2_CHUNK_MAX_DATA_SIZE + 3];
+    uint8_t dst[sizeof(src)];
+    for (size_t i = 0; i < sizeof(src); i++) {
+        src[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    LT_LOG_INFO("Checking copy with CRC16 calculation against crc16_update()...");
+    const uint16_t lens[] = {0, 1, 3, 4, 7, 8, 9, sizeof(src) - 1, sizeof(src)};
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        memset(dst, 0, sizeof(dst));
+        LT_TEST_ASSERT(crc16_update(0x1234, src, lens[i]), crc16_copy_update(0x1234, dst, src, lens[i]));
+        LT_TEST_ASSERT(0, memcmp(dst, src, lens[i]));
+        if (lens[i] < sizeof(dst)) {
+            LT_TEST_ASSERT(0, dst[lens[i]]);
+        }
+    }
+
+    LT_LOG_INFO("Checking frame check with copy of RSP_DATA...");
+    uint8_t frame[TR01_L1_LEN_MAX] = {TR01_L1_CHIP_MODE_READY_bit, TR01_L2_STATUS_RESULT_OK, 100};
+    memcpy(frame + 3, src, frame[2]);
+    uint16_t crc = crc16(frame + 1, frame[2] + 2);
+    frame[frame[2] + 3] = crc >> 8;
+    frame[frame[2] + 4] = crc & 0x00FF;
+    memset(dst, 0, sizeof(dst));
+    LT_TEST_ASSERT(LT_OK, lt_l2_frame_check_copy(frame, dst));
+    LT_TEST_ASSERT(0, memcmp(dst, src, frame[2]));
+    LT_TEST_ASSERT(0, dst[frame[2]]);
+    frame[50] ^= 0x01;
+    LT_TEST_ASSERT(LT_L2_IN_CRC_ERR, lt_l2_frame_check_copy(frame, dst));
+    frame[1] = TR01_L2_STATUS_RESULT_CONT;
+    memset(dst, 0, sizeof(dst));
+    LT_TEST_ASSERT(LT_L2_RES_CONT, lt_l2_frame_check_copy(frame, dst));
+    LT_TEST_ASSERT(0, memcmp(dst, frame + 3, frame[2]));
+}
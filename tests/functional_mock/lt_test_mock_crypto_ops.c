@@ -0,0 +1,137 @@
+/**
+ * @file lt_test_mock_crypto_ops.c
+ * @brief Test CAL selected at runtime through function tables (LT_CRYPTO_OPS).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+#ifdef LT_CRYPTO_OPS
+#include "libtropic_trezor_crypto.h"
+
+/** Broken X25519, the public key it computes is all zeros. */
+static lt_ret_t broken_X25519_scalarmult(const uint8_t *sk, uint8_t *pk)
+{
+    LT_UNUSED(sk);
+    memset(pk, 0, TR01_X25519_KEY_LEN);
+    return LT_OK;
+}
+
+/** Starts a mocked Secure Session with the CAL selected for the handle and pings through it. */
+static void crypto_ops_ping(lt_handle_t *h)
+{
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    uint8_t ping_res[TR01_L3_RESULT_SIZE + 32] = {TR01_L3_RESULT_OK};
+    uint8_t ping_in[32] = {0};
+
+    lt_mock_hal_reset(&h->l2);
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, sizeof(kres));
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, ping_res + TR01_L3_RESULT_SIZE, sizeof(ping_in)));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_ping(h, ping_res + TR01_L3_RESULT_SIZE, ping_in, sizeof(ping_in)));
+    LT_TEST_ASSERT(0, memcmp(ping_res + TR01_L3_RESULT_SIZE, ping_in, sizeof(ping_in)));
+
+#ifdef LT_L3_STREAM_DECRYPT
+    // Random bytes are decrypted by the streaming AES-GCM of the CAL, after RESULT and 3B of padding.
+    uint8_t rnd_res[TR01_L3_RESULT_SIZE + 3 + 32] = {TR01_L3_RESULT_OK};
+    uint8_t rnd[32];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, rnd_res + TR01_L3_RESULT_SIZE + 3, sizeof(rnd)));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, rnd_res, sizeof(rnd_res)));
+    LT_TEST_ASSERT(LT_OK, lt_random_value_get(h, rnd, sizeof(rnd)));
+    LT_TEST_ASSERT(0, memcmp(rnd_res + TR01_L3_RESULT_SIZE + 3, rnd, sizeof(rnd)));
+#endif
+
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+}
+#endif
+
+void lt_test_mock_crypto_ops(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_crypto_ops()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_CRYPTO_OPS
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_CRYPTO_OPS is not enabled, skipping.");
+#else
+    lt_crypto_ops_ctx_t *c = h->l3.crypto_ctx;
+    lt_ctx_trezor_crypto_t trezor_ctx = {0};
+    lt_ctx_trezor_crypto_t broken_ctx = {0};
+    lt_crypto_ops_t broken_ops = lt_crypto_ops_trezor_crypto;
+    broken_ops.name = "broken";
+    broken_ops.X25519_scalarmult = broken_X25519_scalarmult;
+
+    // CAL set up by main(), Trezor crypto CAL and a CAL which does not work.
+    lt_crypto_backend_t backends[] = {{.ops = c->ops, .ctx = c->ctx, .probe_us = 0},
+                                      {.ops = &lt_crypto_ops_trezor_crypto, .ctx = &trezor_ctx, .probe_us = 0},
+                                      {.ops = &broken_ops, .ctx = &broken_ctx, .probe_us = 0}};
+    lt_crypto_backend_t initial = backends[0];
+
+    LT_LOG_INFO("Verifying parameter checks...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_crypto_ops_set(NULL, initial.ops, initial.ctx));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_crypto_ops_set(c, NULL, initial.ctx));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_crypto_ops_set(c, initial.ops, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_crypto_ops_probe(NULL, backends, 3));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_crypto_ops_probe(c, NULL, 3));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_crypto_ops_probe(c, backends, 0));
+    backends[1].ctx = NULL;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_crypto_ops_probe(c, backends, 3));
+    backends[1].ctx = &trezor_ctx;
+    LT_TEST_ASSERT(1, c->ops == initial.ops);
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_crypto_ops_set_global(NULL));
+
+    LT_LOG_INFO("Verifying the process-wide CAL is selected once...");
+    // The CAL set up by main() was selected first.
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ops_set_global(initial.ops));
+    LT_TEST_ASSERT(LT_FAIL, lt_crypto_ops_set_global(&lt_crypto_ops_trezor_crypto));
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ops_set(c, &lt_crypto_ops_trezor_crypto, &trezor_ctx));
+    LT_TEST_ASSERT(LT_FAIL, lt_crypto_ops_set_global(&lt_crypto_ops_trezor_crypto));
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ops_set(c, initial.ops, initial.ctx));
+
+    LT_LOG_INFO("Probing CALs, the fastest working one is selected...");
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ops_probe(c, backends, 3));
+    LT_LOG_INFO("%s: %" PRIu32 " us, %s: %" PRIu32 " us", backends[0].ops->name, backends[0].probe_us,
+                backends[1].ops->name, backends[1].probe_us);
+    LT_TEST_ASSERT(1, backends[0].probe_us > 0);
+    LT_TEST_ASSERT(1, backends[1].probe_us > 0);
+    LT_TEST_ASSERT(0, backends[2].probe_us);
+    size_t fastest = (backends[1].probe_us < backends[0].probe_us) ? 1 : 0;
+    LT_TEST_ASSERT(1, c->ops == backends[fastest].ops);
+    LT_TEST_ASSERT(1, c->ctx == backends[fastest].ctx);
+
+    LT_LOG_INFO("Verifying no CAL is selected if none of them works...");
+    LT_TEST_ASSERT(LT_CRYPTO_ERR, lt_crypto_ops_probe(c, &backends[2], 1));
+    LT_TEST_ASSERT(0, backends[2].probe_us);
+    LT_TEST_ASSERT(1, c->ops == backends[fastest].ops);
+
+    for (size_t i = 0; i < 2; i++) {
+        LT_LOG_INFO("Running Secure Session with %s CAL...", backends[i].ops->name);
+        LT_TEST_ASSERT(LT_OK, lt_crypto_ops_set(c, backends[i].ops, backends[i].ctx));
+        crypto_ops_ping(h);
+    }
+
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ops_set(c, initial.ops, initial.ctx));
+#endif
+}
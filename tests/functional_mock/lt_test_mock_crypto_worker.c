@@ -0,0 +1,203 @@
+/**
+ * @file lt_test_mock_crypto_worker.c
+ * @brief Test offload of AES-GCM of the signing queue to a crypto worker (LT_CRYPTO_WORKER).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_CRYPTO_WORKER
+/** Number of jobs executed with the deferred worker. */
+#define CRYPTO_WORKER_TEST_JOBS 3
+/** Number of jobs executed with the worker refusing all works. */
+#define CRYPTO_WORKER_TEST_INLINE_JOBS 2
+/** Max number of rounds of the deferred worker and lt_sign_queue_process(). */
+#define CRYPTO_WORKER_TEST_MAX_ROUNDS 100
+
+/** Worker keeping the works until the test executes them, refuses all works if disabled. */
+struct crypto_worker_test_t {
+    lt_crypto_work_t *works[2];
+    int cnt;
+    int submitted;
+    int enabled;
+};
+
+/** Result of one job. */
+struct crypto_worker_test_job_t {
+    int calls;
+    lt_ret_t ret;
+    uint8_t rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+};
+
+static lt_ret_t crypto_worker_test_submit(void *worker_ctx, lt_crypto_work_t *work)
+{
+    struct crypto_worker_test_t *w = (struct crypto_worker_test_t *)worker_ctx;
+
+    w->submitted++;
+    if (!w->enabled || (w->cnt == (int)(sizeof(w->works) / sizeof(w->works[0])))) {
+        return LT_FAIL;
+    }
+    w->works[w->cnt++] = work;
+
+    return LT_OK;
+}
+
+/** Executes the kept works as another thread would. */
+static void crypto_worker_test_run(struct crypto_worker_test_t *w)
+{
+    for (int i = 0; i < w->cnt; i++) {
+        lt_crypto_work_run(w->works[i]);
+    }
+    w->cnt = 0;
+}
+
+static void crypto_worker_test_cb(lt_ret_t ret, const uint8_t *rs, void *cb_ctx)
+{
+    struct crypto_worker_test_job_t *job = (struct crypto_worker_test_job_t *)cb_ctx;
+
+    job->calls++;
+    job->ret = ret;
+    if (rs) {
+        memcpy(job->rs, rs, sizeof(job->rs));
+    }
+}
+
+/** Mocks L3 Command acknowledgement and signature of the job, encrypted with the decryption nonce of the job. */
+static void crypto_worker_test_mock_job(lt_handle_t *h, const uint8_t nonce)
+{
+    struct lt_l3_ecdsa_sign_res_t res;
+    uint8_t iv[TR01_L3_IV_SIZE];
+
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    memset(res.r, 0x10 + nonce, sizeof(res.r));
+    memset(res.s, 0x20 + nonce, sizeof(res.s));
+
+    memcpy(iv, h->l3.decryption_IV, sizeof(iv));
+    h->l3.decryption_IV[0] = nonce;
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, &res.result, TR01_L3_ECDSA_SIGN_RES_SIZE));
+    memcpy(h->l3.decryption_IV, iv, sizeof(iv));
+}
+
+/** Checks the job finished with the signature mocked for its nonce. */
+static void crypto_worker_test_check(const struct crypto_worker_test_job_t *job, const uint8_t nonce)
+{
+    LT_TEST_ASSERT(1, job->calls);
+    LT_TEST_ASSERT(LT_OK, job->ret);
+    LT_TEST_ASSERT(0x10 + nonce, job->rs[0]);
+    LT_TEST_ASSERT(0x20 + nonce, job->rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH - 1]);
+}
+#endif
+
+void lt_test_mock_crypto_worker(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_crypto_worker()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_CRYPTO_WORKER
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_CRYPTO_WORKER is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    LT_LOG_INFO("Mocking ECDSA_Sign results...");
+    for (uint8_t i = 0; i < CRYPTO_WORKER_TEST_JOBS + CRYPTO_WORKER_TEST_INLINE_JOBS; i++) {
+        crypto_worker_test_mock_job(h, i);
+    }
+
+    LT_LOG_INFO("Setting up the queue with a deferred crypto worker...");
+    lt_l2_async_t op;
+    memset(&op, 0, sizeof(op));
+    lt_sign_queue_t q;
+    struct crypto_worker_test_t worker;
+    memset(&worker, 0, sizeof(worker));
+    worker.enabled = 1;
+    struct crypto_worker_test_job_t jobs[CRYPTO_WORKER_TEST_JOBS + CRYPTO_WORKER_TEST_INLINE_JOBS];
+    memset(jobs, 0, sizeof(jobs));
+    uint8_t digest[LT_SIGN_QUEUE_DIGEST_LEN] = {0};
+
+    LT_TEST_ASSERT(LT_OK, lt_sign_queue_init(&q));
+    LT_TEST_ASSERT(LT_OK, lt_sign_queue_add_device(&q, h, &op));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_sign_queue_set_crypto_worker(NULL, crypto_worker_test_submit, &worker));
+    LT_TEST_ASSERT(LT_OK, lt_sign_queue_set_crypto_worker(&q, crypto_worker_test_submit, &worker));
+
+    LT_LOG_INFO("Submitting jobs, the first command is handed to the worker...");
+    for (uint8_t i = 0; i < CRYPTO_WORKER_TEST_JOBS; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_sign_queue_submit(&q, TR01_ECC_SLOT_0 + i, digest, crypto_worker_test_cb, &jobs[i]));
+    }
+    LT_TEST_ASSERT(CRYPTO_WORKER_TEST_JOBS, lt_sign_queue_pending(&q));
+    LT_TEST_ASSERT(1, worker.cnt);
+    LT_TEST_ASSERT(0, h->l3.encryption_IV[0]);
+    LT_TEST_ASSERT(0, lt_l2_async_busy(&op));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_sign_queue_set_crypto_worker(&q, NULL, NULL));
+
+    LT_LOG_INFO("Verifying the first command is sent while the worker encrypts the second one...");
+    crypto_worker_test_run(&worker);
+    LT_TEST_ASSERT(1, h->l3.encryption_IV[0]);
+    LT_TEST_ASSERT(LT_OK, lt_sign_queue_process(&q));
+    LT_TEST_ASSERT(1, lt_l2_async_busy(&op));
+    LT_TEST_ASSERT(1, worker.cnt);
+    LT_TEST_ASSERT(2, worker.submitted);
+
+    LT_LOG_INFO("Running the worker and the queue...");
+    for (int i = 0; (i < CRYPTO_WORKER_TEST_MAX_ROUNDS) && lt_sign_queue_pending(&q); i++) {
+        crypto_worker_test_run(&worker);
+        LT_TEST_ASSERT(LT_OK, lt_sign_queue_process(&q));
+    }
+    LT_TEST_ASSERT(0, lt_sign_queue_pending(&q));
+    LT_TEST_ASSERT(0, worker.cnt);
+    // Each job is encrypted and decrypted by the worker.
+    LT_TEST_ASSERT(2 * CRYPTO_WORKER_TEST_JOBS, worker.submitted);
+    for (uint8_t i = 0; i < CRYPTO_WORKER_TEST_JOBS; i++) {
+        crypto_worker_test_check(&jobs[i], i);
+    }
+    LT_TEST_ASSERT(CRYPTO_WORKER_TEST_JOBS, h->l3.encryption_IV[0]);
+    LT_TEST_ASSERT(CRYPTO_WORKER_TEST_JOBS, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Running jobs refused by the worker, they are done by the queue itself...");
+    worker.enabled = 0;
+    for (uint8_t i = CRYPTO_WORKER_TEST_JOBS; i < CRYPTO_WORKER_TEST_JOBS + CRYPTO_WORKER_TEST_INLINE_JOBS; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_sign_queue_submit(&q, TR01_ECC_SLOT_0 + i, digest, crypto_worker_test_cb, &jobs[i]));
+    }
+    LT_TEST_ASSERT(LT_OK, lt_sign_queue_run(&q));
+    LT_TEST_ASSERT(0, lt_sign_queue_pending(&q));
+    for (uint8_t i = CRYPTO_WORKER_TEST_JOBS; i < CRYPTO_WORKER_TEST_JOBS + CRYPTO_WORKER_TEST_INLINE_JOBS; i++) {
+        crypto_worker_test_check(&jobs[i], i);
+    }
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+
+    LT_LOG_INFO("Terminating the Secure Session...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,109 @@
+/**
+ * @file lt_test_mock_deadline.c
+ * @brief Test deadline of the API calls (LT_DEADLINE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_DEADLINE
+/** Deadline shorter than the delay between two CHIP_STATUS polls [us]. */
+#define DEADLINE_SHORT_US ((LT_L1_READ_RETRY_DELAY / 2) * 1000)
+/** Deadline long enough for a mocked request [us]. */
+#define DEADLINE_LONG_US 1000000
+
+/** Mocks reply to Get_Info with the RISC-V FW version. */
+static void deadline_mock_get_info(lt_handle_t *h, struct lt_l2_get_info_rsp_t *rsp)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+
+    *rsp = (struct lt_l2_get_info_rsp_t){.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                         .status = TR01_L2_STATUS_REQUEST_OK,
+                                         .rsp_len = TR01_L2_GET_INFO_RISCV_FW_SIZE,
+                                         .object = {0x00, 0x00, 0x00, 0x02}};
+    add_resp_crc(rsp);
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)rsp, calc_mocked_resp_len(rsp)));
+}
+#endif
+
+void lt_test_mock_deadline(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_deadline()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_DEADLINE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_DEADLINE is not enabled, skipping.");
+#else
+    struct lt_l2_get_info_rsp_t get_info_resp;
+    uint8_t riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE];
+
+    LT_LOG_INFO("Checking parameters...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_deadline_set(NULL, DEADLINE_LONG_US));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_deadline_set(h, 0));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_deadline_clear(NULL));
+    LT_TEST_ASSERT(UINT32_MAX, lt_deadline_left_us(NULL));
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(UINT32_MAX, lt_deadline_left_us(h));
+
+#ifdef LT_L1_ADAPTIVE_POLL
+    // First polls of the adaptive scheduler are shorter than any deadline the test can keep reliably.
+    LT_LOG_INFO("LT_L1_ADAPTIVE_POLL is enabled, skipping the busy TROPIC01 part.");
+    LT_TEST_ASSERT(LT_OK, lt_deadline_set(h, DEADLINE_SHORT_US));
+#else
+    LT_LOG_INFO("TROPIC01 is busy, the next poll would end after the deadline...");
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    uint8_t chip_busy = 0x00;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_busy, sizeof(chip_busy)));
+    LT_TEST_ASSERT(LT_OK, lt_deadline_set(h, DEADLINE_SHORT_US));
+    const uint64_t start_us = lt_port_time_us();
+    LT_TEST_ASSERT(LT_DEADLINE_EXCEEDED, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    // The call returned without waiting for the next poll.
+    LT_TEST_ASSERT(1, lt_port_time_us() - start_us < DEADLINE_SHORT_US);
+#endif
+
+    LT_LOG_INFO("Deadline passed, nothing is sent...");
+    while (lt_deadline_left_us(h) > 0) {
+    }
+    deadline_mock_get_info(h, &get_info_resp);
+    LT_TEST_ASSERT(LT_DEADLINE_EXCEEDED, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    LT_TEST_ASSERT(LT_OK, lt_deadline_clear(h));
+    LT_TEST_ASSERT(UINT32_MAX, lt_deadline_left_us(h));
+    LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    LT_TEST_ASSERT(0, memcmp(riscv_fw_ver, get_info_resp.object, sizeof(riscv_fw_ver)));
+
+    LT_LOG_INFO("Request finishes within the deadline...");
+    deadline_mock_get_info(h, &get_info_resp);
+    LT_TEST_ASSERT(LT_OK, lt_deadline_set(h, DEADLINE_LONG_US));
+    LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    const uint32_t left_us = lt_deadline_left_us(h);
+    LT_TEST_ASSERT(1, (left_us > 0) && (left_us < DEADLINE_LONG_US));
+    LT_TEST_ASSERT(LT_OK, lt_deadline_clear(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
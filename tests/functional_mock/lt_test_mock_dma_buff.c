@@ -0,0 +1,65 @@
+/**
+ * @file lt_test_mock_dma_buff.c
+ * @brief Test placement of the buffers for DMA (LT_BUFF_ALIGN) and cache maintenance of the port
+ * (LT_PORT_CACHE_MAINT).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_dma_buff(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_dma_buff()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#if !defined(LT_BUFF_ALIGN) && !defined(LT_PORT_CACHE_MAINT)
+    LT_UNUSED(h);
+    LT_LOG_INFO("Neither LT_BUFF_ALIGN nor LT_PORT_CACHE_MAINT is enabled, skipping.");
+#else
+#ifdef LT_BUFF_ALIGN
+    LT_LOG_INFO("Verifying the buffers start and end on LT_DMA_BUFF_ALIGN boundaries...");
+    LT_TEST_ASSERT(0, (int)((uintptr_t)h->l2.buff % LT_DMA_BUFF_ALIGN));
+    LT_TEST_ASSERT(0, (int)(sizeof(h->l2.buff) % LT_DMA_BUFF_ALIGN));
+    LT_TEST_ASSERT(1, sizeof(h->l2.buff) >= TR01_L1_LEN_MAX);
+    LT_TEST_ASSERT(0, (int)((uintptr_t)h->l3.buff % LT_DMA_BUFF_ALIGN));
+#ifndef LT_SEPARATE_L3_BUFF
+    LT_TEST_ASSERT(0, (int)(sizeof(h->l3.buff) % LT_DMA_BUFF_ALIGN));
+#endif
+    LT_TEST_ASSERT(0, (int)(LT_DMA_BUFF_SIZE(1) % LT_DMA_BUFF_ALIGN));
+#endif
+
+#ifdef LT_PORT_CACHE_MAINT
+    uint32_t cleaned, invalidated;
+
+    lt_mock_hal_reset(&h->l2);
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_mock_hal_cache_bytes(&h->l2, &cleaned, NULL));
+
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Verifying every transferred byte was cleaned before and invalidated after the transfer...");
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_cache_bytes(&h->l2, &cleaned, &invalidated));
+    LT_TEST_ASSERT(1, cleaned > 0);
+    // Frames of Get_Info are transferred in place in the L2 buffer.
+    LT_TEST_ASSERT(cleaned, invalidated);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+#endif
+}
@@ -0,0 +1,143 @@
+/**
+ * @file lt_test_mock_ecc_inventory.c
+ * @brief Test ECC key slot inventory in the handle (LT_ECC_INVENTORY).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_ECC_INVENTORY
+static lt_ret_t ecc_inventory_test_mock_result(lt_handle_t *h, uint8_t *nonce, const uint8_t result)
+{
+    return mock_l3_command_result(h, nonce, &result, TR01_L3_RESULT_SIZE);
+}
+
+/** Mocks ECC_Key_Read result of a generated P-256 key with all public key bytes set to fill. */
+static lt_ret_t ecc_inventory_test_mock_read(lt_handle_t *h, uint8_t *nonce, const uint8_t fill)
+{
+    struct lt_l3_ecc_key_read_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    res.curve = TR01_CURVE_P256;
+    res.origin = TR01_CURVE_GENERATED;
+    memset(res.pub_key, fill, sizeof(res.pub_key));
+
+    return mock_l3_command_result(h, nonce, &res.result, sizeof(res) - sizeof(res.res_size));
+}
+#endif
+
+void lt_test_mock_ecc_inventory(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_ecc_inventory()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_ECC_INVENTORY
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_ECC_INVENTORY is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+    uint8_t key[TR01_CURVE_P256_PUBKEY_LEN];
+    lt_ecc_curve_type_t curve;
+    lt_ecc_key_origin_t origin;
+    lt_ecc_slot_t slot;
+
+    LT_LOG_INFO("Finding free slot, slots 0 and 1 have to be read until the empty one...");
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_read(h, &nonce, 0xA5));
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_result(h, &nonce, TR01_L3_RESULT_INVALID_KEY));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_inventory_find_free(h, &slot));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(TR01_ECC_SLOT_1, slot);
+    LT_TEST_ASSERT(2, (int)h->l3.ecc_inv.misses);
+
+    LT_LOG_INFO("Reading key of slot 0, it has to be answered from the inventory...");
+    memset(key, 0, sizeof(key));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_read(h, TR01_ECC_SLOT_0, key, sizeof(key), &curve, &origin));
+    LT_TEST_ASSERT(TR01_CURVE_P256, curve);
+    LT_TEST_ASSERT(TR01_CURVE_GENERATED, origin);
+    LT_TEST_ASSERT(1, (key[0] == 0xA5) && (key[TR01_CURVE_P256_PUBKEY_LEN - 1] == 0xA5));
+    LT_TEST_ASSERT(1, (int)h->l3.ecc_inv.hits);
+
+    LT_LOG_INFO("Generating key in slot 1, next free slot has to be read...");
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_generate(h, TR01_ECC_SLOT_1, TR01_CURVE_P256));
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_result(h, &nonce, TR01_L3_RESULT_INVALID_KEY));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_inventory_find_free(h, &slot));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(TR01_ECC_SLOT_2, slot);
+
+    LT_LOG_INFO("Erasing slot 0, it has to be found free without an L3 Command...");
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_erase(h, TR01_ECC_SLOT_0));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_inventory_find_free(h, &slot));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(TR01_ECC_SLOT_0, slot);
+
+    LT_LOG_INFO("Reading generated key of slot 1 twice, only the first read has to be sent...");
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_read(h, &nonce, 0x3C));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_read(h, TR01_ECC_SLOT_1, key, sizeof(key), &curve, &origin));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    memset(key, 0, sizeof(key));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_read(h, TR01_ECC_SLOT_1, key, sizeof(key), &curve, &origin));
+    LT_TEST_ASSERT(1, (key[0] == 0x3C));
+    LT_TEST_ASSERT(2, (int)h->l3.ecc_inv.hits);
+
+    LT_LOG_INFO("Too small buffer has to be refused from the inventory as well...");
+    LT_TEST_ASSERT(LT_PARAM_ERR,
+                   lt_ecc_key_read(h, TR01_ECC_SLOT_1, key, TR01_CURVE_ED25519_PUBKEY_LEN, &curve, &origin));
+
+    LT_LOG_INFO("Failed erase of slot 1, the slot has to be read again...");
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_result(h, &nonce, TR01_L3_RESULT_FAIL));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_ecc_key_erase(h, TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_read(h, &nonce, 0x3C));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_read(h, TR01_ECC_SLOT_1, key, sizeof(key), &curve, &origin));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Starting new Secure Session, the inventory has to be dropped...");
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    nonce = 0;
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_result(h, &nonce, TR01_L3_RESULT_INVALID_KEY));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_inventory_find_free(h, &slot));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(TR01_ECC_SLOT_0, slot);
+
+    LT_LOG_INFO("Invalidating the inventory, the slot has to be read again...");
+    LT_TEST_ASSERT(LT_OK, lt_ecc_inventory_invalidate(h));
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_read(h, &nonce, 0x11));
+    LT_TEST_ASSERT(LT_OK, ecc_inventory_test_mock_result(h, &nonce, TR01_L3_RESULT_INVALID_KEY));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_inventory_find_free(h, &slot));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(TR01_ECC_SLOT_1, slot);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,149 @@
+/**
+ * @file lt_test_mock_ecc_key_pool.c
+ * @brief Test pool of ECC keys generated ahead of time (LT_ECC_KEY_POOL).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_ECC_KEY_POOL
+static lt_ret_t ecc_key_pool_test_mock_result(lt_handle_t *h, uint8_t *nonce, const uint8_t result)
+{
+    return mock_l3_command_result(h, nonce, &result, TR01_L3_RESULT_SIZE);
+}
+
+/** Mocks ECC_Key_Read result of a P-256 key of the origin with all public key bytes set to fill. */
+static lt_ret_t ecc_key_pool_test_mock_read(lt_handle_t *h, uint8_t *nonce, const uint8_t origin, const uint8_t fill)
+{
+    struct lt_l3_ecc_key_read_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    res.curve = TR01_CURVE_P256;
+    res.origin = origin;
+    memset(res.pub_key, fill, sizeof(res.pub_key));
+
+    return mock_l3_command_result(h, nonce, &res.result, sizeof(res) - sizeof(res.res_size));
+}
+
+/** Mocks erase, generation and read of a generated key with public key filled by fill, one per refill step. */
+static void ecc_key_pool_test_refill_slot(lt_handle_t *h, uint8_t *nonce, lt_ecc_key_pool_t *pool, const uint8_t fill,
+                                          const bool last)
+{
+    bool done;
+
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_result(h, nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_refill_step(h, pool, &done));
+    LT_TEST_ASSERT(0, done);
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_result(h, nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_refill_step(h, pool, &done));
+    LT_TEST_ASSERT(0, done);
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_read(h, nonce, TR01_CURVE_GENERATED, fill));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_refill_step(h, pool, &done));
+    LT_TEST_ASSERT(last, done);
+}
+#endif
+
+void lt_test_mock_ecc_key_pool(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_ecc_key_pool()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_ECC_KEY_POOL
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_ECC_KEY_POOL is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+    uint8_t pubkey[TR01_CURVE_P256_PUBKEY_LEN];
+    lt_ecc_key_pool_t pool;
+    lt_ecc_slot_t slot;
+    bool done;
+
+    LT_LOG_INFO("Initializing pool with slots 2 and 3...");
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_init(&pool, h, TR01_CURVE_P256));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_add(&pool, TR01_ECC_SLOT_2));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_add(&pool, TR01_ECC_SLOT_3));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ecc_key_pool_add(&pool, TR01_ECC_SLOT_2));
+    LT_TEST_ASSERT(0, lt_ecc_key_pool_ready(&pool));
+
+    LT_LOG_INFO("Refilling pool step by step, every slot has to be erased, generated and read...");
+    ecc_key_pool_test_refill_slot(h, &nonce, &pool, 0xA1, false);
+    LT_TEST_ASSERT(1, lt_ecc_key_pool_ready(&pool));
+    ecc_key_pool_test_refill_slot(h, &nonce, &pool, 0xB2, true);
+    LT_TEST_ASSERT(2, lt_ecc_key_pool_ready(&pool));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_refill(&pool));
+
+    LT_LOG_INFO("Taking ready keys, nothing has to be sent...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ecc_key_pool_take(&pool, &slot, pubkey, TR01_CURVE_ED25519_PUBKEY_LEN));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_take(&pool, &slot, pubkey, sizeof(pubkey)));
+    LT_TEST_ASSERT(TR01_ECC_SLOT_2, slot);
+    LT_TEST_ASSERT(1, (pubkey[0] == 0xA1) && (pubkey[TR01_CURVE_P256_PUBKEY_LEN - 1] == 0xA1));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_take(&pool, &slot, pubkey, sizeof(pubkey)));
+    LT_TEST_ASSERT(TR01_ECC_SLOT_3, slot);
+    LT_TEST_ASSERT(1, (pubkey[0] == 0xB2));
+    LT_TEST_ASSERT(2, (int)pool.hits);
+    LT_TEST_ASSERT(LT_FAIL, lt_ecc_key_pool_take(&pool, &slot, pubkey, sizeof(pubkey)));
+
+    LT_LOG_INFO("Taking key from pool without a ready key, it has to be generated on demand...");
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_add(&pool, TR01_ECC_SLOT_5));
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_read(h, &nonce, TR01_CURVE_GENERATED, 0xC3));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_take(&pool, &slot, pubkey, sizeof(pubkey)));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(TR01_ECC_SLOT_5, slot);
+    LT_TEST_ASSERT(1, (pubkey[0] == 0xC3));
+    LT_TEST_ASSERT(1, (int)pool.misses);
+
+    LT_LOG_INFO("Failed generation and foreign key, the slot has to be erased again...");
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_add(&pool, TR01_ECC_SLOT_6));
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_refill_step(h, &pool, &done));
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_result(h, &nonce, TR01_L3_RESULT_FAIL));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_ecc_key_pool_refill_step(h, &pool, &done));
+    LT_TEST_ASSERT(0, done);
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_refill_step(h, &pool, &done));
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_pool_refill_step(h, &pool, &done));
+    LT_TEST_ASSERT(LT_OK, ecc_key_pool_test_mock_read(h, &nonce, TR01_CURVE_STORED, 0xD4));
+    LT_TEST_ASSERT(LT_FAIL, lt_ecc_key_pool_refill_step(h, &pool, &done));
+    LT_TEST_ASSERT(0, done);
+    LT_TEST_ASSERT(0, lt_ecc_key_pool_ready(&pool));
+    ecc_key_pool_test_refill_slot(h, &nonce, &pool, 0xE5, true);
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(1, lt_ecc_key_pool_ready(&pool));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
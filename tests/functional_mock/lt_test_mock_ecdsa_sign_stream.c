@@ -0,0 +1,161 @@
+/**
+ * @file lt_test_mock_ecdsa_sign_stream.c
+ * @brief Test ECDSA signing of messages hashed part by part and of batches of messages (LT_ECDSA_SIGN_STREAM).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_ECDSA_SIGN_STREAM
+/** Number of messages signed in a batch. */
+#define ECDSA_SIGN_STREAM_TEST_DOCS 3
+
+/** Message read by the reader callback. */
+struct ecdsa_sign_stream_test_doc_t {
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    lt_ret_t ret;
+};
+
+static lt_ret_t ecdsa_sign_stream_test_reader(void *reader_ctx, uint8_t *buf, const size_t buf_len, size_t *read_len)
+{
+    struct ecdsa_sign_stream_test_doc_t *doc = (struct ecdsa_sign_stream_test_doc_t *)reader_ctx;
+
+    if (doc->ret != LT_OK) {
+        return doc->ret;
+    }
+
+    size_t len = doc->len - doc->pos;
+    if (len > buf_len) {
+        len = buf_len;
+    }
+    memcpy(buf, doc->data + doc->pos, len);
+    doc->pos += len;
+    *read_len = len;
+
+    return LT_OK;
+}
+
+/** Mocks L3 Command acknowledgement and ECDSA_Sign L3 Result, encrypted with the given decryption nonce. */
+static lt_ret_t ecdsa_sign_stream_test_mock_sign(lt_handle_t *h, const uint8_t nonce, const uint8_t fill)
+{
+    struct lt_l3_ecdsa_sign_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    memset(res.r, 0x10 + fill, sizeof(res.r));
+    memset(res.s, 0x20 + fill, sizeof(res.s));
+
+    uint8_t iv[TR01_L3_IV_SIZE];
+    memcpy(iv, h->l3.decryption_IV, sizeof(iv));
+    h->l3.decryption_IV[0] = nonce;
+
+    lt_ret_t ret = mock_l3_command_responses(h, 1);
+    if (ret == LT_OK) {
+        ret = mock_l3_result(h, &res.result, TR01_L3_ECDSA_SIGN_RES_SIZE);
+    }
+
+    memcpy(h->l3.decryption_IV, iv, sizeof(iv));
+    return ret;
+}
+#endif
+
+void lt_test_mock_ecdsa_sign_stream(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_ecdsa_sign_stream()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_ECDSA_SIGN_STREAM
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_ECDSA_SIGN_STREAM is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    uint8_t msg[300];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, msg, sizeof(msg)));
+    uint8_t rs[ECDSA_SIGN_STREAM_TEST_DOCS][TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+
+    LT_LOG_INFO("Signing message hashed in two parts...");
+    lt_ecdsa_sign_t s;
+    LT_TEST_ASSERT(LT_OK, ecdsa_sign_stream_test_mock_sign(h, 0, 0));
+    LT_TEST_ASSERT(LT_OK, lt_ecdsa_sign_init(&s, h, TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(LT_OK, lt_ecdsa_sign_update(&s, msg, 100));
+    LT_TEST_ASSERT(LT_OK, lt_ecdsa_sign_update(&s, msg + 100, sizeof(msg) - 100));
+    LT_TEST_ASSERT(LT_OK, lt_ecdsa_sign_final(&s, rs[0]));
+    LT_TEST_ASSERT(0x10, rs[0][0]);
+    LT_TEST_ASSERT(0x20, rs[0][TR01_ECDSA_EDDSA_SIGNATURE_LENGTH - 1]);
+
+    LT_LOG_INFO("Verifying finished context is rejected...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ecdsa_sign_update(&s, msg, sizeof(msg)));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ecdsa_sign_final(&s, rs[0]));
+
+    LT_LOG_INFO("Signing batch of messages read by callback...");
+    struct ecdsa_sign_stream_test_doc_t docs[ECDSA_SIGN_STREAM_TEST_DOCS];
+    lt_ecdsa_sign_doc_t batch[ECDSA_SIGN_STREAM_TEST_DOCS];
+    for (uint8_t i = 0; i < ECDSA_SIGN_STREAM_TEST_DOCS; i++) {
+        docs[i] = (struct ecdsa_sign_stream_test_doc_t){.data = msg, .len = sizeof(msg) - i * 100, .pos = 0, .ret = LT_OK};
+        batch[i] = (lt_ecdsa_sign_doc_t){.reader_ctx = &docs[i], .rs = rs[i]};
+        LT_TEST_ASSERT(LT_OK, ecdsa_sign_stream_test_mock_sign(h, 1 + i, 1 + i));
+    }
+    memset(rs, 0, sizeof(rs));
+    LT_TEST_ASSERT(LT_OK, lt_ecdsa_sign_batch(h, TR01_ECC_SLOT_2, ecdsa_sign_stream_test_reader, batch,
+                                              ECDSA_SIGN_STREAM_TEST_DOCS));
+    for (uint8_t i = 0; i < ECDSA_SIGN_STREAM_TEST_DOCS; i++) {
+        LT_TEST_ASSERT(1, docs[i].pos == docs[i].len);
+        LT_TEST_ASSERT(0x11 + i, rs[i][0]);
+        LT_TEST_ASSERT(0x21 + i, rs[i][TR01_ECDSA_EDDSA_SIGNATURE_LENGTH - 1]);
+    }
+
+    LT_LOG_INFO("Signing batch where reading of the second message fails...");
+    for (uint8_t i = 0; i < ECDSA_SIGN_STREAM_TEST_DOCS; i++) {
+        docs[i].pos = 0;
+    }
+    docs[1].ret = LT_FAIL;
+    memset(rs, 0, sizeof(rs));
+    LT_TEST_ASSERT(LT_OK, ecdsa_sign_stream_test_mock_sign(h, 4, 4));
+    LT_TEST_ASSERT(LT_FAIL, lt_ecdsa_sign_batch(h, TR01_ECC_SLOT_2, ecdsa_sign_stream_test_reader, batch,
+                                                ECDSA_SIGN_STREAM_TEST_DOCS));
+    LT_TEST_ASSERT(0x14, rs[0][0]);
+    LT_TEST_ASSERT(0, rs[1][0]);
+    LT_TEST_ASSERT(0, docs[2].pos);
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+
+    LT_LOG_INFO("Verifying invalid parameters are rejected...");
+    batch[2].rs = NULL;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ecdsa_sign_batch(h, TR01_ECC_SLOT_2, ecdsa_sign_stream_test_reader, batch,
+                                                     ECDSA_SIGN_STREAM_TEST_DOCS));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ecdsa_sign_init(&s, h, (lt_ecc_slot_t)(TR01_ECC_SLOT_31 + 1)));
+
+    LT_LOG_INFO("Terminating the Secure Session...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,110 @@
+/**
+ * @file lt_test_mock_ed25519_verify.c
+ * @brief Test host-side batch verification of Ed25519 signatures (LT_ED25519_VERIFY).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_test_common.h"
+
+#ifdef LT_ED25519_VERIFY
+/** Number of items of the batch, more than one group of the donna based CALs. */
+#define ED25519_VERIFY_ITEMS 12
+
+// Test vectors 1, 2 and 3 of RFC 8032, section 7.1.
+static const uint8_t rfc8032_pubkey[3][TR01_CURVE_ED25519_PUBKEY_LEN]
+    = {{0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+        0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a},
+       {0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a, 0x92, 0xb7, 0x0a, 0xa7, 0x4d, 0x1b, 0x7e, 0xbc,
+        0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c, 0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c},
+       {0xfc, 0x51, 0xcd, 0x8e, 0x62, 0x18, 0xa1, 0xa3, 0x8d, 0xa4, 0x7e, 0xd0, 0x02, 0x30, 0xf0, 0x58,
+        0x08, 0x16, 0xed, 0x13, 0xba, 0x33, 0x03, 0xac, 0x5d, 0xeb, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25}};
+static const uint8_t rfc8032_msg[3][2] = {{0x00}, {0x72}, {0xaf, 0x82}};
+static const uint8_t rfc8032_sig[3][TR01_ECDSA_EDDSA_SIGNATURE_LENGTH]
+    = {{0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2, 0xcc, 0x80, 0x6e, 0x82, 0x8a,
+        0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5, 0xd9, 0x74, 0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55,
+        0x5f, 0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70, 0x1c, 0xf9, 0xb4, 0x6b,
+        0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe, 0x24, 0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b},
+       {0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8, 0x72, 0x0e, 0x82, 0x0b, 0x5f, 0x64, 0x25, 0x40,
+        0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f, 0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda,
+        0x08, 0x5a, 0xc1, 0xe4, 0x3e, 0x15, 0x99, 0x6e, 0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+        0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee, 0xb0, 0x0d, 0x29, 0x16, 0x12, 0xbb, 0x0c, 0x00},
+       {0x62, 0x91, 0xd6, 0x57, 0xde, 0xec, 0x24, 0x02, 0x48, 0x27, 0xe6, 0x9c, 0x3a, 0xbe, 0x01, 0xa3,
+        0x0c, 0xe5, 0x48, 0xa2, 0x84, 0x74, 0x3a, 0x44, 0x5e, 0x36, 0x80, 0xd7, 0xdb, 0x5a, 0xc3, 0xac,
+        0x18, 0xff, 0x9b, 0x53, 0x8d, 0x16, 0xf2, 0x90, 0xae, 0x67, 0xf7, 0x60, 0x98, 0x4d, 0xc6, 0x59,
+        0x4a, 0x7c, 0x15, 0xe9, 0x71, 0x6e, 0xd2, 0x8d, 0xc0, 0x27, 0xbe, 0xce, 0xea, 0x1e, 0xc4, 0x0a}};
+
+static uint8_t sigs[ED25519_VERIFY_ITEMS][TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+static uint8_t msgs[ED25519_VERIFY_ITEMS][2];
+static lt_ed25519_verify_t items[ED25519_VERIFY_ITEMS];
+
+/** Fills the batch with the test vectors in turn, the same public keys repeat. */
+static void ed25519_verify_fill(void)
+{
+    for (int i = 0; i < ED25519_VERIFY_ITEMS; i++) {
+        memcpy(sigs[i], rfc8032_sig[i % 3], sizeof(sigs[i]));
+        memcpy(msgs[i], rfc8032_msg[i % 3], sizeof(msgs[i]));
+        items[i] = (lt_ed25519_verify_t){.pubkey = rfc8032_pubkey[i % 3],
+                                         .msg = (i % 3) ? msgs[i] : NULL,
+                                         .msg_len = (size_t)(i % 3),
+                                         .signature = sigs[i],
+                                         .valid = false};
+    }
+}
+#endif
+
+void lt_test_mock_ed25519_verify(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_ed25519_verify()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    LT_UNUSED(h);
+#ifndef LT_ED25519_VERIFY
+    LT_LOG_INFO("LT_ED25519_VERIFY is not enabled, skipping.");
+#else
+    LT_LOG_INFO("Verifying RFC 8032 signatures one at a time and in a batch...");
+    ed25519_verify_fill();
+    for (int i = 0; i < 3; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_ed25519_verify_batch(&items[i], 1));
+        LT_TEST_ASSERT(true, items[i].valid);
+    }
+    LT_TEST_ASSERT(LT_OK, lt_ed25519_verify_batch(items, ED25519_VERIFY_ITEMS));
+    for (int i = 0; i < ED25519_VERIFY_ITEMS; i++) {
+        LT_TEST_ASSERT(true, items[i].valid);
+    }
+    LT_TEST_ASSERT(LT_OK, lt_ed25519_verify_batch(items, 0));
+
+    LT_LOG_INFO("Verifying only the corrupted signatures are reported...");
+    // Other message, other R, S not reduced and other public key.
+    msgs[1][0] ^= 0x01;
+    sigs[5][0] ^= 0x01;
+    sigs[9][TR01_ECDSA_EDDSA_SIGNATURE_LENGTH - 1] |= 0x10;
+    items[10].pubkey = rfc8032_pubkey[0];
+    LT_TEST_ASSERT(LT_SIGNATURE_INVALID, lt_ed25519_verify_batch(items, ED25519_VERIFY_ITEMS));
+    for (int i = 0; i < ED25519_VERIFY_ITEMS; i++) {
+        LT_TEST_ASSERT((i != 1) && (i != 5) && (i != 9) && (i != 10), items[i].valid);
+    }
+    LT_TEST_ASSERT(LT_SIGNATURE_INVALID, lt_ed25519_verify_batch(&items[5], 1));
+    LT_TEST_ASSERT(false, items[5].valid);
+
+    LT_LOG_INFO("Verifying parameter checks...");
+    ed25519_verify_fill();
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ed25519_verify_batch(NULL, 1));
+    items[2].pubkey = NULL;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ed25519_verify_batch(items, ED25519_VERIFY_ITEMS));
+    ed25519_verify_fill();
+    items[2].signature = NULL;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ed25519_verify_batch(items, ED25519_VERIFY_ITEMS));
+    ed25519_verify_fill();
+    items[2].msg = NULL;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ed25519_verify_batch(items, ED25519_VERIFY_ITEMS));
+#endif
+}
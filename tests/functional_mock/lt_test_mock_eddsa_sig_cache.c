@@ -0,0 +1,145 @@
+/**
+ * @file lt_test_mock_eddsa_sig_cache.c
+ * @brief Test EdDSA signature cache in the handle (LT_EDDSA_SIG_CACHE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_EDDSA_SIG_CACHE
+/** Mocks EDDSA_Sign result with all bytes of the signature set to fill. */
+static lt_ret_t eddsa_sig_cache_test_mock_sign(lt_handle_t *h, uint8_t *nonce, const uint8_t fill)
+{
+    struct lt_l3_eddsa_sign_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    memset(res.r, fill, sizeof(res.r));
+    memset(res.s, fill, sizeof(res.s));
+
+    return mock_l3_command_result(h, nonce, &res.result, TR01_L3_EDDSA_SIGN_RES_SIZE);
+}
+
+/** Tells whether all bytes of the signature are set to fill. */
+static int eddsa_sig_cache_test_sig_is(const uint8_t *rs, const uint8_t fill)
+{
+    for (size_t i = 0; i < TR01_ECDSA_EDDSA_SIGNATURE_LENGTH; i++) {
+        if (rs[i] != fill) {
+            return 0;
+        }
+    }
+    return 1;
+}
+#endif
+
+void lt_test_mock_eddsa_sig_cache(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_eddsa_sig_cache()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_EDDSA_SIG_CACHE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_EDDSA_SIG_CACHE is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_eddsa_sig_cache_invalidate(NULL));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+    const uint8_t msg_a[] = "manifest A";
+    const uint8_t msg_b[] = "manifest B";
+    uint8_t rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+
+    LT_LOG_INFO("Signing message A twice, only the first signing has to be sent...");
+    LT_TEST_ASSERT(LT_OK, eddsa_sig_cache_test_mock_sign(h, &nonce, 0xA1));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_1, msg_a, sizeof(msg_a), rs));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    memset(rs, 0, sizeof(rs));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_1, msg_a, sizeof(msg_a), rs));
+    LT_TEST_ASSERT(1, eddsa_sig_cache_test_sig_is(rs, 0xA1));
+    LT_TEST_ASSERT(1, (int)h->l3.eddsa_sig.hits);
+    LT_TEST_ASSERT(1, (int)h->l3.eddsa_sig.misses);
+
+    LT_LOG_INFO("Signing message B and message A with another key, both have to be sent...");
+    LT_TEST_ASSERT(LT_OK, eddsa_sig_cache_test_mock_sign(h, &nonce, 0xB1));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_1, msg_b, sizeof(msg_b), rs));
+    LT_TEST_ASSERT(1, eddsa_sig_cache_test_sig_is(rs, 0xB1));
+    LT_TEST_ASSERT(LT_OK, eddsa_sig_cache_test_mock_sign(h, &nonce, 0xA2));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_2, msg_a, sizeof(msg_a), rs));
+    LT_TEST_ASSERT(1, eddsa_sig_cache_test_sig_is(rs, 0xA2));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(3, (int)h->l3.eddsa_sig.misses);
+
+    LT_LOG_INFO("Failed signing has to leave nothing in the cache...");
+    uint8_t result = TR01_L3_RESULT_FAIL;
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, &nonce, &result, TR01_L3_RESULT_SIZE));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_3, msg_a, sizeof(msg_a), rs));
+    LT_TEST_ASSERT(LT_OK, eddsa_sig_cache_test_mock_sign(h, &nonce, 0xA3));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_3, msg_a, sizeof(msg_a), rs));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Generating new key in slot 1, message A has to be signed by TROPIC01 again...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, &nonce, &(uint8_t){TR01_L3_RESULT_OK}, TR01_L3_RESULT_SIZE));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_generate(h, TR01_ECC_SLOT_1, TR01_CURVE_ED25519));
+    LT_TEST_ASSERT(LT_OK, eddsa_sig_cache_test_mock_sign(h, &nonce, 0xA4));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_1, msg_a, sizeof(msg_a), rs));
+    LT_TEST_ASSERT(1, eddsa_sig_cache_test_sig_is(rs, 0xA4));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Signature of slot 2 has to be served still...");
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_2, msg_a, sizeof(msg_a), rs));
+    LT_TEST_ASSERT(1, eddsa_sig_cache_test_sig_is(rs, 0xA2));
+
+    LT_LOG_INFO("Failed erase of slot 2, message A has to be signed by TROPIC01 again...");
+    result = TR01_L3_RESULT_FAIL;
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, &nonce, &result, TR01_L3_RESULT_SIZE));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_ecc_key_erase(h, TR01_ECC_SLOT_2));
+    LT_TEST_ASSERT(LT_OK, eddsa_sig_cache_test_mock_sign(h, &nonce, 0xA5));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_2, msg_a, sizeof(msg_a), rs));
+    LT_TEST_ASSERT(1, eddsa_sig_cache_test_sig_is(rs, 0xA5));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Invalidating the cache, message B has to be signed by TROPIC01 again...");
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sig_cache_invalidate(h));
+    LT_TEST_ASSERT(LT_OK, eddsa_sig_cache_test_mock_sign(h, &nonce, 0xB2));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_1, msg_b, sizeof(msg_b), rs));
+    LT_TEST_ASSERT(1, eddsa_sig_cache_test_sig_is(rs, 0xB2));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Starting new Secure Session, the cache has to be dropped...");
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    nonce = 0;
+    LT_TEST_ASSERT(LT_OK, eddsa_sig_cache_test_mock_sign(h, &nonce, 0xB3));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_1, msg_b, sizeof(msg_b), rs));
+    LT_TEST_ASSERT(1, eddsa_sig_cache_test_sig_is(rs, 0xB3));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,131 @@
+/**
+ * @file lt_test_mock_eddsa_sign_stream.c
+ * @brief Test EdDSA signing of messages prehashed part by part (LT_EDDSA_SIGN_STREAM).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_EDDSA_SIGN_STREAM
+/** Length of the message, longer than fits into one EDDSA_Sign L3 Command. */
+#define EDDSA_SIGN_STREAM_TEST_MSG_LEN (TR01_L3_EDDSA_SIGN_CMD_MSG_LEN_MAX + 1000)
+
+/** Message read by the reader callback. */
+struct eddsa_sign_stream_test_doc_t {
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    lt_ret_t ret;
+};
+
+static lt_ret_t eddsa_sign_stream_test_reader(void *reader_ctx, uint8_t *buf, const size_t buf_len, size_t *read_len)
+{
+    struct eddsa_sign_stream_test_doc_t *doc = (struct eddsa_sign_stream_test_doc_t *)reader_ctx;
+
+    if ((doc->ret != LT_OK) && (doc->pos > 0)) {
+        return doc->ret;
+    }
+
+    size_t len = doc->len - doc->pos;
+    if (len > buf_len) {
+        len = buf_len;
+    }
+    memcpy(buf, doc->data + doc->pos, len);
+    doc->pos += len;
+    *read_len = len;
+
+    return LT_OK;
+}
+#endif
+
+void lt_test_mock_eddsa_sign_stream(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_eddsa_sign_stream()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_EDDSA_SIGN_STREAM
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_EDDSA_SIGN_STREAM is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    static uint8_t msg[EDDSA_SIGN_STREAM_TEST_MSG_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, msg, sizeof(msg)));
+    uint8_t rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+    struct lt_l3_eddsa_sign_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    memset(res.r, 0x11, sizeof(res.r));
+    memset(res.s, 0x22, sizeof(res.s));
+
+    LT_LOG_INFO("Verifying the message is too long for lt_ecc_eddsa_sign()...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_ecc_eddsa_sign(h, TR01_ECC_SLOT_1, msg, (uint16_t)sizeof(msg), rs));
+
+    LT_LOG_INFO("Signing message prehashed in two parts...");
+    lt_eddsa_sign_t s;
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, &res.result, TR01_L3_EDDSA_SIGN_RES_SIZE));
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sign_init(&s, h, TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sign_update(&s, msg, TR01_L3_EDDSA_SIGN_CMD_MSG_LEN_MAX));
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sign_update(&s, msg + TR01_L3_EDDSA_SIGN_CMD_MSG_LEN_MAX,
+                                               sizeof(msg) - TR01_L3_EDDSA_SIGN_CMD_MSG_LEN_MAX));
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sign_final(&s, rs));
+    LT_TEST_ASSERT(0, memcmp(rs, res.r, sizeof(res.r)));
+    LT_TEST_ASSERT(0, memcmp(rs + sizeof(res.r), res.s, sizeof(res.s)));
+
+    LT_LOG_INFO("Verifying finished context is rejected...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_eddsa_sign_update(&s, msg, sizeof(msg)));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_eddsa_sign_final(&s, rs));
+
+    LT_LOG_INFO("Signing message read by callback...");
+    struct eddsa_sign_stream_test_doc_t doc = {.data = msg, .len = sizeof(msg), .pos = 0, .ret = LT_OK};
+    memset(rs, 0, sizeof(rs));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, &res.result, TR01_L3_EDDSA_SIGN_RES_SIZE));
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sign_init(&s, h, TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sign_read(&s, eddsa_sign_stream_test_reader, &doc));
+    LT_TEST_ASSERT(1, doc.pos == doc.len);
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sign_final(&s, rs));
+    LT_TEST_ASSERT(0, memcmp(rs, res.r, sizeof(res.r)));
+
+    LT_LOG_INFO("Verifying failing callback abandons the signing...");
+    doc = (struct eddsa_sign_stream_test_doc_t){.data = msg, .len = sizeof(msg), .pos = 0, .ret = LT_FAIL};
+    LT_TEST_ASSERT(LT_OK, lt_eddsa_sign_init(&s, h, TR01_ECC_SLOT_1));
+    LT_TEST_ASSERT(LT_FAIL, lt_eddsa_sign_read(&s, eddsa_sign_stream_test_reader, &doc));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_eddsa_sign_final(&s, rs));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_eddsa_sign_init(&s, h, (lt_ecc_slot_t)(TR01_ECC_SLOT_31 + 1)));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+
+    LT_LOG_INFO("Terminating the Secure Session...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,158 @@
+/**
+ * @file lt_test_mock_fw_fleet.c
+ * @brief Test mutable firmware update of several TROPIC01 devices with one image (LT_FW_FLEET).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#if defined(LT_FW_FLEET) && defined(ACAB)
+/** Number of data chunks of the test image. */
+#define FW_FLEET_CHUNKS 3
+/** Size of one chunk including its length byte (length, hash of the next chunk, offset, data). */
+#define FW_FLEET_CHUNK_SIZE (1 + 32 + 2 + 32)
+/** Size of the update request at the beginning of the image, including its length byte. */
+#define FW_FLEET_REQ_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1)
+/** Size of the test image. */
+#define FW_FLEET_IMAGE_SIZE (FW_FLEET_REQ_SIZE + FW_FLEET_CHUNKS * FW_FLEET_CHUNK_SIZE)
+
+/** Result reported by the callback of the device. */
+struct fw_fleet_dev_t {
+    int calls;       /**< Number of callback calls. */
+    lt_ret_t ret;    /**< Result passed to the callback. */
+    uint16_t offset; /**< Resume offset passed to the callback. */
+};
+
+static void fw_fleet_cb(lt_handle_t *h, lt_ret_t ret, uint16_t offset, void *cb_ctx)
+{
+    struct fw_fleet_dev_t *dev = cb_ctx;
+
+    LT_UNUSED(h);
+    dev->calls++;
+    dev->ret = ret;
+    dev->offset = offset;
+}
+
+/** Builds update image, the hashes are not checked by the mocked chip. */
+static lt_ret_t fw_fleet_build_image(lt_handle_t *h, uint8_t *image)
+{
+    lt_ret_t ret = lt_random_bytes(h, image, FW_FLEET_IMAGE_SIZE);
+
+    image[0] = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN;
+    for (int i = 0; i < FW_FLEET_CHUNKS; i++) {
+        image[FW_FLEET_REQ_SIZE + i * FW_FLEET_CHUNK_SIZE] = FW_FLEET_CHUNK_SIZE - 1;
+    }
+
+    return ret;
+}
+
+/** Mocks replies to given number of Mutable_FW_Update(_Data) L2 Requests with the given L2 status. */
+static lt_ret_t fw_fleet_mock_responses(lt_handle_t *h, const int count, const uint8_t status)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_mutable_fw_update_rsp_t rsp
+        = {.chip_status = TR01_L1_CHIP_MODE_READY_bit, .status = status, .rsp_len = 0};
+    add_resp_crc(&rsp);
+
+    for (int i = 0; i < count; i++) {
+        if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))
+            || LT_OK != lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp))) {
+            return LT_FAIL;
+        }
+    }
+
+    return LT_OK;
+}
+#endif
+
+void lt_test_mock_fw_fleet(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_fw_fleet()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#if !defined(LT_FW_FLEET) || !defined(ACAB)
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_FW_FLEET is not enabled or silicon revision is not ACAB, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    uint8_t image[FW_FLEET_IMAGE_SIZE];
+    LT_TEST_ASSERT(LT_OK, fw_fleet_build_image(h, image));
+
+    lt_l2_async_t op;
+    memset(&op, 0, sizeof(op));
+    lt_fw_fleet_t fleet;
+    struct fw_fleet_dev_t dev = {0};
+    uint16_t offset = 0;
+
+    LT_LOG_INFO("Verifying malformed image and invalid offset are rejected...");
+    image[FW_FLEET_REQ_SIZE + FW_FLEET_CHUNK_SIZE] = 0xff;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_fleet_init(&fleet, image, sizeof(image), TR01_FW_BANK_FW1));
+    image[FW_FLEET_REQ_SIZE + FW_FLEET_CHUNK_SIZE] = FW_FLEET_CHUNK_SIZE - 1;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_fleet_init(&fleet, image, FW_FLEET_REQ_SIZE, TR01_FW_BANK_FW1));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_init(&fleet, image, sizeof(image), TR01_FW_BANK_FW1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_fleet_add_device(&fleet, h, &op, 1, fw_fleet_cb, &dev));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_fleet_progress(&fleet, 0, &offset));
+
+    LT_LOG_INFO("Updating device with the whole image...");
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_add_device(&fleet, h, &op, 0, fw_fleet_cb, &dev));
+    LT_TEST_ASSERT(1, lt_fw_fleet_pending(&fleet));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_fw_fleet_progress(&fleet, 0, &offset));
+    LT_TEST_ASSERT(LT_OK, fw_fleet_mock_responses(h, 1 + FW_FLEET_CHUNKS, TR01_L2_STATUS_REQUEST_OK));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_run(&fleet));
+    LT_TEST_ASSERT(0, lt_fw_fleet_pending(&fleet));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_progress(&fleet, 0, &offset));
+    LT_TEST_ASSERT(sizeof(image), offset);
+    LT_TEST_ASSERT(1, dev.calls);
+    LT_TEST_ASSERT(LT_OK, dev.ret);
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Updating device which fails on the second chunk...");
+    memset(&dev, 0, sizeof(dev));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_init(&fleet, image, sizeof(image), TR01_FW_BANK_FW1));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_add_device(&fleet, h, &op, 0, fw_fleet_cb, &dev));
+    LT_TEST_ASSERT(LT_OK, fw_fleet_mock_responses(h, 2, TR01_L2_STATUS_REQUEST_OK));
+    LT_TEST_ASSERT(LT_OK, fw_fleet_mock_responses(h, 1, TR01_L2_STATUS_GEN_ERR));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_run(&fleet));
+    LT_TEST_ASSERT(LT_L2_GEN_ERR, lt_fw_fleet_progress(&fleet, 0, &offset));
+    LT_TEST_ASSERT(FW_FLEET_REQ_SIZE + FW_FLEET_CHUNK_SIZE, offset);
+    LT_TEST_ASSERT(1, dev.calls);
+    LT_TEST_ASSERT(LT_L2_GEN_ERR, dev.ret);
+    LT_TEST_ASSERT(offset, dev.offset);
+
+    LT_LOG_INFO("Resuming the update from the reported offset...");
+    memset(&dev, 0, sizeof(dev));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_init(&fleet, image, sizeof(image), TR01_FW_BANK_FW1));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_add_device(&fleet, h, &op, offset, fw_fleet_cb, &dev));
+    LT_TEST_ASSERT(LT_OK, fw_fleet_mock_responses(h, FW_FLEET_CHUNKS - 1, TR01_L2_STATUS_REQUEST_OK));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_run(&fleet));
+    LT_TEST_ASSERT(LT_OK, lt_fw_fleet_progress(&fleet, 0, &offset));
+    LT_TEST_ASSERT(sizeof(image), offset);
+    LT_TEST_ASSERT(1, dev.calls);
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,156 @@
+/**
+ * @file lt_test_mock_fw_image.c
+ * @brief Test mutable firmware update image read by parts (LT_FW_IMAGE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#if defined(LT_FW_IMAGE) && defined(ACAB)
+/** Number of data chunks of the test image. */
+#define FW_IMAGE_CHUNKS 3
+/** Size of one chunk including its length byte (length, hash of the next chunk, offset, data). */
+#define FW_IMAGE_CHUNK_SIZE (1 + 32 + 2 + 32)
+/** Size of the update request at the beginning of the image, including its length byte. */
+#define FW_IMAGE_REQ_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1)
+/** Size of the test image. */
+#define FW_IMAGE_SIZE (FW_IMAGE_REQ_SIZE + FW_IMAGE_CHUNKS * FW_IMAGE_CHUNK_SIZE)
+
+/** Image "stored" outside of the library, read by fw_image_read(). */
+struct fw_image_storage_t {
+    uint8_t data[FW_IMAGE_SIZE];
+    int reads;       /**< Number of reads. */
+    uint32_t bytes;  /**< Number of bytes read. */
+};
+
+static lt_ret_t fw_image_read(void *read_ctx, const uint16_t offset, uint8_t *buf, const uint16_t len)
+{
+    struct fw_image_storage_t *storage = (struct fw_image_storage_t *)read_ctx;
+
+    if ((offset > sizeof(storage->data)) || (len > sizeof(storage->data) - offset)) {
+        return LT_FAIL;
+    }
+    memcpy(buf, storage->data + offset, len);
+    storage->reads++;
+    storage->bytes += len;
+
+    return LT_OK;
+}
+
+/** Builds update image, the hashes are not checked by the mocked chip. */
+static lt_ret_t fw_image_build(lt_handle_t *h, struct fw_image_storage_t *storage)
+{
+    memset(storage, 0, sizeof(*storage));
+    lt_ret_t ret = lt_random_bytes(h, storage->data, sizeof(storage->data));
+
+    storage->data[0] = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN;
+    for (int i = 0; i < FW_IMAGE_CHUNKS; i++) {
+        storage->data[FW_IMAGE_REQ_SIZE + i * FW_IMAGE_CHUNK_SIZE] = FW_IMAGE_CHUNK_SIZE - 1;
+    }
+
+    return ret;
+}
+
+/** Mocks replies to given number of Mutable_FW_Update(_Data) L2 Requests with the given L2 status. */
+static lt_ret_t fw_image_mock_responses(lt_handle_t *h, const int count, const uint8_t status)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_mutable_fw_update_rsp_t rsp
+        = {.chip_status = TR01_L1_CHIP_MODE_READY_bit, .status = status, .rsp_len = 0};
+    add_resp_crc(&rsp);
+
+    for (int i = 0; i < count; i++) {
+        if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))
+            || LT_OK != lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp))) {
+            return LT_FAIL;
+        }
+    }
+
+    return LT_OK;
+}
+#endif
+
+void lt_test_mock_fw_image(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_fw_image()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#if !defined(LT_FW_IMAGE) || !defined(ACAB)
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_FW_IMAGE is not enabled or silicon revision is not ACAB, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    struct fw_image_storage_t storage;
+    LT_TEST_ASSERT(LT_OK, fw_image_build(h, &storage));
+
+    lt_fw_image_t img;
+    uint16_t index[2];
+    uint16_t offset, len, next_chunk;
+
+    LT_LOG_INFO("Verifying malformed image and failing reader are rejected...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_image_open(&img, fw_image_read, &storage, sizeof(storage.data) - 1, NULL, 0));
+    LT_TEST_ASSERT(0, lt_fw_image_chunk_count(&img));
+    LT_TEST_ASSERT(LT_FAIL, lt_fw_image_open(&img, fw_image_read, &storage, sizeof(storage.data) + 1, NULL, 0));
+
+    LT_LOG_INFO("Opening image, only the length bytes are read...");
+    storage.reads = 0;
+    storage.bytes = 0;
+    LT_TEST_ASSERT(LT_OK, lt_fw_image_open(&img, fw_image_read, &storage, sizeof(storage.data), index, 2));
+    LT_TEST_ASSERT(1 + FW_IMAGE_CHUNKS, lt_fw_image_chunk_count(&img));
+    LT_TEST_ASSERT(1 + FW_IMAGE_CHUNKS, storage.reads);
+    LT_TEST_ASSERT(1 + FW_IMAGE_CHUNKS, (int)storage.bytes);
+    LT_TEST_ASSERT(0, index[0]);
+    LT_TEST_ASSERT(FW_IMAGE_REQ_SIZE, index[1]);
+
+    LT_LOG_INFO("Looking up chunks, the ones not in the index are walked...");
+    LT_TEST_ASSERT(LT_OK, lt_fw_image_chunk(&img, 0, &offset, &len));
+    LT_TEST_ASSERT(0, offset);
+    LT_TEST_ASSERT(FW_IMAGE_REQ_SIZE, len);
+    LT_TEST_ASSERT(LT_OK, lt_fw_image_chunk(&img, 3, &offset, &len));
+    LT_TEST_ASSERT(FW_IMAGE_REQ_SIZE + 2 * FW_IMAGE_CHUNK_SIZE, offset);
+    LT_TEST_ASSERT(FW_IMAGE_CHUNK_SIZE, len);
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_image_chunk(&img, 1 + FW_IMAGE_CHUNKS, &offset, &len));
+
+    LT_LOG_INFO("Updating with the whole image...");
+    LT_TEST_ASSERT(LT_OK, fw_image_mock_responses(h, 1 + FW_IMAGE_CHUNKS, TR01_L2_STATUS_REQUEST_OK));
+    LT_TEST_ASSERT(LT_OK, lt_fw_image_update(h, &img, TR01_FW_BANK_FW1, 0, &next_chunk));
+    LT_TEST_ASSERT(1 + FW_IMAGE_CHUNKS, next_chunk);
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Updating with image rejected on the second data chunk...");
+    LT_TEST_ASSERT(LT_OK, fw_image_mock_responses(h, 2, TR01_L2_STATUS_REQUEST_OK));
+    LT_TEST_ASSERT(LT_OK, fw_image_mock_responses(h, 1, TR01_L2_STATUS_UNKNOWN_ERR));
+    LT_TEST_ASSERT(LT_L2_UNKNOWN_REQ, lt_fw_image_update(h, &img, TR01_FW_BANK_FW1, 0, &next_chunk));
+    LT_TEST_ASSERT(2, next_chunk);
+
+    LT_LOG_INFO("Resuming the update from the rejected chunk...");
+    LT_TEST_ASSERT(LT_OK, fw_image_mock_responses(h, FW_IMAGE_CHUNKS - 1, TR01_L2_STATUS_REQUEST_OK));
+    LT_TEST_ASSERT(LT_OK, lt_fw_image_update(h, &img, TR01_FW_BANK_FW1, next_chunk, &next_chunk));
+    LT_TEST_ASSERT(1 + FW_IMAGE_CHUNKS, next_chunk);
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
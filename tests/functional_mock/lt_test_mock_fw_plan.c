@@ -0,0 +1,223 @@
+/**
+ * @file lt_test_mock_fw_plan.c
+ * @brief Test multi-bank mutable firmware update overlapping preparation of the images with the bank erase.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_FW_PLAN
+#ifdef ABAB
+/** Size of the test image, written by three Mutable_FW_Update L2 Requests. */
+#define FW_PLAN_IMAGE_SIZE 300
+/** L2 Requests of one step: Mutable_FW_Erase and the parts of the image. */
+#define FW_PLAN_STEP_REQS 4
+/** Size of FW header returned by bootloader of the built silicon revision. */
+#define FW_PLAN_HEADER_SIZE TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V1
+#else
+/** Size of one data chunk including its length byte. */
+#define FW_PLAN_CHUNK_SIZE 20
+/** Size of the test image: update request and two data chunks. */
+#define FW_PLAN_IMAGE_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1 + 2 * FW_PLAN_CHUNK_SIZE)
+/** L2 Requests of one step: the update request and the data chunks. */
+#define FW_PLAN_STEP_REQS 3
+/** Size of FW header returned by bootloader of the built silicon revision. */
+#define FW_PLAN_HEADER_SIZE TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V2
+#endif
+
+/** Maximal number of reported progress events. */
+#define FW_PLAN_MAX_EVENTS 16
+
+/** State shared with the callbacks. */
+struct fw_plan_ctx_t {
+    uint8_t image[FW_PLAN_IMAGE_SIZE];
+    lt_ret_t prepare_ret;
+    int prepared;
+    int events;
+    uint8_t event_step[FW_PLAN_MAX_EVENTS];
+    lt_fw_plan_phase_t event_phase[FW_PLAN_MAX_EVENTS];
+    uint16_t last_offset;
+};
+
+static void fw_plan_build_image(uint8_t *image)
+{
+    for (size_t i = 0; i < FW_PLAN_IMAGE_SIZE; i++) {
+        image[i] = (uint8_t)i;
+    }
+#ifdef ACAB
+    image[0] = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN;
+    image[TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1] = FW_PLAN_CHUNK_SIZE - 1;
+    image[TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1 + FW_PLAN_CHUNK_SIZE] = FW_PLAN_CHUNK_SIZE - 1;
+#endif
+}
+
+static lt_ret_t fw_plan_prepare(void *cb_ctx, uint8_t step, lt_bank_id_t bank_id, const uint8_t **update_data,
+                                uint16_t *update_data_size)
+{
+    struct fw_plan_ctx_t *ctx = (struct fw_plan_ctx_t *)cb_ctx;
+    LT_UNUSED(step);
+    LT_UNUSED(bank_id);
+
+    ctx->prepared++;
+    if (ctx->prepare_ret != LT_OK) {
+        return ctx->prepare_ret;
+    }
+
+    *update_data = ctx->image;
+    *update_data_size = sizeof(ctx->image);
+
+    return LT_OK;
+}
+
+static void fw_plan_progress(void *cb_ctx, uint8_t step, lt_fw_plan_phase_t phase, uint16_t offset, uint16_t size)
+{
+    struct fw_plan_ctx_t *ctx = (struct fw_plan_ctx_t *)cb_ctx;
+
+    LT_TEST_ASSERT(FW_PLAN_IMAGE_SIZE, size);
+    if (ctx->events < FW_PLAN_MAX_EVENTS) {
+        ctx->event_step[ctx->events] = step;
+        ctx->event_phase[ctx->events] = phase;
+    }
+    ctx->events++;
+    ctx->last_offset = offset;
+}
+
+/** Mocks replies to given number of Mutable_FW_Erase and Mutable_FW_Update(_Data) L2 Requests. */
+static lt_ret_t fw_plan_mock_responses(lt_handle_t *h, const int count)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_mutable_fw_update_rsp_t rsp
+        = {.chip_status = TR01_L1_CHIP_MODE_READY_bit, .status = TR01_L2_STATUS_REQUEST_OK, .rsp_len = 0};
+    add_resp_crc(&rsp);
+
+    for (int i = 0; i < count; i++) {
+        if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))
+            || LT_OK != lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp))) {
+            return LT_FAIL;
+        }
+    }
+
+    return LT_OK;
+}
+#endif
+
+void lt_test_mock_fw_plan(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_fw_plan()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_FW_PLAN
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_FW_PLAN is not enabled, skipping.");
+#else
+    static struct fw_plan_ctx_t ctx;
+    static uint8_t first_image[FW_PLAN_IMAGE_SIZE];
+    lt_fw_plan_t plan;
+    uint8_t step;
+    uint16_t offset;
+
+    memset(&ctx, 0, sizeof(ctx));
+    fw_plan_build_image(ctx.image);
+    fw_plan_build_image(first_image);
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Checking parameters...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_plan_init(NULL, NULL, NULL, NULL));
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_init(&plan, NULL, NULL, NULL));
+    // Without the prepare callback, every image has to be given.
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_plan_add(&plan, TR01_FW_BANK_FW1, NULL, 0));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_plan_add(&plan, TR01_FW_BANK_FW1, first_image, 0));
+    for (int i = 0; i < LT_FW_PLAN_MAX_STEPS; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_fw_plan_add(&plan, TR01_FW_BANK_FW1, first_image, sizeof(first_image)));
+    }
+    LT_TEST_ASSERT(LT_FAIL, lt_fw_plan_add(&plan, TR01_FW_BANK_FW1, first_image, sizeof(first_image)));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_plan_run(NULL, &plan));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_plan_progress(NULL, &step, &offset));
+
+    LT_LOG_INFO("Updating CPU and SPECT banks, the second image is prepared during an erase...");
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_init(&plan, fw_plan_prepare, fw_plan_progress, &ctx));
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_add(&plan, TR01_FW_BANK_FW1, first_image, sizeof(first_image)));
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_add(&plan, TR01_FW_BANK_SPECT1, NULL, 0));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_fw_plan_progress(&plan, &step, &offset));
+    LT_TEST_ASSERT(0, step);
+#ifdef LT_SILICON_REV_CHECK
+    LT_TEST_ASSERT(LT_OK, mock_fw_bank_header(h, FW_PLAN_HEADER_SIZE));  // Checked once.
+#endif
+    LT_TEST_ASSERT(LT_OK, fw_plan_mock_responses(h, 2 * FW_PLAN_STEP_REQS));
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_run(h, &plan));
+    LT_TEST_ASSERT(1, ctx.prepared);
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_progress(&plan, &step, &offset));
+    LT_TEST_ASSERT(2, step);
+
+    // Both steps report the erase, every part of the image and the end, the second one also its preparation, which
+    // comes before the erase of its bank is reported (ABAB) or before the erase of the first bank (ACAB).
+    LT_TEST_ASSERT(1 + 2 * (FW_PLAN_STEP_REQS + 1), ctx.events);
+#ifdef ABAB
+    LT_TEST_ASSERT(LT_FW_PLAN_PHASE_ERASED, ctx.event_phase[0]);
+    LT_TEST_ASSERT(1, ctx.event_step[FW_PLAN_STEP_REQS + 1]);
+    LT_TEST_ASSERT(LT_FW_PLAN_PHASE_PREPARED, ctx.event_phase[FW_PLAN_STEP_REQS + 1]);
+#else
+    LT_TEST_ASSERT(1, ctx.event_step[0]);
+    LT_TEST_ASSERT(LT_FW_PLAN_PHASE_PREPARED, ctx.event_phase[0]);
+    LT_TEST_ASSERT(LT_FW_PLAN_PHASE_ERASED, ctx.event_phase[1]);
+#endif
+    LT_TEST_ASSERT(LT_FW_PLAN_PHASE_WRITE, ctx.event_phase[ctx.events - 2]);
+    LT_TEST_ASSERT(1, ctx.event_step[ctx.events - 1]);
+    LT_TEST_ASSERT(LT_FW_PLAN_PHASE_DONE, ctx.event_phase[ctx.events - 1]);
+    LT_TEST_ASSERT(FW_PLAN_IMAGE_SIZE, ctx.last_offset);
+
+    LT_LOG_INFO("Failed preparation ends the plan after the erase, running it again continues...");
+    ctx.prepared = 0;
+    ctx.events = 0;
+    ctx.prepare_ret = LT_FAIL;
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_init(&plan, fw_plan_prepare, NULL, &ctx));
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_add(&plan, TR01_FW_BANK_FW2, first_image, sizeof(first_image)));
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_add(&plan, TR01_FW_BANK_SPECT2, NULL, 0));
+#ifdef ABAB
+    // First step is done, the erase of the second one is answered before the plan ends.
+    LT_TEST_ASSERT(LT_OK, fw_plan_mock_responses(h, FW_PLAN_STEP_REQS + 1));
+    LT_TEST_ASSERT(LT_FAIL, lt_fw_plan_run(h, &plan));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_fw_plan_progress(&plan, &step, &offset));
+    LT_TEST_ASSERT(1, step);
+    ctx.prepare_ret = LT_OK;
+    LT_TEST_ASSERT(LT_OK, fw_plan_mock_responses(h, FW_PLAN_STEP_REQS));
+#else
+    // Image of the second step is prepared during the update request of the first one.
+    LT_TEST_ASSERT(LT_OK, fw_plan_mock_responses(h, 1));
+    LT_TEST_ASSERT(LT_FAIL, lt_fw_plan_run(h, &plan));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_fw_plan_progress(&plan, &step, &offset));
+    LT_TEST_ASSERT(0, step);
+    ctx.prepare_ret = LT_OK;
+    LT_TEST_ASSERT(LT_OK, fw_plan_mock_responses(h, 2 * FW_PLAN_STEP_REQS));
+#endif
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_run(h, &plan));
+    LT_TEST_ASSERT(2, ctx.prepared);
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_progress(&plan, &step, &offset));
+    LT_TEST_ASSERT(2, step);
+    // Finished plan has nothing to do.
+    LT_TEST_ASSERT(LT_OK, lt_fw_plan_run(h, &plan));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,158 @@
+/**
+ * @file lt_test_mock_fw_update_resume.c
+ * @brief Test resumable mutable firmware update with checkpoints (LT_FW_UPDATE_RESUME).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+#ifdef LT_L1_ADAPTIVE_POLL
+#include "lt_l1_poll.h"
+#endif
+
+#if defined(LT_FW_UPDATE_RESUME) && defined(ACAB)
+/** Number of data chunks of the test image. */
+#define FW_RESUME_CHUNKS 3
+/** Size of one chunk including its length byte (length, hash of the next chunk, offset, data). */
+#define FW_RESUME_CHUNK_SIZE (1 + 32 + 2 + 32)
+/** Size of the update request at the beginning of the image, including its length byte. */
+#define FW_RESUME_REQ_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1)
+#ifdef LT_L1_ADAPTIVE_POLL
+/** Busy polls exhausting the time budget of one response, the scheduler polls more often than the fixed loop. */
+#define FW_RESUME_BUSY_POLLS LT_L1_POLL_MAX_TRIES
+#else
+/** Busy polls exhausting the fixed CHIP_STATUS poll loop of one response. */
+#define FW_RESUME_BUSY_POLLS LT_L1_READ_MAX_TRIES
+#endif
+/** Size of the test image. */
+#define FW_RESUME_IMAGE_SIZE (FW_RESUME_REQ_SIZE + FW_RESUME_CHUNKS * FW_RESUME_CHUNK_SIZE)
+
+/** Builds update image, the hashes are not checked by the mocked chip. */
+static lt_ret_t fw_resume_build_image(lt_handle_t *h, uint8_t *image)
+{
+    lt_ret_t ret = lt_random_bytes(h, image, FW_RESUME_IMAGE_SIZE);
+
+    image[0] = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN;
+    for (int i = 0; i < FW_RESUME_CHUNKS; i++) {
+        image[FW_RESUME_REQ_SIZE + i * FW_RESUME_CHUNK_SIZE] = FW_RESUME_CHUNK_SIZE - 1;
+    }
+
+    return ret;
+}
+
+/** Mocks reply with the given L2 status to a Mutable_FW_Update(_Data) L2 Request. */
+static lt_ret_t fw_resume_mock_response(lt_handle_t *h, const uint8_t status)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_mutable_fw_update_rsp_t rsp
+        = {.chip_status = TR01_L1_CHIP_MODE_READY_bit, .status = status, .rsp_len = 0};
+    add_resp_crc(&rsp);
+
+    if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))) {
+        return LT_FAIL;
+    }
+
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp));
+}
+#endif
+
+void lt_test_mock_fw_update_resume(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_fw_update_resume()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#if !defined(LT_FW_UPDATE_RESUME) || !defined(ACAB)
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_FW_UPDATE_RESUME is not enabled or silicon revision is not ACAB, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    uint8_t image[FW_RESUME_IMAGE_SIZE];
+    LT_TEST_ASSERT(LT_OK, fw_resume_build_image(h, image));
+
+    lt_fw_update_session_t s;
+    uint16_t offset, chunks;
+
+    LT_LOG_INFO("Verifying malformed image is rejected...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_update_session_init(&s, image, sizeof(image) - 1, TR01_FW_BANK_FW1));
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_init(&s, image, sizeof(image), TR01_FW_BANK_FW1));
+    LT_TEST_ASSERT(false, lt_fw_update_session_done(&s));
+
+    LT_LOG_INFO("Sending the update request...");
+    LT_TEST_ASSERT(LT_OK, fw_resume_mock_response(h, TR01_L2_STATUS_REQUEST_OK));
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_step(h, &s));
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_progress(&s, &offset, &chunks));
+    LT_TEST_ASSERT(FW_RESUME_REQ_SIZE, offset);
+    LT_TEST_ASSERT(1, chunks);
+
+    LT_LOG_INFO("Sending the first chunk, TROPIC01 is busy for the first attempt...");
+    const mock_latency_t busy
+        = {.req_id = 0, .chip_status = TR01_L1_CHIP_MODE_READY_bit, .polls = FW_RESUME_BUSY_POLLS, .ms = 0};
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_set_next_latency(&h->l2, &busy));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(LT_OK, fw_resume_mock_response(h, TR01_L2_STATUS_REQUEST_OK));
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_step(h, &s));
+    LT_TEST_ASSERT(1, s.retries);
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_progress(&s, &offset, &chunks));
+    LT_TEST_ASSERT(FW_RESUME_REQ_SIZE + FW_RESUME_CHUNK_SIZE, offset);
+    LT_TEST_ASSERT(2, chunks);
+
+    LT_LOG_INFO("Verifying rejected chunk keeps the position of the update...");
+    LT_TEST_ASSERT(LT_OK, fw_resume_mock_response(h, TR01_L2_STATUS_UNKNOWN_ERR));
+    LT_TEST_ASSERT(LT_L2_UNKNOWN_REQ, lt_fw_update_session_run(h, &s));
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_progress(&s, &offset, &chunks));
+    LT_TEST_ASSERT(FW_RESUME_REQ_SIZE + FW_RESUME_CHUNK_SIZE, offset);
+    LT_TEST_ASSERT(2, chunks);
+
+    LT_LOG_INFO("Exporting checkpoint, corrupted one and one of another image are refused...");
+    lt_fw_update_checkpoint_t cp;
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_checkpoint(&s, &cp));
+    memset(&s, 0, sizeof(s));
+    cp.chunks ^= 1;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_update_session_resume(&s, image, sizeof(image), &cp));
+    cp.chunks ^= 1;
+    image[sizeof(image) - 1] ^= 0x01;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_fw_update_session_resume(&s, image, sizeof(image), &cp));
+    image[sizeof(image) - 1] ^= 0x01;
+
+    LT_LOG_INFO("Resuming the update from the checkpoint...");
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_resume(&s, image, sizeof(image), &cp));
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_progress(&s, &offset, &chunks));
+    LT_TEST_ASSERT(FW_RESUME_REQ_SIZE + FW_RESUME_CHUNK_SIZE, offset);
+    for (int i = 1; i < FW_RESUME_CHUNKS; i++) {
+        LT_TEST_ASSERT(LT_OK, fw_resume_mock_response(h, TR01_L2_STATUS_REQUEST_OK));
+    }
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_run(h, &s));
+    LT_TEST_ASSERT(true, lt_fw_update_session_done(&s));
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_progress(&s, &offset, &chunks));
+    LT_TEST_ASSERT(sizeof(image), offset);
+    LT_TEST_ASSERT(1 + FW_RESUME_CHUNKS, chunks);
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Verifying finished update sends nothing...");
+    LT_TEST_ASSERT(LT_OK, lt_fw_update_session_step(h, &s));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,188 @@
+/**
+ * @file lt_test_mock_fw_update_stream.c
+ * @brief Test streamed mutable firmware update with verification of the chunk hashes.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_sha256.h"
+#include "lt_test_common.h"
+
+#if defined(LT_HELPERS) && defined(ACAB)
+/** Number of data chunks of the test image. */
+#define FW_STREAM_CHUNKS 3
+/** Size of firmware data in each chunk. */
+#define FW_STREAM_CHUNK_DATA_LEN 32
+/** Size of one chunk including its length byte (length, hash of the next chunk, offset, data). */
+#define FW_STREAM_CHUNK_SIZE (1 + 32 + 2 + FW_STREAM_CHUNK_DATA_LEN)
+/** Size of the test image. */
+#define FW_STREAM_IMAGE_SIZE (TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1 + FW_STREAM_CHUNKS * FW_STREAM_CHUNK_SIZE)
+/** Offset of the hash of the first chunk in the update request. */
+#define FW_STREAM_REQ_HASH_OFFSET (1 + 64)
+
+/** Image read by fw_stream_reader(). */
+struct fw_stream_image_t {
+    uint8_t data[FW_STREAM_IMAGE_SIZE];
+    size_t pos;
+};
+
+static lt_ret_t fw_stream_reader(void *reader_ctx, uint8_t *buf, const uint16_t len)
+{
+    struct fw_stream_image_t *image = (struct fw_stream_image_t *)reader_ctx;
+
+    if (len > sizeof(image->data) - image->pos) {
+        return LT_FAIL;
+    }
+    memcpy(buf, image->data + image->pos, len);
+    image->pos += len;
+
+    return LT_OK;
+}
+
+/** Feeds chunks of the image one by one, the length byte at the position gives size of the chunk. */
+static lt_ret_t fw_stream_feeder(void *feeder_ctx, const uint8_t **chunk)
+{
+    struct fw_stream_image_t *image = (struct fw_stream_image_t *)feeder_ctx;
+
+    if (image->pos >= sizeof(image->data)) {
+        *chunk = NULL;
+        return LT_OK;
+    }
+    *chunk = image->data + image->pos;
+    image->pos += (size_t)image->data[image->pos] + 1U;
+
+    return LT_OK;
+}
+
+/**
+ * @brief Builds update image with valid hash chain: request announces hash of the first chunk and every chunk announces
+ * hash of the next one.
+ */
+static lt_ret_t fw_stream_build_image(lt_handle_t *h, struct fw_stream_image_t *image)
+{
+    uint8_t next_hash[LT_SHA256_DIGEST_LENGTH] = {0};
+    lt_ret_t ret = lt_sha256_init(h->l3.crypto_ctx);
+
+    memset(image, 0, sizeof(*image));
+    image->data[0] = TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN;
+
+    for (int i = FW_STREAM_CHUNKS - 1; (i >= 0) && (ret == LT_OK); i--) {
+        uint8_t *chunk = image->data + TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1 + i * FW_STREAM_CHUNK_SIZE;
+        chunk[0] = FW_STREAM_CHUNK_SIZE - 1;
+        memcpy(chunk + 1, next_hash, sizeof(next_hash));
+        chunk[1 + 32] = (uint8_t)((i * FW_STREAM_CHUNK_DATA_LEN) & 0xFF);
+        chunk[1 + 33] = (uint8_t)((i * FW_STREAM_CHUNK_DATA_LEN) >> 8);
+        ret = lt_random_bytes(h, chunk + 1 + 34, FW_STREAM_CHUNK_DATA_LEN);
+
+        if (ret == LT_OK) {
+            ret = lt_sha256_start(h->l3.crypto_ctx);
+        }
+        if (ret == LT_OK) {
+            ret = lt_sha256_update(h->l3.crypto_ctx, chunk + 1, FW_STREAM_CHUNK_SIZE - 1);
+        }
+        if (ret == LT_OK) {
+            ret = lt_sha256_finish(h->l3.crypto_ctx, next_hash);
+        }
+    }
+    memcpy(image->data + FW_STREAM_REQ_HASH_OFFSET, next_hash, sizeof(next_hash));
+
+    lt_ret_t ret_deinit = lt_sha256_deinit(h->l3.crypto_ctx);
+    return (ret != LT_OK) ? ret : ret_deinit;
+}
+
+/** Mocks replies to given number of Mutable_FW_Update(_Data) L2 Requests. */
+static lt_ret_t fw_stream_mock_responses(lt_handle_t *h, const int count)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_mutable_fw_update_rsp_t rsp
+        = {.chip_status = TR01_L1_CHIP_MODE_READY_bit, .status = TR01_L2_STATUS_REQUEST_OK, .rsp_len = 0};
+    add_resp_crc(&rsp);
+
+    for (int i = 0; i < count; i++) {
+        if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))
+            || LT_OK != lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp))) {
+            return LT_FAIL;
+        }
+    }
+
+    return LT_OK;
+}
+#endif
+
+void lt_test_mock_fw_update_stream(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_fw_update_stream()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#if !defined(LT_HELPERS) || !defined(ACAB)
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_HELPERS is not enabled or silicon revision is not ACAB, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    struct fw_stream_image_t image;
+    LT_TEST_ASSERT(LT_OK, fw_stream_build_image(h, &image));
+
+#ifdef LT_SILICON_REV_CHECK
+    LT_TEST_ASSERT(LT_OK, mock_fw_bank_header(h, TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V2));  // Checked once.
+#endif
+    LT_LOG_INFO("Streaming valid image...");
+    LT_TEST_ASSERT(LT_OK, fw_stream_mock_responses(h, 1 + FW_STREAM_CHUNKS));
+    LT_TEST_ASSERT(LT_OK, lt_do_mutable_fw_update_stream(h, fw_stream_reader, &image, sizeof(image.data), 0));
+    LT_TEST_ASSERT(sizeof(image.data), image.pos);
+
+    LT_LOG_INFO("Streaming image with corrupted second chunk, it must not be sent...");
+    lt_mock_hal_reset(&h->l2);
+    image.pos = 0;
+    image.data[TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1 + FW_STREAM_CHUNK_SIZE + 1 + 34] ^= 0x01;
+    LT_TEST_ASSERT(LT_OK, fw_stream_mock_responses(h, 2));  // Request and the first chunk only.
+    LT_TEST_ASSERT(LT_FW_UPDATE_HASH_ERR,
+                   lt_do_mutable_fw_update_stream(h, fw_stream_reader, &image, sizeof(image.data), 0));
+    image.data[TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1 + FW_STREAM_CHUNK_SIZE + 1 + 34] ^= 0x01;
+
+    LT_LOG_INFO("Streaming truncated image...");
+    lt_mock_hal_reset(&h->l2);
+    image.pos = 0;
+    LT_TEST_ASSERT(LT_OK, fw_stream_mock_responses(h, FW_STREAM_CHUNKS));
+    LT_TEST_ASSERT(LT_FW_UPDATE_HASH_ERR, lt_do_mutable_fw_update_stream(h, fw_stream_reader, &image,
+                                                                         sizeof(image.data) - FW_STREAM_CHUNK_SIZE, 0));
+
+    LT_LOG_INFO("Feeding valid image chunk by chunk...");
+    lt_mock_hal_reset(&h->l2);
+    image.pos = 0;
+    LT_TEST_ASSERT(LT_OK, fw_stream_mock_responses(h, 1 + FW_STREAM_CHUNKS));
+    LT_TEST_ASSERT(LT_OK, lt_do_mutable_fw_update_feed(h, fw_stream_feeder, &image, 0));
+    LT_TEST_ASSERT(sizeof(image.data), image.pos);
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Feeding image with malformed update request...");
+    image.pos = 0;
+    image.data[0] ^= 0x01;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_do_mutable_fw_update_feed(h, fw_stream_feeder, &image, 0));
+    image.data[0] ^= 0x01;
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,79 @@
+/**
+ * @file lt_test_mock_health.c
+ * @brief Test health monitor piggybacking on L3 Results (LT_HEALTH).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_health(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_health()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_HEALTH
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_HEALTH is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    const uint8_t kcmd[TR01_AES256_KEY_LEN] = {0};
+    uint8_t ping_res[] = {TR01_L3_RESULT_OK};
+    uint8_t ping_res_fail[] = {TR01_L3_RESULT_FAIL};
+    lt_health_t mon;
+    lt_health_stats_t stats;
+
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_health_init(&mon, h, 0));
+    LT_TEST_ASSERT(LT_OK, lt_health_init(&mon, h, 60000));
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kcmd));
+
+    LT_LOG_INFO("Checking without any L3 Result yet, Ping has to be sent...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_health_poll(&mon));
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Checking again within the period, the last L3 Result has to be used...");
+    LT_TEST_ASSERT(LT_OK, lt_health_poll(&mon));
+
+    LT_LOG_INFO("Checking after the period, failed Ping has to be reported...");
+    LT_TEST_ASSERT(LT_OK, lt_health_init(&mon, h, 1));
+    LT_TEST_ASSERT(LT_OK, lt_port_delay(&h->l2, 2));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res_fail, sizeof(ping_res_fail)));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_health_poll(&mon));
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Verifying counters...");
+    LT_TEST_ASSERT(LT_OK, lt_health_get_stats(&mon, &stats));
+    LT_TEST_ASSERT(1, (int)stats.checks);
+    LT_TEST_ASSERT(0, (int)stats.piggybacked);
+    LT_TEST_ASSERT(1, (int)stats.pings);
+    LT_TEST_ASSERT(1, (int)stats.ping_errors);
+
+    LT_LOG_INFO("Checking without Secure Session, Ping has to fail without communication...");
+    lt_l3_invalidate_host_session_data(&h->l3);
+    LT_TEST_ASSERT(LT_OK, lt_port_delay(&h->l2, 2));
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_health_poll(&mon));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
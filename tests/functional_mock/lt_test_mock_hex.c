@@ -0,0 +1,64 @@
+/**
+ * @file lt_test_mock_hex.c
+ * @brief Test hex encoding and decoding shared by lt_print_bytes() and the debug helpers.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_hex.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_hex(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_hex()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    LT_UNUSED(h);
+    uint8_t bytes[256];
+    uint8_t decoded[256];
+    char hex[2 * sizeof(bytes) + 1];
+
+    for (size_t i = 0; i < sizeof(bytes); i++) {
+        bytes[i] = (uint8_t)i;
+    }
+
+    LT_LOG_INFO("Encoding all byte values in both cases...");
+    lt_hex_encode(hex, bytes, sizeof(bytes), true);
+    LT_TEST_ASSERT(0, memcmp(hex, "000102", 6));
+    LT_TEST_ASSERT(0, memcmp(hex + 2 * 0x9A, "9A", 2));
+    LT_TEST_ASSERT(0, memcmp(hex + 2 * 0xFF, "FF", 2));
+    lt_hex_encode(hex, bytes, sizeof(bytes), false);
+    LT_TEST_ASSERT(0, memcmp(hex + 2 * 0xAB, "abac", 4));
+
+    LT_LOG_INFO("Decoding encoded bytes back...");
+    LT_TEST_ASSERT(LT_OK, lt_hex_decode(decoded, hex, sizeof(decoded)));
+    LT_TEST_ASSERT(0, memcmp(decoded, bytes, sizeof(bytes)));
+    LT_TEST_ASSERT(LT_OK, lt_hex_decode(decoded, "0aF9", 2));
+    LT_TEST_ASSERT(1, (decoded[0] == 0x0A) && (decoded[1] == 0xF9));
+
+    LT_LOG_INFO("Decoding characters which are not hex digits...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_hex_decode(decoded, "0G", 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_hex_decode(decoded, "@0", 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_hex_decode(decoded, "0`", 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_hex_decode(decoded, "0:", 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_hex_decode(decoded, "0\xC1", 1));
+
+#ifdef LT_HELPERS
+    LT_LOG_INFO("Printing bytes by lt_print_bytes()...");
+    LT_TEST_ASSERT(LT_OK, lt_print_bytes((const uint8_t[]){0xDE, 0xAD, 0x01}, 3, hex, 7));
+    LT_TEST_ASSERT(0, strcmp(hex, "DEAD01"));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_print_bytes((const uint8_t[]){0xDE, 0xAD, 0x01}, 3, hex, 6));
+    LT_TEST_ASSERT(0, hex[0]);
+    LT_TEST_ASSERT(LT_OK, lt_print_bytes(bytes, 0, hex, 1));
+    LT_TEST_ASSERT(0, hex[0]);
+#endif
+}
@@ -0,0 +1,88 @@
+/**
+ * @file lt_test_mock_i_config_cache.c
+ * @brief Test I-config cache in the handle (LT_I_CONFIG_CACHE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_i_config_cache(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_i_config_cache()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_I_CONFIG_CACHE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_I_CONFIG_CACHE is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+    uint32_t obj = 0;
+
+    LT_LOG_INFO("Reading I-config object, it has to be read from TROPIC01...");
+    uint8_t read_res[] = {TR01_L3_RESULT_OK, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, read_res, sizeof(read_res)));
+    LT_TEST_ASSERT(LT_OK, lt_i_config_read(h, TR01_CFG_UAP_PING_ADDR, &obj));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(1, (obj == 0xFFFFFFFF));
+    LT_TEST_ASSERT(1, (int)h->l3.i_config.misses);
+
+    LT_LOG_INFO("Reading it again, it has to be answered from the cache...");
+    obj = 0;
+    LT_TEST_ASSERT(LT_OK, lt_i_config_read(h, TR01_CFG_UAP_PING_ADDR, &obj));
+    LT_TEST_ASSERT(1, (obj == 0xFFFFFFFF));
+    LT_TEST_ASSERT(1, (int)h->l3.i_config.hits);
+
+    LT_LOG_INFO("Clearing bit 3, the cached object has to follow...");
+    uint8_t write_res[] = {TR01_L3_RESULT_OK};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, write_res, sizeof(write_res)));
+    LT_TEST_ASSERT(LT_OK, lt_i_config_write(h, TR01_CFG_UAP_PING_ADDR, 3));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(LT_OK, lt_i_config_read(h, TR01_CFG_UAP_PING_ADDR, &obj));
+    LT_TEST_ASSERT(1, (obj == 0xFFFFFFF7));
+
+    LT_LOG_INFO("Clearing bit 3 again, no L3 Command has to be sent...");
+    LT_TEST_ASSERT(LT_OK, lt_i_config_write(h, TR01_CFG_UAP_PING_ADDR, 3));
+
+    LT_LOG_INFO("Invalidating the cache, the object has to be read from TROPIC01 again...");
+    LT_TEST_ASSERT(LT_OK, lt_i_config_cache_invalidate(h));
+    read_res[4] = 0xF7;
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, read_res, sizeof(read_res)));
+    LT_TEST_ASSERT(LT_OK, lt_i_config_read(h, TR01_CFG_UAP_PING_ADDR, &obj));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(1, (obj == 0xFFFFFFF7));
+    LT_TEST_ASSERT(2, (int)h->l3.i_config.misses);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,132 @@
+/**
+ * @file lt_test_mock_idle.c
+ * @brief Test idle manager putting TROPIC01 to sleep (LT_IDLE_MGR).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_IDLE_MGR
+/** Mocks reply to Sleep_Req. */
+static lt_ret_t idle_mock_sleep(lt_handle_t *h)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_sleep_rsp_t rsp
+        = {.chip_status = TR01_L1_CHIP_MODE_READY_bit, .status = TR01_L2_STATUS_REQUEST_OK, .rsp_len = 0};
+    add_resp_crc(&rsp);
+
+    if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))) {
+        return LT_FAIL;
+    }
+
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp));
+}
+
+/** Mocks reply to Handshake_Req, which TROPIC01 rejects. */
+static lt_ret_t idle_mock_handshake_rejected(lt_handle_t *h)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_handshake_rsp_t rsp
+        = {.chip_status = TR01_L1_CHIP_MODE_READY_bit, .status = TR01_L2_STATUS_UNKNOWN_ERR, .rsp_len = 0};
+    add_resp_crc(&rsp);
+
+    if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))) {
+        return LT_FAIL;
+    }
+
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp));
+}
+#endif
+
+void lt_test_mock_idle(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_idle()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_IDLE_MGR
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_IDLE_MGR is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    const uint8_t stpub[TR01_STPUB_LEN] = {0x01};
+    const uint8_t shipriv[TR01_SHIPRIV_LEN] = {0x02};
+    const uint8_t shipub[TR01_SHIPUB_LEN] = {0x03};
+    const uint8_t kcmd[TR01_AES256_KEY_LEN] = {0};
+    lt_idle_policy_t policy = {.idle_ms = 60000, .restore_session = true, .prepare_cache = false};
+    lt_idle_t idle;
+    lt_idle_stats_t stats;
+
+    LT_LOG_INFO("Verifying TROPIC01 is not put to sleep before the idle time...");
+    LT_TEST_ASSERT(LT_OK, lt_idle_init(&idle, h, &policy));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_idle_set_session(&idle, stpub, TR01_PAIRING_KEY_SLOT_INDEX_3 + 1, shipriv, shipub));
+    LT_TEST_ASSERT(LT_OK, lt_idle_set_session(&idle, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, shipriv, shipub));
+    LT_TEST_ASSERT(LT_OK, lt_idle_begin(&idle));
+    LT_TEST_ASSERT(LT_OK, lt_idle_end(&idle));
+    LT_TEST_ASSERT(LT_OK, lt_idle_poll(&idle));
+    LT_TEST_ASSERT(false, lt_idle_asleep(&idle));
+
+    LT_LOG_INFO("Verifying TROPIC01 is not put to sleep while in use...");
+    policy.idle_ms = 1;
+    LT_TEST_ASSERT(LT_OK, lt_idle_init(&idle, h, &policy));
+    LT_TEST_ASSERT(LT_OK, lt_idle_set_session(&idle, stpub, TR01_PAIRING_KEY_SLOT_INDEX_0, shipriv, shipub));
+    LT_TEST_ASSERT(LT_OK, lt_idle_begin(&idle));
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kcmd));
+    LT_TEST_ASSERT(LT_OK, lt_port_delay(&h->l2, 2));
+    LT_TEST_ASSERT(LT_OK, lt_idle_poll(&idle));
+    LT_TEST_ASSERT(false, lt_idle_asleep(&idle));
+
+    LT_LOG_INFO("Putting TROPIC01 to sleep after the idle time...");
+    LT_TEST_ASSERT(LT_OK, lt_idle_end(&idle));
+    LT_TEST_ASSERT(LT_OK, lt_port_delay(&h->l2, 2));
+    LT_TEST_ASSERT(LT_OK, idle_mock_sleep(h));
+    LT_TEST_ASSERT(LT_OK, lt_idle_poll(&idle));
+    LT_TEST_ASSERT(true, lt_idle_asleep(&idle));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_OFF, h->l3.session_status);
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Waking TROPIC01, restore of the Secure Session is rejected...");
+    LT_TEST_ASSERT(LT_OK, idle_mock_handshake_rejected(h));
+    LT_TEST_ASSERT(LT_L2_UNKNOWN_REQ, lt_idle_begin(&idle));
+    LT_TEST_ASSERT(false, lt_idle_asleep(&idle));
+    LT_TEST_ASSERT(LT_OK, lt_idle_end(&idle));
+
+    LT_LOG_INFO("Sleeping and waking without Secure Session, nothing is restored...");
+    LT_TEST_ASSERT(LT_OK, lt_port_delay(&h->l2, 2));
+    LT_TEST_ASSERT(LT_OK, idle_mock_sleep(h));
+    LT_TEST_ASSERT(LT_OK, lt_idle_poll(&idle));
+    LT_TEST_ASSERT(LT_OK, lt_idle_begin(&idle));
+    LT_TEST_ASSERT(LT_OK, lt_idle_end(&idle));
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+
+    LT_LOG_INFO("Verifying counters...");
+    LT_TEST_ASSERT(LT_OK, lt_idle_get_stats(&idle, &stats));
+    LT_TEST_ASSERT(2, (int)stats.sleeps);
+    LT_TEST_ASSERT(2, (int)stats.wakes);
+    LT_TEST_ASSERT(0, (int)stats.restores);
+    LT_TEST_ASSERT(1, (int)stats.restore_errors);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,104 @@
+/**
+ * @file lt_test_mock_l2_async.c
+ * @brief Test asynchronous L2 engine (LT_L2_ASYNC).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_L2_ASYNC
+/** Counts calls of the callback and keeps the last result. */
+struct async_test_ctx_t {
+    int calls;
+    lt_ret_t ret;
+};
+
+static void async_test_cb(lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx)
+{
+    struct async_test_ctx_t *ctx = (struct async_test_ctx_t *)cb_ctx;
+
+    LT_UNUSED(op);
+    ctx->calls++;
+    ctx->ret = ret;
+}
+#endif
+
+void lt_test_mock_l2_async(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_l2_async()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_L2_ASYNC
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_L2_ASYNC is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    uint8_t no_resp[] = {TR01_L1_CHIP_MODE_READY_bit, 0xFF, 0xFF};
+
+    LT_LOG_INFO("Mocking Get_Info reply, which is not ready at the first attempt...");
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, no_resp, sizeof(no_resp)));
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = TR01_L2_GET_INFO_RISCV_FW_SIZE,
+                                                 .object = {0x00, 0x00, 0x00, 0x02}};
+    add_resp_crc(&get_info_resp);
+    LT_TEST_ASSERT(
+        LT_OK, lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp, calc_mocked_resp_len(&get_info_resp)));
+
+    LT_LOG_INFO("Starting asynchronous Get_Info request...");
+    struct lt_l2_get_info_req_t *p_l2_req = (struct lt_l2_get_info_req_t *)h->l2.buff;
+    p_l2_req->req_id = TR01_L2_GET_INFO_REQ_ID;
+    p_l2_req->req_len = TR01_L2_GET_INFO_REQ_LEN;
+    p_l2_req->object_id = TR01_L2_GET_INFO_REQ_OBJECT_ID_RISCV_FW_VERSION;
+    p_l2_req->block_index = TR01_L2_GET_INFO_REQ_BLOCK_INDEX_DATA_CHUNK_0_127;
+
+    lt_l2_async_t op;
+    memset(&op, 0, sizeof(op));
+    struct async_test_ctx_t ctx = {0, LT_FAIL};
+    LT_TEST_ASSERT(LT_OK, lt_l2_async_send(&op, &h->l2, async_test_cb, &ctx));
+    LT_TEST_ASSERT(1, lt_l2_async_busy(&op));
+
+    LT_LOG_INFO("Starting another request while the first one is in flight fails...");
+    LT_TEST_ASSERT(LT_FAIL, lt_l2_async_send(&op, &h->l2, async_test_cb, &ctx));
+    LT_TEST_ASSERT(LT_FAIL, lt_l2_async_send_encrypted_cmd(&op, &h->l2, h->l3.buff, h->l3.buff_len, NULL, NULL));
+    LT_TEST_ASSERT(1, lt_l2_async_busy(&op));
+
+    LT_LOG_INFO("Processing, response is not ready yet...");
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_l2_async_process(&op));
+    LT_TEST_ASSERT(0, ctx.calls);
+
+    LT_LOG_INFO("Processing, response is received...");
+    LT_TEST_ASSERT(LT_OK, lt_l2_async_process(&op));
+    LT_TEST_ASSERT(1, ctx.calls);
+    LT_TEST_ASSERT(LT_OK, ctx.ret);
+    LT_TEST_ASSERT(0, lt_l2_async_busy(&op));
+    LT_TEST_ASSERT(0, memcmp(((struct lt_l2_get_info_rsp_t *)h->l2.buff)->object, get_info_resp.object,
+                             TR01_L2_GET_INFO_RISCV_FW_SIZE));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,98 @@
+/**
+ * @file lt_test_mock_l3_buff_arena.c
+ * @brief Test arena of L3 buffers shared by several handles (LT_L3_BUFF_ARENA).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l3.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_l3_buff_arena(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_l3_buff_arena()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_L3_BUFF_ARENA
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_L3_BUFF_ARENA is not enabled, skipping.");
+#else
+    LT_LOG_INFO("Initializing arena with a single buffer...");
+    static uint8_t mem[LT_L3_BUFF_ARENA_MEM_SIZE(1)] __attribute__((aligned(LT_DMA_BUFF_ALIGN)));
+    lt_l3_buff_arena_t arena;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_l3_buff_arena_init(&arena, mem, sizeof(mem) - 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_l3_buff_arena_init(&arena, mem + 1, sizeof(mem)));
+    LT_TEST_ASSERT(LT_OK, lt_l3_buff_arena_init(&arena, mem, sizeof(mem)));
+    LT_TEST_ASSERT(LT_OK, lt_l3_buff_arena_attach(h, &arena));
+    LT_TEST_ASSERT(1, h->l3.buff == NULL);
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    LT_TEST_ASSERT(0, lt_l3_buff_arena_in_use(&arena));
+
+    LT_LOG_INFO("Pinging, the buffer is borrowed and returned...");
+    // Long enough for L3 buffer to be used even with LT_L3_FAST_PATH.
+    uint8_t ping_out[128];
+    uint8_t ping_in[sizeof(ping_out)] = {0};
+    uint8_t ping_res[1 + sizeof(ping_out)] = {TR01_L3_RESULT_OK};
+    memset(ping_out, 0x5A, sizeof(ping_out));
+    memcpy(ping_res + 1, ping_out, sizeof(ping_out));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_ping(h, ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, memcmp(ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, lt_l3_buff_arena_in_use(&arena));
+    LT_TEST_ASSERT(1, arena.borrows);
+    LT_TEST_ASSERT(1, arena.peak);
+    LT_TEST_ASSERT(1, h->l3.buff == NULL);
+
+    LT_LOG_INFO("Mocking failed L3 Result, the buffer is returned too...");
+    uint8_t fail_res[] = {TR01_L3_RESULT_FAIL};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, fail_res, sizeof(fail_res)));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_ping(h, ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, lt_l3_buff_arena_in_use(&arena));
+    LT_TEST_ASSERT(2, arena.borrows);
+
+    LT_LOG_INFO("Verifying another handle cannot borrow while the only buffer is held...");
+    LT_TEST_ASSERT(LT_OK, lt_out__ping(h, ping_out, sizeof(ping_out)));
+    LT_TEST_ASSERT(1, lt_l3_buff_arena_in_use(&arena));
+    lt_handle_t h2 = *h;
+    h2.l3.buff = NULL;
+    arena.timeout_ms = 0;
+    LT_TEST_ASSERT(LT_L3_BUFF_ARENA_EMPTY, lt_out__ping(&h2, ping_out, sizeof(ping_out)));
+    LT_TEST_ASSERT(1, arena.waits);
+    LT_TEST_ASSERT(3, arena.borrows);
+
+    LT_LOG_INFO("Terminating the Secure Session, the held buffer is returned...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+    LT_TEST_ASSERT(0, lt_l3_buff_arena_in_use(&arena));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+    LT_TEST_ASSERT(LT_OK, lt_l3_buff_arena_attach(h, NULL));
+#endif
+}
@@ -0,0 +1,114 @@
+/**
+ * @file lt_test_mock_l3_chunking.c
+ * @brief Test splitting of L3 Commands and L3 Results into several L2 chunks.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+/** Size of R memory data used in this test, L3 packets of both the command and the result take 2 chunks. */
+#define LT_TEST_MOCK_CHUNKING_DATA_SIZE 444
+
+void lt_test_mock_l3_chunking(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_l3_chunking()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+#ifdef LT_STATS
+    LT_TEST_ASSERT(LT_OK, lt_reset_stats(h));
+#endif
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    uint8_t data[LT_TEST_MOCK_CHUNKING_DATA_SIZE];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, data, sizeof(data)));
+
+    // ----------------------------------------------------------------------------------------------------------
+
+#ifdef LT_L3_BUFF_PROFILE_SIGN_RANDOM
+    LT_LOG_INFO("Checking that R_Mem_Data_Write and R_Mem_Data_Read do not fit the L3 buffer...");
+    uint8_t data_read[LT_TEST_MOCK_CHUNKING_DATA_SIZE];
+    uint16_t data_read_size;
+    LT_TEST_ASSERT(LT_L3_BUFFER_TOO_SMALL, lt_r_mem_data_write(h, 0, data, sizeof(data)));
+    LT_TEST_ASSERT(LT_L3_BUFFER_TOO_SMALL, lt_r_mem_data_read(h, 0, data_read, sizeof(data_read), &data_read_size));
+#else
+    LT_LOG_INFO("Mocking R_Mem_Data_Write sent in 2 chunks...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 2));
+
+    uint8_t r_mem_data_write_plaintext[] = {
+        TR01_L3_RESULT_OK,
+    };
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, r_mem_data_write_plaintext, sizeof(r_mem_data_write_plaintext)));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_data_write(h, 0, data, sizeof(data)));
+
+    // ----------------------------------------------------------------------------------------------------------
+
+    LT_LOG_INFO("Mocking R_Mem_Data_Read received in 2 chunks...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+
+    // RESULT, 3B of padding and the data.
+    uint8_t r_mem_data_read_plaintext[TR01_L3_RESULT_SIZE + 3 + LT_TEST_MOCK_CHUNKING_DATA_SIZE] = {
+        TR01_L3_RESULT_OK,
+    };
+    memcpy(r_mem_data_read_plaintext + TR01_L3_RESULT_SIZE + 3, data, sizeof(data));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, r_mem_data_read_plaintext, sizeof(r_mem_data_read_plaintext)));
+
+    uint8_t data_read[LT_TEST_MOCK_CHUNKING_DATA_SIZE];
+    uint16_t data_read_size;
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_data_read(h, 0, data_read, sizeof(data_read), &data_read_size));
+    LT_TEST_ASSERT(LT_TEST_MOCK_CHUNKING_DATA_SIZE, data_read_size);
+    LT_TEST_ASSERT(0, memcmp(data, data_read, sizeof(data)));
+
+#ifdef LT_STATS
+    LT_LOG_INFO("Checking runtime statistics...");
+    lt_stats_t stats;
+    LT_TEST_ASSERT(LT_OK, lt_get_stats(h, &stats));
+    LT_TEST_ASSERT(3, stats.l2_chunks_tx);
+    LT_TEST_ASSERT(3, stats.l2_chunks_rx);
+    LT_TEST_ASSERT(0, stats.l2_crc_errors);
+    LT_TEST_ASSERT(2, stats.l3_nonce);
+    LT_TEST_ASSERT(2, stats.l3_nonce_max);
+    LT_TEST_ASSERT(TR01_L3_R_MEM_DATA_WRITE_CMD_ID, stats.l3_cmds[0].cmd_id);
+    LT_TEST_ASSERT(1, stats.l3_cmds[0].count);
+    LT_TEST_ASSERT(TR01_L3_R_MEM_DATA_READ_CMD_ID, stats.l3_cmds[1].cmd_id);
+    LT_TEST_ASSERT(1, stats.l3_cmds[1].count);
+    LT_TEST_ASSERT(0, stats.l3_cmds[2].count);
+    LT_TEST_ASSERT(1, stats.l1_spi_bytes > 0);
+#endif
+#endif  // LT_L3_BUFF_PROFILE_SIGN_RANDOM
+
+    // ----------------------------------------------------------------------------------------------------------
+
+    LT_LOG_INFO("Terminating the Secure Session...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+}
@@ -0,0 +1,103 @@
+/**
+ * @file lt_test_mock_l3_fast_path.c
+ * @brief Test execution of small L3 commands in a single L2 chunk without the L3 buffer (LT_L3_FAST_PATH).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l3.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+/** Number of bytes of L3 buffer checked to stay untouched. */
+#define LT_TEST_MOCK_FAST_PATH_POISON_LEN 64
+
+void lt_test_mock_l3_fast_path(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_l3_fast_path()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_L3_FAST_PATH
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_L3_FAST_PATH is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    uint8_t poison[LT_TEST_MOCK_FAST_PATH_POISON_LEN];
+    memset(poison, 0xA5, sizeof(poison));
+    memcpy(h->l3.buff, poison, sizeof(poison));
+
+    LT_LOG_INFO("Reading monotonic counter...");
+    uint8_t mcounter_res[] = {TR01_L3_RESULT_OK, 0, 0, 0, 0x04, 0x03, 0x02, 0x01};
+    uint32_t mcounter_value = 0;
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, mcounter_res, sizeof(mcounter_res)));
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_get(h, TR01_MCOUNTER_INDEX_3, &mcounter_value));
+    LT_TEST_ASSERT(1, mcounter_value == 0x01020304);
+
+    LT_LOG_INFO("Reading R-Config object...");
+    uint8_t r_config_res[] = {TR01_L3_RESULT_OK, 0, 0, 0, 0xDD, 0xCC, 0xBB, 0xAA};
+    uint32_t r_config_value = 0;
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, r_config_res, sizeof(r_config_res)));
+    LT_TEST_ASSERT(LT_OK, lt_r_config_read(h, TR01_CFG_START_UP_ADDR, &r_config_value));
+    LT_TEST_ASSERT(1, r_config_value == 0xAABBCCDD);
+
+    LT_LOG_INFO("Erasing ECC key...");
+    uint8_t erase_res[] = {TR01_L3_RESULT_OK};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, erase_res, sizeof(erase_res)));
+    LT_TEST_ASSERT(LT_OK, lt_ecc_key_erase(h, TR01_ECC_SLOT_7));
+
+    LT_LOG_INFO("Pinging with short message...");
+    uint8_t ping_res[TR01_L3_RESULT_SIZE + 110] = {TR01_L3_RESULT_OK};
+    uint8_t ping_in[110] = {0};
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, ping_res + TR01_L3_RESULT_SIZE, sizeof(ping_res) - TR01_L3_RESULT_SIZE));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, TR01_L3_RESULT_SIZE + 16));
+    LT_TEST_ASSERT(LT_OK, lt_ping(h, ping_res + TR01_L3_RESULT_SIZE, ping_in, 16));
+    LT_TEST_ASSERT(0, memcmp(ping_res + TR01_L3_RESULT_SIZE, ping_in, 16));
+
+    LT_LOG_INFO("Verifying L3 buffer was not touched...");
+    LT_TEST_ASSERT(0, memcmp(h->l3.buff, poison, sizeof(poison)));
+
+    LT_LOG_INFO("Pinging with message too long for the fast path...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_ping(h, ping_res + TR01_L3_RESULT_SIZE, ping_in, sizeof(ping_in)));
+    LT_TEST_ASSERT(0, memcmp(ping_res + TR01_L3_RESULT_SIZE, ping_in, sizeof(ping_in)));
+    LT_TEST_ASSERT(1, memcmp(h->l3.buff, poison, sizeof(poison)) != 0);
+
+    LT_LOG_INFO("Mocking result of wrong size, the session is invalidated...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, mcounter_res, 4));
+    LT_TEST_ASSERT(LT_L3_RES_SIZE_ERROR, lt_mcounter_get(h, TR01_MCOUNTER_INDEX_3, &mcounter_value));
+    LT_TEST_ASSERT(1, h->l3.session_status != LT_SECURE_SESSION_ON);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
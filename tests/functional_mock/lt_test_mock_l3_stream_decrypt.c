@@ -0,0 +1,81 @@
+/**
+ * @file lt_test_mock_l3_stream_decrypt.c
+ * @brief Test decryption of L3 Results straight into caller's buffer (LT_L3_STREAM_DECRYPT).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_l3_stream_decrypt(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_l3_stream_decrypt()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_L3_STREAM_DECRYPT
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_L3_STREAM_DECRYPT is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    // RESULT, 3B of padding and the data.
+    uint8_t res[TR01_L3_RESULT_SIZE + 3 + 32] = {TR01_L3_RESULT_OK};
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, res + TR01_L3_RESULT_SIZE + 3, sizeof(res) - TR01_L3_RESULT_SIZE - 3));
+    uint8_t out[sizeof(res) - TR01_L3_RESULT_SIZE - 3];
+    const uint8_t zeros[sizeof(out)] = {0};
+
+    LT_LOG_INFO("Mocking Random_Value_Get, random bytes are decrypted into the output buffer...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, res, sizeof(res)));
+    LT_TEST_ASSERT(LT_OK, lt_random_value_get(h, out, sizeof(out)));
+    LT_TEST_ASSERT(0, memcmp(out, res + TR01_L3_RESULT_SIZE + 3, sizeof(out)));
+
+    LT_LOG_INFO("Mocking R_Mem_Data_Read into too small buffer, nothing is left in it...");
+    uint16_t data_read_size;
+    memset(out, 0xAA, sizeof(out));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, res, sizeof(res)));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_r_mem_data_read(h, 0, out, sizeof(out) / 2, &data_read_size));
+    LT_TEST_ASSERT(sizeof(out), data_read_size);
+    LT_TEST_ASSERT(0, memcmp(out, zeros, sizeof(out) / 2));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+
+    LT_LOG_INFO("Mocking Random_Value_Get with invalid tag, unauthenticated bytes are wiped...");
+    memset(out, 0xAA, sizeof(out));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    // Encrypting with another nonce makes the tag invalid.
+    h->l3.decryption_IV[0] ^= 1;
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, res, sizeof(res)));
+    h->l3.decryption_IV[0] ^= 1;
+    LT_TEST_ASSERT(LT_CRYPTO_ERR, lt_random_value_get(h, out, sizeof(out)));
+    LT_TEST_ASSERT(0, memcmp(out, zeros, sizeof(out)));
+    LT_TEST_ASSERT(1, h->l3.session_status != LT_SECURE_SESSION_ON);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,94 @@
+/**
+ * @file lt_test_mock_l3_stream_encrypt.c
+ * @brief Test encryption of L3 Commands chunk by chunk while they are sent (LT_L3_STREAM_ENCRYPT).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l3.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_aesgcm.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+/** Ping message length, TAG of the L3 Command starts in the second chunk and ends in the third one. */
+#define LT_TEST_MOCK_STREAM_ENCRYPT_MSG_LEN 492
+
+void lt_test_mock_l3_stream_encrypt(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_l3_stream_encrypt()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_L3_STREAM_ENCRYPT
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_L3_STREAM_ENCRYPT is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    static uint8_t msg[LT_TEST_MOCK_STREAM_ENCRYPT_MSG_LEN];
+    static uint8_t msg_in[LT_TEST_MOCK_STREAM_ENCRYPT_MSG_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, msg, sizeof(msg)));
+
+    LT_LOG_INFO("Verifying chunks encrypted one by one give the same L3 packet as encryption at once...");
+    const size_t packet_size = TR01_L3_SIZE_SIZE + TR01_L3_PING_CMD_SIZE_MIN + sizeof(msg) + TR01_L3_TAG_SIZE;
+    static uint8_t expected[TR01_L3_SIZE_SIZE + TR01_L3_PING_CMD_SIZE_MIN + LT_TEST_MOCK_STREAM_ENCRYPT_MSG_LEN
+                            + TR01_L3_TAG_SIZE];
+    // The streaming encryption takes the nonce, the same one is used for the reference.
+    uint8_t iv[TR01_L3_IV_SIZE];
+    memcpy(iv, h->l3.encryption_IV, sizeof(iv));
+    h->l3.encrypt_stream = LT_L3_ENCRYPT_STREAM_REQ;
+    LT_TEST_ASSERT(LT_OK, lt_out__ping(h, msg, sizeof(msg)));
+    LT_TEST_ASSERT(LT_L3_ENCRYPT_STREAM_ON, h->l3.encrypt_stream);
+    h->l3.encrypt_stream = LT_L3_ENCRYPT_STREAM_OFF;
+    memcpy(expected, h->l3.buff, packet_size);
+    for (size_t offset = 0; offset < packet_size; offset += TR01_L2_CHUNK_MAX_DATA_SIZE) {
+        const size_t len = lt_min(packet_size - offset, (size_t)TR01_L2_CHUNK_MAX_DATA_SIZE);
+        LT_TEST_ASSERT(LT_OK, lt_l3_encrypt_stream_chunk(&h->l3, h->l3.buff + offset, (uint8_t)len));
+    }
+    LT_TEST_ASSERT(LT_OK, lt_aesgcm_encrypt(h->l3.crypto_ctx, iv, TR01_L3_IV_SIZE, (uint8_t *)"", 0,
+                                            expected + TR01_L3_SIZE_SIZE, packet_size - TR01_L3_SIZE_SIZE
+                                            - TR01_L3_TAG_SIZE, expected + TR01_L3_SIZE_SIZE,
+                                            packet_size - TR01_L3_SIZE_SIZE));
+    LT_TEST_ASSERT(0, memcmp(expected, h->l3.buff, packet_size));
+    // The command was not sent, TROPIC01 would expect the same nonce.
+    memcpy(h->l3.encryption_IV, iv, sizeof(iv));
+
+    LT_LOG_INFO("Mocking Ping sent in 3 chunks...");
+    static uint8_t ping_res[TR01_L3_RESULT_SIZE + LT_TEST_MOCK_STREAM_ENCRYPT_MSG_LEN] = {TR01_L3_RESULT_OK};
+    memcpy(ping_res + TR01_L3_RESULT_SIZE, msg, sizeof(msg));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 3));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_ping(h, msg, msg_in, sizeof(msg)));
+    LT_TEST_ASSERT(0, memcmp(msg, msg_in, sizeof(msg)));
+    LT_TEST_ASSERT(LT_L3_ENCRYPT_STREAM_OFF, h->l3.encrypt_stream);
+
+    LT_LOG_INFO("Terminating the Secure Session...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
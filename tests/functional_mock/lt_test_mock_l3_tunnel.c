@@ -0,0 +1,108 @@
+/**
+ * @file lt_test_mock_l3_tunnel.c
+ * @brief Test transfer of L3 packets through a bridge of the port (LT_PORT_L3_TUNNEL).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_crc16.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_frame_check.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_PORT_L3_TUNNEL
+/** Length of the Ping message, the L3 packets take several L2 chunks. */
+#define L3_TUNNEL_PING_LEN 600
+/** Number of L2 chunks of the L3 Command packet of the Ping. */
+#define L3_TUNNEL_PING_CHUNKS                                                                        \
+    ((TR01_L3_SIZE_SIZE + 1 + L3_TUNNEL_PING_LEN + TR01_L3_TAG_SIZE + TR01_L2_CHUNK_MAX_DATA_SIZE - 1) \
+     / TR01_L2_CHUNK_MAX_DATA_SIZE)
+
+/** Mocks L2 Responses to the chunks of the Ping and its L3 Result, pings and checks the message came back. */
+static void l3_tunnel_ping(lt_handle_t *h, const uint8_t fill)
+{
+    static uint8_t ping_out[L3_TUNNEL_PING_LEN];
+    static uint8_t ping_in[L3_TUNNEL_PING_LEN];
+    static uint8_t ping_res[TR01_L3_RESULT_SIZE + L3_TUNNEL_PING_LEN];
+
+    memset(ping_out, fill, sizeof(ping_out));
+    memset(ping_in, 0, sizeof(ping_in));
+    ping_res[0] = TR01_L3_RESULT_OK;
+    memcpy(ping_res + TR01_L3_RESULT_SIZE, ping_out, sizeof(ping_out));
+
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, L3_TUNNEL_PING_CHUNKS));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_ping(h, ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, memcmp(ping_out, ping_in, sizeof(ping_out)));
+}
+#endif
+
+void lt_test_mock_l3_tunnel(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_l3_tunnel()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_PORT_L3_TUNNEL
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_PORT_L3_TUNNEL is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)h->l2.device;
+    LT_TEST_ASSERT(0, (int)dev->tunnel_calls);
+    dev->tunnel_unsupported = false;
+
+    LT_LOG_INFO("Pinging through the bridge, it transfers all chunks...");
+    l3_tunnel_ping(h, 0x5A);
+    LT_TEST_ASSERT(1, (int)dev->tunnel_calls);
+    LT_TEST_ASSERT(0, (int)dev->mock_queue_count);
+
+    LT_LOG_INFO("Pinging with the bridge not available, libtropic transfers the chunks itself...");
+    dev->tunnel_unsupported = true;
+    l3_tunnel_ping(h, 0xA5);
+    LT_TEST_ASSERT(2, (int)dev->tunnel_calls);
+    LT_TEST_ASSERT(0, (int)dev->mock_queue_count);
+    dev->tunnel_unsupported = false;
+
+    LT_LOG_INFO("Bridge reports STATUS of the failed L2 Response...");
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    uint8_t tag_err[] = {TR01_L1_CHIP_MODE_READY_bit, TR01_L2_STATUS_TAG_ERR, 0x00, 0x00, 0x00};
+    uint16_t crc = crc16(tag_err + 1, 2);
+    tag_err[3] = crc >> 8;
+    tag_err[4] = crc & 0x00FF;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, tag_err, sizeof(tag_err)));
+    uint8_t ping_out[4] = {1, 2, 3, 4};
+    uint8_t ping_in[sizeof(ping_out)];
+    LT_TEST_ASSERT(LT_L2_TAG_ERR, lt_ping(h, ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(3, (int)dev->tunnel_calls);
+    LT_TEST_ASSERT(0, (int)dev->mock_queue_count);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,92 @@
+/**
+ * @file lt_test_mock_latency.c
+ * @brief Test emulation of the chip latency in the mock HAL.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+/** Busy period of the time based latency, longer than LT_L1_READ_RETRY_DELAY. */
+#define LATENCY_TEST_MS 60
+
+static const uint8_t latency_test_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE] = {0x00, 0x00, 0x00, 0x02};
+
+/** Mocks Get_Info of the RISC-V FW version and checks the call succeeds. */
+static void latency_test_get_info(lt_handle_t *h)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    uint8_t ver[TR01_L2_GET_INFO_RISCV_FW_SIZE];
+
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = TR01_L2_GET_INFO_RISCV_FW_SIZE,
+                                                 .object = {0}};
+    memcpy(get_info_resp.object, latency_test_fw_ver, sizeof(latency_test_fw_ver));
+    add_resp_crc(&get_info_resp);
+
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp,
+                                                       calc_mocked_resp_len(&get_info_resp)));
+    LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, ver));
+    LT_TEST_ASSERT(0, memcmp(ver, latency_test_fw_ver, sizeof(ver)));
+}
+
+void lt_test_mock_latency(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_latency()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    const mock_latency_t polls_latency
+        = {.req_id = TR01_L2_GET_INFO_REQ_ID, .chip_status = TR01_L1_CHIP_MODE_READY_bit, .polls = 3, .ms = 0};
+    const mock_latency_t no_latency = {.req_id = TR01_L2_GET_INFO_REQ_ID, .chip_status = 0, .polls = 0, .ms = 0};
+    const mock_latency_t time_latency = {.req_id = 0, .chip_status = 0, .polls = 0, .ms = LATENCY_TEST_MS};
+    uint32_t busy_reads;
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, latency_test_fw_ver));
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(0, (int)lt_mock_hal_busy_reads(&h->l2));
+
+    LT_LOG_INFO("Emulating %" PRIu16 " busy polls after Get_Info...", polls_latency.polls);
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_set_latency(&h->l2, &polls_latency));
+    latency_test_get_info(h);
+    LT_TEST_ASSERT(polls_latency.polls, (int)lt_mock_hal_busy_reads(&h->l2));
+
+    LT_LOG_INFO("Checking the latency applies to every Get_Info...");
+    latency_test_get_info(h);
+    LT_TEST_ASSERT(2 * polls_latency.polls, (int)lt_mock_hal_busy_reads(&h->l2));
+
+    LT_LOG_INFO("Removing the latency and emulating %d ms of not ready chip after the next request...",
+                LATENCY_TEST_MS);
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_set_latency(&h->l2, &no_latency));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_set_next_latency(&h->l2, &time_latency));
+    latency_test_get_info(h);
+    busy_reads = lt_mock_hal_busy_reads(&h->l2);
+    LT_TEST_ASSERT(1, busy_reads > 2u * polls_latency.polls);
+
+    LT_LOG_INFO("Checking no latency is emulated anymore...");
+    latency_test_get_info(h);
+    LT_TEST_ASSERT((int)busy_reads, (int)lt_mock_hal_busy_reads(&h->l2));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+}
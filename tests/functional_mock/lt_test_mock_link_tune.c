@@ -0,0 +1,157 @@
+/**
+ * @file lt_test_mock_link_tune.c
+ * @brief Test tuning of the SPI clock and its lowering on CRC errors (LT_LINK_TUNE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_LINK_TUNE
+#include "lt_link_tune.h"
+
+/** Pings at each clock. */
+#define LINK_TUNE_PINGS 2
+/** Length of one ping message, fits one L2 chunk. */
+#define LINK_TUNE_PING_LEN 16
+/** Fastest clock the mocked link passes. */
+#define LINK_TUNE_MAX_HZ 10000000
+
+/**
+ * Mocks Ping echoing the stress pattern of the given clock and ping, its L3 Result is encrypted with the given
+ * decryption nonce, so all pings of lt_link_tune() can be mocked ahead.
+ */
+static void link_tune_mock_ping(lt_handle_t *h, uint8_t *nonce, const uint8_t step, const uint8_t ping)
+{
+    uint8_t ping_res[TR01_L3_RESULT_SIZE + LINK_TUNE_PING_LEN] = {TR01_L3_RESULT_OK};
+    uint8_t iv[TR01_L3_IV_SIZE];
+
+    lt_link_tune_pattern(ping_res + TR01_L3_RESULT_SIZE, LINK_TUNE_PING_LEN, ((uint32_t)step << 8) | ping);
+    memcpy(iv, h->l3.decryption_IV, sizeof(iv));
+    h->l3.decryption_IV[0] = (*nonce)++;
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    memcpy(h->l3.decryption_IV, iv, sizeof(iv));
+}
+
+/** Mocks Get_Info response with RISC-V FW version. */
+static void link_tune_mock_get_info(lt_handle_t *h)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = TR01_L2_GET_INFO_RISCV_FW_SIZE,
+                                                 .object = {0x00, 0x00, 0x00, 0x02}};
+    add_resp_crc(&get_info_resp);
+
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(
+        LT_OK, lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp, calc_mocked_resp_len(&get_info_resp)));
+}
+#endif
+
+void lt_test_mock_link_tune(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_link_tune()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_LINK_TUNE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_LINK_TUNE is not enabled, skipping.");
+#else
+    static const uint32_t speeds_hz[] = {1000000, 5000000, LINK_TUNE_MAX_HZ, 20000000};
+    const uint8_t speed_cnt = sizeof(speeds_hz) / sizeof(speeds_hz[0]);
+    lt_link_info_t info;
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_OK, lt_get_link_info(h, &info));
+    LT_TEST_ASSERT(0, (int)info.speed_hz);
+
+    LT_LOG_INFO("Checking parameters...");
+    const uint32_t descending_hz[] = {5000000, 1000000};
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_link_tune(h, NULL, speed_cnt, LINK_TUNE_PINGS, LINK_TUNE_PING_LEN));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_link_tune(h, speeds_hz, 0, LINK_TUNE_PINGS, LINK_TUNE_PING_LEN));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_link_tune(h, speeds_hz, speed_cnt, 0, LINK_TUNE_PING_LEN));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_link_tune(h, speeds_hz, speed_cnt, LINK_TUNE_PINGS, 0));
+    LT_TEST_ASSERT(LT_PARAM_ERR,
+                   lt_link_tune(h, speeds_hz, speed_cnt, LINK_TUNE_PINGS, LT_LINK_TUNE_PING_LEN_MAX + 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_link_tune(h, descending_hz, 2, LINK_TUNE_PINGS, LINK_TUNE_PING_LEN));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_get_link_info(h, NULL));
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_link_tune(h, speeds_hz, speed_cnt, LINK_TUNE_PINGS, LINK_TUNE_PING_LEN));
+    LT_TEST_ASSERT(0, (int)lt_mock_hal_spi_speed(&h->l2));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    LT_LOG_INFO("Tuning, the link corrupts frames above %d Hz...", LINK_TUNE_MAX_HZ);
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_set_max_speed(&h->l2, LINK_TUNE_MAX_HZ));
+    uint8_t nonce = 0;
+    for (uint8_t step = 0; step < speed_cnt - 1; step++) {
+        for (uint8_t ping = 0; ping < LINK_TUNE_PINGS; ping++) {
+            link_tune_mock_ping(h, &nonce, step, ping);
+        }
+    }
+    // At the fastest clock, the acknowledgement of the Ping is corrupted.
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    // Secure Session is aborted at the kept clock.
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, lt_link_tune(h, speeds_hz, speed_cnt, LINK_TUNE_PINGS, LINK_TUNE_PING_LEN));
+    LT_TEST_ASSERT(LINK_TUNE_MAX_HZ, (int)lt_mock_hal_spi_speed(&h->l2));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_OFF, h->l3.session_status);
+    LT_TEST_ASSERT(LT_OK, lt_get_link_info(h, &info));
+    LT_TEST_ASSERT(LINK_TUNE_MAX_HZ, (int)info.speed_hz);
+    LT_TEST_ASSERT(0, (int)info.errors);
+    LT_TEST_ASSERT(0, (int)info.downshifts);
+
+    LT_LOG_INFO("Resending frames, the link degrades below the tuned clock...");
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_set_max_speed(&h->l2, speeds_hz[1]));
+    uint8_t riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE];
+    for (int i = 0; i < LT_LINK_TUNE_MAX_ERRORS; i++) {
+        // Every other frame is corrupted, so the first one is resent.
+        link_tune_mock_get_info(h);
+        link_tune_mock_get_info(h);
+        LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    }
+    LT_TEST_ASSERT((int)speeds_hz[1], (int)lt_mock_hal_spi_speed(&h->l2));
+    LT_TEST_ASSERT(LT_OK, lt_get_link_info(h, &info));
+    LT_TEST_ASSERT((int)speeds_hz[1], (int)info.speed_hz);
+    LT_TEST_ASSERT(LT_LINK_TUNE_MAX_ERRORS, (int)info.errors);
+    LT_TEST_ASSERT(1, (int)info.downshifts);
+
+    LT_LOG_INFO("Checking no more frames are resent at the lowered clock...");
+    link_tune_mock_get_info(h);
+    LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    LT_TEST_ASSERT(LT_OK, lt_get_link_info(h, &info));
+    LT_TEST_ASSERT(LT_LINK_TUNE_MAX_ERRORS, (int)info.errors);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
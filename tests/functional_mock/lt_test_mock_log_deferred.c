@@ -0,0 +1,79 @@
+/**
+ * @file lt_test_mock_log_deferred.c
+ * @brief Test deferred logging (LT_LOG_DEFERRED).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_test_common.h"
+
+#ifdef LT_LOG_DEFERRED
+/** More messages than the deferred log holds by default. */
+#define LOG_DEFERRED_TEST_MSGS 100
+#endif
+
+void lt_test_mock_log_deferred(lt_handle_t *h)
+{
+    LT_UNUSED(h);
+
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_log_deferred()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_LOG_DEFERRED
+    LT_LOG_INFO("LT_LOG_DEFERRED is not enabled, skipping.");
+#else
+    char line[128];
+    char expected[128];
+    char name[8];
+    uint32_t cnt;
+
+    // Messages of the test itself are deferred too, so the log is emptied before each step.
+    LT_LOG_INFO("Logging message with all supported kinds of arguments...");
+    lt_log_deferred_process(UINT32_MAX);
+    strcpy(name, "Ping");
+    lt_log_deferred("%s: ret=%d len=%" PRIu16 " size=%zu id=0x%02" PRIX8 " t=%" PRIu64 " %5.1f %c %.*s %-4s| 100%%\n",
+                    name, -3, (uint16_t)4096, (size_t)1234567, (uint8_t)0xAB, (uint64_t)1 << 40, 2.25, 'x', 3,
+                    "abcdef", "ab");
+    // The string is copied when logged, so the buffer can be reused right away.
+    strcpy(name, "XXXX");
+    size_t len = lt_log_deferred_read(line, sizeof(line));
+    snprintf(expected, sizeof(expected),
+             "%s: ret=%d len=%" PRIu16 " size=%zu id=0x%02" PRIX8 " t=%" PRIu64 " %5.1f %c %.*s %-4s| 100%%\n", "Ping",
+             -3, (uint16_t)4096, (size_t)1234567, (uint8_t)0xAB, (uint64_t)1 << 40, 2.25, 'x', 3, "abcdef", "ab");
+    LT_TEST_ASSERT((int)strlen(expected), (int)len);
+    LT_TEST_ASSERT(0, strcmp(expected, line));
+
+    LT_LOG_INFO("Verifying the message is truncated to the buffer...");
+    lt_log_deferred_process(UINT32_MAX);
+    lt_log_deferred("%d %s\n", 12345, "long string");
+    LT_TEST_ASSERT(7, (int)lt_log_deferred_read(line, 8));
+    LT_TEST_ASSERT(0, strcmp("12345 l", line));
+
+    LT_LOG_INFO("Logging %d messages without a consumer, the oldest ones have to be kept...", LOG_DEFERRED_TEST_MSGS);
+    lt_log_deferred_process(UINT32_MAX);
+    for (int i = 0; i < LOG_DEFERRED_TEST_MSGS; i++) {
+        lt_log_deferred("message %d\n", i);
+    }
+    uint32_t mismatches = 0;
+    for (cnt = 0; lt_log_deferred_read(line, sizeof(line)) != 0; cnt++) {
+        snprintf(expected, sizeof(expected), "message %" PRIu32 "\n", cnt);
+        if (strcmp(expected, line)) {
+            mismatches++;
+        }
+    }
+    LT_TEST_ASSERT(1, (cnt > 0) && (cnt < LOG_DEFERRED_TEST_MSGS));
+    LT_TEST_ASSERT(0, (int)mismatches);
+#endif
+}
@@ -0,0 +1,125 @@
+/**
+ * @file lt_test_mock_mcounter_cache.c
+ * @brief Test monotonic counter with the value cached on the host (LT_MCOUNTER_CACHE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_MCOUNTER_CACHE
+/** Counter used by the test. */
+#define MCOUNTER_TEST_INDEX TR01_MCOUNTER_INDEX_7
+
+static lt_ret_t mcounter_test_mock_result(lt_handle_t *h, uint8_t *nonce, const uint8_t result)
+{
+    return mock_l3_command_result(h, nonce, &result, TR01_L3_RESULT_SIZE);
+}
+
+static lt_ret_t mcounter_test_mock_get(lt_handle_t *h, uint8_t *nonce, const uint32_t value)
+{
+    struct lt_l3_mcounter_get_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    res.mcounter_val = value;
+
+    return mock_l3_command_result(h, nonce, &res.result, TR01_L3_MCOUNTER_GET_RES_SIZE);
+}
+#endif
+
+void lt_test_mock_mcounter_cache(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_mcounter_cache()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_MCOUNTER_CACHE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_MCOUNTER_CACHE is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+
+    LT_LOG_INFO("Verifying invalid counter is rejected...");
+    lt_mcounter_t c;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_mcounter_open(&c, h, TR01_MCOUNTER_INDEX_15 + 1));
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_open(&c, h, MCOUNTER_TEST_INDEX));
+
+    LT_LOG_INFO("Reading the value, then reading it again from the cache...");
+    uint32_t value = 0;
+    LT_TEST_ASSERT(LT_OK, mcounter_test_mock_get(h, &nonce, 10));
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_value(&c, &value));
+    LT_TEST_ASSERT(10, value);
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_value(&c, &value));
+    LT_TEST_ASSERT(10, value);
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Consuming 3 units in one burst...");
+    for (int i = 0; i < 3; i++) {
+        LT_TEST_ASSERT(LT_OK, mcounter_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    }
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_consume(&c, 3, &value));
+    LT_TEST_ASSERT(7, value);
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Verifying too many units are refused without communication...");
+    LT_TEST_ASSERT(LT_FAIL, lt_mcounter_consume(&c, 8, &value));
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_value(&c, &value));
+    LT_TEST_ASSERT(7, value);
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Verifying failed update drops the cached value...");
+    LT_TEST_ASSERT(LT_OK, mcounter_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, mcounter_test_mock_result(h, &nonce, TR01_L3_RESULT_UPDATE_ERR));
+    LT_TEST_ASSERT(LT_L3_UPDATE_ERR, lt_mcounter_consume(&c, 2, &value));
+    LT_TEST_ASSERT(LT_OK, mcounter_test_mock_get(h, &nonce, 6));
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_value(&c, &value));
+    LT_TEST_ASSERT(6, value);
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Setting the counter caches the new value...");
+    LT_TEST_ASSERT(LT_OK, mcounter_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_set(&c, 100));
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_value(&c, &value));
+    LT_TEST_ASSERT(100, value);
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Invalidating the cache, the value is read again...");
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_invalidate(&c));
+    LT_TEST_ASSERT(LT_OK, mcounter_test_mock_get(h, &nonce, 99));
+    LT_TEST_ASSERT(LT_OK, lt_mcounter_value(&c, &value));
+    LT_TEST_ASSERT(99, value);
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Terminating the Secure Session, the cached value is not used without it...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_mcounter_value(&c, &value));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
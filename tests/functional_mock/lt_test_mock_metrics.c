@@ -0,0 +1,158 @@
+/**
+ * @file lt_test_mock_metrics.c
+ * @brief Test export of runtime statistics in the OpenMetrics text format (LT_METRICS).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_METRICS
+#include "lt_metrics.h"
+
+/** Device label of the first device, its name has to be escaped. */
+#define METRICS_TEST_DEV_A "device=\"tr01-\\\"a\\\"\""
+
+/** Exported text, written into a fixed buffer. */
+struct metrics_test_out_t {
+    char text[16384];
+    size_t len;
+};
+
+static lt_ret_t metrics_test_write(void *write_ctx, const char *data, const size_t len)
+{
+    struct metrics_test_out_t *out = (struct metrics_test_out_t *)write_ctx;
+
+    if (out->len + len >= sizeof(out->text)) {
+        return LT_FAIL;
+    }
+    memcpy(out->text + out->len, data, len);
+    out->len += len;
+    out->text[out->len] = '\0';
+
+    return LT_OK;
+}
+
+/** Checks the line is in the exported text. */
+static int metrics_test_has(const struct metrics_test_out_t *out, const char *line)
+{
+    const char *p = strstr(out->text, line);
+    return p && ((p == out->text) || (p[-1] == '\n')) && (p[strlen(line)] == '\n');
+}
+#endif
+
+void lt_test_mock_metrics(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_metrics()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_METRICS
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_METRICS is not enabled, skipping.");
+#else
+    static struct metrics_test_out_t out;
+    lt_stats_t stats_a, stats_b;
+
+    LT_LOG_INFO("Checking latency buckets...");
+    LT_TEST_ASSERT(0, lt_metrics_bucket(0));
+    LT_TEST_ASSERT(0, lt_metrics_bucket(1000));
+    LT_TEST_ASSERT(1, lt_metrics_bucket(1001));
+    LT_TEST_ASSERT(6, lt_metrics_bucket(100000));
+    LT_TEST_ASSERT(LT_METRICS_BUCKETS - 1, lt_metrics_bucket(100001));
+
+    LT_LOG_INFO("Checking parameters...");
+    memset(&stats_a, 0, sizeof(stats_a));
+    memset(&stats_b, 0, sizeof(stats_b));
+    lt_metrics_dev_t devs[] = {{"tr01-\"a\"", &stats_a}, {"b", &stats_b}};
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_metrics_write_stats(devs, 2, NULL, &out));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_metrics_write_stats(devs, 0, metrics_test_write, &out));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_metrics_write_eof(NULL, &out));
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_OK, lt_reset_stats(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    LT_LOG_INFO("Pinging twice, both executions have to be in the latency histogram...");
+    uint8_t ping_res[TR01_L3_RESULT_SIZE + 16] = {TR01_L3_RESULT_OK};
+    uint8_t ping_in[16];
+    for (int i = 0; i < 2; i++) {
+        LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+        LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+        LT_TEST_ASSERT(LT_OK, lt_ping(h, ping_res + TR01_L3_RESULT_SIZE, ping_in, sizeof(ping_in)));
+    }
+    LT_TEST_ASSERT(LT_OK, lt_get_stats(h, &stats_a));
+    LT_TEST_ASSERT(TR01_L3_PING_CMD_ID, stats_a.l3_cmds[0].cmd_id);
+    LT_TEST_ASSERT(2, (int)stats_a.l3_cmds[0].count);
+    uint32_t hist_sum = 0;
+    for (int i = 0; i < LT_METRICS_BUCKETS; i++) {
+        hist_sum += stats_a.l3_cmds[0].hist[i];
+    }
+    LT_TEST_ASSERT(2, (int)hist_sum);
+    LT_TEST_ASSERT(2, (int)stats_a.l3_nonce);
+
+    LT_LOG_INFO("Exporting statistics of two devices...");
+    stats_a.l2_crc_errors = 3;
+    stats_a.l1_spi_bytes = 5000000000ULL;
+    stats_a.l3_cmds[0].time_us = 1500;
+    memset(stats_a.l3_cmds[0].hist, 0, sizeof(stats_a.l3_cmds[0].hist));
+    stats_a.l3_cmds[0].hist[0] = 1;
+    stats_a.l3_cmds[0].hist[LT_METRICS_BUCKETS - 1] = 1;
+    stats_b.l2_resends = 7;
+    LT_TEST_ASSERT(LT_OK, lt_metrics_write_stats(devs, 2, metrics_test_write, &out));
+    LT_TEST_ASSERT(LT_OK, lt_metrics_write_eof(metrics_test_write, &out));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "# TYPE libtropic_l2_crc_errors counter"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l2_crc_errors_total{" METRICS_TEST_DEV_A "} 3"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l2_crc_errors_total{device=\"b\"} 0"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l2_resends_total{device=\"b\"} 7"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l1_spi_bytes_total{" METRICS_TEST_DEV_A "} 5000000000"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l3_nonce_headroom{" METRICS_TEST_DEV_A "} 4294967293"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l3_nonce_headroom{device=\"b\"} 4294967295"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "# UNIT libtropic_l3_cmd_seconds seconds"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l3_cmd_seconds_bucket{" METRICS_TEST_DEV_A ",cmd_id=\"0x01\","
+                                             "le=\"0.001\"} 1"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l3_cmd_seconds_bucket{" METRICS_TEST_DEV_A ",cmd_id=\"0x01\","
+                                             "le=\"0.1\"} 1"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l3_cmd_seconds_bucket{" METRICS_TEST_DEV_A ",cmd_id=\"0x01\","
+                                             "le=\"+Inf\"} 2"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l3_cmd_seconds_count{" METRICS_TEST_DEV_A ",cmd_id=\"0x01\"} "
+                                             "2"));
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "libtropic_l3_cmd_seconds_sum{" METRICS_TEST_DEV_A ",cmd_id=\"0x01\"} "
+                                             "0.001500"));
+    LT_TEST_ASSERT(0, strstr(out.text, "libtropic_l3_cmd_seconds_count{device=\"b\"") != NULL);
+    LT_TEST_ASSERT(1, metrics_test_has(&out, "# EOF"));
+    LT_TEST_ASSERT(0, strcmp(out.text + out.len - 6, "# EOF\n"));
+
+    LT_LOG_INFO("Checking an error of the writer ends the export...");
+    out.len = sizeof(out.text) - 64;
+    LT_TEST_ASSERT(LT_FAIL, lt_metrics_write_stats(devs, 2, metrics_test_write, &out));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,115 @@
+/**
+ * @file lt_test_mock_pairing_key_cache.c
+ * @brief Test pairing keys cached from the application's provider (LT_PAIRING_KEY_CACHE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_test_common.h"
+
+#ifdef LT_PAIRING_KEY_CACHE
+/** Context of the test provider. */
+typedef struct pkc_provider_t {
+    /** Number of calls of the provider. */
+    int calls;
+    /** Value returned by the provider. */
+    lt_ret_t ret;
+} pkc_provider_t;
+
+/** Derives keys filled with the slot index, as a KDF would do it slowly. */
+static lt_ret_t pkc_unwrap(void *ctx, const lt_pkey_index_t pkey_index, uint8_t *shipriv, uint8_t *shipub)
+{
+    pkc_provider_t *provider = ctx;
+    provider->calls++;
+    memset(shipriv, 0x10 + pkey_index, TR01_SHIPRIV_LEN);
+    memset(shipub, 0x20 + pkey_index, TR01_SHIPUB_LEN);
+    return provider->ret;
+}
+
+/** Returns true if all len bytes of buf are equal to value. */
+static bool pkc_filled(const uint8_t *buf, const size_t len, const uint8_t value)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != value) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+void lt_test_mock_pairing_key_cache(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_pairing_key_cache()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_PAIRING_KEY_CACHE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_PAIRING_KEY_CACHE is not enabled, skipping.");
+#else
+    lt_pairing_key_cache_t cache;
+    pkc_provider_t provider = {.calls = 0, .ret = LT_OK};
+    const uint8_t *shipriv = NULL;
+    const uint8_t *shipub = NULL;
+
+    LT_LOG_INFO("Verifying parameter checks...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_init(NULL, pkc_unwrap, &provider));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_init(&cache, NULL, &provider));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_cache_init(&cache, pkc_unwrap, &provider));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_get(NULL, TR01_PAIRING_KEY_SLOT_INDEX_0, &shipriv, &shipub));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_3 + 1, &shipriv,
+                                                          &shipub));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_0, NULL, &shipub));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_0, &shipriv, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_forget(&cache, TR01_PAIRING_KEY_SLOT_INDEX_3 + 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_start_session(NULL, &cache, TR01_PAIRING_KEY_SLOT_INDEX_0));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_start_session(h, NULL, TR01_PAIRING_KEY_SLOT_INDEX_0));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_deinit(NULL));
+    LT_TEST_ASSERT(0, provider.calls);
+
+    LT_LOG_INFO("Verifying the provider is called once per slot...");
+    for (int i = 0; i < 3; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_1, &shipriv, &shipub));
+        LT_TEST_ASSERT(1, provider.calls);
+        LT_TEST_ASSERT(1, pkc_filled(shipriv, TR01_SHIPRIV_LEN, 0x11));
+        LT_TEST_ASSERT(1, pkc_filled(shipub, TR01_SHIPUB_LEN, 0x21));
+    }
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_3, &shipriv, &shipub));
+    LT_TEST_ASSERT(2, provider.calls);
+    LT_TEST_ASSERT(1, pkc_filled(shipriv, TR01_SHIPRIV_LEN, 0x13));
+
+    LT_LOG_INFO("Verifying forgotten slot is wiped and unwrapped again...");
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_cache_forget(&cache, TR01_PAIRING_KEY_SLOT_INDEX_1));
+    LT_TEST_ASSERT(1, pkc_filled(cache.shipriv[TR01_PAIRING_KEY_SLOT_INDEX_1], TR01_SHIPRIV_LEN, 0));
+    LT_TEST_ASSERT(1, pkc_filled(cache.shipub[TR01_PAIRING_KEY_SLOT_INDEX_1], TR01_SHIPUB_LEN, 0));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_3, &shipriv, &shipub));
+    LT_TEST_ASSERT(2, provider.calls);
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_1, &shipriv, &shipub));
+    LT_TEST_ASSERT(3, provider.calls);
+
+    LT_LOG_INFO("Verifying failure of the provider is returned and nothing is cached...");
+    provider.ret = LT_CRYPTO_ERR;
+    LT_TEST_ASSERT(LT_CRYPTO_ERR, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_0, &shipriv, &shipub));
+    LT_TEST_ASSERT(1, pkc_filled(cache.shipriv[TR01_PAIRING_KEY_SLOT_INDEX_0], TR01_SHIPRIV_LEN, 0));
+    LT_TEST_ASSERT(LT_CRYPTO_ERR, lt_pairing_key_cache_start_session(h, &cache, TR01_PAIRING_KEY_SLOT_INDEX_0));
+    LT_TEST_ASSERT(5, provider.calls);
+    provider.ret = LT_OK;
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_0, &shipriv, &shipub));
+    LT_TEST_ASSERT(6, provider.calls);
+
+    LT_LOG_INFO("Verifying deinit wipes all slots...");
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_cache_deinit(&cache));
+    LT_TEST_ASSERT(1, pkc_filled((const uint8_t *)cache.shipriv, sizeof(cache.shipriv), 0));
+    LT_TEST_ASSERT(1, pkc_filled((const uint8_t *)cache.shipub, sizeof(cache.shipub), 0));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_key_cache_get(&cache, TR01_PAIRING_KEY_SLOT_INDEX_0, &shipriv, &shipub));
+#endif
+}
@@ -0,0 +1,126 @@
+/**
+ * @file lt_test_mock_pairing_pub_cache.c
+ * @brief Test pairing public key cache in the handle (LT_PAIRING_PUB_CACHE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_PAIRING_PUB_CACHE
+static lt_ret_t pairing_pub_cache_test_mock_result(lt_handle_t *h, uint8_t *nonce, const uint8_t result)
+{
+    return mock_l3_command_result(h, nonce, &result, TR01_L3_RESULT_SIZE);
+}
+
+/** Mocks successful Pairing_Key_Read result with all public key bytes set to fill. */
+static lt_ret_t pairing_pub_cache_test_mock_read(lt_handle_t *h, uint8_t *nonce, const uint8_t fill)
+{
+    struct lt_l3_pairing_key_read_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    memset(res.s_hipub, fill, sizeof(res.s_hipub));
+
+    return mock_l3_command_result(h, nonce, &res.result, sizeof(res) - sizeof(res.res_size));
+}
+#endif
+
+void lt_test_mock_pairing_pub_cache(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_pairing_pub_cache()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_PAIRING_PUB_CACHE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_PAIRING_PUB_CACHE is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+    uint8_t pub[TR01_SHIPUB_LEN];
+    uint8_t written[TR01_SHIPUB_LEN];
+    memset(written, 0x5A, sizeof(written));
+
+    LT_LOG_INFO("Reading slot 1 twice, only the first read has to be sent...");
+    LT_TEST_ASSERT(LT_OK, pairing_pub_cache_test_mock_read(h, &nonce, 0xA1));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_1));
+    memset(pub, 0, sizeof(pub));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_1));
+    LT_TEST_ASSERT(1, (pub[0] == 0xA1) && (pub[TR01_SHIPUB_LEN - 1] == 0xA1));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(1, (int)h->l3.pairing_pub.hits);
+    LT_TEST_ASSERT(1, (int)h->l3.pairing_pub.misses);
+
+    LT_LOG_INFO("Reading empty slot 2 twice, the empty result has to be cached too...");
+    LT_TEST_ASSERT(LT_OK, pairing_pub_cache_test_mock_result(h, &nonce, TR01_L3_RESULT_SLOT_EMPTY));
+    LT_TEST_ASSERT(LT_L3_SLOT_EMPTY, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_2));
+    LT_TEST_ASSERT(LT_L3_SLOT_EMPTY, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_2));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Writing slot 2, the written key has to be read back from the cache...");
+    LT_TEST_ASSERT(LT_OK, pairing_pub_cache_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_write(h, written, TR01_PAIRING_KEY_SLOT_INDEX_2));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_2));
+    LT_TEST_ASSERT(0, memcmp(pub, written, sizeof(pub)));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Invalidating slot 2, the invalid result has to be cached...");
+    LT_TEST_ASSERT(LT_OK, pairing_pub_cache_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_invalidate(h, TR01_PAIRING_KEY_SLOT_INDEX_2));
+    LT_TEST_ASSERT(LT_L3_SLOT_INVALID, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_2));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Failed write of slot 1, the slot has to be read from TROPIC01 again...");
+    LT_TEST_ASSERT(LT_OK, pairing_pub_cache_test_mock_result(h, &nonce, TR01_L3_RESULT_FAIL));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_pairing_key_write(h, written, TR01_PAIRING_KEY_SLOT_INDEX_1));
+    LT_TEST_ASSERT(LT_OK, pairing_pub_cache_test_mock_read(h, &nonce, 0xB2));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_1));
+    LT_TEST_ASSERT(1, (pub[0] == 0xB2));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Dropping the cache, slot 1 has to be read from TROPIC01 again...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pairing_pub_cache_invalidate(NULL));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_pub_cache_invalidate(h));
+    LT_TEST_ASSERT(LT_OK, pairing_pub_cache_test_mock_read(h, &nonce, 0xC3));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_1));
+    LT_TEST_ASSERT(1, (pub[0] == 0xC3));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Starting new session, the cache of the previous session has to be dropped...");
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    nonce = 0;
+    LT_TEST_ASSERT(LT_OK, pairing_pub_cache_test_mock_read(h, &nonce, 0xD4));
+    LT_TEST_ASSERT(LT_OK, lt_pairing_key_read(h, pub, TR01_PAIRING_KEY_SLOT_INDEX_1));
+    LT_TEST_ASSERT(1, (pub[0] == 0xD4));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,177 @@
+/**
+ * @file lt_test_mock_pin.c
+ * @brief Test PIN verification engine based on MAC-and-Destroy (LT_PIN).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_hmac_sha256.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_PIN
+/** Number of PIN attempts of the tested engine. */
+#define PIN_TEST_ROUNDS 3
+/** First Mac-and-Destroy slot of the tested engine. */
+#define PIN_TEST_MACANDD_SLOT TR01_MAC_AND_DESTROY_SLOT_5
+/** User Data slot of the tested engine. */
+#define PIN_TEST_R_MEM_SLOT 500
+/** Size of the data of the engine in R-Memory. */
+#define PIN_TEST_NVM_SIZE (2 + LT_HMAC_SHA256_HASH_LEN + PIN_TEST_ROUNDS * TR01_MAC_AND_DESTROY_DATA_SIZE)
+
+static lt_ret_t pin_test_mock_macandd(lt_handle_t *h, uint8_t *nonce, const uint8_t fill)
+{
+    struct lt_l3_mac_and_destroy_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    memset(res.data_out, fill, sizeof(res.data_out));
+
+    return mock_l3_command_result(h, nonce, &res.result, TR01_L3_MAC_AND_DESTROY_RES_SIZE);
+}
+
+static lt_ret_t pin_test_mock_ok(lt_handle_t *h, uint8_t *nonce)
+{
+    uint8_t res[] = {TR01_L3_RESULT_OK};
+
+    return mock_l3_command_result(h, nonce, res, sizeof(res));
+}
+
+/** Mocks reading of the engine data with i attempts remaining. */
+static lt_ret_t pin_test_mock_nvm(lt_handle_t *h, uint8_t *nonce, const uint8_t *nvm, const uint8_t i)
+{
+    uint8_t res[TR01_L3_RESULT_SIZE + TR01_L3_R_MEM_DATA_READ_PADDING_SIZE + PIN_TEST_NVM_SIZE] = {TR01_L3_RESULT_OK};
+    memcpy(res + TR01_L3_RESULT_SIZE + TR01_L3_R_MEM_DATA_READ_PADDING_SIZE, nvm, PIN_TEST_NVM_SIZE);
+    res[TR01_L3_RESULT_SIZE + TR01_L3_R_MEM_DATA_READ_PADDING_SIZE] = i;
+
+    return mock_l3_command_result(h, nonce, res, sizeof(res));
+}
+#endif
+
+void lt_test_mock_pin(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_pin()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_PIN
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_PIN is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+
+    LT_LOG_INFO("Verifying invalid engine parameters are rejected...");
+    lt_pin_t p;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pin_init(&p, h, PIN_TEST_MACANDD_SLOT, 0, PIN_TEST_R_MEM_SLOT));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pin_init(&p, h, PIN_TEST_MACANDD_SLOT, LT_PIN_ROUNDS_MAX + 1, PIN_TEST_R_MEM_SLOT));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pin_init(&p, h, TR01_MAC_AND_DESTROY_SLOT_127, 2, PIN_TEST_R_MEM_SLOT));
+    LT_TEST_ASSERT(LT_OK, lt_pin_init(&p, h, PIN_TEST_MACANDD_SLOT, PIN_TEST_ROUNDS, PIN_TEST_R_MEM_SLOT));
+
+    const uint8_t pin[] = {1, 2, 3, 4};
+    const uint8_t wrong_pin[] = {1, 2, 3, 5};
+    const uint8_t add[] = {0xAD, 0xDD};
+    uint8_t pin_add[sizeof(pin) + sizeof(add)];
+    memcpy(pin_add, pin, sizeof(pin));
+    memcpy(pin_add + sizeof(pin), add, sizeof(add));
+    uint8_t master_secret[TR01_MAC_AND_DESTROY_DATA_SIZE];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, master_secret, sizeof(master_secret)));
+    uint8_t key[LT_PIN_KEY_LEN], key_expected[LT_PIN_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_hmac_sha256(master_secret, sizeof(master_secret), (const uint8_t *)"2", 1, key_expected));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pin_setup(&p, master_secret, pin, LT_PIN_LEN_MIN - 1, add, sizeof(add), key));
+
+    LT_LOG_INFO("Expecting data the engine stores into R-Memory...");
+    // Slot i returns w_i filled by 0x40 + i for the PIN.
+    uint8_t nvm[PIN_TEST_NVM_SIZE] = {PIN_TEST_ROUNDS, PIN_TEST_ROUNDS};
+    LT_TEST_ASSERT(LT_OK, lt_hmac_sha256(master_secret, sizeof(master_secret), (uint8_t[]){0x00}, 1, nvm + 2));
+    for (uint8_t i = 0; i < PIN_TEST_ROUNDS; i++) {
+        uint8_t w_i[TR01_MAC_AND_DESTROY_DATA_SIZE], k_i[LT_HMAC_SHA256_HASH_LEN];
+        memset(w_i, 0x40 + i, sizeof(w_i));
+        LT_TEST_ASSERT(LT_OK, lt_hmac_sha256(w_i, sizeof(w_i), pin_add, sizeof(pin_add), k_i));
+        uint8_t *ci = nvm + 2 + LT_HMAC_SHA256_HASH_LEN + i * TR01_MAC_AND_DESTROY_DATA_SIZE;
+        for (uint8_t j = 0; j < TR01_MAC_AND_DESTROY_DATA_SIZE; j++) {
+            ci[j] = master_secret[j] ^ k_i[j];
+        }
+    }
+
+    LT_LOG_INFO("Setting up PIN...");
+    for (uint8_t i = 0; i < PIN_TEST_ROUNDS; i++) {
+        LT_TEST_ASSERT(LT_OK, pin_test_mock_macandd(h, &nonce, 0x00));
+        LT_TEST_ASSERT(LT_OK, pin_test_mock_macandd(h, &nonce, 0x40 + i));
+        LT_TEST_ASSERT(LT_OK, pin_test_mock_macandd(h, &nonce, 0x00));
+    }
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_ok(h, &nonce));  // R_Mem_Data_Erase
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_ok(h, &nonce));  // R_Mem_Data_Write
+    LT_TEST_ASSERT(LT_OK, lt_pin_setup(&p, master_secret, pin, sizeof(pin), add, sizeof(add), key));
+    LT_TEST_ASSERT(0, memcmp(key, key_expected, sizeof(key)));
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Verifying PIN from the cache without communication...");
+    memset(key, 0, sizeof(key));
+    LT_TEST_ASSERT(LT_OK, lt_pin_verify(&p, pin, sizeof(pin), add, sizeof(add), key));
+    LT_TEST_ASSERT(0, memcmp(key, key_expected, sizeof(key)));
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Verifying wrong PIN, it is verified by TROPIC01 and consumes an attempt...");
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_nvm(h, &nonce, nvm, PIN_TEST_ROUNDS));
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_ok(h, &nonce));
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_ok(h, &nonce));
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_macandd(h, &nonce, 0x66));
+    LT_TEST_ASSERT(LT_FAIL, lt_pin_verify(&p, wrong_pin, sizeof(wrong_pin), add, sizeof(add), key));
+    LT_TEST_ASSERT(0, key[0] | key[LT_PIN_KEY_LEN - 1]);
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Verifying correct PIN after the wrong one, the cache was dropped...");
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_nvm(h, &nonce, nvm, PIN_TEST_ROUNDS - 1));
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_ok(h, &nonce));
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_ok(h, &nonce));
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_macandd(h, &nonce, 0x40 + PIN_TEST_ROUNDS - 2));
+    for (uint8_t x = PIN_TEST_ROUNDS - 2; x < PIN_TEST_ROUNDS; x++) {
+        LT_TEST_ASSERT(LT_OK, pin_test_mock_macandd(h, &nonce, 0x00));
+    }
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_ok(h, &nonce));
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_ok(h, &nonce));
+    LT_TEST_ASSERT(LT_OK, lt_pin_verify(&p, pin, sizeof(pin), add, sizeof(add), key));
+    LT_TEST_ASSERT(0, memcmp(key, key_expected, sizeof(key)));
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Verifying PIN without additional data is not answered from the cache...");
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_nvm(h, &nonce, nvm, 0));
+    LT_TEST_ASSERT(LT_FAIL, lt_pin_verify(&p, pin, sizeof(pin), NULL, 0, key));
+    LT_TEST_ASSERT(nonce, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Locking the engine, the key is verified by TROPIC01 again...");
+    LT_TEST_ASSERT(LT_OK, lt_pin_lock(&p));
+    LT_TEST_ASSERT(LT_OK, pin_test_mock_nvm(h, &nonce, nvm, 0));
+    LT_TEST_ASSERT(LT_FAIL, lt_pin_verify(&p, pin, sizeof(pin), add, sizeof(add), key));
+
+    LT_LOG_INFO("Terminating the Secure Session...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_pin_verify(&p, pin, sizeof(pin), add, sizeof(add), key));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
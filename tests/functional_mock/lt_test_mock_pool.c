@@ -0,0 +1,103 @@
+/**
+ * @file lt_test_mock_pool.c
+ * @brief Test pool of TROPIC01 devices (LT_POOL).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_POOL
+/** Executor counting the operations it runs. */
+static lt_ret_t pool_count_exec(void *exec_ctx, lt_handle_t *h, lt_pool_op_t op, void *op_ctx)
+{
+    (*(uint32_t *)exec_ctx)++;
+
+    return op(h, op_ctx);
+}
+#endif
+
+void lt_test_mock_pool(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_pool()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_POOL
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_POOL is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    LT_LOG_INFO("Adding the device with running Secure Session to the pool...");
+    // Keys are used only by the re-handshake, which is not exercised here.
+    uint8_t dummy_key[TR01_SHIPUB_LEN] = {0};
+    lt_pool_t pool;
+    LT_TEST_ASSERT(LT_OK, lt_pool_init(&pool));
+    LT_TEST_ASSERT(LT_OK, lt_pool_add_device(&pool, h, dummy_key, TR01_PAIRING_KEY_SLOT_INDEX_0, dummy_key, dummy_key));
+    LT_TEST_ASSERT(1, lt_pool_is_healthy(&pool, 0));
+
+    LT_LOG_INFO("Pinging through the pool...");
+    uint8_t ping_out[4] = {1, 2, 3, 4};
+    uint8_t ping_in[sizeof(ping_out)] = {0};
+    uint8_t ping_res[1 + sizeof(ping_out)] = {TR01_L3_RESULT_OK, 1, 2, 3, 4};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_pool_ping(&pool, ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, memcmp(ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, lt_pool_depth(&pool, 0));
+    LT_TEST_ASSERT(1, pool.devs[0].ops);
+
+    LT_LOG_INFO("Pinging by the executor of the device...");
+    uint32_t exec_cnt = 0;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pool_set_executor(&pool, 1, pool_count_exec, &exec_cnt));
+    LT_TEST_ASSERT(LT_OK, lt_pool_set_executor(&pool, 0, pool_count_exec, &exec_cnt));
+    memset(ping_in, 0, sizeof(ping_in));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_pool_ping(&pool, ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, memcmp(ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(1, exec_cnt);
+    LT_TEST_ASSERT(LT_OK, lt_pool_set_executor(&pool, 0, NULL, NULL));
+
+    LT_LOG_INFO("Mocking HARDWARE_FAIL, the device is quarantined...");
+    uint8_t hw_fail_res[] = {TR01_L3_RESULT_HARDWARE_FAIL};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, hw_fail_res, sizeof(hw_fail_res)));
+    LT_TEST_ASSERT(LT_L3_HARDWARE_FAIL, lt_pool_ping(&pool, ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, lt_pool_is_healthy(&pool, 0));
+    LT_TEST_ASSERT(1, pool.devs[0].failures);
+    LT_TEST_ASSERT(LT_SECURE_SESSION_OFF, h->l3.session_status);
+
+    LT_LOG_INFO("Verifying no healthy device is left...");
+    uint8_t rnd[4];
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_pool_random_value_get(&pool, rnd, sizeof(rnd)));
+    LT_TEST_ASSERT(0, lt_pool_depth(&pool, 0));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
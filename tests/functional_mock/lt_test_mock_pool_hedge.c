@@ -0,0 +1,182 @@
+/**
+ * @file lt_test_mock_pool_hedge.c
+ * @brief Test hedged operations and warm standby devices of the device pool (LT_POOL_HEDGE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_mbedtls_v4.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_POOL_HEDGE
+/** Number of random bytes requested by the hedged operation. */
+#define POOL_HEDGE_RND_LEN 4
+/** TROPIC01 of the first device is busy this long with the hedged operation. */
+#define POOL_HEDGE_BUSY_MS 200
+
+/** Second TROPIC01 device, the first one is the handle of the test. */
+struct pool_hedge_dev_t {
+    lt_handle_t h;
+    lt_dev_mock_t mock;
+    lt_ctx_mbedtls_v4_t crypto_ctx;
+#ifdef LT_CRYPTO_OPS
+    lt_crypto_ops_ctx_t crypto_ops_ctx;
+#endif
+#if LT_SEPARATE_L3_BUFF
+    uint8_t l3_buff[LT_SIZE_OF_L3_BUFF] __attribute__((aligned(16)));
+#endif
+};
+
+/** Sets up the second device as main() sets up the handle of the test. */
+static void pool_hedge_dev_init(struct pool_hedge_dev_t *dev)
+{
+    memset(dev, 0, sizeof(*dev));
+#if LT_SEPARATE_L3_BUFF
+    dev->h.l3.buff = dev->l3_buff;
+    dev->h.l3.buff_len = sizeof(dev->l3_buff);
+#endif
+    dev->h.l2.device = &dev->mock;
+#ifdef LT_CRYPTO_OPS
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ops_set(&dev->crypto_ops_ctx, &lt_crypto_ops_mbedtls_v4, &dev->crypto_ctx));
+    dev->h.l3.crypto_ctx = &dev->crypto_ops_ctx;
+#else
+    dev->h.l3.crypto_ctx = &dev->crypto_ctx;
+#endif
+}
+
+/** Initializes the handle and starts a mocked Secure Session on it. */
+static void pool_hedge_start(lt_handle_t *h)
+{
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_reset(&h->l2));
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+}
+
+/** Mocks the L3 Command acknowledgement and the L3 Result of Random_Value_Get filled by the byte. */
+static void pool_hedge_mock_random(lt_handle_t *h, const uint8_t fill)
+{
+    uint8_t res[TR01_L3_RESULT_SIZE + 3 + POOL_HEDGE_RND_LEN] = {TR01_L3_RESULT_OK};
+    memset(res + TR01_L3_RESULT_SIZE + 3, fill, POOL_HEDGE_RND_LEN);
+
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, res, sizeof(res)));
+}
+
+/** Mocks the L3 Command acknowledgement and the L3 Result of Ping. */
+static void pool_hedge_mock_ping(lt_handle_t *h, const uint8_t *msg, const size_t msg_len)
+{
+    uint8_t res[TR01_L3_RESULT_SIZE + 4] = {TR01_L3_RESULT_OK};
+    memcpy(res + TR01_L3_RESULT_SIZE, msg, msg_len);
+
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, res, TR01_L3_RESULT_SIZE + msg_len));
+}
+#endif
+
+void lt_test_mock_pool_hedge(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_pool_hedge()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_POOL_HEDGE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_POOL_HEDGE is not enabled, skipping.");
+#else
+    static struct pool_hedge_dev_t dev2;
+    lt_handle_t *h2 = &dev2.h;
+
+    LT_LOG_INFO("Initializing two devices with Secure Sessions...");
+    pool_hedge_dev_init(&dev2);
+    pool_hedge_start(h);
+    pool_hedge_start(h2);
+
+    LT_LOG_INFO("Adding them to the pool, the second one is a warm standby...");
+    // Keys are used only by the re-handshake, which is not exercised here.
+    uint8_t dummy_key[TR01_SHIPUB_LEN] = {0};
+    lt_l2_async_t ops[2];
+    memset(ops, 0, sizeof(ops));
+    lt_pool_t pool;
+    LT_TEST_ASSERT(LT_OK, lt_pool_init(&pool));
+    const lt_pkey_index_t slot = TR01_PAIRING_KEY_SLOT_INDEX_0;
+    LT_TEST_ASSERT(LT_OK, lt_pool_add_device(&pool, h, dummy_key, slot, dummy_key, dummy_key));
+    LT_TEST_ASSERT(LT_OK, lt_pool_add_device(&pool, h2, dummy_key, slot, dummy_key, dummy_key));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pool_set_standby(&pool, 2, true));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pool_set_hedge_op(&pool, 2, &ops[0]));
+    LT_TEST_ASSERT(LT_OK, lt_pool_set_standby(&pool, 1, true));
+    LT_TEST_ASSERT(LT_OK, lt_pool_set_hedge_op(&pool, 0, &ops[0]));
+    LT_TEST_ASSERT(LT_OK, lt_pool_set_hedge_op(&pool, 1, &ops[1]));
+    LT_TEST_ASSERT(0, (int)lt_pool_hedge_delay_ms(&pool));
+
+    LT_LOG_INFO("Pinging until the hedge delay is known, the standby device takes no operation...");
+    uint8_t ping_out[4] = {1, 2, 3, 4};
+    uint8_t ping_in[sizeof(ping_out)];
+    for (int i = 0; i < LT_POOL_HEDGE_MIN_SAMPLES; i++) {
+        LT_TEST_ASSERT(0, (int)lt_pool_hedge_delay_ms(&pool));
+        pool_hedge_mock_ping(h, ping_out, sizeof(ping_out));
+        memset(ping_in, 0, sizeof(ping_in));
+        LT_TEST_ASSERT(LT_OK, lt_pool_ping(&pool, ping_out, ping_in, sizeof(ping_out)));
+        LT_TEST_ASSERT(0, memcmp(ping_out, ping_in, sizeof(ping_out)));
+    }
+    LT_TEST_ASSERT(LT_POOL_HEDGE_MIN_SAMPLES, (int)pool.devs[0].ops);
+    LT_TEST_ASSERT(0, (int)pool.devs[1].ops);
+    uint32_t delay_ms = lt_pool_hedge_delay_ms(&pool);
+    LT_TEST_ASSERT(1, (delay_ms >= 1) && (delay_ms < POOL_HEDGE_BUSY_MS));
+
+    LT_LOG_INFO("First TROPIC01 is slow, the hedged duplicate on the standby device finishes first...");
+    const mock_latency_t busy
+        = {.req_id = 0, .chip_status = TR01_L1_CHIP_MODE_READY_bit, .polls = 0, .ms = POOL_HEDGE_BUSY_MS};
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_set_next_latency(&h->l2, &busy));
+    pool_hedge_mock_random(h, 0xAA);
+    pool_hedge_mock_random(h2, 0xBB);
+    uint8_t rnd[POOL_HEDGE_RND_LEN] = {0};
+    LT_TEST_ASSERT(LT_OK, lt_pool_random_value_get(&pool, rnd, sizeof(rnd)));
+    LT_TEST_ASSERT(0xBB, rnd[0]);
+    LT_TEST_ASSERT(0xBB, rnd[POOL_HEDGE_RND_LEN - 1]);
+    LT_TEST_ASSERT(1, (int)pool.devs[1].hedges);
+    LT_TEST_ASSERT(1, (int)pool.devs[1].hedge_wins);
+    LT_TEST_ASSERT(0, (int)pool.devs[1].handshakes);
+
+    LT_LOG_INFO("Verifying the slow device was abandoned, not counted as failed...");
+    LT_TEST_ASSERT(1, (int)pool.devs[0].abandoned);
+    LT_TEST_ASSERT(0, (int)pool.devs[0].failures);
+    LT_TEST_ASSERT(0, lt_pool_is_healthy(&pool, 0));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_OFF, h->l3.session_status);
+    LT_TEST_ASSERT(0, lt_l2_async_busy(&ops[0]));
+    LT_TEST_ASSERT(1, lt_pool_is_healthy(&pool, 1));
+    LT_TEST_ASSERT(0, lt_pool_depth(&pool, 0));
+    LT_TEST_ASSERT(0, lt_pool_depth(&pool, 1));
+
+    LT_LOG_INFO("Failing over to the standby device, its Secure Session is already established...");
+    pool_hedge_mock_ping(h2, ping_out, sizeof(ping_out));
+    memset(ping_in, 0, sizeof(ping_in));
+    LT_TEST_ASSERT(LT_OK, lt_pool_ping(&pool, ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, memcmp(ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(2, (int)pool.devs[1].ops);
+    LT_TEST_ASSERT(1, (int)pool.devs[1].hedges);
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h2->l3.session_status);
+
+    LT_LOG_INFO("Deinitializing handles");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h2));
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,227 @@
+/**
+ * @file lt_test_mock_pool_replicate.c
+ * @brief Test replication of an ECC key across the device pool (LT_POOL).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_mbedtls_v4.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_POOL
+/** Number of devices of the pool, the first one is the handle of the test. */
+#define POOL_REPLICATE_DEVS 2
+
+/** Second TROPIC01 device. */
+struct pool_replicate_dev_t {
+    lt_handle_t h;
+    lt_dev_mock_t mock;
+    lt_ctx_mbedtls_v4_t crypto_ctx;
+#ifdef LT_CRYPTO_OPS
+    lt_crypto_ops_ctx_t crypto_ops_ctx;
+#endif
+#if LT_SEPARATE_L3_BUFF
+    uint8_t l3_buff[LT_SIZE_OF_L3_BUFF] __attribute__((aligned(16)));
+#endif
+};
+
+/** Sets up the second device as main() sets up the handle of the test. */
+static void pool_replicate_dev_init(struct pool_replicate_dev_t *dev)
+{
+    memset(dev, 0, sizeof(*dev));
+#if LT_SEPARATE_L3_BUFF
+    dev->h.l3.buff = dev->l3_buff;
+    dev->h.l3.buff_len = sizeof(dev->l3_buff);
+#endif
+    dev->h.l2.device = &dev->mock;
+#ifdef LT_CRYPTO_OPS
+    LT_TEST_ASSERT(LT_OK, lt_crypto_ops_set(&dev->crypto_ops_ctx, &lt_crypto_ops_mbedtls_v4, &dev->crypto_ctx));
+    dev->h.l3.crypto_ctx = &dev->crypto_ops_ctx;
+#else
+    dev->h.l3.crypto_ctx = &dev->crypto_ctx;
+#endif
+}
+
+/** Initializes the handle and starts a mocked Secure Session on it. */
+static void pool_replicate_start(lt_handle_t *h)
+{
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_reset(&h->l2));
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+}
+
+/** Mocks the L3 Result of ECC_Key_Erase or ECC_Key_Store without data. */
+static void pool_replicate_mock_status(lt_handle_t *h, uint8_t *nonce, const uint8_t result)
+{
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, nonce, &result, TR01_L3_RESULT_SIZE));
+}
+
+/** Mocks the L3 Result of ECC_Key_Read of a P256 key. */
+static void pool_replicate_mock_read(lt_handle_t *h, uint8_t *nonce, const uint8_t origin, const uint8_t *pubkey)
+{
+    uint8_t res[TR01_L3_RESULT_SIZE + 15 + TR01_CURVE_P256_PUBKEY_LEN] = {TR01_L3_RESULT_OK, TR01_CURVE_P256, origin};
+    memcpy(res + TR01_L3_RESULT_SIZE + 15, pubkey, TR01_CURVE_P256_PUBKEY_LEN);
+
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_result(h, nonce, res, sizeof(res)));
+}
+
+/** Verifies the whole mock queue of the device was consumed. */
+static void pool_replicate_assert_consumed(lt_handle_t *h)
+{
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+}
+#endif
+
+void lt_test_mock_pool_replicate(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_pool_replicate()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_POOL
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_POOL is not enabled, skipping.");
+#else
+    static struct pool_replicate_dev_t dev2;
+    lt_handle_t *hs[POOL_REPLICATE_DEVS] = {h, &dev2.h};
+    uint8_t nonces[POOL_REPLICATE_DEVS] = {0};
+
+    LT_LOG_INFO("Initializing two devices with Secure Sessions...");
+    pool_replicate_dev_init(&dev2);
+    for (int i = 0; i < POOL_REPLICATE_DEVS; i++) {
+        pool_replicate_start(hs[i]);
+    }
+
+    LT_LOG_INFO("Adding them to the pool...");
+    // Keys are used only by the re-handshake, which is not exercised here.
+    uint8_t dummy_key[TR01_SHIPUB_LEN] = {0};
+    lt_pool_t pool;
+    LT_TEST_ASSERT(LT_OK, lt_pool_init(&pool));
+    for (int i = 0; i < POOL_REPLICATE_DEVS; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_pool_add_device(&pool, hs[i], dummy_key, TR01_PAIRING_KEY_SLOT_INDEX_0, dummy_key,
+                                                 dummy_key));
+    }
+#ifdef LT_POOL_HEDGE
+    // Both devices are driven concurrently through their asynchronous L2 operations.
+    lt_l2_async_t ops[POOL_REPLICATE_DEVS];
+    memset(ops, 0, sizeof(ops));
+    for (uint8_t i = 0; i < POOL_REPLICATE_DEVS; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_pool_set_hedge_op(&pool, i, &ops[i]));
+    }
+#endif
+
+    LT_LOG_INFO("Checking parameters...");
+    uint8_t key[TR01_CURVE_PRIVKEY_LEN];
+    uint8_t pubkey[TR01_CURVE_P256_PUBKEY_LEN];
+    uint8_t pubkey_other[TR01_CURVE_P256_PUBKEY_LEN];
+    uint8_t zeros[TR01_CURVE_PRIVKEY_LEN] = {0};
+    lt_ret_t results[POOL_REPLICATE_DEVS];
+    memset(key, 0x5A, sizeof(key));
+    memset(pubkey_other, 0xCC, sizeof(pubkey_other));
+    const lt_ecc_slot_t slot = TR01_ECC_SLOT_3;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pool_replicate_key(NULL, slot, TR01_CURVE_P256, key, false, NULL, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pool_replicate_key(&pool, slot, TR01_CURVE_P256, NULL, false, NULL, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR,
+                   lt_pool_replicate_key(&pool, TR01_ECC_SLOT_31 + 1, TR01_CURVE_P256, key, false, NULL, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_pool_replicate_key(&pool, slot, (lt_ecc_curve_type_t)0, key, false, NULL, NULL));
+
+    LT_LOG_INFO("Replicating the key to both devices, it is verified and zeroized...");
+    uint8_t expected[TR01_CURVE_P256_PUBKEY_LEN];
+    memset(expected, 0xA5, sizeof(expected));
+    for (int i = 0; i < POOL_REPLICATE_DEVS; i++) {
+        pool_replicate_mock_status(hs[i], &nonces[i], TR01_L3_RESULT_OK);
+        pool_replicate_mock_read(hs[i], &nonces[i], TR01_CURVE_STORED, expected);
+    }
+    memset(pubkey, 0, sizeof(pubkey));
+    LT_TEST_ASSERT(LT_OK, lt_pool_replicate_key(&pool, slot, TR01_CURVE_P256, key, false, pubkey, results));
+    LT_TEST_ASSERT(0, memcmp(pubkey, expected, sizeof(expected)));
+    LT_TEST_ASSERT(0, memcmp(key, zeros, sizeof(key)));
+    for (int i = 0; i < POOL_REPLICATE_DEVS; i++) {
+        LT_TEST_ASSERT(LT_OK, results[i]);
+        LT_TEST_ASSERT(1, (int)pool.devs[i].ops);
+        LT_TEST_ASSERT(0, lt_pool_depth(&pool, (uint8_t)i));
+        pool_replicate_assert_consumed(hs[i]);
+    }
+
+    LT_LOG_INFO("Replicating to an expanded pool, the device holding the key already is only verified...");
+    memset(key, 0x5A, sizeof(key));
+    pool_replicate_mock_status(hs[0], &nonces[0], TR01_L3_RESULT_SLOT_NOT_EMPTY);
+    pool_replicate_mock_read(hs[0], &nonces[0], TR01_CURVE_STORED, expected);
+    pool_replicate_mock_status(hs[1], &nonces[1], TR01_L3_RESULT_OK);
+    pool_replicate_mock_read(hs[1], &nonces[1], TR01_CURVE_STORED, expected);
+    LT_TEST_ASSERT(LT_OK, lt_pool_replicate_key(&pool, slot, TR01_CURVE_P256, key, false, NULL, results));
+    LT_TEST_ASSERT(LT_OK, results[0]);
+    LT_TEST_ASSERT(LT_OK, results[1]);
+
+    LT_LOG_INFO("First device holds a different key, it fails the verification against the stored one...");
+    memset(key, 0x5A, sizeof(key));
+    pool_replicate_mock_status(hs[0], &nonces[0], TR01_L3_RESULT_SLOT_NOT_EMPTY);
+    pool_replicate_mock_read(hs[0], &nonces[0], TR01_CURVE_STORED, pubkey_other);
+    pool_replicate_mock_status(hs[1], &nonces[1], TR01_L3_RESULT_OK);
+    pool_replicate_mock_read(hs[1], &nonces[1], TR01_CURVE_STORED, expected);
+    memset(pubkey, 0, sizeof(pubkey));
+    LT_TEST_ASSERT(LT_FAIL, lt_pool_replicate_key(&pool, slot, TR01_CURVE_P256, key, false, pubkey, results));
+    LT_TEST_ASSERT(LT_FAIL, results[0]);
+    LT_TEST_ASSERT(LT_OK, results[1]);
+    LT_TEST_ASSERT(0, memcmp(pubkey, expected, sizeof(expected)));
+    LT_TEST_ASSERT(0, memcmp(key, zeros, sizeof(key)));
+    LT_TEST_ASSERT(1, lt_pool_is_healthy(&pool, 0));
+
+    LT_LOG_INFO("Rotating the key, the slots are erased first...");
+    memset(key, 0x6B, sizeof(key));
+    memset(expected, 0x96, sizeof(expected));
+    for (int i = 0; i < POOL_REPLICATE_DEVS; i++) {
+        pool_replicate_mock_status(hs[i], &nonces[i], TR01_L3_RESULT_OK);
+        pool_replicate_mock_status(hs[i], &nonces[i], TR01_L3_RESULT_OK);
+        pool_replicate_mock_read(hs[i], &nonces[i], TR01_CURVE_STORED, expected);
+    }
+    LT_TEST_ASSERT(LT_OK, lt_pool_replicate_key(&pool, slot, TR01_CURVE_P256, key, true, pubkey, results));
+    LT_TEST_ASSERT(0, memcmp(pubkey, expected, sizeof(expected)));
+    for (int i = 0; i < POOL_REPLICATE_DEVS; i++) {
+        pool_replicate_assert_consumed(hs[i]);
+    }
+
+    LT_LOG_INFO("Second device fails by HARDWARE_FAIL, it is quarantined and skipped by the next replication...");
+    memset(key, 0x6B, sizeof(key));
+    pool_replicate_mock_status(hs[0], &nonces[0], TR01_L3_RESULT_OK);
+    pool_replicate_mock_read(hs[0], &nonces[0], TR01_CURVE_STORED, expected);
+    pool_replicate_mock_status(hs[1], &nonces[1], TR01_L3_RESULT_HARDWARE_FAIL);
+    LT_TEST_ASSERT(LT_L3_HARDWARE_FAIL,
+                   lt_pool_replicate_key(&pool, slot, TR01_CURVE_P256, key, false, NULL, results));
+    LT_TEST_ASSERT(LT_OK, results[0]);
+    LT_TEST_ASSERT(LT_L3_HARDWARE_FAIL, results[1]);
+    LT_TEST_ASSERT(0, lt_pool_is_healthy(&pool, 1));
+
+    memset(key, 0x6B, sizeof(key));
+    pool_replicate_mock_status(hs[0], &nonces[0], TR01_L3_RESULT_SLOT_NOT_EMPTY);
+    pool_replicate_mock_read(hs[0], &nonces[0], TR01_CURVE_STORED, expected);
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION,
+                   lt_pool_replicate_key(&pool, slot, TR01_CURVE_P256, key, false, NULL, results));
+    LT_TEST_ASSERT(LT_OK, results[0]);
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, results[1]);
+    LT_TEST_ASSERT(0, lt_pool_depth(&pool, 1));
+    pool_replicate_assert_consumed(hs[0]);
+
+    LT_LOG_INFO("Deinitializing handles");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(hs[1]));
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,163 @@
+/**
+ * @file lt_test_mock_posix_shm_cache.c
+ * @brief Test shared memory cache of TROPIC01 identity data (LT_POSIX_SHM_CACHE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_POSIX_SHM_CACHE
+#include "libtropic_posix_shm_cache.h"
+
+/** Mocks Get_Info L2 Request returning the given object. */
+static void shm_cache_test_mock_get_info(lt_handle_t *h, const uint8_t *object, const uint8_t object_len)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = object_len,
+                                                 .object = {0}};
+    memcpy(get_info_resp.object, object, object_len);
+    add_resp_crc(&get_info_resp);
+
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp,
+                                                       calc_mocked_resp_len(&get_info_resp)));
+}
+
+/** Fills the entry of the chip with the serial number as lt_posix_shm_cache_init() does on a miss. */
+static void shm_cache_test_fill(lt_handle_t *h, lt_posix_shm_cache_entry_t *entry, const uint32_t sn)
+{
+    const uint8_t fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE] = {0x00, 0x01, 0x00, 0x01};
+    struct lt_chip_id_t chip_id;
+    memset(&chip_id, 0, sizeof(chip_id));
+    chip_id.ser_num.sn = (uint8_t)sn;
+
+    memset(entry, 0, sizeof(*entry));
+    snprintf(entry->dev, sizeof(entry->dev), "/dev/spidev%u.0", (unsigned)sn);
+    shm_cache_test_mock_get_info(h, (const uint8_t *)&chip_id, sizeof(chip_id));
+    shm_cache_test_mock_get_info(h, fw_ver, sizeof(fw_ver));
+    LT_TEST_ASSERT(LT_OK, lt_tr01_attrs_export(h, &entry->attrs));
+}
+#endif
+
+void lt_test_mock_posix_shm_cache(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_posix_shm_cache()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_POSIX_SHM_CACHE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_POSIX_SHM_CACHE is not enabled, skipping.");
+#else
+    const uint8_t fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE] = {0x00, 0x01, 0x00, 0x01};
+    const uint8_t spect_ver[TR01_L2_GET_INFO_SPECT_FW_SIZE] = {0x00, 0x00, 0x03, 0x01};
+    const char *dev = "/dev/spidev0.0";
+    struct lt_chip_id_t chip_id;
+    memset(&chip_id, 0, sizeof(chip_id));
+    chip_id.ser_num.sn = 0x42;
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+
+    char name[32];
+    snprintf(name, sizeof(name), "/lt_test_shm_%d", (int)getpid());
+    lt_posix_shm_cache_unlink(name);
+
+    LT_LOG_INFO("Mapping the segment twice, as two processes do...");
+    lt_posix_shm_cache_t shm_a, shm_b;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_posix_shm_cache_open(&shm_a, NULL));
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_open(&shm_a, name));
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_open(&shm_b, name));
+
+    LT_LOG_INFO("Checking parameters and an empty segment...");
+    lt_posix_shm_cache_entry_t entry, entry_b;
+    bool filled;
+    memset(&entry, 0, sizeof(entry));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_posix_shm_cache_get(&shm_a, NULL, NULL, &entry));
+    LT_TEST_ASSERT(LT_FAIL, lt_posix_shm_cache_get(&shm_a, dev, NULL, &entry));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_posix_shm_cache_put(&shm_a, &entry));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_posix_shm_cache_init(&shm_a, h, NULL, &entry, &filled));
+
+    LT_LOG_INFO("Initializing the first process, the entry is filled from TROPIC01...");
+    lt_mock_hal_reset(&h->l2);
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, fw_ver));
+    shm_cache_test_mock_get_info(h, (const uint8_t *)&chip_id, sizeof(chip_id));
+    shm_cache_test_mock_get_info(h, fw_ver, sizeof(fw_ver));
+    shm_cache_test_mock_get_info(h, spect_ver, sizeof(spect_ver));
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_init(&shm_a, h, dev, &entry, &filled));
+    LT_TEST_ASSERT(true, filled);
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(0, strcmp(entry.dev, dev));
+    LT_TEST_ASSERT(0, memcmp(entry.spect_fw_ver, spect_ver, sizeof(spect_ver)));
+    LT_TEST_ASSERT(false, lt_cert_cache_valid(&entry.certs));
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_put(&shm_a, &entry));
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+
+    LT_LOG_INFO("Initializing the second process from the segment without any communication...");
+    lt_mock_hal_reset(&h->l2);
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_init(&shm_b, h, dev, &entry_b, &filled));
+    LT_TEST_ASSERT(false, filled);
+    LT_TEST_ASSERT(1, h->tr01_attrs.unverified);
+    LT_TEST_ASSERT(0, memcmp(&entry, &entry_b, sizeof(entry)));
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+
+    LT_LOG_INFO("Finding the entry by CHIP_ID...");
+    memset(&entry_b, 0, sizeof(entry_b));
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_get(&shm_b, NULL, &chip_id, &entry_b));
+    LT_TEST_ASSERT(0, strcmp(entry_b.dev, dev));
+
+    LT_LOG_INFO("Publishing the same chip again replaces its entry...");
+    entry.spect_fw_ver[0] = 0x01;
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_put(&shm_b, &entry));
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_get(&shm_a, dev, NULL, &entry_b));
+    LT_TEST_ASSERT(0x01, entry_b.spect_fw_ver[0]);
+
+    LT_LOG_INFO("Publishing other chips, the least recently published entry is replaced once the segment is full...");
+    lt_mock_hal_reset(&h->l2);
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, fw_ver));
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    lt_posix_shm_cache_entry_t other;
+    for (uint32_t sn = 1; sn < LT_POSIX_SHM_CACHE_ENTRIES; sn++) {
+        shm_cache_test_fill(h, &other, sn);
+        LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_put(&shm_a, &other));
+    }
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_get(&shm_b, dev, NULL, &entry_b));
+    shm_cache_test_fill(h, &other, LT_POSIX_SHM_CACHE_ENTRIES);
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_put(&shm_a, &other));
+    LT_TEST_ASSERT(LT_FAIL, lt_posix_shm_cache_get(&shm_b, dev, NULL, &entry_b));
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_get(&shm_b, "/dev/spidev1.0", NULL, &entry_b));
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+
+    LT_LOG_INFO("Unmapping and removing the segment...");
+    lt_posix_shm_cache_close(&shm_a);
+    lt_posix_shm_cache_close(&shm_b);
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_unlink(name));
+
+    LT_LOG_INFO("Verifying a segment of another layout is refused...");
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+    LT_TEST_ASSERT(1, fd >= 0);
+    LT_TEST_ASSERT(0, ftruncate(fd, 4096));
+    close(fd);
+    LT_TEST_ASSERT(LT_FAIL, lt_posix_shm_cache_open(&shm_a, name));
+    LT_TEST_ASSERT(LT_OK, lt_posix_shm_cache_unlink(name));
+#endif
+}
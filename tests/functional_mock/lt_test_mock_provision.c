@@ -0,0 +1,267 @@
+/**
+ * @file lt_test_mock_provision.c
+ * @brief Test provisioning station bringing TROPIC01 devices to a declarative profile (LT_PROVISION).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_PROVISION
+/** Max number of L3 Results of one provisioning mocked by the test. */
+#define PROVISION_TEST_RESULTS 40
+/** Max size of a mocked L3 Result plaintext (ECC_Key_Read with P-256 key). */
+#define PROVISION_TEST_RES_SIZE (1 + 2 + 13 + TR01_CURVE_P256_PUBKEY_LEN)
+/** Number of mock queue entries taken by one L3 Command and its L3 Result. */
+#define PROVISION_TEST_QUEUE_PER_CMD 3
+
+/** L3 Results of one provisioning, in order of the L3 Commands. */
+typedef struct provision_test_script_t {
+    uint8_t res[PROVISION_TEST_RESULTS][PROVISION_TEST_RES_SIZE];
+    uint8_t len[PROVISION_TEST_RESULTS];
+    uint8_t count;
+    uint8_t next;
+} provision_test_script_t;
+
+/** Result reported by the callback of the device. */
+struct provision_test_dev_t {
+    int calls;    /**< Number of callback calls. */
+    lt_ret_t ret; /**< Result passed to the callback. */
+};
+
+static void provision_test_cb(lt_handle_t *h, lt_ret_t ret, void *cb_ctx)
+{
+    struct provision_test_dev_t *dev = cb_ctx;
+
+    LT_UNUSED(h);
+    dev->calls++;
+    dev->ret = ret;
+}
+
+/** Appends L3 Result with only the RESULT field. */
+static void provision_test_add(provision_test_script_t *s, const uint8_t result)
+{
+    s->res[s->count][0] = result;
+    s->len[s->count++] = TR01_L3_RESULT_SIZE;
+}
+
+/** Appends L3 Result of R_Config_Read or I_Config_Read. */
+static void provision_test_add_obj(provision_test_script_t *s, const uint32_t obj)
+{
+    uint8_t *res = s->res[s->count];
+
+    memset(res, 0, 4);
+    res[0] = TR01_L3_RESULT_OK;
+    memcpy(res + 4, &obj, sizeof(obj));
+    s->len[s->count++] = 4 + sizeof(obj);
+}
+
+/** Appends L3 Result of Pairing_Key_Read. */
+static void provision_test_add_pairing(provision_test_script_t *s, const uint8_t *pairing_pub)
+{
+    uint8_t *res = s->res[s->count];
+
+    memset(res, 0, 4);
+    res[0] = TR01_L3_RESULT_OK;
+    memcpy(res + 4, pairing_pub, TR01_SHIPUB_LEN);
+    s->len[s->count++] = 4 + TR01_SHIPUB_LEN;
+}
+
+/** Appends L3 Result of ECC_Key_Read with a generated key. */
+static void provision_test_add_key(provision_test_script_t *s, const lt_ecc_curve_type_t curve, const uint8_t *pubkey)
+{
+    const uint8_t len = (curve == TR01_CURVE_P256) ? TR01_CURVE_P256_PUBKEY_LEN : TR01_CURVE_ED25519_PUBKEY_LEN;
+    uint8_t *res = s->res[s->count];
+
+    memset(res, 0, 16);
+    res[0] = TR01_L3_RESULT_OK;
+    res[1] = (uint8_t)curve;
+    res[2] = TR01_CURVE_GENERATED;
+    memcpy(res + 16, pubkey, len);
+    s->len[s->count++] = 16 + len;
+}
+
+/**
+ * Runs the provisioning, the L3 Results of the script are mocked ahead as the mock queue allows, each encrypted with
+ * its decryption nonce.
+ */
+static lt_ret_t provision_test_run(lt_handle_t *h, lt_provision_t *p, provision_test_script_t *s, uint8_t *nonce)
+{
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+
+    while (lt_provision_pending(p)) {
+        while ((s->next < s->count) && (*queue_count + PROVISION_TEST_QUEUE_PER_CMD <= MOCK_QUEUE_DEPTH)) {
+            uint8_t iv[TR01_L3_IV_SIZE];
+            memcpy(iv, h->l3.decryption_IV, sizeof(iv));
+            h->l3.decryption_IV[0] = (*nonce)++;
+
+            lt_ret_t ret = mock_l3_command_responses(h, 1);
+            if (ret == LT_OK) {
+                ret = mock_l3_result(h, s->res[s->next], s->len[s->next]);
+            }
+            s->next++;
+
+            memcpy(h->l3.decryption_IV, iv, sizeof(iv));
+            if (ret != LT_OK) {
+                return ret;
+            }
+        }
+
+        lt_ret_t ret = lt_provision_process(p);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+
+    return LT_OK;
+}
+#endif
+
+void lt_test_mock_provision(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_provision()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_PROVISION
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_PROVISION is not enabled, skipping.");
+#else
+    static provision_test_script_t script;
+    static lt_provision_t station;
+    lt_provision_profile_t profile;
+    lt_l2_async_t op;
+    struct provision_test_dev_t dev;
+    struct lt_config_t r_config;
+    struct lt_config_t i_config;
+    uint8_t pairing_pub[2][TR01_SHIPUB_LEN];
+    uint8_t p256_pub[TR01_CURVE_P256_PUBKEY_LEN];
+    uint8_t ed25519_pub[TR01_CURVE_ED25519_PUBKEY_LEN];
+    uint8_t pubkeys[2][LT_PROVISION_PUBKEY_LEN];
+    uint16_t sent;
+    uint16_t skipped;
+    memset(&profile, 0, sizeof(profile));
+    memset(&op, 0, sizeof(op));
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, pairing_pub, sizeof(pairing_pub)));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, p256_pub, sizeof(p256_pub)));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, ed25519_pub, sizeof(ed25519_pub)));
+
+    LT_LOG_INFO("Checking parameters...");
+    const lt_provision_key_t keys[] = {{TR01_ECC_SLOT_3, TR01_CURVE_P256}, {TR01_ECC_SLOT_4, TR01_CURVE_ED25519}};
+    const lt_provision_key_t bad_key = {TR01_ECC_SLOT_3, (lt_ecc_curve_type_t)0};
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_provision_init(NULL, &profile));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_provision_init(&station, NULL));
+    profile.key_cnt = 1;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_provision_init(&station, &profile));
+    profile.keys = &bad_key;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_provision_init(&station, &profile));
+    profile.keys = keys;
+    profile.key_cnt = 2;
+    LT_TEST_ASSERT(LT_OK, lt_provision_init(&station, &profile));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_provision_add_device(&station, NULL, &op, NULL, NULL, NULL));
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_provision_add_device(&station, h, &op, NULL, NULL, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_provision_result(&station, 0, &sent, &skipped));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+
+    LT_LOG_INFO("Provisioning pairing keys, R-config and ECC keys, only the differences are written...");
+    memset(&r_config, 0xFF, sizeof(r_config));
+    r_config.obj[1] = 0x0000ABCD;
+    profile.pairing_pub[0] = pairing_pub[0];
+    profile.pairing_pub[1] = pairing_pub[1];
+    profile.r_config = &r_config;
+    memset(&script, 0, sizeof(script));
+    // Pairing key slot 0 holds the key already, slot 1 is empty.
+    provision_test_add_pairing(&script, pairing_pub[0]);
+    provision_test_add(&script, TR01_L3_RESULT_SLOT_EMPTY);
+    // R-config is erased, so only the changed object is written without R_Config_Erase.
+    for (uint8_t i = 0; i < LT_CONFIG_OBJ_CNT; i++) {
+        provision_test_add_obj(&script, 0xFFFFFFFF);
+    }
+    // ECC key slot 3 is empty, slot 4 holds the generated Ed25519 key already.
+    provision_test_add(&script, TR01_L3_RESULT_INVALID_KEY);
+    provision_test_add_key(&script, TR01_CURVE_ED25519, ed25519_pub);
+    // R_Config_Write, Pairing_Key_Write, ECC_Key_Generate.
+    provision_test_add(&script, TR01_L3_RESULT_OK);
+    provision_test_add(&script, TR01_L3_RESULT_OK);
+    provision_test_add(&script, TR01_L3_RESULT_OK);
+    // Readback of everything written.
+    provision_test_add_obj(&script, r_config.obj[1]);
+    provision_test_add_pairing(&script, pairing_pub[1]);
+    provision_test_add_key(&script, TR01_CURVE_P256, p256_pub);
+    memset(&dev, 0, sizeof(dev));
+    memset(pubkeys, 0, sizeof(pubkeys));
+    LT_TEST_ASSERT(LT_OK, lt_provision_init(&station, &profile));
+    LT_TEST_ASSERT(LT_OK, lt_provision_add_device(&station, h, &op, pubkeys[0], provision_test_cb, &dev));
+    LT_TEST_ASSERT(1, lt_provision_pending(&station));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_provision_result(&station, 0, NULL, NULL));
+    LT_TEST_ASSERT(LT_OK, provision_test_run(h, &station, &script, &nonce));
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+    LT_TEST_ASSERT(script.count, script.next);
+    LT_TEST_ASSERT(LT_OK, lt_provision_result(&station, 0, &sent, &skipped));
+    LT_TEST_ASSERT(script.count, sent);
+    LT_TEST_ASSERT(1 + (LT_CONFIG_OBJ_CNT - 1) + 1, skipped);
+    LT_TEST_ASSERT(1, dev.calls);
+    LT_TEST_ASSERT(LT_OK, dev.ret);
+    LT_TEST_ASSERT(0, memcmp(pubkeys[0], p256_pub, sizeof(p256_pub)));
+    LT_TEST_ASSERT(0, memcmp(pubkeys[1], ed25519_pub, sizeof(ed25519_pub)));
+
+    LT_LOG_INFO("Provisioning I-config which needs a cleared bit set again, nothing is written...");
+    memset(&profile, 0, sizeof(profile));
+    memset(&i_config, 0xFF, sizeof(i_config));
+    profile.i_config = &i_config;
+    memset(&script, 0, sizeof(script));
+    provision_test_add_obj(&script, 0xFFFFFFFE);
+    memset(&dev, 0, sizeof(dev));
+    LT_TEST_ASSERT(LT_OK, lt_provision_init(&station, &profile));
+    LT_TEST_ASSERT(LT_OK, lt_provision_add_device(&station, h, &op, NULL, provision_test_cb, &dev));
+    LT_TEST_ASSERT(LT_OK, provision_test_run(h, &station, &script, &nonce));
+    LT_TEST_ASSERT(LT_FAIL, lt_provision_result(&station, 0, &sent, NULL));
+    LT_TEST_ASSERT(1, sent);
+    LT_TEST_ASSERT(LT_FAIL, dev.ret);
+
+    LT_LOG_INFO("Provisioning I-config with one bit to clear, only that bit is written...");
+    i_config.obj[2] = 0xFFFFFFFB;
+    memset(&script, 0, sizeof(script));
+    for (uint8_t i = 0; i < LT_CONFIG_OBJ_CNT; i++) {
+        provision_test_add_obj(&script, 0xFFFFFFFF);
+    }
+    provision_test_add(&script, TR01_L3_RESULT_OK);
+    provision_test_add_obj(&script, i_config.obj[2]);
+    LT_TEST_ASSERT(LT_OK, lt_provision_init(&station, &profile));
+    LT_TEST_ASSERT(LT_OK, lt_provision_add_device(&station, h, &op, NULL, NULL, NULL));
+    LT_TEST_ASSERT(LT_OK, provision_test_run(h, &station, &script, &nonce));
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+    LT_TEST_ASSERT(LT_OK, lt_provision_result(&station, 0, &sent, &skipped));
+    LT_TEST_ASSERT(LT_CONFIG_OBJ_CNT + 2, sent);
+    LT_TEST_ASSERT(LT_CONFIG_OBJ_CNT - 1, skipped);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
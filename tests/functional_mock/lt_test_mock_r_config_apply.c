@@ -0,0 +1,65 @@
+/**
+ * @file lt_test_mock_r_config_apply.c
+ * @brief Test diff-based R-Config apply (lt_apply_R_config()).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_r_config_apply(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_r_config_apply()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_HELPERS
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_HELPERS is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    struct lt_config_t current;
+    memset(&current, 0xFF, sizeof(current));
+    current.obj[0] = 0x12345678;
+    struct lt_config_t config = current;
+    config.obj[1] = 0x0000ABCD;
+
+    LT_LOG_INFO("Applying config differing in one erased object, only that object has to be written...");
+    uint8_t ok_res[] = {TR01_L3_RESULT_OK};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ok_res, sizeof(ok_res)));
+    LT_TEST_ASSERT(LT_OK, lt_apply_R_config(h, &config, &current));
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+    LT_TEST_ASSERT(0, memcmp(&current, &config, sizeof(config)));
+
+    LT_LOG_INFO("Applying the same config again, no L3 Command has to be sent...");
+    LT_TEST_ASSERT(LT_OK, lt_apply_R_config(h, &config, &current));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,187 @@
+/**
+ * @file lt_test_mock_r_mem_map.c
+ * @brief Test occupancy map of R-mem user data slots (LT_R_MEM_MAP).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_R_MEM_MAP
+/** Slot holding the summary in the test. */
+#define R_MEM_MAP_TEST_SUMMARY_SLOT TR01_R_MEM_DATA_SLOT_MAX
+
+static lt_ret_t r_mem_map_test_mock_result(lt_handle_t *h, uint8_t *nonce, const uint8_t result)
+{
+    return mock_l3_command_result(h, nonce, &result, TR01_L3_RESULT_SIZE);
+}
+
+static lt_ret_t r_mem_map_test_mock_get(lt_handle_t *h, uint8_t *nonce, const uint32_t value)
+{
+    struct lt_l3_mcounter_get_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    res.mcounter_val = value;
+
+    return mock_l3_command_result(h, nonce, &res.result, TR01_L3_MCOUNTER_GET_RES_SIZE);
+}
+
+/** Mocks R_Mem_Data_Read result with data_len bytes of data, 0 for an empty slot. */
+static lt_ret_t r_mem_map_test_mock_read(lt_handle_t *h, uint8_t *nonce, const uint8_t *data, const uint16_t data_len)
+{
+    struct lt_l3_r_mem_data_read_res_t res;
+    memset(&res, 0, sizeof(res));
+    res.result = TR01_L3_RESULT_OK;
+    if (data_len) {
+        memcpy(res.data, data, data_len);
+    }
+
+    return mock_l3_command_result(h, nonce, &res.result, TR01_L3_RESULT_SIZE + sizeof(res.padding) + data_len);
+}
+
+/** Mocks R_Mem_Data_Read result of a summary stamped with stamp, with slots 0-2 occupied. */
+static lt_ret_t r_mem_map_test_mock_summary(lt_handle_t *h, uint8_t *nonce, const uint32_t stamp)
+{
+    uint8_t summary[4 + 4 + (4 * LT_R_MEM_MAP_WORDS)];
+    memset(summary, 0, sizeof(summary));
+    memcpy(summary, "LTRM", 4);
+    summary[4] = (uint8_t)stamp;
+    summary[5] = (uint8_t)(stamp >> 8);
+    summary[6] = (uint8_t)(stamp >> 16);
+    summary[7] = (uint8_t)(stamp >> 24);
+    summary[8] = 0x07;
+
+    return r_mem_map_test_mock_read(h, nonce, summary, sizeof(summary));
+}
+#endif
+
+void lt_test_mock_r_mem_map(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_r_mem_map()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_R_MEM_MAP
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_R_MEM_MAP is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t nonce = 0;
+
+    size_t *queue_count = &((lt_dev_mock_t *)h->l2.device)->mock_queue_count;
+    const uint8_t data[4] = {0xDE, 0xAD, 0xBE, 0xEF};
+    lt_r_mem_map_t map;
+    uint16_t slot;
+    bool occupied;
+    bool done;
+
+    LT_LOG_INFO("Attaching map and loading current summary...");
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_attach(&map, h, R_MEM_MAP_TEST_SUMMARY_SLOT, TR01_MCOUNTER_INDEX_3));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_summary(h, &nonce, 100));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_get(h, &nonce, 100));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_load(&map));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(1, (int)map.loads);
+
+    LT_LOG_INFO("Looking up slots, nothing has to be sent...");
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_find_free(&map, 0, &slot));
+    LT_TEST_ASSERT(3, slot);
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_is_occupied(&map, 1, &occupied));
+    LT_TEST_ASSERT(1, occupied);
+    LT_TEST_ASSERT(LT_FAIL, lt_r_mem_map_find_free(&map, R_MEM_MAP_TEST_SUMMARY_SLOT, &slot));
+    LT_TEST_ASSERT(0, (int)map.probes);
+
+    LT_LOG_INFO("Writing slot 3, the counter has to be decremented before the first change only...");
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_data_write(h, 3, data, sizeof(data)));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_data_erase(h, 0));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_find_free(&map, 0, &slot));
+    LT_TEST_ASSERT(0, slot);
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_find_free(&map, 1, &slot));
+    LT_TEST_ASSERT(4, slot);
+
+    LT_LOG_INFO("Failed write of slot 4, the slot has to be probed again...");
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_FAIL));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_r_mem_data_write(h, 4, data, sizeof(data)));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_read(h, &nonce, data, sizeof(data)));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_is_occupied(&map, 4, &occupied));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(1, occupied);
+    LT_TEST_ASSERT(1, (int)map.probes);
+
+    LT_LOG_INFO("Flushing summary and writing again, the counter has to be decremented again...");
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_get(h, &nonce, 99));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_flush(&map));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_flush(&map));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_data_write(h, 5, data, sizeof(data)));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Starting new Secure Session with stale summary, slots have to be probed...");
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    nonce = 0;
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_summary(h, &nonce, 99));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_get(h, &nonce, 98));
+    done = true;
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_scan_step(h, &map, &done));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(0, done);
+    LT_TEST_ASSERT(1, (int)map.loads);
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_read(h, &nonce, NULL, 0));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_find_free(&map, 0, &slot));
+    LT_TEST_ASSERT(0, slot);
+    LT_TEST_ASSERT(LT_FAIL, lt_r_mem_map_flush(&map));
+
+    LT_LOG_INFO("Scan step has to probe the next unknown slot...");
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_read(h, &nonce, data, sizeof(data)));
+    done = true;
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_scan_step(h, &map, &done));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+    LT_TEST_ASSERT(0, done);
+    LT_TEST_ASSERT(3, (int)map.probes);
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_is_occupied(&map, 1, &occupied));
+    LT_TEST_ASSERT(1, occupied);
+
+    LT_LOG_INFO("Detaching map, a write has to be sent alone...");
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_map_detach(&map));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_r_mem_map_find_free(&map, 0, &slot));
+    LT_TEST_ASSERT(LT_OK, r_mem_map_test_mock_result(h, &nonce, TR01_L3_RESULT_OK));
+    LT_TEST_ASSERT(LT_OK, lt_r_mem_data_write(h, 7, data, sizeof(data)));
+    LT_TEST_ASSERT(0, (int)*queue_count);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,100 @@
+/**
+ * @file lt_test_mock_read_ready_nowait.c
+ * @brief Test non-blocking polling for L2 Response offloaded to the port (LT_PORT_SPI_READ_READY_NOWAIT).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+/** Counts calls of the callback and keeps the last result. */
+struct read_ready_nowait_test_ctx_t {
+    int calls;
+    lt_ret_t ret;
+};
+
+static void read_ready_nowait_test_cb(lt_l2_async_t *op, lt_ret_t ret, void *cb_ctx)
+{
+    struct read_ready_nowait_test_ctx_t *ctx = (struct read_ready_nowait_test_ctx_t *)cb_ctx;
+
+    LT_UNUSED(op);
+    ctx->calls++;
+    ctx->ret = ret;
+}
+#endif
+
+void lt_test_mock_read_ready_nowait(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_read_ready_nowait()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_PORT_SPI_READ_READY_NOWAIT
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_PORT_SPI_READ_READY_NOWAIT is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Mocking Get_Info reply...");
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = TR01_L2_GET_INFO_RISCV_FW_SIZE,
+                                                 .object = {0x00, 0x00, 0x00, 0x02}};
+    add_resp_crc(&get_info_resp);
+    LT_TEST_ASSERT(
+        LT_OK, lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp, calc_mocked_resp_len(&get_info_resp)));
+
+    LT_LOG_INFO("Starting asynchronous Get_Info request...");
+    struct lt_l2_get_info_req_t *p_l2_req = (struct lt_l2_get_info_req_t *)h->l2.buff;
+    p_l2_req->req_id = TR01_L2_GET_INFO_REQ_ID;
+    p_l2_req->req_len = TR01_L2_GET_INFO_REQ_LEN;
+    p_l2_req->object_id = TR01_L2_GET_INFO_REQ_OBJECT_ID_RISCV_FW_VERSION;
+    p_l2_req->block_index = TR01_L2_GET_INFO_REQ_BLOCK_INDEX_DATA_CHUNK_0_127;
+
+    lt_l2_async_t op;
+    memset(&op, 0, sizeof(op));
+    struct read_ready_nowait_test_ctx_t ctx = {0, LT_FAIL};
+    LT_TEST_ASSERT(LT_OK, lt_l2_async_send(&op, &h->l2, read_ready_nowait_test_cb, &ctx));
+    lt_dev_mock_t *dev = (lt_dev_mock_t *)h->l2.device;
+    LT_TEST_ASSERT(1, (int)dev->mock_queue_count);
+
+    LT_LOG_INFO("Processing, polling is handed to the port and no frame is read...");
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_l2_async_process(&op));
+    LT_TEST_ASSERT(0, ctx.calls);
+    LT_TEST_ASSERT(1, (int)dev->mock_queue_count);
+    LT_TEST_ASSERT(1, dev->read_pending);
+
+    LT_LOG_INFO("Processing, polling ended and the response is received...");
+    LT_TEST_ASSERT(LT_OK, lt_l2_async_process(&op));
+    LT_TEST_ASSERT(1, ctx.calls);
+    LT_TEST_ASSERT(LT_OK, ctx.ret);
+    LT_TEST_ASSERT(0, lt_l2_async_busy(&op));
+    LT_TEST_ASSERT(0, (int)dev->mock_queue_count);
+    LT_TEST_ASSERT(0, memcmp(((struct lt_l2_get_info_rsp_t *)h->l2.buff)->object, get_info_resp.object,
+                             TR01_L2_GET_INFO_RISCV_FW_SIZE));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,176 @@
+/**
+ * @file lt_test_mock_reboot_async.c
+ * @brief Test asynchronous reboot and initialization of TROPIC01 (LT_REBOOT_ASYNC).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_crc16.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_REBOOT_ASYNC
+/** Maintenance Mode: CHIP_STATUS with READY and START bits. */
+#define REBOOT_ASYNC_MAINTENANCE (TR01_L1_CHIP_MODE_READY_bit | TR01_L1_CHIP_MODE_STARTUP_bit)
+
+/** Results passed to the callback. */
+typedef struct reboot_async_result_t {
+    lt_handle_t *h;
+    lt_ret_t ret;
+    int calls;
+} reboot_async_result_t;
+
+static void reboot_async_cb(lt_handle_t *h, lt_ret_t ret, void *cb_ctx)
+{
+    reboot_async_result_t *result = cb_ctx;
+    result->h = h;
+    result->ret = ret;
+    result->calls++;
+}
+
+/** Mocks Startup_Req and CHIP_STATUS read by each readiness poll. */
+static void reboot_async_mock(lt_handle_t *h, const uint8_t *polls, const size_t poll_cnt)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    uint8_t startup_rsp[TR01_L2_RSP_DATA_RSP_CRC_OFFSET + TR01_L2_REQ_RSP_CRC_SIZE]
+        = {TR01_L1_CHIP_MODE_READY_bit, TR01_L2_STATUS_REQUEST_OK, TR01_L2_STARTUP_RSP_LEN};
+    uint16_t crc = crc16(startup_rsp + 1, 2);
+    startup_rsp[TR01_L2_RSP_DATA_RSP_CRC_OFFSET] = crc >> 8;
+    startup_rsp[TR01_L2_RSP_DATA_RSP_CRC_OFFSET + 1] = crc & 0x00FF;
+
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, startup_rsp, sizeof(startup_rsp)));
+    for (size_t i = 0; i < poll_cnt; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &polls[i], 1));
+    }
+}
+
+/** Processes the reboot until it finishes, sleeping as lt_reboot_async_delay_ms() tells, counts the process calls. */
+static lt_ret_t reboot_async_finish(lt_handle_t *h, lt_reboot_async_t *r, int *reads)
+{
+    lt_ret_t ret;
+    *reads = 0;
+    do {
+        // The delay is rounded up, so each call after it reads CHIP_STATUS.
+        LT_TEST_ASSERT(LT_OK, lt_l1_delay(&h->l2, lt_reboot_async_delay_ms(r)));
+        ret = lt_reboot_async_process(r);
+        (*reads)++;
+    } while (ret == LT_L1_CHIP_BUSY);
+
+    return ret;
+}
+#endif
+
+void lt_test_mock_reboot_async(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_reboot_async()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_REBOOT_ASYNC
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_REBOOT_ASYNC is not enabled, skipping.");
+#else
+    lt_reboot_async_t r = {0};
+    reboot_async_result_t result = {0};
+    int reads;
+
+    LT_LOG_INFO("Checking parameters...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_reboot_async_start(NULL, h, TR01_REBOOT, NULL, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_reboot_async_start(&r, h, (lt_startup_id_t)0x55, NULL, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_init_async_start(&r, NULL, NULL, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_reboot_async_process(&r));
+    LT_TEST_ASSERT(0, lt_reboot_async_busy(&r));
+    LT_TEST_ASSERT(0, lt_reboot_async_delay_ms(&r));
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Initializing asynchronously, TROPIC01 is executing Application FW...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+    LT_TEST_ASSERT(LT_OK, lt_init_async_start(&r, h, reboot_async_cb, &result));
+    LT_TEST_ASSERT(1, lt_reboot_async_busy(&r));
+    LT_TEST_ASSERT(0, result.calls);
+    LT_TEST_ASSERT(LT_OK, lt_reboot_async_process(&r));
+    LT_TEST_ASSERT(1, result.calls);
+    LT_TEST_ASSERT(LT_OK, result.ret);
+    LT_TEST_ASSERT(1, result.h == h);
+    LT_TEST_ASSERT(475, h->tr01_attrs.r_mem_udata_slot_size_max);
+
+    LT_LOG_INFO("Rebooting, nothing is read before the minimal delay...");
+    const uint8_t app_polls[] = {0xFF, 0x00, REBOOT_ASYNC_MAINTENANCE, TR01_L1_CHIP_MODE_READY_bit};
+    reboot_async_mock(h, app_polls, sizeof(app_polls));
+    uint8_t final_status = TR01_L1_CHIP_MODE_READY_bit;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &final_status, 1));
+    result.calls = 0;
+    LT_TEST_ASSERT(LT_OK, lt_reboot_async_start(&r, h, TR01_REBOOT, reboot_async_cb, &result));
+    LT_TEST_ASSERT(1, lt_reboot_async_delay_ms(&r) > 0);
+    LT_TEST_ASSERT(1, lt_reboot_async_delay_ms(&r) <= LT_TR01_REBOOT_MIN_DELAY_MS);
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_reboot_async_process(&r));
+
+    LT_LOG_INFO("Polling until TROPIC01 is ready in Application Mode...");
+    LT_TEST_ASSERT(LT_OK, reboot_async_finish(h, &r, &reads));
+    LT_TEST_ASSERT((int)sizeof(app_polls), reads);
+    LT_TEST_ASSERT(1, result.calls);
+    LT_TEST_ASSERT(LT_OK, result.ret);
+    LT_TEST_ASSERT(0, lt_reboot_async_busy(&r));
+    // Finished reboot only reports its result again.
+    LT_TEST_ASSERT(LT_OK, lt_reboot_async_process(&r));
+    LT_TEST_ASSERT(1, result.calls);
+
+    LT_LOG_INFO("Rebooting into Maintenance Mode, TROPIC01 is still in Application Mode at first...");
+    const uint8_t maint_polls[] = {TR01_L1_CHIP_MODE_READY_bit, 0x00, REBOOT_ASYNC_MAINTENANCE};
+    reboot_async_mock(h, maint_polls, sizeof(maint_polls));
+    final_status = REBOOT_ASYNC_MAINTENANCE;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &final_status, 1));
+    LT_TEST_ASSERT(LT_OK, lt_reboot_async_start(&r, h, TR01_MAINTENANCE_REBOOT, NULL, NULL));
+    LT_TEST_ASSERT(LT_OK, reboot_async_finish(h, &r, &reads));
+    LT_TEST_ASSERT((int)sizeof(maint_polls), reads);
+
+#ifndef LT_RETRIEVE_ALARM_LOG
+    LT_LOG_INFO("Rebooting, TROPIC01 goes to Alarm Mode...");
+    const uint8_t alarm_polls[] = {0xFF, TR01_L1_CHIP_MODE_ALARM_bit};
+    reboot_async_mock(h, alarm_polls, sizeof(alarm_polls));
+    final_status = TR01_L1_CHIP_MODE_ALARM_bit;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &final_status, 1));
+    result.calls = 0;
+    LT_TEST_ASSERT(LT_OK, lt_reboot_async_start(&r, h, TR01_REBOOT, reboot_async_cb, &result));
+    LT_TEST_ASSERT(LT_L1_CHIP_ALARM_MODE, reboot_async_finish(h, &r, &reads));
+    LT_TEST_ASSERT(1, result.calls);
+    LT_TEST_ASSERT(LT_L1_CHIP_ALARM_MODE, result.ret);
+#endif
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+
+    LT_LOG_INFO("Initializing asynchronously, TROPIC01 is in Maintenance Mode and is rebooted...");
+    lt_mock_hal_reset(&h->l2);
+    final_status = REBOOT_ASYNC_MAINTENANCE;
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &final_status, 1));
+    const uint8_t init_polls[] = {0xFF, TR01_L1_CHIP_MODE_READY_bit};
+    reboot_async_mock(h, init_polls, sizeof(init_polls));
+    // Mode check after the reboot and Get_Info of the Application FW version.
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x01}));
+    result.calls = 0;
+    LT_TEST_ASSERT(LT_OK, lt_init_async_start(&r, h, reboot_async_cb, &result));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_reboot_async_process(&r));
+    LT_TEST_ASSERT(LT_OK, reboot_async_finish(h, &r, &reads));
+    LT_TEST_ASSERT((int)sizeof(init_polls), reads);
+    LT_TEST_ASSERT(1, result.calls);
+    LT_TEST_ASSERT(444, h->tr01_attrs.r_mem_udata_slot_size_max);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,102 @@
+/**
+ * @file lt_test_mock_reboot_poll.c
+ * @brief Test polling for readiness of TROPIC01 after reboot (LT_REBOOT_POLL).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_crc16.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_REBOOT_POLL
+/** Maintenance Mode: CHIP_STATUS with READY and START bits. */
+#define REBOOT_POLL_MAINTENANCE (TR01_L1_CHIP_MODE_READY_bit | TR01_L1_CHIP_MODE_STARTUP_bit)
+
+static uint64_t reboot_poll_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/**
+ * Mocks Startup_Req, CHIP_STATUS read by each readiness poll and the final CHIP_STATUS read by the mode check of
+ * lt_reboot().
+ */
+static void reboot_poll_mock(lt_handle_t *h, const uint8_t *polls, const size_t poll_cnt, const uint8_t final_status)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    uint8_t startup_rsp[TR01_L2_RSP_DATA_RSP_CRC_OFFSET + TR01_L2_REQ_RSP_CRC_SIZE]
+        = {TR01_L1_CHIP_MODE_READY_bit, TR01_L2_STATUS_REQUEST_OK, TR01_L2_STARTUP_RSP_LEN};
+    uint16_t crc = crc16(startup_rsp + 1, 2);
+    startup_rsp[TR01_L2_RSP_DATA_RSP_CRC_OFFSET] = crc >> 8;
+    startup_rsp[TR01_L2_RSP_DATA_RSP_CRC_OFFSET + 1] = crc & 0x00FF;
+
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, startup_rsp, sizeof(startup_rsp)));
+    for (size_t i = 0; i < poll_cnt; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &polls[i], 1));
+    }
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &final_status, 1));
+}
+#endif
+
+void lt_test_mock_reboot_poll(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_reboot_poll()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_REBOOT_POLL
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_REBOOT_POLL is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Rebooting, TROPIC01 is in reset, not ready and in Maintenance Mode before it comes up...");
+    const uint8_t app_polls[] = {0xFF, 0x00, REBOOT_POLL_MAINTENANCE, TR01_L1_CHIP_MODE_READY_bit};
+    reboot_poll_mock(h, app_polls, sizeof(app_polls), TR01_L1_CHIP_MODE_READY_bit);
+    uint64_t start_ms = reboot_poll_now_ms();
+    LT_TEST_ASSERT(LT_OK, lt_reboot(h, TR01_REBOOT));
+    LT_TEST_ASSERT(1, reboot_poll_now_ms() - start_ms < LT_TR01_REBOOT_DELAY_MS);
+
+    LT_LOG_INFO("Rebooting into Maintenance Mode, TROPIC01 is still in Application Mode at first...");
+    const uint8_t maint_polls[] = {TR01_L1_CHIP_MODE_READY_bit, 0x00, REBOOT_POLL_MAINTENANCE};
+    reboot_poll_mock(h, maint_polls, sizeof(maint_polls), REBOOT_POLL_MAINTENANCE);
+    LT_TEST_ASSERT(LT_OK, lt_reboot(h, TR01_MAINTENANCE_REBOOT));
+
+    LT_LOG_INFO("Rebooting, TROPIC01 comes up right after the minimal delay...");
+    const uint8_t ready_polls[] = {TR01_L1_CHIP_MODE_READY_bit};
+    reboot_poll_mock(h, ready_polls, sizeof(ready_polls), TR01_L1_CHIP_MODE_READY_bit);
+    LT_TEST_ASSERT(LT_OK, lt_reboot(h, TR01_REBOOT));
+
+#ifndef LT_RETRIEVE_ALARM_LOG
+    LT_LOG_INFO("Rebooting, TROPIC01 goes to Alarm Mode...");
+    const uint8_t alarm_polls[] = {0xFF, TR01_L1_CHIP_MODE_ALARM_bit};
+    reboot_poll_mock(h, alarm_polls, sizeof(alarm_polls), TR01_L1_CHIP_MODE_ALARM_bit);
+    LT_TEST_ASSERT(LT_L1_CHIP_ALARM_MODE, lt_reboot(h, TR01_REBOOT));
+#endif
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,94 @@
+/**
+ * @file lt_test_mock_resend.c
+ * @brief Test recovery from invalid L2 Response frames using Resend_Req.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_PORT_SPI_READ_READY
+/** CHIP_STATUS is polled by lt_port_spi_read_ready(), which is not counted in l1_polls. */
+#define RESEND_L1_POLLS 0
+#else
+/** One poll for the GEN_ERR reply to Get_Info and one for the reply to Resend_Req. */
+#define RESEND_L1_POLLS 2
+#endif
+
+void lt_test_mock_resend(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_resend()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+#ifdef LT_L2_STATS
+    LT_TEST_ASSERT(LT_OK, lt_reset_l2_stats(h));
+#endif
+#ifdef LT_STATS
+    LT_TEST_ASSERT(LT_OK, lt_reset_stats(h));
+#endif
+
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+
+    LT_LOG_INFO("Mocking GEN_ERR reply to Get_Info...");
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    uint8_t gen_err_frame[TR01_L2_MAX_FRAME_SIZE] = {TR01_L1_CHIP_MODE_READY_bit, TR01_L2_STATUS_GEN_ERR, 0x00};
+    add_resp_crc(gen_err_frame);
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, gen_err_frame, calc_mocked_resp_len(gen_err_frame)));
+
+    LT_LOG_INFO("Mocking valid reply to Resend_Req...");
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready)));
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = TR01_L2_GET_INFO_RISCV_FW_SIZE,
+                                                 .object = {0x00, 0x00, 0x00, 0x02}};
+    add_resp_crc(&get_info_resp);
+    LT_TEST_ASSERT(
+        LT_OK, lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp, calc_mocked_resp_len(&get_info_resp)));
+
+    LT_LOG_INFO("Sending Get_Info request, the response has to be recovered...");
+    uint8_t riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE];
+    LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    LT_TEST_ASSERT(0, memcmp(riscv_fw_ver, get_info_resp.object, sizeof(riscv_fw_ver)));
+
+#ifdef LT_L2_STATS
+    LT_LOG_INFO("Checking L2 error recovery counters...");
+    lt_l2_stats_t stats;
+    LT_TEST_ASSERT(LT_OK, lt_get_l2_stats(h, &stats));
+    LT_TEST_ASSERT(1, stats.rx_errors);
+    LT_TEST_ASSERT(1, stats.resends);
+    LT_TEST_ASSERT(1, stats.recovered);
+    LT_TEST_ASSERT(0, stats.unrecovered);
+#endif
+
+#ifdef LT_STATS
+    LT_LOG_INFO("Checking runtime statistics...");
+    lt_stats_t rt_stats;
+    LT_TEST_ASSERT(LT_OK, lt_get_stats(h, &rt_stats));
+    LT_TEST_ASSERT(1, rt_stats.l2_resends);
+    LT_TEST_ASSERT(0, rt_stats.l2_crc_errors);
+    LT_TEST_ASSERT(RESEND_L1_POLLS, rt_stats.l1_polls);
+    LT_TEST_ASSERT(0, rt_stats.l1_chip_busy);
+#endif
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+}
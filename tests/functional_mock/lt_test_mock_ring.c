@@ -0,0 +1,88 @@
+/**
+ * @file lt_test_mock_ring.c
+ * @brief Test lock-free submission and completion rings (LT_RING).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_test_common.h"
+
+#ifdef LT_RING
+/** Capacity of the rings of the test. */
+#define RING_CAP 4
+/** Pushes and pops across the wrap-around of the positions. */
+#define RING_ROUNDS 3
+#endif
+
+void lt_test_mock_ring(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_ring()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    LT_UNUSED(h);
+#ifndef LT_RING
+    LT_LOG_INFO("LT_RING is not enabled, skipping.");
+#else
+    lt_mpsc_ring_t sq;
+    lt_mpsc_slot_t sq_slots[RING_CAP];
+    lt_spsc_ring_t cq;
+    void *cq_items[RING_CAP];
+    uint8_t items[RING_CAP + 1];
+
+    LT_LOG_INFO("Checking parameters...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_mpsc_ring_init(NULL, sq_slots, RING_CAP));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_mpsc_ring_init(&sq, NULL, RING_CAP));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_mpsc_ring_init(&sq, sq_slots, 1));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_mpsc_ring_init(&sq, sq_slots, 3));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_spsc_ring_init(NULL, cq_items, RING_CAP));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_spsc_ring_init(&cq, NULL, RING_CAP));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_spsc_ring_init(&cq, cq_items, 6));
+    LT_TEST_ASSERT(LT_OK, lt_mpsc_ring_init(&sq, sq_slots, RING_CAP));
+    LT_TEST_ASSERT(LT_OK, lt_spsc_ring_init(&cq, cq_items, RING_CAP));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_mpsc_ring_push(&sq, NULL));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_spsc_ring_push(&cq, NULL));
+    LT_TEST_ASSERT(1, lt_mpsc_ring_pop(&sq) == NULL);
+    LT_TEST_ASSERT(1, lt_spsc_ring_pop(&cq) == NULL);
+
+    LT_LOG_INFO("Filling the rings, the next push is refused...");
+    for (uint8_t i = 0; i < RING_CAP; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_mpsc_ring_push(&sq, &items[i]));
+        LT_TEST_ASSERT(LT_OK, lt_spsc_ring_push(&cq, &items[i]));
+    }
+    LT_TEST_ASSERT(RING_CAP, lt_mpsc_ring_count(&sq));
+    LT_TEST_ASSERT(RING_CAP, lt_spsc_ring_count(&cq));
+    LT_TEST_ASSERT(LT_RING_FULL, lt_mpsc_ring_push(&sq, &items[RING_CAP]));
+    LT_TEST_ASSERT(LT_RING_FULL, lt_spsc_ring_push(&cq, &items[RING_CAP]));
+    LT_TEST_ASSERT(RING_CAP, lt_mpsc_ring_count(&sq));
+
+    LT_LOG_INFO("Popping the items in order...");
+    for (uint8_t i = 0; i < RING_CAP; i++) {
+        LT_TEST_ASSERT(1, lt_mpsc_ring_pop(&sq) == &items[i]);
+        LT_TEST_ASSERT(1, lt_spsc_ring_pop(&cq) == &items[i]);
+    }
+    LT_TEST_ASSERT(0, lt_mpsc_ring_count(&sq));
+    LT_TEST_ASSERT(0, lt_spsc_ring_count(&cq));
+    LT_TEST_ASSERT(1, lt_mpsc_ring_pop(&sq) == NULL);
+
+    LT_LOG_INFO("Pushing and popping across the wrap-around...");
+    for (uint8_t round = 0; round < RING_ROUNDS * RING_CAP; round++) {
+        LT_TEST_ASSERT(LT_OK, lt_mpsc_ring_push(&sq, &items[round % RING_CAP]));
+        LT_TEST_ASSERT(LT_OK, lt_mpsc_ring_push(&sq, &items[(round + 1) % RING_CAP]));
+        LT_TEST_ASSERT(LT_OK, lt_spsc_ring_push(&cq, &items[round % RING_CAP]));
+        LT_TEST_ASSERT(1, lt_mpsc_ring_pop(&sq) == &items[round % RING_CAP]);
+        LT_TEST_ASSERT(1, lt_mpsc_ring_pop(&sq) == &items[(round + 1) % RING_CAP]);
+        LT_TEST_ASSERT(1, lt_spsc_ring_pop(&cq) == &items[round % RING_CAP]);
+    }
+    LT_TEST_ASSERT(0, lt_mpsc_ring_count(&sq));
+    LT_TEST_ASSERT(0, lt_spsc_ring_count(&cq));
+#endif
+}
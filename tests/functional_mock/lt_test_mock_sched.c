@@ -0,0 +1,113 @@
+/**
+ * @file lt_test_mock_sched.c
+ * @brief Test priority scheduler of jobs (LT_SCHED).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_test_common.h"
+
+#ifdef LT_SCHED
+/** Max number of steps recorded by the test jobs. */
+#define SCHED_LOG_LEN 16
+
+/** Job of the test, records its steps into the shared log. */
+struct sched_job_t {
+    lt_sched_t *s;
+    char *log;       /**< Shared log of the steps, one character per step. */
+    char name;       /**< Character recorded by the job. */
+    int steps;       /**< Number of steps of the job. */
+    int done_steps;  /**< Number of executed steps. */
+    int fail_at;     /**< Step which fails, 0 never. */
+    struct sched_job_t *urgent;  /**< Job submitted as urgent by the first step, may be NULL. */
+    lt_ret_t urgent_ret;
+};
+
+static lt_ret_t sched_job_step(lt_handle_t *h, void *ctx, bool *done)
+{
+    LT_UNUSED(h);
+    struct sched_job_t *job = (struct sched_job_t *)ctx;
+
+    size_t len = strlen(job->log);
+    if (len < SCHED_LOG_LEN - 1) {
+        job->log[len] = job->name;
+    }
+    job->done_steps++;
+
+    if (job->urgent && (job->done_steps == 1)) {
+        lt_ret_t ret = lt_sched_submit(job->s, LT_SCHED_PRIO_URGENT, sched_job_step, job->urgent, &job->urgent_ret);
+        if (ret != LT_OK) {
+            return ret;
+        }
+    }
+    if (job->done_steps == job->fail_at) {
+        return LT_L3_FAIL;
+    }
+    *done = (job->done_steps >= job->steps);
+
+    return LT_OK;
+}
+#endif
+
+void lt_test_mock_sched(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_sched()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_SCHED
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_SCHED is not enabled, skipping.");
+#else
+    lt_sched_t s;
+    lt_sched_stats_t stats;
+    char log[SCHED_LOG_LEN] = {0};
+    lt_ret_t ret_bulk = LT_FAIL, ret_normal = LT_FAIL, ret_failing = LT_OK;
+
+    struct sched_job_t urgent = {.s = &s, .log = log, .name = 'U', .steps = 1};
+    struct sched_job_t bulk = {.s = &s, .log = log, .name = 'B', .steps = 3, .urgent = &urgent};
+    struct sched_job_t normal = {.s = &s, .log = log, .name = 'N', .steps = 1};
+    struct sched_job_t failing = {.s = &s, .log = log, .name = 'F', .steps = 3, .fail_at = 2};
+
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_sched_init(&s, NULL));
+    LT_TEST_ASSERT(LT_OK, lt_sched_init(&s, h));
+    LT_TEST_ASSERT(LT_FAIL, lt_sched_step(&s));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_sched_submit(&s, LT_SCHED_PRIOS, sched_job_step, &bulk, NULL));
+
+    LT_LOG_INFO("Running jobs, urgent job submitted meanwhile has to go between steps of the bulk job...");
+    LT_TEST_ASSERT(LT_OK, lt_sched_submit(&s, LT_SCHED_PRIO_BULK, sched_job_step, &bulk, &ret_bulk));
+    LT_TEST_ASSERT(LT_OK, lt_sched_submit(&s, LT_SCHED_PRIO_BULK, sched_job_step, &failing, &ret_failing));
+    LT_TEST_ASSERT(LT_OK, lt_sched_submit(&s, LT_SCHED_PRIO_NORMAL, sched_job_step, &normal, &ret_normal));
+    LT_TEST_ASSERT(3, lt_sched_pending(&s));
+    LT_TEST_ASSERT(LT_OK, lt_sched_run(&s));
+    LT_TEST_ASSERT(0, lt_sched_pending(&s));
+    LT_TEST_ASSERT(0, strcmp(log, "NBUBBFF"));
+
+    LT_LOG_INFO("Verifying results...");
+    LT_TEST_ASSERT(LT_OK, ret_bulk);
+    LT_TEST_ASSERT(LT_OK, ret_normal);
+    LT_TEST_ASSERT(LT_OK, bulk.urgent_ret);
+    LT_TEST_ASSERT(LT_L3_FAIL, ret_failing);
+
+    LT_LOG_INFO("Verifying counters...");
+    LT_TEST_ASSERT(LT_OK, lt_sched_get_stats(&s, &stats));
+    LT_TEST_ASSERT(1, (int)stats.jobs[LT_SCHED_PRIO_URGENT]);
+    LT_TEST_ASSERT(1, (int)stats.jobs[LT_SCHED_PRIO_NORMAL]);
+    LT_TEST_ASSERT(2, (int)stats.jobs[LT_SCHED_PRIO_BULK]);
+    LT_TEST_ASSERT(7, (int)stats.steps);
+    LT_TEST_ASSERT(1, (int)stats.preemptions);
+
+    LT_LOG_INFO("Verifying full queue is refused...");
+    for (int i = 0; i < LT_SCHED_QUEUE_LEN; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_sched_submit(&s, LT_SCHED_PRIO_NORMAL, sched_job_step, &normal, NULL));
+    }
+    LT_TEST_ASSERT(LT_FAIL, lt_sched_submit(&s, LT_SCHED_PRIO_URGENT, sched_job_step, &urgent, NULL));
+#endif
+}
@@ -0,0 +1,126 @@
+/**
+ * @file lt_test_mock_session_export.c
+ * @brief Test export and import of a live Secure Session (LT_SESSION_EXPORT).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_SESSION_EXPORT
+/** Mocks reply to Ping and sends it, so both nonces of the session move on. */
+static lt_ret_t session_export_ping(lt_handle_t *h)
+{
+    uint8_t ping_out[16];
+    uint8_t ping_in[sizeof(ping_out)] = {0};
+    uint8_t ping_res[1 + sizeof(ping_out)] = {TR01_L3_RESULT_OK};
+    memset(ping_out, 0xA5, sizeof(ping_out));
+    memcpy(ping_res + 1, ping_out, sizeof(ping_out));
+
+    lt_ret_t ret = mock_l3_command_responses(h, 1);
+    if (ret == LT_OK) {
+        ret = mock_l3_result(h, ping_res, sizeof(ping_res));
+    }
+    if (ret == LT_OK) {
+        ret = lt_ping(h, ping_out, ping_in, sizeof(ping_out));
+    }
+    if ((ret == LT_OK) && memcmp(ping_out, ping_in, sizeof(ping_out))) {
+        ret = LT_FAIL;
+    }
+
+    return ret;
+}
+#endif
+
+void lt_test_mock_session_export(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_session_export()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_SESSION_EXPORT
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_SESSION_EXPORT is not enabled, skipping.");
+#else
+    uint8_t wrap_key[LT_SESSION_WRAP_KEY_LEN];
+    uint8_t other_key[LT_SESSION_WRAP_KEY_LEN];
+    lt_session_blob_t blob;
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, wrap_key, sizeof(wrap_key)));
+    memcpy(other_key, wrap_key, sizeof(other_key));
+    other_key[0] ^= 0x01;
+
+    LT_LOG_INFO("Checking parameters...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_session_export(NULL, wrap_key, &blob));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_session_export(h, NULL, &blob));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_session_export(h, wrap_key, NULL));
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_session_export(h, wrap_key, &blob));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_session_import(NULL, wrap_key, &blob));
+
+    LT_LOG_INFO("Setting up session and sending a command...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    LT_TEST_ASSERT(LT_OK, session_export_ping(h));
+    uint8_t encryption_iv[TR01_L3_IV_SIZE];
+    uint8_t decryption_iv[TR01_L3_IV_SIZE];
+    memcpy(encryption_iv, h->l3.encryption_IV, sizeof(encryption_iv));
+    memcpy(decryption_iv, h->l3.decryption_IV, sizeof(decryption_iv));
+
+    LT_LOG_INFO("Exporting the session, the handle gives it up...");
+    LT_TEST_ASSERT(LT_OK, lt_session_export(h, wrap_key, &blob));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_OFF, h->l3.session_status);
+    LT_TEST_ASSERT(LT_HOST_NO_SESSION, lt_session_export(h, wrap_key, &blob));
+
+    LT_LOG_INFO("Restarting the handle as a new process would...");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+    lt_mock_hal_reset(&h->l2);
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Verifying blobs which are not authentic are refused and kept...");
+    LT_TEST_ASSERT(LT_CRYPTO_ERR, lt_session_import(h, other_key, &blob));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_OFF, h->l3.session_status);
+    blob.sealed[0] ^= 0x01;
+    LT_TEST_ASSERT(LT_CRYPTO_ERR, lt_session_import(h, wrap_key, &blob));
+    blob.sealed[0] ^= 0x01;
+    blob.version++;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_session_import(h, wrap_key, &blob));
+    blob.version--;
+    blob.rfu = 1;
+    LT_TEST_ASSERT(LT_CRYPTO_ERR, lt_session_import(h, wrap_key, &blob));
+    blob.rfu = 0;
+
+    LT_LOG_INFO("Importing the session, the blob is consumed...");
+    LT_TEST_ASSERT(LT_OK, lt_session_import(h, wrap_key, &blob));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+    LT_TEST_ASSERT(0, memcmp(h->l3.encryption_IV, encryption_iv, sizeof(encryption_iv)));
+    LT_TEST_ASSERT(0, memcmp(h->l3.decryption_IV, decryption_iv, sizeof(decryption_iv)));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_session_import(h, wrap_key, &blob));
+
+    LT_LOG_INFO("Sending a command in the resumed session...");
+    LT_TEST_ASSERT(LT_OK, session_export_ping(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
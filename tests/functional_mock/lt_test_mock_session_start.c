@@ -0,0 +1,475 @@
+/**
+ * @file lt_test_mock_session_start.c
+ * @brief Test Secure Channel Handshake against TROPIC01's side of the handshake simulated by the test.
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_mbedtls_v4.h"
+#include "libtropic_port_mock.h"
+#include "libtropic_posix_rng.h"
+#include "lt_aesgcm.h"
+#include "lt_crypto_common.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_hkdf.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_sha256.h"
+#include "lt_test_common.h"
+#include "lt_x25519.h"
+
+/** Seed of the mock HAL's random generator, so the test knows EHPRIV which lt_session_start() generates. */
+#define LT_TEST_MOCK_SESSION_SEED 1234
+
+/** Crypto context of TROPIC01's side of the handshake, the one of the handle holds the host's Secure Session. */
+static lt_ctx_mbedtls_v4_t mock_tr01_crypto_ctx;
+#ifdef LT_CRYPTO_OPS
+static lt_crypto_ops_ctx_t mock_tr01_crypto_ops_ctx;
+#endif
+
+/**
+ * @brief Returns initialized crypto context of TROPIC01's side, NULL on failure.
+ */
+static void *mock_tr01_crypto_init(void)
+{
+    void *ctx = &mock_tr01_crypto_ctx;
+#ifdef LT_CRYPTO_OPS
+    if (lt_crypto_ops_set(&mock_tr01_crypto_ops_ctx, &lt_crypto_ops_mbedtls_v4, &mock_tr01_crypto_ctx) != LT_OK) {
+        return NULL;
+    }
+    ctx = &mock_tr01_crypto_ops_ctx;
+#endif
+
+    return (lt_crypto_ctx_init(ctx) == LT_OK) ? ctx : NULL;
+}
+
+/**
+ * @brief Mixes data into transcript hash: h = SHA256(h||data).
+ */
+static lt_ret_t mock_hash_step(void *ctx, uint8_t *hash, const uint8_t *data, const size_t len)
+{
+    lt_ret_t ret = lt_sha256_start(ctx);
+    if (ret == LT_OK) {
+        ret = lt_sha256_update(ctx, hash, LT_SHA256_DIGEST_LENGTH);
+    }
+    if (ret == LT_OK) {
+        ret = lt_sha256_update(ctx, data, len);
+    }
+    if (ret == LT_OK) {
+        ret = lt_sha256_finish(ctx, hash);
+    }
+    return ret;
+}
+
+#ifdef LT_SESSION_MGR
+/** @brief Context of a session manager request in the test. */
+struct mock_mgr_req_t {
+    char tag;  /**< Appended to the log when the request is executed. */
+    char *log; /**< Execution log. */
+};
+
+/**
+ * @brief Session manager request, appends its tag to the execution log.
+ */
+static lt_ret_t mock_mgr_req(lt_handle_t *h, void *ctx)
+{
+    struct mock_mgr_req_t *req = ctx;
+    size_t len = strlen(req->log);
+
+    req->log[len] = req->tag;
+    req->log[len + 1] = '\0';
+
+    return (h->l3.session_status == LT_SECURE_SESSION_ON) ? LT_OK : LT_HOST_NO_SESSION;
+}
+#endif
+
+/**
+ * @brief Enqueues Handshake_Rsp, which TROPIC01 would send for the given Handshake_Req.
+ *
+ * @param h           Handle
+ * @param stpriv      TROPIC01's X25519 private key
+ * @param stpub       TROPIC01's X25519 public key
+ * @param shipub      Host's public pairing key
+ * @param pkey_index  Pairing key slot
+ * @param ehpub       Host's ephemeral key sent in Handshake_Req
+ * @return            LT_OK on success, error code otherwise.
+ */
+static lt_ret_t mock_handshake_rsp(lt_handle_t *h, const uint8_t *stpriv, const uint8_t *stpub,
+                                   const uint8_t *shipub, const uint8_t pkey_index, const uint8_t *ehpub)
+{
+    uint8_t protocol_name[32] = {'N', 'o', 'i', 's', 'e', '_', 'K', 'K', '1', '_', '2', '5', '5', '1',  '9',  '_',
+                                 'A', 'E', 'S', 'G', 'C', 'M', '_', 'S', 'H', 'A', '2', '5', '6', 0x00, 0x00, 0x00};
+    struct lt_l2_handshake_rsp_t rsp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                        .status = TR01_L2_STATUS_REQUEST_OK,
+                                        .rsp_len = TR01_ETPUB_LEN + 16};
+    uint8_t etpriv[TR01_ETPRIV_LEN];
+    uint8_t hash[LT_SHA256_DIGEST_LENGTH];
+    uint8_t ck[33] = {0};  // Last byte is not written by HKDF, but is part of ck (as in the host code).
+    uint8_t kauth[32], unused[32];
+    uint8_t shared[TR01_X25519_KEY_LEN];
+    uint8_t iv[TR01_L3_IV_SIZE] = {0};
+    void *ctx = mock_tr01_crypto_init();
+    if (!ctx) {
+        return LT_CRYPTO_ERR;
+    }
+
+    lt_ret_t ret = lt_random_bytes(h, etpriv, sizeof(etpriv));
+    if (ret == LT_OK) {
+        ret = lt_X25519_scalarmult(etpriv, rsp.e_tpub);
+    }
+
+    // Transcript hash
+    if (ret == LT_OK) {
+        ret = lt_sha256_init(ctx);
+    }
+    if (ret == LT_OK) {
+        ret = lt_sha256_start(ctx);
+    }
+    if (ret == LT_OK) {
+        ret = lt_sha256_update(ctx, protocol_name, sizeof(protocol_name));
+    }
+    if (ret == LT_OK) {
+        ret = lt_sha256_finish(ctx, hash);
+    }
+    if (ret == LT_OK) {
+        ret = mock_hash_step(ctx, hash, shipub, TR01_SHIPUB_LEN);
+    }
+    if (ret == LT_OK) {
+        ret = mock_hash_step(ctx, hash, stpub, TR01_STPUB_LEN);
+    }
+    if (ret == LT_OK) {
+        ret = mock_hash_step(ctx, hash, ehpub, TR01_EHPUB_LEN);
+    }
+    if (ret == LT_OK) {
+        ret = mock_hash_step(ctx, hash, &pkey_index, 1);
+    }
+    if (ret == LT_OK) {
+        ret = mock_hash_step(ctx, hash, rsp.e_tpub, TR01_ETPUB_LEN);
+    }
+    lt_ret_t ret_unused = lt_sha256_deinit(ctx);
+    LT_UNUSED(ret_unused);
+
+    // Key derivation from TROPIC01's side
+    if (ret == LT_OK) {
+        ret = lt_X25519(etpriv, ehpub, shared);
+    }
+    if (ret == LT_OK) {
+        ret = lt_hkdf(ctx, protocol_name, sizeof(protocol_name), shared, sizeof(shared), 1, ck,
+                      unused);
+    }
+    if (ret == LT_OK) {
+        ret = lt_X25519(etpriv, shipub, shared);
+    }
+    if (ret == LT_OK) {
+        ret = lt_hkdf(ctx, ck, sizeof(ck), shared, sizeof(shared), 1, ck, unused);
+    }
+    if (ret == LT_OK) {
+        ret = lt_X25519(stpriv, ehpub, shared);
+    }
+    if (ret == LT_OK) {
+        ret = lt_hkdf(ctx, ck, sizeof(ck), shared, sizeof(shared), 2, ck, kauth);
+    }
+
+    // Authentication tag
+    if (ret == LT_OK) {
+        ret = lt_aesgcm_encrypt_init(ctx, kauth, sizeof(kauth));
+    }
+    if (ret == LT_OK) {
+        ret = lt_aesgcm_encrypt(ctx, iv, sizeof(iv), hash, sizeof(hash), (uint8_t *)"", 0, rsp.t_tauth,
+                                sizeof(rsp.t_tauth));
+    }
+    ret_unused = lt_crypto_ctx_deinit(ctx);
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    ret = lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready));
+    if (ret != LT_OK) {
+        return ret;
+    }
+    add_resp_crc(&rsp);
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp));
+}
+
+#ifdef LT_BRINGUP
+/**
+ * @brief Enqueues the first block of the certificate store, holding only a minimal device certificate with STPUB.
+ *
+ * @param h           Handle
+ * @param version     Version of the certificate store in its header
+ * @param stpub       TROPIC01's X25519 public key
+ * @return            LT_OK on success, error code otherwise.
+ */
+static lt_ret_t mock_cert_store(lt_handle_t *h, const uint8_t version, const uint8_t *stpub)
+{
+    // SEQUENCE { SEQUENCE { OBJECT IDENTIFIER 1.3.101.110 } BIT STRING STPUB }
+    const uint8_t cert_head[] = {0x30, 0x2a, 0x30, 0x05, 0x06, 0x03, 0x2b, 0x65, 0x6e, 0x03, 0x21, 0x00};
+    const uint16_t cert_len = sizeof(cert_head) + TR01_STPUB_LEN;
+    struct lt_l2_get_info_rsp_t rsp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                       .status = TR01_L2_STATUS_REQUEST_OK,
+                                       .rsp_len = 128,
+                                       .object = {version, LT_NUM_CERTIFICATES, cert_len >> 8, cert_len & 0xff}};
+    uint8_t *cert = rsp.object + 2 + 2 * LT_NUM_CERTIFICATES;
+    memcpy(cert, cert_head, sizeof(cert_head));
+    memcpy(cert + sizeof(cert_head), stpub, TR01_STPUB_LEN);
+
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    lt_ret_t ret = lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready));
+    if (ret != LT_OK) {
+        return ret;
+    }
+    add_resp_crc(&rsp);
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&rsp, calc_mocked_resp_len(&rsp));
+}
+
+/** @brief Result of a device bring-up in the test. */
+struct mock_bringup_dev_t {
+    int calls;                     /**< Number of callback calls. */
+    lt_ret_t ret;                  /**< Result passed to the callback. */
+    uint8_t stpub[TR01_STPUB_LEN]; /**< STPUB passed to the callback. */
+};
+
+static void mock_bringup_cb(lt_handle_t *h, lt_ret_t ret, const uint8_t *stpub, void *cb_ctx)
+{
+    struct mock_bringup_dev_t *dev = cb_ctx;
+
+    LT_UNUSED(h);
+    dev->calls++;
+    dev->ret = ret;
+    if (stpub) {
+        memcpy(dev->stpub, stpub, sizeof(dev->stpub));
+    }
+}
+#endif
+
+void lt_test_mock_session_start(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_session_start()");
+    LT_LOG_INFO("----------------------------------------------");
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    uint8_t stpriv[TR01_STPRIV_LEN], stpub[TR01_STPUB_LEN];
+    uint8_t shipriv[TR01_SHIPRIV_LEN], shipub[TR01_SHIPUB_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, stpriv, sizeof(stpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(stpriv, stpub));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, shipriv, sizeof(shipriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(shipriv, shipub));
+
+    LT_LOG_INFO("Mocking Handshake_Rsp for lt_session_start()...");
+    lt_host_eph_keys_t eph_keys;
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, eph_keys.ehpriv, sizeof(eph_keys.ehpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(eph_keys.ehpriv, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+
+    LT_LOG_INFO("Starting Secure Session...");
+    LT_TEST_ASSERT(LT_OK, lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv, shipub));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+
+#ifdef LT_SESSION_ROLLOVER
+    LT_LOG_INFO("Rolling Secure Session over when the nonce reaches the threshold...");
+    LT_TEST_ASSERT(LT_OK, lt_session_rollover_enable(h, 0x100, stpub, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv, shipub));
+    LT_TEST_ASSERT(0, lt_session_rollover_due(h));
+    LT_TEST_ASSERT(LT_OK, lt_session_rollover_poll(h));
+    LT_TEST_ASSERT(0, lt_session_rollover_count(h));
+    // Pretend 0x100 L3 Commands were sent in the session.
+    h->l3.encryption_IV[1] = 0x01;
+    h->l3.decryption_IV[1] = 0x01;
+    LT_TEST_ASSERT(1, lt_session_rollover_due(h));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, eph_keys.ehpriv, sizeof(eph_keys.ehpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(eph_keys.ehpriv, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_session_rollover_poll(h));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+    LT_TEST_ASSERT(1, lt_session_rollover_count(h));
+    LT_TEST_ASSERT(0, lt_session_rollover_due(h));
+    LT_TEST_ASSERT(LT_OK, lt_session_rollover_disable(h));
+#endif
+
+#ifdef LT_SESSION_CACHE
+    LT_LOG_INFO("Initializing session cache...");
+    lt_session_cache_t cache;
+    LT_TEST_ASSERT(LT_OK, lt_session_cache_init(h, &cache, stpub, shipub));
+
+    LT_LOG_INFO("Starting Secure Session without prepared keys...");
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, eph_keys.ehpriv, sizeof(eph_keys.ehpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(eph_keys.ehpriv, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_session_start_cached(h, &cache, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+
+    LT_LOG_INFO("Starting Secure Session with keys prepared in idle time...");
+    LT_TEST_ASSERT(LT_OK, lt_session_cache_prepare(h, &cache));
+    LT_TEST_ASSERT(LT_SESSION_CACHE_EPH_KEYS, (uint8_t)(cache.eph_head - cache.eph_tail));
+    // Oldest key pair is taken first.
+    memcpy(&eph_keys, &cache.eph[cache.eph_tail % LT_SESSION_CACHE_EPH_KEYS].keys, sizeof(eph_keys));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, lt_session_start_cached(h, &cache, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+    LT_TEST_ASSERT(LT_SESSION_CACHE_EPH_KEYS - 1, (uint8_t)(cache.eph_head - cache.eph_tail));
+
+    LT_TEST_ASSERT(1, cache.hits);
+    LT_TEST_ASSERT(1, cache.misses);
+
+    LT_LOG_INFO("Starting Secure Session by lt_session_start(), transcript prefix is taken from the attached cache...");
+    // Initialization drops the prepared keys and resets the counters.
+    LT_TEST_ASSERT(LT_OK, lt_session_cache_init(h, &cache, stpub, shipub));
+    LT_TEST_ASSERT(LT_OK, lt_session_cache_attach(h, &cache));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, eph_keys.ehpriv, sizeof(eph_keys.ehpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(eph_keys.ehpriv, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv, shipub));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+
+    LT_LOG_INFO("Verifying the prefix of the attached cache is really used...");
+    cache.prefix_hash[0] ^= 0x01;
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, eph_keys.ehpriv, sizeof(eph_keys.ehpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(eph_keys.ehpriv, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(1, lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv, shipub) != LT_OK);
+    cache.prefix_hash[0] ^= 0x01;
+
+    LT_LOG_INFO("Starting Secure Session by lt_session_start() with keys prepared in the attached cache...");
+    LT_TEST_ASSERT(LT_OK, lt_session_cache_prepare(h, &cache));
+    memcpy(&eph_keys, &cache.eph[cache.eph_tail % LT_SESSION_CACHE_EPH_KEYS].keys, sizeof(eph_keys));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, lt_session_start(h, stpub, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv, shipub));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+    LT_TEST_ASSERT(LT_SESSION_CACHE_EPH_KEYS - 1, (uint8_t)(cache.eph_head - cache.eph_tail));
+    LT_TEST_ASSERT(false, cache.eph_in_use);
+
+    LT_TEST_ASSERT(1, cache.hits);
+    LT_TEST_ASSERT(2, cache.misses);
+
+    LT_TEST_ASSERT(LT_OK, lt_session_cache_attach(h, NULL));
+    lt_session_cache_clear(&cache);
+#endif
+
+#ifdef LT_SESSION_MGR
+    LT_LOG_INFO("Executing requests of two pairing key slots by session manager...");
+    uint8_t shipriv2[TR01_SHIPRIV_LEN], shipub2[TR01_SHIPUB_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, shipriv2, sizeof(shipriv2)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(shipriv2, shipub2));
+
+    lt_session_mgr_t mgr;
+    lt_session_mgr_stats_t stats;
+    LT_TEST_ASSERT(LT_OK, lt_session_mgr_init(&mgr, h, stpub));
+    LT_TEST_ASSERT(LT_OK, lt_session_mgr_set_keys(&mgr, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv, shipub));
+    LT_TEST_ASSERT(LT_OK, lt_session_mgr_set_keys(&mgr, TR01_PAIRING_KEY_SLOT_INDEX_2, shipriv2, shipub2));
+
+    lt_host_eph_keys_t eph_keys2;
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, eph_keys.ehpriv, sizeof(eph_keys.ehpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, eph_keys2.ehpriv, sizeof(eph_keys2.ehpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(eph_keys.ehpriv, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(eph_keys2.ehpriv, eph_keys2.ehpub));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK,
+                   mock_handshake_rsp(h, stpriv, stpub, shipub2, TR01_PAIRING_KEY_SLOT_INDEX_2, eph_keys2.ehpub));
+
+    char log[8] = {0};
+    lt_ret_t req_ret[4];
+    struct mock_mgr_req_t reqs[4] = {{'A', log}, {'B', log}, {'C', log}, {'D', log}};
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK,
+                   lt_session_mgr_submit(&mgr, TR01_PAIRING_KEY_SLOT_INDEX_1, mock_mgr_req, &reqs[0], &req_ret[0]));
+    LT_TEST_ASSERT(LT_OK, lt_session_mgr_run(&mgr));
+    LT_TEST_ASSERT(LT_OK,
+                   lt_session_mgr_submit(&mgr, TR01_PAIRING_KEY_SLOT_INDEX_2, mock_mgr_req, &reqs[1], &req_ret[1]));
+    LT_TEST_ASSERT(LT_OK,
+                   lt_session_mgr_submit(&mgr, TR01_PAIRING_KEY_SLOT_INDEX_1, mock_mgr_req, &reqs[2], &req_ret[2]));
+    LT_TEST_ASSERT(LT_OK,
+                   lt_session_mgr_submit(&mgr, TR01_PAIRING_KEY_SLOT_INDEX_2, mock_mgr_req, &reqs[3], &req_ret[3]));
+    LT_TEST_ASSERT(LT_OK, lt_session_mgr_run(&mgr));
+    // C is executed in the session opened for A, B and D share one handshake on slot 2.
+    LT_TEST_ASSERT(0, strcmp(log, "ACBD"));
+    for (int i = 0; i < 4; i++) {
+        LT_TEST_ASSERT(LT_OK, req_ret[i]);
+    }
+
+    LT_TEST_ASSERT(LT_OK, lt_session_mgr_get_stats(&mgr, &stats));
+    LT_TEST_ASSERT(4, stats.requests);
+    LT_TEST_ASSERT(3, stats.batches);
+    LT_TEST_ASSERT(2, stats.handshakes);
+    LT_TEST_ASSERT(1, stats.switches);
+    LT_TEST_ASSERT(0, stats.handshake_errors);
+    LT_TEST_ASSERT(2, lt_session_mgr_switches_per_sec(&stats, 500));
+    LT_TEST_ASSERT(TR01_PAIRING_KEY_SLOT_INDEX_2, mgr.active);
+#endif
+
+#ifdef LT_BRINGUP
+    LT_LOG_INFO("Bringing up device with invalid certificate store...");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+    LT_TEST_ASSERT(LT_OK, mock_cert_store(h, LT_CERT_STORE_VERSION + 1, stpub));
+
+    lt_l2_async_t op;
+    memset(&op, 0, sizeof(op));
+    lt_bringup_t bringup;
+    struct mock_bringup_dev_t bringup_dev = {0};
+    LT_TEST_ASSERT(LT_OK, lt_bringup_init(&bringup));
+    LT_TEST_ASSERT(LT_OK, lt_bringup_add_device(&bringup, h, &op, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv, shipub,
+                                                mock_bringup_cb, &bringup_dev));
+    LT_TEST_ASSERT(1, lt_bringup_pending(&bringup));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_bringup_result(&bringup, 0));
+    LT_TEST_ASSERT(LT_OK, lt_bringup_run(&bringup));
+    LT_TEST_ASSERT(0, lt_bringup_pending(&bringup));
+    LT_TEST_ASSERT(LT_BRINGUP_STATE_FAILED, lt_bringup_state(&bringup, 0));
+    LT_TEST_ASSERT(LT_CERT_STORE_INVALID, lt_bringup_result(&bringup, 0));
+    LT_TEST_ASSERT(1, bringup_dev.calls);
+    LT_TEST_ASSERT(LT_CERT_STORE_INVALID, bringup_dev.ret);
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_bringup_result(&bringup, 1));
+
+    LT_LOG_INFO("Bringing up device: lt_init(), STPUB from the certificate store and Secure Session...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+    LT_TEST_ASSERT(LT_OK, mock_cert_store(h, LT_CERT_STORE_VERSION, stpub));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, eph_keys.ehpriv, sizeof(eph_keys.ehpriv)));
+    LT_TEST_ASSERT(LT_OK, lt_X25519_scalarmult(eph_keys.ehpriv, eph_keys.ehpub));
+    LT_TEST_ASSERT(LT_OK, mock_handshake_rsp(h, stpriv, stpub, shipub, TR01_PAIRING_KEY_SLOT_INDEX_1, eph_keys.ehpub));
+    lt_posix_rng_seed(LT_TEST_MOCK_SESSION_SEED);
+
+    memset(&bringup_dev, 0, sizeof(bringup_dev));
+    LT_TEST_ASSERT(LT_OK, lt_bringup_init(&bringup));
+    LT_TEST_ASSERT(LT_OK, lt_bringup_add_device(&bringup, h, &op, TR01_PAIRING_KEY_SLOT_INDEX_1, shipriv, shipub,
+                                                mock_bringup_cb, &bringup_dev));
+    LT_TEST_ASSERT(LT_OK, lt_bringup_run(&bringup));
+    LT_TEST_ASSERT(LT_BRINGUP_STATE_READY, lt_bringup_state(&bringup, 0));
+    LT_TEST_ASSERT(LT_OK, lt_bringup_result(&bringup, 0));
+    LT_TEST_ASSERT(1, bringup_dev.calls);
+    LT_TEST_ASSERT(LT_OK, bringup_dev.ret);
+    LT_TEST_ASSERT(0, memcmp(bringup_dev.stpub, stpub, sizeof(stpub)));
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+#endif
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+}
@@ -0,0 +1,142 @@
+/**
+ * @file lt_test_mock_sign_queue.c
+ * @brief Test queue of ECDSA signing jobs (LT_SIGN_QUEUE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l3_api_structs.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_SIGN_QUEUE
+/** Number of jobs submitted by the test, the second one fails with INVALID_KEY. */
+#define SIGN_QUEUE_TEST_JOBS 3
+
+/** Result of one job. */
+struct sign_queue_test_job_t {
+    int calls;
+    lt_ret_t ret;
+    uint8_t rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH];
+};
+
+static void sign_queue_test_cb(lt_ret_t ret, const uint8_t *rs, void *cb_ctx)
+{
+    struct sign_queue_test_job_t *job = (struct sign_queue_test_job_t *)cb_ctx;
+
+    job->calls++;
+    job->ret = ret;
+    if (rs) {
+        memcpy(job->rs, rs, sizeof(job->rs));
+    }
+}
+
+/** Mocks L3 Command acknowledgement and L3 Result of the job, encrypted with the decryption nonce of the job. */
+static lt_ret_t sign_queue_test_mock_job(lt_handle_t *h, const uint8_t nonce, const uint8_t *res, const size_t res_size)
+{
+    uint8_t iv[TR01_L3_IV_SIZE];
+    memcpy(iv, h->l3.decryption_IV, sizeof(iv));
+    h->l3.decryption_IV[0] = nonce;
+
+    lt_ret_t ret = mock_l3_command_responses(h, 1);
+    if (ret == LT_OK) {
+        ret = mock_l3_result(h, res, res_size);
+    }
+
+    memcpy(h->l3.decryption_IV, iv, sizeof(iv));
+    return ret;
+}
+#endif
+
+void lt_test_mock_sign_queue(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_sign_queue()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_SIGN_QUEUE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_SIGN_QUEUE is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    LT_LOG_INFO("Mocking ECDSA_Sign results, the second job fails...");
+    struct lt_l3_ecdsa_sign_res_t res;
+    uint8_t invalid_key[] = {TR01_L3_RESULT_INVALID_KEY};
+    for (uint8_t i = 0; i < SIGN_QUEUE_TEST_JOBS; i++) {
+        if (i == 1) {
+            LT_TEST_ASSERT(LT_OK, sign_queue_test_mock_job(h, i, invalid_key, sizeof(invalid_key)));
+            continue;
+        }
+        memset(&res, 0, sizeof(res));
+        res.result = TR01_L3_RESULT_OK;
+        memset(res.r, 0x10 + i, sizeof(res.r));
+        memset(res.s, 0x20 + i, sizeof(res.s));
+        LT_TEST_ASSERT(LT_OK, sign_queue_test_mock_job(h, i, &res.result, TR01_L3_ECDSA_SIGN_RES_SIZE));
+    }
+
+    LT_LOG_INFO("Submitting jobs...");
+    lt_l2_async_t op;
+    memset(&op, 0, sizeof(op));
+    lt_sign_queue_t q;
+    struct sign_queue_test_job_t jobs[SIGN_QUEUE_TEST_JOBS];
+    memset(jobs, 0, sizeof(jobs));
+    uint8_t digest[LT_SIGN_QUEUE_DIGEST_LEN] = {0};
+
+    LT_TEST_ASSERT(LT_OK, lt_sign_queue_init(&q));
+    LT_TEST_ASSERT(LT_OK, lt_sign_queue_add_device(&q, h, &op));
+    for (uint8_t i = 0; i < SIGN_QUEUE_TEST_JOBS; i++) {
+        LT_TEST_ASSERT(LT_OK, lt_sign_queue_submit(&q, TR01_ECC_SLOT_0 + i, digest, sign_queue_test_cb, &jobs[i]));
+    }
+    LT_TEST_ASSERT(SIGN_QUEUE_TEST_JOBS, lt_sign_queue_pending(&q));
+
+    LT_LOG_INFO("Verifying the second command was encrypted while the first one executes...");
+    LT_TEST_ASSERT(2, h->l3.encryption_IV[0]);
+    LT_TEST_ASSERT(0, h->l3.decryption_IV[0]);
+
+    LT_LOG_INFO("Running the queue...");
+    LT_TEST_ASSERT(LT_OK, lt_sign_queue_run(&q));
+    LT_TEST_ASSERT(0, lt_sign_queue_pending(&q));
+
+    for (uint8_t i = 0; i < SIGN_QUEUE_TEST_JOBS; i++) {
+        LT_TEST_ASSERT(1, jobs[i].calls);
+        if (i == 1) {
+            LT_TEST_ASSERT(LT_L3_INVALID_KEY, jobs[i].ret);
+            continue;
+        }
+        LT_TEST_ASSERT(LT_OK, jobs[i].ret);
+        LT_TEST_ASSERT(0x10 + i, jobs[i].rs[0]);
+        LT_TEST_ASSERT(0x20 + i, jobs[i].rs[TR01_ECDSA_EDDSA_SIGNATURE_LENGTH - 1]);
+    }
+    LT_TEST_ASSERT(LT_SECURE_SESSION_ON, h->l3.session_status);
+
+    LT_LOG_INFO("Terminating the Secure Session...");
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
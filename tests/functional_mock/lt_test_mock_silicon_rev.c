@@ -0,0 +1,88 @@
+/**
+ * @file lt_test_mock_silicon_rev.c
+ * @brief Test runtime detection of TROPIC01 silicon revision (LT_SILICON_REV_CHECK).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_SILICON_REV_CHECK
+#ifdef ABAB
+/** Silicon revision Libtropic is built for. */
+#define SILICON_REV_BUILT LT_SILICON_REV_ABAB
+/** Size of FW header returned by bootloader of the built revision. */
+#define SILICON_REV_HEADER_SIZE_BUILT TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V1
+/** Size of FW header returned by bootloader of the other revision. */
+#define SILICON_REV_HEADER_SIZE_OTHER TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V2
+#elif ACAB
+#define SILICON_REV_BUILT LT_SILICON_REV_ACAB
+#define SILICON_REV_HEADER_SIZE_BUILT TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V2
+#define SILICON_REV_HEADER_SIZE_OTHER TR01_L2_GET_INFO_FW_HEADER_SIZE_BOOT_V1
+#endif
+#endif
+
+void lt_test_mock_silicon_rev(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_silicon_rev()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_SILICON_REV_CHECK
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_SILICON_REV_CHECK is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    lt_silicon_rev_t rev;
+
+    LT_LOG_INFO("Detecting the built silicon revision...");
+    LT_TEST_ASSERT(LT_OK, mock_fw_bank_header(h, SILICON_REV_HEADER_SIZE_BUILT));
+    LT_TEST_ASSERT(LT_OK, lt_get_silicon_rev(h, &rev));
+    LT_TEST_ASSERT(SILICON_REV_BUILT, rev);
+    LT_TEST_ASSERT(LT_OK, lt_silicon_rev_check(h));
+
+    LT_LOG_INFO("Verifying the detected revision is returned without communication...");
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+    LT_TEST_ASSERT(LT_OK, lt_get_silicon_rev(h, &rev));
+    LT_TEST_ASSERT(SILICON_REV_BUILT, rev);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+
+    LT_LOG_INFO("Initializing handle again for TROPIC01 of the other revision");
+    lt_mock_hal_reset(&h->l2);
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Verifying mutable firmware update is refused...");
+    LT_TEST_ASSERT(LT_OK, mock_fw_bank_header(h, SILICON_REV_HEADER_SIZE_OTHER));
+#ifdef ABAB
+    LT_TEST_ASSERT(LT_SILICON_REV_MISMATCH, lt_mutable_fw_erase(h, TR01_FW_BANK_FW1));
+#elif ACAB
+    uint8_t update_request[TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN + 1] = {TR01_L2_MUTABLE_FW_UPDATE_REQ_LEN};
+    LT_TEST_ASSERT(LT_SILICON_REV_MISMATCH, lt_mutable_fw_update(h, update_request));
+#endif
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+    LT_TEST_ASSERT(LT_SILICON_REV_MISMATCH, lt_silicon_rev_check(h));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,131 @@
+/**
+ * @file lt_test_mock_spi_recorder.c
+ * @brief Test SPI recorder (LT_SPI_RECORDER).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_SPI_RECORDER
+/** Size of the ring buffer of the test, smallest one allowed. */
+#define SPI_REC_TEST_SIZE 512
+/** Number of Get_Info requests, whose records do not fit into the ring buffer. */
+#define SPI_REC_TEST_OVERFLOW_REQS 16
+
+/** Returns timestamp from the header of the record. */
+static uint64_t spi_rec_test_time_us(const uint8_t *hdr)
+{
+    uint64_t time_us = 0;
+
+    for (int i = 7; i >= 0; i--) {
+        time_us = (time_us << 8) | hdr[4 + i];
+    }
+
+    return time_us;
+}
+
+/** Mocks Get_Info response with RISC-V FW version. */
+static lt_ret_t spi_rec_test_mock_get_info(lt_handle_t *h)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = TR01_L2_GET_INFO_RISCV_FW_SIZE,
+                                                 .object = {0x00, 0x00, 0x00, 0x02}};
+    add_resp_crc(&get_info_resp);
+
+    lt_ret_t ret = lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready));
+    if (ret != LT_OK) {
+        return ret;
+    }
+
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp, calc_mocked_resp_len(&get_info_resp));
+}
+#endif
+
+void lt_test_mock_spi_recorder(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_spi_recorder()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_SPI_RECORDER
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_SPI_RECORDER is not enabled, skipping.");
+#else
+    lt_spi_recorder_t rec;
+    uint8_t rec_buff[SPI_REC_TEST_SIZE];
+    uint8_t out[SPI_REC_TEST_SIZE];
+    uint8_t riscv_fw_ver[TR01_L2_GET_INFO_RISCV_FW_SIZE];
+
+    LT_LOG_INFO("Checking that size of the ring buffer has to be a power of two...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_spi_recorder_init(&rec, rec_buff, SPI_REC_TEST_SIZE - 1));
+    LT_TEST_ASSERT(LT_OK, lt_spi_recorder_init(&rec, rec_buff, SPI_REC_TEST_SIZE));
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_OK, lt_spi_recorder_attach(h, &rec));
+
+    LT_LOG_INFO("Recording Get_Info...");
+    LT_TEST_ASSERT(LT_OK, spi_rec_test_mock_get_info(h));
+    LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+
+    LT_LOG_INFO("Checking the recorded request and response...");
+    uint16_t req_len = TR01_L2_REQ_ID_SIZE + TR01_L2_REQ_RSP_LEN_SIZE + TR01_L2_GET_INFO_REQ_LEN + 2;
+    uint16_t rsp_len = TR01_L2_RSP_DATA_RSP_CRC_OFFSET + TR01_L2_GET_INFO_RISCV_FW_SIZE + TR01_L2_REQ_RSP_CRC_SIZE;
+    uint32_t len = lt_spi_recorder_read(&rec, out, sizeof(out));
+    LT_TEST_ASSERT(2 * LT_SPI_REC_HDR_SIZE + req_len + rsp_len, len);
+
+    const uint8_t *req = out;
+    LT_TEST_ASSERT(LT_SPI_REC_MOSI, req[0]);
+    LT_TEST_ASSERT(req_len, req[2] | (req[3] << 8));
+    LT_TEST_ASSERT(TR01_L2_GET_INFO_REQ_ID, req[LT_SPI_REC_HDR_SIZE]);
+
+    const uint8_t *rsp = req + LT_SPI_REC_HDR_SIZE + req_len;
+    LT_TEST_ASSERT(LT_SPI_REC_MISO, rsp[0]);
+    LT_TEST_ASSERT(rsp_len, rsp[2] | (rsp[3] << 8));
+    LT_TEST_ASSERT(TR01_L2_STATUS_REQUEST_OK, rsp[LT_SPI_REC_HDR_SIZE + TR01_L2_STATUS_OFFSET]);
+    LT_TEST_ASSERT(0, memcmp(rsp + LT_SPI_REC_HDR_SIZE + TR01_L2_RSP_DATA_RSP_CRC_OFFSET, riscv_fw_ver,
+                             sizeof(riscv_fw_ver)));
+    LT_TEST_ASSERT(1, spi_rec_test_time_us(rsp) >= spi_rec_test_time_us(req));
+    LT_TEST_ASSERT(0, lt_spi_recorder_read(&rec, out, sizeof(out)));
+
+    LT_LOG_INFO("Checking that records are dropped when the ring buffer is full...");
+    for (int i = 0; i < SPI_REC_TEST_OVERFLOW_REQS; i++) {
+        LT_TEST_ASSERT(LT_OK, spi_rec_test_mock_get_info(h));
+        LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    }
+    LT_TEST_ASSERT(1, lt_spi_recorder_dropped(&rec) > 0);
+    len = lt_spi_recorder_read(&rec, out, sizeof(out));
+    LT_TEST_ASSERT(1, (len > 0) && (len <= sizeof(out)));
+
+    LT_LOG_INFO("Detaching the recorder");
+    LT_TEST_ASSERT(LT_OK, lt_spi_recorder_attach(h, NULL));
+    LT_TEST_ASSERT(LT_OK, spi_rec_test_mock_get_info(h));
+    LT_TEST_ASSERT(LT_OK, lt_get_info_riscv_fw_ver(h, riscv_fw_ver));
+    LT_TEST_ASSERT(0, lt_spi_recorder_read(&rec, out, sizeof(out)));
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
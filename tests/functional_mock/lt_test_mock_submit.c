@@ -0,0 +1,125 @@
+/**
+ * @file lt_test_mock_submit.c
+ * @brief Test submit/complete API for L3 operations (LT_SUBMIT).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_l2.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+void lt_test_mock_submit(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_submit()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_SUBMIT
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_SUBMIT is not enabled, skipping.");
+#else
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Setting up session...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+
+    lt_cmd_t *done = NULL;
+    LT_LOG_INFO("Completing with nothing submitted...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_complete(h, &done));
+
+    LT_LOG_INFO("Submitting operation without output buffer...");
+    lt_cmd_t get = {.type = LT_CMD_MCOUNTER_GET};
+    get.args.mcounter_get.mcounter_index = TR01_MCOUNTER_INDEX_3;
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_submit(h, &get));
+
+    LT_LOG_INFO("Submitting Ping, a second operation is refused until it is completed...");
+    uint8_t ping_out[4] = {1, 2, 3, 4};
+    uint8_t ping_in[sizeof(ping_out)] = {0};
+    uint8_t ping_res[1 + sizeof(ping_out)] = {TR01_L3_RESULT_OK, 1, 2, 3, 4};
+    lt_cmd_t ping = {.type = LT_CMD_PING};
+    ping.args.ping.msg_out = ping_out;
+    ping.args.ping.msg_in = ping_in;
+    ping.args.ping.msg_len = sizeof(ping_out);
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, lt_submit(h, &ping));
+    uint32_t mcounter_value = 0;
+    get.args.mcounter_get.mcounter_value = &mcounter_value;
+    LT_TEST_ASSERT(LT_FAIL, lt_submit(h, &get));
+
+    LT_LOG_INFO("Completing Ping...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+    LT_TEST_ASSERT(LT_OK, lt_complete(h, &done));
+    LT_TEST_ASSERT(1, done == &ping);
+    LT_TEST_ASSERT(0, memcmp(ping_out, ping_in, sizeof(ping_out)));
+
+    LT_LOG_INFO("Submitting and completing Mcounter_Get...");
+    uint8_t mcounter_res[] = {TR01_L3_RESULT_OK, 0, 0, 0, 0x04, 0x03, 0x02, 0x01};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, lt_submit(h, &get));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, mcounter_res, sizeof(mcounter_res)));
+    LT_TEST_ASSERT(LT_OK, lt_complete(h, &done));
+    LT_TEST_ASSERT(1, done == &get);
+    LT_TEST_ASSERT(1, mcounter_value == 0x01020304);
+
+    LT_LOG_INFO("Completing failed ECC_Key_Erase, the error is returned with the operation...");
+    lt_cmd_t erase = {.type = LT_CMD_ECC_KEY_ERASE};
+    erase.args.ecc_key_erase.slot = TR01_ECC_SLOT_7;
+    uint8_t fail_res[] = {TR01_L3_RESULT_FAIL};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, lt_submit(h, &erase));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, fail_res, sizeof(fail_res)));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_complete(h, &done));
+    LT_TEST_ASSERT(1, done == &erase);
+
+#ifdef LT_L2_ASYNC
+    LT_LOG_INFO("Submitting Ping asynchronously, the result is not ready at the first attempt...");
+    lt_l2_async_t op;
+    memset(&op, 0, sizeof(op));
+    uint8_t no_resp[] = {TR01_L1_CHIP_MODE_READY_bit, 0xFF, 0xFF};
+    memset(ping_in, 0, sizeof(ping_in));
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, lt_submit_async(h, &ping, &op));
+    LT_TEST_ASSERT(LT_FAIL, lt_submit_async(h, &get, &op));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_complete_async(h, &op, &done));
+    LT_TEST_ASSERT(LT_OK, lt_mock_hal_enqueue_response(&h->l2, no_resp, sizeof(no_resp)));
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_complete_async(h, &op, &done));
+
+    LT_LOG_INFO("Completing asynchronous Ping...");
+    done = NULL;
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, ping_res, sizeof(ping_res)));
+#ifdef LT_PORT_SPI_READ_READY_NOWAIT
+    // The port only starts the polling now, the response is received by the next call.
+    LT_TEST_ASSERT(LT_L1_CHIP_BUSY, lt_complete_async(h, &op, &done));
+#endif
+    LT_TEST_ASSERT(LT_OK, lt_complete_async(h, &op, &done));
+    LT_TEST_ASSERT(1, done == &ping);
+    LT_TEST_ASSERT(0, memcmp(ping_out, ping_in, sizeof(ping_out)));
+    LT_TEST_ASSERT(0, (int)((lt_dev_mock_t *)h->l2.device)->mock_queue_count);
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_complete_async(h, &op, &done));
+#endif
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,120 @@
+/**
+ * @file lt_test_mock_trace_export.c
+ * @brief Test export of trace hook events in the Chrome trace event format (LT_TRACE_EXPORT).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_TRACE_EXPORT
+/** Exported JSON text, written into a fixed buffer. */
+struct trace_export_test_out_t {
+    char text[8192];
+    size_t len;
+};
+
+static lt_ret_t trace_export_test_write(void *write_ctx, const char *data, const size_t len)
+{
+    struct trace_export_test_out_t *out = (struct trace_export_test_out_t *)write_ctx;
+
+    if (out->len + len >= sizeof(out->text)) {
+        return LT_FAIL;
+    }
+    memcpy(out->text + out->len, data, len);
+    out->len += len;
+    out->text[out->len] = '\0';
+
+    return LT_OK;
+}
+
+/** Counts occurrences of the string in the exported text. */
+static int trace_export_test_count(const struct trace_export_test_out_t *out, const char *str)
+{
+    int cnt = 0;
+    for (const char *p = strstr(out->text, str); p; p = strstr(p + 1, str)) {
+        cnt++;
+    }
+    return cnt;
+}
+#endif
+
+void lt_test_mock_trace_export(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_trace_export()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_TRACE_EXPORT
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_TRACE_EXPORT is not enabled, skipping.");
+#else
+    static struct trace_export_test_out_t out;
+    lt_trace_event_t events_a[256];
+    lt_trace_event_t events_b[5];
+    lt_trace_export_t exp_a, exp_b;
+
+    LT_LOG_INFO("Checking parameters...");
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_trace_export_init(&exp_a, events_a, 0, 1, NULL));
+    LT_TEST_ASSERT(LT_OK, lt_trace_export_init(&exp_a, events_a, 256, 1, "TROPIC01 \"A\""));
+    LT_TEST_ASSERT(LT_OK, lt_trace_export_init(&exp_b, events_b, 5, 2, "B"));
+    const lt_trace_export_t *exps[] = {&exp_a, &exp_b};
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_trace_export_json(exps, 2, NULL, &out));
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));
+
+    LT_LOG_INFO("Initializing handle traced by the first exporter");
+    LT_TEST_ASSERT(LT_OK, lt_set_trace_hooks(h, &exp_a.hooks));
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+    LT_TEST_ASSERT(LT_OK, lt_set_trace_hooks(h, NULL));
+    LT_TEST_ASSERT(1, exp_a.count > 0);
+    LT_TEST_ASSERT(0, (int)(exp_a.count % 2));
+    LT_TEST_ASSERT(0, (int)lt_trace_export_dropped(&exp_a));
+
+    LT_LOG_INFO("Recording L3 Result of the second exporter until its events are full...");
+    exp_b.hooks.start(exp_b.hooks.ctx, LT_TRACE_L2_ENC_RES, 100);
+    exp_b.hooks.start(exp_b.hooks.ctx, LT_TRACE_L1_WAIT, 110);
+    exp_b.hooks.end(exp_b.hooks.ctx, LT_TRACE_L1_WAIT, 150);
+    exp_b.hooks.start(exp_b.hooks.ctx, LT_TRACE_L1_READ, 150);
+    exp_b.hooks.start(exp_b.hooks.ctx, LT_TRACE_L1_SPI, 151);
+    exp_b.hooks.end(exp_b.hooks.ctx, LT_TRACE_L1_SPI, 160);
+    exp_b.hooks.end(exp_b.hooks.ctx, LT_TRACE_L1_READ, 161);
+    LT_TEST_ASSERT(2, (int)lt_trace_export_dropped(&exp_b));
+
+    LT_LOG_INFO("Exporting both exporters...");
+    LT_TEST_ASSERT(LT_OK, lt_trace_export_json(exps, 2, trace_export_test_write, &out));
+    LT_TEST_ASSERT(1, strncmp(out.text, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 39) == 0);
+    LT_TEST_ASSERT(1, strcmp(out.text + out.len - 4, "\n]}\n") == 0);
+    LT_TEST_ASSERT(1, strstr(out.text, "\"args\":{\"name\":\"TROPIC01 \\\"A\\\"\"}") != NULL);
+    LT_TEST_ASSERT((int)exp_a.count, trace_export_test_count(&out, "\"tid\":1,\"ts\""));
+    LT_TEST_ASSERT(1, strstr(out.text, "{\"name\":\"chip compute\",\"cat\":\"TROPIC01\",\"ph\":\"B\",\"pid\":1,\"tid\":2,"
+                                      "\"ts\":110}")
+                          != NULL);
+    // SPI transfer, L1 read and L3 Result receive were left open by the dropped events.
+    LT_TEST_ASSERT(4, trace_export_test_count(&out, "{\"ph\":\"E\",\"pid\":1,\"tid\":2,"));
+    LT_TEST_ASSERT(3, trace_export_test_count(&out, "{\"ph\":\"E\",\"pid\":1,\"tid\":2,\"ts\":151}"));
+
+    LT_LOG_INFO("Checking the writer's error ends the export...");
+    out.len = sizeof(out.text) - 8;
+    LT_TEST_ASSERT(LT_FAIL, lt_trace_export_json(exps, 2, trace_export_test_write, &out));
+    lt_trace_export_clear(&exp_b);
+    LT_TEST_ASSERT(0, (int)lt_trace_export_dropped(&exp_b));
+    LT_TEST_ASSERT(0, (int)exp_b.count);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}
@@ -0,0 +1,99 @@
+/**
+ * @file lt_test_mock_trace_hooks.c
+ * @brief Test trace hooks (LT_TRACE).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_macros.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_mock_helpers.h"
+#include "lt_test_common.h"
+
+#ifdef LT_TRACE
+#define TRACE_PHASES_CNT (LT_TRACE_CAL_DECRYPT + 1)
+
+/** Counts started and ended phases and checks their ordering. */
+struct trace_test_ctx_t {
+    int starts[TRACE_PHASES_CNT];
+    int ends[TRACE_PHASES_CNT];
+    uint64_t last_time_us;
+    int errors;
+};
+
+static void trace_test_start(void *ctx, lt_trace_phase_t phase, uint64_t time_us)
+{
+    struct trace_test_ctx_t *t = (struct trace_test_ctx_t *)ctx;
+
+    if (time_us < t->last_time_us) {
+        t->errors++;
+    }
+    t->last_time_us = time_us;
+    t->starts[phase]++;
+}
+
+static void trace_test_end(void *ctx, lt_trace_phase_t phase, uint64_t time_us)
+{
+    struct trace_test_ctx_t *t = (struct trace_test_ctx_t *)ctx;
+
+    // Every phase has to end after it started.
+    if ((time_us < t->last_time_us) || (t->ends[phase] >= t->starts[phase])) {
+        t->errors++;
+    }
+    t->last_time_us = time_us;
+    t->ends[phase]++;
+}
+#endif
+
+void lt_test_mock_trace_hooks(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_trace_hooks()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_TRACE
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_TRACE is not enabled, skipping.");
+#else
+    struct trace_test_ctx_t t;
+    memset(&t, 0, sizeof(t));
+    const lt_trace_hooks_t hooks = {.start = trace_test_start, .end = trace_test_end, .ctx = &t};
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Mocking initialization...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, (uint8_t[]){0x00, 0x00, 0x00, 0x02}));  // Version 2.0.0
+
+    LT_LOG_INFO("Initializing handle with trace hooks set");
+    LT_TEST_ASSERT(LT_OK, lt_set_trace_hooks(h, &hooks));
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Checking that every started phase has ended");
+    LT_TEST_ASSERT(0, t.errors);
+    for (int i = 0; i < TRACE_PHASES_CNT; i++) {
+        LT_TEST_ASSERT(t.starts[i], t.ends[i]);
+    }
+
+    LT_LOG_INFO("Checking that L1 and L2 phases of Get_Info were traced");
+    LT_TEST_ASSERT(1, t.starts[LT_TRACE_L1_SPI] > 0);
+    LT_TEST_ASSERT(1, t.starts[LT_TRACE_L1_READ] > 0);
+    LT_TEST_ASSERT(1, t.starts[LT_TRACE_L2_CRC] > 0);
+    LT_TEST_ASSERT(0, t.starts[LT_TRACE_L2_ENC_CMD]);
+    LT_TEST_ASSERT(0, t.starts[LT_TRACE_CAL_ENCRYPT]);
+
+    LT_LOG_INFO("Removing trace hooks");
+    LT_TEST_ASSERT(LT_OK, lt_set_trace_hooks(h, NULL));
+    int spi_cnt = t.starts[LT_TRACE_L1_SPI];
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+    LT_TEST_ASSERT(spi_cnt, t.starts[LT_TRACE_L1_SPI]);
+#endif
+}
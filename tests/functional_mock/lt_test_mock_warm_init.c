@@ -0,0 +1,119 @@
+/**
+ * @file lt_test_mock_warm_init.c
+ * @brief Test warm initialization from cached TROPIC01 attributes (LT_WARM_INIT).
+ * @copyright Copyright (c) 2020-2026 Tropic Square s.r.o.
+ *
+ * @license For the license see file LICENSE.txt file in the root directory of this source tree.
+ */
+
+#include <string.h>
+
+#include "libtropic.h"
+#include "libtropic_common.h"
+#include "libtropic_logging.h"
+#include "libtropic_port_mock.h"
+#include "lt_functional_mock_tests.h"
+#include "lt_l1.h"
+#include "lt_l2_api_structs.h"
+#include "lt_l2_frame_check.h"
+#include "lt_l3_process.h"
+#include "lt_mock_helpers.h"
+#include "lt_port_wrap.h"
+#include "lt_test_common.h"
+
+#ifdef LT_WARM_INIT
+/** Mocks Get_Info L2 Request returning the given object. */
+static lt_ret_t warm_init_test_mock_get_info(lt_handle_t *h, const uint8_t *object, const uint8_t object_len)
+{
+    uint8_t chip_ready = TR01_L1_CHIP_MODE_READY_bit;
+    if (LT_OK != lt_mock_hal_enqueue_response(&h->l2, &chip_ready, sizeof(chip_ready))) {
+        return LT_FAIL;
+    }
+
+    struct lt_l2_get_info_rsp_t get_info_resp = {.chip_status = TR01_L1_CHIP_MODE_READY_bit,
+                                                 .status = TR01_L2_STATUS_REQUEST_OK,
+                                                 .rsp_len = object_len,
+                                                 .object = {0}};
+    memcpy(get_info_resp.object, object, object_len);
+    add_resp_crc(&get_info_resp);
+
+    return lt_mock_hal_enqueue_response(&h->l2, (uint8_t *)&get_info_resp, calc_mocked_resp_len(&get_info_resp));
+}
+#endif
+
+void lt_test_mock_warm_init(lt_handle_t *h)
+{
+    LT_LOG_INFO("----------------------------------------------");
+    LT_LOG_INFO("lt_test_mock_warm_init()");
+    LT_LOG_INFO("----------------------------------------------");
+
+#ifndef LT_WARM_INIT
+    LT_UNUSED(h);
+    LT_LOG_INFO("LT_WARM_INIT is not enabled, skipping.");
+#else
+    const uint8_t fw_ver_1[TR01_L2_GET_INFO_RISCV_FW_SIZE] = {0x00, 0x01, 0x00, 0x01};  // Version 1.0.1
+    const uint8_t fw_ver_2[TR01_L2_GET_INFO_RISCV_FW_SIZE] = {0x00, 0x00, 0x00, 0x02};  // Version 2.0.0
+    struct lt_chip_id_t chip_id, cached_chip_id;
+    memset(&chip_id, 0, sizeof(chip_id));
+    chip_id.ser_num.sn = 0x42;
+    chip_id.ser_num.wafer_id = 0x07;
+
+    lt_mock_hal_reset(&h->l2);
+    LT_LOG_INFO("Initializing handle by lt_init()...");
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, fw_ver_1));
+    LT_TEST_ASSERT(LT_OK, lt_init(h));
+
+    LT_LOG_INFO("Exporting the attributes...");
+    lt_tr01_attrs_cache_t cache;
+    LT_TEST_ASSERT(LT_OK, warm_init_test_mock_get_info(h, (const uint8_t *)&chip_id, sizeof(chip_id)));
+    LT_TEST_ASSERT(LT_OK, warm_init_test_mock_get_info(h, fw_ver_1, sizeof(fw_ver_1)));
+    LT_TEST_ASSERT(LT_OK, lt_tr01_attrs_export(h, &cache));
+    LT_TEST_ASSERT(true, lt_tr01_attrs_cache_valid(&cache));
+    LT_TEST_ASSERT(LT_OK, lt_tr01_attrs_cache_chip_id(&cache, &cached_chip_id));
+    LT_TEST_ASSERT(0, memcmp(&chip_id, &cached_chip_id, sizeof(chip_id)));
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+
+    LT_LOG_INFO("Initializing handle by lt_init_warm() without any communication...");
+    lt_mock_hal_reset(&h->l2);
+    LT_TEST_ASSERT(LT_OK, lt_init_warm(h, &cache));
+    LT_TEST_ASSERT(444, h->tr01_attrs.r_mem_udata_slot_size_max);
+    LT_TEST_ASSERT(1, h->tr01_attrs.unverified);
+
+    LT_LOG_INFO("Verifying the attributes after the first failed operation...");
+    uint8_t kcmd[TR01_AES256_KEY_LEN];
+    uint8_t kres[TR01_AES256_KEY_LEN];
+    LT_TEST_ASSERT(LT_OK, lt_random_bytes(h, kcmd, sizeof(kcmd)));
+    memcpy(kres, kcmd, TR01_AES256_KEY_LEN);
+    LT_TEST_ASSERT(LT_OK, mock_session_start(h, kcmd, kres));
+    uint8_t res_fail[] = {TR01_L3_RESULT_FAIL};
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, res_fail, sizeof(res_fail)));
+    // The FW was updated since the export.
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, fw_ver_2));
+    uint8_t data[TR01_R_MEM_DATA_SIZE_MIN];
+    uint16_t read_size;
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_r_mem_data_read(h, 0, data, sizeof(data), &read_size));
+    LT_TEST_ASSERT(475, h->tr01_attrs.r_mem_udata_slot_size_max);
+    LT_TEST_ASSERT(0, h->tr01_attrs.unverified);
+
+    LT_LOG_INFO("Verifying next failure does not verify the attributes again...");
+    LT_TEST_ASSERT(LT_OK, mock_l3_command_responses(h, 1));
+    LT_TEST_ASSERT(LT_OK, mock_l3_result(h, res_fail, sizeof(res_fail)));
+    LT_TEST_ASSERT(LT_L3_FAIL, lt_r_mem_data_read(h, 0, data, sizeof(data), &read_size));
+    LT_TEST_ASSERT(LT_OK, mock_session_abort(h));
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+
+    LT_LOG_INFO("Initializing handle by lt_init_warm() with corrupted cache falls back to lt_init()...");
+    lt_mock_hal_reset(&h->l2);
+    cache.r_mem_udata_slot_size_max ^= 1;
+    LT_TEST_ASSERT(false, lt_tr01_attrs_cache_valid(&cache));
+    LT_TEST_ASSERT(LT_PARAM_ERR, lt_tr01_attrs_cache_chip_id(&cache, &cached_chip_id));
+    LT_TEST_ASSERT(LT_OK, mock_init_communication(h, fw_ver_2));
+    LT_TEST_ASSERT(LT_OK, lt_init_warm(h, &cache));
+    LT_TEST_ASSERT(475, h->tr01_attrs.r_mem_udata_slot_size_max);
+    LT_TEST_ASSERT(0, h->tr01_attrs.unverified);
+
+    LT_LOG_INFO("Deinitializing handle");
+    LT_TEST_ASSERT(LT_OK, lt_deinit(h));
+#endif
+}